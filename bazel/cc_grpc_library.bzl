@@ -10,6 +10,7 @@ def cc_grpc_library(
         proto_only = False,
         well_known_protos = False,
         generate_mocks = False,
+        use_arena = False,
         use_external = False,
         grpc_only = False,
         **kwargs):
@@ -41,6 +42,8 @@ def cc_grpc_library(
           (passed in srcs parameter) instead. False by default.
         generate_mocks (bool): when True, Google Mock code for client stub is
           generated. False by default.
+        use_arena (bool): when True, the generated services allocate the
+          messages of unary methods on protobuf arenas. False by default.
         use_external (bool): Not used.
         grpc_only (bool): if True, generate only grpc library, expecting
           protobuf messages library (cc_proto_library target) to be passed as
@@ -91,6 +94,7 @@ def cc_grpc_library(
             plugin = "@com_github_grpc_grpc//src/compiler:grpc_cpp_plugin",
             well_known_protos = well_known_protos,
             generate_mocks = generate_mocks,
+            flags = ["arena=true"] if use_arena else [],
             **kwargs
         )
 
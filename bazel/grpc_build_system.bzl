@@ -151,7 +151,8 @@ def grpc_proto_library(
         well_known_protos = False,
         has_services = True,
         use_external = False,
-        generate_mocks = False):
+        generate_mocks = False,
+        use_arena = False):
     cc_grpc_library(
         name = name,
         srcs = srcs,
@@ -160,6 +161,7 @@ def grpc_proto_library(
         proto_only = not has_services,
         use_external = use_external,
         generate_mocks = generate_mocks,
+        use_arena = use_arena,
     )
 
 def ios_cc_test(
@@ -189,6 +189,7 @@
         'src/core/lib/gpr/env_windows.cc',
         'src/core/lib/gpr/log.cc',
         'src/core/lib/gpr/log_android.cc',
+        'src/core/lib/gpr/log_async.cc',
         'src/core/lib/gpr/log_linux.cc',
         'src/core/lib/gpr/log_posix.cc',
         'src/core/lib/gpr/log_windows.cc',
@@ -217,6 +218,7 @@
         'src/core/lib/gprpp/thd_posix.cc',
         'src/core/lib/gprpp/thd_windows.cc',
         'src/core/lib/profiling/basic_timers.cc',
+        'src/core/lib/profiling/ring_timers.cc',
         'src/core/lib/profiling/stap_timers.cc',
       ],
     },
@@ -231,6 +233,7 @@
         'src/core/lib/surface/init.cc',
         'src/core/lib/avl/avl.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -273,6 +276,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -337,6 +341,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -406,6 +411,7 @@
         'src/core/ext/transport/chttp2/transport/http2_settings.cc',
         'src/core/ext/transport/chttp2/transport/huffsyms.cc',
         'src/core/ext/transport/chttp2/transport/incoming_metadata.cc',
+        'src/core/ext/transport/chttp2/transport/keepalive_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
@@ -514,6 +520,7 @@
         'src/core/ext/filters/client_channel/subchannel.cc',
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
+        'src/core/ext/filters/deadline/deadline_wheel.cc',
         'src/core/ext/upb-generated/src/proto/grpc/health/v1/health.upb.c',
         'src/core/ext/upb-generated/udpa/data/orca/v1/orca_load_report.upb.c',
         'src/core/ext/upb-generated/gogoproto/gogo.upb.c',
@@ -541,6 +548,11 @@
         'src/core/ext/transport/chttp2/server/insecure/server_chttp2_posix.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
+        'src/core/ext/transport/shm/shm_endpoint.cc',
+        'src/core/ext/transport/shm/shm_handshaker.cc',
+        'src/core/ext/transport/shm/shm_plugin.cc',
+        'src/core/ext/transport/shm/shm_resolver.cc',
+        'src/core/ext/transport/shm/shm_ring.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/client_load_reporting_filter.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_channel_secure.cc',
@@ -578,6 +590,10 @@
         'src/core/ext/filters/client_channel/lb_policy/xds/xds.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
+        'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/dns_resolver_ares.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver_libuv.cc',
@@ -643,6 +659,7 @@
         'test/core/util/cmdline.cc',
         'src/core/lib/avl/avl.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -685,6 +702,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -749,6 +767,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -826,6 +845,7 @@
         'src/core/ext/filters/client_channel/subchannel.cc',
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
+        'src/core/ext/filters/deadline/deadline_wheel.cc',
         'src/core/ext/upb-generated/src/proto/grpc/health/v1/health.upb.c',
         'src/core/ext/upb-generated/udpa/data/orca/v1/orca_load_report.upb.c',
         'src/core/ext/upb-generated/gogoproto/gogo.upb.c',
@@ -858,6 +878,7 @@
         'src/core/ext/transport/chttp2/transport/http2_settings.cc',
         'src/core/ext/transport/chttp2/transport/huffsyms.cc',
         'src/core/ext/transport/chttp2/transport/incoming_metadata.cc',
+        'src/core/ext/transport/chttp2/transport/keepalive_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
@@ -906,6 +927,7 @@
         'test/core/util/cmdline.cc',
         'src/core/lib/avl/avl.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -948,6 +970,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -1012,6 +1035,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -1089,6 +1113,7 @@
         'src/core/ext/filters/client_channel/subchannel.cc',
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
+        'src/core/ext/filters/deadline/deadline_wheel.cc',
         'src/core/ext/upb-generated/src/proto/grpc/health/v1/health.upb.c',
         'src/core/ext/upb-generated/udpa/data/orca/v1/orca_load_report.upb.c',
         'src/core/ext/upb-generated/gogoproto/gogo.upb.c',
@@ -1121,6 +1146,7 @@
         'src/core/ext/transport/chttp2/transport/http2_settings.cc',
         'src/core/ext/transport/chttp2/transport/huffsyms.cc',
         'src/core/ext/transport/chttp2/transport/incoming_metadata.cc',
+        'src/core/ext/transport/chttp2/transport/keepalive_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
@@ -1145,6 +1171,7 @@
         'src/core/lib/surface/init_unsecure.cc',
         'src/core/lib/avl/avl.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -1187,6 +1214,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -1251,6 +1279,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -1321,6 +1350,7 @@
         'src/core/ext/transport/chttp2/transport/http2_settings.cc',
         'src/core/ext/transport/chttp2/transport/huffsyms.cc',
         'src/core/ext/transport/chttp2/transport/incoming_metadata.cc',
+        'src/core/ext/transport/chttp2/transport/keepalive_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
@@ -1363,6 +1393,7 @@
         'src/core/ext/filters/client_channel/subchannel.cc',
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
+        'src/core/ext/filters/deadline/deadline_wheel.cc',
         'src/core/ext/upb-generated/src/proto/grpc/health/v1/health.upb.c',
         'src/core/ext/upb-generated/udpa/data/orca/v1/orca_load_report.upb.c',
         'src/core/ext/upb-generated/gogoproto/gogo.upb.c',
@@ -1379,6 +1410,11 @@
         'src/core/ext/upb-generated/google/rpc/status.upb.c',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
+        'src/core/ext/transport/shm/shm_endpoint.cc',
+        'src/core/ext/transport/shm/shm_handshaker.cc',
+        'src/core/ext/transport/shm/shm_plugin.cc',
+        'src/core/ext/transport/shm/shm_resolver.cc',
+        'src/core/ext/transport/shm/shm_ring.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/dns_resolver_ares.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver.cc',
         'src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver_libuv.cc',
@@ -1430,6 +1466,10 @@
         'src/core/ext/filters/client_channel/lb_policy/xds/xds.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
+        'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/client_idle/client_idle_filter.cc',
         'src/core/ext/filters/max_age/max_age_filter.cc',
@@ -1519,17 +1559,21 @@
         'src/cpp/client/create_channel_posix.cc',
         'src/cpp/client/credentials_cc.cc',
         'src/cpp/client/generic_stub.cc',
+        'src/cpp/client/generic_unary_batcher.cc',
         'src/cpp/common/alarm.cc',
+        'src/cpp/common/call_timeline_cc.cc',
         'src/cpp/common/channel_arguments.cc',
         'src/cpp/common/channel_filter.cc',
         'src/cpp/common/completion_queue_cc.cc',
         'src/cpp/common/core_codegen.cc',
+        'src/cpp/common/event_trace.cc',
         'src/cpp/common/resource_quota_cc.cc',
         'src/cpp/common/rpc_method.cc',
         'src/cpp/common/validate_service_config.cc',
         'src/cpp/common/version_cc.cc',
         'src/cpp/server/async_generic_service.cc',
         'src/cpp/server/channel_argument_option.cc',
+        'src/cpp/server/concurrency_limiter.cc',
         'src/cpp/server/create_default_thread_pool.cc',
         'src/cpp/server/dynamic_thread_pool.cc',
         'src/cpp/server/external_connection_acceptor_impl.cc',
@@ -1542,6 +1586,7 @@
         'src/cpp/server/server_context.cc',
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
+        'src/cpp/server/work_stealing_thread_pool.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
         'src/cpp/util/status.cc',
@@ -1575,6 +1620,7 @@
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/lib/avl/avl.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -1617,6 +1663,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -1681,6 +1728,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -1732,6 +1780,7 @@
         'src/core/lib/uri/uri_parser.cc',
         'src/core/lib/debug/trace.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
+        'src/core/ext/filters/deadline/deadline_wheel.cc',
         'src/core/ext/upb-generated/src/proto/grpc/health/v1/health.upb.c',
         'src/core/ext/upb-generated/udpa/data/orca/v1/orca_load_report.upb.c',
         'src/core/ext/upb-generated/gogoproto/gogo.upb.c',
@@ -1873,17 +1922,21 @@
         'src/cpp/client/create_channel_posix.cc',
         'src/cpp/client/credentials_cc.cc',
         'src/cpp/client/generic_stub.cc',
+        'src/cpp/client/generic_unary_batcher.cc',
         'src/cpp/common/alarm.cc',
+        'src/cpp/common/call_timeline_cc.cc',
         'src/cpp/common/channel_arguments.cc',
         'src/cpp/common/channel_filter.cc',
         'src/cpp/common/completion_queue_cc.cc',
         'src/cpp/common/core_codegen.cc',
+        'src/cpp/common/event_trace.cc',
         'src/cpp/common/resource_quota_cc.cc',
         'src/cpp/common/rpc_method.cc',
         'src/cpp/common/validate_service_config.cc',
         'src/cpp/common/version_cc.cc',
         'src/cpp/server/async_generic_service.cc',
         'src/cpp/server/channel_argument_option.cc',
+        'src/cpp/server/concurrency_limiter.cc',
         'src/cpp/server/create_default_thread_pool.cc',
         'src/cpp/server/dynamic_thread_pool.cc',
         'src/cpp/server/external_connection_acceptor_impl.cc',
@@ -1896,6 +1949,7 @@
         'src/cpp/server/server_context.cc',
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
+        'src/cpp/server/work_stealing_thread_pool.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
         'src/cpp/util/status.cc',
@@ -1929,6 +1983,7 @@
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/lib/avl/avl.cc',
         'src/core/lib/backoff/backoff.cc',
+        'src/core/lib/channel/call_timeline.cc',
         'src/core/lib/channel/channel_args.cc',
         'src/core/lib/channel/channel_stack.cc',
         'src/core/lib/channel/channel_stack_builder.cc',
@@ -1971,6 +2026,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -2035,6 +2091,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -2086,6 +2143,7 @@
         'src/core/lib/uri/uri_parser.cc',
         'src/core/lib/debug/trace.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
+        'src/core/ext/filters/deadline/deadline_wheel.cc',
         'src/core/ext/upb-generated/src/proto/grpc/health/v1/health.upb.c',
         'src/core/ext/upb-generated/udpa/data/orca/v1/orca_load_report.upb.c',
         'src/core/ext/upb-generated/gogoproto/gogo.upb.c',
@@ -2278,6 +2336,7 @@
         'test/cpp/qps/client_async.cc',
         'test/cpp/qps/client_callback.cc',
         'test/cpp/qps/client_sync.cc',
+        'test/cpp/qps/cpu_affinity.cc',
         'test/cpp/qps/driver.cc',
         'test/cpp/qps/parse_json.cc',
         'test/cpp/qps/qps_server_builder.cc',
@@ -2723,6 +2782,7 @@
         'test/core/end2end/tests/retry_disabled.cc',
         'test/core/end2end/tests/retry_exceeds_buffer_size_in_initial_batch.cc',
         'test/core/end2end/tests/retry_exceeds_buffer_size_in_subsequent_batch.cc',
+        'test/core/end2end/tests/retry_hedging.cc',
         'test/core/end2end/tests/retry_non_retriable_status.cc',
         'test/core/end2end/tests/retry_non_retriable_status_before_recv_trailing_metadata_started.cc',
         'test/core/end2end/tests/retry_recv_initial_metadata.cc',
@@ -2813,6 +2873,7 @@
         'test/core/end2end/tests/retry_disabled.cc',
         'test/core/end2end/tests/retry_exceeds_buffer_size_in_initial_batch.cc',
         'test/core/end2end/tests/retry_exceeds_buffer_size_in_subsequent_batch.cc',
+        'test/core/end2end/tests/retry_hedging.cc',
         'test/core/end2end/tests/retry_non_retriable_status.cc',
         'test/core/end2end/tests/retry_non_retriable_status_before_recv_trailing_metadata_started.cc',
         'test/core/end2end/tests/retry_recv_initial_metadata.cc',
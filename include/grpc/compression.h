@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include <grpc/impl/codegen/compression_types.h>
+#include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/slice.h>
 
 #ifdef __cplusplus
@@ -68,6 +69,26 @@ GRPCAPI void grpc_compression_options_disable_algorithm(
 GRPCAPI int grpc_compression_options_is_algorithm_enabled(
     const grpc_compression_options* opts, grpc_compression_algorithm algorithm);
 
+/** Creates a set of \a count preset dictionaries for the deflate compression
+ * algorithm, to be passed to channels and servers with the
+ * GRPC_COMPRESSION_CHANNEL_DEFLATE_DICTIONARIES channel argument. Each
+ * dictionary is identified by its Adler-32 checksum, which deflate streams
+ * carry: dictionaries whose checksum is already in the set are ignored. Only
+ * the last 32KB of a dictionary are used, so it should end with the content
+ * most likely to appear in messages. The set takes its own references to
+ * \a dictionaries. */
+GRPCAPI grpc_compression_dictionaries* grpc_compression_dictionaries_create(
+    const grpc_slice* dictionaries, size_t count);
+
+/** Releases a reference to \a dictionaries. */
+GRPCAPI void grpc_compression_dictionaries_unref(
+    grpc_compression_dictionaries* dictionaries);
+
+/** Fetch a vtable for a grpc_channel_arg that points to a set of compression
+ * dictionaries */
+GRPCAPI const grpc_arg_pointer_vtable* grpc_compression_dictionaries_arg_vtable(
+    void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -136,6 +136,19 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
                                               gpr_timespec deadline,
                                               void* reserved);
 
+/** Like grpc_completion_queue_next, but once the first event is available also
+    takes up to max_events - 1 others that are already queued, without waiting
+    for more.
+
+    Fills in and returns the number of entries of events, which is at least 1.
+    If events[0] has type GRPC_QUEUE_TIMEOUT or GRPC_QUEUE_SHUTDOWN it is the
+    only entry. cq must have been created with GRPC_CQ_NEXT and max_events must
+    be positive. */
+GRPCAPI int grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                             grpc_event* events, int max_events,
+                                             gpr_timespec deadline,
+                                             void* reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
@@ -41,6 +41,44 @@ extern "C" {
 /** Default compression level for the channel.
  * Its value is an int from the \a grpc_compression_level enum. */
 #define GRPC_COMPRESSION_CHANNEL_DEFAULT_LEVEL "grpc.default_compression_level"
+/** zlib level used to compress messages with the deflate and gzip
+ * algorithms: an int from 0 (no compression) to 9 (best compression), or -1
+ * for zlib's default. Low levels are much faster, for a somewhat larger
+ * output. */
+#define GRPC_COMPRESSION_CHANNEL_ZLIB_LEVEL "grpc.compression_zlib_level"
+/** Messages smaller than this many bytes are sent uncompressed, even when
+ * their call compresses messages. An int, 0 (the default) compresses messages
+ * of any size. */
+#define GRPC_COMPRESSION_CHANNEL_MIN_MESSAGE_SIZE \
+  "grpc.compression_min_message_size"
+/** Minimum savings, as a percentage of the message size, that compressing
+ * messages of a method has to bring. While recent messages of a method
+ * compressed worse than that, most of its messages are sent uncompressed, and
+ * only a sample is compressed to follow how well they compress. An int from 0
+ * (the default: always compress) to 99. */
+#define GRPC_COMPRESSION_CHANNEL_MIN_SAVINGS_PERCENT \
+  "grpc.compression_min_savings_percent"
+/** Preset dictionaries for messages compressed with the deflate algorithm.
+ * Its value is a grpc_compression_dictionaries* (use
+ * grpc_compression_dictionaries_arg_vtable() to fetch an appropriate pointer
+ * arg vtable). Both peers announce the dictionaries they have in their
+ * initial metadata, and deflate messages are compressed with the first
+ * dictionary of the channel that the peer has too. Small messages that share
+ * a lot of content with a dictionary compress much better with it. */
+#define GRPC_COMPRESSION_CHANNEL_DEFLATE_DICTIONARIES \
+  "grpc.compression_deflate_dictionaries"
+/** If 0, compressed messages received on the channel are not decompressed:
+ * they are handed to the application as received, in a byte buffer that
+ * records their compression algorithm. Reading such a buffer with a
+ * grpc_byte_buffer_reader still decompresses it, but sending it on a call
+ * that compresses messages with the same algorithm forwards its bytes
+ * unchanged, which lets proxies pass messages through without decompressing
+ * and recompressing them. The size limit on decompressed messages is not
+ * enforced for messages that are not decompressed, and messages compressed
+ * with a preset dictionary can be forwarded but not read. An int, 1
+ * (decompress) by default. */
+#define GRPC_COMPRESSION_CHANNEL_PER_MESSAGE_DECOMPRESSION \
+  "grpc.per_message_decompression"
 /** Compression algorithms supported by the channel.
  * Its value is a bitset (an int). Bits correspond to algorithms in \a
  * grpc_compression_algorithm. For example, its LSB corresponds to
@@ -76,6 +114,9 @@ typedef enum {
   GRPC_COMPRESS_LEVEL_COUNT
 } grpc_compression_level;
 
+/** A set of preset dictionaries for the deflate compression algorithm. */
+typedef struct grpc_compression_dictionaries grpc_compression_dictionaries;
+
 typedef struct grpc_compression_options {
   /** All algs are enabled by default. This option corresponds to the channel
    * argument key behind \a GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET
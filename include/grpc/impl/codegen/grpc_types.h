@@ -45,6 +45,11 @@ typedef struct grpc_byte_buffer {
       void* reserved[8];
     } reserved;
     struct grpc_compressed_buffer {
+      /** The algorithm the slices are compressed with. Unless
+          GRPC_COMPRESSION_CHANNEL_PER_MESSAGE_DECOMPRESSION is 0, received
+          messages are decompressed as they arrive: buffers returned by
+          GRPC_OP_RECV_MESSAGE hold the uncompressed message and report
+          GRPC_COMPRESS_NONE, whatever compression was used on the wire. */
       grpc_compression_algorithm compression;
       grpc_slice_buffer slice_buffer;
     } raw;
@@ -177,6 +182,12 @@ typedef struct {
 /** Enable/disable support for deadline checking. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0 */
 #define GRPC_ARG_ENABLE_DEADLINE_CHECKS "grpc.enable_deadline_checking"
+/** If non-zero, call deadlines more than a couple of seconds away wait in
+    coarse buckets shared with other calls, and only get a timer of their own
+    about a second before they expire. Saves a timer insertion and
+    cancellation for calls that finish early. Int valued, defaults to 0
+    (off). */
+#define GRPC_ARG_DEADLINE_WHEEL "grpc.deadline_wheel"
 /** Initial stream ID for http2 transports. Int valued. */
 #define GRPC_ARG_HTTP2_INITIAL_SEQUENCE_NUMBER \
   "grpc.http2.initial_sequence_number"
@@ -191,12 +202,44 @@ typedef struct {
 /** How much memory to use for hpack encoding. Int valued, bytes. */
 #define GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_ENCODER \
   "grpc.http2.hpack_table_size.encoder"
+/** If set, the hpack decoder table of a connection is shrunk to this many
+    bytes when the resource quota needs memory back, before idle connections
+    are asked to go away. The cap lasts for the lifetime of the connection.
+    Int valued, bytes. */
+#define GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER_PRESSURE \
+  "grpc.http2.hpack_table_size.decoder_pressure"
+/** If non-zero, the grpc-timeout sent with each call is rounded down to this
+    many significant figures, from 1 to 3, so that calls with similar
+    deadlines send the same value, which can then be compressed away. The
+    server sees a deadline up to 50%, 10% or 1% earlier than the client's.
+    Int valued, defaults to 0 (off). */
+#define GRPC_ARG_HTTP2_TIMEOUT_SIGNIFICANT_DIGITS \
+  "grpc.http2.timeout_significant_digits"
+/** If non-zero, an HTTP2 connection that has had no streams for this many
+    milliseconds frees the buffers and tables it keeps for later streams;
+    they are allocated again when the connection is next used.
+    Int valued, milliseconds, defaults to 0 (off). */
+#define GRPC_ARG_HTTP2_IDLE_COMPACTION_MS "grpc.http2.idle_compaction_ms"
 /** How big a frame are we willing to receive via HTTP2.
     Min 16384, max 16777215. Larger values give lower CPU usage for large
     messages, but more head of line blocking for small messages. */
 #define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
+/** If non-zero, pick the max frame size advertised to the peer from the
+    sizes of the messages it has been sending, in place of
+    GRPC_ARG_HTTP2_MAX_FRAME_SIZE or the bandwidth estimate, so bulk streams
+    get large frames and small messages keep small ones. DATA frames sent
+    while other streams are waiting to write are kept to 16384 bytes. Int
+    valued, defaults to 0 (off). */
+#define GRPC_ARG_HTTP2_ADAPTIVE_MAX_FRAME_SIZE \
+  "grpc.http2.adaptive_max_frame_size"
 /** Should BDP probing be performed? */
 #define GRPC_ARG_HTTP2_BDP_PROBE "grpc.http2.bdp_probe"
+/** If non-zero, and BDP probing is on, size the flow control windows from a
+    model of the path's bandwidth and minimum round trip time, in the style of
+    BBR, rather than from the PID controlled BDP estimate. Ramps up faster on
+    links with a high bandwidth-delay product. Windows never exceed a quarter
+    of the free resource quota. Int valued, defaults to 0 (off). */
+#define GRPC_ARG_HTTP2_BBR_AUTOTUNING "grpc.http2.bbr_autotuning"
 /** Minimum time between sending successive ping frames without receiving any
     data frame, Int valued, milliseconds. */
 #define GRPC_ARG_HTTP2_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS \
@@ -222,6 +265,22 @@ typedef struct {
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
+/** If non-zero, streams whose messages are all at most this many bytes, as
+    well as ping acks, complete their operations on the ExecCtx latency lane,
+    ahead of bulk transfers on other streams. Int valued, bytes. Defaults to 0
+    (off). */
+#define GRPC_ARG_HTTP2_LATENCY_LANE_MAX_MESSAGE_BYTES \
+  "grpc.http2.latency_lane_max_message_bytes"
+/** If non-zero, a write of fewer than GRPC_ARG_HTTP2_WRITE_COALESCE_BYTES
+    bytes on a connection that wrote less than this long ago is held back for
+    up to this long, so that the frames of other streams go out in the same
+    endpoint write. Writes on idle connections are never held back. Int valued,
+    milliseconds. Defaults to 0 (off). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCE_DELAY_MS \
+  "grpc.http2.write_coalesce_delay_ms"
+/** Writes held back by GRPC_ARG_HTTP2_WRITE_COALESCE_DELAY_MS go out as soon
+    as they reach this many bytes. Int valued, bytes. Defaults to 16384. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCE_BYTES "grpc.http2.write_coalesce_bytes"
 /** After a duration of this time the client/server pings its peer to see if the
     transport is still alive. Int valued, milliseconds. */
 #define GRPC_ARG_KEEPALIVE_TIME_MS "grpc.keepalive_time_ms"
@@ -233,6 +292,13 @@ typedef struct {
     Int valued, 0(false)/1(true). */
 #define GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS \
   "grpc.keepalive_permit_without_calls"
+/** If non-zero, the keepalive time adapts to the connection: it doubles, up
+    to eight times its configured value, each time several keepalive pings in
+    a row are acked, and a client that was sent a GOAWAY with "too_many_pings"
+    starts later connections to that peer at the doubled time it then
+    switched to. Keepalive pings are never sent while data is being received.
+    Int valued, 0(false)/1(true), defaults to 0 (off). */
+#define GRPC_ARG_KEEPALIVE_ADAPTIVE "grpc.keepalive_adaptive"
 /** Default authority to pass if none specified on call construction. A string.
  * */
 #define GRPC_ARG_DEFAULT_AUTHORITY "grpc.default_authority"
@@ -249,12 +315,52 @@ typedef struct {
 /** The time between the first and second connection attempts, in ms */
 #define GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS \
   "grpc.initial_reconnect_backoff_ms"
+/** If non-zero, subchannels with the same address and channel args share a
+    reconnect backoff: once one of them fails to connect, the others wait for
+    its retry time too, so that a restarted backend is not hit by all of them
+    at once. Boolean valued. Defaults to 0. */
+#define GRPC_ARG_SHARED_RECONNECT_BACKOFF \
+  "grpc.experimental.shared_reconnect_backoff"
+/** The maximum number of connections a subchannel opens to its address. Once
+    every connection carries GRPC_ARG_SUBCHANNEL_CALLS_PER_CONNECTION calls,
+    the subchannel opens another one and spreads new calls over all of them.
+    Extra connections are closed after they have been idle for a while. Int
+    valued. Defaults to 1. */
+#define GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS "grpc.subchannel_max_connections"
+/** The number of calls in flight on each connection of a subchannel past
+    which it opens another connection, as allowed by
+    GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS. Should usually match the server's
+    MAX_CONCURRENT_STREAMS. Int valued. Defaults to 100. */
+#define GRPC_ARG_SUBCHANNEL_CALLS_PER_CONNECTION \
+  "grpc.subchannel_calls_per_connection"
 /** Minimum amount of time between DNS resolutions, in ms */
 #define GRPC_ARG_DNS_MIN_TIME_BETWEEN_RESOLUTIONS_MS \
   "grpc.dns_min_time_between_resolutions_ms"
+/** If non-zero, DNS resolvers re-resolve in the background this many ms after
+    each successful resolution, and only return the new result to the channel
+    if the addresses or service config changed. Should be a little below the
+    TTL of the records being resolved. Int valued. Defaults to 0 (disabled). */
+#define GRPC_ARG_DNS_REFRESH_INTERVAL_MS "grpc.dns_refresh_interval_ms"
+/** If non-zero, the channel hands resolver results to the LB policy at most
+    once per this many ms; results that arrive in between are coalesced, and
+    only the latest one is delivered when the interval is over. Int valued.
+    Defaults to 0 (each result is delivered when it arrives). */
+#define GRPC_ARG_RESOLVER_RESULT_DEBOUNCE_MS "grpc.resolver_result_debounce_ms"
 /** The timeout used on servers for finishing handshaking on an incoming
     connection.  Defaults to 120 seconds. */
 #define GRPC_ARG_SERVER_HANDSHAKE_TIMEOUT_MS "grpc.server_handshake_timeout_ms"
+/** If non-zero, the server sheds load CoDel-style: once calls have waited at
+    least this many ms for the application to request them throughout an
+    interval, queued calls that waited over twice as long are failed with
+    RESOURCE_EXHAUSTED instead of being handed out. Int valued. Defaults to 0
+    (disabled). */
+#define GRPC_ARG_SERVER_LOAD_SHEDDING_TARGET_DELAY_MS \
+  "grpc.server_load_shedding_target_delay_ms"
+/** The interval over which the minimum queueing delay is compared against
+    GRPC_ARG_SERVER_LOAD_SHEDDING_TARGET_DELAY_MS. Int valued, in ms.
+    Defaults to 100. */
+#define GRPC_ARG_SERVER_LOAD_SHEDDING_INTERVAL_MS \
+  "grpc.server_load_shedding_interval_ms"
 /** This *should* be used for testing only.
     The caller of the secure_channel_create functions may override the target
     name used for SSL host name checking using this channel argument which is of
@@ -275,15 +381,48 @@ typedef struct {
  *        can break old binaries that don't support larger than 1MiB frame
  *        size. */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, once a TLS handshake completes on a TCP connection, the
+    encryption of outgoing records is handed to the kernel (Linux kernel TLS),
+    so that writes bypass the user-space frame protector. Falls back to the
+    frame protector when the kernel, the TLS library or the negotiated cipher
+    suite does not support it. Defaults to 0. */
+#define GRPC_ARG_TSI_KERNEL_TLS_TX "grpc.tsi.kernel_tls_tx"
+/** If non-zero, the steps of security handshakes (e.g. the TLS key exchange
+    and signatures) run on a dedicated, bounded executor rather than on the
+    thread that read the handshake bytes, which is often a polling thread. The
+    executor's size is set by the GRPC_HANDSHAKER_THREADS environment variable.
+    Defaults to 0. */
+#define GRPC_ARG_HANDSHAKER_OFFLOAD "grpc.handshaker_offload"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
 /** If non-zero, allow the use of SO_REUSEPORT if it's available (default 1) */
 #define GRPC_ARG_ALLOW_REUSEPORT "grpc.so_reuseport"
+/** If non-zero, open this many SO_REUSEPORT listeners per port, each tied to
+    one of the server's pollsets (completion queues), and poll the connections
+    a listener accepts on its own pollset rather than spreading them across all
+    of them. -1 opens one listener per core. The default, 0, keeps the previous
+    behaviour of one listener per pollset. Has no effect if SO_REUSEPORT is not
+    in use. Only polling engines that poll fds per pollset (epollex and poll)
+    keep connections on one pollset; epoll1 polls every fd from one shared
+    epoll set, so there the option only spreads accepts over the listeners. */
+#define GRPC_ARG_REUSEPORT_LISTENERS_PER_PORT \
+  "grpc.so_reuseport_listeners_per_port"
+/** If non-zero, use TCP Fast Open where the platform supports it. Clients
+    then send the first bytes of a connection, such as the HTTP/2 preface or
+    a TLS ClientHello, with the SYN once the server has handed out a cookie.
+    Servers accept that many pending fast open connections per listener.
+    Int valued, defaults to 0 (off). */
+#define GRPC_ARG_TCP_FAST_OPEN "grpc.tcp_fast_open"
 /** If non-zero, a pointer to a buffer pool (a pointer of type
  * grpc_resource_quota*). (use grpc_resource_quota_arg_vtable() to fetch an
  * appropriate pointer arg vtable) */
 #define GRPC_ARG_RESOURCE_QUOTA "grpc.resource_quota"
+/** How many bytes of storage of the arenas of finished calls a channel may
+    keep for reuse by new calls, instead of freeing it. The bytes are charged
+    against the channel's resource quota (if any) up front. Defaults to 0,
+    which disables the pool. */
+#define GRPC_ARG_CALL_ARENA_POOL_SIZE "grpc.call_arena_pool_size"
 /** If non-zero, expand wildcard addresses to a list of local addresses. */
 #define GRPC_ARG_EXPAND_WILDCARD_ADDRS "grpc.expand_wildcard_addrs"
 /** Service config data in JSON form.
@@ -308,6 +447,11 @@ typedef struct {
  * level. Disabling channelz naturally disables channel tracing. The default
  * is for channelz to be enabled. */
 #define GRPC_ARG_ENABLE_CHANNELZ "grpc.enable_channelz"
+/** If greater than 1, channelz counts only one call in this many and scales
+ * the call counts it reports back up, trading exact counts for less
+ * per-call work. The default is 1, counting every call. */
+#define GRPC_ARG_CHANNELZ_CALL_SAMPLING_PERIOD \
+  "grpc.channelz_call_sampling_period"
 /** If non-zero, Cronet transport will coalesce packets to fewer frames
  * when possible. */
 #define GRPC_ARG_USE_CRONET_PACKET_COALESCING \
@@ -323,6 +467,32 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/** If non-zero, the TCP endpoint sends large writes with MSG_ZEROCOPY instead
+ * of copying them into the kernel. Only effective on Linux 4.14+ with a
+ * polling engine that can track socket errors. Defaults to 0 (disabled). */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_tx_zerocopy_enabled"
+/** Channel arg (integer) setting the minimum size, in bytes, of a write for it
+ * to be sent with MSG_ZEROCOPY. Smaller writes are copied as usual. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_tx_zerocopy_send_bytes_threshold"
+/** Channel arg (integer) setting the maximum number of zerocopy writes that may
+ * be waiting for kernel completion notifications on one connection. Further
+ * writes are copied until a notification arrives. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
+  "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/** Channel arg (integer): runs of consecutive slices shorter than this many
+ * bytes are copied into a per-connection buffer before sendmsg, so that each
+ * run takes a single iovec. Defaults to 0, which disables the copying; 256
+ * covers HPACK frames, frame headers and small messages. */
+#define GRPC_ARG_TCP_TX_COALESCE_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_tx_coalesce_bytes_threshold"
+/** Channel arg (integer) enabling busy polling, in microseconds, for the
+ * connections of a channel or server. Their sockets get SO_BUSY_POLL (and
+ * SO_PREFER_BUSY_POLL where supported) set to this value, and while any of them
+ * is open the epoll1 polling engine polls without blocking for up to this long
+ * before it blocks. This trades CPU for wakeup latency. Defaults to 0 (off). */
+#define GRPC_ARG_TCP_BUSY_POLL_US "grpc.experimental.tcp_busy_poll_us"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -398,6 +568,10 @@ typedef struct {
 #define GRPC_ARG_CHANNEL_POOL_DOMAIN "grpc.channel_pooling_domain"
 /** gRPC Objective-C channel pooling id. */
 #define GRPC_ARG_CHANNEL_ID "grpc.channel_id"
+/** If non-zero, C++ calls on an in-process channel hand messages of types
+ * that specialize grpc::experimental::InprocMessagePassthrough to the server
+ * as objects instead of serializing them. Defaults to 0. */
+#define GRPC_ARG_INPROC_MESSAGE_PASSTHROUGH "grpc.inproc_message_passthrough"
 /** \} */
 
 /** Result of a grpc call. If the caller satisfies the prerequisites of a
@@ -637,7 +811,8 @@ typedef struct grpc_op {
     /** ownership of the byte buffer is moved to the caller; the caller must
         call grpc_byte_buffer_destroy on this value, or reuse it in a future op.
         The returned byte buffer will be NULL if trailing metadata was
-        received instead of a message.
+        received instead of a message. By default it holds the message
+        uncompressed, see grpc_byte_buffer.
        */
     struct grpc_op_recv_message {
       struct grpc_byte_buffer** recv_message;
@@ -735,9 +910,9 @@ typedef struct grpc_experimental_completion_queue_functor {
   struct grpc_experimental_completion_queue_functor* internal_next;
 } grpc_experimental_completion_queue_functor;
 
-/* The upgrade to version 2 is currently experimental. */
+/* The upgrades to versions 2 and 3 are currently experimental. */
 
-#define GRPC_CQ_CURRENT_VERSION 2
+#define GRPC_CQ_CURRENT_VERSION 3
 #define GRPC_CQ_VERSION_MINIMUM_FOR_CALLBACKABLE 2
 typedef struct grpc_completion_queue_attributes {
   /** The version number of this structure. More fields might be added to this
@@ -756,6 +931,15 @@ typedef struct grpc_completion_queue_attributes {
   grpc_experimental_completion_queue_functor* cq_shutdown_cb;
 
   /* END OF VERSION 2 CQ ATTRIBUTES */
+
+  /* EXPERIMENTAL: START OF VERSION 3 CQ ATTRIBUTES */
+  /** For GRPC_CQ_NEXT only: the number of sub-queues to split the queue's
+   * events across. Each thread calling grpc_completion_queue_next gets a
+   * sub-queue it serves first, and takes events from the others only when its
+   * own is empty. Values of 1 or less (the default) mean a single queue. */
+  int cq_num_shards;
+
+  /* END OF VERSION 3 CQ ATTRIBUTES */
 } grpc_completion_queue_attributes;
 
 /** The completion queue factory structure is opaque to the callers of grpc */
@@ -78,6 +78,7 @@ class Channel final : public ::grpc::ChannelInterface,
           ::grpc::experimental::ClientInterceptorFactoryInterface>>
           interceptor_creators);
   friend class ::grpc::internal::InterceptedChannel;
+  friend class ::grpc_impl::Server;
   Channel(const grpc::string& host, grpc_channel* c_channel,
           std::vector<std::unique_ptr<
               ::grpc::experimental::ClientInterceptorFactoryInterface>>
@@ -119,6 +120,10 @@ class Channel final : public ::grpc::ChannelInterface,
   std::vector<
       std::unique_ptr<::grpc::experimental::ClientInterceptorFactoryInterface>>
       interceptor_creators_;
+
+  // Whether calls may hand messages to the server as objects, see
+  // GRPC_ARG_INPROC_MESSAGE_PASSTHROUGH. Only set on in-process channels.
+  bool message_passthrough_ = false;
 };
 
 }  // namespace grpc_impl
@@ -51,6 +51,14 @@ CreateCustomChannelWithInterceptors(
       target, creds, args, std::move(interceptor_creators));
 }
 
+static inline std::shared_ptr<::grpc::ChannelInterface> CreateCustomChannelPool(
+    const grpc::string& target,
+    const std::shared_ptr<ChannelCredentials>& creds,
+    const ChannelArguments& args, size_t pool_size) {
+  return ::grpc_impl::experimental::CreateCustomChannelPool(target, creds, args,
+                                                           pool_size);
+}
+
 }  // namespace experimental
 }  // namespace grpc
 
@@ -72,6 +72,25 @@ std::shared_ptr<::grpc::Channel> CreateCustomChannelWithInterceptors(
     std::vector<
         std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
         interceptor_creators);
+
+/// Create a pool of \a pool_size channels to \a target, each with its own
+/// subchannels and thus its own connections, behind a single
+/// ChannelInterface that stubs can be created on. Calls are spread over the
+/// channels round robin, which spreads the per-connection transport work
+/// of a busy client over several connections.
+///
+/// Connectivity state queries and watches are answered by the first channel
+/// of the pool; asking for the state with \a try_to_connect connects them
+/// all.
+///
+/// \param target The URI of the endpoint to connect to.
+/// \param creds Credentials to use for the created channels.
+/// \param args Options for the creation of each channel.
+/// \param pool_size Number of channels in the pool, at least 1.
+std::shared_ptr<::grpc::ChannelInterface> CreateCustomChannelPool(
+    const grpc::string& target,
+    const std::shared_ptr<grpc::ChannelCredentials>& creds,
+    const ::grpc::ChannelArguments& args, size_t pool_size);
 }  // namespace experimental
 }  // namespace grpc_impl
 
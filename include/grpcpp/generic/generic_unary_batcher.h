@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_GENERIC_GENERIC_UNARY_BATCHER_H
+#define GRPCPP_GENERIC_GENERIC_UNARY_BATCHER_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/codegen/channel_interface.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/config.h>
+#include <grpcpp/support/status.h>
+
+namespace grpc {
+namespace experimental {
+
+/// Coalesces the unary calls made through it within a short window into a
+/// single bidi-streaming call, so that a burst of small requests pays for one
+/// call (headers, stream and trailers) instead of one per request.
+///
+/// The requests of a batch are sent as the messages of one call to the
+/// bidi-streaming method given to the constructor. That method must answer
+/// each request with exactly one response, in the order of the requests, and
+/// finish the call once the client has half-closed it. Each response is handed
+/// to its caller as soon as it is read. If the call fails, the callers that
+/// did not get a response get its status.
+class GenericUnaryBatcher {
+ public:
+  struct Options {
+    /// A batch is sent as soon as it has this many requests...
+    size_t max_batch_size = 32;
+    /// ... or once its first request has waited this long.
+    std::chrono::microseconds max_delay = std::chrono::microseconds(500);
+    /// If set, called on the context of each batch call before it starts,
+    /// e.g. to set a deadline or metadata.
+    std::function<void(ClientContext*)> configure_context;
+  };
+
+  GenericUnaryBatcher(std::shared_ptr<ChannelInterface> channel,
+                      const grpc::string& method);
+  GenericUnaryBatcher(std::shared_ptr<ChannelInterface> channel,
+                      const grpc::string& method, const Options& options);
+
+  /// Sends the pending requests right away. Calls in flight are not affected.
+  ~GenericUnaryBatcher();
+
+  /// Adds \a request to the current batch. Once the response is read into
+  /// \a response, or the batch call fails, \a on_done is called with the
+  /// status of this request, on a thread of the library. \a response must
+  /// remain valid until then.
+  void Call(const ByteBuffer& request, ByteBuffer* response,
+            std::function<void(Status)> on_done);
+
+  /// Sends the requests of the current batch without waiting any longer.
+  void Flush();
+
+ private:
+  class Batch;
+  struct State;
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_GENERIC_GENERIC_UNARY_BATCHER_H
@@ -58,6 +58,8 @@ template <class R>
 class CallOpRecvMessage;
 class CallOpGenericRecvMessage;
 class ExternalConnectionAcceptorImpl;
+class MessagePassthrough;
+class ProtoFieldSplitter;
 template <class R>
 class DeserializeFuncType;
 class GrpcByteBufferPeer;
@@ -95,6 +97,17 @@ class ByteBuffer final {
         reinterpret_cast<grpc_slice*>(const_cast<Slice*>(slices)), nslices);
   }
 
+  /// Construct a buffer over \a length bytes at \a data owned by the caller,
+  /// without copying them. \a release is called with \a user_data once the
+  /// library, and every buffer sharing the bytes, is done with them.
+  ByteBuffer(void* data, size_t length, void (*release)(void*),
+             void* user_data)
+      : buffer_(nullptr) {
+    Slice slice(data, length, release, user_data);
+    buffer_ = g_core_codegen_interface->grpc_raw_byte_buffer_create(
+        &slice.slice_, 1);
+  }
+
   /// Constuct a byte buffer by referencing elements of existing buffer
   /// \a buf. Wrapper of core function grpc_byte_buffer_copy . This is not
   /// a deep copy; it is just a referencing. As a result, its performance is
@@ -124,6 +137,32 @@ class ByteBuffer final {
   /// Dump (read) the buffer contents into \a slices.
   Status Dump(std::vector<Slice>* slices) const;
 
+  /// Call \a f(const uint8_t* data, size_t length) on each slice of the
+  /// buffer, in order. The slices are read in place, without copies, refs or
+  /// allocations, and are only valid for the duration of the call. A buffer
+  /// that was left compressed (see compression_algorithm()) is decompressed
+  /// first, as Dump() does.
+  template <class F>
+  Status ForEachSlice(F f) const {
+    if (buffer_ == nullptr) {
+      return Status(StatusCode::FAILED_PRECONDITION, "Buffer not initialized");
+    }
+    if (buffer_->data.raw.compression != GRPC_COMPRESS_NONE) {
+      std::vector<Slice> slices;
+      Status s = Dump(&slices);
+      for (const Slice& slice : slices) {
+        f(slice.begin(), slice.size());
+      }
+      return s;
+    }
+    const grpc_slice_buffer& slices = buffer_->data.raw.slice_buffer;
+    for (size_t i = 0; i < slices.count; i++) {
+      f(GRPC_SLICE_START_PTR(slices.slices[i]),
+        GRPC_SLICE_LENGTH(slices.slices[i]));
+    }
+    return Status::OK;
+  }
+
   /// Remove all data.
   void Clear() {
     if (buffer_) {
@@ -162,6 +201,17 @@ class ByteBuffer final {
   /// Is this ByteBuffer valid?
   bool Valid() const { return (buffer_ != nullptr); }
 
+  /// The algorithm the bytes of the buffer are compressed with. Only messages
+  /// received on a channel or server with
+  /// GRPC_COMPRESSION_CHANNEL_PER_MESSAGE_DECOMPRESSION set to 0 are left
+  /// compressed. Length() is then the compressed length, and Dump() and
+  /// deserialization still see the uncompressed message. Writing the buffer
+  /// on a call that compresses with the same algorithm sends it as it is.
+  grpc_compression_algorithm compression_algorithm() const {
+    return buffer_ == nullptr ? GRPC_COMPRESS_NONE
+                              : buffer_->data.raw.compression;
+  }
+
  private:
   friend class SerializationTraits<ByteBuffer, void>;
   friend class ServerInterface;
@@ -185,6 +235,8 @@ class ByteBuffer final {
   friend class ProtoBufferWriter;
   friend class internal::GrpcByteBufferPeer;
   friend class internal::ExternalConnectionAcceptorImpl;
+  friend class internal::MessagePassthrough;
+  friend class internal::ProtoFieldSplitter;
 
   grpc_byte_buffer* buffer_;
 
@@ -82,6 +82,13 @@ class Call final {
     return server_rpc_info_;
   }
 
+  /// Whether messages of this call may be handed to the peer as objects, see
+  /// experimental::InprocMessagePassthrough.
+  bool message_passthrough() const { return message_passthrough_; }
+  void set_message_passthrough(bool message_passthrough) {
+    message_passthrough_ = message_passthrough;
+  }
+
  private:
   CallHook* call_hook_;
   ::grpc_impl::CompletionQueue* cq_;
@@ -89,6 +96,7 @@ class Call final {
   int max_receive_message_size_;
   experimental::ClientRpcInfo* client_rpc_info_ = nullptr;
   experimental::ServerRpcInfo* server_rpc_info_ = nullptr;
+  bool message_passthrough_ = false;
 };
 }  // namespace internal
 }  // namespace grpc
@@ -36,6 +36,7 @@
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/codegen/intercepted_channel.h>
 #include <grpcpp/impl/codegen/interceptor_common.h>
+#include <grpcpp/impl/codegen/message_passthrough.h>
 #include <grpcpp/impl/codegen/serialization_traits.h>
 #include <grpcpp/impl/codegen/slice.h>
 #include <grpcpp/impl/codegen/string_ref.h>
@@ -211,6 +212,8 @@ class CallNoOp {
       InterceptorBatchMethodsImpl* /*interceptor_methods*/) {}
   void SetHijackingState(InterceptorBatchMethodsImpl* /*interceptor_methods*/) {
   }
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() {}
 };
 
 class CallOpSendInitialMetadata {
@@ -271,6 +274,9 @@ class CallOpSendInitialMetadata {
     hijacked_ = true;
   }
 
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() {}
+
   bool hijacked_ = false;
   bool send_;
   uint32_t flags_;
@@ -341,6 +347,7 @@ class CallOpSendMessage {
   void SetInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
     if (msg_ == nullptr && !send_buf_.Valid()) return;
+    message_passthrough_ = interceptor_methods->MessagePassthroughAllowed();
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::PRE_SEND_MESSAGE);
     interceptor_methods->SetSendMessage(&send_buf_, &msg_, &failed_send_,
@@ -365,10 +372,23 @@ class CallOpSendMessage {
     hijacked_ = true;
   }
 
+  void SkipInterceptionHookPoint(Call* call) {
+    if (msg_ == nullptr && !send_buf_.Valid()) return;
+    message_passthrough_ = call->message_passthrough();
+  }
+
+  void SkipFinishInterceptionHookPoint() {
+    send_buf_.Clear();
+    msg_ = nullptr;
+  }
+
  private:
   const void* msg_ = nullptr;  // The original non-serialized message
   bool hijacked_ = false;
   bool failed_send_ = false;
+  // Whether msg_ may be handed to the peer as an object, see
+  // experimental::InprocMessagePassthrough
+  bool message_passthrough_ = false;
   ByteBuffer send_buf_;
   WriteOptions write_options_;
   std::function<Status(const void*)> serializer_;
@@ -380,6 +400,13 @@ Status CallOpSendMessage::SendMessage(const M& message, WriteOptions options) {
   serializer_ = [this](const void* message) {
     bool own_buf;
     send_buf_.Clear();
+    if (experimental::InprocMessagePassthrough<M>::value &&
+        message_passthrough_) {
+      // The bytes are a pointer, there's nothing to compress
+      write_options_.set_no_compression();
+      return MessagePassthrough::Serialize(*static_cast<const M*>(message),
+                                           send_buf_.bbuf_ptr());
+    }
     // TODO(vjpai): Remove the void below when possible
     // The void in the template parameter below should not be needed
     // (since it should be implicit) but is needed due to an observed
@@ -448,7 +475,7 @@ class CallOpRecvMessage {
     if (recv_buf_.Valid()) {
       if (*status) {
         got_message = *status =
-            SerializationTraits<R>::Deserialize(recv_buf_.bbuf_ptr(), message_)
+            MessagePassthrough::Deserialize(recv_buf_.bbuf_ptr(), message_)
                 .ok();
         recv_buf_.Release();
       } else {
@@ -484,6 +511,9 @@ class CallOpRecvMessage {
     got_message = true;
   }
 
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() {}
+
  private:
   R* message_;
   ByteBuffer recv_buf_;
@@ -502,7 +532,7 @@ class DeserializeFuncType final : public DeserializeFunc {
  public:
   DeserializeFuncType(R* message) : message_(message) {}
   Status Deserialize(ByteBuffer* buf) override {
-    return SerializationTraits<R>::Deserialize(buf->bbuf_ptr(), message_);
+    return MessagePassthrough::Deserialize(buf->bbuf_ptr(), message_);
   }
 
   ~DeserializeFuncType() override {}
@@ -581,6 +611,9 @@ class CallOpGenericRecvMessage {
     got_message = true;
   }
 
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() { deserialize_.reset(); }
+
  private:
   void* message_;
   bool hijacked_ = false;
@@ -619,6 +652,9 @@ class CallOpClientSendClose {
     hijacked_ = true;
   }
 
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() {}
+
  private:
   bool hijacked_ = false;
   bool send_;
@@ -679,6 +715,9 @@ class CallOpServerSendStatus {
     hijacked_ = true;
   }
 
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() {}
+
  private:
   bool hijacked_ = false;
   bool send_status_available_;
@@ -734,6 +773,9 @@ class CallOpRecvInitialMetadata {
         experimental::InterceptionHookPoints::PRE_RECV_INITIAL_METADATA);
   }
 
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() { metadata_map_ = nullptr; }
+
  private:
   bool hijacked_ = false;
   MetadataMap* metadata_map_;
@@ -808,6 +850,9 @@ class CallOpClientRecvStatus {
         experimental::InterceptionHookPoints::PRE_RECV_STATUS);
   }
 
+  void SkipInterceptionHookPoint(Call* /*call*/) {}
+  void SkipFinishInterceptionHookPoint() { recv_status_ = nullptr; }
+
  private:
   bool hijacked_ = false;
   ::grpc_impl::ClientContext* client_context_;
@@ -847,6 +892,7 @@ class CallOpSet : public CallOpSetInterface,
         return_tag_(this),
         call_(other.call_),
         done_intercepting_(false),
+        intercepted_(true),
         interceptor_methods_(InterceptorBatchMethodsImpl()) {}
 
   CallOpSet& operator=(const CallOpSet& other) {
@@ -854,6 +900,7 @@ class CallOpSet : public CallOpSetInterface,
     return_tag_ = this;
     call_ = other.call_;
     done_intercepting_ = false;
+    intercepted_ = true;
     interceptor_methods_ = InterceptorBatchMethodsImpl();
     return *this;
   }
@@ -962,18 +1009,27 @@ class CallOpSet : public CallOpSetInterface,
  private:
   // Returns true if no interceptors need to be run
   bool RunInterceptors() {
+    interceptor_methods_.SetCall(&call_);
+    intercepted_ = !interceptor_methods_.InterceptorsListEmpty();
+    if (!intercepted_) {
+      // Calls without interceptors, the common case, skip the hook point
+      // bookkeeping for this batch altogether
+      this->Op1::SkipInterceptionHookPoint(&call_);
+      this->Op2::SkipInterceptionHookPoint(&call_);
+      this->Op3::SkipInterceptionHookPoint(&call_);
+      this->Op4::SkipInterceptionHookPoint(&call_);
+      this->Op5::SkipInterceptionHookPoint(&call_);
+      this->Op6::SkipInterceptionHookPoint(&call_);
+      return true;
+    }
     interceptor_methods_.ClearState();
     interceptor_methods_.SetCallOpSetInterface(this);
-    interceptor_methods_.SetCall(&call_);
     this->Op1::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op2::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op3::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op4::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op5::SetInterceptionHookPoint(&interceptor_methods_);
     this->Op6::SetInterceptionHookPoint(&interceptor_methods_);
-    if (interceptor_methods_.InterceptorsListEmpty()) {
-      return true;
-    }
     // This call will go through interceptors and would need to
     // schedule new batches, so delay completion queue shutdown
     call_.cq()->RegisterAvalanching();
@@ -981,6 +1037,15 @@ class CallOpSet : public CallOpSetInterface,
   }
   // Returns true if no interceptors need to be run
   bool RunInterceptorsPostRecv() {
+    if (!intercepted_) {
+      this->Op1::SkipFinishInterceptionHookPoint();
+      this->Op2::SkipFinishInterceptionHookPoint();
+      this->Op3::SkipFinishInterceptionHookPoint();
+      this->Op4::SkipFinishInterceptionHookPoint();
+      this->Op5::SkipFinishInterceptionHookPoint();
+      this->Op6::SkipFinishInterceptionHookPoint();
+      return true;
+    }
     // Call and OpSet had already been set on the set state.
     // SetReverse also clears previously set hook points
     interceptor_methods_.SetReverse();
@@ -997,6 +1062,9 @@ class CallOpSet : public CallOpSetInterface,
   void* return_tag_;
   Call call_;
   bool done_intercepting_ = false;
+  // Whether the current batch goes through interceptors. Stays true for a
+  // set that is finalized without having been filled.
+  bool intercepted_ = true;
   InterceptorBatchMethodsImpl interceptor_methods_;
   bool saved_status_;
 };
@@ -58,6 +58,7 @@ namespace grpc {
 class ChannelInterface;
 
 namespace experimental {
+class ChannelPool;
 class DelegatingChannel;
 }
 
@@ -132,6 +133,7 @@ class ChannelInterface {
   template <class InputMessage, class OutputMessage>
   friend class ::grpc_impl::internal::CallbackUnaryCallImpl;
   friend class ::grpc::internal::RpcMethod;
+  friend class ::grpc::experimental::ChannelPool;
   friend class ::grpc::experimental::DelegatingChannel;
   friend class ::grpc::internal::InterceptedChannel;
   virtual internal::Call CreateCall(const internal::RpcMethod& method,
@@ -49,7 +49,7 @@ void CallbackUnaryCall(::grpc::ChannelInterface* channel,
                        const InputMessage* request, OutputMessage* result,
                        std::function<void(::grpc::Status)> on_completion) {
   CallbackUnaryCallImpl<InputMessage, OutputMessage> x(
-      channel, method, context, request, result, on_completion);
+      channel, method, context, request, result, std::move(on_completion));
 }
 
 template <class InputMessage, class OutputMessage>
@@ -72,6 +72,9 @@ class CallbackUnaryCallImpl {
         grpc::internal::CallOpClientSendClose,
         grpc::internal::CallOpClientRecvStatus>;
 
+    // The ops and the tag, including the user callback, live in the call
+    // arena. The callback is moved all the way in, so a callback that fits
+    // in std::function's inline storage costs no heap allocation at all.
     struct OpSetAndTag {
       FullCallOpSet opset;
       grpc::internal::CallbackWithStatusTag tag;
@@ -82,7 +85,8 @@ class CallbackUnaryCallImpl {
                                                                 alloc_sz));
     auto* ops = new (&alloced->opset) FullCallOpSet;
     auto* tag = new (&alloced->tag)
-        grpc::internal::CallbackWithStatusTag(call.call(), on_completion, ops);
+        grpc::internal::CallbackWithStatusTag(call.call(),
+                                              std::move(on_completion), ops);
 
     // TODO(vjpai): Unify code with sync API as much as possible
     ::grpc::Status s = ops->SendMessagePtr(request);
@@ -29,7 +29,8 @@
 /// compression options, can be made persistent at channel construction time
 /// (see \a grpc::CreateCustomChannel).
 ///
-/// \warning ClientContext instances should \em not be reused across rpcs.
+/// \warning ClientContext instances should \em not be reused across rpcs,
+///          unless \a Reset is called in between.
 
 #ifndef GRPCPP_IMPL_CODEGEN_CLIENT_CONTEXT_IMPL_H
 #define GRPCPP_IMPL_CODEGEN_CLIENT_CONTEXT_IMPL_H
@@ -52,6 +53,7 @@
 #include <grpcpp/impl/codegen/string_ref.h>
 #include <grpcpp/impl/codegen/sync.h>
 #include <grpcpp/impl/codegen/time.h>
+#include <grpcpp/impl/codegen/write_timestamps.h>
 
 struct census_context;
 struct grpc_call;
@@ -180,7 +182,8 @@ class PropagationOptions {
 /// compression options, can be made persistent at channel construction time
 /// (see \a grpc::CreateCustomChannel).
 ///
-/// \warning ClientContext instances should \em not be reused across rpcs.
+/// \warning ClientContext instances should \em not be reused across rpcs,
+///          unless \a Reset is called in between.
 /// \warning The ClientContext instance used for creating an rpc must remain
 ///          alive and valid for the lifetime of the rpc.
 class ClientContext {
@@ -205,6 +208,17 @@ class ClientContext {
       const grpc_impl::experimental::CallbackServerContext& server_context,
       PropagationOptions options = PropagationOptions());
 
+  /// Return the context to the state of a newly constructed one, so that it
+  /// can be used for another rpc. The deadline, metadata, credentials and all
+  /// other settings are cleared, but the storage for received metadata is
+  /// kept for the next rpc. This is cheaper than constructing a new context
+  /// for each of many sequential rpcs.
+  ///
+  /// \warning This method must only be called once the rpc that used the
+  ///          context is done (e.g. after its Finish has returned), and not
+  ///          on a context created with \a FromServerContext.
+  void Reset();
+
   /// Add the (\a meta_key, \a meta_value) pair to the metadata associated with
   /// a client call. These are made available at the server side by the \a
   /// grpc::ServerContext::client_metadata() method.
@@ -379,6 +393,24 @@ class ClientContext {
     return census_context_;
   }
 
+  /// EXPERIMENTAL: Ask the transport to collect the kernel timestamps of the
+  /// writes of this call, see \a grpc::experimental::WriteTimestamps.
+  /// It is only valid to call this before the client call is created.
+  void EnableWriteTimestamps() { write_timestamps_enabled_ = true; }
+
+  /// EXPERIMENTAL: Fill \a timestamps with the kernel timestamps collected so
+  /// far. The kernel reports them asynchronously, so those of the last writes
+  /// may only become available after the call has finished.
+  ///
+  /// \return false if the call was not created with EnableWriteTimestamps().
+  bool GetWriteTimestamps(grpc::experimental::WriteTimestamps* timestamps);
+
+  /// EXPERIMENTAL: Give this call \a weight times the share of its
+  /// connection's writes that calls with the default weight of 1 get, while
+  /// several calls have messages to send. Weights above 256 count as 256.
+  /// It is only valid to call this before the client call is created.
+  void set_write_weight(uint32_t weight) { write_weight_ = weight; }
+
   /// Send a best-effort out-of-band cancel on the call associated with
   /// this client context.  The call could be in any stage; e.g., if it is
   /// already finished, it may still return success.
@@ -510,6 +542,8 @@ class ClientContext {
 
   grpc_compression_algorithm compression_algorithm_;
   bool initial_metadata_corked_;
+  bool write_timestamps_enabled_;
+  uint32_t write_weight_;
 
   grpc::string debug_error_string_;
 
@@ -106,7 +106,7 @@ class CompletionQueue : private ::grpc::GrpcLibraryCodegen {
   CompletionQueue()
       : CompletionQueue(grpc_completion_queue_attributes{
             GRPC_CQ_CURRENT_VERSION, GRPC_CQ_NEXT, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}) {}
+            nullptr, 1}) {}
 
   /// Wrap \a take, taking ownership of the instance.
   ///
@@ -180,6 +180,28 @@ class CompletionQueue : private ::grpc::GrpcLibraryCodegen {
                                   GPR_CLOCK_REALTIME)) != SHUTDOWN);
   }
 
+  /// Like \a Next, but reads up to \a max_events events at once: blocks until
+  /// the first is available and then takes whichever others are already
+  /// queued, without waiting for more.
+  ///
+  /// \param tags [out] Updated with the tags of the events read.
+  /// \param oks [out] Updated with the \a ok of each event read. See
+  ///        documentation for CompletionQueue::Next for explanation of ok
+  /// \param max_events [in] The number of entries \a tags and \a oks have.
+  ///
+  /// \return The number of events read, or 0 if the queue is fully drained
+  ///         and shut down.
+  int NextBatch(void** tags, bool* oks, int max_events) {
+    int num_events = 0;
+    NextStatus status;
+    do {
+      status = AsyncNextBatchInternal(
+          tags, oks, max_events, &num_events,
+          ::grpc::g_core_codegen_interface->gpr_inf_future(GPR_CLOCK_REALTIME));
+    } while (status == TIMEOUT);
+    return num_events;
+  }
+
   /// Read from the queue, blocking up to \a deadline (or the queue's shutdown).
   /// Both \a tag and \a ok are updated upon success (if an event is available
   /// within the \a deadline).  A \a tag points to an arbitrary location usually
@@ -305,6 +327,8 @@ class CompletionQueue : private ::grpc::GrpcLibraryCodegen {
   };
 
   NextStatus AsyncNextInternal(void** tag, bool* ok, gpr_timespec deadline);
+  NextStatus AsyncNextBatchInternal(void** tags, bool* oks, int max_events,
+                                    int* num_events, gpr_timespec deadline);
 
   /// Wraps \a grpc_completion_queue_pluck.
   /// \warning Must not be mixed with calls to \a Next.
@@ -403,12 +427,15 @@ class ServerCompletionQueue : public CompletionQueue {
   /// allowed on this completion queue. See grpc_cq_polling_type's description
   /// in grpc_types.h for more details.
   /// \param shutdown_cb is the shutdown callback used for CALLBACK api queues
+  /// \param num_shards is the number of sub-queues a NEXT completion queue
+  /// splits its events across. See cq_num_shards in grpc_types.h.
   ServerCompletionQueue(grpc_cq_completion_type completion_type,
                         grpc_cq_polling_type polling_type,
-                        grpc_experimental_completion_queue_functor* shutdown_cb)
+                        grpc_experimental_completion_queue_functor* shutdown_cb,
+                        int num_shards = 1)
       : CompletionQueue(grpc_completion_queue_attributes{
             GRPC_CQ_CURRENT_VERSION, completion_type, polling_type,
-            shutdown_cb}),
+            shutdown_cb, num_shards}),
         polling_type_(polling_type) {}
 
   grpc_cq_polling_type polling_type_;
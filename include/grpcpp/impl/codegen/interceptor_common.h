@@ -239,6 +239,13 @@ class InterceptorBatchMethodsImpl
     return false;
   }
 
+  // SetCall should have been called before this.
+  // Returns true if messages may be handed to the peer as objects: the call
+  // allows it, and there are no interceptors that would expect them serialized
+  bool MessagePassthroughAllowed() {
+    return call_->message_passthrough() && InterceptorsListEmpty();
+  }
+
   // This should be used only by subclasses of CallOpSetInterface. SetCall and
   // SetCallOpSetInterface should have been called before this. After all the
   // interceptors are done running, either ContinueFillOpsAfterInterception or
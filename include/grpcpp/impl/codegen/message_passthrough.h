@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_IMPL_CODEGEN_MESSAGE_PASSTHROUGH_H
+#define GRPCPP_IMPL_CODEGEN_MESSAGE_PASSTHROUGH_H
+
+#include <string.h>
+
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/serialization_traits.h>
+#include <grpcpp/impl/codegen/slice.h>
+#include <grpcpp/impl/codegen/status.h>
+
+namespace grpc {
+namespace experimental {
+
+/// Specialize this as \a std::true_type for a message type \a M to let calls
+/// over in-process channels created with GRPC_ARG_INPROC_MESSAGE_PASSTHROUGH
+/// hand messages of that type to the other side as objects, instead of
+/// serializing them with \a SerializationTraits and parsing them back. The
+/// client and the server must both see the specialization, and \a M must be
+/// copy constructible and move assignable.
+///
+/// Only messages sent through the synchronous and callback APIs are handed
+/// over, and only on calls without interceptors. Responses are handed back on
+/// server calls whose request arrived that way.
+template <class M>
+struct InprocMessagePassthrough : public std::false_type {};
+
+}  // namespace experimental
+
+namespace internal {
+
+/// Hands messages across in-process calls in place of their serialized
+/// bytes. The byte buffer of such a message holds a single slice whose bytes
+/// are a Header, owned along with a copy of the message by an Envelope. A
+/// header is only trusted if it carries this process' cookie and its own
+/// address, which bytes that arrived from anywhere else can't do.
+class MessagePassthrough {
+ public:
+  /// Replaces the contents of \a buffer with a copy of \a message.
+  template <class M>
+  static Status Serialize(const M& message, ByteBuffer* buffer) {
+    auto* envelope = new Envelope<M>(message);
+    Slice slice(g_core_codegen_interface->grpc_slice_new_with_user_data(
+                    &envelope->header, sizeof(envelope->header),
+                    &Envelope<M>::Destroy, envelope),
+                Slice::STEAL_REF);
+    ByteBuffer tmp(&slice, 1);
+    buffer->Swap(&tmp);
+    return g_core_codegen_interface->ok();
+  }
+
+  /// Fills \a message from \a buffer, taking the object out of it if it was
+  /// handed over by Serialize and parsing it with \a SerializationTraits
+  /// otherwise.
+  template <class M>
+  static Status Deserialize(ByteBuffer* buffer, M* message) {
+    return Deserialize(
+        buffer, message,
+        std::integral_constant<
+            bool, experimental::InprocMessagePassthrough<M>::value>());
+  }
+
+  /// Returns true if \a buffer holds a message handed over by Serialize.
+  static bool IsPassedThrough(grpc_byte_buffer* buffer) {
+    return GetHeader(buffer) != nullptr;
+  }
+
+ private:
+  struct Header {
+    uint64_t cookie;
+    const Header* self;
+    const void* type_tag;
+    void* envelope;
+  };
+
+  template <class M>
+  struct TypeTag {
+    static const char tag;
+  };
+
+  template <class M>
+  struct Envelope {
+    explicit Envelope(const M& message) : message(message) {
+      header.cookie = Cookie();
+      header.self = &header;
+      header.type_tag = &TypeTag<M>::tag;
+      header.envelope = this;
+    }
+    static void Destroy(void* envelope) {
+      delete static_cast<Envelope*>(envelope);
+    }
+
+    Header header;
+    M message;
+  };
+
+  static uint64_t Cookie() {
+    static const uint64_t cookie = [] {
+      std::random_device random;
+      return (static_cast<uint64_t>(random()) << 32) ^ random();
+    }();
+    return cookie;
+  }
+
+  static const Header* GetHeader(grpc_byte_buffer* buffer) {
+    if (buffer == nullptr || buffer->type != GRPC_BB_RAW ||
+        buffer->data.raw.compression != GRPC_COMPRESS_NONE ||
+        buffer->data.raw.slice_buffer.count != 1) {
+      return nullptr;
+    }
+    const grpc_slice& slice = buffer->data.raw.slice_buffer.slices[0];
+    if (slice.refcount == nullptr ||
+        slice.data.refcounted.length != sizeof(Header)) {
+      return nullptr;
+    }
+    // The bytes may have come off the wire, so don't assume they're aligned
+    // until they've proven to be a Header of ours.
+    Header header;
+    memcpy(&header, slice.data.refcounted.bytes, sizeof(header));
+    if (header.cookie != Cookie() ||
+        reinterpret_cast<const uint8_t*>(header.self) !=
+            slice.data.refcounted.bytes) {
+      return nullptr;
+    }
+    return header.self;
+  }
+
+  template <class M>
+  static Status Deserialize(ByteBuffer* buffer, M* message, std::true_type) {
+    const Header* header = GetHeader(buffer->c_buffer());
+    if (header == nullptr) {
+      return Deserialize(buffer, message, std::false_type());
+    }
+    if (header->type_tag != &TypeTag<M>::tag) {
+      buffer->Clear();
+      return Status(StatusCode::INTERNAL,
+                    "Message handed over as a different type");
+    }
+    *message = std::move(static_cast<Envelope<M>*>(header->envelope)->message);
+    buffer->Clear();
+    return g_core_codegen_interface->ok();
+  }
+
+  template <class M>
+  static Status Deserialize(ByteBuffer* buffer, M* message, std::false_type) {
+    return SerializationTraits<M>::Deserialize(buffer, message);
+  }
+};
+
+template <class M>
+const char MessagePassthrough::TypeTag<M>::tag = 0;
+
+}  // namespace internal
+}  // namespace grpc
+
+#endif  // GRPCPP_IMPL_CODEGEN_MESSAGE_PASSTHROUGH_H
@@ -69,11 +69,12 @@ class MetadataMap {
   }
   grpc_metadata_array* arr() { return &arr_; }
 
+  // Empties the map. The array keeps its storage: its entries do not own the
+  // slices they point to.
   void Reset() {
     filled_ = false;
     map_.clear();
-    Destroy();
-    Setup();
+    arr_.count = 0;
   }
 
  private:
@@ -21,6 +21,8 @@
 
 #include <grpcpp/impl/codegen/byte_buffer.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/message_passthrough.h>
 #include <grpcpp/impl/codegen/rpc_service_method.h>
 #include <grpcpp/impl/codegen/sync_stream_impl.h>
 
@@ -53,24 +55,90 @@ template <class Callable>
 template <class ServiceType, class RequestType, class ResponseType>
 class RpcMethodHandler : public ::grpc::internal::MethodHandler {
  public:
+  typedef ::grpc::Status (ServiceType::*Method)(::grpc_impl::ServerContext*,
+                                                const RequestType*,
+                                                ResponseType*);
+
+  /// If \a allocator is set, the request and response of each RPC are
+  /// taken from it instead of the call arena and the stack. It must outlive
+  /// the server.
   RpcMethodHandler(
       std::function<::grpc::Status(ServiceType*, ::grpc_impl::ServerContext*,
                                    const RequestType*, ResponseType*)>
           func,
-      ServiceType* service)
-      : func_(func), service_(service) {}
+      ServiceType* service,
+      ::grpc::experimental::MessageAllocator<RequestType, ResponseType>*
+          allocator = nullptr)
+      : func_(func),
+        method_(nullptr),
+        service_(service),
+        allocator_(allocator) {}
+
+  /// Calls \a method on \a service directly, without going through a
+  /// std::function. This is what generated services use.
+  RpcMethodHandler(
+      Method method, ServiceType* service,
+      ::grpc::experimental::MessageAllocator<RequestType, ResponseType>*
+          allocator = nullptr)
+      : method_(method), service_(service), allocator_(allocator) {}
 
   void RunHandler(const HandlerParameter& param) final {
-    ResponseType rsp;
+    auto* holder = static_cast<
+        ::grpc::experimental::MessageHolder<RequestType, ResponseType>*>(
+        param.internal_data);
+    if (holder != nullptr) {
+      RunHandler(param, holder->response());
+      holder->Release();
+    } else {
+      ResponseType rsp;
+      RunHandler(param, &rsp);
+    }
+  }
+
+  void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
+                    ::grpc::Status* status, void** handler_data) final {
+    ::grpc::ByteBuffer buf;
+    buf.set_buffer(req);
+    if (allocator_ != nullptr && handler_data != nullptr) {
+      auto* holder = allocator_->AllocateMessages();
+      *status = ::grpc::internal::MessagePassthrough::Deserialize(
+          &buf, holder->request());
+      buf.Release();
+      if (status->ok()) {
+        *handler_data = holder;
+        return holder->request();
+      }
+      holder->Release();
+      return nullptr;
+    }
+    auto* request =
+        new (::grpc::g_core_codegen_interface->grpc_call_arena_alloc(
+            call, sizeof(RequestType))) RequestType();
+    *status =
+        ::grpc::internal::MessagePassthrough::Deserialize(&buf, request);
+    buf.Release();
+    if (status->ok()) {
+      return request;
+    }
+    request->~RequestType();
+    return nullptr;
+  }
+
+ private:
+  void RunHandler(const HandlerParameter& param, ResponseType* rsp) {
     ::grpc::Status status = param.status;
     if (status.ok()) {
-      status = CatchingFunctionHandler([this, &param, &rsp] {
-        return func_(
-            service_,
-            static_cast<::grpc_impl::ServerContext*>(param.server_context),
-            static_cast<RequestType*>(param.request), &rsp);
+      status = CatchingFunctionHandler([this, &param, rsp] {
+        auto* context =
+            static_cast<::grpc_impl::ServerContext*>(param.server_context);
+        auto* request = static_cast<RequestType*>(param.request);
+        return method_ != nullptr ? (service_->*method_)(context, request, rsp)
+                                  : func_(service_, context, request, rsp);
       });
-      static_cast<RequestType*>(param.request)->~RequestType();
+      // A request from the allocator is freed along with its holder.
+      if (param.internal_data == nullptr) {
+        static_cast<RequestType*>(param.request)->~RequestType();
+      }
     }
 
     GPR_CODEGEN_ASSERT(!param.server_context->sent_initial_metadata_);
@@ -84,50 +152,45 @@ class RpcMethodHandler : public ::grpc::internal::MethodHandler {
       ops.set_compression_level(param.server_context->compression_level());
     }
     if (status.ok()) {
-      status = ops.SendMessagePtr(&rsp);
+      status = ops.SendMessagePtr(rsp);
     }
     ops.ServerSendStatus(&param.server_context->trailing_metadata_, status);
     param.call->PerformOps(&ops);
     param.call->cq()->Pluck(&ops);
   }
 
-  void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
-                    ::grpc::Status* status, void** /*handler_data*/) final {
-    ::grpc::ByteBuffer buf;
-    buf.set_buffer(req);
-    auto* request =
-        new (::grpc::g_core_codegen_interface->grpc_call_arena_alloc(
-            call, sizeof(RequestType))) RequestType();
-    *status =
-        ::grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
-    buf.Release();
-    if (status->ok()) {
-      return request;
-    }
-    request->~RequestType();
-    return nullptr;
-  }
-
- private:
   /// Application provided rpc handler function.
   std::function<::grpc::Status(ServiceType*, ::grpc_impl::ServerContext*,
                                const RequestType*, ResponseType*)>
       func_;
+  // Set instead of func_ for generated services.
+  const Method method_;
   // The class the above handler function lives in.
   ServiceType* service_;
+  ::grpc::experimental::MessageAllocator<RequestType, ResponseType>* const
+      allocator_;
 };
 
 /// A wrapper class of an application provided client streaming handler.
 template <class ServiceType, class RequestType, class ResponseType>
 class ClientStreamingHandler : public ::grpc::internal::MethodHandler {
  public:
+  typedef ::grpc::Status (ServiceType::*Method)(
+      ::grpc_impl::ServerContext*, ::grpc_impl::ServerReader<RequestType>*,
+      ResponseType*);
+
   ClientStreamingHandler(
       std::function<::grpc::Status(ServiceType*, ::grpc_impl::ServerContext*,
                                    ::grpc_impl::ServerReader<RequestType>*,
                                    ResponseType*)>
           func,
       ServiceType* service)
-      : func_(func), service_(service) {}
+      : func_(func), method_(nullptr), service_(service) {}
+
+  /// Calls \a method on \a service directly, without going through a
+  /// std::function. This is what generated services use.
+  ClientStreamingHandler(Method method, ServiceType* service)
+      : method_(method), service_(service) {}
 
   void RunHandler(const HandlerParameter& param) final {
     ::grpc_impl::ServerReader<RequestType> reader(
@@ -136,10 +199,11 @@ class ClientStreamingHandler : public ::grpc::internal::MethodHandler {
     ResponseType rsp;
     ::grpc::Status status =
         CatchingFunctionHandler([this, &param, &reader, &rsp] {
-          return func_(
-              service_,
-              static_cast<::grpc_impl::ServerContext*>(param.server_context),
-              &reader, &rsp);
+          auto* context =
+              static_cast<::grpc_impl::ServerContext*>(param.server_context);
+          return method_ != nullptr
+                     ? (service_->*method_)(context, &reader, &rsp)
+                     : func_(service_, context, &reader, &rsp);
         });
 
     ::grpc::internal::CallOpSet<::grpc::internal::CallOpSendInitialMetadata,
@@ -166,6 +230,7 @@ class ClientStreamingHandler : public ::grpc::internal::MethodHandler {
                                ::grpc_impl::ServerReader<RequestType>*,
                                ResponseType*)>
       func_;
+  const Method method_;
   ServiceType* service_;
 };
 
@@ -173,13 +238,22 @@ class ClientStreamingHandler : public ::grpc::internal::MethodHandler {
 template <class ServiceType, class RequestType, class ResponseType>
 class ServerStreamingHandler : public ::grpc::internal::MethodHandler {
  public:
+  typedef ::grpc::Status (ServiceType::*Method)(
+      ::grpc_impl::ServerContext*, const RequestType*,
+      ::grpc_impl::ServerWriter<ResponseType>*);
+
   ServerStreamingHandler(
       std::function<::grpc::Status(ServiceType*, ::grpc_impl::ServerContext*,
                                    const RequestType*,
                                    ::grpc_impl::ServerWriter<ResponseType>*)>
           func,
       ServiceType* service)
-      : func_(func), service_(service) {}
+      : func_(func), method_(nullptr), service_(service) {}
+
+  /// Calls \a method on \a service directly, without going through a
+  /// std::function. This is what generated services use.
+  ServerStreamingHandler(Method method, ServiceType* service)
+      : method_(method), service_(service) {}
 
   void RunHandler(const HandlerParameter& param) final {
     ::grpc::Status status = param.status;
@@ -188,10 +262,12 @@ class ServerStreamingHandler : public ::grpc::internal::MethodHandler {
           param.call,
           static_cast<::grpc_impl::ServerContext*>(param.server_context));
       status = CatchingFunctionHandler([this, &param, &writer] {
-        return func_(
-            service_,
-            static_cast<::grpc_impl::ServerContext*>(param.server_context),
-            static_cast<RequestType*>(param.request), &writer);
+        auto* context =
+            static_cast<::grpc_impl::ServerContext*>(param.server_context);
+        auto* request = static_cast<RequestType*>(param.request);
+        return method_ != nullptr
+                   ? (service_->*method_)(context, request, &writer)
+                   : func_(service_, context, request, &writer);
       });
       static_cast<RequestType*>(param.request)->~RequestType();
     }
@@ -222,7 +298,7 @@ class ServerStreamingHandler : public ::grpc::internal::MethodHandler {
         new (::grpc::g_core_codegen_interface->grpc_call_arena_alloc(
             call, sizeof(RequestType))) RequestType();
     *status =
-        ::grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
+        ::grpc::internal::MessagePassthrough::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
@@ -236,6 +312,7 @@ class ServerStreamingHandler : public ::grpc::internal::MethodHandler {
                                const RequestType*,
                                ::grpc_impl::ServerWriter<ResponseType>*)>
       func_;
+  const Method method_;
   ServiceType* service_;
 };
 
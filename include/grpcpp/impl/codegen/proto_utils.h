@@ -19,7 +19,10 @@
 #ifndef GRPCPP_IMPL_CODEGEN_PROTO_UTILS_H
 #define GRPCPP_IMPL_CODEGEN_PROTO_UTILS_H
 
+#include <string.h>
+
 #include <type_traits>
+#include <vector>
 
 #include <grpc/impl/codegen/byte_buffer_reader.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -50,7 +53,12 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
                 "::protobuf::io::ZeroCopyOutputStream");
   *own_buffer = true;
   int byte_size = msg.ByteSize();
-  if ((size_t)byte_size <= GRPC_SLICE_INLINED_SIZE) {
+  // The size is known, so serialize into a single exactly-sized slice: one
+  // allocation, and no Next()/BackUp() round trips. Only subclasses of
+  // ProtoBufferWriter, which may need to see the chunks, go through the
+  // stream for messages too large to be inlined.
+  if ((size_t)byte_size <= GRPC_SLICE_INLINED_SIZE ||
+      std::is_same<ProtoBufferWriter, grpc::ProtoBufferWriter>::value) {
     Slice slice(byte_size);
     // We serialize directly into the allocated slices memory
     GPR_CODEGEN_ASSERT(slice.end() == msg.SerializeWithCachedSizesToArray(
@@ -91,6 +99,193 @@ Status GenericDeserialize(ByteBuffer* buffer,
   return result;
 }
 
+namespace internal {
+
+// Splits the top-level fields of a serialized message into one
+// length-delimited field and the rest, without copying the payload: both
+// parts are made of sub-slices of the received slices.
+class ProtoFieldSplitter {
+ public:
+  explicit ProtoFieldSplitter(ByteBuffer* buffer) {
+    grpc_byte_buffer_reader reader;
+    if (!buffer->Valid() ||
+        !g_core_codegen_interface->grpc_byte_buffer_reader_init(
+            &reader, buffer->c_buffer())) {
+      status_ = Status(StatusCode::INTERNAL,
+                       "Couldn't initialize byte buffer reader");
+      return;
+    }
+    grpc_slice slice;
+    while (g_core_codegen_interface->grpc_byte_buffer_reader_next(&reader,
+                                                                  &slice)) {
+      slices_.push_back(slice);
+    }
+    g_core_codegen_interface->grpc_byte_buffer_reader_destroy(&reader);
+    Normalize();
+  }
+
+  ~ProtoFieldSplitter() {
+    for (const grpc_slice& slice : slices_) {
+      g_core_codegen_interface->grpc_slice_unref(slice);
+    }
+  }
+
+  Status status() const { return status_; }
+
+  // Appends everything but field \a field_number to \a rest, and sets
+  // \a field to the value of its last occurrence, as the parser would keep
+  // for a bytes field. The value is only copied if it spans several slices.
+  // Returns false if the payload is malformed or contains groups.
+  bool Split(uint32_t field_number, std::vector<Slice>* rest, Slice* field) {
+    Position kept_begin = pos_;
+    Position value_begin = pos_;
+    uint64_t value_length = 0;
+    while (pos_.slice < slices_.size()) {
+      const Position field_begin = pos_;
+      uint64_t tag;
+      if (!ReadVarint(&tag)) return false;
+      uint64_t length;
+      switch (tag & 7) {
+        case 0:  // varint
+          if (!ReadVarint(&length)) return false;
+          continue;
+        case 1:  // fixed64
+          length = 8;
+          break;
+        case 2:  // length-delimited
+          if (!ReadVarint(&length)) return false;
+          break;
+        case 5:  // fixed32
+          length = 4;
+          break;
+        default:  // groups, or garbage
+          return false;
+      }
+      const Position skipped = pos_;
+      if (!Skip(length)) return false;
+      if ((tag & 7) == 2 && (tag >> 3) == field_number) {
+        AppendRange(kept_begin, field_begin, rest);
+        kept_begin = pos_;
+        value_begin = skipped;
+        value_length = length;
+      }
+    }
+    AppendRange(kept_begin, pos_, rest);
+    *field = Value(value_begin, static_cast<size_t>(value_length));
+    return true;
+  }
+
+ private:
+  struct Position {
+    size_t slice;
+    size_t offset;
+  };
+
+  size_t SliceLength(size_t i) const { return GRPC_SLICE_LENGTH(slices_[i]); }
+
+  // Moves pos_ past the end of the current slice and any empty ones.
+  void Normalize() {
+    while (pos_.slice < slices_.size() &&
+           pos_.offset == SliceLength(pos_.slice)) {
+      ++pos_.slice;
+      pos_.offset = 0;
+    }
+  }
+
+  bool ReadVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (pos_.slice == slices_.size()) return false;
+      const uint8_t byte =
+          GRPC_SLICE_START_PTR(slices_[pos_.slice])[pos_.offset++];
+      Normalize();
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+  }
+
+  bool Skip(uint64_t length) {
+    while (length > 0) {
+      if (pos_.slice == slices_.size()) return false;
+      const size_t available = SliceLength(pos_.slice) - pos_.offset;
+      const size_t step =
+          length < available ? static_cast<size_t>(length) : available;
+      pos_.offset += step;
+      length -= step;
+      Normalize();
+    }
+    return true;
+  }
+
+  void AppendRange(Position begin, Position end, std::vector<Slice>* out) {
+    for (size_t i = begin.slice; i < slices_.size() && i <= end.slice; ++i) {
+      const size_t from = i == begin.slice ? begin.offset : 0;
+      const size_t to = i == end.slice ? end.offset : SliceLength(i);
+      if (from == to) continue;
+      out->emplace_back(
+          g_core_codegen_interface->grpc_slice_sub(slices_[i], from, to),
+          Slice::STEAL_REF);
+    }
+  }
+
+  Slice Value(Position begin, size_t length) {
+    if (length == 0) return Slice();
+    if (begin.offset + length <= SliceLength(begin.slice)) {
+      return Slice(g_core_codegen_interface->grpc_slice_sub(
+                       slices_[begin.slice], begin.offset,
+                       begin.offset + length),
+                   Slice::STEAL_REF);
+    }
+    Slice value(length);
+    uint8_t* dst = const_cast<uint8_t*>(value.begin());
+    for (size_t i = begin.slice; length > 0; ++i) {
+      const size_t from = i == begin.slice ? begin.offset : 0;
+      size_t step = SliceLength(i) - from;
+      if (step > length) step = length;
+      memcpy(dst, GRPC_SLICE_START_PTR(slices_[i]) + from, step);
+      dst += step;
+      length -= step;
+    }
+    return value;
+  }
+
+  std::vector<grpc_slice> slices_;
+  Position pos_ = {0, 0};
+  Status status_;
+};
+
+}  // namespace internal
+
+// Like GenericDeserialize(), except that the top-level bytes field
+// \a field_number is not parsed into \a msg but returned in \a field,
+// aliasing the received slices. This avoids copying large payload fields.
+// If the payload can't be split (e.g. it uses groups), it is parsed as
+// usual and \a field is left empty.
+template <class ProtoBufferReader, class T>
+Status GenericDeserializeAliasingField(ByteBuffer* buffer,
+                                       uint32_t field_number,
+                                       grpc::protobuf::MessageLite* msg,
+                                       Slice* field) {
+  if (buffer == nullptr) {
+    return Status(StatusCode::INTERNAL, "No payload");
+  }
+  std::vector<Slice> rest;
+  {
+    internal::ProtoFieldSplitter splitter(buffer);
+    if (!splitter.status().ok()) {
+      return splitter.status();
+    }
+    if (!splitter.Split(field_number, &rest, field)) {
+      *field = Slice();
+      return GenericDeserialize<ProtoBufferReader, T>(buffer, msg);
+    }
+  }
+  buffer->Clear();
+  ByteBuffer rest_buffer(rest.data(), rest.size());
+  return GenericDeserialize<ProtoBufferReader, T>(&rest_buffer, msg);
+}
+
 // this is needed so the following class does not conflict with protobuf
 // serializers that utilize internal-only tools.
 #ifdef GRPC_OPEN_SOURCE_PROTO
@@ -112,6 +307,19 @@ class SerializationTraits<
     return GenericDeserialize<ProtoBufferReader, T>(buffer, msg);
   }
 };
+
+/// Deserializes \a buffer into \a msg, except for the top-level bytes field
+/// \a field_number, which is returned in \a field as a reference to the
+/// received slices rather than copied into \a msg. Meant for methods that
+/// take a ByteBuffer and carry large bytes fields.
+template <class T>
+Status DeserializeAliasingField(ByteBuffer* buffer, uint32_t field_number,
+                                T* msg, Slice* field) {
+  static_assert(std::is_base_of<grpc::protobuf::MessageLite, T>::value,
+                "T must be a protobuf message");
+  return GenericDeserializeAliasingField<ProtoBufferReader, T>(
+      buffer, field_number, msg, field);
+}
 #endif
 
 }  // namespace grpc
@@ -44,6 +44,9 @@ class RpcMethod {
         method_type_(type),
         channel_tag_(channel->RegisterMethod(name)) {}
 
+  RpcMethod(const char* name, RpcType type, void* channel_tag)
+      : name_(name), method_type_(type), channel_tag_(channel_tag) {}
+
   const char* name() const { return name_; }
   RpcType method_type() const { return method_type_; }
   void SetMethodType(RpcType type) { method_type_ = type; }
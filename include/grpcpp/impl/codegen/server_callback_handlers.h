@@ -19,6 +19,7 @@
 #define GRPCPP_IMPL_CODEGEN_SERVER_CALLBACK_HANDLERS_H
 
 #include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/message_passthrough.h>
 #include <grpcpp/impl/codegen/rpc_service_method.h>
 #include <grpcpp/impl/codegen/server_callback_impl.h>
 #include <grpcpp/impl/codegen/server_context_impl.h>
@@ -99,7 +100,7 @@ class CallbackUnaryHandler : public ::grpc::internal::MethodHandler {
     *handler_data = allocator_state;
     request = allocator_state->request();
     *status =
-        ::grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
+        ::grpc::internal::MessagePassthrough::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
@@ -122,7 +123,8 @@ class CallbackUnaryHandler : public ::grpc::internal::MethodHandler {
     void Finish(::grpc::Status s) override {
       finish_tag_.Set(
           call_.call(), [this](bool) { MaybeDone(); }, &finish_ops_,
-          reactor_.load(std::memory_order_relaxed)->InternalInlineable());
+          reactor_.load(std::memory_order_relaxed)->InternalInlineable() ||
+              ctx_->inline_reactions_);
       finish_ops_.set_core_cq_tag(&finish_tag_);
 
       if (!ctx_->sent_initial_metadata_) {
@@ -153,7 +155,7 @@ class CallbackUnaryHandler : public ::grpc::internal::MethodHandler {
                           ->OnSendInitialMetadataDone(ok);
                       MaybeDone();
                     },
-                    &meta_ops_, false);
+                    &meta_ops_, ctx_->inline_reactions_);
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -178,6 +180,7 @@ class CallbackUnaryHandler : public ::grpc::internal::MethodHandler {
           allocator_state_(allocator_state),
           call_requester_(std::move(call_requester)) {
       ctx_->set_message_allocator_state(allocator_state);
+      this->set_inline_reactions(ctx_->inline_reactions_);
     }
 
     /// SetupReactor binds the reactor (which also releases any queued
@@ -293,7 +296,7 @@ class CallbackClientStreamingHandler : public ::grpc::internal::MethodHandler {
    public:
     void Finish(::grpc::Status s) override {
       finish_tag_.Set(call_.call(), [this](bool) { MaybeDone(); }, &finish_ops_,
-                      false);
+                      ctx_->inline_reactions_);
       if (!ctx_->sent_initial_metadata_) {
         finish_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                         ctx_->initial_metadata_flags());
@@ -322,7 +325,7 @@ class CallbackClientStreamingHandler : public ::grpc::internal::MethodHandler {
                           ->OnSendInitialMetadataDone(ok);
                       MaybeDone();
                     },
-                    &meta_ops_, false);
+                    &meta_ops_, ctx_->inline_reactions_);
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -345,7 +348,9 @@ class CallbackClientStreamingHandler : public ::grpc::internal::MethodHandler {
     ServerCallbackReaderImpl(
         ::grpc_impl::experimental::CallbackServerContext* ctx,
         ::grpc::internal::Call* call, std::function<void()> call_requester)
-        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {}
+        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {
+      this->set_inline_reactions(ctx_->inline_reactions_);
+    }
 
     void SetupReactor(experimental::ServerReadReactor<RequestType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -354,7 +359,7 @@ class CallbackClientStreamingHandler : public ::grpc::internal::MethodHandler {
                       reactor_.load(std::memory_order_relaxed)->OnReadDone(ok);
                       MaybeDone();
                     },
-                    &read_ops_, false);
+                    &read_ops_, ctx_->inline_reactions_);
       read_ops_.set_core_cq_tag(&read_tag_);
       this->BindReactor(reactor);
       this->MaybeCallOnCancel(reactor);
@@ -456,7 +461,7 @@ class CallbackServerStreamingHandler : public ::grpc::internal::MethodHandler {
         new (::grpc::g_core_codegen_interface->grpc_call_arena_alloc(
             call, sizeof(RequestType))) RequestType();
     *status =
-        ::grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
+        ::grpc::internal::MessagePassthrough::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
@@ -475,7 +480,7 @@ class CallbackServerStreamingHandler : public ::grpc::internal::MethodHandler {
    public:
     void Finish(::grpc::Status s) override {
       finish_tag_.Set(call_.call(), [this](bool) { MaybeDone(); }, &finish_ops_,
-                      false);
+                      ctx_->inline_reactions_);
       finish_ops_.set_core_cq_tag(&finish_tag_);
 
       if (!ctx_->sent_initial_metadata_) {
@@ -499,7 +504,7 @@ class CallbackServerStreamingHandler : public ::grpc::internal::MethodHandler {
                           ->OnSendInitialMetadataDone(ok);
                       MaybeDone();
                     },
-                    &meta_ops_, false);
+                    &meta_ops_, ctx_->inline_reactions_);
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -550,7 +555,9 @@ class CallbackServerStreamingHandler : public ::grpc::internal::MethodHandler {
         : ctx_(ctx),
           call_(*call),
           req_(req),
-          call_requester_(std::move(call_requester)) {}
+          call_requester_(std::move(call_requester)) {
+      this->set_inline_reactions(ctx_->inline_reactions_);
+    }
 
     void SetupReactor(experimental::ServerWriteReactor<ResponseType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -560,7 +567,7 @@ class CallbackServerStreamingHandler : public ::grpc::internal::MethodHandler {
             reactor_.load(std::memory_order_relaxed)->OnWriteDone(ok);
             MaybeDone();
           },
-          &write_ops_, false);
+          &write_ops_, ctx_->inline_reactions_);
       write_ops_.set_core_cq_tag(&write_tag_);
       this->BindReactor(reactor);
       this->MaybeCallOnCancel(reactor);
@@ -663,7 +670,7 @@ class CallbackBidiHandler : public ::grpc::internal::MethodHandler {
    public:
     void Finish(::grpc::Status s) override {
       finish_tag_.Set(call_.call(), [this](bool) { MaybeDone(); }, &finish_ops_,
-                      false);
+                      ctx_->inline_reactions_);
       finish_ops_.set_core_cq_tag(&finish_tag_);
 
       if (!ctx_->sent_initial_metadata_) {
@@ -687,7 +694,7 @@ class CallbackBidiHandler : public ::grpc::internal::MethodHandler {
                           ->OnSendInitialMetadataDone(ok);
                       MaybeDone();
                     },
-                    &meta_ops_, false);
+                    &meta_ops_, ctx_->inline_reactions_);
       meta_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                     ctx_->initial_metadata_flags());
       if (ctx_->compression_level_set()) {
@@ -739,7 +746,9 @@ class CallbackBidiHandler : public ::grpc::internal::MethodHandler {
     ServerCallbackReaderWriterImpl(
         ::grpc_impl::experimental::CallbackServerContext* ctx,
         ::grpc::internal::Call* call, std::function<void()> call_requester)
-        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {}
+        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {
+      this->set_inline_reactions(ctx_->inline_reactions_);
+    }
 
     void SetupReactor(
         experimental::ServerBidiReactor<RequestType, ResponseType>* reactor) {
@@ -750,14 +759,14 @@ class CallbackBidiHandler : public ::grpc::internal::MethodHandler {
             reactor_.load(std::memory_order_relaxed)->OnWriteDone(ok);
             MaybeDone();
           },
-          &write_ops_, false);
+          &write_ops_, ctx_->inline_reactions_);
       write_ops_.set_core_cq_tag(&write_tag_);
       read_tag_.Set(call_.call(),
                     [this](bool ok) {
                       reactor_.load(std::memory_order_relaxed)->OnReadDone(ok);
                       MaybeDone();
                     },
-                    &read_ops_, false);
+                    &read_ops_, ctx_->inline_reactions_);
       read_ops_.set_core_cq_tag(&read_tag_);
       this->BindReactor(reactor);
       this->MaybeCallOnCancel(reactor);
@@ -103,6 +103,12 @@ class ServerCallbackCall {
     return callbacks_outstanding_.fetch_sub(1, std::memory_order_acq_rel);
   }
 
+  /// Set when the server was told that all reactions are non-blocking, so
+  /// that they can be run without an extra executor scheduling.
+  void set_inline_reactions(bool inline_reactions) {
+    inline_reactions_ = inline_reactions;
+  }
+
  private:
   virtual ServerReactor* reactor() = 0;
   virtual void MaybeDone() = 0;
@@ -111,6 +117,7 @@ class ServerCallbackCall {
   // it to an executor.
   void CallOnCancel(ServerReactor* reactor);
 
+  bool inline_reactions_ = false;
   std::atomic_int on_cancel_conditions_remaining_{2};
   std::atomic_int callbacks_outstanding_{
       3};  // reserve for start, Finish, and CompletionOp
@@ -40,6 +40,7 @@
 #include <grpcpp/impl/codegen/status.h>
 #include <grpcpp/impl/codegen/string_ref.h>
 #include <grpcpp/impl/codegen/time.h>
+#include <grpcpp/impl/codegen/write_timestamps.h>
 
 struct grpc_metadata;
 struct grpc_call;
@@ -258,6 +259,25 @@ class ServerContextBase {
   /// Get the census context associated with this server call.
   const struct census_context* census_context() const;
 
+  /// EXPERIMENTAL: Ask the transport to collect the kernel timestamps of the
+  /// writes of this call, see \a grpc::experimental::WriteTimestamps. Only
+  /// writes started after this call are covered, so call it before sending
+  /// anything.
+  void EnableWriteTimestamps();
+
+  /// EXPERIMENTAL: Fill \a timestamps with the kernel timestamps collected so
+  /// far. The kernel reports them asynchronously, so those of the last writes
+  /// may only become available after the call has finished.
+  ///
+  /// \return false if EnableWriteTimestamps() was not called.
+  bool GetWriteTimestamps(grpc::experimental::WriteTimestamps* timestamps);
+
+  /// EXPERIMENTAL: Give this call \a weight times the share of its
+  /// connection's writes that calls with the default weight of 1 get, while
+  /// several calls have messages to send. Weights above 256 count as 256.
+  /// Only writes started after this call are affected.
+  void set_write_weight(uint32_t weight);
+
   /// Should be used for framework-level extensions only.
   /// Applications never need to call this method.
   grpc_call* c_call() { return call_; }
@@ -414,6 +434,8 @@ class ServerContextBase {
 
   ::grpc::experimental::ServerRpcInfo* rpc_info_;
   ::grpc::experimental::RpcAllocatorState* message_allocator_state_ = nullptr;
+  // Whether the reactions of a callback-API call may be run inline.
+  bool inline_reactions_ = false;
 
   class Reactor : public experimental::ServerUnaryReactor {
    public:
@@ -495,9 +517,12 @@ class ServerContext : public experimental::ServerContextBase {
 
   using experimental::ServerContextBase::AddInitialMetadata;
   using experimental::ServerContextBase::AddTrailingMetadata;
+  using experimental::ServerContextBase::EnableWriteTimestamps;
+  using experimental::ServerContextBase::GetWriteTimestamps;
   using experimental::ServerContextBase::IsCancelled;
   using experimental::ServerContextBase::SetLoadReportingCosts;
   using experimental::ServerContextBase::TryCancel;
+  using experimental::ServerContextBase::set_write_weight;
   using experimental::ServerContextBase::auth_context;
   using experimental::ServerContextBase::c_call;
   using experimental::ServerContextBase::census_context;
@@ -539,9 +564,12 @@ class CallbackServerContext : public ServerContextBase {
 
   using ServerContextBase::AddInitialMetadata;
   using ServerContextBase::AddTrailingMetadata;
+  using ServerContextBase::EnableWriteTimestamps;
+  using ServerContextBase::GetWriteTimestamps;
   using ServerContextBase::IsCancelled;
   using ServerContextBase::SetLoadReportingCosts;
   using ServerContextBase::TryCancel;
+  using ServerContextBase::set_write_weight;
   using ServerContextBase::auth_context;
   using ServerContextBase::c_call;
   using ServerContextBase::census_context;
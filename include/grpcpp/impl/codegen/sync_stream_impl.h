@@ -139,6 +139,46 @@ class WriterInterface {
   void WriteLast(const W& msg, ::grpc::WriteOptions options) {
     Write(msg, options.set_last_message());
   }
+
+  /// Block to write the \a count messages at \a msgs, in order. All but the
+  /// last are written with the buffer hint, so the transport coalesces them
+  /// into as few frames and socket writes as it can; the last one is written
+  /// with \a options and flushes them unless it is corked itself.
+  ///
+  /// \return \a true on success, \a false as soon as one of the writes fails.
+  bool WriteMany(const W* msgs, size_t count, ::grpc::WriteOptions options) {
+    for (size_t i = 0; i + 1 < count; i++) {
+      ::grpc::WriteOptions buffered = options;
+      buffered.clear_last_message().set_buffer_hint();
+      if (!Write(msgs[i], buffered)) return false;
+    }
+    return count == 0 || Write(msgs[count - 1], options);
+  }
+
+  /// Cork the stream: until \a Uncork, every write is made with the buffer
+  /// hint. The transport holds corked messages back until a write without the
+  /// hint (or the end of the stream) flushes them, or until they exceed its
+  /// write buffer size (GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE, 64KiB by default).
+  /// Writes of corked messages return as soon as they are buffered.
+  void Cork() { corked_ = true; }
+
+  /// Uncork the stream and write \a msg, flushing it together with the
+  /// messages written since \a Cork.
+  bool Uncork(const W& msg, ::grpc::WriteOptions options) {
+    corked_ = false;
+    return Write(msg, options);
+  }
+  bool Uncork(const W& msg) { return Uncork(msg, ::grpc::WriteOptions()); }
+
+ protected:
+  /// Applies the cork, if any, to the options of a write. Called by the
+  /// implementations of \a Write.
+  void ApplyCork(::grpc::WriteOptions* options) const {
+    if (corked_) options->set_buffer_hint();
+  }
+
+ private:
+  bool corked_ = false;
 };
 
 }  // namespace internal
@@ -244,7 +284,7 @@ class ClientReader final : public ClientReaderInterface<R> {
       : context_(context),
         cq_(grpc_completion_queue_attributes{
             GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}),  // Pluckable cq
+            nullptr, 1}),  // Pluckable cq
         call_(channel->CreateCall(method, context, &cq_)) {
     ::grpc::internal::CallOpSet<::grpc::internal::CallOpSendInitialMetadata,
                                 ::grpc::internal::CallOpSendMessage,
@@ -323,6 +363,7 @@ class ClientWriter : public ClientWriterInterface<W> {
                                 ::grpc::internal::CallOpClientSendClose>
         ops;
 
+    this->ApplyCork(&options);
     if (options.is_last_message()) {
       options.set_buffer_hint();
       ops.ClientSendClose();
@@ -379,7 +420,7 @@ class ClientWriter : public ClientWriterInterface<W> {
       : context_(context),
         cq_(grpc_completion_queue_attributes{
             GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}),  // Pluckable cq
+            nullptr, 1}),  // Pluckable cq
         call_(channel->CreateCall(method, context, &cq_)) {
     finish_ops_.RecvMessage(response);
     finish_ops_.AllowNoMessage();
@@ -495,6 +536,7 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
                                 ::grpc::internal::CallOpClientSendClose>
         ops;
 
+    this->ApplyCork(&options);
     if (options.is_last_message()) {
       options.set_buffer_hint();
       ops.ClientSendClose();
@@ -554,7 +596,7 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
       : context_(context),
         cq_(grpc_completion_queue_attributes{
             GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
-            nullptr}),  // Pluckable cq
+            nullptr, 1}),  // Pluckable cq
         call_(channel->CreateCall(method, context, &cq_)) {
     if (!context_->initial_metadata_corked_) {
       ::grpc::internal::CallOpSet<::grpc::internal::CallOpSendInitialMetadata>
@@ -656,6 +698,7 @@ class ServerWriter final : public ServerWriterInterface<W> {
   ///   \a ClientContext associated with this call to fill in values).
   using internal::WriterInterface<W>::Write;
   bool Write(const W& msg, ::grpc::WriteOptions options) override {
+    this->ApplyCork(&options);
     if (options.is_last_message()) {
       options.set_buffer_hint();
     }
@@ -794,6 +837,7 @@ class ServerReaderWriter final : public ServerReaderWriterInterface<W, R> {
   ///   ServerContext associated with this call).
   using internal::WriterInterface<W>::Write;
   bool Write(const W& msg, ::grpc::WriteOptions options) override {
+    this->ApplyCork(&options);
     return body_.Write(msg, options);
   }
 
@@ -925,6 +969,7 @@ class ServerSplitStreamer final
   using internal::WriterInterface<ResponseType>::Write;
   bool Write(const ResponseType& response,
              ::grpc::WriteOptions options) override {
+    this->ApplyCork(&options);
     return read_done_ && body_.Write(response, options);
   }
 
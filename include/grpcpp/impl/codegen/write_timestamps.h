@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_IMPL_CODEGEN_WRITE_TIMESTAMPS_H
+#define GRPCPP_IMPL_CODEGEN_WRITE_TIMESTAMPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <grpc/impl/codegen/gpr_types.h>
+
+namespace grpc {
+namespace experimental {
+
+/// EXPERIMENTAL: Kernel timestamps of an RPC's most recent write to its TCP
+/// socket, as reported by the socket error queue. They are only collected on
+/// Linux, for RPCs that asked for them, and use GPR_CLOCK_REALTIME.
+///
+/// scheduled_time - sendmsg_time is the time spent in the kernel before the
+/// packet scheduler, sent_time - scheduled_time the time spent queued for the
+/// device and acked_time - sent_time the network round trip.
+struct WriteTimestamps {
+  /// Number of writes of the RPC for which all the timestamps came back
+  size_t num_writes = 0;
+  /// Number of bytes of the RPC written up to and including the most recent
+  /// write
+  uint32_t byte_offset = 0;
+  /// When the write was handed to sendmsg()
+  gpr_timespec sendmsg_time;
+  /// When the write entered the packet scheduler
+  gpr_timespec scheduled_time;
+  /// When the write was handed to the network device
+  gpr_timespec sent_time;
+  /// When the peer acknowledged all of the write
+  gpr_timespec acked_time;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_IMPL_CODEGEN_WRITE_TIMESTAMPS_H
@@ -29,6 +29,9 @@ static inline void RegisterOpenCensusPlugin() {
 static inline void RegisterOpenCensusViewsForExport() {
   ::grpc_impl::RegisterOpenCensusViewsForExport();
 }
+static inline void SetOpenCensusStatsSampling(uint32_t one_in) {
+  ::grpc_impl::SetOpenCensusStatsSampling(one_in);
+}
 static inline ::opencensus::trace::Span GetSpanFromServerContext(
     ::grpc_impl::ServerContext* context) {
   return ::grpc_impl::GetSpanFromServerContext(context);
@@ -19,6 +19,8 @@
 #ifndef GRPCPP_OPENCENSUS_IMPL_H
 #define GRPCPP_OPENCENSUS_IMPL_H
 
+#include <stdint.h>
+
 #include "opencensus/trace/span.h"
 
 namespace grpc_impl {
@@ -39,6 +41,12 @@ void RegisterOpenCensusPlugin();
 // ViewDescriptors below.
 void RegisterOpenCensusViewsForExport();
 
+// Makes the plugin record RPC stats for one RPC in every \a one_in; 0 stops
+// recording stats. The default, 1, records every RPC. Clients and servers
+// sample their RPCs independently. Spans are sampled separately, by the
+// OpenCensus trace config.
+void SetOpenCensusStatsSampling(uint32_t one_in);
+
 // Returns the tracing Span for the current RPC.
 ::opencensus::trace::Span GetSpanFromServerContext(ServerContext* context);
 
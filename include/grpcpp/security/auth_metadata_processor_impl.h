@@ -19,7 +19,9 @@
 #ifndef GRPCPP_SECURITY_AUTH_METADATA_PROCESSOR_IMPL_H
 #define GRPCPP_SECURITY_AUTH_METADATA_PROCESSOR_IMPL_H
 
+#include <chrono>
 #include <map>
+#include <vector>
 
 #include <grpcpp/security/auth_context.h>
 #include <grpcpp/support/status.h>
@@ -54,6 +56,45 @@ class AuthMetadataProcessor {
                                grpc::AuthContext* context,
                                OutputMetadata* consumed_auth_metadata,
                                OutputMetadata* response_metadata) = 0;
+
+  /// One of the calls handed to \a ProcessBatch: the arguments of \a Process,
+  /// whose return value goes to \a status.
+  struct BatchEntry {
+    const InputMetadata* auth_metadata;
+    grpc::AuthContext* context;
+    OutputMetadata* consumed_auth_metadata;
+    OutputMetadata* response_metadata;
+    grpc::Status status;
+  };
+
+  /// If this method returns more than 1 for a blocking processor, the calls
+  /// that arrive while the processor is busy are handed to \a ProcessBatch
+  /// together, up to this many at a time, instead of to \a Process one by
+  /// one, e.g. to validate their tokens with a single request to an external
+  /// service.
+  virtual size_t MaxBatchSize() const { return 1; }
+
+  /// Processes several calls at once. The default calls \a Process for each.
+  virtual void ProcessBatch(std::vector<BatchEntry>* batch) {
+    for (BatchEntry& entry : *batch) {
+      entry.status =
+          Process(*entry.auth_metadata, entry.context,
+                  entry.consumed_auth_metadata, entry.response_metadata);
+    }
+  }
+
+  /// If this method returns a positive duration, the verdict of the processor
+  /// on a call is cached for that long, keyed by the value of the call's
+  /// \a VerdictCacheMetadataKey() metadata: later calls carrying the same
+  /// value are not processed, their status, consumed and response metadata
+  /// and context properties are those of the cached verdict. Only enable it
+  /// if the verdict depends on that value alone.
+  virtual std::chrono::milliseconds VerdictCacheTtl() const {
+    return std::chrono::milliseconds(0);
+  }
+  virtual grpc::string VerdictCacheMetadataKey() const {
+    return "authorization";
+  }
 };
 
 }  // namespace grpc_impl
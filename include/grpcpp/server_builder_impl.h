@@ -225,10 +225,17 @@ class ServerBuilder {
 
   /// Options for synchronous servers.
   enum SyncServerOption {
-    NUM_CQS,         ///< Number of completion queues.
-    MIN_POLLERS,     ///< Minimum number of polling threads.
-    MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    NUM_CQS,          ///< Number of completion queues.
+    MIN_POLLERS,      ///< Minimum number of polling threads.
+    MAX_POLLERS,      ///< Maximum number of polling threads.
+    CQ_TIMEOUT_MSEC,  ///< Completion queue timeout in milliseconds.
+    /// If positive, the number of threads adapts to keep the time RPCs wait
+    /// for a thread near this many microseconds. Disabled by default.
+    TARGET_QUEUE_DELAY_USEC,
+    /// If non-zero, the CPUs the server may run on are split into NUM_CQS
+    /// groups and the threads polling each completion queue are pinned to
+    /// one group. Linux only. Disabled by default.
+    PIN_CQ_THREADS
   };
 
   /// Only useful if this is a Synchronous server.
@@ -284,6 +291,56 @@ class ServerBuilder {
     AddExternalConnectionAcceptor(ExternalConnectionType type,
                                   std::shared_ptr<ServerCredentials> creds);
 
+    /// Like \a AddCompletionQueue, but the returned completion queue splits
+    /// its events across \a num_shards sub-queues. Each thread calling \a Next
+    /// on it is given a sub-queue of its own, which receives the events that
+    /// thread completes while polling, and takes events from the other
+    /// sub-queues only when its own is empty. It is still a single completion
+    /// queue for \a RequestAsyncCall and call operations, so one can replace
+    /// a set of per-thread completion queues.
+    std::unique_ptr<ServerCompletionQueue> AddShardedCompletionQueue(
+        int num_shards, bool is_frequently_polled = true);
+
+    /// Declares that the reactions of all callback-API handlers of the server
+    /// (e.g. those of \a ServerUnaryReactor and \a ServerBidiReactor) never
+    /// block. They are then always run inline on the thread that completed
+    /// the operation, instead of from the executor, saving a thread hop.
+    void SetCallbackReactionsInline(bool inline_reactions) {
+      builder_->callback_reactions_inline_ = inline_reactions;
+    }
+
+    /// Makes the server fail queued calls fast with RESOURCE_EXHAUSTED when
+    /// it is overloaded, i.e. when calls have been waiting at least
+    /// \a target_delay_ms for a handler throughout an \a interval_ms window.
+    /// Only calls that waited over twice the target are shed. The number of
+    /// shed calls is reported by the server_calls_shed stat, and state changes
+    /// are traced in channelz.
+    void SetLoadShedding(int target_delay_ms, int interval_ms = 100) {
+      builder_->AddChannelArgument(
+          GRPC_ARG_SERVER_LOAD_SHEDDING_TARGET_DELAY_MS, target_delay_ms);
+      builder_->AddChannelArgument(GRPC_ARG_SERVER_LOAD_SHEDDING_INTERVAL_MS,
+                                   interval_ms);
+    }
+
+    /// Gives each synchronous method its own limit on concurrent calls,
+    /// starting at \a initial_limit and adapted to the latency of its calls,
+    /// up to \a max_limit. Calls over the limit fail with RESOURCE_EXHAUSTED.
+    /// The limits can be read with
+    /// \a Server::experimental_type::GetMethodConcurrencyLimits.
+    void SetAdaptiveConcurrencyLimits(int initial_limit, int max_limit) {
+      builder_->concurrency_limit_initial_ = initial_limit;
+      builder_->concurrency_limit_max_ = max_limit;
+    }
+
+    /// Puts the synchronous method \a method (e.g. "/pkg.Service/Method") in
+    /// priority class \a priority. Methods are in class 0 by default. When
+    /// calls of several methods are waiting for a thread, calls of higher
+    /// classes are handled first, but a call is never passed over more than a
+    /// few times in a row, so lower classes still make progress.
+    void SetMethodPriority(const grpc::string& method, int priority) {
+      builder_->method_priorities_[method] = priority;
+    }
+
    private:
     ServerBuilder* builder_;
   };
@@ -337,7 +394,12 @@ class ServerBuilder {
 
   struct SyncServerSettings {
     SyncServerSettings()
-        : num_cqs(1), min_pollers(1), max_pollers(2), cq_timeout_msec(10000) {}
+        : num_cqs(1),
+          min_pollers(1),
+          max_pollers(2),
+          cq_timeout_msec(10000),
+          target_queue_delay_usec(0),
+          pin_cq_threads(false) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -352,6 +414,14 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// The queueing delay that adaptive thread sizing aims for, or 0 to size
+    /// the thread pool from min_pollers and max_pollers alone.
+    int target_queue_delay_usec;
+
+    /// Whether the threads of each completion queue are pinned to their own
+    /// group of CPUs.
+    bool pin_cq_threads;
   };
 
   int max_receive_message_size_;
@@ -371,6 +441,10 @@ class ServerBuilder {
   grpc::AsyncGenericService* generic_service_{nullptr};
   grpc::experimental::CallbackGenericService* callback_generic_service_{
       nullptr};
+  bool callback_reactions_inline_ = false;
+  int concurrency_limit_initial_ = 0;
+  int concurrency_limit_max_ = 0;
+  std::map<grpc::string, int> method_priorities_;
   struct {
     bool is_set;
     grpc_compression_level level;
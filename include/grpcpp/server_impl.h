@@ -20,6 +20,7 @@
 #define GRPCPP_SERVER_IMPL_H
 
 #include <list>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -45,6 +46,7 @@ namespace grpc {
 class AsyncGenericService;
 
 namespace internal {
+class ConcurrencyLimiter;
 class ExternalConnectionAcceptorImpl;
 }  // namespace internal
 
@@ -124,6 +126,22 @@ class Server : public grpc::ServerInterface, private grpc::GrpcLibraryCodegen {
             grpc::experimental::ClientInterceptorFactoryInterface>>
             interceptor_creators);
 
+    /// The adaptive concurrency limit of a synchronous method, see
+    /// \a ServerBuilder::experimental_type::SetAdaptiveConcurrencyLimits.
+    struct MethodConcurrencyLimit {
+      grpc::string method;
+      /// The current limit on concurrent calls of the method.
+      int limit;
+      /// How many calls of the method are being handled.
+      int in_flight;
+      /// How many calls of the method were rejected because of the limit.
+      uint64_t rejected_calls;
+    };
+
+    /// Returns the adaptive concurrency limits of the synchronous methods,
+    /// or nothing if they are not enabled.
+    std::vector<MethodConcurrencyLimit> GetMethodConcurrencyLimits();
+
    private:
     Server* server_;
   };
@@ -180,10 +198,15 @@ class Server : public grpc::ServerInterface, private grpc::GrpcLibraryCodegen {
   ///
   /// \param sync_cq_timeout_msec The timeout to use when calling AsyncNext() on
   /// server completion queues passed via sync_server_cqs param.
+  ///
+  /// \param sync_target_queue_delay_usec If positive, the number of threads
+  /// per server completion queue adapts to keep the time incoming requests
+  /// wait for a thread near this value (used only in case of sync server)
   Server(int max_message_size, ChannelArguments* args,
          std::shared_ptr<std::vector<std::unique_ptr<ServerCompletionQueue>>>
              sync_server_cqs,
          int min_pollers, int max_pollers, int sync_cq_timeout_msec,
+         int sync_target_queue_delay_usec,
          std::vector<
              std::shared_ptr<grpc::internal::ExternalConnectionAcceptorImpl>>
              acceptors,
@@ -264,6 +287,12 @@ class Server : public grpc::ServerInterface, private grpc::GrpcLibraryCodegen {
   void RegisterCallbackGenericService(
       grpc::experimental::CallbackGenericService* service);
 
+  std::shared_ptr<Channel> InProcessChannelInternal(
+      const ChannelArguments& args,
+      std::vector<std::unique_ptr<
+          grpc::experimental::ClientInterceptorFactoryInterface>>
+          interceptor_creators);
+
   /// NOTE: The function experimental_registration() is not stable public API.
   /// It is a view to the experimental components of this class. It may be
   /// changed or removed at any time.
@@ -355,6 +384,25 @@ class Server : public grpc::ServerInterface, private grpc::GrpcLibraryCodegen {
   std::unique_ptr<grpc::HealthCheckServiceInterface> health_check_service_;
   bool health_check_service_disabled_;
 
+  // Whether the reactions of callback-API handlers are run inline on the
+  // thread that completed the operation.
+  bool callback_reactions_inline_ = false;
+
+  // Whether the threads of each of sync_req_mgrs_ are pinned to their own
+  // group of CPUs.
+  bool pin_sync_cq_threads_ = false;
+
+  // If concurrency_limit_max_ is non-zero, each synchronous method gets an
+  // adaptive concurrency limit starting at concurrency_limit_initial_.
+  int concurrency_limit_initial_ = 0;
+  int concurrency_limit_max_ = 0;
+  std::vector<std::unique_ptr<grpc::internal::ConcurrencyLimiter>>
+      concurrency_limiters_;
+
+  // Priority classes of synchronous methods, by method name. Calls of other
+  // methods are in class 0.
+  std::map<grpc::string, int> method_priorities_;
+
   // When appropriate, use a default callback generic service to handle
   // unimplemented methods
   std::unique_ptr<grpc::experimental::CallbackGenericService>
@@ -0,0 +1,65 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_SUPPORT_CALL_TIMELINE_H
+#define GRPCPP_SUPPORT_CALL_TIMELINE_H
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace grpc {
+namespace experimental {
+
+/// EXPERIMENTAL: When a sampled RPC went through the stages of its life, in
+/// nanoseconds of GPR_CLOCK_REALTIME. Stages the RPC did not reach, or that
+/// do not apply to it, are 0.
+struct CallTimeline {
+  bool is_client = false;
+  /// When the call was created
+  int64_t created = 0;
+  /// When the client channel picked a connection for the call
+  int64_t pick_complete = 0;
+  /// When the transport opened the call's stream on the connection
+  int64_t stream_started = 0;
+  /// When the first bytes of the call were handed to sendmsg(). Only known on
+  /// Linux, from the socket error queue.
+  int64_t first_byte_written = 0;
+  /// When the client received the response headers
+  int64_t initial_metadata_received = 0;
+  /// When the first message received was parsed
+  int64_t first_message_received = 0;
+  /// When the batch that finished the call was handed to the application
+  int64_t completion_delivered = 0;
+};
+
+/// EXPERIMENTAL: Makes one RPC in \a one_in, client or server, record a
+/// CallTimeline. 0, the default, turns recording off.
+void SetCallTimelineSampling(uint32_t one_in);
+
+/// EXPERIMENTAL: Appends the timelines of the RPCs finished since \a *cursor
+/// to \a timelines and advances \a *cursor. Start with a cursor of 0. The
+/// last 1024 timelines are kept; older ones, and the ones finishing while
+/// this runs, may be missed.
+void CollectCallTimelines(uint64_t* cursor,
+                          std::vector<CallTimeline>* timelines);
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_CALL_TIMELINE_H
@@ -0,0 +1,165 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_SUPPORT_COROUTINE_H
+#define GRPCPP_SUPPORT_COROUTINE_H
+
+/// Adapters to co_await the callback and completion queue APIs from C++20
+/// coroutines. The awaiters live in the awaiting coroutine's frame: awaiting
+/// an operation allocates nothing beyond what the underlying API does.
+///
+/// This header is empty unless the compiler supports coroutines; the library
+/// itself does not need them.
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/support/status.h>
+
+#define GRPC_HAS_COROUTINES 1
+
+namespace grpc {
+namespace experimental {
+
+/// Return type for coroutines that are started and left to run on their own,
+/// such as server handlers or client loops.
+///
+/// \code
+///   grpc::experimental::DetachedCoroutine Ping(Stub* stub) {
+///     ...
+///     Status s = co_await grpc::experimental::AwaitCallback(
+///         [&](std::function<void(Status)> done) {
+///           stub->experimental_async()->Echo(&ctx, &req, &resp,
+///                                            std::move(done));
+///         });
+///     ...
+///   }
+/// \endcode
+struct DetachedCoroutine {
+  struct promise_type {
+    DetachedCoroutine get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+/// Awaits an operation of the callback API. \a start is called with the
+/// completion callback to pass to the operation; the awaiting coroutine is
+/// resumed with the operation's status on the library thread that completed
+/// it, so no extra scheduler hop is taken.
+template <class Start>
+class CallbackAwaiter {
+ public:
+  explicit CallbackAwaiter(Start start) : start_(std::move(start)) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    // The coroutine, and this awaiter with it, may be resumed and destroyed
+    // on another thread before start returns, so run it off a local copy.
+    Start start = std::move(start_);
+    start([this](::grpc::Status status) {
+      status_ = std::move(status);
+      handle_.resume();
+    });
+  }
+
+  ::grpc::Status await_resume() { return std::move(status_); }
+
+ private:
+  Start start_;
+  std::coroutine_handle<> handle_;
+  ::grpc::Status status_;
+};
+
+template <class Start>
+CallbackAwaiter<Start> AwaitCallback(Start start) {
+  return CallbackAwaiter<Start>(std::move(start));
+}
+
+/// A completion queue tag that resumes the coroutine awaiting it. Queues
+/// whose tags are all CoroutineTags are driven by ResumeCoroutines().
+class CoroutineTag {
+ public:
+  void Resume(bool ok) {
+    ok_ = ok;
+    handle_.resume();
+  }
+
+ protected:
+  std::coroutine_handle<> handle_;
+  bool ok_ = false;
+};
+
+/// Awaits an operation of the completion queue API. \a start is called with
+/// the tag to pass to the operation; the awaiting coroutine is resumed with
+/// the operation's ok bit by the thread that takes the tag off the queue.
+///
+/// \code
+///   bool ok = co_await grpc::experimental::AwaitTag(
+///       [&](void* tag) { reader->Finish(&resp, &status, tag); });
+/// \endcode
+template <class Start>
+class TagAwaiter : public CoroutineTag {
+ public:
+  explicit TagAwaiter(Start start) : start_(std::move(start)) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    Start start = std::move(start_);
+    start(static_cast<void*>(static_cast<CoroutineTag*>(this)));
+  }
+
+  bool await_resume() const noexcept { return ok_; }
+
+ private:
+  Start start_;
+};
+
+template <class Start>
+TagAwaiter<Start> AwaitTag(Start start) {
+  return TagAwaiter<Start>(std::move(start));
+}
+
+/// Resumes the coroutines waiting on \a cq as their tags complete, on the
+/// calling thread, until the queue is shut down and drained. Several threads
+/// may drive the same queue.
+inline void ResumeCoroutines(::grpc::CompletionQueue* cq) {
+  void* tag;
+  bool ok;
+  while (cq->Next(&tag, &ok)) {
+    static_cast<CoroutineTag*>(tag)->Resume(ok);
+  }
+}
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#endif  // GRPCPP_SUPPORT_COROUTINE_H
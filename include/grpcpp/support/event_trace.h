@@ -0,0 +1,44 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_SUPPORT_EVENT_TRACE_H
+#define GRPCPP_SUPPORT_EVENT_TRACE_H
+
+#include <grpcpp/support/config.h>
+
+namespace grpc {
+namespace experimental {
+
+/// EXPERIMENTAL: Starts recording the library's internal timing events
+/// (transport, combiner, polling...) into a ring per thread. Each thread
+/// keeps its last 8192 events.
+void StartEventTrace();
+
+/// EXPERIMENTAL: Stops recording.
+void StopEventTrace();
+
+/// EXPERIMENTAL: Writes the events recorded since the last StartEventTrace()
+/// to \a filename as a Chrome trace, which chrome://tracing and the Perfetto
+/// UI load. Stop recording first. Returns false if the file could not be
+/// written, or if the library was built with another profiler.
+bool WriteEventTrace(const grpc::string& filename);
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_EVENT_TRACE_H
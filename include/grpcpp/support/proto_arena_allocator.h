@@ -0,0 +1,152 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_SUPPORT_PROTO_ARENA_ALLOCATOR_H
+#define GRPCPP_SUPPORT_PROTO_ARENA_ALLOCATOR_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <grpcpp/impl/codegen/config_protobuf.h>
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/support/message_allocator.h>
+
+namespace grpc {
+namespace experimental {
+
+/// A MessageAllocator that creates the request and response of each RPC on
+/// a protobuf arena, so that the messages and all their submessages are
+/// freed at once when the RPC is done. It is set per method, e.g. with
+/// SetMessageAllocatorFor_Echo(), and must outlive the server.
+///
+/// Arenas are pooled. Each one owns a first block, sized from what the
+/// arenas of this allocator recently needed, and keeps it across RPCs, so
+/// that once the size has settled an RPC makes no heap allocation for its
+/// messages.
+template <typename RequestT, typename ResponseT>
+class ProtoArenaMessageAllocator
+    : public MessageAllocator<RequestT, ResponseT> {
+ public:
+  /// At most \a max_pooled_arenas idle arenas are kept for reuse.
+  explicit ProtoArenaMessageAllocator(size_t max_pooled_arenas = 64)
+      : max_pooled_arenas_(max_pooled_arenas) {}
+
+  ~ProtoArenaMessageAllocator() {
+    for (Holder* holder : pool_) delete holder;
+  }
+
+  MessageHolder<RequestT, ResponseT>* AllocateMessages() override {
+    const size_t block_size = block_size_hint_.load(std::memory_order_relaxed);
+    Holder* holder = nullptr;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!pool_.empty()) {
+        holder = pool_.back();
+        pool_.pop_back();
+      }
+    }
+    // An arena whose block is smaller than what RPCs now need is replaced,
+    // so that it does not have to allocate more blocks.
+    if (holder != nullptr && holder->block_size() < block_size) {
+      delete holder;
+      holder = nullptr;
+    }
+    if (holder == nullptr) holder = new Holder(this, block_size);
+    holder->CreateMessages();
+    return holder;
+  }
+
+ private:
+  static constexpr size_t kMinBlockSize = 256;
+  static constexpr size_t kMaxBlockSize = 64 * 1024;
+
+  class Holder : public MessageHolder<RequestT, ResponseT> {
+   public:
+    Holder(ProtoArenaMessageAllocator* allocator, size_t block_size)
+        : allocator_(allocator),
+          block_(new char[block_size]),
+          block_size_(block_size),
+          arena_(Options(block_.get(), block_size)) {}
+
+    void CreateMessages() {
+      this->set_request(protobuf::Arena::CreateMessage<RequestT>(&arena_));
+      this->set_response(protobuf::Arena::CreateMessage<ResponseT>(&arena_));
+    }
+
+    void Release() override { allocator_->Recycle(this); }
+
+    size_t block_size() const { return block_size_; }
+
+    // Frees the messages, and returns the space they used.
+    size_t Reset() {
+      const size_t used = static_cast<size_t>(arena_.SpaceUsed());
+      arena_.Reset();
+      return used;
+    }
+
+   private:
+    static protobuf::ArenaOptions Options(char* block, size_t block_size) {
+      protobuf::ArenaOptions options;
+      options.initial_block = block;
+      options.initial_block_size = block_size;
+      return options;
+    }
+
+    ProtoArenaMessageAllocator* const allocator_;
+    // Must outlive arena_, which does not free it.
+    std::unique_ptr<char[]> block_;
+    const size_t block_size_;
+    protobuf::Arena arena_;
+  };
+
+  void Recycle(Holder* holder) {
+    UpdateBlockSizeHint(holder->Reset());
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (pool_.size() < max_pooled_arenas_) {
+        pool_.push_back(holder);
+        return;
+      }
+    }
+    delete holder;
+  }
+
+  // The hint rises at once to a larger need, and otherwise decays towards
+  // the recent needs by 1/16 of the difference per RPC. Concurrent updates
+  // may overwrite each other, which is fine for a hint.
+  void UpdateBlockSizeHint(size_t used) {
+    const size_t hint = block_size_hint_.load(std::memory_order_relaxed);
+    size_t new_hint = used > hint ? used : hint - (hint - used) / 16;
+    new_hint = (new_hint + kMinBlockSize - 1) / kMinBlockSize * kMinBlockSize;
+    if (new_hint > kMaxBlockSize) new_hint = kMaxBlockSize;
+    if (new_hint != hint) {
+      block_size_hint_.store(new_hint, std::memory_order_relaxed);
+    }
+  }
+
+  const size_t max_pooled_arenas_;
+  std::atomic<size_t> block_size_hint_{kMinBlockSize};
+  grpc::internal::Mutex mu_;
+  std::vector<Holder*> pool_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_PROTO_ARENA_ALLOCATOR_H
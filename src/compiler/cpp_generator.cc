@@ -40,6 +40,12 @@ inline bool ServerOnlyStreaming(const grpc_generator::Method* method) {
   return !method->ClientStreaming() && method->ServerStreaming();
 }
 
+// Whether the messages of unary methods are allocated on protobuf arenas, see
+// Parameters::use_arena.
+inline bool UseArena(const std::map<grpc::string, grpc::string>& vars) {
+  return vars.find("use_arena") != vars.end();
+}
+
 grpc::string FilenameIdentifier(const grpc::string& filename) {
   grpc::string result;
   for (unsigned i = 0; i < filename.size(); i++) {
@@ -156,6 +162,9 @@ grpc::string GetHeaderIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/sync_stream.h",
     };
     std::vector<grpc::string> headers(headers_strs, array_end(headers_strs));
+    if (params.use_arena) {
+      headers.push_back("grpcpp/support/proto_arena_allocator.h");
+    }
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
     printer->Print(vars, "\n");
@@ -1015,7 +1024,14 @@ void PrintHeaderServerMethodCallback(
         "const $RealRequest$* "
         "request, "
         "$RealResponse$* response) { "
-        "return this->$Method$(context, request, response); }));}\n");
+        "return this->$Method$(context, request, response); }));");
+    if (UseArena(*vars)) {
+      printer->Print(
+          *vars,
+          "\n  SetMessageAllocatorFor_$Method$("
+          "&this->arena_allocator_$Method$_);\n");
+    }
+    printer->Print("}\n");
     printer->Print(*vars,
                    "void SetMessageAllocatorFor_$Method$(\n"
                    "    ::grpc::experimental::MessageAllocator< "
@@ -1431,6 +1447,21 @@ void PrintHeaderService(grpc_generator::Printer* printer,
   for (int i = 0; i < service->method_count(); ++i) {
     PrintHeaderServerMethodSync(printer, service->method(i).get(), vars);
   }
+  if (UseArena(*vars)) {
+    printer->Outdent();
+    printer->Print(" protected:\n");
+    printer->Indent();
+    for (int i = 0; i < service->method_count(); ++i) {
+      auto method = service->method(i);
+      if (!method->NoStreaming()) continue;
+      (*vars)["Method"] = method->name();
+      (*vars)["Request"] = method->input_type_name();
+      (*vars)["Response"] = method->output_type_name();
+      printer->Print(*vars,
+                     "::grpc::experimental::ProtoArenaMessageAllocator< "
+                     "$Request$, $Response$> arena_allocator_$Method$_;\n");
+    }
+  }
   printer->Outdent();
   printer->Print("};\n");
 
@@ -1579,6 +1610,9 @@ grpc::string GetHeaderServices(grpc_generator::File* file,
       vars["services_namespace"] = params.services_namespace;
       printer->Print(vars, "\nnamespace $services_namespace$ {\n\n");
     }
+    if (params.use_arena) {
+      vars["use_arena"] = "true";
+    }
 
     for (int i = 0; i < file->service_count(); ++i) {
       PrintHeaderService(printer.get(), file->service(i).get(), &vars);
@@ -2039,6 +2073,8 @@ void PrintSourceService(grpc_generator::Printer* printer,
     (*vars)["Request"] = method->input_type_name();
     (*vars)["Response"] = method->output_type_name();
     if (method->NoStreaming()) {
+      (*vars)["Allocator"] =
+          UseArena(*vars) ? ", &arena_allocator_" + method->name() + "_" : "";
       printer->Print(
           *vars,
           "AddMethod(new ::grpc::internal::RpcServiceMethod(\n"
@@ -2047,7 +2083,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "    new ::grpc::internal::RpcMethodHandler< $ns$$Service$::Service, "
           "$Request$, "
           "$Response$>(\n"
-          "        std::mem_fn(&$ns$$Service$::Service::$Method$), this)));\n");
+          "        &$ns$$Service$::Service::$Method$, this$Allocator$)));\n");
     } else if (ClientOnlyStreaming(method.get())) {
       printer->Print(
           *vars,
@@ -2056,7 +2092,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "    ::grpc::internal::RpcMethod::CLIENT_STREAMING,\n"
           "    new ::grpc::internal::ClientStreamingHandler< "
           "$ns$$Service$::Service, $Request$, $Response$>(\n"
-          "        std::mem_fn(&$ns$$Service$::Service::$Method$), this)));\n");
+          "        &$ns$$Service$::Service::$Method$, this)));\n");
     } else if (ServerOnlyStreaming(method.get())) {
       printer->Print(
           *vars,
@@ -2065,7 +2101,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
           "    ::grpc::internal::RpcMethod::SERVER_STREAMING,\n"
           "    new ::grpc::internal::ServerStreamingHandler< "
           "$ns$$Service$::Service, $Request$, $Response$>(\n"
-          "        std::mem_fn(&$ns$$Service$::Service::$Method$), this)));\n");
+          "        &$ns$$Service$::Service::$Method$, this)));\n");
     } else if (method->BidiStreaming()) {
       printer->Print(
           *vars,
@@ -2108,6 +2144,9 @@ grpc::string GetSourceServices(grpc_generator::File* file,
       vars["ns"] = "";
       vars["prefix"] = "";
     }
+    if (params.use_arena) {
+      vars["use_arena"] = "true";
+    }
 
     for (int i = 0; i < file->service_count(); ++i) {
       PrintSourceService(printer.get(), file->service(i).get(), &vars);
@@ -60,6 +60,9 @@ struct Parameters {
   grpc::string message_header_extension;
   // Whether to include headers corresponding to imports in source file.
   bool include_import_headers;
+  // Allocate the messages of unary sync and callback methods on per-call
+  // protobuf arenas.
+  bool use_arena;
 };
 
 // Return the prologue of the generated header file.
@@ -50,6 +50,7 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
     generator_parameters.use_system_headers = true;
     generator_parameters.generate_mock_code = false;
     generator_parameters.include_import_headers = false;
+    generator_parameters.use_arena = false;
 
     ProtoBufFile pbfile(file);
 
@@ -94,6 +95,13 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
             *error = grpc::string("Invalid parameter: ") + *parameter_string;
             return false;
           }
+        } else if (param[0] == "arena") {
+          if (param[1] == "true") {
+            generator_parameters.use_arena = true;
+          } else if (param[1] != "false") {
+            *error = grpc::string("Invalid parameter: ") + *parameter_string;
+            return false;
+          }
         } else {
           *error = grpc::string("Unknown parameter: ") + *parameter_string;
           return false;
@@ -48,13 +48,17 @@
 #include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 #include "src/core/lib/backoff/backoff.h"
+#include "src/core/lib/channel/call_timeline.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/channel/status_util.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/reader_epochs.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/iomgr.h"
@@ -113,6 +117,21 @@ class ChannelData {
     QueuedPick* next = nullptr;
   };
 
+  // The state read by each pick.  It is replaced as a whole whenever the
+  // picker or the service config changes, so that picks can read it
+  // without holding the data plane mutex.
+  struct DataPlaneState {
+    // Owned by the channel's picker_.
+    LoadBalancingPolicy::SubchannelPicker* picker = nullptr;
+    // Data from service config.
+    bool received_service_config_data = false;
+    RefCountedPtr<ServerRetryThrottleData> retry_throttle_data;
+    RefCountedPtr<ServiceConfig> service_config;
+    // Incremented on each update, so that a pick can tell whether the
+    // state changed after it was read.
+    uint64_t generation = 0;
+  };
+
   static grpc_error* Init(grpc_channel_element* elem,
                           grpc_channel_element_args* args);
   static void Destroy(grpc_channel_element* elem);
@@ -122,6 +141,7 @@ class ChannelData {
                              const grpc_channel_info* info);
 
   bool deadline_checking_enabled() const { return deadline_checking_enabled_; }
+  bool deadline_wheel_enabled() const { return deadline_wheel_enabled_; }
   bool enable_retries() const { return enable_retries_; }
   size_t per_rpc_retry_buffer_size() const {
     return per_rpc_retry_buffer_size_;
@@ -134,22 +154,21 @@ class ChannelData {
 
   Mutex* data_plane_mu() const { return &data_plane_mu_; }
 
-  LoadBalancingPolicy::SubchannelPicker* picker() const {
-    return picker_.get();
-  }
-  void AddQueuedPick(QueuedPick* pick, grpc_polling_entity* pollent);
-  void RemoveQueuedPick(QueuedPick* to_remove, grpc_polling_entity* pollent);
-
-  bool received_service_config_data() const {
-    return received_service_config_data_;
+  // Picks read the data plane state between BeginDataPlaneRead() and
+  // EndDataPlaneRead(), or while holding the data plane mutex.
+  ReaderEpochs::Read BeginDataPlaneRead() {
+    return data_plane_readers_.BeginRead();
   }
-  RefCountedPtr<ServerRetryThrottleData> retry_throttle_data() const {
-    return retry_throttle_data_;
+  void EndDataPlaneRead(ReaderEpochs::Read read) {
+    data_plane_readers_.EndRead(read);
   }
-  RefCountedPtr<ServiceConfig> service_config() const {
-    return service_config_;
+  const DataPlaneState* data_plane_state() const {
+    return data_plane_state_.Load(MemoryOrder::ACQUIRE);
   }
 
+  void AddQueuedPick(QueuedPick* pick, grpc_polling_entity* pollent);
+  void RemoveQueuedPick(QueuedPick* to_remove, grpc_polling_entity* pollent);
+
   RefCountedPtr<ConnectedSubchannel> GetConnectedSubchannelInDataPlane(
       SubchannelInterface* subchannel) const;
 
@@ -234,6 +253,45 @@ class ChannelData {
       RefCountedPtr<ServerRetryThrottleData> retry_throttle_data,
       RefCountedPtr<ServiceConfig> service_config);
 
+  // What data plane updates unlinked, which picks that started before the
+  // update may still be reading.
+  struct RetiredDataPlaneState {
+    InlinedVector<std::unique_ptr<DataPlaneState>, 1> states;
+    InlinedVector<std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>, 1>
+        pickers;
+    InlinedVector<RefCountedPtr<ConnectedSubchannel>, 4> connected_subchannels;
+    // Subchannels that lost their connected subchannel.  A picker never
+    // returns a subchannel that has no connected subchannel, so it is only
+    // cleared once the picks with the pickers replaced along with it are
+    // done.
+    InlinedVector<SubchannelWrapper*, 4> subchannels_to_clear;
+
+    bool empty() const {
+      return states.empty() && pickers.empty() &&
+             connected_subchannels.empty() && subchannels_to_clear.empty();
+    }
+    // Moves everything in other to this.
+    void TakeFrom(RetiredDataPlaneState* other);
+  };
+
+  // Replaces the data plane state.  The previous one is retired, since
+  // picks may still be reading it.  Must be called in the control plane
+  // combiner while holding the data plane mutex.
+  void SwapDataPlaneStateLocked(std::unique_ptr<DataPlaneState> state);
+
+  // Moves the retired data plane state that picks can no longer be reading
+  // to to_free, to be destroyed once the data plane mutex is released.
+  // Whatever picks may still be reading is freed by a later update, or by
+  // a timer if none comes.  Must be called in the control plane combiner
+  // while holding the data plane mutex.
+  void FreeRetiredDataPlaneStateLocked(RetiredDataPlaneState* to_free);
+  static void OnRetiredDataPlaneStateTimer(void* arg, grpc_error* error);
+  static void OnRetiredDataPlaneStateTimerLocked(void* arg, grpc_error* error);
+
+  // Drops subchannel_wrapper from the subchannels to clear.  Must be called
+  // in the control plane combiner.
+  void ForgetSubchannelToClear(SubchannelWrapper* subchannel_wrapper);
+
   void CreateResolvingLoadBalancingPolicyLocked();
 
   void DestroyResolvingLoadBalancingPolicyLocked();
@@ -259,6 +317,7 @@ class ChannelData {
   // Fields set at construction and never modified.
   //
   const bool deadline_checking_enabled_;
+  const bool deadline_wheel_enabled_;
   const bool enable_retries_;
   const size_t per_rpc_retry_buffer_size_;
   grpc_channel_stack* owning_stack_;
@@ -270,15 +329,22 @@ class ChannelData {
   channelz::ChannelNode* channelz_node_;
 
   //
-  // Fields used in the data plane.  Guarded by data_plane_mu.
+  // Fields used in the data plane.  The state is read by picks without
+  // holding data_plane_mu, and replaced while holding it; the queued picks
+  // are guarded by it.
   //
   mutable Mutex data_plane_mu_;
-  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_;
+  Atomic<DataPlaneState*> data_plane_state_;  // Owned.
+  ReaderEpochs data_plane_readers_;
   QueuedPick* queued_picks_ = nullptr;  // Linked list of queued picks.
-  // Data from service config.
-  bool received_service_config_data_ = false;
-  RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
-  RefCountedPtr<ServiceConfig> service_config_;
+  // Retired by updates since the last flip of data_plane_readers_.
+  RetiredDataPlaneState retired_data_plane_state_;
+  // Retired before the last flip, freed once the previous epoch is done.
+  RetiredDataPlaneState waiting_data_plane_state_;
+  bool retired_data_plane_state_timer_pending_ = false;
+  grpc_timer retired_data_plane_state_timer_;
+  grpc_closure on_retired_data_plane_state_timer_;
+  grpc_closure on_retired_data_plane_state_timer_locked_;
 
   //
   // Fields used in the control plane.  Guarded by combiner.
@@ -286,6 +352,8 @@ class ChannelData {
   Combiner* combiner_;
   grpc_pollset_set* interested_parties_;
   RefCountedPtr<SubchannelPoolInterface> subchannel_pool_;
+  // The picker in the data plane state.
+  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_;
   OrphanablePtr<ResolvingLoadBalancingPolicy> resolving_lb_policy_;
   ConnectivityStateTracker state_tracker_;
   grpc_core::UniquePtr<char> health_check_service_name_;
@@ -343,7 +411,8 @@ class CallData {
   RefCountedPtr<SubchannelCall> subchannel_call() { return subchannel_call_; }
 
   // Invoked by channel for queued picks once resolver results are available.
-  void MaybeApplyServiceConfigToCallLocked(grpc_call_element* elem);
+  void MaybeApplyServiceConfigToCall(
+      grpc_call_element* elem, const ChannelData::DataPlaneState* state);
 
   // Invoked by channel for queued picks when the picker is updated.
   static void PickSubchannel(void* arg, grpc_error* error);
@@ -447,6 +516,7 @@ class CallData {
     // on_complete callback will be set to point to on_complete();
     // otherwise, the batch's on_complete callback will be null.
     static SubchannelCallBatchData* Create(grpc_call_element* elem,
+                                           SubchannelCall* subchannel_call,
                                            int refcount, bool set_on_complete);
 
     void Unref() {
@@ -454,7 +524,8 @@ class CallData {
     }
 
     SubchannelCallBatchData(grpc_call_element* elem, CallData* calld,
-                            int refcount, bool set_on_complete);
+                            SubchannelCall* subchannel_call, int refcount,
+                            bool set_on_complete);
     // All dtor code must be added in `Destroy()`. This is because we may
     // call closures in `SubchannelCallBatchData` after they are unrefed by
     // `Unref()`, and msan would complain about accessing this class
@@ -514,6 +585,13 @@ class CallData {
     grpc_metadata_batch recv_trailing_metadata;
     grpc_transport_stream_stats collect_stats;
     grpc_closure recv_trailing_metadata_ready;
+    // The LB policy's recv_trailing_metadata_ready callback for this
+    // attempt.  Tracked per attempt rather than in CallData, since an
+    // attempt superseded by a hedged one may finish after the next attempt
+    // has been picked.
+    std::function<void(grpc_error*, LoadBalancingPolicy::MetadataInterface*,
+                       LoadBalancingPolicy::CallState*)>
+        lb_recv_trailing_metadata_ready;
     // These fields indicate which ops have been started and completed on
     // this subchannel call.
     size_t started_send_message_count = 0;
@@ -535,6 +613,7 @@ class CallData {
     SubchannelCallBatchData* recv_message_ready_deferred_batch = nullptr;
     grpc_error* recv_message_error = GRPC_ERROR_NONE;
     SubchannelCallBatchData* recv_trailing_metadata_internal_batch = nullptr;
+    // Also set when the attempt is cancelled in favour of another one.
     // NOTE: Do not move this next to the metadata bitfields above. That would
     //       save space but will also result in a data race because compiler
     //       will generate a 2 byte store which overwrites the meta-data
@@ -555,8 +634,9 @@ class CallData {
   ~CallData();
 
   // Caches data for send ops so that it can be retried later, if not
-  // already cached.
-  void MaybeCacheSendOpsForBatch(PendingBatch* pending);
+  // already cached.  Returns false if a message for hedged attempts could
+  // not be cached in full.
+  bool MaybeCacheSendOpsForBatch(PendingBatch* pending);
   void FreeCachedSendInitialMetadata(ChannelData* chand);
   // Frees cached send_message at index idx.
   void FreeCachedSendMessage(ChannelData* chand, size_t idx);
@@ -603,7 +683,8 @@ class CallData {
       grpc_call_element* elem, grpc_error* error,
       YieldCallCombinerPredicate yield_call_combiner_predicate);
   static void ResumePendingBatchInCallCombiner(void* arg, grpc_error* ignored);
-  // Resumes all pending batches on subchannel_call_.
+  // Resumes all pending batches on subchannel_call_, and on any hedged
+  // attempts still running alongside it.
   void PendingBatchesResume(grpc_call_element* elem);
   // Returns a pointer to the first pending batch for which predicate(batch)
   // returns true, or null if not found.
@@ -621,6 +702,52 @@ class CallData {
   bool MaybeRetry(grpc_call_element* elem, SubchannelCallBatchData* batch_data,
                   grpc_status_code status, grpc_mdelem* server_pushback_md);
 
+  // State for the hedging delay of one call attempt.
+  struct HedgingTimer {
+    explicit HedgingTimer(grpc_call_element* elem) : elem(elem) {}
+    grpc_call_element* elem;
+    grpc_timer timer;
+    grpc_closure on_timer;
+    grpc_closure on_timer_in_call_combiner;
+  };
+  // An attempt whose result will not be used, to be cancelled.
+  struct CancelledAttempt {
+    CancelledAttempt(grpc_call_element* elem,
+                     RefCountedPtr<SubchannelCall> subchannel_call)
+        : elem(elem), subchannel_call(std::move(subchannel_call)) {}
+    grpc_call_element* elem;
+    RefCountedPtr<SubchannelCall> subchannel_call;
+    grpc_closure cancel_in_call_combiner;
+    grpc_closure on_cancel_done;
+  };
+  // Starts the hedging delay timer for the current attempt, if the call
+  // has a hedging policy and attempts remaining.
+  void MaybeStartHedgingTimer(grpc_call_element* elem);
+  void CancelHedgingTimer();
+  static void OnHedgingTimer(void* arg, grpc_error* error);
+  static void OnHedgingTimerInCallCombiner(void* arg, grpc_error* error);
+  // Starts the next attempt alongside the current one if the current one
+  // has not received a response within the hedging delay.  Returns true if
+  // a new attempt was started.
+  bool MaybeHedge(grpc_call_element* elem);
+  // Called instead of retrying when a hedged attempt fails with a retryable
+  // status.  Drops the attempt (null for a failed pick) and starts another
+  // one in its place if allowed, or else waits for the attempts still
+  // running.  Returns false if the failure is to be returned to the surface.
+  bool MaybeHedgeAfterFailure(grpc_call_element* elem,
+                              SubchannelCallBatchData* batch_data,
+                              grpc_mdelem* server_pushback_md);
+  // Removes subchannel_call from the running attempts.  If it was
+  // subchannel_call_, the newest of the other attempts takes its place.
+  void RemoveAttempt(SubchannelCall* subchannel_call);
+  // Cancels all attempts in hedged_attempts_ after making the attempt
+  // whose retry state is keep, if any, subchannel_call_.  Takes ownership
+  // of error.
+  void CancelHedgedAttempts(grpc_call_element* elem,
+                            SubchannelCallRetryState* keep, grpc_error* error);
+  static void CancelAttemptInCallCombiner(void* arg, grpc_error* error);
+  static void OnAttemptCancelled(void* arg, grpc_error* error);
+
   // Invokes recv_initial_metadata_ready for a subchannel batch.
   static void InvokeRecvInitialMetadataCallback(void* arg, grpc_error* error);
   // Intercepts recv_initial_metadata_ready callback for retries.
@@ -684,6 +811,7 @@ class CallData {
   static void StartBatchInCallCombiner(void* arg, grpc_error* ignored);
   // Adds a closure to closures that will execute batch in the call combiner.
   void AddClosureForSubchannelBatch(grpc_call_element* elem,
+                                    SubchannelCall* subchannel_call,
                                     grpc_transport_stream_op_batch* batch,
                                     CallCombinerClosureList* closures);
   // Adds retriable send_initial_metadata op to batch_data.
@@ -709,18 +837,24 @@ class CallData {
   // is used in the case where a recv_initial_metadata or recv_message
   // op fails in a way that we know the call is over but when the application
   // has not yet started its own recv_trailing_metadata op.
-  void StartInternalRecvTrailingMetadata(grpc_call_element* elem);
-  // If there are any cached send ops that need to be replayed on the
-  // current subchannel call, creates and returns a new subchannel batch
-  // to replay those ops.  Otherwise, returns nullptr.
+  void StartInternalRecvTrailingMetadata(grpc_call_element* elem,
+                                         SubchannelCall* subchannel_call);
+  // If there are any cached send ops that need to be replayed on
+  // subchannel_call, creates and returns a new subchannel batch to replay
+  // those ops.  Otherwise, returns nullptr.
   SubchannelCallBatchData* MaybeCreateSubchannelBatchForReplay(
-      grpc_call_element* elem, SubchannelCallRetryState* retry_state);
+      grpc_call_element* elem, SubchannelCall* subchannel_call);
   // Adds subchannel batches for pending batches to closures.
   void AddSubchannelBatchesForPendingBatches(
-      grpc_call_element* elem, SubchannelCallRetryState* retry_state,
+      grpc_call_element* elem, SubchannelCall* subchannel_call,
       CallCombinerClosureList* closures);
+  // Adds closures for whatever subchannel batches are needed on
+  // subchannel_call to closures.
+  void AddRetriableSubchannelBatches(grpc_call_element* elem,
+                                     SubchannelCall* subchannel_call,
+                                     CallCombinerClosureList* closures);
   // Constructs and starts whatever subchannel batches are needed on the
-  // subchannel call.
+  // subchannel calls of all running attempts.
   static void StartRetriableSubchannelBatches(void* arg, grpc_error* ignored);
 
   void CreateSubchannelCall(grpc_call_element* elem);
@@ -732,7 +866,16 @@ class CallData {
   void AddCallToQueuedPicksLocked(grpc_call_element* elem);
   // Applies service config to the call.  Must be invoked once we know
   // that the resolver has returned results to the channel.
-  void ApplyServiceConfigToCallLocked(grpc_call_element* elem);
+  void ApplyServiceConfigToCall(grpc_call_element* elem,
+                                const ChannelData::DataPlaneState* state);
+  // Attempts a pick with the picker in state, which must not be null.
+  // Returns true if the pick is complete, with *error set.  Otherwise,
+  // sets *queue to whether the call must wait for a new picker.  Does not
+  // touch the queued picks, so it may be called without holding the data
+  // plane mutex.
+  bool AttemptPick(grpc_call_element* elem,
+                   const ChannelData::DataPlaneState* state,
+                   grpc_error** error, bool* queue);
 
   // State for handling deadlines.
   // The code in deadline_filter.c requires this to be the first field.
@@ -755,6 +898,12 @@ class CallData {
   const ClientChannelMethodParsedConfig* method_params_ = nullptr;
 
   RefCountedPtr<SubchannelCall> subchannel_call_;
+  // When hedging, the attempts started before subchannel_call_ that are
+  // still running alongside it.
+  InlinedVector<RefCountedPtr<SubchannelCall>, 2> hedged_attempts_;
+  // The call contexts of attempts started while another one was running.
+  // Values set in them by the subchannel stack are destroyed with the call.
+  InlinedVector<grpc_call_context_element*, 2> hedged_attempt_contexts_;
 
   // Set when we get a cancel_stream op.
   grpc_error* cancel_error_ = GRPC_ERROR_NONE;
@@ -770,6 +919,8 @@ class CallData {
                      LoadBalancingPolicy::CallState*)>
       lb_recv_trailing_metadata_ready_;
   grpc_closure pick_closure_;
+  // When the current pick started.
+  gpr_cycle_counter pick_start_ = 0;
 
   // For intercepting recv_trailing_metadata_ready for the LB policy.
   grpc_metadata_batch* recv_trailing_metadata_ = nullptr;
@@ -797,6 +948,12 @@ class CallData {
   // TODO(roth): Restructure this to eliminate use of ManualConstructor.
   ManualConstructor<BackOff> retry_backoff_;
   grpc_timer retry_timer_;
+  // The pending hedging delay timer of the current attempt, if any.
+  HedgingTimer* hedging_timer_ = nullptr;
+  // Set once an attempt has been cancelled in favour of another one.  As it
+  // may still be reading the cached send ops, they are then freed only with
+  // the call.
+  bool free_cached_send_ops_on_destroy_ = false;
 
   // The number of pending retriable subchannel batches containing send ops.
   // We hold a ref to the call stack while this is non-zero, since replay
@@ -872,6 +1029,9 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
               "chand=%p: destroying subchannel wrapper %p for subchannel %p",
               chand_, this, subchannel_);
     }
+    // Release the ref held for the data plane.
+    set_connected_subchannel_in_data_plane(nullptr);
+    chand_->ForgetSubchannelToClear(this);
     chand_->subchannel_wrappers_.erase(this);
     auto* subchannel_node = subchannel_->channelz_node();
     if (subchannel_node != nullptr) {
@@ -925,6 +1085,14 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
 
   void ResetBackoff() override { subchannel_->ResetBackoff(); }
 
+  // Caller must be reading the data plane state, as pickers do.
+  bool IsSaturated() override {
+    ConnectedSubchannel* connected_subchannel =
+        connected_subchannel_in_data_plane();
+    return connected_subchannel != nullptr &&
+           connected_subchannel->IsSaturated();
+  }
+
   const grpc_channel_args* channel_args() override {
     return subchannel_->channel_args();
   }
@@ -970,13 +1138,17 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
     return connected_subchannel_.get();
   }
 
-  // Caller must be holding the data-plane mutex.
+  // Caller must be reading the data plane state.
   ConnectedSubchannel* connected_subchannel_in_data_plane() const {
-    return connected_subchannel_in_data_plane_.get();
+    return connected_subchannel_in_data_plane_.Load(MemoryOrder::ACQUIRE);
   }
-  void set_connected_subchannel_in_data_plane(
+  // Returns the previous value, which picks may still be reading until the
+  // data plane state retired along with it is freed.
+  RefCountedPtr<ConnectedSubchannel> set_connected_subchannel_in_data_plane(
       RefCountedPtr<ConnectedSubchannel> connected_subchannel) {
-    connected_subchannel_in_data_plane_ = std::move(connected_subchannel);
+    return RefCountedPtr<ConnectedSubchannel>(
+        connected_subchannel_in_data_plane_.Exchange(
+            connected_subchannel.release(), MemoryOrder::ACQ_REL));
   }
 
  private:
@@ -1125,8 +1297,8 @@ class ChannelData::SubchannelWrapper : public SubchannelInterface {
   std::map<ConnectivityStateWatcherInterface*, WatcherWrapper*> watcher_map_;
   // To be accessed only in the control plane combiner.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
-  // To be accessed only in the data plane mutex.
-  RefCountedPtr<ConnectedSubchannel> connected_subchannel_in_data_plane_;
+  // Set in the data plane mutex, read by picks.  Holds a ref.
+  Atomic<ConnectedSubchannel*> connected_subchannel_in_data_plane_{nullptr};
 };
 
 //
@@ -1411,6 +1583,7 @@ channelz::ChannelNode* GetChannelzNode(const grpc_channel_args* args) {
 ChannelData::ChannelData(grpc_channel_element_args* args, grpc_error** error)
     : deadline_checking_enabled_(
           grpc_deadline_checking_enabled(args->channel_args)),
+      deadline_wheel_enabled_(grpc_deadline_wheel_enabled(args->channel_args)),
       enable_retries_(GetEnableRetries(args->channel_args)),
       per_rpc_retry_buffer_size_(
           GetMaxPerRpcRetryBufferSize(args->channel_args)),
@@ -1418,7 +1591,9 @@ ChannelData::ChannelData(grpc_channel_element_args* args, grpc_error** error)
       client_channel_factory_(
           ClientChannelFactory::GetFromChannelArgs(args->channel_args)),
       channelz_node_(GetChannelzNode(args->channel_args)),
-      combiner_(grpc_combiner_create()),
+      data_plane_state_(new DataPlaneState()),
+      data_plane_readers_(),
+      combiner_(grpc_combiner_create("client_channel")),
       interested_parties_(grpc_pollset_set_create()),
       subchannel_pool_(GetSubchannelPool(args->channel_args)),
       state_tracker_("client_channel", GRPC_CHANNEL_IDLE),
@@ -1429,8 +1604,6 @@ ChannelData::ChannelData(grpc_channel_element_args* args, grpc_error** error)
   }
   // Initialize data members.
   gpr_mu_init(&info_mu_);
-  // Start backup polling.
-  grpc_client_channel_start_backup_polling(interested_parties_);
   // Check client channel factory.
   if (client_channel_factory_ == nullptr) {
     *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -1486,11 +1659,10 @@ ChannelData::~ChannelData() {
   }
   DestroyResolvingLoadBalancingPolicyLocked();
   grpc_channel_args_destroy(channel_args_);
-  // Stop backup polling.
-  grpc_client_channel_stop_backup_polling(interested_parties_);
   grpc_pollset_set_destroy(interested_parties_);
   GRPC_COMBINER_UNREF(combiner_, "client_channel");
   GRPC_ERROR_UNREF(disconnect_error_.Load(MemoryOrder::RELAXED));
+  delete data_plane_state_.Load(MemoryOrder::RELAXED);
   gpr_mu_destroy(&info_mu_);
 }
 
@@ -1521,36 +1693,58 @@ void ChannelData::UpdateStateAndPickerLocked(
   // the refs until after we release the lock, and then unref them at
   // that point.  This includes the following:
   // - refs to subchannel wrappers in the keys of pending_subchannel_updates_
-  // - ref stored in retry_throttle_data_
-  // - ref stored in service_config_
-  // - ownership of the existing picker in picker_
-  RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_to_unref;
-  RefCountedPtr<ServiceConfig> service_config_to_unref;
+  // - retired data plane state that picks are done with
+  // Whatever picks may still be reading (the previous data plane state, the
+  // previous picker and the connected subchannels replaced in the subchannel
+  // wrappers) is retired, to be freed by a later update or timer.
+  RetiredDataPlaneState to_free;
   {
     MutexLock lock(&data_plane_mu_);
-    // Handle subchannel updates.
+    // Picks may still be using the old picker without holding the lock,
+    // and a picker never returns a subchannel that has no connected
+    // subchannel.  So we set the new connected subchannels before the new
+    // picker can see them, and clear the ones that went away only after
+    // picks with the old picker are done.
     for (auto& p : pending_subchannel_updates_) {
+      // Note: We do not remove the entry from pending_subchannel_updates_
+      // here, since this would unref the subchannel wrapper; instead,
+      // we wait until we've released the lock to clear the map.
+      ForgetSubchannelToClear(p.first.get());
+      if (p.second == nullptr) {
+        retired_data_plane_state_.subchannels_to_clear.push_back(
+            p.first.get());
+        continue;
+      }
       if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
         gpr_log(GPR_INFO,
                 "chand=%p: updating subchannel wrapper %p data plane "
                 "connected_subchannel to %p",
                 this, p.first.get(), p.second.get());
       }
-      // Note: We do not remove the entry from pending_subchannel_updates_
-      // here, since this would unref the subchannel wrapper; instead,
-      // we wait until we've released the lock to clear the map.
-      p.first->set_connected_subchannel_in_data_plane(std::move(p.second));
+      RefCountedPtr<ConnectedSubchannel> old_connected_subchannel =
+          p.first->set_connected_subchannel_in_data_plane(p.second);
+      if (old_connected_subchannel != nullptr) {
+        retired_data_plane_state_.connected_subchannels.push_back(
+            std::move(old_connected_subchannel));
+      }
     }
     // Swap out the picker.
-    // Note: Original value will be destroyed after the lock is released.
     picker_.swap(picker);
+    if (picker != nullptr) {
+      retired_data_plane_state_.pickers.push_back(std::move(picker));
+    }
+    std::unique_ptr<DataPlaneState> state = MakeUnique<DataPlaneState>();
+    state->picker = picker_.get();
     // Clean the data plane if the updated picker is nullptr.
-    if (picker_ == nullptr) {
-      received_service_config_data_ = false;
-      // Note: We save the objects to unref until after the lock is released.
-      retry_throttle_data_to_unref = std::move(retry_throttle_data_);
-      service_config_to_unref = std::move(service_config_);
+    if (picker_ != nullptr) {
+      const DataPlaneState* old_state = data_plane_state();
+      state->received_service_config_data =
+          old_state->received_service_config_data;
+      state->retry_throttle_data = old_state->retry_throttle_data;
+      state->service_config = old_state->service_config;
     }
+    SwapDataPlaneStateLocked(std::move(state));
+    FreeRetiredDataPlaneStateLocked(&to_free);
     // Re-process queued picks.
     for (QueuedPick* pick = queued_picks_; pick != nullptr; pick = pick->next) {
       grpc_call_element* elem = pick->elem;
@@ -1573,23 +1767,141 @@ void ChannelData::UpdateServiceConfigLocked(
   //
   // We defer unreffing the old values (and deallocating memory) until
   // after releasing the lock to keep the critical section small.
+  RetiredDataPlaneState to_free;
   {
     MutexLock lock(&data_plane_mu_);
     // Update service config.
-    received_service_config_data_ = true;
-    // Old values will be unreffed after lock is released.
-    retry_throttle_data_.swap(retry_throttle_data);
-    service_config_.swap(service_config);
+    std::unique_ptr<DataPlaneState> state = MakeUnique<DataPlaneState>();
+    state->picker = picker_.get();
+    state->received_service_config_data = true;
+    state->retry_throttle_data = std::move(retry_throttle_data);
+    state->service_config = std::move(service_config);
+    // Old values will be unreffed once picks are done with them.
+    SwapDataPlaneStateLocked(std::move(state));
+    FreeRetiredDataPlaneStateLocked(&to_free);
     // Apply service config to queued picks.
+    const DataPlaneState* current_state = data_plane_state();
     for (QueuedPick* pick = queued_picks_; pick != nullptr; pick = pick->next) {
       CallData* calld = static_cast<CallData*>(pick->elem->call_data);
-      calld->MaybeApplyServiceConfigToCallLocked(pick->elem);
+      calld->MaybeApplyServiceConfigToCall(pick->elem, current_state);
     }
   }
   // Old values will be unreffed after lock is released when they go out
   // of scope.
 }
 
+void ChannelData::RetiredDataPlaneState::TakeFrom(
+    RetiredDataPlaneState* other) {
+  for (size_t i = 0; i < other->states.size(); ++i) {
+    states.push_back(std::move(other->states[i]));
+  }
+  for (size_t i = 0; i < other->pickers.size(); ++i) {
+    pickers.push_back(std::move(other->pickers[i]));
+  }
+  for (size_t i = 0; i < other->connected_subchannels.size(); ++i) {
+    connected_subchannels.push_back(
+        std::move(other->connected_subchannels[i]));
+  }
+  for (size_t i = 0; i < other->subchannels_to_clear.size(); ++i) {
+    subchannels_to_clear.push_back(other->subchannels_to_clear[i]);
+  }
+  other->states.clear();
+  other->pickers.clear();
+  other->connected_subchannels.clear();
+  other->subchannels_to_clear.clear();
+}
+
+void ChannelData::SwapDataPlaneStateLocked(
+    std::unique_ptr<DataPlaneState> state) {
+  state->generation = data_plane_state()->generation + 1;
+  retired_data_plane_state_.states.emplace_back(
+      data_plane_state_.Exchange(state.release(), MemoryOrder::ACQ_REL));
+}
+
+void ChannelData::FreeRetiredDataPlaneStateLocked(
+    RetiredDataPlaneState* to_free) {
+  // Same scheme as the interned slice table: what was retired before the
+  // last flip is freed once the previous epoch is done, and only then is
+  // what was retired since moved over and the epoch flipped again.  Reads
+  // last for a single pick, so this usually completes right away.
+  while (true) {
+    if (!waiting_data_plane_state_.empty()) {
+      if (!data_plane_readers_.PreviousEpochDone()) break;
+      // No pick is using the pickers retired along with these any more.
+      InlinedVector<SubchannelWrapper*, 4>& to_clear =
+          waiting_data_plane_state_.subchannels_to_clear;
+      for (size_t i = 0; i < to_clear.size(); ++i) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+          gpr_log(GPR_INFO,
+                  "chand=%p: clearing subchannel wrapper %p data plane "
+                  "connected_subchannel",
+                  this, to_clear[i]);
+        }
+        RefCountedPtr<ConnectedSubchannel> old_connected_subchannel =
+            to_clear[i]->set_connected_subchannel_in_data_plane(nullptr);
+        if (old_connected_subchannel != nullptr) {
+          retired_data_plane_state_.connected_subchannels.push_back(
+              std::move(old_connected_subchannel));
+        }
+      }
+      to_clear.clear();
+      to_free->TakeFrom(&waiting_data_plane_state_);
+    }
+    if (retired_data_plane_state_.empty()) break;
+    waiting_data_plane_state_.TakeFrom(&retired_data_plane_state_);
+    data_plane_readers_.Flip();
+  }
+  if (!waiting_data_plane_state_.empty() &&
+      !retired_data_plane_state_timer_pending_) {
+    retired_data_plane_state_timer_pending_ = true;
+    GRPC_CHANNEL_STACK_REF(owning_stack_, "retired_data_plane_state_timer");
+    GRPC_CLOSURE_INIT(&on_retired_data_plane_state_timer_,
+                      OnRetiredDataPlaneStateTimer, this, nullptr);
+    grpc_timer_init(&retired_data_plane_state_timer_,
+                    ExecCtx::Get()->Now() + 10,
+                    &on_retired_data_plane_state_timer_);
+  }
+}
+
+void ChannelData::OnRetiredDataPlaneStateTimer(void* arg,
+                                               grpc_error* /*error*/) {
+  ChannelData* chand = static_cast<ChannelData*>(arg);
+  chand->combiner_->Run(
+      GRPC_CLOSURE_INIT(&chand->on_retired_data_plane_state_timer_locked_,
+                        OnRetiredDataPlaneStateTimerLocked, chand, nullptr),
+      GRPC_ERROR_NONE);
+}
+
+void ChannelData::OnRetiredDataPlaneStateTimerLocked(void* arg,
+                                                     grpc_error* /*error*/) {
+  ChannelData* chand = static_cast<ChannelData*>(arg);
+  chand->retired_data_plane_state_timer_pending_ = false;
+  {
+    RetiredDataPlaneState to_free;
+    MutexLock lock(&chand->data_plane_mu_);
+    chand->FreeRetiredDataPlaneStateLocked(&to_free);
+  }
+  GRPC_CHANNEL_STACK_UNREF(chand->owning_stack_,
+                           "retired_data_plane_state_timer");
+}
+
+void ChannelData::ForgetSubchannelToClear(
+    SubchannelWrapper* subchannel_wrapper) {
+  RetiredDataPlaneState* const retired[] = {&retired_data_plane_state_,
+                                            &waiting_data_plane_state_};
+  for (RetiredDataPlaneState* state : retired) {
+    InlinedVector<SubchannelWrapper*, 4>& to_clear =
+        state->subchannels_to_clear;
+    for (size_t i = 0; i < to_clear.size(); ++i) {
+      if (to_clear[i] == subchannel_wrapper) {
+        to_clear[i] = to_clear[to_clear.size() - 1];
+        to_clear.pop_back();
+        break;
+      }
+    }
+  }
+}
+
 void ChannelData::CreateResolvingLoadBalancingPolicyLocked() {
   // Instantiate resolving LB policy.
   LoadBalancingPolicy::Args lb_args;
@@ -1602,6 +1914,10 @@ void ChannelData::CreateResolvingLoadBalancingPolicyLocked() {
       std::move(target_uri), ProcessResolverResultLocked, this));
   grpc_pollset_set_add_pollset_set(resolving_lb_policy_->interested_parties(),
                                    interested_parties_);
+  // Only a channel that is out of IDLE has connections or resolver requests
+  // that may need polling while the application polls nothing, so idle
+  // channels do not keep the backup poller's timer running.
+  grpc_client_channel_start_backup_polling(interested_parties_);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
     gpr_log(GPR_INFO, "chand=%p: created resolving_lb_policy=%p", this,
             resolving_lb_policy_.get());
@@ -1613,6 +1929,7 @@ void ChannelData::DestroyResolvingLoadBalancingPolicyLocked() {
     grpc_pollset_set_del_pollset_set(resolving_lb_policy_->interested_parties(),
                                      interested_parties_);
     resolving_lb_policy_.reset();
+    grpc_client_channel_stop_backup_polling(interested_parties_);
   }
 }
 
@@ -2019,7 +2336,8 @@ CallData::CallData(grpc_call_element* elem, const ChannelData& chand,
     : deadline_state_(elem, args.call_stack, args.call_combiner,
                       GPR_LIKELY(chand.deadline_checking_enabled())
                           ? args.deadline
-                          : GRPC_MILLIS_INF_FUTURE),
+                          : GRPC_MILLIS_INF_FUTURE,
+                      chand.deadline_wheel_enabled()),
       path_(grpc_slice_ref_internal(args.path)),
       call_start_time_(args.start_time),
       deadline_(args.deadline),
@@ -2046,6 +2364,23 @@ CallData::~CallData() {
   for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
     GPR_ASSERT(pending_batches_[i].batch == nullptr);
   }
+  if (free_cached_send_ops_on_destroy_) {
+    if (seen_send_initial_metadata_) {
+      grpc_metadata_batch_destroy(&send_initial_metadata_);
+    }
+    for (size_t i = 0; i < send_messages_.size(); ++i) {
+      send_messages_[i]->Destroy();
+    }
+    if (seen_send_trailing_metadata_) {
+      grpc_metadata_batch_destroy(&send_trailing_metadata_);
+    }
+  }
+  for (size_t i = 0; i < hedged_attempt_contexts_.size(); ++i) {
+    grpc_call_context_element* context = hedged_attempt_contexts_[i];
+    for (size_t j = 0; j < GRPC_CONTEXT_COUNT; ++j) {
+      if (context[j].destroy != nullptr) context[j].destroy(context[j].value);
+    }
+  }
 }
 
 grpc_error* CallData::Init(grpc_call_element* elem,
@@ -2113,6 +2448,10 @@ void CallData::StartTransportStreamOpBatch(
       grpc_transport_stream_op_batch_finish_with_failure(
           batch, GRPC_ERROR_REF(calld->cancel_error_), calld->call_combiner_);
     } else {
+      // Only the newest attempt sees the cancellation; any others are
+      // cancelled on our side.
+      calld->CancelHedgedAttempts(elem, nullptr,
+                                  GRPC_ERROR_REF(calld->cancel_error_));
       // Note: This will release the call combiner.
       calld->subchannel_call_->StartTransportStreamOpBatch(batch);
     }
@@ -2121,8 +2460,8 @@ void CallData::StartTransportStreamOpBatch(
   // Add the batch to the pending list.
   calld->PendingBatchesAdd(elem, batch);
   // Check if we've already gotten a subchannel call.
-  // Note that once we have picked a subchannel, we do not need to acquire
-  // the channel's data plane mutex, which is more efficient (especially for
+  // Note that once we have picked a subchannel, we do not need to read
+  // the channel's data plane state, which is more efficient (especially for
   // streaming calls).
   if (calld->subchannel_call_ != nullptr) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
@@ -2134,12 +2473,11 @@ void CallData::StartTransportStreamOpBatch(
     return;
   }
   // We do not yet have a subchannel call.
-  // For batches containing a send_initial_metadata op, acquire the
-  // channel's data plane mutex to pick a subchannel.
+  // For batches containing a send_initial_metadata op, pick a subchannel.
   if (GPR_LIKELY(batch->send_initial_metadata)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
       gpr_log(GPR_INFO,
-              "chand=%p calld=%p: grabbing data plane mutex to perform pick",
+              "chand=%p calld=%p: performing pick",
               chand, calld);
     }
     PickSubchannel(elem, GRPC_ERROR_NONE);
@@ -2165,9 +2503,10 @@ void CallData::SetPollent(grpc_call_element* elem,
 // send op data caching
 //
 
-void CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
-  if (pending->send_ops_cached) return;
+bool CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
+  if (pending->send_ops_cached) return true;
   pending->send_ops_cached = true;
+  bool ok = true;
   grpc_transport_stream_op_batch* batch = pending->batch;
   // Save a copy of metadata for send_initial_metadata ops.
   if (batch->send_initial_metadata) {
@@ -2182,12 +2521,23 @@ void CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
     send_initial_metadata_flags_ =
         batch->payload->send_initial_metadata.send_initial_metadata_flags;
     peer_string_ = batch->payload->send_initial_metadata.peer_string;
+    GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_CLIENT_RETRY_BUFFERED_BYTES,
+                              grpc_metadata_batch_size(send_initial_metadata));
   }
-  // Set up cache for send_message ops.
+  // Set up cache for send_message ops.  The cache holds refs to the slices
+  // of the message as they are sent, rather than copies.
   if (batch->send_message) {
+    GRPC_STATS_INC_COUNTER_BY(
+        GRPC_STATS_COUNTER_CLIENT_RETRY_BUFFERED_BYTES,
+        batch->payload->send_message.send_message->length());
     ByteStreamCache* cache = arena_->New<ByteStreamCache>(
         std::move(batch->payload->send_message.send_message));
     send_messages_.push_back(cache);
+    // Hedged attempts may read the message at the same time from different
+    // transports, so they must only ever read it from the cache.
+    if (method_params_->retry_policy()->hedging && !cache->CacheAll()) {
+      ok = false;
+    }
   }
   // Save metadata batch for send_trailing_metadata ops.
   if (batch->send_trailing_metadata) {
@@ -2200,6 +2550,7 @@ void CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
     grpc_metadata_batch_copy(send_trailing_metadata, &send_trailing_metadata_,
                              send_trailing_metadata_storage_);
   }
+  return ok;
 }
 
 void CallData::FreeCachedSendInitialMetadata(ChannelData* chand) {
@@ -2232,6 +2583,7 @@ void CallData::FreeCachedSendTrailingMetadata(ChannelData* chand) {
 void CallData::FreeCachedSendOpDataAfterCommit(
     grpc_call_element* elem, SubchannelCallRetryState* retry_state) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  if (free_cached_send_ops_on_destroy_) return;
   if (retry_state->completed_send_initial_metadata) {
     FreeCachedSendInitialMetadata(chand);
   }
@@ -2247,6 +2599,7 @@ void CallData::FreeCachedSendOpDataForCompletedBatch(
     grpc_call_element* elem, SubchannelCallBatchData* batch_data,
     SubchannelCallRetryState* retry_state) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  if (free_cached_send_ops_on_destroy_) return;
   if (batch_data->batch.send_initial_metadata) {
     FreeCachedSendInitialMetadata(chand);
   }
@@ -2344,6 +2697,9 @@ void CallData::PendingBatchesAdd(grpc_call_element* elem,
                 "chand=%p calld=%p: exceeded retry buffer size, committing",
                 chand, this);
       }
+      if (!retry_committed_) {
+        GRPC_STATS_INC_CLIENT_RETRY_BUFFER_OVERFLOW_COMMITS();
+      }
       SubchannelCallRetryState* retry_state =
           subchannel_call_ == nullptr ? nullptr
                                       : static_cast<SubchannelCallRetryState*>(
@@ -2425,6 +2781,8 @@ void CallData::PendingBatchesFail(
             "chand=%p calld=%p: failing %" PRIuPTR " pending batches: %s",
             elem->channel_data, this, num_batches, grpc_error_string(error));
   }
+  // No attempt still running can complete the batches now.
+  CancelHedgedAttempts(elem, nullptr, GRPC_ERROR_REF(error));
   CallCombinerClosureList closures;
   for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
     PendingBatch* pending = &pending_batches_[i];
@@ -2532,9 +2890,23 @@ void CallData::RetryCommit(grpc_call_element* elem,
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand, this);
   }
+  CancelHedgingTimer();
+  // Only the attempt committed to carries on.
+  if (!hedged_attempts_.empty()) {
+    CancelHedgedAttempts(
+        elem, retry_state,
+        grpc_error_set_int(
+            GRPC_ERROR_CREATE_FROM_STATIC_STRING("Lost to hedged attempt"),
+            GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED));
+  }
   if (retry_state != nullptr) {
     FreeCachedSendOpDataAfterCommit(elem, retry_state);
   }
+  // No message will be replayed now, so the rest of the slices of those
+  // still being sent need not be held.
+  for (size_t i = 0; i < send_messages_.size(); ++i) {
+    send_messages_[i]->StopCaching();
+  }
 }
 
 void CallData::DoRetry(grpc_call_element* elem,
@@ -2546,11 +2918,16 @@ void CallData::DoRetry(grpc_call_element* elem,
   GPR_ASSERT(retry_policy != nullptr);
   // Reset subchannel call.
   subchannel_call_.reset();
+  // Any hedging delay was for the attempt that just ended.
+  CancelHedgingTimer();
   // Compute backoff delay.
   grpc_millis next_attempt_time;
   if (server_pushback_ms >= 0) {
     next_attempt_time = ExecCtx::Get()->Now() + server_pushback_ms;
     last_attempt_got_server_pushback_ = true;
+  } else if (retry_policy->hedging) {
+    // Hedged attempts are spaced out by the hedging delay, not by backoff.
+    next_attempt_time = ExecCtx::Get()->Now();
   } else {
     if (num_attempts_completed_ == 1 || last_attempt_got_server_pushback_) {
       retry_backoff_.Init(
@@ -2619,6 +2996,10 @@ bool CallData::MaybeRetry(grpc_call_element* elem,
     }
     return false;
   }
+  // Hedged attempts overlap, so a failed one may have others to wait for.
+  if (retry_policy->hedging) {
+    return MaybeHedgeAfterFailure(elem, batch_data, server_pushback_md);
+  }
   // Record the failure and check whether retries are throttled.
   // Note that it's important for this check to come after the status
   // code check above, since we should only record failures whose statuses
@@ -2683,24 +3064,264 @@ bool CallData::MaybeRetry(grpc_call_element* elem,
   return true;
 }
 
+//
+// hedging
+//
+
+void CallData::MaybeStartHedgingTimer(grpc_call_element* elem) {
+  const auto* retry_policy = method_params_->retry_policy();
+  if (!retry_policy->hedging || retry_policy->hedging_delay == 0) return;
+  if (retry_committed_ ||
+      num_attempts_completed_ + 1 >= retry_policy->max_attempts) {
+    return;
+  }
+  hedging_timer_ = arena_->New<HedgingTimer>(elem);
+  GRPC_CALL_STACK_REF(owning_call_, "hedging_timer");
+  GRPC_CLOSURE_INIT(&hedging_timer_->on_timer, OnHedgingTimer, hedging_timer_,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&hedging_timer_->timer,
+                  ExecCtx::Get()->Now() + retry_policy->hedging_delay,
+                  &hedging_timer_->on_timer);
+}
+
+void CallData::CancelHedgingTimer() {
+  if (hedging_timer_ != nullptr) {
+    grpc_timer_cancel(&hedging_timer_->timer);
+    hedging_timer_ = nullptr;
+  }
+}
+
+void CallData::OnHedgingTimer(void* arg, grpc_error* error) {
+  HedgingTimer* timer = static_cast<HedgingTimer*>(arg);
+  CallData* calld = static_cast<CallData*>(timer->elem->call_data);
+  if (error == GRPC_ERROR_NONE) {
+    GRPC_CLOSURE_INIT(&timer->on_timer_in_call_combiner,
+                      OnHedgingTimerInCallCombiner, timer, nullptr);
+    GRPC_CALL_COMBINER_START(calld->call_combiner_,
+                             &timer->on_timer_in_call_combiner,
+                             GRPC_ERROR_NONE, "hedging timer");
+    return;
+  }
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "hedging_timer");
+}
+
+void CallData::OnHedgingTimerInCallCombiner(void* arg, grpc_error* /*error*/) {
+  HedgingTimer* timer = static_cast<HedgingTimer*>(arg);
+  CallData* calld = static_cast<CallData*>(timer->elem->call_data);
+  // The timer may have fired just as it was cancelled, in which case it
+  // is no longer the current one.
+  bool hedged = false;
+  if (calld->hedging_timer_ == timer) {
+    calld->hedging_timer_ = nullptr;
+    hedged = calld->MaybeHedge(timer->elem);
+  }
+  // If we hedged, the new attempt holds the call combiner until its
+  // batches are started, just like a retry.
+  if (!hedged) {
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "hedging timer");
+  }
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "hedging_timer");
+}
+
+bool CallData::MaybeHedge(grpc_call_element* elem) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  const auto* retry_policy = method_params_->retry_policy();
+  if (retry_committed_ || cancel_error_ != GRPC_ERROR_NONE ||
+      subchannel_call_ == nullptr) {
+    return false;
+  }
+  // Only hedge while the current attempt has not heard from the server.
+  SubchannelCallRetryState* retry_state =
+      static_cast<SubchannelCallRetryState*>(
+          subchannel_call_->GetParentData());
+  if (retry_state->retry_dispatched ||
+      retry_state->completed_recv_initial_metadata ||
+      retry_state->completed_recv_trailing_metadata) {
+    return false;
+  }
+  if (num_attempts_completed_ + 1 >= retry_policy->max_attempts) return false;
+  // A hedged attempt spends throttling tokens just like a retry after a
+  // failure, so that hedging stops adding load to overloaded backends.
+  if (retry_throttle_data_ != nullptr &&
+      !retry_throttle_data_->RecordFailure()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: hedging throttled", chand, this);
+    }
+    return false;
+  }
+  ++num_attempts_completed_;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: no response within hedging delay, "
+            "starting attempt %d alongside subchannel_call=%p",
+            chand, this, num_attempts_completed_ + 1, subchannel_call_.get());
+  }
+  // The current attempt keeps running; whichever attempt gets a response
+  // first is committed to.
+  hedged_attempts_.push_back(std::move(subchannel_call_));
+  DoRetry(elem, nullptr /* retry_state */, -1 /* server_pushback_ms */);
+  return true;
+}
+
+bool CallData::MaybeHedgeAfterFailure(grpc_call_element* elem,
+                                      SubchannelCallBatchData* batch_data,
+                                      grpc_mdelem* server_pushback_md) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  const auto* retry_policy = method_params_->retry_policy();
+  if (retry_committed_ || cancel_error_ != GRPC_ERROR_NONE) return false;
+  const bool throttled = retry_throttle_data_ != nullptr &&
+                         !retry_throttle_data_->RecordFailure();
+  // A server push-back delays the next attempt; an unparseable one means
+  // that no more attempts are to be started.
+  grpc_millis server_pushback_ms = -1;
+  bool pushback_allows_attempt = true;
+  if (server_pushback_md != nullptr) {
+    uint32_t ms;
+    if (grpc_parse_slice_to_uint32(GRPC_MDVALUE(*server_pushback_md), &ms)) {
+      server_pushback_ms = static_cast<grpc_millis>(ms);
+    } else {
+      pushback_allows_attempt = false;
+    }
+  }
+  const bool start_attempt =
+      !throttled && pushback_allows_attempt &&
+      num_attempts_completed_ + 1 < retry_policy->max_attempts;
+  SubchannelCall* failed_call =
+      batch_data == nullptr ? nullptr : batch_data->subchannel_call.get();
+  size_t num_other_attempts = hedged_attempts_.size();
+  if (subchannel_call_ != nullptr) ++num_other_attempts;
+  if (failed_call != nullptr) --num_other_attempts;
+  if (!start_attempt && num_other_attempts == 0) return false;
+  // Whatever else the failed attempt returns is ignored.
+  if (failed_call != nullptr) {
+    static_cast<SubchannelCallRetryState*>(failed_call->GetParentData())
+        ->retry_dispatched = true;
+    RemoveAttempt(failed_call);
+  }
+  if (!start_attempt) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: hedged attempt failed, waiting for %" PRIuPTR
+              " other attempts",
+              chand, this, num_other_attempts);
+    }
+    GRPC_CALL_COMBINER_STOP(call_combiner_, "hedged attempt failed");
+    return true;
+  }
+  ++num_attempts_completed_;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: hedged attempt failed, starting attempt %d",
+            chand, this, num_attempts_completed_ + 1);
+  }
+  if (subchannel_call_ != nullptr) {
+    hedged_attempts_.push_back(std::move(subchannel_call_));
+  }
+  DoRetry(elem, nullptr /* retry_state */, server_pushback_ms);
+  return true;
+}
+
+void CallData::RemoveAttempt(SubchannelCall* subchannel_call) {
+  if (subchannel_call_.get() == subchannel_call) {
+    subchannel_call_.reset();
+    if (!hedged_attempts_.empty()) {
+      const size_t last = hedged_attempts_.size() - 1;
+      subchannel_call_ = std::move(hedged_attempts_[last]);
+      hedged_attempts_.pop_back();
+    }
+    return;
+  }
+  for (size_t i = 0; i < hedged_attempts_.size(); ++i) {
+    if (hedged_attempts_[i].get() == subchannel_call) {
+      for (size_t j = i + 1; j < hedged_attempts_.size(); ++j) {
+        hedged_attempts_[j - 1] = std::move(hedged_attempts_[j]);
+      }
+      hedged_attempts_.pop_back();
+      return;
+    }
+  }
+}
+
+void CallData::CancelHedgedAttempts(grpc_call_element* elem,
+                                    SubchannelCallRetryState* keep,
+                                    grpc_error* error) {
+  if (hedged_attempts_.empty()) {
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  if (keep != nullptr && (subchannel_call_ == nullptr ||
+                          subchannel_call_->GetParentData() != keep)) {
+    for (size_t i = 0; i < hedged_attempts_.size(); ++i) {
+      if (hedged_attempts_[i]->GetParentData() == keep) {
+        std::swap(hedged_attempts_[i], subchannel_call_);
+        break;
+      }
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: cancelling %" PRIuPTR
+            " hedged attempts, keeping subchannel_call=%p",
+            elem->channel_data, this, hedged_attempts_.size(),
+            subchannel_call_.get());
+  }
+  // The cancelled attempts may still be reading the cached send ops.
+  free_cached_send_ops_on_destroy_ = true;
+  for (size_t i = 0; i < hedged_attempts_.size(); ++i) {
+    if (hedged_attempts_[i] == nullptr) continue;
+    static_cast<SubchannelCallRetryState*>(
+        hedged_attempts_[i]->GetParentData())
+        ->retry_dispatched = true;
+    CancelledAttempt* attempt =
+        arena_->New<CancelledAttempt>(elem, std::move(hedged_attempts_[i]));
+    GRPC_CALL_STACK_REF(owning_call_, "cancelled_attempt");
+    GRPC_CLOSURE_INIT(&attempt->cancel_in_call_combiner,
+                      CancelAttemptInCallCombiner, attempt, nullptr);
+    GRPC_CALL_COMBINER_START(call_combiner_, &attempt->cancel_in_call_combiner,
+                             GRPC_ERROR_REF(error), "cancel hedged attempt");
+  }
+  hedged_attempts_.clear();
+  GRPC_ERROR_UNREF(error);
+}
+
+void CallData::CancelAttemptInCallCombiner(void* arg, grpc_error* error) {
+  CancelledAttempt* attempt = static_cast<CancelledAttempt*>(arg);
+  grpc_transport_stream_op_batch* batch =
+      grpc_make_transport_stream_op(GRPC_CLOSURE_INIT(
+          &attempt->on_cancel_done, OnAttemptCancelled, attempt,
+          grpc_schedule_on_exec_ctx));
+  batch->cancel_stream = true;
+  batch->payload->cancel_stream.cancel_error = GRPC_ERROR_REF(error);
+  // Note: This will release the call combiner.
+  attempt->subchannel_call->StartTransportStreamOpBatch(batch);
+}
+
+void CallData::OnAttemptCancelled(void* arg, grpc_error* /*error*/) {
+  CancelledAttempt* attempt = static_cast<CancelledAttempt*>(arg);
+  CallData* calld = static_cast<CallData*>(attempt->elem->call_data);
+  attempt->subchannel_call.reset();
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "cancelled_attempt");
+}
+
 //
 // CallData::SubchannelCallBatchData
 //
 
 CallData::SubchannelCallBatchData* CallData::SubchannelCallBatchData::Create(
-    grpc_call_element* elem, int refcount, bool set_on_complete) {
+    grpc_call_element* elem, SubchannelCall* subchannel_call, int refcount,
+    bool set_on_complete) {
   CallData* calld = static_cast<CallData*>(elem->call_data);
-  return calld->arena_->New<SubchannelCallBatchData>(elem, calld, refcount,
-                                                     set_on_complete);
+  return calld->arena_->New<SubchannelCallBatchData>(
+      elem, calld, subchannel_call, refcount, set_on_complete);
 }
 
 CallData::SubchannelCallBatchData::SubchannelCallBatchData(
-    grpc_call_element* elem, CallData* calld, int refcount,
-    bool set_on_complete)
-    : elem(elem), subchannel_call(calld->subchannel_call_) {
+    grpc_call_element* elem, CallData* calld, SubchannelCall* subchannel_call,
+    int refcount, bool set_on_complete)
+    : elem(elem), subchannel_call(subchannel_call->Ref()) {
   SubchannelCallRetryState* retry_state =
       static_cast<SubchannelCallRetryState*>(
-          calld->subchannel_call_->GetParentData());
+          subchannel_call->GetParentData());
   batch.payload = &retry_state->batch_payload;
   gpr_ref_init(&refs, refcount);
   if (set_on_complete) {
@@ -2811,7 +3432,8 @@ void CallData::RecvInitialMetadataReady(void* arg, grpc_error* error) {
     if (!retry_state->started_recv_trailing_metadata) {
       // recv_trailing_metadata not yet started by application; start it
       // ourselves to get status.
-      calld->StartInternalRecvTrailingMetadata(elem);
+      calld->StartInternalRecvTrailingMetadata(
+          elem, batch_data->subchannel_call.get());
     } else {
       GRPC_CALL_COMBINER_STOP(
           calld->call_combiner_,
@@ -2899,7 +3521,8 @@ void CallData::RecvMessageReady(void* arg, grpc_error* error) {
     if (!retry_state->started_recv_trailing_metadata) {
       // recv_trailing_metadata not yet started by application; start it
       // ourselves to get status.
-      calld->StartInternalRecvTrailingMetadata(elem);
+      calld->StartInternalRecvTrailingMetadata(
+          elem, batch_data->subchannel_call.get());
     } else {
       GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "recv_message_ready null");
     }
@@ -3080,6 +3703,31 @@ void CallData::RecvTrailingMetadataReady(void* arg, grpc_error* error) {
       static_cast<SubchannelCallRetryState*>(
           batch_data->subchannel_call->GetParentData());
   retry_state->completed_recv_trailing_metadata = true;
+  // Invoke the LB policy's callback for this attempt, if any.
+  if (retry_state->lb_recv_trailing_metadata_ready != nullptr) {
+    calld->recv_trailing_metadata_ = &retry_state->recv_trailing_metadata;
+    Metadata trailing_metadata(calld, calld->recv_trailing_metadata_);
+    retry_state->lb_recv_trailing_metadata_ready(error, &trailing_metadata,
+                                                 &calld->lb_call_state_);
+    retry_state->lb_recv_trailing_metadata_ready = nullptr;
+  }
+  // If this attempt was cancelled in favour of another one, then we're not
+  // going to use its result, so do nothing.
+  if (retry_state->retry_dispatched) {
+    if (retry_state->recv_initial_metadata_ready_deferred_batch != nullptr) {
+      batch_data->Unref();
+      GRPC_ERROR_UNREF(retry_state->recv_initial_metadata_error);
+    }
+    if (retry_state->recv_message_ready_deferred_batch != nullptr) {
+      batch_data->Unref();
+      GRPC_ERROR_UNREF(retry_state->recv_message_error);
+    }
+    batch_data->Unref();
+    GRPC_CALL_COMBINER_STOP(
+        calld->call_combiner_,
+        "recv_trailing_metadata_ready after retry dispatched");
+    return;
+  }
   // Get the call's status and check for server pushback metadata.
   grpc_status_code status = GRPC_STATUS_OK;
   grpc_mdelem* server_pushback_md = nullptr;
@@ -3120,10 +3768,14 @@ void CallData::AddClosuresForCompletedPendingBatch(
     grpc_call_element* elem, SubchannelCallBatchData* batch_data,
     grpc_error* error, CallCombinerClosureList* closures) {
   PendingBatch* pending = PendingBatchFind(
-      elem, "completed", [batch_data](grpc_transport_stream_op_batch* batch) {
+      elem, "completed",
+      [this, batch_data](grpc_transport_stream_op_batch* batch) {
         // Match the pending batch with the same set of send ops as the
-        // subchannel batch we've just completed.
+        // subchannel batch we've just completed.  A batch not yet started
+        // on any attempt (so not cached) is left to be started, rather
+        // than completed by a hedged attempt's replay of earlier ops.
         return batch->on_complete != nullptr &&
+               pending_batches_[GetBatchIndex(batch)].send_ops_cached &&
                batch_data->batch.send_initial_metadata ==
                    batch->send_initial_metadata &&
                batch_data->batch.send_message == batch->send_message &&
@@ -3254,10 +3906,10 @@ void CallData::StartBatchInCallCombiner(void* arg, grpc_error* /*ignored*/) {
 }
 
 void CallData::AddClosureForSubchannelBatch(
-    grpc_call_element* elem, grpc_transport_stream_op_batch* batch,
-    CallCombinerClosureList* closures) {
+    grpc_call_element* elem, SubchannelCall* subchannel_call,
+    grpc_transport_stream_op_batch* batch, CallCombinerClosureList* closures) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
-  batch->handler_private.extra_arg = subchannel_call_.get();
+  batch->handler_private.extra_arg = subchannel_call;
   GRPC_CLOSURE_INIT(&batch->handler_private.closure, StartBatchInCallCombiner,
                     batch, grpc_schedule_on_exec_ctx);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
@@ -3399,11 +4051,15 @@ void CallData::AddRetriableRecvTrailingMetadataOp(
   batch_data->batch.payload->recv_trailing_metadata
       .recv_trailing_metadata_ready =
       &retry_state->recv_trailing_metadata_ready;
-  MaybeInjectRecvTrailingMetadataReadyForLoadBalancingPolicy(
-      &batch_data->batch);
+  // The LB policy's callback is invoked from RecvTrailingMetadataReady(),
+  // so that each attempt reports to the policy that picked it.
+  retry_state->lb_recv_trailing_metadata_ready =
+      std::move(lb_recv_trailing_metadata_ready_);
+  lb_recv_trailing_metadata_ready_ = nullptr;
 }
 
-void CallData::StartInternalRecvTrailingMetadata(grpc_call_element* elem) {
+void CallData::StartInternalRecvTrailingMetadata(
+    grpc_call_element* elem, SubchannelCall* subchannel_call) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
     gpr_log(GPR_INFO,
@@ -3412,26 +4068,28 @@ void CallData::StartInternalRecvTrailingMetadata(grpc_call_element* elem) {
             chand, this);
   }
   SubchannelCallRetryState* retry_state =
-      static_cast<SubchannelCallRetryState*>(subchannel_call_->GetParentData());
+      static_cast<SubchannelCallRetryState*>(subchannel_call->GetParentData());
   // Create batch_data with 2 refs, since this batch will be unreffed twice:
   // once for the recv_trailing_metadata_ready callback when the subchannel
   // batch returns, and again when we actually get a recv_trailing_metadata
   // op from the surface.
-  SubchannelCallBatchData* batch_data =
-      SubchannelCallBatchData::Create(elem, 2, false /* set_on_complete */);
+  SubchannelCallBatchData* batch_data = SubchannelCallBatchData::Create(
+      elem, subchannel_call, 2, false /* set_on_complete */);
   AddRetriableRecvTrailingMetadataOp(retry_state, batch_data);
   retry_state->recv_trailing_metadata_internal_batch = batch_data;
   // Note: This will release the call combiner.
-  subchannel_call_->StartTransportStreamOpBatch(&batch_data->batch);
+  subchannel_call->StartTransportStreamOpBatch(&batch_data->batch);
 }
 
-// If there are any cached send ops that need to be replayed on the
-// current subchannel call, creates and returns a new subchannel batch
-// to replay those ops.  Otherwise, returns nullptr.
+// If there are any cached send ops that need to be replayed on
+// subchannel_call, creates and returns a new subchannel batch to replay
+// those ops.  Otherwise, returns nullptr.
 CallData::SubchannelCallBatchData*
-CallData::MaybeCreateSubchannelBatchForReplay(
-    grpc_call_element* elem, SubchannelCallRetryState* retry_state) {
+CallData::MaybeCreateSubchannelBatchForReplay(grpc_call_element* elem,
+                                              SubchannelCall* subchannel_call) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  SubchannelCallRetryState* retry_state =
+      static_cast<SubchannelCallRetryState*>(subchannel_call->GetParentData());
   SubchannelCallBatchData* replay_batch_data = nullptr;
   // send_initial_metadata.
   if (seen_send_initial_metadata_ &&
@@ -3443,8 +4101,8 @@ CallData::MaybeCreateSubchannelBatchForReplay(
               "send_initial_metadata op",
               chand, this);
     }
-    replay_batch_data =
-        SubchannelCallBatchData::Create(elem, 1, true /* set_on_complete */);
+    replay_batch_data = SubchannelCallBatchData::Create(
+        elem, subchannel_call, 1, true /* set_on_complete */);
     AddRetriableSendInitialMetadataOp(retry_state, replay_batch_data);
   }
   // send_message.
@@ -3460,8 +4118,8 @@ CallData::MaybeCreateSubchannelBatchForReplay(
               chand, this);
     }
     if (replay_batch_data == nullptr) {
-      replay_batch_data =
-          SubchannelCallBatchData::Create(elem, 1, true /* set_on_complete */);
+      replay_batch_data = SubchannelCallBatchData::Create(
+          elem, subchannel_call, 1, true /* set_on_complete */);
     }
     AddRetriableSendMessageOp(elem, retry_state, replay_batch_data);
   }
@@ -3480,8 +4138,8 @@ CallData::MaybeCreateSubchannelBatchForReplay(
               chand, this);
     }
     if (replay_batch_data == nullptr) {
-      replay_batch_data =
-          SubchannelCallBatchData::Create(elem, 1, true /* set_on_complete */);
+      replay_batch_data = SubchannelCallBatchData::Create(
+          elem, subchannel_call, 1, true /* set_on_complete */);
     }
     AddRetriableSendTrailingMetadataOp(retry_state, replay_batch_data);
   }
@@ -3489,8 +4147,10 @@ CallData::MaybeCreateSubchannelBatchForReplay(
 }
 
 void CallData::AddSubchannelBatchesForPendingBatches(
-    grpc_call_element* elem, SubchannelCallRetryState* retry_state,
+    grpc_call_element* elem, SubchannelCall* subchannel_call,
     CallCombinerClosureList* closures) {
+  SubchannelCallRetryState* retry_state =
+      static_cast<SubchannelCallRetryState*>(subchannel_call->GetParentData());
   for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
     PendingBatch* pending = &pending_batches_[i];
     grpc_transport_stream_op_batch* batch = pending->batch;
@@ -3560,7 +4220,7 @@ void CallData::AddSubchannelBatchesForPendingBatches(
         method_params_->retry_policy() == nullptr || retry_committed_) {
       // TODO(roth) : We should probably call
       // MaybeInjectRecvTrailingMetadataReadyForLoadBalancingPolicy here.
-      AddClosureForSubchannelBatch(elem, batch, closures);
+      AddClosureForSubchannelBatch(elem, subchannel_call, batch, closures);
       PendingBatchClear(pending);
       continue;
     }
@@ -3571,10 +4231,12 @@ void CallData::AddSubchannelBatchesForPendingBatches(
     const int num_callbacks = has_send_ops + batch->recv_initial_metadata +
                               batch->recv_message +
                               batch->recv_trailing_metadata;
-    SubchannelCallBatchData* batch_data = SubchannelCallBatchData::Create(
-        elem, num_callbacks, has_send_ops /* set_on_complete */);
-    // Cache send ops if needed.
-    MaybeCacheSendOpsForBatch(pending);
+    SubchannelCallBatchData* batch_data =
+        SubchannelCallBatchData::Create(elem, subchannel_call, num_callbacks,
+                                        has_send_ops /* set_on_complete */);
+    // Cache send ops if needed.  A message that hedged attempts could not
+    // all read from the cache ends hedging.
+    if (!MaybeCacheSendOpsForBatch(pending)) RetryCommit(elem, retry_state);
     // send_initial_metadata.
     if (batch->send_initial_metadata) {
       AddRetriableSendInitialMetadataOp(retry_state, batch_data);
@@ -3601,7 +4263,8 @@ void CallData::AddSubchannelBatchesForPendingBatches(
     if (batch->recv_trailing_metadata) {
       AddRetriableRecvTrailingMetadataOp(retry_state, batch_data);
     }
-    AddClosureForSubchannelBatch(elem, &batch_data->batch, closures);
+    AddClosureForSubchannelBatch(elem, subchannel_call, &batch_data->batch,
+                                 closures);
     // Track number of pending subchannel send batches.
     // If this is the first one, take a ref to the call stack.
     if (batch->send_initial_metadata || batch->send_message ||
@@ -3614,6 +4277,26 @@ void CallData::AddSubchannelBatchesForPendingBatches(
   }
 }
 
+void CallData::AddRetriableSubchannelBatches(
+    grpc_call_element* elem, SubchannelCall* subchannel_call,
+    CallCombinerClosureList* closures) {
+  // Replay previously-returned send_* ops if needed.
+  SubchannelCallBatchData* replay_batch_data =
+      MaybeCreateSubchannelBatchForReplay(elem, subchannel_call);
+  if (replay_batch_data != nullptr) {
+    AddClosureForSubchannelBatch(elem, subchannel_call,
+                                 &replay_batch_data->batch, closures);
+    // Track number of pending subchannel send batches.
+    // If this is the first one, take a ref to the call stack.
+    if (num_pending_retriable_subchannel_send_batches_ == 0) {
+      GRPC_CALL_STACK_REF(owning_call_, "subchannel_send_batches");
+    }
+    ++num_pending_retriable_subchannel_send_batches_;
+  }
+  // Now add pending batches.
+  AddSubchannelBatchesForPendingBatches(elem, subchannel_call, closures);
+}
+
 void CallData::StartRetriableSubchannelBatches(void* arg,
                                                grpc_error* /*ignored*/) {
   grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
@@ -3623,32 +4306,30 @@ void CallData::StartRetriableSubchannelBatches(void* arg,
     gpr_log(GPR_INFO, "chand=%p calld=%p: constructing retriable batches",
             chand, calld);
   }
-  SubchannelCallRetryState* retry_state =
-      static_cast<SubchannelCallRetryState*>(
-          calld->subchannel_call_->GetParentData());
-  // Construct list of closures to execute, one for each pending batch.
+  // Starting a batch may commit the call, which changes the set of running
+  // attempts, so take a copy of it first.
+  InlinedVector<RefCountedPtr<SubchannelCall>, 3> attempts;
+  if (calld->subchannel_call_ != nullptr) {
+    attempts.push_back(calld->subchannel_call_);
+  }
+  for (size_t i = 0; i < calld->hedged_attempts_.size(); ++i) {
+    attempts.push_back(calld->hedged_attempts_[i]);
+  }
+  // Construct list of closures to execute, one for each pending batch on
+  // each attempt.
   CallCombinerClosureList closures;
-  // Replay previously-returned send_* ops if needed.
-  SubchannelCallBatchData* replay_batch_data =
-      calld->MaybeCreateSubchannelBatchForReplay(elem, retry_state);
-  if (replay_batch_data != nullptr) {
-    calld->AddClosureForSubchannelBatch(elem, &replay_batch_data->batch,
-                                        &closures);
-    // Track number of pending subchannel send batches.
-    // If this is the first one, take a ref to the call stack.
-    if (calld->num_pending_retriable_subchannel_send_batches_ == 0) {
-      GRPC_CALL_STACK_REF(calld->owning_call_, "subchannel_send_batches");
-    }
-    ++calld->num_pending_retriable_subchannel_send_batches_;
+  for (size_t i = 0; i < attempts.size(); ++i) {
+    SubchannelCallRetryState* retry_state =
+        static_cast<SubchannelCallRetryState*>(attempts[i]->GetParentData());
+    if (retry_state->retry_dispatched) continue;
+    calld->AddRetriableSubchannelBatches(elem, attempts[i].get(), &closures);
   }
-  // Now add pending batches.
-  calld->AddSubchannelBatchesForPendingBatches(elem, retry_state, &closures);
-  // Start batches on subchannel call.
+  // Start batches on subchannel calls.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
     gpr_log(GPR_INFO,
             "chand=%p calld=%p: starting %" PRIuPTR
-            " retriable batches on subchannel_call=%p",
-            chand, calld, closures.size(), calld->subchannel_call_.get());
+            " retriable batches on %" PRIuPTR " subchannel calls",
+            chand, calld, closures.size(), attempts.size());
   }
   // Note: This will yield the call combiner.
   closures.RunClosures(calld->call_combiner_);
@@ -3662,12 +4343,22 @@ void CallData::CreateSubchannelCall(grpc_call_element* elem) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
   const size_t parent_data_size =
       enable_retries_ ? sizeof(SubchannelCallRetryState) : 0;
+  // An attempt started while others are still running gets a call context
+  // of its own, so that the subchannel stacks of the attempts do not
+  // overwrite each other's entries.
+  grpc_call_context_element* context = call_context_;
+  if (!hedged_attempts_.empty()) {
+    context = static_cast<grpc_call_context_element*>(
+        arena_->Alloc(sizeof(grpc_call_context_element) * GRPC_CONTEXT_COUNT));
+    for (size_t i = 0; i < GRPC_CONTEXT_COUNT; ++i) {
+      context[i].value = call_context_[i].value;
+      context[i].destroy = nullptr;
+    }
+    hedged_attempt_contexts_.push_back(context);
+  }
   SubchannelCall::Args call_args = {
       std::move(connected_subchannel_), pollent_, path_, call_start_time_,
-      deadline_, arena_,
-      // TODO(roth): When we implement hedging support, we will probably
-      // need to use a separate call context for each subchannel call.
-      call_context_, call_combiner_, parent_data_size};
+      deadline_, arena_, context, call_combiner_, parent_data_size};
   grpc_error* error = GRPC_ERROR_NONE;
   subchannel_call_ = SubchannelCall::Create(std::move(call_args), &error);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
@@ -3678,8 +4369,8 @@ void CallData::CreateSubchannelCall(grpc_call_element* elem) {
     PendingBatchesFail(elem, error, YieldCallCombiner);
   } else {
     if (parent_data_size > 0) {
-      new (subchannel_call_->GetParentData())
-          SubchannelCallRetryState(call_context_);
+      new (subchannel_call_->GetParentData()) SubchannelCallRetryState(context);
+      MaybeStartHedgingTimer(elem);
     }
     PendingBatchesResume(elem);
   }
@@ -3703,6 +4394,9 @@ void CallData::PickDone(void* arg, grpc_error* error) {
     calld->PendingBatchesFail(elem, GRPC_ERROR_REF(error), YieldCallCombiner);
     return;
   }
+  GRPC_STATS_INC_PICK_LATENCY_US(gpr_timespec_to_micros(
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), calld->pick_start_)));
+  CallTimeline::Mark(calld->call_context_, CallTimeline::kPickComplete);
   calld->CreateSubchannelCall(elem);
 }
 
@@ -3771,7 +4465,8 @@ void CallData::AddCallToQueuedPicksLocked(grpc_call_element* elem) {
   pick_canceller_ = new QueuedPickCanceller(elem);
 }
 
-void CallData::ApplyServiceConfigToCallLocked(grpc_call_element* elem) {
+void CallData::ApplyServiceConfigToCall(
+    grpc_call_element* elem, const ChannelData::DataPlaneState* state) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: applying service config to call",
@@ -3781,7 +4476,7 @@ void CallData::ApplyServiceConfigToCallLocked(grpc_call_element* elem) {
   // a pointer to this in the call_context so that all future filters can access
   // it.
   service_config_call_data_ =
-      ServiceConfig::CallData(chand->service_config(), path_);
+      ServiceConfig::CallData(state->service_config, path_);
   if (service_config_call_data_.service_config() != nullptr) {
     call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value =
         &service_config_call_data_;
@@ -3789,7 +4484,7 @@ void CallData::ApplyServiceConfigToCallLocked(grpc_call_element* elem) {
         service_config_call_data_.GetMethodParsedConfig(
             internal::ClientChannelServiceConfigParser::ParserIndex()));
   }
-  retry_throttle_data_ = chand->retry_throttle_data();
+  retry_throttle_data_ = state->retry_throttle_data;
   if (method_params_ != nullptr) {
     // If the deadline from the service config is shorter than the one
     // from the client API, reset the deadline timer.
@@ -3824,14 +4519,14 @@ void CallData::ApplyServiceConfigToCallLocked(grpc_call_element* elem) {
   }
 }
 
-void CallData::MaybeApplyServiceConfigToCallLocked(grpc_call_element* elem) {
-  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+void CallData::MaybeApplyServiceConfigToCall(
+    grpc_call_element* elem, const ChannelData::DataPlaneState* state) {
   // Apply service config data to the call only once, and only if the
   // channel has the data available.
-  if (GPR_LIKELY(chand->received_service_config_data() &&
+  if (GPR_LIKELY(state->received_service_config_data &&
                  !service_config_applied_)) {
     service_config_applied_ = true;
-    ApplyServiceConfigToCallLocked(elem);
+    ApplyServiceConfigToCall(elem, state);
   }
 }
 
@@ -3852,10 +4547,25 @@ void CallData::PickSubchannel(void* arg, grpc_error* error) {
   grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
   CallData* calld = static_cast<CallData*>(elem->call_data);
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
-  bool pick_complete;
-  {
+  calld->pick_start_ = gpr_get_cycle_counter();
+  // Try the pick without holding the data plane mutex, which is only
+  // needed if the call has to be queued.
+  ReaderEpochs::Read read = chand->BeginDataPlaneRead();
+  const ChannelData::DataPlaneState* state = chand->data_plane_state();
+  const uint64_t generation = state->generation;
+  bool queue = true;
+  bool pick_complete = state->picker != nullptr &&
+                       calld->AttemptPick(elem, state, &error, &queue);
+  chand->EndDataPlaneRead(read);
+  if (queue) {
     MutexLock lock(chand->data_plane_mu());
-    pick_complete = calld->PickSubchannelLocked(elem, &error);
+    state = chand->data_plane_state();
+    if (state->generation == generation && state->picker != nullptr) {
+      // Nothing changed since the pick, so wait for a new picker.
+      calld->AddCallToQueuedPicksLocked(elem);
+    } else {
+      pick_complete = calld->PickSubchannelLocked(elem, &error);
+    }
   }
   if (pick_complete) {
     PickDone(elem, error);
@@ -3866,20 +4576,36 @@ void CallData::PickSubchannel(void* arg, grpc_error* error) {
 bool CallData::PickSubchannelLocked(grpc_call_element* elem,
                                     grpc_error** error) {
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
-  GPR_ASSERT(connected_subchannel_ == nullptr);
-  GPR_ASSERT(subchannel_call_ == nullptr);
+  const ChannelData::DataPlaneState* state = chand->data_plane_state();
   // The picker being null means that the channel is currently in IDLE state.
   // The incoming call will make the channel exit IDLE.
-  if (chand->picker() == nullptr) {
+  if (state->picker == nullptr) {
     // Bounce into the control plane combiner to exit IDLE.
     chand->CheckConnectivityState(/*try_to_connect=*/true);
     // Queue the pick, so that it will be attempted once the channel
     // becomes connected.
-    AddCallToQueuedPicksLocked(elem);
+    if (!pick_queued_) AddCallToQueuedPicksLocked(elem);
     return false;
   }
+  bool queue;
+  const bool pick_complete = AttemptPick(elem, state, error, &queue);
+  if (queue) {
+    if (!pick_queued_) AddCallToQueuedPicksLocked(elem);
+  } else if (pick_queued_) {
+    RemoveCallFromQueuedPicksLocked(elem);
+  }
+  return pick_complete;
+}
+
+bool CallData::AttemptPick(grpc_call_element* elem,
+                           const ChannelData::DataPlaneState* state,
+                           grpc_error** error, bool* queue) {
+  ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
+  GPR_ASSERT(connected_subchannel_ == nullptr);
+  GPR_ASSERT(subchannel_call_ == nullptr);
+  *queue = false;
   // Apply service config to call if needed.
-  MaybeApplyServiceConfigToCallLocked(elem);
+  MaybeApplyServiceConfigToCall(elem, state);
   // If this is a retry, use the send_initial_metadata payload that
   // we've cached; otherwise, use the pending batch.  The
   // send_initial_metadata batch will be the first pending batch in the
@@ -3907,7 +4633,7 @@ bool CallData::PickSubchannelLocked(grpc_call_element* elem,
                                         .batch->payload->send_initial_metadata
                                         .send_initial_metadata_flags;
   // Attempt pick.
-  auto result = chand->picker()->Pick(pick_args);
+  auto result = state->picker->Pick(pick_args);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
     gpr_log(GPR_INFO,
             "chand=%p calld=%p: LB pick returned %s (subchannel=%p, error=%s)",
@@ -3920,7 +4646,6 @@ bool CallData::PickSubchannelLocked(grpc_call_element* elem,
       grpc_error* disconnect_error = chand->disconnect_error();
       if (disconnect_error != GRPC_ERROR_NONE) {
         GRPC_ERROR_UNREF(result.error);
-        if (pick_queued_) RemoveCallFromQueuedPicksLocked(elem);
         *error = GRPC_ERROR_REF(disconnect_error);
         return true;
       }
@@ -3942,7 +4667,6 @@ bool CallData::PickSubchannelLocked(grpc_call_element* elem,
           GRPC_ERROR_UNREF(result.error);
           *error = new_error;
         }
-        if (pick_queued_) RemoveCallFromQueuedPicksLocked(elem);
         return !retried;
       }
       // If wait_for_ready is true, then queue to retry when we get a new
@@ -3951,17 +4675,16 @@ bool CallData::PickSubchannelLocked(grpc_call_element* elem,
     }
     // Fallthrough
     case LoadBalancingPolicy::PickResult::PICK_QUEUE:
-      if (!pick_queued_) AddCallToQueuedPicksLocked(elem);
+      *queue = true;
       return false;
     default:  // PICK_COMPLETE
-      if (pick_queued_) RemoveCallFromQueuedPicksLocked(elem);
       // Handle drops.
       if (GPR_UNLIKELY(result.subchannel == nullptr)) {
         result.error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             "Call dropped by load balancing policy");
       } else {
         // Grab a ref to the connected subchannel while we're still
-        // holding the data plane mutex.
+        // reading the data plane state.
         connected_subchannel_ =
             chand->GetConnectedSubchannelInDataPlane(result.subchannel.get());
         GPR_ASSERT(connected_subchannel_ != nullptr);
@@ -31,9 +31,11 @@ namespace grpc_core {
 namespace channelz {
 
 SubchannelNode::SubchannelNode(std::string target_address,
-                               size_t channel_tracer_max_nodes)
+                               size_t channel_tracer_max_nodes,
+                               uint32_t call_sampling_period)
     : BaseNode(EntityType::kSubchannel, target_address),
       target_(std::move(target_address)),
+      call_counter_(call_sampling_period),
       trace_(channel_tracer_max_nodes) {}
 
 SubchannelNode::~SubchannelNode() {}
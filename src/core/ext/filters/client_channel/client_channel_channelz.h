@@ -36,7 +36,9 @@ namespace channelz {
 
 class SubchannelNode : public BaseNode {
  public:
-  SubchannelNode(std::string target_address, size_t channel_tracer_max_nodes);
+  SubchannelNode(std::string target_address, size_t channel_tracer_max_nodes,
+                 uint32_t call_sampling_period =
+                     GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT);
   ~SubchannelNode() override;
 
   // Sets the subchannel's connectivity state without health checking.
@@ -59,7 +61,7 @@ class SubchannelNode : public BaseNode {
     trace_.AddTraceEventWithReference(severity, data,
                                       std::move(referenced_channel));
   }
-  void RecordCallStarted() { call_counter_.RecordCallStarted(); }
+  bool RecordCallStarted() { return call_counter_.RecordCallStarted(); }
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
 
@@ -20,23 +20,131 @@
 
 #include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
 #include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/gprpp/sync.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_client_connect_attempts_per_second, 0,
+    "If positive, the most subchannel connection attempts the process starts "
+    "per second, after a burst of as many. Attempts over the rate are "
+    "delayed, not dropped.");
 
 namespace grpc_core {
 
-GlobalSubchannelPool::GlobalSubchannelPool() {
-  subchannel_map_ = grpc_avl_create(&subchannel_avl_vtable_);
-  gpr_mu_init(&mu_);
+namespace {
+
+// The number of buckets each shard starts with.
+constexpr size_t kInitialShardCapacity = 8;
+
+// Past this many keys in a round of failures, expired rounds are
+// dropped, and new ones are not recorded if none has expired.
+constexpr size_t kMaxReconnectRounds = 4096;
+
+// Reconnect pacing state. It lives as long as the process: subchannels may
+// still connect while grpc shuts down.
+struct ReconnectPacing {
+  gpr_mu mu;
+  // For each key whose last attempts failed, the time before which no
+  // subchannel sharing it should retry.
+  std::map<std::string, grpc_millis> not_before;
+  // The rate limiter is a token bucket, kept as the time the next attempt
+  // would be due at if there was no burst (the generic cell rate algorithm).
+  double attempt_interval_ms = 0;
+  double burst_ms = 0;
+  double next_attempt_due = 0;
+};
+
+gpr_once g_pacing_once = GPR_ONCE_INIT;
+ReconnectPacing* g_pacing;
+
+void ResetReconnectPacingLocked() {
+  g_pacing->not_before.clear();
+  g_pacing->attempt_interval_ms = 0;
+  g_pacing->burst_ms = 0;
+  g_pacing->next_attempt_due = 0;
+  const int32_t rate =
+      GPR_GLOBAL_CONFIG_GET(grpc_client_connect_attempts_per_second);
+  if (rate > 0) {
+    g_pacing->attempt_interval_ms = 1000.0 / rate;
+    g_pacing->burst_ms = 1000.0 - g_pacing->attempt_interval_ms;
+  }
+}
+
+void InitReconnectPacing() {
+  g_pacing = new ReconnectPacing();
+  gpr_mu_init(&g_pacing->mu);
+  ResetReconnectPacingLocked();
+}
+
+}  // namespace
+
+struct GlobalSubchannelPool::Entry {
+  Entry(const SubchannelKey& key, Subchannel* subchannel)
+      : key(key), subchannel(subchannel) {}
+
+  SubchannelKey key;
+  // Weakly reffed until the entry is freed.
+  Subchannel* subchannel;
+  Atomic<Entry*> next;
+  // Next in the shard's list of retired entries.
+  Entry* next_retired = nullptr;
+};
+
+struct GlobalSubchannelPool::Buckets {
+  explicit Buckets(size_t capacity)
+      : capacity(capacity), entries(new Atomic<Entry*>[capacity]) {}
+  ~Buckets() { delete[] entries; }
+
+  size_t Index(uint32_t hash) const { return hash / kNumShards % capacity; }
+
+  const size_t capacity;
+  Atomic<Entry*>* const entries;
+  // Next in the shard's list of retired bucket arrays.
+  Buckets* next_retired = nullptr;
+};
+
+GlobalSubchannelPool::GlobalSubchannelPool() : shards_() {
+  for (Shard& shard : shards_) {
+    gpr_mu_init(&shard.mu);
+    shard.buckets.Store(new Buckets(kInitialShardCapacity),
+                        MemoryOrder::RELAXED);
+    shard.count = 0;
+  }
 }
 
 GlobalSubchannelPool::~GlobalSubchannelPool() {
-  gpr_mu_destroy(&mu_);
-  grpc_avl_unref(subchannel_map_, nullptr);
+  for (Shard& shard : shards_) {
+    Buckets* buckets = shard.buckets.Load(MemoryOrder::RELAXED);
+    for (size_t i = 0; i < buckets->capacity; ++i) {
+      Entry* entry = buckets->entries[i].Load(MemoryOrder::RELAXED);
+      while (entry != nullptr) {
+        Entry* next = entry->next.Load(MemoryOrder::RELAXED);
+        entry->next_retired = shard.retired.entries;
+        shard.retired.entries = entry;
+        entry = next;
+      }
+    }
+    buckets->next_retired = shard.retired.buckets;
+    shard.retired.buckets = buckets;
+    FreeRetired(&shard.retired);
+    FreeRetired(&shard.waiting);
+    gpr_mu_destroy(&shard.mu);
+  }
 }
 
 void GlobalSubchannelPool::Init() {
   instance_ = new RefCountedPtr<GlobalSubchannelPool>(
       MakeRefCounted<GlobalSubchannelPool>());
+  // Rounds of failures from before a shutdown say nothing about the
+  // backends after it, and the rate may have been reconfigured.
+  gpr_once_init(&g_pacing_once, InitReconnectPacing);
+  MutexLock lock(&g_pacing->mu);
+  ResetReconnectPacingLocked();
 }
 
 void GlobalSubchannelPool::Shutdown() {
@@ -56,124 +164,212 @@ RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
 
 Subchannel* GlobalSubchannelPool::RegisterSubchannel(SubchannelKey* key,
                                                      Subchannel* constructed) {
+  Shard* shard = ShardForKey(*key);
   Subchannel* c = nullptr;
-  // Compare and swap (CAS) loop:
   while (c == nullptr) {
-    // Ref the shared map to have a local copy.
-    gpr_mu_lock(&mu_);
-    grpc_avl old_map = grpc_avl_ref(subchannel_map_, nullptr);
-    gpr_mu_unlock(&mu_);
-    // Check to see if a subchannel already exists.
-    c = static_cast<Subchannel*>(grpc_avl_get(old_map, key, nullptr));
-    if (c != nullptr) {
+    gpr_mu_lock(&shard->mu);
+    Entry* entry = FindEntry(shard->buckets.Load(MemoryOrder::RELAXED), *key);
+    if (entry == nullptr) {
+      // There hasn't been such subchannel. Add one.
+      AddEntryLocked(shard, new Entry(*key, GRPC_SUBCHANNEL_WEAK_REF(
+                                                constructed,
+                                                "subchannel_register+new")));
+      c = constructed;
+      gpr_mu_unlock(&shard->mu);
+    } else {
       // The subchannel already exists. Try to reuse it.
-      c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(c, "subchannel_register+reuse");
+      c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(entry->subchannel,
+                                            "subchannel_register+reuse");
+      gpr_mu_unlock(&shard->mu);
       if (c != nullptr) {
         GRPC_SUBCHANNEL_UNREF(constructed,
                               "subchannel_register+found_existing");
-        // Exit the CAS loop without modifying the shared map.
-      }  // Else, reuse failed, so retry CAS loop.
-    } else {
-      // There hasn't been such subchannel. Add one.
-      // Note that we should ref the old map first because grpc_avl_add() will
-      // unref it while we still need to access it later.
-      grpc_avl new_map = grpc_avl_add(
-          grpc_avl_ref(old_map, nullptr), new SubchannelKey(*key),
-          GRPC_SUBCHANNEL_WEAK_REF(constructed, "subchannel_register+new"),
-          nullptr);
-      // Try to publish the change to the shared map. It may happen (but
-      // unlikely) that some other thread has changed the shared map, so compare
-      // to make sure it's unchanged before swapping. Retry if it's changed.
-      gpr_mu_lock(&mu_);
-      if (old_map.root == subchannel_map_.root) {
-        GPR_SWAP(grpc_avl, new_map, subchannel_map_);
-        c = constructed;
-      }
-      gpr_mu_unlock(&mu_);
-      grpc_avl_unref(new_map, nullptr);
+      }  // Else, it is being unregistered, so retry once it's gone.
     }
-    grpc_avl_unref(old_map, nullptr);
   }
   return c;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(SubchannelKey* key) {
-  bool done = false;
-  // Compare and swap (CAS) loop:
-  while (!done) {
-    // Ref the shared map to have a local copy.
-    gpr_mu_lock(&mu_);
-    grpc_avl old_map = grpc_avl_ref(subchannel_map_, nullptr);
-    gpr_mu_unlock(&mu_);
-    // Remove the subchannel.
-    // Note that we should ref the old map first because grpc_avl_remove() will
-    // unref it while we still need to access it later.
-    grpc_avl new_map =
-        grpc_avl_remove(grpc_avl_ref(old_map, nullptr), key, nullptr);
-    // Try to publish the change to the shared map. It may happen (but
-    // unlikely) that some other thread has changed the shared map, so compare
-    // to make sure it's unchanged before swapping. Retry if it's changed.
-    gpr_mu_lock(&mu_);
-    if (old_map.root == subchannel_map_.root) {
-      GPR_SWAP(grpc_avl, new_map, subchannel_map_);
-      done = true;
-    }
-    gpr_mu_unlock(&mu_);
-    grpc_avl_unref(new_map, nullptr);
-    grpc_avl_unref(old_map, nullptr);
+  Shard* shard = ShardForKey(*key);
+  gpr_mu_lock(&shard->mu);
+  Buckets* buckets = shard->buckets.Load(MemoryOrder::RELAXED);
+  Atomic<Entry*>* prev_next = &buckets->entries[buckets->Index(key->hash())];
+  Entry* entry;
+  while ((entry = prev_next->Load(MemoryOrder::RELAXED)) != nullptr) {
+    if (entry->key.hash() == key->hash() && entry->key.Cmp(*key) == 0) break;
+    prev_next = &entry->next;
+  }
+  if (entry != nullptr) {
+    prev_next->Store(entry->next.Load(MemoryOrder::RELAXED),
+                     MemoryOrder::RELEASE);
+    --shard->count;
+    // A lookup that does not hold the lock may still be looking at entry, so
+    // it cannot be freed yet.
+    entry->next_retired = shard->retired.entries;
+    shard->retired.entries = entry;
   }
+  Retired reclaimed = ReclaimRetiredLocked(shard);
+  gpr_mu_unlock(&shard->mu);
+  // Dropping the weak refs may destroy subchannels, so do it unlocked.
+  FreeRetired(&reclaimed);
 }
 
 Subchannel* GlobalSubchannelPool::FindSubchannel(SubchannelKey* key) {
-  // Lock, and take a reference to the subchannel map.
-  // We don't need to do the search under a lock as AVL's are immutable.
-  gpr_mu_lock(&mu_);
-  grpc_avl index = grpc_avl_ref(subchannel_map_, nullptr);
-  gpr_mu_unlock(&mu_);
-  Subchannel* c = static_cast<Subchannel*>(grpc_avl_get(index, key, nullptr));
-  if (c != nullptr) c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(c, "found_from_pool");
-  grpc_avl_unref(index, nullptr);
+  // Registered subchannels are found without taking the lock. A lookup that
+  // races with the shard growing may miss, and RegisterSubchannel() then
+  // finds the subchannel under the lock.
+  Shard* shard = ShardForKey(*key);
+  ReaderEpochs::Read read = shard->readers.BeginRead();
+  Entry* entry = FindEntry(shard->buckets.Load(MemoryOrder::ACQUIRE), *key);
+  Subchannel* c = nullptr;
+  if (entry != nullptr) {
+    c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(entry->subchannel,
+                                          "found_from_pool");
+  }
+  shard->readers.EndRead(read);
   return c;
 }
 
-RefCountedPtr<GlobalSubchannelPool>* GlobalSubchannelPool::instance_ = nullptr;
+grpc_millis GlobalSubchannelPool::SharedNextAttemptTime(const char* key,
+                                                        grpc_millis earliest) {
+  gpr_once_init(&g_pacing_once, InitReconnectPacing);
+  MutexLock lock(&g_pacing->mu);
+  auto it = g_pacing->not_before.find(key);
+  if (it == g_pacing->not_before.end()) return earliest;
+  return std::max(earliest, it->second);
+}
 
-namespace {
+grpc_millis GlobalSubchannelPool::ReserveConnectAttempt() {
+  gpr_once_init(&g_pacing_once, InitReconnectPacing);
+  const grpc_millis now = ExecCtx::Get()->Now();
+  MutexLock lock(&g_pacing->mu);
+  if (g_pacing->attempt_interval_ms == 0) return now;
+  // Slots are only taken for now, so they are handed out in order.
+  const double earliest = g_pacing->next_attempt_due - g_pacing->burst_ms;
+  const double start = std::max(static_cast<double>(now), earliest);
+  g_pacing->next_attempt_due =
+      std::max(g_pacing->next_attempt_due, start) +
+      g_pacing->attempt_interval_ms;
+  return static_cast<grpc_millis>(std::ceil(start));
+}
 
-void sck_avl_destroy(void* p, void* /*user_data*/) {
-  SubchannelKey* key = static_cast<SubchannelKey*>(p);
-  delete key;
+void GlobalSubchannelPool::RecordConnectFailure(const char* key,
+                                                grpc_millis next_attempt) {
+  gpr_once_init(&g_pacing_once, InitReconnectPacing);
+  const grpc_millis now = ExecCtx::Get()->Now();
+  MutexLock lock(&g_pacing->mu);
+  auto it = g_pacing->not_before.find(key);
+  if (it != g_pacing->not_before.end()) {
+    // Later failures of the round keep the retry time it started with.
+    if (it->second <= now) it->second = next_attempt;
+    return;
+  }
+  if (g_pacing->not_before.size() >= kMaxReconnectRounds) {
+    for (it = g_pacing->not_before.begin();
+         it != g_pacing->not_before.end();) {
+      if (it->second <= now) {
+        it = g_pacing->not_before.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (g_pacing->not_before.size() >= kMaxReconnectRounds) return;
+  }
+  g_pacing->not_before.emplace(key, next_attempt);
 }
 
-void* sck_avl_copy(void* p, void* /*unused*/) {
-  const SubchannelKey* key = static_cast<const SubchannelKey*>(p);
-  auto* new_key = new SubchannelKey(*key);
-  return static_cast<void*>(new_key);
+void GlobalSubchannelPool::RecordConnectSuccess(const char* key) {
+  gpr_once_init(&g_pacing_once, InitReconnectPacing);
+  MutexLock lock(&g_pacing->mu);
+  g_pacing->not_before.erase(key);
 }
 
-long sck_avl_compare(void* a, void* b, void* /*unused*/) {
-  const SubchannelKey* key_a = static_cast<const SubchannelKey*>(a);
-  const SubchannelKey* key_b = static_cast<const SubchannelKey*>(b);
-  return key_a->Cmp(*key_b);
+GlobalSubchannelPool::Entry* GlobalSubchannelPool::FindEntry(
+    Buckets* buckets, const SubchannelKey& key) {
+  for (Entry* entry = buckets->entries[buckets->Index(key.hash())].Load(
+           MemoryOrder::ACQUIRE);
+       entry != nullptr; entry = entry->next.Load(MemoryOrder::ACQUIRE)) {
+    if (entry->key.hash() == key.hash() && entry->key.Cmp(key) == 0) {
+      return entry;
+    }
+  }
+  return nullptr;
 }
 
-void scv_avl_destroy(void* p, void* /*user_data*/) {
-  GRPC_SUBCHANNEL_WEAK_UNREF((Subchannel*)p, "global_subchannel_pool");
+void GlobalSubchannelPool::AddEntryLocked(Shard* shard, Entry* entry) {
+  if (shard->count >= shard->buckets.Load(MemoryOrder::RELAXED)->capacity * 2) {
+    GrowLocked(shard);
+  }
+  Buckets* buckets = shard->buckets.Load(MemoryOrder::RELAXED);
+  Atomic<Entry*>* head = &buckets->entries[buckets->Index(entry->key.hash())];
+  entry->next.Store(head->Load(MemoryOrder::RELAXED), MemoryOrder::RELAXED);
+  // Publishes the fully constructed entry to lookups without the lock.
+  head->Store(entry, MemoryOrder::RELEASE);
+  ++shard->count;
 }
 
-void* scv_avl_copy(void* p, void* /*unused*/) {
-  GRPC_SUBCHANNEL_WEAK_REF((Subchannel*)p, "global_subchannel_pool");
-  return p;
+void GlobalSubchannelPool::GrowLocked(Shard* shard) {
+  Buckets* old_buckets = shard->buckets.Load(MemoryOrder::RELAXED);
+  Buckets* buckets = new Buckets(old_buckets->capacity * 2);
+  // Lookups still walking the old buckets may be led astray into the new
+  // chains and miss.
+  for (size_t i = 0; i < old_buckets->capacity; ++i) {
+    Entry* next;
+    for (Entry* entry = old_buckets->entries[i].Load(MemoryOrder::RELAXED);
+         entry != nullptr; entry = next) {
+      next = entry->next.Load(MemoryOrder::RELAXED);
+      Atomic<Entry*>* head =
+          &buckets->entries[buckets->Index(entry->key.hash())];
+      entry->next.Store(head->Load(MemoryOrder::RELAXED),
+                        MemoryOrder::RELEASE);
+      head->Store(entry, MemoryOrder::RELAXED);
+    }
+  }
+  shard->buckets.Store(buckets, MemoryOrder::RELEASE);
+  old_buckets->next_retired = shard->retired.buckets;
+  shard->retired.buckets = old_buckets;
 }
 
-}  // namespace
+// Returns what was unlinked before the last epoch flip once the lookups that
+// could still see it are done, and flips the epoch for what was unlinked
+// since.
+GlobalSubchannelPool::Retired GlobalSubchannelPool::ReclaimRetiredLocked(
+    Shard* shard) {
+  Retired reclaimed;
+  if (!shard->waiting.empty()) {
+    if (!shard->readers.PreviousEpochDone()) return reclaimed;
+    reclaimed = shard->waiting;
+    shard->waiting = Retired();
+  }
+  if (!shard->retired.empty()) {
+    // Nothing is waiting, so the previous epoch was found done before
+    // whatever waited last was reclaimed, and has only drained since.
+    GPR_DEBUG_ASSERT(shard->readers.PreviousEpochDone());
+    shard->waiting = shard->retired;
+    shard->retired = Retired();
+    shard->readers.Flip();
+  }
+  return reclaimed;
+}
 
-const grpc_avl_vtable GlobalSubchannelPool::subchannel_avl_vtable_ = {
-    sck_avl_destroy,  // destroy_key
-    sck_avl_copy,     // copy_key
-    sck_avl_compare,  // compare_keys
-    scv_avl_destroy,  // destroy_value
-    scv_avl_copy      // copy_value
-};
+void GlobalSubchannelPool::FreeRetired(Retired* retired) {
+  Entry* entry = retired->entries;
+  while (entry != nullptr) {
+    Entry* next = entry->next_retired;
+    GRPC_SUBCHANNEL_WEAK_UNREF(entry->subchannel, "global_subchannel_pool");
+    delete entry;
+    entry = next;
+  }
+  Buckets* buckets = retired->buckets;
+  while (buckets != nullptr) {
+    Buckets* next = buckets->next_retired;
+    delete buckets;
+    buckets = next;
+  }
+  *retired = Retired();
+}
+
+RefCountedPtr<GlobalSubchannelPool>* GlobalSubchannelPool::instance_ = nullptr;
 
 }  // namespace grpc_core
@@ -21,7 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <grpc/support/sync.h>
+
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/reader_epochs.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_client_connect_attempts_per_second);
 
 namespace grpc_core {
 
@@ -50,17 +58,73 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
   void UnregisterSubchannel(SubchannelKey* key) override;
   Subchannel* FindSubchannel(SubchannelKey* key) override;
 
+  // Reconnect pacing, shared by subchannels in the process whichever pool
+  // they are in, so that a restarted backend is not hit by every channel at
+  // once. Subchannels opt in with GRPC_ARG_SHARED_RECONNECT_BACKOFF and share
+  // a backoff under a key derived from their address and channel args.
+  // Unlike the pool itself, it outlives Shutdown(), and Init() resets it.
+  //
+  // Returns when a subchannel that wants to retry at \a earliest should: no
+  // earlier than the retry time the round of failures under \a key has set.
+  static grpc_millis SharedNextAttemptTime(const char* key,
+                                           grpc_millis earliest);
+  // Takes the next slot for a connection attempt and returns its time. With
+  // GRPC_CLIENT_CONNECT_ATTEMPTS_PER_SECOND set, that is late enough for
+  // attempts across the process to stay under that rate, otherwise now.
+  static grpc_millis ReserveConnectAttempt();
+  // Records a failed attempt under \a key, after which the subchannel's own
+  // backoff would retry at \a next_attempt. The first failure of a round
+  // sets the retry time of the subchannels that fail after it.
+  static void RecordConnectFailure(const char* key, grpc_millis next_attempt);
+  // Ends the round of failures under \a key.
+  static void RecordConnectSuccess(const char* key);
+
  private:
+  // The subchannel map is split into shards by key hash, so that
+  // registrations of different subchannels rarely contend for a lock.
+  static constexpr size_t kNumShards = 16;
+
+  struct Entry;
+  struct Buckets;
+
+  // Memory that lookups without the shard lock may still be reading.
+  struct Retired {
+    Entry* entries = nullptr;
+    Buckets* buckets = nullptr;
+
+    bool empty() const { return entries == nullptr && buckets == nullptr; }
+  };
+
+  // A hash map from subchannel key to subchannel. Entries are only added and
+  // removed under mu, but registered subchannels are looked up without it.
+  struct Shard {
+    gpr_mu mu;
+    // The bucket array in use. Only replaced under mu, but read without it.
+    Atomic<Buckets*> buckets;
+    size_t count;
+    // Lookups that take no lock.
+    ReaderEpochs readers;
+    // Entries and bucket arrays unlinked since the last epoch flip.
+    Retired retired;
+    // Entries and bucket arrays unlinked before the last epoch flip.
+    Retired waiting;
+  };
+
+  static Entry* FindEntry(Buckets* buckets, const SubchannelKey& key);
+  static void AddEntryLocked(Shard* shard, Entry* entry);
+  static void GrowLocked(Shard* shard);
+  static Retired ReclaimRetiredLocked(Shard* shard);
+  static void FreeRetired(Retired* retired);
+
+  Shard* ShardForKey(const SubchannelKey& key) {
+    return &shards_[key.hash() % kNumShards];
+  }
+
   // The singleton instance. (It's a pointer to RefCountedPtr so that this
   // non-local static object can be trivially destructible.)
   static RefCountedPtr<GlobalSubchannelPool>* instance_;
 
-  // The vtable for subchannel operations in an AVL tree.
-  static const grpc_avl_vtable subchannel_avl_vtable_;
-  // A map from subchannel key to subchannel.
-  grpc_avl subchannel_map_;
-  // To protect subchannel_map_.
-  gpr_mu mu_;
+  Shard shards_[kNumShards];
 };
 
 }  // namespace grpc_core
@@ -23,6 +23,7 @@
 
 #include "src/core/ext/filters/client_channel/health/health_check_client.h"
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -244,7 +245,9 @@ HealthCheckClient::CallState::CallState(
       pollent_(grpc_polling_entity_create_from_pollset_set(interested_parties)),
       arena_(Arena::Create(health_check_client_->connected_subchannel_
                                ->GetInitialCallSizeEstimate(0))),
-      payload_(context_) {}
+      payload_(context_) {
+  GRPC_STATS_INC_HEALTH_CHECK_STREAMS_STARTED();
+}
 
 HealthCheckClient::CallState::~CallState() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_health_check_client_trace)) {
@@ -265,6 +268,7 @@ HealthCheckClient::CallState::~CallState() {
   call_combiner_.SetNotifyOnCancel(nullptr);
   ExecCtx::Get()->Flush();
   arena_->Destroy();
+  GRPC_STATS_INC_HEALTH_CHECK_STREAMS_ENDED();
 }
 
 void HealthCheckClient::CallState::Orphan() {
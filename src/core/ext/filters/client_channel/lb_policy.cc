@@ -99,11 +99,10 @@ LoadBalancingPolicy::PickResult LoadBalancingPolicy::QueuePicker::Pick(
   //    the time this function returns, the pick will already have
   //    been processed, and we'll be trying to re-process the same
   //    pick again, leading to a crash.
-  // 2. We are currently running in the data plane combiner, but we
-  //    need to bounce into the control plane combiner to call
-  //    ExitIdleLocked().
-  if (!exit_idle_called_) {
-    exit_idle_called_ = true;
+  // 2. We are currently running in the data plane, but we need to
+  //    bounce into the control plane combiner to call ExitIdleLocked().
+  if (!exit_idle_called_.Load(MemoryOrder::RELAXED) &&
+      !exit_idle_called_.Exchange(true, MemoryOrder::RELAXED)) {
     parent_->Ref().release();  // ref held by closure.
     parent_->combiner()->Run(
         GRPC_CLOSURE_CREATE(&CallExitIdle, parent_.get(), nullptr),
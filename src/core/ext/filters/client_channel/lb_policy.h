@@ -27,6 +27,7 @@
 #include "src/core/ext/filters/client_channel/server_address.h"
 #include "src/core/ext/filters/client_channel/service_config.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -241,9 +242,8 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   /// updates, connectivity state notifications, etc); the latter should
   /// live in the LB policy object itself.
   ///
-  /// Currently, pickers are always accessed from within the
-  /// client_channel data plane combiner, so they do not have to be
-  /// thread-safe.
+  /// The client channel calls Pick() from many threads at once, without
+  /// holding any lock, so pickers must be thread-safe.
   class SubchannelPicker {
    public:
     SubchannelPicker() = default;
@@ -371,7 +371,7 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
     static void CallExitIdle(void* arg, grpc_error* error);
 
     RefCountedPtr<LoadBalancingPolicy> parent_;
-    bool exit_idle_called_ = false;
+    Atomic<bool> exit_idle_called_{false};
   };
 
   // A picker that returns PICK_TRANSIENT_FAILURE for all picks.
@@ -85,6 +85,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/orphanable.h"
@@ -250,8 +251,8 @@ class GrpcLb : public LoadBalancingPolicy {
     // Returns the LB token to use for a drop, or null if the call
     // should not be dropped.
     //
-    // Note: This is called from the picker, so it will be invoked in
-    // the channel's data plane combiner, NOT the control plane
+    // Note: This is called from the picker, so it will be invoked
+    // concurrently in the channel's data plane, NOT the control plane
     // combiner.  It should not be accessed by any other part of the LB
     // policy.
     const char* ShouldDrop();
@@ -259,10 +260,9 @@ class GrpcLb : public LoadBalancingPolicy {
    private:
     grpc_grpclb_serverlist* serverlist_;
 
-    // Guarded by the channel's data plane combiner, NOT the control
-    // plane combiner.  It should not be accessed by anything but the
-    // picker via the ShouldDrop() method.
-    size_t drop_index_ = 0;
+    // Advanced atomically by concurrent picks.  It should not be accessed
+    // by anything but the picker via the ShouldDrop() method.
+    Atomic<size_t> drop_index_{0};
   };
 
   class Picker : public SubchannelPicker {
@@ -570,8 +570,9 @@ bool GrpcLb::Serverlist::ContainsAllDropEntries() const {
 
 const char* GrpcLb::Serverlist::ShouldDrop() {
   if (serverlist_->num_servers == 0) return nullptr;
-  grpc_grpclb_server* server = serverlist_->servers[drop_index_];
-  drop_index_ = (drop_index_ + 1) % serverlist_->num_servers;
+  grpc_grpclb_server* server =
+      serverlist_->servers[drop_index_.FetchAdd(1, MemoryOrder::RELAXED) %
+                           serverlist_->num_servers];
   return server->drop ? server->load_balance_token : nullptr;
 }
 
@@ -1161,6 +1162,9 @@ void GrpcLb::BalancerCallState::OnBalancerMessageReceivedLocked(
       // instance will be destroyed either upon the next update or when the
       // GrpcLb instance is destroyed.
       grpclb_policy->serverlist_ = std::move(serverlist_wrapper);
+      // The child policy keeps the subchannels of the backends that are
+      // still in the serverlist, and does no work at all if only the drop
+      // entries changed.
       grpclb_policy->CreateOrUpdateChildPolicyLocked();
     }
   } else {
@@ -23,52 +23,84 @@
 #include <string.h>
 
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 
-#include "src/core/lib/gprpp/sync.h"
-
 namespace grpc_core {
 
+constexpr size_t GrpcLbClientStats::kStripes;
+
+GrpcLbClientStats::~GrpcLbClientStats() {
+  DropEntry* entry = drop_entries_.Load(MemoryOrder::RELAXED);
+  while (entry != nullptr) {
+    DropEntry* next = entry->next;
+    delete entry;
+    entry = next;
+  }
+}
+
+GrpcLbClientStats::Stripe* GrpcLbClientStats::CurrentStripe() {
+  return &stripes_[gpr_cpu_current_cpu() % kStripes];
+}
+
+GrpcLbClientStats::DropEntry* GrpcLbClientStats::FindOrAddDropEntry(
+    const char* token) {
+  DropEntry* head = drop_entries_.Load(MemoryOrder::ACQUIRE);
+  for (DropEntry* entry = head; entry != nullptr; entry = entry->next) {
+    if (strcmp(entry->token.get(), token) == 0) return entry;
+  }
+  // Not found, so add a new entry.
+  DropEntry* new_entry = new DropEntry();
+  new_entry->token.reset(gpr_strdup(token));
+  new_entry->next = head;
+  while (!drop_entries_.CompareExchangeWeak(&new_entry->next, new_entry,
+                                            MemoryOrder::ACQ_REL,
+                                            MemoryOrder::ACQUIRE)) {
+    // Only the entries added since we last looked can have the same token.
+    for (DropEntry* entry = new_entry->next; entry != head;
+         entry = entry->next) {
+      if (strcmp(entry->token.get(), token) == 0) {
+        delete new_entry;
+        return entry;
+      }
+    }
+    head = new_entry->next;
+  }
+  return new_entry;
+}
+
 void GrpcLbClientStats::AddCallStarted() {
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
+  gpr_atm_no_barrier_fetch_add(&CurrentStripe()->num_calls_started,
+                               (gpr_atm)1);
 }
 
 void GrpcLbClientStats::AddCallFinished(
     bool finished_with_client_failed_to_send, bool finished_known_received) {
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  Stripe* stripe = CurrentStripe();
+  gpr_atm_no_barrier_fetch_add(&stripe->num_calls_finished, (gpr_atm)1);
   if (finished_with_client_failed_to_send) {
-    gpr_atm_full_fetch_add(&num_calls_finished_with_client_failed_to_send_,
-                           (gpr_atm)1);
+    gpr_atm_no_barrier_fetch_add(
+        &stripe->num_calls_finished_with_client_failed_to_send, (gpr_atm)1);
   }
   if (finished_known_received) {
-    gpr_atm_full_fetch_add(&num_calls_finished_known_received_, (gpr_atm)1);
+    gpr_atm_no_barrier_fetch_add(&stripe->num_calls_finished_known_received,
+                                 (gpr_atm)1);
   }
 }
 
 void GrpcLbClientStats::AddCallDropped(const char* token) {
   // Increment num_calls_started and num_calls_finished.
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  Stripe* stripe = CurrentStripe();
+  gpr_atm_no_barrier_fetch_add(&stripe->num_calls_started, (gpr_atm)1);
+  gpr_atm_no_barrier_fetch_add(&stripe->num_calls_finished, (gpr_atm)1);
   // Record the drop.
-  MutexLock lock(&drop_count_mu_);
-  if (drop_token_counts_ == nullptr) {
-    drop_token_counts_.reset(new DroppedCallCounts());
-  }
-  for (size_t i = 0; i < drop_token_counts_->size(); ++i) {
-    if (strcmp((*drop_token_counts_)[i].token.get(), token) == 0) {
-      ++(*drop_token_counts_)[i].count;
-      return;
-    }
-  }
-  // Not found, so add a new entry.
-  drop_token_counts_->emplace_back(
-      grpc_core::UniquePtr<char>(gpr_strdup(token)), 1);
+  gpr_atm_no_barrier_fetch_add(&FindOrAddDropEntry(token)->count, (gpr_atm)1);
 }
 
 namespace {
 
 void AtomicGetAndResetCounter(int64_t* value, gpr_atm* counter) {
-  *value = static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
+  *value += static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
 }
 
 }  // namespace
@@ -78,14 +110,33 @@ void GrpcLbClientStats::Get(
     int64_t* num_calls_finished_with_client_failed_to_send,
     int64_t* num_calls_finished_known_received,
     std::unique_ptr<DroppedCallCounts>* drop_token_counts) {
-  AtomicGetAndResetCounter(num_calls_started, &num_calls_started_);
-  AtomicGetAndResetCounter(num_calls_finished, &num_calls_finished_);
-  AtomicGetAndResetCounter(num_calls_finished_with_client_failed_to_send,
-                           &num_calls_finished_with_client_failed_to_send_);
-  AtomicGetAndResetCounter(num_calls_finished_known_received,
-                           &num_calls_finished_known_received_);
-  MutexLock lock(&drop_count_mu_);
-  *drop_token_counts = std::move(drop_token_counts_);
+  *num_calls_started = 0;
+  *num_calls_finished = 0;
+  *num_calls_finished_with_client_failed_to_send = 0;
+  *num_calls_finished_known_received = 0;
+  for (size_t i = 0; i < kStripes; ++i) {
+    Stripe* stripe = &stripes_[i];
+    AtomicGetAndResetCounter(num_calls_started, &stripe->num_calls_started);
+    AtomicGetAndResetCounter(num_calls_finished, &stripe->num_calls_finished);
+    AtomicGetAndResetCounter(
+        num_calls_finished_with_client_failed_to_send,
+        &stripe->num_calls_finished_with_client_failed_to_send);
+    AtomicGetAndResetCounter(num_calls_finished_known_received,
+                             &stripe->num_calls_finished_known_received);
+  }
+  drop_token_counts->reset();
+  for (DropEntry* entry = drop_entries_.Load(MemoryOrder::ACQUIRE);
+       entry != nullptr; entry = entry->next) {
+    const int64_t count =
+        static_cast<int64_t>(gpr_atm_full_xchg(&entry->count, (gpr_atm)0));
+    if (count == 0) continue;
+    if (*drop_token_counts == nullptr) {
+      drop_token_counts->reset(new DroppedCallCounts());
+    }
+    (*drop_token_counts)
+        ->emplace_back(
+            grpc_core::UniquePtr<char>(gpr_strdup(entry->token.get())), count);
+  }
 }
 
 }  // namespace grpc_core
@@ -23,10 +23,10 @@
 
 #include <grpc/support/atm.h>
 
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
-#include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_core {
 
@@ -42,6 +42,9 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
 
   typedef InlinedVector<DropTokenCount, 10> DroppedCallCounts;
 
+  GrpcLbClientStats() = default;
+  ~GrpcLbClientStats();
+
   void AddCallStarted();
   void AddCallFinished(bool finished_with_client_failed_to_send,
                        bool finished_known_received);
@@ -60,12 +63,31 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
   }
 
  private:
-  gpr_atm num_calls_started_ = 0;
-  gpr_atm num_calls_finished_ = 0;
-  gpr_atm num_calls_finished_with_client_failed_to_send_ = 0;
-  gpr_atm num_calls_finished_known_received_ = 0;
-  Mutex drop_count_mu_;  // Guards drop_token_counts_.
-  std::unique_ptr<DroppedCallCounts> drop_token_counts_;
+  // Calls are counted in a stripe picked by CPU, so that calls on different
+  // cores rarely share a cache line.  Get() sums up the stripes.
+  static constexpr size_t kStripes = 8;
+
+  struct Stripe {
+    gpr_atm num_calls_started;
+    gpr_atm num_calls_finished;
+    gpr_atm num_calls_finished_with_client_failed_to_send;
+    gpr_atm num_calls_finished_known_received;
+    char padding[GPR_CACHELINE_SIZE - 4 * sizeof(gpr_atm)];
+  };
+
+  // A drop count per token.  Entries are added lock-free and live as long
+  // as the stats; the tokens come from the serverlist, so there are few.
+  struct DropEntry {
+    grpc_core::UniquePtr<char> token;
+    gpr_atm count = 0;
+    DropEntry* next = nullptr;
+  };
+
+  Stripe* CurrentStripe();
+  DropEntry* FindOrAddDropEntry(const char* token);
+
+  Stripe stripes_[kStripes] = {};
+  Atomic<DropEntry*> drop_entries_{nullptr};
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,909 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Outlier Detection Policy.
+ *
+ * Wraps a child policy, such as round_robin, and takes the backends whose
+ * calls fail or are slow compared to the others out of its rotation for a
+ * while.  It can also be the child policy of xds_experimental.
+ *
+ * The picker records the outcome and latency of each call on the address it
+ * was sent to, in counters that need no lock.  Every interval, the policy
+ * collects the counters and ejects the addresses whose success rate is too
+ * far below the mean, or whose latency percentile is too far above the
+ * median.  An ejected address is reported to the child policy as being in
+ * TRANSIENT_FAILURE, for a time that grows each time it is ejected again.
+ * At most maxEjectionPercent of the addresses are ejected at any time. */
+
+#include <grpc/support/port_platform.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_outlier_detection_trace(false, "outlier_detection_lb");
+
+namespace {
+
+//
+// outlier_detection LB policy
+//
+
+constexpr char kOutlierDetection[] = "outlier_detection_experimental";
+
+class ParsedOutlierDetectionConfig : public LoadBalancingPolicy::Config {
+ public:
+  struct Params {
+    // How often outliers are looked for.
+    grpc_millis interval = 10 * GPR_MS_PER_SEC;
+    // An address is ejected for baseEjectionTime times the number of times
+    // it was ejected recently, up to maxEjectionTime.
+    grpc_millis base_ejection_time = 30 * GPR_MS_PER_SEC;
+    grpc_millis max_ejection_time = 300 * GPR_MS_PER_SEC;
+    int max_ejection_percent = 10;
+    // Addresses whose success rate is more than this many standard
+    // deviations below the mean are ejected.  0 disables the check.
+    double success_rate_stdev_factor = 1.9;
+    // Addresses whose latency percentile is more than this many times the
+    // median of all addresses are ejected.  0 disables the check.
+    double latency_percentile = 90;
+    double latency_threshold_factor = 3;
+    // A check only considers the addresses that got at least
+    // request_volume calls in the interval, and only if there are at
+    // least minimum_hosts of them.
+    int minimum_hosts = 5;
+    int request_volume = 100;
+  };
+
+  ParsedOutlierDetectionConfig(
+      RefCountedPtr<LoadBalancingPolicy::Config> child_policy,
+      const Params& params)
+      : child_policy_(std::move(child_policy)), params_(params) {}
+
+  const char* name() const override { return kOutlierDetection; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy() const {
+    return child_policy_;
+  }
+  const Params& params() const { return params_; }
+
+ private:
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy_;
+  Params params_;
+};
+
+class OutlierDetectionLb : public LoadBalancingPolicy {
+ public:
+  explicit OutlierDetectionLb(Args args);
+
+  const char* name() const override { return kOutlierDetection; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ExitIdleLocked() override;
+  void ResetBackoffLocked() override;
+
+ private:
+  class SubchannelWrapper;
+
+  // The calls sent to one address, and whether it is ejected.
+  class EndpointState : public RefCounted<EndpointState> {
+   public:
+    // Watches the subchannel for the address on behalf of the child
+    // policy, and reports TRANSIENT_FAILURE instead of the subchannel's
+    // state while the address is ejected.
+    class WatcherWrapper
+        : public SubchannelInterface::ConnectivityStateWatcherInterface {
+     public:
+      WatcherWrapper(
+          std::unique_ptr<
+              SubchannelInterface::ConnectivityStateWatcherInterface>
+              delegate,
+          RefCountedPtr<EndpointState> endpoint,
+          grpc_connectivity_state initial_state)
+          : delegate_(std::move(delegate)),
+            endpoint_(std::move(endpoint)),
+            last_state_(initial_state) {}
+
+      void OnConnectivityStateChange(
+          grpc_connectivity_state new_state) override {
+        last_state_ = new_state;
+        if (!endpoint_->ejected()) {
+          delegate_->OnConnectivityStateChange(new_state);
+        }
+      }
+
+      grpc_pollset_set* interested_parties() override {
+        return delegate_->interested_parties();
+      }
+
+      // Tells the child policy about the address being ejected or
+      // returned.  Either way, the child policy's view changes only if
+      // the subchannel is not in TRANSIENT_FAILURE anyway.
+      void OnEjectionChanged(bool ejected) {
+        if (last_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE) return;
+        delegate_->OnConnectivityStateChange(
+            ejected ? GRPC_CHANNEL_TRANSIENT_FAILURE : last_state_);
+      }
+
+     private:
+      std::unique_ptr<SubchannelInterface::ConnectivityStateWatcherInterface>
+          delegate_;
+      RefCountedPtr<EndpointState> endpoint_;
+      grpc_connectivity_state last_state_;
+    };
+
+    // The calls recorded during an interval.
+    struct Interval {
+      uint64_t successes = 0;
+      uint64_t failures = 0;
+      // The requested percentile of the latencies of the successful calls.
+      double latency_us = 0;
+    };
+
+    explicit EndpointState(std::string address)
+        : address_(std::move(address)) {}
+
+    const std::string& address() const { return address_; }
+
+    // Records a finished call.  May be called from any thread.
+    void RecordCall(bool succeeded, int64_t latency_us);
+
+    // Returns the calls recorded since the last call and starts a new
+    // interval.
+    Interval TakeIntervalLocked(double latency_percentile);
+
+    bool ejected() const { return ejected_; }
+    void EjectLocked(grpc_millis now);
+    // Returns the address to the child policy if its ejection time is up.
+    // Returns true if it did.
+    bool MaybeUnejectLocked(grpc_millis now,
+                            const ParsedOutlierDetectionConfig::Params& params);
+
+    void AddWatcherLocked(WatcherWrapper* watcher) {
+      watchers_.insert(watcher);
+    }
+    void RemoveWatcherLocked(WatcherWrapper* watcher) {
+      watchers_.erase(watcher);
+    }
+
+   private:
+    void NotifyWatchersLocked();
+
+    // Successful calls are counted by latency: bucket i counts the
+    // latencies in [2^i, 2^(i+1)) microseconds, and bucket 0 also counts
+    // the shorter ones.
+    static constexpr size_t kNumLatencyBuckets = 32;
+
+    const std::string address_;
+
+    // Updated without a lock by the calls, and taken by the policy.
+    Atomic<uint64_t> latency_buckets_[kNumLatencyBuckets];
+    Atomic<uint64_t> failures_{0};
+
+    // Ejection state, only accessed in the combiner.
+    bool ejected_ = false;
+    grpc_millis ejection_time_ = 0;
+    // Goes up on each ejection, and back down on each interval the
+    // address is not ejected.
+    int ejection_multiplier_ = 0;
+    std::set<WatcherWrapper*> watchers_;
+  };
+
+  // Wraps the subchannels that the child policy creates, to link them to
+  // the state of their address.
+  class SubchannelWrapper : public SubchannelInterface {
+   public:
+    SubchannelWrapper(RefCountedPtr<SubchannelInterface> subchannel,
+                      RefCountedPtr<EndpointState> endpoint)
+        : subchannel_(std::move(subchannel)), endpoint_(std::move(endpoint)) {}
+
+    ~SubchannelWrapper() {
+      // Child policies cancel their watch before giving up their
+      // subchannels, so this only happens in the combiner.
+      if (watcher_ != nullptr) endpoint_->RemoveWatcherLocked(watcher_);
+    }
+
+    grpc_connectivity_state CheckConnectivityState() override {
+      const grpc_connectivity_state state =
+          subchannel_->CheckConnectivityState();
+      return endpoint_->ejected() ? GRPC_CHANNEL_TRANSIENT_FAILURE : state;
+    }
+
+    void WatchConnectivityState(
+        grpc_connectivity_state initial_state,
+        std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+      delegate_ = watcher.get();
+      watcher_ =
+          new EndpointState::WatcherWrapper(std::move(watcher), endpoint_,
+                                            initial_state);
+      endpoint_->AddWatcherLocked(watcher_);
+      subchannel_->WatchConnectivityState(
+          initial_state,
+          std::unique_ptr<ConnectivityStateWatcherInterface>(watcher_));
+    }
+
+    void CancelConnectivityStateWatch(
+        ConnectivityStateWatcherInterface* watcher) override {
+      if (watcher_ == nullptr || watcher != delegate_) return;
+      endpoint_->RemoveWatcherLocked(watcher_);
+      subchannel_->CancelConnectivityStateWatch(watcher_);
+      watcher_ = nullptr;
+      delegate_ = nullptr;
+    }
+
+    void AttemptToConnect() override { subchannel_->AttemptToConnect(); }
+    void ResetBackoff() override { subchannel_->ResetBackoff(); }
+    bool IsSaturated() override { return subchannel_->IsSaturated(); }
+    const grpc_channel_args* channel_args() override {
+      return subchannel_->channel_args();
+    }
+
+    const RefCountedPtr<SubchannelInterface>& wrapped_subchannel() const {
+      return subchannel_;
+    }
+    const RefCountedPtr<EndpointState>& endpoint() const { return endpoint_; }
+
+   private:
+    RefCountedPtr<SubchannelInterface> subchannel_;
+    RefCountedPtr<EndpointState> endpoint_;
+    // The child policy's watcher, and the wrapper we registered for it,
+    // which is owned by subchannel_.
+    ConnectivityStateWatcherInterface* delegate_ = nullptr;
+    EndpointState::WatcherWrapper* watcher_ = nullptr;
+  };
+
+  // Wraps the child policy's picker, to hand the wrapped subchannels to
+  // the channel and record the outcome of the calls.
+  class Picker : public SubchannelPicker {
+   public:
+    explicit Picker(std::unique_ptr<SubchannelPicker> picker)
+        : picker_(std::move(picker)) {}
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    std::unique_ptr<SubchannelPicker> picker_;
+  };
+
+  class Helper : public ChannelControlHelper {
+   public:
+    explicit Helper(RefCountedPtr<OutlierDetectionLb> parent)
+        : parent_(std::move(parent)) {}
+
+    ~Helper() { parent_.reset(DEBUG_LOCATION, "Helper"); }
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        const grpc_channel_args& args) override;
+    void UpdateState(grpc_connectivity_state state,
+                     std::unique_ptr<SubchannelPicker> picker) override;
+    void RequestReresolution() override;
+    void AddTraceEvent(TraceSeverity severity, StringView message) override;
+
+   private:
+    RefCountedPtr<OutlierDetectionLb> parent_;
+  };
+
+  ~OutlierDetectionLb();
+
+  void ShutdownLocked() override;
+
+  void StartIntervalTimerLocked();
+  static void OnIntervalTimer(void* arg, grpc_error* error);
+  static void OnIntervalTimerLocked(void* arg, grpc_error* error);
+  void EjectOutliersLocked();
+
+  RefCountedPtr<ParsedOutlierDetectionConfig> config_;
+
+  // Child LB policy.
+  OrphanablePtr<LoadBalancingPolicy> child_policy_;
+
+  // The state of each address in the latest update, by URI.
+  std::map<std::string, RefCountedPtr<EndpointState>> endpoints_;
+
+  // Timer for looking for outliers.
+  bool interval_timer_pending_ = false;
+  grpc_timer interval_timer_;
+  grpc_closure on_interval_timer_;
+
+  bool shutting_down_ = false;
+};
+
+//
+// OutlierDetectionLb::EndpointState
+//
+
+void OutlierDetectionLb::EndpointState::RecordCall(bool succeeded,
+                                                   int64_t latency_us) {
+  if (!succeeded) {
+    failures_.FetchAdd(1, MemoryOrder::RELAXED);
+    return;
+  }
+  size_t bucket = 0;
+  while (bucket + 1 < kNumLatencyBuckets &&
+         latency_us >= (static_cast<int64_t>(2) << bucket)) {
+    ++bucket;
+  }
+  latency_buckets_[bucket].FetchAdd(1, MemoryOrder::RELAXED);
+}
+
+OutlierDetectionLb::EndpointState::Interval
+OutlierDetectionLb::EndpointState::TakeIntervalLocked(
+    double latency_percentile) {
+  Interval interval;
+  interval.failures = failures_.Exchange(0, MemoryOrder::RELAXED);
+  uint64_t buckets[kNumLatencyBuckets];
+  for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+    buckets[i] = latency_buckets_[i].Exchange(0, MemoryOrder::RELAXED);
+    interval.successes += buckets[i];
+  }
+  if (interval.successes == 0) return interval;
+  // Find the bucket holding the percentile, and assume that the latencies
+  // are spread evenly over it.
+  const double rank = interval.successes * latency_percentile / 100;
+  uint64_t below = 0;
+  for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+    if (buckets[i] == 0) continue;
+    if (below + buckets[i] >= rank || i + 1 == kNumLatencyBuckets) {
+      const double low = i == 0 ? 0 : static_cast<double>(1ULL << i);
+      const double high = static_cast<double>(1ULL << (i + 1));
+      interval.latency_us =
+          low + (high - low) * std::max(0.0, rank - below) / buckets[i];
+      break;
+    }
+    below += buckets[i];
+  }
+  return interval;
+}
+
+void OutlierDetectionLb::EndpointState::EjectLocked(grpc_millis now) {
+  ejected_ = true;
+  ejection_time_ = now;
+  ++ejection_multiplier_;
+  NotifyWatchersLocked();
+}
+
+bool OutlierDetectionLb::EndpointState::MaybeUnejectLocked(
+    grpc_millis now, const ParsedOutlierDetectionConfig::Params& params) {
+  if (!ejected_) {
+    if (ejection_multiplier_ > 0) --ejection_multiplier_;
+    return false;
+  }
+  const grpc_millis ejection_duration =
+      std::min(params.base_ejection_time * ejection_multiplier_,
+               std::max(params.base_ejection_time, params.max_ejection_time));
+  if (now < ejection_time_ + ejection_duration) return false;
+  ejected_ = false;
+  NotifyWatchersLocked();
+  return true;
+}
+
+void OutlierDetectionLb::EndpointState::NotifyWatchersLocked() {
+  // The child policy may cancel watches as it reacts, which destroys
+  // their watchers, so skip the ones that are gone by their turn.
+  std::vector<WatcherWrapper*> watchers(watchers_.begin(), watchers_.end());
+  for (WatcherWrapper* watcher : watchers) {
+    if (watchers_.find(watcher) != watchers_.end()) {
+      watcher->OnEjectionChanged(ejected_);
+    }
+  }
+}
+
+//
+// OutlierDetectionLb::Picker
+//
+
+bool CallSucceeded(grpc_error* error,
+                   LoadBalancingPolicy::MetadataInterface* metadata) {
+  if (error != GRPC_ERROR_NONE) return false;
+  if (metadata == nullptr) return true;
+  for (const auto& md : *metadata) {
+    if (md.first == "grpc-status") return md.second == "0";
+  }
+  return true;
+}
+
+OutlierDetectionLb::PickResult OutlierDetectionLb::Picker::Pick(
+    PickArgs args) {
+  PickResult result = picker_->Pick(args);
+  if (result.type != PickResult::PICK_COMPLETE ||
+      result.subchannel == nullptr) {
+    return result;
+  }
+  // All of the child policy's subchannels come from our helper.
+  SubchannelWrapper* subchannel =
+      static_cast<SubchannelWrapper*>(result.subchannel.get());
+  RefCountedPtr<EndpointState> endpoint = subchannel->endpoint();
+  result.subchannel = subchannel->wrapped_subchannel();
+  // Record the outcome of the call, and pass it on to the child policy
+  // if it wants it too.
+  const gpr_timespec start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  std::function<void(grpc_error*, MetadataInterface*, CallState*)>
+      child_recv_trailing_metadata_ready =
+          std::move(result.recv_trailing_metadata_ready);
+  result.recv_trailing_metadata_ready =
+      // Note: This callback does not run in either the control plane
+      // combiner or in the data plane mutex.
+      [endpoint, start_time, child_recv_trailing_metadata_ready](
+          grpc_error* error, MetadataInterface* metadata,
+          CallState* call_state) {
+        const gpr_timespec latency =
+            gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time);
+        endpoint->RecordCall(
+            CallSucceeded(error, metadata),
+            latency.tv_sec * GPR_US_PER_SEC + latency.tv_nsec / GPR_NS_PER_US);
+        if (child_recv_trailing_metadata_ready != nullptr) {
+          child_recv_trailing_metadata_ready(error, metadata, call_state);
+        }
+      };
+  return result;
+}
+
+//
+// OutlierDetectionLb::Helper
+//
+
+RefCountedPtr<SubchannelInterface> OutlierDetectionLb::Helper::CreateSubchannel(
+    const grpc_channel_args& args) {
+  if (parent_->shutting_down_) return nullptr;
+  RefCountedPtr<SubchannelInterface> subchannel =
+      parent_->channel_control_helper()->CreateSubchannel(args);
+  if (subchannel == nullptr) return nullptr;
+  const char* uri = Subchannel::GetUriFromSubchannelAddressArg(&args);
+  if (uri == nullptr) uri = "";
+  auto it = parent_->endpoints_.find(uri);
+  // If the address is not in the latest update, its calls are recorded but
+  // never checked.
+  RefCountedPtr<EndpointState> endpoint =
+      it != parent_->endpoints_.end() ? it->second
+                                      : MakeRefCounted<EndpointState>(uri);
+  return MakeRefCounted<SubchannelWrapper>(std::move(subchannel),
+                                           std::move(endpoint));
+}
+
+void OutlierDetectionLb::Helper::UpdateState(
+    grpc_connectivity_state state, std::unique_ptr<SubchannelPicker> picker) {
+  if (parent_->shutting_down_) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection_lb %p] state updated by child: %s",
+            parent_.get(), ConnectivityStateName(state));
+  }
+  parent_->channel_control_helper()->UpdateState(
+      state, MakeUnique<Picker>(std::move(picker)));
+}
+
+void OutlierDetectionLb::Helper::RequestReresolution() {
+  if (parent_->shutting_down_) return;
+  parent_->channel_control_helper()->RequestReresolution();
+}
+
+void OutlierDetectionLb::Helper::AddTraceEvent(TraceSeverity severity,
+                                               StringView message) {
+  if (parent_->shutting_down_) return;
+  parent_->channel_control_helper()->AddTraceEvent(severity, message);
+}
+
+//
+// OutlierDetectionLb
+//
+
+OutlierDetectionLb::OutlierDetectionLb(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection_lb %p] created", this);
+  }
+}
+
+OutlierDetectionLb::~OutlierDetectionLb() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] destroying outlier_detection LB policy",
+            this);
+  }
+}
+
+void OutlierDetectionLb::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection_lb %p] shutting down", this);
+  }
+  shutting_down_ = true;
+  if (interval_timer_pending_) {
+    grpc_timer_cancel(&interval_timer_);
+  }
+  if (child_policy_ != nullptr) {
+    grpc_pollset_set_del_pollset_set(child_policy_->interested_parties(),
+                                     interested_parties());
+    child_policy_.reset();
+  }
+  endpoints_.clear();
+}
+
+void OutlierDetectionLb::ExitIdleLocked() {
+  if (child_policy_ != nullptr) child_policy_->ExitIdleLocked();
+}
+
+void OutlierDetectionLb::ResetBackoffLocked() {
+  if (child_policy_ != nullptr) child_policy_->ResetBackoffLocked();
+}
+
+void OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] received update with %" PRIuPTR
+            " addresses",
+            this, args.addresses.size());
+  }
+  auto old_config = std::move(config_);
+  config_ = std::move(args.config);
+  // Keep the state of the addresses that are still there.
+  std::map<std::string, RefCountedPtr<EndpointState>> endpoints;
+  for (size_t i = 0; i < args.addresses.size(); ++i) {
+    char* uri = grpc_sockaddr_to_uri(&args.addresses[i].address());
+    auto it = endpoints_.find(uri);
+    endpoints[uri] = it != endpoints_.end()
+                         ? std::move(it->second)
+                         : MakeRefCounted<EndpointState>(uri);
+    gpr_free(uri);
+  }
+  endpoints_ = std::move(endpoints);
+  // Replace the child policy if its name changed.
+  if (child_policy_ != nullptr &&
+      strcmp(child_policy_->name(), config_->child_policy()->name()) != 0) {
+    grpc_pollset_set_del_pollset_set(child_policy_->interested_parties(),
+                                     interested_parties());
+    child_policy_.reset();
+  }
+  if (child_policy_ == nullptr) {
+    LoadBalancingPolicy::Args child_args;
+    child_args.combiner = combiner();
+    child_args.args = args.args;
+    child_args.channel_control_helper =
+        MakeUnique<Helper>(Ref(DEBUG_LOCATION, "Helper"));
+    child_policy_ = LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+        config_->child_policy()->name(), std::move(child_args));
+    grpc_pollset_set_add_pollset_set(child_policy_->interested_parties(),
+                                     interested_parties());
+  }
+  // Restart the interval timer if the interval changed.
+  if (interval_timer_pending_ && old_config != nullptr &&
+      old_config->params().interval != config_->params().interval) {
+    grpc_timer_cancel(&interval_timer_);
+  }
+  StartIntervalTimerLocked();
+  // Update child policy.
+  UpdateArgs child_update;
+  child_update.addresses = std::move(args.addresses);
+  child_update.config = config_->child_policy();
+  child_update.args = args.args;
+  args.args = nullptr;
+  child_policy_->UpdateLocked(std::move(child_update));
+}
+
+void OutlierDetectionLb::StartIntervalTimerLocked() {
+  if (interval_timer_pending_ || shutting_down_) return;
+  // TODO(roth): We currently track this ref manually.  Once the
+  // ClosureRef API is ready, we should pass the RefCountedPtr<> along
+  // with the callback.
+  auto self = Ref(DEBUG_LOCATION, "on_interval_timer");
+  self.release();
+  GRPC_CLOSURE_INIT(&on_interval_timer_, &OutlierDetectionLb::OnIntervalTimer,
+                    this, grpc_schedule_on_exec_ctx);
+  interval_timer_pending_ = true;
+  grpc_timer_init(&interval_timer_,
+                  ExecCtx::Get()->Now() + config_->params().interval,
+                  &on_interval_timer_);
+}
+
+void OutlierDetectionLb::OnIntervalTimer(void* arg, grpc_error* error) {
+  OutlierDetectionLb* self = static_cast<OutlierDetectionLb*>(arg);
+  self->combiner()->Run(
+      GRPC_CLOSURE_INIT(&self->on_interval_timer_,
+                        &OutlierDetectionLb::OnIntervalTimerLocked, self,
+                        nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+void OutlierDetectionLb::OnIntervalTimerLocked(void* arg, grpc_error* error) {
+  OutlierDetectionLb* self = static_cast<OutlierDetectionLb*>(arg);
+  self->interval_timer_pending_ = false;
+  if (!self->shutting_down_) {
+    if (error == GRPC_ERROR_NONE) self->EjectOutliersLocked();
+    // Also restarts the timer after it was cancelled for a new interval.
+    self->StartIntervalTimerLocked();
+  }
+  self->Unref(DEBUG_LOCATION, "on_interval_timer");
+}
+
+void OutlierDetectionLb::EjectOutliersLocked() {
+  const ParsedOutlierDetectionConfig::Params& params = config_->params();
+  const grpc_millis now = ExecCtx::Get()->Now();
+  // Take the calls of the interval, and return the addresses whose
+  // ejection time is up.
+  struct Candidate {
+    EndpointState* endpoint;
+    EndpointState::Interval interval;
+  };
+  std::vector<Candidate> candidates;
+  size_t num_ejected = 0;
+  for (auto& p : endpoints_) {
+    EndpointState* endpoint = p.second.get();
+    Candidate candidate = {
+        endpoint, endpoint->TakeIntervalLocked(params.latency_percentile)};
+    if (endpoint->MaybeUnejectLocked(now, params) &&
+        GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+      gpr_log(GPR_INFO, "[outlier_detection_lb %p] returning address %s",
+              this, endpoint->address().c_str());
+    }
+    if (endpoint->ejected()) {
+      ++num_ejected;
+    } else {
+      candidates.push_back(candidate);
+    }
+  }
+  auto eject = [&](EndpointState* endpoint, const char* reason) {
+    if (endpoint->ejected() ||
+        num_ejected * 100 >=
+            static_cast<size_t>(params.max_ejection_percent) *
+                endpoints_.size()) {
+      return;
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_outlier_detection_trace)) {
+      gpr_log(GPR_INFO, "[outlier_detection_lb %p] ejecting address %s: %s",
+              this, endpoint->address().c_str(), reason);
+    }
+    endpoint->EjectLocked(now);
+    ++num_ejected;
+  };
+  const size_t minimum_hosts = static_cast<size_t>(params.minimum_hosts);
+  const uint64_t request_volume = static_cast<uint64_t>(params.request_volume);
+  // Success rate.
+  if (params.success_rate_stdev_factor > 0) {
+    std::vector<std::pair<EndpointState*, double>> success_rates;
+    for (const Candidate& candidate : candidates) {
+      const uint64_t volume =
+          candidate.interval.successes + candidate.interval.failures;
+      if (volume < request_volume || volume == 0) continue;
+      success_rates.emplace_back(
+          candidate.endpoint,
+          static_cast<double>(candidate.interval.successes) / volume);
+    }
+    if (!success_rates.empty() && success_rates.size() >= minimum_hosts) {
+      double mean = 0;
+      for (const auto& p : success_rates) mean += p.second;
+      mean /= success_rates.size();
+      double variance = 0;
+      for (const auto& p : success_rates) {
+        variance += (p.second - mean) * (p.second - mean);
+      }
+      variance /= success_rates.size();
+      const double threshold =
+          mean - params.success_rate_stdev_factor * sqrt(variance);
+      for (const auto& p : success_rates) {
+        if (p.second < threshold) eject(p.first, "low success rate");
+      }
+    }
+  }
+  // Latency.
+  if (params.latency_threshold_factor > 0) {
+    std::vector<std::pair<EndpointState*, double>> latencies;
+    for (const Candidate& candidate : candidates) {
+      if (candidate.interval.successes < request_volume ||
+          candidate.interval.successes == 0) {
+        continue;
+      }
+      latencies.emplace_back(candidate.endpoint, candidate.interval.latency_us);
+    }
+    if (!latencies.empty() && latencies.size() >= minimum_hosts) {
+      std::vector<double> sorted;
+      for (const auto& p : latencies) sorted.push_back(p.second);
+      // With an even count, take the lower of the two middle values, so
+      // that one slow address out of two counts as an outlier.
+      const size_t median = (sorted.size() - 1) / 2;
+      std::nth_element(sorted.begin(), sorted.begin() + median, sorted.end());
+      const double threshold =
+          sorted[median] * params.latency_threshold_factor;
+      for (const auto& p : latencies) {
+        if (p.second > threshold) eject(p.first, "high latency");
+      }
+    }
+  }
+}
+
+//
+// factory
+//
+
+// Parses a JSON field of the form generated for a google.proto.Duration
+// proto message, such as "1.5s".
+bool ParseDuration(const grpc_json* field, grpc_millis* duration) {
+  if (field->type != GRPC_JSON_STRING) return false;
+  const size_t len = strlen(field->value);
+  if (len == 0 || field->value[len - 1] != 's') return false;
+  char* end;
+  const double seconds = strtod(field->value, &end);
+  if (end != field->value + len - 1 || seconds < 0) return false;
+  *duration = static_cast<grpc_millis>(seconds * GPR_MS_PER_SEC);
+  return true;
+}
+
+class OutlierDetectionFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<OutlierDetectionLb>(std::move(args));
+  }
+
+  const char* name() const override { return kOutlierDetection; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const grpc_json* json, grpc_error** error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    if (json == nullptr) {
+      // outlier_detection was mentioned as a policy in the deprecated
+      // loadBalancingPolicy field or in the client API.
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:loadBalancingPolicy error:outlier_detection policy requires "
+          "configuration. Please use loadBalancingConfig field of service "
+          "config instead.");
+      return nullptr;
+    }
+    GPR_DEBUG_ASSERT(strcmp(json->key, name()) == 0);
+    InlinedVector<grpc_error*, 3> error_list;
+    RefCountedPtr<LoadBalancingPolicy::Config> child_policy;
+    ParsedOutlierDetectionConfig::Params params;
+    for (const grpc_json* field = json->child; field != nullptr;
+         field = field->next) {
+      if (field->key == nullptr) continue;
+      if (strcmp(field->key, "childPolicy") == 0) {
+        if (child_policy != nullptr) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:childPolicy error:Duplicate entry"));
+        }
+        grpc_error* parse_error = GRPC_ERROR_NONE;
+        child_policy = LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+            field, &parse_error);
+        if (child_policy == nullptr) {
+          GPR_DEBUG_ASSERT(parse_error != GRPC_ERROR_NONE);
+          error_list.push_back(parse_error);
+        }
+      } else if (strcmp(field->key, "interval") == 0) {
+        if (!ParseDuration(field, &params.interval) || params.interval == 0) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:interval error:should be a positive duration"));
+        }
+      } else if (strcmp(field->key, "baseEjectionTime") == 0) {
+        if (!ParseDuration(field, &params.base_ejection_time)) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:baseEjectionTime error:Failed to parse"));
+        }
+      } else if (strcmp(field->key, "maxEjectionTime") == 0) {
+        if (!ParseDuration(field, &params.max_ejection_time)) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:maxEjectionTime error:Failed to parse"));
+        }
+      } else if (strcmp(field->key, "maxEjectionPercent") == 0) {
+        params.max_ejection_percent =
+            field->type == GRPC_JSON_NUMBER
+                ? gpr_parse_nonnegative_int(field->value)
+                : -1;
+        if (params.max_ejection_percent < 0 ||
+            params.max_ejection_percent > 100) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:maxEjectionPercent error:should be an integer between 0 "
+              "and 100"));
+        }
+      } else if (strcmp(field->key, "successRateStdevFactor") == 0) {
+        params.success_rate_stdev_factor =
+            field->type == GRPC_JSON_NUMBER ? strtod(field->value, nullptr)
+                                            : -1;
+        if (params.success_rate_stdev_factor < 0) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:successRateStdevFactor error:should be a non-negative "
+              "number"));
+        }
+      } else if (strcmp(field->key, "latencyPercentile") == 0) {
+        params.latency_percentile =
+            field->type == GRPC_JSON_NUMBER ? strtod(field->value, nullptr)
+                                            : -1;
+        if (params.latency_percentile <= 0 ||
+            params.latency_percentile > 100) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:latencyPercentile error:should be a number greater than "
+              "0 and at most 100"));
+        }
+      } else if (strcmp(field->key, "latencyThresholdFactor") == 0) {
+        params.latency_threshold_factor =
+            field->type == GRPC_JSON_NUMBER ? strtod(field->value, nullptr)
+                                            : -1;
+        if (params.latency_threshold_factor < 0) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:latencyThresholdFactor error:should be a non-negative "
+              "number"));
+        }
+      } else if (strcmp(field->key, "minimumHosts") == 0) {
+        params.minimum_hosts = field->type == GRPC_JSON_NUMBER
+                                   ? gpr_parse_nonnegative_int(field->value)
+                                   : -1;
+        if (params.minimum_hosts < 0) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:minimumHosts error:should be a non-negative integer"));
+        }
+      } else if (strcmp(field->key, "requestVolume") == 0) {
+        params.request_volume = field->type == GRPC_JSON_NUMBER
+                                    ? gpr_parse_nonnegative_int(field->value)
+                                    : -1;
+        if (params.request_volume < 0) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:requestVolume error:should be a non-negative integer"));
+        }
+      }
+    }
+    if (child_policy == nullptr && error_list.empty()) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:childPolicy error:required field not present"));
+    }
+    if (error_list.empty()) {
+      return MakeRefCounted<ParsedOutlierDetectionConfig>(
+          std::move(child_policy), params);
+    } else {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR("OutlierDetection Parser",
+                                             &error_list);
+      return nullptr;
+    }
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+//
+// Plugin registration
+//
+
+void grpc_lb_policy_outlier_detection_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          grpc_core::MakeUnique<grpc_core::OutlierDetectionFactory>());
+}
+
+void grpc_lb_policy_outlier_detection_shutdown() {}
@@ -29,6 +29,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/transport/connectivity_state.h"
 
 namespace grpc_core {
@@ -43,6 +44,10 @@ namespace {
 
 constexpr char kPickFirst[] = "pick_first";
 
+// How long to wait for a connection attempt before also trying the next
+// address, as recommended by RFC 8305 (Happy Eyeballs).
+constexpr grpc_millis kConnectionAttemptDelay = 250;
+
 class PickFirst : public LoadBalancingPolicy {
  public:
   explicit PickFirst(Args args);
@@ -98,13 +103,60 @@ class PickFirst : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
+    void Orphan() override {
+      if (connection_attempt_timer_pending_) {
+        grpc_timer_cancel(&connection_attempt_timer_);
+      }
+      SubchannelList::Orphan();
+    }
+
     bool in_transient_failure() const { return in_transient_failure_; }
     void set_in_transient_failure(bool in_transient_failure) {
       in_transient_failure_ = in_transient_failure;
     }
 
+    // Starts connecting to the next address that has not been tried yet.
+    // The attempt after that starts as soon as this one fails, or after
+    // kConnectionAttemptDelay if it has not succeeded by then, so that an
+    // address that does not answer does not hold up the others.  Attempts
+    // already started keep going, and the first one to succeed is selected.
+    void StartNextConnectionAttemptLocked();
+
+    // Called when a connection attempt fails.
+    void ConnectionAttemptFailedLocked() {
+      GPR_ASSERT(num_attempts_in_flight_ > 0);
+      --num_attempts_in_flight_;
+    }
+
+    // Makes the next connection attempt start again from the first address.
+    void RestartConnectionAttemptsLocked() { next_attempt_index_ = 0; }
+
+    bool all_connection_attempts_started() const {
+      return next_attempt_index_ == num_subchannels();
+    }
+    size_t num_connection_attempts_in_flight() const {
+      return num_attempts_in_flight_;
+    }
+
    private:
+    // Returns true if a subchannel of this list has been selected.
+    bool HasSelectedSubchannel() const;
+
+    void StartConnectionAttemptTimerLocked(grpc_millis deadline);
+    static void OnConnectionAttemptTimer(void* arg, grpc_error* error);
+    static void OnConnectionAttemptTimerLocked(void* arg, grpc_error* error);
+
     bool in_transient_failure_ = false;
+
+    // Index of the next subchannel to try connecting to.
+    size_t next_attempt_index_ = 0;
+    size_t num_attempts_in_flight_ = 0;
+    grpc_millis last_attempt_start_time_ = 0;
+
+    // Timer for starting the next connection attempt.
+    bool connection_attempt_timer_pending_ = false;
+    grpc_timer connection_attempt_timer_;
+    grpc_closure on_connection_attempt_timer_;
   };
 
   class Picker : public SubchannelPicker {
@@ -229,11 +281,7 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
     subchannel_list_ = std::move(subchannel_list);
     // If we're not in IDLE state, start trying to connect to the first
     // subchannel in the new list.
-    // Note: No need to use CheckConnectivityStateAndStartWatchingLocked()
-    // here, since we've already checked the initial connectivity
-    // state of all subchannels above.
-    subchannel_list_->subchannel(0)->StartConnectivityWatchLocked();
-    subchannel_list_->subchannel(0)->subchannel()->AttemptToConnect();
+    subchannel_list_->StartNextConnectionAttemptLocked();
   } else {
     // We do have a selected subchannel (which means it's READY), so keep
     // using it until one of the subchannels in the new list reports READY.
@@ -249,14 +297,7 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
     latest_pending_subchannel_list_ = std::move(subchannel_list);
     // If we're not in IDLE state, start trying to connect to the first
     // subchannel in the new list.
-    // Note: No need to use CheckConnectivityStateAndStartWatchingLocked()
-    // here, since we've already checked the initial connectivity
-    // state of all subchannels above.
-    latest_pending_subchannel_list_->subchannel(0)
-        ->StartConnectivityWatchLocked();
-    latest_pending_subchannel_list_->subchannel(0)
-        ->subchannel()
-        ->AttemptToConnect();
+    latest_pending_subchannel_list_->StartNextConnectionAttemptLocked();
   }
 }
 
@@ -373,31 +414,36 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
     }
     case GRPC_CHANNEL_TRANSIENT_FAILURE: {
       CancelConnectivityWatchLocked("connection attempt failed");
-      PickFirstSubchannelData* sd = this;
-      size_t next_index =
-          (sd->Index() + 1) % subchannel_list()->num_subchannels();
-      sd = subchannel_list()->subchannel(next_index);
-      // If we're tried all subchannels, set state to TRANSIENT_FAILURE.
-      if (sd->Index() == 0) {
-        // Re-resolve if this is the most recent subchannel list.
-        if (subchannel_list() == (p->latest_pending_subchannel_list_ != nullptr
-                                      ? p->latest_pending_subchannel_list_.get()
-                                      : p->subchannel_list_.get())) {
-          p->channel_control_helper()->RequestReresolution();
-        }
-        subchannel_list()->set_in_transient_failure(true);
-        // Only report new state in case 1.
-        if (subchannel_list() == p->subchannel_list_.get()) {
-          grpc_error* error = grpc_error_set_int(
-              GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-                  "failed to connect to all addresses"),
-              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
-          p->channel_control_helper()->UpdateState(
-              GRPC_CHANNEL_TRANSIENT_FAILURE,
-              MakeUnique<TransientFailurePicker>(error));
-        }
+      PickFirstSubchannelList* subchannel_list = this->subchannel_list();
+      subchannel_list->ConnectionAttemptFailedLocked();
+      // Try the next address now rather than when the delay expires.
+      if (!subchannel_list->all_connection_attempts_started()) {
+        subchannel_list->StartNextConnectionAttemptLocked();
+        break;
       }
-      sd->CheckConnectivityStateAndStartWatchingLocked();
+      // Otherwise, wait for the attempts that are still in flight.
+      if (subchannel_list->num_connection_attempts_in_flight() > 0) break;
+      // We've tried all subchannels, so set state to TRANSIENT_FAILURE.
+      // Re-resolve if this is the most recent subchannel list.
+      if (subchannel_list == (p->latest_pending_subchannel_list_ != nullptr
+                                  ? p->latest_pending_subchannel_list_.get()
+                                  : p->subchannel_list_.get())) {
+        p->channel_control_helper()->RequestReresolution();
+      }
+      subchannel_list->set_in_transient_failure(true);
+      // Only report new state in case 1.
+      if (subchannel_list == p->subchannel_list_.get()) {
+        grpc_error* error = grpc_error_set_int(
+            GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "failed to connect to all addresses"),
+            GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+        p->channel_control_helper()->UpdateState(
+            GRPC_CHANNEL_TRANSIENT_FAILURE,
+            MakeUnique<TransientFailurePicker>(error));
+      }
+      // Keep trying, starting over from the first address.
+      subchannel_list->RestartConnectionAttemptsLocked();
+      subchannel_list->StartNextConnectionAttemptLocked();
       break;
     }
     case GRPC_CHANNEL_CONNECTING:
@@ -471,6 +517,81 @@ void PickFirst::PickFirstSubchannelData::
   }
 }
 
+//
+// PickFirst::PickFirstSubchannelList
+//
+
+bool PickFirst::PickFirstSubchannelList::HasSelectedSubchannel() const {
+  PickFirst* p = static_cast<PickFirst*>(policy());
+  return p->selected_ != nullptr && p->selected_->subchannel_list() == this;
+}
+
+void PickFirst::PickFirstSubchannelList::StartNextConnectionAttemptLocked() {
+  GPR_ASSERT(!all_connection_attempts_started());
+  PickFirstSubchannelData* sd = subchannel(next_attempt_index_++);
+  ++num_attempts_in_flight_;
+  last_attempt_start_time_ = ExecCtx::Get()->Now();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+    gpr_log(GPR_INFO,
+            "Pick First %p subchannel list %p starting connection attempt "
+            "to subchannel %p (index %" PRIuPTR " of %" PRIuPTR
+            "), %" PRIuPTR " in flight",
+            policy(), this, sd->subchannel(), sd->Index(), num_subchannels(),
+            num_attempts_in_flight_);
+  }
+  sd->CheckConnectivityStateAndStartWatchingLocked();
+  // The subchannel may have been selected right away.
+  if (HasSelectedSubchannel() || all_connection_attempts_started()) return;
+  StartConnectionAttemptTimerLocked(last_attempt_start_time_ +
+                                    kConnectionAttemptDelay);
+}
+
+void PickFirst::PickFirstSubchannelList::StartConnectionAttemptTimerLocked(
+    grpc_millis deadline) {
+  if (connection_attempt_timer_pending_) return;
+  // TODO(roth): We currently track this ref manually.  Once the
+  // ClosureRef API is ready, we should pass the RefCountedPtr<> along
+  // with the callback.
+  auto self = Ref(DEBUG_LOCATION, "on_connection_attempt_timer");
+  self.release();
+  GRPC_CLOSURE_INIT(&on_connection_attempt_timer_,
+                    &PickFirstSubchannelList::OnConnectionAttemptTimer, this,
+                    grpc_schedule_on_exec_ctx);
+  connection_attempt_timer_pending_ = true;
+  grpc_timer_init(&connection_attempt_timer_, deadline,
+                  &on_connection_attempt_timer_);
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimer(
+    void* arg, grpc_error* error) {
+  PickFirstSubchannelList* self = static_cast<PickFirstSubchannelList*>(arg);
+  PickFirst* p = static_cast<PickFirst*>(self->policy());
+  p->combiner()->Run(GRPC_CLOSURE_INIT(&self->on_connection_attempt_timer_,
+                                       OnConnectionAttemptTimerLocked, self,
+                                       nullptr),
+                     GRPC_ERROR_REF(error));
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimerLocked(
+    void* arg, grpc_error* error) {
+  PickFirstSubchannelList* self = static_cast<PickFirstSubchannelList*>(arg);
+  self->connection_attempt_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && !self->shutting_down() &&
+      !self->HasSelectedSubchannel() &&
+      !self->all_connection_attempts_started()) {
+    // An attempt that failed early may have started the next one since the
+    // timer was set, in which case wait for that one's delay instead.
+    const grpc_millis next_attempt_time =
+        self->last_attempt_start_time_ + kConnectionAttemptDelay;
+    if (ExecCtx::Get()->Now() >= next_attempt_time) {
+      self->StartNextConnectionAttemptLocked();
+    } else {
+      self->StartConnectionAttemptTimerLocked(next_attempt_time);
+    }
+  }
+  self->Unref(DEBUG_LOCATION, "on_connection_attempt_timer");
+}
+
 class ParsedPickFirstConfig : public LoadBalancingPolicy::Config {
  public:
   const char* name() const override { return kPickFirst; }
@@ -0,0 +1,731 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Ring Hash Policy.
+ *
+ * Consistent hashing: each address is hashed onto a ring many times, and a
+ * call goes to the address that owns the first point of the ring at or
+ * after the hash of the call's key.  The key is the value of a request
+ * header named in the config, so calls carrying the same key go to the same
+ * backend.  Calls without the key are spread over the ring.
+ *
+ * Since the points of an address depend only on the address, adding or
+ * removing an address only remaps the keys that hash next to its points.
+ * When the owner of a point is not READY, the call goes to the owner of the
+ * next point that is, so the keys of a failing backend spread over the
+ * others instead of piling onto a single one.
+ *
+ * The ring is built once per address list and never modified afterwards,
+ * so pickers share it and look keys up without a lock. */
+
+#include <grpc/support/port_platform.h>
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/murmur_hash.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/transport/static_metadata.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_ring_hash_trace(false, "ring_hash");
+
+namespace {
+
+//
+// ring_hash LB policy
+//
+
+constexpr char kRingHash[] = "ring_hash";
+
+// Defaults for the number of points on the ring.
+constexpr size_t kDefaultMinRingSize = 1024;
+constexpr size_t kDefaultMaxRingSize = 8 * 1024 * 1024;
+
+class ParsedRingHashConfig : public LoadBalancingPolicy::Config {
+ public:
+  ParsedRingHashConfig(grpc_core::UniquePtr<char> hash_header,
+                       size_t min_ring_size, size_t max_ring_size)
+      : hash_header_(std::move(hash_header)),
+        min_ring_size_(min_ring_size),
+        max_ring_size_(max_ring_size) {}
+
+  const char* name() const override { return kRingHash; }
+
+  // The lower-case name of the header holding the hash key, or null if
+  // calls carry no key.
+  const char* hash_header() const { return hash_header_.get(); }
+  size_t min_ring_size() const { return min_ring_size_; }
+  size_t max_ring_size() const { return max_ring_size_; }
+
+ private:
+  grpc_core::UniquePtr<char> hash_header_;
+  size_t min_ring_size_;
+  size_t max_ring_size_;
+};
+
+class RingHash : public LoadBalancingPolicy {
+ public:
+  explicit RingHash(Args args);
+
+  const char* name() const override { return kRingHash; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~RingHash();
+
+  // Forward declaration.
+  class RingHashSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  class RingHashSubchannelData
+      : public SubchannelData<RingHashSubchannelList, RingHashSubchannelData> {
+   public:
+    RingHashSubchannelData(
+        SubchannelList<RingHashSubchannelList, RingHashSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)) {
+      char* address_string = nullptr;
+      grpc_sockaddr_to_string(&address_string, &address.address(),
+                              false /* normalize */);
+      address_string_.reset(address_string);
+    }
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    const char* address_string() const { return address_string_.get(); }
+
+    bool seen_failure_since_ready() const { return seen_failure_since_ready_; }
+
+    // Performs connectivity state updates that need to be done both when we
+    // first start watching and when a watcher notification is received.
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    grpc_core::UniquePtr<char> address_string_;
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    bool seen_failure_since_ready_ = false;
+  };
+
+  // The points of the addresses of a subchannel list, sorted by hash.
+  // Immutable once built, so that pickers can share it.
+  class Ring : public RefCounted<Ring> {
+   public:
+    struct Entry {
+      uint32_t hash;
+      size_t subchannel_index;
+    };
+
+    Ring(RingHashSubchannelList* subchannel_list, size_t min_ring_size,
+         size_t max_ring_size);
+
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    // Returns the index of the first entry at or after hash, wrapping
+    // around the ring.
+    size_t FindEntry(uint32_t hash) const;
+
+   private:
+    std::vector<Entry> entries_;
+  };
+
+  // A list of subchannels.
+  class RingHashSubchannelList
+      : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
+   public:
+    RingHashSubchannelList(RingHash* policy, TraceFlag* tracer,
+                           const ServerAddressList& addresses,
+                           const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, addresses,
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+      ring_ = MakeRefCounted<Ring>(this, policy->config_->min_ring_size(),
+                                   policy->config_->max_ring_size());
+    }
+
+    ~RingHashSubchannelList() {
+      RingHash* p = static_cast<RingHash*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the RH policy's current subchannel
+    // list, updates the RH policy's connectivity state based on the
+    // subchannel list's state counters.
+    void MaybeUpdateRingHashConnectivityStateLocked();
+
+    // Updates the RH policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateRingHashStateFromSubchannelStateCountsLocked();
+
+    Ring* ring() const { return ring_.get(); }
+
+   private:
+    RefCountedPtr<Ring> ring_;
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(RingHash* parent, RingHashSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Returns the hash of the call's key.
+    uint32_t HashForCall(const PickArgs& args);
+
+    // Using pointer value only, no ref held -- do not dereference!
+    RingHash* parent_;
+
+    RefCountedPtr<ParsedRingHashConfig> config_;
+    RefCountedPtr<Ring> ring_;
+    // Indexed like the subchannel list; null for the subchannels that are
+    // not READY.
+    InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
+    // Advanced by every pick without a key, so that those picks spread
+    // over the ring.
+    Atomic<uint32_t> next_keyless_hash_;
+  };
+
+  void ShutdownLocked() override;
+
+  RefCountedPtr<ParsedRingHashConfig> config_;
+  /** list of subchannels */
+  OrphanablePtr<RingHashSubchannelList> subchannel_list_;
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  OrphanablePtr<RingHashSubchannelList> latest_pending_subchannel_list_;
+  /** are we shutting down? */
+  bool shutdown_ = false;
+};
+
+//
+// RingHash::Picker
+//
+
+RingHash::Picker::Picker(RingHash* parent,
+                         RingHashSubchannelList* subchannel_list)
+    : parent_(parent),
+      config_(parent->config_),
+      ring_(subchannel_list->ring()->Ref()),
+      next_keyless_hash_(static_cast<uint32_t>(rand())) {
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    RingHashSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back(sd->subchannel()->Ref());
+    } else {
+      subchannels_.emplace_back();
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO,
+            "[RH %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " subchannels and %" PRIuPTR " ring entries",
+            parent_, this, subchannel_list, subchannels_.size(),
+            ring_->entries().size());
+  }
+}
+
+uint32_t RingHash::Picker::HashForCall(const PickArgs& args) {
+  if (config_->hash_header() != nullptr) {
+    const StringView header(config_->hash_header());
+    for (const auto& entry : *args.initial_metadata) {
+      if (entry.first == header) {
+        return gpr_murmur_hash3(entry.second.data(), entry.second.size(), 0);
+      }
+    }
+  }
+  // Golden ratio increments visit the whole ring evenly.
+  return next_keyless_hash_.FetchAdd(0x9e3779b9, MemoryOrder::RELAXED);
+}
+
+RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
+  const uint32_t hash = HashForCall(args);
+  const std::vector<Ring::Entry>& entries = ring_->entries();
+  // Walk the ring from the key's point to the first READY subchannel.  The
+  // picker is only used while at least one subchannel is READY.
+  size_t entry_index = ring_->FindEntry(hash);
+  size_t index = entries[entry_index].subchannel_index;
+  for (size_t i = 1; i < entries.size() && subchannels_[index] == nullptr;
+       ++i) {
+    entry_index = (entry_index + 1) % entries.size();
+    index = entries[entry_index].subchannel_index;
+  }
+  GPR_ASSERT(subchannels_[index] != nullptr);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO,
+            "[RH %p picker %p] hash %" PRIu32 " maps to index %" PRIuPTR
+            ", subchannel=%p",
+            parent_, this, hash, index, subchannels_[index].get());
+  }
+  PickResult result;
+  result.type = PickResult::PICK_COMPLETE;
+  result.subchannel = subchannels_[index];
+  return result;
+}
+
+//
+// RingHash::Ring
+//
+
+RingHash::Ring::Ring(RingHashSubchannelList* subchannel_list,
+                     size_t min_ring_size, size_t max_ring_size) {
+  const size_t num_subchannels = subchannel_list->num_subchannels();
+  if (num_subchannels == 0) return;
+  // Give every address the same number of points, enough to reach
+  // min_ring_size in total but without going over max_ring_size.
+  size_t points_per_address =
+      (min_ring_size + num_subchannels - 1) / num_subchannels;
+  points_per_address =
+      GPR_MAX(1, GPR_MIN(points_per_address, max_ring_size / num_subchannels));
+  entries_.reserve(points_per_address * num_subchannels);
+  std::string key;
+  for (size_t i = 0; i < num_subchannels; ++i) {
+    // The points of an address are the hashes of "<address>_<n>".
+    key = subchannel_list->subchannel(i)->address_string();
+    key += '_';
+    const size_t prefix_length = key.size();
+    char count[GPR_LTOA_MIN_BUFSIZE];
+    for (size_t j = 0; j < points_per_address; ++j) {
+      gpr_ltoa(static_cast<long>(j), count);
+      key.resize(prefix_length);
+      key += count;
+      entries_.push_back({gpr_murmur_hash3(key.data(), key.size(), 0), i});
+    }
+  }
+  // Break ties by index, so that the ring does not depend on the sort.
+  std::sort(entries_.begin(), entries_.end(),
+            [](const Entry& a, const Entry& b) {
+              if (a.hash != b.hash) return a.hash < b.hash;
+              return a.subchannel_index < b.subchannel_index;
+            });
+}
+
+size_t RingHash::Ring::FindEntry(uint32_t hash) const {
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), hash,
+      [](const Entry& entry, uint32_t value) { return entry.hash < value; });
+  return it == entries_.end() ? 0 : it - entries_.begin();
+}
+
+//
+// RingHash
+//
+
+RingHash::RingHash(Args args) : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Created", this);
+  }
+}
+
+RingHash::~RingHash() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Destroying Ring Hash policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void RingHash::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void RingHash::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void RingHash::RingHashSubchannelList::StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateRingHashStateFromSubchannelStateCountsLocked();
+}
+
+void RingHash::RingHashSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the RH policy's connectivity state and generates a new picker based
+// on the current subchannel list.
+void RingHash::RingHashSubchannelList::
+    MaybeUpdateRingHashConnectivityStateLocked() {
+  RingHash* p = static_cast<RingHash*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  /* In priority order. The first rule to match terminates the search (ie, if we
+   * are on rule n, all previous rules were unfulfilled).
+   *
+   * 1) RULE: ANY subchannel is READY => policy is READY.
+   *    CHECK: subchannel_list->num_ready > 0.
+   *
+   * 2) RULE: ANY subchannel is CONNECTING => policy is CONNECTING.
+   *    CHECK: sd->curr_connectivity_state == CONNECTING.
+   *
+   * 3) RULE: ALL subchannels are TRANSIENT_FAILURE => policy is
+   *                                                   TRANSIENT_FAILURE.
+   *    CHECK: subchannel_list->num_transient_failures ==
+   *           subchannel_list->num_subchannels.
+   */
+  if (num_ready_ > 0) {
+    /* 1) READY */
+    p->channel_control_helper()->UpdateState(GRPC_CHANNEL_READY,
+                                             MakeUnique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    /* 2) CONNECTING */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING,
+        MakeUnique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    /* 3) TRANSIENT_FAILURE */
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                               "connections to all backends failing"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        MakeUnique<TransientFailurePicker>(error));
+  }
+}
+
+void RingHash::RingHashSubchannelList::
+    UpdateRingHashStateFromSubchannelStateCountsLocked() {
+  RingHash* p = static_cast<RingHash*>(policy());
+  if (num_ready_ > 0) {
+    if (p->subchannel_list_.get() != this) {
+      // Promote this list to p->subchannel_list_.
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[RH %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  // Update the RH policy's connectivity state if needed.
+  MaybeUpdateRingHashConnectivityStateLocked();
+}
+
+void RingHash::RingHashSubchannelData::UpdateConnectivityStateLocked(
+    grpc_connectivity_state connectivity_state) {
+  RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[RH %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(last_connectivity_state_),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If we haven't seen a failure since the last time we were in state
+  // READY, then we report the state change as-is.  However, once we do see
+  // a failure, we report TRANSIENT_FAILURE and do not report any subsequent
+  // state changes until we go back into state READY.
+  if (!seen_failure_since_ready_) {
+    if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      seen_failure_since_ready_ = true;
+    }
+    subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                                 connectivity_state);
+  } else {
+    if (connectivity_state == GRPC_CHANNEL_READY) {
+      seen_failure_since_ready_ = false;
+      subchannel_list()->UpdateStateCountersLocked(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, connectivity_state);
+    }
+  }
+  // Record last seen connectivity state.
+  last_connectivity_state_ = connectivity_state;
+}
+
+void RingHash::RingHashSubchannelData::ProcessConnectivityChangeLocked(
+    grpc_connectivity_state connectivity_state) {
+  RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve.
+  // Only do this if we've started watching, not at startup time.
+  // Otherwise, if the subchannel was already in state TRANSIENT_FAILURE
+  // when the subchannel list was created, we'd wind up in a constant
+  // loop of re-resolution.
+  // Also attempt to reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  // Update state counters.
+  UpdateConnectivityStateLocked(connectivity_state);
+  // Update overall state and renew notification.
+  subchannel_list()->UpdateRingHashStateFromSubchannelStateCountsLocked();
+}
+
+void RingHash::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] received update with %" PRIuPTR " addresses",
+            this, args.addresses.size());
+  }
+  // Replace latest_pending_subchannel_list_.
+  if (latest_pending_subchannel_list_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] Shutting down previous pending subchannel list %p", this,
+              latest_pending_subchannel_list_.get());
+    }
+  }
+  if (args.config != nullptr) {
+    config_ = std::move(args.config);
+  } else if (config_ == nullptr) {
+    config_ = MakeRefCounted<ParsedRingHashConfig>(
+        nullptr, kDefaultMinRingSize, kDefaultMaxRingSize);
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<RingHashSubchannelList>(
+      this, &grpc_lb_ring_hash_trace, args.addresses, *args.args);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        MakeUnique<TransientFailurePicker>(error));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+}
+
+//
+// factory
+//
+
+class RingHashFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<RingHash>(std::move(args));
+  }
+
+  const char* name() const override { return kRingHash; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const grpc_json* json, grpc_error** error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    const char* hash_header = nullptr;
+    size_t min_ring_size = kDefaultMinRingSize;
+    size_t max_ring_size = kDefaultMaxRingSize;
+    if (json == nullptr) {
+      return MakeRefCounted<ParsedRingHashConfig>(nullptr, min_ring_size,
+                                                  max_ring_size);
+    }
+    GPR_DEBUG_ASSERT(strcmp(json->key, name()) == 0);
+    InlinedVector<grpc_error*, 3> error_list;
+    for (const grpc_json* field = json->child; field != nullptr;
+         field = field->next) {
+      if (field->key == nullptr) continue;
+      if (strcmp(field->key, "hashHeader") == 0) {
+        if (hash_header != nullptr) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:hashHeader error:Duplicate entry"));
+        }
+        if (field->type != GRPC_JSON_STRING) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:hashHeader error:type should be string"));
+          continue;
+        }
+        hash_header = field->value;
+      } else if (strcmp(field->key, "minRingSize") == 0) {
+        if (field->type != GRPC_JSON_NUMBER) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:minRingSize error:type should be number"));
+          continue;
+        }
+        const int value = gpr_parse_nonnegative_int(field->value);
+        if (value <= 0) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:minRingSize error:should be a positive integer"));
+          continue;
+        }
+        min_ring_size = static_cast<size_t>(value);
+      } else if (strcmp(field->key, "maxRingSize") == 0) {
+        if (field->type != GRPC_JSON_NUMBER) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:maxRingSize error:type should be number"));
+          continue;
+        }
+        const int value = gpr_parse_nonnegative_int(field->value);
+        if (value <= 0 || static_cast<size_t>(value) > kDefaultMaxRingSize) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:maxRingSize error:should be a positive integer no "
+              "greater than 8388608"));
+          continue;
+        }
+        max_ring_size = static_cast<size_t>(value);
+      }
+    }
+    if (error_list.empty() && min_ring_size > max_ring_size) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:minRingSize error:greater than maxRingSize"));
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR("RingHash Parser", &error_list);
+      return nullptr;
+    }
+    // Metadata keys are lower case.
+    grpc_core::UniquePtr<char> header;
+    if (hash_header != nullptr) {
+      header.reset(gpr_strdup(hash_header));
+      for (char* c = header.get(); *c != '\0'; ++c) {
+        *c = static_cast<char>(tolower(*c));
+      }
+    }
+    return MakeRefCounted<ParsedRingHashConfig>(std::move(header),
+                                                min_ring_size, max_ring_size);
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_ring_hash_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          grpc_core::MakeUnique<grpc_core::RingHashFactory>());
+}
+
+void grpc_lb_policy_ring_hash_shutdown() {}
@@ -36,6 +36,7 @@
 #include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
@@ -159,7 +160,9 @@ class RoundRobin : public LoadBalancingPolicy {
     // Using pointer value only, no ref held -- do not dereference!
     RoundRobin* parent_;
 
-    size_t last_picked_index_;
+    // Advanced by every pick, so that concurrent picks rotate through the
+    // subchannels.  Taken modulo the number of subchannels.
+    Atomic<size_t> last_picked_index_;
     InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
   };
 
@@ -173,6 +176,10 @@ class RoundRobin : public LoadBalancingPolicy {
    * racing callbacks that reference outdated subchannel lists won't perform any
    * update. */
   OrphanablePtr<RoundRobinSubchannelList> latest_pending_subchannel_list_;
+  /** Addresses and args of the latest update, used to skip updates that
+   * would rebuild the same subchannel list. */
+  ServerAddressList latest_addresses_;
+  grpc_channel_args* latest_args_ = nullptr;
   /** are we shutting down? */
   bool shutdown_ = false;
 };
@@ -194,27 +201,37 @@ RoundRobin::Picker::Picker(RoundRobin* parent,
   // the picker, see https://github.com/grpc/grpc-go/issues/2580.
   // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
   // something better as part of https://github.com/grpc/grpc/issues/17891.
-  last_picked_index_ = rand() % subchannels_.size();
+  last_picked_index_.Store(rand() % subchannels_.size(),
+                           MemoryOrder::RELAXED);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] created picker from subchannel_list=%p "
             "with %" PRIuPTR " READY subchannels; last_picked_index_=%" PRIuPTR,
             parent_, this, subchannel_list, subchannels_.size(),
-            last_picked_index_);
+            last_picked_index_.Load(MemoryOrder::RELAXED));
   }
 }
 
 RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs /*args*/) {
-  last_picked_index_ = (last_picked_index_ + 1) % subchannels_.size();
+  // Skip the subchannels that would queue the call for lack of concurrent
+  // streams, unless they all would.
+  size_t index = (last_picked_index_.FetchAdd(1, MemoryOrder::RELAXED) + 1) %
+                 subchannels_.size();
+  for (size_t i = 0; i < subchannels_.size(); ++i) {
+    const size_t candidate = (index + i) % subchannels_.size();
+    if (!subchannels_[candidate]->IsSaturated()) {
+      index = candidate;
+      break;
+    }
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
-            parent_, this, last_picked_index_,
-            subchannels_[last_picked_index_].get());
+            parent_, this, index, subchannels_[index].get());
   }
   PickResult result;
   result.type = PickResult::PICK_COMPLETE;
-  result.subchannel = subchannels_[last_picked_index_];
+  result.subchannel = subchannels_[index];
   return result;
 }
 
@@ -234,6 +251,7 @@ RoundRobin::~RoundRobin() {
   }
   GPR_ASSERT(subchannel_list_ == nullptr);
   GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+  grpc_channel_args_destroy(latest_args_);
 }
 
 void RoundRobin::ShutdownLocked() {
@@ -435,6 +453,27 @@ void RoundRobin::UpdateLocked(UpdateArgs args) {
     gpr_log(GPR_INFO, "[RR %p] received update with %" PRIuPTR " addresses",
             this, args.addresses.size());
   }
+  // If nothing that goes into the subchannel list changed (e.g., grpclb
+  // got a serverlist that differs only in its drop entries), keep the
+  // current lists, so that the subchannels keep their connectivity state
+  // and watches.  The parent may still want a new picker, so report the
+  // current state again.
+  if (latest_args_ != nullptr && args.addresses == latest_addresses_ &&
+      grpc_channel_args_compare(args.args, latest_args_) == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
+      gpr_log(GPR_INFO, "[RR %p] update unchanged, keeping subchannel list %p",
+              this, subchannel_list_.get());
+    }
+    if (latest_pending_subchannel_list_ == nullptr &&
+        subchannel_list_ != nullptr &&
+        subchannel_list_->num_subchannels() > 0) {
+      subchannel_list_->MaybeUpdateRoundRobinConnectivityStateLocked();
+    }
+    return;
+  }
+  latest_addresses_ = args.addresses;
+  grpc_channel_args_destroy(latest_args_);
+  latest_args_ = grpc_channel_args_copy(args.args);
   // Replace latest_pending_subchannel_list_.
   if (latest_pending_subchannel_list_ != nullptr) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
@@ -0,0 +1,794 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Weighted Round Robin Policy.
+ *
+ * Like round_robin, but each READY subchannel is picked in proportion to a
+ * weight derived from the backend metrics (ORCA load reports) that the
+ * backend returns in the trailing metadata of each call: the requests per
+ * second it serves divided by its CPU utilization.  Backends that have not
+ * reported yet get the mean weight of those that have.
+ *
+ * Weights are collected by the calls as they finish and applied by a new
+ * picker every kWeightUpdatePeriod.  Picks use a stride scheduler, so that
+ * they do not need a lock. */
+
+#include <grpc/support/port_platform.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_weighted_round_robin_trace(false, "weighted_round_robin");
+
+namespace {
+
+//
+// weighted_round_robin LB policy
+//
+
+constexpr char kWeightedRoundRobin[] = "weighted_round_robin";
+
+// How often the weights reported by the backends are applied to the picker.
+constexpr grpc_millis kWeightUpdatePeriod = 1000;
+// How long a backend's weight is used after its last load report.
+constexpr grpc_millis kWeightExpirationPeriod = 3 * 60 * 1000;
+
+// Picks indexes with a frequency proportional to their weights, without a
+// lock.  Each weight is scaled to at most kMaxWeight.  A pick visits the
+// indexes in turn, as round robin does, and accepts the visited index on a
+// fraction weight / kMaxWeight of its turns; the offset spreads the accepted
+// turns of different indexes apart.
+class StrideScheduler {
+ public:
+  // Returns null if the weights do not need a scheduler, i.e. if fewer than
+  // two of them are known, or if they are all equal.
+  static std::unique_ptr<StrideScheduler> Make(
+      const InlinedVector<double, 10>& weights) {
+    size_t num_known = 0;
+    double sum = 0;
+    double max = 0;
+    for (size_t i = 0; i < weights.size(); ++i) {
+      const double weight = weights[i];
+      if (weight <= 0) continue;
+      ++num_known;
+      sum += weight;
+      max = GPR_MAX(max, weight);
+    }
+    if (num_known < 2) return nullptr;
+    // Backends with no weight yet get the mean weight.
+    const double mean = sum / num_known;
+    // Weights are clamped to a fraction of the largest one, which bounds
+    // the number of turns a pick may skip.
+    const double min = max * kMinWeightRatio;
+    std::unique_ptr<StrideScheduler> scheduler(new StrideScheduler());
+    bool all_equal = true;
+    for (size_t i = 0; i < weights.size(); ++i) {
+      double weight = weights[i] > 0 ? weights[i] : mean;
+      weight = GPR_CLAMP(weight, min, max);
+      const uint16_t scaled =
+          static_cast<uint16_t>(weight / max * kMaxWeight + 0.5);
+      if (!scheduler->weights_.empty() && scaled != scheduler->weights_[0]) {
+        all_equal = false;
+      }
+      scheduler->weights_.push_back(scaled);
+    }
+    if (all_equal) return nullptr;
+    return scheduler;
+  }
+
+  // Thread-safe.
+  size_t Pick() {
+    const uint64_t size = weights_.size();
+    while (true) {
+      const uint64_t sequence = sequence_.FetchAdd(1, MemoryOrder::RELAXED);
+      const uint64_t index = sequence % size;
+      const uint64_t generation = sequence / size;
+      const uint64_t weight = weights_[index];
+      const uint64_t position =
+          (weight * generation + index * kOffset) % kMaxWeight;
+      if (position >= kMaxWeight - weight) return static_cast<size_t>(index);
+    }
+  }
+
+  uint16_t weight(size_t index) const { return weights_[index]; }
+
+ private:
+  static constexpr uint16_t kMaxWeight = 0xFFFF;
+  static constexpr uint16_t kOffset = kMaxWeight / 2;
+  static constexpr double kMinWeightRatio = 0.1;
+
+  StrideScheduler() : sequence_(static_cast<uint64_t>(rand())) {}
+
+  InlinedVector<uint16_t, 10> weights_;
+  Atomic<uint64_t> sequence_;
+};
+
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~WeightedRoundRobin();
+
+  // Forward declaration.
+  class WeightedRoundRobinSubchannelList;
+
+  // The weight of a backend address, updated by the calls sent to it.  It
+  // is shared by the subchannels for the address in all subchannel lists,
+  // so that it survives address updates.
+  class AddressWeight : public RefCounted<AddressWeight> {
+   public:
+    AddressWeight(RefCountedPtr<WeightedRoundRobin> wrr, char* key)
+        : wrr_(std::move(wrr)), key_(key) {}
+    ~AddressWeight();
+
+    // Records a load report.  Thread-safe.
+    void MaybeUpdateWeight(double requests_per_second,
+                           double cpu_utilization);
+
+    // Returns the weight, or 0 if it is not known.  Thread-safe.
+    double GetWeight(grpc_millis now) const;
+
+    const char* key() const { return key_.get(); }
+
+   private:
+    RefCountedPtr<WeightedRoundRobin> wrr_;
+    grpc_core::UniquePtr<char> key_;
+    mutable Mutex mu_;
+    double weight_ = 0;
+    grpc_millis last_update_time_ = GRPC_MILLIS_INF_PAST;
+  };
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the weight of the subchannel's address.
+  class WeightedRoundRobinSubchannelData
+      : public SubchannelData<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelData(
+        SubchannelList<WeightedRoundRobinSubchannelList,
+                       WeightedRoundRobinSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel);
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    bool seen_failure_since_ready() const { return seen_failure_since_ready_; }
+
+    AddressWeight* weight() const { return weight_.get(); }
+
+    // Performs connectivity state updates that need to be done both when we
+    // first start watching and when a watcher notification is received.
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    bool seen_failure_since_ready_ = false;
+    RefCountedPtr<AddressWeight> weight_;
+  };
+
+  // A list of subchannels.
+  class WeightedRoundRobinSubchannelList
+      : public SubchannelList<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelList(WeightedRoundRobin* policy,
+                                     TraceFlag* tracer,
+                                     const ServerAddressList& addresses,
+                                     const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, addresses,
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~WeightedRoundRobinSubchannelList() {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the WRR policy's current subchannel
+    // list, updates the WRR policy's connectivity state based on the
+    // subchannel list's state counters.
+    void MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+
+    // Updates the WRR policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+
+    size_t num_ready() const { return num_ready_; }
+
+   private:
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent,
+           WeightedRoundRobinSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    // Returns the index of the next subchannel to try.
+    size_t NextIndex();
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    // Used to pick while the weights are unknown or all equal.
+    Atomic<size_t> last_picked_index_;
+    std::unique_ptr<StrideScheduler> scheduler_;
+    InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
+    InlinedVector<RefCountedPtr<AddressWeight>, 10> weights_;
+  };
+
+  // Returns the weight for the address, creating it if needed.
+  RefCountedPtr<AddressWeight> GetOrCreateAddressWeight(
+      const ServerAddress& address);
+
+  void StartWeightUpdateTimerLocked();
+  static void OnWeightUpdateTimer(void* arg, grpc_error* error);
+  static void OnWeightUpdateTimerLocked(void* arg, grpc_error* error);
+
+  void ShutdownLocked() override;
+
+  /** list of subchannels */
+  OrphanablePtr<WeightedRoundRobinSubchannelList> subchannel_list_;
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  OrphanablePtr<WeightedRoundRobinSubchannelList>
+      latest_pending_subchannel_list_;
+  /** are we shutting down? */
+  bool shutting_down_ = false;
+
+  // Timer for applying the latest weights.
+  bool weight_update_timer_pending_ = false;
+  grpc_timer weight_update_timer_;
+  grpc_closure on_weight_update_timer_;
+
+  // The weights of the addresses, which may be looked up and released
+  // outside of the combiner.  Weights are not owned by the map; they
+  // remove themselves when destroyed.
+  Mutex address_weights_mu_;
+  std::map<StringView, AddressWeight*, StringLess> address_weights_;
+};
+
+//
+// WeightedRoundRobin::AddressWeight
+//
+
+WeightedRoundRobin::AddressWeight::~AddressWeight() {
+  MutexLock lock(&wrr_->address_weights_mu_);
+  auto it = wrr_->address_weights_.find(StringView(key_.get()));
+  if (it != wrr_->address_weights_.end() && it->second == this) {
+    wrr_->address_weights_.erase(it);
+  }
+}
+
+void WeightedRoundRobin::AddressWeight::MaybeUpdateWeight(
+    double requests_per_second, double cpu_utilization) {
+  // Ignore reports that cannot tell how loaded the backend is.
+  if (requests_per_second <= 0 || cpu_utilization <= 0) return;
+  const double weight = requests_per_second / cpu_utilization;
+  const grpc_millis now = ExecCtx::Get()->Now();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p] address %s: qps=%f cpu_utilization=%f weight=%f",
+            wrr_.get(), key_.get(), requests_per_second, cpu_utilization,
+            weight);
+  }
+  MutexLock lock(&mu_);
+  weight_ = weight;
+  last_update_time_ = now;
+}
+
+double WeightedRoundRobin::AddressWeight::GetWeight(grpc_millis now) const {
+  MutexLock lock(&mu_);
+  if (now - last_update_time_ > kWeightExpirationPeriod) return 0;
+  return weight_;
+}
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(
+    WeightedRoundRobin* parent,
+    WeightedRoundRobinSubchannelList* subchannel_list)
+    : parent_(parent) {
+  const grpc_millis now = ExecCtx::Get()->Now();
+  InlinedVector<double, 10> weights;
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WeightedRoundRobinSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back(sd->subchannel()->Ref());
+      weights_.push_back(sd->weight()->Ref());
+      weights.push_back(sd->weight()->GetWeight(now));
+    }
+  }
+  scheduler_ = StrideScheduler::Make(weights);
+  // For discussion on why we generate a random starting index for
+  // the picker, see https://github.com/grpc/grpc-go/issues/2580.
+  last_picked_index_.Store(rand() % subchannels_.size(),
+                           MemoryOrder::RELAXED);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels, %s",
+            parent_, this, subchannel_list, subchannels_.size(),
+            scheduler_ == nullptr ? "unweighted" : "weighted");
+    for (size_t i = 0; scheduler_ != nullptr && i < subchannels_.size();
+         ++i) {
+      gpr_log(GPR_INFO,
+              "[WRR %p picker %p] subchannel %p (%s) has weight %f, "
+              "scaled to %d",
+              parent_, this, subchannels_[i].get(), weights_[i]->key(),
+              weights[i], scheduler_->weight(i));
+    }
+  }
+}
+
+size_t WeightedRoundRobin::Picker::NextIndex() {
+  if (scheduler_ != nullptr) return scheduler_->Pick();
+  return (last_picked_index_.FetchAdd(1, MemoryOrder::RELAXED) + 1) %
+         subchannels_.size();
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  // Skip the subchannels that would queue the call for lack of concurrent
+  // streams, unless they all would.
+  size_t index = NextIndex();
+  for (size_t i = 1; i < subchannels_.size(); ++i) {
+    if (!subchannels_[index]->IsSaturated()) break;
+    index = NextIndex();
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            parent_, this, index, subchannels_[index].get());
+  }
+  PickResult result;
+  result.type = PickResult::PICK_COMPLETE;
+  result.subchannel = subchannels_[index];
+  // Record the backend's load report when the call finishes.
+  AddressWeight* weight = weights_[index]->Ref().release();
+  result.recv_trailing_metadata_ready =
+      // Note: This callback does not run in either the control plane
+      // combiner or in the data plane.
+      [weight](grpc_error* /*error*/, MetadataInterface* /*metadata*/,
+               CallState* call_state) {
+        const BackendMetricData* backend_metric_data =
+            call_state->GetBackendMetricData();
+        if (backend_metric_data != nullptr) {
+          weight->MaybeUpdateWeight(
+              static_cast<double>(backend_metric_data->requests_per_second),
+              backend_metric_data->cpu_utilization);
+        }
+        weight->Unref();
+      };
+  return result;
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying Weighted Round Robin policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+  GPR_ASSERT(address_weights_.empty());
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutting_down_ = true;
+  if (weight_update_timer_pending_) {
+    grpc_timer_cancel(&weight_update_timer_);
+  }
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RefCountedPtr<WeightedRoundRobin::AddressWeight>
+WeightedRoundRobin::GetOrCreateAddressWeight(const ServerAddress& address) {
+  char* key = nullptr;
+  grpc_sockaddr_to_string(&key, &address.address(), false /* normalize */);
+  MutexLock lock(&address_weights_mu_);
+  auto it = address_weights_.find(StringView(key));
+  if (it != address_weights_.end() && it->second->RefIfNonZero()) {
+    gpr_free(key);
+    return RefCountedPtr<AddressWeight>(it->second);
+  }
+  // Either there is no weight for the address, or it is being destroyed,
+  // in which case its destructor will find that it was replaced.
+  if (it != address_weights_.end()) address_weights_.erase(it);
+  RefCountedPtr<AddressWeight> weight = MakeRefCounted<AddressWeight>(
+      Ref(DEBUG_LOCATION, "AddressWeight"), key);
+  address_weights_.emplace(StringView(weight->key()), weight.get());
+  return weight;
+}
+
+void WeightedRoundRobin::StartWeightUpdateTimerLocked() {
+  if (weight_update_timer_pending_ || shutting_down_) return;
+  // TODO(roth): We currently track this ref manually.  Once the
+  // ClosureRef API is ready, we should pass the RefCountedPtr<> along
+  // with the callback.
+  auto self = Ref(DEBUG_LOCATION, "on_weight_update_timer");
+  self.release();
+  GRPC_CLOSURE_INIT(&on_weight_update_timer_,
+                    &WeightedRoundRobin::OnWeightUpdateTimer, this,
+                    grpc_schedule_on_exec_ctx);
+  weight_update_timer_pending_ = true;
+  grpc_timer_init(&weight_update_timer_,
+                  ExecCtx::Get()->Now() + kWeightUpdatePeriod,
+                  &on_weight_update_timer_);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimer(void* arg, grpc_error* error) {
+  WeightedRoundRobin* wrr = static_cast<WeightedRoundRobin*>(arg);
+  wrr->combiner()->Run(
+      GRPC_CLOSURE_INIT(&wrr->on_weight_update_timer_,
+                        &WeightedRoundRobin::OnWeightUpdateTimerLocked, wrr,
+                        nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimerLocked(void* arg,
+                                                   grpc_error* error) {
+  WeightedRoundRobin* wrr = static_cast<WeightedRoundRobin*>(arg);
+  wrr->weight_update_timer_pending_ = false;
+  if (!wrr->shutting_down_ && error == GRPC_ERROR_NONE &&
+      wrr->subchannel_list_ != nullptr) {
+    // Hand the latest weights to a new picker.
+    wrr->subchannel_list_
+        ->MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+  }
+  wrr->Unref(DEBUG_LOCATION, "on_weight_update_timer");
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                              grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the WRR policy's connectivity state and generates a new picker based
+// on the current subchannel list.
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    MaybeUpdateWeightedRoundRobinConnectivityStateLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // The rules are the same as for round_robin.
+  if (num_ready_ > 0) {
+    /* 1) READY */
+    p->channel_control_helper()->UpdateState(GRPC_CHANNEL_READY,
+                                             MakeUnique<Picker>(p, this));
+    // Keep refreshing the weights while there are READY subchannels.
+    p->StartWeightUpdateTimerLocked();
+  } else if (num_connecting_ > 0) {
+    /* 2) CONNECTING */
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING,
+        MakeUnique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    /* 3) TRANSIENT_FAILURE */
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                               "connections to all backends failing"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        MakeUnique<TransientFailurePicker>(error));
+  }
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  if (num_ready_ > 0) {
+    if (p->subchannel_list_.get() != this) {
+      // Promote this list to p->subchannel_list_.
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[WRR %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  // Update the WRR policy's connectivity state if needed.
+  MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+}
+
+WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    WeightedRoundRobinSubchannelData(
+        SubchannelList<WeightedRoundRobinSubchannelList,
+                       WeightedRoundRobinSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+    : SubchannelData(subchannel_list, address, std::move(subchannel)),
+      weight_(static_cast<WeightedRoundRobin*>(subchannel_list->policy())
+                  ->GetOrCreateAddressWeight(address)) {}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    UpdateConnectivityStateLocked(grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(last_connectivity_state_),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If we haven't seen a failure since the last time we were in state
+  // READY, then we report the state change as-is.  However, once we do see
+  // a failure, we report TRANSIENT_FAILURE and do not report any subsequent
+  // state changes until we go back into state READY.
+  if (!seen_failure_since_ready_) {
+    if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      seen_failure_since_ready_ = true;
+    }
+    subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                                 connectivity_state);
+  } else {
+    if (connectivity_state == GRPC_CHANNEL_READY) {
+      seen_failure_since_ready_ = false;
+      subchannel_list()->UpdateStateCountersLocked(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, connectivity_state);
+    }
+  }
+  // Record last seen connectivity state.
+  last_connectivity_state_ = connectivity_state;
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve.
+  // Only do this if we've started watching, not at startup time.
+  // Otherwise, if the subchannel was already in state TRANSIENT_FAILURE
+  // when the subchannel list was created, we'd wind up in a constant
+  // loop of re-resolution.
+  // Also attempt to reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  // Update state counters.
+  UpdateConnectivityStateLocked(connectivity_state);
+  // Update overall state and renew notification.
+  subchannel_list()
+      ->UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+            this, args.addresses.size());
+  }
+  // Replace latest_pending_subchannel_list_.
+  if (latest_pending_subchannel_list_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Shutting down previous pending subchannel list %p",
+              this, latest_pending_subchannel_list_.get());
+    }
+  }
+  latest_pending_subchannel_list_ =
+      MakeOrphanable<WeightedRoundRobinSubchannelList>(
+          this, &grpc_lb_weighted_round_robin_trace, args.addresses,
+          *args.args);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE,
+        MakeUnique<TransientFailurePicker>(error));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+}
+
+class ParsedWeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  const char* name() const override { return kWeightedRoundRobin; }
+};
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const grpc_json* json, grpc_error** /*error*/) const override {
+    if (json != nullptr) {
+      GPR_DEBUG_ASSERT(strcmp(json->key, name()) == 0);
+    }
+    return RefCountedPtr<LoadBalancingPolicy::Config>(
+        new ParsedWeightedRoundRobinConfig());
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_weighted_round_robin_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          grpc_core::MakeUnique<grpc_core::WeightedRoundRobinFactory>());
+}
+
+void grpc_lb_policy_weighted_round_robin_shutdown() {}
@@ -44,6 +44,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/alias_table.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/memory.h"
@@ -149,25 +150,21 @@ class XdsLb : public LoadBalancingPolicy {
   class LocalityPicker : public SubchannelPicker {
    public:
     // Maintains a weighted list of pickers from each locality that is in ready
-    // state. The first element in the pair represents the end of a range
-    // proportional to the locality's weight. The start of the range is the
-    // previous value in the vector and is 0 for the first element.
+    // state. The first element in the pair is the locality's weight.
     using PickerList =
         InlinedVector<std::pair<uint32_t, RefCountedPtr<EndpointPickerWrapper>>,
                       1>;
-    LocalityPicker(RefCountedPtr<XdsLb> xds_policy, PickerList pickers)
-        : xds_policy_(std::move(xds_policy)),
-          pickers_(std::move(pickers)),
-          drop_config_(xds_policy_->drop_config_) {}
+    LocalityPicker(RefCountedPtr<XdsLb> xds_policy, PickerList pickers);
 
     PickResult Pick(PickArgs args) override;
 
    private:
-    // Calls the picker of the locality that the key falls within.
-    PickResult PickFromLocality(const uint32_t key, PickArgs args);
+    static InlinedVector<uint32_t, 1> Weights(const PickerList& pickers);
 
     RefCountedPtr<XdsLb> xds_policy_;
     PickerList pickers_;
+    // Picks the index of a locality in pickers_.
+    AliasTable alias_table_;
     RefCountedPtr<XdsDropConfig> drop_config_;
   };
 
@@ -474,17 +471,25 @@ LoadBalancingPolicy::PickResult XdsLb::EndpointPickerWrapper::Pick(
   }
   // Record a call started.
   locality_stats_->AddCallStarted();
-  // Intercept the recv_trailing_metadata op to record call completion.
+  // Intercept the recv_trailing_metadata op to record call completion,
+  // passing it on to the child policy if it wants it too.
   XdsClientStats::LocalityStats* locality_stats =
       locality_stats_->Ref(DEBUG_LOCATION, "LocalityStats+call").release();
+  std::function<void(grpc_error*, MetadataInterface*, CallState*)>
+      child_recv_trailing_metadata_ready =
+          std::move(result.recv_trailing_metadata_ready);
   result.recv_trailing_metadata_ready =
       // Note: This callback does not run in either the control plane
       // combiner or in the data plane mutex.
-      [locality_stats](grpc_error* error, MetadataInterface* /*metadata*/,
-                       CallState* /*call_state*/) {
+      [locality_stats, child_recv_trailing_metadata_ready](
+          grpc_error* error, MetadataInterface* metadata,
+          CallState* call_state) {
         const bool call_failed = error != GRPC_ERROR_NONE;
         locality_stats->AddCallFinished(call_failed);
         locality_stats->Unref(DEBUG_LOCATION, "LocalityStats+call");
+        if (child_recv_trailing_metadata_ready != nullptr) {
+          child_recv_trailing_metadata_ready(error, metadata, call_state);
+        }
       };
   return result;
 }
@@ -493,6 +498,22 @@ LoadBalancingPolicy::PickResult XdsLb::EndpointPickerWrapper::Pick(
 // XdsLb::LocalityPicker
 //
 
+XdsLb::LocalityPicker::LocalityPicker(RefCountedPtr<XdsLb> xds_policy,
+                                      PickerList pickers)
+    : xds_policy_(std::move(xds_policy)),
+      pickers_(std::move(pickers)),
+      alias_table_(Weights(pickers_)),
+      drop_config_(xds_policy_->drop_config_) {}
+
+InlinedVector<uint32_t, 1> XdsLb::LocalityPicker::Weights(
+    const PickerList& pickers) {
+  InlinedVector<uint32_t, 1> weights;
+  for (size_t i = 0; i < pickers.size(); ++i) {
+    weights.push_back(pickers[i].first);
+  }
+  return weights;
+}
+
 XdsLb::PickResult XdsLb::LocalityPicker::Pick(PickArgs args) {
   // Handle drop.
   const grpc_core::UniquePtr<char>* drop_category;
@@ -502,33 +523,8 @@ XdsLb::PickResult XdsLb::LocalityPicker::Pick(PickArgs args) {
     result.type = PickResult::PICK_COMPLETE;
     return result;
   }
-  // Generate a random number in [0, total weight).
-  const uint32_t key = rand() % pickers_[pickers_.size() - 1].first;
-  // Forward pick to whichever locality maps to the range in which the
-  // random number falls in.
-  return PickFromLocality(key, args);
-}
-
-XdsLb::PickResult XdsLb::LocalityPicker::PickFromLocality(const uint32_t key,
-                                                          PickArgs args) {
-  size_t mid = 0;
-  size_t start_index = 0;
-  size_t end_index = pickers_.size() - 1;
-  size_t index = 0;
-  while (end_index > start_index) {
-    mid = (start_index + end_index) / 2;
-    if (pickers_[mid].first > key) {
-      end_index = mid;
-    } else if (pickers_[mid].first < key) {
-      start_index = mid + 1;
-    } else {
-      index = mid + 1;
-      break;
-    }
-  }
-  if (index == 0) index = start_index;
-  GPR_ASSERT(pickers_[index].first > key);
-  return pickers_[index].second->Pick(args);
+  // Forward pick to a random locality, in proportion to its weight.
+  return pickers_[alias_table_.Pick()].second->Pick(args);
 }
 
 //
@@ -1228,15 +1224,14 @@ void XdsLb::PriorityList::LocalityMap::UpdateXdsPickerLocked() {
   // proportional to its weight, such that the total range is the sum of the
   // weights of all localities.
   LocalityPicker::PickerList picker_list;
-  uint32_t end = 0;
   for (const auto& p : localities_) {
     const auto& locality_name = p.first;
     const Locality* locality = p.second.get();
     // Skip the localities that are not in the latest locality map update.
     if (!locality_map_update()->Contains(locality_name)) continue;
     if (locality->connectivity_state() != GRPC_CHANNEL_READY) continue;
-    end += locality->weight();
-    picker_list.push_back(std::make_pair(end, locality->picker_wrapper()));
+    picker_list.push_back(
+        std::make_pair(locality->weight(), locality->picker_wrapper()));
   }
   xds_policy()->channel_control_helper()->UpdateState(
       GRPC_CHANNEL_READY, MakeUnique<LocalityPicker>(
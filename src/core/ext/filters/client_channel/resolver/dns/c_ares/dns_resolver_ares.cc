@@ -75,11 +75,14 @@ class AresDnsResolver : public Resolver {
 
   void MaybeStartResolvingLocked();
   void StartResolvingLocked();
+  void MaybeStartRefreshTimerLocked();
 
   static void OnNextResolution(void* arg, grpc_error* error);
   static void OnResolved(void* arg, grpc_error* error);
+  static void OnRefresh(void* arg, grpc_error* error);
   static void OnNextResolutionLocked(void* arg, grpc_error* error);
   static void OnResolvedLocked(void* arg, grpc_error* error);
+  static void OnRefreshLocked(void* arg, grpc_error* error);
 
   /// DNS server to use (if not system default)
   char* dns_server_;
@@ -94,6 +97,7 @@ class AresDnsResolver : public Resolver {
   /// closures used by the combiner
   grpc_closure on_next_resolution_;
   grpc_closure on_resolved_;
+  grpc_closure on_refresh_;
   /// are we currently resolving?
   bool resolving_ = false;
   /// the pending resolving request
@@ -117,6 +121,16 @@ class AresDnsResolver : public Resolver {
   int query_timeout_ms_;
   // whether or not to enable SRV DNS queries
   bool enable_srv_queries_;
+  // interval of background refreshes, 0 if disabled
+  grpc_millis refresh_interval_;
+  // background refresh timer
+  bool have_refresh_timer_ = false;
+  grpc_timer refresh_timer_;
+  // whether the resolution in progress is a background refresh
+  bool refreshing_ = false;
+  // last result returned to the channel, used to drop unchanged refreshes
+  ServerAddressList last_addresses_;
+  UniquePtr<char> last_service_config_;
 };
 
 AresDnsResolver::AresDnsResolver(ResolverArgs args)
@@ -150,6 +164,9 @@ AresDnsResolver::AresDnsResolver(ResolverArgs args)
   // Enable SRV queries option
   arg = grpc_channel_args_find(channel_args_, GRPC_ARG_DNS_ENABLE_SRV_QUERIES);
   enable_srv_queries_ = grpc_channel_arg_get_bool(arg, false);
+  // Background refresh option
+  arg = grpc_channel_args_find(channel_args_, GRPC_ARG_DNS_REFRESH_INTERVAL_MS);
+  refresh_interval_ = grpc_channel_arg_get_integer(arg, {0, 0, INT_MAX});
   interested_parties_ = grpc_pollset_set_create();
   if (args.pollset_set != nullptr) {
     grpc_pollset_set_add_pollset_set(interested_parties_, args.pollset_set);
@@ -177,6 +194,8 @@ void AresDnsResolver::StartLocked() {
 }
 
 void AresDnsResolver::RequestReresolutionLocked() {
+  // The channel wants to see the result, even if nothing changed.
+  refreshing_ = false;
   if (!resolving_) {
     MaybeStartResolvingLocked();
   }
@@ -194,6 +213,9 @@ void AresDnsResolver::ShutdownLocked() {
   if (have_next_resolution_timer_) {
     grpc_timer_cancel(&next_resolution_timer_);
   }
+  if (have_refresh_timer_) {
+    grpc_timer_cancel(&refresh_timer_);
+  }
   if (pending_request_ != nullptr) {
     grpc_cancel_ares_request_locked(pending_request_);
   }
@@ -223,6 +245,27 @@ void AresDnsResolver::OnNextResolutionLocked(void* arg, grpc_error* error) {
   r->Unref(DEBUG_LOCATION, "next_resolution_timer");
 }
 
+void AresDnsResolver::OnRefresh(void* arg, grpc_error* error) {
+  AresDnsResolver* r = static_cast<AresDnsResolver*>(arg);
+  r->combiner()->Run(
+      GRPC_CLOSURE_INIT(&r->on_refresh_, OnRefreshLocked, r, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+void AresDnsResolver::OnRefreshLocked(void* arg, grpc_error* error) {
+  AresDnsResolver* r = static_cast<AresDnsResolver*>(arg);
+  r->have_refresh_timer_ = false;
+  // A resolution in progress or pending retry re-arms the timer when done.
+  if (error == GRPC_ERROR_NONE && !r->shutdown_initiated_ && !r->resolving_ &&
+      !r->have_next_resolution_timer_) {
+    GRPC_CARES_TRACE_LOG("resolver:%p start resolving due to refresh timer",
+                         r);
+    r->refreshing_ = true;
+    r->MaybeStartResolvingLocked();
+  }
+  r->Unref(DEBUG_LOCATION, "refresh_timer");
+}
+
 bool ValueInJsonArray(grpc_json* array, const char* value) {
   for (grpc_json* entry = array->child; entry != nullptr; entry = entry->next) {
     if (entry->type == GRPC_JSON_STRING && strcmp(entry->value, value) == 0) {
@@ -340,28 +383,53 @@ void AresDnsResolver::OnResolvedLocked(void* arg, grpc_error* error) {
     r->Unref(DEBUG_LOCATION, "OnResolvedLocked() shutdown");
     return;
   }
+  const bool refreshing = r->refreshing_;
+  r->refreshing_ = false;
   if (r->addresses_ != nullptr) {
     Result result;
     result.addresses = std::move(*r->addresses_);
+    UniquePtr<char> service_config_string;
     if (r->service_config_json_ != nullptr) {
-      char* service_config_string = ChooseServiceConfig(
-          r->service_config_json_, &result.service_config_error);
+      service_config_string.reset(ChooseServiceConfig(
+          r->service_config_json_, &result.service_config_error));
       gpr_free(r->service_config_json_);
       if (result.service_config_error == GRPC_ERROR_NONE &&
           service_config_string != nullptr) {
         GRPC_CARES_TRACE_LOG("resolver:%p selected service config choice: %s",
-                             r, service_config_string);
+                             r, service_config_string.get());
         result.service_config = ServiceConfig::Create(
-            service_config_string, &result.service_config_error);
+            service_config_string.get(), &result.service_config_error);
       }
-      gpr_free(service_config_string);
     }
-    result.args = grpc_channel_args_copy(r->channel_args_);
-    r->result_handler()->ReturnResult(std::move(result));
+    // A refresh that found the same addresses and service config is not
+    // worth a new result: the channel would only redo the same work.
+    if (refreshing && result.service_config_error == GRPC_ERROR_NONE &&
+        result.addresses == r->last_addresses_ &&
+        (service_config_string == nullptr
+             ? r->last_service_config_ == nullptr
+             : r->last_service_config_ != nullptr &&
+                   strcmp(service_config_string.get(),
+                          r->last_service_config_.get()) == 0)) {
+      GRPC_CARES_TRACE_LOG("resolver:%p refresh found no changes", r);
+    } else {
+      if (r->refresh_interval_ > 0) {
+        r->last_addresses_ = result.addresses;
+        r->last_service_config_ = std::move(service_config_string);
+      }
+      result.args = grpc_channel_args_copy(r->channel_args_);
+      r->result_handler()->ReturnResult(std::move(result));
+    }
     r->addresses_.reset();
     // Reset backoff state so that we start from the beginning when the
     // next request gets triggered.
     r->backoff_.Reset();
+    r->MaybeStartRefreshTimerLocked();
+  } else if (refreshing) {
+    // The channel still has the last result, which is as good as it was
+    // before the refresh. Try again at the next refresh.
+    GRPC_CARES_TRACE_LOG("resolver:%p dns refresh failed: %s", r,
+                         grpc_error_string(error));
+    r->MaybeStartRefreshTimerLocked();
   } else {
     GRPC_CARES_TRACE_LOG("resolver:%p dns resolution failed: %s", r,
                          grpc_error_string(error));
@@ -426,6 +494,18 @@ void AresDnsResolver::MaybeStartResolvingLocked() {
   StartResolvingLocked();
 }
 
+void AresDnsResolver::MaybeStartRefreshTimerLocked() {
+  if (refresh_interval_ == 0 || have_refresh_timer_) return;
+  have_refresh_timer_ = true;
+  // TODO(roth): We currently deal with this ref manually.  Once the
+  // new closure API is done, find a way to track this ref with the timer
+  // callback as part of the type system.
+  Ref(DEBUG_LOCATION, "refresh_timer").release();
+  GRPC_CLOSURE_INIT(&on_refresh_, OnRefresh, this, grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&refresh_timer_, ExecCtx::Get()->Now() + refresh_interval_,
+                  &on_refresh_);
+}
+
 void AresDnsResolver::StartResolvingLocked() {
   // TODO(roth): We currently deal with this ref manually.  Once the
   // new closure API is done, find a way to track this ref with the timer
@@ -507,6 +587,7 @@ void grpc_resolver_dns_ares_init() {
       GRPC_LOG_IF_ERROR("grpc_ares_init() failed", error);
       return;
     }
+    grpc_ares_cache_init();
     if (default_resolver == nullptr) {
       default_resolver = grpc_resolve_address_impl;
     }
@@ -520,6 +601,7 @@ void grpc_resolver_dns_ares_init() {
 
 void grpc_resolver_dns_ares_shutdown() {
   if (g_use_ares_dns_resolver) {
+    grpc_ares_cache_shutdown();
     address_sorting_shutdown();
     grpc_ares_cleanup();
   }
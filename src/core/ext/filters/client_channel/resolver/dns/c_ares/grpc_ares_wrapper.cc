@@ -26,6 +26,11 @@
 #include <string.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <ares.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -36,7 +41,9 @@
 #include "src/core/ext/filters/client_channel/parse_address.h"
 #include "src/core/ext/filters/client_channel/resolver/dns/c_ares/grpc_ares_ev_driver.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/executor.h"
@@ -52,6 +59,16 @@ grpc_core::TraceFlag grpc_trace_cares_address_sorting(false,
 
 grpc_core::TraceFlag grpc_trace_cares_resolver(false, "cares_resolver");
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_dns_cache_ttl_ms, 0,
+    "Declares for how long in ms the results of c-ares lookups are shared "
+    "by all channels resolving the same name. Failed lookups are shared for "
+    "at most 5 seconds. Concurrent lookups of the same name are always "
+    "shared. Set to 0 to only share concurrent lookups.");
+
+/* The longest that a failed lookup is shared for */
+#define GRPC_ARES_MAX_NEGATIVE_CACHE_TTL_MS 5000
+
 struct grpc_ares_request {
   /** indicates the DNS server to use, if specified */
   struct ares_addr_port_node dns_server_addr;
@@ -69,6 +86,25 @@ struct grpc_ares_request {
 
   /** the errors explaining query failures, appended to in query callbacks */
   grpc_error* error;
+
+  /** following members are set when the request is shared through the
+      lookup cache */
+  /** the key of the lookup in the cache, or null if it isn't shared */
+  char* cache_key;
+  /** whether this request runs the lookup that the others wait on */
+  bool is_leader;
+  /** set when the owner of the request cancels it */
+  bool cancelled;
+  /** the arguments of the lookup, to rerun it if the leader is cancelled */
+  char* dns_server;
+  char* name;
+  char* default_port;
+  grpc_pollset_set* interested_parties;
+  bool check_grpclb;
+  int query_timeout_ms;
+  grpc_core::Combiner* combiner;
+  /** reruns the lookup, under combiner */
+  grpc_closure on_restart_locked;
 };
 
 typedef struct grpc_ares_hostbyname_request {
@@ -136,6 +172,8 @@ static void grpc_ares_request_unref_locked(grpc_ares_request* r) {
   }
 }
 
+static void grpc_ares_cache_finish_lookup_locked(grpc_ares_request* r);
+
 void grpc_ares_complete_request_locked(grpc_ares_request* r) {
   /* Invoke on_done callback and destroy the
      request */
@@ -148,6 +186,7 @@ void grpc_ares_complete_request_locked(grpc_ares_request* r) {
     // TODO(apolcyn): allow c-ares to return a service config
     // with no addresses along side it
   }
+  if (r->cache_key != nullptr) grpc_ares_cache_finish_lookup_locked(r);
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, r->on_done, r->error);
 }
 
@@ -447,9 +486,202 @@ void grpc_dns_lookup_ares_continue_after_check_localhost_and_ip_literals_locked(
   return;
 
 error_cleanup:
+  r->error = error;
+  grpc_ares_complete_request_locked(r);
+}
+
+/*
+ * The lookup cache, which shares lookups among all the requests for the same
+ * name. While a lookup is in flight, the requests that arrive wait on it
+ * instead of querying again; once it is done, its results are served until
+ * they expire.
+ */
+
+namespace {
+
+struct CachedLookup {
+  ~CachedLookup() { GRPC_ERROR_UNREF(error); }
+
+  /** the request running the lookup, or null once it is done */
+  grpc_ares_request* leader = nullptr;
+  /** the requests waiting on the leader */
+  std::vector<grpc_ares_request*> followers;
+  /** following members are set once the lookup is done */
+  grpc_millis expiration = 0;
+  std::unique_ptr<ServerAddressList> addresses;
+  grpc_core::UniquePtr<char> service_config_json;
+  grpc_error* error = GRPC_ERROR_NONE;
+};
+
+gpr_once g_cache_mu_once = GPR_ONCE_INIT;
+gpr_mu g_cache_mu;
+std::map<std::string, CachedLookup>* g_cache;  // guarded by g_cache_mu
+grpc_millis g_cache_ttl_ms;
+
+void init_cache_mu() { gpr_mu_init(&g_cache_mu); }
+
+}  // namespace
+
+void grpc_ares_cache_init() {
+  gpr_once_init(&g_cache_mu_once, init_cache_mu);
+  grpc_core::MutexLock lock(&g_cache_mu);
+  GPR_ASSERT(g_cache == nullptr);
+  g_cache = new std::map<std::string, CachedLookup>();
+  g_cache_ttl_ms = GPR_MAX(0, GPR_GLOBAL_CONFIG_GET(grpc_dns_cache_ttl_ms));
+}
+
+void grpc_ares_cache_shutdown() {
+  grpc_core::MutexLock lock(&g_cache_mu);
+  delete g_cache;
+  g_cache = nullptr;
+}
+
+static void grpc_ares_cache_release_request(grpc_ares_request* r) {
+  gpr_free(r->cache_key);
+  r->cache_key = nullptr;
+  gpr_free(r->dns_server);
+  r->dns_server = nullptr;
+  gpr_free(r->name);
+  r->name = nullptr;
+  gpr_free(r->default_port);
+  r->default_port = nullptr;
+}
+
+/* Hands the results of a shared lookup to \a r and completes it. */
+static void grpc_ares_cache_complete_request(
+    grpc_ares_request* r, const ServerAddressList* addresses,
+    const char* service_config_json, grpc_error* error) {
+  if (addresses != nullptr) {
+    *r->addresses_out = grpc_core::MakeUnique<ServerAddressList>(*addresses);
+    error = GRPC_ERROR_NONE;
+  } else {
+    error = GRPC_ERROR_REF(error);
+  }
+  if (service_config_json != nullptr && r->service_config_json_out != nullptr) {
+    *r->service_config_json_out = gpr_strdup(service_config_json);
+  }
+  grpc_ares_cache_release_request(r);
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, r->on_done, error);
 }
 
+/* Looks \a r up in the cache. Returns false if \a r becomes the leader and
+   has to run the lookup, and true if it is served by the cache or waits on
+   the leader. */
+static bool grpc_ares_cache_start_lookup_locked(grpc_ares_request* r) {
+  grpc_core::MutexLock lock(&g_cache_mu);
+  if (g_cache == nullptr) return false;
+  auto it = g_cache->find(r->cache_key);
+  if (it != g_cache->end()) {
+    CachedLookup& lookup = it->second;
+    if (lookup.leader != nullptr) {
+      GRPC_CARES_TRACE_LOG("request:%p waiting on request:%p for %s", r,
+                           lookup.leader, r->cache_key);
+      lookup.followers.push_back(r);
+      return true;
+    }
+    if (lookup.expiration > grpc_core::ExecCtx::Get()->Now()) {
+      GRPC_CARES_TRACE_LOG("request:%p served from cache for %s", r,
+                           r->cache_key);
+      grpc_ares_cache_complete_request(r, lookup.addresses.get(),
+                                       lookup.service_config_json.get(),
+                                       lookup.error);
+      return true;
+    }
+    g_cache->erase(it);
+  }
+  r->is_leader = true;
+  (*g_cache)[r->cache_key].leader = r;
+  return false;
+}
+
+static void grpc_ares_cache_start_request_locked(grpc_ares_request* r);
+
+static void on_restart_locked(void* arg, grpc_error* /*error*/) {
+  grpc_ares_request* r = static_cast<grpc_ares_request*>(arg);
+  if (r->cancelled) {
+    grpc_ares_cache_release_request(r);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, r->on_done, GRPC_ERROR_CANCELLED);
+    return;
+  }
+  grpc_ares_cache_start_request_locked(r);
+}
+
+/* Shares the results of the leader \a r with the requests waiting on it, and
+   keeps them in the cache. If \a r was cancelled, the waiting requests rerun
+   the lookup instead. */
+static void grpc_ares_cache_finish_lookup_locked(grpc_ares_request* r) {
+  if (!r->is_leader) return;
+  std::vector<grpc_ares_request*> followers;
+  const ServerAddressList* addresses = r->addresses_out->get();
+  const char* service_config_json = r->service_config_json_out != nullptr
+                                        ? *r->service_config_json_out
+                                        : nullptr;
+  {
+    grpc_core::MutexLock lock(&g_cache_mu);
+    if (g_cache != nullptr) {
+      auto it = g_cache->find(r->cache_key);
+      GPR_ASSERT(it != g_cache->end());
+      CachedLookup& lookup = it->second;
+      followers.swap(lookup.followers);
+      const grpc_millis ttl =
+          addresses != nullptr
+              ? g_cache_ttl_ms
+              : GPR_MIN(g_cache_ttl_ms, GRPC_ARES_MAX_NEGATIVE_CACHE_TTL_MS);
+      if (r->cancelled || ttl == 0) {
+        g_cache->erase(it);
+      } else {
+        lookup.leader = nullptr;
+        lookup.expiration = grpc_core::ExecCtx::Get()->Now() + ttl;
+        if (addresses != nullptr) {
+          lookup.addresses =
+              grpc_core::MakeUnique<ServerAddressList>(*addresses);
+        }
+        if (service_config_json != nullptr) {
+          lookup.service_config_json.reset(gpr_strdup(service_config_json));
+        }
+        lookup.error = GRPC_ERROR_REF(r->error);
+      }
+    }
+  }
+  for (grpc_ares_request* follower : followers) {
+    if (r->cancelled) {
+      follower->combiner->Run(
+          GRPC_CLOSURE_INIT(&follower->on_restart_locked, on_restart_locked,
+                            follower, nullptr),
+          GRPC_ERROR_NONE);
+    } else {
+      grpc_ares_cache_complete_request(follower, addresses,
+                                       service_config_json, r->error);
+    }
+  }
+  grpc_ares_cache_release_request(r);
+  r->is_leader = false;
+}
+
+/* Completes the cancelled request \a r if it is waiting on a leader. */
+static void grpc_ares_cache_cancel_request_locked(grpc_ares_request* r) {
+  {
+    grpc_core::MutexLock lock(&g_cache_mu);
+    if (g_cache == nullptr) return;
+    auto it = g_cache->find(r->cache_key);
+    if (it == g_cache->end()) return;
+    std::vector<grpc_ares_request*>& followers = it->second.followers;
+    auto follower = std::find(followers.begin(), followers.end(), r);
+    // Else a rerun of the lookup is pending, which completes r instead.
+    if (follower == followers.end()) return;
+    followers.erase(follower);
+  }
+  grpc_ares_cache_release_request(r);
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, r->on_done, GRPC_ERROR_CANCELLED);
+}
+
+static void grpc_ares_cache_start_request_locked(grpc_ares_request* r) {
+  if (grpc_ares_cache_start_lookup_locked(r)) return;
+  grpc_dns_lookup_ares_continue_after_check_localhost_and_ip_literals_locked(
+      r, r->dns_server, r->name, r->default_port, r->interested_parties,
+      r->check_grpclb, r->query_timeout_ms, r->combiner);
+}
+
 static bool inner_resolve_as_ip_literal_locked(
     const char* name, const char* default_port,
     std::unique_ptr<grpc_core::ServerAddressList>* addrs,
@@ -621,10 +853,20 @@ static grpc_ares_request* grpc_dns_lookup_ares_locked_impl(
     check_grpclb = false;
     r->service_config_json_out = nullptr;
   }
-  // Look up name using c-ares lib.
-  grpc_dns_lookup_ares_continue_after_check_localhost_and_ip_literals_locked(
-      r, dns_server, name, default_port, interested_parties, check_grpclb,
-      query_timeout_ms, combiner);
+  // Look up name using c-ares lib, sharing the lookup with other requests
+  // for the same name.
+  gpr_asprintf(&r->cache_key, "%s|%s|%s|%d|%d",
+               dns_server != nullptr ? dns_server : "", name,
+               default_port != nullptr ? default_port : "", check_grpclb,
+               r->service_config_json_out != nullptr);
+  r->dns_server = gpr_strdup(dns_server);
+  r->name = gpr_strdup(name);
+  r->default_port = gpr_strdup(default_port);
+  r->interested_parties = interested_parties;
+  r->check_grpclb = check_grpclb;
+  r->query_timeout_ms = query_timeout_ms;
+  r->combiner = combiner;
+  grpc_ares_cache_start_request_locked(r);
   return r;
 }
 
@@ -637,8 +879,11 @@ grpc_ares_request* (*grpc_dns_lookup_ares_locked)(
 
 static void grpc_cancel_ares_request_locked_impl(grpc_ares_request* r) {
   GPR_ASSERT(r != nullptr);
+  r->cancelled = true;
   if (r->ev_driver != nullptr) {
     grpc_ares_ev_driver_shutdown_locked(r->ev_driver);
+  } else if (r->cache_key != nullptr && !r->is_leader) {
+    grpc_ares_cache_cancel_request_locked(r);
   }
 }
 
@@ -748,7 +993,7 @@ static void grpc_resolve_address_ares_impl(const char* name,
                                            grpc_resolved_addresses** addrs) {
   grpc_resolve_address_ares_request* r =
       new grpc_resolve_address_ares_request();
-  r->combiner = grpc_combiner_create();
+  r->combiner = grpc_combiner_create("ares_resolver");
   r->addrs_out = addrs;
   r->on_resolve_address_done = on_done;
   r->name = name;
@@ -79,6 +79,13 @@ grpc_error* grpc_ares_init(void);
    it has been called the same number of times as grpc_ares_init(). */
 void grpc_ares_cleanup(void);
 
+/* Initializes the cache of lookups shared by all c-ares requests. Must be
+   called before grpc_dns_lookup_ares_locked() for lookups to be shared. */
+void grpc_ares_cache_init(void);
+
+/* Drops the lookups kept in the cache. */
+void grpc_ares_cache_shutdown(void);
+
 /** Schedules the desired callback for request completion
  * and destroys the grpc_ares_request */
 void grpc_ares_complete_request_locked(grpc_ares_request* request);
@@ -65,11 +65,14 @@ class NativeDnsResolver : public Resolver {
 
   void MaybeStartResolvingLocked();
   void StartResolvingLocked();
+  void MaybeStartRefreshTimerLocked();
 
   static void OnNextResolution(void* arg, grpc_error* error);
   static void OnNextResolutionLocked(void* arg, grpc_error* error);
   static void OnResolved(void* arg, grpc_error* error);
   static void OnResolvedLocked(void* arg, grpc_error* error);
+  static void OnRefresh(void* arg, grpc_error* error);
+  static void OnRefreshLocked(void* arg, grpc_error* error);
 
   /// name to resolve
   char* name_to_resolve_ = nullptr;
@@ -94,6 +97,16 @@ class NativeDnsResolver : public Resolver {
   BackOff backoff_;
   /// currently resolving addresses
   grpc_resolved_addresses* addresses_ = nullptr;
+  /// interval of background refreshes, 0 if disabled
+  grpc_millis refresh_interval_;
+  /// background refresh timer
+  bool have_refresh_timer_ = false;
+  grpc_timer refresh_timer_;
+  grpc_closure on_refresh_;
+  /// is the resolution in progress a background refresh?
+  bool refreshing_ = false;
+  /// last addresses returned to the channel
+  ServerAddressList last_addresses_;
 };
 
 NativeDnsResolver::NativeDnsResolver(ResolverArgs args)
@@ -113,6 +126,8 @@ NativeDnsResolver::NativeDnsResolver(ResolverArgs args)
       args.args, GRPC_ARG_DNS_MIN_TIME_BETWEEN_RESOLUTIONS_MS);
   min_time_between_resolutions_ =
       grpc_channel_arg_get_integer(arg, {1000 * 30, 0, INT_MAX});
+  arg = grpc_channel_args_find(args.args, GRPC_ARG_DNS_REFRESH_INTERVAL_MS);
+  refresh_interval_ = grpc_channel_arg_get_integer(arg, {0, 0, INT_MAX});
   interested_parties_ = grpc_pollset_set_create();
   if (args.pollset_set != nullptr) {
     grpc_pollset_set_add_pollset_set(interested_parties_, args.pollset_set);
@@ -128,6 +143,8 @@ NativeDnsResolver::~NativeDnsResolver() {
 void NativeDnsResolver::StartLocked() { MaybeStartResolvingLocked(); }
 
 void NativeDnsResolver::RequestReresolutionLocked() {
+  // The channel wants to see the result, even if nothing changed.
+  refreshing_ = false;
   if (!resolving_) {
     MaybeStartResolvingLocked();
   }
@@ -145,6 +162,9 @@ void NativeDnsResolver::ShutdownLocked() {
   if (have_next_resolution_timer_) {
     grpc_timer_cancel(&next_resolution_timer_);
   }
+  if (have_refresh_timer_) {
+    grpc_timer_cancel(&refresh_timer_);
+  }
 }
 
 void NativeDnsResolver::OnNextResolution(void* arg, grpc_error* error) {
@@ -164,6 +184,26 @@ void NativeDnsResolver::OnNextResolutionLocked(void* arg, grpc_error* error) {
   r->Unref(DEBUG_LOCATION, "retry-timer");
 }
 
+void NativeDnsResolver::OnRefresh(void* arg, grpc_error* error) {
+  NativeDnsResolver* r = static_cast<NativeDnsResolver*>(arg);
+  r->combiner()->Run(
+      GRPC_CLOSURE_INIT(&r->on_refresh_, NativeDnsResolver::OnRefreshLocked, r,
+                        nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+void NativeDnsResolver::OnRefreshLocked(void* arg, grpc_error* error) {
+  NativeDnsResolver* r = static_cast<NativeDnsResolver*>(arg);
+  r->have_refresh_timer_ = false;
+  // A resolution in progress or pending retry re-arms the timer when done.
+  if (error == GRPC_ERROR_NONE && !r->shutdown_ && !r->resolving_ &&
+      !r->have_next_resolution_timer_) {
+    r->refreshing_ = true;
+    r->MaybeStartResolvingLocked();
+  }
+  r->Unref(DEBUG_LOCATION, "refresh_timer");
+}
+
 void NativeDnsResolver::OnResolved(void* arg, grpc_error* error) {
   NativeDnsResolver* r = static_cast<NativeDnsResolver*>(arg);
   r->combiner()->Run(
@@ -180,6 +220,8 @@ void NativeDnsResolver::OnResolvedLocked(void* arg, grpc_error* error) {
     r->Unref(DEBUG_LOCATION, "dns-resolving");
     return;
   }
+  const bool refreshing = r->refreshing_;
+  r->refreshing_ = false;
   if (r->addresses_ != nullptr) {
     Result result;
     for (size_t i = 0; i < r->addresses_->naddrs; ++i) {
@@ -188,11 +230,22 @@ void NativeDnsResolver::OnResolvedLocked(void* arg, grpc_error* error) {
                                     nullptr /* args */);
     }
     grpc_resolved_addresses_destroy(r->addresses_);
-    result.args = grpc_channel_args_copy(r->channel_args_);
-    r->result_handler()->ReturnResult(std::move(result));
+    // Don't make the channel redo its work for a refresh that changed nothing.
+    if (refreshing && result.addresses == r->last_addresses_) {
+      gpr_log(GPR_DEBUG, "dns refresh found no changes");
+    } else {
+      if (r->refresh_interval_ > 0) r->last_addresses_ = result.addresses;
+      result.args = grpc_channel_args_copy(r->channel_args_);
+      r->result_handler()->ReturnResult(std::move(result));
+    }
     // Reset backoff state so that we start from the beginning when the
     // next request gets triggered.
     r->backoff_.Reset();
+    r->MaybeStartRefreshTimerLocked();
+  } else if (refreshing) {
+    // The channel keeps the last result. Try again at the next refresh.
+    gpr_log(GPR_INFO, "dns refresh failed: %s", grpc_error_string(error));
+    r->MaybeStartRefreshTimerLocked();
   } else {
     gpr_log(GPR_INFO, "dns resolution failed (will retry): %s",
             grpc_error_string(error));
@@ -257,6 +310,19 @@ void NativeDnsResolver::MaybeStartResolvingLocked() {
   StartResolvingLocked();
 }
 
+void NativeDnsResolver::MaybeStartRefreshTimerLocked() {
+  if (refresh_interval_ == 0 || have_refresh_timer_) return;
+  have_refresh_timer_ = true;
+  // TODO(roth): We currently deal with this ref manually.  Once the
+  // new closure API is done, find a way to track this ref with the timer
+  // callback as part of the type system.
+  Ref(DEBUG_LOCATION, "refresh_timer").release();
+  GRPC_CLOSURE_INIT(&on_refresh_, NativeDnsResolver::OnRefresh, this,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&refresh_timer_, ExecCtx::Get()->Now() + refresh_interval_,
+                  &on_refresh_);
+}
+
 void NativeDnsResolver::StartResolvingLocked() {
   gpr_log(GPR_DEBUG, "Start resolving.");
   // TODO(roth): We currently deal with this ref manually.  Once the
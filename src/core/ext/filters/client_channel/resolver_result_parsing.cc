@@ -222,6 +222,96 @@ std::unique_ptr<ClientChannelMethodParsedConfig::RetryPolicy> ParseRetryPolicy(
   return *error == GRPC_ERROR_NONE ? std::move(retry_policy) : nullptr;
 }
 
+std::unique_ptr<ClientChannelMethodParsedConfig::RetryPolicy>
+ParseHedgingPolicy(grpc_json* field, grpc_error** error) {
+  GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  auto hedging_policy =
+      MakeUnique<ClientChannelMethodParsedConfig::RetryPolicy>();
+  hedging_policy->hedging = true;
+  if (field->type != GRPC_JSON_OBJECT) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:hedgingPolicy error:should be of type object");
+    return nullptr;
+  }
+  InlinedVector<grpc_error*, 4> error_list;
+  bool seen_hedging_delay = false;
+  bool seen_non_fatal_status_codes = false;
+  for (grpc_json* sub_field = field->child; sub_field != nullptr;
+       sub_field = sub_field->next) {
+    if (sub_field->key == nullptr) continue;
+    if (strcmp(sub_field->key, "maxAttempts") == 0) {
+      if (hedging_policy->max_attempts != 0) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:maxAttempts error:Duplicate entry"));
+      }  // Duplicate. Continue Parsing
+      if (sub_field->type != GRPC_JSON_NUMBER) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:maxAttempts error:should be of type number"));
+        continue;
+      }
+      hedging_policy->max_attempts =
+          gpr_parse_nonnegative_int(sub_field->value);
+      if (hedging_policy->max_attempts <= 1) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:maxAttempts error:should be at least 2"));
+        continue;
+      }
+      if (hedging_policy->max_attempts > MAX_MAX_RETRY_ATTEMPTS) {
+        gpr_log(GPR_ERROR,
+                "service config: clamped hedgingPolicy.maxAttempts at %d",
+                MAX_MAX_RETRY_ATTEMPTS);
+        hedging_policy->max_attempts = MAX_MAX_RETRY_ATTEMPTS;
+      }
+    } else if (strcmp(sub_field->key, "hedgingDelay") == 0) {
+      if (seen_hedging_delay) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:hedgingDelay error:Duplicate entry"));
+      }  // Duplicate, continue parsing.
+      seen_hedging_delay = true;
+      if (!ParseDuration(sub_field, &hedging_policy->hedging_delay)) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:hedgingDelay error:Failed to parse"));
+      }
+    } else if (strcmp(sub_field->key, "nonFatalStatusCodes") == 0) {
+      if (seen_non_fatal_status_codes) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:nonFatalStatusCodes error:Duplicate entry"));
+      }  // Duplicate, continue parsing.
+      seen_non_fatal_status_codes = true;
+      if (sub_field->type != GRPC_JSON_ARRAY) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:nonFatalStatusCodes error:should be of type array"));
+        continue;
+      }
+      for (grpc_json* element = sub_field->child; element != nullptr;
+           element = element->next) {
+        if (element->type != GRPC_JSON_STRING) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:nonFatalStatusCodes error:status codes should be of type "
+              "string"));
+          continue;
+        }
+        grpc_status_code status;
+        if (!grpc_status_code_from_string(element->value, &status)) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:nonFatalStatusCodes error:failed to parse status code"));
+          continue;
+        }
+        hedging_policy->retryable_status_codes.Add(status);
+      }
+    }
+  }
+  // Make sure required fields are set.  Unlike for retryPolicy, both
+  // hedgingDelay and nonFatalStatusCodes are optional.
+  if (error_list.empty() && hedging_policy->max_attempts == 0) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:hedgingPolicy error:Missing required field(s)");
+    return nullptr;
+  }
+  *error = GRPC_ERROR_CREATE_FROM_VECTOR("hedgingPolicy", &error_list);
+  return *error == GRPC_ERROR_NONE ? std::move(hedging_policy) : nullptr;
+}
+
 const char* ParseHealthCheckConfig(const grpc_json* field, grpc_error** error) {
   GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
   const char* service_name = nullptr;
@@ -452,7 +542,10 @@ ClientChannelServiceConfigParser::ParsePerMethodParams(const grpc_json* json,
   InlinedVector<grpc_error*, 4> error_list;
   Optional<bool> wait_for_ready;
   grpc_millis timeout = 0;
+  // Holds either the retryPolicy or the hedgingPolicy.
   std::unique_ptr<ClientChannelMethodParsedConfig::RetryPolicy> retry_policy;
+  bool seen_retry_policy = false;
+  bool seen_hedging_policy = false;
   for (grpc_json* field = json->child; field != nullptr; field = field->next) {
     if (field->key == nullptr) continue;
     if (strcmp(field->key, "waitForReady") == 0) {
@@ -478,15 +571,35 @@ ClientChannelServiceConfigParser::ParsePerMethodParams(const grpc_json* json,
             "field:timeout error:Failed parsing"));
       };
     } else if (strcmp(field->key, "retryPolicy") == 0) {
-      if (retry_policy != nullptr) {
+      if (seen_retry_policy) {
         error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             "field:retryPolicy error:Duplicate entry"));
       }  // Duplicate, continue parsing.
+      if (seen_hedging_policy) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:retryPolicy error:Cannot be combined with hedgingPolicy"));
+      }
+      seen_retry_policy = true;
       grpc_error* error = GRPC_ERROR_NONE;
       retry_policy = ParseRetryPolicy(field, &error);
       if (retry_policy == nullptr) {
         error_list.push_back(error);
       }
+    } else if (strcmp(field->key, "hedgingPolicy") == 0) {
+      if (seen_hedging_policy) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:hedgingPolicy error:Duplicate entry"));
+      }  // Duplicate, continue parsing.
+      if (seen_retry_policy) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:hedgingPolicy error:Cannot be combined with retryPolicy"));
+      }
+      seen_hedging_policy = true;
+      grpc_error* error = GRPC_ERROR_NONE;
+      retry_policy = ParseHedgingPolicy(field, &error);
+      if (retry_policy == nullptr) {
+        error_list.push_back(error);
+      }
     }
   }
   *error = GRPC_ERROR_CREATE_FROM_VECTOR("Client channel parser", &error_list);
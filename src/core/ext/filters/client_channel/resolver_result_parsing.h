@@ -85,6 +85,12 @@ class ClientChannelMethodParsedConfig : public ServiceConfig::ParsedConfig {
     grpc_millis max_backoff = 0;
     float backoff_multiplier = 0;
     StatusCodeSet retryable_status_codes;
+    // Set when parsed from a hedgingPolicy.  Attempts are then started
+    // hedging_delay after the previous one if it has not yet received a
+    // response, and immediately on a status in retryable_status_codes (the
+    // policy's nonFatalStatusCodes).  The backoff fields are unused.
+    bool hedging = false;
+    grpc_millis hedging_delay = 0;
   };
 
   ClientChannelMethodParsedConfig(grpc_millis timeout,
@@ -84,7 +84,7 @@ class ResolvingLoadBalancingPolicy::ResolverResultHandler
   }
 
   void ReturnResult(Resolver::Result result) override {
-    parent_->OnResolverResultChangedLocked(std::move(result));
+    parent_->OnResolverResultLocked(std::move(result));
   }
 
   void ReturnError(grpc_error* error) override {
@@ -186,6 +186,8 @@ ResolvingLoadBalancingPolicy::ResolvingLoadBalancingPolicy(
       process_resolver_result_(process_resolver_result),
       process_resolver_result_user_data_(process_resolver_result_user_data) {
   GPR_ASSERT(process_resolver_result != nullptr);
+  result_debounce_interval_ = grpc_channel_args_find_integer(
+      args.args, GRPC_ARG_RESOLVER_RESULT_DEBOUNCE_MS, {0, 0, INT_MAX});
   resolver_ = ResolverRegistry::CreateResolver(
       target_uri_.get(), args.args, interested_parties(), combiner(),
       MakeUnique<ResolverResultHandler>(Ref()));
@@ -208,6 +210,7 @@ ResolvingLoadBalancingPolicy::~ResolvingLoadBalancingPolicy() {
 void ResolvingLoadBalancingPolicy::ShutdownLocked() {
   if (resolver_ != nullptr) {
     resolver_.reset();
+    if (have_debounce_timer_) grpc_timer_cancel(&debounce_timer_);
     if (lb_policy_ != nullptr) {
       if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
         gpr_log(GPR_INFO, "resolving_lb=%p: shutting down lb_policy=%p", this,
@@ -432,10 +435,105 @@ void ResolvingLoadBalancingPolicy::ConcatenateAndAddChannelTraceLocked(
   }
 }
 
-void ResolvingLoadBalancingPolicy::OnResolverResultChangedLocked(
+namespace {
+
+// Returns true if the two results would lead to the same update of the
+// child policy.  Results carrying a service config error never match.
+bool ResolverResultsEqual(const Resolver::Result& a,
+                          const Resolver::Result& b) {
+  if (a.service_config_error != GRPC_ERROR_NONE ||
+      b.service_config_error != GRPC_ERROR_NONE) {
+    return false;
+  }
+  if (a.service_config != b.service_config) {
+    if (a.service_config == nullptr || b.service_config == nullptr ||
+        strcmp(a.service_config->service_config_json(),
+               b.service_config->service_config_json()) != 0) {
+      return false;
+    }
+  }
+  return a.addresses == b.addresses &&
+         grpc_channel_args_compare(a.args, b.args) == 0;
+}
+
+}  // namespace
+
+void ResolvingLoadBalancingPolicy::OnResolverResultLocked(
     Resolver::Result result) {
   // Handle race conditions.
   if (resolver_ == nullptr) return;
+  // Drop results that do not change anything for the child policy.  This
+  // also supersedes any result still waiting for the debounce timer.
+  if (lb_policy_ != nullptr && have_last_result_ &&
+      ResolverResultsEqual(result, last_result_)) {
+    if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+      gpr_log(GPR_INFO, "resolving_lb=%p: ignoring unchanged resolver result",
+              this);
+    }
+    have_pending_result_ = false;
+    pending_result_ = Resolver::Result();
+    return;
+  }
+  if (result_debounce_interval_ > 0 && have_last_result_) {
+    const grpc_millis next_result_time =
+        last_result_time_ + result_debounce_interval_;
+    if (have_debounce_timer_ || ExecCtx::Get()->Now() < next_result_time) {
+      if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
+        gpr_log(GPR_INFO,
+                "resolving_lb=%p: holding resolver result until %" PRId64,
+                this, next_result_time);
+      }
+      pending_result_ = std::move(result);
+      have_pending_result_ = true;
+      if (!have_debounce_timer_) {
+        // TODO(roth): We currently deal with this ref manually.  Once the
+        // new closure API is done, find a way to track this ref with the timer
+        // callback as part of the type system.
+        Ref(DEBUG_LOCATION, "debounce_timer").release();
+        GRPC_CLOSURE_INIT(&on_debounce_timer_, OnDebounceTimer, this,
+                          grpc_schedule_on_exec_ctx);
+        have_debounce_timer_ = true;
+        grpc_timer_init(&debounce_timer_, next_result_time,
+                        &on_debounce_timer_);
+      }
+      return;
+    }
+  }
+  DeliverResolverResultLocked(std::move(result));
+}
+
+void ResolvingLoadBalancingPolicy::DeliverResolverResultLocked(
+    Resolver::Result result) {
+  last_result_time_ = ExecCtx::Get()->Now();
+  last_result_ = result;
+  have_last_result_ = true;
+  OnResolverResultChangedLocked(std::move(result));
+}
+
+void ResolvingLoadBalancingPolicy::OnDebounceTimer(void* arg,
+                                                   grpc_error* error) {
+  ResolvingLoadBalancingPolicy* self =
+      static_cast<ResolvingLoadBalancingPolicy*>(arg);
+  self->combiner()->Run(GRPC_CLOSURE_INIT(&self->on_debounce_timer_,
+                                          OnDebounceTimerLocked, self, nullptr),
+                        GRPC_ERROR_REF(error));
+}
+
+void ResolvingLoadBalancingPolicy::OnDebounceTimerLocked(void* arg,
+                                                         grpc_error* error) {
+  ResolvingLoadBalancingPolicy* self =
+      static_cast<ResolvingLoadBalancingPolicy*>(arg);
+  self->have_debounce_timer_ = false;
+  if (error == GRPC_ERROR_NONE && self->resolver_ != nullptr &&
+      self->have_pending_result_) {
+    self->have_pending_result_ = false;
+    self->DeliverResolverResultLocked(std::move(self->pending_result_));
+  }
+  self->Unref(DEBUG_LOCATION, "debounce_timer");
+}
+
+void ResolvingLoadBalancingPolicy::OnResolverResultChangedLocked(
+    Resolver::Result result) {
   if (GRPC_TRACE_FLAG_ENABLED(*tracer_)) {
     gpr_log(GPR_INFO, "resolving_lb=%p: got resolver result", this);
   }
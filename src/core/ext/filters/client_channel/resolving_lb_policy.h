@@ -33,6 +33,7 @@
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/metadata_batch.h"
 
@@ -102,7 +103,11 @@ class ResolvingLoadBalancingPolicy : public LoadBalancingPolicy {
       bool resolution_contains_addresses, TraceStringVector* trace_strings);
   void ConcatenateAndAddChannelTraceLocked(
       TraceStringVector* trace_strings) const;
+  void OnResolverResultLocked(Resolver::Result result);
+  void DeliverResolverResultLocked(Resolver::Result result);
   void OnResolverResultChangedLocked(Resolver::Result result);
+  static void OnDebounceTimer(void* arg, grpc_error* error);
+  static void OnDebounceTimerLocked(void* arg, grpc_error* error);
 
   // Passed in from caller at construction time.
   TraceFlag* tracer_;
@@ -116,6 +121,18 @@ class ResolvingLoadBalancingPolicy : public LoadBalancingPolicy {
   OrphanablePtr<Resolver> resolver_;
   bool previous_resolution_contained_addresses_ = false;
 
+  // Debouncing of resolver results.  The last result delivered to the child
+  // policy is kept so that identical results can be dropped.
+  grpc_millis result_debounce_interval_ = 0;
+  grpc_millis last_result_time_ = 0;
+  bool have_last_result_ = false;
+  Resolver::Result last_result_;
+  bool have_pending_result_ = false;
+  Resolver::Result pending_result_;
+  bool have_debounce_timer_ = false;
+  grpc_timer debounce_timer_;
+  grpc_closure on_debounce_timer_;
+
   // Child LB policy.
   OrphanablePtr<LoadBalancingPolicy> lb_policy_;
   OrphanablePtr<LoadBalancingPolicy> pending_lb_policy_;
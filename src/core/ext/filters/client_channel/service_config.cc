@@ -20,12 +20,16 @@
 
 #include <string.h>
 
+#include <map>
+
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/slice/slice_hash_table.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -38,10 +42,25 @@ typedef InlinedVector<std::unique_ptr<ServiceConfig::Parser>,
                       ServiceConfig::kNumPreallocatedParsers>
     ServiceConfigParserList;
 ServiceConfigParserList* g_registered_parsers;
+
+// Service configs that parsed without error, by their json, so that channels
+// given the same config share one. Configs remove themselves when destroyed.
+typedef std::map<StringView, ServiceConfig*, StringLess> ServiceConfigCache;
+Mutex* g_cache_mu;
+ServiceConfigCache* g_cache;
 }  // namespace
 
 RefCountedPtr<ServiceConfig> ServiceConfig::Create(const char* json,
                                                    grpc_error** error) {
+  {
+    MutexLock lock(g_cache_mu);
+    auto it = g_cache->find(StringView(json));
+    // The config may be on its way out, waiting for the lock to remove
+    // itself.
+    if (it != g_cache->end() && it->second->RefIfNonZero()) {
+      return RefCountedPtr<ServiceConfig>(it->second);
+    }
+  }
   grpc_core::UniquePtr<char> service_config_json(gpr_strdup(json));
   grpc_core::UniquePtr<char> json_string(gpr_strdup(json));
   GPR_DEBUG_ASSERT(error != nullptr);
@@ -51,8 +70,19 @@ RefCountedPtr<ServiceConfig> ServiceConfig::Create(const char* json,
         "failed to parse JSON for service config");
     return nullptr;
   }
-  return MakeRefCounted<ServiceConfig>(
+  RefCountedPtr<ServiceConfig> service_config = MakeRefCounted<ServiceConfig>(
       std::move(service_config_json), std::move(json_string), json_tree, error);
+  if (*error == GRPC_ERROR_NONE) {
+    MutexLock lock(g_cache_mu);
+    // Replaces any config of the same json that is being destroyed, or that
+    // another thread parsed meanwhile. The key points into the json of the
+    // config it maps to, so it is replaced too.
+    g_cache->erase(StringView(json));
+    g_cache->emplace(StringView(service_config->service_config_json()),
+                     service_config.get());
+    service_config->cached_ = true;
+  }
+  return service_config;
 }
 
 ServiceConfig::ServiceConfig(grpc_core::UniquePtr<char> service_config_json,
@@ -213,7 +243,14 @@ grpc_error* ServiceConfig::ParsePerMethodParams(const grpc_json* json_tree) {
   return GRPC_ERROR_CREATE_FROM_VECTOR("Method Params", &error_list);
 }
 
-ServiceConfig::~ServiceConfig() { grpc_json_destroy(json_tree_); }
+ServiceConfig::~ServiceConfig() {
+  if (cached_ && g_cache_mu != nullptr) {
+    MutexLock lock(g_cache_mu);
+    auto it = g_cache->find(StringView(service_config_json_.get()));
+    if (it != g_cache->end() && it->second == this) g_cache->erase(it);
+  }
+  grpc_json_destroy(json_tree_);
+}
 
 int ServiceConfig::CountNamesInMethodConfig(grpc_json* json) {
   int num_names = 0;
@@ -320,11 +357,17 @@ size_t ServiceConfig::RegisterParser(std::unique_ptr<Parser> parser) {
 void ServiceConfig::Init() {
   GPR_ASSERT(g_registered_parsers == nullptr);
   g_registered_parsers = new ServiceConfigParserList();
+  g_cache_mu = new Mutex();
+  g_cache = new ServiceConfigCache();
 }
 
 void ServiceConfig::Shutdown() {
   delete g_registered_parsers;
   g_registered_parsers = nullptr;
+  delete g_cache;
+  g_cache = nullptr;
+  delete g_cache_mu;
+  g_cache_mu = nullptr;
 }
 
 }  // namespace grpc_core
@@ -124,7 +124,9 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
   };
 
   /// Creates a new service config from parsing \a json_string.
-  /// Returns null on parse error.
+  /// Returns null on parse error. Service configs are immutable: as long as
+  /// one parsed from the same json without error exists, it is returned
+  /// rather than parsing the json again.
   static RefCountedPtr<ServiceConfig> Create(const char* json,
                                              grpc_error** error);
 
@@ -181,6 +183,8 @@ class ServiceConfig : public RefCounted<ServiceConfig> {
   grpc_core::UniquePtr<char> service_config_json_;
   grpc_core::UniquePtr<char> json_string_;  // Underlying storage for json_tree.
   grpc_json* json_tree_;
+  // Whether Create() added the config to the cache of parsed configs.
+  bool cached_ = false;
 
   InlinedVector<std::unique_ptr<ParsedConfig>, kNumPreallocatedParsers>
       parsed_global_configs_;
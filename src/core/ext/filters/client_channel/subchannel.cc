@@ -30,6 +30,7 @@
 #include <grpc/support/string_util.h>
 
 #include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
 #include "src/core/ext/filters/client_channel/health/health_check_client.h"
 #include "src/core/ext/filters/client_channel/parse_address.h"
 #include "src/core/ext/filters/client_channel/proxy_mapper_registry.h"
@@ -65,6 +66,10 @@
 #define GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS 120
 #define GRPC_SUBCHANNEL_RECONNECT_JITTER 0.2
 
+// Extra connections parameters.
+#define GRPC_SUBCHANNEL_DEFAULT_CALLS_PER_CONNECTION 100
+#define GRPC_SUBCHANNEL_EXTRA_CONNECTION_IDLE_SECONDS 10
+
 // Conversion between subchannel call and call stack.
 #define SUBCHANNEL_CALL_TO_CALL_STACK(call) \
   (grpc_call_stack*)((char*)(call) +        \
@@ -88,11 +93,20 @@ ConnectedSubchannel::ConnectedSubchannel(
     : RefCounted<ConnectedSubchannel>(&grpc_trace_subchannel_refcount),
       channel_stack_(channel_stack),
       args_(grpc_channel_args_copy(args)),
-      channelz_subchannel_(std::move(channelz_subchannel)) {}
+      channelz_subchannel_(std::move(channelz_subchannel)),
+      stream_headroom_(MakeRefCounted<StreamHeadroom>()) {
+  grpc_transport_op* op = grpc_make_transport_op(nullptr);
+  op->watch_stream_headroom = stream_headroom_;
+  grpc_channel_element* elem = grpc_channel_stack_element(channel_stack_, 0);
+  elem->filter->start_transport_op(elem, op);
+}
 
 ConnectedSubchannel::~ConnectedSubchannel() {
   grpc_channel_args_destroy(args_);
   GRPC_CHANNEL_STACK_UNREF(channel_stack_, "connected_subchannel_dtor");
+  if (subchannel_ != nullptr) {
+    GRPC_SUBCHANNEL_WEAK_UNREF(subchannel_, "connection_pool");
+  }
 }
 
 void ConnectedSubchannel::StartWatch(
@@ -130,23 +144,163 @@ size_t ConnectedSubchannel::GetInitialCallSizeEstimate(
   return allocation_size;
 }
 
+void ConnectedSubchannel::EnableConnectionPool(Subchannel* subchannel,
+                                               size_t max_connections,
+                                               size_t calls_per_connection) {
+  subchannel_ = GRPC_SUBCHANNEL_WEAK_REF(subchannel, "connection_pool");
+  max_connections_ = max_connections;
+  calls_per_connection_ = calls_per_connection;
+  track_calls_ = true;
+  GRPC_CLOSURE_INIT(&request_extra_connection_, RequestExtraConnection, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+bool ConnectedSubchannel::IsSaturated() {
+  if (!stream_headroom_->saturated()) return false;
+  if (!has_connection_pool()) return true;
+  MutexLock lock(&pool_mu_);
+  for (size_t i = 0; i < extra_connections_.size(); i++) {
+    if (!extra_connections_[i]->stream_headroom_->saturated()) return false;
+  }
+  return true;
+}
+
+RefCountedPtr<ConnectedSubchannel> ConnectedSubchannel::PickConnection(
+    bool* extra_connection_pending) {
+  GPR_DEBUG_ASSERT(has_connection_pool());
+  RefCountedPtr<ConnectedSubchannel> picked;
+  bool request_extra_connection = false;
+  {
+    MutexLock lock(&pool_mu_);
+    // Connections whose transport would queue the call come last.
+    ConnectedSubchannel* least_loaded = this;
+    bool least_saturated = stream_headroom_->saturated();
+    size_t least_calls = calls_in_flight_.Load(MemoryOrder::RELAXED);
+    for (size_t i = 0; i < extra_connections_.size(); i++) {
+      ConnectedSubchannel* connection = extra_connections_[i].get();
+      const bool saturated = connection->stream_headroom_->saturated();
+      const size_t calls =
+          connection->calls_in_flight_.Load(MemoryOrder::RELAXED);
+      if (saturated < least_saturated ||
+          (saturated == least_saturated && calls < least_calls)) {
+        least_loaded = connection;
+        least_saturated = saturated;
+        least_calls = calls;
+      }
+    }
+    picked = least_loaded->Ref();
+    if ((least_saturated || least_calls >= calls_per_connection_) &&
+        extra_connections_.size() + 1 < max_connections_ &&
+        !extra_connection_requested_) {
+      extra_connection_requested_ = true;
+      request_extra_connection = true;
+    }
+    *extra_connection_pending = extra_connection_requested_;
+  }
+  if (request_extra_connection) {
+    // Not inline: calls may get created with the subchannel's mutex held.
+    Ref().release();
+    ExecCtx::Run(DEBUG_LOCATION, &request_extra_connection_, GRPC_ERROR_NONE);
+  }
+  return picked;
+}
+
+void ConnectedSubchannel::RequestExtraConnection(void* arg,
+                                                 grpc_error* /*error*/) {
+  ConnectedSubchannel* self = static_cast<ConnectedSubchannel*>(arg);
+  {
+    MutexLock lock(&self->subchannel_->mu_);
+    self->subchannel_->StartExtraConnectionLocked(self);
+  }
+  self->Unref();
+}
+
+void ConnectedSubchannel::ExtraConnectionRequestDone() {
+  MutexLock lock(&pool_mu_);
+  extra_connection_requested_ = false;
+}
+
+void ConnectedSubchannel::AddExtraConnection(
+    RefCountedPtr<ConnectedSubchannel> connection) {
+  MutexLock lock(&pool_mu_);
+  extra_connections_.push_back(std::move(connection));
+}
+
+void ConnectedSubchannel::RemoveExtraConnection(
+    ConnectedSubchannel* connection) {
+  MutexLock lock(&pool_mu_);
+  for (size_t i = 0; i < extra_connections_.size(); i++) {
+    if (extra_connections_[i].get() == connection) {
+      if (i + 1 != extra_connections_.size()) {
+        extra_connections_[i] = std::move(
+            extra_connections_[extra_connections_.size() - 1]);
+      }
+      extra_connections_.pop_back();
+      return;
+    }
+  }
+}
+
+size_t ConnectedSubchannel::RemoveIdleExtraConnections() {
+  MutexLock lock(&pool_mu_);
+  size_t i = 0;
+  while (i < extra_connections_.size()) {
+    ConnectedSubchannel* connection = extra_connections_[i].get();
+    const size_t calls_started =
+        connection->calls_started_.Load(MemoryOrder::RELAXED);
+    if (connection->calls_in_flight_.Load(MemoryOrder::RELAXED) == 0 &&
+        calls_started == connection->calls_started_at_idle_check_) {
+      gpr_log(GPR_INFO, "Closing idle extra connection %p of %p", connection,
+              this);
+      if (i + 1 != extra_connections_.size()) {
+        extra_connections_[i] = std::move(
+            extra_connections_[extra_connections_.size() - 1]);
+      }
+      extra_connections_.pop_back();
+    } else {
+      connection->calls_started_at_idle_check_ = calls_started;
+      i++;
+    }
+  }
+  return extra_connections_.size();
+}
+
+void ConnectedSubchannel::RemoveAllExtraConnections() {
+  MutexLock lock(&pool_mu_);
+  extra_connections_.clear();
+}
+
 //
 // SubchannelCall
 //
 
 RefCountedPtr<SubchannelCall> SubchannelCall::Create(Args args,
                                                      grpc_error** error) {
+  Subchannel* subchannel = nullptr;
+  bool extra_connection_pending = false;
+  if (args.connected_subchannel->has_connection_pool()) {
+    subchannel = args.connected_subchannel->subchannel_;
+    args.connected_subchannel =
+        args.connected_subchannel->PickConnection(&extra_connection_pending);
+  }
+  grpc_polling_entity* pollent = args.pollent;
   const size_t allocation_size =
       args.connected_subchannel->GetInitialCallSizeEstimate(
           args.parent_data_size);
   Arena* arena = args.arena;
-  return RefCountedPtr<SubchannelCall>(new (
-      arena->Alloc(allocation_size)) SubchannelCall(std::move(args), error));
+  SubchannelCall* call = new (arena->Alloc(allocation_size))
+      SubchannelCall(std::move(args), error);
+  if (extra_connection_pending) call->PollExtraConnection(subchannel, pollent);
+  return RefCountedPtr<SubchannelCall>(call);
 }
 
 SubchannelCall::SubchannelCall(Args args, grpc_error** error)
     : connected_subchannel_(std::move(args.connected_subchannel)),
       deadline_(args.deadline) {
+  if (connected_subchannel_->track_calls_) {
+    connected_subchannel_->calls_in_flight_.FetchAdd(1, MemoryOrder::RELAXED);
+    connected_subchannel_->calls_started_.FetchAdd(1, MemoryOrder::RELAXED);
+  }
   grpc_call_stack* callstk = SUBCHANNEL_CALL_TO_CALL_STACK(this);
   const grpc_call_element_args call_args = {
       callstk,           /* call_stack */
@@ -168,7 +322,7 @@ SubchannelCall::SubchannelCall(Args args, grpc_error** error)
   grpc_call_stack_set_pollset_or_pollset_set(callstk, args.pollent);
   auto* channelz_node = connected_subchannel_->channelz_subchannel();
   if (channelz_node != nullptr) {
-    channelz_node->RecordCallStarted();
+    channelz_sampled_ = channelz_node->RecordCallStarted();
   }
 }
 
@@ -225,6 +379,14 @@ void SubchannelCall::Destroy(void* arg, grpc_error* /*error*/) {
   grpc_closure* after_call_stack_destroy = self->after_call_stack_destroy_;
   RefCountedPtr<ConnectedSubchannel> connected_subchannel =
       std::move(self->connected_subchannel_);
+  if (connected_subchannel->track_calls_) {
+    connected_subchannel->calls_in_flight_.FetchSub(1, MemoryOrder::RELAXED);
+  }
+  Subchannel* polled_subchannel = self->polled_subchannel_;
+  if (polled_subchannel != nullptr) {
+    grpc_polling_entity_del_from_pollset_set(&self->pollent_,
+                                             polled_subchannel->pollset_set_);
+  }
   // Destroy the subchannel call.
   self->~SubchannelCall();
   // Destroy the call stack. This should be after destroying the subchannel
@@ -232,19 +394,30 @@ void SubchannelCall::Destroy(void* arg, grpc_error* /*error*/) {
   // call arena.
   grpc_call_stack_destroy(SUBCHANNEL_CALL_TO_CALL_STACK(self), nullptr,
                           after_call_stack_destroy);
+  if (polled_subchannel != nullptr) {
+    GRPC_SUBCHANNEL_WEAK_UNREF(polled_subchannel, "extra_connection_poller");
+  }
   // Automatically reset connected_subchannel. This should be after destroying
   // the call stack, because destroying call stack needs access to the channel
   // stack.
 }
 
+void SubchannelCall::PollExtraConnection(Subchannel* subchannel,
+                                         grpc_polling_entity* pollent) {
+  polled_subchannel_ =
+      GRPC_SUBCHANNEL_WEAK_REF(subchannel, "extra_connection_poller");
+  pollent_ = *pollent;
+  grpc_polling_entity_add_to_pollset_set(&pollent_, subchannel->pollset_set_);
+}
+
 void SubchannelCall::MaybeInterceptRecvTrailingMetadata(
     grpc_transport_stream_op_batch* batch) {
   // only intercept payloads with recv trailing.
   if (!batch->recv_trailing_metadata) {
     return;
   }
-  // only add interceptor is channelz is enabled.
-  if (connected_subchannel_->channelz_subchannel() == nullptr) {
+  // only add interceptor is channelz is enabled and counts this call.
+  if (!channelz_sampled_) {
     return;
   }
   GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_, RecvTrailingMetadataReady,
@@ -332,13 +505,14 @@ class Subchannel::ConnectedSubchannelStateWatcher
       case GRPC_CHANNEL_TRANSIENT_FAILURE:
       case GRPC_CHANNEL_SHUTDOWN: {
         if (!c->disconnected_ && c->connected_subchannel_ != nullptr) {
-          if (grpc_trace_subchannel.enabled()) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
             gpr_log(GPR_INFO,
                     "Connected subchannel %p of subchannel %p has gone into "
                     "%s. Attempting to reconnect.",
                     c->connected_subchannel_.get(), c,
                     ConnectivityStateName(new_state));
           }
+          c->connected_subchannel_->RemoveAllExtraConnections();
           c->connected_subchannel_.reset();
           if (c->channelz_node() != nullptr) {
             c->channelz_node()->SetChildSocket(nullptr);
@@ -362,6 +536,43 @@ class Subchannel::ConnectedSubchannelStateWatcher
   Subchannel* subchannel_;
 };
 
+//
+// Subchannel::ExtraConnectionStateWatcher
+//
+
+class Subchannel::ExtraConnectionStateWatcher
+    : public AsyncConnectivityStateWatcherInterface {
+ public:
+  // Must be instantiated while holding c->mu.
+  ExtraConnectionStateWatcher(Subchannel* c, ConnectedSubchannel* connection)
+      : subchannel_(c), connection_(connection) {
+    // Steal subchannel ref for connecting.
+    GRPC_SUBCHANNEL_WEAK_REF(subchannel_, "extra_connection_watcher");
+    GRPC_SUBCHANNEL_WEAK_UNREF(subchannel_, "connecting");
+  }
+
+  ~ExtraConnectionStateWatcher() {
+    GRPC_SUBCHANNEL_WEAK_UNREF(subchannel_, "extra_connection_watcher");
+  }
+
+ private:
+  void OnConnectivityStateChange(grpc_connectivity_state new_state) override {
+    if (new_state != GRPC_CHANNEL_TRANSIENT_FAILURE &&
+        new_state != GRPC_CHANNEL_SHUTDOWN) {
+      return;
+    }
+    Subchannel* c = subchannel_;
+    MutexLock lock(&c->mu_);
+    if (c->connected_subchannel_ != nullptr) {
+      c->connected_subchannel_->RemoveExtraConnection(connection_);
+    }
+  }
+
+  Subchannel* subchannel_;
+  // Only used to find the connection in the pool: the pool owns it.
+  ConnectedSubchannel* connection_;
+};
+
 //
 // Subchannel::ConnectivityStateWatcherList
 //
@@ -640,8 +851,26 @@ Subchannel::Subchannel(SubchannelKey* key,
       GPR_ARRAY_SIZE(keys_to_remove), &new_arg, 1);
   gpr_free(new_arg.value.string);
   if (new_args != nullptr) grpc_channel_args_destroy(new_args);
+  if (grpc_channel_arg_get_bool(
+          grpc_channel_args_find(args_, GRPC_ARG_SHARED_RECONNECT_BACKOFF),
+          false)) {
+    // The args include the address, the credentials and the backoff
+    // settings, so only subchannels that would back off alike share it.
+    grpc_channel_args* normalized = grpc_channel_args_normalize(args_);
+    reconnect_pacing_key_.reset(grpc_channel_args_string(normalized));
+    grpc_channel_args_destroy(normalized);
+  }
   GRPC_CLOSURE_INIT(&on_connecting_finished_, OnConnectingFinished, this,
                     grpc_schedule_on_exec_ctx);
+  max_connections_ = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args_, GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS),
+      {1, 1, INT_MAX});
+  calls_per_connection_ = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args_, GRPC_ARG_SUBCHANNEL_CALLS_PER_CONNECTION),
+      {GRPC_SUBCHANNEL_DEFAULT_CALLS_PER_CONNECTION, 1, INT_MAX});
+  GRPC_CLOSURE_INIT(&on_extra_connection_idle_timer_,
+                    OnExtraConnectionIdleTimer, this,
+                    grpc_schedule_on_exec_ctx);
   const grpc_arg* arg = grpc_channel_args_find(args_, GRPC_ARG_ENABLE_CHANNELZ);
   const bool channelz_enabled =
       grpc_channel_arg_get_bool(arg, GRPC_ENABLE_CHANNELZ_DEFAULT);
@@ -651,9 +880,12 @@ Subchannel::Subchannel(SubchannelKey* key,
       GRPC_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE_DEFAULT, 0, INT_MAX};
   size_t channel_tracer_max_memory =
       (size_t)grpc_channel_arg_get_integer(arg, options);
+  arg = grpc_channel_args_find(args_, GRPC_ARG_CHANNELZ_CALL_SAMPLING_PERIOD);
+  const uint32_t call_sampling_period = grpc_channel_arg_get_integer(
+      arg, {GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT, 1, INT_MAX});
   if (channelz_enabled) {
     channelz_node_ = MakeRefCounted<channelz::SubchannelNode>(
-        GetTargetAddress(), channel_tracer_max_memory);
+        GetTargetAddress(), channel_tracer_max_memory, call_sampling_period);
     channelz_node_->AddTraceEvent(
         channelz::ChannelTrace::Severity::Info,
         grpc_slice_from_static_string("subchannel created"));
@@ -926,16 +1158,30 @@ void Subchannel::MaybeStartConnectingLocked() {
     // Already connected: don't restart.
     return;
   }
+  if (connecting_extra_) {
+    // The connector is busy opening an extra connection for the connection
+    // we just lost: connect once it is done.
+    connect_after_extra_ = true;
+    return;
+  }
   connecting_ = true;
   GRPC_SUBCHANNEL_WEAK_REF(this, "connecting");
-  if (!backoff_begun_) {
-    backoff_begun_ = true;
+  const grpc_millis now = ExecCtx::Get()->Now();
+  const bool first_attempt = !backoff_begun_;
+  backoff_begun_ = true;
+  grpc_millis attempt_time = first_attempt ? now : next_attempt_deadline_;
+  if (reconnect_pacing_key_ != nullptr) {
+    // Our backoff only sets the earliest time: failures of the subchannels
+    // we share it with may push it back.
+    attempt_time = GlobalSubchannelPool::SharedNextAttemptTime(
+        reconnect_pacing_key_.get(), attempt_time);
+  }
+  if (first_attempt && attempt_time <= now) {
     ContinueConnectingLocked();
   } else {
     GPR_ASSERT(!have_retry_alarm_);
     have_retry_alarm_ = true;
-    const grpc_millis time_til_next =
-        next_attempt_deadline_ - ExecCtx::Get()->Now();
+    const grpc_millis time_til_next = attempt_time - now;
     if (time_til_next <= 0) {
       gpr_log(GPR_INFO, "Subchannel %p: Retry immediately", this);
     } else {
@@ -944,7 +1190,7 @@ void Subchannel::MaybeStartConnectingLocked() {
     }
     GRPC_CLOSURE_INIT(&on_retry_alarm_, OnRetryAlarm, this,
                       grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&retry_alarm_, next_attempt_deadline_, &on_retry_alarm_);
+    grpc_timer_init(&retry_alarm_, attempt_time, &on_retry_alarm_);
   }
 }
 
@@ -975,6 +1221,21 @@ void Subchannel::OnRetryAlarm(void* arg, grpc_error* error) {
 }
 
 void Subchannel::ContinueConnectingLocked() {
+  if (!have_connect_slot_) {
+    // Connection attempts across the process are rate limited: wait for our
+    // turn if it is not now.
+    const grpc_millis slot = GlobalSubchannelPool::ReserveConnectAttempt();
+    if (slot > ExecCtx::Get()->Now()) {
+      have_connect_slot_ = true;
+      GPR_ASSERT(!have_retry_alarm_);
+      have_retry_alarm_ = true;
+      GRPC_CLOSURE_INIT(&on_retry_alarm_, OnRetryAlarm, this,
+                        grpc_schedule_on_exec_ctx);
+      grpc_timer_init(&retry_alarm_, slot, &on_retry_alarm_);
+      return;
+    }
+  }
+  have_connect_slot_ = false;
   SubchannelConnector::Args args;
   args.interested_parties = pollset_set_;
   const grpc_millis min_deadline =
@@ -994,16 +1255,38 @@ void Subchannel::OnConnectingFinished(void* arg, grpc_error* error) {
   {
     MutexLock lock(&c->mu_);
     c->connecting_ = false;
+    const bool was_extra = c->connecting_extra_;
+    c->connecting_extra_ = false;
+    // If the connection it was meant for is gone, an extra connection
+    // replaces it instead.
+    const bool extra = was_extra && c->connected_subchannel_ != nullptr;
+    if (extra) c->connected_subchannel_->ExtraConnectionRequestDone();
     if (c->connecting_result_.transport != nullptr &&
-        c->PublishTransportLocked()) {
-      // Do nothing, transport was published.
+        c->PublishTransportLocked(extra)) {
+      if (c->reconnect_pacing_key_ != nullptr) {
+        GlobalSubchannelPool::RecordConnectSuccess(
+            c->reconnect_pacing_key_.get());
+      }
     } else if (c->disconnected_) {
       GRPC_SUBCHANNEL_WEAK_UNREF(c, "connecting");
+    } else if (was_extra) {
+      // The state does not depend on extra connections.
+      gpr_log(GPR_INFO, "Extra connection failed: %s",
+              grpc_error_string(error));
+      GRPC_SUBCHANNEL_WEAK_UNREF(c, "connecting");
     } else {
       gpr_log(GPR_INFO, "Connect failed: %s", grpc_error_string(error));
+      if (c->reconnect_pacing_key_ != nullptr) {
+        GlobalSubchannelPool::RecordConnectFailure(
+            c->reconnect_pacing_key_.get(), c->next_attempt_deadline_);
+      }
       c->SetConnectivityStateLocked(GRPC_CHANNEL_TRANSIENT_FAILURE);
       GRPC_SUBCHANNEL_WEAK_UNREF(c, "connecting");
     }
+    if (c->connect_after_extra_) {
+      c->connect_after_extra_ = false;
+      c->MaybeStartConnectingLocked();
+    }
   }
   GRPC_SUBCHANNEL_WEAK_UNREF(c, "on_connecting_finished");
   grpc_channel_args_destroy(delete_channel_args);
@@ -1019,7 +1302,7 @@ void ConnectionDestroy(void* arg, grpc_error* /*error*/) {
 
 }  // namespace
 
-bool Subchannel::PublishTransportLocked() {
+bool Subchannel::PublishTransportLocked(bool extra_connection) {
   // Construct channel stack.
   grpc_channel_stack_builder* builder = grpc_channel_stack_builder_create();
   grpc_channel_stack_builder_set_channel_arguments(
@@ -1049,9 +1332,17 @@ bool Subchannel::PublishTransportLocked() {
     gpr_free(stk);
     return false;
   }
+  if (extra_connection) {
+    AddExtraConnectionLocked(stk);
+    return true;
+  }
   // Publish.
   connected_subchannel_.reset(
       new ConnectedSubchannel(stk, args_, channelz_node_));
+  if (max_connections_ > 1) {
+    connected_subchannel_->EnableConnectionPool(this, max_connections_,
+                                                calls_per_connection_);
+  }
   gpr_log(GPR_INFO, "New connected subchannel at %p for subchannel %p",
           connected_subchannel_.get(), this);
   if (channelz_node_ != nullptr) {
@@ -1076,16 +1367,75 @@ void Subchannel::Disconnect() {
   GPR_ASSERT(!disconnected_);
   disconnected_ = true;
   connector_.reset();
+  if (connected_subchannel_ != nullptr) {
+    connected_subchannel_->RemoveAllExtraConnections();
+  }
   connected_subchannel_.reset();
+  if (have_extra_connection_idle_timer_) {
+    grpc_timer_cancel(&extra_connection_idle_timer_);
+  }
   health_watcher_map_.ShutdownLocked();
 }
 
+void Subchannel::StartExtraConnectionLocked(
+    ConnectedSubchannel* connection_pool) {
+  if (disconnected_ || connecting_ || connecting_extra_ ||
+      connected_subchannel_.get() != connection_pool) {
+    connection_pool->ExtraConnectionRequestDone();
+    return;
+  }
+  connecting_extra_ = true;
+  GRPC_SUBCHANNEL_WEAK_REF(this, "connecting");
+  SubchannelConnector::Args args;
+  args.interested_parties = pollset_set_;
+  args.deadline = min_connect_timeout_ms_ + ExecCtx::Get()->Now();
+  args.channel_args = args_;
+  connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
+}
+
+void Subchannel::AddExtraConnectionLocked(grpc_channel_stack* stk) {
+  RefCountedPtr<ConnectedSubchannel> connection(
+      new ConnectedSubchannel(stk, args_, channelz_node_));
+  connection->track_calls_ = true;
+  gpr_log(GPR_INFO, "New extra connection at %p for subchannel %p",
+          connection.get(), this);
+  connection->StartWatch(pollset_set_,
+                         MakeOrphanable<ExtraConnectionStateWatcher>(
+                             this, connection.get()));
+  connected_subchannel_->AddExtraConnection(std::move(connection));
+  MaybeStartExtraConnectionIdleTimerLocked();
+}
+
+void Subchannel::MaybeStartExtraConnectionIdleTimerLocked() {
+  if (have_extra_connection_idle_timer_) return;
+  have_extra_connection_idle_timer_ = true;
+  GRPC_SUBCHANNEL_WEAK_REF(this, "extra_connection_idle_timer");
+  grpc_timer_init(&extra_connection_idle_timer_,
+                  ExecCtx::Get()->Now() +
+                      GRPC_SUBCHANNEL_EXTRA_CONNECTION_IDLE_SECONDS * 1000,
+                  &on_extra_connection_idle_timer_);
+}
+
+void Subchannel::OnExtraConnectionIdleTimer(void* arg, grpc_error* error) {
+  Subchannel* c = static_cast<Subchannel*>(arg);
+  {
+    MutexLock lock(&c->mu_);
+    c->have_extra_connection_idle_timer_ = false;
+    if (error == GRPC_ERROR_NONE && !c->disconnected_ &&
+        c->connected_subchannel_ != nullptr &&
+        c->connected_subchannel_->RemoveIdleExtraConnections() > 0) {
+      c->MaybeStartExtraConnectionIdleTimerLocked();
+    }
+  }
+  GRPC_SUBCHANNEL_WEAK_UNREF(c, "extra_connection_idle_timer");
+}
+
 gpr_atm Subchannel::RefMutate(
     gpr_atm delta, int barrier GRPC_SUBCHANNEL_REF_MUTATE_EXTRA_ARGS) {
   gpr_atm old_val = barrier ? gpr_atm_full_fetch_add(&ref_pair_, delta)
                             : gpr_atm_no_barrier_fetch_add(&ref_pair_, delta);
 #ifndef NDEBUG
-  if (grpc_trace_subchannel_refcount.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel_refcount)) {
     gpr_log(file, line, GPR_LOG_SEVERITY_DEBUG,
             "SUBCHANNEL: %p %12s 0x%" PRIxPTR " -> 0x%" PRIxPTR " [%s]", this,
             purpose, old_val, old_val + delta, reason);
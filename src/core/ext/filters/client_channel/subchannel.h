@@ -28,6 +28,8 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -67,6 +69,7 @@
 
 namespace grpc_core {
 
+class Subchannel;
 class SubchannelCall;
 
 class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
@@ -89,12 +92,61 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
 
   size_t GetInitialCallSizeEstimate(size_t parent_data_size) const;
 
+  // True if a call started now would have to wait for the peer to allow more
+  // concurrent streams, on this connection and on any extra ones the
+  // subchannel opened alongside it.
+  bool IsSaturated();
+
+  // True if the subchannel may open more connections alongside this one.
+  bool has_connection_pool() const { return subchannel_ != nullptr; }
+  // Returns the least loaded of this connection and the extra ones the
+  // subchannel opened alongside it. If they are all busy, also asks the
+  // subchannel for another one. Sets \a extra_connection_pending if a new
+  // connection is on its way. Requires has_connection_pool().
+  RefCountedPtr<ConnectedSubchannel> PickConnection(
+      bool* extra_connection_pending);
+
  private:
+  friend class Subchannel;
+  friend class SubchannelCall;
+
+  // Makes this the pool of connections of \a subchannel.
+  void EnableConnectionPool(Subchannel* subchannel, size_t max_connections,
+                            size_t calls_per_connection);
+  void AddExtraConnection(RefCountedPtr<ConnectedSubchannel> connection);
+  void RemoveExtraConnection(ConnectedSubchannel* connection);
+  // Removes the extra connections that started no call since the last time.
+  // Returns the number of extra connections left.
+  size_t RemoveIdleExtraConnections();
+  void RemoveAllExtraConnections();
+  // Lets PickConnection() ask for another connection again.
+  void ExtraConnectionRequestDone();
+
+  static void RequestExtraConnection(void* arg, grpc_error* error);
+
   grpc_channel_stack* channel_stack_;
   grpc_channel_args* args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  // Kept up to date by the transport.
+  RefCountedPtr<StreamHeadroom> stream_headroom_;
+
+  // Call accounting, only kept for the connections of a pool.
+  bool track_calls_ = false;
+  Atomic<size_t> calls_in_flight_{0};
+  Atomic<size_t> calls_started_{0};
+  size_t calls_started_at_idle_check_ = 0;
+
+  // Connection pool state. The subchannel (weakly reffed) is only set on the
+  // connection it publishes, and only if it may open more than one.
+  Subchannel* subchannel_ = nullptr;
+  size_t max_connections_ = 1;
+  size_t calls_per_connection_ = 0;
+  Mutex pool_mu_;
+  InlinedVector<RefCountedPtr<ConnectedSubchannel>, 3> extra_connections_;
+  bool extra_connection_requested_ = false;
+  grpc_closure request_extra_connection_;
 };
 
 // Implements the interface of RefCounted<>.
@@ -146,13 +198,19 @@ class SubchannelCall {
 
   SubchannelCall(Args args, grpc_error** error);
 
-  // If channelz is enabled, intercepts recv_trailing so that we may check the
-  // status and associate it to a subchannel.
+  // If channelz is enabled and counts this call, intercepts recv_trailing so
+  // that we may check the status and associate it to a subchannel.
   void MaybeInterceptRecvTrailingMetadata(
       grpc_transport_stream_op_batch* batch);
 
   static void RecvTrailingMetadataReady(void* arg, grpc_error* error);
 
+  // Has the call poll for the extra connection \a subchannel is opening:
+  // nothing else may poll the subchannel once all the calls are on their
+  // transports.
+  void PollExtraConnection(Subchannel* subchannel,
+                           grpc_polling_entity* pollent);
+
   // Interface of RefCounted<>.
   void IncrementRefCount();
   void IncrementRefCount(const DebugLocation& location, const char* reason);
@@ -163,7 +221,12 @@ class SubchannelCall {
   grpc_closure recv_trailing_metadata_ready_;
   grpc_closure* original_recv_trailing_metadata_ = nullptr;
   grpc_metadata_batch* recv_trailing_metadata_ = nullptr;
+  // Whether channelz counts this call; unsampled calls are not intercepted.
+  bool channelz_sampled_ = false;
   grpc_millis deadline_;
+  // Set (weakly reffed) while pollent_ is in the subchannel's pollset_set.
+  Subchannel* polled_subchannel_ = nullptr;
+  grpc_polling_entity pollent_;
 };
 
 // A subchannel that knows how to connect to exactly one target address. It
@@ -273,6 +336,9 @@ class Subchannel {
                                                  grpc_resolved_address* addr);
 
  private:
+  friend class ConnectedSubchannel;
+  friend class SubchannelCall;
+
   // A linked list of ConnectivityStateWatcherInterfaces that are monitoring
   // the subchannel's state.
   class ConnectivityStateWatcherList {
@@ -331,6 +397,7 @@ class Subchannel {
   };
 
   class ConnectedSubchannelStateWatcher;
+  class ExtraConnectionStateWatcher;
 
   // Sets the subchannel's connectivity state to \a state.
   void SetConnectivityStateLocked(grpc_connectivity_state state);
@@ -340,9 +407,17 @@ class Subchannel {
   static void OnRetryAlarm(void* arg, grpc_error* error);
   void ContinueConnectingLocked();
   static void OnConnectingFinished(void* arg, grpc_error* error);
-  bool PublishTransportLocked();
+  // Publishes the transport as the subchannel's connection, or adds it to
+  // the pool of the subchannel's connection if \a extra_connection.
+  bool PublishTransportLocked(bool extra_connection);
   void Disconnect();
 
+  // Methods for extra connections.
+  void StartExtraConnectionLocked(ConnectedSubchannel* connection_pool);
+  void AddExtraConnectionLocked(grpc_channel_stack* stk);
+  void MaybeStartExtraConnectionIdleTimerLocked();
+  static void OnExtraConnectionIdleTimer(void* arg, grpc_error* error);
+
   gpr_atm RefMutate(gpr_atm delta,
                     int barrier GRPC_SUBCHANNEL_REF_MUTATE_EXTRA_ARGS);
 
@@ -353,6 +428,9 @@ class Subchannel {
   SubchannelKey* key_;
   // Channel args.
   grpc_channel_args* args_;
+  // If GRPC_ARG_SHARED_RECONNECT_BACKOFF is set, the key under which the
+  // reconnect backoff is shared with other subchannels, otherwise null.
+  grpc_core::UniquePtr<char> reconnect_pacing_key_;
   // pollset_set tracking who's interested in a connection being setup.
   grpc_pollset_set* pollset_set_;
   // Protects the other members.
@@ -374,6 +452,17 @@ class Subchannel {
   bool connecting_ = false;
   bool disconnected_ = false;
 
+  // Extra connections. The connector opens them one at a time, when it is
+  // not busy connecting the subchannel.
+  size_t max_connections_;
+  size_t calls_per_connection_;
+  bool connecting_extra_ = false;
+  // A connection attempt was asked for while connecting an extra connection.
+  bool connect_after_extra_ = false;
+  grpc_timer extra_connection_idle_timer_;
+  grpc_closure on_extra_connection_idle_timer_;
+  bool have_extra_connection_idle_timer_ = false;
+
   // Connectivity state tracking.
   grpc_connectivity_state state_ = GRPC_CHANNEL_IDLE;
   // The list of watchers without a health check service name.
@@ -393,6 +482,9 @@ class Subchannel {
   bool have_retry_alarm_ = false;
   // reset_backoff() was called while alarm was pending.
   bool retry_immediately_ = false;
+  // The alarm waits for a connection attempt the rate limiter already let
+  // through.
+  bool have_connect_slot_ = false;
 
   // Channelz tracking.
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
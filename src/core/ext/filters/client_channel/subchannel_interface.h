@@ -85,6 +85,12 @@ class SubchannelInterface : public RefCounted<SubchannelInterface> {
   // attempt will be started as soon as AttemptToConnect() is called.
   virtual void ResetBackoff() = 0;
 
+  // Returns true if the subchannel is connected, but a call sent to it now
+  // would have to wait for the backend to allow more concurrent streams.
+  // Meant to be called by pickers, so that they can route around saturated
+  // connections.
+  virtual bool IsSaturated() { return false; }
+
   // TODO(roth): Need a better non-grpc-specific abstraction here.
   virtual const grpc_channel_args* channel_args() = 0;
 };
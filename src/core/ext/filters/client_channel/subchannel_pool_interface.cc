@@ -20,6 +20,9 @@
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
 
+#include <string.h>
+
+#include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gpr/useful.h"
 
 // The subchannel pool to reuse subchannels.
@@ -31,32 +34,65 @@ namespace grpc_core {
 
 TraceFlag grpc_subchannel_pool_trace(false, "subchannel_pool");
 
-SubchannelKey::SubchannelKey(const grpc_channel_args* args) {
-  Init(args, grpc_channel_args_normalize);
-}
+namespace {
 
-SubchannelKey::~SubchannelKey() {
-  grpc_channel_args_destroy(const_cast<grpc_channel_args*>(args_));
+// Hashes \a args consistently with grpc_channel_args_compare(). Pointer
+// args are compared by their vtable, so only their keys are hashed.
+uint32_t HashChannelArgs(const grpc_channel_args* args) {
+  if (args == nullptr) return 0;
+  uint32_t hash = static_cast<uint32_t>(args->num_args);
+  for (size_t i = 0; i < args->num_args; ++i) {
+    const grpc_arg& arg = args->args[i];
+    hash = gpr_murmur_hash3(arg.key, strlen(arg.key), hash);
+    switch (arg.type) {
+      case GRPC_ARG_STRING:
+        hash = gpr_murmur_hash3(arg.value.string, strlen(arg.value.string),
+                                hash);
+        break;
+      case GRPC_ARG_INTEGER:
+        hash = gpr_murmur_hash3(&arg.value.integer, sizeof(arg.value.integer),
+                                hash);
+        break;
+      case GRPC_ARG_POINTER:
+        break;
+    }
+  }
+  return hash;
 }
 
-SubchannelKey::SubchannelKey(const SubchannelKey& other) {
-  Init(other.args_, grpc_channel_args_copy);
-}
+}  // namespace
+
+class SubchannelKey::Args : public RefCounted<Args> {
+ public:
+  explicit Args(const grpc_channel_args* args)
+      : args_(grpc_channel_args_normalize(args)) {}
+  ~Args() { grpc_channel_args_destroy(args_); }
+
+  const grpc_channel_args* get() const { return args_; }
+
+ private:
+  grpc_channel_args* args_;
+};
+
+SubchannelKey::SubchannelKey(const grpc_channel_args* args)
+    : args_(MakeRefCounted<Args>(args)), hash_(HashChannelArgs(args_->get())) {}
+
+SubchannelKey::~SubchannelKey() {}
+
+SubchannelKey::SubchannelKey(const SubchannelKey& other)
+    : args_(other.args_), hash_(other.hash_) {}
 
 SubchannelKey& SubchannelKey::operator=(const SubchannelKey& other) {
-  grpc_channel_args_destroy(const_cast<grpc_channel_args*>(args_));
-  Init(other.args_, grpc_channel_args_copy);
+  args_ = other.args_;
+  hash_ = other.hash_;
   return *this;
 }
 
 int SubchannelKey::Cmp(const SubchannelKey& other) const {
-  return grpc_channel_args_compare(args_, other.args_);
-}
-
-void SubchannelKey::Init(
-    const grpc_channel_args* args,
-    grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args)) {
-  args_ = copy_channel_args(args);
+  if (args_ == other.args_) return 0;
+  int c = GPR_ICMP(hash_, other.hash_);
+  if (c != 0) return c;
+  return grpc_channel_args_compare(args_->get(), other.args_->get());
 }
 
 namespace {
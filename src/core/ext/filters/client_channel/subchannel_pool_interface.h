@@ -24,6 +24,7 @@
 #include "src/core/lib/avl/avl.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 
 namespace grpc_core {
 
@@ -37,23 +38,28 @@ class SubchannelKey {
   explicit SubchannelKey(const grpc_channel_args* args);
   ~SubchannelKey();
 
-  // Copyable.
+  // Copyable. Copies share the normalized args of the original, so copying
+  // is a ref and comparing copies of one key is a pointer comparison.
   SubchannelKey(const SubchannelKey& other);
   SubchannelKey& operator=(const SubchannelKey& other);
   // Not movable.
   SubchannelKey(SubchannelKey&&) = delete;
   SubchannelKey& operator=(SubchannelKey&&) = delete;
 
+  // Orders keys by hash first, so that keys with different args rarely need
+  // a deep comparison.
   int Cmp(const SubchannelKey& other) const;
 
+  // A hash of the key, computed once at construction. Keys that compare
+  // equal have the same hash.
+  uint32_t hash() const { return hash_; }
+
  private:
-  // Initializes the subchannel key with the given \a args and the function to
-  // copy channel args.
-  void Init(
-      const grpc_channel_args* args,
-      grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args));
+  // Immutable normalized args, shared by all copies of a key.
+  class Args;
 
-  const grpc_channel_args* args_;
+  RefCountedPtr<Args> args_;
+  uint32_t hash_;
 };
 
 // Interface for subchannel pool.
@@ -42,6 +42,7 @@
 #include "google/protobuf/struct.upb.h"
 #include "google/protobuf/timestamp.upb.h"
 #include "google/protobuf/wrappers.upb.h"
+#include "google/rpc/status.upb.h"
 #include "upb/upb.h"
 
 namespace grpc_core {
@@ -88,14 +89,29 @@ bool XdsPriorityListUpdate::Contains(
   return false;
 }
 
+void XdsDropConfig::AddCategory(grpc_core::UniquePtr<char> name,
+                                uint32_t parts_per_million) {
+  // Categories are applied in order, each to the calls that the earlier ones
+  // kept, so this one drops its share of what is left.
+  const uint32_t previous = drop_thresholds_.empty()
+                                ? 0
+                                : drop_thresholds_[drop_thresholds_.size() - 1];
+  const uint64_t remaining = 1000000 - previous;
+  drop_thresholds_.push_back(
+      previous +
+      static_cast<uint32_t>(remaining * parts_per_million / 1000000));
+  drop_category_list_.emplace_back(
+      DropCategory{std::move(name), parts_per_million});
+}
+
 bool XdsDropConfig::ShouldDrop(
     const grpc_core::UniquePtr<char>** category_name) const {
-  for (size_t i = 0; i < drop_category_list_.size(); ++i) {
-    const auto& drop_category = drop_category_list_[i];
-    // Generate a random number in [0, 1000000).
-    const uint32_t random = static_cast<uint32_t>(rand()) % 1000000;
-    if (random < drop_category.parts_per_million) {
-      *category_name = &drop_category.name;
+  if (drop_category_list_.empty()) return false;
+  // Generate a random number in [0, 1000000).
+  const uint32_t random = static_cast<uint32_t>(rand()) % 1000000;
+  for (size_t i = 0; i < drop_thresholds_.size(); ++i) {
+    if (random < drop_thresholds_[i]) {
+      *category_name = &drop_category_list_[i].name;
       return true;
     }
   }
@@ -245,13 +261,16 @@ grpc_error* ServerAddressParseAndAppend(
   if (GPR_UNLIKELY(port >> 16) != 0) {
     return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Invalid port.");
   }
-  // Populate grpc_resolved_address.
-  grpc_resolved_address addr;
-  char* address_str = static_cast<char*>(gpr_malloc(address_strview.size + 1));
+  // Populate grpc_resolved_address. Any IP address fits in a buffer on the
+  // stack, which saves an allocation per endpoint in large responses.
+  char address_str[64];
+  if (address_strview.size >= sizeof(address_str)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Invalid address.");
+  }
   memcpy(address_str, address_strview.data, address_strview.size);
   address_str[address_strview.size] = '\0';
+  grpc_resolved_address addr;
   grpc_string_to_sockaddr(&addr, address_str, port);
-  gpr_free(address_str);
   // Append the address to the list.
   list->emplace_back(addr, nullptr);
   return GRPC_ERROR_NONE;
@@ -293,6 +312,7 @@ grpc_error* LocalityParse(
   const envoy_api_v2_endpoint_LbEndpoint* const* lb_endpoints =
       envoy_api_v2_endpoint_LocalityLbEndpoints_lb_endpoints(
           locality_lb_endpoints, &size);
+  output_locality->serverlist.reserve(size);
   for (size_t i = 0; i < size; ++i) {
     grpc_error* error = ServerAddressParseAndAppend(
         lb_endpoints[i], &output_locality->serverlist);
@@ -342,47 +362,22 @@ grpc_error* DropParseAndAppend(
   return GRPC_ERROR_NONE;
 }
 
-}  // namespace
-
-grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
-                                         EdsUpdate* update) {
-  upb::Arena arena;
-  // Decode the response.
-  const envoy_api_v2_DiscoveryResponse* response =
-      envoy_api_v2_DiscoveryResponse_parse(
-          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(encoded_response)),
-          GRPC_SLICE_LENGTH(encoded_response), arena.ptr());
-  // Parse the response.
-  if (response == nullptr) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("No response found.");
-  }
-  // Check the type_url of the response.
-  upb_strview type_url = envoy_api_v2_DiscoveryResponse_type_url(response);
-  upb_strview expected_type_url = upb_strview_makez(kEdsTypeUrl);
-  if (!upb_strview_eql(type_url, expected_type_url)) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
-  }
-  // Get the resources from the response.
-  size_t size;
-  const google_protobuf_Any* const* resources =
-      envoy_api_v2_DiscoveryResponse_resources(response, &size);
-  if (size < 1) {
-    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-        "EDS response contains 0 resource.");
-  }
+grpc_error* EdsResourceParse(const google_protobuf_Any* resource,
+                             upb_arena* arena, EdsUpdate* update) {
   // Check the type_url of the resource.
-  type_url = google_protobuf_Any_type_url(resources[0]);
-  if (!upb_strview_eql(type_url, expected_type_url)) {
+  upb_strview type_url = google_protobuf_Any_type_url(resource);
+  if (!upb_strview_eql(type_url, upb_strview_makez(kEdsTypeUrl))) {
     return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
   }
   // Get the cluster_load_assignment.
   upb_strview encoded_cluster_load_assignment =
-      google_protobuf_Any_value(resources[0]);
+      google_protobuf_Any_value(resource);
   envoy_api_v2_ClusterLoadAssignment* cluster_load_assignment =
       envoy_api_v2_ClusterLoadAssignment_parse(
           encoded_cluster_load_assignment.data,
-          encoded_cluster_load_assignment.size, arena.ptr());
+          encoded_cluster_load_assignment.size, arena);
   // Get the endpoints.
+  size_t size;
   const envoy_api_v2_endpoint_LocalityLbEndpoints* const* endpoints =
       envoy_api_v2_ClusterLoadAssignment_endpoints(cluster_load_assignment,
                                                    &size);
@@ -392,7 +387,7 @@ grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
     if (error != GRPC_ERROR_NONE) return error;
     // Filter out locality with weight 0.
     if (locality.lb_weight == 0) continue;
-    update->priority_list_update.Add(locality);
+    update->priority_list_update.Add(std::move(locality));
   }
   // Get the drop config.
   update->drop_config = MakeRefCounted<XdsDropConfig>();
@@ -412,6 +407,153 @@ grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
   return GRPC_ERROR_NONE;
 }
 
+}  // namespace
+
+grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
+                                         EdsUpdate* update) {
+  upb::Arena arena;
+  // Decode the response.
+  const envoy_api_v2_DiscoveryResponse* response =
+      envoy_api_v2_DiscoveryResponse_parse(
+          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(encoded_response)),
+          GRPC_SLICE_LENGTH(encoded_response), arena.ptr());
+  // Parse the response.
+  if (response == nullptr) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("No response found.");
+  }
+  // Check the type_url of the response.
+  upb_strview type_url = envoy_api_v2_DiscoveryResponse_type_url(response);
+  upb_strview expected_type_url = upb_strview_makez(kEdsTypeUrl);
+  if (!upb_strview_eql(type_url, expected_type_url)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
+  }
+  // Get the resources from the response.
+  size_t size;
+  const google_protobuf_Any* const* resources =
+      envoy_api_v2_DiscoveryResponse_resources(response, &size);
+  if (size < 1) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "EDS response contains 0 resource.");
+  }
+  return EdsResourceParse(resources[0], arena.ptr(), update);
+}
+
+grpc_slice XdsEdsDeltaRequestCreateAndEncode(const char* server_name,
+                                             const XdsBootstrap::Node* node,
+                                             const char* build_version,
+                                             const char* version) {
+  upb::Arena arena;
+  // Create a request.
+  envoy_api_v2_DeltaDiscoveryRequest* request =
+      envoy_api_v2_DeltaDiscoveryRequest_new(arena.ptr());
+  envoy_api_v2_core_Node* node_msg =
+      envoy_api_v2_DeltaDiscoveryRequest_mutable_node(request, arena.ptr());
+  PopulateNode(arena.ptr(), node, build_version, node_msg);
+  envoy_api_v2_DeltaDiscoveryRequest_set_type_url(
+      request, upb_strview_makez(kEdsTypeUrl));
+  envoy_api_v2_DeltaDiscoveryRequest_add_resource_names_subscribe(
+      request, upb_strview_makez(server_name), arena.ptr());
+  // Tell the server which version we already have, so that it only sends the
+  // resource if it has changed since.
+  if (version != nullptr) {
+    envoy_api_v2_DeltaDiscoveryRequest_InitialResourceVersionsEntry* entry =
+        envoy_api_v2_DeltaDiscoveryRequest_add_initial_resource_versions(
+            request, arena.ptr());
+    envoy_api_v2_DeltaDiscoveryRequest_InitialResourceVersionsEntry_set_key(
+        entry, upb_strview_makez(server_name));
+    envoy_api_v2_DeltaDiscoveryRequest_InitialResourceVersionsEntry_set_value(
+        entry, upb_strview_makez(version));
+  }
+  // Encode the request.
+  size_t output_length;
+  char* output = envoy_api_v2_DeltaDiscoveryRequest_serialize(
+      request, arena.ptr(), &output_length);
+  return grpc_slice_from_copied_buffer(output, output_length);
+}
+
+grpc_slice XdsEdsDeltaAckCreateAndEncode(const char* nonce,
+                                         grpc_error* error) {
+  upb::Arena arena;
+  // Create a request.
+  envoy_api_v2_DeltaDiscoveryRequest* request =
+      envoy_api_v2_DeltaDiscoveryRequest_new(arena.ptr());
+  envoy_api_v2_DeltaDiscoveryRequest_set_type_url(
+      request, upb_strview_makez(kEdsTypeUrl));
+  envoy_api_v2_DeltaDiscoveryRequest_set_response_nonce(
+      request, upb_strview_makez(nonce));
+  if (error != GRPC_ERROR_NONE) {
+    google_rpc_Status* error_detail =
+        envoy_api_v2_DeltaDiscoveryRequest_mutable_error_detail(request,
+                                                                arena.ptr());
+    google_rpc_Status_set_code(error_detail, GRPC_STATUS_INVALID_ARGUMENT);
+    google_rpc_Status_set_message(error_detail,
+                                  upb_strview_makez(grpc_error_string(error)));
+  }
+  // Encode the request.
+  size_t output_length;
+  char* output = envoy_api_v2_DeltaDiscoveryRequest_serialize(
+      request, arena.ptr(), &output_length);
+  return grpc_slice_from_copied_buffer(output, output_length);
+}
+
+grpc_error* XdsEdsDeltaResponseDecodeAndParse(
+    const grpc_slice& encoded_response, const char* server_name,
+    const char* current_version, EdsDeltaResponse* delta_response) {
+  upb::Arena arena;
+  // Decode the response.
+  const envoy_api_v2_DeltaDiscoveryResponse* response =
+      envoy_api_v2_DeltaDiscoveryResponse_parse(
+          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(encoded_response)),
+          GRPC_SLICE_LENGTH(encoded_response), arena.ptr());
+  // Parse the response.
+  if (response == nullptr) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("No response found.");
+  }
+  delta_response->nonce =
+      StringCopy(envoy_api_v2_DeltaDiscoveryResponse_nonce(response));
+  // Check the type_url of the response.
+  upb_strview type_url = envoy_api_v2_DeltaDiscoveryResponse_type_url(response);
+  if (!upb_strview_eql(type_url, upb_strview_makez(kEdsTypeUrl))) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is not EDS.");
+  }
+  const upb_strview name = upb_strview_makez(server_name);
+  // Check whether our resource was removed.
+  size_t size;
+  const upb_strview* removed_resources =
+      envoy_api_v2_DeltaDiscoveryResponse_removed_resources(response, &size);
+  for (size_t i = 0; i < size; ++i) {
+    if (upb_strview_eql(removed_resources[i], name)) {
+      delta_response->removed = true;
+    }
+  }
+  // Only changed resources are sent, so the response may not include ours.
+  const envoy_api_v2_Resource* const* resources =
+      envoy_api_v2_DeltaDiscoveryResponse_resources(response, &size);
+  for (size_t i = 0; i < size; ++i) {
+    if (!upb_strview_eql(envoy_api_v2_Resource_name(resources[i]), name)) {
+      continue;
+    }
+    // Don't parse a version we already have.
+    upb_strview version = envoy_api_v2_Resource_version(resources[i]);
+    if (current_version != nullptr && version.size > 0 &&
+        upb_strview_eql(version, upb_strview_makez(current_version))) {
+      continue;
+    }
+    const google_protobuf_Any* resource =
+        envoy_api_v2_Resource_resource(resources[i]);
+    if (resource == nullptr) {
+      return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource is empty.");
+    }
+    grpc_error* error =
+        EdsResourceParse(resource, arena.ptr(), &delta_response->update);
+    if (error != GRPC_ERROR_NONE) return error;
+    delta_response->updated = true;
+    delta_response->removed = false;
+    delta_response->version = StringCopy(version);
+  }
+  return GRPC_ERROR_NONE;
+}
+
 namespace {
 
 grpc_slice LrsRequestEncode(
@@ -108,10 +108,7 @@ class XdsDropConfig : public RefCounted<XdsDropConfig> {
   using DropCategoryList = InlinedVector<DropCategory, 2>;
 
   void AddCategory(grpc_core::UniquePtr<char> name,
-                   uint32_t parts_per_million) {
-    drop_category_list_.emplace_back(
-        DropCategory{std::move(name), parts_per_million});
-  }
+                   uint32_t parts_per_million);
 
   // The only method invoked from the data plane combiner.
   bool ShouldDrop(const grpc_core::UniquePtr<char>** category_name) const;
@@ -129,6 +126,9 @@ class XdsDropConfig : public RefCounted<XdsDropConfig> {
 
  private:
   DropCategoryList drop_category_list_;
+  // For each category, the chance in a million that a call is dropped by it
+  // or an earlier category. Lets a single random number make the decision.
+  InlinedVector<uint32_t, 2> drop_thresholds_;
 };
 
 struct EdsUpdate {
@@ -158,6 +158,38 @@ grpc_slice XdsEdsRequestCreateAndEncode(const char* server_name,
 grpc_error* XdsEdsResponseDecodeAndParse(const grpc_slice& encoded_response,
                                          EdsUpdate* update);
 
+// The parts of an incremental (Delta ADS) EDS response the client acts on.
+struct EdsDeltaResponse {
+  // The nonce to send back in the ACK or NACK.
+  grpc_core::UniquePtr<char> nonce;
+  // Whether the response carries a new version of the resource. If so,
+  // \a update and \a version are set.
+  bool updated = false;
+  EdsUpdate update;
+  grpc_core::UniquePtr<char> version;
+  // Whether the server removed the resource.
+  bool removed = false;
+};
+
+// Creates the initial Delta ADS request subscribing to \a server_name. If \a
+// version is non-null, the client already has that version of the resource,
+// so the server only needs to send it if it changed.
+grpc_slice XdsEdsDeltaRequestCreateAndEncode(const char* server_name,
+                                             const XdsBootstrap::Node* node,
+                                             const char* build_version,
+                                             const char* version);
+
+// Creates a Delta ADS request that ACKs the response with \a nonce, or NACKs
+// it if \a error is not GRPC_ERROR_NONE.
+grpc_slice XdsEdsDeltaAckCreateAndEncode(const char* nonce, grpc_error* error);
+
+// Parses a Delta ADS response for the resource \a server_name. A resource
+// whose version is \a current_version is skipped without being parsed. If
+// there is any error, only the nonce of the output is valid.
+grpc_error* XdsEdsDeltaResponseDecodeAndParse(
+    const grpc_slice& encoded_response, const char* server_name,
+    const char* current_version, EdsDeltaResponse* delta_response);
+
 // Creates an LRS request querying \a server_name.
 grpc_slice XdsLrsRequestCreateAndEncode(const char* server_name,
                                         const XdsBootstrap::Node* node,
@@ -107,6 +107,7 @@ grpc_error* XdsBootstrap::ParseXdsServer(grpc_json* json) {
   InlinedVector<grpc_error*, 1> error_list;
   server_uri_ = nullptr;
   bool seen_channel_creds = false;
+  bool seen_incremental_xds = false;
   for (grpc_json* child = json->child; child != nullptr; child = child->next) {
     if (child->key == nullptr) {
       error_list.push_back(
@@ -133,6 +134,17 @@ grpc_error* XdsBootstrap::ParseXdsServer(grpc_json* json) {
       seen_channel_creds = true;
       grpc_error* parse_error = ParseChannelCredsArray(child);
       if (parse_error != GRPC_ERROR_NONE) error_list.push_back(parse_error);
+    } else if (strcmp(child->key, "incremental_xds") == 0) {
+      if (child->type != GRPC_JSON_TRUE && child->type != GRPC_JSON_FALSE) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "\"incremental_xds\" field is not a boolean"));
+      }
+      if (seen_incremental_xds) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "duplicate \"incremental_xds\" field"));
+      }
+      seen_incremental_xds = true;
+      incremental_xds_ = child->type == GRPC_JSON_TRUE;
     }
   }
   if (server_uri_ == nullptr) {
@@ -70,6 +70,8 @@ class XdsBootstrap {
   const InlinedVector<ChannelCreds, 1>& channel_creds() const {
     return channel_creds_;
   }
+  // Whether to use the incremental (Delta ADS) variant of the protocol.
+  bool incremental_xds() const { return incremental_xds_; }
   const Node* node() const { return node_.get(); }
 
  private:
@@ -92,6 +94,7 @@ class XdsBootstrap {
 
   const char* server_uri_ = nullptr;
   InlinedVector<ChannelCreds, 1> channel_creds_;
+  bool incremental_xds_ = false;
   std::unique_ptr<Node> node_;
 };
 
@@ -126,11 +126,20 @@ class XdsClient::ChannelState::AdsCallState
   bool seen_response() const { return seen_response_; }
 
  private:
+  static void OnRequestSent(void* arg, grpc_error* error);
   static void OnResponseReceived(void* arg, grpc_error* error);
   static void OnStatusReceived(void* arg, grpc_error* error);
+  static void OnRequestSentLocked(void* arg, grpc_error* error);
   static void OnResponseReceivedLocked(void* arg, grpc_error* error);
   static void OnStatusReceivedLocked(void* arg, grpc_error* error);
 
+  // Parses an incremental xDS response and ACKs or NACKs it. Returns true if
+  // the response carries an update to apply.
+  bool HandleDeltaResponseLocked(const grpc_slice& response_slice,
+                                 EdsUpdate* update);
+  void SendAckLocked(const char* nonce, grpc_error* error);
+  void SendMessageLocked(grpc_byte_buffer* payload);
+
   bool IsCurrentCallOnChannel() const;
 
   // The owning RetryableCall<>.
@@ -145,6 +154,9 @@ class XdsClient::ChannelState::AdsCallState
 
   // send_message
   grpc_byte_buffer* send_message_payload_ = nullptr;
+  grpc_closure on_request_sent_;
+  // The latest ACK, waiting for the message in flight to be sent.
+  grpc_byte_buffer* pending_ack_payload_ = nullptr;
 
   // recv_message
   grpc_byte_buffer* recv_message_payload_ = nullptr;
@@ -525,16 +537,31 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
   GPR_ASSERT(xds_client()->server_name_ != nullptr);
   GPR_ASSERT(*xds_client()->server_name_.get() != '\0');
   // Create a call with the specified method name.
+  const bool incremental = xds_client()->bootstrap_->incremental_xds();
+  grpc_slice method =
+      GRPC_MDSTR_SLASH_ENVOY_DOT_SERVICE_DOT_DISCOVERY_DOT_V2_DOT_AGGREGATEDDISCOVERYSERVICE_SLASH_STREAMAGGREGATEDRESOURCES;
+  if (incremental) {
+    method = grpc_slice_from_static_string(
+        "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
+        "DeltaAggregatedResources");
+  }
   call_ = grpc_channel_create_pollset_set_call(
       chand()->channel_, nullptr, GRPC_PROPAGATE_DEFAULTS,
-      xds_client()->interested_parties_,
-      GRPC_MDSTR_SLASH_ENVOY_DOT_SERVICE_DOT_DISCOVERY_DOT_V2_DOT_AGGREGATEDDISCOVERYSERVICE_SLASH_STREAMAGGREGATEDRESOURCES,
-      nullptr, GRPC_MILLIS_INF_FUTURE, nullptr);
+      xds_client()->interested_parties_, method, nullptr,
+      GRPC_MILLIS_INF_FUTURE, nullptr);
   GPR_ASSERT(call_ != nullptr);
-  // Init the request payload.
-  grpc_slice request_payload_slice = XdsEdsRequestCreateAndEncode(
-      xds_client()->server_name_.get(), xds_client()->bootstrap_->node(),
-      xds_client()->build_version_.get());
+  // Init the request payload. On a new incremental xDS stream, tell the server
+  // which version we already have, so that it doesn't resend it unchanged.
+  grpc_slice request_payload_slice =
+      incremental
+          ? XdsEdsDeltaRequestCreateAndEncode(
+                xds_client()->server_name_.get(),
+                xds_client()->bootstrap_->node(),
+                xds_client()->build_version_.get(),
+                xds_client()->cluster_state_.eds_version.get())
+          : XdsEdsRequestCreateAndEncode(xds_client()->server_name_.get(),
+                                         xds_client()->bootstrap_->node(),
+                                         xds_client()->build_version_.get());
   send_message_payload_ =
       grpc_raw_byte_buffer_create(&request_payload_slice, 1);
   grpc_slice_unref_internal(request_payload_slice);
@@ -566,8 +593,11 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
   op->flags = 0;
   op->reserved = nullptr;
   op++;
+  Ref(DEBUG_LOCATION, "ADS+OnRequestSentLocked").release();
+  GRPC_CLOSURE_INIT(&on_request_sent_, OnRequestSent, this,
+                    grpc_schedule_on_exec_ctx);
   call_error = grpc_call_start_batch_and_execute(call_, ops, (size_t)(op - ops),
-                                                 nullptr);
+                                                 &on_request_sent_);
   GPR_ASSERT(GRPC_CALL_OK == call_error);
   // Op: recv initial metadata.
   op = ops;
@@ -612,6 +642,7 @@ XdsClient::ChannelState::AdsCallState::~AdsCallState() {
   grpc_metadata_array_destroy(&initial_metadata_recv_);
   grpc_metadata_array_destroy(&trailing_metadata_recv_);
   grpc_byte_buffer_destroy(send_message_payload_);
+  grpc_byte_buffer_destroy(pending_ack_payload_);
   grpc_byte_buffer_destroy(recv_message_payload_);
   grpc_slice_unref_internal(status_details_);
   GPR_ASSERT(call_ != nullptr);
@@ -629,6 +660,113 @@ void XdsClient::ChannelState::AdsCallState::Orphan() {
   // corresponding unref happens in on_status_received_ instead of here.
 }
 
+void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
+    grpc_byte_buffer* payload) {
+  GPR_ASSERT(send_message_payload_ == nullptr);
+  send_message_payload_ = payload;
+  grpc_op op;
+  memset(&op, 0, sizeof(op));
+  op.op = GRPC_OP_SEND_MESSAGE;
+  op.data.send_message.send_message = send_message_payload_;
+  op.flags = 0;
+  op.reserved = nullptr;
+  Ref(DEBUG_LOCATION, "ADS+OnRequestSentLocked").release();
+  GRPC_CLOSURE_INIT(&on_request_sent_, OnRequestSent, this,
+                    grpc_schedule_on_exec_ctx);
+  const grpc_call_error call_error =
+      grpc_call_start_batch_and_execute(call_, &op, 1, &on_request_sent_);
+  GPR_ASSERT(GRPC_CALL_OK == call_error);
+}
+
+void XdsClient::ChannelState::AdsCallState::SendAckLocked(const char* nonce,
+                                                          grpc_error* error) {
+  grpc_slice payload_slice = XdsEdsDeltaAckCreateAndEncode(nonce, error);
+  grpc_byte_buffer* payload = grpc_raw_byte_buffer_create(&payload_slice, 1);
+  grpc_slice_unref_internal(payload_slice);
+  // Only one message can be in flight. Since only the latest nonce matters,
+  // a newer ACK replaces one that is still waiting.
+  if (send_message_payload_ != nullptr) {
+    grpc_byte_buffer_destroy(pending_ack_payload_);
+    pending_ack_payload_ = payload;
+    return;
+  }
+  SendMessageLocked(payload);
+}
+
+void XdsClient::ChannelState::AdsCallState::OnRequestSent(void* arg,
+                                                          grpc_error* error) {
+  AdsCallState* ads_calld = static_cast<AdsCallState*>(arg);
+  ads_calld->xds_client()->combiner_->Run(
+      GRPC_CLOSURE_INIT(&ads_calld->on_request_sent_, OnRequestSentLocked,
+                        ads_calld, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+void XdsClient::ChannelState::AdsCallState::OnRequestSentLocked(
+    void* arg, grpc_error* error) {
+  AdsCallState* ads_calld = static_cast<AdsCallState*>(arg);
+  grpc_byte_buffer_destroy(ads_calld->send_message_payload_);
+  ads_calld->send_message_payload_ = nullptr;
+  if (error == GRPC_ERROR_NONE && ads_calld->IsCurrentCallOnChannel() &&
+      ads_calld->pending_ack_payload_ != nullptr) {
+    grpc_byte_buffer* payload = ads_calld->pending_ack_payload_;
+    ads_calld->pending_ack_payload_ = nullptr;
+    ads_calld->SendMessageLocked(payload);
+  }
+  ads_calld->Unref(DEBUG_LOCATION, "ADS+OnRequestSentLocked");
+}
+
+bool XdsClient::ChannelState::AdsCallState::HandleDeltaResponseLocked(
+    const grpc_slice& response_slice, EdsUpdate* update) {
+  XdsClient* xds_client = this->xds_client();
+  ClusterState& cluster_state = xds_client->cluster_state_;
+  EdsDeltaResponse delta_response;
+  grpc_error* parse_error = XdsEdsDeltaResponseDecodeAndParse(
+      response_slice, xds_client->server_name_.get(),
+      cluster_state.eds_version.get(), &delta_response);
+  if (parse_error == GRPC_ERROR_NONE && delta_response.updated &&
+      delta_response.update.priority_list_update.empty() &&
+      !delta_response.update.drop_all) {
+    parse_error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "EDS resource doesn't contain any valid locality but doesn't require "
+        "to drop all calls");
+  }
+  if (delta_response.nonce != nullptr) {
+    SendAckLocked(delta_response.nonce.get(), parse_error);
+  }
+  if (parse_error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "[xds_client %p] ADS response parsing failed. error=%s",
+            xds_client, grpc_error_string(parse_error));
+    GRPC_ERROR_UNREF(parse_error);
+    return false;
+  }
+  if (delta_response.removed) {
+    gpr_log(GPR_INFO, "[xds_client %p] EDS resource %s removed by server",
+            xds_client, xds_client->server_name_.get());
+    cluster_state.eds_update = EdsUpdate();
+    cluster_state.eds_version.reset();
+    grpc_error* error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "EDS resource removed by xds server");
+    for (const auto& p : cluster_state.endpoint_watchers) {
+      p.first->OnError(GRPC_ERROR_REF(error));
+    }
+    GRPC_ERROR_UNREF(error);
+    return false;
+  }
+  if (!delta_response.updated) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+      gpr_log(GPR_INFO,
+              "[xds_client %p] ADS response has no new version of %s, "
+              "ignoring.",
+              xds_client, xds_client->server_name_.get());
+    }
+    return false;
+  }
+  cluster_state.eds_version = std::move(delta_response.version);
+  *update = std::move(delta_response.update);
+  return true;
+}
+
 void XdsClient::ChannelState::AdsCallState::OnResponseReceived(
     void* arg, grpc_error* error) {
   AdsCallState* ads_calld = static_cast<AdsCallState*>(arg);
@@ -667,14 +805,20 @@ void XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked(
   [&]() {
     // Parse the response.
     EdsUpdate update;
-    grpc_error* parse_error =
-        XdsEdsResponseDecodeAndParse(response_slice, &update);
-    if (parse_error != GRPC_ERROR_NONE) {
-      gpr_log(GPR_ERROR,
-              "[xds_client %p] ADS response parsing failed. error=%s",
-              xds_client, grpc_error_string(parse_error));
-      GRPC_ERROR_UNREF(parse_error);
-      return;
+    if (xds_client->bootstrap_->incremental_xds()) {
+      if (!ads_calld->HandleDeltaResponseLocked(response_slice, &update)) {
+        return;
+      }
+    } else {
+      grpc_error* parse_error =
+          XdsEdsResponseDecodeAndParse(response_slice, &update);
+      if (parse_error != GRPC_ERROR_NONE) {
+        gpr_log(GPR_ERROR,
+                "[xds_client %p] ADS response parsing failed. error=%s",
+                xds_client, grpc_error_string(parse_error));
+        GRPC_ERROR_UNREF(parse_error);
+        return;
+      }
     }
     if (update.priority_list_update.empty() && !update.drop_all) {
       char* response_slice_str =
@@ -180,6 +180,8 @@ class XdsClient : public InternallyRefCounted<XdsClient> {
     std::set<XdsClientStats*> client_stats;
     // The latest data seen from EDS.
     EdsUpdate eds_update;
+    // The version of eds_update, if it came from incremental xDS.
+    grpc_core::UniquePtr<char> eds_version;
   };
 
   // Sends an error notification to all watchers.
@@ -47,11 +47,18 @@ bool XdsClientStats::LocalityStats::LoadMetric::Snapshot::IsAllZero() const {
 // XdsClientStats::LocalityStats::LoadMetric
 //
 
+void XdsClientStats::LocalityStats::LoadMetric::Record(double value) {
+  num_requests_finished_with_metric_.FetchAdd(1, MemoryOrder::RELAXED);
+  double total = total_metric_value_.Load(MemoryOrder::RELAXED);
+  while (!total_metric_value_.CompareExchangeWeak(
+      &total, total + value, MemoryOrder::RELAXED, MemoryOrder::RELAXED)) {
+  }
+}
+
 XdsClientStats::LocalityStats::LoadMetric::Snapshot
 XdsClientStats::LocalityStats::LoadMetric::GetSnapshotAndReset() {
-  Snapshot metric = {num_requests_finished_with_metric_, total_metric_value_};
-  num_requests_finished_with_metric_ = 0;
-  total_metric_value_ = 0;
+  Snapshot metric = {GetAndResetCounter(&num_requests_finished_with_metric_),
+                     GetAndResetCounter(&total_metric_value_)};
   return metric;
 }
 
@@ -84,16 +91,12 @@ XdsClientStats::LocalityStats::GetSnapshotAndReset() {
       total_requests_in_progress_.Load(MemoryOrder::RELAXED),
       GetAndResetCounter(&total_error_requests_),
       GetAndResetCounter(&total_issued_requests_)};
-  {
-    MutexLock lock(&load_metric_stats_mu_);
-    for (auto& p : load_metric_stats_) {
-      const char* metric_name = p.first.get();
-      LoadMetric& metric_value = p.second;
-      snapshot.load_metric_stats.emplace(
-          grpc_core::UniquePtr<char>(gpr_strdup(metric_name)),
-          metric_value.GetSnapshotAndReset());
-    }
-  }
+  load_metric_stats_.ForEach([&snapshot](const char* metric_name,
+                                        LoadMetric* metric_value) {
+    snapshot.load_metric_stats.emplace(
+        grpc_core::UniquePtr<char>(gpr_strdup(metric_name)),
+        metric_value->GetSnapshotAndReset());
+  });
   return snapshot;
 }
 
@@ -109,6 +112,11 @@ void XdsClientStats::LocalityStats::AddCallFinished(bool fail) {
   total_requests_in_progress_.FetchAdd(-1, MemoryOrder::ACQ_REL);
 }
 
+void XdsClientStats::LocalityStats::RecordLoadMetric(const char* metric_name,
+                                                     double value) {
+  load_metric_stats_.FindOrAdd(metric_name)->Record(value);
+}
+
 //
 // XdsClientStats::Snapshot
 //
@@ -141,14 +149,14 @@ XdsClientStats::Snapshot XdsClientStats::GetSnapshotAndReset() {
     snapshot.upstream_locality_stats.emplace(p.first,
                                              p.second->GetSnapshotAndReset());
   }
-  {
-    MutexLock lock(&dropped_requests_mu_);
-    // This is a workaround for the case where some compilers cannot build
-    // move-assignment of map with non-copyable but movable key.
-    // https://stackoverflow.com/questions/36475497
-    std::swap(snapshot.dropped_requests, dropped_requests_);
-    dropped_requests_.clear();
-  }
+  dropped_requests_.ForEach(
+      [&snapshot](const char* category, Atomic<uint64_t>* count) {
+        const uint64_t dropped = GetAndResetCounter(count);
+        if (dropped != 0) {
+          snapshot.dropped_requests.emplace(
+              grpc_core::UniquePtr<char>(gpr_strdup(category)), dropped);
+        }
+      });
   return snapshot;
 }
 
@@ -181,14 +189,8 @@ void XdsClientStats::PruneLocalityStats() {
 void XdsClientStats::AddCallDropped(
     const grpc_core::UniquePtr<char>& category) {
   total_dropped_requests_.FetchAdd(1, MemoryOrder::RELAXED);
-  MutexLock lock(&dropped_requests_mu_);
-  auto iter = dropped_requests_.find(category);
-  if (iter == dropped_requests_.end()) {
-    dropped_requests_.emplace(
-        grpc_core::UniquePtr<char>(gpr_strdup(category.get())), 1);
-  } else {
-    ++iter->second;
-  }
+  dropped_requests_.FindOrAdd(category.get())
+      ->FetchAdd(1, MemoryOrder::RELAXED);
 }
 
 }  // namespace grpc_core
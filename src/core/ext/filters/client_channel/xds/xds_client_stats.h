@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <string.h>
+
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gprpp/atomic.h"
@@ -80,16 +82,84 @@ class XdsLocalityName : public RefCounted<XdsLocalityName> {
   grpc_core::UniquePtr<char> human_readable_string_;
 };
 
+// An append-only list of stats keyed by name, in which entries are found or
+// added without taking a lock, so that it can be updated from the data plane.
+// Entries are freed only with the list. The names come from the xds config
+// (drop categories and backend metric names), so there are few of them.
+template <typename Stats>
+class XdsNamedStatsList {
+ public:
+  struct Entry {
+    explicit Entry(const char* entry_name) : name(gpr_strdup(entry_name)) {}
+
+    grpc_core::UniquePtr<char> name;
+    Stats stats;
+    Entry* next = nullptr;
+  };
+
+  XdsNamedStatsList() = default;
+  ~XdsNamedStatsList() {
+    Entry* entry = head_.Load(MemoryOrder::RELAXED);
+    while (entry != nullptr) {
+      Entry* next = entry->next;
+      delete entry;
+      entry = next;
+    }
+  }
+
+  XdsNamedStatsList(const XdsNamedStatsList&) = delete;
+  XdsNamedStatsList& operator=(const XdsNamedStatsList&) = delete;
+
+  Stats* FindOrAdd(const char* name) {
+    Entry* head = head_.Load(MemoryOrder::ACQUIRE);
+    Entry* found = Find(head, nullptr, name);
+    if (found != nullptr) return &found->stats;
+    Entry* new_entry = new Entry(name);
+    new_entry->next = head;
+    while (!head_.CompareExchangeWeak(&new_entry->next, new_entry,
+                                      MemoryOrder::ACQ_REL,
+                                      MemoryOrder::ACQUIRE)) {
+      // Someone else added entries; only those can have the same name.
+      found = Find(new_entry->next, head, name);
+      if (found != nullptr) {
+        delete new_entry;
+        return &found->stats;
+      }
+      head = new_entry->next;
+    }
+    return &new_entry->stats;
+  }
+
+  // Only entries added before the call are visited.
+  template <typename F>
+  void ForEach(F f) {
+    for (Entry* entry = head_.Load(MemoryOrder::ACQUIRE); entry != nullptr;
+         entry = entry->next) {
+      f(entry->name.get(), &entry->stats);
+    }
+  }
+
+ private:
+  // Searches the entries from begin up to, but not including, end.
+  static Entry* Find(Entry* begin, Entry* end, const char* name) {
+    for (Entry* entry = begin; entry != end; entry = entry->next) {
+      if (strcmp(entry->name.get(), name) == 0) return entry;
+    }
+    return nullptr;
+  }
+
+  Atomic<Entry*> head_{nullptr};
+};
+
 // The stats classes (i.e., XdsClientStats, LocalityStats, and LoadMetric) can
 // be taken a snapshot (and reset) to populate the load report. The snapshots
 // are contained in the respective Snapshot structs. The Snapshot structs have
 // no synchronization. The stats classes use several different synchronization
-// methods. 1. Most of the counters are Atomic<>s for performance. 2. Some of
-// the Map<>s are protected by Mutex if we are not guaranteed that the accesses
-// to them are synchronized by the callers. 3. The Map<>s to which the accesses
-// are already synchronized by the callers do not have additional
-// synchronization here. Note that the Map<>s we mentioned in 2 and 3 refer to
-// the map's tree structure rather than the content in each tree node.
+// methods. 1. The counters are Atomic<>s, so that the data plane never takes a
+// lock to record a call. 2. The per-name stats updated from the data plane are
+// kept in XdsNamedStatsList<>s, whose entries are found or added lock-free.
+// 3. The Map<>s to which the accesses are already synchronized by the callers
+// do not have additional synchronization here.
 class XdsClientStats {
  public:
   class LocalityStats : public RefCounted<LocalityStats> {
@@ -103,17 +173,17 @@ class XdsClientStats {
         double total_metric_value;
       };
 
+      void Record(double value);
+
       // Returns a snapshot of this instance and reset all the accumulative
       // counters.
       Snapshot GetSnapshotAndReset();
 
      private:
-      uint64_t num_requests_finished_with_metric_{0};
-      double total_metric_value_{0};
+      Atomic<uint64_t> num_requests_finished_with_metric_{0};
+      Atomic<double> total_metric_value_{0};
     };
 
-    using LoadMetricMap =
-        std::map<grpc_core::UniquePtr<char>, LoadMetric, StringLess>;
     using LoadMetricSnapshotMap =
         std::map<grpc_core::UniquePtr<char>, LoadMetric::Snapshot, StringLess>;
 
@@ -159,6 +229,8 @@ class XdsClientStats {
 
     void AddCallStarted();
     void AddCallFinished(bool fail = false);
+    // Records a backend metric reported for a finished call.
+    void RecordLoadMetric(const char* metric_name, double value);
 
    private:
     Atomic<uint64_t> total_successful_requests_{0};
@@ -166,12 +238,10 @@ class XdsClientStats {
     // Requests that were issued (not dropped) but failed.
     Atomic<uint64_t> total_error_requests_{0};
     Atomic<uint64_t> total_issued_requests_{0};
-    // Protects load_metric_stats_. A mutex is necessary because the length of
-    // load_metric_stats_ can be accessed by both the callback intercepting the
-    // call's recv_trailing_metadata (not from any combiner) and the load
-    // reporting thread (from the control plane combiner).
-    Mutex load_metric_stats_mu_;
-    LoadMetricMap load_metric_stats_;
+    // Updated by the callback intercepting the call's recv_trailing_metadata
+    // (not from any combiner) and read by the load reporting thread (from the
+    // control plane combiner).
+    XdsNamedStatsList<LoadMetric> load_metric_stats_;
     // Can be accessed from either the control plane combiner or the data plane
     // combiner.
     Atomic<uint8_t> picker_refcount_{0};
@@ -217,11 +287,9 @@ class XdsClientStats {
   // The stats for each locality.
   LocalityStatsMap upstream_locality_stats_;
   Atomic<uint64_t> total_dropped_requests_{0};
-  // Protects dropped_requests_. A mutex is necessary because the length of
-  // dropped_requests_ can be accessed by both the picker (from data plane
-  // combiner) and the load reporting thread (from the control plane combiner).
-  Mutex dropped_requests_mu_;
-  DroppedRequestsMap dropped_requests_;
+  // Updated by the picker (from data plane combiner) and read by the load
+  // reporting thread (from the control plane combiner).
+  XdsNamedStatsList<Atomic<uint64_t>> dropped_requests_;
   // The timestamp of last reporting. For the LB-policy-wide first report, the
   // last_report_time is the time we scheduled the first reporting timer.
   grpc_millis last_report_time_ = -1;
@@ -20,9 +20,12 @@
 
 #include <limits.h>
 
+#include <grpc/support/cpu.h>
+
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/surface/channel_init.h"
 #include "src/core/lib/transport/http2_errors.h"
@@ -47,74 +50,38 @@ TraceFlag grpc_trace_client_idle_filter(false, "client_idle_filter");
 namespace {
 
 /*
-  client_idle_filter maintains a state tracking if there are active calls in the
-  channel and its internal idle_timer_. The states are specified as following:
-
-  +--------------------------------------------+-------------+---------+
-  |               ChannelState                 | idle_timer_ | channel |
-  +--------------------------------------------+-------------+---------+
-  | IDLE                                       | unset       | idle    |
-  | CALLS_ACTIVE                               | unset       | busy    |
-  | TIMER_PENDING                              | set-valid   | idle    |
-  | TIMER_PENDING_CALLS_ACTIVE                 | set-invalid | busy    |
-  | TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START | set-invalid | idle    |
-  +--------------------------------------------+-------------+---------+
-
-  IDLE: The initial state of the client_idle_filter, indicating the channel is
-  in IDLE.
-
-  CALLS_ACTIVE: The channel has 1 or 1+ active calls and the timer is not set.
-
-  TIMER_PENDING: The state after the timer is set and no calls have arrived
-  after the timer is set. The channel must have 0 active call in this state. If
-  the timer is fired in this state, the channel will go into IDLE state.
-
-  TIMER_PENDING_CALLS_ACTIVE: The state after the timer is set and at least one
-  call has arrived after the timer is set. The channel must have 1 or 1+ active
-  calls in this state. If the timer is fired in this state, we won't reschedule
-  it.
-
-  TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START: The state after the timer is set
-  and at least one call has arrived after the timer is set, BUT the channel
-  currently has 0 active call. If the timer is fired in this state, we will
-  reschedule it according to the finish time of the latest call.
-
-  PROCESSING: The state set to block other threads when the setting thread is
-  doing some work to keep state consistency.
-
-  idle_timer_ will not be cancelled (unless the channel is shutting down).
-  If the timer callback is called when the idle_timer_ is valid (i.e. idle_state
-  is TIMER_PENDING), the channel will enter IDLE, otherwise the channel won't be
-  changed.
-
-  State transitions:
-                                            IDLE
-                                            |  ^
-            ---------------------------------  *
-            |                                  *
-            v                                  *
-      CALLS_ACTIVE =================> TIMER_PENDING
-            ^                               |  ^
-            *  ------------------------------  *
-            *  |                               *
-            *  v                               *
-TIMER_PENDING_CALLS_ACTIVE ===> TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START
-            ^                               |
-            |                               |
-            ---------------------------------
-
-  ---> Triggered by IncreaseCallCount()
-  ===> Triggered by DecreaseCallCount()
-  ***> Triggered by IdleTimerCallback()
+  client_idle_filter counts the calls of the channel in stripes picked by CPU,
+  so that calls starting and finishing on different cores rarely touch the
+  same cache line. A call may finish on another CPU than the one it started
+  on, so only the sums over all stripes are meaningful.
+
+  Whether the channel has gone idle is only checked by idle_timer_, which is
+  set whenever the channel is not IDLE:
+  - If calls are active, the channel cannot go idle before a full timeout from
+    now, so the timer is set again for then.
+  - If no calls are active, the channel goes idle once the timeout has passed
+    since the latest call finished, and the timer is set again for that time
+    if it has not.
+
+  The states of the channel are:
+
+  IDLE: The initial state, indicating the channel is in IDLE. The timer is not
+  set. The first call to start moves the channel to ACTIVE and sets the timer.
+
+  ACTIVE: The timer is set. Calls starting and finishing only touch their
+  stripe, and read state_.
+
+  ENTERING_IDLE: The timer callback found no active calls, and is making sure
+  of that before telling the channel to enter IDLE. It holds timer_mu_
+  throughout, and calls that start meanwhile block on timer_mu_ until it
+  finishes.
+
+  Calls add themselves to their stripe before reading state_, and the timer
+  callback sets ENTERING_IDLE before counting the calls again. Either the
+  second count sees a call, or the call sees ENTERING_IDLE and waits, so the
+  channel never enters IDLE with active calls.
 */
-enum ChannelState {
-  IDLE,
-  CALLS_ACTIVE,
-  TIMER_PENDING,
-  TIMER_PENDING_CALLS_ACTIVE,
-  TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START,
-  PROCESSING
-};
+enum ChannelState { IDLE, ACTIVE, ENTERING_IDLE };
 
 grpc_millis GetClientIdleTimeout(const grpc_channel_args* args) {
   return GPR_MAX(
@@ -138,14 +105,33 @@ class ChannelData {
   void DecreaseCallCount();
 
  private:
+  static constexpr size_t kStripes = 16;
+
+  struct Stripe {
+    Atomic<intptr_t> calls_started{0};
+    Atomic<intptr_t> calls_finished{0};
+    // When the latest call counted in this stripe finished.
+    Atomic<grpc_millis> last_finish_time{0};
+    char padding[GPR_CACHELINE_SIZE - 2 * sizeof(Atomic<intptr_t>) -
+                 sizeof(Atomic<grpc_millis>)];
+  };
+
   ChannelData(grpc_channel_element* elem, grpc_channel_element_args* args,
               grpc_error** error);
-  ~ChannelData() = default;
+  ~ChannelData() { gpr_mu_destroy(&timer_mu_); }
 
   static void IdleTimerCallback(void* arg, grpc_error* error);
   static void IdleTransportOpCompleteCallback(void* arg, grpc_error* error);
 
-  void StartIdleTimer();
+  Stripe* CurrentStripe() {
+    return &stripes_[gpr_cpu_current_cpu() % kStripes];
+  }
+
+  // Returns the number of active calls, and sets *last_finish_time to when
+  // the latest call finished.
+  intptr_t CountActiveCalls(grpc_millis* last_finish_time);
+
+  void StartIdleTimerLocked(grpc_millis deadline);
 
   void EnterIdle();
 
@@ -157,10 +143,17 @@ class ChannelData {
   const grpc_millis client_idle_timeout_;
 
   // Member data used to track the state of channel.
-  grpc_millis last_idle_time_;
-  Atomic<intptr_t> call_count_{0};
+  Stripe stripes_[kStripes];
+  // Read by every call, but only written when the channel enters or leaves
+  // IDLE.
   Atomic<ChannelState> state_{IDLE};
 
+  // Serializes setting the idle timer and entering IDLE with shutting down.
+  // Never taken by calls, except the one that moves the channel out of IDLE
+  // and the ones that start while the channel is ENTERING_IDLE.
+  gpr_mu timer_mu_;
+  bool shutdown_ = false;
+
   // Idle timer and its callback closure.
   grpc_timer idle_timer_;
   grpc_closure idle_timer_callback_;
@@ -170,6 +163,8 @@ class ChannelData {
   grpc_closure idle_transport_op_complete_callback_;
 };
 
+constexpr size_t ChannelData::kStripes;
+
 grpc_error* ChannelData::Init(grpc_channel_element* elem,
                               grpc_channel_element_args* args) {
   grpc_error* error = GRPC_ERROR_NONE;
@@ -187,12 +182,11 @@ void ChannelData::StartTransportOp(grpc_channel_element* elem,
   ChannelData* chand = static_cast<ChannelData*>(elem->channel_data);
   // Catch the disconnect_with_error transport op.
   if (op->disconnect_with_error != nullptr) {
-    // IncreaseCallCount() introduces a dummy call and prevent the timer from
-    // being reset by other threads.
-    chand->IncreaseCallCount();
-    // If the timer has been set, cancel the timer.
-    // No synchronization issues here. grpc_timer_cancel() is valid as long as
+    // Keep the timer from being set again or entering IDLE after this, and
+    // cancel it if it has been set. grpc_timer_cancel() is valid as long as
     // the timer has been init()ed before.
+    MutexLock lock(&chand->timer_mu_);
+    chand->shutdown_ = true;
     grpc_timer_cancel(&chand->idle_timer_);
   }
   // Pass the op to the next filter.
@@ -200,85 +194,52 @@ void ChannelData::StartTransportOp(grpc_channel_element* elem,
 }
 
 void ChannelData::IncreaseCallCount() {
-  const intptr_t previous_value = call_count_.FetchAdd(1, MemoryOrder::RELAXED);
-  GRPC_IDLE_FILTER_LOG("call counter has increased to %" PRIuPTR,
-                       previous_value + 1);
-  if (previous_value == 0) {
-    // This call is the one that makes the channel busy.
-    // Loop here to make sure the previous decrease operation has finished.
-    ChannelState state = state_.Load(MemoryOrder::RELAXED);
-    while (true) {
-      switch (state) {
-        // Timer has not been set. Switch to CALLS_ACTIVE.
-        case IDLE:
-          // In this case, no other threads will modify the state, so we can
-          // just store the value.
-          state_.Store(CALLS_ACTIVE, MemoryOrder::RELAXED);
-          return;
-        // Timer has been set. Switch to TIMER_PENDING_CALLS_ACTIVE.
-        case TIMER_PENDING:
-        case TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START:
-          // At this point, the state may have been switched to IDLE by the
-          // idle timer callback. Therefore, use CAS operation to change the
-          // state atomically.
-          // Use MemoryOrder::ACQUIRE on success to ensure last_idle_time_ has
-          // been properly set in DecreaseCallCount().
-          if (state_.CompareExchangeWeak(&state, TIMER_PENDING_CALLS_ACTIVE,
-                                         MemoryOrder::ACQUIRE,
-                                         MemoryOrder::RELAXED)) {
-            return;
-          }
-          break;
-        default:
-          // The state has not been switched to desired value yet, try again.
-          state = state_.Load(MemoryOrder::RELAXED);
-          break;
+  CurrentStripe()->calls_started.FetchAdd(1, MemoryOrder::SEQ_CST);
+  ChannelState state = state_.Load(MemoryOrder::SEQ_CST);
+  while (GPR_UNLIKELY(state != ACTIVE)) {
+    if (state == IDLE) {
+      // This call is the one that makes the channel busy.
+      if (state_.CompareExchangeWeak(&state, ACTIVE, MemoryOrder::SEQ_CST,
+                                     MemoryOrder::SEQ_CST)) {
+        GRPC_IDLE_FILTER_LOG("the channel is no longer idle");
+        MutexLock lock(&timer_mu_);
+        StartIdleTimerLocked(ExecCtx::Get()->Now() + client_idle_timeout_);
+        return;
       }
+    } else {
+      // The timer callback is entering IDLE, under timer_mu_. Once it is
+      // released, the channel is either ACTIVE or IDLE again.
+      MutexLock lock(&timer_mu_);
+      state = state_.Load(MemoryOrder::SEQ_CST);
     }
   }
 }
 
 void ChannelData::DecreaseCallCount() {
-  const intptr_t previous_value = call_count_.FetchSub(1, MemoryOrder::RELAXED);
-  GRPC_IDLE_FILTER_LOG("call counter has decreased to %" PRIuPTR,
-                       previous_value - 1);
-  if (previous_value == 1) {
-    // This call is the one that makes the channel idle.
-    // last_idle_time_ does not need to be Atomic<> because busy-loops in
-    // IncreaseCallCount(), DecreaseCallCount() and IdleTimerCallback() will
-    // prevent multiple threads from simultaneously accessing this variable.
-    last_idle_time_ = ExecCtx::Get()->Now();
-    ChannelState state = state_.Load(MemoryOrder::RELAXED);
-    while (true) {
-      switch (state) {
-        // Timer has not been set. Set the timer and switch to TIMER_PENDING
-        case CALLS_ACTIVE:
-          // Release store here to make other threads see the updated value of
-          // last_idle_time_.
-          StartIdleTimer();
-          state_.Store(TIMER_PENDING, MemoryOrder::RELEASE);
-          return;
-        // Timer has been set. Switch to
-        // TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START
-        case TIMER_PENDING_CALLS_ACTIVE:
-          // At this point, the state may have been switched to CALLS_ACTIVE by
-          // the idle timer callback. Therefore, use CAS operation to change the
-          // state atomically.
-          // Release store here to make the idle timer callback see the updated
-          // value of last_idle_time_ to properly reset the idle timer.
-          if (state_.CompareExchangeWeak(
-                  &state, TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START,
-                  MemoryOrder::RELEASE, MemoryOrder::RELAXED)) {
-            return;
-          }
-          break;
-        default:
-          // The state has not been switched to desired value yet, try again.
-          state = state_.Load(MemoryOrder::RELAXED);
-          break;
-      }
-    }
+  Stripe* stripe = CurrentStripe();
+  stripe->last_finish_time.Store(ExecCtx::Get()->Now(), MemoryOrder::RELAXED);
+  stripe->calls_finished.FetchAdd(1, MemoryOrder::SEQ_CST);
+}
+
+intptr_t ChannelData::CountActiveCalls(grpc_millis* last_finish_time) {
+  // Finished calls are summed before started ones. A call counted as
+  // finished was started before, so a call is either counted as active or
+  // not counted at all.
+  intptr_t calls_finished = 0;
+  *last_finish_time = 0;
+  for (size_t i = 0; i < kStripes; ++i) {
+    calls_finished += stripes_[i].calls_finished.Load(MemoryOrder::SEQ_CST);
+    *last_finish_time =
+        GPR_MAX(*last_finish_time,
+                stripes_[i].last_finish_time.Load(MemoryOrder::RELAXED));
+  }
+  intptr_t calls_started = 0;
+  for (size_t i = 0; i < kStripes; ++i) {
+    calls_started += stripes_[i].calls_started.Load(MemoryOrder::SEQ_CST);
   }
+  GRPC_IDLE_FILTER_LOG("%" PRIdPTR " active calls",
+                       calls_started - calls_finished);
+  return calls_started - calls_finished;
 }
 
 ChannelData::ChannelData(grpc_channel_element* elem,
@@ -292,6 +253,7 @@ ChannelData::ChannelData(grpc_channel_element* elem,
   GPR_ASSERT(client_idle_timeout_ != GRPC_MILLIS_INF_FUTURE);
   GRPC_IDLE_FILTER_LOG("created with max_leisure_time = %" PRId64 " ms",
                        client_idle_timeout_);
+  gpr_mu_init(&timer_mu_);
   // Initialize the idle timer without setting it.
   grpc_timer_init_unset(&idle_timer_);
   // Initialize the idle timer callback closure.
@@ -311,40 +273,24 @@ void ChannelData::IdleTimerCallback(void* arg, grpc_error* error) {
     GRPC_CHANNEL_STACK_UNREF(chand->channel_stack_, "max idle timer callback");
     return;
   }
-  bool finished = false;
-  ChannelState state = chand->state_.Load(MemoryOrder::RELAXED);
-  while (!finished) {
-    switch (state) {
-      case TIMER_PENDING:
-        // Change the state to PROCESSING to block IncreaseCallCout() until the
-        // EnterIdle() operation finishes, preventing mistakenly entering IDLE
-        // when active RPC exists.
-        finished = chand->state_.CompareExchangeWeak(
-            &state, PROCESSING, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED);
-        if (finished) {
-          chand->EnterIdle();
-          chand->state_.Store(IDLE, MemoryOrder::RELAXED);
-        }
-        break;
-      case TIMER_PENDING_CALLS_ACTIVE:
-        finished = chand->state_.CompareExchangeWeak(
-            &state, CALLS_ACTIVE, MemoryOrder::RELAXED, MemoryOrder::RELAXED);
-        break;
-      case TIMER_PENDING_CALLS_SEEN_SINCE_TIMER_START:
-        // Change the state to PROCESSING to block IncreaseCallCount() until the
-        // StartIdleTimer() operation finishes, preventing mistakenly restarting
-        // the timer after grpc_timer_cancel() when shutdown.
-        finished = chand->state_.CompareExchangeWeak(
-            &state, PROCESSING, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED);
-        if (finished) {
-          chand->StartIdleTimer();
-          chand->state_.Store(TIMER_PENDING, MemoryOrder::RELAXED);
-        }
-        break;
-      default:
-        // The state has not been switched to desired value yet, try again.
-        state = chand->state_.Load(MemoryOrder::RELAXED);
-        break;
+  {
+    MutexLock lock(&chand->timer_mu_);
+    const grpc_millis now = ExecCtx::Get()->Now();
+    grpc_millis last_finish_time;
+    if (chand->CountActiveCalls(&last_finish_time) > 0) {
+      chand->StartIdleTimerLocked(now + chand->client_idle_timeout_);
+    } else if (last_finish_time + chand->client_idle_timeout_ > now) {
+      chand->StartIdleTimerLocked(last_finish_time +
+                                  chand->client_idle_timeout_);
+    } else if (!chand->shutdown_) {
+      chand->state_.Store(ENTERING_IDLE, MemoryOrder::SEQ_CST);
+      if (chand->CountActiveCalls(&last_finish_time) == 0) {
+        chand->EnterIdle();
+        chand->state_.Store(IDLE, MemoryOrder::SEQ_CST);
+      } else {
+        chand->state_.Store(ACTIVE, MemoryOrder::SEQ_CST);
+        chand->StartIdleTimerLocked(now + chand->client_idle_timeout_);
+      }
     }
   }
   GRPC_IDLE_FILTER_LOG("timer finishes");
@@ -357,12 +303,12 @@ void ChannelData::IdleTransportOpCompleteCallback(void* arg,
   GRPC_CHANNEL_STACK_UNREF(chand->channel_stack_, "idle transport op");
 }
 
-void ChannelData::StartIdleTimer() {
+void ChannelData::StartIdleTimerLocked(grpc_millis deadline) {
+  if (shutdown_) return;
   GRPC_IDLE_FILTER_LOG("timer has started");
   // Hold a ref to the channel stack for the timer callback.
   GRPC_CHANNEL_STACK_REF(channel_stack_, "max idle timer callback");
-  grpc_timer_init(&idle_timer_, last_idle_time_ + client_idle_timeout_,
-                  &idle_timer_callback_);
+  grpc_timer_init(&idle_timer_, deadline, &idle_timer_callback_);
 }
 
 void ChannelData::EnterIdle() {
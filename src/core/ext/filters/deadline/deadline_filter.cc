@@ -27,6 +27,7 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -36,6 +37,11 @@
 // grpc_deadline_state
 //
 
+// Deadline timers are allowed to fire up to 1/32 of the remaining time late,
+// capped at 100ms, so that calls with nearby deadlines share a timer.
+#define DEADLINE_TIMER_SLACK_DIVISOR 32
+#define DEADLINE_TIMER_MAX_SLACK_MS 100
+
 // The on_complete callback used when sending a cancel_error batch down the
 // filter stack.  Yields the call combiner when the batch returns.
 static void yield_call_combiner(void* arg, grpc_error* /*ignored*/) {
@@ -59,15 +65,18 @@ static void send_cancel_op_in_call_combiner(void* arg, grpc_error* error) {
   elem->filter->start_transport_stream_op_batch(elem, batch);
 }
 
+// Shared by every call whose deadline fires, so that expiring does not
+// allocate.
+static grpc_error_status_only g_deadline_exceeded = GRPC_ERROR_STATUS_ONLY_INIT(
+    "Deadline Exceeded", GRPC_STATUS_DEADLINE_EXCEEDED);
+
 // Timer callback.
 static void timer_callback(void* arg, grpc_error* error) {
   grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
   grpc_deadline_state* deadline_state =
       static_cast<grpc_deadline_state*>(elem->call_data);
   if (error != GRPC_ERROR_CANCELLED) {
-    error = grpc_error_set_int(
-        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Deadline Exceeded"),
-        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_DEADLINE_EXCEEDED);
+    error = grpc_error_from_status_only(&g_deadline_exceeded);
     deadline_state->call_combiner->Cancel(GRPC_ERROR_REF(error));
     GRPC_CLOSURE_INIT(&deadline_state->timer_callback,
                       send_cancel_op_in_call_combiner, elem,
@@ -112,7 +121,18 @@ static void start_timer_if_needed(grpc_call_element* elem,
   }
   GPR_ASSERT(closure != nullptr);
   GRPC_CALL_STACK_REF(deadline_state->call_stack, "deadline_timer");
-  grpc_timer_init(&deadline_state->timer, deadline, closure);
+  const grpc_millis slack =
+      GPR_CLAMP((deadline - grpc_core::ExecCtx::Get()->Now()) /
+                    DEADLINE_TIMER_SLACK_DIVISOR,
+                0, DEADLINE_TIMER_MAX_SLACK_MS);
+  if (deadline_state->use_wheel) {
+    grpc_core::DeadlineWheel::Start(&deadline_state->wheel_entry,
+                                    &deadline_state->timer, deadline, slack,
+                                    closure);
+  } else {
+    grpc_timer_init_with_slack(&deadline_state->timer, deadline, slack,
+                               closure);
+  }
 }
 
 // Cancels the deadline timer.
@@ -121,7 +141,11 @@ static void start_timer_if_needed(grpc_call_element* elem,
 static void cancel_timer_if_needed(grpc_deadline_state* deadline_state) {
   if (deadline_state->timer_state == GRPC_DEADLINE_STATE_PENDING) {
     deadline_state->timer_state = GRPC_DEADLINE_STATE_FINISHED;
-    grpc_timer_cancel(&deadline_state->timer);
+    if (deadline_state->use_wheel) {
+      grpc_core::DeadlineWheel::Cancel(&deadline_state->wheel_entry);
+    } else {
+      grpc_timer_cancel(&deadline_state->timer);
+    }
   } else {
     // timer was either in STATE_INITIAL (nothing to cancel)
     // OR in STATE_FINISHED (again nothing to cancel)
@@ -184,8 +208,11 @@ static void start_timer_after_init(void* arg, grpc_error* error) {
 grpc_deadline_state::grpc_deadline_state(grpc_call_element* elem,
                                          grpc_call_stack* call_stack,
                                          grpc_core::CallCombiner* call_combiner,
-                                         grpc_millis deadline)
-    : call_stack(call_stack), call_combiner(call_combiner) {
+                                         grpc_millis deadline,
+                                         bool use_wheel)
+    : call_stack(call_stack),
+      call_combiner(call_combiner),
+      use_wheel(use_wheel) {
   // Deadline will always be infinite on servers, so the timer will only be
   // set on clients with a finite deadline.
   if (deadline != GRPC_MILLIS_INF_FUTURE) {
@@ -233,10 +260,17 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
 // filter code
 //
 
+// Channel data used for both client and server filter.
+typedef struct channel_data {
+  bool use_wheel;
+} channel_data;
+
 // Constructor for channel_data.  Used for both client and server filters.
-static grpc_error* deadline_init_channel_elem(grpc_channel_element* /*elem*/,
+static grpc_error* deadline_init_channel_elem(grpc_channel_element* elem,
                                               grpc_channel_element_args* args) {
   GPR_ASSERT(!args->is_last);
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  chand->use_wheel = grpc_deadline_wheel_enabled(args->channel_args);
   return GRPC_ERROR_NONE;
 }
 
@@ -263,8 +297,10 @@ typedef struct server_call_data {
 // Constructor for call_data.  Used for both client and server filters.
 static grpc_error* deadline_init_call_elem(grpc_call_element* elem,
                                            const grpc_call_element_args* args) {
-  new (elem->call_data) grpc_deadline_state(
-      elem, args->call_stack, args->call_combiner, args->deadline);
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  new (elem->call_data)
+      grpc_deadline_state(elem, args->call_stack, args->call_combiner,
+                          args->deadline, chand->use_wheel);
   return GRPC_ERROR_NONE;
 }
 
@@ -337,7 +373,7 @@ const grpc_channel_filter grpc_client_deadline_filter = {
     deadline_init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     deadline_destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     deadline_init_channel_elem,
     deadline_destroy_channel_elem,
     grpc_channel_next_get_info,
@@ -351,7 +387,7 @@ const grpc_channel_filter grpc_server_deadline_filter = {
     deadline_init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     deadline_destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     deadline_init_channel_elem,
     deadline_destroy_channel_elem,
     grpc_channel_next_get_info,
@@ -364,6 +400,11 @@ bool grpc_deadline_checking_enabled(const grpc_channel_args* channel_args) {
       !grpc_channel_args_want_minimal_stack(channel_args));
 }
 
+bool grpc_deadline_wheel_enabled(const grpc_channel_args* channel_args) {
+  return grpc_channel_arg_get_bool(
+      grpc_channel_args_find(channel_args, GRPC_ARG_DEADLINE_WHEEL), false);
+}
+
 static bool maybe_add_deadline_filter(grpc_channel_stack_builder* builder,
                                       void* arg) {
   return grpc_deadline_checking_enabled(
@@ -19,6 +19,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/ext/filters/deadline/deadline_wheel.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/iomgr/timer.h"
 
@@ -33,7 +34,7 @@ enum grpc_deadline_timer_state {
 struct grpc_deadline_state {
   grpc_deadline_state(grpc_call_element* elem, grpc_call_stack* call_stack,
                       grpc_core::CallCombiner* call_combiner,
-                      grpc_millis deadline);
+                      grpc_millis deadline, bool use_wheel);
   ~grpc_deadline_state();
 
   // We take a reference to the call stack for the timer callback.
@@ -41,6 +42,9 @@ struct grpc_deadline_state {
   grpc_core::CallCombiner* call_combiner;
   grpc_deadline_timer_state timer_state = GRPC_DEADLINE_STATE_INITIAL;
   grpc_timer timer;
+  // Set when far away deadlines wait in the grpc_core::DeadlineWheel.
+  bool use_wheel;
+  grpc_core::DeadlineWheel::Entry wheel_entry;
   grpc_closure timer_callback;
   // Closure to invoke when we receive trailing metadata.
   // We use this to cancel the timer.
@@ -81,6 +85,10 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
 // Should deadline checking be performed (according to channel args)
 bool grpc_deadline_checking_enabled(const grpc_channel_args* args);
 
+// Should far away deadlines wait in the deadline wheel (according to channel
+// args)
+bool grpc_deadline_wheel_enabled(const grpc_channel_args* args);
+
 // Deadline filters for direct client channels and server channels.
 // Note: Deadlines for non-direct client channels are handled by the
 // client_channel filter.
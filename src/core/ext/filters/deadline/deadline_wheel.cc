@@ -0,0 +1,166 @@
+//
+// Copyright 2019 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/deadline/deadline_wheel.h"
+
+#include <map>
+
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/sync.h"
+
+// Buckets are this wide, and fire at least this long before the earliest
+// deadline they hold, so that entries get their own timer in time.
+#define DEADLINE_WHEEL_GRANULARITY_MS 1000
+#define DEADLINE_WHEEL_LEAD_MS 1000
+// Calls are spread over this many independently locked sets of buckets.
+#define DEADLINE_WHEEL_NUM_SHARDS 16
+
+namespace grpc_core {
+
+class DeadlineWheel::Bucket {
+ public:
+  Bucket(size_t shard, grpc_millis fire_time)
+      : shard_(shard), fire_time_(fire_time) {
+    GRPC_CLOSURE_INIT(&on_timer_, OnBucketTimer, this,
+                      grpc_schedule_on_exec_ctx);
+  }
+
+ private:
+  friend class DeadlineWheel;
+
+  const size_t shard_;
+  const grpc_millis fire_time_;
+  grpc_timer timer_;
+  grpc_closure on_timer_;
+  Entry* entries_ = nullptr;
+};
+
+namespace {
+
+// The wheel lives as long as the process: bucket timers may still fire
+// while grpc shuts down.
+struct Shard {
+  gpr_mu mu;
+  std::map<grpc_millis, DeadlineWheel::Bucket*> buckets;
+};
+
+gpr_once g_once = GPR_ONCE_INIT;
+Shard* g_shards;
+
+void init_wheel() {
+  g_shards = new Shard[DEADLINE_WHEEL_NUM_SHARDS];
+  for (size_t i = 0; i < DEADLINE_WHEEL_NUM_SHARDS; ++i) {
+    gpr_mu_init(&g_shards[i].mu);
+  }
+}
+
+}  // namespace
+
+void DeadlineWheel::Start(Entry* entry, grpc_timer* timer,
+                          grpc_millis deadline, grpc_millis slack,
+                          grpc_closure* on_deadline) {
+  gpr_once_init(&g_once, init_wheel);
+  entry->timer_ = timer;
+  entry->deadline_ = deadline;
+  entry->slack_ = slack;
+  entry->on_deadline_ = on_deadline;
+  entry->shard_ = GPR_HASH_POINTER(entry, DEADLINE_WHEEL_NUM_SHARDS);
+  Shard* shard = &g_shards[entry->shard_];
+  const grpc_millis fire_time =
+      (deadline - DEADLINE_WHEEL_LEAD_MS) / DEADLINE_WHEEL_GRANULARITY_MS *
+      DEADLINE_WHEEL_GRANULARITY_MS;
+  MutexLock lock(&shard->mu);
+  GPR_ASSERT(entry->bucket_ == nullptr && !entry->armed_);
+  if (fire_time <= ExecCtx::Get()->Now()) {
+    // Too close to be worth parking.
+    entry->armed_ = true;
+    grpc_timer_init_with_slack(timer, deadline, slack, on_deadline);
+    return;
+  }
+  Bucket*& bucket = shard->buckets[fire_time];
+  if (bucket == nullptr) {
+    bucket = new Bucket(entry->shard_, fire_time);
+    grpc_timer_init(&bucket->timer_, fire_time, &bucket->on_timer_);
+  }
+  entry->bucket_ = bucket;
+  entry->prev_ = nullptr;
+  entry->next_ = bucket->entries_;
+  if (bucket->entries_ != nullptr) bucket->entries_->prev_ = entry;
+  bucket->entries_ = entry;
+}
+
+void DeadlineWheel::Cancel(Entry* entry) {
+  gpr_once_init(&g_once, init_wheel);
+  Shard* shard = &g_shards[entry->shard_];
+  bool was_armed;
+  {
+    MutexLock lock(&shard->mu);
+    Bucket* bucket = entry->bucket_;
+    was_armed = entry->armed_;
+    entry->armed_ = false;
+    if (bucket == nullptr) {
+      if (!was_armed) return;
+    } else {
+      if (entry->prev_ != nullptr) {
+        entry->prev_->next_ = entry->next_;
+      } else {
+        bucket->entries_ = entry->next_;
+      }
+      if (entry->next_ != nullptr) entry->next_->prev_ = entry->prev_;
+      entry->bucket_ = nullptr;
+      // An emptied bucket is left to fire: its timer may be shared with
+      // calls that start later, and cancelling it costs as much as firing.
+    }
+  }
+  if (was_armed) {
+    grpc_timer_cancel(entry->timer_);
+  } else {
+    ExecCtx::Run(DEBUG_LOCATION, entry->on_deadline_, GRPC_ERROR_CANCELLED);
+  }
+}
+
+void DeadlineWheel::OnBucketTimer(void* arg, grpc_error* error) {
+  Bucket* bucket = static_cast<Bucket*>(arg);
+  Shard* shard = &g_shards[bucket->shard_];
+  {
+    MutexLock lock(&shard->mu);
+    shard->buckets.erase(bucket->fire_time_);
+    for (Entry* entry = bucket->entries_; entry != nullptr;
+         entry = entry->next_) {
+      entry->bucket_ = nullptr;
+      if (error == GRPC_ERROR_NONE) {
+        // Armed under the lock, so that Cancel() sees either the bucket or
+        // a timer it can cancel.
+        entry->armed_ = true;
+        grpc_timer_init_with_slack(entry->timer_, entry->deadline_,
+                                   entry->slack_, entry->on_deadline_);
+      } else {
+        // The timer system is shutting down: pass that on, as the timer
+        // would have.
+        ExecCtx::Run(DEBUG_LOCATION, entry->on_deadline_,
+                     GRPC_ERROR_REF(error));
+      }
+    }
+  }
+  delete bucket;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,74 @@
+//
+// Copyright 2019 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_DEADLINE_DEADLINE_WHEEL_H
+#define GRPC_CORE_EXT_FILTERS_DEADLINE_DEADLINE_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+namespace grpc_core {
+
+// Process-wide holding area for call deadlines that are still far away.
+//
+// Most calls finish long before their deadline, so instead of a timer of
+// their own, deadlines more than a couple of seconds out are parked in
+// coarse buckets, each with a single timer that fires shortly before the
+// deadlines it holds. Cancelling a parked deadline is only a list removal.
+// When a bucket fires, the deadlines still in it get a real timer for the
+// time that is left, so deadline-exceeded cancellation is as prompt as
+// without the wheel.
+class DeadlineWheel {
+ public:
+  class Bucket;
+
+  // One deadline, owned by the call it belongs to.
+  class Entry {
+   private:
+    friend class DeadlineWheel;
+
+    grpc_timer* timer_ = nullptr;
+    grpc_millis deadline_ = GRPC_MILLIS_INF_FUTURE;
+    grpc_millis slack_ = 0;
+    grpc_closure* on_deadline_ = nullptr;
+    size_t shard_ = 0;
+    // Guarded by the shard's lock. At most one of bucket_ and armed_ is set.
+    Bucket* bucket_ = nullptr;
+    bool armed_ = false;
+    Entry* prev_ = nullptr;
+    Entry* next_ = nullptr;
+  };
+
+  // Runs \a on_deadline once \a deadline passes, at most \a slack late, as
+  // grpc_timer_init_with_slack() would. \a timer is used once the deadline is
+  // near; it and \a entry must stay alive until \a on_deadline has run.
+  static void Start(Entry* entry, grpc_timer* timer, grpc_millis deadline,
+                    grpc_millis slack, grpc_closure* on_deadline);
+
+  // Like grpc_timer_cancel(): if \a entry has not fired yet, runs its closure
+  // with GRPC_ERROR_CANCELLED.
+  static void Cancel(Entry* entry);
+
+ private:
+  static void OnBucketTimer(void* arg, grpc_error* error);
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_FILTERS_DEADLINE_DEADLINE_WHEEL_H */
@@ -63,13 +63,6 @@ struct call_data {
   ~call_data() { GRPC_ERROR_UNREF(recv_initial_metadata_error); }
 
   grpc_core::CallCombiner* call_combiner;
-  // State for handling send_initial_metadata ops.
-  grpc_linked_mdelem method;
-  grpc_linked_mdelem scheme;
-  grpc_linked_mdelem authority;
-  grpc_linked_mdelem te_trailers;
-  grpc_linked_mdelem content_type;
-  grpc_linked_mdelem user_agent;
   // State for handling recv_initial_metadata ops.
   grpc_metadata_batch* recv_initial_metadata;
   grpc_error* recv_initial_metadata_error = GRPC_ERROR_NONE;
@@ -90,11 +83,14 @@ struct call_data {
   grpc_closure on_send_message_next_done;
   grpc_closure* original_send_message_on_complete;
   grpc_closure send_message_on_complete;
+  // Storage for the headers of channel_data::constant_headers.
+  grpc_linked_mdelem constant_headers[grpc_mdelem_group::kMaxElems];
 };
 
 struct channel_data {
   grpc_mdelem static_scheme;
-  grpc_mdelem user_agent;
+  // te, content-type and user-agent, which are the same on every call.
+  grpc_mdelem_group constant_headers;
   size_t max_payload_size_for_get;
 };
 }  // namespace
@@ -432,26 +428,17 @@ static void http_client_start_transport_stream_op_batch(
     /* Send : prefixed headers, which have to be before any application
        layer headers. */
     error = grpc_metadata_batch_add_head(
-        batch->payload->send_initial_metadata.send_initial_metadata,
-        &calld->method, method, GRPC_BATCH_METHOD);
+        batch->payload->send_initial_metadata.send_initial_metadata, method,
+        GRPC_BATCH_METHOD);
     if (error != GRPC_ERROR_NONE) goto done;
     error = grpc_metadata_batch_add_head(
         batch->payload->send_initial_metadata.send_initial_metadata,
-        &calld->scheme, channeld->static_scheme, GRPC_BATCH_SCHEME);
-    if (error != GRPC_ERROR_NONE) goto done;
-    error = grpc_metadata_batch_add_tail(
-        batch->payload->send_initial_metadata.send_initial_metadata,
-        &calld->te_trailers, GRPC_MDELEM_TE_TRAILERS, GRPC_BATCH_TE);
+        channeld->static_scheme, GRPC_BATCH_SCHEME);
     if (error != GRPC_ERROR_NONE) goto done;
-    error = grpc_metadata_batch_add_tail(
+    /* Linked as a group, so that the transport can encode them together. */
+    error = grpc_metadata_batch_link_tail_group(
         batch->payload->send_initial_metadata.send_initial_metadata,
-        &calld->content_type, GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC,
-        GRPC_BATCH_CONTENT_TYPE);
-    if (error != GRPC_ERROR_NONE) goto done;
-    error = grpc_metadata_batch_add_tail(
-        batch->payload->send_initial_metadata.send_initial_metadata,
-        &calld->user_agent, GRPC_MDELEM_REF(channeld->user_agent),
-        GRPC_BATCH_USER_AGENT);
+        calld->constant_headers, &channeld->constant_headers);
     if (error != GRPC_ERROR_NONE) goto done;
   }
 
@@ -574,17 +561,26 @@ static grpc_error* http_client_init_channel_elem(
   chand->static_scheme = scheme_from_args(args->channel_args);
   chand->max_payload_size_for_get =
       max_payload_size_from_args(args->channel_args);
-  chand->user_agent = grpc_mdelem_from_slices(
-      GRPC_MDSTR_USER_AGENT,
-      user_agent_from_args(args->channel_args,
-                           args->optional_transport->vtable->name));
+  grpc_mdelem_group_init(&chand->constant_headers);
+  grpc_mdelem_group_add(&chand->constant_headers, GRPC_MDELEM_TE_TRAILERS,
+                        GRPC_BATCH_TE);
+  grpc_mdelem_group_add(&chand->constant_headers,
+                        GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC,
+                        GRPC_BATCH_CONTENT_TYPE);
+  grpc_mdelem_group_add(
+      &chand->constant_headers,
+      grpc_mdelem_from_slices(
+          GRPC_MDSTR_USER_AGENT,
+          user_agent_from_args(args->channel_args,
+                               args->optional_transport->vtable->name)),
+      GRPC_BATCH_USER_AGENT);
   return GRPC_ERROR_NONE;
 }
 
 /* Destructor for channel data */
 static void http_client_destroy_channel_elem(grpc_channel_element* elem) {
   channel_data* chand = static_cast<channel_data*>(elem->channel_data);
-  GRPC_MDELEM_UNREF(chand->user_agent);
+  grpc_mdelem_group_destroy(&chand->constant_headers);
 }
 
 const grpc_channel_filter grpc_http_client_filter = {
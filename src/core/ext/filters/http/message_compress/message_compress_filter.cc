@@ -19,8 +19,13 @@
 #include <grpc/support/port_platform.h>
 
 #include <assert.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
 #include <string.h>
 
+#include <map>
+
 #include <grpc/compression.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
@@ -32,20 +37,104 @@
 #include "src/core/lib/compression/compression_args.h"
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/map.h"
+#include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/transport/static_metadata.h"
 
+// Initial metadata key listing the deflate dictionaries a peer has.
+#define GRPC_DICTIONARIES_MD_KEY "grpc-deflate-dictionaries"
+
 static void start_send_message_batch(void* arg, grpc_error* unused);
 static void send_message_on_complete(void* arg, grpc_error* error);
 static void on_send_message_next_done(void* arg, grpc_error* error);
+static void on_recv_initial_metadata_ready(void* arg, grpc_error* error);
 
 namespace {
 
+// How much compressing recent messages of a method saved.
+class MethodCompressionStats {
+ public:
+  explicit MethodCompressionStats(const grpc_slice& path)
+      : path_(grpc_slice_intern(path)) {}
+  ~MethodCompressionStats() { grpc_slice_unref_internal(path_); }
+
+  const grpc_slice& path() const { return path_; }
+
+  // Returns true if the next message of the method should be compressed,
+  // given the savings compression has to bring, in percent.
+  bool ShouldCompress(int min_savings_percent) {
+    if (gpr_atm_no_barrier_load(&savings_) >= min_savings_percent * kScale) {
+      return true;
+    }
+    // Still compress a sample of the messages, so that the method is
+    // compressed again once its messages compress well again.
+    return gpr_atm_no_barrier_fetch_add(&skipped_, 1) % kSampleInterval ==
+           kSampleInterval - 1;
+  }
+
+  void RecordCompression(size_t uncompressed_size, size_t compressed_size) {
+    gpr_atm savings = 0;
+    if (compressed_size < uncompressed_size) {
+      savings = static_cast<gpr_atm>(
+          100 * kScale *
+          (1 - static_cast<double>(compressed_size) / uncompressed_size));
+    }
+    // Moving average over the last few messages. Concurrent updates may
+    // overwrite one another, which only makes the average a bit slower.
+    gpr_atm old_savings = gpr_atm_no_barrier_load(&savings_);
+    gpr_atm_no_barrier_store(&savings_,
+                             old_savings + (savings - old_savings) / 4);
+  }
+
+ private:
+  // Savings are kept in 1/kScale percent, so that the average gets close
+  // enough to 0.
+  static constexpr gpr_atm kScale = 256;
+  static constexpr gpr_atm kSampleInterval = 16;
+
+  grpc_slice path_;
+  // Starts at 100%, so that the first messages of a method are compressed.
+  gpr_atm savings_ = 100 * kScale;
+  gpr_atm skipped_ = 0;
+};
+
+// The compression stats of the methods called on a channel.
+class MethodCompressionStatsTable {
+ public:
+  // Returns nullptr if the table is already full.
+  MethodCompressionStats* Get(const grpc_slice& path) {
+    grpc_core::MutexLock lock(&mu_);
+    auto it = methods_.find(grpc_core::StringViewFromSlice(path));
+    if (it != methods_.end()) return it->second.get();
+    // Servers see whatever paths clients send: bound what they can make us
+    // keep.
+    if (methods_.size() == kMaxMethods) return nullptr;
+    std::unique_ptr<MethodCompressionStats> stats =
+        grpc_core::MakeUnique<MethodCompressionStats>(path);
+    MethodCompressionStats* result = stats.get();
+    methods_.emplace(grpc_core::StringViewFromSlice(result->path()),
+                     std::move(stats));
+    return result;
+  }
+
+ private:
+  static constexpr size_t kMaxMethods = 1024;
+
+  grpc_core::Mutex mu_;
+  std::map<grpc_core::StringView, std::unique_ptr<MethodCompressionStats>,
+           grpc_core::StringLess>
+      methods_;
+};
+
 struct channel_data {
   /** The default, channel-level, compression algorithm */
   grpc_compression_algorithm default_compression_algorithm;
@@ -55,6 +144,26 @@ struct channel_data {
   uint32_t enabled_message_compression_algorithms_bitset;
   /** Bitset of enabled stream compression algorithms */
   uint32_t enabled_stream_compression_algorithms_bitset;
+  /** zlib level for the deflate and gzip message compression algorithms */
+  int zlib_level;
+  /** Messages smaller than this are not compressed */
+  size_t min_message_size;
+  /** Savings, in percent, that compressing the messages of a method has to
+   * bring for them to keep being compressed. 0 to always compress. */
+  int min_savings_percent;
+  /** Only kept if min_savings_percent is set */
+  std::unique_ptr<MethodCompressionStatsTable> method_stats;
+  /** Deflate dictionaries of the channel, if any, with the metadata element
+   * that announces them to peers */
+  grpc_compression_dictionaries* dictionaries = nullptr;
+  grpc_mdelem dictionaries_md = GRPC_MDNULL;
+
+  ~channel_data() {
+    if (dictionaries != nullptr) {
+      grpc_compression_dictionaries_unref(dictionaries);
+      GRPC_MDELEM_UNREF(dictionaries_md);
+    }
+  }
 };
 
 struct call_data {
@@ -69,9 +178,16 @@ struct call_data {
           grpc_compression_algorithm_to_message_compression_algorithm(
               channeld->default_compression_algorithm);
     }
+    // Servers only learn the method from the initial metadata they receive.
+    if (channeld->method_stats != nullptr && !GRPC_SLICE_IS_EMPTY(args.path)) {
+      method_stats = channeld->method_stats->Get(args.path);
+    }
     GRPC_CLOSURE_INIT(&start_send_message_batch_in_call_combiner,
                       start_send_message_batch, elem,
                       grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&recv_initial_metadata_ready,
+                      ::on_recv_initial_metadata_ready, elem,
+                      grpc_schedule_on_exec_ctx);
   }
 
   ~call_data() {
@@ -90,6 +206,13 @@ struct call_data {
   /* Set to true, if the fields below are initialized. */
   bool state_initialized = false;
   grpc_closure start_send_message_batch_in_call_combiner;
+  MethodCompressionStats* method_stats = nullptr;
+  grpc_metadata_batch* recv_initial_metadata = nullptr;
+  grpc_closure* original_recv_initial_metadata_ready = nullptr;
+  grpc_closure recv_initial_metadata_ready;
+  /* The dictionary, owned by the channel, that deflate messages are
+   * compressed with: the first one of the channel that the peer announced. */
+  gpr_atm send_dictionary = 0;
   /* The fields below are only initialized when we compress the payload.
    * Keep them at the bottom of the struct, so they don't pollute the
    * cache-lines. */
@@ -97,6 +220,7 @@ struct call_data {
   grpc_linked_mdelem stream_compression_algorithm_storage;
   grpc_linked_mdelem accept_encoding_storage;
   grpc_linked_mdelem accept_stream_encoding_storage;
+  grpc_linked_mdelem dictionaries_storage;
   grpc_slice_buffer slices; /**< Buffers up input slices to be compressed */
   grpc_core::ManualConstructor<grpc_core::SliceBufferByteStream>
       replacement_stream;
@@ -119,7 +243,20 @@ static bool skip_message_compression(grpc_call_element* elem) {
   }
   // If this call doesn't have any message compression algorithm set, skip
   // message compression.
-  return calld->message_compression_algorithm == GRPC_MESSAGE_COMPRESS_NONE;
+  if (calld->message_compression_algorithm == GRPC_MESSAGE_COMPRESS_NONE) {
+    return true;
+  }
+  // Skip messages too small to be worth it, and most messages of methods
+  // whose messages recently did not compress well.
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  if (calld->send_message_batch->payload->send_message.send_message
+              ->length() < channeld->min_message_size ||
+      (calld->method_stats != nullptr &&
+       !calld->method_stats->ShouldCompress(channeld->min_savings_percent))) {
+    GRPC_STATS_INC_COMPRESSION_SKIPPED_MESSAGES();
+    return true;
+  }
+  return false;
 }
 
 // Determines the compression algorithm from the initial metadata and the
@@ -220,6 +357,13 @@ static grpc_error* process_send_initial_metadata(
             channeld->enabled_stream_compression_algorithms_bitset),
         GRPC_BATCH_ACCEPT_ENCODING);
   }
+  if (error != GRPC_ERROR_NONE) return error;
+  // Convey the dictionaries deflate messages may be compressed with.
+  if (!GRPC_MDISNULL(channeld->dictionaries_md)) {
+    error = grpc_metadata_batch_add_tail(
+        initial_metadata, &calld->dictionaries_storage,
+        GRPC_MDELEM_REF(channeld->dictionaries_md));
+  }
   return error;
 }
 
@@ -252,9 +396,24 @@ static void finish_send_message(grpc_call_element* elem) {
   grpc_slice_buffer_init(&tmp);
   uint32_t send_flags =
       calld->send_message_batch->payload->send_message.send_message->flags();
-  bool did_compress = grpc_msg_compress(calld->message_compression_algorithm,
-                                        &calld->slices, &tmp);
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  const grpc_slice* dictionary = reinterpret_cast<const grpc_slice*>(
+      gpr_atm_acq_load(&calld->send_dictionary));
+  gpr_cycle_counter start = gpr_get_cycle_counter();
+  bool did_compress = grpc_msg_compress_with_dictionary(
+      calld->message_compression_algorithm, channeld->zlib_level, dictionary,
+      &calld->slices, &tmp);
+  gpr_timespec elapsed =
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), start);
+  GRPC_STATS_INC_COMPRESSION_RUN_US(elapsed.tv_sec * GPR_US_PER_SEC +
+                                    elapsed.tv_nsec / GPR_NS_PER_US);
+  // Messages that did not compress are copied to tmp as they are.
+  if (calld->method_stats != nullptr) {
+    calld->method_stats->RecordCompression(calld->slices.length, tmp.length);
+  }
   if (did_compress) {
+    GRPC_STATS_INC_COMPRESSED_MESSAGES();
+    GRPC_STATS_INC_COMPRESSION_BYTES_SAVED(calld->slices.length - tmp.length);
     if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
       const char* algo_name;
       const size_t before_size = calld->slices.length;
@@ -367,6 +526,73 @@ static void on_send_message_next_done(void* arg, grpc_error* error) {
   }
 }
 
+// Returns true if 'ids', a comma separated list of dictionary ids as sent in
+// GRPC_DICTIONARIES_MD_KEY, has 'id'.
+static bool dictionary_ids_contain(const grpc_slice& ids, uint32_t id) {
+  char id_str[9];
+  snprintf(id_str, sizeof(id_str), "%08" PRIx32, id);
+  const char* p = reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(ids));
+  const char* end = p + GRPC_SLICE_LENGTH(ids);
+  while (p < end) {
+    const char* comma =
+        static_cast<const char*>(memchr(p, ',', static_cast<size_t>(end - p)));
+    if (comma == nullptr) comma = end;
+    if (comma - p == 8 && memcmp(p, id_str, 8) == 0) return true;
+    p = comma + 1;
+  }
+  return false;
+}
+
+// Picks the dictionary to compress with from the ones the peer announced, and
+// drops their metadata, which is of no use to the application.
+static void process_recv_dictionaries(channel_data* channeld,
+                                      call_data* calld) {
+  grpc_linked_mdelem* next;
+  for (grpc_linked_mdelem* l = calld->recv_initial_metadata->list.head;
+       l != nullptr; l = next) {
+    next = l->next;
+    if (!grpc_slice_eq(GRPC_MDKEY(l->md),
+                       GRPC_MDKEY(channeld->dictionaries_md))) {
+      continue;
+    }
+    if (gpr_atm_no_barrier_load(&calld->send_dictionary) == 0) {
+      for (size_t i = 0;
+           i < grpc_compression_dictionaries_count(channeld->dictionaries);
+           i++) {
+        if (dictionary_ids_contain(
+                GRPC_MDVALUE(l->md),
+                grpc_compression_dictionaries_id(channeld->dictionaries, i))) {
+          gpr_atm_rel_store(
+              &calld->send_dictionary,
+              reinterpret_cast<gpr_atm>(grpc_compression_dictionaries_get(
+                  channeld->dictionaries, i)));
+          break;
+        }
+      }
+    }
+    grpc_metadata_batch_remove(calld->recv_initial_metadata, l);
+  }
+}
+
+static void on_recv_initial_metadata_ready(void* arg, grpc_error* error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  if (error == GRPC_ERROR_NONE) {
+    if (channeld->method_stats != nullptr && calld->method_stats == nullptr &&
+        calld->recv_initial_metadata->idx.named.path != nullptr) {
+      calld->method_stats = channeld->method_stats->Get(
+          GRPC_MDVALUE(calld->recv_initial_metadata->idx.named.path->md));
+    }
+    if (!GRPC_MDISNULL(channeld->dictionaries_md)) {
+      process_recv_dictionaries(channeld, calld);
+    }
+  }
+  grpc_core::Closure::Run(DEBUG_LOCATION,
+                          calld->original_recv_initial_metadata_ready,
+                          GRPC_ERROR_REF(error));
+}
+
 static void start_send_message_batch(void* arg, grpc_error* /*unused*/) {
   grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
   if (skip_message_compression(elem)) {
@@ -402,6 +628,19 @@ static void compress_start_transport_stream_op_batch(
         batch, GRPC_ERROR_REF(calld->cancel_error), calld->call_combiner);
     return;
   }
+  // On servers, find out the method from recv_initial_metadata. On both
+  // sides, find out which dictionaries the peer has.
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  if (batch->recv_initial_metadata &&
+      ((channeld->method_stats != nullptr && calld->method_stats == nullptr) ||
+       !GRPC_MDISNULL(channeld->dictionaries_md))) {
+    calld->recv_initial_metadata =
+        batch->payload->recv_initial_metadata.recv_initial_metadata;
+    calld->original_recv_initial_metadata_ready =
+        batch->payload->recv_initial_metadata.recv_initial_metadata_ready;
+    batch->payload->recv_initial_metadata.recv_initial_metadata_ready =
+        &calld->recv_initial_metadata_ready;
+  }
   // Handle send_initial_metadata.
   if (batch->send_initial_metadata) {
     GPR_ASSERT(!calld->seen_initial_metadata);
@@ -461,10 +700,29 @@ static void compress_destroy_call_elem(
   calld->~call_data();
 }
 
+// Returns the metadata element that announces 'dictionaries' to peers: their
+// ids, in hex, separated by commas.
+static grpc_mdelem dictionaries_mdelem(
+    const grpc_compression_dictionaries* dictionaries) {
+  size_t count = grpc_compression_dictionaries_count(dictionaries);
+  char* ids = static_cast<char*>(gpr_malloc(count * 9));
+  for (size_t i = 0; i < count; i++) {
+    snprintf(ids + i * 9, 9, "%08" PRIx32,
+             grpc_compression_dictionaries_id(dictionaries, i));
+    ids[i * 9 + 8] = ',';
+  }
+  grpc_mdelem md = grpc_mdelem_from_slices(
+      grpc_slice_intern(
+          grpc_slice_from_static_string(GRPC_DICTIONARIES_MD_KEY)),
+      grpc_slice_intern(grpc_slice_from_static_buffer(ids, count * 9 - 1)));
+  gpr_free(ids);
+  return md;
+}
+
 /* Constructor for channel_data */
 static grpc_error* compress_init_channel_elem(grpc_channel_element* elem,
                                               grpc_channel_element_args* args) {
-  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  channel_data* channeld = new (elem->channel_data) channel_data();
   // Get the enabled and the default algorithms from channel args.
   channeld->enabled_compression_algorithms_bitset =
       grpc_channel_args_compression_algorithm_get_states(args->channel_args);
@@ -488,12 +746,35 @@ static grpc_error* compress_init_channel_elem(grpc_channel_element* elem,
   channeld->enabled_stream_compression_algorithms_bitset =
       grpc_compression_bitset_to_stream_bitset(
           channeld->enabled_compression_algorithms_bitset);
+  channeld->zlib_level = grpc_channel_args_find_integer(
+      args->channel_args, GRPC_COMPRESSION_CHANNEL_ZLIB_LEVEL,
+      {GRPC_MSG_COMPRESS_DEFAULT_ZLIB_LEVEL, -1, 9});
+  channeld->min_message_size = grpc_channel_args_find_integer(
+      args->channel_args, GRPC_COMPRESSION_CHANNEL_MIN_MESSAGE_SIZE,
+      {0, 0, INT_MAX});
+  channeld->min_savings_percent = grpc_channel_args_find_integer(
+      args->channel_args, GRPC_COMPRESSION_CHANNEL_MIN_SAVINGS_PERCENT,
+      {0, 0, 99});
+  if (channeld->min_savings_percent > 0) {
+    channeld->method_stats =
+        grpc_core::MakeUnique<MethodCompressionStatsTable>();
+  }
+  grpc_compression_dictionaries* dictionaries =
+      grpc_compression_dictionaries_from_channel_args(args->channel_args);
+  if (dictionaries != nullptr &&
+      grpc_compression_dictionaries_count(dictionaries) > 0) {
+    channeld->dictionaries = grpc_compression_dictionaries_ref(dictionaries);
+    channeld->dictionaries_md = dictionaries_mdelem(dictionaries);
+  }
   GPR_ASSERT(!args->is_last);
   return GRPC_ERROR_NONE;
 }
 
 /* Destructor for channel data */
-static void compress_destroy_channel_elem(grpc_channel_element* /*elem*/) {}
+static void compress_destroy_channel_elem(grpc_channel_element* elem) {
+  channel_data* channeld = static_cast<channel_data*>(elem->channel_data);
+  channeld->~channel_data();
+}
 
 const grpc_channel_filter grpc_message_compress_filter = {
     compress_start_transport_stream_op_batch,
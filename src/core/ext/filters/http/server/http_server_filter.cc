@@ -63,10 +63,6 @@ struct call_data {
 
   grpc_core::CallCombiner* call_combiner;
 
-  // Outgoing headers to add to send_initial_metadata.
-  grpc_linked_mdelem status;
-  grpc_linked_mdelem content_type;
-
   // If we see the recv_message contents in the GET query string, we
   // store it here.
   grpc_core::ManualConstructor<grpc_core::SliceBufferByteStream> read_stream;
@@ -149,12 +145,10 @@ static bool md_strict_equal(grpc_mdelem a, grpc_mdelem b_static) {
   }
 }
 
-static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
-                                               grpc_metadata_batch* b) {
-  call_data* calld = static_cast<call_data*>(elem->call_data);
-  grpc_error* error = GRPC_ERROR_NONE;
-  static const char* error_name = "Failed processing incoming headers";
-
+// Checks and removes :method, te, :scheme and content-type.
+static void hs_filter_request_headers(call_data* calld, grpc_metadata_batch* b,
+                                      const char* error_name,
+                                      grpc_error** error) {
   if (b->idx.named.method != nullptr) {
     if (md_strict_equal(b->idx.named.method->md, GRPC_MDELEM_METHOD_POST)) {
       *calld->recv_initial_metadata_flags &=
@@ -173,7 +167,7 @@ static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
       *calld->recv_initial_metadata_flags &=
           ~GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST;
     } else {
-      hs_add_error(error_name, &error,
+      hs_add_error(error_name, error,
                    grpc_attach_md_to_error(
                        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Bad header"),
                        b->idx.named.method->md));
@@ -181,7 +175,7 @@ static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
     grpc_metadata_batch_remove(b, GRPC_BATCH_METHOD);
   } else {
     hs_add_error(
-        error_name, &error,
+        error_name, error,
         grpc_error_set_str(
             GRPC_ERROR_CREATE_FROM_STATIC_STRING("Missing header"),
             GRPC_ERROR_STR_KEY, grpc_slice_from_static_string(":method")));
@@ -190,14 +184,14 @@ static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
   if (b->idx.named.te != nullptr) {
     if (!grpc_mdelem_static_value_eq(b->idx.named.te->md,
                                      GRPC_MDELEM_TE_TRAILERS)) {
-      hs_add_error(error_name, &error,
+      hs_add_error(error_name, error,
                    grpc_attach_md_to_error(
                        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Bad header"),
                        b->idx.named.te->md));
     }
     grpc_metadata_batch_remove(b, GRPC_BATCH_TE);
   } else {
-    hs_add_error(error_name, &error,
+    hs_add_error(error_name, error,
                  grpc_error_set_str(
                      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Missing header"),
                      GRPC_ERROR_STR_KEY, grpc_slice_from_static_string("te")));
@@ -208,7 +202,7 @@ static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
         !md_strict_equal(b->idx.named.scheme->md, GRPC_MDELEM_SCHEME_HTTPS) &&
         !grpc_mdelem_static_value_eq(b->idx.named.scheme->md,
                                      GRPC_MDELEM_SCHEME_GRPC)) {
-      hs_add_error(error_name, &error,
+      hs_add_error(error_name, error,
                    grpc_attach_md_to_error(
                        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Bad header"),
                        b->idx.named.scheme->md));
@@ -216,7 +210,7 @@ static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
     grpc_metadata_batch_remove(b, GRPC_BATCH_SCHEME);
   } else {
     hs_add_error(
-        error_name, &error,
+        error_name, error,
         grpc_error_set_str(
             GRPC_ERROR_CREATE_FROM_STATIC_STRING("Missing header"),
             GRPC_ERROR_STR_KEY, grpc_slice_from_static_string(":scheme")));
@@ -251,6 +245,33 @@ static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
     }
     grpc_metadata_batch_remove(b, GRPC_BATCH_CONTENT_TYPE);
   }
+}
+
+// The transport has already seen that this is a plain gRPC POST, so only
+// the work that follows from that is left.
+static void hs_remove_checked_request_headers(call_data* calld,
+                                              grpc_metadata_batch* b) {
+  *calld->recv_initial_metadata_flags &=
+      ~(GRPC_INITIAL_METADATA_CACHEABLE_REQUEST |
+        GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST);
+  grpc_metadata_batch_remove(b, GRPC_BATCH_METHOD);
+  grpc_metadata_batch_remove(b, GRPC_BATCH_TE);
+  grpc_metadata_batch_remove(b, GRPC_BATCH_SCHEME);
+  grpc_metadata_batch_remove(b, GRPC_BATCH_CONTENT_TYPE);
+  b->checked_grpc_post = false;
+}
+
+static grpc_error* hs_filter_incoming_metadata(grpc_call_element* elem,
+                                               grpc_metadata_batch* b) {
+  call_data* calld = static_cast<call_data*>(elem->call_data);
+  grpc_error* error = GRPC_ERROR_NONE;
+  static const char* error_name = "Failed processing incoming headers";
+
+  if (GPR_LIKELY(b->checked_grpc_post)) {
+    hs_remove_checked_request_headers(calld, b);
+  } else {
+    hs_filter_request_headers(calld, b, error_name, &error);
+  }
 
   if (b->idx.named.path == nullptr) {
     hs_add_error(
@@ -422,11 +443,10 @@ static grpc_error* hs_mutate_op(grpc_call_element* elem,
         error_name, &error,
         grpc_metadata_batch_add_head(
             op->payload->send_initial_metadata.send_initial_metadata,
-            &calld->status, GRPC_MDELEM_STATUS_200, GRPC_BATCH_STATUS));
+            GRPC_MDELEM_STATUS_200, GRPC_BATCH_STATUS));
     hs_add_error(error_name, &error,
                  grpc_metadata_batch_add_tail(
                      op->payload->send_initial_metadata.send_initial_metadata,
-                     &calld->content_type,
                      GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC,
                      GRPC_BATCH_CONTENT_TYPE));
     hs_add_error(error_name, &error,
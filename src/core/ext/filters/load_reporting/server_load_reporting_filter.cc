@@ -18,6 +18,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <ctype.h>
 #include <string.h>
 
 #include <grpc/grpc_security.h>
@@ -47,6 +48,42 @@ constexpr char kEncodedIpv6AddressLengthString[] = "32";
 constexpr char kEmptyAddressLengthString[] = "00";
 constexpr size_t kLengthPrefixSize = 2;
 
+namespace {
+
+// Returns a ref to \a host if it has no uppercase letters, which is the
+// common case, and a lowercased copy otherwise.
+grpc_slice LowercaseHost(const grpc_slice& host) {
+  const uint8_t* start = GRPC_SLICE_START_PTR(host);
+  const size_t len = GRPC_SLICE_LENGTH(host);
+  size_t i = 0;
+  while (i < len && !isupper(start[i])) ++i;
+  if (i == len) return grpc_slice_ref_internal(host);
+  grpc_slice lowercase_host = GRPC_SLICE_MALLOC(len);
+  uint8_t* out = GRPC_SLICE_START_PTR(lowercase_host);
+  for (i = 0; i < len; ++i) {
+    out[i] = static_cast<uint8_t>(tolower(start[i]));
+  }
+  return lowercase_host;
+}
+
+}  // namespace
+
+ServerLoadReportingChannelData::~ServerLoadReportingChannelData() {
+  gpr_free(client_ip_prefix_.Load(grpc_core::MemoryOrder::RELAXED));
+}
+
+const char* ServerLoadReportingChannelData::SetClientIpPrefix(char* prefix) {
+  char* current = nullptr;
+  if (!client_ip_prefix_.CompareExchangeStrong(
+          &current, prefix, grpc_core::MemoryOrder::ACQ_REL,
+          grpc_core::MemoryOrder::ACQUIRE)) {
+    // Another call got there first; both computed the same prefix.
+    gpr_free(prefix);
+    return current;
+  }
+  return prefix;
+}
+
 grpc_error* ServerLoadReportingChannelData::Init(
     grpc_channel_element* /* elem */, grpc_channel_element_args* args) {
   GPR_ASSERT(!args->is_last);
@@ -78,6 +115,8 @@ void ServerLoadReportingCallData::Destroy(
   // start, because the data needed for recording the start comes from the
   // initial metadata, which may not be ready before the call finishes.
   if (client_ip_and_lr_token_ != nullptr) {
+    const char* target_host =
+        reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(target_host_));
     opencensus::stats::Record(
         {{::grpc::load_reporter::MeasureEndCount(), 1},
          {::grpc::load_reporter::MeasureEndBytesSent(),
@@ -89,14 +128,14 @@ void ServerLoadReportingCallData::Destroy(
         {{::grpc::load_reporter::TagKeyToken(),
           {client_ip_and_lr_token_, client_ip_and_lr_token_len_}},
          {::grpc::load_reporter::TagKeyHost(),
-          {target_host_, target_host_len_}},
+          {target_host, GRPC_SLICE_LENGTH(target_host_)}},
          {::grpc::load_reporter::TagKeyUserId(),
           {chand->peer_identity(), chand->peer_identity_len()}},
          {::grpc::load_reporter::TagKeyStatus(),
           GetStatusTagForStatus(final_info->final_status)}});
     gpr_free(client_ip_and_lr_token_);
   }
-  gpr_free(target_host_);
+  grpc_slice_unref_internal(target_host_);
   grpc_slice_unref_internal(service_method_);
 }
 
@@ -176,39 +215,45 @@ void ServerLoadReportingCallData::GetCensusSafeClientIpString(
   }
 }
 
-void ServerLoadReportingCallData::StoreClientIpAndLrToken(const char* lr_token,
-                                                          size_t lr_token_len) {
+const char* ServerLoadReportingCallData::GetClientIpPrefix(
+    ServerLoadReportingChannelData* chand) {
+  const char* client_ip_prefix = chand->client_ip_prefix();
+  if (client_ip_prefix != nullptr) return client_ip_prefix;
   char* client_ip;
   size_t client_ip_len;
   GetCensusSafeClientIpString(&client_ip, &client_ip_len);
-  client_ip_and_lr_token_len_ =
-      kLengthPrefixSize + client_ip_len + lr_token_len;
-  client_ip_and_lr_token_ = static_cast<char*>(
-      gpr_zalloc(client_ip_and_lr_token_len_ * sizeof(char)));
-  char* cur_pos = client_ip_and_lr_token_;
+  // Not cached, so that a later call may still find the IP.
+  if (client_ip_len == 0) return kEmptyAddressLengthString;
+  char* prefix =
+      static_cast<char*>(gpr_malloc(kLengthPrefixSize + client_ip_len + 1));
   // Store the IP length prefix.
-  if (client_ip_len == 0) {
-    strncpy(cur_pos, kEmptyAddressLengthString, kLengthPrefixSize);
-  } else if (client_ip_len == 8) {
-    strncpy(cur_pos, kEncodedIpv4AddressLengthString, kLengthPrefixSize);
+  if (client_ip_len == 8) {
+    memcpy(prefix, kEncodedIpv4AddressLengthString, kLengthPrefixSize);
   } else if (client_ip_len == 32) {
-    strncpy(cur_pos, kEncodedIpv6AddressLengthString, kLengthPrefixSize);
+    memcpy(prefix, kEncodedIpv6AddressLengthString, kLengthPrefixSize);
   } else {
     GPR_UNREACHABLE_CODE();
   }
-  cur_pos += kLengthPrefixSize;
   // Store the IP.
-  if (client_ip_len != 0) {
-    strncpy(cur_pos, client_ip, client_ip_len);
-  }
+  memcpy(prefix + kLengthPrefixSize, client_ip, client_ip_len + 1);
   gpr_free(client_ip);
-  cur_pos += client_ip_len;
+  return chand->SetClientIpPrefix(prefix);
+}
+
+void ServerLoadReportingCallData::StoreClientIpAndLrToken(
+    ServerLoadReportingChannelData* chand, const char* lr_token,
+    size_t lr_token_len) {
+  const char* client_ip_prefix = GetClientIpPrefix(chand);
+  const size_t client_ip_prefix_len = strlen(client_ip_prefix);
+  client_ip_and_lr_token_len_ = client_ip_prefix_len + lr_token_len;
+  client_ip_and_lr_token_ =
+      static_cast<char*>(gpr_malloc(client_ip_and_lr_token_len_));
+  memcpy(client_ip_and_lr_token_, client_ip_prefix, client_ip_prefix_len);
   // Store the LR token.
   if (lr_token_len != 0) {
-    strncpy(cur_pos, lr_token, lr_token_len);
+    memcpy(client_ip_and_lr_token_ + client_ip_prefix_len, lr_token,
+           lr_token_len);
   }
-  GPR_ASSERT(cur_pos + lr_token_len - client_ip_and_lr_token_ ==
-             client_ip_and_lr_token_len_);
 }
 
 grpc_filtered_mdelem ServerLoadReportingCallData::RecvInitialMetadataFilter(
@@ -216,22 +261,19 @@ grpc_filtered_mdelem ServerLoadReportingCallData::RecvInitialMetadataFilter(
   grpc_call_element* elem = reinterpret_cast<grpc_call_element*>(user_data);
   ServerLoadReportingCallData* calld =
       reinterpret_cast<ServerLoadReportingCallData*>(elem->call_data);
+  ServerLoadReportingChannelData* chand =
+      reinterpret_cast<ServerLoadReportingChannelData*>(elem->channel_data);
   if (grpc_slice_eq(GRPC_MDKEY(md), GRPC_MDSTR_PATH)) {
     calld->service_method_ = grpc_slice_ref_internal(GRPC_MDVALUE(md));
-  } else if (calld->target_host_ == nullptr &&
+  } else if (GRPC_SLICE_IS_EMPTY(calld->target_host_) &&
              grpc_slice_eq(GRPC_MDKEY(md), GRPC_MDSTR_AUTHORITY)) {
-    grpc_slice target_host_slice = GRPC_MDVALUE(md);
-    calld->target_host_len_ = GRPC_SLICE_LENGTH(target_host_slice);
-    calld->target_host_ =
-        reinterpret_cast<char*>(gpr_zalloc(calld->target_host_len_));
-    for (size_t i = 0; i < calld->target_host_len_; ++i) {
-      calld->target_host_[i] = static_cast<char>(
-          tolower(GRPC_SLICE_START_PTR(target_host_slice)[i]));
-    }
+    grpc_slice_unref_internal(calld->target_host_);
+    calld->target_host_ = LowercaseHost(GRPC_MDVALUE(md));
   } else if (grpc_slice_str_cmp(GRPC_MDKEY(md),
                                 grpc_core::kGrpcLbLbTokenMetadataKey) == 0) {
     if (calld->client_ip_and_lr_token_ == nullptr) {
       calld->StoreClientIpAndLrToken(
+          chand,
           reinterpret_cast<const char*> GRPC_SLICE_START_PTR(GRPC_MDVALUE(md)),
           GRPC_SLICE_LENGTH(GRPC_MDVALUE(md)));
     }
@@ -256,14 +298,16 @@ void ServerLoadReportingCallData::RecvInitialMetadataReady(void* arg,
     // If the LB token was not found in the recv_initial_metadata, only the
     // client IP part will be recorded (with an empty LB token).
     if (calld->client_ip_and_lr_token_ == nullptr) {
-      calld->StoreClientIpAndLrToken(nullptr, 0);
+      calld->StoreClientIpAndLrToken(chand, nullptr, 0);
     }
+    const char* target_host = reinterpret_cast<const char*>(
+        GRPC_SLICE_START_PTR(calld->target_host_));
     opencensus::stats::Record(
         {{::grpc::load_reporter::MeasureStartCount(), 1}},
         {{::grpc::load_reporter::TagKeyToken(),
           {calld->client_ip_and_lr_token_, calld->client_ip_and_lr_token_len_}},
          {::grpc::load_reporter::TagKeyHost(),
-          {calld->target_host_, calld->target_host_len_}},
+          {target_host, GRPC_SLICE_LENGTH(calld->target_host_)}},
          {::grpc::load_reporter::TagKeyUserId(),
           {chand->peer_identity(), chand->peer_identity_len()}}});
   }
@@ -275,6 +319,7 @@ void ServerLoadReportingCallData::RecvInitialMetadataReady(void* arg,
 grpc_error* ServerLoadReportingCallData::Init(
     grpc_call_element* elem, const grpc_call_element_args* args) {
   service_method_ = grpc_empty_slice();
+  target_host_ = grpc_empty_slice();
   GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, RecvInitialMetadataReady,
                     elem, grpc_schedule_on_exec_ctx);
   return GRPC_ERROR_NONE;
@@ -302,12 +347,14 @@ grpc_filtered_mdelem ServerLoadReportingCallData::SendTrailingMetadataFilter(
     double cost_value = *cost_entry_ptr++;
     const char* cost_name = reinterpret_cast<const char*>(cost_entry_ptr);
     const size_t cost_name_len = cost_entry_size - sizeof(double);
+    const char* target_host = reinterpret_cast<const char*>(
+        GRPC_SLICE_START_PTR(calld->target_host_));
     opencensus::stats::Record(
         {{::grpc::load_reporter::MeasureOtherCallMetric(), cost_value}},
         {{::grpc::load_reporter::TagKeyToken(),
           {calld->client_ip_and_lr_token_, calld->client_ip_and_lr_token_len_}},
          {::grpc::load_reporter::TagKeyHost(),
-          {calld->target_host_, calld->target_host_len_}},
+          {target_host, GRPC_SLICE_LENGTH(calld->target_host_)}},
          {::grpc::load_reporter::TagKeyUserId(),
           {chand->peer_identity(), chand->peer_identity_len()}},
          {::grpc::load_reporter::TagKeyMetricName(),
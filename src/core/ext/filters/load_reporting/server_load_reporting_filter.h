@@ -22,12 +22,15 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/cpp/common/channel_filter.h"
 
 namespace grpc {
 
 class ServerLoadReportingChannelData : public ChannelData {
  public:
+  ~ServerLoadReportingChannelData() override;
+
   grpc_error* Init(grpc_channel_element* elem,
                    grpc_channel_element_args* args) override;
 
@@ -35,10 +38,22 @@ class ServerLoadReportingChannelData : public ChannelData {
   const char* peer_identity() { return peer_identity_; }
   size_t peer_identity_len() { return peer_identity_len_; }
 
+  // The client IP with its length prefix, as it starts every token tag on
+  // this channel, or null if no call has computed it yet.
+  const char* client_ip_prefix() {
+    return client_ip_prefix_.Load(grpc_core::MemoryOrder::ACQUIRE);
+  }
+  // Publishes \a prefix (owned by the channel from now on), unless another
+  // call did so first. Returns the published prefix.
+  const char* SetClientIpPrefix(char* prefix);
+
  private:
   // The peer's authenticated identity.
   char* peer_identity_ = nullptr;
   size_t peer_identity_len_ = 0;
+  // A server channel carries a single connection, so the client IP is worked
+  // out from the peer string once rather than on every call.
+  grpc_core::Atomic<char*> client_ip_prefix_{nullptr};
 };
 
 class ServerLoadReportingCallData : public CallData {
@@ -58,9 +73,14 @@ class ServerLoadReportingCallData : public CallData {
   // size to zero.
   void GetCensusSafeClientIpString(char** client_ip_string, size_t* size);
 
+  // Returns the length-prefixed client IP, computing it for the channel if
+  // this is its first call.
+  const char* GetClientIpPrefix(ServerLoadReportingChannelData* chand);
+
   // Concatenates the client IP address and the load reporting token, then
   // stores the result into the call data.
-  void StoreClientIpAndLrToken(const char* lr_token, size_t lr_token_len);
+  void StoreClientIpAndLrToken(ServerLoadReportingChannelData* chand,
+                               const char* lr_token, size_t lr_token_len);
 
   // This matches the classification of the status codes in
   // googleapis/google/rpc/code.proto.
@@ -103,15 +123,14 @@ class ServerLoadReportingCallData : public CallData {
 
   // The backend host that the client thinks it's talking to. This may be
   // different from the actual backend in the case of, for example,
-  // load-balanced targets. We store a copy of the metadata slice in order to
-  // lowercase it. */
-  char* target_host_;
-  size_t target_host_len_;
+  // load-balanced targets. This is a ref to the :authority value, or a
+  // lowercased copy if it has any uppercase letters.
+  grpc_slice target_host_;
 
   // The client IP address (including a length prefix) and the load reporting
   // token.
-  char* client_ip_and_lr_token_;
-  size_t client_ip_and_lr_token_len_;
+  char* client_ip_and_lr_token_ = nullptr;
+  size_t client_ip_and_lr_token_len_ = 0;
 };
 
 }  // namespace grpc
@@ -150,6 +150,13 @@ struct call_data {
         this->limits.max_recv_size = limits->limits().max_recv_size;
       }
     }
+    // Let the surface stop inflating compressed messages at the limit, since
+    // we only see their compressed size.
+    if (args.context != nullptr && this->limits.max_recv_size >= 0) {
+      args.context[GRPC_CONTEXT_MAX_RECV_MESSAGE_SIZE].value =
+          reinterpret_cast<void*>(
+              static_cast<uintptr_t>(this->limits.max_recv_size) + 1);
+    }
   }
 
   ~call_data() { GRPC_ERROR_UNREF(error); }
@@ -260,6 +267,12 @@ static void message_size_start_transport_stream_op_batch(
     gpr_free(message_string);
     return;
   }
+  // Without a receive limit there is nothing to check on the way up, so
+  // leave the receive callbacks alone.
+  if (calld->limits.max_recv_size < 0) {
+    grpc_call_next_op(elem, op);
+    return;
+  }
   // Inject callback for receiving a message.
   if (op->recv_message) {
     calld->next_recv_message_ready =
@@ -375,7 +388,9 @@ const grpc_channel_filter grpc_message_size_filter = {
     grpc_channel_next_get_info,
     "message_size"};
 
-// Used for GRPC_CLIENT_SUBCHANNEL
+// Used for GRPC_CLIENT_SUBCHANNEL. Always added, since the limits may come
+// from the per-call service config; calls that end up without limits pass
+// through.
 static bool maybe_add_message_size_filter_subchannel(
     grpc_channel_stack_builder* builder, void* /*arg*/) {
   const grpc_channel_args* channel_args =
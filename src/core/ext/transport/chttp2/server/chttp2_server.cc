@@ -34,6 +34,7 @@
 #include "src/core/ext/filters/http/server/http_server_filter.h"
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/ext/transport/shm/shm_transport.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/handshaker.h"
 #include "src/core/lib/channel/handshaker_registry.h"
@@ -346,12 +347,24 @@ grpc_error* grpc_chttp2_server_add_port(grpc_server* server, const char* addr,
   grpc_error** errors = nullptr;
   size_t naddrs = 0;
   const grpc_arg* arg = nullptr;
+  char* unix_addr = nullptr;
 
   *port_num = -1;
 
   if (strncmp(addr, "external:", 9) == 0) {
     return chttp2_server_add_acceptor(server, addr, args);
   }
+  if (strncmp(addr, "shm:", 4) == 0) {
+    /* listen on the unix socket, moving connections onto shared memory */
+    gpr_asprintf(&unix_addr, "unix:%s", addr + 4);
+    addr = unix_addr;
+    grpc_arg shm_arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_SHM_TRANSPORT), 1);
+    grpc_channel_args* shm_args =
+        grpc_channel_args_copy_and_add(args, &shm_arg, 1);
+    grpc_channel_args_destroy(args);
+    args = shm_args;
+  }
 
   /* resolve address */
   err = grpc_blocking_resolve_address(addr, "https", &resolved);
@@ -450,5 +463,6 @@ done:
     }
     gpr_free(errors);
   }
+  gpr_free(unix_addr);
   return err;
 }
@@ -22,10 +22,11 @@
 #include <grpc/support/log.h>
 #include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
-static uint8_t decode_table[] = {
+static const uint8_t decode_table[] = {
     0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
     0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
     0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
@@ -59,13 +60,32 @@ static bool input_is_valid(const uint8_t* input_ptr, size_t length) {
       gpr_log(GPR_ERROR,
               "Base64 decoding failed, invalid character '%c' in base64 "
               "input.\n",
-              static_cast<char>(*input_ptr));
+              static_cast<char>(input_ptr[i]));
       return false;
     }
   }
   return true;
 }
 
+// Decodes the 4 characters at in into the 3 bytes at out, looking each
+// character up once. Returns false if one of them is not a base64 character.
+static bool decode_block(const uint8_t* in, uint8_t* out) {
+  const uint32_t a = decode_table[in[0]];
+  const uint32_t b = decode_table[in[1]];
+  const uint32_t c = decode_table[in[2]];
+  const uint32_t d = decode_table[in[3]];
+  if (GPR_UNLIKELY(((a | b | c | d) & 0xC0) != 0)) {
+    // Logs the offending character.
+    input_is_valid(in, 4);
+    return false;
+  }
+  const uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+  out[0] = static_cast<uint8_t>(group >> 16);
+  out[1] = static_cast<uint8_t>(group >> 8);
+  out[2] = static_cast<uint8_t>(group);
+  return true;
+}
+
 #define COMPOSE_OUTPUT_BYTE_0(input_ptr)        \
   (uint8_t)((decode_table[input_ptr[0]] << 2) | \
             (decode_table[input_ptr[1]] >> 4))
@@ -74,9 +94,6 @@ static bool input_is_valid(const uint8_t* input_ptr, size_t length) {
   (uint8_t)((decode_table[input_ptr[1]] << 4) | \
             (decode_table[input_ptr[2]] >> 2))
 
-#define COMPOSE_OUTPUT_BYTE_2(input_ptr) \
-  (uint8_t)((decode_table[input_ptr[2]] << 6) | decode_table[input_ptr[3]])
-
 // By RFC 4648, if the length of the encoded string without padding is 4n+r,
 // the length of decoded string is: 1) 3n if r = 0, 2) 3n + 1 if r = 2, 3, or
 // 3) invalid if r = 1.
@@ -110,16 +127,24 @@ bool grpc_base64_decode_partial(struct grpc_base64_decode_context* ctx) {
     return false;
   }
 
-  // Process a block of 4 input characters and 3 output bytes
-  while (ctx->input_end >= ctx->input_cur + 4 &&
-         ctx->output_end >= ctx->output_cur + 3) {
-    if (!input_is_valid(ctx->input_cur, 4)) return false;
-    ctx->output_cur[0] = COMPOSE_OUTPUT_BYTE_0(ctx->input_cur);
-    ctx->output_cur[1] = COMPOSE_OUTPUT_BYTE_1(ctx->input_cur);
-    ctx->output_cur[2] = COMPOSE_OUTPUT_BYTE_2(ctx->input_cur);
-    ctx->output_cur += 3;
-    ctx->input_cur += 4;
+  // Process blocks of 4 input characters and 3 output bytes. The cursors are
+  // kept in locals: stores to the output could otherwise alias ctx and force
+  // them to be reloaded for every block.
+  const uint8_t* in = ctx->input_cur;
+  uint8_t* out = ctx->output_cur;
+  size_t blocks = GPR_MIN(static_cast<size_t>(ctx->input_end - in) / 4,
+                          static_cast<size_t>(ctx->output_end - out) / 3);
+  for (; blocks > 0; blocks--) {
+    if (!decode_block(in, out)) {
+      ctx->input_cur = in;
+      ctx->output_cur = out;
+      return false;
+    }
+    in += 4;
+    out += 3;
   }
+  ctx->input_cur = in;
+  ctx->output_cur = out;
 
   // Process the tail of input data
   input_tail = static_cast<size_t>(ctx->input_end - ctx->input_cur);
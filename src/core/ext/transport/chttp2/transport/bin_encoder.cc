@@ -48,6 +48,14 @@ static const b64_huff_sym huff_alphabet[64] = {
 
 static const uint8_t tail_xtra[3] = {0, 2, 3};
 
+/* Reads 3 input bytes as one 24-bit group. The output is written through
+   char pointers, which may alias the input: loading the whole group up front
+   saves reloading each input byte after every output byte stored. */
+static uint32_t load_triplet(const uint8_t* in) {
+  return (static_cast<uint32_t>(in[0]) << 16) |
+         (static_cast<uint32_t>(in[1]) << 8) | in[2];
+}
+
 grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   size_t input_length = GRPC_SLICE_LENGTH(input);
   size_t input_triplets = input_length / 3;
@@ -60,10 +68,11 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
 
   /* encode full triplets */
   for (i = 0; i < input_triplets; i++) {
-    out[0] = alphabet[in[0] >> 2];
-    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
-    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
-    out[3] = alphabet[in[2] & 0x3f];
+    const uint32_t group = load_triplet(in);
+    out[0] = alphabet[group >> 18];
+    out[1] = alphabet[(group >> 12) & 0x3f];
+    out[2] = alphabet[(group >> 6) & 0x3f];
+    out[3] = alphabet[group & 0x3f];
     out += 4;
     in += 3;
   }
@@ -92,60 +101,90 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   return output;
 }
 
-grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
-  size_t nbits;
-  const uint8_t* in;
-  uint8_t* out;
-  grpc_slice output;
-  uint32_t temp = 0;
+/* Writes the huffman codes of [in, end) to [out, out_end), packing them into
+   a 64-bit accumulator that is flushed 32 bits at a time. Returns the end of
+   the output, or nullptr if it does not fit. */
+static uint8_t* huffman_compress(const uint8_t* in, const uint8_t* end,
+                                 uint8_t* out, uint8_t* out_end) {
+  uint64_t temp = 0;
   uint32_t temp_length = 0;
-
-  nbits = 0;
-  for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
-       ++in) {
-    nbits += grpc_chttp2_huffsyms[*in].length;
-  }
-
-  output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
-  out = GRPC_SLICE_START_PTR(output);
-  for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
-       ++in) {
-    int sym = *in;
-    temp <<= grpc_chttp2_huffsyms[sym].length;
-    temp |= grpc_chttp2_huffsyms[sym].bits;
-    temp_length += grpc_chttp2_huffsyms[sym].length;
-
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
+  for (; in != end; ++in) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[*in];
+    /* fewer than 32 bits are left from the previous rounds, and codes are at
+       most 30 bits long */
+    temp = (temp << sym.length) | sym.bits;
+    temp_length += sym.length;
+    if (temp_length >= 32) {
+      if (out_end - out < 4) return nullptr;
+      temp_length -= 32;
+      const uint32_t word = static_cast<uint32_t>(temp >> temp_length);
+      out[0] = static_cast<uint8_t>(word >> 24);
+      out[1] = static_cast<uint8_t>(word >> 16);
+      out[2] = static_cast<uint8_t>(word >> 8);
+      out[3] = static_cast<uint8_t>(word);
+      out += 4;
     }
   }
-
-  if (temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
+  /* pad the last byte with the start of EOS */
+  const uint32_t padding = (8 - temp_length % 8) % 8;
+  temp = (temp << padding) | ((1u << padding) - 1);
+  temp_length += padding;
+  if (static_cast<size_t>(out_end - out) < temp_length / 8) return nullptr;
+  while (temp_length > 0) {
+    temp_length -= 8;
+    *out++ = static_cast<uint8_t>(temp >> temp_length);
   }
+  return out;
+}
 
+grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
+  size_t nbits = 0;
+  for (const uint8_t* in = GRPC_SLICE_START_PTR(input);
+       in != GRPC_SLICE_END_PTR(input); ++in) {
+    nbits += grpc_chttp2_huffsyms[*in].length;
+  }
+  grpc_slice output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
+  uint8_t* out = huffman_compress(
+      GRPC_SLICE_START_PTR(input), GRPC_SLICE_END_PTR(input),
+      GRPC_SLICE_START_PTR(output), GRPC_SLICE_END_PTR(output));
   GPR_ASSERT(out == GRPC_SLICE_END_PTR(output));
-
   return output;
 }
 
+bool grpc_chttp2_huffman_compress_if_shorter(const grpc_slice& input,
+                                             grpc_slice* output) {
+  const size_t length = GRPC_SLICE_LENGTH(input);
+  if (length < 2) return false;
+  /* compress straight into a buffer one byte shorter than the input, giving
+     up as soon as it fills up */
+  grpc_slice compressed = GRPC_SLICE_MALLOC(length - 1);
+  uint8_t* out = huffman_compress(
+      GRPC_SLICE_START_PTR(input), GRPC_SLICE_END_PTR(input),
+      GRPC_SLICE_START_PTR(compressed), GRPC_SLICE_END_PTR(compressed));
+  if (out == nullptr) {
+    grpc_slice_unref(compressed);
+    return false;
+  }
+  GRPC_SLICE_SET_LENGTH(compressed, out - GRPC_SLICE_START_PTR(compressed));
+  *output = compressed;
+  return true;
+}
+
 typedef struct {
-  uint32_t temp;
+  uint64_t temp;
   uint32_t temp_length;
   uint8_t* out;
 } huff_out;
 
 static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    const uint32_t word = static_cast<uint32_t>(out->temp >> out->temp_length);
+    out->out[0] = static_cast<uint8_t>(word >> 24);
+    out->out[1] = static_cast<uint8_t>(word >> 16);
+    out->out[2] = static_cast<uint8_t>(word >> 8);
+    out->out[3] = static_cast<uint8_t>(word);
+    out->out += 4;
   }
 }
 
@@ -186,13 +225,11 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
 
   /* encode full triplets */
   for (i = 0; i < input_triplets; i++) {
-    const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-    const uint8_t high_to_low = in[1] >> 4;
-    enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-
-    const uint8_t a = static_cast<uint8_t>((in[1] & 0xf) << 2);
-    const uint8_t b = (in[2] >> 6);
-    enc_add2(&out, a | b, in[2] & 0x3f);
+    const uint32_t group = load_triplet(in);
+    enc_add2(&out, static_cast<uint8_t>(group >> 18),
+             static_cast<uint8_t>((group >> 12) & 0x3f));
+    enc_add2(&out, static_cast<uint8_t>((group >> 6) & 0x3f),
+             static_cast<uint8_t>(group & 0x3f));
     in += 3;
   }
 
@@ -214,6 +251,10 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     }
   }
 
+  while (out.temp_length >= 8) {
+    out.temp_length -= 8;
+    *out.out++ = static_cast<uint8_t>(out.temp >> out.temp_length);
+  }
   if (out.temp_length) {
     /* NB: the following integer arithmetic operation needs to be in its
      * expanded form due to the "integral promotion" performed (see section
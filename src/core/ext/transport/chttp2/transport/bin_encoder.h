@@ -31,6 +31,12 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input);
    standard. Returns a new slice, does not take ownership of the input */
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input);
 
+/* Like grpc_chttp2_huffman_compress(), when that makes the slice shorter:
+   returns true and sets *output to a new slice if it does, or false without
+   touching *output otherwise. Does not take ownership of the input */
+bool grpc_chttp2_huffman_compress_if_shorter(const grpc_slice& input,
+                                             grpc_slice* output);
+
 /* equivalent to:
    grpc_slice x = grpc_chttp2_base64_encode(input);
    grpc_slice y = grpc_chttp2_huffman_compress(x);
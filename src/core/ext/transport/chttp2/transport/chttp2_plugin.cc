@@ -19,6 +19,7 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/context_list.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/transport/metadata.h"
@@ -32,6 +33,11 @@ GPR_GLOBAL_CONFIG_DEFINE_BOOL(
 void grpc_chttp2_plugin_init(void) {
   g_flow_control_enabled =
       !GPR_GLOBAL_CONFIG_GET(grpc_experimental_disable_flow_control);
+#ifdef GRPC_LINUX_ERRQUEUE
+  // Deliver the kernel timestamps of traced writes back to their calls
+  grpc_core::grpc_tcp_set_write_timestamps_callback(
+      grpc_core::ContextList::Execute);
+#endif
 }
 
 void grpc_chttp2_plugin_shutdown(void) {}
@@ -35,6 +35,7 @@
 #include "src/core/ext/transport/chttp2/transport/frame_data.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
+#include "src/core/lib/channel/call_timeline.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/compression/stream_compression.h"
 #include "src/core/lib/debug/stats.h"
@@ -68,6 +69,14 @@
 #define DEFAULT_SERVER_KEEPALIVE_TIMEOUT_MS 20000 /* 20 seconds */
 #define DEFAULT_KEEPALIVE_PERMIT_WITHOUT_CALLS false
 #define KEEPALIVE_TIME_BACKOFF_MULTIPLIER 2
+/* With adaptive keepalive, the keepalive time doubles after this many acked
+   pings in a row, up to this multiple of its configured value. */
+#define KEEPALIVE_ADAPTIVE_STABLE_ACKS 3
+#define KEEPALIVE_ADAPTIVE_MAX_MULTIPLIER 8
+/* Keepalive timers may fire up to 1/32 of their interval late (capped at one
+   second) so that the timers of many transports can be coalesced. */
+#define KEEPALIVE_TIMER_SLACK_DIVISOR 32
+#define KEEPALIVE_TIMER_MAX_SLACK_MS 1000
 
 #define DEFAULT_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS 300000 /* 5 minutes */
 #define DEFAULT_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS 300000 /* 5 minutes */
@@ -106,6 +115,10 @@ static void write_action_begin_locked(void* t, grpc_error* error);
 static void write_action(void* t, grpc_error* error);
 static void write_action_end(void* t, grpc_error* error);
 static void write_action_end_locked(void* t, grpc_error* error);
+static bool hold_write_locked(grpc_chttp2_transport* t);
+static void write_coalesce_timer_fired(void* t, grpc_error* error);
+static void write_coalesce_timer_fired_locked(void* t, grpc_error* error);
+static void write_coalesce_regather_locked(void* t, grpc_error* error);
 
 static void read_action(void* t, grpc_error* error);
 static void read_action_locked(void* t, grpc_error* error);
@@ -113,6 +126,7 @@ static void continue_read_action_locked(grpc_chttp2_transport* t);
 
 static void complete_fetch(void* gs, grpc_error* error);
 static void complete_fetch_locked(void* gs, grpc_error* error);
+static void resume_fetching_send_locked(void* gs, grpc_error* error);
 /** Set a transport level setting, and push it to our peer */
 static void queue_setting_update(grpc_chttp2_transport* t,
                                  grpc_chttp2_setting_id id, uint32_t value);
@@ -133,6 +147,7 @@ static void benign_reclaimer_locked(void* t, grpc_error* error);
 static void destructive_reclaimer_locked(void* t, grpc_error* error);
 
 static void post_benign_reclaimer(grpc_chttp2_transport* t);
+static void start_idle_compaction_timer(grpc_chttp2_transport* t);
 static void post_destructive_reclaimer(grpc_chttp2_transport* t);
 
 static void close_transport_locked(grpc_chttp2_transport* t, grpc_error* error);
@@ -262,6 +277,19 @@ static bool read_channel_args(grpc_chttp2_transport* t,
         grpc_chttp2_hpack_compressor_set_max_usable_size(
             &t->hpack_compressor, static_cast<uint32_t>(value));
       }
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_TIMEOUT_SIGNIFICANT_DIGITS)) {
+      grpc_chttp2_hpack_compressor_set_timeout_digits(
+          &t->hpack_compressor,
+          grpc_channel_arg_get_integer(&channel_args->args[i], {0, 0, 3}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_KEEPALIVE_ADAPTIVE)) {
+      t->keepalive_adaptive =
+          grpc_channel_arg_get_bool(&channel_args->args[i], false);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_IDLE_COMPACTION_MS)) {
+      t->idle_compaction_ms = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, INT_MAX});
     } else if (0 == strcmp(channel_args->args[i].key,
                            GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA)) {
       t->ping_policy.max_pings_without_data = grpc_channel_arg_get_integer(
@@ -296,6 +324,21 @@ static bool read_channel_args(grpc_chttp2_transport* t,
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_LATENCY_LANE_MAX_MESSAGE_BYTES)) {
+      t->latency_lane_max_message_bytes =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i], {0, 0, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCE_DELAY_MS)) {
+      t->write_coalesce_delay = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, INT_MAX});
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCE_BYTES)) {
+      t->write_coalesce_bytes =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i],
+              {static_cast<int>(t->write_coalesce_bytes), 0, INT_MAX}));
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_KEEPALIVE_TIME_MS)) {
       const int value = grpc_channel_arg_get_integer(
@@ -321,6 +364,10 @@ static bool read_channel_args(grpc_chttp2_transport* t,
     } else if (0 == strcmp(channel_args->args[i].key,
                            GRPC_ARG_OPTIMIZATION_TARGET)) {
       gpr_log(GPR_INFO, "GRPC_ARG_OPTIMIZATION_TARGET is deprecated");
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER_PRESSURE)) {
+      t->hpack_decoder_table_size_under_pressure = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {-1, -1, INT32_MAX});
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_ENABLE_CHANNELZ)) {
       channelz_enabled = grpc_channel_arg_get_bool(
@@ -382,7 +429,7 @@ static bool read_channel_args(grpc_chttp2_transport* t,
     gpr_asprintf(&socket_name, "%s %s", get_vtable()->name, t->peer_string);
     t->channelz_socket =
         grpc_core::MakeRefCounted<grpc_core::channelz::SocketNode>(
-            "", t->peer_string, socket_name);
+            "", t->peer_string, socket_name, t->combiner->profile);
     // TODO(veblush): Remove this once gpr_asprintf is replaced by
     // absl::StrFormat
     gpr_free(socket_name);
@@ -421,15 +468,62 @@ static void configure_transport_ping_policy(grpc_chttp2_transport* t) {
       g_default_min_recv_ping_interval_without_data_ms;
 }
 
+static grpc_millis keepalive_timer_slack(grpc_millis interval) {
+  return GPR_MIN(interval / KEEPALIVE_TIMER_SLACK_DIVISOR,
+                 KEEPALIVE_TIMER_MAX_SLACK_MS);
+}
+
+static grpc_millis keepalive_time_multiply(grpc_millis time,
+                                           grpc_millis multiplier) {
+  return time > INT_MAX / multiplier ? GRPC_MILLIS_INF_FUTURE
+                                     : time * multiplier;
+}
+
+static void init_adaptive_keepalive(grpc_chttp2_transport* t) {
+  if (!t->keepalive_adaptive || t->keepalive_time == GRPC_MILLIS_INF_FUTURE) {
+    return;
+  }
+  t->keepalive_max_time = keepalive_time_multiply(
+      t->keepalive_time, KEEPALIVE_ADAPTIVE_MAX_MULTIPLIER);
+  if (t->is_client) {
+    /* start where the last connection to this peer that was told off for
+       pinging too often left off */
+    const grpc_millis floor =
+        grpc_core::KeepaliveScheduler::PeerIntervalFloor(t->peer_string);
+    if (floor > t->keepalive_time) {
+      t->keepalive_time = floor;
+      t->keepalive_max_time = GPR_MAX(t->keepalive_max_time, floor);
+    }
+  }
+}
+
+// Called on each keepalive ping ack: a connection that keeps answering is
+// pinged less often.
+static void maybe_grow_keepalive_time(grpc_chttp2_transport* t) {
+  if (!t->keepalive_adaptive ||
+      ++t->keepalive_acks_since_growth < KEEPALIVE_ADAPTIVE_STABLE_ACKS ||
+      t->keepalive_time >= t->keepalive_max_time) {
+    return;
+  }
+  t->keepalive_acks_since_growth = 0;
+  t->keepalive_time = GPR_MIN(keepalive_time_multiply(t->keepalive_time, 2),
+                              t->keepalive_max_time);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+    gpr_log(GPR_INFO, "%s: Keepalive time grows to %" PRId64 "ms",
+            t->peer_string, t->keepalive_time);
+  }
+}
+
 static void init_keepalive_pings_if_enabled(grpc_chttp2_transport* t) {
   if (t->keepalive_time != GRPC_MILLIS_INF_FUTURE) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
     GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
     GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                       grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    grpc_core::KeepaliveScheduler::Schedule(
+        &t->keepalive_ping_timer, t->keepalive_time,
+        keepalive_timer_slack(t->keepalive_time),
+        &t->init_keepalive_ping_locked);
   } else {
     /* Use GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED to indicate there are no
        inflight keeaplive timers */
@@ -444,7 +538,7 @@ grpc_chttp2_transport::grpc_chttp2_transport(
       ep(ep),
       peer_string(grpc_endpoint_get_peer(ep)),
       resource_user(resource_user),
-      combiner(grpc_combiner_create()),
+      combiner(grpc_combiner_create("transport")),
       state_tracker(is_client ? "client_transport" : "server_transport",
                     GRPC_CHANNEL_READY),
       is_client(is_client),
@@ -496,10 +590,19 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   if (channel_args) {
     enable_bdp = read_channel_args(this, channel_args, is_client);
   }
+  init_adaptive_keepalive(this);
 
+  adaptive_max_frame_size = grpc_channel_arg_get_bool(
+      grpc_channel_args_find(channel_args,
+                             GRPC_ARG_HTTP2_ADAPTIVE_MAX_FRAME_SIZE),
+      false);
   if (g_flow_control_enabled) {
-    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(this,
-                                                               enable_bdp);
+    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(
+        this, enable_bdp,
+        grpc_channel_arg_get_bool(
+            grpc_channel_args_find(channel_args, GRPC_ARG_HTTP2_BBR_AUTOTUNING),
+            false),
+        adaptive_max_frame_size);
   } else {
     flow_control.Init<grpc_core::chttp2::TransportFlowControlDisabled>(this);
     enable_bdp = false;
@@ -524,6 +627,7 @@ grpc_chttp2_transport::grpc_chttp2_transport(
 
   grpc_chttp2_initiate_write(this, GRPC_CHTTP2_INITIATE_WRITE_INITIAL_WRITE);
   post_benign_reclaimer(this);
+  start_idle_compaction_timer(this);
 }
 
 static void destroy_transport_locked(void* tp, grpc_error* /*error*/) {
@@ -553,6 +657,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
                                  GRPC_STATUS_UNAVAILABLE);
     }
     if (t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE) {
+      if (t->write_coalescing) {
+        /* flush the held write right away */
+        grpc_timer_cancel(&t->write_coalesce_timer);
+      }
       if (t->close_transport_on_writes_finished == nullptr) {
         t->close_transport_on_writes_finished =
             GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -571,12 +679,14 @@ static void close_transport_locked(grpc_chttp2_transport* t,
     if (t->have_next_bdp_ping_timer) {
       grpc_timer_cancel(&t->next_bdp_ping_timer);
     }
+    if (t->have_idle_compaction_timer) {
+      grpc_timer_cancel(&t->idle_compaction_timer);
+    }
     switch (t->keepalive_state) {
       case GRPC_CHTTP2_KEEPALIVE_STATE_WAITING:
-        grpc_timer_cancel(&t->keepalive_ping_timer);
+        grpc_core::KeepaliveScheduler::Cancel(&t->keepalive_ping_timer);
         break;
       case GRPC_CHTTP2_KEEPALIVE_STATE_PINGING:
-        grpc_timer_cancel(&t->keepalive_ping_timer);
         grpc_timer_cancel(&t->keepalive_watchdog_timer);
         break;
       case GRPC_CHTTP2_KEEPALIVE_STATE_DYING:
@@ -653,6 +763,7 @@ grpc_chttp2_stream::grpc_chttp2_stream(grpc_chttp2_transport* t,
   grpc_slice_buffer_init(&unprocessed_incoming_frames_buffer);
   grpc_slice_buffer_init(&flow_controlled_buffer);
   GRPC_CLOSURE_INIT(&reset_byte_stream, ::reset_byte_stream, this, nullptr);
+  latency_lane = t->latency_lane_max_message_bytes > 0;
 }
 
 grpc_chttp2_stream::~grpc_chttp2_stream() {
@@ -888,6 +999,7 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       inc_initiate_write_reason(reason);
+      t->write_initiated_at = gpr_get_cycle_counter();
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
@@ -913,12 +1025,22 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
           GRPC_ERROR_NONE);
       break;
     case GRPC_CHTTP2_WRITE_STATE_WRITING:
+      t->next_write_initiated_at = gpr_get_cycle_counter();
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE,
                       grpc_chttp2_initiate_write_reason_string(reason));
       break;
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       break;
   }
+  if (t->write_coalescing && !t->write_coalesce_regather_scheduled) {
+    /* gather the new frames into the held write, which may then be big
+       enough to go out */
+    t->write_coalesce_regather_scheduled = true;
+    t->combiner->FinallyRun(
+        GRPC_CLOSURE_INIT(&t->write_coalesce_regather_locked,
+                          write_coalesce_regather_locked, t, nullptr),
+        GRPC_ERROR_NONE);
+  }
 }
 
 void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
@@ -948,13 +1070,19 @@ static void write_action_begin_locked(void* gt, grpc_error* /*error_ignored*/) {
     r = grpc_chttp2_begin_write(t);
   }
   if (r.writing) {
+    if (hold_write_locked(t)) {
+      return;
+    }
     if (r.partial) {
       GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
+      /* what is left over has been waiting as long as this write */
+      t->next_write_initiated_at = t->write_initiated_at;
     }
     set_write_state(t,
                     r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
                               : GRPC_CHTTP2_WRITE_STATE_WRITING,
                     begin_writing_desc(r.partial));
+    t->last_write_time = grpc_core::ExecCtx::Get()->Now();
     write_action(t, GRPC_ERROR_NONE);
     if (t->reading_paused_on_pending_induced_frames) {
       GPR_ASSERT(t->num_pending_induced_frames == 0);
@@ -971,11 +1099,80 @@ static void write_action_begin_locked(void* gt, grpc_error* /*error_ignored*/) {
     }
   } else {
     GRPC_STATS_INC_HTTP2_SPURIOUS_WRITES_BEGUN();
+    if (t->write_coalescing) {
+      /* closed while a write was held */
+      t->write_coalescing = false;
+      grpc_timer_cancel(&t->write_coalesce_timer);
+    }
     set_write_state(t, GRPC_CHTTP2_WRITE_STATE_IDLE, "begin writing nothing");
     GRPC_CHTTP2_UNREF_TRANSPORT(t, "writing");
   }
 }
 
+/* Holds a write gathered by write_action_begin_locked back when it is small
+   and the connection busy, so that the frames of the streams becoming
+   writable within the coalescing window go out in the same endpoint write.
+   Returns true if the write is (still) held. */
+static bool hold_write_locked(grpc_chttp2_transport* t) {
+  if (t->write_coalescing) {
+    /* gathered again: flush once big enough, or when the timer fires */
+    if (t->outbuf.length < t->write_coalesce_bytes) {
+      return true;
+    }
+    t->write_coalescing = false;
+    grpc_timer_cancel(&t->write_coalesce_timer);
+    return false;
+  }
+  if (t->write_coalesce_delay == 0 ||
+      t->outbuf.length >= t->write_coalesce_bytes ||
+      t->reading_paused_on_pending_induced_frames ||
+      t->close_transport_on_writes_finished != GRPC_ERROR_NONE) {
+    return false;
+  }
+  /* on an idle connection, holding writes would only add latency */
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  if (now - t->last_write_time >= t->write_coalesce_delay) {
+    return false;
+  }
+  GRPC_STATS_INC_HTTP2_WRITES_HELD();
+  t->write_coalescing = true;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "write_coalesce_timer");
+  GRPC_CLOSURE_INIT(&t->write_coalesce_timer_fired_locked,
+                    write_coalesce_timer_fired, t, grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->write_coalesce_timer, now + t->write_coalesce_delay,
+                  &t->write_coalesce_timer_fired_locked);
+  return true;
+}
+
+static void write_coalesce_timer_fired(void* tp, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalesce_timer_fired_locked,
+                        write_coalesce_timer_fired_locked, t, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+/* Runs when the coalescing window ends, or when the timer gets cancelled:
+   unless the write went out already, gather once more and write (even when
+   cancelled, as the transport waits for the write before closing) */
+static void write_coalesce_timer_fired_locked(void* tp,
+                                              grpc_error* /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  if (t->write_coalescing) {
+    t->write_coalescing = false;
+    write_action_begin_locked(t, GRPC_ERROR_NONE);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_coalesce_timer");
+}
+
+static void write_coalesce_regather_locked(void* tp, grpc_error* /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->write_coalesce_regather_scheduled = false;
+  if (t->write_coalescing) {
+    write_action_begin_locked(t, GRPC_ERROR_NONE);
+  }
+}
+
 static void write_action(void* gt, grpc_error* /*error*/) {
   GPR_TIMER_SCOPE("write_action", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
@@ -1016,6 +1213,9 @@ static void write_action_end_locked(void* tp, grpc_error* error) {
     }
   }
 
+  GRPC_STATS_INC_WRITE_LATENCY_US(gpr_timespec_to_micros(
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), t->write_initiated_at)));
+
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       GPR_UNREACHABLE_CODE(break);
@@ -1026,6 +1226,7 @@ static void write_action_end_locked(void* tp, grpc_error* error) {
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       GPR_TIMER_MARK("state=writing_stale_no_poller", 0);
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING, "continue writing");
+      t->write_initiated_at = t->next_write_initiated_at;
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
       // If the transport is closed, we will retry writing on the endpoint
       // and next write may contain part of the currently serialized frames.
@@ -1104,6 +1305,11 @@ void grpc_chttp2_add_incoming_goaway(grpc_chttp2_transport* t,
             ? GRPC_MILLIS_INF_FUTURE
             : static_cast<grpc_millis>(current_keepalive_time_ms *
                                        KEEPALIVE_TIME_BACKOFF_MULTIPLIER);
+    if (t->keepalive_adaptive) {
+      /* so that the next connection does not start at the rejected time */
+      grpc_core::KeepaliveScheduler::RaisePeerIntervalFloor(t->peer_string,
+                                                            t->keepalive_time);
+    }
   }
 
   /* lie: use transient failure from the transport to indicate goaway has been
@@ -1122,6 +1328,7 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
               GRPC_ERROR_CREATE_FROM_STATIC_STRING("GOAWAY received"),
               GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
     }
+    grpc_chttp2_update_stream_headroom(t);
     return;
   }
   /* start streams where we have free grpc_chttp2_stream ids and free
@@ -1148,6 +1355,9 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
 
     grpc_chttp2_stream_map_add(&t->stream_map, s->id, s);
     post_destructive_reclaimer(t);
+    grpc_core::CallTimeline::Mark(
+        static_cast<grpc_call_context_element*>(s->context),
+        grpc_core::CallTimeline::kStreamStarted);
     grpc_chttp2_mark_stream_writable(t, s);
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM);
   }
@@ -1161,6 +1371,27 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
               GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
     }
   }
+  grpc_chttp2_update_stream_headroom(t);
+}
+
+void grpc_chttp2_update_stream_headroom(grpc_chttp2_transport* t) {
+  if (!t->is_client) return;
+  if (t->channelz_socket != nullptr) {
+    t->channelz_socket->SetStreamsWaitingForConcurrency(
+        static_cast<int64_t>(t->num_waiting_for_concurrency));
+  }
+  if (t->stream_headroom == nullptr) return;
+  int64_t headroom = 0;
+  if (t->goaway_error == GRPC_ERROR_NONE &&
+      t->next_stream_id <= MAX_CLIENT_STREAM_ID) {
+    headroom = static_cast<int64_t>(
+                   t->settings[GRPC_PEER_SETTINGS]
+                              [GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS]) -
+               static_cast<int64_t>(
+                   grpc_chttp2_stream_map_size(&t->stream_map)) -
+               static_cast<int64_t>(t->num_waiting_for_concurrency);
+  }
+  t->stream_headroom->set_headroom(headroom);
 }
 
 /* Flag that this closure barrier may be covering a write in a pollset, and so
@@ -1176,14 +1407,27 @@ static grpc_closure* add_closure_barrier(grpc_closure* closure) {
   return closure;
 }
 
-static void null_then_sched_closure(grpc_closure** closure) {
+static grpc_core::ExecCtx::ClosureLane stream_lane(grpc_chttp2_stream* s) {
+  return s != nullptr && s->latency_lane
+             ? grpc_core::ExecCtx::ClosureLane::kLatency
+             : grpc_core::ExecCtx::ClosureLane::kBulk;
+}
+
+static void note_message_size(grpc_chttp2_stream* s, uint32_t length) {
+  if (length > s->t->latency_lane_max_message_bytes) {
+    s->latency_lane = false;
+  }
+}
+
+static void null_then_sched_closure(grpc_chttp2_stream* s,
+                                    grpc_closure** closure) {
   grpc_closure* c = *closure;
   *closure = nullptr;
-  grpc_core::ExecCtx::Run(DEBUG_LOCATION, c, GRPC_ERROR_NONE);
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, c, GRPC_ERROR_NONE, stream_lane(s));
 }
 
 void grpc_chttp2_complete_closure_step(grpc_chttp2_transport* t,
-                                       grpc_chttp2_stream* /*s*/,
+                                       grpc_chttp2_stream* s,
                                        grpc_closure** pclosure,
                                        grpc_error* error, const char* desc) {
   grpc_closure* closure = *pclosure;
@@ -1223,7 +1467,7 @@ void grpc_chttp2_complete_closure_step(grpc_chttp2_transport* t,
       // Using GRPC_CLOSURE_SCHED instead of GRPC_CLOSURE_RUN to avoid running
       // closures earlier than when it is safe to do so.
       grpc_core::ExecCtx::Run(DEBUG_LOCATION, closure,
-                              closure->error_data.error);
+                              closure->error_data.error, stream_lane(s));
     } else {
       grpc_closure_list_append(&t->run_after_write, closure,
                                closure->error_data.error);
@@ -1256,6 +1500,22 @@ static void add_fetched_slice_locked(grpc_chttp2_transport* t,
   maybe_become_writable_due_to_send_msg(t, s);
 }
 
+/* Messages are pulled from their ByteStream only as fast as the peer lets us
+   send them: once flow_controlled_buffer holds more than the window (or the
+   write buffer size, if larger), the rest of the message stays in the
+   ByteStream, which may produce it lazily, rather than in our buffers. */
+static bool send_message_exceeds_window(grpc_chttp2_transport* t,
+                                        grpc_chttp2_stream* s) {
+  const uint32_t initial_window =
+      t->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE];
+  const int64_t stream_window =
+      s->flow_control->remote_window_delta() + initial_window;
+  const int64_t window =
+      GPR_MIN(stream_window, t->flow_control->remote_window());
+  return static_cast<int64_t>(s->flow_controlled_buffer.length) >
+         GPR_MAX(window, static_cast<int64_t>(t->write_buffer_size));
+}
+
 static void continue_fetching_send_locked(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream* s) {
   for (;;) {
@@ -1289,6 +1549,11 @@ static void continue_fetching_send_locked(grpc_chttp2_transport* t,
       }
       s->fetching_send_message.reset();
       return; /* early out */
+    } else if (send_message_exceeds_window(t, s)) {
+      /* The buffer is past write_buffer_size, so the stream is writable (or
+         will be once it has an id), and writing will resume us. */
+      s->fetching_send_message_paused = true;
+      return; /* early out */
     } else if (s->fetching_send_message->Next(
                    UINT32_MAX, GRPC_CLOSURE_INIT(&s->complete_fetch_locked,
                                                  ::complete_fetch, s,
@@ -1327,6 +1592,27 @@ static void complete_fetch_locked(void* gs, grpc_error* error) {
   }
 }
 
+void grpc_chttp2_maybe_resume_fetching_send(grpc_chttp2_transport* t,
+                                            grpc_chttp2_stream* s) {
+  if (!s->fetching_send_message_paused) return;
+  s->fetching_send_message_paused = false;
+  /* Not while the write is being framed: it is iterating the stream lists
+     that fetching adds to. */
+  GRPC_CHTTP2_STREAM_REF(s, "resume_fetching_send");
+  t->combiner->Run(GRPC_CLOSURE_INIT(&s->complete_fetch_locked,
+                                     resume_fetching_send_locked, s, nullptr),
+                   GRPC_ERROR_NONE);
+}
+
+static void resume_fetching_send_locked(void* gs, grpc_error* /*error*/) {
+  grpc_chttp2_stream* s = static_cast<grpc_chttp2_stream*>(gs);
+  /* The stream may have been cancelled since the fetch was paused. */
+  if (s->fetching_send_message != nullptr) {
+    continue_fetching_send_locked(s->t, s);
+  }
+  GRPC_CHTTP2_STREAM_UNREF(s, "resume_fetching_send");
+}
+
 static void log_metadata(const grpc_metadata_batch* md_batch, uint32_t id,
                          bool is_client, bool is_initial) {
   for (grpc_linked_mdelem* md = md_batch->list.head; md != nullptr;
@@ -1355,6 +1641,24 @@ static void perform_stream_op_locked(void* stream_op,
 
   s->context = op->payload->context;
   s->traced = op->is_traced;
+  if (s->traced && s->write_timestamps == nullptr &&
+      op_payload->context != nullptr) {
+    void* write_timestamps =
+        op_payload->context[GRPC_CONTEXT_WRITE_TIMESTAMPS].value;
+    if (write_timestamps != nullptr) {
+      s->write_timestamps =
+          static_cast<grpc_core::CallWriteTimestamps*>(write_timestamps)
+              ->Ref();
+    }
+  }
+  if (op_payload->context != nullptr) {
+    uintptr_t write_weight = reinterpret_cast<uintptr_t>(
+        op_payload->context[GRPC_CONTEXT_WRITE_WEIGHT].value);
+    if (write_weight != 0) {
+      s->write_weight = static_cast<uint32_t>(
+          GPR_MIN(write_weight, GRPC_CHTTP2_MAX_WRITE_WEIGHT));
+    }
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
     char* str = grpc_transport_stream_op_batch_string(op);
     gpr_log(GPR_INFO, "perform_stream_op_locked: %s; on_complete = %p", str,
@@ -1442,6 +1746,9 @@ static void perform_stream_op_locked(void* stream_op,
             GPR_ASSERT(s->id == 0);
             grpc_chttp2_list_add_waiting_for_concurrency(t, s);
             maybe_start_some_streams(t);
+            if (s->id == 0 && t->channelz_socket != nullptr) {
+              t->channelz_socket->RecordStreamQueuedForConcurrency();
+            }
           } else {
             grpc_chttp2_cancel_stream(
                 t, s,
@@ -1481,6 +1788,7 @@ static void perform_stream_op_locked(void* stream_op,
     t->num_messages_in_next_write++;
     GRPC_STATS_INC_HTTP2_SEND_MESSAGE_SIZE(
         op->payload->send_message.send_message->length());
+    note_message_size(s, op->payload->send_message.send_message->length());
     on_complete->next_data.scratch |= CLOSURE_BARRIER_MAY_COVER_WRITE;
     s->fetching_send_message_finished = add_closure_barrier(op->on_complete);
     if (s->write_closed) {
@@ -1760,7 +2068,10 @@ void grpc_chttp2_ack_ping(grpc_chttp2_transport* t, uint64_t id) {
     return;
   }
   grpc_core::ExecCtx::RunList(DEBUG_LOCATION,
-                              &pq->lists[GRPC_CHTTP2_PCL_INFLIGHT]);
+                              &pq->lists[GRPC_CHTTP2_PCL_INFLIGHT],
+                              t->latency_lane_max_message_bytes > 0
+                                  ? grpc_core::ExecCtx::ClosureLane::kLatency
+                                  : grpc_core::ExecCtx::ClosureLane::kBulk);
   if (!grpc_closure_list_empty(pq->lists[GRPC_CHTTP2_PCL_NEXT])) {
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_CONTINUE_PINGS);
   }
@@ -1833,6 +2144,11 @@ static void perform_transport_op_locked(void* stream_op,
     t->state_tracker.RemoveWatcher(op->stop_connectivity_watch);
   }
 
+  if (op->watch_stream_headroom != nullptr) {
+    t->stream_headroom = std::move(op->watch_stream_headroom);
+    grpc_chttp2_update_stream_headroom(t);
+  }
+
   if (op->disconnect_with_error != GRPC_ERROR_NONE) {
     close_transport_locked(t, op->disconnect_with_error);
   }
@@ -1873,7 +2189,7 @@ void grpc_chttp2_maybe_complete_recv_initial_metadata(
     }
     grpc_chttp2_incoming_metadata_buffer_publish(&s->metadata_buffer[0],
                                                  s->recv_initial_metadata);
-    null_then_sched_closure(&s->recv_initial_metadata_ready);
+    null_then_sched_closure(s, &s->recv_initial_metadata_ready);
   }
 }
 
@@ -1953,10 +2269,11 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* /*t*/,
     s->unprocessed_incoming_frames_buffer_cached_length =
         s->unprocessed_incoming_frames_buffer.length;
     if (error == GRPC_ERROR_NONE && *s->recv_message != nullptr) {
-      null_then_sched_closure(&s->recv_message_ready);
+      note_message_size(s, (*s->recv_message)->length());
+      null_then_sched_closure(s, &s->recv_message_ready);
     } else if (s->published_metadata[1] != GRPC_METADATA_NOT_PUBLISHED) {
       *s->recv_message = nullptr;
-      null_then_sched_closure(&s->recv_message_ready);
+      null_then_sched_closure(s, &s->recv_message_ready);
     }
     GRPC_ERROR_UNREF(error);
   }
@@ -2023,7 +2340,7 @@ void grpc_chttp2_maybe_complete_recv_trailing_metadata(grpc_chttp2_transport* t,
       s->collecting_stats = nullptr;
       grpc_chttp2_incoming_metadata_buffer_publish(&s->metadata_buffer[1],
                                                    s->recv_trailing_metadata);
-      null_then_sched_closure(&s->recv_trailing_metadata_finished);
+      null_then_sched_closure(s, &s->recv_trailing_metadata_finished);
     }
   }
 }
@@ -2054,6 +2371,7 @@ static void remove_stream(grpc_chttp2_transport* t, uint32_t id,
 
   if (grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
     post_benign_reclaimer(t);
+    start_idle_compaction_timer(t);
     if (t->sent_goaway_state == GRPC_CHTTP2_GOAWAY_SENT) {
       close_transport_locked(
           t, GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
@@ -2186,6 +2504,7 @@ void grpc_chttp2_fail_pending_writes(grpc_chttp2_transport* t,
                                     "send_trailing_metadata_finished");
 
   s->fetching_send_message.reset();
+  s->fetching_send_message_paused = false;
   grpc_chttp2_complete_closure_step(t, s, &s->fetching_send_message_finished,
                                     GRPC_ERROR_REF(error),
                                     "fetching_send_message_finished");
@@ -2223,6 +2542,7 @@ void grpc_chttp2_mark_stream_closed(grpc_chttp2_transport* t,
     } else {
       /* Purge streams waiting on concurrency still waiting for id assignment */
       grpc_chttp2_list_remove_waiting_for_concurrency(t, s);
+      grpc_chttp2_update_stream_headroom(t);
     }
     if (overall_error != GRPC_ERROR_NONE) {
       grpc_chttp2_fake_status(t, s, overall_error);
@@ -2573,7 +2893,7 @@ static void read_action_locked(void* tp, grpc_error* error) {
     keep_reading = true;
     /* Since we have read a byte, reset the keepalive timer */
     if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-      grpc_timer_cancel(&t->keepalive_ping_timer);
+      t->keepalive_ping_timer.RecordActivity();
     }
   }
   grpc_slice_buffer_reset_and_unref_internal(&t->read_buffer);
@@ -2634,7 +2954,7 @@ static void start_bdp_ping_locked(void* tp, grpc_error* error) {
   }
   /* Reset the keepalive ping timer */
   if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-    grpc_timer_cancel(&t->keepalive_ping_timer);
+    t->keepalive_ping_timer.RecordActivity();
   }
   t->flow_control->bdp_estimator()->StartPing();
   t->bdp_ping_started = true;
@@ -2787,18 +3107,20 @@ static void init_keepalive_ping_locked(void* arg, grpc_error* error) {
       GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
       GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                         grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      grpc_core::KeepaliveScheduler::Schedule(
+          &t->keepalive_ping_timer, t->keepalive_time,
+          keepalive_timer_slack(t->keepalive_time),
+          &t->init_keepalive_ping_locked);
     }
   } else if (error == GRPC_ERROR_CANCELLED) {
-    /* The keepalive ping timer may be cancelled by bdp */
+    /* The keepalive timers are cancelled when the timer list shuts down */
     GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
     GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                       grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    grpc_core::KeepaliveScheduler::Schedule(
+        &t->keepalive_ping_timer, t->keepalive_time,
+        keepalive_timer_slack(t->keepalive_time),
+        &t->init_keepalive_ping_locked);
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "init keepalive ping");
 }
@@ -2824,9 +3146,11 @@ static void start_keepalive_ping_locked(void* arg, grpc_error* error) {
   GRPC_CHTTP2_REF_TRANSPORT(t, "keepalive watchdog");
   GRPC_CLOSURE_INIT(&t->keepalive_watchdog_fired_locked,
                     keepalive_watchdog_fired, t, grpc_schedule_on_exec_ctx);
-  grpc_timer_init(&t->keepalive_watchdog_timer,
-                  grpc_core::ExecCtx::Get()->Now() + t->keepalive_timeout,
-                  &t->keepalive_watchdog_fired_locked);
+  grpc_timer_init_with_slack(
+      &t->keepalive_watchdog_timer,
+      grpc_core::ExecCtx::Get()->Now() + t->keepalive_timeout,
+      keepalive_timer_slack(t->keepalive_timeout),
+      &t->keepalive_watchdog_fired_locked);
   t->keepalive_ping_started = true;
 }
 
@@ -2856,12 +3180,14 @@ static void finish_keepalive_ping_locked(void* arg, grpc_error* error) {
       t->keepalive_ping_started = false;
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
       grpc_timer_cancel(&t->keepalive_watchdog_timer);
+      maybe_grow_keepalive_time(t);
       GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
       GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                         grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      grpc_core::KeepaliveScheduler::Schedule(
+          &t->keepalive_ping_timer, t->keepalive_time,
+          keepalive_timer_slack(t->keepalive_time),
+          &t->init_keepalive_ping_locked);
     }
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "keepalive ping end");
@@ -3179,10 +3505,106 @@ static void benign_reclaimer(void* arg, grpc_error* error) {
                    GRPC_ERROR_REF(error));
 }
 
+// Asks the peer to shrink the hpack decoder table to
+// GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER_PRESSURE. Returns false if the
+// table is not capped or holds no memory.
+static bool cap_hpack_decoder_table_locked(grpc_chttp2_transport* t) {
+  if (t->hpack_decoder_table_size_under_pressure < 0 ||
+      t->hpack_parser.table.cap_entries == 0) {
+    return false;
+  }
+  const uint32_t cap =
+      static_cast<uint32_t>(t->hpack_decoder_table_size_under_pressure);
+  if (t->settings[GRPC_LOCAL_SETTINGS]
+                 [GRPC_CHTTP2_SETTINGS_HEADER_TABLE_SIZE] <= cap) {
+    return false;
+  }
+  queue_setting_update(t, GRPC_CHTTP2_SETTINGS_HEADER_TABLE_SIZE, cap);
+  grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_SEND_SETTINGS);
+  return true;
+}
+
+// Frees what the transport keeps around only to save work later: the grown
+// slice arrays of its idle write buffers, the hpack parser's string buffers,
+// and the encoder's refs on metadata that is no longer in the peer's table.
+// Returns the number of bytes freed.
+static size_t release_cached_memory_locked(grpc_chttp2_transport* t) {
+  size_t buffer_bytes = grpc_chttp2_hpack_parser_release_scratch(
+      &t->hpack_parser);
+  buffer_bytes += grpc_slice_buffer_shrink_internal(&t->qbuf);
+  if (t->write_state == GRPC_CHTTP2_WRITE_STATE_IDLE) {
+    buffer_bytes += grpc_slice_buffer_shrink_internal(&t->outbuf);
+  }
+  const size_t hpack_bytes =
+      grpc_chttp2_hpack_compressor_release_stale(&t->hpack_compressor);
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_MEMORY_RECLAIMED_BUFFER_BYTES,
+                            buffer_bytes);
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_MEMORY_RECLAIMED_HPACK_BYTES,
+                            hpack_bytes);
+  return buffer_bytes + hpack_bytes;
+}
+
+// A rough count of the bytes the transport holds for the connection, apart
+// from its streams and the endpoint.
+static size_t transport_memory_locked(grpc_chttp2_transport* t) {
+  size_t bytes = sizeof(*t);
+  bytes += t->stream_map.capacity * (sizeof(uint32_t) + sizeof(void*));
+  bytes += t->hpack_parser.table.cap_entries * sizeof(grpc_mdelem) +
+           t->hpack_parser.table.mem_used;
+  bytes += t->hpack_parser.key.data.copied.capacity +
+           t->hpack_parser.value.data.copied.capacity;
+  bytes += t->hpack_compressor.cap_table_elems *
+           sizeof(*t->hpack_compressor.table_elem_size);
+  grpc_slice_buffer* buffers[] = {&t->outbuf, &t->qbuf};
+  for (grpc_slice_buffer* sb : buffers) {
+    bytes += sb->length;
+    if (sb->base_slices != sb->inlined) {
+      bytes += sb->capacity * sizeof(grpc_slice);
+    }
+  }
+  return bytes;
+}
+
+static void update_channelz_transport_memory(grpc_chttp2_transport* t) {
+  if (t->channelz_socket != nullptr) {
+    t->channelz_socket->SetTransportMemory(
+        static_cast<int64_t>(transport_memory_locked(t)));
+  }
+}
+
+// Besides the caches, shrinks the stream map and the hpack decoder table's
+// entry array, which are only needed at their grown size while streams are
+// busy. All of it is allocated again as the connection is used.
+static size_t compact_idle_transport_locked(grpc_chttp2_transport* t) {
+  size_t released = release_cached_memory_locked(t);
+  released += grpc_chttp2_stream_map_shrink(&t->stream_map, 8);
+  released += grpc_chttp2_hptbl_shrink_to_fit(&t->hpack_parser.table);
+  return released;
+}
+
+// Each run takes the cheapest step that frees something, and stays posted
+// for the next run while costlier steps are left.
 static void benign_reclaimer_locked(void* arg, grpc_error* error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  size_t released = 0;
+  bool capped_hpack_table = false;
   if (error == GRPC_ERROR_NONE &&
-      grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
+      (released = release_cached_memory_locked(t)) > 0) {
+    /* Nothing but some work later is lost by freeing caches */
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+      gpr_log(GPR_INFO, "HTTP2: %s - released %" PRIuPTR " cached bytes",
+              t->peer_string, released);
+    }
+  } else if (error == GRPC_ERROR_NONE && cap_hpack_decoder_table_locked(t)) {
+    /* Giving back the decoder table is cheaper than losing the connection,
+     * so try that first */
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+      gpr_log(GPR_INFO, "HTTP2: %s - cap hpack decoder table to %d bytes",
+              t->peer_string, t->hpack_decoder_table_size_under_pressure);
+    }
+    capped_hpack_table = true;
+  } else if (error == GRPC_ERROR_NONE &&
+             grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
     /* Channel with no active streams: send a goaway to try and make it
      * disconnect cleanly */
     if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
@@ -3201,6 +3623,11 @@ static void benign_reclaimer_locked(void* arg, grpc_error* error) {
             t->peer_string, grpc_chttp2_stream_map_size(&t->stream_map));
   }
   t->benign_reclaimer_registered = false;
+  if (released > 0 || (capped_hpack_table &&
+                       grpc_chttp2_stream_map_size(&t->stream_map) == 0)) {
+    /* the costlier steps are still left to the next run if that's not enough */
+    post_benign_reclaimer(t);
+  }
   if (error != GRPC_ERROR_CANCELLED) {
     grpc_resource_user_finish_reclamation(
         grpc_endpoint_get_resource_user(t->ep));
@@ -3246,6 +3673,67 @@ static void destructive_reclaimer_locked(void* arg, grpc_error* error) {
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "destructive_reclaimer");
 }
 
+/*******************************************************************************
+ * IDLE COMPACTION
+ */
+
+static void idle_compaction(void* arg, grpc_error* error);
+static void idle_compaction_locked(void* arg, grpc_error* error);
+
+// Called whenever the transport is left without streams: the timer fires
+// once the transport has stayed that way for idle_compaction_ms.
+static void start_idle_compaction_timer(grpc_chttp2_transport* t) {
+  if (t->idle_compaction_ms == 0) return;
+  t->idle_since = grpc_core::ExecCtx::Get()->Now();
+  update_channelz_transport_memory(t);
+  if (t->have_idle_compaction_timer ||
+      t->closed_with_error != GRPC_ERROR_NONE) {
+    return;
+  }
+  t->have_idle_compaction_timer = true;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "idle_compaction");
+  GRPC_CLOSURE_INIT(&t->idle_compaction_locked, idle_compaction, t,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->idle_compaction_timer,
+                  t->idle_since + t->idle_compaction_ms,
+                  &t->idle_compaction_locked);
+}
+
+static void idle_compaction(void* arg, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  t->combiner->Run(GRPC_CLOSURE_INIT(&t->idle_compaction_locked,
+                                     idle_compaction_locked, t, nullptr),
+                   GRPC_ERROR_REF(error));
+}
+
+static void idle_compaction_locked(void* arg, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  GPR_ASSERT(t->have_idle_compaction_timer);
+  t->have_idle_compaction_timer = false;
+  if (error == GRPC_ERROR_NONE && t->closed_with_error == GRPC_ERROR_NONE &&
+      grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
+    const grpc_millis deadline = t->idle_since + t->idle_compaction_ms;
+    if (deadline > grpc_core::ExecCtx::Get()->Now()) {
+      /* streams came and went since the timer was set: wait for the rest of
+       * the current idle period, reusing the transport ref */
+      t->have_idle_compaction_timer = true;
+      GRPC_CLOSURE_INIT(&t->idle_compaction_locked, idle_compaction, t,
+                        grpc_schedule_on_exec_ctx);
+      grpc_timer_init(&t->idle_compaction_timer, deadline,
+                      &t->idle_compaction_locked);
+      return;
+    }
+    const size_t released = compact_idle_transport_locked(t);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+      gpr_log(GPR_INFO,
+              "HTTP2: %s - idle compaction released %" PRIuPTR " bytes",
+              t->peer_string, released);
+    }
+    update_channelz_transport_memory(t);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "idle_compaction");
+}
+
 /*******************************************************************************
  * MONITORING
  */
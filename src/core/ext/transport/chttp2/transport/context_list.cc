@@ -28,13 +28,18 @@ void* (*get_copied_context_fn_g)(void*) = nullptr;
 
 namespace grpc_core {
 void ContextList::Append(ContextList** head, grpc_chttp2_stream* s) {
-  if (get_copied_context_fn_g == nullptr ||
-      write_timestamps_callback_g == nullptr) {
+  if (s->write_timestamps == nullptr &&
+      (get_copied_context_fn_g == nullptr ||
+       write_timestamps_callback_g == nullptr)) {
     return;
   }
   /* Create a new element in the list and add it at the front */
   ContextList* elem = new ContextList();
-  elem->trace_context_ = get_copied_context_fn_g(s->context);
+  if (s->write_timestamps != nullptr) {
+    elem->write_timestamps_ = s->write_timestamps;
+  } else {
+    elem->trace_context_ = get_copied_context_fn_g(s->context);
+  }
   elem->byte_offset_ = s->byte_counter;
   elem->next_ = *head;
   *head = elem;
@@ -45,7 +50,14 @@ void ContextList::Execute(void* arg, grpc_core::Timestamps* ts,
   ContextList* head = static_cast<ContextList*>(arg);
   ContextList* to_be_freed;
   while (head != nullptr) {
-    if (write_timestamps_callback_g) {
+    if (head->write_timestamps_ != nullptr) {
+      /* Writes cut short by the shutdown of the endpoint only have part of
+       * their timestamps */
+      if (ts != nullptr && error == GRPC_ERROR_NONE) {
+        ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
+        head->write_timestamps_->Record(*ts);
+      }
+    } else if (write_timestamps_callback_g) {
       if (ts) {
         ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
       }
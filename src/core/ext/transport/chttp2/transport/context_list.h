@@ -30,7 +30,8 @@ namespace grpc_core {
 class ContextList {
  public:
   /* Creates a new element with \a context as the value and appends it to the
-   * list. */
+   * list. If \a s has a CallWriteTimestamps, the element records the
+   * timestamps there instead of passing them to the global callback. */
   static void Append(ContextList** head, grpc_chttp2_stream* s);
 
   /* Executes a function \a fn with each context in the list and \a ts. It also
@@ -40,6 +41,7 @@ class ContextList {
 
  private:
   void* trace_context_ = nullptr;
+  RefCountedPtr<CallWriteTimestamps> write_timestamps_;
   ContextList* next_ = nullptr;
   size_t byte_offset_ = 0;
 };
@@ -173,7 +173,9 @@ TransportFlowControlDisabled::TransportFlowControlDisabled(
 }
 
 TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
-                                           bool enable_bdp_probe)
+                                           bool enable_bdp_probe,
+                                           bool bbr_autotuning,
+                                           bool adaptive_max_frame_size)
     : t_(t),
       enable_bdp_probe_(enable_bdp_probe),
       bdp_estimator_(t->peer_string),
@@ -185,7 +187,9 @@ TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
                           .set_min_control_value(-1)
                           .set_max_control_value(25)
                           .set_integral_range(10)),
-      last_pid_update_(grpc_core::ExecCtx::Get()->Now()) {}
+      last_pid_update_(grpc_core::ExecCtx::Get()->Now()),
+      bbr_autotuning_(bbr_autotuning),
+      adaptive_max_frame_size_(adaptive_max_frame_size) {}
 
 uint32_t TransportFlowControl::MaybeSendUpdate(bool writing_anyway) {
   FlowControlTrace trace("t updt sent", this, nullptr);
@@ -215,6 +219,26 @@ grpc_error* TransportFlowControl::ValidateRecvData(
   return GRPC_ERROR_NONE;
 }
 
+// Memory pressure above which windows stop growing, and at which they reach
+// zero
+static const double kHighMemPressure = 0.8;
+static const double kMaxMemPressure = 0.9;
+
+// Scales down what a stream may receive ahead of the application under heavy
+// memory pressure, so that a peer can't get every stream to buffer a whole
+// large message before the application reads any of it. The stream keeps its
+// initial window, so reads still make progress.
+static uint32_t AdjustLookaheadForMemoryPressure(grpc_resource_quota* quota,
+                                                 uint32_t lookahead) {
+  double memory_pressure = grpc_resource_quota_get_memory_pressure(quota);
+  if (memory_pressure > kHighMemPressure) {
+    lookahead = static_cast<uint32_t>(
+        lookahead * (1 - GPR_MIN(1, (memory_pressure - kHighMemPressure) /
+                                        (kMaxMemPressure - kHighMemPressure))));
+  }
+  return lookahead;
+}
+
 StreamFlowControl::StreamFlowControl(TransportFlowControl* tfc,
                                      const grpc_chttp2_stream* s)
     : tfc_(tfc), s_(s) {}
@@ -296,6 +320,10 @@ void StreamFlowControl::IncomingByteStreamUpdate(size_t max_size_hint,
   } else {
     max_recv_bytes = 0;
   }
+  max_recv_bytes = AdjustLookaheadForMemoryPressure(
+      grpc_resource_user_quota(
+          grpc_endpoint_get_resource_user(tfc_->transport()->ep)),
+      max_recv_bytes);
 
   /* add some small lookahead to keep pipelines flowing */
   GPR_ASSERT(max_recv_bytes <= UINT32_MAX - sent_init_window);
@@ -313,8 +341,6 @@ static double AdjustForMemoryPressure(grpc_resource_quota* quota,
   double memory_pressure = grpc_resource_quota_get_memory_pressure(quota);
   static const double kLowMemPressure = 0.1;
   static const double kZeroTarget = 22;
-  static const double kHighMemPressure = 0.8;
-  static const double kMaxMemPressure = 0.9;
   if (memory_pressure < kLowMemPressure && target < kZeroTarget) {
     target = (target - kZeroTarget) * memory_pressure / kLowMemPressure +
              kZeroTarget;
@@ -341,6 +367,29 @@ double TransportFlowControl::SmoothLogBdp(double value) {
   return pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt);
 }
 
+double TransportFlowControl::BbrTargetWindow() {
+  // Never let the connection window take more than a quarter of what is left
+  // in the resource quota
+  grpc_resource_quota* quota =
+      grpc_resource_user_quota(grpc_endpoint_get_resource_user(t_->ep));
+  const double available =
+      static_cast<double>(grpc_resource_quota_peek_size(quota)) *
+      (1 - grpc_resource_quota_get_memory_pressure(quota));
+  max_window_ = static_cast<int64_t> GPR_CLAMP(available / 4, kDefaultWindow,
+                                               kMaxWindow);
+  const double bdp = bdp_estimator_.ModelBdp();
+  if (bdp == 0) {
+    return GPR_MIN(target_initial_window_size_, max_window_);
+  }
+  // Windows only get topped up once half used, so about half of the window is
+  // in flight. On top of that, a sender limited by the window only shows a
+  // higher delivery rate to the next ping if the window lets it go faster:
+  // double the rate each round during startup, like BBR, and leave a quarter
+  // of headroom afterwards.
+  const double gain = bdp_estimator_.FilledPipe() ? 2.5 : 4;
+  return GPR_CLAMP(gain * bdp, kDefaultWindow, max_window_);
+}
+
 FlowControlAction::Urgency TransportFlowControl::DeltaUrgency(
     int64_t value, grpc_chttp2_setting_id setting_id) {
   int64_t delta = value - static_cast<int64_t>(
@@ -360,7 +409,9 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
     // target might change based on how much memory pressure we are under
     // TODO(ncteisen): experiment with setting target to be huge under low
     // memory pressure.
-    const double target = pow(2, SmoothLogBdp(TargetLogBdp()));
+    const double target = bbr_autotuning_
+                              ? BbrTargetWindow()
+                              : pow(2, SmoothLogBdp(TargetLogBdp()));
 
     // Though initial window 'could' drop to 0, we keep the floor at 128
     target_initial_window_size_ =
@@ -371,21 +422,64 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
                      GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE),
         static_cast<uint32_t>(target_initial_window_size_));
 
-    // get bandwidth estimate and update max_frame accordingly.
-    double bw_dbl = bdp_estimator_.EstimateBandwidth();
-    // we target the max of BDP or bandwidth in microseconds.
-    int32_t frame_size = static_cast<int32_t> GPR_CLAMP(
-        GPR_MAX((int32_t)GPR_CLAMP(bw_dbl, 0, INT_MAX) / 1000,
-                target_initial_window_size_),
-        16384, 16777215);
-    action.set_send_max_frame_size_update(
-        DeltaUrgency(static_cast<int64_t>(frame_size),
-                     GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE),
-        frame_size);
+    // with adaptive max frame size RecvMessage() sets it instead
+    if (!adaptive_max_frame_size_) {
+      // get bandwidth estimate and update max_frame accordingly.
+      double bw_dbl = bdp_estimator_.EstimateBandwidth();
+      // we target the max of BDP or bandwidth in microseconds.
+      int32_t frame_size = static_cast<int32_t> GPR_CLAMP(
+          GPR_MAX((int32_t)GPR_CLAMP(bw_dbl, 0, INT_MAX) / 1000,
+                  target_initial_window_size_),
+          16384, 16777215);
+      action.set_send_max_frame_size_update(
+          DeltaUrgency(static_cast<int64_t>(frame_size),
+                       GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE),
+          frame_size);
+    }
   }
   return UpdateAction(action);
 }
 
+FlowControlAction TransportFlowControl::RecvMessage(uint32_t length) {
+  FlowControlAction action;
+  if (!adaptive_max_frame_size_) return action;
+  size_t bucket = 0;
+  while (bucket < kMessageSizeBuckets - 1 && (length >> bucket) != 0) {
+    ++bucket;
+  }
+  ++message_size_buckets_[bucket];
+  ++message_size_samples_;
+  if (++messages_since_update_ < kMessageSizeSamplesPerUpdate) return action;
+  messages_since_update_ = 0;
+  uint32_t frame_size = MessageSizeTargetFrameSize();
+  action.set_send_max_frame_size_update(
+      DeltaUrgency(static_cast<int64_t>(frame_size),
+                   GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE),
+      frame_size);
+  message_size_samples_ = 0;
+  for (size_t i = 0; i < kMessageSizeBuckets; i++) {
+    message_size_buckets_[i] /= 2;
+    message_size_samples_ += message_size_buckets_[i];
+  }
+  return action;
+}
+
+// The smallest frame size that carries nine in ten of the messages seen in a
+// single frame, within the limits HTTP/2 allows.
+uint32_t TransportFlowControl::MessageSizeTargetFrameSize() const {
+  const uint32_t wanted = message_size_samples_ - message_size_samples_ / 10;
+  uint32_t seen = 0;
+  size_t bucket = 0;
+  for (; bucket < kMessageSizeBuckets - 1; bucket++) {
+    seen += message_size_buckets_[bucket];
+    if (seen >= wanted) break;
+  }
+  // messages in the bucket are less than 2^bucket bytes long, and the gRPC
+  // message header adds another five
+  const uint64_t frame_size = (static_cast<uint64_t>(1) << bucket) + 4;
+  return static_cast<uint32_t> GPR_CLAMP(frame_size, 16384, 16777215);
+}
+
 FlowControlAction StreamFlowControl::UpdateAction(FlowControlAction action) {
   // TODO(ncteisen): tune this
   if (!s_->read_closed) {
@@ -174,6 +174,10 @@ class TransportFlowControlBase {
   // Called to do bookkeeping when we receive a WINDOW_UPDATE frame.
   virtual void RecvUpdate(uint32_t /* size */) { abort(); }
 
+  // Called when a stream owned by this transport starts receiving a message
+  // of \a length bytes. May return an Action changing our max frame size.
+  virtual FlowControlAction RecvMessage(uint32_t /* length */) { abort(); }
+
   // Returns the BdpEstimator held by this object. Caller is responsible for
   // checking for nullptr. TODO(ncteisen): consider fully encapsulating all
   // bdp estimator actions inside TransportFlowControl
@@ -215,13 +219,22 @@ class TransportFlowControlDisabled final : public TransportFlowControlBase {
     return GRPC_ERROR_NONE;
   }
   void RecvUpdate(uint32_t /* size */) override {}
+  FlowControlAction RecvMessage(uint32_t /* length */) override {
+    return FlowControlAction();
+  }
 };
 
 // Implementation of flow control that abides to HTTP/2 spec and attempts
 // to be as performant as possible.
 class TransportFlowControl final : public TransportFlowControlBase {
  public:
-  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe);
+  // With \a bbr_autotuning, windows follow the BdpEstimator's model of the
+  // path rather than its PID controlled BDP estimate. With
+  // \a adaptive_max_frame_size, the max frame size follows the sizes of the
+  // messages received rather than the bandwidth estimate.
+  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe,
+                       bool bbr_autotuning = false,
+                       bool adaptive_max_frame_size = false);
   ~TransportFlowControl() {}
 
   bool flow_control_enabled() const override { return true; }
@@ -266,13 +279,14 @@ class TransportFlowControl final : public TransportFlowControlBase {
     remote_window_ += size;
   }
 
+  FlowControlAction RecvMessage(uint32_t length) override;
+
   // See comment above announced_stream_total_over_incoming_window_ for the
   // logic behind this decision.
   int64_t target_window() const override {
     return static_cast<uint32_t> GPR_MIN(
-        (int64_t)((1u << 31) - 1),
-        announced_stream_total_over_incoming_window_ +
-            target_initial_window_size_);
+        max_window_, announced_stream_total_over_incoming_window_ +
+                         target_initial_window_size_);
   }
 
   const grpc_chttp2_transport* transport() const { return t_; }
@@ -297,8 +311,14 @@ class TransportFlowControl final : public TransportFlowControlBase {
   }
 
  private:
+  // Bit lengths of message sizes up to the largest allowed max frame size
+  static constexpr size_t kMessageSizeBuckets = 25;
+  static constexpr uint32_t kMessageSizeSamplesPerUpdate = 64;
+
   double TargetLogBdp();
   double SmoothLogBdp(double value);
+  double BbrTargetWindow();
+  uint32_t MessageSizeTargetFrameSize() const;
   FlowControlAction::Urgency DeltaUrgency(int64_t value,
                                           grpc_chttp2_setting_id setting_id);
 
@@ -331,6 +351,19 @@ class TransportFlowControl final : public TransportFlowControlBase {
   /* pid controller */
   grpc_core::PidController pid_controller_;
   grpc_millis last_pid_update_ = 0;
+
+  /* bbr style autotuning */
+  const bool bbr_autotuning_;
+  /** cap on target_window(), from the resource quota */
+  int64_t max_window_ = kMaxWindow;
+
+  /* message size driven max frame size */
+  const bool adaptive_max_frame_size_;
+  /** count of received messages by the bit length of their size, halved
+      after every update so that old traffic fades out */
+  uint32_t message_size_buckets_[kMessageSizeBuckets] = {};
+  uint32_t message_size_samples_ = 0;
+  uint32_t messages_since_update_ = 0;
 };
 
 // Fat interface with all methods a stream flow control implementation needs
@@ -26,6 +26,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -89,6 +90,7 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
 
   stats->framing_bytes += header_size;
   stats->data_bytes += write_bytes;
+  GRPC_STATS_INC_HTTP2_SEND_DATA_FRAMES();
 }
 
 grpc_error* grpc_deframe_unprocessed_incoming_frames(
@@ -187,6 +189,9 @@ grpc_error* grpc_deframe_unprocessed_incoming_frames(
         if (t->channelz_socket != nullptr) {
           t->channelz_socket->RecordMessageReceived();
         }
+        GRPC_STATS_INC_HTTP2_RECV_MESSAGES();
+        grpc_chttp2_act_on_flowctl_action(
+            t->flow_control->RecvMessage(p->frame_size), t, nullptr);
         p->state = GRPC_CHTTP2_DATA_FRAME;
         ++cur;
         message_flags = 0;
@@ -217,46 +222,37 @@ grpc_error* grpc_deframe_unprocessed_incoming_frames(
           continue;
         }
         uint32_t remaining = static_cast<uint32_t>(end - cur);
-        if (remaining == p->frame_size) {
+        if (remaining <= p->frame_size) {
           s->stats.incoming.data_bytes += remaining;
+          // The rest of the slice belongs to this frame: hand the buffer's
+          // reference over to the message rather than taking another one
+          grpc_slice data = grpc_slice_sub_no_ref(
+              grpc_slice_buffer_take_first(slices),
+              static_cast<size_t>(cur - beg), static_cast<size_t>(end - beg));
           if (GRPC_ERROR_NONE !=
-              (error = p->parsing_frame->Push(
-                   grpc_slice_sub(*slice, static_cast<size_t>(cur - beg),
-                                  static_cast<size_t>(end - beg)),
-                   slice_out))) {
-            grpc_slice_buffer_remove_first(slices);
+              (error = p->parsing_frame->Push(data, slice_out))) {
             return error;
           }
+          p->frame_size -= remaining;
+          if (p->frame_size > 0) {
+            return GRPC_ERROR_NONE;
+          }
           if (GRPC_ERROR_NONE !=
               (error = p->parsing_frame->Finished(GRPC_ERROR_NONE, true))) {
-            grpc_slice_buffer_remove_first(slices);
             return error;
           }
           p->parsing_frame = nullptr;
           p->state = GRPC_CHTTP2_DATA_FH_0;
-          grpc_slice_buffer_remove_first(slices);
-          return GRPC_ERROR_NONE;
-        } else if (remaining < p->frame_size) {
-          s->stats.incoming.data_bytes += remaining;
-          if (GRPC_ERROR_NONE !=
-              (error = p->parsing_frame->Push(
-                   grpc_slice_sub(*slice, static_cast<size_t>(cur - beg),
-                                  static_cast<size_t>(end - beg)),
-                   slice_out))) {
-            return error;
-          }
-          p->frame_size -= remaining;
-          grpc_slice_buffer_remove_first(slices);
           return GRPC_ERROR_NONE;
         } else {
           GPR_ASSERT(remaining > p->frame_size);
           s->stats.incoming.data_bytes += p->frame_size;
           if (GRPC_ERROR_NONE !=
-              p->parsing_frame->Push(
-                  grpc_slice_sub(
-                      *slice, static_cast<size_t>(cur - beg),
-                      static_cast<size_t>(cur + p->frame_size - beg)),
-                  slice_out)) {
+              (error = p->parsing_frame->Push(
+                   grpc_slice_sub(
+                       *slice, static_cast<size_t>(cur - beg),
+                       static_cast<size_t>(cur + p->frame_size - beg)),
+                   slice_out))) {
             grpc_slice_buffer_remove_first(slices);
             return error;
           }
@@ -283,6 +279,9 @@ grpc_error* grpc_chttp2_data_parser_parse(void* /*parser*/,
                                           grpc_chttp2_stream* s,
                                           const grpc_slice& slice,
                                           int is_last) {
+  // The payload outlives this read: from here on it may be pulled and
+  // released by the application, concurrently with the transport.
+  grpc_slice_publish(slice);
   if (!s->pending_byte_stream) {
     grpc_slice_ref_internal(slice);
     grpc_slice_buffer_add(&s->frame_storage, slice);
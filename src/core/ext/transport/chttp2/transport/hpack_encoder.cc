@@ -33,6 +33,7 @@
 
 #include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_table.h"
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -71,8 +72,16 @@ constexpr size_t kDataFrameHeaderSize = 9;
 constexpr uint8_t kMaxFilterValue = 255;
 
 /* if the probability of this item being seen again is < 1/x then don't add
-   it to the table */
-#define ONE_ON_ADD_PROBABILITY (GRPC_CHTTP2_HPACKC_NUM_VALUES >> 1)
+   it to the table: elems need eight times the count that traffic spread
+   evenly over a sketch row would give each counter, so that elems seen once
+   are not added just because the sum was halved recently */
+#define ONE_ON_ADD_PROBABILITY (GRPC_CHTTP2_HPACKC_SKETCH_WIDTH >> 3)
+/* elems that are not interned are only added to the table (which interns
+   them) once they have been seen at least this many times */
+constexpr uint8_t kMinPopularityToIntern = 2;
+/* values of headers carrying credentials shorter than this are sent as
+   never-indexed literals */
+constexpr size_t kMaxNeverIndexedValueLength = 25;
 /* The hpack index we encode over the wire. Meaningful to the hpack encoder and
    parser on the remote end as well as HTTP2. *Not* the same as
    HpackEncoderSlotHash, which is only meaningful to the hpack encoder
@@ -119,6 +128,16 @@ struct MetadataComparator {
   }
 };
 
+/* Matches the interned elems of the table against elems with the same key and
+   value, for looking up elems that are not interned themselves */
+struct MetadataContentComparator : public MetadataComparator {
+  static bool Equals(const grpc_mdelem md, const grpc_mdelem table_md) {
+    return table_md.payload != 0 &&
+           grpc_slice_eq(GRPC_MDKEY(md), GRPC_MDKEY(table_md)) &&
+           grpc_slice_eq(GRPC_MDVALUE(md), GRPC_MDVALUE(table_md));
+  }
+};
+
 /* Index table management */
 template <typename Hashtable>
 static HpackEncoderIndex HpackIndex(const Hashtable* hashtable,
@@ -223,38 +242,62 @@ static void UpdateAddOrEvict(Hashtable hashtable, const ValueType& value,
 #endif
 }
 
+/* position of an elem's counter in a row of the popularity sketch */
+static uint32_t SketchIndex(int row, uint32_t elem_hash) {
+  /* the first row uses the low bits of the hash, the others multiplicative
+     hashes of it, so that elems colliding in one row rarely do in another */
+  return row == 0 ? elem_hash & (GRPC_CHTTP2_HPACKC_SKETCH_WIDTH - 1)
+                  : ((elem_hash * (2654435761u + 2 * row)) >>
+                     (32 - GRPC_CHTTP2_HPACKC_SKETCH_WIDTH_BITS));
+}
+
 /* halve all counts because an element reached max */
-static void HalveFilter(uint8_t /*idx*/, uint32_t* sum, uint8_t* elems) {
+static void HalveFilter(uint32_t* sum,
+                        uint8_t (*elems)[GRPC_CHTTP2_HPACKC_SKETCH_WIDTH]) {
   *sum = 0;
-  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_VALUES; i++) {
-    elems[i] /= 2;
-    (*sum) += elems[i];
+  for (int i = 0; i < GRPC_CHTTP2_HPACKC_SKETCH_WIDTH; i++) {
+    elems[0][i] /= 2;
+    (*sum) += elems[0][i];
+  }
+  for (int row = 1; row < GRPC_CHTTP2_HPACKC_SKETCH_ROWS; row++) {
+    for (int i = 0; i < GRPC_CHTTP2_HPACKC_SKETCH_WIDTH; i++) {
+      elems[row][i] /= 2;
+    }
   }
 }
 
-/* increment a filter count, halve all counts if one element reaches max */
-static void IncrementFilter(uint8_t idx, uint32_t* sum, uint8_t* elems) {
-  elems[idx]++;
-  if (GPR_LIKELY(elems[idx] < kMaxFilterValue)) {
+/* increment the counts of an elem, halve all counts if one reaches max;
+   returns the new popularity of the elem */
+static uint8_t IncrementFilter(
+    uint32_t elem_hash, uint32_t* sum,
+    uint8_t (*elems)[GRPC_CHTTP2_HPACKC_SKETCH_WIDTH]) {
+  uint8_t popularity = kMaxFilterValue;
+  bool halve = false;
+  for (int row = 0; row < GRPC_CHTTP2_HPACKC_SKETCH_ROWS; row++) {
+    uint8_t* count = &elems[row][SketchIndex(row, elem_hash)];
+    (*count)++;
+    popularity = GPR_MIN(popularity, *count);
+    halve |= *count == kMaxFilterValue;
+  }
+  if (GPR_LIKELY(!halve)) {
     (*sum)++;
   } else {
-    HalveFilter(idx, sum, elems);
+    HalveFilter(sum, elems);
+    popularity /= 2;
   }
+  return popularity;
 }
 
-static uint32_t UpdateHashtablePopularity(
+static uint8_t UpdateHashtablePopularity(
     grpc_chttp2_hpack_compressor* hpack_compressor, uint32_t elem_hash) {
-  const uint32_t popularity_hash = HASH_FRAGMENT_1(elem_hash);
-  IncrementFilter(popularity_hash, &hpack_compressor->filter_elems_sum,
-                  hpack_compressor->filter_elems);
-  return popularity_hash;
+  return IncrementFilter(elem_hash, &hpack_compressor->filter_elems_sum,
+                         hpack_compressor->filter_elems);
 }
 
 static bool CanAddToHashtable(grpc_chttp2_hpack_compressor* hpack_compressor,
-                              uint32_t popularity_hash) {
+                              uint8_t popularity) {
   const bool can_add =
-      hpack_compressor->filter_elems[popularity_hash] >=
-      hpack_compressor->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
+      popularity >= hpack_compressor->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
   return can_add;
 }
 } /* namespace */
@@ -277,8 +320,15 @@ typedef struct {
   /* maximum size of a frame */
   size_t max_frame_size;
   bool use_true_binary_metadata;
+  /* the indices emitted so far, to pre-encode the header block */
+  uint32_t indices[GRPC_CHTTP2_HPACKC_PREENCODED_MAX_ELEMS];
+  size_t num_indices;
 } framer_state;
 
+static_assert(grpc_mdelem_group::kMaxElems <=
+                  GRPC_CHTTP2_HPACKC_PREENCODED_MAX_ELEMS,
+              "the indices of a whole mdelem group must be recorded");
+
 /* fills p (which is expected to be kDataFrameHeaderSize bytes long)
  * with a data frame header */
 static void fill_header(uint8_t* p, uint8_t type, uint32_t id, size_t len,
@@ -455,6 +505,10 @@ static void add_key(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
 static void emit_indexed(grpc_chttp2_hpack_compressor* /*c*/,
                          uint32_t elem_index, framer_state* st) {
   GRPC_STATS_INC_HPACK_SEND_INDEXED();
+  if (st->num_indices < GRPC_CHTTP2_HPACKC_PREENCODED_MAX_ELEMS) {
+    st->indices[st->num_indices] = elem_index;
+  }
+  st->num_indices++;
   uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(elem_index, 1);
   GRPC_CHTTP2_WRITE_VARINT(elem_index, 1, 0x80, add_tiny_header_data(st, len),
                            len);
@@ -476,6 +530,24 @@ struct wire_value {
   const size_t length;
 };
 
+/* Huffman compressing a non binary value only pays off if it saves at least a
+   byte. Values made of symbols with long codes (upper case letters,
+   punctuation) do not get any shorter, which a few evenly spaced samples of a
+   long value tell before compressing it. */
+#define HUFFMAN_SAMPLES 16
+
+static bool huffman_may_pay_off(const grpc_slice& value) {
+  const size_t length = GRPC_SLICE_LENGTH(value);
+  if (length < 2) return false;
+  if (length < 4 * HUFFMAN_SAMPLES) return true;
+  const uint8_t* data = GRPC_SLICE_START_PTR(value);
+  uint32_t nbits = 0;
+  for (size_t i = 0; i < HUFFMAN_SAMPLES; i++) {
+    nbits += grpc_chttp2_huffsyms[data[i * length / HUFFMAN_SAMPLES]].length;
+  }
+  return nbits < 8 * HUFFMAN_SAMPLES;
+}
+
 template <bool mdkey_definitely_interned>
 static wire_value get_wire_value(grpc_mdelem elem, bool true_binary_enabled) {
   const bool is_bin_hdr =
@@ -493,7 +565,12 @@ static wire_value get_wire_value(grpc_mdelem elem, bool true_binary_enabled) {
                         grpc_chttp2_base64_encode_and_huffman_compress(value));
     }
   } else {
-    /* TODO(ctiller): opportunistically compress non-binary headers */
+    grpc_slice compressed;
+    if (huffman_may_pay_off(value) &&
+        grpc_chttp2_huffman_compress_if_shorter(value, &compressed)) {
+      GRPC_STATS_INC_HPACK_SEND_HUFFMAN();
+      return wire_value(0x80, false, compressed);
+    }
     GRPC_STATS_INC_HPACK_SEND_UNCOMPRESSED();
     return wire_value(0x00, false, grpc_slice_ref_internal(value));
   }
@@ -505,9 +582,9 @@ static uint32_t wire_value_length(const wire_value& v) {
 }
 
 namespace {
-enum class EmitLitHdrType { INC_IDX, NO_IDX };
+enum class EmitLitHdrType { INC_IDX, NO_IDX, NEVER_IDX };
 
-enum class EmitLitHdrVType { INC_IDX_V, NO_IDX_V };
+enum class EmitLitHdrVType { INC_IDX_V, NO_IDX_V, NEVER_IDX_V };
 }  // namespace
 
 template <EmitLitHdrType type>
@@ -520,6 +597,9 @@ static void emit_lithdr(grpc_chttp2_hpack_compressor* /*c*/, uint32_t key_index,
     case EmitLitHdrType::NO_IDX:
       GRPC_STATS_INC_HPACK_SEND_LITHDR_NOTIDX();
       break;
+    case EmitLitHdrType::NEVER_IDX:
+      GRPC_STATS_INC_HPACK_SEND_LITHDR_NVRIDX();
+      break;
   }
   const uint32_t len_pfx = type == EmitLitHdrType::INC_IDX
                                ? GRPC_CHTTP2_VARINT_LENGTH(key_index, 2)
@@ -539,6 +619,9 @@ static void emit_lithdr(grpc_chttp2_hpack_compressor* /*c*/, uint32_t key_index,
     case EmitLitHdrType::NO_IDX:
       GRPC_CHTTP2_WRITE_VARINT(key_index, 4, 0x00, data, len_pfx);
       break;
+    case EmitLitHdrType::NEVER_IDX:
+      GRPC_CHTTP2_WRITE_VARINT(key_index, 4, 0x10, data, len_pfx);
+      break;
   }
   GRPC_CHTTP2_WRITE_VARINT(len_val, 1, value.huffman_prefix, &data[len_pfx],
                            len_val_len);
@@ -558,6 +641,9 @@ static void emit_lithdr_v(grpc_chttp2_hpack_compressor* /*c*/, grpc_mdelem elem,
     case EmitLitHdrVType::NO_IDX_V:
       GRPC_STATS_INC_HPACK_SEND_LITHDR_NOTIDX_V();
       break;
+    case EmitLitHdrVType::NEVER_IDX_V:
+      GRPC_STATS_INC_HPACK_SEND_LITHDR_NVRIDX_V();
+      break;
   }
   GRPC_STATS_INC_HPACK_SEND_UNCOMPRESSED();
   const uint32_t len_key =
@@ -572,7 +658,17 @@ static void emit_lithdr_v(grpc_chttp2_hpack_compressor* /*c*/, grpc_mdelem elem,
   GPR_DEBUG_ASSERT(len_key <= UINT32_MAX);
   GPR_DEBUG_ASSERT(1 + len_key_len < GRPC_SLICE_INLINED_SIZE);
   uint8_t* key_buf = add_tiny_header_data(st, 1 + len_key_len);
-  key_buf[0] = type == EmitLitHdrVType::INC_IDX_V ? 0x40 : 0x00;
+  switch (type) {
+    case EmitLitHdrVType::INC_IDX_V:
+      key_buf[0] = 0x40;
+      break;
+    case EmitLitHdrVType::NO_IDX_V:
+      key_buf[0] = 0x00;
+      break;
+    case EmitLitHdrVType::NEVER_IDX_V:
+      key_buf[0] = 0x10;
+      break;
+  }
   GRPC_CHTTP2_WRITE_VARINT(len_key, 1, 0x00, &key_buf[1], len_key_len);
   add_header_data(st, grpc_slice_ref_internal(GRPC_MDKEY(elem)));
   uint8_t* value_buf = add_tiny_header_data(
@@ -636,18 +732,96 @@ static EmitIndexedStatus maybe_emit_indexed(grpc_chttp2_hpack_compressor* c,
           : reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(elem))
                 ->hash();
   /* Update filter to see if we can perhaps add this elem. */
-  const uint32_t popularity_hash = UpdateHashtablePopularity(c, elem_hash);
+  const uint8_t popularity = UpdateHashtablePopularity(c, elem_hash);
   /* is this elem currently in the decoders table? */
   HpackEncoderIndex indices_key;
   if (GetMatchingIndex<MetadataComparator>(c->elem_table.entries, elem,
                                            elem_hash, &indices_key) &&
       indices_key > c->tail_remote_index) {
+    GRPC_STATS_INC_HPACK_SEND_DYNIDX_HIT();
     emit_indexed(c, dynidx(c, indices_key), st);
     return EmitIndexedStatus(elem_hash, true, false);
   }
   /* Didn't hit either cuckoo index, so no emit. */
-  return EmitIndexedStatus(elem_hash, false,
-                           CanAddToHashtable(c, popularity_hash));
+  GRPC_STATS_INC_HPACK_SEND_DYNIDX_MISS();
+  return EmitIndexedStatus(elem_hash, false, CanAddToHashtable(c, popularity));
+}
+
+/* Elems that are not interned (custom metadata, mostly) can't be matched
+   against the table by identity: match them by content instead, and intern
+   those that keep being sent once they're popular enough to be added to the
+   table. Returns false if the elem still has to be emitted. */
+static bool maybe_emit_popular(grpc_chttp2_hpack_compressor* c,
+                               grpc_mdelem elem, framer_state* st) {
+  const size_t decoder_space_usage =
+      grpc_chttp2_get_size_in_hpack_table(elem, st->use_true_binary_metadata);
+  if (decoder_space_usage >= kMaxDecoderSpaceUsage) {
+    return false;
+  }
+  /* the same hashes as the interned elem's */
+  const uint32_t key_hash = grpc_slice_hash_internal(GRPC_MDKEY(elem));
+  const uint32_t elem_hash = GRPC_MDSTR_KV_HASH(
+      key_hash, grpc_slice_hash_internal(GRPC_MDVALUE(elem)));
+  const uint8_t popularity = UpdateHashtablePopularity(c, elem_hash);
+  HpackEncoderIndex indices_key;
+  if (GetMatchingIndex<MetadataContentComparator>(
+          c->elem_table.entries, elem, elem_hash, &indices_key) &&
+      indices_key > c->tail_remote_index) {
+    GRPC_STATS_INC_HPACK_SEND_DYNIDX_HIT();
+    emit_indexed(c, dynidx(c, indices_key), st);
+    return true;
+  }
+  GRPC_STATS_INC_HPACK_SEND_DYNIDX_MISS();
+  if (popularity < kMinPopularityToIntern ||
+      !CanAddToHashtable(c, popularity)) {
+    return false;
+  }
+  grpc_mdelem interned =
+      grpc_mdelem_from_slices(grpc_slice_intern(GRPC_MDKEY(elem)),
+                              grpc_slice_intern(GRPC_MDVALUE(elem)));
+  if (GetMatchingIndex<SliceRefComparator>(c->key_table.entries,
+                                           GRPC_MDKEY(interned).refcount,
+                                           key_hash, &indices_key) &&
+      indices_key > c->tail_remote_index) {
+    emit_lithdr<EmitLitHdrType::INC_IDX>(c, dynidx(c, indices_key), interned,
+                                         st);
+  } else {
+    emit_lithdr_v<EmitLitHdrVType::INC_IDX_V>(c, interned, st);
+  }
+  add_elem(c, interned, decoder_space_usage, elem_hash, key_hash);
+  GRPC_MDELEM_UNREF(interned);
+  return true;
+}
+
+/* Short values of headers carrying credentials are easy to recover by probing
+   a compression context shared with an attacker (RFC 7541, section 7.1.3), so
+   they are sent as literals that intermediaries must not index either. */
+static bool is_never_indexed(grpc_mdelem elem) {
+  if (GRPC_SLICE_LENGTH(GRPC_MDVALUE(elem)) >= kMaxNeverIndexedValueLength) {
+    return false;
+  }
+  const grpc_slice& key = GRPC_MDKEY(elem);
+  return grpc_slice_eq(key, GRPC_MDSTR_AUTHORIZATION) ||
+         grpc_slice_eq(key, GRPC_MDSTR_PROXY_AUTHORIZATION) ||
+         grpc_slice_eq(key, GRPC_MDSTR_COOKIE);
+}
+
+static void emit_never_indexed(grpc_chttp2_hpack_compressor* c,
+                               grpc_mdelem elem, bool key_interned,
+                               framer_state* st) {
+  const grpc_slice& elem_key = GRPC_MDKEY(elem);
+  HpackEncoderIndex indices_key;
+  if (key_interned &&
+      GetMatchingIndex<SliceRefComparator>(c->key_table.entries,
+                                           elem_key.refcount,
+                                           elem_key.refcount->Hash(elem_key),
+                                           &indices_key) &&
+      indices_key > c->tail_remote_index) {
+    emit_lithdr<EmitLitHdrType::NEVER_IDX>(c, dynidx(c, indices_key), elem,
+                                           st);
+  } else {
+    emit_lithdr_v<EmitLitHdrVType::NEVER_IDX_V>(c, elem, st);
+  }
 }
 
 static void emit_maybe_add(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
@@ -686,6 +860,14 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
   }
   const bool elem_interned = GRPC_MDELEM_IS_INTERNED(elem);
   const bool key_interned = elem_interned || grpc_slice_is_interned(elem_key);
+  if (GPR_UNLIKELY(is_never_indexed(elem))) {
+    emit_never_indexed(c, elem, key_interned, st);
+    return;
+  }
+  /* Not interned => maybe popular enough to be indexed by content. */
+  if (!elem_interned && maybe_emit_popular(c, elem, st)) {
+    return;
+  }
   /* Key is not interned, emit literals. */
   if (!key_interned) {
     emit_lithdr_v<EmitLitHdrVType::NO_IDX_V>(c, elem, st);
@@ -732,12 +914,43 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
 #define STRLEN_LIT(x) (sizeof(x) - 1)
 #define TIMEOUT_KEY "grpc-timeout"
 
+/* encode an mdelem, using the static table if it is there */
+static void elem_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem md,
+                     framer_state* st) {
+  const bool is_static = GRPC_MDELEM_STORAGE(md) == GRPC_MDELEM_STORAGE_STATIC;
+  uintptr_t static_index;
+  if (is_static &&
+      (static_index =
+           reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(md))
+               ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
+    emit_indexed(c, static_cast<uint32_t>(static_index + 1), st);
+  } else {
+    hpack_enc(c, md, st);
+  }
+}
+
 static void deadline_enc(grpc_chttp2_hpack_compressor* c, grpc_millis deadline,
                          framer_state* st) {
   char timeout_str[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
   grpc_mdelem mdelem;
-  grpc_http2_encode_timeout(deadline - grpc_core::ExecCtx::Get()->Now(),
-                            timeout_str);
+  grpc_millis timeout = deadline - grpc_core::ExecCtx::Get()->Now();
+  if (c->timeout_digits != 0) {
+    timeout = grpc_http2_round_timeout_down(timeout, c->timeout_digits);
+    auto* entry =
+        &c->timeouts[(static_cast<uint64_t>(timeout) * 0x9e3779b97f4a7c15) >>
+                     (64 - GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS_BITS)];
+    if (GRPC_MDISNULL(entry->elem) || entry->timeout != timeout) {
+      grpc_http2_encode_timeout(timeout, timeout_str);
+      GRPC_MDELEM_UNREF(entry->elem);
+      entry->timeout = timeout;
+      entry->elem = grpc_mdelem_from_slices(
+          GRPC_MDSTR_GRPC_TIMEOUT,
+          grpc_slice_intern(grpc_slice_from_static_string(timeout_str)));
+    }
+    hpack_enc(c, entry->elem, st);
+    return;
+  }
+  grpc_http2_encode_timeout(timeout, timeout_str);
   mdelem = grpc_mdelem_from_slices(
       GRPC_MDSTR_GRPC_TIMEOUT, grpc_core::UnmanagedMemorySlice(timeout_str));
   hpack_enc(c, mdelem, st);
@@ -765,9 +978,45 @@ void grpc_chttp2_hpack_compressor_destroy(grpc_chttp2_hpack_compressor* c) {
     }
     GRPC_MDELEM_UNREF(GetEntry<grpc_mdelem>(c->elem_table.entries, i));
   }
+  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS; i++) {
+    GRPC_MDELEM_UNREF(c->timeouts[i].elem);
+  }
   gpr_free(c->table_elem_size);
 }
 
+void grpc_chttp2_hpack_compressor_set_timeout_digits(
+    grpc_chttp2_hpack_compressor* c, int digits) {
+  GPR_ASSERT(digits >= 0 && digits <= 3);
+  c->timeout_digits = digits;
+}
+
+size_t grpc_chttp2_hpack_compressor_release_stale(
+    grpc_chttp2_hpack_compressor* c) {
+  size_t released = 0;
+  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_VALUES; i++) {
+    auto& key = c->key_table.entries[i];
+    if (key.value != nullptr && key.index <= c->tail_remote_index) {
+      key.value->Unref();
+      key.value = nullptr;
+    }
+    auto& elem = c->elem_table.entries[i];
+    if (!GRPC_MDISNULL(elem.value) && elem.index <= c->tail_remote_index) {
+      released += GRPC_SLICE_LENGTH(GRPC_MDKEY(elem.value)) +
+                  GRPC_SLICE_LENGTH(GRPC_MDVALUE(elem.value));
+      GRPC_MDELEM_UNREF(elem.value);
+      elem.value = GRPC_MDNULL;
+    }
+  }
+  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS; i++) {
+    if (!GRPC_MDISNULL(c->timeouts[i].elem)) {
+      released += GRPC_SLICE_LENGTH(GRPC_MDVALUE(c->timeouts[i].elem));
+      GRPC_MDELEM_UNREF(c->timeouts[i].elem);
+      c->timeouts[i].elem = GRPC_MDNULL;
+    }
+  }
+  return released;
+}
+
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
     grpc_chttp2_hpack_compressor* c, uint32_t max_table_size) {
   c->max_usable_size = max_table_size;
@@ -819,6 +1068,147 @@ void grpc_chttp2_hpack_compressor_set_max_table_size(
   }
 }
 
+/* Fills \a elems with the static indices of the elems to encode, and returns
+   their number. Returns 0 if the block can't be pre-encoded. */
+static size_t preencoded_key(grpc_mdelem** extra_headers,
+                             size_t extra_headers_size,
+                             grpc_metadata_batch* metadata, uint8_t* elems) {
+  if (metadata->deadline != GRPC_MILLIS_INF_FUTURE ||
+      extra_headers_size + metadata->list.count >
+          GRPC_CHTTP2_HPACKC_PREENCODED_MAX_ELEMS ||
+      GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+    return 0;
+  }
+  size_t n = 0;
+  for (size_t i = 0; i < extra_headers_size; ++i) {
+    grpc_mdelem md = *extra_headers[i];
+    if (GRPC_MDELEM_STORAGE(md) != GRPC_MDELEM_STORAGE_STATIC) return 0;
+    elems[n++] = static_cast<uint8_t>(
+        reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(md))
+            ->StaticIndex());
+  }
+  for (grpc_linked_mdelem* l = metadata->list.head; l; l = l->next) {
+    if (GRPC_MDELEM_STORAGE(l->md) != GRPC_MDELEM_STORAGE_STATIC) return 0;
+    elems[n++] = static_cast<uint8_t>(
+        reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(l->md))
+            ->StaticIndex());
+  }
+  return n;
+}
+
+static bool emit_preencoded(grpc_chttp2_hpack_compressor* c,
+                            const uint8_t* elems, size_t num_elems,
+                            framer_state* st) {
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_PREENCODED; i++) {
+    const auto& block = c->preencoded[i];
+    if (block.num_elems == num_elems &&
+        block.tail_remote_index == c->tail_remote_index &&
+        block.table_elems == c->table_elems &&
+        memcmp(block.elems, elems, num_elems) == 0) {
+      GRPC_STATS_INC_HPACK_SEND_PREENCODED();
+      memcpy(add_tiny_header_data(st, block.length), block.bytes,
+             block.length);
+      return true;
+    }
+  }
+  return false;
+}
+
+static void save_preencoded(grpc_chttp2_hpack_compressor* c,
+                            const uint8_t* elems, size_t num_elems,
+                            const framer_state* st) {
+  /* Only indexed fields leave the decoder table as it was. */
+  if (st->num_indices != num_elems) return;
+  uint8_t bytes[GRPC_CHTTP2_HPACKC_PREENCODED_MAX_SIZE];
+  size_t length = 0;
+  for (size_t i = 0; i < num_elems; i++) {
+    const uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(st->indices[i], 1);
+    if (length + len > GRPC_CHTTP2_HPACKC_PREENCODED_MAX_SIZE) return;
+    GRPC_CHTTP2_WRITE_VARINT(st->indices[i], 1, 0x80, bytes + length, len);
+    length += len;
+  }
+  /* Replace a stale copy of the same block, or the oldest one. */
+  size_t slot = c->next_preencoded;
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_PREENCODED; i++) {
+    if (c->preencoded[i].num_elems == num_elems &&
+        memcmp(c->preencoded[i].elems, elems, num_elems) == 0) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == c->next_preencoded) {
+    c->next_preencoded =
+        (c->next_preencoded + 1) % GRPC_CHTTP2_HPACKC_NUM_PREENCODED;
+  }
+  auto& block = c->preencoded[slot];
+  memcpy(block.elems, elems, num_elems);
+  block.num_elems = static_cast<uint8_t>(num_elems);
+  memcpy(block.bytes, bytes, length);
+  block.length = static_cast<uint8_t>(length);
+  block.tail_remote_index = c->tail_remote_index;
+  block.table_elems = c->table_elems;
+}
+
+/* Returns true if the elems of \a group, and only those, follow on from
+   \a l, as linked by grpc_metadata_batch_link_tail_group(). */
+static bool group_in_place(const grpc_mdelem_group* group,
+                           grpc_linked_mdelem* l) {
+  for (size_t i = 0; i < group->count; i++, l = l->next) {
+    if (l == nullptr || l->md.payload != group->elems[i].payload) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void group_enc(grpc_chttp2_hpack_compressor* c,
+                      const grpc_mdelem_group* group, framer_state* st) {
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_GROUPS; i++) {
+    const auto& enc = c->groups[i];
+    if (enc.group_id == group->id &&
+        enc.tail_remote_index == c->tail_remote_index &&
+        enc.table_elems == c->table_elems) {
+      GRPC_STATS_INC_HPACK_SEND_PREENCODED();
+#ifndef NDEBUG
+      st->seen_regular_header = 1;
+#endif
+      memcpy(add_tiny_header_data(st, enc.length), enc.bytes, enc.length);
+      return;
+    }
+  }
+  st->num_indices = 0;
+  for (size_t i = 0; i < group->count; i++) {
+    elem_enc(c, group->elems[i], st);
+  }
+  /* Only indexed fields leave the decoder table as it was. */
+  if (st->num_indices != group->count) return;
+  uint8_t bytes[GRPC_CHTTP2_HPACKC_GROUP_MAX_SIZE];
+  size_t length = 0;
+  for (size_t i = 0; i < group->count; i++) {
+    const uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(st->indices[i], 1);
+    if (length + len > GRPC_CHTTP2_HPACKC_GROUP_MAX_SIZE) return;
+    GRPC_CHTTP2_WRITE_VARINT(st->indices[i], 1, 0x80, bytes + length, len);
+    length += len;
+  }
+  /* Replace a stale encoding of the same group, or the oldest one. */
+  size_t slot = c->next_group;
+  for (size_t i = 0; i < GRPC_CHTTP2_HPACKC_NUM_GROUPS; i++) {
+    if (c->groups[i].group_id == group->id) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == c->next_group) {
+    c->next_group = (c->next_group + 1) % GRPC_CHTTP2_HPACKC_NUM_GROUPS;
+  }
+  auto& enc = c->groups[slot];
+  enc.group_id = group->id;
+  memcpy(enc.bytes, bytes, length);
+  enc.length = static_cast<uint8_t>(length);
+  enc.tail_remote_index = c->tail_remote_index;
+  enc.table_elems = c->table_elems;
+}
+
 void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
                                grpc_mdelem** extra_headers,
                                size_t extra_headers_size,
@@ -841,6 +1231,7 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
   st.stats = options->stats;
   st.max_frame_size = options->max_frame_size;
   st.use_true_binary_metadata = options->use_true_binary_metadata;
+  st.num_indices = 0;
 
   /* Encode a metadata batch; store the returned values, representing
      a metadata element that needs to be unreffed back into the metadata
@@ -850,38 +1241,34 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
   if (c->advertise_table_size_change != 0) {
     emit_advertise_table_size_change(c, &st);
   }
+  uint8_t elems[GRPC_CHTTP2_HPACKC_PREENCODED_MAX_ELEMS];
+  const size_t num_elems =
+      preencoded_key(extra_headers, extra_headers_size, metadata, elems);
+  if (num_elems > 0 && emit_preencoded(c, elems, num_elems, &st)) {
+    finish_frame(&st, 1, options->is_eof);
+    return;
+  }
   for (size_t i = 0; i < extra_headers_size; ++i) {
-    grpc_mdelem md = *extra_headers[i];
-    const bool is_static =
-        GRPC_MDELEM_STORAGE(md) == GRPC_MDELEM_STORAGE_STATIC;
-    uintptr_t static_index;
-    if (is_static &&
-        (static_index =
-             reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(md))
-                 ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
-      emit_indexed(c, static_cast<uint32_t>(static_index + 1), &st);
-    } else {
-      hpack_enc(c, md, &st);
-    }
+    elem_enc(c, *extra_headers[i], &st);
   }
   grpc_metadata_batch_assert_ok(metadata);
+  /* The indices recorded for a group would clobber those of the block. */
+  const bool use_groups =
+      num_elems == 0 && !GRPC_TRACE_FLAG_ENABLED(grpc_http_trace);
   for (grpc_linked_mdelem* l = metadata->list.head; l; l = l->next) {
-    const bool is_static =
-        GRPC_MDELEM_STORAGE(l->md) == GRPC_MDELEM_STORAGE_STATIC;
-    uintptr_t static_index;
-    if (is_static &&
-        (static_index = reinterpret_cast<grpc_core::StaticMetadata*>(
-                            GRPC_MDELEM_DATA(l->md))
-                            ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
-      emit_indexed(c, static_cast<uint32_t>(static_index + 1), &st);
-    } else {
-      hpack_enc(c, l->md, &st);
+    if (l == metadata->group_head && use_groups &&
+        group_in_place(metadata->group, l)) {
+      group_enc(c, metadata->group, &st);
+      for (size_t i = 1; i < metadata->group->count; i++) l = l->next;
+      continue;
     }
+    elem_enc(c, l->md, &st);
   }
   grpc_millis deadline = metadata->deadline;
   if (deadline != GRPC_MILLIS_INF_FUTURE) {
     deadline_enc(c, deadline, &st);
   }
+  if (num_elems > 0) save_preencoded(c, elems, num_elems, &st);
 
   finish_frame(&st, 1, options->is_eof);
 }
@@ -31,6 +31,26 @@
 // This should be <= 8. We use 6 to save space.
 #define GRPC_CHTTP2_HPACKC_NUM_VALUES_BITS 6
 #define GRPC_CHTTP2_HPACKC_NUM_VALUES (1 << GRPC_CHTTP2_HPACKC_NUM_VALUES_BITS)
+/* dimensions of the popularity sketch: rows of counters, each indexed by a
+   different hash of the elem */
+#define GRPC_CHTTP2_HPACKC_SKETCH_ROWS 2
+#define GRPC_CHTTP2_HPACKC_SKETCH_WIDTH_BITS 8
+#define GRPC_CHTTP2_HPACKC_SKETCH_WIDTH \
+  (1 << GRPC_CHTTP2_HPACKC_SKETCH_WIDTH_BITS)
+/* number of pre-encoded header blocks kept by a compressor */
+#define GRPC_CHTTP2_HPACKC_NUM_PREENCODED 4
+/* maximum number of elems in a pre-encoded header block */
+#define GRPC_CHTTP2_HPACKC_PREENCODED_MAX_ELEMS 4
+/* maximum size of a pre-encoded header block */
+#define GRPC_CHTTP2_HPACKC_PREENCODED_MAX_SIZE 16
+/* number of mdelem group encodings kept by a compressor */
+#define GRPC_CHTTP2_HPACKC_NUM_GROUPS 4
+/* maximum size of the encoding of an mdelem group */
+#define GRPC_CHTTP2_HPACKC_GROUP_MAX_SIZE 16
+/* number of interned grpc-timeout elems kept by a compressor, a power of 2 */
+#define GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS_BITS 3
+#define GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS \
+  (1 << GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS_BITS)
 /* initial table size, per spec */
 #define GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE 4096
 /* maximum table size we'll actually use */
@@ -54,13 +74,15 @@ struct grpc_chttp2_hpack_compressor {
       of this size */
   uint8_t advertise_table_size_change;
 
-  /* filter tables for elems: this tables provides an approximate
-     popularity count for particular hashes, and are used to determine whether
-     a new literal should be added to the compression table or not.
-     They track a single integer that counts how often a particular value has
-     been seen. When that count reaches max (255), all values are halved. */
+  /* filter tables for elems: a count-min sketch that provides an approximate
+     popularity count for particular (key, value) pairs, and is used to
+     determine whether a new literal should be added to the compression table
+     or not. Each elem bumps one counter per row, and its count is the smallest
+     of them. When a counter reaches max (255), all counters are halved, so
+     that headers which stop being sent are forgotten. */
   uint32_t filter_elems_sum;
-  uint8_t filter_elems[GRPC_CHTTP2_HPACKC_NUM_VALUES];
+  uint8_t filter_elems[GRPC_CHTTP2_HPACKC_SKETCH_ROWS]
+                      [GRPC_CHTTP2_HPACKC_SKETCH_WIDTH];
 
   /* entry tables for keys & elems: these tables track values that have been
      seen and *may* be in the decompressor table */
@@ -81,6 +103,47 @@ struct grpc_chttp2_hpack_compressor {
       uint32_t index;
     } entries[GRPC_CHTTP2_HPACKC_NUM_VALUES];
   } key_table; /* Key table management */
+
+  /* header blocks made only of static elems, which were all sent as indexed
+     fields the last time: as long as no elem is added to or evicted from the
+     decoder table, the same bytes encode the same block. The table state is
+     identified by tail_remote_index and table_elems. Common blocks, like
+     trailers with only grpc-status: 0, are then copied out in one go. */
+  struct {
+    /* static indices of the elems of the block, zero elems if unused */
+    uint8_t elems[GRPC_CHTTP2_HPACKC_PREENCODED_MAX_ELEMS];
+    uint8_t num_elems;
+    uint8_t length;
+    uint8_t bytes[GRPC_CHTTP2_HPACKC_PREENCODED_MAX_SIZE];
+    uint32_t tail_remote_index;
+    uint32_t table_elems;
+  } preencoded[GRPC_CHTTP2_HPACKC_NUM_PREENCODED];
+  uint32_t next_preencoded;
+
+  /* encodings of mdelem groups (see grpc_metadata_batch_link_tail_group()),
+     kept on the same terms as the pre-encoded blocks above: the elems of a
+     group were all sent as indexed fields, so the bytes hold as long as the
+     decoder table does not change. This covers the request headers that a
+     channel sends on every call, interned ones included. */
+  struct {
+    /* id of the group, zero if unused */
+    uint64_t group_id;
+    uint8_t length;
+    uint8_t bytes[GRPC_CHTTP2_HPACKC_GROUP_MAX_SIZE];
+    uint32_t tail_remote_index;
+    uint32_t table_elems;
+  } groups[GRPC_CHTTP2_HPACKC_NUM_GROUPS];
+  uint32_t next_group;
+
+  /* if non-zero, timeouts are rounded down to this many significant figures
+     (see grpc_http2_round_timeout_down()). Timeouts then repeat, so their
+     grpc-timeout elems are interned, which lets them be indexed, and the
+     recent ones are kept here by rounded timeout. */
+  int timeout_digits;
+  struct {
+    grpc_millis timeout;
+    grpc_mdelem elem;
+  } timeouts[GRPC_CHTTP2_HPACKC_NUM_TIMEOUTS];
 };
 
 void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor* c);
@@ -89,6 +152,15 @@ void grpc_chttp2_hpack_compressor_set_max_table_size(
     grpc_chttp2_hpack_compressor* c, uint32_t max_table_size);
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
     grpc_chttp2_hpack_compressor* c, uint32_t max_table_size);
+/* \a digits is 0 (timeouts are sent as precisely as the format allows) or 1
+   to 3 */
+void grpc_chttp2_hpack_compressor_set_timeout_digits(
+    grpc_chttp2_hpack_compressor* c, int digits);
+/* drops the refs the compressor holds on keys and elems that were evicted
+   from the decoder table, and on its cached grpc-timeout elems. Returns
+   roughly how many bytes of metadata were let go of. */
+size_t grpc_chttp2_hpack_compressor_release_stale(
+    grpc_chttp2_hpack_compressor* c);
 
 typedef struct {
   uint32_t stream_id;
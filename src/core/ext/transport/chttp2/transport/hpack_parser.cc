@@ -231,379 +231,420 @@ static const uint8_t first_byte_lut[256] = {
     INDEXED_FIELD,   INDEXED_FIELD, INDEXED_FIELD, INDEXED_FIELD_X,
 };
 
-/* state table for huffman decoding: given a state, gives an index/16 into
-   next_sub_tbl. Taking that index and adding the value of the nibble being
-   considered returns the next state.
-
-   generated by gen_hpack_tables.c */
-static const uint8_t next_tbl[256] = {
-    0,  1,  2,  3,  4,  1,  2, 5,  6,  1, 7,  8,  1,  3,  3,  9,  10, 11, 1,  1,
-    1,  12, 1,  2,  13, 1,  1, 1,  1,  1, 1,  1,  1,  1,  1,  1,  1,  1,  1,  2,
-    14, 1,  15, 16, 1,  17, 1, 15, 2,  7, 3,  18, 19, 1,  1,  1,  1,  20, 1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  15, 2, 2,  7,  21, 1,  22, 1,  1,  1,  1,  1,
-    1,  1,  1,  15, 2,  2,  2, 2,  2,  2, 23, 24, 25, 1,  1,  1,  1,  2,  2,  2,
-    26, 3,  3,  27, 10, 28, 1, 1,  1,  1, 1,  1,  2,  3,  29, 10, 30, 1,  1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  1,  1, 1,  31, 1,  1,  1,  1,  1,  1,  1,  2,
-    2,  2,  2,  2,  2,  2,  2, 32, 1,  1, 15, 33, 1,  34, 35, 9,  36, 1,  1,  1,
-    1,  1,  1,  1,  37, 1,  1, 1,  1,  1, 1,  2,  2,  2,  2,  2,  2,  2,  26, 9,
-    38, 1,  1,  1,  1,  1,  1, 1,  15, 2, 2,  2,  2,  26, 3,  3,  39, 1,  1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  2,  2, 2,  2,  2,  2,  7,  3,  3,  3,  40, 2,
-    41, 1,  1,  1,  42, 43, 1, 1,  44, 1, 1,  1,  1,  15, 2,  2,  2,  2,  2,  2,
-    3,  3,  3,  45, 46, 1,  1, 2,  2,  2, 35, 3,  3,  18, 47, 2,
+/* tables for huffman decoding: codes longer than HUFF_LOOKUP_BITS are rare
+   and decoded canonically. The codes of length n are the values in
+   [huff_first_code[n], huff_first_code[n] + huff_num_codes[n]), and belong to
+   the symbols of huff_sorted_syms starting at huff_first_sym[n].
+
+   generated by gen_hpack_tables.cc */
+#define HUFF_LOOKUP_BITS 11
+#define HUFF_MAX_CODE_LENGTH 30
+#define HUFF_EOS 256
+
+static const uint32_t huff_first_code[31] = {
+    0,         0,       0,          0,        0,        0,        20,
+    92,        248,     0,          1016,     2042,     4090,     8184,
+    16380,     32764,   0,          0,        0,        524272,   1048550,
+    2097116,   4194258, 8388568,    16777194, 33554412, 67108832, 134217694,
+    268435426, 0,       1073741820,
 };
 
-/* next state, based upon current state and the current nibble: see above.
-   generated by gen_hpack_tables.c */
-static const int16_t next_sub_tbl[48 * 16] = {
-    1,   204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217,
-    218, 2,   6,   10,  13,  14,  15,  16,  17,  2,   6,   10,  13,  14,  15,
-    16,  17,  3,   7,   11,  24,  3,   7,   11,  24,  3,   7,   11,  24,  3,
-    7,   11,  24,  4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   5,
-    199, 200, 201, 202, 203, 4,   8,   4,   8,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   9,   133, 134, 135, 136, 137, 138, 139, 140,
-    141, 142, 143, 144, 145, 146, 147, 3,   7,   11,  24,  3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   12,  132, 4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   18,  19,  20,  21,  4,   8,   4,
-    8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   22,  23,  91,  25,  26,
-    27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  3,
-    7,   11,  24,  3,   7,   11,  24,  0,   0,   0,   0,   0,   41,  42,  43,
-    2,   6,   10,  13,  14,  15,  16,  17,  3,   7,   11,  24,  3,   7,   11,
-    24,  4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,
-    44,  45,  2,   6,   10,  13,  14,  15,  16,  17,  46,  47,  48,  49,  50,
-    51,  52,  57,  4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   53,  54,  55,  56,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,
-    68,  69,  70,  71,  72,  74,  0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   73,  75,  76,  77,  78,  79,  80,  81,  82,
-    83,  84,  85,  86,  87,  88,  89,  90,  3,   7,   11,  24,  3,   7,   11,
-    24,  3,   7,   11,  24,  0,   0,   0,   0,   3,   7,   11,  24,  3,   7,
-    11,  24,  4,   8,   4,   8,   0,   0,   0,   92,  0,   0,   0,   93,  94,
-    95,  96,  97,  98,  99,  100, 101, 102, 103, 104, 105, 3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,
-    8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 4,
-    8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,
-    0,   117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130,
-    131, 2,   6,   10,  13,  14,  15,  16,  17,  4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   148,
-    149, 150, 151, 3,   7,   11,  24,  4,   8,   4,   8,   0,   0,   0,   0,
-    0,   0,   152, 153, 3,   7,   11,  24,  3,   7,   11,  24,  3,   7,   11,
-    24,  154, 155, 156, 164, 3,   7,   11,  24,  3,   7,   11,  24,  3,   7,
-    11,  24,  4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    157, 158, 159, 160, 161, 162, 163, 165, 166, 167, 168, 169, 170, 171, 172,
-    173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187,
-    188, 189, 190, 191, 192, 193, 194, 195, 196, 4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   4,   8,   197, 198, 4,   8,   4,   8,   4,
-    8,   4,   8,   0,   0,   0,   0,   0,   0,   219, 220, 3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   0,   0,   221, 222, 223, 224, 3,   7,   11,
-    24,  3,   7,   11,  24,  4,   8,   4,   8,   4,   8,   225, 228, 4,   8,
-    4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   226, 227, 229,
-    230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   245, 246, 247, 248, 249, 250, 251, 252,
-    253, 254, 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   255,
+static const uint16_t huff_num_codes[31] = {
+    0,  0,  0,  0, 0,  10, 26, 32, 6, 0, 5, 3, 2, 6, 2, 3, 0, 0, 0, 3, 8, 13,
+    26, 29, 12, 4, 15, 19, 29, 0,  4,
 };
 
-/* emission table: indexed like next_tbl, ultimately gives the byte to be
-   emitted, or -1 for no byte, or 256 for end of stream
-
-   generated by gen_hpack_tables.c */
-static const uint16_t emit_tbl[256] = {
-    0,   1,   2,   3,   4,   5,   6,   7,   0,   8,   9,   10,  11,  12,  13,
-    14,  15,  16,  17,  18,  19,  20,  21,  22,  0,   23,  24,  25,  26,  27,
-    28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,
-    43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  0,   55,  56,
-    57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  0,
-    71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,
-    86,  87,  88,  89,  90,  91,  92,  93,  94,  95,  96,  97,  98,  99,  100,
-    101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115,
-    116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130,
-    131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145,
-    146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 0,
-    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174,
-    0,   175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188,
-    189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203,
-    204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218,
-    219, 220, 221, 0,   222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232,
-    233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247,
-    248,
+static const uint16_t huff_first_sym[31] = {
+    0,  0,  0,  0,  0,  0,   10,  36,  68,  74,  74,  79,  82,  84,  90,  92,
+    95, 95, 95, 95, 98, 106, 119, 145, 174, 186, 190, 205, 224, 253, 253,
 };
 
-/* generated by gen_hpack_tables.c */
-static const int16_t emit_sub_tbl[249 * 16] = {
-    -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
-    -1,  48,  48,  48,  48,  48,  48,  48,  48,  49,  49,  49,  49,  49,  49,
-    49,  49,  48,  48,  48,  48,  49,  49,  49,  49,  50,  50,  50,  50,  97,
-    97,  97,  97,  48,  48,  49,  49,  50,  50,  97,  97,  99,  99,  101, 101,
-    105, 105, 111, 111, 48,  49,  50,  97,  99,  101, 105, 111, 115, 116, -1,
-    -1,  -1,  -1,  -1,  -1,  32,  32,  32,  32,  32,  32,  32,  32,  37,  37,
-    37,  37,  37,  37,  37,  37,  99,  99,  99,  99,  101, 101, 101, 101, 105,
-    105, 105, 105, 111, 111, 111, 111, 115, 115, 116, 116, 32,  37,  45,  46,
-    47,  51,  52,  53,  54,  55,  56,  57,  61,  61,  61,  61,  61,  61,  61,
-    61,  65,  65,  65,  65,  65,  65,  65,  65,  115, 115, 115, 115, 116, 116,
-    116, 116, 32,  32,  37,  37,  45,  45,  46,  46,  61,  65,  95,  98,  100,
-    102, 103, 104, 108, 109, 110, 112, 114, 117, -1,  -1,  58,  58,  58,  58,
-    58,  58,  58,  58,  66,  66,  66,  66,  66,  66,  66,  66,  47,  47,  51,
-    51,  52,  52,  53,  53,  54,  54,  55,  55,  56,  56,  57,  57,  61,  61,
-    65,  65,  95,  95,  98,  98,  100, 100, 102, 102, 103, 103, 104, 104, 108,
-    108, 109, 109, 110, 110, 112, 112, 114, 114, 117, 117, 58,  66,  67,  68,
-    69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,
-    84,  85,  86,  87,  89,  106, 107, 113, 118, 119, 120, 121, 122, -1,  -1,
-    -1,  -1,  38,  38,  38,  38,  38,  38,  38,  38,  42,  42,  42,  42,  42,
-    42,  42,  42,  44,  44,  44,  44,  44,  44,  44,  44,  59,  59,  59,  59,
-    59,  59,  59,  59,  88,  88,  88,  88,  88,  88,  88,  88,  90,  90,  90,
-    90,  90,  90,  90,  90,  33,  33,  34,  34,  40,  40,  41,  41,  63,  63,
-    39,  43,  124, -1,  -1,  -1,  35,  35,  35,  35,  35,  35,  35,  35,  62,
-    62,  62,  62,  62,  62,  62,  62,  0,   0,   0,   0,   36,  36,  36,  36,
-    64,  64,  64,  64,  91,  91,  91,  91,  69,  69,  69,  69,  69,  69,  69,
-    69,  70,  70,  70,  70,  70,  70,  70,  70,  71,  71,  71,  71,  71,  71,
-    71,  71,  72,  72,  72,  72,  72,  72,  72,  72,  73,  73,  73,  73,  73,
-    73,  73,  73,  74,  74,  74,  74,  74,  74,  74,  74,  75,  75,  75,  75,
-    75,  75,  75,  75,  76,  76,  76,  76,  76,  76,  76,  76,  77,  77,  77,
-    77,  77,  77,  77,  77,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79,
-    79,  79,  79,  79,  79,  79,  80,  80,  80,  80,  80,  80,  80,  80,  81,
-    81,  81,  81,  81,  81,  81,  81,  82,  82,  82,  82,  82,  82,  82,  82,
-    83,  83,  83,  83,  83,  83,  83,  83,  84,  84,  84,  84,  84,  84,  84,
-    84,  85,  85,  85,  85,  85,  85,  85,  85,  86,  86,  86,  86,  86,  86,
-    86,  86,  87,  87,  87,  87,  87,  87,  87,  87,  89,  89,  89,  89,  89,
-    89,  89,  89,  106, 106, 106, 106, 106, 106, 106, 106, 107, 107, 107, 107,
-    107, 107, 107, 107, 113, 113, 113, 113, 113, 113, 113, 113, 118, 118, 118,
-    118, 118, 118, 118, 118, 119, 119, 119, 119, 119, 119, 119, 119, 120, 120,
-    120, 120, 120, 120, 120, 120, 121, 121, 121, 121, 121, 121, 121, 121, 122,
-    122, 122, 122, 122, 122, 122, 122, 38,  38,  38,  38,  42,  42,  42,  42,
-    44,  44,  44,  44,  59,  59,  59,  59,  88,  88,  88,  88,  90,  90,  90,
-    90,  33,  34,  40,  41,  63,  -1,  -1,  -1,  39,  39,  39,  39,  39,  39,
-    39,  39,  43,  43,  43,  43,  43,  43,  43,  43,  124, 124, 124, 124, 124,
-    124, 124, 124, 35,  35,  35,  35,  62,  62,  62,  62,  0,   0,   36,  36,
-    64,  64,  91,  91,  93,  93,  126, 126, 94,  125, -1,  -1,  60,  60,  60,
-    60,  60,  60,  60,  60,  96,  96,  96,  96,  96,  96,  96,  96,  123, 123,
-    123, 123, 123, 123, 123, 123, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  92,
-    92,  92,  92,  92,  92,  92,  92,  195, 195, 195, 195, 195, 195, 195, 195,
-    208, 208, 208, 208, 208, 208, 208, 208, 128, 128, 128, 128, 130, 130, 130,
-    130, 131, 131, 131, 131, 162, 162, 162, 162, 184, 184, 184, 184, 194, 194,
-    194, 194, 224, 224, 224, 224, 226, 226, 226, 226, 153, 153, 161, 161, 167,
-    167, 172, 172, 176, 176, 177, 177, 179, 179, 209, 209, 216, 216, 217, 217,
-    227, 227, 229, 229, 230, 230, 129, 132, 133, 134, 136, 146, 154, 156, 160,
-    163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228,
-    232, 233, -1,  -1,  -1,  -1,  1,   1,   1,   1,   1,   1,   1,   1,   135,
-    135, 135, 135, 135, 135, 135, 135, 137, 137, 137, 137, 137, 137, 137, 137,
-    138, 138, 138, 138, 138, 138, 138, 138, 139, 139, 139, 139, 139, 139, 139,
-    139, 140, 140, 140, 140, 140, 140, 140, 140, 141, 141, 141, 141, 141, 141,
-    141, 141, 143, 143, 143, 143, 143, 143, 143, 143, 147, 147, 147, 147, 147,
-    147, 147, 147, 149, 149, 149, 149, 149, 149, 149, 149, 150, 150, 150, 150,
-    150, 150, 150, 150, 151, 151, 151, 151, 151, 151, 151, 151, 152, 152, 152,
-    152, 152, 152, 152, 152, 155, 155, 155, 155, 155, 155, 155, 155, 157, 157,
-    157, 157, 157, 157, 157, 157, 158, 158, 158, 158, 158, 158, 158, 158, 165,
-    165, 165, 165, 165, 165, 165, 165, 166, 166, 166, 166, 166, 166, 166, 166,
-    168, 168, 168, 168, 168, 168, 168, 168, 174, 174, 174, 174, 174, 174, 174,
-    174, 175, 175, 175, 175, 175, 175, 175, 175, 180, 180, 180, 180, 180, 180,
-    180, 180, 182, 182, 182, 182, 182, 182, 182, 182, 183, 183, 183, 183, 183,
-    183, 183, 183, 188, 188, 188, 188, 188, 188, 188, 188, 191, 191, 191, 191,
-    191, 191, 191, 191, 197, 197, 197, 197, 197, 197, 197, 197, 231, 231, 231,
-    231, 231, 231, 231, 231, 239, 239, 239, 239, 239, 239, 239, 239, 9,   9,
-    9,   9,   142, 142, 142, 142, 144, 144, 144, 144, 145, 145, 145, 145, 148,
-    148, 148, 148, 159, 159, 159, 159, 171, 171, 171, 171, 206, 206, 206, 206,
-    215, 215, 215, 215, 225, 225, 225, 225, 236, 236, 236, 236, 237, 237, 237,
-    237, 199, 199, 207, 207, 234, 234, 235, 235, 192, 193, 200, 201, 202, 205,
-    210, 213, 218, 219, 238, 240, 242, 243, 255, -1,  203, 203, 203, 203, 203,
-    203, 203, 203, 204, 204, 204, 204, 204, 204, 204, 204, 211, 211, 211, 211,
-    211, 211, 211, 211, 212, 212, 212, 212, 212, 212, 212, 212, 214, 214, 214,
-    214, 214, 214, 214, 214, 221, 221, 221, 221, 221, 221, 221, 221, 222, 222,
-    222, 222, 222, 222, 222, 222, 223, 223, 223, 223, 223, 223, 223, 223, 241,
-    241, 241, 241, 241, 241, 241, 241, 244, 244, 244, 244, 244, 244, 244, 244,
-    245, 245, 245, 245, 245, 245, 245, 245, 246, 246, 246, 246, 246, 246, 246,
-    246, 247, 247, 247, 247, 247, 247, 247, 247, 248, 248, 248, 248, 248, 248,
-    248, 248, 250, 250, 250, 250, 250, 250, 250, 250, 251, 251, 251, 251, 251,
-    251, 251, 251, 252, 252, 252, 252, 252, 252, 252, 252, 253, 253, 253, 253,
-    253, 253, 253, 253, 254, 254, 254, 254, 254, 254, 254, 254, 2,   2,   2,
-    2,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,
-    6,   6,   7,   7,   7,   7,   8,   8,   8,   8,   11,  11,  11,  11,  12,
-    12,  12,  12,  14,  14,  14,  14,  15,  15,  15,  15,  16,  16,  16,  16,
-    17,  17,  17,  17,  18,  18,  18,  18,  19,  19,  19,  19,  20,  20,  20,
-    20,  21,  21,  21,  21,  23,  23,  23,  23,  24,  24,  24,  24,  25,  25,
-    25,  25,  26,  26,  26,  26,  27,  27,  27,  27,  28,  28,  28,  28,  29,
-    29,  29,  29,  30,  30,  30,  30,  31,  31,  31,  31,  127, 127, 127, 127,
-    220, 220, 220, 220, 249, 249, 249, 249, 10,  13,  22,  256, 93,  93,  93,
-    93,  126, 126, 126, 126, 94,  94,  125, 125, 60,  96,  123, -1,  92,  195,
-    208, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  128,
-    128, 128, 128, 128, 128, 128, 128, 130, 130, 130, 130, 130, 130, 130, 130,
-    131, 131, 131, 131, 131, 131, 131, 131, 162, 162, 162, 162, 162, 162, 162,
-    162, 184, 184, 184, 184, 184, 184, 184, 184, 194, 194, 194, 194, 194, 194,
-    194, 194, 224, 224, 224, 224, 224, 224, 224, 224, 226, 226, 226, 226, 226,
-    226, 226, 226, 153, 153, 153, 153, 161, 161, 161, 161, 167, 167, 167, 167,
-    172, 172, 172, 172, 176, 176, 176, 176, 177, 177, 177, 177, 179, 179, 179,
-    179, 209, 209, 209, 209, 216, 216, 216, 216, 217, 217, 217, 217, 227, 227,
-    227, 227, 229, 229, 229, 229, 230, 230, 230, 230, 129, 129, 132, 132, 133,
-    133, 134, 134, 136, 136, 146, 146, 154, 154, 156, 156, 160, 160, 163, 163,
-    164, 164, 169, 169, 170, 170, 173, 173, 178, 178, 181, 181, 185, 185, 186,
-    186, 187, 187, 189, 189, 190, 190, 196, 196, 198, 198, 228, 228, 232, 232,
-    233, 233, 1,   135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151, 152,
-    155, 157, 158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197, 231,
-    239, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  9,   9,   9,
-    9,   9,   9,   9,   9,   142, 142, 142, 142, 142, 142, 142, 142, 144, 144,
-    144, 144, 144, 144, 144, 144, 145, 145, 145, 145, 145, 145, 145, 145, 148,
-    148, 148, 148, 148, 148, 148, 148, 159, 159, 159, 159, 159, 159, 159, 159,
-    171, 171, 171, 171, 171, 171, 171, 171, 206, 206, 206, 206, 206, 206, 206,
-    206, 215, 215, 215, 215, 215, 215, 215, 215, 225, 225, 225, 225, 225, 225,
-    225, 225, 236, 236, 236, 236, 236, 236, 236, 236, 237, 237, 237, 237, 237,
-    237, 237, 237, 199, 199, 199, 199, 207, 207, 207, 207, 234, 234, 234, 234,
-    235, 235, 235, 235, 192, 192, 193, 193, 200, 200, 201, 201, 202, 202, 205,
-    205, 210, 210, 213, 213, 218, 218, 219, 219, 238, 238, 240, 240, 242, 242,
-    243, 243, 255, 255, 203, 204, 211, 212, 214, 221, 222, 223, 241, 244, 245,
-    246, 247, 248, 250, 251, 252, 253, 254, -1,  -1,  -1,  -1,  -1,  -1,  -1,
-    -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  2,   2,   2,   2,   2,   2,   2,
-    2,   3,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   4,
-    4,   4,   5,   5,   5,   5,   5,   5,   5,   5,   6,   6,   6,   6,   6,
-    6,   6,   6,   7,   7,   7,   7,   7,   7,   7,   7,   8,   8,   8,   8,
-    8,   8,   8,   8,   11,  11,  11,  11,  11,  11,  11,  11,  12,  12,  12,
-    12,  12,  12,  12,  12,  14,  14,  14,  14,  14,  14,  14,  14,  15,  15,
-    15,  15,  15,  15,  15,  15,  16,  16,  16,  16,  16,  16,  16,  16,  17,
-    17,  17,  17,  17,  17,  17,  17,  18,  18,  18,  18,  18,  18,  18,  18,
-    19,  19,  19,  19,  19,  19,  19,  19,  20,  20,  20,  20,  20,  20,  20,
-    20,  21,  21,  21,  21,  21,  21,  21,  21,  23,  23,  23,  23,  23,  23,
-    23,  23,  24,  24,  24,  24,  24,  24,  24,  24,  25,  25,  25,  25,  25,
-    25,  25,  25,  26,  26,  26,  26,  26,  26,  26,  26,  27,  27,  27,  27,
-    27,  27,  27,  27,  28,  28,  28,  28,  28,  28,  28,  28,  29,  29,  29,
-    29,  29,  29,  29,  29,  30,  30,  30,  30,  30,  30,  30,  30,  31,  31,
-    31,  31,  31,  31,  31,  31,  127, 127, 127, 127, 127, 127, 127, 127, 220,
-    220, 220, 220, 220, 220, 220, 220, 249, 249, 249, 249, 249, 249, 249, 249,
-    10,  10,  13,  13,  22,  22,  256, 256, 67,  67,  67,  67,  67,  67,  67,
-    67,  68,  68,  68,  68,  68,  68,  68,  68,  95,  95,  95,  95,  95,  95,
-    95,  95,  98,  98,  98,  98,  98,  98,  98,  98,  100, 100, 100, 100, 100,
-    100, 100, 100, 102, 102, 102, 102, 102, 102, 102, 102, 103, 103, 103, 103,
-    103, 103, 103, 103, 104, 104, 104, 104, 104, 104, 104, 104, 108, 108, 108,
-    108, 108, 108, 108, 108, 109, 109, 109, 109, 109, 109, 109, 109, 110, 110,
-    110, 110, 110, 110, 110, 110, 112, 112, 112, 112, 112, 112, 112, 112, 114,
-    114, 114, 114, 114, 114, 114, 114, 117, 117, 117, 117, 117, 117, 117, 117,
-    58,  58,  58,  58,  66,  66,  66,  66,  67,  67,  67,  67,  68,  68,  68,
-    68,  69,  69,  69,  69,  70,  70,  70,  70,  71,  71,  71,  71,  72,  72,
-    72,  72,  73,  73,  73,  73,  74,  74,  74,  74,  75,  75,  75,  75,  76,
-    76,  76,  76,  77,  77,  77,  77,  78,  78,  78,  78,  79,  79,  79,  79,
-    80,  80,  80,  80,  81,  81,  81,  81,  82,  82,  82,  82,  83,  83,  83,
-    83,  84,  84,  84,  84,  85,  85,  85,  85,  86,  86,  86,  86,  87,  87,
-    87,  87,  89,  89,  89,  89,  106, 106, 106, 106, 107, 107, 107, 107, 113,
-    113, 113, 113, 118, 118, 118, 118, 119, 119, 119, 119, 120, 120, 120, 120,
-    121, 121, 121, 121, 122, 122, 122, 122, 38,  38,  42,  42,  44,  44,  59,
-    59,  88,  88,  90,  90,  -1,  -1,  -1,  -1,  33,  33,  33,  33,  33,  33,
-    33,  33,  34,  34,  34,  34,  34,  34,  34,  34,  40,  40,  40,  40,  40,
-    40,  40,  40,  41,  41,  41,  41,  41,  41,  41,  41,  63,  63,  63,  63,
-    63,  63,  63,  63,  39,  39,  39,  39,  43,  43,  43,  43,  124, 124, 124,
-    124, 35,  35,  62,  62,  0,   36,  64,  91,  93,  126, -1,  -1,  94,  94,
-    94,  94,  94,  94,  94,  94,  125, 125, 125, 125, 125, 125, 125, 125, 60,
-    60,  60,  60,  96,  96,  96,  96,  123, 123, 123, 123, -1,  -1,  -1,  -1,
-    92,  92,  92,  92,  195, 195, 195, 195, 208, 208, 208, 208, 128, 128, 130,
-    130, 131, 131, 162, 162, 184, 184, 194, 194, 224, 224, 226, 226, 153, 161,
-    167, 172, 176, 177, 179, 209, 216, 217, 227, 229, 230, -1,  -1,  -1,  -1,
-    -1,  -1,  -1,  129, 129, 129, 129, 129, 129, 129, 129, 132, 132, 132, 132,
-    132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133, 133, 134, 134, 134,
-    134, 134, 134, 134, 134, 136, 136, 136, 136, 136, 136, 136, 136, 146, 146,
-    146, 146, 146, 146, 146, 146, 154, 154, 154, 154, 154, 154, 154, 154, 156,
-    156, 156, 156, 156, 156, 156, 156, 160, 160, 160, 160, 160, 160, 160, 160,
-    163, 163, 163, 163, 163, 163, 163, 163, 164, 164, 164, 164, 164, 164, 164,
-    164, 169, 169, 169, 169, 169, 169, 169, 169, 170, 170, 170, 170, 170, 170,
-    170, 170, 173, 173, 173, 173, 173, 173, 173, 173, 178, 178, 178, 178, 178,
-    178, 178, 178, 181, 181, 181, 181, 181, 181, 181, 181, 185, 185, 185, 185,
-    185, 185, 185, 185, 186, 186, 186, 186, 186, 186, 186, 186, 187, 187, 187,
-    187, 187, 187, 187, 187, 189, 189, 189, 189, 189, 189, 189, 189, 190, 190,
-    190, 190, 190, 190, 190, 190, 196, 196, 196, 196, 196, 196, 196, 196, 198,
-    198, 198, 198, 198, 198, 198, 198, 228, 228, 228, 228, 228, 228, 228, 228,
-    232, 232, 232, 232, 232, 232, 232, 232, 233, 233, 233, 233, 233, 233, 233,
-    233, 1,   1,   1,   1,   135, 135, 135, 135, 137, 137, 137, 137, 138, 138,
-    138, 138, 139, 139, 139, 139, 140, 140, 140, 140, 141, 141, 141, 141, 143,
-    143, 143, 143, 147, 147, 147, 147, 149, 149, 149, 149, 150, 150, 150, 150,
-    151, 151, 151, 151, 152, 152, 152, 152, 155, 155, 155, 155, 157, 157, 157,
-    157, 158, 158, 158, 158, 165, 165, 165, 165, 166, 166, 166, 166, 168, 168,
-    168, 168, 174, 174, 174, 174, 175, 175, 175, 175, 180, 180, 180, 180, 182,
-    182, 182, 182, 183, 183, 183, 183, 188, 188, 188, 188, 191, 191, 191, 191,
-    197, 197, 197, 197, 231, 231, 231, 231, 239, 239, 239, 239, 9,   9,   142,
-    142, 144, 144, 145, 145, 148, 148, 159, 159, 171, 171, 206, 206, 215, 215,
-    225, 225, 236, 236, 237, 237, 199, 207, 234, 235, 192, 192, 192, 192, 192,
-    192, 192, 192, 193, 193, 193, 193, 193, 193, 193, 193, 200, 200, 200, 200,
-    200, 200, 200, 200, 201, 201, 201, 201, 201, 201, 201, 201, 202, 202, 202,
-    202, 202, 202, 202, 202, 205, 205, 205, 205, 205, 205, 205, 205, 210, 210,
-    210, 210, 210, 210, 210, 210, 213, 213, 213, 213, 213, 213, 213, 213, 218,
-    218, 218, 218, 218, 218, 218, 218, 219, 219, 219, 219, 219, 219, 219, 219,
-    238, 238, 238, 238, 238, 238, 238, 238, 240, 240, 240, 240, 240, 240, 240,
-    240, 242, 242, 242, 242, 242, 242, 242, 242, 243, 243, 243, 243, 243, 243,
-    243, 243, 255, 255, 255, 255, 255, 255, 255, 255, 203, 203, 203, 203, 204,
-    204, 204, 204, 211, 211, 211, 211, 212, 212, 212, 212, 214, 214, 214, 214,
-    221, 221, 221, 221, 222, 222, 222, 222, 223, 223, 223, 223, 241, 241, 241,
-    241, 244, 244, 244, 244, 245, 245, 245, 245, 246, 246, 246, 246, 247, 247,
-    247, 247, 248, 248, 248, 248, 250, 250, 250, 250, 251, 251, 251, 251, 252,
-    252, 252, 252, 253, 253, 253, 253, 254, 254, 254, 254, 2,   2,   3,   3,
-    4,   4,   5,   5,   6,   6,   7,   7,   8,   8,   11,  11,  12,  12,  14,
-    14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,
-    23,  23,  24,  24,  25,  25,  26,  26,  27,  27,  28,  28,  29,  29,  30,
-    30,  31,  31,  127, 127, 220, 220, 249, 249, -1,  -1,  10,  10,  10,  10,
-    10,  10,  10,  10,  13,  13,  13,  13,  13,  13,  13,  13,  22,  22,  22,
-    22,  22,  22,  22,  22,  256, 256, 256, 256, 256, 256, 256, 256, 45,  45,
-    45,  45,  45,  45,  45,  45,  46,  46,  46,  46,  46,  46,  46,  46,  47,
-    47,  47,  47,  47,  47,  47,  47,  51,  51,  51,  51,  51,  51,  51,  51,
-    52,  52,  52,  52,  52,  52,  52,  52,  53,  53,  53,  53,  53,  53,  53,
-    53,  54,  54,  54,  54,  54,  54,  54,  54,  55,  55,  55,  55,  55,  55,
-    55,  55,  56,  56,  56,  56,  56,  56,  56,  56,  57,  57,  57,  57,  57,
-    57,  57,  57,  50,  50,  50,  50,  50,  50,  50,  50,  97,  97,  97,  97,
-    97,  97,  97,  97,  99,  99,  99,  99,  99,  99,  99,  99,  101, 101, 101,
-    101, 101, 101, 101, 101, 105, 105, 105, 105, 105, 105, 105, 105, 111, 111,
-    111, 111, 111, 111, 111, 111, 115, 115, 115, 115, 115, 115, 115, 115, 116,
-    116, 116, 116, 116, 116, 116, 116, 32,  32,  32,  32,  37,  37,  37,  37,
-    45,  45,  45,  45,  46,  46,  46,  46,  47,  47,  47,  47,  51,  51,  51,
-    51,  52,  52,  52,  52,  53,  53,  53,  53,  54,  54,  54,  54,  55,  55,
-    55,  55,  56,  56,  56,  56,  57,  57,  57,  57,  61,  61,  61,  61,  65,
-    65,  65,  65,  95,  95,  95,  95,  98,  98,  98,  98,  100, 100, 100, 100,
-    102, 102, 102, 102, 103, 103, 103, 103, 104, 104, 104, 104, 108, 108, 108,
-    108, 109, 109, 109, 109, 110, 110, 110, 110, 112, 112, 112, 112, 114, 114,
-    114, 114, 117, 117, 117, 117, 58,  58,  66,  66,  67,  67,  68,  68,  69,
-    69,  70,  70,  71,  71,  72,  72,  73,  73,  74,  74,  75,  75,  76,  76,
-    77,  77,  78,  78,  79,  79,  80,  80,  81,  81,  82,  82,  83,  83,  84,
-    84,  85,  85,  86,  86,  87,  87,  89,  89,  106, 106, 107, 107, 113, 113,
-    118, 118, 119, 119, 120, 120, 121, 121, 122, 122, 38,  42,  44,  59,  88,
-    90,  -1,  -1,  33,  33,  33,  33,  34,  34,  34,  34,  40,  40,  40,  40,
-    41,  41,  41,  41,  63,  63,  63,  63,  39,  39,  43,  43,  124, 124, 35,
-    62,  -1,  -1,  -1,  -1,  0,   0,   0,   0,   0,   0,   0,   0,   36,  36,
-    36,  36,  36,  36,  36,  36,  64,  64,  64,  64,  64,  64,  64,  64,  91,
-    91,  91,  91,  91,  91,  91,  91,  93,  93,  93,  93,  93,  93,  93,  93,
-    126, 126, 126, 126, 126, 126, 126, 126, 94,  94,  94,  94,  125, 125, 125,
-    125, 60,  60,  96,  96,  123, 123, -1,  -1,  92,  92,  195, 195, 208, 208,
-    128, 130, 131, 162, 184, 194, 224, 226, -1,  -1,  153, 153, 153, 153, 153,
-    153, 153, 153, 161, 161, 161, 161, 161, 161, 161, 161, 167, 167, 167, 167,
-    167, 167, 167, 167, 172, 172, 172, 172, 172, 172, 172, 172, 176, 176, 176,
-    176, 176, 176, 176, 176, 177, 177, 177, 177, 177, 177, 177, 177, 179, 179,
-    179, 179, 179, 179, 179, 179, 209, 209, 209, 209, 209, 209, 209, 209, 216,
-    216, 216, 216, 216, 216, 216, 216, 217, 217, 217, 217, 217, 217, 217, 217,
-    227, 227, 227, 227, 227, 227, 227, 227, 229, 229, 229, 229, 229, 229, 229,
-    229, 230, 230, 230, 230, 230, 230, 230, 230, 129, 129, 129, 129, 132, 132,
-    132, 132, 133, 133, 133, 133, 134, 134, 134, 134, 136, 136, 136, 136, 146,
-    146, 146, 146, 154, 154, 154, 154, 156, 156, 156, 156, 160, 160, 160, 160,
-    163, 163, 163, 163, 164, 164, 164, 164, 169, 169, 169, 169, 170, 170, 170,
-    170, 173, 173, 173, 173, 178, 178, 178, 178, 181, 181, 181, 181, 185, 185,
-    185, 185, 186, 186, 186, 186, 187, 187, 187, 187, 189, 189, 189, 189, 190,
-    190, 190, 190, 196, 196, 196, 196, 198, 198, 198, 198, 228, 228, 228, 228,
-    232, 232, 232, 232, 233, 233, 233, 233, 1,   1,   135, 135, 137, 137, 138,
-    138, 139, 139, 140, 140, 141, 141, 143, 143, 147, 147, 149, 149, 150, 150,
-    151, 151, 152, 152, 155, 155, 157, 157, 158, 158, 165, 165, 166, 166, 168,
-    168, 174, 174, 175, 175, 180, 180, 182, 182, 183, 183, 188, 188, 191, 191,
-    197, 197, 231, 231, 239, 239, 9,   142, 144, 145, 148, 159, 171, 206, 215,
-    225, 236, 237, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  199, 199,
-    199, 199, 199, 199, 199, 199, 207, 207, 207, 207, 207, 207, 207, 207, 234,
-    234, 234, 234, 234, 234, 234, 234, 235, 235, 235, 235, 235, 235, 235, 235,
-    192, 192, 192, 192, 193, 193, 193, 193, 200, 200, 200, 200, 201, 201, 201,
-    201, 202, 202, 202, 202, 205, 205, 205, 205, 210, 210, 210, 210, 213, 213,
-    213, 213, 218, 218, 218, 218, 219, 219, 219, 219, 238, 238, 238, 238, 240,
-    240, 240, 240, 242, 242, 242, 242, 243, 243, 243, 243, 255, 255, 255, 255,
-    203, 203, 204, 204, 211, 211, 212, 212, 214, 214, 221, 221, 222, 222, 223,
-    223, 241, 241, 244, 244, 245, 245, 246, 246, 247, 247, 248, 248, 250, 250,
-    251, 251, 252, 252, 253, 253, 254, 254, 2,   3,   4,   5,   6,   7,   8,
-    11,  12,  14,  15,  16,  17,  18,  19,  20,  21,  23,  24,  25,  26,  27,
-    28,  29,  30,  31,  127, 220, 249, -1,  10,  10,  10,  10,  13,  13,  13,
-    13,  22,  22,  22,  22,  256, 256, 256, 256,
+/* generated by gen_hpack_tables.cc */
+static const uint16_t huff_sorted_syms[257] = {
+    48,  49,  50,  97,  99,  101, 105, 111, 115, 116, 32,  37,  45,  46,  47,
+    51,  52,  53,  54,  55,  56,  57,  61,  65,  95,  98,  100, 102, 103, 104,
+    108, 109, 110, 112, 114, 117, 58,  66,  67,  68,  69,  70,  71,  72,  73,
+    74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  89,
+    106, 107, 113, 118, 119, 120, 121, 122, 38,  42,  44,  59,  88,  90,  33,
+    34,  40,  41,  63,  39,  43,  124, 35,  62,  0,   36,  64,  91,  93,  126,
+    94,  125, 60,  96,  123, 92,  195, 208, 128, 130, 131, 162, 184, 194, 224,
+    226, 153, 161, 167, 172, 176, 177, 179, 209, 216, 217, 227, 229, 230, 129,
+    132, 133, 134, 136, 146, 154, 156, 160, 163, 164, 169, 170, 173, 178, 181,
+    185, 186, 187, 189, 190, 196, 198, 228, 232, 233, 1,   135, 137, 138, 139,
+    140, 141, 143, 147, 149, 150, 151, 152, 155, 157, 158, 165, 166, 168, 174,
+    175, 180, 182, 183, 188, 191, 197, 231, 239, 9,   142, 144, 145, 148, 159,
+    171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193, 200, 201, 202,
+    205, 210, 213, 218, 219, 238, 240, 242, 243, 255, 203, 204, 211, 212, 214,
+    221, 222, 223, 241, 244, 245, 246, 247, 248, 250, 251, 252, 253, 254, 2,
+    3,   4,   5,   6,   7,   8,   11,  12,  14,  15,  16,  17,  18,  19,  20,
+    21,  23,  24,  25,  26,  27,  28,  29,  30,  31,  127, 220, 249, 10,  13,
+    22,  256,
 };
 
+/* lookup table for huffman decoding: indexed by the next HUFF_LOOKUP_BITS bits
+   of a string, gives the (up to two) symbols whose codes fit in those bits.
+   Each entry packs the first symbol, the second symbol, the number of symbols
+   and the number of bits they take, from the lowest byte up.
+
+   generated by gen_hpack_tables.cc */
+static const uint32_t huff_lookup[2048] = {
+    0x0a023030, 0x0a023030, 0x0a023130, 0x0a023130, 0x0a023230, 0x0a023230,
+    0x0a026130, 0x0a026130, 0x0a026330, 0x0a026330, 0x0a026530, 0x0a026530,
+    0x0a026930, 0x0a026930, 0x0a026f30, 0x0a026f30, 0x0a027330, 0x0a027330,
+    0x0a027430, 0x0a027430, 0x0b022030, 0x0b022530, 0x0b022d30, 0x0b022e30,
+    0x0b022f30, 0x0b023330, 0x0b023430, 0x0b023530, 0x0b023630, 0x0b023730,
+    0x0b023830, 0x0b023930, 0x0b023d30, 0x0b024130, 0x0b025f30, 0x0b026230,
+    0x0b026430, 0x0b026630, 0x0b026730, 0x0b026830, 0x0b026c30, 0x0b026d30,
+    0x0b026e30, 0x0b027030, 0x0b027230, 0x0b027530, 0x05010030, 0x05010030,
+    0x05010030, 0x05010030, 0x05010030, 0x05010030, 0x05010030, 0x05010030,
+    0x05010030, 0x05010030, 0x05010030, 0x05010030, 0x05010030, 0x05010030,
+    0x05010030, 0x05010030, 0x05010030, 0x05010030, 0x0a023031, 0x0a023031,
+    0x0a023131, 0x0a023131, 0x0a023231, 0x0a023231, 0x0a026131, 0x0a026131,
+    0x0a026331, 0x0a026331, 0x0a026531, 0x0a026531, 0x0a026931, 0x0a026931,
+    0x0a026f31, 0x0a026f31, 0x0a027331, 0x0a027331, 0x0a027431, 0x0a027431,
+    0x0b022031, 0x0b022531, 0x0b022d31, 0x0b022e31, 0x0b022f31, 0x0b023331,
+    0x0b023431, 0x0b023531, 0x0b023631, 0x0b023731, 0x0b023831, 0x0b023931,
+    0x0b023d31, 0x0b024131, 0x0b025f31, 0x0b026231, 0x0b026431, 0x0b026631,
+    0x0b026731, 0x0b026831, 0x0b026c31, 0x0b026d31, 0x0b026e31, 0x0b027031,
+    0x0b027231, 0x0b027531, 0x05010031, 0x05010031, 0x05010031, 0x05010031,
+    0x05010031, 0x05010031, 0x05010031, 0x05010031, 0x05010031, 0x05010031,
+    0x05010031, 0x05010031, 0x05010031, 0x05010031, 0x05010031, 0x05010031,
+    0x05010031, 0x05010031, 0x0a023032, 0x0a023032, 0x0a023132, 0x0a023132,
+    0x0a023232, 0x0a023232, 0x0a026132, 0x0a026132, 0x0a026332, 0x0a026332,
+    0x0a026532, 0x0a026532, 0x0a026932, 0x0a026932, 0x0a026f32, 0x0a026f32,
+    0x0a027332, 0x0a027332, 0x0a027432, 0x0a027432, 0x0b022032, 0x0b022532,
+    0x0b022d32, 0x0b022e32, 0x0b022f32, 0x0b023332, 0x0b023432, 0x0b023532,
+    0x0b023632, 0x0b023732, 0x0b023832, 0x0b023932, 0x0b023d32, 0x0b024132,
+    0x0b025f32, 0x0b026232, 0x0b026432, 0x0b026632, 0x0b026732, 0x0b026832,
+    0x0b026c32, 0x0b026d32, 0x0b026e32, 0x0b027032, 0x0b027232, 0x0b027532,
+    0x05010032, 0x05010032, 0x05010032, 0x05010032, 0x05010032, 0x05010032,
+    0x05010032, 0x05010032, 0x05010032, 0x05010032, 0x05010032, 0x05010032,
+    0x05010032, 0x05010032, 0x05010032, 0x05010032, 0x05010032, 0x05010032,
+    0x0a023061, 0x0a023061, 0x0a023161, 0x0a023161, 0x0a023261, 0x0a023261,
+    0x0a026161, 0x0a026161, 0x0a026361, 0x0a026361, 0x0a026561, 0x0a026561,
+    0x0a026961, 0x0a026961, 0x0a026f61, 0x0a026f61, 0x0a027361, 0x0a027361,
+    0x0a027461, 0x0a027461, 0x0b022061, 0x0b022561, 0x0b022d61, 0x0b022e61,
+    0x0b022f61, 0x0b023361, 0x0b023461, 0x0b023561, 0x0b023661, 0x0b023761,
+    0x0b023861, 0x0b023961, 0x0b023d61, 0x0b024161, 0x0b025f61, 0x0b026261,
+    0x0b026461, 0x0b026661, 0x0b026761, 0x0b026861, 0x0b026c61, 0x0b026d61,
+    0x0b026e61, 0x0b027061, 0x0b027261, 0x0b027561, 0x05010061, 0x05010061,
+    0x05010061, 0x05010061, 0x05010061, 0x05010061, 0x05010061, 0x05010061,
+    0x05010061, 0x05010061, 0x05010061, 0x05010061, 0x05010061, 0x05010061,
+    0x05010061, 0x05010061, 0x05010061, 0x05010061, 0x0a023063, 0x0a023063,
+    0x0a023163, 0x0a023163, 0x0a023263, 0x0a023263, 0x0a026163, 0x0a026163,
+    0x0a026363, 0x0a026363, 0x0a026563, 0x0a026563, 0x0a026963, 0x0a026963,
+    0x0a026f63, 0x0a026f63, 0x0a027363, 0x0a027363, 0x0a027463, 0x0a027463,
+    0x0b022063, 0x0b022563, 0x0b022d63, 0x0b022e63, 0x0b022f63, 0x0b023363,
+    0x0b023463, 0x0b023563, 0x0b023663, 0x0b023763, 0x0b023863, 0x0b023963,
+    0x0b023d63, 0x0b024163, 0x0b025f63, 0x0b026263, 0x0b026463, 0x0b026663,
+    0x0b026763, 0x0b026863, 0x0b026c63, 0x0b026d63, 0x0b026e63, 0x0b027063,
+    0x0b027263, 0x0b027563, 0x05010063, 0x05010063, 0x05010063, 0x05010063,
+    0x05010063, 0x05010063, 0x05010063, 0x05010063, 0x05010063, 0x05010063,
+    0x05010063, 0x05010063, 0x05010063, 0x05010063, 0x05010063, 0x05010063,
+    0x05010063, 0x05010063, 0x0a023065, 0x0a023065, 0x0a023165, 0x0a023165,
+    0x0a023265, 0x0a023265, 0x0a026165, 0x0a026165, 0x0a026365, 0x0a026365,
+    0x0a026565, 0x0a026565, 0x0a026965, 0x0a026965, 0x0a026f65, 0x0a026f65,
+    0x0a027365, 0x0a027365, 0x0a027465, 0x0a027465, 0x0b022065, 0x0b022565,
+    0x0b022d65, 0x0b022e65, 0x0b022f65, 0x0b023365, 0x0b023465, 0x0b023565,
+    0x0b023665, 0x0b023765, 0x0b023865, 0x0b023965, 0x0b023d65, 0x0b024165,
+    0x0b025f65, 0x0b026265, 0x0b026465, 0x0b026665, 0x0b026765, 0x0b026865,
+    0x0b026c65, 0x0b026d65, 0x0b026e65, 0x0b027065, 0x0b027265, 0x0b027565,
+    0x05010065, 0x05010065, 0x05010065, 0x05010065, 0x05010065, 0x05010065,
+    0x05010065, 0x05010065, 0x05010065, 0x05010065, 0x05010065, 0x05010065,
+    0x05010065, 0x05010065, 0x05010065, 0x05010065, 0x05010065, 0x05010065,
+    0x0a023069, 0x0a023069, 0x0a023169, 0x0a023169, 0x0a023269, 0x0a023269,
+    0x0a026169, 0x0a026169, 0x0a026369, 0x0a026369, 0x0a026569, 0x0a026569,
+    0x0a026969, 0x0a026969, 0x0a026f69, 0x0a026f69, 0x0a027369, 0x0a027369,
+    0x0a027469, 0x0a027469, 0x0b022069, 0x0b022569, 0x0b022d69, 0x0b022e69,
+    0x0b022f69, 0x0b023369, 0x0b023469, 0x0b023569, 0x0b023669, 0x0b023769,
+    0x0b023869, 0x0b023969, 0x0b023d69, 0x0b024169, 0x0b025f69, 0x0b026269,
+    0x0b026469, 0x0b026669, 0x0b026769, 0x0b026869, 0x0b026c69, 0x0b026d69,
+    0x0b026e69, 0x0b027069, 0x0b027269, 0x0b027569, 0x05010069, 0x05010069,
+    0x05010069, 0x05010069, 0x05010069, 0x05010069, 0x05010069, 0x05010069,
+    0x05010069, 0x05010069, 0x05010069, 0x05010069, 0x05010069, 0x05010069,
+    0x05010069, 0x05010069, 0x05010069, 0x05010069, 0x0a02306f, 0x0a02306f,
+    0x0a02316f, 0x0a02316f, 0x0a02326f, 0x0a02326f, 0x0a02616f, 0x0a02616f,
+    0x0a02636f, 0x0a02636f, 0x0a02656f, 0x0a02656f, 0x0a02696f, 0x0a02696f,
+    0x0a026f6f, 0x0a026f6f, 0x0a02736f, 0x0a02736f, 0x0a02746f, 0x0a02746f,
+    0x0b02206f, 0x0b02256f, 0x0b022d6f, 0x0b022e6f, 0x0b022f6f, 0x0b02336f,
+    0x0b02346f, 0x0b02356f, 0x0b02366f, 0x0b02376f, 0x0b02386f, 0x0b02396f,
+    0x0b023d6f, 0x0b02416f, 0x0b025f6f, 0x0b02626f, 0x0b02646f, 0x0b02666f,
+    0x0b02676f, 0x0b02686f, 0x0b026c6f, 0x0b026d6f, 0x0b026e6f, 0x0b02706f,
+    0x0b02726f, 0x0b02756f, 0x0501006f, 0x0501006f, 0x0501006f, 0x0501006f,
+    0x0501006f, 0x0501006f, 0x0501006f, 0x0501006f, 0x0501006f, 0x0501006f,
+    0x0501006f, 0x0501006f, 0x0501006f, 0x0501006f, 0x0501006f, 0x0501006f,
+    0x0501006f, 0x0501006f, 0x0a023073, 0x0a023073, 0x0a023173, 0x0a023173,
+    0x0a023273, 0x0a023273, 0x0a026173, 0x0a026173, 0x0a026373, 0x0a026373,
+    0x0a026573, 0x0a026573, 0x0a026973, 0x0a026973, 0x0a026f73, 0x0a026f73,
+    0x0a027373, 0x0a027373, 0x0a027473, 0x0a027473, 0x0b022073, 0x0b022573,
+    0x0b022d73, 0x0b022e73, 0x0b022f73, 0x0b023373, 0x0b023473, 0x0b023573,
+    0x0b023673, 0x0b023773, 0x0b023873, 0x0b023973, 0x0b023d73, 0x0b024173,
+    0x0b025f73, 0x0b026273, 0x0b026473, 0x0b026673, 0x0b026773, 0x0b026873,
+    0x0b026c73, 0x0b026d73, 0x0b026e73, 0x0b027073, 0x0b027273, 0x0b027573,
+    0x05010073, 0x05010073, 0x05010073, 0x05010073, 0x05010073, 0x05010073,
+    0x05010073, 0x05010073, 0x05010073, 0x05010073, 0x05010073, 0x05010073,
+    0x05010073, 0x05010073, 0x05010073, 0x05010073, 0x05010073, 0x05010073,
+    0x0a023074, 0x0a023074, 0x0a023174, 0x0a023174, 0x0a023274, 0x0a023274,
+    0x0a026174, 0x0a026174, 0x0a026374, 0x0a026374, 0x0a026574, 0x0a026574,
+    0x0a026974, 0x0a026974, 0x0a026f74, 0x0a026f74, 0x0a027374, 0x0a027374,
+    0x0a027474, 0x0a027474, 0x0b022074, 0x0b022574, 0x0b022d74, 0x0b022e74,
+    0x0b022f74, 0x0b023374, 0x0b023474, 0x0b023574, 0x0b023674, 0x0b023774,
+    0x0b023874, 0x0b023974, 0x0b023d74, 0x0b024174, 0x0b025f74, 0x0b026274,
+    0x0b026474, 0x0b026674, 0x0b026774, 0x0b026874, 0x0b026c74, 0x0b026d74,
+    0x0b026e74, 0x0b027074, 0x0b027274, 0x0b027574, 0x05010074, 0x05010074,
+    0x05010074, 0x05010074, 0x05010074, 0x05010074, 0x05010074, 0x05010074,
+    0x05010074, 0x05010074, 0x05010074, 0x05010074, 0x05010074, 0x05010074,
+    0x05010074, 0x05010074, 0x05010074, 0x05010074, 0x0b023020, 0x0b023120,
+    0x0b023220, 0x0b026120, 0x0b026320, 0x0b026520, 0x0b026920, 0x0b026f20,
+    0x0b027320, 0x0b027420, 0x06010020, 0x06010020, 0x06010020, 0x06010020,
+    0x06010020, 0x06010020, 0x06010020, 0x06010020, 0x06010020, 0x06010020,
+    0x06010020, 0x06010020, 0x06010020, 0x06010020, 0x06010020, 0x06010020,
+    0x06010020, 0x06010020, 0x06010020, 0x06010020, 0x06010020, 0x06010020,
+    0x0b023025, 0x0b023125, 0x0b023225, 0x0b026125, 0x0b026325, 0x0b026525,
+    0x0b026925, 0x0b026f25, 0x0b027325, 0x0b027425, 0x06010025, 0x06010025,
+    0x06010025, 0x06010025, 0x06010025, 0x06010025, 0x06010025, 0x06010025,
+    0x06010025, 0x06010025, 0x06010025, 0x06010025, 0x06010025, 0x06010025,
+    0x06010025, 0x06010025, 0x06010025, 0x06010025, 0x06010025, 0x06010025,
+    0x06010025, 0x06010025, 0x0b02302d, 0x0b02312d, 0x0b02322d, 0x0b02612d,
+    0x0b02632d, 0x0b02652d, 0x0b02692d, 0x0b026f2d, 0x0b02732d, 0x0b02742d,
+    0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d,
+    0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d,
+    0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d,
+    0x0601002d, 0x0601002d, 0x0601002d, 0x0601002d, 0x0b02302e, 0x0b02312e,
+    0x0b02322e, 0x0b02612e, 0x0b02632e, 0x0b02652e, 0x0b02692e, 0x0b026f2e,
+    0x0b02732e, 0x0b02742e, 0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e,
+    0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e,
+    0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e,
+    0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e, 0x0601002e,
+    0x0b02302f, 0x0b02312f, 0x0b02322f, 0x0b02612f, 0x0b02632f, 0x0b02652f,
+    0x0b02692f, 0x0b026f2f, 0x0b02732f, 0x0b02742f, 0x0601002f, 0x0601002f,
+    0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f,
+    0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f,
+    0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f, 0x0601002f,
+    0x0601002f, 0x0601002f, 0x0b023033, 0x0b023133, 0x0b023233, 0x0b026133,
+    0x0b026333, 0x0b026533, 0x0b026933, 0x0b026f33, 0x0b027333, 0x0b027433,
+    0x06010033, 0x06010033, 0x06010033, 0x06010033, 0x06010033, 0x06010033,
+    0x06010033, 0x06010033, 0x06010033, 0x06010033, 0x06010033, 0x06010033,
+    0x06010033, 0x06010033, 0x06010033, 0x06010033, 0x06010033, 0x06010033,
+    0x06010033, 0x06010033, 0x06010033, 0x06010033, 0x0b023034, 0x0b023134,
+    0x0b023234, 0x0b026134, 0x0b026334, 0x0b026534, 0x0b026934, 0x0b026f34,
+    0x0b027334, 0x0b027434, 0x06010034, 0x06010034, 0x06010034, 0x06010034,
+    0x06010034, 0x06010034, 0x06010034, 0x06010034, 0x06010034, 0x06010034,
+    0x06010034, 0x06010034, 0x06010034, 0x06010034, 0x06010034, 0x06010034,
+    0x06010034, 0x06010034, 0x06010034, 0x06010034, 0x06010034, 0x06010034,
+    0x0b023035, 0x0b023135, 0x0b023235, 0x0b026135, 0x0b026335, 0x0b026535,
+    0x0b026935, 0x0b026f35, 0x0b027335, 0x0b027435, 0x06010035, 0x06010035,
+    0x06010035, 0x06010035, 0x06010035, 0x06010035, 0x06010035, 0x06010035,
+    0x06010035, 0x06010035, 0x06010035, 0x06010035, 0x06010035, 0x06010035,
+    0x06010035, 0x06010035, 0x06010035, 0x06010035, 0x06010035, 0x06010035,
+    0x06010035, 0x06010035, 0x0b023036, 0x0b023136, 0x0b023236, 0x0b026136,
+    0x0b026336, 0x0b026536, 0x0b026936, 0x0b026f36, 0x0b027336, 0x0b027436,
+    0x06010036, 0x06010036, 0x06010036, 0x06010036, 0x06010036, 0x06010036,
+    0x06010036, 0x06010036, 0x06010036, 0x06010036, 0x06010036, 0x06010036,
+    0x06010036, 0x06010036, 0x06010036, 0x06010036, 0x06010036, 0x06010036,
+    0x06010036, 0x06010036, 0x06010036, 0x06010036, 0x0b023037, 0x0b023137,
+    0x0b023237, 0x0b026137, 0x0b026337, 0x0b026537, 0x0b026937, 0x0b026f37,
+    0x0b027337, 0x0b027437, 0x06010037, 0x06010037, 0x06010037, 0x06010037,
+    0x06010037, 0x06010037, 0x06010037, 0x06010037, 0x06010037, 0x06010037,
+    0x06010037, 0x06010037, 0x06010037, 0x06010037, 0x06010037, 0x06010037,
+    0x06010037, 0x06010037, 0x06010037, 0x06010037, 0x06010037, 0x06010037,
+    0x0b023038, 0x0b023138, 0x0b023238, 0x0b026138, 0x0b026338, 0x0b026538,
+    0x0b026938, 0x0b026f38, 0x0b027338, 0x0b027438, 0x06010038, 0x06010038,
+    0x06010038, 0x06010038, 0x06010038, 0x06010038, 0x06010038, 0x06010038,
+    0x06010038, 0x06010038, 0x06010038, 0x06010038, 0x06010038, 0x06010038,
+    0x06010038, 0x06010038, 0x06010038, 0x06010038, 0x06010038, 0x06010038,
+    0x06010038, 0x06010038, 0x0b023039, 0x0b023139, 0x0b023239, 0x0b026139,
+    0x0b026339, 0x0b026539, 0x0b026939, 0x0b026f39, 0x0b027339, 0x0b027439,
+    0x06010039, 0x06010039, 0x06010039, 0x06010039, 0x06010039, 0x06010039,
+    0x06010039, 0x06010039, 0x06010039, 0x06010039, 0x06010039, 0x06010039,
+    0x06010039, 0x06010039, 0x06010039, 0x06010039, 0x06010039, 0x06010039,
+    0x06010039, 0x06010039, 0x06010039, 0x06010039, 0x0b02303d, 0x0b02313d,
+    0x0b02323d, 0x0b02613d, 0x0b02633d, 0x0b02653d, 0x0b02693d, 0x0b026f3d,
+    0x0b02733d, 0x0b02743d, 0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d,
+    0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d,
+    0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d,
+    0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d, 0x0601003d,
+    0x0b023041, 0x0b023141, 0x0b023241, 0x0b026141, 0x0b026341, 0x0b026541,
+    0x0b026941, 0x0b026f41, 0x0b027341, 0x0b027441, 0x06010041, 0x06010041,
+    0x06010041, 0x06010041, 0x06010041, 0x06010041, 0x06010041, 0x06010041,
+    0x06010041, 0x06010041, 0x06010041, 0x06010041, 0x06010041, 0x06010041,
+    0x06010041, 0x06010041, 0x06010041, 0x06010041, 0x06010041, 0x06010041,
+    0x06010041, 0x06010041, 0x0b02305f, 0x0b02315f, 0x0b02325f, 0x0b02615f,
+    0x0b02635f, 0x0b02655f, 0x0b02695f, 0x0b026f5f, 0x0b02735f, 0x0b02745f,
+    0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f,
+    0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f,
+    0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f,
+    0x0601005f, 0x0601005f, 0x0601005f, 0x0601005f, 0x0b023062, 0x0b023162,
+    0x0b023262, 0x0b026162, 0x0b026362, 0x0b026562, 0x0b026962, 0x0b026f62,
+    0x0b027362, 0x0b027462, 0x06010062, 0x06010062, 0x06010062, 0x06010062,
+    0x06010062, 0x06010062, 0x06010062, 0x06010062, 0x06010062, 0x06010062,
+    0x06010062, 0x06010062, 0x06010062, 0x06010062, 0x06010062, 0x06010062,
+    0x06010062, 0x06010062, 0x06010062, 0x06010062, 0x06010062, 0x06010062,
+    0x0b023064, 0x0b023164, 0x0b023264, 0x0b026164, 0x0b026364, 0x0b026564,
+    0x0b026964, 0x0b026f64, 0x0b027364, 0x0b027464, 0x06010064, 0x06010064,
+    0x06010064, 0x06010064, 0x06010064, 0x06010064, 0x06010064, 0x06010064,
+    0x06010064, 0x06010064, 0x06010064, 0x06010064, 0x06010064, 0x06010064,
+    0x06010064, 0x06010064, 0x06010064, 0x06010064, 0x06010064, 0x06010064,
+    0x06010064, 0x06010064, 0x0b023066, 0x0b023166, 0x0b023266, 0x0b026166,
+    0x0b026366, 0x0b026566, 0x0b026966, 0x0b026f66, 0x0b027366, 0x0b027466,
+    0x06010066, 0x06010066, 0x06010066, 0x06010066, 0x06010066, 0x06010066,
+    0x06010066, 0x06010066, 0x06010066, 0x06010066, 0x06010066, 0x06010066,
+    0x06010066, 0x06010066, 0x06010066, 0x06010066, 0x06010066, 0x06010066,
+    0x06010066, 0x06010066, 0x06010066, 0x06010066, 0x0b023067, 0x0b023167,
+    0x0b023267, 0x0b026167, 0x0b026367, 0x0b026567, 0x0b026967, 0x0b026f67,
+    0x0b027367, 0x0b027467, 0x06010067, 0x06010067, 0x06010067, 0x06010067,
+    0x06010067, 0x06010067, 0x06010067, 0x06010067, 0x06010067, 0x06010067,
+    0x06010067, 0x06010067, 0x06010067, 0x06010067, 0x06010067, 0x06010067,
+    0x06010067, 0x06010067, 0x06010067, 0x06010067, 0x06010067, 0x06010067,
+    0x0b023068, 0x0b023168, 0x0b023268, 0x0b026168, 0x0b026368, 0x0b026568,
+    0x0b026968, 0x0b026f68, 0x0b027368, 0x0b027468, 0x06010068, 0x06010068,
+    0x06010068, 0x06010068, 0x06010068, 0x06010068, 0x06010068, 0x06010068,
+    0x06010068, 0x06010068, 0x06010068, 0x06010068, 0x06010068, 0x06010068,
+    0x06010068, 0x06010068, 0x06010068, 0x06010068, 0x06010068, 0x06010068,
+    0x06010068, 0x06010068, 0x0b02306c, 0x0b02316c, 0x0b02326c, 0x0b02616c,
+    0x0b02636c, 0x0b02656c, 0x0b02696c, 0x0b026f6c, 0x0b02736c, 0x0b02746c,
+    0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c,
+    0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c,
+    0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c,
+    0x0601006c, 0x0601006c, 0x0601006c, 0x0601006c, 0x0b02306d, 0x0b02316d,
+    0x0b02326d, 0x0b02616d, 0x0b02636d, 0x0b02656d, 0x0b02696d, 0x0b026f6d,
+    0x0b02736d, 0x0b02746d, 0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d,
+    0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d,
+    0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d,
+    0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d, 0x0601006d,
+    0x0b02306e, 0x0b02316e, 0x0b02326e, 0x0b02616e, 0x0b02636e, 0x0b02656e,
+    0x0b02696e, 0x0b026f6e, 0x0b02736e, 0x0b02746e, 0x0601006e, 0x0601006e,
+    0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e,
+    0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e,
+    0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e, 0x0601006e,
+    0x0601006e, 0x0601006e, 0x0b023070, 0x0b023170, 0x0b023270, 0x0b026170,
+    0x0b026370, 0x0b026570, 0x0b026970, 0x0b026f70, 0x0b027370, 0x0b027470,
+    0x06010070, 0x06010070, 0x06010070, 0x06010070, 0x06010070, 0x06010070,
+    0x06010070, 0x06010070, 0x06010070, 0x06010070, 0x06010070, 0x06010070,
+    0x06010070, 0x06010070, 0x06010070, 0x06010070, 0x06010070, 0x06010070,
+    0x06010070, 0x06010070, 0x06010070, 0x06010070, 0x0b023072, 0x0b023172,
+    0x0b023272, 0x0b026172, 0x0b026372, 0x0b026572, 0x0b026972, 0x0b026f72,
+    0x0b027372, 0x0b027472, 0x06010072, 0x06010072, 0x06010072, 0x06010072,
+    0x06010072, 0x06010072, 0x06010072, 0x06010072, 0x06010072, 0x06010072,
+    0x06010072, 0x06010072, 0x06010072, 0x06010072, 0x06010072, 0x06010072,
+    0x06010072, 0x06010072, 0x06010072, 0x06010072, 0x06010072, 0x06010072,
+    0x0b023075, 0x0b023175, 0x0b023275, 0x0b026175, 0x0b026375, 0x0b026575,
+    0x0b026975, 0x0b026f75, 0x0b027375, 0x0b027475, 0x06010075, 0x06010075,
+    0x06010075, 0x06010075, 0x06010075, 0x06010075, 0x06010075, 0x06010075,
+    0x06010075, 0x06010075, 0x06010075, 0x06010075, 0x06010075, 0x06010075,
+    0x06010075, 0x06010075, 0x06010075, 0x06010075, 0x06010075, 0x06010075,
+    0x06010075, 0x06010075, 0x0701003a, 0x0701003a, 0x0701003a, 0x0701003a,
+    0x0701003a, 0x0701003a, 0x0701003a, 0x0701003a, 0x0701003a, 0x0701003a,
+    0x0701003a, 0x0701003a, 0x0701003a, 0x0701003a, 0x0701003a, 0x0701003a,
+    0x07010042, 0x07010042, 0x07010042, 0x07010042, 0x07010042, 0x07010042,
+    0x07010042, 0x07010042, 0x07010042, 0x07010042, 0x07010042, 0x07010042,
+    0x07010042, 0x07010042, 0x07010042, 0x07010042, 0x07010043, 0x07010043,
+    0x07010043, 0x07010043, 0x07010043, 0x07010043, 0x07010043, 0x07010043,
+    0x07010043, 0x07010043, 0x07010043, 0x07010043, 0x07010043, 0x07010043,
+    0x07010043, 0x07010043, 0x07010044, 0x07010044, 0x07010044, 0x07010044,
+    0x07010044, 0x07010044, 0x07010044, 0x07010044, 0x07010044, 0x07010044,
+    0x07010044, 0x07010044, 0x07010044, 0x07010044, 0x07010044, 0x07010044,
+    0x07010045, 0x07010045, 0x07010045, 0x07010045, 0x07010045, 0x07010045,
+    0x07010045, 0x07010045, 0x07010045, 0x07010045, 0x07010045, 0x07010045,
+    0x07010045, 0x07010045, 0x07010045, 0x07010045, 0x07010046, 0x07010046,
+    0x07010046, 0x07010046, 0x07010046, 0x07010046, 0x07010046, 0x07010046,
+    0x07010046, 0x07010046, 0x07010046, 0x07010046, 0x07010046, 0x07010046,
+    0x07010046, 0x07010046, 0x07010047, 0x07010047, 0x07010047, 0x07010047,
+    0x07010047, 0x07010047, 0x07010047, 0x07010047, 0x07010047, 0x07010047,
+    0x07010047, 0x07010047, 0x07010047, 0x07010047, 0x07010047, 0x07010047,
+    0x07010048, 0x07010048, 0x07010048, 0x07010048, 0x07010048, 0x07010048,
+    0x07010048, 0x07010048, 0x07010048, 0x07010048, 0x07010048, 0x07010048,
+    0x07010048, 0x07010048, 0x07010048, 0x07010048, 0x07010049, 0x07010049,
+    0x07010049, 0x07010049, 0x07010049, 0x07010049, 0x07010049, 0x07010049,
+    0x07010049, 0x07010049, 0x07010049, 0x07010049, 0x07010049, 0x07010049,
+    0x07010049, 0x07010049, 0x0701004a, 0x0701004a, 0x0701004a, 0x0701004a,
+    0x0701004a, 0x0701004a, 0x0701004a, 0x0701004a, 0x0701004a, 0x0701004a,
+    0x0701004a, 0x0701004a, 0x0701004a, 0x0701004a, 0x0701004a, 0x0701004a,
+    0x0701004b, 0x0701004b, 0x0701004b, 0x0701004b, 0x0701004b, 0x0701004b,
+    0x0701004b, 0x0701004b, 0x0701004b, 0x0701004b, 0x0701004b, 0x0701004b,
+    0x0701004b, 0x0701004b, 0x0701004b, 0x0701004b, 0x0701004c, 0x0701004c,
+    0x0701004c, 0x0701004c, 0x0701004c, 0x0701004c, 0x0701004c, 0x0701004c,
+    0x0701004c, 0x0701004c, 0x0701004c, 0x0701004c, 0x0701004c, 0x0701004c,
+    0x0701004c, 0x0701004c, 0x0701004d, 0x0701004d, 0x0701004d, 0x0701004d,
+    0x0701004d, 0x0701004d, 0x0701004d, 0x0701004d, 0x0701004d, 0x0701004d,
+    0x0701004d, 0x0701004d, 0x0701004d, 0x0701004d, 0x0701004d, 0x0701004d,
+    0x0701004e, 0x0701004e, 0x0701004e, 0x0701004e, 0x0701004e, 0x0701004e,
+    0x0701004e, 0x0701004e, 0x0701004e, 0x0701004e, 0x0701004e, 0x0701004e,
+    0x0701004e, 0x0701004e, 0x0701004e, 0x0701004e, 0x0701004f, 0x0701004f,
+    0x0701004f, 0x0701004f, 0x0701004f, 0x0701004f, 0x0701004f, 0x0701004f,
+    0x0701004f, 0x0701004f, 0x0701004f, 0x0701004f, 0x0701004f, 0x0701004f,
+    0x0701004f, 0x0701004f, 0x07010050, 0x07010050, 0x07010050, 0x07010050,
+    0x07010050, 0x07010050, 0x07010050, 0x07010050, 0x07010050, 0x07010050,
+    0x07010050, 0x07010050, 0x07010050, 0x07010050, 0x07010050, 0x07010050,
+    0x07010051, 0x07010051, 0x07010051, 0x07010051, 0x07010051, 0x07010051,
+    0x07010051, 0x07010051, 0x07010051, 0x07010051, 0x07010051, 0x07010051,
+    0x07010051, 0x07010051, 0x07010051, 0x07010051, 0x07010052, 0x07010052,
+    0x07010052, 0x07010052, 0x07010052, 0x07010052, 0x07010052, 0x07010052,
+    0x07010052, 0x07010052, 0x07010052, 0x07010052, 0x07010052, 0x07010052,
+    0x07010052, 0x07010052, 0x07010053, 0x07010053, 0x07010053, 0x07010053,
+    0x07010053, 0x07010053, 0x07010053, 0x07010053, 0x07010053, 0x07010053,
+    0x07010053, 0x07010053, 0x07010053, 0x07010053, 0x07010053, 0x07010053,
+    0x07010054, 0x07010054, 0x07010054, 0x07010054, 0x07010054, 0x07010054,
+    0x07010054, 0x07010054, 0x07010054, 0x07010054, 0x07010054, 0x07010054,
+    0x07010054, 0x07010054, 0x07010054, 0x07010054, 0x07010055, 0x07010055,
+    0x07010055, 0x07010055, 0x07010055, 0x07010055, 0x07010055, 0x07010055,
+    0x07010055, 0x07010055, 0x07010055, 0x07010055, 0x07010055, 0x07010055,
+    0x07010055, 0x07010055, 0x07010056, 0x07010056, 0x07010056, 0x07010056,
+    0x07010056, 0x07010056, 0x07010056, 0x07010056, 0x07010056, 0x07010056,
+    0x07010056, 0x07010056, 0x07010056, 0x07010056, 0x07010056, 0x07010056,
+    0x07010057, 0x07010057, 0x07010057, 0x07010057, 0x07010057, 0x07010057,
+    0x07010057, 0x07010057, 0x07010057, 0x07010057, 0x07010057, 0x07010057,
+    0x07010057, 0x07010057, 0x07010057, 0x07010057, 0x07010059, 0x07010059,
+    0x07010059, 0x07010059, 0x07010059, 0x07010059, 0x07010059, 0x07010059,
+    0x07010059, 0x07010059, 0x07010059, 0x07010059, 0x07010059, 0x07010059,
+    0x07010059, 0x07010059, 0x0701006a, 0x0701006a, 0x0701006a, 0x0701006a,
+    0x0701006a, 0x0701006a, 0x0701006a, 0x0701006a, 0x0701006a, 0x0701006a,
+    0x0701006a, 0x0701006a, 0x0701006a, 0x0701006a, 0x0701006a, 0x0701006a,
+    0x0701006b, 0x0701006b, 0x0701006b, 0x0701006b, 0x0701006b, 0x0701006b,
+    0x0701006b, 0x0701006b, 0x0701006b, 0x0701006b, 0x0701006b, 0x0701006b,
+    0x0701006b, 0x0701006b, 0x0701006b, 0x0701006b, 0x07010071, 0x07010071,
+    0x07010071, 0x07010071, 0x07010071, 0x07010071, 0x07010071, 0x07010071,
+    0x07010071, 0x07010071, 0x07010071, 0x07010071, 0x07010071, 0x07010071,
+    0x07010071, 0x07010071, 0x07010076, 0x07010076, 0x07010076, 0x07010076,
+    0x07010076, 0x07010076, 0x07010076, 0x07010076, 0x07010076, 0x07010076,
+    0x07010076, 0x07010076, 0x07010076, 0x07010076, 0x07010076, 0x07010076,
+    0x07010077, 0x07010077, 0x07010077, 0x07010077, 0x07010077, 0x07010077,
+    0x07010077, 0x07010077, 0x07010077, 0x07010077, 0x07010077, 0x07010077,
+    0x07010077, 0x07010077, 0x07010077, 0x07010077, 0x07010078, 0x07010078,
+    0x07010078, 0x07010078, 0x07010078, 0x07010078, 0x07010078, 0x07010078,
+    0x07010078, 0x07010078, 0x07010078, 0x07010078, 0x07010078, 0x07010078,
+    0x07010078, 0x07010078, 0x07010079, 0x07010079, 0x07010079, 0x07010079,
+    0x07010079, 0x07010079, 0x07010079, 0x07010079, 0x07010079, 0x07010079,
+    0x07010079, 0x07010079, 0x07010079, 0x07010079, 0x07010079, 0x07010079,
+    0x0701007a, 0x0701007a, 0x0701007a, 0x0701007a, 0x0701007a, 0x0701007a,
+    0x0701007a, 0x0701007a, 0x0701007a, 0x0701007a, 0x0701007a, 0x0701007a,
+    0x0701007a, 0x0701007a, 0x0701007a, 0x0701007a, 0x08010026, 0x08010026,
+    0x08010026, 0x08010026, 0x08010026, 0x08010026, 0x08010026, 0x08010026,
+    0x0801002a, 0x0801002a, 0x0801002a, 0x0801002a, 0x0801002a, 0x0801002a,
+    0x0801002a, 0x0801002a, 0x0801002c, 0x0801002c, 0x0801002c, 0x0801002c,
+    0x0801002c, 0x0801002c, 0x0801002c, 0x0801002c, 0x0801003b, 0x0801003b,
+    0x0801003b, 0x0801003b, 0x0801003b, 0x0801003b, 0x0801003b, 0x0801003b,
+    0x08010058, 0x08010058, 0x08010058, 0x08010058, 0x08010058, 0x08010058,
+    0x08010058, 0x08010058, 0x0801005a, 0x0801005a, 0x0801005a, 0x0801005a,
+    0x0801005a, 0x0801005a, 0x0801005a, 0x0801005a, 0x0a010021, 0x0a010021,
+    0x0a010022, 0x0a010022, 0x0a010028, 0x0a010028, 0x0a010029, 0x0a010029,
+    0x0a01003f, 0x0a01003f, 0x0b010027, 0x0b01002b, 0x0b01007c, 0x00000000,
+    0x00000000, 0x00000000,
+};
+
+/* returns the symbol whose code starts \a bits (most significant bit first),
+   or -1 if no code of at most \a max_length bits does */
+static int huff_match(uint64_t bits, int max_length, int* length) {
+  for (int n = 1; n <= max_length; n++) {
+    const uint64_t code = bits >> (64 - n);
+    if (code - huff_first_code[n] < huff_num_codes[n]) {
+      *length = n;
+      return huff_sorted_syms[huff_first_sym[n] + code - huff_first_code[n]];
+    }
+  }
+  return -1;
+}
+
 static const uint8_t inverse_base64[256] = {
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
@@ -677,14 +718,29 @@ static grpc_core::UnmanagedMemorySlice take_string_extern(
 static grpc_core::ManagedMemorySlice take_string_intern(
     grpc_chttp2_hpack_parser* /*p*/, grpc_chttp2_hpack_parser_string* str) {
   grpc_core::ManagedMemorySlice s;
+  // Most of what gets interned are the well known gRPC keys and values: look
+  // them up in the static table straight from their bytes
+  const intptr_t static_idx =
+      str->copied
+          ? grpc_static_slice_index_for_bytes(str->data.copied.str,
+                                              str->data.copied.length)
+          : grpc_static_slice_index_for_bytes(
+                reinterpret_cast<const char*>(
+                    GRPC_SLICE_START_PTR(str->data.referenced)),
+                GRPC_SLICE_LENGTH(str->data.referenced));
+  if (static_idx >= 0) {
+    GRPC_STATS_INC_HPACK_RECV_STATIC_STRING();
+    s = grpc_static_slice_table()[static_idx];
+  } else {
+    GRPC_STATS_INC_HPACK_RECV_INTERNED_STRING();
+    s = str->copied ? grpc_core::ManagedMemorySlice(str->data.copied.str,
+                                                    str->data.copied.length)
+                    : grpc_core::ManagedMemorySlice(&str->data.referenced);
+  }
   if (!str->copied) {
-    s = grpc_core::ManagedMemorySlice(&str->data.referenced);
     grpc_slice_unref_internal(str->data.referenced);
     str->copied = true;
     str->data.referenced = grpc_empty_slice();
-  } else {
-    s = grpc_core::ManagedMemorySlice(str->data.copied.str,
-                                      str->data.copied.length);
   }
   str->data.copied.length = 0;
   return s;
@@ -1370,11 +1426,94 @@ static grpc_error* append_string(grpc_chttp2_hpack_parser* p,
       GRPC_ERROR_CREATE_FROM_STATIC_STRING("Should never reach here")));
 }
 
+/* decode full bytes from a huffman encoded stream: the bits that do not make
+   up a whole code yet are kept in p->huff_bits, most significant first, until
+   more bytes or the end of the string (finish_huff) arrive */
+static grpc_error* add_huff_bytes(grpc_chttp2_hpack_parser* p,
+                                  const uint8_t* cur, const uint8_t* end) {
+  uint64_t bits = p->huff_bits;
+  int count = p->huff_bit_count;
+  uint8_t decoded[256];
+  size_t num_decoded = 0;
+  for (;;) {
+    while (count <= 56 && cur != end) {
+      bits |= static_cast<uint64_t>(*cur++) << (56 - count);
+      count += 8;
+    }
+    /* with fewer bits, the next code may not be complete yet */
+    if (count < HUFF_MAX_CODE_LENGTH) break;
+    while (count >= HUFF_MAX_CODE_LENGTH &&
+           num_decoded <= sizeof(decoded) - 2) {
+      const uint32_t e = huff_lookup[bits >> (64 - HUFF_LOOKUP_BITS)];
+      int length;
+      if (GPR_LIKELY(e & 0xff0000)) {
+        decoded[num_decoded] = static_cast<uint8_t>(e);
+        decoded[num_decoded + 1] = static_cast<uint8_t>(e >> 8);
+        num_decoded += (e >> 16) & 0xff;
+        length = static_cast<int>(e >> 24);
+      } else {
+        int sym = huff_match(bits, HUFF_MAX_CODE_LENGTH, &length);
+        if (sym < 0 || sym == HUFF_EOS) {
+          return parse_error(p, cur, end,
+                             GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                 "EOS in huffman encoded string"));
+        }
+        decoded[num_decoded++] = static_cast<uint8_t>(sym);
+      }
+      bits <<= length;
+      count -= length;
+    }
+    if (num_decoded > sizeof(decoded) - 2) {
+      grpc_error* err = append_string(p, decoded, decoded + num_decoded);
+      if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
+      num_decoded = 0;
+    }
+  }
+  p->huff_bits = bits;
+  p->huff_bit_count = static_cast<uint8_t>(count);
+  return append_string(p, decoded, decoded + num_decoded);
+}
+
+/* decode the codes left at the end of a huffman encoded string: what remains
+   after them is padding */
+static grpc_error* finish_huff(grpc_chttp2_hpack_parser* p) {
+  /* padding is made of ones, as is the start of the EOS code, so that the
+     remaining bits can be extended with ones without completing a code */
+  int count = p->huff_bit_count;
+  uint64_t bits = p->huff_bits | (~static_cast<uint64_t>(0) >> count);
+  uint8_t decoded[HUFF_MAX_CODE_LENGTH / 5 + 1];
+  size_t num_decoded = 0;
+  while (count > 0) {
+    const uint32_t e = huff_lookup[bits >> (64 - HUFF_LOOKUP_BITS)];
+    const int length = static_cast<int>(e >> 24);
+    if (!(e & 0xff0000) || length > count) break;
+    decoded[num_decoded] = static_cast<uint8_t>(e);
+    decoded[num_decoded + 1] = static_cast<uint8_t>(e >> 8);
+    num_decoded += (e >> 16) & 0xff;
+    bits <<= length;
+    count -= length;
+  }
+  int length;
+  int sym;
+  while ((sym = huff_match(bits, count, &length)) >= 0) {
+    decoded[num_decoded++] = static_cast<uint8_t>(sym);
+    bits <<= length;
+    count -= length;
+  }
+  p->huff_bits = 0;
+  p->huff_bit_count = 0;
+  return append_string(p, decoded, decoded + num_decoded);
+}
+
 static grpc_error* finish_str(grpc_chttp2_hpack_parser* p, const uint8_t* cur,
                               const uint8_t* end) {
   uint8_t decoded[2];
   uint32_t bits;
   grpc_chttp2_hpack_parser_string* str = p->parsing.str;
+  if (p->huff) {
+    grpc_error* err = finish_huff(p);
+    if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
+  }
   switch (static_cast<binary_state>(p->binary)) {
     case NOT_BINARY:
       break;
@@ -1417,35 +1556,6 @@ static grpc_error* finish_str(grpc_chttp2_hpack_parser* p, const uint8_t* cur,
   return GRPC_ERROR_NONE;
 }
 
-/* decode a nibble from a huffman encoded stream */
-static grpc_error* huff_nibble(grpc_chttp2_hpack_parser* p, uint8_t nibble) {
-  int16_t emit = emit_sub_tbl[16 * emit_tbl[p->huff_state] + nibble];
-  int16_t next = next_sub_tbl[16 * next_tbl[p->huff_state] + nibble];
-  if (emit != -1) {
-    if (emit >= 0 && emit < 256) {
-      uint8_t c = static_cast<uint8_t>(emit);
-      grpc_error* err = append_string(p, &c, (&c) + 1);
-      if (err != GRPC_ERROR_NONE) return err;
-    } else {
-      assert(emit == 256);
-    }
-  }
-  p->huff_state = next;
-  return GRPC_ERROR_NONE;
-}
-
-/* decode full bytes from a huffman encoded stream */
-static grpc_error* add_huff_bytes(grpc_chttp2_hpack_parser* p,
-                                  const uint8_t* cur, const uint8_t* end) {
-  for (; cur != end; ++cur) {
-    grpc_error* err = huff_nibble(p, *cur >> 4);
-    if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
-    err = huff_nibble(p, *cur & 0xf);
-    if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
-  }
-  return GRPC_ERROR_NONE;
-}
-
 /* decode some string bytes based on the current decoding mode
    (huffman or not) */
 static grpc_error* add_str_bytes(grpc_chttp2_hpack_parser* p,
@@ -1491,6 +1601,8 @@ static grpc_error* begin_parse_string(grpc_chttp2_hpack_parser* p,
     str->data.referenced.refcount = p->current_slice_refcount;
     str->data.referenced.data.refcounted.bytes = const_cast<uint8_t*>(cur);
     str->data.referenced.data.refcounted.length = p->strlen;
+    // Referenced strings can end up in metadata handed to the application.
+    grpc_slice_publish(str->data.referenced);
     grpc_slice_ref_internal(str->data.referenced);
     return parse_next(p, cur + p->strlen, end);
   }
@@ -1498,7 +1610,8 @@ static grpc_error* begin_parse_string(grpc_chttp2_hpack_parser* p,
   str->copied = true;
   str->data.copied.length = 0;
   p->parsing.str = str;
-  p->huff_state = 0;
+  p->huff_bits = 0;
+  p->huff_bit_count = 0;
   p->binary = binary;
   switch (p->binary) {
     case NOT_BINARY:
@@ -1636,6 +1749,20 @@ void grpc_chttp2_hpack_parser_set_has_priority(grpc_chttp2_hpack_parser* p) {
   p->state = parse_stream_dep0;
 }
 
+static size_t release_string_buffer(grpc_chttp2_hpack_parser_string* str) {
+  const size_t freed = str->data.copied.capacity;
+  gpr_free(str->data.copied.str);
+  str->data.copied.str = nullptr;
+  str->data.copied.capacity = 0;
+  str->data.copied.length = 0;
+  return freed;
+}
+
+size_t grpc_chttp2_hpack_parser_release_scratch(grpc_chttp2_hpack_parser* p) {
+  if (p->state != parse_begin) return 0;
+  return release_string_buffer(&p->key) + release_string_buffer(&p->value);
+}
+
 void grpc_chttp2_hpack_parser_destroy(grpc_chttp2_hpack_parser* p) {
   grpc_chttp2_hptbl_destroy(&p->table);
   GRPC_ERROR_UNREF(p->last_error);
@@ -81,8 +81,10 @@ struct grpc_chttp2_hpack_parser {
   uint32_t strlen;
   /* number of source bytes read for the currently parsing string */
   uint32_t strgot;
-  /* huffman decoding state */
-  int16_t huff_state;
+  /* huffman decoding state: the bits not decoded yet, most significant
+     first, and their number */
+  uint64_t huff_bits;
+  uint8_t huff_bit_count;
   /* is the string being decoded binary? */
   uint8_t binary;
   /* is the current string huffman encoded? */
@@ -104,6 +106,11 @@ void grpc_chttp2_hpack_parser_destroy(grpc_chttp2_hpack_parser* p);
 
 void grpc_chttp2_hpack_parser_set_has_priority(grpc_chttp2_hpack_parser* p);
 
+/* frees the buffers that header keys and values are copied into, if no
+   string is being parsed; they grow back on demand. Returns the number of
+   bytes freed. */
+size_t grpc_chttp2_hpack_parser_release_scratch(grpc_chttp2_hpack_parser* p);
+
 grpc_error* grpc_chttp2_hpack_parser_parse(grpc_chttp2_hpack_parser* p,
                                            const grpc_slice& slice);
 
@@ -135,17 +135,33 @@ grpc_error* grpc_chttp2_hptbl_set_current_table_size(grpc_chttp2_hptbl* tbl,
   }
   tbl->current_table_bytes = bytes;
   tbl->max_entries = grpc_chttp2_hptbl::entries_for_bytes(bytes);
-  if (tbl->max_entries > tbl->cap_entries) {
-    rebuild_ents(tbl, GPR_MAX(tbl->max_entries, 2 * tbl->cap_entries));
-  } else if (tbl->max_entries < tbl->cap_entries / 3) {
-    uint32_t new_cap = GPR_MAX(tbl->max_entries, 16u);
-    if (new_cap != tbl->cap_entries) {
+  /* growing is left to grpc_chttp2_hptbl_add */
+  if (tbl->max_entries < tbl->cap_entries / 3) {
+    uint32_t new_cap =
+        GPR_MAX(tbl->max_entries, grpc_chttp2_hptbl::kMinCapacity);
+    if (new_cap < tbl->cap_entries) {
       rebuild_ents(tbl, new_cap);
     }
   }
   return GRPC_ERROR_NONE;
 }
 
+size_t grpc_chttp2_hptbl_shrink_to_fit(grpc_chttp2_hptbl* tbl) {
+  const uint32_t old_cap = tbl->cap_entries;
+  if (tbl->num_ents == 0) {
+    gpr_free(tbl->ents);
+    tbl->ents = nullptr;
+    tbl->cap_entries = 0;
+    tbl->first_ent = 0;
+  } else {
+    const uint32_t new_cap =
+        GPR_MAX(tbl->num_ents, grpc_chttp2_hptbl::kMinCapacity);
+    if (new_cap >= old_cap) return 0;
+    rebuild_ents(tbl, new_cap);
+  }
+  return (old_cap - tbl->cap_entries) * sizeof(grpc_mdelem);
+}
+
 grpc_error* grpc_chttp2_hptbl_add(grpc_chttp2_hptbl* tbl, grpc_mdelem md) {
   /* determine how many bytes of buffer this entry represents */
   size_t elem_bytes = GRPC_SLICE_LENGTH(GRPC_MDKEY(md)) +
@@ -187,6 +203,14 @@ grpc_error* grpc_chttp2_hptbl_add(grpc_chttp2_hptbl* tbl, grpc_mdelem md) {
     evict1(tbl);
   }
 
+  /* grow the buffer on demand: connections that keep their headers in the
+     static table never allocate one */
+  if (tbl->num_ents == tbl->cap_entries) {
+    rebuild_ents(tbl, GPR_MIN(tbl->max_entries,
+                              GPR_MAX(grpc_chttp2_hptbl::kMinCapacity,
+                                      2 * tbl->cap_entries)));
+  }
+
   /* copy the finalized entry in */
   tbl->ents[(tbl->first_ent + tbl->num_ents) % tbl->cap_entries] =
       GRPC_MDELEM_REF(md);
@@ -56,13 +56,10 @@ struct grpc_chttp2_hptbl {
       (GRPC_CHTTP2_INITIAL_HPACK_TABLE_SIZE + GRPC_CHTTP2_HPACK_ENTRY_OVERHEAD -
        1) /
       GRPC_CHTTP2_HPACK_ENTRY_OVERHEAD;
-
-  grpc_chttp2_hptbl() {
-    GPR_DEBUG_ASSERT(!ents);
-    constexpr uint32_t AllocSize = sizeof(*ents) * kInitialCapacity;
-    ents = static_cast<grpc_mdelem*>(gpr_malloc(AllocSize));
-    memset(ents, 0, AllocSize);
-  }
+  /* Number of entries allocated by the first insertion. ents is not allocated
+     up front since many connections never use the dynamic table; it then
+     doubles as entries are added, up to max_entries. */
+  static constexpr uint32_t kMinCapacity = 16;
 
   /* the first used entry in ents */
   uint32_t first_ent = 0;
@@ -79,7 +76,7 @@ struct grpc_chttp2_hptbl {
      overheads */
   uint32_t max_entries = kInitialCapacity;
   /* Number of entries allocated in ents */
-  uint32_t cap_entries = kInitialCapacity;
+  uint32_t cap_entries = 0;
   /* a circular buffer of headers - this is stored in the opposite order to
      what hpack specifies, in order to simplify table management a little...
      meaning lookups need to SUBTRACT from the end position */
@@ -91,6 +88,9 @@ void grpc_chttp2_hptbl_set_max_bytes(grpc_chttp2_hptbl* tbl,
                                      uint32_t max_bytes);
 grpc_error* grpc_chttp2_hptbl_set_current_table_size(grpc_chttp2_hptbl* tbl,
                                                      uint32_t bytes);
+/* Trim ents to the entries it holds, or free it if there are none; it grows
+   again on demand. Returns the number of bytes freed. */
+size_t grpc_chttp2_hptbl_shrink_to_fit(grpc_chttp2_hptbl* tbl);
 
 /* lookup a table entry based on its hpack index */
 grpc_mdelem grpc_chttp2_hptbl_lookup_dynamic_index(const grpc_chttp2_hptbl* tbl,
@@ -35,10 +35,13 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
+#include "src/core/ext/transport/chttp2/transport/keepalive_scheduler.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/compression/stream_compression.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/timer.h"
@@ -306,6 +309,9 @@ struct grpc_chttp2_transport {
 
   /** write execution state of the transport */
   grpc_chttp2_write_state write_state = GRPC_CHTTP2_WRITE_STATE_IDLE;
+  /** when the write in flight, and the one to follow it, were asked for */
+  gpr_cycle_counter write_initiated_at = 0;
+  gpr_cycle_counter next_write_initiated_at = 0;
 
   /** is the transport destroying itself? */
   uint8_t destroying = false;
@@ -411,6 +417,9 @@ struct grpc_chttp2_transport {
       grpc_core::chttp2::TransportFlowControl,
       grpc_core::chttp2::TransportFlowControlDisabled>
       flow_control;
+  /** is the max frame size following the sizes of received messages? Also
+      limits DATA frames sent while other streams are waiting to write */
+  bool adaptive_max_frame_size = false;
   /** initial window change. This is tracked as we parse settings frames from
    * the remote peer. If there is a positive delta, then we will make all
    * streams readable since they may have become unstalled */
@@ -456,6 +465,19 @@ struct grpc_chttp2_transport {
   grpc_closure benign_reclaimer_locked;
   /** destructive cleanup closure */
   grpc_closure destructive_reclaimer_locked;
+  /** size the hpack decoder table is capped to by benign reclamation, or -1
+      to leave it alone */
+  int32_t hpack_decoder_table_size_under_pressure = -1;
+
+  /* idle compaction */
+  /** how long the transport must go without streams before its buffers are
+      compacted, or 0 to never compact them */
+  grpc_millis idle_compaction_ms = 0;
+  /** when the stream map last became empty */
+  grpc_millis idle_since = GRPC_MILLIS_INF_PAST;
+  bool have_idle_compaction_timer = false;
+  grpc_timer idle_compaction_timer;
+  grpc_closure idle_compaction_locked;
 
   /* next bdp ping timer */
   bool have_next_bdp_ping_timer = false;
@@ -472,8 +494,8 @@ struct grpc_chttp2_transport {
   grpc_closure finish_keepalive_ping_locked;
   /** Closrue to run when the keepalive ping timeouts */
   grpc_closure keepalive_watchdog_fired_locked;
-  /** timer to initiate ping events */
-  grpc_timer keepalive_ping_timer;
+  /** timer to initiate ping events, shared with other transports */
+  grpc_core::KeepaliveScheduler::Timer keepalive_ping_timer;
   /** watchdog to kill the transport when waiting for the keepalive ping */
   grpc_timer keepalive_watchdog_timer;
   /** time duration in between pings */
@@ -482,12 +504,23 @@ struct grpc_chttp2_transport {
   grpc_millis keepalive_timeout;
   /** if keepalive pings are allowed when there's no outstanding streams */
   bool keepalive_permit_without_calls = false;
+  /** if keepalive_time grows on connections whose pings keep being acked */
+  bool keepalive_adaptive = false;
+  /** the most keepalive_time may grow to */
+  grpc_millis keepalive_max_time = GRPC_MILLIS_INF_FUTURE;
+  /** keepalive pings acked since keepalive_time last grew */
+  uint32_t keepalive_acks_since_growth = 0;
   /** If start_keepalive_ping_locked has been called */
   bool keepalive_ping_started = false;
   /** keep-alive state machine state */
   grpc_chttp2_keepalive_state keepalive_state;
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
+  /** where to publish how many more streams we can start before the peer's
+      MAX_CONCURRENT_STREAMS holds them back; set by the subchannel */
+  grpc_core::RefCountedPtr<grpc_core::StreamHeadroom> stream_headroom;
+  /** length of the waiting_for_concurrency stream list */
+  size_t num_waiting_for_concurrency = 0;
   uint32_t num_messages_in_next_write = 0;
   /** The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
    * RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
@@ -496,6 +529,26 @@ struct grpc_chttp2_transport {
    * thereby reducing the number of induced frames. */
   uint32_t num_pending_induced_frames = 0;
   bool reading_paused_on_pending_induced_frames = false;
+  /** Streams with no message bigger than this complete their operations on
+   * the ExecCtx latency lane. 0 keeps everything on the bulk lane. */
+  uint32_t latency_lane_max_message_bytes = 0;
+
+  /* write coalescing */
+  /** If non-zero, how long a small write may be held back on a busy
+   * connection, to gather the frames of the streams becoming writable
+   * meanwhile into the same endpoint write */
+  grpc_millis write_coalesce_delay = 0;
+  /** Writes of at least this many bytes are not held back */
+  uint32_t write_coalesce_bytes = 16384;
+  /** When the last write was handed to the endpoint */
+  grpc_millis last_write_time = 0;
+  /** Is a gathered write being held back? */
+  bool write_coalescing = false;
+  /** Has gathering more frames into the held write been scheduled? */
+  bool write_coalesce_regather_scheduled = false;
+  grpc_timer write_coalesce_timer;
+  grpc_closure write_coalesce_timer_fired_locked;
+  grpc_closure write_coalesce_regather_locked;
 };
 
 typedef enum {
@@ -543,6 +596,10 @@ struct grpc_chttp2_stream {
   int64_t flow_controlled_bytes_flowed = 0;
   grpc_closure complete_fetch_locked;
   grpc_closure* fetching_send_message_finished = nullptr;
+  /** Set while fetching_send_message is left unpulled because the bytes
+      already in flow_controlled_buffer cover the peer's flow control window;
+      writing resumes the fetch once some of them are sent */
+  bool fetching_send_message_paused = false;
 
   grpc_metadata_batch* recv_initial_metadata;
   grpc_closure* recv_initial_metadata_ready = nullptr;
@@ -564,6 +621,9 @@ struct grpc_chttp2_stream {
   /** Has this stream seen an error.
       If true, then pending incoming frames can be thrown away. */
   bool seen_error = false;
+  /** Which headers of a plain gRPC request have been received so far, on the
+      server (see classify_request_header() in parsing.cc) */
+  uint8_t request_headers_seen = 0;
   /** Are we buffering writes on this stream? If yes, we won't become writable
       until there's enough queued up in the flow_controlled_buffer */
   bool write_buffering = false;
@@ -571,6 +631,10 @@ struct grpc_chttp2_stream {
   /* have we sent or received the EOS bit? */
   bool eos_received = false;
   bool eos_sent = false;
+  /** Complete operations on the ExecCtx latency lane? Cleared for good once
+      the stream carries a message bigger than
+      t->latency_lane_max_message_bytes. */
+  bool latency_lane = false;
 
   /** the error that resulted in this stream being read-closed */
   grpc_error* read_closed_error = GRPC_ERROR_NONE;
@@ -641,6 +705,12 @@ struct grpc_chttp2_stream {
   bool unprocessed_incoming_frames_decompressed = false;
   /** Whether the bytes needs to be traced using Fathom */
   bool traced = false;
+  /** Where to record the timestamps of traced writes, if the call asked for
+   * them (GRPC_CONTEXT_WRITE_TIMESTAMPS) */
+  grpc_core::RefCountedPtr<grpc_core::CallWriteTimestamps> write_timestamps;
+  /** Number of frames the stream may write each time its turn comes in the
+   * writable list (GRPC_CONTEXT_WRITE_WEIGHT) */
+  uint32_t write_weight = 1;
   /** gRPC header bytes that are already decompressed */
   size_t decompressed_header_bytes = 0;
   /** Byte counter for number of bytes written */
@@ -769,6 +839,9 @@ void grpc_chttp2_complete_closure_step(grpc_chttp2_transport* t,
 #define GRPC_HEADER_SIZE_IN_BYTES 5
 #define MAX_SIZE_T (~(size_t)0)
 
+/* Bound on grpc_chttp2_stream::write_weight */
+#define GRPC_CHTTP2_MAX_WRITE_WEIGHT 256
+
 #define GRPC_CHTTP2_CLIENT_CONNECT_STRING "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
 #define GRPC_CHTTP2_CLIENT_CONNECT_STRLEN \
   (sizeof(GRPC_CHTTP2_CLIENT_CONNECT_STRING) - 1)
@@ -848,6 +921,16 @@ void grpc_chttp2_add_ping_strike(grpc_chttp2_transport* t);
 void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
                                       grpc_chttp2_stream* s);
 
+/** called by writing after sending some of flow_controlled_buffer: if the
+    stream's send_message fetch was paused for flow control, continue it */
+void grpc_chttp2_maybe_resume_fetching_send(grpc_chttp2_transport* t,
+                                            grpc_chttp2_stream* s);
+
+/** republish the stream headroom (and channelz queue length) after any change
+    to the active stream count, the waiting_for_concurrency list or the peer's
+    MAX_CONCURRENT_STREAMS */
+void grpc_chttp2_update_stream_headroom(grpc_chttp2_transport* t);
+
 void grpc_chttp2_cancel_stream(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
                                grpc_error* due_to_error);
 
@@ -0,0 +1,176 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/keepalive_scheduler.h"
+
+#include <map>
+#include <string>
+
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/timer.h"
+
+namespace grpc_core {
+
+class KeepaliveScheduler::Bucket {
+ public:
+  explicit Bucket(grpc_millis deadline) : deadline_(deadline) {
+    GRPC_CLOSURE_INIT(&on_timer_, OnBucketTimer, this,
+                      grpc_schedule_on_exec_ctx);
+  }
+
+ private:
+  friend class KeepaliveScheduler;
+
+  const grpc_millis deadline_;
+  grpc_timer timer_;
+  grpc_closure on_timer_;
+  Timer* timers_ = nullptr;
+};
+
+namespace {
+
+/* The scheduler lives as long as the process: bucket timers may still fire
+   while grpc shuts down. */
+gpr_once g_once = GPR_ONCE_INIT;
+gpr_mu g_mu;
+std::map<grpc_millis, KeepaliveScheduler::Bucket*>* g_buckets;
+/* Peers are forgotten in no particular order past this many. */
+#define MAX_PEER_INTERVAL_FLOORS 1024
+std::map<std::string, grpc_millis>* g_peer_interval_floors;
+
+void init_scheduler() {
+  gpr_mu_init(&g_mu);
+  g_buckets = new std::map<grpc_millis, KeepaliveScheduler::Bucket*>();
+  g_peer_interval_floors = new std::map<std::string, grpc_millis>();
+}
+
+grpc_millis round_up(grpc_millis deadline, grpc_millis slack) {
+  if (slack <= 1) return deadline;
+  return (deadline + slack - 1) / slack * slack;
+}
+
+}  // namespace
+
+void KeepaliveScheduler::Schedule(Timer* timer, grpc_millis interval,
+                                  grpc_millis slack, grpc_closure* on_due) {
+  gpr_once_init(&g_once, init_scheduler);
+  const grpc_millis now = ExecCtx::Get()->Now();
+  timer->last_activity_.Store(now, MemoryOrder::RELAXED);
+  timer->interval_ = interval;
+  timer->slack_ = slack;
+  timer->on_due_ = on_due;
+  MutexLock lock(&g_mu);
+  GPR_ASSERT(timer->bucket_ == nullptr);
+  AddLocked(timer, now + interval);
+}
+
+void KeepaliveScheduler::Cancel(Timer* timer) {
+  gpr_once_init(&g_once, init_scheduler);
+  {
+    MutexLock lock(&g_mu);
+    Bucket* bucket = timer->bucket_;
+    if (bucket == nullptr) return;
+    if (timer->prev_ != nullptr) {
+      timer->prev_->next_ = timer->next_;
+    } else {
+      bucket->timers_ = timer->next_;
+    }
+    if (timer->next_ != nullptr) timer->next_->prev_ = timer->prev_;
+    timer->bucket_ = nullptr;
+    if (bucket->timers_ == nullptr) {
+      /* OnBucketTimer() frees the bucket once it is out of the map. */
+      g_buckets->erase(bucket->deadline_);
+      grpc_timer_cancel(&bucket->timer_);
+    }
+  }
+  ExecCtx::Run(DEBUG_LOCATION, timer->on_due_, GRPC_ERROR_CANCELLED);
+}
+
+grpc_millis KeepaliveScheduler::PeerIntervalFloor(const char* peer) {
+  gpr_once_init(&g_once, init_scheduler);
+  MutexLock lock(&g_mu);
+  auto it = g_peer_interval_floors->find(peer);
+  return it == g_peer_interval_floors->end() ? 0 : it->second;
+}
+
+void KeepaliveScheduler::RaisePeerIntervalFloor(const char* peer,
+                                                grpc_millis interval) {
+  gpr_once_init(&g_once, init_scheduler);
+  MutexLock lock(&g_mu);
+  auto it = g_peer_interval_floors->find(peer);
+  if (it != g_peer_interval_floors->end()) {
+    if (it->second < interval) it->second = interval;
+    return;
+  }
+  if (g_peer_interval_floors->size() >= MAX_PEER_INTERVAL_FLOORS) {
+    g_peer_interval_floors->erase(g_peer_interval_floors->begin());
+  }
+  g_peer_interval_floors->emplace(peer, interval);
+}
+
+void KeepaliveScheduler::AddLocked(Timer* timer, grpc_millis deadline) {
+  const grpc_millis bucket_deadline = round_up(deadline, timer->slack_);
+  Bucket*& bucket = (*g_buckets)[bucket_deadline];
+  if (bucket == nullptr) {
+    bucket = new Bucket(bucket_deadline);
+    grpc_timer_init(&bucket->timer_, bucket_deadline, &bucket->on_timer_);
+  }
+  timer->bucket_ = bucket;
+  timer->prev_ = nullptr;
+  timer->next_ = bucket->timers_;
+  if (bucket->timers_ != nullptr) bucket->timers_->prev_ = timer;
+  bucket->timers_ = timer;
+}
+
+void KeepaliveScheduler::OnBucketTimer(void* arg, grpc_error* error) {
+  Bucket* bucket = static_cast<Bucket*>(arg);
+  Timer* due = nullptr;
+  {
+    MutexLock lock(&g_mu);
+    auto it = g_buckets->find(bucket->deadline_);
+    if (it != g_buckets->end() && it->second == bucket) g_buckets->erase(it);
+    Timer* timer = bucket->timers_;
+    while (timer != nullptr) {
+      Timer* next = timer->next_;
+      timer->bucket_ = nullptr;
+      const grpc_millis deadline =
+          timer->last_activity_.Load(MemoryOrder::RELAXED) + timer->interval_;
+      if (error == GRPC_ERROR_NONE &&
+          round_up(deadline, timer->slack_) > bucket->deadline_) {
+        /* Active since it was scheduled: wait for a later bucket. */
+        AddLocked(timer, deadline);
+      } else {
+        timer->next_ = due;
+        due = timer;
+      }
+      timer = next;
+    }
+  }
+  while (due != nullptr) {
+    Timer* next = due->next_;
+    ExecCtx::Run(DEBUG_LOCATION, due->on_due_, GRPC_ERROR_REF(error));
+    due = next;
+  }
+  delete bucket;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULER_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+/** Process-wide scheduler for the keepalive pings of chttp2 transports.
+ *
+ * Transports due at about the same time share a bucket, and each bucket has a
+ * single timer. Activity on a transport is only recorded: nothing is
+ * cancelled or rescheduled on the read path. When a bucket fires, transports
+ * that were active since they were scheduled move to a later bucket, and the
+ * others run their keepalive closure. */
+class KeepaliveScheduler {
+ public:
+  class Bucket;
+
+  /** The keepalive timer of one transport, which owns it. It must outlive any
+   * pending Schedule(). */
+  class Timer {
+   public:
+    /** Pushes the due time back to \a interval after now. Lock free, so that
+     * it may be called on every read. */
+    void RecordActivity() {
+      last_activity_.Store(ExecCtx::Get()->Now(), MemoryOrder::RELAXED);
+    }
+
+   private:
+    friend class KeepaliveScheduler;
+
+    Atomic<grpc_millis> last_activity_{0};
+    grpc_millis interval_ = 0;
+    grpc_millis slack_ = 0;
+    grpc_closure* on_due_ = nullptr;
+    /* Guarded by the scheduler's lock. Null when not scheduled. */
+    Bucket* bucket_ = nullptr;
+    Timer* prev_ = nullptr;
+    Timer* next_ = nullptr;
+  };
+
+  /** Runs \a on_due with GRPC_ERROR_NONE once \a timer has seen no activity
+   * for \a interval, at most \a slack late. */
+  static void Schedule(Timer* timer, grpc_millis interval, grpc_millis slack,
+                       grpc_closure* on_due);
+
+  /** If \a timer is scheduled, unschedules it and runs its closure with
+   * GRPC_ERROR_CANCELLED. */
+  static void Cancel(Timer* timer);
+
+  /** The keepalive interval connections to \a peer should use at least,
+   * because it closed an earlier connection for pinging more often, or 0 if
+   * it never did. Remembered for the life of the process, for a bounded
+   * number of peers. */
+  static grpc_millis PeerIntervalFloor(const char* peer);
+
+  /** Records that connections to \a peer should ping no more often than
+   * every \a interval. Lower intervals than one already recorded are
+   * ignored. */
+  static void RaisePeerIntervalFloor(const char* peer, grpc_millis interval);
+
+ private:
+  static void AddLocked(Timer* timer, grpc_millis deadline);
+  static void OnBucketTimer(void* arg, grpc_error* error);
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_KEEPALIVE_SCHEDULER_H */
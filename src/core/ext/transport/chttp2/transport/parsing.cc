@@ -26,6 +26,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/slice/slice_utils.h"
@@ -109,6 +110,20 @@ grpc_error* grpc_chttp2_perform_read(grpc_chttp2_transport* t,
     dts_fh_0:
     case GRPC_DTS_FH_0:
       GPR_DEBUG_ASSERT(cur < end);
+      if (static_cast<size_t>(end - cur) >= GRPC_CHTTP2_FRAME_HEADER_SIZE) {
+        /* the whole frame header is in this slice: decode it in one go
+           rather than stopping after each byte to check for the end */
+        t->incoming_frame_size = (static_cast<uint32_t>(cur[0]) << 16) |
+                                 (static_cast<uint32_t>(cur[1]) << 8) |
+                                 static_cast<uint32_t>(cur[2]);
+        t->incoming_frame_type = cur[3];
+        t->incoming_frame_flags = cur[4];
+        t->incoming_stream_id = ((static_cast<uint32_t>(cur[5]) & 0x7f) << 24) |
+                                (static_cast<uint32_t>(cur[6]) << 16) |
+                                (static_cast<uint32_t>(cur[7]) << 8);
+        cur += GRPC_CHTTP2_FRAME_HEADER_SIZE - 1;
+        goto dts_fh_8;
+      }
       t->incoming_frame_size = (static_cast<uint32_t>(*cur)) << 16;
       if (++cur == end) {
         t->deframe_state = GRPC_DTS_FH_1;
@@ -171,6 +186,7 @@ grpc_error* grpc_chttp2_perform_read(grpc_chttp2_transport* t,
         return GRPC_ERROR_NONE;
       }
     /* fallthrough */
+    dts_fh_8:
     case GRPC_DTS_FH_8:
       GPR_DEBUG_ASSERT(cur < end);
       t->incoming_stream_id |= (static_cast<uint32_t>(*cur));
@@ -374,6 +390,7 @@ static grpc_error* init_data_frame_parser(grpc_chttp2_transport* t) {
 error_handler:
   intptr_t unused;
   if (err == GRPC_ERROR_NONE) {
+    GRPC_STATS_INC_HTTP2_RECV_DATA_FRAMES();
     t->incoming_stream = s;
     /* t->parser = grpc_chttp2_data_parser_parse;*/
     t->parser = grpc_chttp2_data_parser_parse;
@@ -492,6 +509,37 @@ handle_metadata_add_failure(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
   return GRPC_ERROR_NONE;
 }
 
+/* Headers that make up a plain gRPC request. The server http filter does not
+   need to look at them again once all are seen. */
+#define REQUEST_HEADER_METHOD 1
+#define REQUEST_HEADER_SCHEME 2
+#define REQUEST_HEADER_TE 4
+#define REQUEST_HEADER_CONTENT_TYPE 8
+#define REQUEST_HEADERS_ALL 15
+
+/* The hpack parser hands out the static mdelems for these headers whenever
+   their values match, so a pointer comparison suffices. A header that is
+   sent twice fails to link into the batch, so each is seen at most once. */
+static void classify_request_header(grpc_chttp2_stream* s,
+                                    uintptr_t payload) {
+  if (payload == GRPC_MDELEM_METHOD_POST.payload) {
+    s->request_headers_seen |= REQUEST_HEADER_METHOD;
+  } else if (payload == GRPC_MDELEM_SCHEME_HTTP.payload ||
+             payload == GRPC_MDELEM_SCHEME_HTTPS.payload) {
+    s->request_headers_seen |= REQUEST_HEADER_SCHEME;
+  } else if (payload == GRPC_MDELEM_TE_TRAILERS.payload) {
+    s->request_headers_seen |= REQUEST_HEADER_TE;
+  } else if (payload ==
+             GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC.payload) {
+    s->request_headers_seen |= REQUEST_HEADER_CONTENT_TYPE;
+  } else {
+    return;
+  }
+  if (s->request_headers_seen == REQUEST_HEADERS_ALL) {
+    s->metadata_buffer[0].batch.checked_grpc_post = true;
+  }
+}
+
 static grpc_error* on_initial_header(void* tp, grpc_mdelem md) {
   GPR_TIMER_SCOPE("on_initial_header", 0);
 
@@ -517,11 +565,16 @@ static grpc_error* on_initial_header(void* tp, grpc_mdelem md) {
     return handle_metadata_size_limit_exceeded(t, s, md, new_size,
                                                metadata_size_limit);
   } else {
+    const bool is_request_header =
+        !t->is_client &&
+        GRPC_MDELEM_STORAGE(md) == GRPC_MDELEM_STORAGE_STATIC;
+    const uintptr_t payload = md.payload;
     grpc_error* error =
         grpc_chttp2_incoming_metadata_buffer_add(&s->metadata_buffer[0], md);
     if (GPR_UNLIKELY(error != GRPC_ERROR_NONE)) {
       return handle_metadata_add_failure(t, s, md, error);
     }
+    if (is_request_header) classify_request_header(s, payload);
   }
   // Not timeout-related metadata, and no error occurred.
   return GRPC_ERROR_NONE;
@@ -170,17 +170,26 @@ bool grpc_chttp2_list_pop_writing_stream(grpc_chttp2_transport* t,
 
 void grpc_chttp2_list_add_waiting_for_concurrency(grpc_chttp2_transport* t,
                                                   grpc_chttp2_stream* s) {
-  stream_list_add(t, s, GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY);
+  if (stream_list_add(t, s, GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY)) {
+    t->num_waiting_for_concurrency++;
+  }
 }
 
 bool grpc_chttp2_list_pop_waiting_for_concurrency(grpc_chttp2_transport* t,
                                                   grpc_chttp2_stream** s) {
-  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY);
+  if (!stream_list_pop(t, s, GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY)) {
+    return false;
+  }
+  t->num_waiting_for_concurrency--;
+  return true;
 }
 
 void grpc_chttp2_list_remove_waiting_for_concurrency(grpc_chttp2_transport* t,
                                                      grpc_chttp2_stream* s) {
-  stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY);
+  if (stream_list_maybe_remove(t, s,
+                               GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY)) {
+    t->num_waiting_for_concurrency--;
+  }
 }
 
 void grpc_chttp2_list_add_stalled_by_transport(grpc_chttp2_transport* t,
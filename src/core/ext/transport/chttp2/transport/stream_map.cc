@@ -25,16 +25,34 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+/* Stream ids are sequential odd (or even) numbers and may be picked by the
+   peer: spread them over the slots with a multiplicative hash, keeping its
+   high bits */
+static size_t slot_for(uint32_t key, size_t capacity) {
+  const uint32_t h = key * 2654435761u;
+  return static_cast<size_t>((static_cast<uint64_t>(h) * capacity) >> 32);
+}
+
+static void alloc_slots(grpc_chttp2_stream_map* map, size_t capacity) {
+  map->keys = static_cast<uint32_t*>(gpr_zalloc(sizeof(uint32_t) * capacity));
+  map->values = static_cast<void**>(gpr_malloc(sizeof(void*) * capacity));
+  map->capacity = capacity;
+}
+
+static size_t round_capacity(size_t capacity) {
+  GPR_DEBUG_ASSERT(capacity > 1);
+  size_t rounded = 2;
+  while (rounded < capacity) {
+    rounded *= 2;
+  }
+  return rounded;
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
-  GPR_DEBUG_ASSERT(initial_capacity > 1);
-  map->keys =
-      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
-  map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
+  alloc_slots(map, round_capacity(initial_capacity));
   map->count = 0;
   map->free = 0;
-  map->capacity = initial_capacity;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
@@ -42,125 +60,130 @@ void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
   gpr_free(map->values);
 }
 
-static size_t compact(uint32_t* keys, void** values, size_t count) {
-  size_t i, out;
+/* insert a key that is not in the table into the first empty or deleted slot
+   of its probe sequence; returns true if that slot was a deleted one */
+static bool insert(uint32_t* keys, void** values, size_t capacity,
+                   uint32_t key, void* value) {
+  size_t i = slot_for(key, capacity);
+  while (keys[i] != 0 && values[i] != nullptr) {
+    i = (i + 1) & (capacity - 1);
+  }
+  const bool reused = keys[i] != 0;
+  keys[i] = key;
+  values[i] = value;
+  return reused;
+}
 
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
+/* move the populated entries to a table of new_capacity slots, dropping the
+   deleted ones */
+static void rehash(grpc_chttp2_stream_map* map, size_t new_capacity) {
+  uint32_t* keys = map->keys;
+  void** values = map->values;
+  const size_t capacity = map->capacity;
+  alloc_slots(map, new_capacity);
+  for (size_t i = 0; i < capacity; i++) {
+    if (keys[i] != 0 && values[i] != nullptr) {
+      insert(map->keys, map->values, new_capacity, keys[i], values[i]);
     }
   }
-
-  return out;
+  map->free = 0;
+  gpr_free(keys);
+  gpr_free(values);
 }
 
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
-  // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  GPR_ASSERT(key != 0);
   GPR_DEBUG_ASSERT(value);
-  // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
 
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
-    } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
-    }
+  /* keep at least half of the slots empty, to keep probe sequences short */
+  if (2 * (map->count + map->free + 1) > map->capacity) {
+    /* grow when more than 3/8 of the slots are populated, otherwise
+       reclaiming the deleted slots will do */
+    rehash(map, 8 * (map->count + 1) > 3 * map->capacity ? 2 * map->capacity
+                                                          : map->capacity);
   }
 
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  if (insert(map->keys, map->values, map->capacity, key, value)) {
+    map->free--;
+  }
+  map->count++;
 }
 
-template <bool strict_find>
 static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
+  if (key == 0) return nullptr;
+  const size_t mask = map->capacity - 1;
   uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
+  for (size_t i = slot_for(key, map->capacity); keys[i] != 0;
+       i = (i + 1) & mask) {
+    /* a deleted entry for this key may precede a re-added one */
+    if (keys[i] == key && map->values[i] != nullptr) {
+      return &map->values[i];
     }
   }
-
-  GPR_DEBUG_ASSERT(!strict_find);
   return nullptr;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
+  void** pvalue = find(map, key);
   GPR_DEBUG_ASSERT(pvalue != nullptr);
+  if (pvalue == nullptr) return nullptr;
   void* out = *pvalue;
-  GPR_DEBUG_ASSERT(out != nullptr);
   *pvalue = nullptr;
+  map->count--;
   map->free++;
-  /* recognize complete emptyness and ensure we can skip
-     defragmentation later */
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  /* no probe sequence goes past a deleted slot followed by an empty one: turn
+     it, and the deleted slots just before it, into empty slots */
+  const size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(pvalue - map->values);
+  if (map->keys[(i + 1) & mask] == 0) {
+    do {
+      map->keys[i] = 0;
+      map->free--;
+      i = (i - 1) & mask;
+    } while (map->keys[i] != 0 && map->values[i] == nullptr);
   }
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
+  void** pvalue = find(map, key);
   return pvalue != nullptr ? *pvalue : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->count;
+}
+
+size_t grpc_chttp2_stream_map_shrink(grpc_chttp2_stream_map* map,
+                                     size_t capacity) {
+  capacity = round_capacity(capacity);
+  if (map->count != 0 || capacity >= map->capacity) {
+    return 0;
+  }
+  const size_t freed =
+      (map->capacity - capacity) * (sizeof(uint32_t) + sizeof(void*));
+  gpr_free(map->keys);
+  gpr_free(map->values);
+  alloc_slots(map, capacity);
+  map->free = 0;
+  return freed;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  if (map->count == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
+  /* the first populated slot from a random one: good enough to pick a stream
+     to abandon */
+  const size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(rand()) & mask;
+  while (map->keys[i] == 0 || map->values[i] == nullptr) {
+    i = (i + 1) & mask;
   }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
+  return map->values[i];
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
@@ -169,8 +192,8 @@ void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void* user_data) {
   size_t i;
 
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
+  for (i = 0; i < map->capacity; i++) {
+    if (map->keys[i] != 0 && map->values[i]) {
       f(user_data, map->keys[i], map->values[i]);
     }
   }
@@ -25,15 +25,19 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
-   Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   Represented as an open addressing hash table with linear probing: an array
+   of keys, probed on lookups, and a corresponding array of values. Zero (the
+   connection's stream id) marks an empty slot, and a null value a deleted one:
+   deleted slots are only reclaimed when adding, so that entries can be deleted
+   from grpc_chttp2_stream_map_for_each callbacks. */
 typedef struct {
   uint32_t* keys;
   void** values;
+  /* number of populated entries */
   size_t count;
+  /* number of deleted entries still taking a slot */
   size_t free;
+  /* number of slots, a power of two */
   size_t capacity;
 } grpc_chttp2_stream_map;
 
@@ -41,8 +45,7 @@ void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map);
 
-/* Add a new key: given http2 semantics, new keys must always be greater than
-   existing keys - this is asserted */
+/* Add a new key, which must not already be in the map */
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value);
 
@@ -59,6 +62,12 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
+/* If the map is empty, give back the slots beyond \a capacity (rounded up as
+   for grpc_chttp2_stream_map_init); they are grown again as streams are
+   added. Returns the number of bytes freed. */
+size_t grpc_chttp2_stream_map_shrink(grpc_chttp2_stream_map* map,
+                                     size_t capacity);
+
 /* Callback on each stream */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
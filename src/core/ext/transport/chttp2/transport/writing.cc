@@ -181,6 +181,25 @@ static uint32_t target_write_size(grpc_chttp2_transport* /*t*/) {
   return 1024 * 1024;
 }
 
+/* With adaptive max frame size, bulk streams send frames as large as the peer
+   accepts only while nothing else is waiting to write */
+static uint32_t max_frame_size_for_write(grpc_chttp2_transport* t) {
+  uint32_t max_frame_size =
+      t->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE];
+  if (t->adaptive_max_frame_size &&
+      t->lists[GRPC_CHTTP2_LIST_WRITABLE].head != nullptr) {
+    max_frame_size = GPR_MIN(
+        max_frame_size,
+        grpc_chttp2_settings_parameters[GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE]
+            .default_value);
+  }
+  return max_frame_size;
+}
+
+// Unary calls that encode to at most this many bytes are copied into a single
+// slice, so that the whole call goes out as one iovec.
+static const size_t kMaxCoalescedUnaryBytes = 1024;
+
 // Returns true if initial_metadata contains only default headers.
 static bool is_default_initial_metadata(grpc_metadata_batch* initial_metadata) {
   return initial_metadata->list.default_count == initial_metadata->list.count;
@@ -322,7 +341,13 @@ class DataSendContext {
       : write_context_(write_context),
         t_(t),
         s_(s),
-        sending_bytes_before_(s_->sending_bytes) {}
+        sending_bytes_before_(s_->sending_bytes),
+        max_frame_size_(max_frame_size_for_write(t)),
+        // The stream gets write_weight frames before the next writable
+        // stream's turn
+        turn_bytes_left_(static_cast<uint32_t> GPR_MIN(
+            UINT32_MAX,
+            static_cast<uint64_t>(s_->write_weight) * max_frame_size_)) {}
 
   uint32_t stream_remote_window() const {
     return static_cast<uint32_t> GPR_MAX(
@@ -333,7 +358,7 @@ class DataSendContext {
 
   uint32_t max_outgoing() const {
     return static_cast<uint32_t> GPR_MIN(
-        t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
+        GPR_MIN(max_frame_size_, turn_bytes_left_),
         GPR_MIN(stream_remote_window(), t_->flow_control->remote_window()));
   }
 
@@ -350,6 +375,7 @@ class DataSendContext {
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    turn_bytes_left_ -= send_bytes;
   }
 
   void FlushCompressedBytes() {
@@ -384,6 +410,7 @@ class DataSendContext {
     grpc_chttp2_encode_data(s_->id, &s_->compressed_data_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
+    turn_bytes_left_ -= send_bytes;
     if (s_->compressed_data_buffer.length == 0) {
       s_->sending_bytes += s_->uncompressed_data_size;
     }
@@ -423,6 +450,8 @@ class DataSendContext {
   grpc_chttp2_transport* t_;
   grpc_chttp2_stream* s_;
   const size_t sending_bytes_before_;
+  const uint32_t max_frame_size_;
+  uint32_t turn_bytes_left_;
   bool is_last_frame_ = false;
 };
 
@@ -479,6 +508,88 @@ class StreamWriteContext {
         "send_initial_metadata_finished");
   }
 
+  // Writes a stream whose initial metadata, whole message and trailing metadata
+  // are all pending -- the usual shape of a unary call -- as back to back
+  // HEADERS, DATA and trailers frames with a single flow control step.
+  // Returns false, having written nothing, if the stream is not in that shape
+  // or its message doesn't fit in one DATA frame.
+  bool FlushUnary() {
+    if (s_->sent_initial_metadata || s_->send_initial_metadata == nullptr ||
+        s_->send_trailing_metadata == nullptr ||
+        s_->fetching_send_message != nullptr ||
+        s_->stream_compression_method !=
+            GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS ||
+        s_->flow_controlled_buffer.length == 0) {
+      return false;
+    }
+    DataSendContext data_send_context(write_context_, t_, s_);
+    const uint32_t send_bytes =
+        static_cast<uint32_t>(s_->flow_controlled_buffer.length);
+    if (data_send_context.max_outgoing() < send_bytes) return false;
+
+    const bool send_trailers =
+        !grpc_metadata_batch_is_empty(s_->send_trailing_metadata);
+    grpc_slice_buffer frames;
+    grpc_slice_buffer_init(&frames);
+    grpc_encode_header_options hopt = {
+        s_->id,  // stream_id
+        false,   // is_eof
+        t_->settings[GRPC_PEER_SETTINGS]
+                    [GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_TRUE_BINARY_METADATA] !=
+            0,  // use_true_binary_metadata
+        t_->settings[GRPC_PEER_SETTINGS]
+                    [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],  // max_frame_size
+        &s_->stats.outgoing                                 // stats
+    };
+    grpc_chttp2_encode_header(&t_->hpack_compressor, nullptr, 0,
+                              s_->send_initial_metadata, &hopt, &frames);
+    const uint32_t stream_announce = s_->flow_control->MaybeSendUpdate();
+    if (stream_announce != 0) {
+      grpc_slice_buffer_add(
+          &frames, grpc_chttp2_window_update_create(s_->id, stream_announce,
+                                                    &s_->stats.outgoing));
+      write_context_->IncWindowUpdateWrites();
+    }
+    grpc_chttp2_encode_data(s_->id, &s_->flow_controlled_buffer, send_bytes,
+                            !send_trailers, &s_->stats.outgoing, &frames);
+    s_->flow_control->SentData(send_bytes);
+    s_->sending_bytes += send_bytes;
+    if (send_trailers) {
+      hopt.is_eof = true;
+      grpc_chttp2_encode_header(&t_->hpack_compressor, nullptr, 0,
+                                s_->send_trailing_metadata, &hopt, &frames);
+      write_context_->IncTrailingMetadataWrites();
+    }
+    if (frames.length <= kMaxCoalescedUnaryBytes) {
+      grpc_slice merged = GRPC_SLICE_MALLOC(frames.length);
+      grpc_slice_buffer_move_first_into_buffer(&frames, frames.length,
+                                               GRPC_SLICE_START_PTR(merged));
+      grpc_slice_buffer_add(&t_->outbuf, merged);
+    } else {
+      grpc_slice_buffer_move_into(&frames, &t_->outbuf);
+    }
+    grpc_slice_buffer_destroy_internal(&frames);
+    write_context_->ResetPingClock();
+    write_context_->IncInitialMetadataWrites();
+    write_context_->IncMessageWrites();
+
+    s_->send_initial_metadata = nullptr;
+    s_->sent_initial_metadata = true;
+    write_context_->NoteScheduledResults();
+    grpc_chttp2_complete_closure_step(
+        t_, s_, &s_->send_initial_metadata_finished, GRPC_ERROR_NONE,
+        "send_initial_metadata_finished");
+    SentLastFrame();
+    data_send_context.CallCallbacks();
+    if (send_trailers) {
+      grpc_chttp2_complete_closure_step(
+          t_, s_, &s_->send_trailing_metadata_finished, GRPC_ERROR_NONE,
+          "send_trailing_metadata_finished");
+    }
+    stream_became_writable_ = true;
+    return true;
+  }
+
   bool compressed_data_buffer_len() {
     return s_->stream_compression_method ==
                    GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS
@@ -536,6 +647,7 @@ class StreamWriteContext {
         }
       }
     }
+    grpc_chttp2_maybe_resume_fetching_send(t_, s_);
     write_context_->ResetPingClock();
     if (data_send_context.is_last_frame()) {
       SentLastFrame();
@@ -642,14 +754,19 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
   }
 
   /* for each grpc_chttp2_stream that's become writable, frame it's data
-     (according to available window sizes) and add to the output buffer */
+     (according to available window sizes) and add to the output buffer.
+     Streams take turns, each writing up to write_weight frames of data before
+     going back to the end of the writable list, so that a long upload does
+     not use up the transport window ahead of the short calls behind it. */
   while (grpc_chttp2_stream* s = ctx.NextStream()) {
     StreamWriteContext stream_ctx(&ctx, s);
     size_t orig_len = t->outbuf.length;
-    stream_ctx.FlushInitialMetadata();
-    stream_ctx.FlushWindowUpdates();
-    stream_ctx.FlushData();
-    stream_ctx.FlushTrailingMetadata();
+    if (!stream_ctx.FlushUnary()) {
+      stream_ctx.FlushInitialMetadata();
+      stream_ctx.FlushWindowUpdates();
+      stream_ctx.FlushData();
+      stream_ctx.FlushTrailingMetadata();
+    }
     if (t->outbuf.length > orig_len) {
       /* Add this stream to the list of the contexts to be traced at TCP */
       s->byte_counter += t->outbuf.length - orig_len;
@@ -47,6 +47,11 @@
 
 #define GRPC_HEADER_SIZE_IN_BYTES 5
 #define GRPC_FLUSH_READ_SIZE 4096
+/* Messages at least this large are written to Cronet straight from their
+   slice, after a separate write of the gRPC header. Smaller ones are cheaper
+   to copy into a single frame than to hand to Cronet's network thread twice.
+ */
+#define GRPC_ZERO_COPY_WRITE_MIN_SIZE 16384
 
 grpc_core::TraceFlag grpc_cronet_trace(false, "cronet");
 #define CRONET_LOG(...)                                    \
@@ -119,6 +124,10 @@ struct read_state {
 
   /* vars to store data coming from server */
   char* read_buffer = nullptr;
+  /* Message bodies are read straight into read_slice, which read_buffer then
+     points into, and is handed to the application without a copy. */
+  grpc_slice read_slice;
+  bool read_buffer_in_slice = false;
   bool length_field_received = false;
   int received_bytes = 0;
   int remaining_bytes = 0;
@@ -141,7 +150,15 @@ struct read_state {
 };
 
 struct write_state {
+  write_state() : write_slice(grpc_empty_slice()) {}
+
+  /* Either the whole frame, copied, or only its gRPC header, with the message
+     written from write_slice. */
   char* write_buffer = nullptr;
+  char write_header[GRPC_HEADER_SIZE_IN_BYTES] = {};
+  grpc_slice write_slice;
+  /* Writes of the current message Cronet has not completed yet. */
+  int pending_message_writes = 0;
 };
 
 /* track state of one stream op */
@@ -285,13 +302,26 @@ static const char* op_id_string(enum e_op_id i) {
 }
 
 static void null_and_maybe_free_read_buffer(stream_obj* s) {
-  if (s->state.rs.read_buffer &&
-      s->state.rs.read_buffer != s->state.rs.grpc_header_bytes) {
+  if (s->state.rs.read_buffer_in_slice) {
+    grpc_slice_unref_internal(s->state.rs.read_slice);
+    s->state.rs.read_buffer_in_slice = false;
+  } else if (s->state.rs.read_buffer &&
+             s->state.rs.read_buffer != s->state.rs.grpc_header_bytes) {
     gpr_free(s->state.rs.read_buffer);
   }
   s->state.rs.read_buffer = nullptr;
 }
 
+static void free_write_buffers(stream_obj* s) {
+  if (s->state.ws.write_buffer &&
+      s->state.ws.write_buffer != s->state.ws.write_header) {
+    gpr_free(s->state.ws.write_buffer);
+  }
+  s->state.ws.write_buffer = nullptr;
+  grpc_slice_unref_internal(s->state.ws.write_slice);
+  s->state.ws.write_slice = grpc_empty_slice();
+}
+
 static void maybe_flush_read(stream_obj* s) {
   /* To enter flush read state (discarding all the buffered messages in
    * transport layer), two conditions must be satisfied: 1) non-zero grpc status
@@ -452,10 +482,8 @@ static void on_failed(bidirectional_stream* stream, int net_error) {
     gpr_free(s->header_array.headers);
     s->header_array.headers = nullptr;
   }
-  if (s->state.ws.write_buffer) {
-    gpr_free(s->state.ws.write_buffer);
-    s->state.ws.write_buffer = nullptr;
-  }
+  free_write_buffers(s);
+  s->state.ws.pending_message_writes = 0;
   null_and_maybe_free_read_buffer(s);
   gpr_mu_unlock(&s->mu);
   execute_from_storage(s);
@@ -479,10 +507,8 @@ static void on_canceled(bidirectional_stream* stream) {
     gpr_free(s->header_array.headers);
     s->header_array.headers = nullptr;
   }
-  if (s->state.ws.write_buffer) {
-    gpr_free(s->state.ws.write_buffer);
-    s->state.ws.write_buffer = nullptr;
-  }
+  free_write_buffers(s);
+  s->state.ws.pending_message_writes = 0;
   null_and_maybe_free_read_buffer(s);
   gpr_mu_unlock(&s->mu);
   execute_from_storage(s);
@@ -589,11 +615,16 @@ static void on_write_completed(bidirectional_stream* stream, const char* data) {
   stream_obj* s = static_cast<stream_obj*>(stream->annotation);
   CRONET_LOG(GPR_DEBUG, "W: on_write_completed(%p, %s)", stream, data);
   gpr_mu_lock(&s->mu);
-  if (s->state.ws.write_buffer) {
-    gpr_free(s->state.ws.write_buffer);
-    s->state.ws.write_buffer = nullptr;
+  /* Cronet completes writes in order. A message written in two parts is done
+     once both are, and writes that are not part of a message (the end of
+     stream) leave the count at zero. */
+  if (s->state.ws.pending_message_writes > 0) {
+    --s->state.ws.pending_message_writes;
+  }
+  if (s->state.ws.pending_message_writes == 0) {
+    free_write_buffers(s);
+    s->state.state_callback_received[OP_SEND_MESSAGE] = true;
   }
-  s->state.state_callback_received[OP_SEND_MESSAGE] = true;
   gpr_mu_unlock(&s->mu);
   execute_from_storage(s);
 }
@@ -687,6 +718,20 @@ static void on_response_trailers_received(
   }
 }
 
+/*
+ Utility function that writes the 5 byte gRPC header for a message of \a length
+ bytes to \a p.
+*/
+static void write_grpc_header(size_t length, uint32_t flags, uint8_t* p) {
+  /* Compressed flag */
+  *p++ = static_cast<uint8_t>((flags & GRPC_WRITE_INTERNAL_COMPRESS) ? 1 : 0);
+  /* Message length */
+  *p++ = static_cast<uint8_t>(length >> 24);
+  *p++ = static_cast<uint8_t>(length >> 16);
+  *p++ = static_cast<uint8_t>(length >> 8);
+  *p++ = static_cast<uint8_t>(length);
+}
+
 /*
  Utility function that takes the data from s->write_slice_buffer and assembles
  into a contiguous byte stream with 5 byte gRPC header prepended.
@@ -703,15 +748,9 @@ static void create_grpc_frame(grpc_slice_buffer* write_slice_buffer,
   *pp_write_buffer = write_buffer;
   uint8_t* p = reinterpret_cast<uint8_t*>(write_buffer);
   /* Append 5 byte header */
-  /* Compressed flag */
-  *p++ = static_cast<uint8_t>((flags & GRPC_WRITE_INTERNAL_COMPRESS) ? 1 : 0);
-  /* Message length */
-  *p++ = static_cast<uint8_t>(length >> 24);
-  *p++ = static_cast<uint8_t>(length >> 16);
-  *p++ = static_cast<uint8_t>(length >> 8);
-  *p++ = static_cast<uint8_t>(length);
+  write_grpc_header(length, flags, p);
   /* append actual data */
-  memcpy(p, GRPC_SLICE_START_PTR(slice), length);
+  memcpy(p + GRPC_HEADER_SIZE_IN_BYTES, GRPC_SLICE_START_PTR(slice), length);
   grpc_slice_unref_internal(slice);
 }
 
@@ -1097,16 +1136,39 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
         GPR_ASSERT(write_slice_buffer.count == 1);
       }
       if (write_slice_buffer.count > 0) {
-        size_t write_buffer_size;
-        create_grpc_frame(
-            &write_slice_buffer, &stream_state->ws.write_buffer,
-            &write_buffer_size,
-            stream_op->payload->send_message.send_message->flags());
-        CRONET_LOG(GPR_DEBUG, "bidirectional_stream_write (%p, %p)", s->cbs,
-                   stream_state->ws.write_buffer);
+        const uint32_t flags =
+            stream_op->payload->send_message.send_message->flags();
+        const size_t length = GRPC_SLICE_LENGTH(write_slice_buffer.slices[0]);
         stream_state->state_callback_received[OP_SEND_MESSAGE] = false;
-        bidirectional_stream_write(s->cbs, stream_state->ws.write_buffer,
-                                   static_cast<int>(write_buffer_size), false);
+        if (length >= GRPC_ZERO_COPY_WRITE_MIN_SIZE) {
+          /* Keep the slice alive until Cronet is done writing from it. */
+          stream_state->ws.write_slice =
+              grpc_slice_buffer_take_first(&write_slice_buffer);
+          write_grpc_header(
+              length, flags,
+              reinterpret_cast<uint8_t*>(stream_state->ws.write_header));
+          stream_state->ws.write_buffer = stream_state->ws.write_header;
+          stream_state->ws.pending_message_writes = 2;
+          CRONET_LOG(GPR_DEBUG, "bidirectional_stream_write (%p, %p)", s->cbs,
+                     GRPC_SLICE_START_PTR(stream_state->ws.write_slice));
+          bidirectional_stream_write(s->cbs, stream_state->ws.write_header,
+                                     GRPC_HEADER_SIZE_IN_BYTES, false);
+          bidirectional_stream_write(
+              s->cbs,
+              reinterpret_cast<const char*>(
+                  GRPC_SLICE_START_PTR(stream_state->ws.write_slice)),
+              static_cast<int>(length), false);
+        } else {
+          size_t write_buffer_size;
+          create_grpc_frame(&write_slice_buffer, &stream_state->ws.write_buffer,
+                            &write_buffer_size, flags);
+          stream_state->ws.pending_message_writes = 1;
+          CRONET_LOG(GPR_DEBUG, "bidirectional_stream_write (%p, %p)", s->cbs,
+                     stream_state->ws.write_buffer);
+          bidirectional_stream_write(s->cbs, stream_state->ws.write_buffer,
+                                     static_cast<int>(write_buffer_size),
+                                     false);
+        }
         grpc_slice_buffer_destroy_internal(&write_slice_buffer);
         if (t->use_packet_coalescing) {
           if (!stream_op->send_trailing_metadata) {
@@ -1222,9 +1284,11 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
         CRONET_LOG(GPR_DEBUG, "length field = %d",
                    stream_state->rs.length_field);
         if (stream_state->rs.length_field > 0) {
-          stream_state->rs.read_buffer = static_cast<char*>(
-              gpr_malloc(static_cast<size_t>(stream_state->rs.length_field)));
-          GPR_ASSERT(stream_state->rs.read_buffer);
+          stream_state->rs.read_slice = GRPC_SLICE_MALLOC(
+              static_cast<size_t>(stream_state->rs.length_field));
+          stream_state->rs.read_buffer = reinterpret_cast<char*>(
+              GRPC_SLICE_START_PTR(stream_state->rs.read_slice));
+          stream_state->rs.read_buffer_in_slice = true;
           stream_state->rs.remaining_bytes = stream_state->rs.length_field;
           stream_state->rs.received_bytes = 0;
           CRONET_LOG(GPR_DEBUG, "bidirectional_stream_read(%p)", s->cbs);
@@ -1287,12 +1351,11 @@ static enum e_op_result execute_stream_op(struct op_and_state* oas) {
       }
     } else if (stream_state->rs.remaining_bytes == 0) {
       CRONET_LOG(GPR_DEBUG, "read operation complete");
-      grpc_slice read_data_slice =
-          GRPC_SLICE_MALLOC((uint32_t)stream_state->rs.length_field);
-      uint8_t* dst_p = GRPC_SLICE_START_PTR(read_data_slice);
-      memcpy(dst_p, stream_state->rs.read_buffer,
-             static_cast<size_t>(stream_state->rs.length_field));
-      null_and_maybe_free_read_buffer(s);
+      /* Cronet read the message into read_slice: pass it on as it is. */
+      GPR_ASSERT(stream_state->rs.read_buffer_in_slice);
+      grpc_slice read_data_slice = stream_state->rs.read_slice;
+      stream_state->rs.read_buffer_in_slice = false;
+      stream_state->rs.read_buffer = nullptr;
       /* Clean up read_slice_buffer in case there is unread data. */
       grpc_slice_buffer_destroy_internal(&stream_state->rs.read_slice_buffer);
       grpc_slice_buffer_init(&stream_state->rs.read_slice_buffer);
@@ -1418,6 +1481,7 @@ inline stream_obj::stream_obj(grpc_transport* gt, grpc_stream* gs,
 
 inline stream_obj::~stream_obj() {
   null_and_maybe_free_read_buffer(this);
+  free_write_buffers(this);
   /* Clean up read_slice_buffer in case there is unread data. */
   grpc_slice_buffer_destroy_internal(&state.rs.read_slice_buffer);
   GRPC_ERROR_UNREF(state.cancel_error);
@@ -25,6 +25,8 @@
 #include <string.h>
 #include "src/core/ext/transport/inproc/inproc_transport.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/api_trace.h"
@@ -59,15 +61,25 @@ grpc_error* fill_in_metadata(inproc_stream* s,
                              uint32_t flags, grpc_metadata_batch* out_md,
                              uint32_t* outflags, bool* markfilled);
 
+// A lock shared by both sides of a transport, or by both sides of a stream,
+// since an operation on one side affects the other as well.
 struct shared_mu {
-  shared_mu() {
-    // Share one lock between both sides since both sides get affected
+  explicit shared_mu(int refs) {
     gpr_mu_init(&mu);
-    gpr_ref_init(&refs, 2);
+    gpr_ref_init(&this->refs, refs);
   }
 
   ~shared_mu() { gpr_mu_destroy(&mu); }
 
+  void ref() { gpr_ref(&refs); }
+
+  void unref() {
+    if (gpr_unref(&refs)) {
+      this->~shared_mu();
+      gpr_free(this);
+    }
+  }
+
   gpr_mu mu;
   gpr_refcount refs;
 };
@@ -85,12 +97,7 @@ struct inproc_transport {
     gpr_ref_init(&refs, 2);
   }
 
-  ~inproc_transport() {
-    if (gpr_unref(&mu->refs)) {
-      mu->~shared_mu();
-      gpr_free(mu);
-    }
-  }
+  ~inproc_transport() { mu->unref(); }
 
   void ref() {
     INPROC_LOG(GPR_INFO, "ref_transport %p", this);
@@ -108,6 +115,8 @@ struct inproc_transport {
   }
 
   grpc_transport base;
+  // Guards state_tracker and the stream list. Each stream has a lock of its
+  // own for everything else, so calls don't contend with each other.
   shared_mu* mu;
   gpr_refcount refs;
   bool is_client;
@@ -115,7 +124,8 @@ struct inproc_transport {
   void (*accept_stream_cb)(void* user_data, grpc_transport* transport,
                            const void* server_data);
   void* accept_stream_data;
-  bool is_closed = false;
+  // Written under mu, but read by streams under their own locks
+  grpc_core::Atomic<bool> is_closed{false};
   struct inproc_transport* other_side;
   struct inproc_stream* stream_list = nullptr;
 };
@@ -135,16 +145,8 @@ struct inproc_stream {
     grpc_metadata_batch_init(&write_buffer_initial_md);
     grpc_metadata_batch_init(&write_buffer_trailing_md);
 
-    stream_list_prev = nullptr;
-    gpr_mu_lock(&t->mu->mu);
-    stream_list_next = t->stream_list;
-    if (t->stream_list) {
-      t->stream_list->stream_list_prev = this;
-    }
-    t->stream_list = this;
-    gpr_mu_unlock(&t->mu->mu);
-
     if (!server_data) {
+      mu = new (gpr_malloc(sizeof(*mu))) shared_mu(1);
       t->ref();
       inproc_transport* st = t->other_side;
       st->ref();
@@ -159,12 +161,14 @@ struct inproc_stream {
       // This is the server-side and is being called through accept_stream_cb
       inproc_stream* cs = (inproc_stream*)server_data;
       other_side = cs;
+      mu = cs->mu;
+      mu->ref();
       // Ref the server-side stream on behalf of the client now
       ref("inproc_init_stream:srv");
 
-      // Now we are about to affect the other side, so lock the transport
-      // to make sure that it doesn't get destroyed
-      gpr_mu_lock(&t->mu->mu);
+      // Now we are about to affect the other side, so take the lock we share
+      // with it
+      gpr_mu_lock(&mu->mu);
       cs->other_side = this;
       // Now transfer from the other side's write_buffer if any to the to_read
       // buffer
@@ -188,8 +192,21 @@ struct inproc_stream {
         cs->write_buffer_cancel_error = GRPC_ERROR_NONE;
       }
 
-      gpr_mu_unlock(&t->mu->mu);
+      gpr_mu_unlock(&mu->mu);
+    }
+
+    // Only list the stream once it is fully set up: close_transport() may
+    // pick it up from the list, and cancel it under mu, as soon as it is
+    // there. A stream created while the transport closes may miss being
+    // cancelled, but then fails to send metadata as it sees is_closed.
+    stream_list_prev = nullptr;
+    gpr_mu_lock(&t->mu->mu);
+    stream_list_next = t->stream_list;
+    if (t->stream_list) {
+      t->stream_list->stream_list_prev = this;
     }
+    t->stream_list = this;
+    gpr_mu_unlock(&t->mu->mu);
   }
 
   ~inproc_stream() {
@@ -201,6 +218,7 @@ struct inproc_stream {
       grpc_slice_buffer_destroy_internal(&recv_message);
     }
 
+    mu->unref();
     t->unref();
 
     if (closure_at_destroy) {
@@ -229,6 +247,8 @@ struct inproc_stream {
 #undef STREAM_UNREF
 
   inproc_transport* t;
+  // Shared with other_side, created by the client-side stream
+  shared_mu* mu;
   grpc_metadata_batch to_read_initial_md;
   uint32_t to_read_initial_md_flags = 0;
   bool to_read_initial_md_filled = false;
@@ -277,6 +297,7 @@ struct inproc_stream {
 
   grpc_millis deadline = GRPC_MILLIS_INF_FUTURE;
 
+  // Guarded by t->mu
   bool listed = true;
   struct inproc_stream* stream_list_prev;
   struct inproc_stream* stream_list_next;
@@ -338,7 +359,9 @@ void close_stream_locked(inproc_stream* s) {
     grpc_metadata_batch_destroy(&s->write_buffer_initial_md);
     grpc_metadata_batch_destroy(&s->write_buffer_trailing_md);
 
-    if (s->listed) {
+    gpr_mu_lock(&s->t->mu->mu);
+    bool listed = s->listed;
+    if (listed) {
       inproc_stream* p = s->stream_list_prev;
       inproc_stream* n = s->stream_list_next;
       if (p != nullptr) {
@@ -350,6 +373,9 @@ void close_stream_locked(inproc_stream* s) {
         n->stream_list_prev = p;
       }
       s->listed = false;
+    }
+    gpr_mu_unlock(&s->t->mu->mu);
+    if (listed) {
       s->unref("close_stream:list");
     }
     s->closed = true;
@@ -601,8 +627,9 @@ void op_state_machine(void* arg, grpc_error* error) {
 
   INPROC_LOG(GPR_INFO, "op_state_machine %p", arg);
   inproc_stream* s = static_cast<inproc_stream*>(arg);
-  gpr_mu* mu = &s->t->mu->mu;  // keep aside in case s gets closed
-  gpr_mu_lock(mu);
+  shared_mu* mu = s->mu;  // keep aside in case s gets closed
+  mu->ref();
+  gpr_mu_lock(&mu->mu);
   s->op_closure_scheduled = false;
   // cancellation takes precedence
   inproc_stream* other = s->other_side;
@@ -860,7 +887,8 @@ done:
     close_other_side_locked(s, "op_state_machine");
     close_stream_locked(s);
   }
-  gpr_mu_unlock(mu);
+  gpr_mu_unlock(&mu->mu);
+  mu->unref();
   GRPC_ERROR_UNREF(new_err);
 }
 
@@ -925,8 +953,9 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
                        grpc_transport_stream_op_batch* op) {
   INPROC_LOG(GPR_INFO, "perform_stream_op %p %p %p", gt, gs, op);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu* mu = &s->t->mu->mu;  // save aside in case s gets closed
-  gpr_mu_lock(mu);
+  shared_mu* mu = s->mu;  // save aside in case s gets closed
+  mu->ref();
+  gpr_mu_lock(&mu->mu);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_inproc_trace)) {
     if (op->send_initial_metadata) {
@@ -974,7 +1003,7 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
   inproc_stream* other = s->other_side;
   if (error == GRPC_ERROR_NONE &&
       (op->send_initial_metadata || op->send_trailing_metadata)) {
-    if (s->t->is_closed) {
+    if (s->t->is_closed.Load(grpc_core::MemoryOrder::ACQUIRE)) {
       error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint already shutdown");
     }
     if (error == GRPC_ERROR_NONE && op->send_initial_metadata) {
@@ -1107,24 +1136,42 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
     close_other_side_locked(s, "perform_stream_op:other_side");
     close_stream_locked(s);
   }
-  gpr_mu_unlock(mu);
+  gpr_mu_unlock(&mu->mu);
+  mu->unref();
   GRPC_ERROR_UNREF(error);
 }
 
-void close_transport_locked(inproc_transport* t) {
-  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed);
+void close_transport(inproc_transport* t) {
+  // Streams take the transport lock under their own lock, so collect them
+  // here and cancel them each under its own lock once this one is released.
+  grpc_core::InlinedVector<inproc_stream*, 4> streams;
+  gpr_mu_lock(&t->mu->mu);
+  INPROC_LOG(GPR_INFO, "close_transport %p %d", t,
+             t->is_closed.Load(grpc_core::MemoryOrder::RELAXED));
   t->state_tracker.SetState(GRPC_CHANNEL_SHUTDOWN, "close transport");
-  if (!t->is_closed) {
-    t->is_closed = true;
-    /* Also end all streams on this transport */
-    while (t->stream_list != nullptr) {
+  if (!t->is_closed.Load(grpc_core::MemoryOrder::RELAXED)) {
+    t->is_closed.Store(true, grpc_core::MemoryOrder::RELEASE);
+    for (inproc_stream* s = t->stream_list; s != nullptr;
+         s = s->stream_list_next) {
+      s->ref("close_transport");
+      streams.push_back(s);
+    }
+  }
+  gpr_mu_unlock(&t->mu->mu);
+  /* Also end all streams on this transport */
+  for (size_t i = 0; i < streams.size(); i++) {
+    inproc_stream* s = streams[i];
+    shared_mu* mu = s->mu;
+    gpr_mu_lock(&mu->mu);
+    if (!s->closed) {
       // cancel_stream_locked also adjusts stream list
       cancel_stream_locked(
-          t->stream_list,
-          grpc_error_set_int(
-              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
-              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+          s, grpc_error_set_int(
+                 GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
+                 GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
     }
+    gpr_mu_unlock(&mu->mu);
+    s->unref("close_transport");
   }
 }
 
@@ -1157,10 +1204,10 @@ void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
     GRPC_ERROR_UNREF(op->disconnect_with_error);
   }
 
+  gpr_mu_unlock(&t->mu->mu);
   if (do_close) {
-    close_transport_locked(t);
+    close_transport(t);
   }
-  gpr_mu_unlock(&t->mu->mu);
 }
 
 void destroy_stream(grpc_transport* /*gt*/, grpc_stream* gs,
@@ -1174,9 +1221,7 @@ void destroy_stream(grpc_transport* /*gt*/, grpc_stream* gs,
 void destroy_transport(grpc_transport* gt) {
   inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   INPROC_LOG(GPR_INFO, "destroy_transport %p", t);
-  gpr_mu_lock(&t->mu->mu);
-  close_transport_locked(t);
-  gpr_mu_unlock(&t->mu->mu);
+  close_transport(t);
   t->other_side->unref();
   t->unref();
 }
@@ -1211,7 +1256,7 @@ void inproc_transports_create(grpc_transport** server_transport,
                               grpc_transport** client_transport,
                               const grpc_channel_args* /*client_args*/) {
   INPROC_LOG(GPR_INFO, "inproc_transports_create");
-  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu();
+  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu(2);
   inproc_transport* st = new (gpr_malloc(sizeof(*st)))
       inproc_transport(&inproc_vtable, mu, /*is_client=*/false);
   inproc_transport* ct = new (gpr_malloc(sizeof(*ct)))
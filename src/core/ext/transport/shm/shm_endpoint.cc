@@ -0,0 +1,499 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_SHM_TRANSPORT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+constexpr size_t kMinRingSize = 4096;
+constexpr size_t kMaxRingSize = 1u << 30;
+// Upper bound on the bytes handed up by one read.
+constexpr size_t kMaxReadSize = 1024 * 1024;
+
+size_t SegmentSize(size_t ring_size) {
+  return 2 * ShmRing::SpaceFor(ring_size);
+}
+
+bool ValidRingSize(size_t ring_size) {
+  return ring_size >= kMinRingSize && ring_size <= kMaxRingSize &&
+         (ring_size & (ring_size - 1)) == 0;
+}
+
+void SignalEventfd(int fd) {
+  uint64_t one = 1;
+  ssize_t ret;
+  do {
+    ret = write(fd, &one, sizeof(one));
+  } while (ret < 0 && errno == EINTR);
+  // EAGAIN means the counter is saturated, which wakes the peer all the same.
+}
+
+void DrainEventfd(grpc_fd* fd) {
+  uint64_t value;
+  ssize_t ret;
+  do {
+    ret = read(grpc_fd_wrapped_fd(fd), &value, sizeof(value));
+  } while (ret < 0 && errno == EINTR);
+}
+
+class ShmEndpoint {
+ public:
+  ShmEndpoint(grpc_shm_fds* fds, int side, grpc_endpoint* wrapped,
+              void* segment);
+
+  static const grpc_endpoint_vtable kVtable;
+
+  grpc_endpoint base;
+
+ private:
+  ~ShmEndpoint();
+
+  void Ref() { gpr_ref(&refs_); }
+  void Unref() {
+    if (gpr_unref(&refs_)) delete this;
+  }
+
+  static ShmEndpoint* FromBase(grpc_endpoint* ep) {
+    return reinterpret_cast<ShmEndpoint*>(ep);
+  }
+
+  grpc_error* AnnotateError(grpc_error* error) {
+    return grpc_error_set_str(
+        grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS,
+                           GRPC_STATUS_UNAVAILABLE),
+        GRPC_ERROR_STR_TARGET_ADDRESS,
+        grpc_slice_from_copied_string(peer_string_));
+  }
+
+  void ContinueRead(grpc_error* error);
+  void ContinueWrite(grpc_error* error);
+  void Shutdown(grpc_error* why);
+
+  static void OnReadable(void* arg, grpc_error* error);
+  static void OnWritable(void* arg, grpc_error* error);
+  static void OnPeerGone(void* arg, grpc_error* error);
+
+  static void Read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                   grpc_closure* cb, bool urgent);
+  static void Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                    grpc_closure* cb, void* arg);
+  static void AddToPollset(grpc_endpoint* ep, grpc_pollset* pollset);
+  static void AddToPollsetSet(grpc_endpoint* ep, grpc_pollset_set* pollset_set);
+  static void DeleteFromPollsetSet(grpc_endpoint* ep,
+                                   grpc_pollset_set* pollset_set);
+  static void Shutdown(grpc_endpoint* ep, grpc_error* why);
+  static void Destroy(grpc_endpoint* ep);
+  static grpc_resource_user* GetResourceUser(grpc_endpoint* ep);
+  static char* GetPeer(grpc_endpoint* ep);
+  static int GetFd(grpc_endpoint* ep);
+  static bool CanTrackErr(grpc_endpoint* ep);
+
+  gpr_refcount refs_;
+  void* segment_;
+  size_t segment_size_;
+  ShmRing out_;
+  ShmRing in_;
+  // Signalled by the peer when it wrote into in_, or freed space in out_.
+  grpc_fd* data_fd_;
+  grpc_fd* space_fd_;
+  // Signalled by us for the same.
+  int peer_data_efd_;
+  int peer_space_efd_;
+  grpc_endpoint* wrapped_;
+  char* peer_string_;
+  std::atomic<bool> shutdown_{false};
+  std::atomic<bool> peer_gone_{false};
+
+  grpc_slice_buffer* read_buffer_ = nullptr;
+  grpc_closure* read_cb_ = nullptr;
+  grpc_closure read_closure_;
+
+  grpc_slice_buffer* write_buffer_ = nullptr;
+  grpc_closure* write_cb_ = nullptr;
+  size_t write_index_ = 0;
+  size_t write_offset_ = 0;
+  grpc_closure write_closure_;
+
+  // Nothing is sent on the wrapped socket; a read on it completes when the
+  // peer closes it.
+  grpc_slice_buffer liveness_buffer_;
+  grpc_closure liveness_closure_;
+};
+
+const grpc_endpoint_vtable ShmEndpoint::kVtable = {
+    ShmEndpoint::Read,
+    ShmEndpoint::Write,
+    ShmEndpoint::AddToPollset,
+    ShmEndpoint::AddToPollsetSet,
+    ShmEndpoint::DeleteFromPollsetSet,
+    ShmEndpoint::Shutdown,
+    ShmEndpoint::Destroy,
+    ShmEndpoint::GetResourceUser,
+    ShmEndpoint::GetPeer,
+    ShmEndpoint::GetFd,
+    ShmEndpoint::CanTrackErr};
+
+ShmEndpoint::ShmEndpoint(grpc_shm_fds* fds, int side, grpc_endpoint* wrapped,
+                         void* segment)
+    : segment_(segment),
+      segment_size_(SegmentSize(fds->ring_size)),
+      wrapped_(wrapped),
+      peer_string_(grpc_endpoint_get_peer(wrapped)) {
+  base.vtable = &kVtable;
+  // One ref for the endpoint, one for the liveness read.
+  gpr_ref_init(&refs_, 2);
+  uint8_t* rings = static_cast<uint8_t*>(segment);
+  size_t ring_space = ShmRing::SpaceFor(fds->ring_size);
+  out_ = ShmRing(rings + side * ring_space, fds->ring_size);
+  in_ = ShmRing(rings + (1 - side) * ring_space, fds->ring_size);
+  data_fd_ = grpc_fd_create(fds->data_efds[1 - side], "shm_data", false);
+  space_fd_ = grpc_fd_create(fds->space_efds[side], "shm_space", false);
+  peer_data_efd_ = fds->data_efds[side];
+  peer_space_efd_ = fds->space_efds[1 - side];
+  close(fds->memfd);
+  GRPC_CLOSURE_INIT(&read_closure_, OnReadable, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&write_closure_, OnWritable, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&liveness_closure_, OnPeerGone, this,
+                    grpc_schedule_on_exec_ctx);
+  grpc_slice_buffer_init(&liveness_buffer_);
+  grpc_endpoint_read(wrapped_, &liveness_buffer_, &liveness_closure_,
+                     /*urgent=*/false);
+}
+
+ShmEndpoint::~ShmEndpoint() {
+  grpc_endpoint_destroy(wrapped_);
+  grpc_slice_buffer_destroy_internal(&liveness_buffer_);
+  grpc_fd_orphan(data_fd_, nullptr, nullptr, "shm_endpoint");
+  grpc_fd_orphan(space_fd_, nullptr, nullptr, "shm_endpoint");
+  close(peer_data_efd_);
+  close(peer_space_efd_);
+  munmap(segment_, segment_size_);
+  gpr_free(peer_string_);
+}
+
+void ShmEndpoint::ContinueRead(grpc_error* error) {
+  while (true) {
+    if (error == GRPC_ERROR_NONE && shutdown_.load()) {
+      error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint shutdown");
+    }
+    if (error != GRPC_ERROR_NONE) break;
+    // Data the peer wrote before closing is still delivered.
+    size_t length = GPR_MIN(in_.ReadableBytes(), kMaxReadSize);
+    if (length > 0) {
+      grpc_slice slice = GRPC_SLICE_MALLOC(length);
+      in_.Read(GRPC_SLICE_START_PTR(slice), length);
+      grpc_slice_buffer_add(read_buffer_, slice);
+      if (in_.TakeWriterWaiting()) SignalEventfd(peer_space_efd_);
+      break;
+    }
+    if (in_.writer_closed() || peer_gone_.load()) {
+      error = AnnotateError(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory peer closed"));
+      break;
+    }
+    DrainEventfd(data_fd_);
+    if (in_.ReaderPrepareWait()) {
+      grpc_fd_notify_on_read(data_fd_, &read_closure_);
+      return;
+    }
+  }
+  grpc_closure* cb = read_cb_;
+  read_cb_ = nullptr;
+  read_buffer_ = nullptr;
+  ExecCtx::Run(DEBUG_LOCATION, cb, error);
+  Unref();
+}
+
+void ShmEndpoint::ContinueWrite(grpc_error* error) {
+  while (true) {
+    if (error == GRPC_ERROR_NONE && shutdown_.load()) {
+      error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint shutdown");
+    }
+    if (error != GRPC_ERROR_NONE) break;
+    if (out_.reader_closed() || peer_gone_.load()) {
+      error = AnnotateError(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory peer closed"));
+      break;
+    }
+    bool wrote = false;
+    while (write_index_ < write_buffer_->count) {
+      const grpc_slice& slice = write_buffer_->slices[write_index_];
+      size_t length = GRPC_SLICE_LENGTH(slice);
+      size_t written =
+          out_.Write(GRPC_SLICE_START_PTR(slice) + write_offset_,
+                     length - write_offset_);
+      if (written == 0 && length != 0) break;
+      wrote = true;
+      write_offset_ += written;
+      if (write_offset_ == length) {
+        write_index_++;
+        write_offset_ = 0;
+      }
+    }
+    if (wrote && out_.TakeReaderWaiting()) SignalEventfd(peer_data_efd_);
+    if (write_index_ == write_buffer_->count) break;
+    DrainEventfd(space_fd_);
+    if (out_.WriterPrepareWait()) {
+      grpc_fd_notify_on_read(space_fd_, &write_closure_);
+      return;
+    }
+  }
+  grpc_closure* cb = write_cb_;
+  write_cb_ = nullptr;
+  write_buffer_ = nullptr;
+  ExecCtx::Run(DEBUG_LOCATION, cb, error);
+  Unref();
+}
+
+void ShmEndpoint::OnReadable(void* arg, grpc_error* error) {
+  static_cast<ShmEndpoint*>(arg)->ContinueRead(GRPC_ERROR_REF(error));
+}
+
+void ShmEndpoint::OnWritable(void* arg, grpc_error* error) {
+  static_cast<ShmEndpoint*>(arg)->ContinueWrite(GRPC_ERROR_REF(error));
+}
+
+void ShmEndpoint::OnPeerGone(void* arg, grpc_error* /*error*/) {
+  ShmEndpoint* self = static_cast<ShmEndpoint*>(arg);
+  // Data or an error alike: the peer never writes to the socket.
+  self->peer_gone_.store(true);
+  grpc_fd_set_readable(self->data_fd_);
+  grpc_fd_set_readable(self->space_fd_);
+  self->Unref();
+}
+
+void ShmEndpoint::Shutdown(grpc_error* why) {
+  if (shutdown_.exchange(true)) {
+    GRPC_ERROR_UNREF(why);
+    return;
+  }
+  out_.CloseWriter();
+  in_.CloseReader();
+  SignalEventfd(peer_data_efd_);
+  SignalEventfd(peer_space_efd_);
+  grpc_fd_shutdown(data_fd_, GRPC_ERROR_REF(why));
+  grpc_fd_shutdown(space_fd_, GRPC_ERROR_REF(why));
+  grpc_endpoint_shutdown(wrapped_, why);
+}
+
+void ShmEndpoint::Read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                       grpc_closure* cb, bool /*urgent*/) {
+  ShmEndpoint* self = FromBase(ep);
+  GPR_ASSERT(self->read_cb_ == nullptr);
+  self->read_cb_ = cb;
+  self->read_buffer_ = slices;
+  grpc_slice_buffer_reset_and_unref_internal(slices);
+  self->Ref();
+  self->ContinueRead(GRPC_ERROR_NONE);
+}
+
+void ShmEndpoint::Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                        grpc_closure* cb, void* /*arg*/) {
+  ShmEndpoint* self = FromBase(ep);
+  GPR_ASSERT(self->write_cb_ == nullptr);
+  self->write_cb_ = cb;
+  self->write_buffer_ = slices;
+  self->write_index_ = 0;
+  self->write_offset_ = 0;
+  self->Ref();
+  self->ContinueWrite(GRPC_ERROR_NONE);
+}
+
+void ShmEndpoint::AddToPollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+  ShmEndpoint* self = FromBase(ep);
+  grpc_pollset_add_fd(pollset, self->data_fd_);
+  grpc_pollset_add_fd(pollset, self->space_fd_);
+  grpc_endpoint_add_to_pollset(self->wrapped_, pollset);
+}
+
+void ShmEndpoint::AddToPollsetSet(grpc_endpoint* ep,
+                                  grpc_pollset_set* pollset_set) {
+  ShmEndpoint* self = FromBase(ep);
+  grpc_pollset_set_add_fd(pollset_set, self->data_fd_);
+  grpc_pollset_set_add_fd(pollset_set, self->space_fd_);
+  grpc_endpoint_add_to_pollset_set(self->wrapped_, pollset_set);
+}
+
+void ShmEndpoint::DeleteFromPollsetSet(grpc_endpoint* ep,
+                                       grpc_pollset_set* pollset_set) {
+  ShmEndpoint* self = FromBase(ep);
+  grpc_pollset_set_del_fd(pollset_set, self->data_fd_);
+  grpc_pollset_set_del_fd(pollset_set, self->space_fd_);
+  grpc_endpoint_delete_from_pollset_set(self->wrapped_, pollset_set);
+}
+
+void ShmEndpoint::Shutdown(grpc_endpoint* ep, grpc_error* why) {
+  FromBase(ep)->Shutdown(why);
+}
+
+void ShmEndpoint::Destroy(grpc_endpoint* ep) {
+  ShmEndpoint* self = FromBase(ep);
+  self->Shutdown(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint destroyed"));
+  self->Unref();
+}
+
+grpc_resource_user* ShmEndpoint::GetResourceUser(grpc_endpoint* ep) {
+  return grpc_endpoint_get_resource_user(FromBase(ep)->wrapped_);
+}
+
+// The peer of the socket, so that checks on it (eg. local credentials)
+// keep working.
+char* ShmEndpoint::GetPeer(grpc_endpoint* ep) {
+  return gpr_strdup(FromBase(ep)->peer_string_);
+}
+
+int ShmEndpoint::GetFd(grpc_endpoint* /*ep*/) { return -1; }
+
+bool ShmEndpoint::CanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+}  // namespace
+
+}  // namespace grpc_core
+
+grpc_error* grpc_shm_fds_create(size_t ring_size, grpc_shm_fds* fds) {
+  grpc_shm_fds_from_array(nullptr, ring_size, fds);
+  if (!grpc_core::ValidRingSize(ring_size)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Invalid shm ring size");
+  }
+  fds->memfd = static_cast<int>(syscall(SYS_memfd_create, "grpc_shm",
+                                        MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  if (fds->memfd < 0) return GRPC_OS_ERROR(errno, "memfd_create");
+  grpc_error* error = GRPC_ERROR_NONE;
+  if (ftruncate(fds->memfd, grpc_core::SegmentSize(ring_size)) != 0) {
+    error = GRPC_OS_ERROR(errno, "ftruncate");
+    grpc_shm_fds_close(fds);
+    return error;
+  }
+#ifdef F_ADD_SEALS
+  // Keeps the peer from shrinking the segment under our mapping.
+  fcntl(fds->memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+#endif
+  for (int i = 0; i < 2; i++) {
+    fds->data_efds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    fds->space_efds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fds->data_efds[i] < 0 || fds->space_efds[i] < 0) {
+      error = GRPC_OS_ERROR(errno, "eventfd");
+      grpc_shm_fds_close(fds);
+      return error;
+    }
+  }
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error* grpc_shm_fds_validate(const grpc_shm_fds* fds) {
+  if (!grpc_core::ValidRingSize(fds->ring_size)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Invalid shm ring size");
+  }
+  struct stat st;
+  if (fstat(fds->memfd, &st) != 0) return GRPC_OS_ERROR(errno, "fstat");
+  if (static_cast<uint64_t>(st.st_size) <
+      grpc_core::SegmentSize(fds->ring_size)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shm segment too small");
+  }
+#ifdef F_GET_SEALS
+  int seals = fcntl(fds->memfd, F_GET_SEALS);
+  if (seals < 0 || (seals & F_SEAL_SHRINK) == 0) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shm segment not sealed");
+  }
+#endif
+  return GRPC_ERROR_NONE;
+}
+
+void grpc_shm_fds_to_array(const grpc_shm_fds* fds,
+                           int array[GRPC_SHM_NUM_FDS]) {
+  array[0] = fds->memfd;
+  array[1] = fds->data_efds[0];
+  array[2] = fds->data_efds[1];
+  array[3] = fds->space_efds[0];
+  array[4] = fds->space_efds[1];
+}
+
+void grpc_shm_fds_from_array(const int array[GRPC_SHM_NUM_FDS],
+                             size_t ring_size, grpc_shm_fds* fds) {
+  fds->memfd = array == nullptr ? -1 : array[0];
+  fds->data_efds[0] = array == nullptr ? -1 : array[1];
+  fds->data_efds[1] = array == nullptr ? -1 : array[2];
+  fds->space_efds[0] = array == nullptr ? -1 : array[3];
+  fds->space_efds[1] = array == nullptr ? -1 : array[4];
+  fds->ring_size = ring_size;
+}
+
+void grpc_shm_fds_close(grpc_shm_fds* fds) {
+  int array[GRPC_SHM_NUM_FDS];
+  grpc_shm_fds_to_array(fds, array);
+  for (int fd : array) {
+    if (fd >= 0) close(fd);
+  }
+  grpc_shm_fds_from_array(nullptr, fds->ring_size, fds);
+}
+
+grpc_error* grpc_shm_endpoint_create(grpc_shm_fds* fds, int side,
+                                     grpc_endpoint* wrapped,
+                                     grpc_endpoint** endpoint) {
+  GPR_ASSERT(side == 0 || side == 1);
+  void* segment =
+      mmap(nullptr, grpc_core::SegmentSize(fds->ring_size),
+           PROT_READ | PROT_WRITE, MAP_SHARED, fds->memfd, 0);
+  if (segment == MAP_FAILED) {
+    grpc_error* error = GRPC_OS_ERROR(errno, "mmap");
+    grpc_shm_fds_close(fds);
+    return error;
+  }
+  grpc_core::ShmEndpoint* ep =
+      new grpc_core::ShmEndpoint(fds, side, wrapped, segment);
+  *endpoint = &ep->base;
+  return GRPC_ERROR_NONE;
+}
+
+#endif /* GRPC_SHM_TRANSPORT */
@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#if defined(GRPC_LINUX_EVENTFD) && defined(GRPC_HAVE_UNIX_SOCKET) && \
+    defined(GRPC_POSIX_SOCKET_EV)
+#define GRPC_SHM_TRANSPORT 1
+#endif
+
+#ifdef GRPC_SHM_TRANSPORT
+
+#include "src/core/lib/iomgr/endpoint.h"
+
+/* An endpoint over a pair of shared memory rings, for peers on the same
+   host. Side 0 (the client) writes ring 0 and reads ring 1, side 1 the
+   reverse. Each ring has an eventfd its writer signals once it has added
+   data and one its reader signals once it has freed space, both only when
+   the other side asked to be woken.
+
+   The endpoint keeps the Unix socket the segment was passed over, and
+   treats the socket closing as the peer going away. */
+
+#define GRPC_SHM_NUM_FDS 5
+
+typedef struct grpc_shm_fds {
+  int memfd;
+  int data_efds[2];
+  int space_efds[2];
+  size_t ring_size;
+} grpc_shm_fds;
+
+/* Creates a segment holding two rings of \a ring_size bytes each, which
+   must be a power of two. */
+grpc_error* grpc_shm_fds_create(size_t ring_size, grpc_shm_fds* fds);
+
+/* Checks fds received from a peer, and that the segment is large enough for
+   fds->ring_size. */
+grpc_error* grpc_shm_fds_validate(const grpc_shm_fds* fds);
+
+/* The fds in the order they are passed to the peer. */
+void grpc_shm_fds_to_array(const grpc_shm_fds* fds,
+                           int array[GRPC_SHM_NUM_FDS]);
+void grpc_shm_fds_from_array(const int array[GRPC_SHM_NUM_FDS],
+                             size_t ring_size, grpc_shm_fds* fds);
+
+void grpc_shm_fds_close(grpc_shm_fds* fds);
+
+/* Takes ownership of \a fds, and on success of \a wrapped, the socket the
+   fds were passed over. \a side is 0 for the client and 1 for the server. */
+grpc_error* grpc_shm_endpoint_create(grpc_shm_fds* fds, int side,
+                                     grpc_endpoint* wrapped,
+                                     grpc_endpoint** endpoint);
+
+#endif /* GRPC_SHM_TRANSPORT */
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H */
@@ -0,0 +1,360 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_transport.h"
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+#include "src/core/lib/channel/handshaker_registry.h"
+
+#ifdef GRPC_SHM_TRANSPORT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Sent by the client, together with the segment's fds.
+struct ShmHello {
+  uint32_t magic;
+  uint32_t ring_size;
+};
+
+constexpr uint32_t kShmMagic = 0x67736d01;  // "gsm", version 1
+
+grpc_error* SendSegment(int fd, const grpc_shm_fds* fds) {
+  ShmHello hello = {kShmMagic, static_cast<uint32_t>(fds->ring_size)};
+  struct iovec iov = {&hello, sizeof(hello)};
+  int array[GRPC_SHM_NUM_FDS];
+  grpc_shm_fds_to_array(fds, array);
+  union {
+    char buf[CMSG_SPACE(sizeof(array))];
+    struct cmsghdr align;
+  } control;
+  memset(&control, 0, sizeof(control));
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(array));
+  memcpy(CMSG_DATA(cmsg), array, sizeof(array));
+  ssize_t sent;
+  do {
+    sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  if (sent < 0) return GRPC_OS_ERROR(errno, "sendmsg");
+  if (sent != sizeof(hello)) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Short shm handshake write");
+  }
+  return GRPC_ERROR_NONE;
+}
+
+// Returns false if the client's message has not arrived yet. Otherwise sets
+// *error, and on success *fds.
+bool ReceiveSegment(int fd, grpc_shm_fds* fds, grpc_error** error) {
+  ShmHello hello = {0, 0};
+  struct iovec iov = {&hello, sizeof(hello)};
+  union {
+    char buf[CMSG_SPACE(sizeof(int) * GRPC_SHM_NUM_FDS)];
+    struct cmsghdr align;
+  } control;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  ssize_t received;
+  do {
+    received = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+    *error = GRPC_OS_ERROR(errno, "recvmsg");
+    return true;
+  }
+  // Take whatever fds came along first, so that they are closed on failure.
+  int array[GRPC_SHM_NUM_FDS];
+  size_t num_fds = 0;
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < count; i++) {
+      int received_fd;
+      memcpy(&received_fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+      if (num_fds < GRPC_SHM_NUM_FDS) {
+        array[num_fds++] = received_fd;
+      } else {
+        close(received_fd);
+      }
+    }
+  }
+  for (size_t i = num_fds; i < GRPC_SHM_NUM_FDS; i++) array[i] = -1;
+  grpc_shm_fds_from_array(array, hello.ring_size, fds);
+  if (received == 0) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed");
+  } else if (received != sizeof(hello) || hello.magic != kShmMagic ||
+             num_fds != GRPC_SHM_NUM_FDS || (msg.msg_flags & MSG_CTRUNC)) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Invalid shm handshake");
+  } else {
+    *error = grpc_shm_fds_validate(fds);
+  }
+  if (*error != GRPC_ERROR_NONE) grpc_shm_fds_close(fds);
+  return true;
+}
+
+// Moves the connection onto a shared memory segment: the client creates
+// one and passes it over the socket, the server waits for it.
+class ShmHandshaker : public Handshaker {
+ public:
+  ShmHandshaker(bool is_client, grpc_pollset_set* interested_parties)
+      : is_client_(is_client), interested_parties_(interested_parties) {}
+  void Shutdown(grpc_error* why) override;
+  void DoHandshake(grpc_tcp_server_acceptor* acceptor,
+                   grpc_closure* on_handshake_done,
+                   HandshakerArgs* args) override;
+  const char* name() const override { return "shm"; }
+
+ private:
+  virtual ~ShmHandshaker();
+  void CleanupArgsForFailureLocked();
+  void FinishLocked(grpc_error* error);
+  void TryReceiveLocked();
+  static void OnReadable(void* arg, grpc_error* error);
+
+  const bool is_client_;
+  grpc_pollset_set* const interested_parties_;
+
+  Mutex mu_;
+
+  bool is_shutdown_ = false;
+  // Endpoint and read buffer to destroy after a shutdown.
+  grpc_endpoint* endpoint_to_destroy_ = nullptr;
+  grpc_slice_buffer* read_buffer_to_destroy_ = nullptr;
+
+  // State saved while performing the handshake.
+  HandshakerArgs* args_ = nullptr;
+  grpc_closure* on_handshake_done_ = nullptr;
+
+  // Server only: a dup of the endpoint's socket, to wait for the client's
+  // message on without the endpoint reading it.
+  grpc_fd* socket_fd_ = nullptr;
+  grpc_closure on_readable_;
+};
+
+ShmHandshaker::~ShmHandshaker() {
+  if (endpoint_to_destroy_ != nullptr) {
+    grpc_endpoint_destroy(endpoint_to_destroy_);
+  }
+  if (read_buffer_to_destroy_ != nullptr) {
+    grpc_slice_buffer_destroy_internal(read_buffer_to_destroy_);
+    gpr_free(read_buffer_to_destroy_);
+  }
+}
+
+// Set args fields to nullptr, saving the endpoint and read buffer for
+// later destruction.
+void ShmHandshaker::CleanupArgsForFailureLocked() {
+  endpoint_to_destroy_ = args_->endpoint;
+  args_->endpoint = nullptr;
+  read_buffer_to_destroy_ = args_->read_buffer;
+  args_->read_buffer = nullptr;
+  grpc_channel_args_destroy(args_->args);
+  args_->args = nullptr;
+}
+
+void ShmHandshaker::FinishLocked(grpc_error* error) {
+  if (socket_fd_ != nullptr) {
+    grpc_pollset_set_del_fd(interested_parties_, socket_fd_);
+    grpc_fd_orphan(socket_fd_, nullptr, nullptr, "shm_handshake");
+    socket_fd_ = nullptr;
+  }
+  if (is_shutdown_) {
+    // Shutdown() already cleaned up.
+    if (error == GRPC_ERROR_NONE) {
+      error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Handshaker shutdown");
+    }
+  } else if (error != GRPC_ERROR_NONE) {
+    grpc_endpoint_shutdown(args_->endpoint, GRPC_ERROR_REF(error));
+    CleanupArgsForFailureLocked();
+  }
+  // Set shutdown to true so that subsequent calls to Shutdown() do nothing.
+  is_shutdown_ = true;
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, error);
+}
+
+void ShmHandshaker::TryReceiveLocked() {
+  grpc_shm_fds fds;
+  grpc_error* error = GRPC_ERROR_NONE;
+  if (!ReceiveSegment(grpc_fd_wrapped_fd(socket_fd_), &fds, &error)) {
+    // The read callback holds a ref to the handshaker.
+    Ref().release();
+    grpc_fd_notify_on_read(socket_fd_, &on_readable_);
+    return;
+  }
+  if (error == GRPC_ERROR_NONE) {
+    error = grpc_shm_endpoint_create(&fds, 1, args_->endpoint,
+                                     &args_->endpoint);
+  }
+  FinishLocked(error);
+}
+
+void ShmHandshaker::OnReadable(void* arg, grpc_error* error) {
+  auto* handshaker = static_cast<ShmHandshaker*>(arg);
+  {
+    MutexLock lock(&handshaker->mu_);
+    if (error != GRPC_ERROR_NONE || handshaker->is_shutdown_) {
+      handshaker->FinishLocked(GRPC_ERROR_REF(error));
+    } else {
+      handshaker->TryReceiveLocked();
+    }
+  }
+  handshaker->Unref();
+}
+
+void ShmHandshaker::Shutdown(grpc_error* why) {
+  {
+    MutexLock lock(&mu_);
+    if (!is_shutdown_) {
+      is_shutdown_ = true;
+      if (socket_fd_ != nullptr) {
+        grpc_fd_shutdown(socket_fd_, GRPC_ERROR_REF(why));
+      }
+      grpc_endpoint_shutdown(args_->endpoint, GRPC_ERROR_REF(why));
+      CleanupArgsForFailureLocked();
+    }
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+void ShmHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
+                                grpc_closure* on_handshake_done,
+                                HandshakerArgs* args) {
+  if (!grpc_channel_arg_get_bool(
+          grpc_channel_args_find(args->args, GRPC_ARG_SHM_TRANSPORT),
+          false)) {
+    // Set shutdown to true so that subsequent calls to Shutdown() do
+    // nothing.
+    {
+      MutexLock lock(&mu_);
+      is_shutdown_ = true;
+    }
+    ExecCtx::Run(DEBUG_LOCATION, on_handshake_done, GRPC_ERROR_NONE);
+    return;
+  }
+  MutexLock lock(&mu_);
+  args_ = args;
+  on_handshake_done_ = on_handshake_done;
+  int fd = grpc_endpoint_get_fd(args->endpoint);
+  if (fd < 0) {
+    FinishLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared memory needs a Unix socket to set up"));
+    return;
+  }
+  if (is_client_) {
+    size_t ring_size = grpc_channel_arg_get_integer(
+        grpc_channel_args_find(args->args, GRPC_ARG_SHM_RING_SIZE),
+        {GRPC_SHM_DEFAULT_RING_SIZE, 0, INT_MAX});
+    grpc_shm_fds fds;
+    grpc_error* error = grpc_shm_fds_create(ring_size, &fds);
+    if (error == GRPC_ERROR_NONE) {
+      error = SendSegment(fd, &fds);
+      if (error == GRPC_ERROR_NONE) {
+        error = grpc_shm_endpoint_create(&fds, 0, args->endpoint,
+                                         &args->endpoint);
+      } else {
+        grpc_shm_fds_close(&fds);
+      }
+    }
+    FinishLocked(error);
+    return;
+  }
+  int socket_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (socket_fd < 0) {
+    FinishLocked(GRPC_OS_ERROR(errno, "fcntl"));
+    return;
+  }
+  socket_fd_ = grpc_fd_create(socket_fd, "shm_handshake", false);
+  grpc_pollset_set_add_fd(interested_parties_, socket_fd_);
+  GRPC_CLOSURE_INIT(&on_readable_, &ShmHandshaker::OnReadable, this,
+                    grpc_schedule_on_exec_ctx);
+  TryReceiveLocked();
+}
+
+//
+// handshaker factory
+//
+
+class ShmHandshakerFactory : public HandshakerFactory {
+ public:
+  explicit ShmHandshakerFactory(bool is_client) : is_client_(is_client) {}
+  void AddHandshakers(const grpc_channel_args* /*args*/,
+                      grpc_pollset_set* interested_parties,
+                      HandshakeManager* handshake_mgr) override {
+    handshake_mgr->Add(
+        MakeRefCounted<ShmHandshaker>(is_client_, interested_parties));
+  }
+  ~ShmHandshakerFactory() override = default;
+
+ private:
+  const bool is_client_;
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_shm_register_handshaker_factories() {
+  using namespace grpc_core;
+  // Ahead of the security handshakers, which then run over shared memory.
+  HandshakerRegistry::RegisterHandshakerFactory(
+      true /* at_start */, HANDSHAKER_CLIENT,
+      MakeUnique<ShmHandshakerFactory>(true));
+  HandshakerRegistry::RegisterHandshakerFactory(
+      true /* at_start */, HANDSHAKER_SERVER,
+      MakeUnique<ShmHandshakerFactory>(false));
+}
+
+#else /* GRPC_SHM_TRANSPORT */
+
+// Without shared memory support both sides stay on the Unix socket.
+void grpc_shm_register_handshaker_factories() {}
+
+#endif /* GRPC_SHM_TRANSPORT */
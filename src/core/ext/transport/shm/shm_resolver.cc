@@ -0,0 +1,126 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_transport.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_HAVE_UNIX_SOCKET
+
+#include <string.h>
+
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/ext/filters/client_channel/resolver_registry.h"
+#include "src/core/ext/filters/client_channel/server_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/resolve_address.h"
+#include "src/core/lib/iomgr/unix_sockets_posix.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Resolves "shm:path" to the Unix socket at path, and asks the subchannels
+// to move onto shared memory once connected.
+class ShmResolver : public Resolver {
+ public:
+  ShmResolver(ServerAddressList addresses, ResolverArgs args)
+      : Resolver(args.combiner, std::move(args.result_handler)),
+        addresses_(std::move(addresses)) {
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_SHM_TRANSPORT), 1);
+    channel_args_ = grpc_channel_args_copy_and_add(args.args, &arg, 1);
+  }
+
+  ~ShmResolver() override { grpc_channel_args_destroy(channel_args_); }
+
+  void StartLocked() override {
+    Result result;
+    result.addresses = std::move(addresses_);
+    // TODO(roth): Use std::move() once channel args is converted to C++.
+    result.args = channel_args_;
+    channel_args_ = nullptr;
+    result_handler()->ReturnResult(std::move(result));
+  }
+
+  void ShutdownLocked() override {}
+
+ private:
+  ServerAddressList addresses_;
+  grpc_channel_args* channel_args_ = nullptr;
+};
+
+bool ParseUri(const grpc_uri* uri, ServerAddressList* addresses) {
+  if (strcmp(uri->authority, "") != 0) {
+    gpr_log(GPR_ERROR, "authority-based URIs not supported by the shm scheme");
+    return false;
+  }
+  grpc_resolved_addresses* resolved = nullptr;
+  grpc_error* error = grpc_resolve_unix_domain_address(uri->path, &resolved);
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+    GRPC_ERROR_UNREF(error);
+    return false;
+  }
+  if (addresses != nullptr) {
+    for (size_t i = 0; i < resolved->naddrs; i++) {
+      addresses->emplace_back(resolved->addrs[i], nullptr /* args */);
+    }
+  }
+  grpc_resolved_addresses_destroy(resolved);
+  return true;
+}
+
+class ShmResolverFactory : public ResolverFactory {
+ public:
+  bool IsValidUri(const grpc_uri* uri) const override {
+    return ParseUri(uri, nullptr);
+  }
+
+  OrphanablePtr<Resolver> CreateResolver(ResolverArgs args) const override {
+    ServerAddressList addresses;
+    if (!ParseUri(args.uri, &addresses)) return nullptr;
+    return MakeOrphanable<ShmResolver>(std::move(addresses), std::move(args));
+  }
+
+  grpc_core::UniquePtr<char> GetDefaultAuthority(
+      grpc_uri* /*uri*/) const override {
+    return grpc_core::UniquePtr<char>(gpr_strdup("localhost"));
+  }
+
+  const char* scheme() const override { return "shm"; }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_resolver_shm_init() {
+  grpc_core::ResolverRegistry::Builder::RegisterResolverFactory(
+      grpc_core::MakeUnique<grpc_core::ShmResolverFactory>());
+}
+
+#else /* GRPC_HAVE_UNIX_SOCKET */
+
+void grpc_resolver_shm_init() {}
+
+#endif /* GRPC_HAVE_UNIX_SOCKET */
@@ -0,0 +1,116 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+
+#include <string.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+ShmRing::ShmRing(void* base, size_t size)
+    : header_(static_cast<ShmRingHeader*>(base)),
+      data_(static_cast<uint8_t*>(base) + sizeof(ShmRingHeader)),
+      size_(size) {
+  GPR_ASSERT(size > 0 && (size & (size - 1)) == 0);
+}
+
+// The counters below are clamped to the ring's size, so a peer writing
+// garbage into the header can corrupt the stream but never make us touch
+// memory outside the ring.
+
+size_t ShmRing::WritableBytes() const {
+  uint64_t head = header_->head.load(std::memory_order_seq_cst);
+  uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+  uint64_t used = tail - head;
+  return used >= size_ ? 0 : size_ - static_cast<size_t>(used);
+}
+
+size_t ShmRing::ReadableBytes() const {
+  uint64_t head = header_->head.load(std::memory_order_relaxed);
+  uint64_t tail = header_->tail.load(std::memory_order_seq_cst);
+  uint64_t used = tail - head;
+  return used >= size_ ? size_ : static_cast<size_t>(used);
+}
+
+size_t ShmRing::Write(const uint8_t* data, size_t length) {
+  length = GPR_MIN(length, WritableBytes());
+  if (length == 0) return 0;
+  uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+  size_t offset = static_cast<size_t>(tail & (size_ - 1));
+  size_t first = GPR_MIN(length, size_ - offset);
+  memcpy(data_ + offset, data, first);
+  memcpy(data_, data + first, length - first);
+  header_->tail.store(tail + length, std::memory_order_seq_cst);
+  return length;
+}
+
+size_t ShmRing::Read(uint8_t* data, size_t length) {
+  length = GPR_MIN(length, ReadableBytes());
+  if (length == 0) return 0;
+  uint64_t head = header_->head.load(std::memory_order_relaxed);
+  size_t offset = static_cast<size_t>(head & (size_ - 1));
+  size_t first = GPR_MIN(length, size_ - offset);
+  memcpy(data, data_ + offset, first);
+  memcpy(data + first, data_, length - first);
+  header_->head.store(head + length, std::memory_order_seq_cst);
+  return length;
+}
+
+bool ShmRing::WriterPrepareWait() {
+  header_->writer_waiting.store(1, std::memory_order_seq_cst);
+  return WritableBytes() == 0 && !reader_closed();
+}
+
+bool ShmRing::ReaderPrepareWait() {
+  header_->reader_waiting.store(1, std::memory_order_seq_cst);
+  return ReadableBytes() == 0 && !writer_closed();
+}
+
+bool ShmRing::TakeReaderWaiting() {
+  return header_->reader_waiting.load(std::memory_order_seq_cst) != 0 &&
+         header_->reader_waiting.exchange(0, std::memory_order_seq_cst) != 0;
+}
+
+bool ShmRing::TakeWriterWaiting() {
+  return header_->writer_waiting.load(std::memory_order_seq_cst) != 0 &&
+         header_->writer_waiting.exchange(0, std::memory_order_seq_cst) != 0;
+}
+
+void ShmRing::CloseWriter() {
+  header_->writer_closed.store(1, std::memory_order_seq_cst);
+}
+
+void ShmRing::CloseReader() {
+  header_->reader_closed.store(1, std::memory_order_seq_cst);
+}
+
+bool ShmRing::reader_closed() const {
+  return header_->reader_closed.load(std::memory_order_seq_cst) != 0;
+}
+
+bool ShmRing::writer_closed() const {
+  return header_->writer_closed.load(std::memory_order_seq_cst) != 0;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+namespace grpc_core {
+
+// The shared header of a single-producer single-consumer byte ring. It lives
+// in memory mapped by two processes, so each side keeps its fields on its
+// own cache line and neither trusts what the other wrote.
+struct ShmRingHeader {
+  // Written by the reader.
+  alignas(64) std::atomic<uint64_t> head;
+  std::atomic<uint32_t> reader_waiting;
+  std::atomic<uint32_t> reader_closed;
+  // Written by the writer.
+  alignas(64) std::atomic<uint64_t> tail;
+  std::atomic<uint32_t> writer_waiting;
+  std::atomic<uint32_t> writer_closed;
+};
+
+// One side's view of a ring. head and tail only grow, and are taken modulo
+// the ring's size, a power of two.
+//
+// Each side blocks on an eventfd of its own. Before blocking it marks
+// itself waiting and checks the ring once more; after moving data the other
+// side signals the eventfd if it finds the mark. Both use sequentially
+// consistent operations, so one of them always sees the other.
+class ShmRing {
+ public:
+  // Bytes of the segment taken by a ring holding \a size bytes of data.
+  static size_t SpaceFor(size_t size) { return sizeof(ShmRingHeader) + size; }
+
+  ShmRing() = default;
+  // \a base points at SpaceFor(size) bytes of the segment.
+  ShmRing(void* base, size_t size);
+
+  // Writer side. Copies up to \a length bytes in and returns how many fit.
+  size_t Write(const uint8_t* data, size_t length);
+  // Returns true if the ring is still full after marking the writer waiting.
+  bool WriterPrepareWait();
+  // Returns true if the reader was waiting, clearing its mark.
+  bool TakeReaderWaiting();
+  void CloseWriter();
+  bool reader_closed() const;
+
+  // Reader side. Copies up to \a length bytes out and returns how many
+  // there were.
+  size_t Read(uint8_t* data, size_t length);
+  size_t ReadableBytes() const;
+  // Returns true if the ring is still empty and open after marking the
+  // reader waiting.
+  bool ReaderPrepareWait();
+  // Returns true if the writer was waiting, clearing its mark.
+  bool TakeWriterWaiting();
+  void CloseReader();
+  bool writer_closed() const;
+
+ private:
+  size_t WritableBytes() const;
+
+  ShmRingHeader* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H */
@@ -0,0 +1,39 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+
+#include <grpc/support/port_platform.h>
+
+/* "shm:path" targets and listening addresses connect over the Unix socket
+   at path, then move the HTTP/2 stream onto shared memory rings handed over
+   that socket. Where shared memory is not supported, both sides stay on the
+   socket. */
+
+/* Set by the shm resolver and by servers listening on shm addresses. */
+#define GRPC_ARG_SHM_TRANSPORT "grpc.internal.shm_transport"
+/* Bytes in each direction's ring, a power of two. Set by the client. */
+#define GRPC_ARG_SHM_RING_SIZE "grpc.shm_ring_size"
+
+#define GRPC_SHM_DEFAULT_RING_SIZE (4 * 1024 * 1024)
+
+void grpc_shm_register_handshaker_factories();
+void grpc_resolver_shm_init();
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H */
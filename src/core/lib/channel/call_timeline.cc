@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/channel/call_timeline.h"
+
+#include <new>
+
+#include <grpc/support/time.h>
+
+namespace grpc_core {
+
+namespace {
+
+constexpr size_t kRingSize = 1024;
+
+// A ring slot is guarded by a sequence lock: its sequence is odd while a
+// writer fills it, and readers skip the records they see half written.
+struct Slot {
+  std::atomic<uint64_t> seq{0};
+  std::atomic<uint64_t> index{0};
+  std::atomic<bool> is_client{false};
+  std::atomic<int64_t> stage_ns[CallTimeline::kNumStages];
+};
+
+Slot g_ring[kRingSize];
+std::atomic<uint64_t> g_next_index{0};
+std::atomic<uint32_t> g_sample_one_in{0};
+std::atomic<uint32_t> g_sample_counter{0};
+
+int64_t NowNanos(gpr_timespec now) {
+  return static_cast<int64_t>(now.tv_sec) * GPR_NS_PER_SEC + now.tv_nsec;
+}
+
+void PublishRecord(const CallTimelineRecord& record) {
+  uint64_t index = g_next_index.fetch_add(1, std::memory_order_relaxed);
+  Slot* slot = &g_ring[index % kRingSize];
+  uint64_t seq = slot->seq.load(std::memory_order_relaxed);
+  // A writer a lap behind still holds the slot: drop the record rather than
+  // wait for it. Readers skip the index as overwritten.
+  if ((seq & 1) != 0 ||
+      !slot->seq.compare_exchange_strong(seq, seq + 1,
+                                         std::memory_order_relaxed)) {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->index.store(index, std::memory_order_relaxed);
+  slot->is_client.store(record.is_client, std::memory_order_relaxed);
+  for (int i = 0; i < CallTimeline::kNumStages; i++) {
+    slot->stage_ns[i].store(record.stage_ns[i], std::memory_order_relaxed);
+  }
+  slot->seq.store(seq + 2, std::memory_order_release);
+}
+
+// Returns false if the slot no longer, or not yet, holds record \a index.
+bool ReadRecord(uint64_t index, CallTimelineRecord* record) {
+  const Slot& slot = g_ring[index % kRingSize];
+  uint64_t seq = slot.seq.load(std::memory_order_acquire);
+  if (seq == 0 || (seq & 1) != 0) return false;
+  record->index = slot.index.load(std::memory_order_relaxed);
+  record->is_client = slot.is_client.load(std::memory_order_relaxed);
+  for (int i = 0; i < CallTimeline::kNumStages; i++) {
+    record->stage_ns[i] = slot.stage_ns[i].load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot.seq.load(std::memory_order_relaxed) == seq &&
+         record->index == index;
+}
+
+}  // namespace
+
+CallTimeline::CallTimeline(grpc_call_context_element* context, bool is_client)
+    : is_client_(is_client) {
+  for (int i = 0; i < kNumStages; i++) {
+    stage_ns_[i].store(0, std::memory_order_relaxed);
+  }
+  Mark(kCreated);
+  // The first write is timed by the transport's write tracing; turn it on
+  // unless the application already has.
+  grpc_call_context_element* write_timestamps =
+      &context[GRPC_CONTEXT_WRITE_TIMESTAMPS];
+  if (write_timestamps->value == nullptr) {
+    write_timestamps->value = new CallWriteTimestamps();
+    write_timestamps->destroy = CallWriteTimestamps::Destroy;
+  }
+  write_timestamps_ =
+      static_cast<CallWriteTimestamps*>(write_timestamps->value)->Ref();
+}
+
+bool CallTimeline::MaybeStart(Arena* arena,
+                              grpc_call_context_element* context,
+                              bool is_client) {
+  uint32_t one_in = g_sample_one_in.load(std::memory_order_relaxed);
+  if (GPR_LIKELY(one_in == 0)) return false;
+  if (g_sample_counter.fetch_add(1, std::memory_order_relaxed) % one_in != 0) {
+    return false;
+  }
+  CallTimeline* timeline = new (arena->Alloc(sizeof(CallTimeline)))
+      CallTimeline(context, is_client);
+  context[GRPC_CONTEXT_CALL_TIMELINE].value = timeline;
+  context[GRPC_CONTEXT_CALL_TIMELINE].destroy = Publish;
+  return true;
+}
+
+void CallTimeline::SetSampling(uint32_t one_in) {
+  g_sample_one_in.store(one_in, std::memory_order_relaxed);
+}
+
+void CallTimeline::Mark(Stage stage) {
+  if (stage_ns_[stage].load(std::memory_order_relaxed) != 0) return;
+  int64_t unset = 0;
+  stage_ns_[stage].compare_exchange_strong(
+      unset, NowNanos(gpr_now(GPR_CLOCK_REALTIME)), std::memory_order_relaxed);
+}
+
+void CallTimeline::Publish(void* arg) {
+  CallTimeline* timeline = static_cast<CallTimeline*>(arg);
+  // Reports for the last writes may come back after the call is gone; the
+  // first write's is usually in by now.
+  Timestamps first_write;
+  if (timeline->write_timestamps_->GetFirst(&first_write)) {
+    int64_t unset = 0;
+    timeline->stage_ns_[kFirstByteWritten].compare_exchange_strong(
+        unset, NowNanos(first_write.sendmsg_time.time),
+        std::memory_order_relaxed);
+  }
+  CallTimelineRecord record;
+  record.index = 0;
+  record.is_client = timeline->is_client_;
+  for (int i = 0; i < kNumStages; i++) {
+    record.stage_ns[i] =
+        timeline->stage_ns_[i].load(std::memory_order_relaxed);
+  }
+  PublishRecord(record);
+  // The memory belongs to the call's arena.
+  timeline->~CallTimeline();
+}
+
+size_t CollectCallTimelines(uint64_t* cursor, CallTimelineRecord* out,
+                            size_t max_records) {
+  uint64_t end = g_next_index.load(std::memory_order_acquire);
+  uint64_t index = *cursor;
+  if (end > kRingSize && index < end - kRingSize) index = end - kRingSize;
+  size_t count = 0;
+  for (; index < end && count < max_records; index++) {
+    if (ReadRecord(index, &out[count])) count++;
+  }
+  *cursor = index;
+  return count;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,112 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_CHANNEL_CALL_TIMELINE_H
+#define GRPC_CORE_LIB_CHANNEL_CALL_TIMELINE_H
+
+#include <grpc/impl/codegen/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+
+namespace grpc_core {
+
+/// Times at which a sampled call went through the stages of its life. A
+/// timeline is attached to the call context at GRPC_CONTEXT_CALL_TIMELINE
+/// when the call is created and published to a process-wide ring of
+/// CallTimelineRecords when the call is destroyed.
+///
+/// Stages are stamped from whichever thread reaches them; the first stamp of
+/// a stage wins, so retries and later messages do not move it.
+class CallTimeline {
+ public:
+  enum Stage {
+    kCreated = 0,
+    /// The client channel picked a subchannel for the call.
+    kPickComplete,
+    /// The transport opened the call's stream.
+    kStreamStarted,
+    /// The kernel took the first bytes of the call. Only stamped on platforms
+    /// with TX timestamps, once their report has come back.
+    kFirstByteWritten,
+    /// Client calls only: server calls are created with their initial
+    /// metadata.
+    kInitialMetadataReceived,
+    /// The first message received was parsed (and inflated).
+    kFirstMessageReceived,
+    /// The batch that finished the call was handed to the application.
+    kCompletionDelivered,
+    kNumStages
+  };
+
+  /// Starts a timeline for one call in every N (see SetSampling), allocated
+  /// on \a arena. Returns whether the call was sampled.
+  static bool MaybeStart(Arena* arena, grpc_call_context_element* context,
+                         bool is_client);
+
+  /// Stamps \a stage on the timeline in \a context, if there is one.
+  static void Mark(grpc_call_context_element* context, Stage stage) {
+    if (context == nullptr) return;
+    auto* timeline =
+        static_cast<CallTimeline*>(context[GRPC_CONTEXT_CALL_TIMELINE].value);
+    if (timeline != nullptr) timeline->Mark(stage);
+  }
+
+  /// Makes one call in \a one_in start a timeline; 0 turns sampling off.
+  static void SetSampling(uint32_t one_in);
+
+  void Mark(Stage stage);
+
+ private:
+  CallTimeline(grpc_call_context_element* context, bool is_client);
+
+  // Publishes the timeline; the context element's destroy function.
+  static void Publish(void* arg);
+
+  const bool is_client_;
+  // Realtime nanoseconds, to compare with the kernel's TX timestamps; 0 for
+  // stages not reached.
+  std::atomic<int64_t> stage_ns_[kNumStages];
+  RefCountedPtr<CallWriteTimestamps> write_timestamps_;
+};
+
+/// A published timeline.
+struct CallTimelineRecord {
+  /// Position of the record in the sequence of published timelines.
+  uint64_t index;
+  bool is_client;
+  int64_t stage_ns[CallTimeline::kNumStages];
+};
+
+/// Copies the records published since \a *cursor (0 for the oldest still
+/// kept) to \a out, up to \a max_records, and advances \a *cursor past them.
+/// Records overwritten before they were read are skipped. Returns the number
+/// of records copied.
+size_t CollectCallTimelines(uint64_t* cursor, CallTimelineRecord* out,
+                            size_t max_records);
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_CHANNEL_CALL_TIMELINE_H */
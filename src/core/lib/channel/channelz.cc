@@ -24,6 +24,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -106,7 +107,8 @@ char* BaseNode::RenderJsonString() {
 // CallCountingHelper
 //
 
-CallCountingHelper::CallCountingHelper() {
+CallCountingHelper::CallCountingHelper(uint32_t sampling_period)
+    : sampling_period_(GPR_MAX(1, sampling_period)) {
   num_cores_ = GPR_MAX(1, gpr_cpu_num_cores());
   per_cpu_counter_data_storage_.reserve(num_cores_);
   for (size_t i = 0; i < num_cores_; ++i) {
@@ -114,12 +116,21 @@ CallCountingHelper::CallCountingHelper() {
   }
 }
 
-void CallCountingHelper::RecordCallStarted() {
+bool CallCountingHelper::RecordCallStarted() {
   AtomicCounterData& data =
       per_cpu_counter_data_storage_[ExecCtx::Get()->starting_cpu()];
+  if (sampling_period_ > 1) {
+    // A plain load and store: a call counted twice or missed by a racing
+    // thread only skews the sample.
+    uint32_t seen = data.calls_seen.Load(MemoryOrder::RELAXED);
+    data.calls_seen.Store(seen + 1, MemoryOrder::RELAXED);
+    if (seen % sampling_period_ != 0) return false;
+  }
   data.calls_started.FetchAdd(1, MemoryOrder::RELAXED);
-  data.last_call_started_cycle.Store(gpr_get_cycle_counter(),
-                                     MemoryOrder::RELAXED);
+  // The exec_ctx caches Now(), so this rarely reads the clock.
+  data.last_call_started_millis.Store(ExecCtx::Get()->Now(),
+                                      MemoryOrder::RELAXED);
+  return true;
 }
 
 void CallCountingHelper::RecordCallFailed() {
@@ -142,13 +153,16 @@ void CallCountingHelper::CollectData(CounterData* out) {
             MemoryOrder::RELAXED);
     out->calls_failed += per_cpu_counter_data_storage_[core].calls_failed.Load(
         MemoryOrder::RELAXED);
-    const gpr_cycle_counter last_call =
-        per_cpu_counter_data_storage_[core].last_call_started_cycle.Load(
+    const grpc_millis last_call =
+        per_cpu_counter_data_storage_[core].last_call_started_millis.Load(
             MemoryOrder::RELAXED);
-    if (last_call > out->last_call_started_cycle) {
-      out->last_call_started_cycle = last_call;
+    if (last_call > out->last_call_started_millis) {
+      out->last_call_started_millis = last_call;
     }
   }
+  out->calls_started *= sampling_period_;
+  out->calls_succeeded *= sampling_period_;
+  out->calls_failed *= sampling_period_;
 }
 
 void CallCountingHelper::PopulateCallCounts(grpc_json* json) {
@@ -168,9 +182,8 @@ void CallCountingHelper::PopulateCallCounts(grpc_json* json) {
         json, json_iterator, "callsFailed", data.calls_failed);
   }
   if (data.calls_started != 0) {
-    gpr_timespec ts = gpr_convert_clock_type(
-        gpr_cycle_counter_to_time(data.last_call_started_cycle),
-        GPR_CLOCK_REALTIME);
+    gpr_timespec ts = grpc_millis_to_timespec(data.last_call_started_millis,
+                                              GPR_CLOCK_REALTIME);
     json_iterator =
         grpc_json_create_child(json_iterator, json, "lastCallStartedTimestamp",
                                gpr_format_timespec(ts), GRPC_JSON_STRING, true);
@@ -182,11 +195,12 @@ void CallCountingHelper::PopulateCallCounts(grpc_json* json) {
 //
 
 ChannelNode::ChannelNode(std::string target, size_t channel_tracer_max_nodes,
-                         intptr_t parent_uuid)
+                         intptr_t parent_uuid, uint32_t call_sampling_period)
     : BaseNode(parent_uuid == 0 ? EntityType::kTopLevelChannel
                                 : EntityType::kInternalChannel,
                target),
       target_(std::move(target)),
+      call_counter_(call_sampling_period),
       trace_(channel_tracer_max_nodes),
       parent_uuid_(parent_uuid) {}
 
@@ -316,8 +330,11 @@ void ChannelNode::RemoveChildSubchannel(intptr_t child_uuid) {
 // ServerNode
 //
 
-ServerNode::ServerNode(grpc_server* /*server*/, size_t channel_tracer_max_nodes)
-    : BaseNode(EntityType::kServer, ""), trace_(channel_tracer_max_nodes) {}
+ServerNode::ServerNode(grpc_server* /*server*/, size_t channel_tracer_max_nodes,
+                       uint32_t call_sampling_period)
+    : BaseNode(EntityType::kServer, ""),
+      call_counter_(call_sampling_period),
+      trace_(channel_tracer_max_nodes) {}
 
 ServerNode::~ServerNode() {}
 
@@ -481,10 +498,12 @@ void PopulateSocketAddressJson(grpc_json* json, const char* name,
 
 }  // namespace
 
-SocketNode::SocketNode(std::string local, std::string remote, std::string name)
+SocketNode::SocketNode(std::string local, std::string remote, std::string name,
+                       RefCountedPtr<CombinerProfile> combiner_profile)
     : BaseNode(EntityType::kSocket, std::move(name)),
       local_(std::move(local)),
-      remote_(std::move(remote)) {}
+      remote_(std::move(remote)),
+      combiner_profile_(std::move(combiner_profile)) {}
 
 void SocketNode::RecordStreamStartedFromLocal() {
   streams_started_.FetchAdd(1, MemoryOrder::RELAXED);
@@ -599,6 +618,46 @@ grpc_json* SocketNode::RenderJson() {
     json_iterator = grpc_json_add_number_string_child(
         json, json_iterator, "keepAlivesSent", keepalives_sent);
   }
+  grpc_json* options = nullptr;
+  grpc_json* option = nullptr;
+  // Takes ownership of name and value.
+  auto add_option = [&](char* name, char* value) {
+    if (options == nullptr) {
+      options = grpc_json_create_child(json_iterator, json, "option", nullptr,
+                                       GRPC_JSON_ARRAY, false);
+    }
+    option = grpc_json_create_child(option, options, nullptr, nullptr,
+                                    GRPC_JSON_OBJECT, false);
+    grpc_json* name_json = grpc_json_create_child(nullptr, option, "name",
+                                                  name, GRPC_JSON_STRING, true);
+    grpc_json_create_child(name_json, option, "value", value,
+                           GRPC_JSON_STRING, true);
+  };
+  if (combiner_profile_ != nullptr) {
+    char* name;
+    gpr_asprintf(&name, "grpc.combiner.%s", combiner_profile_->name());
+    add_option(name, combiner_profile_->Summary().release());
+  }
+  int64_t streams_waiting_for_concurrency =
+      streams_waiting_for_concurrency_.Load(MemoryOrder::RELAXED);
+  if (streams_waiting_for_concurrency != 0) {
+    char* value;
+    gpr_asprintf(&value, "%" PRId64, streams_waiting_for_concurrency);
+    add_option(gpr_strdup("grpc.streams_waiting_for_concurrency"), value);
+  }
+  int64_t streams_queued_for_concurrency =
+      streams_queued_for_concurrency_.Load(MemoryOrder::RELAXED);
+  if (streams_queued_for_concurrency != 0) {
+    char* value;
+    gpr_asprintf(&value, "%" PRId64, streams_queued_for_concurrency);
+    add_option(gpr_strdup("grpc.streams_queued_for_concurrency"), value);
+  }
+  int64_t transport_memory = transport_memory_.Load(MemoryOrder::RELAXED);
+  if (transport_memory != 0) {
+    char* value;
+    gpr_asprintf(&value, "%" PRId64, transport_memory);
+    add_option(gpr_strdup("grpc.transport_memory_bytes"), value);
+  }
   return top_level_json;
 }
 
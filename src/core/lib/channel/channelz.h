@@ -34,6 +34,7 @@
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
@@ -54,6 +55,11 @@
  * this default value. */
 #define GRPC_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE_DEFAULT 1024 * 4
 
+/** This is the default for how many calls channelz counts one call in. If
+ * GRPC_ARG_CHANNELZ_CALL_SAMPLING_PERIOD is set, it will override this default
+ * value. */
+#define GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT 1
+
 namespace grpc_core {
 
 namespace channelz {
@@ -115,11 +121,17 @@ class BaseNode : public RefCounted<BaseNode> {
 //   - track calls_{started,succeeded,failed}
 //   - track last_call_started_timestamp
 //   - perform rendering of the above items
+//
+// With a sampling period of N, only one call in N is counted and the counts
+// are scaled back up by N when rendered. Callers must only record the
+// outcome of the calls for which RecordCallStarted() returned true.
 class CallCountingHelper {
  public:
-  CallCountingHelper();
+  explicit CallCountingHelper(
+      uint32_t sampling_period = GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT);
 
-  void RecordCallStarted();
+  // Returns whether the call is sampled.
+  bool RecordCallStarted();
   void RecordCallFailed();
   void RecordCallSucceeded();
 
@@ -138,23 +150,27 @@ class CallCountingHelper {
         : calls_started(that.calls_started.Load(MemoryOrder::RELAXED)),
           calls_succeeded(that.calls_succeeded.Load(MemoryOrder::RELAXED)),
           calls_failed(that.calls_failed.Load(MemoryOrder::RELAXED)),
-          last_call_started_cycle(
-              that.last_call_started_cycle.Load(MemoryOrder::RELAXED)) {}
+          last_call_started_millis(
+              that.last_call_started_millis.Load(MemoryOrder::RELAXED)),
+          calls_seen(that.calls_seen.Load(MemoryOrder::RELAXED)) {}
 
     Atomic<int64_t> calls_started{0};
     Atomic<int64_t> calls_succeeded{0};
     Atomic<int64_t> calls_failed{0};
-    Atomic<gpr_cycle_counter> last_call_started_cycle{0};
+    Atomic<grpc_millis> last_call_started_millis{0};
+    // Calls started on this core, sampled or not. Only used to pick the
+    // sampled calls, so lost updates are harmless.
+    Atomic<uint32_t> calls_seen{0};
     // Make sure the size is exactly one cache line.
     uint8_t padding[GPR_CACHELINE_SIZE - 3 * sizeof(Atomic<intptr_t>) -
-                    sizeof(Atomic<gpr_cycle_counter>)];
+                    sizeof(Atomic<grpc_millis>) - sizeof(Atomic<uint32_t>)];
   } GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
 
   struct CounterData {
     int64_t calls_started = 0;
     int64_t calls_succeeded = 0;
     int64_t calls_failed = 0;
-    gpr_cycle_counter last_call_started_cycle = 0;
+    grpc_millis last_call_started_millis = 0;
   };
 
   // collects the sharded data into one CounterData struct.
@@ -163,13 +179,16 @@ class CallCountingHelper {
   // Really zero-sized, but 0-sized arrays are illegal on MSVC.
   InlinedVector<AtomicCounterData, 1> per_cpu_counter_data_storage_;
   size_t num_cores_ = 0;
+  const uint32_t sampling_period_;
 };
 
 // Handles channelz bookkeeping for channels
 class ChannelNode : public BaseNode {
  public:
   ChannelNode(std::string target, size_t channel_tracer_max_nodes,
-              intptr_t parent_uuid);
+              intptr_t parent_uuid,
+              uint32_t call_sampling_period =
+                  GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT);
 
   // Returns the string description of the given connectivity state.
   static const char* GetChannelConnectivityStateChangeString(
@@ -189,7 +208,7 @@ class ChannelNode : public BaseNode {
     trace_.AddTraceEventWithReference(severity, data,
                                       std::move(referenced_channel));
   }
-  void RecordCallStarted() { call_counter_.RecordCallStarted(); }
+  bool RecordCallStarted() { return call_counter_.RecordCallStarted(); }
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
 
@@ -231,7 +250,9 @@ class ChannelNode : public BaseNode {
 // Handles channelz bookkeeping for servers
 class ServerNode : public BaseNode {
  public:
-  ServerNode(grpc_server* server, size_t channel_tracer_max_nodes);
+  ServerNode(grpc_server* server, size_t channel_tracer_max_nodes,
+             uint32_t call_sampling_period =
+                 GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT);
 
   ~ServerNode() override;
 
@@ -257,7 +278,7 @@ class ServerNode : public BaseNode {
     trace_.AddTraceEventWithReference(severity, data,
                                       std::move(referenced_channel));
   }
-  void RecordCallStarted() { call_counter_.RecordCallStarted(); }
+  bool RecordCallStarted() { return call_counter_.RecordCallStarted(); }
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
 
@@ -272,7 +293,9 @@ class ServerNode : public BaseNode {
 // Handles channelz bookkeeping for sockets
 class SocketNode : public BaseNode {
  public:
-  SocketNode(std::string local, std::string remote, std::string name);
+  // If \a combiner_profile is set, it is rendered as a socket option.
+  SocketNode(std::string local, std::string remote, std::string name,
+             RefCountedPtr<CombinerProfile> combiner_profile = nullptr);
   ~SocketNode() override {}
 
   grpc_json* RenderJson() override;
@@ -290,6 +313,19 @@ class SocketNode : public BaseNode {
   void RecordKeepaliveSent() {
     keepalives_sent_.FetchAdd(1, MemoryOrder::RELAXED);
   }
+  // Streams that had to wait for the peer to allow more concurrent streams,
+  // rendered as socket options when non zero.
+  void RecordStreamQueuedForConcurrency() {
+    streams_queued_for_concurrency_.FetchAdd(1, MemoryOrder::RELAXED);
+  }
+  void SetStreamsWaitingForConcurrency(int64_t streams) {
+    streams_waiting_for_concurrency_.Store(streams, MemoryOrder::RELAXED);
+  }
+  // An estimate of the memory the transport holds for the connection,
+  // rendered as a socket option when non zero.
+  void SetTransportMemory(int64_t bytes) {
+    transport_memory_.Store(bytes, MemoryOrder::RELAXED);
+  }
 
   const std::string& remote() { return remote_; }
 
@@ -300,12 +336,16 @@ class SocketNode : public BaseNode {
   Atomic<int64_t> messages_sent_{0};
   Atomic<int64_t> messages_received_{0};
   Atomic<int64_t> keepalives_sent_{0};
+  Atomic<int64_t> streams_queued_for_concurrency_{0};
+  Atomic<int64_t> streams_waiting_for_concurrency_{0};
+  Atomic<int64_t> transport_memory_{0};
   Atomic<gpr_cycle_counter> last_local_stream_created_cycle_{0};
   Atomic<gpr_cycle_counter> last_remote_stream_created_cycle_{0};
   Atomic<gpr_cycle_counter> last_message_sent_cycle_{0};
   Atomic<gpr_cycle_counter> last_message_received_cycle_{0};
   std::string local_;
   std::string remote_;
+  RefCountedPtr<CombinerProfile> combiner_profile_;
 };
 
 // Handles channelz bookkeeping for listen sockets
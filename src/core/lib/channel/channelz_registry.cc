@@ -39,7 +39,7 @@ namespace {
 // singleton instance of the registry.
 ChannelzRegistry* g_channelz_registry = nullptr;
 
-const int kPaginationLimit = 100;
+const size_t kPaginationLimit = 100;
 
 }  // anonymous namespace
 
@@ -53,25 +53,28 @@ ChannelzRegistry* ChannelzRegistry::Default() {
 }
 
 void ChannelzRegistry::InternalRegister(BaseNode* node) {
-  MutexLock lock(&mu_);
-  node->uuid_ = ++uuid_generator_;
-  node_map_[node->uuid_] = node;
+  node->uuid_ = uuid_generator_.FetchAdd(1, MemoryOrder::RELAXED) + 1;
+  Shard* shard = ShardFor(node->uuid_);
+  MutexLock lock(&shard->mu);
+  shard->node_map[node->uuid_] = node;
 }
 
 void ChannelzRegistry::InternalUnregister(intptr_t uuid) {
   GPR_ASSERT(uuid >= 1);
-  MutexLock lock(&mu_);
-  GPR_ASSERT(uuid <= uuid_generator_);
-  node_map_.erase(uuid);
+  GPR_ASSERT(uuid <= uuid_generator_.Load(MemoryOrder::RELAXED));
+  Shard* shard = ShardFor(uuid);
+  MutexLock lock(&shard->mu);
+  shard->node_map.erase(uuid);
 }
 
 RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
-  MutexLock lock(&mu_);
-  if (uuid < 1 || uuid > uuid_generator_) {
+  if (uuid < 1 || uuid > uuid_generator_.Load(MemoryOrder::RELAXED)) {
     return nullptr;
   }
-  auto it = node_map_.find(uuid);
-  if (it == node_map_.end()) return nullptr;
+  Shard* shard = ShardFor(uuid);
+  MutexLock lock(&shard->mu);
+  auto it = shard->node_map.find(uuid);
+  if (it == shard->node_map.end()) return nullptr;
   // Found node.  Return only if its refcount is not zero (i.e., when we
   // know that there is no other thread about to destroy it).
   BaseNode* node = it->second;
@@ -79,33 +82,48 @@ RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
   return RefCountedPtr<BaseNode>(node);
 }
 
+void ChannelzRegistry::FindNodes(
+    BaseNode::EntityType type, intptr_t start_id, size_t max_nodes,
+    InlinedVector<RefCountedPtr<BaseNode>, 10>* nodes) {
+  // Each shard is locked in turn, and contributes at most max_nodes nodes,
+  // which are then merged. Nodes registered or unregistered meanwhile may or
+  // may not be seen, as with a single lock taken before or after them.
+  // Because the nodes have been reffed, they must be unreffed, but we can't
+  // unref while holding a lock, because this may lead to a deadlock.
+  InlinedVector<BaseNode*, 10> found;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard* shard = &shards_[i];
+    size_t num_found = 0;
+    MutexLock lock(&shard->mu);
+    for (auto it = shard->node_map.lower_bound(start_id);
+         it != shard->node_map.end() && num_found < max_nodes; ++it) {
+      BaseNode* node = it->second;
+      if (node->type() == type && node->RefIfNonZero()) {
+        found.emplace_back(node);
+        ++num_found;
+      }
+    }
+  }
+  std::sort(found.data(), found.data() + found.size(),
+            [](const BaseNode* a, const BaseNode* b) {
+              return a->uuid() < b->uuid();
+            });
+  for (size_t i = 0; i < found.size(); ++i) {
+    RefCountedPtr<BaseNode> node(found[i]);
+    if (nodes->size() < max_nodes) nodes->emplace_back(std::move(node));
+  }
+}
+
 char* ChannelzRegistry::InternalGetTopChannels(intptr_t start_channel_id) {
   grpc_json* top_level_json = grpc_json_create(GRPC_JSON_OBJECT);
   grpc_json* json = top_level_json;
   grpc_json* json_iterator = nullptr;
+  // One more than the limit tells whether to set the "end" element.
   InlinedVector<RefCountedPtr<BaseNode>, 10> top_level_channels;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_channel_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      if (node->type() == BaseNode::EntityType::kTopLevelChannel &&
-          node->RefIfNonZero()) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (top_level_channels.size() == kPaginationLimit) {
-          node_after_pagination_limit.reset(node);
-          break;
-        }
-        top_level_channels.emplace_back(node);
-      }
-    }
-  }
+  FindNodes(BaseNode::EntityType::kTopLevelChannel, start_channel_id,
+            kPaginationLimit + 1, &top_level_channels);
+  const bool reached_end = top_level_channels.size() <= kPaginationLimit;
+  if (!reached_end) top_level_channels.pop_back();
   if (!top_level_channels.empty()) {
     // create list of channels
     grpc_json* array_parent = grpc_json_create_child(
@@ -116,7 +134,7 @@ char* ChannelzRegistry::InternalGetTopChannels(intptr_t start_channel_id) {
           grpc_json_link_child(array_parent, channel_json, json_iterator);
     }
   }
-  if (node_after_pagination_limit == nullptr) {
+  if (reached_end) {
     grpc_json_create_child(nullptr, json, "end", nullptr, GRPC_JSON_TRUE,
                            false);
   }
@@ -129,29 +147,12 @@ char* ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
   grpc_json* top_level_json = grpc_json_create(GRPC_JSON_OBJECT);
   grpc_json* json = top_level_json;
   grpc_json* json_iterator = nullptr;
+  // One more than the limit tells whether to set the "end" element.
   InlinedVector<RefCountedPtr<BaseNode>, 10> servers;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_server_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      if (node->type() == BaseNode::EntityType::kServer &&
-          node->RefIfNonZero()) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (servers.size() == kPaginationLimit) {
-          node_after_pagination_limit.reset(node);
-          break;
-        }
-        servers.emplace_back(node);
-      }
-    }
-  }
+  FindNodes(BaseNode::EntityType::kServer, start_server_id,
+            kPaginationLimit + 1, &servers);
+  const bool reached_end = servers.size() <= kPaginationLimit;
+  if (!reached_end) servers.pop_back();
   if (!servers.empty()) {
     // create list of servers
     grpc_json* array_parent = grpc_json_create_child(
@@ -162,7 +163,7 @@ char* ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
           grpc_json_link_child(array_parent, server_json, json_iterator);
     }
   }
-  if (node_after_pagination_limit == nullptr) {
+  if (reached_end) {
     grpc_json_create_child(nullptr, json, "end", nullptr, GRPC_JSON_TRUE,
                            false);
   }
@@ -173,9 +174,10 @@ char* ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
 
 void ChannelzRegistry::InternalLogAllEntities() {
   InlinedVector<RefCountedPtr<BaseNode>, 10> nodes;
-  {
-    MutexLock lock(&mu_);
-    for (auto& p : node_map_) {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard* shard = &shards_[i];
+    MutexLock lock(&shard->mu);
+    for (auto& p : shard->node_map) {
       BaseNode* node = p.second;
       if (node->RefIfNonZero()) {
         nodes.emplace_back(node);
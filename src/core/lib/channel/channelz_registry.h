@@ -25,6 +25,8 @@
 
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/gprpp/sync.h"
 
@@ -85,10 +87,27 @@ class ChannelzRegistry {
 
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  // Returns, in uuid order, refs to at most max_nodes nodes of the given type
+  // whose uuid is at least start_id.
+  void FindNodes(BaseNode::EntityType type, intptr_t start_id,
+                 size_t max_nodes,
+                 InlinedVector<RefCountedPtr<BaseNode>, 10>* nodes);
+
+  // Nodes are spread over shards by uuid, so that registering and
+  // unregistering nodes only contends with nodes of the same shard.
+  static const size_t kNumShards = 16;
+  struct Shard {
+    // protects node_map
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map;
+  };
+
+  Shard* ShardFor(intptr_t uuid) {
+    return &shards_[static_cast<size_t>(uuid) % kNumShards];
+  }
+
+  Shard shards_[kNumShards];
+  Atomic<intptr_t> uuid_generator_{0};
 };
 
 }  // namespace channelz
@@ -38,6 +38,24 @@ typedef enum {
   /// Holds a pointer to ServiceConfig::CallData associated with this call.
   GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA,
 
+  /// Value is a \a grpc_core::CallWriteTimestamps. If set, the transport
+  /// collects kernel timestamps for the writes of the call.
+  GRPC_CONTEXT_WRITE_TIMESTAMPS,
+
+  /// Value is a uintptr_t weight cast to a pointer, with no destroy function.
+  /// If set, the transport gives the call that many shares of the data it
+  /// writes while other calls on the connection have data to write too.
+  GRPC_CONTEXT_WRITE_WEIGHT,
+
+  /// Value is a uintptr_t limit plus one cast to a pointer, with no destroy
+  /// function. If set, the call fails messages that inflate to more than
+  /// limit bytes as soon as they do, rather than once they are decompressed.
+  GRPC_CONTEXT_MAX_RECV_MESSAGE_SIZE,
+
+  /// Value is a \a grpc_core::CallTimeline, set on sampled calls when they
+  /// are created.
+  GRPC_CONTEXT_CALL_TIMELINE,
+
   GRPC_CONTEXT_COUNT
 } grpc_context_index;
 
@@ -20,16 +20,172 @@
 
 #include "src/core/lib/compression/message_compress.h"
 
+#include <inttypes.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 
 #include <zlib.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 #define OUTPUT_BLOCK_SIZE 1024
+/* Incremental decompression sizes its first output block from the compressed
+   size, assuming messages inflate to about DECOMPRESSION_RATIO_HINT times
+   their compressed size, and doubles the size of the following blocks, so that
+   large messages are inflated into few slices. */
+#define DECOMPRESSION_RATIO_HINT 4
+#define MAX_OUTPUT_BLOCK_SIZE (64 * 1024)
+
+/* Setting up a zlib stream is expensive (a deflate stream allocates about
+   256KB), so streams are reset and kept for the next message rather than
+   torn down after each one. At most MAX_CACHED_STREAMS idle streams are kept
+   per kind of stream. */
+#define MAX_CACHED_STREAMS 4
+/* zlib levels go from -1 (zlib's default) to 9 */
+#define ZLIB_LEVEL_COUNT 11
+
+typedef struct {
+  z_stream* streams[MAX_CACHED_STREAMS];
+  size_t count;
+} stream_cache;
+
+static gpr_once g_cache_once = GPR_ONCE_INIT;
+static gpr_mu g_cache_mu;
+/* indexed by [gzip][zlib level + 1] */
+static stream_cache g_deflate_cache[2][ZLIB_LEVEL_COUNT];
+/* indexed by [gzip] */
+static stream_cache g_inflate_cache[2];
+
+static void init_cache(void) { gpr_mu_init(&g_cache_mu); }
+
+static z_stream* take_cached_stream(stream_cache* cache) {
+  gpr_once_init(&g_cache_once, init_cache);
+  z_stream* zs = nullptr;
+  gpr_mu_lock(&g_cache_mu);
+  if (cache->count > 0) {
+    zs = cache->streams[--cache->count];
+  }
+  gpr_mu_unlock(&g_cache_mu);
+  return zs;
+}
+
+/* Returns whether the cache took ownership of zs. */
+static bool put_cached_stream(stream_cache* cache, z_stream* zs) {
+  bool kept = false;
+  gpr_mu_lock(&g_cache_mu);
+  if (cache->count < MAX_CACHED_STREAMS) {
+    cache->streams[cache->count++] = zs;
+    kept = true;
+  }
+  gpr_mu_unlock(&g_cache_mu);
+  return kept;
+}
+
+struct grpc_compression_dictionaries {
+  gpr_refcount refs;
+  size_t count;
+  uint32_t* ids;
+  grpc_slice* dictionaries;
+};
+
+grpc_compression_dictionaries* grpc_compression_dictionaries_create(
+    const grpc_slice* dictionaries, size_t count) {
+  grpc_compression_dictionaries* result =
+      static_cast<grpc_compression_dictionaries*>(
+          gpr_malloc(sizeof(*result)));
+  gpr_ref_init(&result->refs, 1);
+  result->count = 0;
+  result->ids = static_cast<uint32_t*>(gpr_malloc(count * sizeof(uint32_t)));
+  result->dictionaries =
+      static_cast<grpc_slice*>(gpr_malloc(count * sizeof(grpc_slice)));
+  for (size_t i = 0; i < count; i++) {
+    GPR_ASSERT(GRPC_SLICE_LENGTH(dictionaries[i]) <= ~static_cast<uInt>(0));
+    uint32_t id = static_cast<uint32_t>(
+        adler32(adler32(0, nullptr, 0), GRPC_SLICE_START_PTR(dictionaries[i]),
+                static_cast<uInt> GRPC_SLICE_LENGTH(dictionaries[i])));
+    if (grpc_compression_dictionaries_find(result, id) != nullptr) {
+      gpr_log(GPR_ERROR, "compression dictionary %08x given twice: ignored",
+              id);
+      continue;
+    }
+    result->ids[result->count] = id;
+    result->dictionaries[result->count] =
+        grpc_slice_ref_internal(dictionaries[i]);
+    result->count++;
+  }
+  return result;
+}
+
+grpc_compression_dictionaries* grpc_compression_dictionaries_ref(
+    grpc_compression_dictionaries* dictionaries) {
+  gpr_ref(&dictionaries->refs);
+  return dictionaries;
+}
+
+void grpc_compression_dictionaries_unref(
+    grpc_compression_dictionaries* dictionaries) {
+  if (gpr_unref(&dictionaries->refs)) {
+    for (size_t i = 0; i < dictionaries->count; i++) {
+      grpc_slice_unref_internal(dictionaries->dictionaries[i]);
+    }
+    gpr_free(dictionaries->ids);
+    gpr_free(dictionaries->dictionaries);
+    gpr_free(dictionaries);
+  }
+}
+
+static void* dictionaries_copy(void* dictionaries) {
+  return grpc_compression_dictionaries_ref(
+      static_cast<grpc_compression_dictionaries*>(dictionaries));
+}
+
+static void dictionaries_destroy(void* dictionaries) {
+  grpc_compression_dictionaries_unref(
+      static_cast<grpc_compression_dictionaries*>(dictionaries));
+}
+
+static int dictionaries_cmp(void* a, void* b) { return GPR_ICMP(a, b); }
+
+const grpc_arg_pointer_vtable* grpc_compression_dictionaries_arg_vtable(void) {
+  static const grpc_arg_pointer_vtable vtable = {
+      dictionaries_copy, dictionaries_destroy, dictionaries_cmp};
+  return &vtable;
+}
+
+grpc_compression_dictionaries* grpc_compression_dictionaries_from_channel_args(
+    const grpc_channel_args* args) {
+  return grpc_channel_args_find_pointer<grpc_compression_dictionaries>(
+      args, GRPC_COMPRESSION_CHANNEL_DEFLATE_DICTIONARIES);
+}
+
+size_t grpc_compression_dictionaries_count(
+    const grpc_compression_dictionaries* dictionaries) {
+  return dictionaries->count;
+}
+
+uint32_t grpc_compression_dictionaries_id(
+    const grpc_compression_dictionaries* dictionaries, size_t index) {
+  GPR_DEBUG_ASSERT(index < dictionaries->count);
+  return dictionaries->ids[index];
+}
+
+const grpc_slice* grpc_compression_dictionaries_get(
+    const grpc_compression_dictionaries* dictionaries, size_t index) {
+  GPR_DEBUG_ASSERT(index < dictionaries->count);
+  return &dictionaries->dictionaries[index];
+}
+
+const grpc_slice* grpc_compression_dictionaries_find(
+    const grpc_compression_dictionaries* dictionaries, uint32_t id) {
+  for (size_t i = 0; i < dictionaries->count; i++) {
+    if (dictionaries->ids[i] == id) return &dictionaries->dictionaries[i];
+  }
+  return nullptr;
+}
 
 static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
                      grpc_slice_buffer* output,
@@ -87,20 +243,34 @@ static void* zalloc_gpr(void* /*opaque*/, unsigned int items,
 
 static void zfree_gpr(void* /*opaque*/, void* address) { gpr_free(address); }
 
+static z_stream* new_stream(void) {
+  z_stream* zs = static_cast<z_stream*>(gpr_zalloc(sizeof(*zs)));
+  zs->zalloc = zalloc_gpr;
+  zs->zfree = zfree_gpr;
+  return zs;
+}
+
 static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                         int gzip) {
-  z_stream zs;
+                         int gzip, int level, const grpc_slice* dictionary) {
+  stream_cache* cache = &g_deflate_cache[gzip][level + 1];
+  z_stream* zs = take_cached_stream(cache);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
+  if (zs == nullptr) {
+    zs = new_stream();
+    r = deflateInit2(zs, level, Z_DEFLATED, 15 | (gzip ? 16 : 0), 8,
+                     Z_DEFAULT_STRATEGY);
+    GPR_ASSERT(r == Z_OK);
+  }
+  /* a reset stream forgets its dictionary: set it for every message */
+  if (dictionary != nullptr) {
+    r = deflateSetDictionary(zs, GRPC_SLICE_START_PTR(*dictionary),
+                             static_cast<uInt> GRPC_SLICE_LENGTH(*dictionary));
+    GPR_ASSERT(r == Z_OK);
+  }
+  r = zlib_body(zs, input, output, deflate) && output->length < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref_internal(output->slices[i]);
@@ -108,23 +278,39 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  deflateEnd(&zs);
+  if (deflateReset(zs) != Z_OK || !put_cached_stream(cache, zs)) {
+    deflateEnd(zs);
+    gpr_free(zs);
+  }
   return r;
 }
 
+static z_stream* take_inflate_stream(stream_cache* cache, int gzip) {
+  z_stream* zs = take_cached_stream(cache);
+  if (zs == nullptr) {
+    zs = new_stream();
+    int r = inflateInit2(zs, 15 | (gzip ? 16 : 0));
+    GPR_ASSERT(r == Z_OK);
+  }
+  return zs;
+}
+
+static void release_inflate_stream(stream_cache* cache, z_stream* zs) {
+  if (inflateReset(zs) != Z_OK || !put_cached_stream(cache, zs)) {
+    inflateEnd(zs);
+    gpr_free(zs);
+  }
+}
+
 static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
                            int gzip) {
-  z_stream zs;
+  stream_cache* cache = &g_inflate_cache[gzip];
+  z_stream* zs = take_inflate_stream(cache, gzip);
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
+  r = zlib_body(zs, input, output, inflate);
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref_internal(output->slices[i]);
@@ -132,7 +318,7 @@ static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  inflateEnd(&zs);
+  release_inflate_stream(cache, zs);
   return r;
 }
 
@@ -145,6 +331,7 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
 }
 
 static int compress_inner(grpc_message_compression_algorithm algorithm,
+                          int zlib_level, const grpc_slice* dictionary,
                           grpc_slice_buffer* input, grpc_slice_buffer* output) {
   switch (algorithm) {
     case GRPC_MESSAGE_COMPRESS_NONE:
@@ -152,9 +339,9 @@ static int compress_inner(grpc_message_compression_algorithm algorithm,
          rely on that here */
       return 0;
     case GRPC_MESSAGE_COMPRESS_DEFLATE:
-      return zlib_compress(input, output, 0);
+      return zlib_compress(input, output, 0, zlib_level, dictionary);
     case GRPC_MESSAGE_COMPRESS_GZIP:
-      return zlib_compress(input, output, 1);
+      return zlib_compress(input, output, 1, zlib_level, nullptr);
     case GRPC_MESSAGE_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -164,7 +351,26 @@ static int compress_inner(grpc_message_compression_algorithm algorithm,
 
 int grpc_msg_compress(grpc_message_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  if (!compress_inner(algorithm, input, output)) {
+  return grpc_msg_compress_with_level(
+      algorithm, GRPC_MSG_COMPRESS_DEFAULT_ZLIB_LEVEL, input, output);
+}
+
+int grpc_msg_compress_with_level(grpc_message_compression_algorithm algorithm,
+                                 int zlib_level, grpc_slice_buffer* input,
+                                 grpc_slice_buffer* output) {
+  return grpc_msg_compress_with_dictionary(algorithm, zlib_level, nullptr,
+                                           input, output);
+}
+
+int grpc_msg_compress_with_dictionary(
+    grpc_message_compression_algorithm algorithm, int zlib_level,
+    const grpc_slice* dictionary, grpc_slice_buffer* input,
+    grpc_slice_buffer* output) {
+  if (zlib_level < -1 || zlib_level > 9) {
+    gpr_log(GPR_ERROR, "invalid zlib level %d: using the default", zlib_level);
+    zlib_level = GRPC_MSG_COMPRESS_DEFAULT_ZLIB_LEVEL;
+  }
+  if (!compress_inner(algorithm, zlib_level, dictionary, input, output)) {
     copy(input, output);
     return 0;
   }
@@ -186,3 +392,184 @@ int grpc_msg_decompress(grpc_message_compression_algorithm algorithm,
   gpr_log(GPR_ERROR, "invalid compression algorithm %d", algorithm);
   return 0;
 }
+
+struct grpc_msg_decompressor {
+  stream_cache* cache;
+  z_stream* zs;
+  const grpc_compression_dictionaries* dictionaries;
+  /* output block being filled: handed over once full, or by finish */
+  grpc_slice outbuf;
+  /* size of the next output block */
+  size_t block_size;
+  size_t max_output_size;
+  bool ended;
+  bool over_limit;
+};
+
+grpc_msg_decompressor* grpc_msg_decompressor_create(
+    grpc_message_compression_algorithm algorithm,
+    const grpc_compression_dictionaries* dictionaries,
+    size_t compressed_length, size_t max_output_size) {
+  int gzip;
+  switch (algorithm) {
+    case GRPC_MESSAGE_COMPRESS_DEFLATE:
+      gzip = 0;
+      break;
+    case GRPC_MESSAGE_COMPRESS_GZIP:
+      gzip = 1;
+      break;
+    default:
+      return nullptr;
+  }
+  grpc_msg_decompressor* decompressor =
+      static_cast<grpc_msg_decompressor*>(gpr_malloc(sizeof(*decompressor)));
+  decompressor->cache = &g_inflate_cache[gzip];
+  decompressor->zs = take_inflate_stream(decompressor->cache, gzip);
+  decompressor->dictionaries = dictionaries;
+  /* a reused stream still points at the last output of its previous user */
+  decompressor->zs->next_out = nullptr;
+  decompressor->zs->avail_out = 0;
+  decompressor->outbuf = grpc_empty_slice();
+  decompressor->block_size =
+      GPR_CLAMP(GPR_MIN(compressed_length,
+                        MAX_OUTPUT_BLOCK_SIZE / DECOMPRESSION_RATIO_HINT) *
+                    DECOMPRESSION_RATIO_HINT,
+                OUTPUT_BLOCK_SIZE, MAX_OUTPUT_BLOCK_SIZE);
+  decompressor->max_output_size = max_output_size;
+  decompressor->ended = false;
+  decompressor->over_limit = false;
+  return decompressor;
+}
+
+bool grpc_msg_decompressor_add(grpc_msg_decompressor* decompressor,
+                               const grpc_slice& input,
+                               grpc_slice_buffer* output) {
+  z_stream* zs = decompressor->zs;
+  const uInt uint_max = ~static_cast<uInt>(0);
+  GPR_ASSERT(GRPC_SLICE_LENGTH(input) <= uint_max);
+  zs->avail_in = static_cast<uInt> GRPC_SLICE_LENGTH(input);
+  zs->next_in = const_cast<uint8_t*>(GRPC_SLICE_START_PTR(input));
+  while (!decompressor->ended) {
+    if (zs->avail_out == 0) {
+      if (decompressor->outbuf.refcount != nullptr) {
+        grpc_slice_buffer_add_indexed(output, decompressor->outbuf);
+      }
+      /* never more than one byte past the limit, which is enough to see
+         that the message is too large */
+      size_t size = decompressor->block_size;
+      size_t left = decompressor->max_output_size - zs->total_out;
+      if (left < size) size = left + 1;
+      decompressor->block_size =
+          GPR_MIN(decompressor->block_size * 2, MAX_OUTPUT_BLOCK_SIZE);
+      decompressor->outbuf = GRPC_SLICE_MALLOC(size);
+      zs->avail_out = static_cast<uInt>(size);
+      zs->next_out = GRPC_SLICE_START_PTR(decompressor->outbuf);
+    }
+    int r = inflate(zs, Z_NO_FLUSH);
+    if (r == Z_NEED_DICT) {
+      /* zlib has read the id of the dictionary from the stream header */
+      uint32_t id = static_cast<uint32_t>(zs->adler);
+      const grpc_slice* dictionary =
+          decompressor->dictionaries == nullptr
+              ? nullptr
+              : grpc_compression_dictionaries_find(decompressor->dictionaries,
+                                                   id);
+      if (dictionary == nullptr) {
+        gpr_log(GPR_INFO, "zlib: unknown dictionary %08x", id);
+        return false;
+      }
+      r = inflateSetDictionary(
+          zs, GRPC_SLICE_START_PTR(*dictionary),
+          static_cast<uInt> GRPC_SLICE_LENGTH(*dictionary));
+      if (r != Z_OK) {
+        gpr_log(GPR_INFO, "zlib error (%d)", r);
+        return false;
+      }
+    } else if (r == Z_STREAM_END) {
+      decompressor->ended = true;
+    } else if (r < 0 && r != Z_BUF_ERROR /* not fatal */) {
+      gpr_log(GPR_INFO, "zlib error (%d)", r);
+      return false;
+    }
+    if (zs->total_out > decompressor->max_output_size) {
+      gpr_log(GPR_INFO, "zlib: message inflates past %" PRIuPTR " bytes",
+              decompressor->max_output_size);
+      decompressor->over_limit = true;
+      return false;
+    }
+    if (!decompressor->ended && zs->avail_in == 0 && zs->avail_out > 0) {
+      /* everything given so far is inflated */
+      break;
+    }
+  }
+  if (zs->avail_in > 0) {
+    gpr_log(GPR_INFO, "zlib: not all input consumed");
+    return false;
+  }
+  return true;
+}
+
+bool grpc_msg_decompressor_finish(grpc_msg_decompressor* decompressor,
+                                  grpc_slice_buffer* output) {
+  /* an empty message is sent as is, even when it is flagged as compressed */
+  if (!decompressor->ended && decompressor->zs->total_in > 0) {
+    gpr_log(GPR_INFO, "zlib: compressed message is truncated");
+    return false;
+  }
+  if (decompressor->outbuf.refcount != nullptr) {
+    size_t capacity = GRPC_SLICE_LENGTH(decompressor->outbuf);
+    decompressor->outbuf.data.refcounted.length -= decompressor->zs->avail_out;
+    size_t length = GRPC_SLICE_LENGTH(decompressor->outbuf);
+    if (length > 0 && capacity > OUTPUT_BLOCK_SIZE && length < capacity / 2) {
+      /* do not keep a large block mostly empty for the life of the message */
+      grpc_slice_buffer_add_indexed(
+          output, grpc_slice_from_copied_buffer(
+                      reinterpret_cast<const char*>(
+                          GRPC_SLICE_START_PTR(decompressor->outbuf)),
+                      length));
+      grpc_slice_unref_internal(decompressor->outbuf);
+    } else if (length > 0) {
+      grpc_slice_buffer_add_indexed(output, decompressor->outbuf);
+    } else {
+      grpc_slice_unref_internal(decompressor->outbuf);
+    }
+    decompressor->outbuf = grpc_empty_slice();
+    decompressor->zs->avail_out = 0;
+  }
+  return true;
+}
+
+bool grpc_msg_decompressor_over_limit(
+    const grpc_msg_decompressor* decompressor) {
+  return decompressor->over_limit;
+}
+
+void grpc_msg_decompressor_destroy(grpc_msg_decompressor* decompressor) {
+  grpc_slice_unref_internal(decompressor->outbuf);
+  release_inflate_stream(decompressor->cache, decompressor->zs);
+  gpr_free(decompressor);
+}
+
+static void free_cached_streams(stream_cache* cache, bool deflating) {
+  for (size_t i = 0; i < cache->count; i++) {
+    if (deflating) {
+      deflateEnd(cache->streams[i]);
+    } else {
+      inflateEnd(cache->streams[i]);
+    }
+    gpr_free(cache->streams[i]);
+  }
+  cache->count = 0;
+}
+
+void grpc_msg_compress_shutdown(void) {
+  gpr_once_init(&g_cache_once, init_cache);
+  gpr_mu_lock(&g_cache_mu);
+  for (int gzip = 0; gzip < 2; gzip++) {
+    for (int level = 0; level < ZLIB_LEVEL_COUNT; level++) {
+      free_cached_streams(&g_deflate_cache[gzip][level], true);
+    }
+    free_cached_streams(&g_inflate_cache[gzip], false);
+  }
+  gpr_mu_unlock(&g_cache_mu);
+}
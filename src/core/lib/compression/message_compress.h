@@ -21,6 +21,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <grpc/compression.h>
 #include <grpc/slice_buffer.h>
 
 #include "src/core/lib/compression/compression_internal.h"
@@ -31,10 +32,86 @@
 int grpc_msg_compress(grpc_message_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+/* zlib level used by grpc_msg_compress: zlib's own default */
+#define GRPC_MSG_COMPRESS_DEFAULT_ZLIB_LEVEL (-1)
+
+/* Same as grpc_msg_compress, but deflate and gzip compress at 'zlib_level',
+   from 0 (no compression) to 9 (best compression), or -1 for the default. */
+int grpc_msg_compress_with_level(grpc_message_compression_algorithm algorithm,
+                                 int zlib_level, grpc_slice_buffer* input,
+                                 grpc_slice_buffer* output);
+
+/* Same as grpc_msg_compress_with_level, but deflate compresses with the preset
+   'dictionary' if it is not null. gzip does not support dictionaries. */
+int grpc_msg_compress_with_dictionary(
+    grpc_message_compression_algorithm algorithm, int zlib_level,
+    const grpc_slice* dictionary, grpc_slice_buffer* input,
+    grpc_slice_buffer* output);
+
+/* Returns the dictionaries passed in 'args', if any, without taking a ref. */
+grpc_compression_dictionaries* grpc_compression_dictionaries_from_channel_args(
+    const grpc_channel_args* args);
+
+grpc_compression_dictionaries* grpc_compression_dictionaries_ref(
+    grpc_compression_dictionaries* dictionaries);
+
+size_t grpc_compression_dictionaries_count(
+    const grpc_compression_dictionaries* dictionaries);
+
+/* The id of a dictionary is its Adler-32 checksum, as in deflate streams. */
+uint32_t grpc_compression_dictionaries_id(
+    const grpc_compression_dictionaries* dictionaries, size_t index);
+
+const grpc_slice* grpc_compression_dictionaries_get(
+    const grpc_compression_dictionaries* dictionaries, size_t index);
+
+/* Returns nullptr if there is no dictionary 'id' in 'dictionaries'. */
+const grpc_slice* grpc_compression_dictionaries_find(
+    const grpc_compression_dictionaries* dictionaries, uint32_t id);
+
 /* decompress 'input' to 'output' using 'algorithm'.
    On success, appends slices to output and returns 1.
    On failure, output is unchanged, and returns 0. */
 int grpc_msg_decompress(grpc_message_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+/* Decompresses a message one slice at a time, as its compressed slices are
+   received, so that they can be dropped as soon as they are inflated rather
+   than held until the whole message is there. */
+typedef struct grpc_msg_decompressor grpc_msg_decompressor;
+
+/* Returns nullptr if 'algorithm' does not compress messages. Deflate messages
+   compressed with a preset dictionary are inflated with the dictionary of the
+   same id in 'dictionaries', which may be null and must outlive the
+   decompressor. 'compressed_length', the size of the compressed message, is
+   used to size the output blocks. Decompression fails as soon as the message
+   inflates to more than 'max_output_size' bytes. */
+grpc_msg_decompressor* grpc_msg_decompressor_create(
+    grpc_message_compression_algorithm algorithm,
+    const grpc_compression_dictionaries* dictionaries,
+    size_t compressed_length, size_t max_output_size);
+
+/* Inflates 'input', which the caller keeps ownership of, appending the output
+   to 'output' in blocks of bounded size. Returns false if 'input' is not valid
+   compressed data, or if it inflates past the size limit; output may then hold
+   part of the message. */
+bool grpc_msg_decompressor_add(grpc_msg_decompressor* decompressor,
+                               const grpc_slice& input,
+                               grpc_slice_buffer* output);
+
+/* Appends the rest of the message to 'output', once all of its slices were
+   added. Returns false if the compressed data is truncated. */
+bool grpc_msg_decompressor_finish(grpc_msg_decompressor* decompressor,
+                                  grpc_slice_buffer* output);
+
+/* Returns true if decompression failed because the message inflated past the
+   size limit. */
+bool grpc_msg_decompressor_over_limit(
+    const grpc_msg_decompressor* decompressor);
+
+void grpc_msg_decompressor_destroy(grpc_msg_decompressor* decompressor);
+
+/* Frees the zlib streams kept for reuse across messages. */
+void grpc_msg_compress_shutdown(void);
+
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
@@ -81,6 +81,20 @@ int grpc_stats_histo_find_bucket_slow(int value, const int* table,
   return static_cast<int>(table - start) - 1;
 }
 
+int grpc_stats_histo_find_bucket_log_linear(int value, int precision) {
+  if (value < (1 << precision)) return value;
+  /* the top precision bits after the leading one pick the bucket within the
+     value's power of two */
+#if defined(__GNUC__)
+  int top_bit = 31 - __builtin_clz(static_cast<unsigned>(value));
+#else
+  int top_bit = 0;
+  while ((value >> top_bit) > 1) top_bit++;
+#endif
+  int shift = top_bit - precision;
+  return (shift << precision) + (value >> shift);
+}
+
 size_t grpc_stats_histo_count(const grpc_stats_data* stats,
                               grpc_stats_histograms histogram) {
   size_t sum = 0;
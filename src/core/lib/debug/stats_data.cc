@@ -31,6 +31,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "cqs_created",
     "client_channels_created",
     "client_subchannels_created",
+    "client_retry_buffered_bytes",
+    "client_retry_buffer_overflow_commits",
     "server_channels_created",
     "syscall_poll",
     "syscall_wait",
@@ -42,11 +44,18 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "pollset_kick_own_thread",
     "syscall_epoll_ctl",
     "pollset_fd_cache_hits",
+    "busy_poll_spin_hits",
+    "busy_poll_spin_misses",
+    "pollset_numa_local_wakeups",
+    "pollset_numa_remote_wakeups",
     "histogram_slow_lookups",
     "syscall_write",
     "syscall_read",
     "tcp_backup_pollers_created",
     "tcp_backup_poller_polls",
+    "tcp_zerocopy_sends",
+    "tcp_zerocopy_fallbacks",
+    "tcp_write_coalesced_runs",
     "http2_op_batches",
     "http2_op_cancel",
     "http2_op_send_initial_metadata",
@@ -55,12 +64,16 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_op_recv_initial_metadata",
     "http2_op_recv_message",
     "http2_op_recv_trailing_metadata",
+    "http2_send_data_frames",
+    "http2_recv_data_frames",
+    "http2_recv_messages",
     "http2_settings_writes",
     "http2_pings_sent",
     "http2_writes_begun",
     "http2_writes_offloaded",
     "http2_writes_continued",
     "http2_partial_writes",
+    "http2_writes_held",
     "http2_initiate_write_due_to_initial_write",
     "http2_initiate_write_due_to_start_new_stream",
     "http2_initiate_write_due_to_send_message",
@@ -94,6 +107,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "hpack_recv_huffman",
     "hpack_recv_binary",
     "hpack_recv_binary_base64",
+    "hpack_recv_static_string",
+    "hpack_recv_interned_string",
     "hpack_send_indexed",
     "hpack_send_lithdr_incidx",
     "hpack_send_lithdr_incidx_v",
@@ -105,6 +120,9 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "hpack_send_huffman",
     "hpack_send_binary",
     "hpack_send_binary_base64",
+    "hpack_send_dynidx_hit",
+    "hpack_send_dynidx_miss",
+    "hpack_send_preencoded",
     "combiner_locks_initiated",
     "combiner_locks_scheduled_items",
     "combiner_locks_scheduled_final_items",
@@ -119,11 +137,34 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "executor_wakeup_initiated",
     "executor_queue_drained",
     "executor_push_retries",
+    "executor_stolen_items",
+    "handshaker_offloaded_steps",
+    "handshaker_queued_steps",
+    "alts_handshakes_started",
+    "alts_handshakes_queued",
     "server_requested_calls",
     "server_slowpath_requests_queued",
+    "server_request_matcher_lock_contentions",
+    "sync_server_queue_delay_over_target",
+    "sync_server_thread_target_raised",
+    "sync_server_thread_target_lowered",
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
+    "cq_ev_queue_steals",
+    "compressed_messages",
+    "compression_skipped_messages",
+    "health_check_streams_started",
+    "health_check_streams_ended",
+    "native_dns_requests_coalesced",
+    "cq_callback_executor_hops",
+    "cq_callback_inline_runs",
+    "server_calls_shed",
+    "oauth2_calls_queued_for_token",
+    "oauth2_token_background_refreshes",
+    "memory_reclaimed_buffer_bytes",
+    "memory_reclaimed_hpack_bytes",
+    "memory_reclaimed_arena_pool_bytes",
 };
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
@@ -131,6 +172,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of completion queues created",
     "Number of client channels created",
     "Number of client subchannels created",
+    "Bytes of messages and metadata held by client calls so that they can be "
+    "retried",
+    "Number of client calls that stopped being retriable because their "
+    "messages outgrew the retry buffer",
     "Number of server channels created",
     "Number of polling syscalls (epoll_wait, poll, etc) made by this process",
     "Number of sleeping syscalls made by this process",
@@ -149,6 +194,15 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of epoll_ctl calls made (only valid for epollex right now)",
     "Number of epoll_ctl calls skipped because the fd was cached as already "
     "being added.  (only valid for epollex right now)",
+    "Number of busy polls that found events before their budget ran out (only "
+    "valid for epoll1 right now)",
+    "Number of busy polls that ran out of budget and fell back to a blocking "
+    "poll (only valid for epoll1 right now)",
+    "Number of fd events handled on the NUMA node of the pollset the fd was "
+    "first added to (only valid for epollex with GRPC_EPOLLEX_NUMA_AFFINITY)",
+    "Number of fd events handled on another NUMA node than the one of the "
+    "pollset the fd was first added to (only valid for epollex with "
+    "GRPC_EPOLLEX_NUMA_AFFINITY)",
     "Number of times histogram increments went through the slow (binary "
     "search) path",
     "Number of write syscalls (or equivalent - eg sendmsg) made by this "
@@ -156,6 +210,12 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of times a backup poller has been created (this can be expensive)",
     "Number of polls performed on the backup poller",
+    "Number of sendmsg calls made with MSG_ZEROCOPY",
+    "Number of times a zerocopy-eligible write was copied instead, either "
+    "because no send record was free, sendmsg returned ENOBUFS, or the kernel "
+    "reported that it copied the data",
+    "Number of runs of small slices copied into a contiguous buffer so that "
+    "each run is written to a socket with a single iovec",
     "Number of batches received by HTTP2 transport",
     "Number of cancelations received by HTTP2 transport",
     "Number of batches containing send initial metadata",
@@ -164,6 +224,11 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of batches containing receive initial metadata",
     "Number of batches containing receive message",
     "Number of batches containing receive trailing metadata",
+    "Number of HTTP2 DATA frames sent; divide by http2_op_send_message for "
+    "frames per message",
+    "Number of HTTP2 DATA frames received",
+    "Number of messages received over HTTP2; divide http2_recv_data_frames by "
+    "this for frames per message",
     "Number of settings frames sent",
     "Number of HTTP2 pings sent by process",
     "Number of HTTP2 writes initiated",
@@ -172,6 +237,7 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "written",
     "Number of HTTP2 writes that were made knowing there was still more data "
     "to be written (we cap maximum write size to syscall_write)",
+    "Number of HTTP2 writes held back to coalesce them with later frames",
     "Number of HTTP2 writes initiated due to 'initial_write'",
     "Number of HTTP2 writes initiated due to 'start_new_stream'",
     "Number of HTTP2 writes initiated due to 'send_message'",
@@ -211,6 +277,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of huffman encoded strings received in metadata",
     "Number of binary strings received in metadata",
     "Number of binary strings received encoded in base64 in metadata",
+    "Number of interned strings received in metadata that were found in the "
+    "static table without hashing them into the intern table",
+    "Number of interned strings received in metadata that were not static and "
+    "went through the intern table",
     "Number of HPACK indexed fields sent",
     "Number of HPACK literal headers sent with incremental indexing",
     "Number of HPACK literal headers sent with incremental indexing and "
@@ -223,6 +293,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of huffman encoded strings sent in metadata",
     "Number of binary strings received in metadata",
     "Number of binary strings received encoded in base64 in metadata",
+    "Number of HPACK headers sent as an index into the dynamic table",
+    "Number of HPACK headers looked up in the dynamic table without a match",
+    "Number of HPACK header blocks sent from the connection's cache of "
+    "pre-encoded blocks",
     "Number of combiner lock entries by process (first items queued to a "
     "combiner)",
     "Number of items scheduled against combiner locks",
@@ -242,15 +316,54 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of times an executor queue was drained",
     "Number of times we raced and were forced to retry pushing a closure to "
     "the executor",
+    "Number of closures a work-stealing executor thread took from another "
+    "thread's queue",
+    "Number of security handshake steps run on the handshaker executor",
+    "Number of offloaded security handshake steps that had to wait because "
+    "all handshaker threads were busy",
+    "Number of ALTS handshakes started with the handshaker service",
+    "Number of ALTS handshakes that had to wait because the maximum number of "
+    "concurrent handshakes with the handshaker service were in flight",
     "How many calls were requested (not necessarily received) by the server",
     "How many times was the server slow path taken (indicates too few "
     "outstanding requests)",
+    "Number of times a thread had to wait for a server request matcher's lock "
+    "because another thread held it",
+    "Number of times a sync server thread manager measured a queueing delay "
+    "above its target",
+    "Number of times a sync server thread manager raised its thread target",
+    "Number of times a sync server thread manager lowered its thread target",
     "Number of lock (trylock) acquisition failures on completion queue event "
     "queue. High value here indicates high contention on completion queues",
     "Number of lock (trylock) acquisition successes on completion queue event "
     "queue.",
     "Number of times NULL was popped out of completion queue's event queue "
     "even though the event queue was not empty",
+    "Number of events a thread took from another thread's shard of a sharded "
+    "completion queue because its own shard was empty",
+    "Number of outgoing messages sent compressed",
+    "Number of outgoing messages sent uncompressed although their call had "
+    "message compression on, because they were too small or their method "
+    "recently compressed poorly",
+    "Number of health check watch streams started on subchannels",
+    "Number of health check watch streams that ended. The difference from "
+    "health_check_streams_started is the number of streams currently open",
+    "Number of native DNS resolution requests that waited on a lookup of the "
+    "same name already in progress instead of starting their own",
+    "Number of callback completion queue callbacks that had to be run from "
+    "the executor, i.e. with a thread hop",
+    "Number of callback completion queue callbacks run inline on the thread "
+    "that completed the operation",
+    "Number of queued server calls failed with RESOURCE_EXHAUSTED by load "
+    "shedding",
+    "Number of calls that waited for an oauth2 access token to be fetched",
+    "Number of oauth2 access token fetches started ahead of expiry while "
+    "calls kept using the cached token",
+    "Number of bytes of idle transport buffers freed by benign memory "
+    "reclamation",
+    "Number of bytes of metadata the hpack encoder stopped holding on to "
+    "during benign memory reclamation",
+    "Number of bytes of pooled call arenas freed by benign memory reclamation",
 };
 const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "call_initial_size",
@@ -266,6 +379,16 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
     "server_cqs_checked",
+    "combiner_queue_wait_us",
+    "combiner_run_us",
+    "registered_call_initial_size",
+    "compression_bytes_saved",
+    "compression_run_us",
+    "native_dns_resolve_us",
+    "oauth2_token_fetch_us",
+    "pick_latency_us",
+    "write_latency_us",
+    "cq_delivery_delay_us",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
@@ -282,6 +405,22 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of flow control updates written per TCP write",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
+    "Number of microseconds closures spent queued on a combiner before running "
+    "(only with GRPC_COMBINER_PROFILING)",
+    "Number of microseconds closures took to run on a combiner (only with "
+    "GRPC_COMBINER_PROFILING)",
+    "Initial size of the grpc_call arena created at call start, for client "
+    "calls on registered methods",
+    "Number of bytes saved by compressing an outgoing message",
+    "Number of microseconds spent compressing an outgoing message",
+    "Number of microseconds a native DNS lookup took",
+    "Number of microseconds an oauth2 access token fetch took",
+    "Number of microseconds from the start of a call's load balancing pick to "
+    "its completion",
+    "Number of microseconds from a transport asking to write to the write "
+    "completing on its endpoint",
+    "Number of microseconds completions waited in a completion queue before "
+    "the application took them",
 };
 const int grpc_stats_table_0[65] = {
     0,      1,      2,      3,      4,     5,     7,     9,     11,    14,
@@ -350,6 +489,74 @@ const uint8_t grpc_stats_table_7[102] = {
     42, 42, 43, 44, 44, 45, 46, 46, 47, 48, 48, 49, 49, 50, 50, 51, 51};
 const int grpc_stats_table_8[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
 const uint8_t grpc_stats_table_9[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
+const int grpc_stats_table_10[65] = {
+    0,      1,      2,      3,      4,      5,      7,      9,      12,
+    15,     19,     24,     30,     37,     46,     57,     70,     86,
+    105,    129,    158,    193,    236,    288,    352,    430,    525,
+    641,    782,    954,    1164,   1420,   1733,   2114,   2579,   3146,
+    3838,   4682,   5711,   6967,   8499,   10367,  12646,  15426,  18816,
+    22951,  27995,  34148,  41653,  50807,  61972,  75591,  92203,  112465,
+    137180, 167326, 204096, 248947, 303653, 370381, 451772, 551049, 672141,
+    819843, 1000000};
+const uint8_t grpc_stats_table_11[139] = {
+    0,  0,  0,  1,  1,  1,  2,  2,  2,  3,  3,  3,  4,  4,  5,  5,  5,  6,
+    6,  6,  7,  7,  8,  8,  9,  9,  9,  10, 10, 11, 11, 12, 12, 12, 13, 13,
+    13, 14, 15, 15, 15, 16, 16, 17, 17, 17, 18, 18, 19, 19, 20, 20, 20, 21,
+    21, 22, 22, 23, 23, 24, 24, 24, 25, 25, 26, 26, 27, 27, 27, 28, 28, 29,
+    29, 30, 30, 31, 31, 31, 32, 32, 33, 33, 34, 34, 34, 35, 35, 36, 36, 37,
+    37, 37, 38, 38, 39, 39, 40, 40, 41, 41, 41, 42, 42, 43, 43, 44, 44, 44,
+    45, 45, 46, 46, 47, 47, 48, 48, 48, 49, 49, 50, 50, 51, 51, 51, 52, 52,
+    53, 53, 54, 54, 55, 55, 55, 56, 56, 57, 57, 58, 58};
+const int grpc_stats_table_12[338] = {
+    0,        1,        2,        3,        4,        5,        6,
+    7,        8,        9,        10,       11,       12,       13,
+    14,       15,       16,       17,       18,       19,       20,
+    21,       22,       23,       24,       25,       26,       27,
+    28,       29,       30,       31,       32,       34,       36,
+    38,       40,       42,       44,       46,       48,       50,
+    52,       54,       56,       58,       60,       62,       64,
+    68,       72,       76,       80,       84,       88,       92,
+    96,       100,      104,      108,      112,      116,      120,
+    124,      128,      136,      144,      152,      160,      168,
+    176,      184,      192,      200,      208,      216,      224,
+    232,      240,      248,      256,      272,      288,      304,
+    320,      336,      352,      368,      384,      400,      416,
+    432,      448,      464,      480,      496,      512,      544,
+    576,      608,      640,      672,      704,      736,      768,
+    800,      832,      864,      896,      928,      960,      992,
+    1024,     1088,     1152,     1216,     1280,     1344,     1408,
+    1472,     1536,     1600,     1664,     1728,     1792,     1856,
+    1920,     1984,     2048,     2176,     2304,     2432,     2560,
+    2688,     2816,     2944,     3072,     3200,     3328,     3456,
+    3584,     3712,     3840,     3968,     4096,     4352,     4608,
+    4864,     5120,     5376,     5632,     5888,     6144,     6400,
+    6656,     6912,     7168,     7424,     7680,     7936,     8192,
+    8704,     9216,     9728,     10240,    10752,    11264,    11776,
+    12288,    12800,    13312,    13824,    14336,    14848,    15360,
+    15872,    16384,    17408,    18432,    19456,    20480,    21504,
+    22528,    23552,    24576,    25600,    26624,    27648,    28672,
+    29696,    30720,    31744,    32768,    34816,    36864,    38912,
+    40960,    43008,    45056,    47104,    49152,    51200,    53248,
+    55296,    57344,    59392,    61440,    63488,    65536,    69632,
+    73728,    77824,    81920,    86016,    90112,    94208,    98304,
+    102400,   106496,   110592,   114688,   118784,   122880,   126976,
+    131072,   139264,   147456,   155648,   163840,   172032,   180224,
+    188416,   196608,   204800,   212992,   221184,   229376,   237568,
+    245760,   253952,   262144,   278528,   294912,   311296,   327680,
+    344064,   360448,   376832,   393216,   409600,   425984,   442368,
+    458752,   475136,   491520,   507904,   524288,   557056,   589824,
+    622592,   655360,   688128,   720896,   753664,   786432,   819200,
+    851968,   884736,   917504,   950272,   983040,   1015808,  1048576,
+    1114112,  1179648,  1245184,  1310720,  1376256,  1441792,  1507328,
+    1572864,  1638400,  1703936,  1769472,  1835008,  1900544,  1966080,
+    2031616,  2097152,  2228224,  2359296,  2490368,  2621440,  2752512,
+    2883584,  3014656,  3145728,  3276800,  3407872,  3538944,  3670016,
+    3801088,  3932160,  4063232,  4194304,  4456448,  4718592,  4980736,
+    5242880,  5505024,  5767168,  6029312,  6291456,  6553600,  6815744,
+    7077888,  7340032,  7602176,  7864320,  8126464,  8388608,  8912896,
+    9437184,  9961472,  10485760, 11010048, 11534336, 12058624, 12582912,
+    13107200, 13631488, 14155776, 14680064, 15204352, 15728640, 16252928,
+    16777216, 17825792};
 void grpc_stats_inc_call_initial_size(int value) {
   value = GPR_CLAMP(value, 0, 262144);
   if (value < 6) {
@@ -661,17 +868,203 @@ void grpc_stats_inc_server_cqs_checked(int value) {
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
-    grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
-    grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+void grpc_stats_inc_combiner_queue_wait_us(int value) {
+  value = GPR_CLAMP(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_WAIT_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_WAIT_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_WAIT_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 64));
+}
+void grpc_stats_inc_combiner_run_us(int value) {
+  value = GPR_CLAMP(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_RUN_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_RUN_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMBINER_RUN_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 64));
+}
+void grpc_stats_inc_registered_call_initial_size(int value) {
+  value = GPR_CLAMP(value, 0, 262144);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_REGISTERED_CALL_INITIAL_SIZE,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_1[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_0[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_REGISTERED_CALL_INITIAL_SIZE,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_REGISTERED_CALL_INITIAL_SIZE,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_0, 64));
+}
+void grpc_stats_inc_compression_bytes_saved(int value) {
+  value = GPR_CLAMP(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMPRESSION_BYTES_SAVED,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMPRESSION_BYTES_SAVED,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMPRESSION_BYTES_SAVED,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+void grpc_stats_inc_compression_run_us(int value) {
+  value = GPR_CLAMP(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMPRESSION_RUN_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMPRESSION_RUN_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMPRESSION_RUN_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 64));
+}
+void grpc_stats_inc_native_dns_resolve_us(int value) {
+  value = GPR_CLAMP(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_NATIVE_DNS_RESOLVE_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_NATIVE_DNS_RESOLVE_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_NATIVE_DNS_RESOLVE_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+void grpc_stats_inc_oauth2_token_fetch_us(int value) {
+  value = GPR_CLAMP(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_OAUTH2_TOKEN_FETCH_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_OAUTH2_TOKEN_FETCH_US,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_OAUTH2_TOKEN_FETCH_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+void grpc_stats_inc_pick_latency_us(int value) {
+  value = GPR_CLAMP(value, 0, 16777216);
+  GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_PICK_LATENCY_US,
+                           grpc_stats_histo_find_bucket_log_linear(value, 4));
+}
+void grpc_stats_inc_write_latency_us(int value) {
+  value = GPR_CLAMP(value, 0, 16777216);
+  GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WRITE_LATENCY_US,
+                           grpc_stats_histo_find_bucket_log_linear(value, 4));
+}
+void grpc_stats_inc_cq_delivery_delay_us(int value) {
+  value = GPR_CLAMP(value, 0, 16777216);
+  GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_CQ_DELIVERY_DELAY_US,
+                           grpc_stats_histo_find_bucket_log_linear(value, 4));
+}
+const int grpc_stats_histo_buckets[23] = {
+    64, 128, 64, 64, 64, 64,  64,  64,  64, 64, 64, 64, 8, 64, 64,
+    64, 64,  64, 64, 64, 337, 337, 337};
+const int grpc_stats_histo_start[23] = {
+    0,   64,  192, 256,  320,  384,  448,  512,  576,  640,  704, 768, 832,
+    840, 904, 968, 1032, 1096, 1160, 1224, 1288, 1625, 1962};
+const int* const grpc_stats_histo_bucket_boundaries[23] = {
+    grpc_stats_table_0,  grpc_stats_table_2,  grpc_stats_table_4,
+    grpc_stats_table_6,  grpc_stats_table_4,  grpc_stats_table_4,
+    grpc_stats_table_6,  grpc_stats_table_4,  grpc_stats_table_6,
+    grpc_stats_table_6,  grpc_stats_table_6,  grpc_stats_table_6,
+    grpc_stats_table_8,  grpc_stats_table_10, grpc_stats_table_10,
+    grpc_stats_table_0,  grpc_stats_table_4,  grpc_stats_table_10,
+    grpc_stats_table_4,  grpc_stats_table_4,  grpc_stats_table_12,
+    grpc_stats_table_12, grpc_stats_table_12};
+void (*const grpc_stats_inc_histogram[23])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -684,4 +1077,14 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
-    grpc_stats_inc_server_cqs_checked};
+    grpc_stats_inc_server_cqs_checked,
+    grpc_stats_inc_combiner_queue_wait_us,
+    grpc_stats_inc_combiner_run_us,
+    grpc_stats_inc_registered_call_initial_size,
+    grpc_stats_inc_compression_bytes_saved,
+    grpc_stats_inc_compression_run_us,
+    grpc_stats_inc_native_dns_resolve_us,
+    grpc_stats_inc_oauth2_token_fetch_us,
+    grpc_stats_inc_pick_latency_us,
+    grpc_stats_inc_write_latency_us,
+    grpc_stats_inc_cq_delivery_delay_us};
@@ -32,6 +32,8 @@ typedef enum {
   GRPC_STATS_COUNTER_CQS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED,
+  GRPC_STATS_COUNTER_CLIENT_RETRY_BUFFERED_BYTES,
+  GRPC_STATS_COUNTER_CLIENT_RETRY_BUFFER_OVERFLOW_COMMITS,
   GRPC_STATS_COUNTER_SERVER_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_SYSCALL_POLL,
   GRPC_STATS_COUNTER_SYSCALL_WAIT,
@@ -43,11 +45,18 @@ typedef enum {
   GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD,
   GRPC_STATS_COUNTER_SYSCALL_EPOLL_CTL,
   GRPC_STATS_COUNTER_POLLSET_FD_CACHE_HITS,
+  GRPC_STATS_COUNTER_BUSY_POLL_SPIN_HITS,
+  GRPC_STATS_COUNTER_BUSY_POLL_SPIN_MISSES,
+  GRPC_STATS_COUNTER_POLLSET_NUMA_LOCAL_WAKEUPS,
+  GRPC_STATS_COUNTER_POLLSET_NUMA_REMOTE_WAKEUPS,
   GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS,
   GRPC_STATS_COUNTER_SYSCALL_WRITE,
   GRPC_STATS_COUNTER_SYSCALL_READ,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS,
+  GRPC_STATS_COUNTER_TCP_ZEROCOPY_SENDS,
+  GRPC_STATS_COUNTER_TCP_ZEROCOPY_FALLBACKS,
+  GRPC_STATS_COUNTER_TCP_WRITE_COALESCED_RUNS,
   GRPC_STATS_COUNTER_HTTP2_OP_BATCHES,
   GRPC_STATS_COUNTER_HTTP2_OP_CANCEL,
   GRPC_STATS_COUNTER_HTTP2_OP_SEND_INITIAL_METADATA,
@@ -56,12 +65,16 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_OP_RECV_INITIAL_METADATA,
   GRPC_STATS_COUNTER_HTTP2_OP_RECV_MESSAGE,
   GRPC_STATS_COUNTER_HTTP2_OP_RECV_TRAILING_METADATA,
+  GRPC_STATS_COUNTER_HTTP2_SEND_DATA_FRAMES,
+  GRPC_STATS_COUNTER_HTTP2_RECV_DATA_FRAMES,
+  GRPC_STATS_COUNTER_HTTP2_RECV_MESSAGES,
   GRPC_STATS_COUNTER_HTTP2_SETTINGS_WRITES,
   GRPC_STATS_COUNTER_HTTP2_PINGS_SENT,
   GRPC_STATS_COUNTER_HTTP2_WRITES_BEGUN,
   GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED,
   GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED,
   GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_HELD,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE,
@@ -95,6 +108,8 @@ typedef enum {
   GRPC_STATS_COUNTER_HPACK_RECV_HUFFMAN,
   GRPC_STATS_COUNTER_HPACK_RECV_BINARY,
   GRPC_STATS_COUNTER_HPACK_RECV_BINARY_BASE64,
+  GRPC_STATS_COUNTER_HPACK_RECV_STATIC_STRING,
+  GRPC_STATS_COUNTER_HPACK_RECV_INTERNED_STRING,
   GRPC_STATS_COUNTER_HPACK_SEND_INDEXED,
   GRPC_STATS_COUNTER_HPACK_SEND_LITHDR_INCIDX,
   GRPC_STATS_COUNTER_HPACK_SEND_LITHDR_INCIDX_V,
@@ -106,6 +121,9 @@ typedef enum {
   GRPC_STATS_COUNTER_HPACK_SEND_HUFFMAN,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64,
+  GRPC_STATS_COUNTER_HPACK_SEND_DYNIDX_HIT,
+  GRPC_STATS_COUNTER_HPACK_SEND_DYNIDX_MISS,
+  GRPC_STATS_COUNTER_HPACK_SEND_PREENCODED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS,
@@ -120,11 +138,34 @@ typedef enum {
   GRPC_STATS_COUNTER_EXECUTOR_WAKEUP_INITIATED,
   GRPC_STATS_COUNTER_EXECUTOR_QUEUE_DRAINED,
   GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES,
+  GRPC_STATS_COUNTER_EXECUTOR_STOLEN_ITEMS,
+  GRPC_STATS_COUNTER_HANDSHAKER_OFFLOADED_STEPS,
+  GRPC_STATS_COUNTER_HANDSHAKER_QUEUED_STEPS,
+  GRPC_STATS_COUNTER_ALTS_HANDSHAKES_STARTED,
+  GRPC_STATS_COUNTER_ALTS_HANDSHAKES_QUEUED,
   GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS,
   GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED,
+  GRPC_STATS_COUNTER_SERVER_REQUEST_MATCHER_LOCK_CONTENTIONS,
+  GRPC_STATS_COUNTER_SYNC_SERVER_QUEUE_DELAY_OVER_TARGET,
+  GRPC_STATS_COUNTER_SYNC_SERVER_THREAD_TARGET_RAISED,
+  GRPC_STATS_COUNTER_SYNC_SERVER_THREAD_TARGET_LOWERED,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
+  GRPC_STATS_COUNTER_CQ_EV_QUEUE_STEALS,
+  GRPC_STATS_COUNTER_COMPRESSED_MESSAGES,
+  GRPC_STATS_COUNTER_COMPRESSION_SKIPPED_MESSAGES,
+  GRPC_STATS_COUNTER_HEALTH_CHECK_STREAMS_STARTED,
+  GRPC_STATS_COUNTER_HEALTH_CHECK_STREAMS_ENDED,
+  GRPC_STATS_COUNTER_NATIVE_DNS_REQUESTS_COALESCED,
+  GRPC_STATS_COUNTER_CQ_CALLBACK_EXECUTOR_HOPS,
+  GRPC_STATS_COUNTER_CQ_CALLBACK_INLINE_RUNS,
+  GRPC_STATS_COUNTER_SERVER_CALLS_SHED,
+  GRPC_STATS_COUNTER_OAUTH2_CALLS_QUEUED_FOR_TOKEN,
+  GRPC_STATS_COUNTER_OAUTH2_TOKEN_BACKGROUND_REFRESHES,
+  GRPC_STATS_COUNTER_MEMORY_RECLAIMED_BUFFER_BYTES,
+  GRPC_STATS_COUNTER_MEMORY_RECLAIMED_HPACK_BYTES,
+  GRPC_STATS_COUNTER_MEMORY_RECLAIMED_ARENA_POOL_BYTES,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -143,6 +184,16 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_WAIT_US,
+  GRPC_STATS_HISTOGRAM_COMBINER_RUN_US,
+  GRPC_STATS_HISTOGRAM_REGISTERED_CALL_INITIAL_SIZE,
+  GRPC_STATS_HISTOGRAM_COMPRESSION_BYTES_SAVED,
+  GRPC_STATS_HISTOGRAM_COMPRESSION_RUN_US,
+  GRPC_STATS_HISTOGRAM_NATIVE_DNS_RESOLVE_US,
+  GRPC_STATS_HISTOGRAM_OAUTH2_TOKEN_FETCH_US,
+  GRPC_STATS_HISTOGRAM_PICK_LATENCY_US,
+  GRPC_STATS_HISTOGRAM_WRITE_LATENCY_US,
+  GRPC_STATS_HISTOGRAM_CQ_DELIVERY_DELAY_US,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -174,7 +225,27 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_WAIT_US_FIRST_SLOT = 840,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_WAIT_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_RUN_US_FIRST_SLOT = 904,
+  GRPC_STATS_HISTOGRAM_COMBINER_RUN_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_REGISTERED_CALL_INITIAL_SIZE_FIRST_SLOT = 968,
+  GRPC_STATS_HISTOGRAM_REGISTERED_CALL_INITIAL_SIZE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMPRESSION_BYTES_SAVED_FIRST_SLOT = 1032,
+  GRPC_STATS_HISTOGRAM_COMPRESSION_BYTES_SAVED_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMPRESSION_RUN_US_FIRST_SLOT = 1096,
+  GRPC_STATS_HISTOGRAM_COMPRESSION_RUN_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_NATIVE_DNS_RESOLVE_US_FIRST_SLOT = 1160,
+  GRPC_STATS_HISTOGRAM_NATIVE_DNS_RESOLVE_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_OAUTH2_TOKEN_FETCH_US_FIRST_SLOT = 1224,
+  GRPC_STATS_HISTOGRAM_OAUTH2_TOKEN_FETCH_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_PICK_LATENCY_US_FIRST_SLOT = 1288,
+  GRPC_STATS_HISTOGRAM_PICK_LATENCY_US_BUCKETS = 337,
+  GRPC_STATS_HISTOGRAM_WRITE_LATENCY_US_FIRST_SLOT = 1625,
+  GRPC_STATS_HISTOGRAM_WRITE_LATENCY_US_BUCKETS = 337,
+  GRPC_STATS_HISTOGRAM_CQ_DELIVERY_DELAY_US_FIRST_SLOT = 1962,
+  GRPC_STATS_HISTOGRAM_CQ_DELIVERY_DELAY_US_BUCKETS = 337,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 2299
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
@@ -187,6 +258,11 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED)
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED)
+#define GRPC_STATS_INC_CLIENT_RETRY_BUFFERED_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_RETRY_BUFFERED_BYTES)
+#define GRPC_STATS_INC_CLIENT_RETRY_BUFFER_OVERFLOW_COMMITS() \
+  GRPC_STATS_INC_COUNTER(                                     \
+      GRPC_STATS_COUNTER_CLIENT_RETRY_BUFFER_OVERFLOW_COMMITS)
 #define GRPC_STATS_INC_SERVER_CHANNELS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_CHANNELS_CREATED)
 #define GRPC_STATS_INC_SYSCALL_POLL() \
@@ -209,6 +285,14 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_EPOLL_CTL)
 #define GRPC_STATS_INC_POLLSET_FD_CACHE_HITS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_FD_CACHE_HITS)
+#define GRPC_STATS_INC_BUSY_POLL_SPIN_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_SPIN_HITS)
+#define GRPC_STATS_INC_BUSY_POLL_SPIN_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_SPIN_MISSES)
+#define GRPC_STATS_INC_POLLSET_NUMA_LOCAL_WAKEUPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_NUMA_LOCAL_WAKEUPS)
+#define GRPC_STATS_INC_POLLSET_NUMA_REMOTE_WAKEUPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_NUMA_REMOTE_WAKEUPS)
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS)
 #define GRPC_STATS_INC_SYSCALL_WRITE() \
@@ -219,6 +303,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED)
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS)
+#define GRPC_STATS_INC_TCP_ZEROCOPY_SENDS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_ZEROCOPY_SENDS)
+#define GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_ZEROCOPY_FALLBACKS)
+#define GRPC_STATS_INC_TCP_WRITE_COALESCED_RUNS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_WRITE_COALESCED_RUNS)
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_BATCHES)
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL() \
@@ -235,6 +325,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_RECV_MESSAGE)
 #define GRPC_STATS_INC_HTTP2_OP_RECV_TRAILING_METADATA() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_RECV_TRAILING_METADATA)
+#define GRPC_STATS_INC_HTTP2_SEND_DATA_FRAMES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_SEND_DATA_FRAMES)
+#define GRPC_STATS_INC_HTTP2_RECV_DATA_FRAMES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_RECV_DATA_FRAMES)
+#define GRPC_STATS_INC_HTTP2_RECV_MESSAGES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_RECV_MESSAGES)
 #define GRPC_STATS_INC_HTTP2_SETTINGS_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_SETTINGS_WRITES)
 #define GRPC_STATS_INC_HTTP2_PINGS_SENT() \
@@ -247,6 +343,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED)
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
+#define GRPC_STATS_INC_HTTP2_WRITES_HELD() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_HELD)
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE() \
   GRPC_STATS_INC_COUNTER(                                          \
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE)
@@ -334,6 +432,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_RECV_BINARY)
 #define GRPC_STATS_INC_HPACK_RECV_BINARY_BASE64() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_RECV_BINARY_BASE64)
+#define GRPC_STATS_INC_HPACK_RECV_STATIC_STRING() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_RECV_STATIC_STRING)
+#define GRPC_STATS_INC_HPACK_RECV_INTERNED_STRING() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_RECV_INTERNED_STRING)
 #define GRPC_STATS_INC_HPACK_SEND_INDEXED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_INDEXED)
 #define GRPC_STATS_INC_HPACK_SEND_LITHDR_INCIDX() \
@@ -356,6 +458,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY)
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64)
+#define GRPC_STATS_INC_HPACK_SEND_DYNIDX_HIT() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_DYNIDX_HIT)
+#define GRPC_STATS_INC_HPACK_SEND_DYNIDX_MISS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_DYNIDX_MISS)
+#define GRPC_STATS_INC_HPACK_SEND_PREENCODED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_PREENCODED)
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED)
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS() \
@@ -385,16 +493,62 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_QUEUE_DRAINED)
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES)
+#define GRPC_STATS_INC_EXECUTOR_STOLEN_ITEMS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_STOLEN_ITEMS)
+#define GRPC_STATS_INC_HANDSHAKER_OFFLOADED_STEPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HANDSHAKER_OFFLOADED_STEPS)
+#define GRPC_STATS_INC_HANDSHAKER_QUEUED_STEPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HANDSHAKER_QUEUED_STEPS)
+#define GRPC_STATS_INC_ALTS_HANDSHAKES_STARTED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_ALTS_HANDSHAKES_STARTED)
+#define GRPC_STATS_INC_ALTS_HANDSHAKES_QUEUED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_ALTS_HANDSHAKES_QUEUED)
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS)
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED)
+#define GRPC_STATS_INC_SERVER_REQUEST_MATCHER_LOCK_CONTENTIONS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUEST_MATCHER_LOCK_CONTENTIONS)
+#define GRPC_STATS_INC_SYNC_SERVER_QUEUE_DELAY_OVER_TARGET() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYNC_SERVER_QUEUE_DELAY_OVER_TARGET)
+#define GRPC_STATS_INC_SYNC_SERVER_THREAD_TARGET_RAISED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYNC_SERVER_THREAD_TARGET_RAISED)
+#define GRPC_STATS_INC_SYNC_SERVER_THREAD_TARGET_LOWERED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYNC_SERVER_THREAD_TARGET_LOWERED)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES)
+#define GRPC_STATS_INC_CQ_EV_QUEUE_STEALS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_STEALS)
+#define GRPC_STATS_INC_COMPRESSED_MESSAGES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMPRESSED_MESSAGES)
+#define GRPC_STATS_INC_COMPRESSION_SKIPPED_MESSAGES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMPRESSION_SKIPPED_MESSAGES)
+#define GRPC_STATS_INC_HEALTH_CHECK_STREAMS_STARTED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HEALTH_CHECK_STREAMS_STARTED)
+#define GRPC_STATS_INC_HEALTH_CHECK_STREAMS_ENDED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HEALTH_CHECK_STREAMS_ENDED)
+#define GRPC_STATS_INC_NATIVE_DNS_REQUESTS_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_NATIVE_DNS_REQUESTS_COALESCED)
+#define GRPC_STATS_INC_CQ_CALLBACK_EXECUTOR_HOPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_CALLBACK_EXECUTOR_HOPS)
+#define GRPC_STATS_INC_CQ_CALLBACK_INLINE_RUNS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_CALLBACK_INLINE_RUNS)
+#define GRPC_STATS_INC_SERVER_CALLS_SHED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_CALLS_SHED)
+#define GRPC_STATS_INC_OAUTH2_CALLS_QUEUED_FOR_TOKEN() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_OAUTH2_CALLS_QUEUED_FOR_TOKEN)
+#define GRPC_STATS_INC_OAUTH2_TOKEN_BACKGROUND_REFRESHES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_OAUTH2_TOKEN_BACKGROUND_REFRESHES)
+#define GRPC_STATS_INC_MEMORY_RECLAIMED_BUFFER_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_MEMORY_RECLAIMED_BUFFER_BYTES)
+#define GRPC_STATS_INC_MEMORY_RECLAIMED_HPACK_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_MEMORY_RECLAIMED_HPACK_BYTES)
+#define GRPC_STATS_INC_MEMORY_RECLAIMED_ARENA_POOL_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_MEMORY_RECLAIMED_ARENA_POOL_BYTES)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value) \
   grpc_stats_inc_call_initial_size((int)(value))
 void grpc_stats_inc_call_initial_size(int x);
@@ -434,12 +588,44 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
+#define GRPC_STATS_INC_COMBINER_QUEUE_WAIT_US(value) \
+  grpc_stats_inc_combiner_queue_wait_us((int)(value))
+void grpc_stats_inc_combiner_queue_wait_us(int x);
+#define GRPC_STATS_INC_COMBINER_RUN_US(value) \
+  grpc_stats_inc_combiner_run_us((int)(value))
+void grpc_stats_inc_combiner_run_us(int x);
+#define GRPC_STATS_INC_REGISTERED_CALL_INITIAL_SIZE(value) \
+  grpc_stats_inc_registered_call_initial_size((int)(value))
+void grpc_stats_inc_registered_call_initial_size(int x);
+#define GRPC_STATS_INC_COMPRESSION_BYTES_SAVED(value) \
+  grpc_stats_inc_compression_bytes_saved((int)(value))
+void grpc_stats_inc_compression_bytes_saved(int x);
+#define GRPC_STATS_INC_COMPRESSION_RUN_US(value) \
+  grpc_stats_inc_compression_run_us((int)(value))
+void grpc_stats_inc_compression_run_us(int x);
+#define GRPC_STATS_INC_NATIVE_DNS_RESOLVE_US(value) \
+  grpc_stats_inc_native_dns_resolve_us((int)(value))
+void grpc_stats_inc_native_dns_resolve_us(int x);
+#define GRPC_STATS_INC_OAUTH2_TOKEN_FETCH_US(value) \
+  grpc_stats_inc_oauth2_token_fetch_us((int)(value))
+void grpc_stats_inc_oauth2_token_fetch_us(int x);
+#define GRPC_STATS_INC_PICK_LATENCY_US(value) \
+  grpc_stats_inc_pick_latency_us((int)(value))
+void grpc_stats_inc_pick_latency_us(int x);
+#define GRPC_STATS_INC_WRITE_LATENCY_US(value) \
+  grpc_stats_inc_write_latency_us((int)(value))
+void grpc_stats_inc_write_latency_us(int x);
+#define GRPC_STATS_INC_CQ_DELIVERY_DELAY_US(value) \
+  grpc_stats_inc_cq_delivery_delay_us((int)(value))
+void grpc_stats_inc_cq_delivery_delay_us(int x);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
 #define GRPC_STATS_INC_CQS_CREATED()
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED()
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED()
+#define GRPC_STATS_INC_CLIENT_RETRY_BUFFERED_BYTES()
+#define GRPC_STATS_INC_CLIENT_RETRY_BUFFER_OVERFLOW_COMMITS()
 #define GRPC_STATS_INC_SERVER_CHANNELS_CREATED()
 #define GRPC_STATS_INC_SYSCALL_POLL()
 #define GRPC_STATS_INC_SYSCALL_WAIT()
@@ -451,11 +637,18 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD()
 #define GRPC_STATS_INC_SYSCALL_EPOLL_CTL()
 #define GRPC_STATS_INC_POLLSET_FD_CACHE_HITS()
+#define GRPC_STATS_INC_BUSY_POLL_SPIN_HITS()
+#define GRPC_STATS_INC_BUSY_POLL_SPIN_MISSES()
+#define GRPC_STATS_INC_POLLSET_NUMA_LOCAL_WAKEUPS()
+#define GRPC_STATS_INC_POLLSET_NUMA_REMOTE_WAKEUPS()
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS()
 #define GRPC_STATS_INC_SYSCALL_WRITE()
 #define GRPC_STATS_INC_SYSCALL_READ()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLERS_CREATED()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS()
+#define GRPC_STATS_INC_TCP_ZEROCOPY_SENDS()
+#define GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS()
+#define GRPC_STATS_INC_TCP_WRITE_COALESCED_RUNS()
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES()
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL()
 #define GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA()
@@ -464,12 +657,16 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_OP_RECV_INITIAL_METADATA()
 #define GRPC_STATS_INC_HTTP2_OP_RECV_MESSAGE()
 #define GRPC_STATS_INC_HTTP2_OP_RECV_TRAILING_METADATA()
+#define GRPC_STATS_INC_HTTP2_SEND_DATA_FRAMES()
+#define GRPC_STATS_INC_HTTP2_RECV_DATA_FRAMES()
+#define GRPC_STATS_INC_HTTP2_RECV_MESSAGES()
 #define GRPC_STATS_INC_HTTP2_SETTINGS_WRITES()
 #define GRPC_STATS_INC_HTTP2_PINGS_SENT()
 #define GRPC_STATS_INC_HTTP2_WRITES_BEGUN()
 #define GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED()
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED()
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES()
+#define GRPC_STATS_INC_HTTP2_WRITES_HELD()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE()
@@ -503,6 +700,8 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HPACK_RECV_HUFFMAN()
 #define GRPC_STATS_INC_HPACK_RECV_BINARY()
 #define GRPC_STATS_INC_HPACK_RECV_BINARY_BASE64()
+#define GRPC_STATS_INC_HPACK_RECV_STATIC_STRING()
+#define GRPC_STATS_INC_HPACK_RECV_INTERNED_STRING()
 #define GRPC_STATS_INC_HPACK_SEND_INDEXED()
 #define GRPC_STATS_INC_HPACK_SEND_LITHDR_INCIDX()
 #define GRPC_STATS_INC_HPACK_SEND_LITHDR_INCIDX_V()
@@ -514,6 +713,9 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HPACK_SEND_HUFFMAN()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64()
+#define GRPC_STATS_INC_HPACK_SEND_DYNIDX_HIT()
+#define GRPC_STATS_INC_HPACK_SEND_DYNIDX_MISS()
+#define GRPC_STATS_INC_HPACK_SEND_PREENCODED()
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS()
@@ -528,11 +730,34 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED()
 #define GRPC_STATS_INC_EXECUTOR_QUEUE_DRAINED()
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES()
+#define GRPC_STATS_INC_EXECUTOR_STOLEN_ITEMS()
+#define GRPC_STATS_INC_HANDSHAKER_OFFLOADED_STEPS()
+#define GRPC_STATS_INC_HANDSHAKER_QUEUED_STEPS()
+#define GRPC_STATS_INC_ALTS_HANDSHAKES_STARTED()
+#define GRPC_STATS_INC_ALTS_HANDSHAKES_QUEUED()
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS()
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED()
+#define GRPC_STATS_INC_SERVER_REQUEST_MATCHER_LOCK_CONTENTIONS()
+#define GRPC_STATS_INC_SYNC_SERVER_QUEUE_DELAY_OVER_TARGET()
+#define GRPC_STATS_INC_SYNC_SERVER_THREAD_TARGET_RAISED()
+#define GRPC_STATS_INC_SYNC_SERVER_THREAD_TARGET_LOWERED()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
+#define GRPC_STATS_INC_CQ_EV_QUEUE_STEALS()
+#define GRPC_STATS_INC_COMPRESSED_MESSAGES()
+#define GRPC_STATS_INC_COMPRESSION_SKIPPED_MESSAGES()
+#define GRPC_STATS_INC_HEALTH_CHECK_STREAMS_STARTED()
+#define GRPC_STATS_INC_HEALTH_CHECK_STREAMS_ENDED()
+#define GRPC_STATS_INC_NATIVE_DNS_REQUESTS_COALESCED()
+#define GRPC_STATS_INC_CQ_CALLBACK_EXECUTOR_HOPS()
+#define GRPC_STATS_INC_CQ_CALLBACK_INLINE_RUNS()
+#define GRPC_STATS_INC_SERVER_CALLS_SHED()
+#define GRPC_STATS_INC_OAUTH2_CALLS_QUEUED_FOR_TOKEN()
+#define GRPC_STATS_INC_OAUTH2_TOKEN_BACKGROUND_REFRESHES()
+#define GRPC_STATS_INC_MEMORY_RECLAIMED_BUFFER_BYTES()
+#define GRPC_STATS_INC_MEMORY_RECLAIMED_HPACK_BYTES()
+#define GRPC_STATS_INC_MEMORY_RECLAIMED_ARENA_POOL_BYTES()
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value)
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value)
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value)
@@ -546,10 +771,20 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
+#define GRPC_STATS_INC_COMBINER_QUEUE_WAIT_US(value)
+#define GRPC_STATS_INC_COMBINER_RUN_US(value)
+#define GRPC_STATS_INC_REGISTERED_CALL_INITIAL_SIZE(value)
+#define GRPC_STATS_INC_COMPRESSION_BYTES_SAVED(value)
+#define GRPC_STATS_INC_COMPRESSION_RUN_US(value)
+#define GRPC_STATS_INC_NATIVE_DNS_RESOLVE_US(value)
+#define GRPC_STATS_INC_OAUTH2_TOKEN_FETCH_US(value)
+#define GRPC_STATS_INC_PICK_LATENCY_US(value)
+#define GRPC_STATS_INC_WRITE_LATENCY_US(value)
+#define GRPC_STATS_INC_CQ_DELIVERY_DELAY_US(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[23];
+extern const int grpc_stats_histo_start[23];
+extern const int* const grpc_stats_histo_bucket_boundaries[23];
+extern void (*const grpc_stats_inc_histogram[23])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
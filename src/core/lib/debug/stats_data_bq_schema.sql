@@ -3,6 +3,8 @@ server_calls_created_per_iteration:FLOAT,
 cqs_created_per_iteration:FLOAT,
 client_channels_created_per_iteration:FLOAT,
 client_subchannels_created_per_iteration:FLOAT,
+client_retry_buffered_bytes_per_iteration:FLOAT,
+client_retry_buffer_overflow_commits_per_iteration:FLOAT,
 server_channels_created_per_iteration:FLOAT,
 syscall_poll_per_iteration:FLOAT,
 syscall_wait_per_iteration:FLOAT,
@@ -14,11 +16,18 @@ pollset_kick_wakeup_cv_per_iteration:FLOAT,
 pollset_kick_own_thread_per_iteration:FLOAT,
 syscall_epoll_ctl_per_iteration:FLOAT,
 pollset_fd_cache_hits_per_iteration:FLOAT,
+busy_poll_spin_hits_per_iteration:FLOAT,
+busy_poll_spin_misses_per_iteration:FLOAT,
+pollset_numa_local_wakeups_per_iteration:FLOAT,
+pollset_numa_remote_wakeups_per_iteration:FLOAT,
 histogram_slow_lookups_per_iteration:FLOAT,
 syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
 tcp_backup_pollers_created_per_iteration:FLOAT,
 tcp_backup_poller_polls_per_iteration:FLOAT,
+tcp_zerocopy_sends_per_iteration:FLOAT,
+tcp_zerocopy_fallbacks_per_iteration:FLOAT,
+tcp_write_coalesced_runs_per_iteration:FLOAT,
 http2_op_batches_per_iteration:FLOAT,
 http2_op_cancel_per_iteration:FLOAT,
 http2_op_send_initial_metadata_per_iteration:FLOAT,
@@ -27,12 +36,16 @@ http2_op_send_trailing_metadata_per_iteration:FLOAT,
 http2_op_recv_initial_metadata_per_iteration:FLOAT,
 http2_op_recv_message_per_iteration:FLOAT,
 http2_op_recv_trailing_metadata_per_iteration:FLOAT,
+http2_send_data_frames_per_iteration:FLOAT,
+http2_recv_data_frames_per_iteration:FLOAT,
+http2_recv_messages_per_iteration:FLOAT,
 http2_settings_writes_per_iteration:FLOAT,
 http2_pings_sent_per_iteration:FLOAT,
 http2_writes_begun_per_iteration:FLOAT,
 http2_writes_offloaded_per_iteration:FLOAT,
 http2_writes_continued_per_iteration:FLOAT,
 http2_partial_writes_per_iteration:FLOAT,
+http2_writes_held_per_iteration:FLOAT,
 http2_initiate_write_due_to_initial_write_per_iteration:FLOAT,
 http2_initiate_write_due_to_start_new_stream_per_iteration:FLOAT,
 http2_initiate_write_due_to_send_message_per_iteration:FLOAT,
@@ -66,6 +79,8 @@ hpack_recv_uncompressed_per_iteration:FLOAT,
 hpack_recv_huffman_per_iteration:FLOAT,
 hpack_recv_binary_per_iteration:FLOAT,
 hpack_recv_binary_base64_per_iteration:FLOAT,
+hpack_recv_static_string_per_iteration:FLOAT,
+hpack_recv_interned_string_per_iteration:FLOAT,
 hpack_send_indexed_per_iteration:FLOAT,
 hpack_send_lithdr_incidx_per_iteration:FLOAT,
 hpack_send_lithdr_incidx_v_per_iteration:FLOAT,
@@ -77,6 +92,9 @@ hpack_send_uncompressed_per_iteration:FLOAT,
 hpack_send_huffman_per_iteration:FLOAT,
 hpack_send_binary_per_iteration:FLOAT,
 hpack_send_binary_base64_per_iteration:FLOAT,
+hpack_send_dynidx_hit_per_iteration:FLOAT,
+hpack_send_dynidx_miss_per_iteration:FLOAT,
+hpack_send_preencoded_per_iteration:FLOAT,
 combiner_locks_initiated_per_iteration:FLOAT,
 combiner_locks_scheduled_items_per_iteration:FLOAT,
 combiner_locks_scheduled_final_items_per_iteration:FLOAT,
@@ -91,8 +109,31 @@ executor_scheduled_to_self_per_iteration:FLOAT,
 executor_wakeup_initiated_per_iteration:FLOAT,
 executor_queue_drained_per_iteration:FLOAT,
 executor_push_retries_per_iteration:FLOAT,
+executor_stolen_items_per_iteration:FLOAT,
+handshaker_offloaded_steps_per_iteration:FLOAT,
+handshaker_queued_steps_per_iteration:FLOAT,
+alts_handshakes_started_per_iteration:FLOAT,
+alts_handshakes_queued_per_iteration:FLOAT,
 server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
+server_request_matcher_lock_contentions_per_iteration:FLOAT,
+sync_server_queue_delay_over_target_per_iteration:FLOAT,
+sync_server_thread_target_raised_per_iteration:FLOAT,
+sync_server_thread_target_lowered_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
-cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
+cq_ev_queue_transient_pop_failures_per_iteration:FLOAT,
+cq_ev_queue_steals_per_iteration:FLOAT,
+compressed_messages_per_iteration:FLOAT,
+compression_skipped_messages_per_iteration:FLOAT,
+health_check_streams_started_per_iteration:FLOAT,
+health_check_streams_ended_per_iteration:FLOAT,
+native_dns_requests_coalesced_per_iteration:FLOAT,
+cq_callback_executor_hops_per_iteration:FLOAT,
+cq_callback_inline_runs_per_iteration:FLOAT,
+server_calls_shed_per_iteration:FLOAT,
+oauth2_calls_queued_for_token_per_iteration:FLOAT,
+oauth2_token_background_refreshes_per_iteration:FLOAT,
+memory_reclaimed_buffer_bytes_per_iteration:FLOAT,
+memory_reclaimed_hpack_bytes_per_iteration:FLOAT,
+memory_reclaimed_arena_pool_bytes_per_iteration:FLOAT
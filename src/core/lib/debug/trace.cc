@@ -144,6 +144,13 @@ void grpc_tracer_init(const char* env_var_name) {
 
 void grpc_tracer_init() {
   grpc_core::UniquePtr<char> value = GPR_GLOBAL_CONFIG_GET(grpc_trace);
+#if !defined(GRPC_USE_TRACERS) && defined(NDEBUG)
+  if (value.get()[0] != '\0') {
+    gpr_log(GPR_ERROR,
+            "GRPC_TRACE is ignored: tracers were compiled out with "
+            "GRPC_NO_TRACERS");
+  }
+#endif
   parse(value.get());
 }
 
@@ -0,0 +1,231 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gpr/log_async.h"
+
+#if defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG)
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_log_async, false,
+    "If set, debug and info log lines are written to stderr by a background "
+    "thread instead of the thread that logs them. Lines from different "
+    "threads may be reordered, lines are dropped rather than blocking when "
+    "the writer falls behind, and lines still queued when the process exits "
+    "are lost.");
+
+/* Each logging thread owns a single-producer ring of length-prefixed lines,
+   which the writer thread drains. Rings are allocated on first use, never
+   freed, and handed to a new thread when their owner exits. */
+#define RING_SIZE (64 * 1024)
+#define MAX_RINGS 64
+/* Longer lines are truncated. */
+#define MAX_LINE 4096
+#define WRITER_IDLE_MS 10
+
+typedef struct {
+  /* Set while a thread owns the ring. */
+  gpr_atm in_use;
+  /* Bytes ever written by the owner and consumed by the writer. */
+  gpr_atm head;
+  gpr_atm tail;
+  /* RING_SIZE bytes, published once. */
+  gpr_atm buf;
+} ring;
+
+static ring g_rings[MAX_RINGS];
+static gpr_atm g_dropped;
+/* Wakes the writer early when a ring fills past half. */
+static gpr_mu g_mu;
+static gpr_cv g_cv;
+static bool g_enabled;
+static gpr_once g_once = GPR_ONCE_INIT;
+static pthread_key_t g_ring_key;
+/* Stored for threads that found no free ring, so they don't look again. */
+static char g_no_ring;
+
+static void ring_copy_in(char* buf, uintptr_t pos, const void* src,
+                         size_t len) {
+  size_t offset = pos % RING_SIZE;
+  size_t first = GPR_MIN(len, RING_SIZE - offset);
+  memcpy(buf + offset, src, first);
+  memcpy(buf, static_cast<const char*>(src) + first, len - first);
+}
+
+static void ring_copy_out(const char* buf, uintptr_t pos, void* dst,
+                          size_t len) {
+  size_t offset = pos % RING_SIZE;
+  size_t first = GPR_MIN(len, RING_SIZE - offset);
+  memcpy(dst, buf + offset, first);
+  memcpy(static_cast<char*>(dst) + first, buf, len - first);
+}
+
+static void release_ring(void* arg) {
+  if (arg == &g_no_ring) return;
+  gpr_atm_rel_store(&static_cast<ring*>(arg)->in_use, 0);
+}
+
+static ring* get_ring() {
+  void* p = pthread_getspecific(g_ring_key);
+  if (p != nullptr) {
+    return p == &g_no_ring ? nullptr : static_cast<ring*>(p);
+  }
+  for (size_t i = 0; i < MAX_RINGS; ++i) {
+    ring* r = &g_rings[i];
+    if (gpr_atm_no_barrier_load(&r->in_use) == 0 &&
+        gpr_atm_acq_cas(&r->in_use, 0, 1)) {
+      if (gpr_atm_acq_load(&r->buf) == 0) {
+        gpr_atm_rel_store(&r->buf,
+                          reinterpret_cast<gpr_atm>(gpr_malloc(RING_SIZE)));
+      }
+      pthread_setspecific(g_ring_key, r);
+      return r;
+    }
+  }
+  pthread_setspecific(g_ring_key, &g_no_ring);
+  return nullptr;
+}
+
+/* Appends as many whole lines from \a r to \a out as fit. Returns false if
+   lines are left. */
+static bool drain_ring(ring* r, char* out, size_t* out_len, size_t out_cap) {
+  const char* buf = reinterpret_cast<const char*>(gpr_atm_acq_load(&r->buf));
+  if (buf == nullptr) return true;
+  uintptr_t tail = static_cast<uintptr_t>(gpr_atm_no_barrier_load(&r->tail));
+  const uintptr_t head = static_cast<uintptr_t>(gpr_atm_acq_load(&r->head));
+  bool drained = true;
+  while (tail != head) {
+    uint32_t len;
+    ring_copy_out(buf, tail, &len, sizeof(len));
+    if (out_cap - *out_len < len) {
+      drained = false;
+      break;
+    }
+    ring_copy_out(buf, tail + sizeof(len), out + *out_len, len);
+    *out_len += len;
+    tail += sizeof(len) + len;
+  }
+  gpr_atm_rel_store(&r->tail, static_cast<gpr_atm>(tail));
+  return drained;
+}
+
+static void* writer_thread(void* /*arg*/) {
+  char* out = static_cast<char*>(gpr_malloc(RING_SIZE));
+  for (;;) {
+    bool idle = true;
+    for (size_t i = 0; i < MAX_RINGS; ++i) {
+      size_t out_len = 0;
+      while (!drain_ring(&g_rings[i], out, &out_len, RING_SIZE)) {
+        fwrite(out, 1, out_len, stderr);
+        out_len = 0;
+        idle = false;
+      }
+      if (out_len > 0) {
+        fwrite(out, 1, out_len, stderr);
+        idle = false;
+      }
+    }
+    gpr_atm dropped = gpr_atm_full_xchg(&g_dropped, 0);
+    if (dropped > 0) {
+      fprintf(stderr, "gpr_log: dropped %" PRIdPTR " lines\n", dropped);
+    }
+    if (idle) {
+      gpr_mu_lock(&g_mu);
+      gpr_cv_wait(&g_cv, &g_mu,
+                  gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                               gpr_time_from_millis(WRITER_IDLE_MS,
+                                                    GPR_TIMESPAN)));
+      gpr_mu_unlock(&g_mu);
+    }
+  }
+  return nullptr;
+}
+
+static void init_async_log() {
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_log_async)) return;
+  if (pthread_key_create(&g_ring_key, release_ring) != 0) return;
+  gpr_mu_init(&g_mu);
+  gpr_cv_init(&g_cv);
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  pthread_t writer;
+  g_enabled = pthread_create(&writer, &attr, writer_thread, nullptr) == 0;
+  pthread_attr_destroy(&attr);
+}
+
+bool gpr_log_async_print(gpr_log_severity severity, int prefix_width,
+                         const char* prefix, const char* message) {
+  /* Also keeps any error logged by the config lookup in init_async_log() out
+     of the once it runs in. */
+  if (severity == GPR_LOG_SEVERITY_ERROR) return false;
+  gpr_once_init(&g_once, init_async_log);
+  if (!g_enabled) return false;
+  ring* r = get_ring();
+  if (r == nullptr) return false;
+  char line[MAX_LINE];
+  int n = snprintf(line, sizeof(line), "%-*s %s\n", prefix_width, prefix,
+                   message);
+  if (n < 0) return false;
+  uint32_t len = static_cast<uint32_t>(n);
+  if (len >= sizeof(line)) {
+    len = sizeof(line) - 1;
+    line[len - 1] = '\n';
+  }
+  char* buf = reinterpret_cast<char*>(gpr_atm_no_barrier_load(&r->buf));
+  const uintptr_t head =
+      static_cast<uintptr_t>(gpr_atm_no_barrier_load(&r->head));
+  const uintptr_t tail = static_cast<uintptr_t>(gpr_atm_acq_load(&r->tail));
+  const uintptr_t used = head - tail;
+  if (RING_SIZE - used < sizeof(len) + len) {
+    gpr_atm_no_barrier_fetch_add(&g_dropped, 1);
+    return true;
+  }
+  ring_copy_in(buf, head, &len, sizeof(len));
+  ring_copy_in(buf, head + sizeof(len), line, len);
+  gpr_atm_rel_store(&r->head, static_cast<gpr_atm>(head + sizeof(len) + len));
+  if (used <= RING_SIZE / 2 && used + sizeof(len) + len > RING_SIZE / 2) {
+    gpr_mu_lock(&g_mu);
+    gpr_cv_signal(&g_cv);
+    gpr_mu_unlock(&g_mu);
+  }
+  return true;
+}
+
+#else /* !(defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG)) */
+
+bool gpr_log_async_print(gpr_log_severity /*severity*/, int /*prefix_width*/,
+                         const char* /*prefix*/, const char* /*message*/) {
+  return false;
+}
+
+#endif /* defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG) */
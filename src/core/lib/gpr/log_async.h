@@ -0,0 +1,36 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPR_LOG_ASYNC_H
+#define GRPC_CORE_LIB_GPR_LOG_ASYNC_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/support/log.h>
+
+/* When GRPC_LOG_ASYNC is set, queues the line "<prefix> <message>\n", with
+   the prefix padded to prefix_width, for a background thread to write to
+   stderr, and returns true. The line is counted and dropped if the calling
+   thread's queue is full. Returns false, leaving the caller to write the line
+   itself, if async logging is off or unsupported, for errors, which are
+   written before the process may abort, and for threads beyond the ones that
+   can get a queue. */
+bool gpr_log_async_print(gpr_log_severity severity, int prefix_width,
+                         const char* prefix, const char* message);
+
+#endif /* GRPC_CORE_LIB_GPR_LOG_ASYNC_H */
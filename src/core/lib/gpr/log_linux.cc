@@ -40,6 +40,8 @@
 #include <time.h>
 #include <unistd.h>
 
+#include "src/core/lib/gpr/log_async.h"
+
 static long sys_gettid(void) { return syscall(__NR_gettid); }
 
 void gpr_log(const char* file, int line, gpr_log_severity severity,
@@ -90,7 +92,9 @@ void gpr_default_log(gpr_log_func_args* args) {
                gpr_log_severity_string(args->severity), time_buffer,
                now.tv_nsec, tid, display_file, args->line);
 
-  fprintf(stderr, "%-60s %s\n", prefix, args->message);
+  if (!gpr_log_async_print(args->severity, 60, prefix, args->message)) {
+    fprintf(stderr, "%-60s %s\n", prefix, args->message);
+  }
   gpr_free(prefix);
 }
 
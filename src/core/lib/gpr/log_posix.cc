@@ -31,6 +31,8 @@
 #include <string.h>
 #include <time.h>
 
+#include "src/core/lib/gpr/log_async.h"
+
 static intptr_t sys_gettid(void) { return (intptr_t)pthread_self(); }
 
 void gpr_log(const char* file, int line, gpr_log_severity severity,
@@ -88,7 +90,9 @@ void gpr_default_log(gpr_log_func_args* args) {
                gpr_log_severity_string(args->severity), time_buffer,
                (int)(now.tv_nsec), sys_gettid(), display_file, args->line);
 
-  fprintf(stderr, "%-70s %s\n", prefix, args->message);
+  if (!gpr_log_async_print(args->severity, 70, prefix, args->message)) {
+    fprintf(stderr, "%-70s %s\n", prefix, args->message);
+  }
   gpr_free(prefix);
 }
 
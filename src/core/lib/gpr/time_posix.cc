@@ -62,7 +62,10 @@ static gpr_timespec gpr_from_timespec(struct timespec ts,
 static const clockid_t clockid_for_gpr_clock[] = {CLOCK_MONOTONIC,
                                                   CLOCK_REALTIME};
 
-void gpr_time_init(void) { gpr_precise_clock_init(); }
+void gpr_time_init(void) {
+  gpr_precise_clock_init();
+  gpr_cycle_clock_init();
+}
 
 static gpr_timespec now_impl(gpr_clock_type clock_type) {
   struct timespec now;
@@ -72,6 +75,11 @@ static gpr_timespec now_impl(gpr_clock_type clock_type) {
     gpr_precise_clock_now(&ret);
     return ret;
   } else {
+    gpr_timespec ret;
+    if (clock_type == GPR_CLOCK_MONOTONIC &&
+        gpr_cycle_clock_monotonic_now(&ret)) {
+      return ret;
+    }
 #if defined(GPR_BACKWARDS_COMPATIBILITY_MODE) && defined(__linux__)
     /* avoid ABI problems by invoking syscalls directly */
     syscall(SYS_clock_gettime, clockid_for_gpr_clock[clock_type], &now);
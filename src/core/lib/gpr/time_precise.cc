@@ -27,10 +27,200 @@
 
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
 #include "src/core/lib/gpr/time_precise.h"
 
+#ifdef GPR_HAS_CYCLE_CLOCK
+#include <cpuid.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <atomic>
+#endif /* GPR_HAS_CYCLE_CLOCK */
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_cycle_clock, false,
+    "If set, read the monotonic clock from the CPU's time stamp counter when "
+    "the hardware and kernel allow it, instead of asking the kernel.")
+
+#ifdef GPR_HAS_CYCLE_CLOCK
+// The cycle clock extrapolates the kernel's monotonic clock along a line
+// through (cycle, ns) with slope ns_per_cycle. Whichever reader first notices
+// that CYCLE_CLOCK_UPDATE_NS have passed re-anchors the line on a fresh
+// reading of the kernel clock. The new line continues from the old one so the
+// clock never goes backwards. Its slope is set to meet the kernel clock again
+// by the next update, which absorbs any adjustment the kernel made
+// meanwhile. The clock is off until the first update has measured the
+// counter's rate, and for good once it strays more than
+// CYCLE_CLOCK_MAX_ERROR_NS from the kernel.
+#define CYCLE_CLOCK_UPDATE_NS GPR_NS_PER_SEC
+#define CYCLE_CLOCK_MAX_ERROR_NS (10 * GPR_NS_PER_MS)
+
+namespace {
+
+enum { kCycleClockOff, kCycleClockCalibrating, kCycleClockOn };
+
+struct CycleClock {
+  std::atomic<int> state{kCycleClockOff};
+  std::atomic<bool> updating{false};
+  std::atomic<int64_t> next_update_cycle{0};
+  // Seqlock over the line: odd while it is being written.
+  std::atomic<uint64_t> seq{0};
+  std::atomic<int64_t> cycle{0};
+  std::atomic<int64_t> ns{0};
+  std::atomic<double> ns_per_cycle{0};
+  // Set once by gpr_cycle_clock_init(), and used to measure the long-term
+  // rate of the counter.
+  int64_t first_cycle = 0;
+  int64_t first_ns = 0;
+};
+
+CycleClock g_cycle_clock;
+gpr_once g_cycle_clock_once = GPR_ONCE_INIT;
+
+int64_t read_tsc() {
+  uint64_t low, high;
+  __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+  return static_cast<int64_t>((high << 32) | low);
+}
+
+// Reads the kernel's monotonic clock, along with the cycle it was read at.
+int64_t kernel_monotonic_ns(int64_t* cycle) {
+  struct timespec ts;
+  const int64_t before = read_tsc();
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  const int64_t after = read_tsc();
+  *cycle = before + (after - before) / 2;
+  return static_cast<int64_t>(ts.tv_sec) * GPR_NS_PER_SEC + ts.tv_nsec;
+}
+
+bool tsc_is_trusted() {
+  // An invariant counter ticks at the same rate in every power state.
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) ||
+      (edx & (1u << 8)) == 0) {
+    return false;
+  }
+  // The kernel only keeps tsc as its clocksource while the counters of all
+  // CPUs agree with each other.
+  int fd = open("/sys/devices/system/clocksource/clocksource0/"
+                "current_clocksource",
+                O_RDONLY);
+  if (fd == -1) return false;
+  char line[32] = {};
+  const ssize_t len = read(fd, line, sizeof(line) - 1);
+  close(fd);
+  return len > 0 && strcmp(line, "tsc\n") == 0;
+}
+
+int64_t line_ns(int64_t cycle, int64_t anchor_cycle, int64_t anchor_ns,
+                double ns_per_cycle) {
+  return anchor_ns +
+         static_cast<int64_t>(static_cast<double>(cycle - anchor_cycle) *
+                              ns_per_cycle);
+}
+
+void publish_line(int64_t cycle, int64_t ns, double ns_per_cycle) {
+  CycleClock* c = &g_cycle_clock;
+  const uint64_t seq = c->seq.load(std::memory_order_relaxed);
+  c->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  c->cycle.store(cycle, std::memory_order_relaxed);
+  c->ns.store(ns, std::memory_order_relaxed);
+  c->ns_per_cycle.store(ns_per_cycle, std::memory_order_relaxed);
+  c->seq.store(seq + 2, std::memory_order_release);
+}
+
+void update_cycle_clock() {
+  CycleClock* c = &g_cycle_clock;
+  if (c->updating.exchange(true, std::memory_order_acquire)) return;
+  int64_t cycle;
+  const int64_t kernel_ns = kernel_monotonic_ns(&cycle);
+  const double rate = static_cast<double>(kernel_ns - c->first_ns) /
+                      static_cast<double>(cycle - c->first_cycle);
+  int next_state = kCycleClockOn;
+  if (!(rate > 0)) {
+    next_state = kCycleClockOff;
+  } else if (c->state.load(std::memory_order_relaxed) ==
+             kCycleClockCalibrating) {
+    publish_line(cycle, kernel_ns, rate);
+  } else {
+    // Only updates write the line, so it can be read without the seqlock.
+    const int64_t ns =
+        line_ns(cycle, c->cycle.load(std::memory_order_relaxed),
+                c->ns.load(std::memory_order_relaxed),
+                c->ns_per_cycle.load(std::memory_order_relaxed));
+    if (std::abs(ns - kernel_ns) > CYCLE_CLOCK_MAX_ERROR_NS) {
+      next_state = kCycleClockOff;
+    } else {
+      // Jump forward to the kernel clock, or slow down until it catches up.
+      const int64_t anchor_ns = std::max(ns, kernel_ns);
+      const double slope =
+          rate * static_cast<double>(kernel_ns + CYCLE_CLOCK_UPDATE_NS -
+                                     anchor_ns) /
+          CYCLE_CLOCK_UPDATE_NS;
+      publish_line(cycle, anchor_ns, slope);
+    }
+  }
+  if (next_state == kCycleClockOff) {
+    gpr_log(GPR_INFO, "cycle clock disagrees with the kernel, turning it off");
+  } else {
+    c->next_update_cycle.store(
+        cycle + static_cast<int64_t>(CYCLE_CLOCK_UPDATE_NS / rate),
+        std::memory_order_relaxed);
+  }
+  c->state.store(next_state, std::memory_order_release);
+  c->updating.store(false, std::memory_order_release);
+}
+
+void init_cycle_clock() {
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_cycle_clock) || !tsc_is_trusted()) return;
+  CycleClock* c = &g_cycle_clock;
+  c->first_ns = kernel_monotonic_ns(&c->first_cycle);
+  // Long enough to measure the rate to well within a part per million.
+  c->next_update_cycle.store(c->first_cycle + 100000000,
+                             std::memory_order_relaxed);
+  c->state.store(kCycleClockCalibrating, std::memory_order_release);
+}
+
+}  // namespace
+
+void gpr_cycle_clock_init(void) {
+  gpr_once_init(&g_cycle_clock_once, init_cycle_clock);
+}
+
+bool gpr_cycle_clock_monotonic_now(gpr_timespec* clk) {
+  CycleClock* c = &g_cycle_clock;
+  if (c->state.load(std::memory_order_acquire) == kCycleClockOff) return false;
+  int64_t cycle = read_tsc();
+  if (cycle >= c->next_update_cycle.load(std::memory_order_relaxed)) {
+    update_cycle_clock();
+    cycle = read_tsc();
+  }
+  if (c->state.load(std::memory_order_acquire) != kCycleClockOn) return false;
+  int64_t ns;
+  for (;;) {
+    const uint64_t seq = c->seq.load(std::memory_order_acquire);
+    ns = line_ns(cycle, c->cycle.load(std::memory_order_relaxed),
+                 c->ns.load(std::memory_order_relaxed),
+                 c->ns_per_cycle.load(std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((seq & 1) == 0 && c->seq.load(std::memory_order_relaxed) == seq) break;
+  }
+  clk->tv_sec = ns / GPR_NS_PER_SEC;
+  clk->tv_nsec = static_cast<int32_t>(ns % GPR_NS_PER_SEC);
+  clk->clock_type = GPR_CLOCK_MONOTONIC;
+  return true;
+}
+#else  /* GPR_HAS_CYCLE_CLOCK */
+void gpr_cycle_clock_init(void) {}
+
+bool gpr_cycle_clock_monotonic_now(gpr_timespec* /*clk*/) { return false; }
+#endif /* GPR_HAS_CYCLE_CLOCK */
+
 #if GPR_CYCLE_COUNTER_RDTSC_32 or GPR_CYCLE_COUNTER_RDTSC_64
 #if GPR_LINUX
 static bool read_freq_from_kernel(double* freq) {
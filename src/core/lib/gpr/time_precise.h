@@ -24,6 +24,8 @@
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gprpp/global_config.h"
+
 // Depending on the platform gpr_get_cycle_counter() can have a resolution as
 // low as a usec. Use other clock sources or gpr_precise_clock_now(),
 // where you need high resolution clocks.
@@ -58,6 +60,20 @@ gpr_cycle_counter gpr_get_cycle_counter();
     GPR_CYCLE_COUNTER_FALLBACK
 #endif
 
+// The cycle clock reads GPR_CLOCK_MONOTONIC from the x86 time stamp counter,
+// without a call into the kernel. It is used by gpr_now() on Linux when
+// GRPC_CYCLE_CLOCK is set, the counter ticks at a constant rate and the kernel
+// keeps it synchronized across CPUs, and otherwise stays off.
+#if defined(GPR_LINUX) && (defined(__x86_64__) || defined(__amd64__))
+#define GPR_HAS_CYCLE_CLOCK 1
+#endif
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_cycle_clock);
+
+void gpr_cycle_clock_init(void);
+// Returns false, leaving \a clk alone, if the cycle clock is off.
+bool gpr_cycle_clock_monotonic_now(gpr_timespec* clk);
+
 void gpr_precise_clock_init(void);
 void gpr_precise_clock_now(gpr_timespec* clk);
 gpr_timespec gpr_cycle_counter_to_time(gpr_cycle_counter cycles);
@@ -0,0 +1,111 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPRPP_ALIAS_TABLE_H
+#define GRPC_CORE_LIB_GPRPP_ALIAS_TABLE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "src/core/lib/gprpp/inlined_vector.h"
+
+namespace grpc_core {
+
+// Picks an index with a probability proportional to its weight, in constant
+// time, using Walker's alias method. The table is built with Vose's
+// algorithm, in time linear in the number of weights.
+//
+// There is an entry per weight. A pick chooses an entry uniformly, then a key
+// uniformly in [0, total_weight()). The entry resolves to its own index if
+// the key is below the entry's threshold, and to its alias otherwise. The
+// weights are scaled by the number of entries, so that every entry holds
+// exactly total_weight() and the integer arithmetic is exact.
+class AliasTable {
+ public:
+  explicit AliasTable(const InlinedVector<uint32_t, 1>& weights) {
+    const size_t num_weights = weights.size();
+    for (size_t i = 0; i < num_weights; ++i) {
+      total_weight_ += weights[i];
+    }
+    entries_.resize(num_weights);
+    InlinedVector<uint64_t, 1> scaled_weights;
+    // Entries whose weight is less than a full entry, and the others.
+    InlinedVector<size_t, 1> underfull;
+    InlinedVector<size_t, 1> overfull;
+    for (size_t i = 0; i < num_weights; ++i) {
+      scaled_weights.push_back(static_cast<uint64_t>(weights[i]) *
+                               num_weights);
+      if (scaled_weights[i] < total_weight_) {
+        underfull.push_back(i);
+      } else {
+        overfull.push_back(i);
+      }
+    }
+    while (!underfull.empty() && !overfull.empty()) {
+      const size_t u = underfull[underfull.size() - 1];
+      underfull.pop_back();
+      const size_t o = overfull[overfull.size() - 1];
+      // Fill the rest of the underfull entry with the overfull one.
+      entries_[u] = {scaled_weights[u], o};
+      scaled_weights[o] -= total_weight_ - scaled_weights[u];
+      if (scaled_weights[o] < total_weight_) {
+        overfull.pop_back();
+        underfull.push_back(o);
+      }
+    }
+    // The remaining entries are exactly full.
+    for (size_t i = 0; i < underfull.size(); ++i) {
+      entries_[underfull[i]] = {total_weight_, underfull[i]};
+    }
+    for (size_t i = 0; i < overfull.size(); ++i) {
+      entries_[overfull[i]] = {total_weight_, overfull[i]};
+    }
+  }
+
+  size_t size() const { return entries_.size(); }
+  uint64_t total_weight() const { return total_weight_; }
+
+  // Returns the index that \a entry resolves to for \a key, which must be in
+  // [0, total_weight()).
+  size_t Resolve(size_t entry, uint64_t key) const {
+    return key < entries_[entry].threshold ? entry : entries_[entry].alias;
+  }
+
+  // Returns a random index. The table must have a weight that is not 0.
+  size_t Pick() const {
+    const size_t entry = rand() % entries_.size();
+    const uint64_t key = static_cast<uint64_t>(rand()) % total_weight_;
+    return Resolve(entry, key);
+  }
+
+ private:
+  struct Entry {
+    uint64_t threshold;
+    size_t alias;
+  };
+
+  InlinedVector<Entry, 1> entries_;
+  uint64_t total_weight_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_GPRPP_ALIAS_TABLE_H */
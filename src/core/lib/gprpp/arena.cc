@@ -25,10 +25,12 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 
 namespace {
@@ -100,4 +102,119 @@ void* Arena::AllocZone(size_t size) {
   return reinterpret_cast<char*>(z) + zone_base_size;
 }
 
+constexpr size_t ArenaPool::kMinStorageShift;
+constexpr size_t ArenaPool::kMaxStorageShift;
+constexpr size_t ArenaPool::kNumBuckets;
+
+ArenaPool::ArenaPool(size_t max_bytes)
+    : num_shards_(GPR_CLAMP(gpr_cpu_num_cores(), 1, 32)),
+      shards_(new Shard[num_shards_]) {
+  for (size_t i = 0; i < num_shards_; i++) {
+    shards_[i].max_bytes = max_bytes / num_shards_;
+  }
+}
+
+ArenaPool::~ArenaPool() {
+  for (size_t i = 0; i < num_shards_; i++) {
+    for (size_t j = 0; j < kNumBuckets; j++) {
+      FreeStorage* storage = shards_[i].free_storage[j];
+      while (storage != nullptr) {
+        FreeStorage* next = storage->next;
+        gpr_free_aligned(storage);
+        storage = next;
+      }
+    }
+  }
+  delete[] shards_;
+}
+
+ArenaPool::Shard* ArenaPool::CurrentShard() {
+  return &shards_[gpr_cpu_current_cpu() % num_shards_];
+}
+
+std::pair<Arena*, void*> ArenaPool::CreateWithAlloc(size_t initial_size,
+                                                    size_t alloc_size) {
+  static constexpr size_t base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
+  size_t storage_size =
+      base_size + GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
+  size_t bucket = 0;
+  while ((size_t(1) << (kMinStorageShift + bucket)) < storage_size) {
+    if (++bucket == kNumBuckets) {
+      return Arena::CreateWithAlloc(initial_size, alloc_size);
+    }
+  }
+  storage_size = size_t(1) << (kMinStorageShift + bucket);
+  Shard* shard = CurrentShard();
+  gpr_spinlock_lock(&shard->lock);
+  void* storage = shard->free_storage[bucket];
+  if (storage != nullptr) {
+    shard->free_storage[bucket] = shard->free_storage[bucket]->next;
+    shard->cached_bytes -= storage_size;
+  }
+  gpr_spinlock_unlock(&shard->lock);
+  if (storage == nullptr) {
+    storage = ArenaStorage(storage_size - base_size);
+  }
+  auto* new_arena = new (storage) Arena(storage_size - base_size, alloc_size);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  return std::make_pair(new_arena, first_alloc);
+}
+
+size_t ArenaPool::Destroy(Arena* arena) {
+  static constexpr size_t base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
+  size_t size = arena->total_used_.Load(MemoryOrder::RELAXED);
+  size_t storage_size = base_size + arena->initial_zone_size_;
+  arena->~Arena();
+  // Storage too large for any bucket came from Arena::CreateWithAlloc(), and
+  // is never a bucket's size.
+  size_t bucket = kNumBuckets;
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    if ((size_t(1) << (kMinStorageShift + i)) == storage_size) {
+      bucket = i;
+      break;
+    }
+  }
+  if (bucket != kNumBuckets) {
+    Shard* shard = CurrentShard();
+    gpr_spinlock_lock(&shard->lock);
+    if (shard->cached_bytes + storage_size <= shard->max_bytes) {
+      FreeStorage* storage = new (arena) FreeStorage;
+      storage->next = shard->free_storage[bucket];
+      shard->free_storage[bucket] = storage;
+      shard->cached_bytes += storage_size;
+      gpr_spinlock_unlock(&shard->lock);
+      return size;
+    }
+    gpr_spinlock_unlock(&shard->lock);
+  }
+  gpr_free_aligned(arena);
+  return size;
+}
+
+size_t ArenaPool::Release() {
+  size_t freed = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    Shard* shard = &shards_[i];
+    FreeStorage* free_storage[kNumBuckets];
+    gpr_spinlock_lock(&shard->lock);
+    shard->max_bytes = 0;
+    memcpy(free_storage, shard->free_storage, sizeof(free_storage));
+    memset(shard->free_storage, 0, sizeof(shard->free_storage));
+    freed += shard->cached_bytes;
+    shard->cached_bytes = 0;
+    gpr_spinlock_unlock(&shard->lock);
+    for (size_t j = 0; j < kNumBuckets; j++) {
+      FreeStorage* storage = free_storage[j];
+      while (storage != nullptr) {
+        FreeStorage* next = storage->next;
+        gpr_free_aligned(storage);
+        storage = next;
+      }
+    }
+  }
+  return freed;
+}
+
 }  // namespace grpc_core
@@ -31,6 +31,7 @@
 #include <utility>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/alloc.h"
@@ -55,11 +56,20 @@ class Arena {
   // Destroy an arena, returning the total number of bytes allocated.
   size_t Destroy();
   // Allocate \a size bytes from the arena.
-  void* Alloc(size_t size) {
+  void* Alloc(size_t size) { return Alloc(size, GPR_MAX_ALIGNMENT); }
+
+  // Allocate \a size bytes from the arena, aligned to \a align bytes. \a align
+  // must be a power of two no larger than GPR_MAX_ALIGNMENT.
+  void* Alloc(size_t size, size_t align) {
     static constexpr size_t base_size =
         GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-    size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(size);
-    size_t begin = total_used_.FetchAdd(size, MemoryOrder::RELAXED);
+    GPR_DEBUG_ASSERT(align <= GPR_MAX_ALIGNMENT && (align & (align - 1)) == 0);
+    size_t used = total_used_.Load(MemoryOrder::RELAXED);
+    size_t begin;
+    do {
+      begin = (used + align - 1) & ~(align - 1);
+    } while (!total_used_.CompareExchangeWeak(
+        &used, begin + size, MemoryOrder::RELAXED, MemoryOrder::RELAXED));
     if (begin + size <= initial_zone_size_) {
       return reinterpret_cast<char*>(this) + base_size + begin;
     } else {
@@ -67,18 +77,21 @@ class Arena {
     }
   }
 
-  // TODO(roth): We currently assume that all callers need alignment of 16
-  // bytes, which may be wrong in some cases. When we have time, we should
-  // change this to instead use the alignment of the type being allocated by
-  // this method.
+  // Allocates and constructs a T, packed at the alignment T needs (capped at
+  // GPR_MAX_ALIGNMENT) rather than always at GPR_MAX_ALIGNMENT.
   template <typename T, typename... Args>
   T* New(Args&&... args) {
-    T* t = static_cast<T*>(Alloc(sizeof(T)));
+    static constexpr size_t align = alignof(T) < GPR_MAX_ALIGNMENT
+                                        ? alignof(T)
+                                        : GPR_MAX_ALIGNMENT;
+    T* t = static_cast<T*>(Alloc(sizeof(T), align));
     new (t) T(std::forward<Args>(args)...);
     return t;
   }
 
  private:
+  friend class ArenaPool;
+
   struct Zone {
     Zone* prev;
   };
@@ -115,6 +128,52 @@ class Arena {
   Zone* last_zone_ = nullptr;
 };
 
+// Keeps the storage of destroyed arenas around for reuse by new ones, rather
+// than handing it back to the allocator each time. Arenas are bucketed by the
+// size of their storage, which is rounded up to a power of two, and at most
+// max_bytes of storage is kept. The cache is sharded by cpu.
+class ArenaPool {
+ public:
+  explicit ArenaPool(size_t max_bytes);
+  ~ArenaPool();
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  // Like Arena::CreateWithAlloc(), reusing cached storage if there is some.
+  // The arena's initial zone may end up larger than \a initial_size.
+  std::pair<Arena*, void*> CreateWithAlloc(size_t initial_size,
+                                           size_t alloc_size);
+
+  // Like Arena::Destroy(), caching the arena's storage if there is room.
+  size_t Destroy(Arena* arena);
+
+  // Frees all cached storage, and stops caching any more. Returns the number
+  // of bytes freed.
+  size_t Release();
+
+ private:
+  static constexpr size_t kMinStorageShift = 10;
+  static constexpr size_t kMaxStorageShift = 16;
+  static constexpr size_t kNumBuckets = kMaxStorageShift - kMinStorageShift + 1;
+
+  struct FreeStorage {
+    FreeStorage* next;
+  };
+
+  struct Shard {
+    gpr_spinlock lock = GPR_SPINLOCK_STATIC_INITIALIZER;
+    FreeStorage* free_storage[kNumBuckets] = {};
+    size_t cached_bytes = 0;
+    size_t max_bytes = 0;
+  };
+
+  Shard* CurrentShard();
+
+  size_t num_shards_;
+  Shard* shards_;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_GPRPP_ARENA_H */
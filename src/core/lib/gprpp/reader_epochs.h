@@ -0,0 +1,104 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPRPP_READER_EPOCHS_H
+#define GRPC_CORE_LIB_GPRPP_READER_EPOCHS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
+
+namespace grpc_core {
+
+// Counts the readers that walk a structure without taking its lock, so that
+// writers, which do hold the lock, know when memory they unlinked from the
+// structure can no longer be reached and may be freed.
+//
+// Each read is counted in the current epoch. Writers set aside what they
+// unlink, call Flip(), and free it once PreviousEpochDone() returns true.
+// Reads that start after a flip cannot reach memory unlinked before it, so
+// the count of the previous epoch only ever drains. Writers must not flip
+// again before PreviousEpochDone() has returned true.
+//
+// Zero-initialized storage is a valid ReaderEpochs, so it can be part of
+// statically allocated tables.
+class ReaderEpochs {
+ public:
+  class Read {
+   private:
+    friend class ReaderEpochs;
+    explicit Read(gpr_atm* count) : count_(count) {}
+    gpr_atm* count_;
+  };
+
+  // Counts a read that is about to start, and must be passed to EndRead().
+  Read BeginRead() {
+    Slot* slot = &slots_[gpr_cpu_current_cpu() % kSlots];
+    gpr_atm epoch = gpr_atm_acq_load(&epoch_);
+    for (;;) {
+      gpr_atm* count = &slot->count[epoch];
+      gpr_atm_full_fetch_add(count, 1);
+      // A writer may have flipped, and checked the old epoch, between the
+      // load and the increment. The read is only counted if the epoch is
+      // still current once the increment is visible to writers; until the
+      // read is done, it keeps writers from flipping back to this epoch.
+      const gpr_atm current = gpr_atm_acq_load(&epoch_);
+      if (current == epoch) return Read(count);
+      gpr_atm_full_fetch_add(count, -1);
+      epoch = current;
+    }
+  }
+  void EndRead(Read read) { gpr_atm_full_fetch_add(read.count_, -1); }
+
+  // Starts a new epoch. Must be called under the writers' lock, after the
+  // memory to be reclaimed is unlinked.
+  void Flip() {
+    gpr_atm_rel_store(&epoch_, 1 - gpr_atm_no_barrier_load(&epoch_));
+  }
+  // Returns true if all reads counted in the epoch before the last Flip() are
+  // done. Must be called under the writers' lock.
+  bool PreviousEpochDone() {
+    // Pairs with the increment in BeginRead(): a read is either counted here,
+    // or it started late enough to see everything unlinked before the flip.
+    gpr_atm_full_barrier();
+    const gpr_atm previous = 1 - gpr_atm_no_barrier_load(&epoch_);
+    for (size_t i = 0; i < kSlots; i++) {
+      if (gpr_atm_acq_load(&slots_[i].count[previous]) != 0) return false;
+    }
+    return true;
+  }
+
+ private:
+  // Reads are spread over slots by CPU, so they rarely contend for a count.
+  static constexpr size_t kSlots = 8;
+
+  struct Slot {
+    gpr_atm count[2];
+    char padding[GPR_CACHELINE_SIZE - 2 * sizeof(gpr_atm)];
+  };
+
+  gpr_atm epoch_;
+  Slot slots_[kSlots];
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_GPRPP_READER_EPOCHS_H */
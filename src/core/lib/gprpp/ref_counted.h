@@ -209,6 +209,22 @@ class RefCount {
     return prior == 1;
   }
 
+  // Same as RefNonZero() and Unref(), but with a plain load and store instead
+  // of an atomic read-modify-write. Only valid while every change to the
+  // ref-count is ordered by happens-before, e.g. while the object is only
+  // reachable from code serialized by a single combiner.
+  void RefNonZeroUnsynchronized() {
+    const Value prior = get();
+    GPR_DEBUG_ASSERT(prior > 0);
+    value_.Store(prior + 1, MemoryOrder::RELAXED);
+  }
+  bool UnrefUnsynchronized() {
+    const Value prior = get();
+    GPR_DEBUG_ASSERT(prior > 0);
+    value_.Store(prior - 1, MemoryOrder::RELAXED);
+    return prior == 1;
+  }
+
  private:
   Value get() const { return value_.Load(MemoryOrder::RELAXED); }
 
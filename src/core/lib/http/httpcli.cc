@@ -29,6 +29,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/http/format_request.h"
 #include "src/core/lib/http/parser.h"
 #include "src/core/lib/iomgr/endpoint.h"
@@ -38,7 +39,21 @@
 #include "src/core/lib/iomgr/tcp_client.h"
 #include "src/core/lib/slice/slice_internal.h"
 
-typedef struct {
+/* Idle keep-alive connections are kept at most this long, and at most this
+   many of them in all. */
+#define GRPC_HTTPCLI_MAX_IDLE_MS 60000
+#define GRPC_HTTPCLI_MAX_IDLE_CONNECTIONS 8
+
+/* A caller whose GET was identical to one already in flight, and that gets a
+   copy of its response. */
+typedef struct waiting_request {
+  grpc_polling_entity* pollent;
+  grpc_closure* on_done;
+  grpc_httpcli_response* response;
+  struct waiting_request* next;
+} waiting_request;
+
+typedef struct internal_request {
   grpc_slice request_text;
   grpc_http_parser parser;
   grpc_resolved_addresses* addresses;
@@ -60,11 +75,151 @@ typedef struct {
   grpc_closure connected;
   grpc_error* overall_error;
   grpc_resource_quota* resource_quota;
+  /* Set when ep was taken from the idle connections. */
+  bool reused_connection;
+  /* Found in the response headers once they are parsed: content_length is -1
+     if the response has none, and is then delimited by the end of stream. */
+  bool checked_headers;
+  int64_t content_length;
+  bool keep_alive;
+  /* GETs are listed in g_in_flight, so that identical ones can wait for their
+     response instead of making their own request. Guarded by g_mu. */
+  bool coalescable;
+  waiting_request* waiters;
+  struct internal_request* next_in_flight;
 } internal_request;
 
+typedef struct idle_connection {
+  grpc_endpoint* ep;
+  const grpc_httpcli_handshaker* handshaker;
+  char* host;
+  char* ssl_host_override;
+  grpc_millis idle_since;
+  struct idle_connection* next;
+} idle_connection;
+
 static grpc_httpcli_get_override g_get_override = nullptr;
 static grpc_httpcli_post_override g_post_override = nullptr;
 
+static gpr_once g_once = GPR_ONCE_INIT;
+static gpr_mu g_mu;
+/* Most recently used first. Only kept between grpc_httpcli_init() and
+   grpc_httpcli_shutdown(). */
+static idle_connection* g_idle_connections;
+static size_t g_num_idle_connections;
+static bool g_pool_enabled;
+static internal_request* g_in_flight;
+
+static void init_globals() { gpr_mu_init(&g_mu); }
+
+void grpc_httpcli_init() {
+  gpr_once_init(&g_once, init_globals);
+  grpc_core::MutexLock lock(&g_mu);
+  g_pool_enabled = true;
+}
+
+static void destroy_idle_connections(idle_connection* c) {
+  while (c != nullptr) {
+    idle_connection* next = c->next;
+    grpc_endpoint_destroy(c->ep);
+    gpr_free(c->host);
+    gpr_free(c->ssl_host_override);
+    gpr_free(c);
+    c = next;
+  }
+}
+
+void grpc_httpcli_shutdown() {
+  gpr_once_init(&g_once, init_globals);
+  idle_connection* idle;
+  {
+    grpc_core::MutexLock lock(&g_mu);
+    g_pool_enabled = false;
+    idle = g_idle_connections;
+    g_idle_connections = nullptr;
+    g_num_idle_connections = 0;
+  }
+  destroy_idle_connections(idle);
+}
+
+static bool same_string(const char* a, const char* b) {
+  if (a == nullptr || b == nullptr) return a == b;
+  return strcmp(a, b) == 0;
+}
+
+static bool same_server(const internal_request* req,
+                        const grpc_httpcli_handshaker* handshaker,
+                        const char* host, const char* ssl_host_override) {
+  return req->handshaker == handshaker && same_string(req->host, host) &&
+         same_string(req->ssl_host_override, ssl_host_override);
+}
+
+/* Returns an idle connection to the server of \a req, if there is one. */
+static grpc_endpoint* take_idle_connection(internal_request* req) {
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_endpoint* ep = nullptr;
+  idle_connection* expired = nullptr;
+  {
+    grpc_core::MutexLock lock(&g_mu);
+    idle_connection** p = &g_idle_connections;
+    while (*p != nullptr) {
+      idle_connection* c = *p;
+      const bool is_expired = now - c->idle_since > GRPC_HTTPCLI_MAX_IDLE_MS;
+      if (!is_expired &&
+          (ep != nullptr || c->handshaker != req->handshaker ||
+           !same_string(c->host, req->host) ||
+           !same_string(c->ssl_host_override, req->ssl_host_override))) {
+        p = &c->next;
+        continue;
+      }
+      *p = c->next;
+      --g_num_idle_connections;
+      if (is_expired) {
+        c->next = expired;
+        expired = c;
+      } else {
+        ep = c->ep;
+        gpr_free(c->host);
+        gpr_free(c->ssl_host_override);
+        gpr_free(c);
+      }
+    }
+  }
+  destroy_idle_connections(expired);
+  return ep;
+}
+
+/* Keeps the connection of \a req for the next request to the same server. */
+static void put_idle_connection(internal_request* req) {
+  idle_connection* c =
+      static_cast<idle_connection*>(gpr_malloc(sizeof(idle_connection)));
+  c->ep = req->ep;
+  c->handshaker = req->handshaker;
+  c->host = gpr_strdup(req->host);
+  c->ssl_host_override = gpr_strdup(req->ssl_host_override);
+  c->idle_since = grpc_core::ExecCtx::Get()->Now();
+  req->ep = nullptr;
+  idle_connection* evicted = nullptr;
+  {
+    grpc_core::MutexLock lock(&g_mu);
+    if (!g_pool_enabled) {
+      evicted = c;
+      c->next = nullptr;
+    } else {
+      c->next = g_idle_connections;
+      g_idle_connections = c;
+      if (++g_num_idle_connections > GRPC_HTTPCLI_MAX_IDLE_CONNECTIONS) {
+        idle_connection** p = &g_idle_connections;
+        while ((*p)->next != nullptr) p = &(*p)->next;
+        evicted = *p;
+        *p = nullptr;
+        --g_num_idle_connections;
+      }
+    }
+  }
+  destroy_idle_connections(evicted);
+}
+
 static void plaintext_handshake(void* arg, grpc_endpoint* endpoint,
                                 const char* /*host*/, grpc_millis /*deadline*/,
                                 void (*on_done)(void* arg,
@@ -85,17 +240,72 @@ void grpc_httpcli_context_destroy(grpc_httpcli_context* context) {
 
 static void next_address(internal_request* req, grpc_error* due_to_error);
 
+static void drop_endpoint(internal_request* req) {
+  if (req->ep == nullptr) return;
+  grpc_endpoint_delete_from_pollset_set(req->ep, req->context->pollset_set);
+  grpc_endpoint_destroy(req->ep);
+  req->ep = nullptr;
+}
+
+static void copy_response(const grpc_httpcli_response* from,
+                          grpc_httpcli_response* to) {
+  to->status = from->status;
+  to->hdr_count = from->hdr_count;
+  to->hdrs = nullptr;
+  if (from->hdr_count > 0) {
+    to->hdrs = static_cast<grpc_http_header*>(
+        gpr_malloc(from->hdr_count * sizeof(grpc_http_header)));
+    for (size_t i = 0; i < from->hdr_count; i++) {
+      to->hdrs[i].key = gpr_strdup(from->hdrs[i].key);
+      to->hdrs[i].value = gpr_strdup(from->hdrs[i].value);
+    }
+  }
+  to->body_length = from->body_length;
+  to->body = nullptr;
+  if (from->body_length > 0) {
+    to->body = static_cast<char*>(gpr_malloc(from->body_length));
+    memcpy(to->body, from->body, from->body_length);
+  }
+}
+
 static void finish(internal_request* req, grpc_error* error) {
+  waiting_request* waiters = nullptr;
+  if (req->coalescable) {
+    grpc_core::MutexLock lock(&g_mu);
+    internal_request** p = &g_in_flight;
+    while (*p != req) p = &(*p)->next_in_flight;
+    *p = req->next_in_flight;
+    waiters = req->waiters;
+    req->waiters = nullptr;
+  }
+  while (waiters != nullptr) {
+    waiting_request* w = waiters;
+    waiters = w->next;
+    if (error == GRPC_ERROR_NONE) {
+      copy_response(req->parser.http.response, w->response);
+    }
+    grpc_polling_entity_del_from_pollset_set(w->pollent,
+                                             req->context->pollset_set);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, w->on_done, GRPC_ERROR_REF(error));
+    gpr_free(w);
+  }
   grpc_polling_entity_del_from_pollset_set(req->pollent,
                                            req->context->pollset_set);
+  /* Only a connection whose response was read to its Content-Length, and that
+     the server said it keeps open, is ready for another request. */
+  if (req->ep != nullptr && error == GRPC_ERROR_NONE && req->keep_alive &&
+      req->content_length >= 0 &&
+      req->parser.http.response->body_length ==
+          static_cast<size_t>(req->content_length)) {
+    grpc_endpoint_delete_from_pollset_set(req->ep, req->context->pollset_set);
+    put_idle_connection(req);
+  }
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, req->on_done, error);
   grpc_http_parser_destroy(&req->parser);
   if (req->addresses != nullptr) {
     grpc_resolved_addresses_destroy(req->addresses);
   }
-  if (req->ep != nullptr) {
-    grpc_endpoint_destroy(req->ep);
-  }
+  drop_endpoint(req);
   grpc_slice_unref_internal(req->request_text);
   gpr_free(req->host);
   gpr_free(req->ssl_host_override);
@@ -120,6 +330,44 @@ static void append_error(internal_request* req, grpc_error* error) {
                          grpc_slice_from_moved_string(std::move(addr_text))));
 }
 
+/* Returns true once the response has been read up to its Content-Length, so
+   that there is no need to wait for the server to close the connection. */
+static bool response_complete(internal_request* req) {
+  if (req->parser.state != GRPC_HTTP_BODY) return false;
+  const grpc_httpcli_response* response = req->parser.http.response;
+  if (!req->checked_headers) {
+    req->checked_headers = true;
+    for (size_t i = 0; i < response->hdr_count; i++) {
+      const grpc_http_header* hdr = &response->hdrs[i];
+      uint32_t length;
+      if (gpr_stricmp(hdr->key, "Content-Length") == 0 &&
+          gpr_parse_bytes_to_uint32(hdr->value, strlen(hdr->value),
+                                    &length)) {
+        req->content_length = length;
+      } else if (gpr_stricmp(hdr->key, "Connection") == 0) {
+        req->keep_alive = gpr_stricmp(hdr->value, "keep-alive") == 0;
+      }
+    }
+  }
+  return req->content_length >= 0 &&
+         response->body_length >= static_cast<size_t>(req->content_length);
+}
+
+static void start_request(internal_request* req);
+
+/* Called when the connection fails before any of the response is read. */
+static void on_connection_failed(internal_request* req, grpc_error* error) {
+  if (req->reused_connection) {
+    /* The server closed the idle connection: start over with a new one. */
+    GRPC_ERROR_UNREF(error);
+    drop_endpoint(req);
+    req->reused_connection = false;
+    start_request(req);
+    return;
+  }
+  next_address(req, error);
+}
+
 static void do_read(internal_request* req) {
   grpc_endpoint_read(req->ep, &req->incoming, &req->on_read, /*urgent=*/true);
 }
@@ -140,10 +388,13 @@ static void on_read(void* user_data, grpc_error* error) {
     }
   }
 
-  if (error == GRPC_ERROR_NONE) {
+  if (response_complete(req)) {
+    if (error != GRPC_ERROR_NONE) req->keep_alive = false;
+    finish(req, GRPC_ERROR_NONE);
+  } else if (error == GRPC_ERROR_NONE) {
     do_read(req);
   } else if (!req->have_read_byte) {
-    next_address(req, GRPC_ERROR_REF(error));
+    on_connection_failed(req, GRPC_ERROR_REF(error));
   } else {
     finish(req, grpc_http_parser_eof(&req->parser));
   }
@@ -156,11 +407,13 @@ static void done_write(void* arg, grpc_error* error) {
   if (error == GRPC_ERROR_NONE) {
     on_written(req);
   } else {
-    next_address(req, GRPC_ERROR_REF(error));
+    on_connection_failed(req, GRPC_ERROR_REF(error));
   }
 }
 
 static void start_write(internal_request* req) {
+  grpc_endpoint_add_to_pollset_set(req->ep, req->context->pollset_set);
+  grpc_slice_buffer_reset_and_unref_internal(&req->outgoing);
   grpc_slice_ref_internal(req->request_text);
   grpc_slice_buffer_add(&req->outgoing, req->request_text);
   grpc_endpoint_write(req->ep, &req->outgoing, &req->done_write, nullptr);
@@ -186,8 +439,11 @@ static void on_connected(void* arg, grpc_error* error) {
     next_address(req, GRPC_ERROR_REF(error));
     return;
   }
+  /* The handshaker owns the endpoint until it is done. */
+  grpc_endpoint* ep = req->ep;
+  req->ep = nullptr;
   req->handshaker->handshake(
-      req, req->ep, req->ssl_host_override ? req->ssl_host_override : req->host,
+      req, ep, req->ssl_host_override ? req->ssl_host_override : req->host,
       req->deadline, on_handshake_done);
 }
 
@@ -202,6 +458,7 @@ static void next_address(internal_request* req, grpc_error* error) {
                "Failed HTTP requests to all targets", &req->overall_error, 1));
     return;
   }
+  drop_endpoint(req);
   addr = &req->addresses->addrs[req->next_address++];
   GRPC_CLOSURE_INIT(&req->connected, on_connected, req,
                     grpc_schedule_on_exec_ctx);
@@ -223,6 +480,49 @@ static void on_resolved(void* arg, grpc_error* error) {
   next_address(req, GRPC_ERROR_NONE);
 }
 
+static void start_request(internal_request* req) {
+  req->ep = take_idle_connection(req);
+  if (req->ep != nullptr) {
+    req->reused_connection = true;
+    start_write(req);
+    return;
+  }
+  grpc_resolve_address(
+      req->host, req->handshaker->default_port, req->context->pollset_set,
+      GRPC_CLOSURE_CREATE(on_resolved, req, grpc_schedule_on_exec_ctx),
+      &req->addresses);
+}
+
+/* If an identical GET is in flight, waits for its response instead. */
+static bool join_in_flight_request(const grpc_httpcli_request* request,
+                                   const grpc_slice& request_text,
+                                   grpc_polling_entity* pollent,
+                                   grpc_closure* on_done,
+                                   grpc_httpcli_response* response) {
+  const grpc_httpcli_handshaker* handshaker =
+      request->handshaker ? request->handshaker : &grpc_httpcli_plaintext;
+  grpc_core::MutexLock lock(&g_mu);
+  for (internal_request* req = g_in_flight; req != nullptr;
+       req = req->next_in_flight) {
+    if (same_server(req, handshaker, request->host,
+                    request->ssl_host_override) &&
+        grpc_slice_eq(req->request_text, request_text)) {
+      waiting_request* w =
+          static_cast<waiting_request*>(gpr_malloc(sizeof(waiting_request)));
+      w->pollent = pollent;
+      w->on_done = on_done;
+      w->response = response;
+      w->next = req->waiters;
+      req->waiters = w;
+      /* Lets the waiter's polling drive the request too. */
+      grpc_polling_entity_add_to_pollset_set(pollent,
+                                             req->context->pollset_set);
+      return true;
+    }
+  }
+  return false;
+}
+
 static void internal_request_begin(grpc_httpcli_context* context,
                                    grpc_polling_entity* pollent,
                                    grpc_resource_quota* resource_quota,
@@ -230,7 +530,15 @@ static void internal_request_begin(grpc_httpcli_context* context,
                                    grpc_millis deadline, grpc_closure* on_done,
                                    grpc_httpcli_response* response,
                                    const char* name,
-                                   const grpc_slice& request_text) {
+                                   const grpc_slice& request_text,
+                                   bool coalescable) {
+  GPR_ASSERT(pollent);
+  gpr_once_init(&g_once, init_globals);
+  if (coalescable && join_in_flight_request(request, request_text, pollent,
+                                            on_done, response)) {
+    grpc_slice_unref_internal(request_text);
+    return;
+  }
   internal_request* req =
       static_cast<internal_request*>(gpr_malloc(sizeof(internal_request)));
   memset(req, 0, sizeof(*req));
@@ -252,14 +560,17 @@ static void internal_request_begin(grpc_httpcli_context* context,
   grpc_iomgr_register_object(&req->iomgr_obj, name);
   req->host = gpr_strdup(request->host);
   req->ssl_host_override = gpr_strdup(request->ssl_host_override);
+  req->content_length = -1;
+  req->coalescable = coalescable;
+  if (coalescable) {
+    grpc_core::MutexLock lock(&g_mu);
+    req->next_in_flight = g_in_flight;
+    g_in_flight = req;
+  }
 
-  GPR_ASSERT(pollent);
   grpc_polling_entity_add_to_pollset_set(req->pollent,
                                          req->context->pollset_set);
-  grpc_resolve_address(
-      request->host, req->handshaker->default_port, req->context->pollset_set,
-      GRPC_CLOSURE_CREATE(on_resolved, req, grpc_schedule_on_exec_ctx),
-      &req->addresses);
+  start_request(req);
 }
 
 void grpc_httpcli_get(grpc_httpcli_context* context,
@@ -274,7 +585,8 @@ void grpc_httpcli_get(grpc_httpcli_context* context,
   gpr_asprintf(&name, "HTTP:GET:%s:%s", request->host, request->http.path);
   internal_request_begin(context, pollent, resource_quota, request, deadline,
                          on_done, response, name,
-                         grpc_httpcli_format_get_request(request));
+                         grpc_httpcli_format_get_request(request),
+                         /*coalescable=*/true);
   gpr_free(name);
 }
 
@@ -293,7 +605,8 @@ void grpc_httpcli_post(grpc_httpcli_context* context,
   gpr_asprintf(&name, "HTTP:POST:%s:%s", request->host, request->http.path);
   internal_request_begin(
       context, pollent, resource_quota, request, deadline, on_done, response,
-      name, grpc_httpcli_format_post_request(request, body_bytes, body_size));
+      name, grpc_httpcli_format_post_request(request, body_bytes, body_size),
+      /*coalescable=*/false);
   gpr_free(name);
 }
 
@@ -34,9 +34,11 @@
 /* User agent this library reports */
 #define GRPC_HTTPCLI_USER_AGENT "grpc-httpcli/0.0"
 
-/* Tracks in-progress http requests
-   TODO(ctiller): allow caching and capturing multiple requests for the
-                  same content and combining them */
+/* Tracks in-progress http requests.
+   Connections are kept open after a response delimited by Content-Length, and
+   reused by later requests to the same server from any context. A GET that is
+   identical to one in flight waits for its response, and its deadline,
+   instead of making its own request. */
 typedef struct grpc_httpcli_context {
   grpc_pollset_set* pollset_set;
 } grpc_httpcli_context;
@@ -68,6 +70,11 @@ typedef struct grpc_httpcli_request {
 /* Expose the parser response type as a httpcli response too */
 typedef struct grpc_http_response grpc_httpcli_response;
 
+/* Called by grpc_init() and grpc_shutdown(): idle connections are only kept
+   in between, and closed on shutdown. */
+void grpc_httpcli_init();
+void grpc_httpcli_shutdown();
+
 void grpc_httpcli_context_init(grpc_httpcli_context* context);
 void grpc_httpcli_context_destroy(grpc_httpcli_context* context);
 
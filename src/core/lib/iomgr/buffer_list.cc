@@ -305,3 +305,25 @@ void grpc_tcp_set_write_timestamps_callback(void (*fn)(void*,
 } /* namespace grpc_core */
 
 #endif /* GRPC_LINUX_ERRQUEUE */
+
+namespace grpc_core {
+void CallWriteTimestamps::Record(const grpc_core::Timestamps& ts) {
+  MutexLock lock(&mu_);
+  if (num_writes_ == 0) first_ = ts;
+  ++num_writes_;
+  last_ = ts;
+}
+
+size_t CallWriteTimestamps::Get(grpc_core::Timestamps* last) {
+  MutexLock lock(&mu_);
+  if (num_writes_ > 0) *last = last_;
+  return num_writes_;
+}
+
+bool CallWriteTimestamps::GetFirst(grpc_core::Timestamps* first) {
+  MutexLock lock(&mu_);
+  if (num_writes_ == 0) return false;
+  *first = first_;
+  return true;
+}
+} /* namespace grpc_core */
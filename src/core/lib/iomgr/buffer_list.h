@@ -27,6 +27,8 @@
 
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/optional.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/internal_errqueue.h"
 
@@ -153,6 +155,35 @@ class TracedBuffer {
 };
 #endif /* GRPC_LINUX_ERRQUEUE */
 
+/** Keeps the timestamps of the writes of a single call. An instance attached
+ * to the call context at GRPC_CONTEXT_WRITE_TIMESTAMPS makes the chttp2
+ * transport trace the writes of that call (see ContextList). Thread-safe. */
+class CallWriteTimestamps : public RefCounted<CallWriteTimestamps> {
+ public:
+  /** Records the timestamps of one of the call's writes. */
+  void Record(const grpc_core::Timestamps& ts);
+
+  /** Returns the number of writes recorded so far and, if there is any, copies
+   * the timestamps of the most recent one to \a last. */
+  size_t Get(grpc_core::Timestamps* last);
+
+  /** Copies the timestamps of the first write to \a first. Returns false if
+   * none was recorded yet. */
+  bool GetFirst(grpc_core::Timestamps* first);
+
+  /** Drops the call context's ref; for use as grpc_call_context_element's
+   * destroy function. */
+  static void Destroy(void* arg) {
+    static_cast<CallWriteTimestamps*>(arg)->Unref();
+  }
+
+ private:
+  Mutex mu_;
+  size_t num_writes_ = 0;
+  grpc_core::Timestamps first_;
+  grpc_core::Timestamps last_;
+};
+
 /** Sets the callback function to call when timestamps for a write are
  *  collected. The callback does not own a reference to error. */
 void grpc_tcp_set_write_timestamps_callback(void (*fn)(void*,
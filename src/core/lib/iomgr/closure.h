@@ -235,7 +235,7 @@ class Closure {
       return;
     }
 #ifndef NDEBUG
-    if (grpc_trace_closure.enabled()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_closure)) {
       gpr_log(GPR_DEBUG, "running closure %p: created [%s:%d]: run [%s:%d]",
               closure, closure->file_created, closure->line_created,
               location.file(), location.line());
@@ -244,7 +244,7 @@ class Closure {
 #endif
     closure->cb(closure->cb_arg, error);
 #ifndef NDEBUG
-    if (grpc_trace_closure.enabled()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_closure)) {
       gpr_log(GPR_DEBUG, "closure %p finished", closure);
     }
 #endif
@@ -26,6 +26,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/mpscq.h"
@@ -35,11 +36,18 @@
 
 grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 
-#define GRPC_COMBINER_TRACE(fn)          \
-  do {                                   \
-    if (grpc_combiner_trace.enabled()) { \
-      fn;                                \
-    }                                    \
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_combiner_profiling, false,
+    "If set, combiners record how long closures wait in their queues and how "
+    "long they run, into grpc_stats and per combiner for channelz.");
+
+static bool g_combiner_profiling;
+
+#define GRPC_COMBINER_TRACE(fn)                         \
+  do {                                                  \
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_combiner_trace)) { \
+      fn;                                               \
+    }                                                   \
   } while (0)
 
 #define STATE_UNORPHANED 1
@@ -52,13 +60,78 @@ static void combiner_finally_exec(grpc_core::Combiner* lock,
 
 static void offload(void* arg, grpc_error* error);
 
-grpc_core::Combiner* grpc_combiner_create(void) {
+namespace {
+
+// While profiling, the queue holds one of these per closure rather than the
+// closure itself, so that closures do not need room for the timestamp.
+struct ProfiledNode {
+  grpc_core::MultiProducerSingleConsumerQueue::Node node;
+  grpc_closure* closure;
+  gpr_cycle_counter queued;
+};
+
+int64_t cycles_to_us(gpr_cycle_counter start, gpr_cycle_counter end) {
+  gpr_timespec elapsed = gpr_cycle_counter_sub(end, start);
+  return elapsed.tv_sec * GPR_US_PER_SEC + elapsed.tv_nsec / GPR_NS_PER_US;
+}
+
+void store_max(grpc_core::Atomic<int64_t>* max, int64_t value) {
+  int64_t cur = max->Load(grpc_core::MemoryOrder::RELAXED);
+  while (value > cur &&
+         !max->CompareExchangeWeak(&cur, value, grpc_core::MemoryOrder::RELAXED,
+                                   grpc_core::MemoryOrder::RELAXED)) {
+  }
+}
+
+}  // namespace
+
+namespace grpc_core {
+
+void CombinerProfile::RecordClosure(gpr_cycle_counter queued,
+                                    gpr_cycle_counter started,
+                                    gpr_cycle_counter done) {
+  const int64_t queue_wait_us = cycles_to_us(queued, started);
+  const int64_t run_us = cycles_to_us(started, done);
+  GRPC_STATS_INC_COMBINER_QUEUE_WAIT_US(queue_wait_us);
+  GRPC_STATS_INC_COMBINER_RUN_US(run_us);
+  closures_.FetchAdd(1, MemoryOrder::RELAXED);
+  queue_wait_us_.FetchAdd(queue_wait_us, MemoryOrder::RELAXED);
+  run_us_.FetchAdd(run_us, MemoryOrder::RELAXED);
+  store_max(&max_queue_wait_us_, queue_wait_us);
+  store_max(&max_run_us_, run_us);
+}
+
+UniquePtr<char> CombinerProfile::Summary() const {
+  char* summary;
+  gpr_asprintf(&summary,
+               "closures=%" PRId64 " queue_wait_us=%" PRId64
+               " max_queue_wait_us=%" PRId64 " run_us=%" PRId64
+               " max_run_us=%" PRId64 " offloads=%" PRId64,
+               closures_.Load(MemoryOrder::RELAXED),
+               queue_wait_us_.Load(MemoryOrder::RELAXED),
+               max_queue_wait_us_.Load(MemoryOrder::RELAXED),
+               run_us_.Load(MemoryOrder::RELAXED),
+               max_run_us_.Load(MemoryOrder::RELAXED),
+               offloads_.Load(MemoryOrder::RELAXED));
+  return UniquePtr<char>(summary);
+}
+
+}  // namespace grpc_core
+
+void grpc_combiner_global_init() {
+  g_combiner_profiling = GPR_GLOBAL_CONFIG_GET(grpc_combiner_profiling);
+}
+
+grpc_core::Combiner* grpc_combiner_create(const char* name) {
   grpc_core::Combiner* lock = new grpc_core::Combiner();
   gpr_ref_init(&lock->refs, 1);
   gpr_atm_no_barrier_store(&lock->state, STATE_UNORPHANED);
   grpc_closure_list_init(&lock->final_list);
   GRPC_CLOSURE_INIT(&lock->offload, offload, lock, nullptr);
-  GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p create", lock));
+  if (g_combiner_profiling) {
+    lock->profile = grpc_core::MakeRefCounted<grpc_core::CombinerProfile>(name);
+  }
+  GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p create %s", lock, name));
   return lock;
 }
 
@@ -79,7 +152,7 @@ static void start_destroy(grpc_core::Combiner* lock) {
 
 #ifndef NDEBUG
 #define GRPC_COMBINER_DEBUG_SPAM(op, delta)                                \
-  if (grpc_combiner_trace.enabled()) {                                     \
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_combiner_trace)) {                      \
     gpr_log(file, line, GPR_LOG_SEVERITY_DEBUG,                            \
             "C:%p %s %" PRIdPTR " --> %" PRIdPTR " %s", lock, (op),        \
             gpr_atm_no_barrier_load(&lock->refs.count),                    \
@@ -153,6 +226,13 @@ static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
   GPR_ASSERT(last & STATE_UNORPHANED);  // ensure lock has not been destroyed
   assert(cl->cb);
   cl->error_data.error = error;
+  if (lock->profile != nullptr) {
+    ProfiledNode* node = new ProfiledNode();
+    node->closure = cl;
+    node->queued = gpr_get_cycle_counter();
+    lock->queue.Push(&node->node);
+    return;
+  }
   lock->queue.Push(cl->next_data.mpscq_node.get());
 }
 
@@ -173,6 +253,9 @@ static void offload(void* arg, grpc_error* /*error*/) {
 
 static void queue_offload(grpc_core::Combiner* lock) {
   GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED();
+  if (lock->profile != nullptr) {
+    lock->profile->RecordOffload();
+  }
   move_next();
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
   grpc_core::Executor::Run(&lock->offload, GRPC_ERROR_NONE);
@@ -228,12 +311,27 @@ bool grpc_combiner_continue_exec_ctx() {
       return true;
     }
     GPR_TIMER_SCOPE("combiner.exec1", 0);
-    grpc_closure* cl = reinterpret_cast<grpc_closure*>(n);
+    grpc_closure* cl;
+    gpr_cycle_counter queued = 0;
+    if (lock->profile != nullptr) {
+      ProfiledNode* node = reinterpret_cast<ProfiledNode*>(n);
+      cl = node->closure;
+      queued = node->queued;
+      delete node;
+    } else {
+      cl = reinterpret_cast<grpc_closure*>(n);
+    }
     grpc_error* cl_err = cl->error_data.error;
 #ifndef NDEBUG
     cl->scheduled = false;
 #endif
-    cl->cb(cl->cb_arg, cl_err);
+    if (lock->profile != nullptr) {
+      gpr_cycle_counter started = gpr_get_cycle_counter();
+      cl->cb(cl->cb_arg, cl_err);
+      lock->profile->RecordClosure(queued, started, gpr_get_cycle_counter());
+    } else {
+      cl->cb(cl->cb_arg, cl_err);
+    }
     GRPC_ERROR_UNREF(cl_err);
   } else {
     grpc_closure* c = lock->final_list.head;
@@ -249,7 +347,14 @@ bool grpc_combiner_continue_exec_ctx() {
 #ifndef NDEBUG
       c->scheduled = false;
 #endif
-      c->cb(c->cb_arg, error);
+      if (lock->profile != nullptr) {
+        gpr_cycle_counter started = gpr_get_cycle_counter();
+        c->cb(c->cb_arg, error);
+        lock->profile->RecordClosure(started, started,
+                                     gpr_get_cycle_counter());
+      } else {
+        c->cb(c->cb_arg, error);
+      }
       GRPC_ERROR_UNREF(error);
       c = next;
     }
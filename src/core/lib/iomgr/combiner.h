@@ -25,9 +25,45 @@
 
 #include <grpc/support/atm.h>
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_combiner_profiling);
+
 namespace grpc_core {
+// How long the closures of a combiner waited in its queue and how long they
+// ran. Only kept when grpc_combiner_profiling is set; channelz nodes may hold
+// a ref to report it after the combiner is gone.
+class CombinerProfile : public RefCounted<CombinerProfile> {
+ public:
+  explicit CombinerProfile(const char* name) : name_(name) {}
+
+  const char* name() const { return name_; }
+
+  // Records a closure queued at \a queued that ran from \a started until
+  // \a done. Final-list closures are not queued and pass \a started twice.
+  void RecordClosure(gpr_cycle_counter queued, gpr_cycle_counter started,
+                     gpr_cycle_counter done);
+  void RecordOffload() { offloads_.FetchAdd(1, MemoryOrder::RELAXED); }
+
+  // Returns a human readable summary, e.g. for channelz.
+  UniquePtr<char> Summary() const;
+
+ private:
+  const char* name_;
+  Atomic<int64_t> closures_{0};
+  Atomic<int64_t> queue_wait_us_{0};
+  Atomic<int64_t> max_queue_wait_us_{0};
+  Atomic<int64_t> run_us_{0};
+  Atomic<int64_t> max_run_us_{0};
+  Atomic<int64_t> offloads_{0};
+};
+
 // TODO(yashkt) : Remove this class and replace it with a class that does not
 // use ExecCtx
 class Combiner {
@@ -50,6 +86,8 @@ class Combiner {
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
+  // Null unless grpc_combiner_profiling is set.
+  RefCountedPtr<CombinerProfile> profile;
 };
 }  // namespace grpc_core
 
@@ -58,9 +96,13 @@ class Combiner {
 // The actual thread executing actions may change over time (but there will only
 // ever be one at a time).
 
-// Initialize the lock, with an optional workqueue to shift load to when
-// necessary
-grpc_core::Combiner* grpc_combiner_create(void);
+// Initialize the lock. \a name says what the combiner serializes (e.g.
+// "transport") and must outlive it; it tags the combiner's profile when
+// grpc_combiner_profiling is set.
+grpc_core::Combiner* grpc_combiner_create(const char* name = "unnamed");
+
+// Reads grpc_combiner_profiling. Called by grpc_iomgr_init().
+void grpc_combiner_global_init();
 
 #ifndef NDEBUG
 #define GRPC_COMBINER_DEBUG_ARGS \
@@ -55,7 +55,11 @@ struct grpc_endpoint_vtable {
    Callback success indicates that the endpoint can accept more reads, failure
    indicates the endpoint is closed.
    Valid slices may be placed into \a slices even when the callback is
-   invoked with error != GRPC_ERROR_NONE. */
+   invoked with error != GRPC_ERROR_NONE.
+   The slices may have a confined refcount (see grpc_slice_refcount): the
+   reader must publish them (grpc_slice_publish) before refs to them can be
+   used by anything that is not serialized with its next read, including a
+   write to another endpoint. */
 void grpc_endpoint_read(grpc_endpoint* ep, grpc_slice_buffer* slices,
                         grpc_closure* cb, bool urgent);
 
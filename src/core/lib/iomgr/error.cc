@@ -41,6 +41,14 @@ grpc_core::DebugOnlyTraceFlag grpc_trace_error_refcount(false,
                                                         "error_refcount");
 grpc_core::DebugOnlyTraceFlag grpc_trace_closure(false, "closure");
 
+static_assert(alignof(grpc_error_status_only) > GRPC_ERROR_STATUS_ONLY_TAG,
+              "status-only errors must leave room for their tag");
+
+static grpc_error_status_only* get_status_only(grpc_error* err) {
+  return reinterpret_cast<grpc_error_status_only*>(
+      reinterpret_cast<uintptr_t>(err) & ~GRPC_ERROR_STATUS_ONLY_TAG);
+}
+
 static const char* error_int_name(grpc_error_ints key) {
   switch (key) {
     case GRPC_ERROR_INT_ERRNO:
@@ -125,7 +133,7 @@ static const char* error_time_name(grpc_error_times key) {
 
 #ifndef NDEBUG
 grpc_error* grpc_error_do_ref(grpc_error* err, const char* file, int line) {
-  if (grpc_trace_error_refcount.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_error_refcount)) {
     gpr_log(GPR_DEBUG, "%p: %" PRIdPTR " -> %" PRIdPTR " [%s:%d]", err,
             gpr_atm_no_barrier_load(&err->atomics.refs.count),
             gpr_atm_no_barrier_load(&err->atomics.refs.count) + 1, file, line);
@@ -172,7 +180,7 @@ static void error_destroy(grpc_error* err) {
 
 #ifndef NDEBUG
 void grpc_error_do_unref(grpc_error* err, const char* file, int line) {
-  if (grpc_trace_error_refcount.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_error_refcount)) {
     gpr_log(GPR_DEBUG, "%p: %" PRIdPTR " -> %" PRIdPTR " [%s:%d]", err,
             gpr_atm_no_barrier_load(&err->atomics.refs.count),
             gpr_atm_no_barrier_load(&err->atomics.refs.count) - 1, file, line);
@@ -204,7 +212,7 @@ static uint8_t get_placement(grpc_error** err, size_t size) {
     *err = static_cast<grpc_error*>(gpr_realloc(
         *err, sizeof(grpc_error) + (*err)->arena_capacity * sizeof(intptr_t)));
 #ifndef NDEBUG
-    if (grpc_trace_error_refcount.enabled()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_error_refcount)) {
       if (*err != orig) {
         gpr_log(GPR_DEBUG, "realloc %p -> %p", orig, *err);
       }
@@ -328,6 +336,7 @@ grpc_error* grpc_error_create(const char* file, int line,
   if (err == nullptr) {  // TODO(ctiller): make gpr_malloc return NULL
     return GRPC_ERROR_OOM;
   }
+  GPR_DEBUG_ASSERT(!grpc_error_is_special(err));
 #ifndef NDEBUG
   if (!gpr_atm_no_barrier_load(&g_error_creation_allowed)) {
     gpr_log(GPR_ERROR,
@@ -335,7 +344,7 @@ grpc_error* grpc_error_create(const char* file, int line,
             file, line);
     abort();
   }
-  if (grpc_trace_error_refcount.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_error_refcount)) {
     gpr_log(GPR_DEBUG, "%p create [%s:%d]", err, file, line);
   }
 #endif
@@ -392,7 +401,11 @@ static void ref_errs(grpc_error* err) {
 static grpc_error* copy_error_and_unref(grpc_error* in) {
   GPR_TIMER_SCOPE("copy_error_and_unref", 0);
   grpc_error* out;
-  if (grpc_error_is_special(in)) {
+  if (grpc_error_is_status_only(in)) {
+    grpc_error_status_only* status_only = get_status_only(in);
+    out = GRPC_ERROR_CREATE_FROM_STATIC_STRING(status_only->desc);
+    internal_set_int(&out, GRPC_ERROR_INT_GRPC_STATUS, status_only->code);
+  } else if (grpc_error_is_special(in)) {
     out = GRPC_ERROR_CREATE_FROM_STATIC_STRING("unknown");
     if (in == GRPC_ERROR_NONE) {
       internal_set_str(&out, GRPC_ERROR_STR_DESCRIPTION,
@@ -419,7 +432,7 @@ static grpc_error* copy_error_and_unref(grpc_error* in) {
     out = static_cast<grpc_error*>(
         gpr_malloc(sizeof(*in) + new_arena_capacity * sizeof(intptr_t)));
 #ifndef NDEBUG
-    if (grpc_trace_error_refcount.enabled()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_error_refcount)) {
       gpr_log(GPR_DEBUG, "%p create copying %p", out, in);
     }
 #endif
@@ -464,6 +477,11 @@ const special_error_status_map error_status_map[] = {
 
 bool grpc_error_get_int(grpc_error* err, grpc_error_ints which, intptr_t* p) {
   GPR_TIMER_SCOPE("grpc_error_get_int", 0);
+  if (grpc_error_is_status_only(err)) {
+    if (which != GRPC_ERROR_INT_GRPC_STATUS) return false;
+    *p = get_status_only(err)->code;
+    return true;
+  }
   if (grpc_error_is_special(err)) {
     if (which != GRPC_ERROR_INT_GRPC_STATUS) return false;
     *p = error_status_map[reinterpret_cast<size_t>(err)].code;
@@ -487,6 +505,11 @@ grpc_error* grpc_error_set_str(grpc_error* src, grpc_error_strs which,
 
 bool grpc_error_get_str(grpc_error* err, grpc_error_strs which,
                         grpc_slice* str) {
+  if (grpc_error_is_status_only(err)) {
+    if (which != GRPC_ERROR_STR_DESCRIPTION) return false;
+    *str = grpc_slice_from_static_string(get_status_only(err)->desc);
+    return true;
+  }
   if (grpc_error_is_special(err)) {
     if (which != GRPC_ERROR_STR_GRPC_MESSAGE) return false;
     const special_error_status_map& msg =
@@ -746,7 +769,10 @@ const char* grpc_error_string(grpc_error* err) {
   if (err == GRPC_ERROR_OOM) return oom_error_string;
   if (err == GRPC_ERROR_CANCELLED) return cancelled_error_string;
 
-  void* p = (void*)gpr_atm_acq_load(&err->atomics.error_string);
+  gpr_atm* error_string = grpc_error_is_status_only(err)
+                              ? &get_status_only(err)->error_string
+                              : &err->atomics.error_string;
+  void* p = (void*)gpr_atm_acq_load(error_string);
   if (p != nullptr) {
     return static_cast<const char*>(p);
   }
@@ -754,20 +780,29 @@ const char* grpc_error_string(grpc_error* err) {
   kv_pairs kvs;
   memset(&kvs, 0, sizeof(kvs));
 
-  collect_ints_kvs(err, &kvs);
-  collect_strs_kvs(err, &kvs);
-  collect_times_kvs(err, &kvs);
-  if (err->first_err != UINT8_MAX) {
-    append_kv(&kvs, gpr_strdup("referenced_errors"), errs_string(err));
+  if (grpc_error_is_status_only(err)) {
+    // Built once per status-only error and kept for the life of the process.
+    grpc_error_status_only* status_only = get_status_only(err);
+    append_kv(&kvs, key_str(GRPC_ERROR_STR_DESCRIPTION),
+              fmt_str(grpc_slice_from_static_string(status_only->desc)));
+    append_kv(&kvs, key_int(GRPC_ERROR_INT_GRPC_STATUS),
+              fmt_int(status_only->code));
+  } else {
+    collect_ints_kvs(err, &kvs);
+    collect_strs_kvs(err, &kvs);
+    collect_times_kvs(err, &kvs);
+    if (err->first_err != UINT8_MAX) {
+      append_kv(&kvs, gpr_strdup("referenced_errors"), errs_string(err));
+    }
   }
 
   qsort(kvs.kvs, kvs.num_kvs, sizeof(kv_pair), cmp_kvs);
 
   char* out = finish_kvs(&kvs);
 
-  if (!gpr_atm_rel_cas(&err->atomics.error_string, 0, (gpr_atm)out)) {
+  if (!gpr_atm_rel_cas(error_string, 0, (gpr_atm)out)) {
     gpr_free(out);
-    out = (char*)gpr_atm_acq_load(&err->atomics.error_string);
+    out = (char*)gpr_atm_acq_load(error_string);
   }
 
   return out;
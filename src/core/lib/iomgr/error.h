@@ -26,6 +26,7 @@
 
 #include <grpc/slice.h>
 #include <grpc/status.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
@@ -129,8 +130,43 @@ typedef enum {
 #define GRPC_ERROR_CANCELLED ((grpc_error*)4)
 #define GRPC_ERROR_SPECIAL_MAX GRPC_ERROR_CANCELLED
 
+/// An error made of a status code and a static description only. Like the
+/// special errors above it can be propagated without allocating memory: define
+/// one at file scope with GRPC_ERROR_STATUS_ONLY_INIT() and pass it around as
+/// grpc_error_from_status_only(). It is equivalent to
+///   grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(desc),
+///                      GRPC_ERROR_INT_GRPC_STATUS, code)
+/// without the file and line, and is upgraded to such an error by the first
+/// call that adds to it.
+struct grpc_error_status_only {
+  const char* desc;
+  grpc_status_code code;
+  // Built on the first call to grpc_error_string().
+  gpr_atm error_string;
+};
+
+#define GRPC_ERROR_STATUS_ONLY_INIT(desc, code) \
+  { desc, code, 0 }
+
+/// Status-only errors are tagged with the second lowest bit, which is clear
+/// in allocated errors and leaves the lowest bit to other code.
+#define GRPC_ERROR_STATUS_ONLY_TAG ((uintptr_t)2)
+
+inline grpc_error* grpc_error_from_status_only(grpc_error_status_only* err) {
+  return reinterpret_cast<grpc_error*>(reinterpret_cast<uintptr_t>(err) |
+                                       GRPC_ERROR_STATUS_ONLY_TAG);
+}
+
+inline bool grpc_error_is_status_only(struct grpc_error* err) {
+  return err > GRPC_ERROR_SPECIAL_MAX &&
+         (reinterpret_cast<uintptr_t>(err) & GRPC_ERROR_STATUS_ONLY_TAG) != 0;
+}
+
+/// True for the special errors and for status-only errors: neither is
+/// refcounted.
 inline bool grpc_error_is_special(struct grpc_error* err) {
-  return err <= GRPC_ERROR_SPECIAL_MAX;
+  return err <= GRPC_ERROR_SPECIAL_MAX ||
+         (reinterpret_cast<uintptr_t>(err) & GRPC_ERROR_STATUS_ONLY_TAG) != 0;
 }
 
 // debug only toggles that allow for a sanity to check that ensures we will
@@ -31,13 +31,18 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <linux/futex.h>
 #include <poll.h>
 #include <pthread.h>
 #include <string.h>
 #include <sys/epoll.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <map>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
@@ -46,16 +51,27 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/lockfree_event.h"
+#include "src/core/lib/iomgr/timer_manager.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
 static grpc_wakeup_fd global_wakeup_fd;
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_epoll1_worker_spin_us, 0,
+    "How long, in microseconds, a thread waiting for its turn on an epoll1 "
+    "pollset spins for a kick before it sleeps. Spinning trades CPU for "
+    "latency, so it is off by default.");
+
+/* Read once at init, as GPR_GLOBAL_CONFIG_GET() is too slow for every wait */
+static int64_t g_worker_spin_us;
+
 /*******************************************************************************
  * Singleton epoll set related fields
  */
@@ -147,6 +163,10 @@ struct grpc_fd {
 
   struct grpc_fd* freelist_next;
 
+  /* The busy poll budget this fd asked for, counted in g_busy_poll_fd_counts,
+   * or 0 */
+  int busy_poll_us;
+
   grpc_iomgr_object iomgr_object;
 
   /* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
@@ -177,10 +197,16 @@ static const char* kick_state_string(kick_state st) {
 struct grpc_pollset_worker {
   kick_state state;
   int kick_state_mutator;  // which line of code last changed kick state
-  bool initialized_cv;
+  /* Set if the worker waits in worker_wait() for a kick, rather than
+     polling */
+  bool waits_for_kick;
   grpc_pollset_worker* next;
   grpc_pollset_worker* prev;
-  gpr_cv cv;
+  /* Futex word, bumped by every worker_wakeup() */
+  std::atomic<int32_t> wakeup_seq;
+  /* Set while the worker sleeps in FUTEX_WAIT, so that wakeups of a worker
+     that is still spinning skip the syscall */
+  std::atomic<bool> sleeping;
   grpc_closure_list schedule_on_end_work;
 };
 
@@ -190,6 +216,71 @@ struct grpc_pollset_worker {
     (worker)->kick_state_mutator = __LINE__; \
   } while (false)
 
+/* Wakes a worker blocked in worker_wait(). Called with the worker's pollset
+   locked, which keeps the worker from returning meanwhile. */
+static void worker_wakeup(grpc_pollset_worker* worker) {
+  worker->wakeup_seq.fetch_add(1);
+  if (worker->sleeping.load()) {
+    syscall(SYS_futex, &worker->wakeup_seq, FUTEX_WAKE_PRIVATE, 1, nullptr,
+            nullptr, 0);
+  }
+}
+
+/* Tells the CPU that the calling thread spins, so that it backs off and
+   leaves the core to a sibling hyperthread. */
+static inline void cpu_relax() {
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/* Waits for worker_wakeup() or \a deadline, spinning for a while before
+   sleeping on the worker's futex: a worker handed a kick soon after it
+   started waiting then needs no syscall at all. Called and returns with
+   \a pollset_mu held. Returns true if the deadline passed. */
+static bool worker_wait(gpr_mu* pollset_mu, grpc_pollset_worker* worker,
+                        grpc_millis deadline) {
+  const int32_t seq = worker->wakeup_seq.load(std::memory_order_relaxed);
+  const gpr_timespec deadline_ts =
+      grpc_millis_to_timespec(deadline, GPR_CLOCK_MONOTONIC);
+  gpr_mu_unlock(pollset_mu);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  const gpr_timespec spin_end = gpr_time_add(
+      now, gpr_time_from_micros(g_worker_spin_us, GPR_TIMESPAN));
+  while (worker->wakeup_seq.load(std::memory_order_acquire) == seq &&
+         gpr_time_cmp(now, spin_end) < 0 &&
+         gpr_time_cmp(now, deadline_ts) < 0) {
+    cpu_relax();
+    now = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+  if (worker->wakeup_seq.load(std::memory_order_acquire) == seq &&
+      gpr_time_cmp(now, deadline_ts) < 0) {
+    struct timespec timeout;
+    struct timespec* timeout_ptr = nullptr;
+    if (gpr_time_cmp(deadline_ts, gpr_inf_future(GPR_CLOCK_MONOTONIC)) != 0) {
+      gpr_timespec left = gpr_time_sub(deadline_ts, now);
+      timeout.tv_sec = static_cast<time_t>(left.tv_sec);
+      timeout.tv_nsec = left.tv_nsec;
+      timeout_ptr = &timeout;
+    }
+    /* Either worker_wakeup() sees sleeping set and wakes us, or FUTEX_WAIT
+       sees the bumped sequence number and returns at once. */
+    worker->sleeping.store(true);
+    GRPC_SCHEDULING_START_BLOCKING_REGION;
+    syscall(SYS_futex, &worker->wakeup_seq, FUTEX_WAIT_PRIVATE, seq,
+            timeout_ptr, nullptr, 0);
+    GRPC_SCHEDULING_END_BLOCKING_REGION;
+    worker->sleeping.store(false);
+    now = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+  gpr_mu_lock(pollset_mu);
+  /* Wakeups, like kicks, are only sent with the pollset locked */
+  return worker->wakeup_seq.load(std::memory_order_relaxed) == seq &&
+         gpr_time_cmp(now, deadline_ts) >= 0;
+}
+
 #define MAX_NEIGHBORHOODS 1024
 
 typedef struct pollset_neighborhood {
@@ -274,7 +365,35 @@ static gpr_mu fd_freelist_mu;
 static grpc_fd* fork_fd_list_head = nullptr;
 static gpr_mu fork_fd_list_mu;
 
-static void fd_global_init(void) { gpr_mu_init(&fd_freelist_mu); }
+/* The number of open fds that asked for each busy poll budget (in
+   microseconds), and the largest budget asked for by any of them. The
+   designated poller busy polls while the latter is non-zero, so busy polling
+   stops once the connections that asked for it are closed. */
+static gpr_mu g_busy_poll_mu;
+static std::map<int, int>* g_busy_poll_fd_counts;
+static gpr_atm g_busy_poll_us;
+
+static void fd_global_init(void) {
+  gpr_mu_init(&fd_freelist_mu);
+  gpr_mu_init(&g_busy_poll_mu);
+  g_busy_poll_fd_counts = new std::map<int, int>();
+  gpr_atm_no_barrier_store(&g_busy_poll_us, 0);
+}
+
+/* Adds delta to the number of open fds with a busy poll budget of
+   busy_poll_us, and updates g_busy_poll_us */
+static void busy_poll_count_fds(int busy_poll_us, int delta) {
+  gpr_mu_lock(&g_busy_poll_mu);
+  int& count = (*g_busy_poll_fd_counts)[busy_poll_us];
+  count += delta;
+  /* Fds opened before a fork are not counted after it */
+  if (count <= 0) g_busy_poll_fd_counts->erase(busy_poll_us);
+  gpr_atm_no_barrier_store(&g_busy_poll_us,
+                           g_busy_poll_fd_counts->empty()
+                               ? 0
+                               : g_busy_poll_fd_counts->rbegin()->first);
+  gpr_mu_unlock(&g_busy_poll_mu);
+}
 
 static void fd_global_shutdown(void) {
   // TODO(guantaol): We don't have a reasonable explanation about this
@@ -289,6 +408,9 @@ static void fd_global_shutdown(void) {
     gpr_free(fd);
   }
   gpr_mu_destroy(&fd_freelist_mu);
+  delete g_busy_poll_fd_counts;
+  g_busy_poll_fd_counts = nullptr;
+  gpr_mu_destroy(&g_busy_poll_mu);
 }
 
 static void fork_fd_list_add_grpc_fd(grpc_fd* fd) {
@@ -345,6 +467,7 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   new_fd->error_closure->InitEvent();
 
   new_fd->freelist_next = nullptr;
+  new_fd->busy_poll_us = 0;
 
   char* fd_name;
   gpr_asprintf(&fd_name, "%s fd=%d", name, fd);
@@ -420,6 +543,10 @@ static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
     close(fd->fd);
   }
 
+  if (fd->busy_poll_us > 0) {
+    busy_poll_count_fds(fd->busy_poll_us, -1);
+  }
+
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_done, GRPC_ERROR_REF(error));
 
   grpc_iomgr_unregister_object(&fd->iomgr_object);
@@ -456,6 +583,12 @@ static void fd_become_writable(grpc_fd* fd) { fd->write_closure->SetReady(); }
 
 static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
 
+static void fd_set_busy_poll(grpc_fd* fd, int busy_poll_us) {
+  if (busy_poll_us <= 0 || fd->busy_poll_us > 0) return;
+  fd->busy_poll_us = busy_poll_us;
+  busy_poll_count_fds(busy_poll_us, 1);
+}
+
 /*******************************************************************************
  * Pollset Definitions
  */
@@ -511,6 +644,7 @@ static size_t choose_neighborhood(void) {
 }
 
 static grpc_error* pollset_global_init(void) {
+  g_worker_spin_us = GPR_GLOBAL_CONFIG_GET(grpc_epoll1_worker_spin_us);
   gpr_tls_init(&g_current_thread_pollset);
   gpr_tls_init(&g_current_thread_worker);
   gpr_atm_no_barrier_store(&g_active_poller, 0);
@@ -598,9 +732,9 @@ static grpc_error* pollset_kick_all(grpc_pollset* pollset) {
           break;
         case UNKICKED:
           SET_KICK_STATE(worker, KICKED);
-          if (worker->initialized_cv) {
+          if (worker->waits_for_kick) {
             GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-            gpr_cv_signal(&worker->cv);
+            worker_wakeup(worker);
           }
           break;
         case DESIGNATED_POLLER:
@@ -704,6 +838,44 @@ static grpc_error* process_epoll_events(grpc_pollset* /*pollset*/) {
   return error;
 }
 
+/* Waits for up to timeout milliseconds for events and stores them in
+   g_epoll_set.events. Returns the number of events, or -1 on error. */
+static int wait_for_events(int timeout) {
+  int r;
+  do {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                   timeout);
+  } while (r < 0 && errno == EINTR);
+  return r;
+}
+
+/* Polls without blocking until there are events or busy_poll_us microseconds
+   have passed. Returns the result of the last poll. */
+static int busy_poll(int64_t busy_poll_us) {
+  GPR_TIMER_SCOPE("busy_poll", 0);
+  gpr_timespec end =
+      gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                   gpr_time_from_micros(busy_poll_us, GPR_TIMESPAN));
+  int r;
+  do {
+    r = wait_for_events(0);
+  } while (r == 0 && gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), end) < 0);
+  if (r == 0) {
+    GRPC_STATS_INC_BUSY_POLL_SPIN_MISSES();
+  } else {
+    GRPC_STATS_INC_BUSY_POLL_SPIN_HITS();
+  }
+  return r;
+}
+
+/* Wakes up the designated poller when it watches timers and an earlier timer
+   gets added */
+static void kick_designated_poller_for_timers(void* /*arg*/) {
+  GRPC_LOG_IF_ERROR("kick_designated_poller_for_timers",
+                    grpc_wakeup_fd_wakeup(&global_wakeup_fd));
+}
+
 /* Do epoll_wait and store the events in g_epoll_set.events field. This does not
    "process" any of the events yet; that is done in process_epoll_events().
    *See process_epoll_events() function for more details.
@@ -714,18 +886,25 @@ static grpc_error* process_epoll_events(grpc_pollset* /*pollset*/) {
 static grpc_error* do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
-  int r;
+  int r = 0;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  int64_t busy_poll_us = gpr_atm_no_barrier_load(&g_busy_poll_us);
+  if (timeout != 0 && busy_poll_us > 0) {
+    /* Spin for the busy poll budget, but not past the deadline */
+    if (timeout > 0) {
+      busy_poll_us = GPR_MIN(busy_poll_us,
+                             static_cast<int64_t>(timeout) * GPR_US_PER_MS);
+    }
+    r = busy_poll(busy_poll_us);
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0) {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    r = wait_for_events(timeout);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
@@ -747,7 +926,9 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
                          grpc_millis deadline) {
   GPR_TIMER_SCOPE("begin_worker", 0);
   if (worker_hdl != nullptr) *worker_hdl = worker;
-  worker->initialized_cv = false;
+  worker->waits_for_kick = false;
+  worker->wakeup_seq.store(0, std::memory_order_relaxed);
+  worker->sleeping.store(false, std::memory_order_relaxed);
   SET_KICK_STATE(worker, UNKICKED);
   worker->schedule_on_end_work = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
   pollset->begin_refs++;
@@ -820,8 +1001,7 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
   pollset->begin_refs--;
   if (worker->state == UNKICKED && !pollset->kicked_without_poller) {
     GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
-    worker->initialized_cv = true;
-    gpr_cv_init(&worker->cv);
+    worker->waits_for_kick = true;
     while (worker->state == UNKICKED && !pollset->shutting_down) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
         gpr_log(GPR_INFO, "PS:%p BEGIN_WAIT:%p kick_state=%s shutdown=%d",
@@ -829,10 +1009,9 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
                 pollset->shutting_down);
       }
 
-      if (gpr_cv_wait(&worker->cv, &pollset->mu,
-                      grpc_millis_to_timespec(deadline, GPR_CLOCK_MONOTONIC)) &&
+      if (worker_wait(&pollset->mu, worker, deadline) &&
           worker->state == UNKICKED) {
-        /* If gpr_cv_wait returns true (i.e a timeout), pretend that the worker
+        /* If worker_wait returns true (i.e a timeout), pretend that the worker
            received a kick */
         SET_KICK_STATE(worker, KICKED);
       }
@@ -850,7 +1029,7 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
 
   /* We release pollset lock in this function at a couple of places:
    *   1. Briefly when assigning pollset to a neighborhood
-   *   2. When doing gpr_cv_wait()
+   *   2. When doing worker_wait()
    * It is possible that 'kicked_without_poller' was set to true during (1) and
    * 'shutting_down' is set to true during (1) or (2). If either of them is
    * true, this worker cannot do polling */
@@ -888,10 +1067,10 @@ static bool check_neighborhood_for_available_poller(
                         inspect_worker);
               }
               SET_KICK_STATE(inspect_worker, DESIGNATED_POLLER);
-              if (inspect_worker->initialized_cv) {
+              if (inspect_worker->waits_for_kick) {
                 GPR_TIMER_MARK("signal worker", 0);
                 GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-                gpr_cv_signal(&inspect_worker->cv);
+                worker_wakeup(inspect_worker);
               }
             } else {
               if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
@@ -945,11 +1124,11 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
       if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
         gpr_log(GPR_INFO, " .. choose next poller to be peer %p", worker);
       }
-      GPR_ASSERT(worker->next->initialized_cv);
+      GPR_ASSERT(worker->next->waits_for_kick);
       gpr_atm_no_barrier_store(&g_active_poller, (gpr_atm)worker->next);
       SET_KICK_STATE(worker->next, DESIGNATED_POLLER);
       GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-      gpr_cv_signal(&worker->next->cv);
+      worker_wakeup(worker->next);
       if (grpc_core::ExecCtx::Get()->HasWork()) {
         gpr_mu_unlock(&pollset->mu);
         grpc_core::ExecCtx::Get()->Flush();
@@ -991,9 +1170,6 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
     grpc_core::ExecCtx::Get()->Flush();
     gpr_mu_lock(&pollset->mu);
   }
-  if (worker->initialized_cv) {
-    gpr_cv_destroy(&worker->cv);
-  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
     gpr_log(GPR_INFO, " .. remove worker");
   }
@@ -1042,7 +1218,13 @@ static grpc_error* pollset_work(grpc_pollset* ps,
        without a designated poller */
     if (gpr_atm_acq_load(&g_epoll_set.cursor) ==
         gpr_atm_acq_load(&g_epoll_set.num_events)) {
-      append_error(&error, do_epoll_wait(ps, deadline), err_desc);
+      grpc_millis poll_deadline = deadline;
+      bool watch_timers = grpc_timer_manager_begin_poll(
+          &poll_deadline, kick_designated_poller_for_timers, nullptr);
+      append_error(&error, do_epoll_wait(ps, poll_deadline), err_desc);
+      if (watch_timers) {
+        grpc_timer_manager_end_poll();
+      }
     }
     append_error(&error, process_epoll_events(ps), err_desc);
 
@@ -1133,22 +1315,22 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
         if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
           gpr_log(GPR_INFO, " .. kicked %p", next_worker);
         }
-        GPR_ASSERT(next_worker->initialized_cv);
+        GPR_ASSERT(next_worker->waits_for_kick);
         SET_KICK_STATE(next_worker, KICKED);
-        gpr_cv_signal(&next_worker->cv);
+        worker_wakeup(next_worker);
         goto done;
       } else if (next_worker->state == DESIGNATED_POLLER) {
         if (root_worker->state != DESIGNATED_POLLER) {
           if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
             gpr_log(
                 GPR_INFO,
-                " .. kicked root non-poller %p (initialized_cv=%d) (poller=%p)",
-                root_worker, root_worker->initialized_cv, next_worker);
+                " .. kicked root non-poller %p (waits_for_kick=%d) (poller=%p)",
+                root_worker, root_worker->waits_for_kick, next_worker);
           }
           SET_KICK_STATE(root_worker, KICKED);
-          if (root_worker->initialized_cv) {
+          if (root_worker->waits_for_kick) {
             GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
-            gpr_cv_signal(&root_worker->cv);
+            worker_wakeup(root_worker);
           }
           goto done;
         } else {
@@ -1200,13 +1382,13 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
     SET_KICK_STATE(specific_worker, KICKED);
     ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
     goto done;
-  } else if (specific_worker->initialized_cv) {
+  } else if (specific_worker->waits_for_kick) {
     GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
     if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
       gpr_log(GPR_INFO, " .. kick waiting worker");
     }
     SET_KICK_STATE(specific_worker, KICKED);
-    gpr_cv_signal(&specific_worker->cv);
+    worker_wakeup(specific_worker);
     goto done;
   } else {
     GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
@@ -1222,6 +1404,8 @@ done:
 
 static void pollset_add_fd(grpc_pollset* /*pollset*/, grpc_fd* /*fd*/) {}
 
+static bool pollset_is_local(grpc_pollset* /*pollset*/) { return true; }
+
 /*******************************************************************************
  * Pollset-set Definitions
  */
@@ -1287,6 +1471,7 @@ static const grpc_event_engine_vtable vtable = {
     fd_become_writable,
     fd_has_errors,
     fd_is_shutdown,
+    fd_set_busy_poll,
 
     pollset_init,
     pollset_shutdown,
@@ -1294,6 +1479,7 @@ static const grpc_event_engine_vtable vtable = {
     pollset_work,
     pollset_kick,
     pollset_add_fd,
+    pollset_is_local,
 
     pollset_set_create,
     pollset_set_destroy,
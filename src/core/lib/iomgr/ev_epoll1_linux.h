@@ -21,9 +21,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/port.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_epoll1_worker_spin_us);
+
 // a polling engine that utilizes a singleton epoll set and turnstile polling
 
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request);
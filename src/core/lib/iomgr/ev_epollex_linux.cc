@@ -32,6 +32,9 @@
 #include <limits.h>
 #include <poll.h>
 #include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/epoll.h>
 #include <sys/socket.h>
@@ -39,6 +42,7 @@
 #include <unistd.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/debug/stats.h"
@@ -55,6 +59,7 @@
 #include "src/core/lib/iomgr/lockfree_event.h"
 #include "src/core/lib/iomgr/sys_epoll_wrapper.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_manager.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
@@ -68,6 +73,12 @@
 // .com/grpc/grpc/pull/14943 once we figure out the root cause.
 #define MAX_EPOLL_EVENTS_HANDLED_EACH_POLL_CALL 16
 #define MAX_FDS_IN_CACHE 32
+#define MAX_NUMA_NODES 64
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_epollex_numa_affinity, false,
+    "If set, epollex binds every pollset to a NUMA node, round-robin, and "
+    "pins the threads that poll it to the CPUs of that node.");
 
 grpc_core::DebugOnlyTraceFlag grpc_trace_pollable_refcount(false,
                                                            "pollable_refcount");
@@ -246,6 +257,10 @@ struct grpc_fd {
 
   // Do we need to track EPOLLERR events separately?
   bool track_err;
+
+  // NUMA node of the first pollset bound to a node that the fd was added to,
+  // or -1.
+  gpr_atm numa_node = -1;
 };
 
 static void fd_global_init(void);
@@ -286,12 +301,27 @@ struct grpc_pollset {
   bool already_shutdown;
   grpc_pollset_worker* root_worker;
   int containing_pollset_set_count;
+  int numa_node;  // -1 unless grpc_epollex_numa_affinity is set
 };
 
 /*******************************************************************************
  * Pollset-set Declarations
  */
 
+// Open-addressed map from a member of a pollset_set to its position in the
+// set's array, so that members are removed without scanning the array. A
+// member added more than once has one slot per position it holds.
+typedef struct {
+  void* member;
+  size_t pos;
+} pss_index_slot;
+
+typedef struct {
+  size_t count;
+  size_t capacity;  // zero or a power of two
+  pss_index_slot* slots;
+} pss_index;
+
 struct grpc_pollset_set {
   grpc_core::RefCount refs;
   gpr_mu mu;
@@ -300,10 +330,12 @@ struct grpc_pollset_set {
   size_t pollset_count;
   size_t pollset_capacity;
   grpc_pollset** pollsets;
+  pss_index pollset_index;
 
   size_t fd_count;
   size_t fd_capacity;
   grpc_fd** fds;
+  pss_index fd_index;
 };
 
 /*******************************************************************************
@@ -504,6 +536,9 @@ static bool fd_is_shutdown(grpc_fd* fd) {
   return fd->read_closure.IsShutdown();
 }
 
+/* Busy polling is not supported by this engine. */
+static void fd_set_busy_poll(grpc_fd* /*fd*/, int /*busy_poll_us*/) {}
+
 /* Might be called multiple times */
 static void fd_shutdown(grpc_fd* fd, grpc_error* why) {
   if (fd->read_closure.SetShutdown(GRPC_ERROR_REF(why))) {
@@ -631,6 +666,156 @@ static grpc_error* pollable_add_fd(pollable* p, grpc_fd* fd) {
   return error;
 }
 
+/*******************************************************************************
+ * NUMA Definitions
+ */
+
+typedef struct {
+  cpu_set_t cpus;
+  gpr_atm remote_wakeups;
+  // Keep the counters of different nodes on different cache lines
+  char padding[GPR_CACHELINE_SIZE];
+} numa_node;
+
+// Only set up by numa_global_init(): g_numa_node_count is zero unless
+// grpc_epollex_numa_affinity is set.
+static numa_node* g_numa_nodes;
+static int g_numa_node_count;
+static int* g_cpu_numa_node;  // CPU_SETSIZE entries, -1 for unknown CPUs
+static gpr_atm g_next_numa_node;
+
+// The node the current thread is pinned to, plus one; zero if it is not.
+GPR_TLS_DECL(g_current_thread_numa_node);
+
+// Parses a sysfs list such as "0-3,8,10-11" into set.
+static bool parse_cpu_list(const char* list, cpu_set_t* set) {
+  CPU_ZERO(set);
+  const char* p = list;
+  while (*p != '\0' && *p != '\n') {
+    char* end;
+    long first = strtol(p, &end, 10);
+    if (end == p || first < 0) return false;
+    long last = first;
+    if (*end == '-') {
+      p = end + 1;
+      last = strtol(p, &end, 10);
+      if (end == p || last < first) return false;
+    }
+    for (long i = first; i <= last && i < CPU_SETSIZE; i++) {
+      CPU_SET(i, set);
+    }
+    p = end;
+    if (*p == ',') p++;
+  }
+  return true;
+}
+
+// sysfs files do not know their size up front, so they are read with plain
+// stdio rather than grpc_load_file().
+static bool read_cpu_list(const char* path, cpu_set_t* set) {
+  FILE* f = fopen(path, "r");
+  if (f == nullptr) return false;
+  char buf[4096];
+  bool ok = fgets(buf, sizeof(buf), f) != nullptr && parse_cpu_list(buf, set);
+  fclose(f);
+  return ok;
+}
+
+static void numa_global_init(void) {
+  gpr_tls_init(&g_current_thread_numa_node);
+  g_numa_node_count = 0;
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_epollex_numa_affinity)) return;
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    gpr_log(GPR_ERROR, "Not using NUMA affinity: sched_getaffinity: %s",
+            strerror(errno));
+    return;
+  }
+  g_numa_nodes =
+      static_cast<numa_node*>(gpr_zalloc(sizeof(numa_node) * MAX_NUMA_NODES));
+  g_cpu_numa_node = static_cast<int*>(gpr_malloc(sizeof(int) * CPU_SETSIZE));
+  for (int i = 0; i < CPU_SETSIZE; i++) {
+    g_cpu_numa_node[i] = -1;
+  }
+  // Nodes that none of our CPUs belong to are left out.
+  cpu_set_t online;
+  if (read_cpu_list("/sys/devices/system/node/online", &online)) {
+    for (int id = 0; id < CPU_SETSIZE && g_numa_node_count < MAX_NUMA_NODES;
+         id++) {
+      if (!CPU_ISSET(id, &online)) continue;
+      char* path;
+      gpr_asprintf(&path, "/sys/devices/system/node/node%d/cpulist", id);
+      numa_node* node = &g_numa_nodes[g_numa_node_count];
+      if (read_cpu_list(path, &node->cpus)) {
+        CPU_AND(&node->cpus, &node->cpus, &allowed);
+        if (CPU_COUNT(&node->cpus) > 0) g_numa_node_count++;
+      }
+      gpr_free(path);
+    }
+  }
+  if (g_numa_node_count == 0) {
+    // No NUMA topology to go by: all of our CPUs make up a single node.
+    g_numa_nodes[0].cpus = allowed;
+    g_numa_node_count = 1;
+  }
+  for (int i = 0; i < g_numa_node_count; i++) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &g_numa_nodes[i].cpus)) g_cpu_numa_node[cpu] = i;
+    }
+  }
+  gpr_log(GPR_INFO, "Binding pollsets to %d NUMA nodes", g_numa_node_count);
+}
+
+static void numa_global_shutdown(void) {
+  g_numa_node_count = 0;
+  gpr_free(g_numa_nodes);
+  g_numa_nodes = nullptr;
+  gpr_free(g_cpu_numa_node);
+  g_cpu_numa_node = nullptr;
+  gpr_tls_destroy(&g_current_thread_numa_node);
+}
+
+static int current_numa_node(void) {
+  intptr_t pinned = gpr_tls_get(&g_current_thread_numa_node);
+  if (pinned != 0) return static_cast<int>(pinned - 1);
+  unsigned cpu = gpr_cpu_current_cpu();
+  return cpu < CPU_SETSIZE ? g_cpu_numa_node[cpu] : -1;
+}
+
+// Pins the current thread to the CPUs of node, unless it already is. A thread
+// that fails to pin still counts as being on node, so that it does not retry
+// on every poll.
+static void pin_current_thread_to_numa_node(int node) {
+  if (gpr_tls_get(&g_current_thread_numa_node) == node + 1) return;
+  if (sched_setaffinity(0, sizeof(cpu_set_t), &g_numa_nodes[node].cpus) !=
+      0) {
+    gpr_log(GPR_ERROR, "sched_setaffinity: %s", strerror(errno));
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "pinned thread to NUMA node %d", node);
+  }
+  gpr_tls_set(&g_current_thread_numa_node, node + 1);
+}
+
+// Called for every fd event while NUMA affinity is on.
+static void numa_count_wakeup(grpc_fd* fd) {
+  int node = static_cast<int>(gpr_atm_no_barrier_load(&fd->numa_node));
+  if (node < 0) return;
+  if (current_numa_node() == node) {
+    GRPC_STATS_INC_POLLSET_NUMA_LOCAL_WAKEUPS();
+  } else {
+    GRPC_STATS_INC_POLLSET_NUMA_REMOTE_WAKEUPS();
+    gpr_atm_no_barrier_fetch_add(&g_numa_nodes[node].remote_wakeups, 1);
+  }
+}
+
+int grpc_epollex_numa_node_count() { return g_numa_node_count; }
+
+int64_t grpc_epollex_numa_remote_wakeups(int node) {
+  GPR_ASSERT(node >= 0 && node < g_numa_node_count);
+  return gpr_atm_no_barrier_load(&g_numa_nodes[node].remote_wakeups);
+}
+
 /*******************************************************************************
  * Pollset Definitions
  */
@@ -642,6 +827,7 @@ GPR_TLS_DECL(g_current_thread_worker);
 static grpc_error* pollset_global_init(void) {
   gpr_tls_init(&g_current_thread_pollset);
   gpr_tls_init(&g_current_thread_worker);
+  numa_global_init();
   return pollable_create(PO_EMPTY, &g_empty_pollable);
 }
 
@@ -649,6 +835,7 @@ static void pollset_global_shutdown(void) {
   POLLABLE_UNREF(g_empty_pollable, "g_empty_pollable");
   gpr_tls_destroy(&g_current_thread_pollset);
   gpr_tls_destroy(&g_current_thread_worker);
+  numa_global_shutdown();
 }
 
 /* pollset->mu must be held while calling this function */
@@ -792,6 +979,11 @@ static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
   pollset->already_shutdown = false;
   pollset->root_worker = nullptr;
   pollset->containing_pollset_set_count = 0;
+  pollset->numa_node = -1;
+  if (g_numa_node_count > 0) {
+    pollset->numa_node = static_cast<int>(
+        gpr_atm_no_barrier_fetch_add(&g_next_numa_node, 1) % g_numa_node_count);
+  }
   *mu = &pollset->mu;
 }
 
@@ -900,6 +1092,9 @@ static grpc_error* pollable_process_events(grpc_pollset* pollset,
                 "write=%d",
                 pollset, fd, cancel, read_ev, write_ev);
       }
+      if (g_numa_node_count > 0) {
+        numa_count_wakeup(fd);
+      }
       if (error && !err_fallback) {
         fd_has_errors(fd);
       }
@@ -922,6 +1117,14 @@ static void pollset_destroy(grpc_pollset* pollset) {
   gpr_mu_destroy(&pollset->mu);
 }
 
+/* Wakes up a worker polling a pollable when it watches timers and an earlier
+   timer gets added */
+static void kick_pollable_for_timers(void* arg) {
+  pollable* p = static_cast<pollable*>(arg);
+  GRPC_LOG_IF_ERROR("kick_pollable_for_timers",
+                    grpc_wakeup_fd_wakeup(&p->wakeup));
+}
+
 static grpc_error* pollable_epoll(pollable* p, grpc_millis deadline) {
   GPR_TIMER_SCOPE("pollable_epoll", 0);
   int timeout = poll_deadline_to_millis_timeout(deadline);
@@ -1121,13 +1324,23 @@ static grpc_error* pollset_work(grpc_pollset* pollset,
   if (pollset->kicked_without_poller) {
     pollset->kicked_without_poller = false;
   } else {
+    if (pollset->numa_node >= 0) {
+      pin_current_thread_to_numa_node(pollset->numa_node);
+    }
     if (begin_worker(pollset, WORKER_PTR, worker_hdl, deadline)) {
       gpr_tls_set(&g_current_thread_pollset, (intptr_t)pollset);
       gpr_tls_set(&g_current_thread_worker, (intptr_t)WORKER_PTR);
       if (WORKER_PTR->pollable_obj->event_cursor ==
           WORKER_PTR->pollable_obj->event_count) {
-        append_error(&error, pollable_epoll(WORKER_PTR->pollable_obj, deadline),
+        grpc_millis poll_deadline = deadline;
+        bool watch_timers = grpc_timer_manager_begin_poll(
+            &poll_deadline, kick_pollable_for_timers, WORKER_PTR->pollable_obj);
+        append_error(&error,
+                     pollable_epoll(WORKER_PTR->pollable_obj, poll_deadline),
                      err_desc);
+        if (watch_timers) {
+          grpc_timer_manager_end_poll();
+        }
       }
       append_error(
           &error,
@@ -1279,6 +1492,10 @@ static grpc_error* pollset_as_multipollable_locked(grpc_pollset* pollset,
 static void pollset_add_fd(grpc_pollset* pollset, grpc_fd* fd) {
   GPR_TIMER_SCOPE("pollset_add_fd", 0);
 
+  if (pollset->numa_node >= 0) {
+    gpr_atm_no_barrier_cas(&fd->numa_node, -1, pollset->numa_node);
+  }
+
   // We never transition from PO_MULTI to other modes (i.e., PO_FD or PO_EMPTY)
   // and, thus, it is safe to simply store and check whether the FD has already
   // been added to the active pollable previously.
@@ -1298,10 +1515,110 @@ static void pollset_add_fd(grpc_pollset* pollset, grpc_fd* fd) {
   GRPC_LOG_IF_ERROR("pollset_add_fd", error);
 }
 
+static bool pollset_is_local(grpc_pollset* pollset) {
+  return pollset->numa_node < 0 || pollset->numa_node == current_numa_node();
+}
+
 /*******************************************************************************
  * Pollset-set Definitions
  */
 
+static size_t pss_index_home(const pss_index* idx, void* member) {
+  uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(member));
+  h *= 0x9e3779b97f4a7c15ull;
+  return static_cast<size_t>(h >> 32) & (idx->capacity - 1);
+}
+
+static void pss_index_insert(pss_index* idx, void* member, size_t pos);
+
+static void pss_index_grow(pss_index* idx) {
+  pss_index_slot* old_slots = idx->slots;
+  size_t old_capacity = idx->capacity;
+  idx->capacity = GPR_MAX(2 * old_capacity, 16);
+  idx->slots = static_cast<pss_index_slot*>(
+      gpr_zalloc(idx->capacity * sizeof(*idx->slots)));
+  idx->count = 0;
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_slots[i].member != nullptr) {
+      pss_index_insert(idx, old_slots[i].member, old_slots[i].pos);
+    }
+  }
+  gpr_free(old_slots);
+}
+
+static void pss_index_insert(pss_index* idx, void* member, size_t pos) {
+  if (2 * (idx->count + 1) > idx->capacity) pss_index_grow(idx);
+  size_t i = pss_index_home(idx, member);
+  while (idx->slots[i].member != nullptr) i = (i + 1) & (idx->capacity - 1);
+  idx->slots[i].member = member;
+  idx->slots[i].pos = pos;
+  idx->count++;
+}
+
+// Returns the slot of \a member, at position \a pos unless that is SIZE_MAX.
+static size_t pss_index_find(const pss_index* idx, void* member, size_t pos) {
+  GPR_ASSERT(idx->capacity > 0);
+  size_t i = pss_index_home(idx, member);
+  for (;;) {
+    const pss_index_slot& slot = idx->slots[i];
+    GPR_ASSERT(slot.member != nullptr);
+    if (slot.member == member && (pos == SIZE_MAX || slot.pos == pos)) {
+      return i;
+    }
+    i = (i + 1) & (idx->capacity - 1);
+  }
+}
+
+// Removes a slot of \a member and returns the position it held.
+static size_t pss_index_remove(pss_index* idx, void* member) {
+  size_t hole = pss_index_find(idx, member, SIZE_MAX);
+  const size_t pos = idx->slots[hole].pos;
+  // Shift later slots of the probe run back, so that lookups need no
+  // tombstones.
+  const size_t mask = idx->capacity - 1;
+  for (size_t i = (hole + 1) & mask; idx->slots[i].member != nullptr;
+       i = (i + 1) & mask) {
+    const size_t home = pss_index_home(idx, idx->slots[i].member);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      idx->slots[hole] = idx->slots[i];
+      hole = i;
+    }
+  }
+  idx->slots[hole].member = nullptr;
+  idx->count--;
+  return pos;
+}
+
+template <typename T>
+static void pss_index_rebuild(pss_index* idx, T** members, size_t count) {
+  if (idx->capacity > 0) {
+    memset(idx->slots, 0, idx->capacity * sizeof(*idx->slots));
+  }
+  idx->count = 0;
+  for (size_t i = 0; i < count; i++) {
+    pss_index_insert(idx, members[i], i);
+  }
+}
+
+static void pss_index_destroy(pss_index* idx) {
+  gpr_free(idx->slots);
+  idx->slots = nullptr;
+  idx->count = idx->capacity = 0;
+}
+
+// Removes the member at \a pos from \a members by moving the last member
+// into its place. Returns the new count.
+template <typename T>
+static size_t pss_remove_at(pss_index* idx, T** members, size_t count,
+                            size_t pos) {
+  const size_t last = count - 1;
+  if (pos != last) {
+    members[pos] = members[last];
+    idx->slots[pss_index_find(idx, members[pos], last)].pos = pos;
+  }
+  return last;
+}
+
 static grpc_pollset_set* pss_lock_adam(grpc_pollset_set* pss) {
   gpr_mu_lock(&pss->mu);
   while (pss->parent != nullptr) {
@@ -1337,6 +1654,8 @@ static void pollset_set_unref(grpc_pollset_set* pss) {
   }
   gpr_free(pss->pollsets);
   gpr_free(pss->fds);
+  pss_index_destroy(&pss->pollset_index);
+  pss_index_destroy(&pss->fd_index);
   gpr_free(pss);
 }
 
@@ -1358,6 +1677,7 @@ static void pollset_set_add_fd(grpc_pollset_set* pss, grpc_fd* fd) {
         gpr_realloc(pss->fds, pss->fd_capacity * sizeof(*pss->fds)));
   }
   REF_BY(fd, 2, "pollset_set");
+  pss_index_insert(&pss->fd_index, fd, pss->fd_count);
   pss->fds[pss->fd_count++] = fd;
   gpr_mu_unlock(&pss->mu);
 
@@ -1370,18 +1690,9 @@ static void pollset_set_del_fd(grpc_pollset_set* pss, grpc_fd* fd) {
     gpr_log(GPR_INFO, "PSS:%p: del fd %p", pss, fd);
   }
   pss = pss_lock_adam(pss);
-  size_t i;
-  for (i = 0; i < pss->fd_count; i++) {
-    if (pss->fds[i] == fd) {
-      UNREF_BY(fd, 2, "pollset_set");
-      break;
-    }
-  }
-  GPR_ASSERT(i != pss->fd_count);
-  for (; i < pss->fd_count - 1; i++) {
-    pss->fds[i] = pss->fds[i + 1];
-  }
-  pss->fd_count--;
+  size_t pos = pss_index_remove(&pss->fd_index, fd);
+  UNREF_BY(fd, 2, "pollset_set");
+  pss->fd_count = pss_remove_at(&pss->fd_index, pss->fds, pss->fd_count, pos);
   gpr_mu_unlock(&pss->mu);
 }
 
@@ -1391,17 +1702,9 @@ static void pollset_set_del_pollset(grpc_pollset_set* pss, grpc_pollset* ps) {
     gpr_log(GPR_INFO, "PSS:%p: del pollset %p", pss, ps);
   }
   pss = pss_lock_adam(pss);
-  size_t i;
-  for (i = 0; i < pss->pollset_count; i++) {
-    if (pss->pollsets[i] == ps) {
-      break;
-    }
-  }
-  GPR_ASSERT(i != pss->pollset_count);
-  for (; i < pss->pollset_count - 1; i++) {
-    pss->pollsets[i] = pss->pollsets[i + 1];
-  }
-  pss->pollset_count--;
+  size_t pos = pss_index_remove(&pss->pollset_index, ps);
+  pss->pollset_count = pss_remove_at(&pss->pollset_index, pss->pollsets,
+                                     pss->pollset_count, pos);
   gpr_mu_unlock(&pss->mu);
   gpr_mu_lock(&ps->mu);
   if (0 == --ps->containing_pollset_set_count) {
@@ -1461,11 +1764,16 @@ static void pollset_set_add_pollset(grpc_pollset_set* pss, grpc_pollset* ps) {
                add_fds_to_pollsets(pss->fds, initial_fd_count, &ps, 1, err_desc,
                                    pss->fds, &pss->fd_count),
                err_desc);
+  if (pss->fd_count != initial_fd_count) {
+    // Orphaned fds were dropped, which moved the others.
+    pss_index_rebuild(&pss->fd_index, pss->fds, pss->fd_count);
+  }
   if (pss->pollset_count == pss->pollset_capacity) {
     pss->pollset_capacity = GPR_MAX(pss->pollset_capacity * 2, 8);
     pss->pollsets = static_cast<grpc_pollset**>(gpr_realloc(
         pss->pollsets, pss->pollset_capacity * sizeof(*pss->pollsets)));
   }
+  pss_index_insert(&pss->pollset_index, ps, pss->pollset_count);
   pss->pollsets[pss->pollset_count++] = ps;
   gpr_mu_unlock(&pss->mu);
   POLLABLE_UNREF(pollable_obj, "pollset_set");
@@ -1543,8 +1851,12 @@ static void pollset_set_add_pollset_set(grpc_pollset_set* a,
            b->pollset_count * sizeof(*b->pollsets));
   }
   a->pollset_count += b->pollset_count;
+  pss_index_rebuild(&a->fd_index, a->fds, a->fd_count);
+  pss_index_rebuild(&a->pollset_index, a->pollsets, a->pollset_count);
   gpr_free(b->fds);
   gpr_free(b->pollsets);
+  pss_index_destroy(&b->fd_index);
+  pss_index_destroy(&b->pollset_index);
   b->fds = nullptr;
   b->pollsets = nullptr;
   b->fd_count = b->fd_capacity = b->pollset_count = b->pollset_capacity = 0;
@@ -1589,6 +1901,7 @@ static const grpc_event_engine_vtable vtable = {
     fd_become_writable,
     fd_has_errors,
     fd_is_shutdown,
+    fd_set_busy_poll,
 
     pollset_init,
     pollset_shutdown,
@@ -1596,6 +1909,7 @@ static const grpc_event_engine_vtable vtable = {
     pollset_work,
     pollset_kick,
     pollset_add_fd,
+    pollset_is_local,
 
     pollset_set_create,
     pollset_set_unref,  // destroy ==> unref 1 public ref
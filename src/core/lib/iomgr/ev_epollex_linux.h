@@ -21,10 +21,21 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/port.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_epollex_numa_affinity);
+
 const grpc_event_engine_vtable* grpc_init_epollex_linux(
     bool explicitly_requested);
 
+/* Returns the number of NUMA nodes that pollsets are spread over, or 0 if
+ * grpc_epollex_numa_affinity is not set. */
+int grpc_epollex_numa_node_count();
+
+/* Returns how many fd events of fds that were first added to a pollset on
+ * NUMA node \a node were handled by a poller running on another node. */
+int64_t grpc_epollex_numa_remote_wakeups(int node);
+
 #endif /* GRPC_CORE_LIB_IOMGR_EV_EPOLLEX_LINUX_H */
@@ -559,6 +559,9 @@ static bool fd_is_shutdown(grpc_fd* fd) {
   return r;
 }
 
+/* Busy polling is not supported by this engine. */
+static void fd_set_busy_poll(grpc_fd* /*fd*/, int /*busy_poll_us*/) {}
+
 static void fd_notify_on_read(grpc_fd* fd, grpc_closure* closure) {
   gpr_mu_lock(&fd->mu);
   notify_on_locked(fd, &fd->read_closure, closure);
@@ -891,6 +894,8 @@ exit:
   gpr_mu_unlock(&pollset->mu);
 }
 
+static bool pollset_is_local(grpc_pollset* /*pollset*/) { return true; }
+
 static void finish_shutdown(grpc_pollset* pollset) {
   size_t i;
   for (i = 0; i < pollset->fd_count; i++) {
@@ -1361,6 +1366,7 @@ static const grpc_event_engine_vtable vtable = {
     fd_set_writable,
     fd_set_error,
     fd_is_shutdown,
+    fd_set_busy_poll,
 
     pollset_init,
     pollset_shutdown,
@@ -1368,6 +1374,7 @@ static const grpc_event_engine_vtable vtable = {
     pollset_work,
     pollset_kick,
     pollset_add_fd,
+    pollset_is_local,
 
     pollset_set_create,
     pollset_set_destroy,
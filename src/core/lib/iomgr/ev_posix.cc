@@ -299,6 +299,12 @@ void grpc_fd_set_writable(grpc_fd* fd) { g_event_engine->fd_set_writable(fd); }
 
 void grpc_fd_set_error(grpc_fd* fd) { g_event_engine->fd_set_error(fd); }
 
+void grpc_fd_set_busy_poll(grpc_fd* fd, int busy_poll_us) {
+  GRPC_POLLING_API_TRACE("fd_set_busy_poll(%d, %d)", grpc_fd_wrapped_fd(fd),
+                         busy_poll_us);
+  g_event_engine->fd_set_busy_poll(fd, busy_poll_us);
+}
+
 static size_t pollset_size(void) { return g_event_engine->pollset_size; }
 
 static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
@@ -339,6 +345,10 @@ void grpc_pollset_add_fd(grpc_pollset* pollset, struct grpc_fd* fd) {
   g_event_engine->pollset_add_fd(pollset, fd);
 }
 
+bool grpc_pollset_is_local(grpc_pollset* pollset) {
+  return g_event_engine->pollset_is_local(pollset);
+}
+
 void pollset_global_init() {}
 void pollset_global_shutdown() {}
 
@@ -60,6 +60,7 @@ typedef struct grpc_event_engine_vtable {
   void (*fd_set_writable)(grpc_fd* fd);
   void (*fd_set_error)(grpc_fd* fd);
   bool (*fd_is_shutdown)(grpc_fd* fd);
+  void (*fd_set_busy_poll)(grpc_fd* fd, int busy_poll_us);
 
   void (*pollset_init)(grpc_pollset* pollset, gpr_mu** mu);
   void (*pollset_shutdown)(grpc_pollset* pollset, grpc_closure* closure);
@@ -70,6 +71,7 @@ typedef struct grpc_event_engine_vtable {
   grpc_error* (*pollset_kick)(grpc_pollset* pollset,
                               grpc_pollset_worker* specific_worker);
   void (*pollset_add_fd)(grpc_pollset* pollset, struct grpc_fd* fd);
+  bool (*pollset_is_local)(grpc_pollset* pollset);
 
   grpc_pollset_set* (*pollset_set_create)(void);
   void (*pollset_set_destroy)(grpc_pollset_set* pollset_set);
@@ -178,11 +180,20 @@ void grpc_fd_set_writable(grpc_fd* fd);
  */
 void grpc_fd_set_error(grpc_fd* fd);
 
+/* Ask the polling engine to busy poll for up to busy_poll_us microseconds
+ * before blocking, for as long as fd is open. This is only a hint: engines that
+ * do not support busy polling ignore it. */
+void grpc_fd_set_busy_poll(grpc_fd* fd, int busy_poll_us);
+
 /* pollset_posix functions */
 
 /* Add an fd to a pollset */
 void grpc_pollset_add_fd(grpc_pollset* pollset, struct grpc_fd* fd);
 
+/* Returns false if the polling engine keeps pollset's pollers on a NUMA node
+ * other than the one the calling thread is running on, true otherwise. */
+bool grpc_pollset_is_local(grpc_pollset* pollset);
+
 /* pollset_set_posix functions */
 
 void grpc_pollset_set_add_fd(grpc_pollset_set* pollset_set, grpc_fd* fd);
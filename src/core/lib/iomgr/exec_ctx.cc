@@ -30,7 +30,7 @@
 static void exec_ctx_run(grpc_closure* closure, grpc_error* error) {
 #ifndef NDEBUG
   closure->scheduled = false;
-  if (grpc_trace_closure.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_closure)) {
     gpr_log(GPR_DEBUG, "running closure %p: created [%s:%d]: %s [%s:%d]",
             closure, closure->file_created, closure->line_created,
             closure->run ? "run" : "scheduled", closure->file_initiated,
@@ -39,16 +39,20 @@ static void exec_ctx_run(grpc_closure* closure, grpc_error* error) {
 #endif
   closure->cb(closure->cb_arg, error);
 #ifndef NDEBUG
-  if (grpc_trace_closure.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_closure)) {
     gpr_log(GPR_DEBUG, "closure %p finished", closure);
   }
 #endif
   GRPC_ERROR_UNREF(error);
 }
 
-static void exec_ctx_sched(grpc_closure* closure, grpc_error* error) {
-  grpc_closure_list_append(grpc_core::ExecCtx::Get()->closure_list(), closure,
-                           error);
+static grpc_closure* closure_list_pop(grpc_closure_list* list) {
+  grpc_closure* closure = list->head;
+  if (closure != nullptr) {
+    list->head = closure->next_data.next;
+    if (list->head == nullptr) list->tail = nullptr;
+  }
+  return closure;
 }
 
 static gpr_timespec g_start_time;
@@ -139,20 +143,47 @@ void ExecCtx::GlobalInit(void) {
   gpr_tls_init(&exec_ctx_);
 }
 
+bool ExecCtx::RunClosures() {
+  if (!grpc_closure_list_empty(latency_closure_list_)) {
+    grpc_closure* c;
+    for (int i = 0; i < kMaxLatencyBurst &&
+                    (c = closure_list_pop(&latency_closure_list_)) != nullptr;
+         i++) {
+      exec_ctx_run(c, c->error_data.error);
+    }
+    // Still more latency work: let one bulk closure through first.
+    if (!grpc_closure_list_empty(latency_closure_list_) &&
+        (c = closure_list_pop(&closure_list_)) != nullptr) {
+      exec_ctx_run(c, c->error_data.error);
+    }
+    return true;
+  }
+  if (grpc_closure_list_empty(closure_list_)) return false;
+  grpc_closure* c = closure_list_.head;
+  grpc_closure* tail = closure_list_.tail;
+  closure_list_.head = closure_list_.tail = nullptr;
+  while (c != nullptr) {
+    grpc_closure* next = c->next_data.next;
+    grpc_error* error = c->error_data.error;
+    exec_ctx_run(c, error);
+    c = next;
+    if (c != nullptr && !grpc_closure_list_empty(latency_closure_list_)) {
+      // Put the rest of the batch back in front of whatever it scheduled.
+      tail->next_data.next = closure_list_.head;
+      if (closure_list_.head == nullptr) closure_list_.tail = tail;
+      closure_list_.head = c;
+      break;
+    }
+  }
+  return true;
+}
+
 bool ExecCtx::Flush() {
   bool did_something = 0;
   GPR_TIMER_SCOPE("grpc_exec_ctx_flush", 0);
   for (;;) {
-    if (!grpc_closure_list_empty(closure_list_)) {
-      grpc_closure* c = closure_list_.head;
-      closure_list_.head = closure_list_.tail = nullptr;
-      while (c != nullptr) {
-        grpc_closure* next = c->next_data.next;
-        grpc_error* error = c->error_data.error;
-        did_something = true;
-        exec_ctx_run(c, error);
-        c = next;
-      }
+    if (RunClosures()) {
+      did_something = true;
     } else if (!grpc_combiner_continue_exec_ctx()) {
       break;
     }
@@ -170,7 +201,7 @@ grpc_millis ExecCtx::Now() {
 }
 
 void ExecCtx::Run(const DebugLocation& location, grpc_closure* closure,
-                  grpc_error* error) {
+                  grpc_error* error, ClosureLane lane) {
   (void)location;
   if (closure == nullptr) {
     GRPC_ERROR_UNREF(error);
@@ -192,11 +223,13 @@ void ExecCtx::Run(const DebugLocation& location, grpc_closure* closure,
   closure->run = false;
   GPR_ASSERT(closure->cb != nullptr);
 #endif
-  exec_ctx_sched(closure, error);
+  grpc_closure_list_append(ExecCtx::Get()->lane_list(lane), closure, error);
 }
 
-void ExecCtx::RunList(const DebugLocation& location, grpc_closure_list* list) {
+void ExecCtx::RunList(const DebugLocation& location, grpc_closure_list* list,
+                      ClosureLane lane) {
   (void)location;
+  grpc_closure_list* lane_list = ExecCtx::Get()->lane_list(lane);
   grpc_closure* c = list->head;
   while (c != nullptr) {
     grpc_closure* next = c->next_data.next;
@@ -215,7 +248,7 @@ void ExecCtx::RunList(const DebugLocation& location, grpc_closure_list* list) {
     c->run = false;
     GPR_ASSERT(c->cb != nullptr);
 #endif
-    exec_ctx_sched(c, c->error_data.error);
+    grpc_closure_list_append(lane_list, c, c->error_data.error);
     c = next;
   }
   list->head = list->tail = nullptr;
@@ -144,7 +144,14 @@ class ExecCtx {
   /** Only to be used by grpc-combiner code */
   CombinerData* combiner_data() { return &combiner_data_; }
 
-  /** Return pointer to grpc_closure_list */
+  /** Lanes that closures can be scheduled on. Flush() runs latency lane
+   *  closures first, but after kMaxLatencyBurst of them in a row it runs a
+   *  bulk lane closure, so that the bulk lane is never starved. Within a lane
+   *  closures run in FIFO order. */
+  enum class ClosureLane { kBulk, kLatency };
+  static constexpr int kMaxLatencyBurst = 16;
+
+  /** Return pointer to the bulk lane grpc_closure_list */
   grpc_closure_list* closure_list() { return &closure_list_; }
 
   /** Return flags */
@@ -153,7 +160,8 @@ class ExecCtx {
   /** Checks if there is work to be done */
   bool HasWork() {
     return combiner_data_.active_combiner != nullptr ||
-           !grpc_closure_list_empty(closure_list_);
+           !grpc_closure_list_empty(closure_list_) ||
+           !grpc_closure_list_empty(latency_closure_list_);
   }
 
   /** Flush any work that has been enqueued onto this grpc_exec_ctx.
@@ -221,9 +229,10 @@ class ExecCtx {
   }
 
   static void Run(const DebugLocation& location, grpc_closure* closure,
-                  grpc_error* error);
+                  grpc_error* error, ClosureLane lane = ClosureLane::kBulk);
 
-  static void RunList(const DebugLocation& location, grpc_closure_list* list);
+  static void RunList(const DebugLocation& location, grpc_closure_list* list,
+                      ClosureLane lane = ClosureLane::kBulk);
 
  protected:
   /** Check if ready to finish. */
@@ -233,9 +242,19 @@ class ExecCtx {
   static void operator delete(void* /* p */) { abort(); }
 
  private:
+  /** Runs queued closures, latency lane first. Returns false if there were
+   *  none. */
+  bool RunClosures();
+
+  grpc_closure_list* lane_list(ClosureLane lane) {
+    return lane == ClosureLane::kLatency ? &latency_closure_list_
+                                         : &closure_list_;
+  }
+
   /** Set exec_ctx_ to exec_ctx. */
 
   grpc_closure_list closure_list_ = GRPC_CLOSURE_LIST_INIT;
+  grpc_closure_list latency_closure_list_ = GRPC_CLOSURE_LIST_INIT;
   CombinerData combiner_data_ = {nullptr, nullptr};
   uintptr_t flags_;
 
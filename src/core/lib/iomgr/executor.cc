@@ -32,10 +32,21 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor/work_stealing.h"
 #include "src/core/lib/iomgr/iomgr.h"
 
 #define MAX_DEPTH 2
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_work_stealing, false,
+    "If set, executor threads steal closures from each other's queues rather "
+    "than each thread only running the closures queued to it.");
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_handshaker_threads, 0,
+    "Number of threads running offloaded security handshake steps. If not "
+    "positive, half the number of cores.");
+
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
     if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
@@ -77,25 +88,67 @@ void resolver_enqueue_long(grpc_closure* closure, grpc_error* error) {
       closure, error, false /* is_short */);
 }
 
+void handshaker_enqueue_short(grpc_closure* closure, grpc_error* error) {
+  executors[static_cast<size_t>(ExecutorType::HANDSHAKER)]->Enqueue(
+      closure, error, true /* is_short */);
+}
+
+void handshaker_enqueue_long(grpc_closure* closure, grpc_error* error) {
+  executors[static_cast<size_t>(ExecutorType::HANDSHAKER)]->Enqueue(
+      closure, error, false /* is_short */);
+}
+
+size_t handshaker_max_threads() {
+  int32_t threads = GPR_GLOBAL_CONFIG_GET(grpc_handshaker_threads);
+  if (threads > 0) return static_cast<size_t>(threads);
+  return GPR_MAX(1, gpr_cpu_num_cores() / 2);
+}
+
 using EnqueueFunc = void (*)(grpc_closure* closure, grpc_error* error);
 
 const EnqueueFunc
     executor_enqueue_fns_[static_cast<size_t>(ExecutorType::NUM_EXECUTORS)]
                          [static_cast<size_t>(ExecutorJobType::NUM_JOB_TYPES)] =
                              {{default_enqueue_short, default_enqueue_long},
-                              {resolver_enqueue_short, resolver_enqueue_long}};
+                              {resolver_enqueue_short, resolver_enqueue_long},
+                              {handshaker_enqueue_short,
+                               handshaker_enqueue_long}};
 
 }  // namespace
 
 TraceFlag executor_trace(false, "executor");
 
-Executor::Executor(const char* name) : name_(name) {
+Executor::Executor(const char* name)
+    : Executor(name, GPR_GLOBAL_CONFIG_GET(grpc_executor_work_stealing)) {}
+
+Executor::Executor(const char* name, bool work_stealing)
+    : Executor(name, work_stealing, GPR_MAX(1, 2 * gpr_cpu_num_cores())) {}
+
+Executor::Executor(const char* name, bool work_stealing, size_t max_threads)
+    : name_(name), work_stealing_(work_stealing) {
   adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
+  start_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
   gpr_atm_rel_store(&num_threads_, 0);
-  max_threads_ = GPR_MAX(1, 2 * gpr_cpu_num_cores());
+  gpr_atm_rel_store(&start_pending_, 0);
+  max_threads_ = GPR_MAX(1, max_threads);
 }
 
-void Executor::Init() { SetThreading(true); }
+void Executor::Init() {
+  EXECUTOR_TRACE("(%s) Init: threads start on first use", name_);
+  gpr_atm_rel_store(&start_pending_, 1);
+}
+
+void Executor::StartIfPending() {
+  if (gpr_atm_acq_load(&start_pending_) == 0) return;
+  gpr_spinlock_lock(&start_lock_);
+  if (gpr_atm_acq_load(&start_pending_) != 0) {
+    SetThreading(true);
+    // Only cleared once num_threads_ is set, so that no closure is run inline
+    // for lack of threads in between.
+    gpr_atm_rel_store(&start_pending_, 0);
+  }
+  gpr_spinlock_unlock(&start_lock_);
+}
 
 size_t Executor::RunClosures(const char* executor_name,
                              grpc_closure_list list) {
@@ -134,7 +187,8 @@ size_t Executor::RunClosures(const char* executor_name,
 }
 
 bool Executor::IsThreaded() const {
-  return gpr_atm_acq_load(&num_threads_) > 0;
+  return gpr_atm_acq_load(&num_threads_) > 0 ||
+         gpr_atm_acq_load(&start_pending_) != 0;
 }
 
 void Executor::SetThreading(bool threading) {
@@ -148,6 +202,13 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
+    if (work_stealing_) {
+      work_stealing_executor_ = new WorkStealingExecutor(name_, max_threads_);
+      work_stealing_executor_->Start();
+      gpr_atm_rel_store(&num_threads_, max_threads_);
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done", name_, threading);
+      return;
+    }
     gpr_atm_rel_store(&num_threads_, 1);
     thd_state_ = static_cast<ThreadState*>(
         gpr_zalloc(sizeof(ThreadState) * max_threads_));
@@ -165,11 +226,23 @@ void Executor::SetThreading(bool threading) {
         grpc_core::Thread(name_, &Executor::ThreadMain, &thd_state_[0]);
     thd_state_[0].thd.Start();
   } else {  // !threading
+    gpr_atm_rel_store(&start_pending_, 0);
     if (curr_num_threads == 0) {
       EXECUTOR_TRACE("(%s) SetThreading(false). curr_num_threads == 0", name_);
       return;
     }
 
+    if (work_stealing_executor_ != nullptr) {
+      grpc_closure_list leftover = work_stealing_executor_->Stop();
+      gpr_atm_rel_store(&num_threads_, 0);
+      delete work_stealing_executor_;
+      work_stealing_executor_ = nullptr;
+      RunClosures(name_, leftover);
+      grpc_iomgr_shutdown_background_closure();
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done", name_, threading);
+      return;
+    }
+
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_lock(&thd_state_[i].mu);
       thd_state_[i].shutdown = true;
@@ -260,6 +333,8 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
     GRPC_STATS_INC_EXECUTOR_SCHEDULED_LONG_ITEMS();
   }
 
+  StartIfPending();
+
   do {
     retry_push = false;
     size_t cur_thread_count =
@@ -283,6 +358,13 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
       return;
     }
 
+    if (work_stealing_executor_ != nullptr) {
+      // Long jobs need no special casing: the closures queued behind one are
+      // stolen by the other threads.
+      work_stealing_executor_->Enqueue(closure, error);
+      return;
+    }
+
     ThreadState* ts = (ThreadState*)gpr_tls_get(&g_this_thread_state);
     if (ts == nullptr) {
       ts = &thd_state_[GPR_HASH_POINTER(grpc_core::ExecCtx::Get(),
@@ -389,6 +471,8 @@ void Executor::InitAll() {
   if (executors[static_cast<size_t>(ExecutorType::DEFAULT)] != nullptr) {
     GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::RESOLVER)] !=
                nullptr);
+    GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::HANDSHAKER)] !=
+               nullptr);
     return;
   }
 
@@ -396,9 +480,14 @@ void Executor::InitAll() {
       new Executor("default-executor");
   executors[static_cast<size_t>(ExecutorType::RESOLVER)] =
       new Executor("resolver-executor");
+  executors[static_cast<size_t>(ExecutorType::HANDSHAKER)] =
+      new Executor("handshaker-executor",
+                   GPR_GLOBAL_CONFIG_GET(grpc_executor_work_stealing),
+                   handshaker_max_threads());
 
   executors[static_cast<size_t>(ExecutorType::DEFAULT)]->Init();
   executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Init();
+  executors[static_cast<size_t>(ExecutorType::HANDSHAKER)]->Init();
 
   EXECUTOR_TRACE0("Executor::InitAll() done");
 }
@@ -416,11 +505,14 @@ void Executor::ShutdownAll() {
   if (executors[static_cast<size_t>(ExecutorType::DEFAULT)] == nullptr) {
     GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::RESOLVER)] ==
                nullptr);
+    GPR_ASSERT(executors[static_cast<size_t>(ExecutorType::HANDSHAKER)] ==
+               nullptr);
     return;
   }
 
   executors[static_cast<size_t>(ExecutorType::DEFAULT)]->Shutdown();
   executors[static_cast<size_t>(ExecutorType::RESOLVER)]->Shutdown();
+  executors[static_cast<size_t>(ExecutorType::HANDSHAKER)]->Shutdown();
 
   // Delete the executor objects.
   //
@@ -436,8 +528,10 @@ void Executor::ShutdownAll() {
 
   delete executors[static_cast<size_t>(ExecutorType::DEFAULT)];
   delete executors[static_cast<size_t>(ExecutorType::RESOLVER)];
+  delete executors[static_cast<size_t>(ExecutorType::HANDSHAKER)];
   executors[static_cast<size_t>(ExecutorType::DEFAULT)] = nullptr;
   executors[static_cast<size_t>(ExecutorType::RESOLVER)] = nullptr;
+  executors[static_cast<size_t>(ExecutorType::HANDSHAKER)] = nullptr;
 
   EXECUTOR_TRACE0("Executor::ShutdownAll() done");
 }
@@ -447,6 +541,11 @@ bool Executor::IsThreaded(ExecutorType executor_type) {
   return executors[static_cast<size_t>(executor_type)]->IsThreaded();
 }
 
+size_t Executor::MaxThreads(ExecutorType executor_type) {
+  GPR_ASSERT(executor_type < ExecutorType::NUM_EXECUTORS);
+  return executors[static_cast<size_t>(executor_type)]->max_threads_;
+}
+
 bool Executor::IsThreadedDefault() {
   return Executor::IsThreaded(ExecutorType::DEFAULT);
 }
@@ -464,6 +563,9 @@ void Executor::SetThreadingDefault(bool enable) {
   executors[static_cast<size_t>(ExecutorType::DEFAULT)]->SetThreading(enable);
 }
 
-void grpc_executor_global_init() { gpr_tls_init(&g_this_thread_state); }
+void grpc_executor_global_init() {
+  gpr_tls_init(&g_this_thread_state);
+  WorkStealingExecutor::GlobalInit();
+}
 
 }  // namespace grpc_core
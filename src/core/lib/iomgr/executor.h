@@ -22,11 +22,17 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_executor_work_stealing);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_handshaker_threads);
+
 namespace grpc_core {
 
+class WorkStealingExecutor;
+
 struct ThreadState {
   gpr_mu mu;
   size_t id;         // For debugging purposes
@@ -42,6 +48,9 @@ struct ThreadState {
 enum class ExecutorType {
   DEFAULT = 0,
   RESOLVER,
+  // Runs the CPU-heavy steps of security handshakes, when they are offloaded
+  // (see GRPC_ARG_HANDSHAKER_OFFLOAD), on a bounded set of threads.
+  HANDSHAKER,
 
   NUM_EXECUTORS  // Add new values above this
 };
@@ -54,8 +63,18 @@ enum class ExecutorJobType {
 
 class Executor {
  public:
+  // Uses work stealing if the grpc_executor_work_stealing config is set.
   Executor(const char* executor_name);
-
+  // If work_stealing is true, the executor runs a fixed set of threads that
+  // steal closures from each other's queues (see WorkStealingExecutor) instead
+  // of the per-thread lists below.
+  Executor(const char* executor_name, bool work_stealing);
+  // Runs at most max_threads threads instead of twice the number of cores.
+  Executor(const char* executor_name, bool work_stealing, size_t max_threads);
+
+  /* Makes the executor threaded. Its threads are started by the first
+   * Enqueue(), so that grpc_init() does not pay for executors a process never
+   * uses. */
   void Init();
 
   /** Is the executor multi-threaded? */
@@ -100,6 +119,9 @@ class Executor {
   // SetThreading(true) was called previously on that executor)
   static bool IsThreaded(ExecutorType executor_type);
 
+  // Return the maximum number of threads of a given executor
+  static size_t MaxThreads(ExecutorType executor_type);
+
   // Return if the DEFAULT executor is threaded
   static bool IsThreadedDefault();
 
@@ -107,11 +129,20 @@ class Executor {
   static size_t RunClosures(const char* executor_name, grpc_closure_list list);
   static void ThreadMain(void* arg);
 
+  // Starts the threads if Init() left that to the first Enqueue().
+  void StartIfPending();
+
   const char* name_;
+  const bool work_stealing_;
+  WorkStealingExecutor* work_stealing_executor_ = nullptr;
   ThreadState* thd_state_;
   size_t max_threads_;
   gpr_atm num_threads_;
   gpr_spinlock adding_thread_lock_;
+  // Set from Init() until the threads are started (or threading is turned
+  // off); start_lock_ serializes the enqueuers that find it set.
+  gpr_atm start_pending_;
+  gpr_spinlock start_lock_;
 };
 
 // Global initializer for executor
@@ -20,6 +20,10 @@
 
 #include "src/core/lib/iomgr/executor/mpmcqueue.h"
 
+#include <new>
+
+#include <grpc/support/alloc.h>
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_thread_pool_trace(false, "thread_pool");
@@ -180,4 +184,149 @@ void InfLenFIFOQueue::RemoveWaiter(Waiter* waiter) {
 
 InfLenFIFOQueue::Waiter* InfLenFIFOQueue::TopWaiter() { return waiters_.next; }
 
+static size_t RoundUpToPowerOfTwo(size_t n) {
+  size_t result = 2;
+  while (result < n) result <<= 1;
+  return result;
+}
+
+BoundedFIFOQueue::BoundedFIFOQueue(size_t capacity, int spin_count)
+    : mask_(RoundUpToPowerOfTwo(capacity) - 1),
+      spin_count_(spin_count),
+      buffer_(static_cast<Cell*>(gpr_malloc(sizeof(Cell) * (mask_ + 1)))) {
+  for (size_t i = 0; i <= mask_; ++i) {
+    new (&buffer_[i].sequence) Atomic<size_t>(i);
+    buffer_[i].data = nullptr;
+  }
+}
+
+BoundedFIFOQueue::~BoundedFIFOQueue() {
+  GPR_ASSERT(count() == 0);
+  GPR_ASSERT(num_waiting_consumers_.Load(MemoryOrder::RELAXED) == 0);
+  GPR_ASSERT(num_waiting_producers_.Load(MemoryOrder::RELAXED) == 0);
+  for (size_t i = 0; i <= mask_; ++i) {
+    buffer_[i].sequence.~Atomic<size_t>();
+  }
+  gpr_free(buffer_);
+}
+
+bool BoundedFIFOQueue::TryPut(void* elem) {
+  Cell* cell;
+  size_t pos = enqueue_pos_.Load(MemoryOrder::RELAXED);
+  for (;;) {
+    cell = &buffer_[pos & mask_];
+    size_t seq = cell->sequence.Load(MemoryOrder::ACQUIRE);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      // The cell is free in this lap: claim it.
+      if (enqueue_pos_.CompareExchangeWeak(&pos, pos + 1, MemoryOrder::RELAXED,
+                                           MemoryOrder::RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // The cell still holds the element from the previous lap: full.
+      return false;
+    } else {
+      pos = enqueue_pos_.Load(MemoryOrder::RELAXED);
+    }
+  }
+  cell->data = elem;
+  cell->sequence.Store(pos + 1, MemoryOrder::RELEASE);
+  return true;
+}
+
+bool BoundedFIFOQueue::TryGet(void** elem) {
+  Cell* cell;
+  size_t pos = dequeue_pos_.Load(MemoryOrder::RELAXED);
+  for (;;) {
+    cell = &buffer_[pos & mask_];
+    size_t seq = cell->sequence.Load(MemoryOrder::ACQUIRE);
+    intptr_t diff =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos_.CompareExchangeWeak(&pos, pos + 1, MemoryOrder::RELAXED,
+                                           MemoryOrder::RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // Nothing has been put in this cell in this lap yet: empty.
+      return false;
+    } else {
+      pos = dequeue_pos_.Load(MemoryOrder::RELAXED);
+    }
+  }
+  *elem = cell->data;
+  // Frees the cell for the producer of the next lap.
+  cell->sequence.Store(pos + mask_ + 1, MemoryOrder::RELEASE);
+  return true;
+}
+
+// The fences in Put/Get and WakeConsumer/WakeProducer pair up: either the
+// parking thread sees the element (or the free cell) on its retry, or the
+// other side sees the waiting count and signals it under mu_.
+void BoundedFIFOQueue::WakeConsumer() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_waiting_consumers_.Load(MemoryOrder::RELAXED) > 0) {
+    MutexLock l(&mu_);
+    not_empty_.Signal();
+  }
+}
+
+void BoundedFIFOQueue::WakeProducer() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_waiting_producers_.Load(MemoryOrder::RELAXED) > 0) {
+    MutexLock l(&mu_);
+    not_full_.Signal();
+  }
+}
+
+void BoundedFIFOQueue::Put(void* elem) {
+  if (!TryPut(elem)) {
+    MutexLock l(&mu_);
+    num_waiting_producers_.FetchAdd(1, MemoryOrder::RELAXED);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!TryPut(elem)) {
+      not_full_.Wait(&mu_);
+    }
+    num_waiting_producers_.FetchSub(1, MemoryOrder::RELAXED);
+  }
+  WakeConsumer();
+}
+
+void* BoundedFIFOQueue::Get(gpr_timespec* wait_time) {
+  void* elem;
+  for (int i = 0; i < spin_count_; ++i) {
+    if (TryGet(&elem)) {
+      WakeProducer();
+      return elem;
+    }
+  }
+  if (!TryGet(&elem)) {
+    gpr_timespec start_time;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) &&
+        wait_time != nullptr) {
+      start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
+    MutexLock l(&mu_);
+    num_waiting_consumers_.FetchAdd(1, MemoryOrder::RELAXED);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!TryGet(&elem)) {
+      not_empty_.Wait(&mu_);
+    }
+    num_waiting_consumers_.FetchSub(1, MemoryOrder::RELAXED);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) &&
+        wait_time != nullptr) {
+      *wait_time = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time);
+    }
+  }
+  WakeProducer();
+  return elem;
+}
+
+int BoundedFIFOQueue::count() const {
+  size_t head = dequeue_pos_.Load(MemoryOrder::RELAXED);
+  size_t tail = enqueue_pos_.Load(MemoryOrder::RELAXED);
+  return tail > head ? static_cast<int>(tail - head) : 0;
+}
+
 }  // namespace grpc_core
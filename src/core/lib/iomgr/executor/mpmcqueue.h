@@ -170,6 +170,73 @@ class InfLenFIFOQueue : public MPMCQueueInterface {
   Node* AllocateNodes(int num);
 };
 
+// A lock-free bounded MPMC queue (Dmitry Vyukov's ring buffer design). Each
+// cell of the ring carries a sequence number that tells producers and
+// consumers whether it is free for the current lap, so Put and Get only
+// contend on a single compare-and-swap of the tail or head position. Blocking
+// on a full or empty queue is done outside the fast path: producers and
+// consumers park on condition variables that are only signalled when somebody
+// is known to be parked.
+class BoundedFIFOQueue : public MPMCQueueInterface {
+ public:
+  // Creates a queue that holds at least \a capacity elements (it is rounded up
+  // to a power of two). If \a spin_count is non-zero, a consumer facing an
+  // empty queue retries that many times before parking, which keeps bursty
+  // workloads off the condition variable.
+  explicit BoundedFIFOQueue(size_t capacity, int spin_count = 0);
+
+  // Releases all resources held by the queue. The queue must be empty, and no
+  // one may be waiting on it.
+  ~BoundedFIFOQueue();
+
+  // Puts elem at the end of the queue, blocking while the queue is full.
+  void Put(void* elem);
+
+  // Removes the oldest element from the queue and returns it, blocking while
+  // the queue is empty. wait_time is only filled in when the thread_pool trace
+  // flag is on and the call had to park.
+  void* Get(gpr_timespec* wait_time = nullptr);
+
+  // Non-blocking versions of Put and Get. They return false if the queue is
+  // full or empty, respectively.
+  bool TryPut(void* elem);
+  bool TryGet(void** elem);
+
+  // Returns number of elements in queue currently. This is only a snapshot
+  // while there are concurrent Puts and Gets.
+  int count() const;
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Cell {
+    Atomic<size_t> sequence;
+    void* data;
+  };
+
+  // Wakes up a parked consumer or producer, if there is one.
+  void WakeConsumer();
+  void WakeProducer();
+
+  const size_t mask_;
+  const int spin_count_;
+  Cell* const buffer_;
+
+  // The head and tail positions live on separate cache lines, so that
+  // producers and consumers do not false share.
+  char pad0_[GPR_CACHELINE_SIZE];
+  Atomic<size_t> enqueue_pos_{0};
+  char pad1_[GPR_CACHELINE_SIZE];
+  Atomic<size_t> dequeue_pos_{0};
+  char pad2_[GPR_CACHELINE_SIZE];
+
+  Mutex mu_;
+  CondVar not_empty_;
+  CondVar not_full_;
+  Atomic<int> num_waiting_consumers_{0};
+  Atomic<int> num_waiting_producers_{0};
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_MPMCQUEUE_H */
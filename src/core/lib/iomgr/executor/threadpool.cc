@@ -54,7 +54,7 @@ void ThreadPool::SharedThreadPoolConstructor() {
   // Create at least 1 worker thread.
   if (num_threads_ <= 0) num_threads_ = 1;
 
-  queue_ = new InfLenFIFOQueue();
+  if (queue_ == nullptr) queue_ = new InfLenFIFOQueue();
   threads_ = static_cast<ThreadPoolWorker**>(
       gpr_zalloc(num_threads_ * sizeof(ThreadPoolWorker*)));
   for (int i = 0; i < num_threads_; ++i) {
@@ -101,6 +101,19 @@ ThreadPool::ThreadPool(int num_threads, const char* thd_name,
   SharedThreadPoolConstructor();
 }
 
+ThreadPool::ThreadPool(int num_threads, const char* thd_name,
+                       const Thread::Options& thread_options,
+                       MPMCQueueInterface* queue)
+    : num_threads_(num_threads),
+      thd_name_(thd_name),
+      thread_options_(thread_options),
+      queue_(queue) {
+  if (thread_options_.stack_size() == 0) {
+    thread_options_.set_stack_size(DefaultStackSize());
+  }
+  SharedThreadPoolConstructor();
+}
+
 ThreadPool::~ThreadPool() {
   // For debug checking purpose, using RELAXED order is sufficient.
   shut_down_.Store(true, MemoryOrder::RELAXED);
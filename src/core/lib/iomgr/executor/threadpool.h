@@ -115,11 +115,18 @@ class ThreadPool : public ThreadPoolInterface {
   ThreadPool(int num_threads, const char* thd_name,
              const Thread::Options& thread_options);
 
+  // Same as ThreadPool(int num_threads, const char* thd_name,
+  // const Thread::Options& thread_options), except that closures are queued
+  // in "queue" (e.g. a BoundedFIFOQueue) instead of an InfLenFIFOQueue. The
+  // thread pool takes ownership of the queue.
+  ThreadPool(int num_threads, const char* thd_name,
+             const Thread::Options& thread_options, MPMCQueueInterface* queue);
+
   // Waits for all pending closures to complete, then shuts down thread pool.
   ~ThreadPool() override;
 
-  // Adds given closure into pending queue immediately. Since closure queue has
-  // infinite length, this routine will not block.
+  // Adds given closure into pending queue immediately. With the default
+  // closure queue, which has infinite length, this routine will not block.
   void Add(grpc_experimental_completion_queue_functor* closure) override;
 
   int num_pending_closures() const override;
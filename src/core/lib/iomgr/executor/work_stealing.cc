@@ -0,0 +1,234 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/executor/work_stealing.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+#define WS_EXECUTOR_TRACE(format, ...)                    \
+  do {                                                    \
+    if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
+      gpr_log(GPR_INFO, "EXECUTOR " format, __VA_ARGS__); \
+    }                                                     \
+  } while (0)
+
+namespace grpc_core {
+
+extern TraceFlag executor_trace;
+
+namespace {
+
+GPR_TLS_DECL(g_this_worker);
+
+grpc_closure* closure_list_pop(grpc_closure_list* list) {
+  grpc_closure* closure = list->head;
+  if (closure != nullptr) {
+    list->head = closure->next_data.next;
+    if (list->head == nullptr) list->tail = nullptr;
+  }
+  return closure;
+}
+
+}  // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(const char* name,
+                                           size_t num_threads)
+    : name_(name), num_workers_(GPR_MAX(1, num_threads)) {
+  gpr_mu_init(&park_mu_);
+  gpr_cv_init(&park_cv_);
+  workers_ = static_cast<Worker*>(gpr_zalloc(sizeof(Worker) * num_workers_));
+  for (size_t i = 0; i < num_workers_; i++) {
+    Worker* worker = &workers_[i];
+    worker->executor = this;
+    worker->index = i;
+    // Any non-zero seed will do for xorshift
+    worker->rand_state = static_cast<uint32_t>(i) * 2654435761u + 1;
+    gpr_mu_init(&worker->mu);
+    worker->elems = GRPC_CLOSURE_LIST_INIT;
+    worker->thd = Thread();
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  for (size_t i = 0; i < num_workers_; i++) {
+    GPR_ASSERT(grpc_closure_list_empty(workers_[i].elems));
+    gpr_mu_destroy(&workers_[i].mu);
+  }
+  gpr_free(workers_);
+  gpr_mu_destroy(&park_mu_);
+  gpr_cv_destroy(&park_cv_);
+}
+
+void WorkStealingExecutor::GlobalInit() { gpr_tls_init(&g_this_worker); }
+
+void WorkStealingExecutor::Start() {
+  for (size_t i = 0; i < num_workers_; i++) {
+    workers_[i].thd =
+        Thread(name_, &WorkStealingExecutor::ThreadMain, &workers_[i]);
+    workers_[i].thd.Start();
+  }
+}
+
+grpc_closure_list WorkStealingExecutor::Stop() {
+  gpr_mu_lock(&park_mu_);
+  shutdown_.Store(true, MemoryOrder::RELAXED);
+  gpr_cv_broadcast(&park_cv_);
+  gpr_mu_unlock(&park_mu_);
+  grpc_closure_list leftover = GRPC_CLOSURE_LIST_INIT;
+  for (size_t i = 0; i < num_workers_; i++) {
+    workers_[i].thd.Join();
+    WS_EXECUTOR_TRACE("(%s) Thread %" PRIdPTR " of %" PRIdPTR " joined", name_,
+                      i + 1, num_workers_);
+  }
+  for (size_t i = 0; i < num_workers_; i++) {
+    grpc_closure_list_move(&workers_[i].elems, &leftover);
+  }
+  num_pending_.Store(0, MemoryOrder::RELAXED);
+  return leftover;
+}
+
+void WorkStealingExecutor::Enqueue(grpc_closure* closure, grpc_error* error) {
+  Worker* worker = reinterpret_cast<Worker*>(gpr_tls_get(&g_this_worker));
+  if (worker != nullptr && worker->executor == this) {
+    GRPC_STATS_INC_EXECUTOR_SCHEDULED_TO_SELF();
+  } else {
+    worker = &workers_[next_worker_.FetchAdd(1, MemoryOrder::RELAXED) %
+                       num_workers_];
+  }
+#ifndef NDEBUG
+  WS_EXECUTOR_TRACE("(%s) schedule %p (created %s:%d) to thread %" PRIdPTR,
+                    name_, closure, closure->file_created,
+                    closure->line_created, worker->index);
+#else
+  WS_EXECUTOR_TRACE("(%s) schedule %p to thread %" PRIdPTR, name_, closure,
+                    worker->index);
+#endif
+  gpr_mu_lock(&worker->mu);
+  grpc_closure_list_append(&worker->elems, closure, error);
+  gpr_mu_unlock(&worker->mu);
+  // Pairs with Park(): either the parking worker sees the new closure, or we
+  // see it parked and wake it up.
+  num_pending_.FetchAdd(1, MemoryOrder::SEQ_CST);
+  if (num_parked_.Load(MemoryOrder::SEQ_CST) > 0) {
+    GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED();
+    gpr_mu_lock(&park_mu_);
+    gpr_cv_signal(&park_cv_);
+    gpr_mu_unlock(&park_mu_);
+  }
+}
+
+grpc_closure* WorkStealingExecutor::Next(Worker* worker) {
+  gpr_mu_lock(&worker->mu);
+  grpc_closure* closure = closure_list_pop(&worker->elems);
+  gpr_mu_unlock(&worker->mu);
+  if (closure == nullptr) {
+    closure = Steal(worker);
+  }
+  if (closure != nullptr) {
+    num_pending_.FetchSub(1, MemoryOrder::RELAXED);
+  }
+  return closure;
+}
+
+grpc_closure* WorkStealingExecutor::Steal(Worker* thief) {
+  if (num_workers_ == 1 || num_pending_.Load(MemoryOrder::RELAXED) <= 0) {
+    return nullptr;
+  }
+  // xorshift32
+  uint32_t x = thief->rand_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  thief->rand_state = x;
+  const size_t start = x % num_workers_;
+  for (size_t i = 0; i < num_workers_; i++) {
+    Worker* victim = &workers_[(start + i) % num_workers_];
+    if (victim == thief) continue;
+    gpr_mu_lock(&victim->mu);
+    grpc_closure* closure = closure_list_pop(&victim->elems);
+    gpr_mu_unlock(&victim->mu);
+    if (closure != nullptr) {
+      GRPC_STATS_INC_EXECUTOR_STOLEN_ITEMS();
+      WS_EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: stole %p from %" PRIdPTR, name_,
+                        thief->index, closure, victim->index);
+      return closure;
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingExecutor::Park(Worker* worker) {
+  gpr_mu_lock(&park_mu_);
+  num_parked_.FetchAdd(1, MemoryOrder::SEQ_CST);
+  while (num_pending_.Load(MemoryOrder::SEQ_CST) <= 0 &&
+         !shutdown_.Load(MemoryOrder::RELAXED)) {
+    WS_EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: park", name_, worker->index);
+    gpr_cv_wait(&park_cv_, &park_mu_, gpr_inf_future(GPR_CLOCK_MONOTONIC));
+  }
+  num_parked_.FetchSub(1, MemoryOrder::RELAXED);
+  const bool shutdown = shutdown_.Load(MemoryOrder::RELAXED);
+  gpr_mu_unlock(&park_mu_);
+  return !shutdown;
+}
+
+void WorkStealingExecutor::ThreadMain(void* arg) {
+  Worker* worker = static_cast<Worker*>(arg);
+  WorkStealingExecutor* executor = worker->executor;
+  gpr_tls_set(&g_this_worker, reinterpret_cast<intptr_t>(worker));
+
+  ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+
+  do {
+    // As in Executor::RunClosures(), callbacks scheduled by the closures run
+    // when this ApplicationCallbackExecCtx goes out of scope.
+    ApplicationCallbackExecCtx callback_exec_ctx(
+        GRPC_APP_CALLBACK_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+    ExecCtx::Get()->InvalidateNow();
+    grpc_closure* c;
+    while (!executor->shutdown_.Load(MemoryOrder::RELAXED) &&
+           (c = executor->Next(worker)) != nullptr) {
+      grpc_error* error = c->error_data.error;
+#ifndef NDEBUG
+      WS_EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: run %p [created by %s:%d]",
+                        executor->name_, worker->index, c, c->file_created,
+                        c->line_created);
+      c->scheduled = false;
+#else
+      WS_EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: run %p", executor->name_,
+                        worker->index, c);
+#endif
+      c->cb(c->cb_arg, error);
+      GRPC_ERROR_UNREF(error);
+      ExecCtx::Get()->Flush();
+    }
+    GRPC_STATS_INC_EXECUTOR_QUEUE_DRAINED();
+  } while (executor->Park(worker));
+
+  gpr_tls_set(&g_this_worker, reinterpret_cast<intptr_t>(nullptr));
+}
+
+}  // namespace grpc_core
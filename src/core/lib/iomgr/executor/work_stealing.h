@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_H
+#define GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/closure.h"
+
+namespace grpc_core {
+
+// A fixed set of worker threads, each owning a queue of closures. Closures
+// enqueued from one of the workers go to that worker's own queue; the others
+// are spread over the workers round-robin. A worker that runs out of work
+// steals from the other queues, starting at a random victim, and only parks
+// once there is nothing left to steal. A long job therefore only holds up the
+// worker running it: the rest of its queue is picked up by the other workers.
+class WorkStealingExecutor {
+ public:
+  WorkStealingExecutor(const char* name, size_t num_threads);
+  // Stop() must have been called.
+  ~WorkStealingExecutor();
+
+  // Starts all the worker threads.
+  void Start();
+
+  // Joins all the worker threads and returns the closures that they did not
+  // get to run. No closure may be enqueued once this is called.
+  grpc_closure_list Stop();
+
+  void Enqueue(grpc_closure* closure, grpc_error* error);
+
+  // Must be called once before any WorkStealingExecutor is started.
+  static void GlobalInit();
+
+ private:
+  struct Worker {
+    WorkStealingExecutor* executor;
+    size_t index;
+    uint32_t rand_state;  // Used to pick steal victims
+    gpr_mu mu;
+    grpc_closure_list elems;
+    Thread thd;
+  };
+
+  static void ThreadMain(void* arg);
+
+  // Returns the next closure for \a worker to run: from its own queue first,
+  // then stolen from another worker. Returns nullptr if there is none.
+  grpc_closure* Next(Worker* worker);
+  grpc_closure* Steal(Worker* thief);
+  // Parks \a worker until there may be work. Returns false on shutdown.
+  bool Park(Worker* worker);
+
+  const char* name_;
+  const size_t num_workers_;
+  Worker* workers_;
+
+  Atomic<size_t> next_worker_{0};
+  // Number of closures in all the worker queues. It is only updated after the
+  // queue itself, so it can briefly go negative.
+  Atomic<intptr_t> num_pending_{0};
+  Atomic<size_t> num_parked_{0};
+  Atomic<bool> shutdown_{false};
+
+  gpr_mu park_mu_;
+  gpr_cv park_cv_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_H */
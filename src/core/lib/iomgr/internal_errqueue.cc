@@ -32,9 +32,12 @@
 
 namespace grpc_core {
 static bool errqueue_supported = false;
+static bool zerocopy_supported = false;
 
 bool kernel_supports_errqueue() { return errqueue_supported; }
 
+bool kernel_supports_zerocopy() { return zerocopy_supported; }
+
 void grpc_errqueue_init() {
 /* Both-compile time and run-time linux kernel versions should be at least 4.0.0
  */
@@ -49,11 +52,21 @@ void grpc_errqueue_init() {
     return;
   }
 
-  if (strtol(release, nullptr, 10) >= 4) {
+  char* minor = nullptr;
+  long major_version = strtol(release, &minor, 10);
+  long minor_version = (minor != nullptr && *minor == '.')
+                           ? strtol(minor + 1, nullptr, 10)
+                           : 0;
+  if (major_version >= 4) {
     errqueue_supported = true;
   } else {
     gpr_log(GPR_DEBUG, "ERRQUEUE support not enabled");
   }
+  if (major_version > 4 || (major_version == 4 && minor_version >= 14)) {
+    zerocopy_supported = true;
+  } else {
+    gpr_log(GPR_DEBUG, "MSG_ZEROCOPY support not enabled");
+  }
 #endif /* GRPC_LINUX_ERRQUEUE */
 }
 } /* namespace grpc_core */
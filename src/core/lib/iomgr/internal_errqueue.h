@@ -172,6 +172,21 @@ struct tcp_info {
 #ifndef TCP_INFO
 #define TCP_INFO 11
 #endif
+
+/* Definitions for MSG_ZEROCOPY sends, in case the system headers predate
+ * Linux 4.14. */
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
 #endif /* GRPC_LINUX_ERRQUEUE */
 
 /* Returns true if kernel is capable of supporting errqueue and timestamping.
@@ -179,6 +194,11 @@ struct tcp_info {
  */
 bool kernel_supports_errqueue();
 
+/* Return true if kernel supports MSG_ZEROCOPY sends on TCP sockets.
+ * Currently allowing only linux kernels 4.14 and above.
+ */
+bool kernel_supports_zerocopy();
+
 } /* namespace grpc_core */
 
 #endif /* GRPC_POSIX_SOCKET_TCP */
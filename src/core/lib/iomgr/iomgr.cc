@@ -34,6 +34,7 @@
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/internal_errqueue.h"
@@ -64,6 +65,7 @@ void grpc_iomgr_init() {
   grpc_timer_list_init();
   grpc_core::grpc_errqueue_init();
   g_grpc_abort_on_leaks = GPR_GLOBAL_CONFIG_GET(grpc_abort_on_leaks);
+  grpc_combiner_global_init();
 }
 
 void grpc_iomgr_start() { grpc_timer_manager_init(); }
@@ -169,7 +169,7 @@ static grpc_error* pollset_work(grpc_pollset* pollset,
     pollset->kicked_without_pollers = 0;
   }
 done:
-  if (!grpc_closure_list_empty(*grpc_core::ExecCtx::Get()->closure_list())) {
+  if (grpc_core::ExecCtx::Get()->HasWork()) {
     gpr_mu_unlock(&grpc_polling_mu);
     grpc_core::ExecCtx::Get()->Flush();
     gpr_mu_lock(&grpc_polling_mu);
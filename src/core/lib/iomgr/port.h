@@ -90,6 +90,10 @@
 #if __GLIBC_PREREQ(2, 10)
 #define GRPC_LINUX_SOCKETUTILS 1
 #endif
+/* recvmmsg() was added in glibc 2.12, sendmmsg() in 2.14. */
+#if __GLIBC_PREREQ(2, 14)
+#define GRPC_LINUX_MMSG 1
+#endif
 #endif
 #ifdef LINUX_VERSION_CODE
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 37)
@@ -104,11 +108,15 @@
 #endif /* __GLIBC_PREREQ(2, 17) */
 #endif /* ifdef __GLIBC_PREREQ */
 #endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 37) */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 11, 0)
+#define GRPC_HAVE_TCP_FASTOPEN_CONNECT
+#endif
 #endif /* LINUX_VERSION_CODE */
 #ifndef __GLIBC__
 #define GRPC_LINUX_EPOLL 1
 #define GRPC_LINUX_EPOLL_CREATE1 1
 #define GRPC_LINUX_EVENTFD 1
+#define GRPC_LINUX_MMSG 1
 #define GRPC_MSG_IOVLEN_TYPE int
 #endif
 #ifndef GRPC_LINUX_EVENTFD
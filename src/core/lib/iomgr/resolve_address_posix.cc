@@ -31,8 +31,10 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/host_port.h"
@@ -139,38 +141,108 @@ done:
   return err;
 }
 
-typedef struct {
-  char* name;
-  char* default_port;
+/* A request waiting on a lookup */
+typedef struct waiter {
   grpc_closure* on_done;
   grpc_resolved_addresses** addrs_out;
-  grpc_closure request_closure;
-  void* arg;
-} request;
+  struct waiter* next;
+} waiter;
+
+/* A blocking lookup on the resolver executor. Requests for the same name that
+   arrive while it is in progress wait on it instead of tying up another
+   executor thread with the same lookup. */
+typedef struct lookup {
+  char* name;
+  char* default_port;
+  grpc_closure closure;
+  /* guarded by g_lookups_mu */
+  waiter* waiters;
+  struct lookup* next;
+} lookup;
+
+static gpr_once g_lookups_once = GPR_ONCE_INIT;
+static gpr_mu g_lookups_mu;
+/* The lookups in progress, guarded by g_lookups_mu */
+static lookup* g_lookups;
+
+static void init_lookups_mu() { gpr_mu_init(&g_lookups_mu); }
+
+static bool strings_equal(const char* a, const char* b) {
+  return a == nullptr ? b == nullptr : b != nullptr && strcmp(a, b) == 0;
+}
+
+static grpc_resolved_addresses* copy_addresses(
+    const grpc_resolved_addresses* addresses) {
+  grpc_resolved_addresses* copy = static_cast<grpc_resolved_addresses*>(
+      gpr_malloc(sizeof(grpc_resolved_addresses)));
+  copy->naddrs = addresses->naddrs;
+  copy->addrs = static_cast<grpc_resolved_address*>(
+      gpr_malloc(sizeof(grpc_resolved_address) * addresses->naddrs));
+  memcpy(copy->addrs, addresses->addrs,
+         sizeof(grpc_resolved_address) * addresses->naddrs);
+  return copy;
+}
 
 /* Callback to be passed to grpc Executor to asynch-ify
  * grpc_blocking_resolve_address */
-static void do_request_thread(void* rp, grpc_error* /*error*/) {
-  request* r = static_cast<request*>(rp);
-  grpc_core::ExecCtx::Run(
-      DEBUG_LOCATION, r->on_done,
-      grpc_blocking_resolve_address(r->name, r->default_port, r->addrs_out));
-  gpr_free(r->name);
-  gpr_free(r->default_port);
-  gpr_free(r);
+static void do_request_thread(void* lp, grpc_error* /*error*/) {
+  lookup* l = static_cast<lookup*>(lp);
+  grpc_resolved_addresses* addresses = nullptr;
+  const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_error* error =
+      grpc_blocking_resolve_address(l->name, l->default_port, &addresses);
+  GRPC_STATS_INC_NATIVE_DNS_RESOLVE_US(gpr_timespec_to_micros(
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)));
+  gpr_mu_lock(&g_lookups_mu);
+  lookup** prev = &g_lookups;
+  while (*prev != l) prev = &(*prev)->next;
+  *prev = l->next;
+  waiter* w = l->waiters;
+  gpr_mu_unlock(&g_lookups_mu);
+  while (w != nullptr) {
+    waiter* next = w->next;
+    if (addresses != nullptr) {
+      *w->addrs_out = next == nullptr ? addresses : copy_addresses(addresses);
+    }
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, w->on_done, GRPC_ERROR_REF(error));
+    gpr_free(w);
+    w = next;
+  }
+  GRPC_ERROR_UNREF(error);
+  gpr_free(l->name);
+  gpr_free(l->default_port);
+  gpr_free(l);
 }
 
 static void posix_resolve_address(const char* name, const char* default_port,
                                   grpc_pollset_set* /*interested_parties*/,
                                   grpc_closure* on_done,
                                   grpc_resolved_addresses** addrs) {
-  request* r = static_cast<request*>(gpr_malloc(sizeof(request)));
-  GRPC_CLOSURE_INIT(&r->request_closure, do_request_thread, r, nullptr);
-  r->name = gpr_strdup(name);
-  r->default_port = gpr_strdup(default_port);
-  r->on_done = on_done;
-  r->addrs_out = addrs;
-  grpc_core::Executor::Run(&r->request_closure, GRPC_ERROR_NONE,
+  waiter* w = static_cast<waiter*>(gpr_malloc(sizeof(waiter)));
+  w->on_done = on_done;
+  w->addrs_out = addrs;
+  gpr_once_init(&g_lookups_once, init_lookups_mu);
+  gpr_mu_lock(&g_lookups_mu);
+  for (lookup* l = g_lookups; l != nullptr; l = l->next) {
+    if (strcmp(l->name, name) == 0 &&
+        strings_equal(l->default_port, default_port)) {
+      w->next = l->waiters;
+      l->waiters = w;
+      gpr_mu_unlock(&g_lookups_mu);
+      GRPC_STATS_INC_NATIVE_DNS_REQUESTS_COALESCED();
+      return;
+    }
+  }
+  lookup* l = static_cast<lookup*>(gpr_malloc(sizeof(lookup)));
+  GRPC_CLOSURE_INIT(&l->closure, do_request_thread, l, nullptr);
+  l->name = gpr_strdup(name);
+  l->default_port = gpr_strdup(default_port);
+  w->next = nullptr;
+  l->waiters = w;
+  l->next = g_lookups;
+  g_lookups = l;
+  gpr_mu_unlock(&g_lookups_mu);
+  grpc_core::Executor::Run(&l->closure, GRPC_ERROR_NONE,
                            grpc_core::ExecutorType::RESOLVER);
 }
 
@@ -27,17 +27,29 @@
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/slice/slice_internal.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_resource_quota_per_cpu_shards, false,
+    "If set, resource quotas cache free memory per cpu so that most "
+    "allocations and frees do not go through the quota's combiner.");
+
 grpc_core::TraceFlag grpc_resource_quota_trace(false, "resource_quota");
 
 #define MEMORY_USAGE_ESTIMATION_MAX 65536
 
+/* Upper bound on the number of per-cpu free pool shards of a quota */
+#define RQ_MAX_SHARDS 32
+/* Upper bound on the bytes a shard takes from the quota's free pool at once */
+#define RQ_MAX_SHARD_REFILL (256 * 1024)
+
 /* Internal linked list pointers for a resource user */
 typedef struct {
   grpc_resource_user* next;
@@ -60,6 +72,17 @@ typedef enum {
   GRPC_RULIST_COUNT
 } grpc_rulist;
 
+/* A per-cpu cache of the quota's free memory. Resource users allocate from
+   and free into the shard of the cpu they run on, which refills from (and
+   spills into) the quota's free pool in large chunks, so that the quota's
+   combiner is only involved once allocations have to wait. Memory held by a
+   shard counts as used, like memory in a resource user's free pool, and is
+   returned to the quota before any reclamation. */
+typedef struct {
+  gpr_mu mu;
+  int64_t free_pool;
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE) rq_shard;
+
 struct grpc_resource_user {
   /* The quota this resource user consumes from */
   grpc_resource_quota* resource_quota;
@@ -131,12 +154,26 @@ struct grpc_resource_quota {
   gpr_atm memory_usage_estimation;
 
   /* Master combiner lock: all activity on a quota executes under this combiner
-   * (so no mutex is needed for this data structure) */
+   * (so no mutex is needed for this data structure), except for the fields
+   * guarded by free_pool_mu */
   grpc_core::Combiner* combiner;
+  /* Protects size and free_pool, which shards refill from outside of the
+   * combiner */
+  gpr_mu free_pool_mu;
   /* Size of the resource quota */
   int64_t size;
   /* Amount of free memory in the resource quota */
   int64_t free_pool;
+  /* Per-cpu caches of free memory */
+  rq_shard* shards;
+  size_t num_shards;
+  /* Bytes a shard takes from free_pool when it runs dry; it spills back down
+   * to this when it holds twice as much. Written under free_pool_mu. */
+  gpr_atm shard_refill_size;
+  /* Number of resource users in the GRPC_RULIST_AWAITING_ALLOCATION list.
+   * While non-zero, shards neither serve nor take memory so that the waiting
+   * users are served first. */
+  gpr_atm num_awaiting;
   /* Used size of memory in the resource quota. Updated as soon as the resource
    * users start to allocate or free the memory. */
   gpr_atm used;
@@ -191,10 +228,18 @@ static void ru_unref_by(grpc_resource_user* resource_user, gpr_atm amount);
  * list management
  */
 
+static void rulist_count(grpc_resource_quota* resource_quota, grpc_rulist list,
+                         gpr_atm delta) {
+  if (list == GRPC_RULIST_AWAITING_ALLOCATION) {
+    gpr_atm_full_fetch_add(&resource_quota->num_awaiting, delta);
+  }
+}
+
 static void rulist_add_head(grpc_resource_user* resource_user,
                             grpc_rulist list) {
   grpc_resource_quota* resource_quota = resource_user->resource_quota;
   grpc_resource_user** root = &resource_quota->roots[list];
+  rulist_count(resource_quota, list, 1);
   if (*root == nullptr) {
     *root = resource_user;
     resource_user->links[list].next = resource_user->links[list].prev =
@@ -212,6 +257,7 @@ static void rulist_add_tail(grpc_resource_user* resource_user,
                             grpc_rulist list) {
   grpc_resource_quota* resource_quota = resource_user->resource_quota;
   grpc_resource_user** root = &resource_quota->roots[list];
+  rulist_count(resource_quota, list, 1);
   if (*root == nullptr) {
     *root = resource_user;
     resource_user->links[list].next = resource_user->links[list].prev =
@@ -236,6 +282,7 @@ static grpc_resource_user* rulist_pop_head(grpc_resource_quota* resource_quota,
   if (resource_user == nullptr) {
     return nullptr;
   }
+  rulist_count(resource_quota, list, -1);
   if (resource_user->links[list].next == resource_user) {
     *root = nullptr;
   } else {
@@ -252,6 +299,7 @@ static grpc_resource_user* rulist_pop_head(grpc_resource_quota* resource_quota,
 static void rulist_remove(grpc_resource_user* resource_user, grpc_rulist list) {
   if (resource_user->links[list].next == nullptr) return;
   grpc_resource_quota* resource_quota = resource_user->resource_quota;
+  rulist_count(resource_quota, list, -1);
   if (resource_quota->roots[list] == resource_user) {
     resource_quota->roots[list] = resource_user->links[list].next;
     if (resource_quota->roots[list] == resource_user) {
@@ -270,17 +318,24 @@ static void rulist_remove(grpc_resource_user* resource_user, grpc_rulist list) {
  */
 
 static bool rq_alloc(grpc_resource_quota* resource_quota);
+static bool rq_reclaim_from_shards(grpc_resource_quota* resource_quota);
 static bool rq_reclaim_from_per_user_free_pool(
     grpc_resource_quota* resource_quota);
 static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive);
 
+static void ru_slab_trim(void);
+
 static void rq_step(void* rq, grpc_error* /*error*/) {
   grpc_resource_quota* resource_quota = static_cast<grpc_resource_quota*>(rq);
   resource_quota->step_scheduled = false;
   do {
     if (rq_alloc(resource_quota)) goto done;
-  } while (rq_reclaim_from_per_user_free_pool(resource_quota));
+  } while (rq_reclaim_from_shards(resource_quota) ||
+           rq_reclaim_from_per_user_free_pool(resource_quota));
 
+  /* Memory is short: give the cached slice blocks back before asking users
+     to reclaim theirs. */
+  ru_slab_trim();
   if (!rq_reclaim(resource_quota, false)) {
     rq_reclaim(resource_quota, true);
   }
@@ -297,8 +352,18 @@ static void rq_step_sched(grpc_resource_quota* resource_quota) {
                                        GRPC_ERROR_NONE);
 }
 
+/* Requires free_pool_mu */
+static void rq_update_shard_refill_size(grpc_resource_quota* resource_quota) {
+  if (resource_quota->num_shards == 0) return;
+  gpr_atm_no_barrier_store(
+      &resource_quota->shard_refill_size,
+      (gpr_atm)GPR_MIN(RQ_MAX_SHARD_REFILL,
+                       resource_quota->size /
+                           (16 * (int64_t)resource_quota->num_shards)));
+}
+
 /* update the atomically available resource estimate - use no barriers since
-   timeliness of delivery really doesn't matter much */
+   timeliness of delivery really doesn't matter much. Requires free_pool_mu. */
 static void rq_update_estimate(grpc_resource_quota* resource_quota) {
   gpr_atm memory_usage_estimation = MEMORY_USAGE_ESTIMATION_MAX;
   if (resource_quota->size != 0) {
@@ -338,6 +403,7 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
       ru_unref_by(resource_user, static_cast<gpr_atm>(aborted_allocations));
       continue;
     }
+    gpr_mu_lock(&resource_quota->free_pool_mu);
     if (resource_user->free_pool < 0 &&
         -resource_user->free_pool <= resource_quota->free_pool) {
       int64_t amt = -resource_user->free_pool;
@@ -356,6 +422,7 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
       gpr_log(GPR_INFO, "RQ %s %s: discard already satisfied alloc request",
               resource_quota->name, resource_user->name);
     }
+    gpr_mu_unlock(&resource_quota->free_pool_mu);
     if (resource_user->free_pool >= 0) {
       resource_user->allocating = false;
       resource_user->outstanding_allocations = 0;
@@ -370,6 +437,30 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
   return true;
 }
 
+/* returns true if any memory could be returned to the quota from its shards */
+static bool rq_reclaim_from_shards(grpc_resource_quota* resource_quota) {
+  int64_t amt = 0;
+  for (size_t i = 0; i < resource_quota->num_shards; i++) {
+    rq_shard* shard = &resource_quota->shards[i];
+    gpr_mu_lock(&shard->mu);
+    amt += shard->free_pool;
+    shard->free_pool = 0;
+    gpr_mu_unlock(&shard->mu);
+  }
+  if (amt == 0) return false;
+  gpr_mu_lock(&resource_quota->free_pool_mu);
+  resource_quota->free_pool += amt;
+  rq_update_estimate(resource_quota);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+    gpr_log(GPR_INFO,
+            "RQ %s: reclaim_from_shards %" PRId64
+            " bytes; rq_free_pool -> %" PRId64,
+            resource_quota->name, amt, resource_quota->free_pool);
+  }
+  gpr_mu_unlock(&resource_quota->free_pool_mu);
+  return true;
+}
+
 /* returns true if any memory could be reclaimed from buffers */
 static bool rq_reclaim_from_per_user_free_pool(
     grpc_resource_quota* resource_quota) {
@@ -381,6 +472,7 @@ static bool rq_reclaim_from_per_user_free_pool(
     if (resource_user->free_pool > 0) {
       int64_t amt = resource_user->free_pool;
       resource_user->free_pool = 0;
+      gpr_mu_lock(&resource_quota->free_pool_mu);
       resource_quota->free_pool += amt;
       rq_update_estimate(resource_quota);
       if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
@@ -390,6 +482,7 @@ static bool rq_reclaim_from_per_user_free_pool(
                 resource_quota->name, resource_user->name, amt,
                 resource_quota->free_pool);
       }
+      gpr_mu_unlock(&resource_quota->free_pool_mu);
       gpr_mu_unlock(&resource_user->mu);
       return true;
     } else {
@@ -432,20 +525,165 @@ static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive) {
  * ru_slice: a slice implementation that is backed by a grpc_resource_user
  */
 
+/* Freed slice blocks are kept on per-cpu free lists, one per power-of-two size
+   class, so that the read path can reuse a buffer instead of going back to
+   malloc on every read. Blocks are handed back to the cpu that frees them.
+   Slices are charged to their resource user for the full capacity of their
+   block. Free blocks belong to no quota, so the cache is capped and is
+   emptied whenever a quota runs short of memory. */
+#define RU_SLAB_MIN_SIZE 256
+#define RU_SLAB_NUM_CLASSES 11 /* up to 256KiB */
+/* Bytes of free blocks each shard keeps for each size class */
+#define RU_SLAB_MAX_CACHED_BYTES (256 * 1024)
+/* Bytes of free blocks kept over all shards and size classes */
+#define RU_SLAB_MAX_TOTAL_CACHED_BYTES (4 * 1024 * 1024)
+
+typedef struct ru_slab_block {
+  struct ru_slab_block* next;
+} ru_slab_block;
+
+typedef struct {
+  gpr_mu mu;
+  ru_slab_block* free_list[RU_SLAB_NUM_CLASSES];
+  size_t free_count[RU_SLAB_NUM_CLASSES];
+} ru_slab_shard;
+
+static gpr_once g_ru_slab_once = GPR_ONCE_INIT;
+static ru_slab_shard* g_ru_slab_shards;
+static size_t g_ru_slab_num_shards;
+static gpr_atm g_ru_slab_cached_bytes;
+
+static void ru_slab_init(void) {
+  g_ru_slab_num_shards = GPR_MAX(1, gpr_cpu_num_cores());
+  g_ru_slab_shards = static_cast<ru_slab_shard*>(
+      gpr_zalloc(sizeof(*g_ru_slab_shards) * g_ru_slab_num_shards));
+  for (size_t i = 0; i < g_ru_slab_num_shards; i++) {
+    gpr_mu_init(&g_ru_slab_shards[i].mu);
+  }
+}
+
+static ru_slab_shard* ru_slab_current_shard(void) {
+  gpr_once_init(&g_ru_slab_once, ru_slab_init);
+  return &g_ru_slab_shards[gpr_cpu_current_cpu() % g_ru_slab_num_shards];
+}
+
+/* Returns the size class for a slice of \a size bytes, or -1 if blocks of that
+   size are not cached */
+static int ru_slab_class(size_t size) {
+  size_t class_size = RU_SLAB_MIN_SIZE;
+  for (int i = 0; i < RU_SLAB_NUM_CLASSES; i++) {
+    if (size <= class_size) return i;
+    class_size <<= 1;
+  }
+  return -1;
+}
+
+static size_t ru_slab_class_size(int size_class) {
+  return static_cast<size_t>(RU_SLAB_MIN_SIZE) << size_class;
+}
+
+/* Returns the number of bytes actually allocated for a slice of \a size
+   bytes, which is what its resource user is charged */
+static size_t ru_slice_capacity(size_t size) {
+  const int size_class = ru_slab_class(size);
+  return size_class < 0 ? size : ru_slab_class_size(size_class);
+}
+
+static void* ru_slab_alloc(int size_class, size_t block_size) {
+  if (size_class < 0) return gpr_malloc(block_size);
+  ru_slab_shard* shard = ru_slab_current_shard();
+  gpr_mu_lock(&shard->mu);
+  ru_slab_block* block = shard->free_list[size_class];
+  if (block != nullptr) {
+    shard->free_list[size_class] = block->next;
+    shard->free_count[size_class]--;
+    gpr_atm_no_barrier_fetch_add(
+        &g_ru_slab_cached_bytes,
+        -static_cast<gpr_atm>(ru_slab_class_size(size_class)));
+  }
+  gpr_mu_unlock(&shard->mu);
+  return block != nullptr ? block : gpr_malloc(block_size);
+}
+
+/* Adds \a size to the bytes cached over all shards, unless that would go
+   over the total cap */
+static bool ru_slab_try_add_cached_bytes(size_t size) {
+  while (true) {
+    const gpr_atm cached = gpr_atm_no_barrier_load(&g_ru_slab_cached_bytes);
+    if (static_cast<size_t>(cached) + size > RU_SLAB_MAX_TOTAL_CACHED_BYTES) {
+      return false;
+    }
+    if (gpr_atm_no_barrier_cas(&g_ru_slab_cached_bytes, cached,
+                               cached + static_cast<gpr_atm>(size))) {
+      return true;
+    }
+  }
+}
+
+static void ru_slab_free(int size_class, void* p) {
+  if (size_class >= 0) {
+    ru_slab_shard* shard = ru_slab_current_shard();
+    gpr_mu_lock(&shard->mu);
+    const size_t class_size = ru_slab_class_size(size_class);
+    if (shard->free_count[size_class] * class_size < RU_SLAB_MAX_CACHED_BYTES &&
+        ru_slab_try_add_cached_bytes(class_size)) {
+      ru_slab_block* block = static_cast<ru_slab_block*>(p);
+      block->next = shard->free_list[size_class];
+      shard->free_list[size_class] = block;
+      shard->free_count[size_class]++;
+      p = nullptr;
+    }
+    gpr_mu_unlock(&shard->mu);
+  }
+  gpr_free(p);
+}
+
+/* Frees all cached blocks */
+static void ru_slab_trim(void) {
+  if (gpr_atm_no_barrier_load(&g_ru_slab_cached_bytes) == 0) return;
+  gpr_once_init(&g_ru_slab_once, ru_slab_init);
+  for (size_t i = 0; i < g_ru_slab_num_shards; i++) {
+    ru_slab_shard* shard = &g_ru_slab_shards[i];
+    for (int size_class = 0; size_class < RU_SLAB_NUM_CLASSES; size_class++) {
+      gpr_mu_lock(&shard->mu);
+      ru_slab_block* block = shard->free_list[size_class];
+      const size_t count = shard->free_count[size_class];
+      shard->free_list[size_class] = nullptr;
+      shard->free_count[size_class] = 0;
+      gpr_mu_unlock(&shard->mu);
+      gpr_atm_no_barrier_fetch_add(
+          &g_ru_slab_cached_bytes,
+          -static_cast<gpr_atm>(count * ru_slab_class_size(size_class)));
+      while (block != nullptr) {
+        ru_slab_block* next = block->next;
+        gpr_free(block);
+        block = next;
+      }
+    }
+  }
+}
+
+size_t grpc_resource_user_slice_cache_size_for_testing(void) {
+  return static_cast<size_t>(gpr_atm_no_barrier_load(&g_ru_slab_cached_bytes));
+}
+
 namespace grpc_core {
 
 class RuSliceRefcount {
  public:
   static void Destroy(void* p) {
     auto* rc = static_cast<RuSliceRefcount*>(p);
+    const int size_class = rc->size_class_;
     rc->~RuSliceRefcount();
-    gpr_free(rc);
+    ru_slab_free(size_class, rc);
   }
-  RuSliceRefcount(grpc_resource_user* resource_user, size_t size)
+  RuSliceRefcount(grpc_resource_user* resource_user, size_t size,
+                  int size_class, bool confined)
       : base_(grpc_slice_refcount::Type::REGULAR, &refs_, Destroy, this,
-              &base_),
+              &base_, confined),
         resource_user_(resource_user),
-        size_(size) {
+        size_(size),
+        size_class_(size_class) {
     // Nothing to do here.
   }
   ~RuSliceRefcount() { grpc_resource_user_free(resource_user_, size_); }
@@ -457,15 +695,19 @@ class RuSliceRefcount {
   RefCount refs_;
   grpc_resource_user* resource_user_;
   size_t size_;
+  int size_class_;
 };
 
 }  // namespace grpc_core
 
 static grpc_slice ru_slice_create(grpc_resource_user* resource_user,
-                                  size_t size) {
+                                  size_t size, bool confined) {
+  const int size_class = ru_slab_class(size);
+  const size_t capacity = ru_slice_capacity(size);
   auto* rc = static_cast<grpc_core::RuSliceRefcount*>(
-      gpr_malloc(sizeof(grpc_core::RuSliceRefcount) + size));
-  new (rc) grpc_core::RuSliceRefcount(resource_user, size);
+      ru_slab_alloc(size_class, sizeof(grpc_core::RuSliceRefcount) + capacity));
+  new (rc)
+      grpc_core::RuSliceRefcount(resource_user, capacity, size_class, confined);
   grpc_slice slice;
 
   slice.refcount = rc->base_refcount();
@@ -579,7 +821,9 @@ static void ru_destroy(void* ru, grpc_error* /*error*/) {
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, resource_user->reclaimers[1],
                           GRPC_ERROR_CANCELLED);
   if (resource_user->free_pool != 0) {
+    gpr_mu_lock(&resource_user->resource_quota->free_pool_mu);
     resource_user->resource_quota->free_pool += resource_user->free_pool;
+    gpr_mu_unlock(&resource_user->resource_quota->free_pool_mu);
     rq_step_sched(resource_user->resource_quota);
   }
   grpc_resource_quota_unref_internal(resource_user->resource_quota);
@@ -592,8 +836,9 @@ static void ru_alloc_slices(
     grpc_resource_user_slice_allocator* slice_allocator) {
   for (size_t i = 0; i < slice_allocator->count; i++) {
     grpc_slice_buffer_add_indexed(
-        slice_allocator->dest, ru_slice_create(slice_allocator->resource_user,
-                                               slice_allocator->length));
+        slice_allocator->dest,
+        ru_slice_create(slice_allocator->resource_user, slice_allocator->length,
+                        slice_allocator->confined));
   }
 }
 
@@ -618,10 +863,14 @@ typedef struct {
 
 static void rq_resize(void* args, grpc_error* /*error*/) {
   rq_resize_args* a = static_cast<rq_resize_args*>(args);
+  gpr_mu_lock(&a->resource_quota->free_pool_mu);
   int64_t delta = a->size - a->resource_quota->size;
   a->resource_quota->size += delta;
   a->resource_quota->free_pool += delta;
   rq_update_estimate(a->resource_quota);
+  rq_update_shard_refill_size(a->resource_quota);
+  gpr_mu_unlock(&a->resource_quota->free_pool_mu);
+  if (delta < 0) rq_reclaim_from_shards(a->resource_quota);
   rq_step_sched(a->resource_quota);
   grpc_resource_quota_unref_internal(a->resource_quota);
   gpr_free(a);
@@ -643,9 +892,26 @@ grpc_resource_quota* grpc_resource_quota_create(const char* name) {
   grpc_resource_quota* resource_quota =
       static_cast<grpc_resource_quota*>(gpr_malloc(sizeof(*resource_quota)));
   gpr_ref_init(&resource_quota->refs, 1);
-  resource_quota->combiner = grpc_combiner_create();
+  resource_quota->combiner = grpc_combiner_create("resource_quota");
+  gpr_mu_init(&resource_quota->free_pool_mu);
   resource_quota->free_pool = INT64_MAX;
   resource_quota->size = INT64_MAX;
+  resource_quota->num_shards =
+      GPR_GLOBAL_CONFIG_GET(grpc_resource_quota_per_cpu_shards)
+          ? GPR_CLAMP(gpr_cpu_num_cores(), 1, RQ_MAX_SHARDS)
+          : 0;
+  resource_quota->shards =
+      resource_quota->num_shards == 0
+          ? nullptr
+          : static_cast<rq_shard*>(gpr_malloc_aligned(
+                resource_quota->num_shards * sizeof(rq_shard),
+                GPR_CACHELINE_SIZE));
+  for (size_t i = 0; i < resource_quota->num_shards; i++) {
+    gpr_mu_init(&resource_quota->shards[i].mu);
+    resource_quota->shards[i].free_pool = 0;
+  }
+  rq_update_shard_refill_size(resource_quota);
+  gpr_atm_no_barrier_store(&resource_quota->num_awaiting, 0);
   resource_quota->used = 0;
   gpr_atm_no_barrier_store(&resource_quota->last_size, GPR_ATM_MAX);
   gpr_mu_init(&resource_quota->thread_count_mu);
@@ -675,6 +941,13 @@ void grpc_resource_quota_unref_internal(grpc_resource_quota* resource_quota) {
     // No outstanding thread quota
     GPR_ASSERT(resource_quota->num_threads_allocated == 0);
     GRPC_COMBINER_UNREF(resource_quota->combiner, "resource_quota");
+    for (size_t i = 0; i < resource_quota->num_shards; i++) {
+      gpr_mu_destroy(&resource_quota->shards[i].mu);
+    }
+    if (resource_quota->shards != nullptr) {
+      gpr_free_aligned(resource_quota->shards);
+    }
+    gpr_mu_destroy(&resource_quota->free_pool_mu);
     gpr_free(resource_quota->name);
     gpr_mu_destroy(&resource_quota->thread_count_mu);
     gpr_free(resource_quota);
@@ -883,6 +1156,78 @@ void grpc_resource_user_free_threads(grpc_resource_user* resource_user,
   gpr_mu_unlock(&resource_user->resource_quota->thread_count_mu);
 }
 
+static rq_shard* rq_current_shard(grpc_resource_quota* resource_quota) {
+  return &resource_quota
+              ->shards[gpr_cpu_current_cpu() % resource_quota->num_shards];
+}
+
+/* Takes \a amount bytes from the current cpu's shard, refilling it from the
+   quota's free pool if needed. Returns false, without taking anything, if
+   users are waiting for memory or the quota cannot refill the shard: it is
+   then up to the combiner to hand out memory. */
+static bool rq_shard_alloc(grpc_resource_quota* resource_quota,
+                           int64_t amount) {
+  if (resource_quota->num_shards == 0) return false;
+  if (gpr_atm_acq_load(&resource_quota->num_awaiting) > 0) return false;
+  rq_shard* shard = rq_current_shard(resource_quota);
+  gpr_mu_lock(&shard->mu);
+  if (shard->free_pool < amount) {
+    int64_t refill =
+        amount - shard->free_pool +
+        gpr_atm_no_barrier_load(&resource_quota->shard_refill_size);
+    gpr_mu_lock(&resource_quota->free_pool_mu);
+    if (refill <= resource_quota->free_pool) {
+      resource_quota->free_pool -= refill;
+      shard->free_pool += refill;
+      rq_update_estimate(resource_quota);
+    }
+    gpr_mu_unlock(&resource_quota->free_pool_mu);
+  }
+  const bool ok = shard->free_pool >= amount;
+  if (ok) shard->free_pool -= amount;
+  gpr_mu_unlock(&shard->mu);
+  return ok;
+}
+
+static void rq_step_locked(void* rq, grpc_error* /*error*/) {
+  grpc_resource_quota* resource_quota = static_cast<grpc_resource_quota*>(rq);
+  rq_step_sched(resource_quota);
+  grpc_resource_quota_unref_internal(resource_quota);
+}
+
+/* Gives \a amount bytes to the current cpu's shard, spilling any excess back
+   to the quota's free pool. Returns false, without taking anything, if users
+   are waiting for memory: the combiner hands it to them instead. */
+static bool rq_shard_free(grpc_resource_quota* resource_quota,
+                          int64_t amount) {
+  if (resource_quota->num_shards == 0) return false;
+  if (gpr_atm_acq_load(&resource_quota->num_awaiting) > 0) return false;
+  rq_shard* shard = rq_current_shard(resource_quota);
+  const int64_t refill_size =
+      gpr_atm_no_barrier_load(&resource_quota->shard_refill_size);
+  gpr_mu_lock(&shard->mu);
+  shard->free_pool += amount;
+  if (shard->free_pool > 2 * refill_size) {
+    int64_t spill = shard->free_pool - refill_size;
+    shard->free_pool = refill_size;
+    gpr_mu_lock(&resource_quota->free_pool_mu);
+    resource_quota->free_pool += spill;
+    rq_update_estimate(resource_quota);
+    gpr_mu_unlock(&resource_quota->free_pool_mu);
+  }
+  gpr_mu_unlock(&shard->mu);
+  // A user may have started waiting since the check above, after the
+  // combiner drained the shards: make sure it gets to see this memory.
+  if (gpr_atm_full_fetch_add(&resource_quota->num_awaiting, 0) > 0) {
+    resource_quota->combiner->Run(
+        GRPC_CLOSURE_CREATE(rq_step_locked,
+                            grpc_resource_quota_ref_internal(resource_quota),
+                            nullptr),
+        GRPC_ERROR_NONE);
+  }
+  return true;
+}
+
 static bool resource_user_alloc_locked(grpc_resource_user* resource_user,
                                        size_t size,
                                        grpc_closure* optional_on_done) {
@@ -894,6 +1239,11 @@ static bool resource_user_alloc_locked(grpc_resource_user* resource_user,
             resource_user->free_pool);
   }
   if (GPR_LIKELY(resource_user->free_pool >= 0)) return true;
+  if (rq_shard_alloc(resource_user->resource_quota,
+                     -resource_user->free_pool)) {
+    resource_user->free_pool = 0;
+    return true;
+  }
   // Slow path: We need to wait for the free pool to refill.
   if (optional_on_done != nullptr) {
     resource_user->outstanding_allocations += static_cast<int64_t>(size);
@@ -957,9 +1307,13 @@ void grpc_resource_user_free(grpc_resource_user* resource_user, size_t size) {
   bool is_bigger_than_zero = resource_user->free_pool > 0;
   if (is_bigger_than_zero && was_zero_or_negative &&
       !resource_user->added_to_free_pool) {
-    resource_user->added_to_free_pool = true;
-    resource_quota->combiner->Run(&resource_user->add_to_free_pool_closure,
-                                  GRPC_ERROR_NONE);
+    if (rq_shard_free(resource_quota, resource_user->free_pool)) {
+      resource_user->free_pool = 0;
+    } else {
+      resource_user->added_to_free_pool = true;
+      resource_quota->combiner->Run(&resource_user->add_to_free_pool_closure,
+                                    GRPC_ERROR_NONE);
+    }
   }
   gpr_mu_unlock(&resource_user->mu);
   ru_unref_by(resource_user, static_cast<gpr_atm>(size));
@@ -992,6 +1346,7 @@ void grpc_resource_user_slice_allocator_init(
   GRPC_CLOSURE_INIT(&slice_allocator->on_done, cb, p,
                     grpc_schedule_on_exec_ctx);
   slice_allocator->resource_user = resource_user;
+  slice_allocator->confined = false;
 }
 
 bool grpc_resource_user_alloc_slices(
@@ -1007,9 +1362,9 @@ bool grpc_resource_user_alloc_slices(
   slice_allocator->length = length;
   slice_allocator->count = count;
   slice_allocator->dest = dest;
-  const bool ret =
-      grpc_resource_user_alloc(slice_allocator->resource_user, count * length,
-                               &slice_allocator->on_allocated);
+  const bool ret = grpc_resource_user_alloc(
+      slice_allocator->resource_user, count * ru_slice_capacity(length),
+      &slice_allocator->on_allocated);
   if (ret) ru_alloc_slices(slice_allocator);
   return ret;
 }
@@ -24,6 +24,7 @@
 #include <grpc/grpc.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/closure.h"
 
 /** \file Tracks resource usage against a pool.
@@ -56,6 +57,12 @@
     reclamation, due to resources that may have been freed up by the destructive
     reclamation in the previous attempt.
 
+    With GRPC_RESOURCE_QUOTA_PER_CPU_SHARDS set, a quota also keeps a cache of
+    free memory per cpu. Allocations and frees that the cache can cover do not
+    go through the quota's combiner, which is then only involved once resource
+    users have to wait for memory. Cached memory counts as used, and is handed
+    back to the quota before any reclamation starts.
+
     Future work will be to expose the current resource pressure so that back
     pressure can be applied to avoid reclamation phases starting.
 
@@ -63,6 +70,8 @@
     maintain lists of users (which users arrange to leave before they are
     destroyed) */
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_resource_quota_per_cpu_shards);
+
 extern grpc_core::TraceFlag grpc_resource_quota_trace;
 
 // TODO(juanlishen): This is a hack. We need to do real accounting instead of
@@ -84,6 +93,10 @@ double grpc_resource_quota_get_memory_pressure(
 
 size_t grpc_resource_quota_peek_size(grpc_resource_quota* resource_quota);
 
+/* Returns the number of bytes of freed slice blocks cached for reuse by
+   grpc_resource_user_alloc_slices() */
+size_t grpc_resource_user_slice_cache_size_for_testing(void);
+
 typedef struct grpc_resource_user grpc_resource_user;
 
 grpc_resource_user* grpc_resource_user_create(
@@ -158,6 +171,10 @@ typedef struct grpc_resource_user_slice_allocator {
   grpc_slice_buffer* dest;
   /* Parent resource user */
   grpc_resource_user* resource_user;
+  /* Whether allocated slices start out with a confined refcount (see
+     grpc_slice_refcount): false after init, set by owners that only hand the
+     slices to serialized code */
+  bool confined;
 } grpc_resource_user_slice_allocator;
 
 /* Initialize a slice allocator.
@@ -60,6 +60,11 @@ void config_default_tcp_user_timeout(bool enable, int timeout, bool is_client);
 grpc_error* grpc_set_socket_tcp_user_timeout(
     int fd, const grpc_channel_args* channel_args, bool is_client);
 
+/* Set TCP_FASTOPEN_CONNECT on clients or TCP_FASTOPEN on servers, if
+   GRPC_ARG_TCP_FAST_OPEN asks for it */
+grpc_error* grpc_set_socket_tcp_fast_open(
+    int fd, const grpc_channel_args* channel_args, bool is_client);
+
 /* Returns true if this system can create AF_INET6 sockets bound to ::1.
    The value is probed once, and cached for the life of the process.
 
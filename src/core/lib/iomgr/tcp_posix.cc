@@ -28,6 +28,7 @@
 #include <limits.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,6 +37,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
+#include <map>
 
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
@@ -49,9 +51,12 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/executor.h"
+#include "src/core/lib/iomgr/internal_errqueue.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -80,6 +85,218 @@ typedef size_t msg_iovlen_type;
 extern grpc_core::TraceFlag grpc_tcp_trace;
 
 namespace {
+
+/* Holds the slices of one grpc_endpoint_write() sent with MSG_ZEROCOPY. The
+ * kernel keeps referencing the slice memory after sendmsg returns, so the
+ * slices are only released once every sendmsg issued for them has been
+ * acknowledged by a completion notification on the socket's error queue. */
+class TcpZerocopySendRecord {
+ public:
+  TcpZerocopySendRecord() { grpc_slice_buffer_init(&buf_); }
+
+  /* The endpoint waits for every outstanding completion before freeing its
+   * send records (see zerocopy_disable_and_wait_for_remaining()), since the
+   * kernel reads straight from the slice memory until it reports one. */
+  ~TcpZerocopySendRecord() { grpc_slice_buffer_destroy_internal(&buf_); }
+
+  /* Takes ownership of the slices in \a slices_to_send. The initial ref is
+   * dropped once all the bytes have been handed to the kernel. */
+  void PrepareForSends(grpc_slice_buffer* slices_to_send) {
+    GPR_DEBUG_ASSERT(buf_.count == 0);
+    slice_idx_ = 0;
+    byte_idx_ = 0;
+    grpc_slice_buffer_swap(slices_to_send, &buf_);
+    Ref();
+  }
+
+  /* Fills \a iov with the next unsent bytes. The position before filling is
+   * stored in \a unwind_slice_idx and \a unwind_byte_idx. */
+  msg_iovlen_type PopulateIovs(size_t* unwind_slice_idx,
+                               size_t* unwind_byte_idx, size_t* sending_length,
+                               struct iovec* iov, size_t max_iovs);
+
+  /* Restores the send position after a sendmsg that did not take any bytes. */
+  void UnwindIfThrottled(size_t unwind_slice_idx, size_t unwind_byte_idx) {
+    slice_idx_ = unwind_slice_idx;
+    byte_idx_ = unwind_byte_idx;
+  }
+
+  /* Rewinds the send position for the bytes of the last PopulateIovs() call
+   * that sendmsg did not take. */
+  void UpdateOffsetForBytesSent(size_t sending_length, size_t actually_sent);
+
+  bool AllSlicesSent() const { return slice_idx_ == buf_.count; }
+
+  void Ref() { ref_.FetchAdd(1, grpc_core::MemoryOrder::RELAXED); }
+
+  /* Returns true if this was the last ref; the slices are released and the
+   * record may be reused. */
+  bool Unref() {
+    const intptr_t prior = ref_.FetchSub(1, grpc_core::MemoryOrder::ACQ_REL);
+    GPR_DEBUG_ASSERT(prior > 0);
+    if (prior == 1) {
+      grpc_slice_buffer_reset_and_unref_internal(&buf_);
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  grpc_slice_buffer buf_;
+  grpc_core::Atomic<intptr_t> ref_{0};
+  size_t slice_idx_ = 0;
+  size_t byte_idx_ = 0;
+};
+
+/* Per-endpoint MSG_ZEROCOPY state: a fixed pool of send records and the
+ * mapping from kernel sequence numbers (one per successful zerocopy sendmsg)
+ * to the record whose bytes that sendmsg referenced. */
+class TcpZerocopySendCtx {
+ public:
+  static constexpr int kDefaultMaxSends = 4;
+  static constexpr int kDefaultSendBytesThreshold = 16 * 1024;
+
+  TcpZerocopySendCtx(bool enabled, int max_sends, size_t threshold_bytes)
+      : threshold_bytes_(threshold_bytes) {
+    gpr_mu_init(&mu_);
+    if (enabled && max_sends > 0) {
+      max_sends_ = max_sends;
+      send_records_ = static_cast<TcpZerocopySendRecord*>(
+          gpr_malloc(max_sends * sizeof(*send_records_)));
+      free_send_records_ = static_cast<TcpZerocopySendRecord**>(
+          gpr_malloc(max_sends * sizeof(*free_send_records_)));
+      for (int i = 0; i < max_sends; ++i) {
+        new (&send_records_[i]) TcpZerocopySendRecord();
+        free_send_records_[i] = &send_records_[i];
+      }
+      free_send_records_size_ = max_sends;
+      enabled_ = true;
+    }
+  }
+
+  ~TcpZerocopySendCtx() {
+    if (send_records_ != nullptr) {
+      for (int i = 0; i < max_sends_; ++i) {
+        send_records_[i].~TcpZerocopySendRecord();
+      }
+    }
+    gpr_free(send_records_);
+    gpr_free(free_send_records_);
+    gpr_mu_destroy(&mu_);
+  }
+
+  bool enabled() const { return enabled_; }
+  void set_enabled(bool enabled) {
+    enabled_ = enabled && send_records_ != nullptr;
+  }
+  size_t threshold_bytes() const { return threshold_bytes_; }
+
+  /* Returns a free send record, or nullptr if all records are waiting for
+   * completion notifications or the context is shut down. */
+  TcpZerocopySendRecord* GetSendRecord() {
+    grpc_core::MutexLock lock(&mu_);
+    if (shutdown_ || free_send_records_size_ == 0) return nullptr;
+    return free_send_records_[--free_send_records_size_];
+  }
+
+  void PutSendRecord(TcpZerocopySendRecord* record) {
+    grpc_core::MutexLock lock(&mu_);
+    GPR_DEBUG_ASSERT(free_send_records_size_ < max_sends_);
+    free_send_records_[free_send_records_size_++] = record;
+  }
+
+  /* Must be called right before a zerocopy sendmsg of \a record's bytes. */
+  void NoteSend(TcpZerocopySendRecord* record) {
+    record->Ref();
+    grpc_core::MutexLock lock(&mu_);
+    ctx_lookup_.emplace(last_send_, record);
+    ++last_send_;
+  }
+
+  /* Reverts the last NoteSend() when the sendmsg failed, since the kernel only
+   * assigns sequence numbers to successful sends. */
+  void UndoSend() {
+    TcpZerocopySendRecord* record = ReleaseSendRecord(--last_send_);
+    GPR_ASSERT(record != nullptr);
+    /* The caller still holds its own ref on record. */
+    GPR_ASSERT(!record->Unref());
+  }
+
+  /* Removes and returns the record associated with \a seq. */
+  TcpZerocopySendRecord* ReleaseSendRecord(uint32_t seq) {
+    grpc_core::MutexLock lock(&mu_);
+    auto iter = ctx_lookup_.find(seq);
+    if (iter == ctx_lookup_.end()) return nullptr;
+    TcpZerocopySendRecord* record = iter->second;
+    ctx_lookup_.erase(iter);
+    return record;
+  }
+
+  /* Stops handing out send records. */
+  void Shutdown() {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+  }
+
+  bool AllSendRecordsEmpty() {
+    grpc_core::MutexLock lock(&mu_);
+    return free_send_records_size_ == max_sends_;
+  }
+
+ private:
+  gpr_mu mu_;
+  TcpZerocopySendRecord* send_records_ = nullptr;
+  TcpZerocopySendRecord** free_send_records_ = nullptr;
+  /* 0 when zerocopy was never enabled, so that there is nothing to wait for
+   * on shutdown. */
+  int max_sends_ = 0;
+  int free_send_records_size_ = 0;
+  /* Only accessed from the write path, which is never concurrent. */
+  uint32_t last_send_ = 0;
+  std::map<uint32_t, TcpZerocopySendRecord*> ctx_lookup_;
+  size_t threshold_bytes_;
+  bool enabled_ = false;
+  bool shutdown_ = false;
+};
+
+msg_iovlen_type TcpZerocopySendRecord::PopulateIovs(size_t* unwind_slice_idx,
+                                                    size_t* unwind_byte_idx,
+                                                    size_t* sending_length,
+                                                    struct iovec* iov,
+                                                    size_t max_iovs) {
+  msg_iovlen_type iov_size;
+  *unwind_slice_idx = slice_idx_;
+  *unwind_byte_idx = byte_idx_;
+  for (iov_size = 0; slice_idx_ != buf_.count && iov_size != max_iovs;
+       iov_size++) {
+    iov[iov_size].iov_base =
+        GRPC_SLICE_START_PTR(buf_.slices[slice_idx_]) + byte_idx_;
+    iov[iov_size].iov_len = GRPC_SLICE_LENGTH(buf_.slices[slice_idx_]) -
+                            byte_idx_;
+    *sending_length += iov[iov_size].iov_len;
+    ++slice_idx_;
+    byte_idx_ = 0;
+  }
+  GPR_DEBUG_ASSERT(iov_size > 0);
+  return iov_size;
+}
+
+void TcpZerocopySendRecord::UpdateOffsetForBytesSent(size_t sending_length,
+                                                     size_t actually_sent) {
+  size_t trailing = sending_length - actually_sent;
+  while (trailing > 0) {
+    size_t slice_length;
+    slice_idx_--;
+    slice_length = GRPC_SLICE_LENGTH(buf_.slices[slice_idx_]);
+    if (slice_length > trailing) {
+      byte_idx_ = slice_length - trailing;
+      break;
+    } else {
+      trailing -= slice_length;
+    }
+  }
+}
+
 struct grpc_tcp {
   grpc_endpoint base;
   grpc_fd* em_fd;
@@ -105,6 +322,11 @@ struct grpc_tcp {
   grpc_slice_buffer* outgoing_buffer;
   /* byte within outgoing_buffer->slices[0] to write next */
   size_t outgoing_byte_idx;
+  /* Slices shorter than this are copied into tx_coalesce_buffer by
+   * tcp_flush() */
+  size_t tx_coalesce_threshold;
+  /* kTxCoalesceBufferSize bytes, allocated on first use */
+  uint8_t* tx_coalesce_buffer;
 
   grpc_closure* read_cb;
   grpc_closure* write_cb;
@@ -142,6 +364,10 @@ struct grpc_tcp {
   bool ts_capable;        /* Cache whether we can set timestamping options */
   gpr_atm stop_error_notification; /* Set to 1 if we do not want to be notified
                                       on errors anymore */
+  TcpZerocopySendCtx tcp_zerocopy_send_ctx;
+  /* Send record of the write in progress if it is being sent with
+   * MSG_ZEROCOPY, nullptr otherwise. */
+  TcpZerocopySendRecord* current_zerocopy_send;
 };
 
 struct backup_poller {
@@ -336,6 +562,7 @@ static grpc_error* tcp_annotate_error(grpc_error* src_error, grpc_tcp* tcp) {
 
 static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error* error);
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error);
+static void zerocopy_disable_and_wait_for_remaining(grpc_tcp* tcp);
 
 static void tcp_shutdown(grpc_endpoint* ep, grpc_error* why) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
@@ -344,9 +571,12 @@ static void tcp_shutdown(grpc_endpoint* ep, grpc_error* why) {
 }
 
 static void tcp_free(grpc_tcp* tcp) {
+  zerocopy_disable_and_wait_for_remaining(tcp);
   grpc_fd_orphan(tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
   grpc_slice_buffer_destroy_internal(&tcp->last_read_buffer);
+  gpr_free(tcp->tx_coalesce_buffer);
+  tcp->tcp_zerocopy_send_ctx.~TcpZerocopySendCtx();
   grpc_resource_user_unref(tcp->resource_user);
   gpr_free(tcp->peer_string);
   /* The lock is not really necessary here, since all refs have been released */
@@ -651,14 +881,14 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
 }
 
 /* A wrapper around sendmsg. It sends \a msg over \a fd and returns the number
- * of bytes sent. */
-ssize_t tcp_send(int fd, const struct msghdr* msg) {
+ * of bytes sent. \a additional_flags are or'ed into the sendmsg flags. */
+ssize_t tcp_send(int fd, const struct msghdr* msg, int additional_flags = 0) {
   GPR_TIMER_SCOPE("sendmsg", 1);
   ssize_t sent_length;
   do {
     /* TODO(klempner): Cork if this is a partial write */
     GRPC_STATS_INC_SYSCALL_WRITE();
-    sent_length = sendmsg(fd, msg, SENDMSG_FLAGS);
+    sent_length = sendmsg(fd, msg, SENDMSG_FLAGS | additional_flags);
   } while (sent_length < 0 && errno == EINTR);
   return sent_length;
 }
@@ -676,6 +906,15 @@ static bool tcp_write_with_timestamps(grpc_tcp* tcp, struct msghdr* msg,
 /** The callback function to be invoked when we get an error on the socket. */
 static void tcp_handle_error(void* arg /* grpc_tcp */, grpc_error* error);
 
+/** Drops a ref on \a record, returning it to the free pool of send records if
+ * that was the last one. */
+static void unref_maybe_put_zerocopy_send_record(
+    grpc_tcp* tcp, TcpZerocopySendRecord* record) {
+  if (record->Unref()) {
+    tcp->tcp_zerocopy_send_ctx.PutSendRecord(record);
+  }
+}
+
 #ifdef GRPC_LINUX_ERRQUEUE
 
 static bool tcp_write_with_timestamps(grpc_tcp* tcp, struct msghdr* msg,
@@ -780,6 +1019,42 @@ struct cmsghdr* process_timestamp(grpc_tcp* tcp, msghdr* msg,
   return next_cmsg;
 }
 
+/** Returns true if \a cmsg is a MSG_ZEROCOPY completion notification. */
+static bool cmsg_is_zerocopy(const cmsghdr& cmsg) {
+  if (!((cmsg.cmsg_level == SOL_IP && cmsg.cmsg_type == IP_RECVERR) ||
+        (cmsg.cmsg_level == SOL_IPV6 && cmsg.cmsg_type == IPV6_RECVERR))) {
+    return false;
+  }
+  auto serr = reinterpret_cast<const struct sock_extended_err*>(
+      CMSG_DATA(const_cast<cmsghdr*>(&cmsg)));
+  return serr->ee_errno == 0 && serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY;
+}
+
+/** Processes a MSG_ZEROCOPY completion notification, which covers the
+ * zerocopy sends with sequence numbers in [ee_info, ee_data]. The send records
+ * of those sends are unreffed, releasing their slices once all of the sends
+ * for a record have completed. */
+static void process_zerocopy(grpc_tcp* tcp, struct cmsghdr* cmsg) {
+  auto serr = reinterpret_cast<struct sock_extended_err*>(CMSG_DATA(cmsg));
+  const uint32_t lo = serr->ee_info;
+  const uint32_t hi = serr->ee_data;
+  if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+    /* The kernel fell back to copying, e.g. because the device does not
+     * support scatter-gather. */
+    GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS();
+  }
+  for (uint32_t seq = lo; seq - lo <= hi - lo; ++seq) {
+    TcpZerocopySendRecord* record =
+        tcp->tcp_zerocopy_send_ctx.ReleaseSendRecord(seq);
+    if (record == nullptr) {
+      gpr_log(GPR_ERROR, "TCP:%p unknown zerocopy sequence number %u", tcp,
+              seq);
+      continue;
+    }
+    unref_maybe_put_zerocopy_send_record(tcp, record);
+  }
+}
+
 /** For linux platforms, reads the socket's error queue and processes error
  * messages from the queue.
  */
@@ -834,6 +1109,11 @@ static void process_errors(grpc_tcp* tcp) {
     bool seen = false;
     for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg && cmsg->cmsg_len;
          cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg_is_zerocopy(*cmsg)) {
+        process_zerocopy(tcp, cmsg);
+        seen = true;
+        continue;
+      }
       if (cmsg->cmsg_level != SOL_SOCKET ||
           cmsg->cmsg_type != SCM_TIMESTAMPING) {
         /* Got a control message that is not a timestamp. Don't know how to
@@ -878,6 +1158,24 @@ static void tcp_handle_error(void* arg /* grpc_tcp */, grpc_error* error) {
   grpc_fd_notify_on_error(tcp->em_fd, &tcp->error_closure);
 }
 
+/** Stops zerocopy sends and reads the error queue until the kernel has
+ * reported the completion of every outstanding one. Until then it may still
+ * read from the slices of their send records. Called once the last ref is
+ * gone, so no write or error handler can be running concurrently. */
+static void zerocopy_disable_and_wait_for_remaining(grpc_tcp* tcp) {
+  tcp->tcp_zerocopy_send_ctx.Shutdown();
+  while (!tcp->tcp_zerocopy_send_ctx.AllSendRecordsEmpty()) {
+    /* A pending error queue message is reported as POLLERR, which is polled
+     * for even with no events requested. */
+    struct pollfd pfd;
+    pfd.fd = tcp->fd;
+    pfd.events = 0;
+    pfd.revents = 0;
+    poll(&pfd, 1, 100 /* ms */);
+    process_errors(tcp);
+  }
+}
+
 #else  /* GRPC_LINUX_ERRQUEUE */
 static bool tcp_write_with_timestamps(grpc_tcp* /*tcp*/, struct msghdr* /*msg*/,
                                       size_t /*sending_length*/,
@@ -892,6 +1190,9 @@ static void tcp_handle_error(void* /*arg*/ /* grpc_tcp */,
   gpr_log(GPR_ERROR, "Error handling is not supported for this platform");
   GPR_ASSERT(0);
 }
+
+/* Zerocopy sends are never enabled without the error queue. */
+static void zerocopy_disable_and_wait_for_remaining(grpc_tcp* /*tcp*/) {}
 #endif /* GRPC_LINUX_ERRQUEUE */
 
 /* If outgoing_buffer_arg is filled, shuts down the list early, so that any
@@ -907,12 +1208,73 @@ void tcp_shutdown_buffer_list(grpc_tcp* tcp) {
   }
 }
 
-/* returns true if done, false if pending; if returning true, *error is set */
 #if defined(IOV_MAX) && IOV_MAX < 1000
 #define MAX_WRITE_IOVEC IOV_MAX
 #else
 #define MAX_WRITE_IOVEC 1000
 #endif
+
+/* Size of the buffer that tcp_flush() copies runs of small slices into. */
+constexpr size_t kTxCoalesceBufferSize = 16 * 1024;
+constexpr int kDefaultTxCoalesceThreshold = 0;
+
+/* Fills \a iov with the slices of tcp->outgoing_buffer from *slice_idx on
+ * (starting at tcp->outgoing_byte_idx within the first one) and advances
+ * *slice_idx past them. A run of at least two slices shorter than
+ * tcp->tx_coalesce_threshold is copied into tcp->tx_coalesce_buffer and takes
+ * a single iovec: the kernel charges for each iovec, and HPACK frames, frame
+ * headers and small messages produce many tiny slices. */
+static msg_iovlen_type tcp_fill_iov(grpc_tcp* tcp, size_t* slice_idx,
+                                    struct iovec* iov,
+                                    size_t* sending_length) {
+  grpc_slice_buffer* buf = tcp->outgoing_buffer;
+  size_t coalesced = 0;
+  msg_iovlen_type iov_size = 0;
+  while (*slice_idx != buf->count && iov_size != MAX_WRITE_IOVEC) {
+    uint8_t* start =
+        GRPC_SLICE_START_PTR(buf->slices[*slice_idx]) + tcp->outgoing_byte_idx;
+    size_t length =
+        GRPC_SLICE_LENGTH(buf->slices[*slice_idx]) - tcp->outgoing_byte_idx;
+    tcp->outgoing_byte_idx = 0;
+    if (length < tcp->tx_coalesce_threshold && *slice_idx + 1 != buf->count &&
+        GRPC_SLICE_LENGTH(buf->slices[*slice_idx + 1]) <
+            tcp->tx_coalesce_threshold &&
+        coalesced + length + GRPC_SLICE_LENGTH(buf->slices[*slice_idx + 1]) <=
+            kTxCoalesceBufferSize) {
+      if (tcp->tx_coalesce_buffer == nullptr) {
+        tcp->tx_coalesce_buffer =
+            static_cast<uint8_t*>(gpr_malloc(kTxCoalesceBufferSize));
+      }
+      uint8_t* run = tcp->tx_coalesce_buffer + coalesced;
+      size_t run_length = 0;
+      for (;;) {
+        memcpy(run + run_length, start, length);
+        run_length += length;
+        ++*slice_idx;
+        if (*slice_idx == buf->count) break;
+        start = GRPC_SLICE_START_PTR(buf->slices[*slice_idx]);
+        length = GRPC_SLICE_LENGTH(buf->slices[*slice_idx]);
+        if (length >= tcp->tx_coalesce_threshold ||
+            coalesced + run_length + length > kTxCoalesceBufferSize) {
+          break;
+        }
+      }
+      GRPC_STATS_INC_TCP_WRITE_COALESCED_RUNS();
+      coalesced += run_length;
+      start = run;
+      length = run_length;
+    } else {
+      ++*slice_idx;
+    }
+    iov[iov_size].iov_base = start;
+    iov[iov_size].iov_len = length;
+    *sending_length += length;
+    ++iov_size;
+  }
+  return iov_size;
+}
+
+/* returns true if done, false if pending; if returning true, *error is set */
 static bool tcp_flush(grpc_tcp* tcp, grpc_error** error) {
   struct msghdr msg;
   struct iovec iov[MAX_WRITE_IOVEC];
@@ -931,20 +1293,7 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error** error) {
     sending_length = 0;
     unwind_slice_idx = outgoing_slice_idx;
     unwind_byte_idx = tcp->outgoing_byte_idx;
-    for (iov_size = 0; outgoing_slice_idx != tcp->outgoing_buffer->count &&
-                       iov_size != MAX_WRITE_IOVEC;
-         iov_size++) {
-      iov[iov_size].iov_base =
-          GRPC_SLICE_START_PTR(
-              tcp->outgoing_buffer->slices[outgoing_slice_idx]) +
-          tcp->outgoing_byte_idx;
-      iov[iov_size].iov_len =
-          GRPC_SLICE_LENGTH(tcp->outgoing_buffer->slices[outgoing_slice_idx]) -
-          tcp->outgoing_byte_idx;
-      sending_length += iov[iov_size].iov_len;
-      outgoing_slice_idx++;
-      tcp->outgoing_byte_idx = 0;
-    }
+    iov_size = tcp_fill_iov(tcp, &outgoing_slice_idx, iov, &sending_length);
     GPR_ASSERT(iov_size > 0);
 
     msg.msg_name = nullptr;
@@ -1020,6 +1369,111 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error** error) {
   }
 }
 
+#ifdef GRPC_LINUX_ERRQUEUE
+/* Like tcp_flush(), but sends the bytes owned by \a record with MSG_ZEROCOPY.
+ * The slices stay referenced by \a record until the kernel reports that it is
+ * done with them. */
+static bool do_tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
+                                  grpc_error** error) {
+  struct msghdr msg;
+  struct iovec iov[MAX_WRITE_IOVEC];
+  msg_iovlen_type iov_size;
+  ssize_t sent_length = 0;
+  size_t sending_length;
+  size_t unwind_slice_idx;
+  size_t unwind_byte_idx;
+  for (;;) {
+    sending_length = 0;
+    iov_size = record->PopulateIovs(&unwind_slice_idx, &unwind_byte_idx,
+                                    &sending_length, iov, MAX_WRITE_IOVEC);
+    msg.msg_name = nullptr;
+    msg.msg_namelen = 0;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_size;
+    msg.msg_flags = 0;
+    msg.msg_control = nullptr;
+    msg.msg_controllen = 0;
+
+    GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
+    GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
+
+    tcp->tcp_zerocopy_send_ctx.NoteSend(record);
+    sent_length = tcp_send(tcp->fd, &msg, MSG_ZEROCOPY);
+    int saved_errno = errno;
+    if (sent_length >= 0) {
+      GRPC_STATS_INC_TCP_ZEROCOPY_SENDS();
+    } else {
+      tcp->tcp_zerocopy_send_ctx.UndoSend();
+      if (saved_errno == ENOBUFS) {
+        /* The socket ran out of optmem for pinning pages. Copy this chunk
+         * instead of stalling until notifications drain. */
+        GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS();
+        sent_length = tcp_send(tcp->fd, &msg);
+        saved_errno = errno;
+      }
+    }
+
+    if (sent_length < 0) {
+      if (saved_errno == EAGAIN) {
+        record->UnwindIfThrottled(unwind_slice_idx, unwind_byte_idx);
+        return false;
+      } else {
+        *error =
+            tcp_annotate_error(GRPC_OS_ERROR(saved_errno, "sendmsg"), tcp);
+        tcp_shutdown_buffer_list(tcp);
+        return true;
+      }
+    }
+
+    tcp->bytes_counter += sent_length;
+    record->UpdateOffsetForBytesSent(sending_length,
+                                     static_cast<size_t>(sent_length));
+    if (record->AllSlicesSent()) {
+      *error = GRPC_ERROR_NONE;
+      return true;
+    }
+  }
+}
+#else  /* GRPC_LINUX_ERRQUEUE */
+static bool do_tcp_flush_zerocopy(grpc_tcp* /*tcp*/,
+                                  TcpZerocopySendRecord* /*record*/,
+                                  grpc_error** /*error*/) {
+  gpr_log(GPR_ERROR, "Zerocopy writes not supported for this platform");
+  GPR_ASSERT(0);
+  return true;
+}
+#endif /* GRPC_LINUX_ERRQUEUE */
+
+/* Returns true if done, false if pending. Once done, the write's own ref on
+ * \a record is dropped. */
+static bool tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
+                               grpc_error** error) {
+  bool done = do_tcp_flush_zerocopy(tcp, record, error);
+  if (done) {
+    unref_maybe_put_zerocopy_send_record(tcp, record);
+  }
+  return done;
+}
+
+/* Returns a send record holding the slices of \a buf if this write should be
+ * sent with MSG_ZEROCOPY, nullptr otherwise. */
+static TcpZerocopySendRecord* tcp_get_send_zerocopy_record(
+    grpc_tcp* tcp, grpc_slice_buffer* buf) {
+  if (!tcp->tcp_zerocopy_send_ctx.enabled() ||
+      tcp->outgoing_buffer_arg != nullptr ||
+      buf->length < tcp->tcp_zerocopy_send_ctx.threshold_bytes()) {
+    return nullptr;
+  }
+  TcpZerocopySendRecord* record = tcp->tcp_zerocopy_send_ctx.GetSendRecord();
+  if (record == nullptr) {
+    /* All records are still waiting for completion notifications. */
+    GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS();
+    return nullptr;
+  }
+  record->PrepareForSends(buf);
+  return record;
+}
+
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error) {
   grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
   grpc_closure* cb;
@@ -1027,12 +1481,20 @@ static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error) {
   if (error != GRPC_ERROR_NONE) {
     cb = tcp->write_cb;
     tcp->write_cb = nullptr;
+    if (tcp->current_zerocopy_send != nullptr) {
+      unref_maybe_put_zerocopy_send_record(tcp, tcp->current_zerocopy_send);
+      tcp->current_zerocopy_send = nullptr;
+    }
     grpc_core::Closure::Run(DEBUG_LOCATION, cb, GRPC_ERROR_REF(error));
     TCP_UNREF(tcp, "write");
     return;
   }
 
-  if (!tcp_flush(tcp, &error)) {
+  bool flush_result =
+      tcp->current_zerocopy_send != nullptr
+          ? tcp_flush_zerocopy(tcp, tcp->current_zerocopy_send, &error)
+          : tcp_flush(tcp, &error);
+  if (!flush_result) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "write: delayed");
     }
@@ -1042,6 +1504,7 @@ static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error) {
   } else {
     cb = tcp->write_cb;
     tcp->write_cb = nullptr;
+    tcp->current_zerocopy_send = nullptr;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       const char* str = grpc_error_string(error);
       gpr_log(GPR_INFO, "write: %s", str);
@@ -1085,15 +1548,22 @@ static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
     tcp_shutdown_buffer_list(tcp);
     return;
   }
+  TcpZerocopySendRecord* zerocopy_send_record =
+      tcp_get_send_zerocopy_record(tcp, buf);
   tcp->outgoing_buffer = buf;
   tcp->outgoing_byte_idx = 0;
   if (arg) {
     GPR_ASSERT(grpc_event_engine_can_track_errors());
   }
 
-  if (!tcp_flush(tcp, &error)) {
+  bool flush_result =
+      zerocopy_send_record != nullptr
+          ? tcp_flush_zerocopy(tcp, zerocopy_send_record, &error)
+          : tcp_flush(tcp, &error);
+  if (!flush_result) {
     TCP_REF(tcp, "write");
     tcp->write_cb = cb;
+    tcp->current_zerocopy_send = zerocopy_send_record;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "write: delayed");
     }
@@ -1175,6 +1645,12 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
+  bool tcp_tx_zerocopy_enabled = false;
+  int tcp_tx_zerocopy_send_bytes_threshold =
+      TcpZerocopySendCtx::kDefaultSendBytesThreshold;
+  int tcp_tx_zerocopy_max_simult_sends = TcpZerocopySendCtx::kDefaultMaxSends;
+  int tcp_busy_poll_us = 0;
+  int tcp_tx_coalesce_threshold = kDefaultTxCoalesceThreshold;
   grpc_resource_quota* resource_quota = grpc_resource_quota_create(nullptr);
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
@@ -1199,6 +1675,34 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
         resource_quota =
             grpc_resource_quota_ref_internal(static_cast<grpc_resource_quota*>(
                 channel_args->args[i].value.pointer.p));
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) {
+        tcp_tx_zerocopy_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], tcp_tx_zerocopy_enabled);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {tcp_tx_zerocopy_send_bytes_threshold,
+                                        0, INT_MAX};
+        tcp_tx_zerocopy_send_bytes_threshold =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS)) {
+        grpc_integer_options options = {tcp_tx_zerocopy_max_simult_sends, 1,
+                                        INT_MAX};
+        tcp_tx_zerocopy_max_simult_sends =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_BUSY_POLL_US)) {
+        grpc_integer_options options = {tcp_busy_poll_us, 0, INT_MAX};
+        tcp_busy_poll_us =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_COALESCE_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {
+            tcp_tx_coalesce_threshold, 0,
+            static_cast<int>(kTxCoalesceBufferSize)};
+        tcp_tx_coalesce_threshold =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
       }
     }
   }
@@ -1228,6 +1732,47 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->socket_ts_enabled = false;
   tcp->ts_capable = true;
   tcp->outgoing_buffer_arg = nullptr;
+  tcp->tx_coalesce_threshold = static_cast<size_t>(tcp_tx_coalesce_threshold);
+  tcp->tx_coalesce_buffer = nullptr;
+  /* Zerocopy completions are reported on the error queue, so zerocopy sends
+   * need a polling engine that can track errors. */
+  tcp_tx_zerocopy_enabled = tcp_tx_zerocopy_enabled &&
+                            grpc_core::kernel_supports_zerocopy() &&
+                            grpc_event_engine_can_track_errors();
+  new (&tcp->tcp_zerocopy_send_ctx) TcpZerocopySendCtx(
+      tcp_tx_zerocopy_enabled, tcp_tx_zerocopy_max_simult_sends,
+      tcp_tx_zerocopy_send_bytes_threshold);
+  tcp->current_zerocopy_send = nullptr;
+#ifdef GRPC_LINUX_ERRQUEUE
+  if (tcp->tcp_zerocopy_send_ctx.enabled()) {
+    const int enable = 1;
+    if (setsockopt(tcp->fd, SOL_SOCKET, SO_ZEROCOPY, &enable,
+                   sizeof(enable)) != 0) {
+      gpr_log(GPR_DEBUG, "cannot set SO_ZEROCOPY fd=%d errno=%d", tcp->fd,
+              errno);
+      tcp->tcp_zerocopy_send_ctx.set_enabled(false);
+    }
+  }
+#endif /* GRPC_LINUX_ERRQUEUE */
+  if (tcp_busy_poll_us > 0) {
+#ifdef SO_BUSY_POLL
+    if (setsockopt(tcp->fd, SOL_SOCKET, SO_BUSY_POLL, &tcp_busy_poll_us,
+                   sizeof(tcp_busy_poll_us)) != 0) {
+      /* Raising the budget above net.core.busy_read needs CAP_NET_ADMIN */
+      gpr_log(GPR_DEBUG, "cannot set SO_BUSY_POLL fd=%d errno=%d", tcp->fd,
+              errno);
+    }
+#endif /* SO_BUSY_POLL */
+#ifdef SO_PREFER_BUSY_POLL
+    const int prefer = 1;
+    if (setsockopt(tcp->fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer,
+                   sizeof(prefer)) != 0) {
+      gpr_log(GPR_DEBUG, "cannot set SO_PREFER_BUSY_POLL fd=%d errno=%d",
+              tcp->fd, errno);
+    }
+#endif /* SO_PREFER_BUSY_POLL */
+    grpc_fd_set_busy_poll(em_fd, tcp_busy_poll_us);
+  }
   /* paired with unref in grpc_tcp_destroy */
   new (&tcp->refcount) grpc_core::RefCount(1, &grpc_tcp_trace);
   gpr_atm_no_barrier_store(&tcp->shutdown_count, 0);
@@ -1236,6 +1781,10 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->resource_user = grpc_resource_user_create(resource_quota, peer_string);
   grpc_resource_user_slice_allocator_init(
       &tcp->slice_allocator, tcp->resource_user, tcp_read_allocation_done, tcp);
+  /* Read slices only travel down the chain of read callbacks, which is
+     serialized with the next read: their refs need not be atomic until the
+     reader publishes them (see grpc_endpoint_read). */
+  tcp->slice_allocator.confined = true;
   grpc_resource_quota_unref_internal(resource_quota);
   gpr_mu_init(&tcp->tb_mu);
   tcp->tb_head = nullptr;
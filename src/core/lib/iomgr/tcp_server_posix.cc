@@ -38,6 +38,7 @@
 #include <unistd.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
@@ -63,6 +64,7 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
       static_cast<grpc_tcp_server*>(gpr_zalloc(sizeof(grpc_tcp_server)));
   s->so_reuseport = grpc_is_socket_reuse_port_supported();
   s->expand_wildcard_addrs = false;
+  s->listeners_per_port = 0;
   for (size_t i = 0; i < (args == nullptr ? 0 : args->num_args); i++) {
     if (0 == strcmp(GRPC_ARG_ALLOW_REUSEPORT, args->args[i].key)) {
       if (args->args[i].type == GRPC_ARG_INTEGER) {
@@ -81,6 +83,20 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             GRPC_ARG_EXPAND_WILDCARD_ADDRS " must be an integer");
       }
+    } else if (0 == strcmp(GRPC_ARG_REUSEPORT_LISTENERS_PER_PORT,
+                           args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER &&
+          args->args[i].value.integer >= -1) {
+        s->listeners_per_port =
+            args->args[i].value.integer == -1
+                ? static_cast<int>(gpr_cpu_num_cores())
+                : args->args[i].value.integer;
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_REUSEPORT_LISTENERS_PER_PORT
+            " must be an integer no less than -1");
+      }
     }
   }
   gpr_ref_init(&s->refs, 1);
@@ -183,7 +199,34 @@ static void tcp_server_destroy(grpc_tcp_server* s) {
   }
 }
 
+/* Picks the pollset for a new connection round-robin, skipping the pollsets
+   that the polling engine keeps on another NUMA node than the current thread
+   as long as there is a local one. */
+static grpc_pollset* next_read_notifier_pollset(grpc_tcp_server* s) {
+  size_t start = static_cast<size_t>(
+      gpr_atm_no_barrier_fetch_add(&s->next_pollset_to_assign, 1));
+  for (size_t i = 0; i < s->pollset_count; i++) {
+    grpc_pollset* pollset = s->pollsets[(start + i) % s->pollset_count];
+    if (grpc_pollset_is_local(pollset)) {
+      /* Move past the pollsets we skipped, so that the next connection goes
+         to the next local pollset rather than to this one again. */
+      if (i > 0) {
+        gpr_atm_no_barrier_fetch_add(&s->next_pollset_to_assign,
+                                     static_cast<gpr_atm>(i));
+      }
+      return pollset;
+    }
+  }
+  return s->pollsets[start % s->pollset_count];
+}
+
 /* event manager callback when reads are ready */
+/* Connections accepted per wakeup of a listener. During an accept storm, the
+   poller that got the wakeup would otherwise accept until the backlog runs
+   dry, while the connections it already accepted wait for their handshakes
+   to start. */
+#define MAX_ACCEPTS_PER_WAKEUP 16
+
 static void on_read(void* arg, grpc_error* err) {
   grpc_tcp_listener* sp = static_cast<grpc_tcp_listener*>(arg);
   grpc_pollset* read_notifier_pollset;
@@ -191,8 +234,17 @@ static void on_read(void* arg, grpc_error* err) {
     goto error;
   }
 
-  /* loop until accept4 returns EAGAIN, and then re-arm notification */
-  for (;;) {
+  /* loop until accept4 returns EAGAIN or the budget runs out, and then re-arm
+     notification */
+  for (int accepted = 0;; accepted++) {
+    if (accepted == MAX_ACCEPTS_PER_WAKEUP) {
+      /* The backlog may still hold connections, and there may be no new edge
+         to report them: mark the fd readable, so that this runs again once
+         the closures queued so far have run. */
+      grpc_fd_set_readable(sp->emfd);
+      grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
+      return;
+    }
     grpc_resolved_address addr;
     char* addr_str;
     char* name;
@@ -245,10 +297,12 @@ static void on_read(void* arg, grpc_error* err) {
 
     grpc_fd* fdobj = grpc_fd_create(fd, name, true);
 
-    read_notifier_pollset =
-        sp->server->pollsets[static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-                                 &sp->server->next_pollset_to_assign, 1)) %
-                             sp->server->pollset_count];
+    if (sp->pollset != nullptr) {
+      /* Keep the connection on the pollset that accepted it. */
+      read_notifier_pollset = sp->pollset;
+    } else {
+      read_notifier_pollset = next_read_notifier_pollset(sp->server);
+    }
 
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
 
@@ -378,6 +432,7 @@ static grpc_error* clone_port(grpc_tcp_listener* listener, unsigned count) {
     sp->is_sibling = 1;
     sp->sibling = listener->sibling;
     listener->sibling = sp;
+    sp->pollset = nullptr;
     sp->server = listener->server;
     sp->fd = fd;
     sp->emfd = grpc_fd_create(fd, name, true);
@@ -502,14 +557,29 @@ static void tcp_server_start(grpc_tcp_server* s, grpc_pollset** pollsets,
   s->on_accept_cb_arg = on_accept_cb_arg;
   s->pollsets = pollsets;
   s->pollset_count = pollset_count;
+  /* With SO_REUSEPORT, every port gets one listener per pollset, or
+     listeners_per_port listeners that each keep their connections on a single
+     pollset. The latter only matters to engines that poll fds per pollset:
+     epoll1 has one epoll set shared by all pollsets. */
+  size_t listener_count = s->listeners_per_port > 0
+                              ? static_cast<size_t>(s->listeners_per_port)
+                              : pollset_count;
   sp = s->head;
   while (sp != nullptr) {
     if (s->so_reuseport && !grpc_is_unix_socket(&sp->addr) &&
-        pollset_count > 1) {
+        listener_count > 1) {
       GPR_ASSERT(GRPC_LOG_IF_ERROR(
-          "clone_port", clone_port(sp, (unsigned)(pollset_count - 1))));
-      for (i = 0; i < pollset_count; i++) {
-        grpc_pollset_add_fd(pollsets[i], sp->emfd);
+          "clone_port", clone_port(sp, (unsigned)(listener_count - 1))));
+      for (i = 0; i < listener_count; i++) {
+        /* Without pollsets, the listeners are still started, but are not
+           tied to any pollset. */
+        if (pollset_count > 0) {
+          grpc_pollset* pollset = pollsets[i % pollset_count];
+          grpc_pollset_add_fd(pollset, sp->emfd);
+          if (s->listeners_per_port > 0) {
+            sp->pollset = pollset;
+          }
+        }
         GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                           grpc_schedule_on_exec_ctx);
         grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
@@ -596,10 +666,7 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
               addr_str);
     }
     grpc_fd* fdobj = grpc_fd_create(fd, name, true);
-    read_notifier_pollset =
-        s_->pollsets[static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-                         &s_->next_pollset_to_assign, 1)) %
-                     s_->pollset_count];
+    read_notifier_pollset = next_read_notifier_pollset(s_);
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
     grpc_tcp_server_acceptor* acceptor =
         static_cast<grpc_tcp_server_acceptor*>(gpr_malloc(sizeof(*acceptor)));
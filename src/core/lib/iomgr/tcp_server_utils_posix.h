@@ -46,6 +46,9 @@ typedef struct grpc_tcp_listener {
      identified while iterating through 'next'. */
   struct grpc_tcp_listener* sibling;
   int is_sibling;
+  /* pollset that connections accepted by this listener are assigned to, or
+     NULL to spread them across all of the server's pollsets */
+  grpc_pollset* pollset;
 } grpc_tcp_listener;
 
 /* the overall server */
@@ -68,6 +71,9 @@ struct grpc_tcp_server {
   bool shutdown_listeners;
   /* use SO_REUSEPORT */
   bool so_reuseport;
+  /* number of SO_REUSEPORT listeners per port, each bound to one pollset, or
+     0 for one listener per pollset */
+  int listeners_per_port;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs;
 
@@ -112,6 +112,7 @@ static grpc_error* add_socket_to_server(grpc_tcp_server* s, int fd,
     sp->fd_index = fd_index;
     sp->is_sibling = 0;
     sp->sibling = nullptr;
+    sp->pollset = nullptr;
     GPR_ASSERT(sp->emfd);
     gpr_mu_unlock(&s->mu);
     gpr_free(addr_str);
@@ -169,6 +170,9 @@ grpc_error* grpc_tcp_server_prepare_socket(grpc_tcp_server* s, int fd,
     err = grpc_set_socket_tcp_user_timeout(fd, s->channel_args,
                                            false /* is_client */);
     if (err != GRPC_ERROR_NONE) goto error;
+    err = grpc_set_socket_tcp_fast_open(fd, s->channel_args,
+                                        false /* is_client */);
+    if (err != GRPC_ERROR_NONE) goto error;
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (err != GRPC_ERROR_NONE) goto error;
@@ -19,20 +19,186 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/iomgr/timer.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
 #include "src/core/lib/iomgr/timer_manager.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_timer_strategy, "heap",
+    "Declares which timer implementation to use: 'heap' (sharded heaps) or "
+    "'wheel' (a hierarchical timing wheel).")
+
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
 grpc_timer_vtable* grpc_timer_impl;
 
 void grpc_set_timer_impl(grpc_timer_vtable* vtable) {
   grpc_timer_impl = vtable;
 }
 
+void grpc_set_default_timer_impl() {
+  grpc_core::UniquePtr<char> strategy =
+      GPR_GLOBAL_CONFIG_GET(grpc_timer_strategy);
+  if (strcmp(strategy.get(), "wheel") == 0) {
+    grpc_set_timer_impl(&grpc_wheel_timer_vtable);
+    return;
+  }
+  if (strcmp(strategy.get(), "heap") != 0) {
+    gpr_log(GPR_ERROR, "Unknown timer strategy '%s', using 'heap'",
+            strategy.get());
+  }
+  grpc_set_timer_impl(&grpc_generic_timer_vtable);
+}
+
 void grpc_timer_init(grpc_timer* timer, grpc_millis deadline,
                      grpc_closure* closure) {
+  timer->group = nullptr;
+  grpc_timer_manager_start_if_pending();
   grpc_timer_impl->init(timer, deadline, closure);
 }
 
-void grpc_timer_cancel(grpc_timer* timer) { grpc_timer_impl->cancel(timer); }
+/*******************************************************************************
+ * Coalesced timers: timers initialized with slack have their deadline rounded
+ * up to a multiple of the largest power of two no bigger than the slack.
+ * Timers that round to the same deadline join one group, which is the only one
+ * of them that gets a timer from the implementation.
+ */
+
+#define NUM_GROUP_BUCKETS 256
+
+struct grpc_timer_group {
+  grpc_timer timer;
+  grpc_closure on_timer;
+  grpc_millis deadline;
+  size_t bucket;
+  /* Doubly linked list of the member timers, through their next/prev */
+  grpc_timer* members;
+  grpc_timer_group* next_in_bucket;
+};
+
+typedef struct {
+  gpr_mu mu;
+  grpc_timer_group* groups;
+} group_bucket;
+
+static gpr_once g_group_buckets_once = GPR_ONCE_INIT;
+static group_bucket g_group_buckets[NUM_GROUP_BUCKETS];
+
+static void init_group_buckets() {
+  for (size_t i = 0; i < NUM_GROUP_BUCKETS; i++) {
+    gpr_mu_init(&g_group_buckets[i].mu);
+  }
+}
+
+/* REQUIRES: bucket locked */
+static void group_remove(group_bucket* bucket, grpc_timer_group* group) {
+  grpc_timer_group** p = &bucket->groups;
+  while (*p != group) p = &(*p)->next_in_bucket;
+  *p = group->next_in_bucket;
+}
+
+static void group_on_timer(void* arg, grpc_error* error) {
+  grpc_timer_group* group = static_cast<grpc_timer_group*>(arg);
+  group_bucket* bucket = &g_group_buckets[group->bucket];
+  gpr_mu_lock(&bucket->mu);
+  if (error == GRPC_ERROR_CANCELLED && group->members != nullptr) {
+    /* The last member was cancelled, but new ones joined before this ran */
+    grpc_timer_init(&group->timer, group->deadline, &group->on_timer);
+    gpr_mu_unlock(&bucket->mu);
+    return;
+  }
+  group_remove(bucket, group);
+  grpc_timer* members = group->members;
+  for (grpc_timer* timer = members; timer != nullptr; timer = timer->next) {
+    timer->pending = false;
+  }
+  gpr_mu_unlock(&bucket->mu);
+  while (members != nullptr) {
+    grpc_timer* timer = members;
+    members = members->next;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_REF(error));
+  }
+  gpr_free(group);
+}
+
+void grpc_timer_init_with_slack(grpc_timer* timer, grpc_millis deadline,
+                                grpc_millis slack, grpc_closure* closure) {
+  grpc_millis granularity = 1;
+  while (granularity <= slack / 2) granularity <<= 1;
+  if (granularity == 1 || deadline > GRPC_MILLIS_INF_FUTURE - granularity) {
+    grpc_timer_init(timer, deadline, closure);
+    return;
+  }
+  deadline = (deadline + granularity - 1) & ~(granularity - 1);
+  gpr_once_init(&g_group_buckets_once, init_group_buckets);
+  const size_t bucket_index = static_cast<size_t>(deadline) % NUM_GROUP_BUCKETS;
+  group_bucket* bucket = &g_group_buckets[bucket_index];
+  gpr_mu_lock(&bucket->mu);
+  grpc_timer_group* group = bucket->groups;
+  while (group != nullptr && group->deadline != deadline) {
+    group = group->next_in_bucket;
+  }
+  const bool new_group = group == nullptr;
+  if (new_group) {
+    group = static_cast<grpc_timer_group*>(gpr_zalloc(sizeof(*group)));
+    group->deadline = deadline;
+    group->bucket = bucket_index;
+    group->next_in_bucket = bucket->groups;
+    bucket->groups = group;
+    GRPC_CLOSURE_INIT(&group->on_timer, group_on_timer, group,
+                      grpc_schedule_on_exec_ctx);
+  }
+  timer->group = group;
+  timer->deadline = deadline;
+  timer->closure = closure;
+  timer->pending = true;
+  timer->prev = nullptr;
+  timer->next = group->members;
+  if (group->members != nullptr) group->members->prev = timer;
+  group->members = timer;
+  if (new_group) {
+    grpc_timer_init(&group->timer, deadline, &group->on_timer);
+  }
+  gpr_mu_unlock(&bucket->mu);
+}
+
+static void group_member_cancel(grpc_timer* timer) {
+  /* The group may already be gone if the timer is not pending, so find the
+     bucket from the timer's own deadline. */
+  group_bucket* bucket =
+      &g_group_buckets[static_cast<size_t>(timer->deadline) %
+                       NUM_GROUP_BUCKETS];
+  gpr_mu_lock(&bucket->mu);
+  if (timer->pending) {
+    grpc_timer_group* group = timer->group;
+    timer->pending = false;
+    if (timer->next != nullptr) timer->next->prev = timer->prev;
+    if (timer->prev != nullptr) {
+      timer->prev->next = timer->next;
+    } else {
+      group->members = timer->next;
+    }
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+    if (group->members == nullptr) grpc_timer_cancel(&group->timer);
+  }
+  gpr_mu_unlock(&bucket->mu);
+}
+
+void grpc_timer_cancel(grpc_timer* timer) {
+  if (timer->group != nullptr) {
+    group_member_cancel(timer);
+    return;
+  }
+  grpc_timer_impl->cancel(timer);
+}
 
 grpc_timer_check_result grpc_timer_check(grpc_millis* next) {
   return grpc_timer_impl->check(next);
@@ -24,17 +24,21 @@
 #include "src/core/lib/iomgr/port.h"
 
 #include <grpc/support/time.h>
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
 
 typedef struct grpc_timer {
   grpc_millis deadline;
   // Uninitialized if not using heap, or INVALID_HEAP_INDEX if not in heap.
+  // The timing wheel keeps the timer's slot here instead.
   uint32_t heap_index;
   bool pending;
   struct grpc_timer* next;
   struct grpc_timer* prev;
   grpc_closure* closure;
+  // Set if the timer was initialized with slack and joined a coalesced group.
+  struct grpc_timer_group* group;
 #ifndef NDEBUG
   struct grpc_timer* hash_table_next;
 #endif
@@ -70,6 +74,15 @@ typedef struct grpc_timer_vtable {
 void grpc_timer_init(grpc_timer* timer, grpc_millis deadline,
                      grpc_closure* closure);
 
+/* Like grpc_timer_init, but the timer may fire up to \a slack milliseconds
+   after \a deadline (never before it). Timers whose windows overlap are
+   coalesced so that they share a single underlying timer and fire together,
+   which keeps the timer list small when there are many timers that do not
+   need to be precise, e.g. call deadlines and keepalive pings. A slack of zero
+   or less behaves exactly like grpc_timer_init. */
+void grpc_timer_init_with_slack(grpc_timer* timer, grpc_millis deadline,
+                                grpc_millis slack, grpc_closure* closure);
+
 /* Initialize *timer without setting it. This can later be passed through
    the regular init or cancel */
 void grpc_timer_init_unset(grpc_timer* timer);
@@ -121,7 +134,12 @@ void grpc_timer_consume_kick(void);
 /* the following must be implemented by each iomgr implementation */
 void grpc_kick_poller(void);
 
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_timer_strategy);
+
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
 
+/* Sets the non-custom timer implementation selected by GRPC_TIMER_STRATEGY */
+void grpc_set_default_timer_impl();
+
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
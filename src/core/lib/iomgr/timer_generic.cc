@@ -348,7 +348,10 @@ static void note_deadline_change(timer_shard* shard) {
   }
 }
 
-void grpc_timer_init_unset(grpc_timer* timer) { timer->pending = false; }
+void grpc_timer_init_unset(grpc_timer* timer) {
+  timer->pending = false;
+  timer->group = nullptr;
+}
 
 static void timer_init(grpc_timer* timer, grpc_millis deadline,
                        grpc_closure* closure) {
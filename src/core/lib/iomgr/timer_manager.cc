@@ -26,9 +26,20 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/timer.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_timers_on_pollers, false,
+    "If set, polling threads wake up for the next timer and run expired timers "
+    "themselves; timer threads only step in when nothing is polling.");
+
+// How long timer threads leave timers to the polling threads after the last
+// one stopped polling, in case another one starts polling again soon.
+static const grpc_millis kPollerLeaseMs = 50;
+
 struct completed_thread {
   grpc_core::Thread thd;
   completed_thread* next;
@@ -61,6 +72,19 @@ static grpc_millis g_timed_waiter_deadline;
 static uint64_t g_timed_waiter_generation;
 // number of timer wakeups
 static uint64_t g_wakeups;
+// set by grpc_timer_manager_init until the first timer starts the threads
+static gpr_atm g_start_pending;
+// do polling threads run timers
+static bool g_timers_on_pollers;
+// is there a polling thread watching timers
+static bool g_has_timer_poller;
+// how to wake up the polling thread watching timers (only relevant if
+// g_has_timer_poller is true)
+static void (*g_timer_poller_kick)(void* arg);
+static void* g_timer_poller_kick_arg;
+// until when timer threads leave timers to polling threads, after the last one
+// watching timers stopped polling
+static grpc_millis g_timer_poller_lease;
 
 static void timer_thread(void* completed_thread_ptr);
 
@@ -177,6 +201,14 @@ static bool wait_until(grpc_millis next) {
        unless their 'next' is earlier than the current timed-waiter's deadline
        (in which case the thread with earlier 'next' takes over as the new timed
        waiter) */
+    if (next != GRPC_MILLIS_INF_FUTURE && g_timers_on_pollers) {
+      // a polling thread is (or is likely to soon be) watching 'next' already:
+      // only check on it now and then, rather than waking up for every timer
+      grpc_millis lease =
+          g_has_timer_poller ? grpc_core::ExecCtx::Get()->Now() + kPollerLeaseMs
+                             : g_timer_poller_lease;
+      next = GPR_MAX(next, lease);
+    }
     if (next != GRPC_MILLIS_INF_FUTURE) {
       if (!g_has_timed_waiter || (next < g_timed_waiter_deadline)) {
         my_timed_waiter_generation = ++g_timed_waiter_generation;
@@ -308,10 +340,24 @@ void grpc_timer_manager_init(void) {
   g_has_timed_waiter = false;
   g_timed_waiter_deadline = GRPC_MILLIS_INF_FUTURE;
 
-  start_threads();
+  g_timers_on_pollers = GPR_GLOBAL_CONFIG_GET(grpc_timers_on_pollers);
+  g_has_timer_poller = false;
+  g_timer_poller_lease = 0;
+
+  // Until there is a timer there is nothing for a timer thread to wait for,
+  // so leave starting it to the first grpc_timer_init().
+  gpr_atm_rel_store(&g_start_pending, 1);
+}
+
+void grpc_timer_manager_start_if_pending(void) {
+  if (gpr_atm_acq_load(&g_start_pending) != 0 &&
+      gpr_atm_full_cas(&g_start_pending, 1, 0)) {
+    start_threads();
+  }
 }
 
 static void stop_threads(void) {
+  gpr_atm_rel_store(&g_start_pending, 0);
   gpr_mu_lock(&g_mu);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
     gpr_log(GPR_INFO, "stop timer threads: threaded=%d", g_threaded);
@@ -344,14 +390,76 @@ void grpc_timer_manager_shutdown(void) {
 
 void grpc_timer_manager_set_threading(bool threaded) {
   if (threaded) {
+    gpr_atm_rel_store(&g_start_pending, 0);
     start_threads();
   } else {
     stop_threads();
   }
 }
 
+bool grpc_timer_manager_begin_poll(grpc_millis* deadline,
+                                   void (*kick)(void* arg), void* kick_arg) {
+  if (!g_timers_on_pollers) return false;
+  gpr_mu_lock(&g_mu);
+  if (g_has_timer_poller) {
+    gpr_mu_unlock(&g_mu);
+    return false;
+  }
+  g_has_timer_poller = true;
+  g_timer_poller_kick = kick;
+  g_timer_poller_kick_arg = kick_arg;
+  gpr_mu_unlock(&g_mu);
+  // timers added from here on kick this thread, so none can be missed
+  switch (grpc_timer_check(deadline)) {
+    case GRPC_TIMERS_FIRED:
+      // don't block while the expired timers wait in our exec_ctx
+      *deadline = grpc_core::ExecCtx::Get()->Now();
+      break;
+    case GRPC_TIMERS_NOT_CHECKED:
+      // a timer thread is checking timers right now: leave them to it
+      gpr_mu_lock(&g_mu);
+      g_has_timer_poller = false;
+      gpr_mu_unlock(&g_mu);
+      return false;
+    case GRPC_TIMERS_CHECKED_AND_EMPTY:
+      break;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "poller watches timers until %" PRId64, *deadline);
+  }
+  return true;
+}
+
+void grpc_timer_manager_end_poll(void) {
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  grpc_millis next = GRPC_MILLIS_INF_FUTURE;
+  grpc_timer_check(&next);
+  gpr_mu_lock(&g_mu);
+  g_has_timer_poller = false;
+  g_timer_poller_lease = grpc_core::ExecCtx::Get()->Now() + kPollerLeaseMs;
+  // the timer threads may not know about timers this thread was kicked for
+  if (next != GRPC_MILLIS_INF_FUTURE && g_threaded &&
+      (!g_has_timed_waiter ||
+       GPR_MAX(next, g_timer_poller_lease) < g_timed_waiter_deadline)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "poller hands timers back to timer threads");
+    }
+    g_kicked = true;
+    g_has_timed_waiter = false;
+    g_timed_waiter_deadline = GRPC_MILLIS_INF_FUTURE;
+    ++g_timed_waiter_generation;
+    gpr_cv_signal(&g_cv_wait);
+  }
+  gpr_mu_unlock(&g_mu);
+}
+
 void grpc_kick_poller(void) {
   gpr_mu_lock(&g_mu);
+  if (g_has_timer_poller) {
+    g_timer_poller_kick(g_timer_poller_kick_arg);
+    gpr_mu_unlock(&g_mu);
+    return;
+  }
   g_kicked = true;
   g_has_timed_waiter = false;
   g_timed_waiter_deadline = GRPC_MILLIS_INF_FUTURE;
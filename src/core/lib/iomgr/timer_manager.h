@@ -23,11 +23,16 @@
 
 #include <stdbool.h>
 
+#include "src/core/lib/iomgr/exec_ctx.h"
+
 /* Timer Manager tries to keep only one thread waiting for the next timeout at
    all times, and thus effectively preventing the thundering herd problem. */
 
+/* Timer threads are not started by init, but by the first timer through
+   grpc_timer_manager_start_if_pending() */
 void grpc_timer_manager_init(void);
 void grpc_timer_manager_shutdown(void);
+void grpc_timer_manager_start_if_pending(void);
 
 /* enable/disable threading - must be called after grpc_timer_manager_init and
  * before grpc_timer_manager_shutdown */
@@ -35,6 +40,17 @@ void grpc_timer_manager_set_threading(bool enabled);
 /* explicitly perform one tick of the timer system - for when threading is
  * disabled */
 void grpc_timer_manager_tick(void);
+/* With GRPC_TIMERS_ON_POLLERS set, a polling thread about to block until
+   *deadline calls this first. If it returns true, the thread has taken over
+   watching timers from the timer threads: *deadline has been brought forward
+   to the next timer, and kick(kick_arg) is called whenever a timer earlier
+   than that is added until the thread calls grpc_timer_manager_end_poll(). */
+bool grpc_timer_manager_begin_poll(grpc_millis* deadline,
+                                   void (*kick)(void* arg), void* kick_arg);
+/* Called by a polling thread for which grpc_timer_manager_begin_poll() returned
+   true once it's done polling: runs the timers that expired (via the thread's
+   exec_ctx) and leaves timers to the timer threads again */
+void grpc_timer_manager_end_poll(void);
 /* get global counter that tracks timer wakeups */
 uint64_t grpc_timer_manager_get_wakeups_testonly(void);
 
@@ -0,0 +1,459 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#include <inttypes.h>
+
+#include "src/core/lib/iomgr/timer.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* A hierarchical timing wheel, in the style of the classic BSD/Linux callout
+ * wheels.
+ *
+ * Level 0 has one slot per millisecond for the next WHEEL_SLOTS milliseconds,
+ * and each level above it has slots WHEEL_SLOTS times as wide as the level
+ * below. A timer is placed in the lowest level that covers its deadline, so
+ * adding or cancelling one is a list operation. Higher level slots are only
+ * redistributed ("cascaded") into the levels below when the wheel reaches
+ * them, and timers beyond the last level wait in an unordered overflow list
+ * until they come within range.
+ *
+ * As with the heap based implementation, timers are hashed onto shards to
+ * reduce lock contention. Each shard keeps a lower bound on the next tick at
+ * which its wheel has work to do, so timer_check only visits shards that may
+ * have expired timers. */
+
+#define WHEEL_LEVEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_LEVEL_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 6
+/* Timers further than this in the future go to the overflow list (~2 years) */
+#define WHEEL_HORIZON (int64_t(1) << (WHEEL_LEVEL_BITS * WHEEL_LEVELS))
+
+/* Stored in heap_index for timers in the overflow list */
+#define OVERFLOW_INDEX 0xffffffffu
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+typedef struct {
+  gpr_mu mu;
+  /* The next tick to process: every timer with a deadline before this has
+     fired. */
+  grpc_millis next_tick;
+  /* A lower bound on the tick of the next fire or cascade in this shard. */
+  grpc_millis min_deadline;
+  /* Bit i of occupied[l] is set iff slots[l][i] is non-empty. */
+  uint64_t occupied[WHEEL_LEVELS];
+  /* Heads of doubly linked lists of timers; the slot of a timer is kept in its
+     heap_index so that it can be unlinked without a sentinel per slot. */
+  grpc_timer* slots[WHEEL_LEVELS][WHEEL_SLOTS];
+  /* Timers more than WHEEL_HORIZON past next_tick, and the earliest of
+     their deadlines. */
+  grpc_timer* overflow;
+  grpc_millis overflow_min;
+} wheel_shard;
+
+static size_t g_num_shards;
+static wheel_shard* g_shards;
+
+struct shared_mutables {
+  /* A lower bound on the deadline of the next timer due across all shards */
+  grpc_millis min_timer;
+  /* Allow only one timer_check at once */
+  gpr_spinlock checker_mu;
+  bool initialized;
+  /* Protects min_timer updates */
+  gpr_mu mu;
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+static struct shared_mutables g_shared_mutables;
+
+static grpc_millis load_min_timer() {
+#if GPR_ARCH_64
+  // See timer_generic.cc for why this is a c-style cast.
+  return static_cast<grpc_millis>(
+      gpr_atm_no_barrier_load((gpr_atm*)(&g_shared_mutables.min_timer)));
+#else
+  // 64-bit values can't be loaded atomically here, so min_timer is only
+  // accessed under g_shared_mutables.mu
+  gpr_mu_lock(&g_shared_mutables.mu);
+  grpc_millis min_timer = g_shared_mutables.min_timer;
+  gpr_mu_unlock(&g_shared_mutables.mu);
+  return min_timer;
+#endif
+}
+
+/* REQUIRES: g_shared_mutables.mu locked */
+static void store_min_timer(grpc_millis min_timer) {
+#if GPR_ARCH_64
+  gpr_atm_no_barrier_store((gpr_atm*)(&g_shared_mutables.min_timer),
+                           min_timer);
+#else
+  g_shared_mutables.min_timer = min_timer;
+#endif
+}
+
+static int first_set_bit(uint64_t bits) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(bits);
+#else
+  int i = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    i++;
+  }
+  return i;
+#endif
+}
+
+static int64_t level_unit(int level) {
+  return int64_t(1) << (WHEEL_LEVEL_BITS * level);
+}
+
+static size_t slot_for(grpc_millis tick, int level) {
+  return static_cast<size_t>(tick >> (WHEEL_LEVEL_BITS * level)) &
+         WHEEL_SLOT_MASK;
+}
+
+static void slot_push(wheel_shard* shard, grpc_timer* timer, int level,
+                      size_t slot) {
+  grpc_timer** head = &shard->slots[level][slot];
+  timer->heap_index = static_cast<uint32_t>(level * WHEEL_SLOTS + slot);
+  timer->prev = nullptr;
+  timer->next = *head;
+  if (*head != nullptr) (*head)->prev = timer;
+  *head = timer;
+  shard->occupied[level] |= uint64_t(1) << slot;
+}
+
+/* Detaches and returns the list of timers in a slot */
+static grpc_timer* slot_take(wheel_shard* shard, int level, size_t slot) {
+  grpc_timer* list = shard->slots[level][slot];
+  shard->slots[level][slot] = nullptr;
+  shard->occupied[level] &= ~(uint64_t(1) << slot);
+  return list;
+}
+
+static void timer_unlink(wheel_shard* shard, grpc_timer* timer) {
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else if (timer->heap_index == OVERFLOW_INDEX) {
+    shard->overflow = timer->next;
+  } else {
+    const int level = timer->heap_index / WHEEL_SLOTS;
+    const size_t slot = timer->heap_index % WHEEL_SLOTS;
+    shard->slots[level][slot] = timer->next;
+    if (timer->next == nullptr) {
+      shard->occupied[level] &= ~(uint64_t(1) << slot);
+    }
+  }
+}
+
+/* Tick at which the overflow list has to be brought back onto the wheel */
+static grpc_millis overflow_deadline(wheel_shard* shard) {
+  return shard->overflow == nullptr
+             ? GRPC_MILLIS_INF_FUTURE
+             : shard->overflow_min - WHEEL_HORIZON + 1;
+}
+
+/* Places a timer on the wheel and returns the tick at which it will next be
+   looked at: its deadline if it is on level 0, or the tick at which its slot
+   gets cascaded otherwise.
+   REQUIRES: shard->mu locked */
+static grpc_millis wheel_add(wheel_shard* shard, grpc_timer* timer) {
+  const grpc_millis deadline = GPR_MAX(timer->deadline, shard->next_tick);
+  const int64_t delta = deadline - shard->next_tick;
+  for (int level = 0; level < WHEEL_LEVELS; level++) {
+    if (delta < level_unit(level + 1)) {
+      slot_push(shard, timer, level, slot_for(deadline, level));
+      return deadline & ~(level_unit(level) - 1);
+    }
+  }
+  timer->heap_index = OVERFLOW_INDEX;
+  timer->prev = nullptr;
+  timer->next = shard->overflow;
+  if (shard->overflow != nullptr) shard->overflow->prev = timer;
+  shard->overflow = timer;
+  shard->overflow_min = GPR_MIN(shard->overflow_min, timer->deadline);
+  return overflow_deadline(shard);
+}
+
+/* Returns the first tick at or after shard->next_tick at which a level 0 slot
+   fires or a higher level slot cascades: a lower bound on the deadline of
+   every timer in the shard.
+   REQUIRES: shard->mu locked */
+static grpc_millis next_wheel_event(wheel_shard* shard) {
+  grpc_millis next = overflow_deadline(shard);
+  for (int level = 0; level < WHEEL_LEVELS; level++) {
+    const uint64_t occupied = shard->occupied[level];
+    if (occupied == 0) continue;
+    const int64_t unit = level_unit(level);
+    /* The first tick that this level's slots are looked at is the next
+       multiple of unit; slots before its index belong to the next turn of
+       the wheel. */
+    const grpc_millis base = (shard->next_tick + unit - 1) & ~(unit - 1);
+    const size_t base_slot = slot_for(base, level);
+    const uint64_t ahead = occupied & (~uint64_t(0) << base_slot);
+    const size_t slot = static_cast<size_t>(
+        ahead != 0 ? first_set_bit(ahead)
+                   : first_set_bit(occupied) + WHEEL_SLOTS);
+    next = GPR_MIN(next, base + static_cast<int64_t>(slot - base_slot) * unit);
+  }
+  return next;
+}
+
+static void run_list(grpc_timer* list, grpc_error* error, size_t* count) {
+  while (list != nullptr) {
+    grpc_timer* timer = list;
+    list = list->next;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64, timer, timer->deadline);
+    }
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_REF(error));
+    ++*count;
+  }
+}
+
+/* Re-adds every timer of a list to the wheel */
+static void readd_list(wheel_shard* shard, grpc_timer* list) {
+  while (list != nullptr) {
+    grpc_timer* timer = list;
+    list = list->next;
+    wheel_add(shard, timer);
+  }
+}
+
+/* Processes every tick up to and including now, firing expired timers with
+   error. Returns the number of timers fired.
+   REQUIRES: shard->mu locked */
+static size_t wheel_advance(wheel_shard* shard, grpc_millis now,
+                            grpc_error* error) {
+  size_t n = 0;
+  for (;;) {
+    const grpc_millis tick = next_wheel_event(shard);
+    if (tick > now || tick == GRPC_MILLIS_INF_FUTURE) break;
+    /* Nothing happens on the ticks being skipped, so the wheel can jump
+       straight to this one. */
+    shard->next_tick = tick;
+    if (tick == overflow_deadline(shard)) {
+      grpc_timer* overflow = shard->overflow;
+      shard->overflow = nullptr;
+      shard->overflow_min = GRPC_MILLIS_INF_FUTURE;
+      readd_list(shard, overflow);
+    }
+    for (int level = 1; level < WHEEL_LEVELS; level++) {
+      if (slot_for(tick, level - 1) != 0) break;
+      readd_list(shard, slot_take(shard, level, slot_for(tick, level)));
+    }
+    run_list(slot_take(shard, 0, slot_for(tick, 0)), error, &n);
+    shard->next_tick = tick + 1;
+  }
+  if (now != GRPC_MILLIS_INF_FUTURE) {
+    shard->next_tick = GPR_MAX(shard->next_tick, now + 1);
+  }
+  return n;
+}
+
+static void timer_list_init() {
+  g_num_shards = GPR_CLAMP(2 * gpr_cpu_num_cores(), 1, 32);
+  g_shards =
+      static_cast<wheel_shard*>(gpr_zalloc(g_num_shards * sizeof(*g_shards)));
+
+  g_shared_mutables.initialized = true;
+  g_shared_mutables.checker_mu = GPR_SPINLOCK_INITIALIZER;
+  gpr_mu_init(&g_shared_mutables.mu);
+  g_shared_mutables.min_timer = GRPC_MILLIS_INF_FUTURE;
+
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    shard->next_tick = now;
+    shard->min_deadline = GRPC_MILLIS_INF_FUTURE;
+    shard->overflow_min = GRPC_MILLIS_INF_FUTURE;
+  }
+}
+
+static void timer_list_shutdown() {
+  grpc_error* error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown");
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    size_t n = 0;
+    gpr_mu_lock(&shard->mu);
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+      for (size_t slot = 0; slot < WHEEL_SLOTS; slot++) {
+        run_list(slot_take(shard, level, slot), error, &n);
+      }
+    }
+    run_list(shard->overflow, error, &n);
+    shard->overflow = nullptr;
+    gpr_mu_unlock(&shard->mu);
+    gpr_mu_destroy(&shard->mu);
+  }
+  GRPC_ERROR_UNREF(error);
+  /* Keeps any timer_check that still comes in from touching the shards */
+  gpr_mu_lock(&g_shared_mutables.mu);
+  store_min_timer(GRPC_MILLIS_INF_FUTURE);
+  gpr_mu_unlock(&g_shared_mutables.mu);
+  gpr_mu_destroy(&g_shared_mutables.mu);
+  gpr_free(g_shards);
+  g_shared_mutables.initialized = false;
+}
+
+static void timer_init(grpc_timer* timer, grpc_millis deadline,
+                       grpc_closure* closure) {
+  wheel_shard* shard = &g_shards[GPR_HASH_POINTER(timer, g_num_shards)];
+  timer->closure = closure;
+  timer->deadline = deadline;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline, grpc_core::ExecCtx::Get()->Now(), closure,
+            closure->cb);
+  }
+
+  if (!g_shared_mutables.initialized) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  gpr_mu_lock(&shard->mu);
+  timer->pending = true;
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  if (deadline <= now) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    gpr_mu_unlock(&shard->mu);
+    /* early out */
+    return;
+  }
+  const grpc_millis event = wheel_add(shard, timer);
+  const bool is_first_timer = event < shard->min_deadline;
+  if (is_first_timer) shard->min_deadline = event;
+  gpr_mu_unlock(&shard->mu);
+
+  /* As in timer_generic.cc, a concurrent timer_check may already have
+     computed min_timer from this shard's old min_deadline; lowering it here
+     afterwards is safe either way. */
+  if (is_first_timer) {
+    gpr_mu_lock(&g_shared_mutables.mu);
+    if (event < g_shared_mutables.min_timer) {
+      store_min_timer(event);
+      grpc_kick_poller();
+    }
+    gpr_mu_unlock(&g_shared_mutables.mu);
+  }
+}
+
+static void timer_consume_kick(void) {}
+
+static void timer_cancel(grpc_timer* timer) {
+  if (!g_shared_mutables.initialized) {
+    /* must have already been cancelled, also the shard mutex is invalid */
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[GPR_HASH_POINTER(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+
+  if (timer->pending) {
+    /* min_deadline is left alone: it only needs to be a lower bound. */
+    timer_unlink(shard, timer);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+static grpc_timer_check_result timer_check(grpc_millis* next) {
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_millis min_timer = load_min_timer();
+
+  if (now < min_timer) {
+    if (next != nullptr) *next = GPR_MIN(*next, min_timer);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now, min_timer);
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (!gpr_spinlock_trylock(&g_shared_mutables.checker_mu)) {
+    return GRPC_TIMERS_NOT_CHECKED;
+  }
+  grpc_error* error =
+      now != GRPC_MILLIS_INF_FUTURE
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  gpr_mu_lock(&g_shared_mutables.mu);
+  size_t n = 0;
+  min_timer = GRPC_MILLIS_INF_FUTURE;
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_lock(&shard->mu);
+    if (shard->min_deadline <= now) {
+      n += wheel_advance(shard, now, error);
+      shard->min_deadline = next_wheel_event(shard);
+    }
+    min_timer = GPR_MIN(min_timer, shard->min_deadline);
+    gpr_mu_unlock(&shard->mu);
+  }
+  store_min_timer(min_timer);
+  gpr_mu_unlock(&g_shared_mutables.mu);
+  gpr_spinlock_unlock(&g_shared_mutables.checker_mu);
+  GRPC_ERROR_UNREF(error);
+
+  if (next != nullptr) *next = GPR_MIN(*next, min_timer);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO,
+            "TIMER CHECK END: now=%" PRId64 " fired=%" PRIdPTR
+            " min_timer=%" PRId64,
+            now, n, min_timer);
+  }
+  return n > 0 ? GRPC_TIMERS_FIRED : GRPC_TIMERS_CHECKED_AND_EMPTY;
+}
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
@@ -25,6 +25,15 @@
 #define SO_RXQ_OVFL 40
 #endif
 
+/* UDP segmentation offload (Linux 4.18) and generic receive offload
+ * (Linux 5.0), possibly missing from older libc headers. */
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/iomgr/port.h"
@@ -52,6 +61,7 @@
 #include <grpc/support/time.h>
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/error.h"
@@ -447,17 +457,20 @@ void GrpcUdpListener::do_read(void* arg, grpc_error* error) {
   gpr_mu_lock(sp->mutex());
   /* Tell the registered callback that data is available to read. */
   if (!sp->already_shutdown_ && sp->udp_handler_->Read()) {
+    gpr_mu_unlock(sp->mutex());
     /* There maybe more packets to read. Schedule read_more_cb_ closure to run
-     * after finishing this event loop. */
+     * after finishing this event loop. The lock is dropped first: when every
+     * executor thread is busy with a long job, Executor::Run() spins until one
+     * frees up, and one of them may be a do_write() waiting for this lock. */
     grpc_core::Executor::Run(&sp->do_read_closure_, GRPC_ERROR_NONE,
                              grpc_core::ExecutorType::DEFAULT,
                              grpc_core::ExecutorJobType::LONG);
-  } else {
-    /* Finish reading all the packets, re-arm the notification event so we can
-     * get another chance to read. Or fd already shutdown, re-arm to get a
-     * notification with shutdown error. */
-    grpc_fd_notify_on_read(sp->emfd_, &sp->read_closure_);
+    return;
   }
+  /* Finish reading all the packets, re-arm the notification event so we can
+   * get another chance to read. Or fd already shutdown, re-arm to get a
+   * notification with shutdown error. */
+  grpc_fd_notify_on_read(sp->emfd_, &sp->read_closure_);
   gpr_mu_unlock(sp->mutex());
 }
 
@@ -749,4 +762,263 @@ void GrpcUdpListener::OnDestroy() {
   }
 }
 
+#ifdef GRPC_LINUX_MMSG
+typedef struct mmsghdr grpc_mmsghdr;
+#else
+/* Same layout as Linux's struct mmsghdr, filled one recvmsg() or sendmsg() at
+ * a time. */
+typedef struct {
+  struct msghdr msg_hdr;
+  unsigned int msg_len;
+} grpc_mmsghdr;
+#endif /* GRPC_LINUX_MMSG */
+
+/* Largest datagram handed back by GRO, along with its UDP header. */
+#define GRO_BUFFER_SIZE 65536
+/* Room for the UDP_GRO, packet info and SO_RXQ_OVFL control messages. */
+#define RECV_CONTROL_SIZE 128
+/* Most datagrams passed to a single sendmmsg() call */
+#define MAX_SEND_BATCH_SIZE 64
+/* Kernel limit on segments per UDP_SEGMENT send */
+#define MAX_GSO_SEGMENTS 64
+
+/* Receive buffers of a GrpcUdpBatchHandler, reused by every Read(). */
+struct GrpcUdpBatchHandler::RecvBatch {
+  RecvBatch(size_t batch_size, size_t buffer_size)
+      : buffer_size(buffer_size),
+        buffers(static_cast<char*>(gpr_malloc(batch_size * buffer_size))),
+        control(static_cast<char*>(
+            gpr_malloc(batch_size * RECV_CONTROL_SIZE))),
+        iovs(static_cast<struct iovec*>(
+            gpr_malloc(batch_size * sizeof(struct iovec)))),
+        peers(static_cast<grpc_resolved_address*>(
+            gpr_malloc(batch_size * sizeof(grpc_resolved_address)))),
+        msgs(static_cast<grpc_mmsghdr*>(
+            gpr_malloc(batch_size * sizeof(grpc_mmsghdr)))) {}
+
+  ~RecvBatch() {
+    gpr_free(msgs);
+    gpr_free(peers);
+    gpr_free(iovs);
+    gpr_free(control);
+    gpr_free(buffers);
+  }
+
+  /* Prepares message i to receive a datagram. */
+  void Reset(size_t i) {
+    iovs[i].iov_base = buffers + i * buffer_size;
+    iovs[i].iov_len = buffer_size;
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_name = peers[i].addr;
+    msgs[i].msg_hdr.msg_namelen =
+        static_cast<socklen_t>(sizeof(peers[i].addr));
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = control + i * RECV_CONTROL_SIZE;
+    msgs[i].msg_hdr.msg_controllen = RECV_CONTROL_SIZE;
+  }
+
+  const size_t buffer_size;
+  char* const buffers;
+  char* const control;
+  struct iovec* const iovs;
+  grpc_resolved_address* const peers;
+  grpc_mmsghdr* const msgs;
+};
+
+GrpcUdpBatchHandler::GrpcUdpBatchHandler(grpc_fd* emfd, void* user_data,
+                                         size_t batch_size,
+                                         size_t max_datagram_size,
+                                         bool enable_gro)
+    : GrpcUdpHandler(emfd, user_data),
+      emfd_(emfd),
+      batch_size_(GPR_MAX(batch_size, 1)),
+      gro_enabled_(false),
+      gso_supported_(false) {
+#ifdef GPR_LINUX
+  int fd = grpc_fd_wrapped_fd(emfd);
+  if (enable_gro) {
+    int one = 1;
+    gro_enabled_ =
+        setsockopt(fd, IPPROTO_UDP, UDP_GRO, &one, sizeof(one)) == 0;
+    if (!gro_enabled_) {
+      gpr_log(GPR_INFO, "UDP_GRO unavailable on fd %d: %s", fd,
+              strerror(errno));
+    }
+  }
+  /* A zero segment size is a no-op, which makes it a cheap probe. */
+  int zero = 0;
+  gso_supported_ =
+      setsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &zero, sizeof(zero)) == 0;
+#else
+  (void)enable_gro;
+#endif /* GPR_LINUX */
+  recv_batch_ = grpc_core::MakeUnique<RecvBatch>(
+      batch_size_, gro_enabled_ ? GRO_BUFFER_SIZE : max_datagram_size);
+}
+
+GrpcUdpBatchHandler::~GrpcUdpBatchHandler() {}
+
+/* Returns the GRO segment size of a received message, or 0 if the kernel did
+ * not coalesce it. */
+static size_t get_gro_segment_size(struct msghdr* msg) {
+#ifdef GPR_LINUX
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int segment_size;
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return segment_size > 0 ? static_cast<size_t>(segment_size) : 0;
+    }
+  }
+#else
+  (void)msg;
+#endif /* GPR_LINUX */
+  return 0;
+}
+
+bool GrpcUdpBatchHandler::Read() {
+  RecvBatch* batch = recv_batch_.get();
+  int fd = grpc_fd_wrapped_fd(emfd_);
+  for (size_t i = 0; i < batch_size_; ++i) {
+    batch->Reset(i);
+  }
+  size_t count = 0;
+#ifdef GRPC_LINUX_MMSG
+  int r;
+  do {
+    r = recvmmsg(fd, batch->msgs, static_cast<unsigned int>(batch_size_), 0,
+                 nullptr);
+  } while (r < 0 && errno == EINTR);
+  if (r > 0) count = static_cast<size_t>(r);
+#else
+  for (; count < batch_size_; ++count) {
+    ssize_t r;
+    do {
+      r = recvmsg(fd, &batch->msgs[count].msg_hdr, 0);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) break;
+    batch->msgs[count].msg_len = static_cast<unsigned int>(r);
+  }
+#endif /* GRPC_LINUX_MMSG */
+  if (count == 0) {
+    return false;
+  }
+
+  grpc_core::InlinedVector<GrpcUdpDatagram, kDefaultBatchSize> datagrams;
+  for (size_t i = 0; i < count; ++i) {
+    struct msghdr* hdr = &batch->msgs[i].msg_hdr;
+    batch->peers[i].len = hdr->msg_namelen;
+    const char* data = static_cast<const char*>(batch->iovs[i].iov_base);
+    size_t length = batch->msgs[i].msg_len;
+    size_t segment_size = get_gro_segment_size(hdr);
+    if (segment_size == 0) segment_size = length;
+    for (size_t offset = 0; offset < length; offset += segment_size) {
+      GrpcUdpDatagram datagram = {
+          data + offset, GPR_MIN(segment_size, length - offset),
+          &batch->peers[i]};
+      datagrams.push_back(datagram);
+    }
+  }
+  OnDatagrams(datagrams.data(), datagrams.size());
+  return count == batch_size_;
+}
+
+static void fill_send_msghdr(const GrpcUdpDatagram& datagram,
+                             struct iovec* iov, struct msghdr* hdr) {
+  iov->iov_base = const_cast<char*>(datagram.data);
+  iov->iov_len = datagram.length;
+  memset(hdr, 0, sizeof(*hdr));
+  if (datagram.peer != nullptr) {
+    hdr->msg_name = const_cast<char*>(datagram.peer->addr);
+    hdr->msg_namelen = datagram.peer->len;
+  }
+  hdr->msg_iov = iov;
+  hdr->msg_iovlen = 1;
+}
+
+int GrpcUdpBatchHandler::SendDatagrams(const GrpcUdpDatagram* datagrams,
+                                       size_t count) {
+  int fd = grpc_fd_wrapped_fd(emfd_);
+  grpc_mmsghdr msgs[MAX_SEND_BATCH_SIZE];
+  struct iovec iovs[MAX_SEND_BATCH_SIZE];
+  size_t sent = 0;
+  while (sent < count) {
+    size_t n =
+        GPR_MIN(count - sent, static_cast<size_t>(MAX_SEND_BATCH_SIZE));
+    for (size_t i = 0; i < n; ++i) {
+      fill_send_msghdr(datagrams[sent + i], &iovs[i], &msgs[i].msg_hdr);
+    }
+    int r;
+#ifdef GRPC_LINUX_MMSG
+    do {
+      r = sendmmsg(fd, msgs, static_cast<unsigned int>(n), 0);
+    } while (r < 0 && errno == EINTR);
+#else
+    for (r = 0; static_cast<size_t>(r) < n; ++r) {
+      ssize_t w;
+      do {
+        w = sendmsg(fd, &msgs[r].msg_hdr, 0);
+      } while (w < 0 && errno == EINTR);
+      if (w < 0) break;
+    }
+    if (r == 0) r = -1;
+#endif /* GRPC_LINUX_MMSG */
+    if (r < 0) {
+      return sent == 0 ? -1 : static_cast<int>(sent);
+    }
+    sent += static_cast<size_t>(r);
+    if (static_cast<size_t>(r) < n) break;
+  }
+  return static_cast<int>(sent);
+}
+
+ssize_t GrpcUdpBatchHandler::SendSegmented(const grpc_resolved_address* peer,
+                                           const char* data, size_t length,
+                                           size_t segment_size) {
+  GPR_ASSERT(segment_size > 0);
+#ifdef GPR_LINUX
+  if (gso_supported_ && length > segment_size &&
+      length <= segment_size * MAX_GSO_SEGMENTS) {
+    GrpcUdpDatagram datagram = {data, length, peer};
+    struct iovec iov;
+    struct msghdr hdr;
+    fill_send_msghdr(datagram, &iov, &hdr);
+    char control[CMSG_SPACE(sizeof(uint16_t))];
+    memset(control, 0, sizeof(control));
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = IPPROTO_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t gso_size = static_cast<uint16_t>(segment_size);
+    memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    ssize_t r;
+    do {
+      r = sendmsg(grpc_fd_wrapped_fd(emfd_), &hdr, 0);
+    } while (r < 0 && errno == EINTR);
+    /* EIO means the device cannot checksum segmented packets. */
+    if (r >= 0 || errno != EIO) {
+      return r;
+    }
+    gpr_log(GPR_INFO, "UDP_SEGMENT unsupported by device, disabling GSO");
+    gso_supported_ = false;
+  }
+#endif /* GPR_LINUX */
+  grpc_core::InlinedVector<GrpcUdpDatagram, MAX_SEND_BATCH_SIZE> datagrams;
+  for (size_t offset = 0; offset < length; offset += segment_size) {
+    GrpcUdpDatagram datagram = {data + offset,
+                                GPR_MIN(segment_size, length - offset), peer};
+    datagrams.push_back(datagram);
+  }
+  int r = SendDatagrams(datagrams.data(), datagrams.size());
+  if (r < 0) return -1;
+  ssize_t bytes = 0;
+  for (int i = 0; i < r; ++i) {
+    bytes += static_cast<ssize_t>(datagrams[i].length);
+  }
+  return bytes;
+}
+
 #endif
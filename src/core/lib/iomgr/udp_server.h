@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
+
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/resolve_address.h"
@@ -58,6 +60,67 @@ class GrpcUdpHandler {
                                  void* user_data) = 0;
 };
 
+/* A datagram received by GrpcUdpBatchHandler, or to be sent by it. */
+struct GrpcUdpDatagram {
+  const char* data;
+  size_t length;
+  /* Source address of a received datagram, destination of a sent one. */
+  const grpc_resolved_address* peer;
+};
+
+/* A GrpcUdpHandler which reads up to |batch_size| datagrams per syscall with
+ * recvmmsg() where available, and delivers each batch to OnDatagrams().
+ *
+ * If |enable_gro| is set and the kernel supports UDP_GRO, consecutive
+ * datagrams from the same peer may be coalesced by the kernel into one buffer.
+ * They are split back into individual datagrams before delivery, so
+ * subclasses do not need to care. Each receive buffer is 64KiB in that case,
+ * and |max_datagram_size| bytes otherwise. */
+class GrpcUdpBatchHandler : public GrpcUdpHandler {
+ public:
+  static constexpr size_t kDefaultBatchSize = 32;
+  static constexpr size_t kDefaultMaxDatagramSize = 2048;
+
+  GrpcUdpBatchHandler(grpc_fd* emfd, void* user_data,
+                      size_t batch_size = kDefaultBatchSize,
+                      size_t max_datagram_size = kDefaultMaxDatagramSize,
+                      bool enable_gro = false);
+  ~GrpcUdpBatchHandler() override;
+
+  // Reads one batch and hands it to OnDatagrams(). Returns true if the batch
+  // was full, in which case more datagrams are likely pending.
+  bool Read() override;
+
+  // Called with the datagrams read from the socket. |datagrams| and the data
+  // and peers they point to are only valid for the duration of the call.
+  virtual void OnDatagrams(const GrpcUdpDatagram* datagrams, size_t count) = 0;
+
+  // Sends |count| datagrams with as few syscalls as possible (sendmmsg() where
+  // available). Returns the number of datagrams sent, which is less than
+  // |count| if the socket would block, or -1 with errno set if the first
+  // datagram could not be sent.
+  int SendDatagrams(const GrpcUdpDatagram* datagrams, size_t count);
+
+  // Sends |length| bytes to |peer| as consecutive datagrams of at most
+  // |segment_size| bytes. With UDP_SEGMENT (GSO) support in the kernel this is
+  // a single syscall; otherwise it falls back to SendDatagrams(). Returns the
+  // number of bytes sent, or -1 with errno set.
+  ssize_t SendSegmented(const grpc_resolved_address* peer, const char* data,
+                        size_t length, size_t segment_size);
+
+ protected:
+  grpc_fd* emfd() const { return emfd_; }
+
+ private:
+  struct RecvBatch;
+
+  grpc_fd* emfd_;
+  size_t batch_size_;
+  bool gro_enabled_;
+  bool gso_supported_;
+  std::unique_ptr<RecvBatch> recv_batch_;
+};
+
 class GrpcUdpHandlerFactory {
  public:
   virtual ~GrpcUdpHandlerFactory() {}
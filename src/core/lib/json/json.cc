@@ -25,6 +25,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/json/json.h"
 
 grpc_json* grpc_json_create(grpc_json_type type) {
@@ -34,6 +35,40 @@ grpc_json* grpc_json_create(grpc_json_type type) {
   return json;
 }
 
+/* Blocks start small, for the many tiny documents we parse, and double up to
+ * a bound. */
+#define MIN_BLOCK_OBJECTS 16
+#define MAX_BLOCK_OBJECTS 1024
+
+struct grpc_json_block {
+  struct grpc_json_block* next;
+  size_t used;
+  size_t capacity;
+  grpc_json objects[1];
+};
+
+grpc_json* grpc_json_create_in_blocks(grpc_json_block** blocks,
+                                      grpc_json_type type) {
+  grpc_json_block* block = *blocks;
+  if (block == nullptr || block->used == block->capacity) {
+    size_t capacity =
+        block == nullptr ? MIN_BLOCK_OBJECTS
+                         : GPR_MIN(block->capacity * 2, MAX_BLOCK_OBJECTS);
+    block = static_cast<grpc_json_block*>(gpr_malloc(
+        sizeof(grpc_json_block) + (capacity - 1) * sizeof(grpc_json)));
+    block->next = *blocks;
+    block->used = 0;
+    block->capacity = capacity;
+    *blocks = block;
+  }
+  grpc_json* json = &block->objects[block->used++];
+  memset(json, 0, sizeof(*json));
+  json->type = type;
+  json->in_block = true;
+
+  return json;
+}
+
 void grpc_json_destroy(grpc_json* json) {
   if (json == nullptr) return;
   while (json->child) {
@@ -50,7 +85,15 @@ void grpc_json_destroy(grpc_json* json) {
   if (json->owns_value) {
     gpr_free((void*)json->value);
   }
-  gpr_free(json);
+  grpc_json_block* blocks = json->blocks;
+  if (!json->in_block) {
+    gpr_free(json);
+  }
+  while (blocks != nullptr) {
+    grpc_json_block* next = blocks->next;
+    gpr_free(blocks);
+    blocks = next;
+  }
 }
 
 grpc_json* grpc_json_link_child(grpc_json* parent, grpc_json* child,
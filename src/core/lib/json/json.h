@@ -41,6 +41,12 @@ typedef struct grpc_json {
 
   /* if set, destructor will free value */
   bool owns_value;
+  /* if set, the object is part of a block of objects, and is only freed with
+   * the block */
+  bool in_block;
+  /* set on the root of a parsed tree: the blocks its objects are in, which
+   * are freed along with it */
+  struct grpc_json_block* blocks;
 } grpc_json;
 
 /* The next two functions are going to parse the input string, and
@@ -77,6 +83,13 @@ char* grpc_json_dump_to_string(const grpc_json* json, int indent);
 grpc_json* grpc_json_create(grpc_json_type type);
 void grpc_json_destroy(grpc_json* json);
 
+/* Same as grpc_json_create, but takes the object from the blocks in *blocks,
+ * adding a block to them when they are full, so that the objects of a large
+ * tree take a handful of allocations. The caller sets the root's blocks to
+ * *blocks once the tree is complete. */
+grpc_json* grpc_json_create_in_blocks(struct grpc_json_block** blocks,
+                                      grpc_json_type type);
+
 /* Links the child json object into the parent's json tree. If the parent
  * already has children, then passing in the most recently added child as the
  * sibling parameter is an optimization. For if sibling is NULL, this function
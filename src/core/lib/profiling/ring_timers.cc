@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/profiling/timers.h"
+
+#ifdef GRPC_TIMER_TRACE
+
+#include <new>
+
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Rings are claimed by threads as they record their first event and are
+// never given back, so threads past the kMaxThreads-th are not traced.
+constexpr size_t kMaxThreads = 256;
+constexpr size_t kEventsPerThread = 8192;
+
+// Fields are atomic only so that Write() may race with a late writer; the
+// writer owns its ring and uses relaxed stores.
+struct Event {
+  std::atomic<const char*> tag;
+  std::atomic<gpr_cycle_counter> time;
+  std::atomic<char> type;
+};
+
+struct Ring {
+  std::atomic<uint64_t> head{0};
+  Event events[kEventsPerThread];
+};
+
+std::atomic<Ring*> g_rings[kMaxThreads];
+std::atomic<size_t> g_num_rings{0};
+std::atomic<gpr_cycle_counter> g_start_time{0};
+gpr_once g_once = GPR_ONCE_INIT;
+
+// The thread's Ring, or kNoRing once the pool ran out.
+GPR_TLS_DECL(g_thread_ring);
+Ring* const kNoRing = reinterpret_cast<Ring*>(1);
+
+void InitThreadRing() { gpr_tls_init(&g_thread_ring); }
+
+Ring* ThreadRing() {
+  Ring* ring = reinterpret_cast<Ring*>(gpr_tls_get(&g_thread_ring));
+  if (GPR_LIKELY(ring != nullptr)) return ring == kNoRing ? nullptr : ring;
+  size_t index = g_num_rings.fetch_add(1, std::memory_order_relaxed);
+  if (index >= kMaxThreads) {
+    gpr_tls_set(&g_thread_ring, reinterpret_cast<intptr_t>(kNoRing));
+    return nullptr;
+  }
+  // Not gpr_malloc: it is timed itself.
+  ring = new (std::nothrow) Ring();
+  if (ring == nullptr) {
+    gpr_tls_set(&g_thread_ring, reinterpret_cast<intptr_t>(kNoRing));
+    return nullptr;
+  }
+  g_rings[index].store(ring, std::memory_order_release);
+  gpr_tls_set(&g_thread_ring, reinterpret_cast<intptr_t>(ring));
+  return ring;
+}
+
+double MicrosSinceStart(gpr_cycle_counter time, gpr_cycle_counter start) {
+  gpr_timespec since = gpr_cycle_counter_sub(time, start);
+  return static_cast<double>(since.tv_sec) * GPR_US_PER_SEC +
+         static_cast<double>(since.tv_nsec) / GPR_NS_PER_US;
+}
+
+// Writes the events of \a ring recorded since \a start as the thread \a tid.
+void WriteRing(FILE* out, const Ring* ring, size_t tid,
+               gpr_cycle_counter start, bool* first) {
+  uint64_t end = ring->head.load(std::memory_order_acquire);
+  uint64_t begin = end > kEventsPerThread ? end - kEventsPerThread : 0;
+  struct Copy {
+    const char* tag;
+    gpr_cycle_counter time;
+    char type;
+  };
+  Copy* copies = new Copy[end - begin];
+  for (uint64_t i = begin; i < end; i++) {
+    const Event& event = ring->events[i % kEventsPerThread];
+    Copy& copy = copies[i - begin];
+    copy.tag = event.tag.load(std::memory_order_relaxed);
+    copy.time = event.time.load(std::memory_order_relaxed);
+    copy.type = event.type.load(std::memory_order_relaxed);
+  }
+  // Drop the events a late writer may have overwritten while we copied.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t now_end = ring->head.load(std::memory_order_relaxed);
+  uint64_t valid = now_end > kEventsPerThread ? now_end - kEventsPerThread : 0;
+  // Ends whose begin was overwritten, or predates Start(), would close the
+  // wrong scope.
+  size_t depth = 0;
+  for (uint64_t i = GPR_MAX(begin, valid); i < end; i++) {
+    const Copy& copy = copies[i - begin];
+    if (copy.time < start) continue;
+    if (copy.type == TimerTrace::kBegin) {
+      depth++;
+    } else if (copy.type == TimerTrace::kEnd) {
+      if (depth == 0) continue;
+      depth--;
+    }
+    fprintf(out,
+            "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,"
+            "\"tid\":%d%s}",
+            *first ? "" : ",", copy.tag, copy.type,
+            MicrosSinceStart(copy.time, start), static_cast<int>(tid),
+            copy.type == TimerTrace::kMark ? ",\"s\":\"t\"" : "");
+    *first = false;
+  }
+  delete[] copies;
+}
+
+}  // namespace
+
+std::atomic<bool> TimerTrace::enabled_{false};
+
+void TimerTrace::Start() {
+  gpr_once_init(&g_once, InitThreadRing);
+  g_start_time.store(gpr_get_cycle_counter(), std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_release);
+}
+
+void TimerTrace::Stop() { enabled_.store(false, std::memory_order_relaxed); }
+
+bool TimerTrace::Write(FILE* out) {
+  gpr_cycle_counter start = g_start_time.load(std::memory_order_relaxed);
+  size_t num_rings =
+      GPR_MIN(g_num_rings.load(std::memory_order_relaxed), kMaxThreads);
+  bool first = true;
+  fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (size_t i = 0; i < num_rings; i++) {
+    const Ring* ring = g_rings[i].load(std::memory_order_acquire);
+    // Claimed, but not yet published or out of memory.
+    if (ring == nullptr) continue;
+    WriteRing(out, ring, i + 1, start, &first);
+  }
+  fprintf(out, "\n]}\n");
+  return fflush(out) == 0 && !ferror(out);
+}
+
+void TimerTrace::Record(const char* tag, EventType type) {
+  Ring* ring = ThreadRing();
+  if (ring == nullptr) return;
+  uint64_t head = ring->head.load(std::memory_order_relaxed);
+  Event& event = ring->events[head % kEventsPerThread];
+  event.tag.store(tag, std::memory_order_relaxed);
+  event.time.store(gpr_get_cycle_counter(), std::memory_order_relaxed);
+  event.type.store(type, std::memory_order_relaxed);
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+}  // namespace grpc_core
+
+#endif /* GRPC_TIMER_TRACE */
@@ -35,14 +35,82 @@ void gpr_timer_set_enabled(int enabled);
 
 #if !(defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER) + \
       defined(GRPC_CUSTOM_PROFILER))
-/* No profiling. No-op all the things. */
-#define GPR_TIMER_MARK(tag, important) \
-  do {                                 \
+/* No profiler built in: timers go to the trace ring, which is off until
+   grpc_core::TimerTrace::Start() is called. */
+#define GRPC_TIMER_TRACE 1
+
+#include <grpc/support/port_platform.h>
+
+#include <stdio.h>
+
+#include <atomic>
+
+namespace grpc_core {
+
+/// Records GPR_TIMER_SCOPE and GPR_TIMER_MARK events, while started, into a
+/// ring per thread, and writes the last events of each thread out as a
+/// Chrome trace (JSON), which chrome://tracing and the Perfetto UI load.
+///
+/// Recording an event takes no lock and makes no allocation after the
+/// thread's first event; while stopped, a timer costs a relaxed load.
+class TimerTrace {
+ public:
+  enum EventType : char { kBegin = 'B', kEnd = 'E', kMark = 'i' };
+
+  /// Starts recording; events recorded before are not written out.
+  static void Start();
+  static void Stop();
+  static bool enabled() {
+    return GPR_UNLIKELY(enabled_.load(std::memory_order_relaxed));
+  }
+
+  /// Writes the events recorded since the last Start(). Call it after
+  /// Stop(): events recorded meanwhile may be lost. Returns false on I/O
+  /// errors.
+  static bool Write(FILE* out);
+
+  static void Record(const char* tag, EventType type);
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace grpc_core
+
+#define GPR_TIMER_MARK(tag, important)                                    \
+  do {                                                                    \
+    if (grpc_core::TimerTrace::enabled()) {                               \
+      grpc_core::TimerTrace::Record((tag), grpc_core::TimerTrace::kMark); \
+    }                                                                     \
   } while (0)
 
+namespace grpc {
+class ProfileScope {
+ public:
+  explicit ProfileScope(const char* desc) : desc_(nullptr) {
+    if (grpc_core::TimerTrace::enabled()) {
+      desc_ = desc;
+      grpc_core::TimerTrace::Record(desc_, grpc_core::TimerTrace::kBegin);
+    }
+  }
+  // Ends the scopes begun while recording, even if recording stopped since,
+  // so that begins and ends pair up.
+  ~ProfileScope() {
+    if (desc_ != nullptr) {
+      grpc_core::TimerTrace::Record(desc_, grpc_core::TimerTrace::kEnd);
+    }
+  }
+
+ private:
+  const char* desc_;
+};
+}  // namespace grpc
+
+#define GPR_TIMER_SCOPE_NAME_INTERNAL(prefix, line) prefix##line
+#define GPR_TIMER_SCOPE_NAME(prefix, line) \
+  GPR_TIMER_SCOPE_NAME_INTERNAL(prefix, line)
 #define GPR_TIMER_SCOPE(tag, important) \
-  do {                                  \
-  } while (0)
+  ::grpc::ProfileScope GPR_TIMER_SCOPE_NAME(_profile_scope_, __LINE__)((tag))
 
 #else /* at least one profiler requested... */
 /* ... hopefully only one. */
@@ -61,6 +61,14 @@ typedef enum {
 #define GRPC_IAM_AUTHORITY_SELECTOR_METADATA_KEY "x-goog-iam-authority-selector"
 
 #define GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS 60
+/* Tokens are refreshed in the background, while calls keep using the cached
+   token, from this long before they expire plus a random jitter of up to
+   GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_JITTER_SECS, or from half their
+   lifetime if that is shorter. */
+#define GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_SECS 300
+#define GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_JITTER_SECS 60
+/* Delay before a failed background refresh is retried. */
+#define GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_RETRY_SECS 10
 
 #define GRPC_COMPUTE_ENGINE_METADATA_HOST "metadata.google.internal."
 #define GRPC_COMPUTE_ENGINE_METADATA_TOKEN_PATH \
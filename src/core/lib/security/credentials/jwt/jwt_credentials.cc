@@ -25,6 +25,7 @@
 
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/surface/api_trace.h"
 
 #include <grpc/support/alloc.h>
@@ -32,66 +33,137 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 
-void grpc_service_account_jwt_access_credentials::reset_cache() {
-  GRPC_MDELEM_UNREF(cached_.jwt_md);
-  cached_.jwt_md = GRPC_MDNULL;
-  if (cached_.service_url != nullptr) {
-    gpr_free(cached_.service_url);
-    cached_.service_url = nullptr;
-  }
-  cached_.jwt_expiration = gpr_inf_past(GPR_CLOCK_REALTIME);
-}
-
 grpc_service_account_jwt_access_credentials::
     ~grpc_service_account_jwt_access_credentials() {
   grpc_auth_json_key_destruct(&key_);
-  reset_cache();
+  for (CacheEntry& entry : cache_) {
+    GRPC_MDELEM_UNREF(entry.jwt_md);
+  }
   gpr_mu_destroy(&cache_mu_);
 }
 
+grpc_mdelem grpc_service_account_jwt_access_credentials::sign_jwt(
+    const char* service_url, gpr_timespec* expiration) {
+  char* jwt =
+      grpc_jwt_encode_and_sign(&key_, service_url, jwt_lifetime_, nullptr);
+  if (jwt == nullptr) return GRPC_MDNULL;
+  char* md_value;
+  gpr_asprintf(&md_value, "Bearer %s", jwt);
+  gpr_free(jwt);
+  *expiration = gpr_time_add(gpr_now(GPR_CLOCK_REALTIME), jwt_lifetime_);
+  grpc_mdelem jwt_md = grpc_mdelem_from_slices(
+      grpc_slice_from_static_string(GRPC_AUTHORIZATION_METADATA_KEY),
+      grpc_slice_from_copied_string(md_value));
+  gpr_free(md_value);
+  return jwt_md;
+}
+
+void grpc_service_account_jwt_access_credentials::cache_jwt_locked(
+    const char* service_url, grpc_mdelem jwt_md, gpr_timespec expiration) {
+  auto it = cache_index_.find(service_url);
+  if (it != cache_index_.end()) {
+    CacheEntry& entry = *it->second;
+    GRPC_MDELEM_UNREF(entry.jwt_md);
+    entry.jwt_md = jwt_md;
+    entry.jwt_expiration = expiration;
+    entry.refreshing = false;
+    cache_.splice(cache_.begin(), cache_, it->second);
+    return;
+  }
+  if (cache_.size() >= GRPC_JWT_CACHE_MAX_ENTRIES) {
+    CacheEntry& lru = cache_.back();
+    GRPC_MDELEM_UNREF(lru.jwt_md);
+    cache_index_.erase(lru.service_url);
+    cache_.pop_back();
+  }
+  cache_.push_front(CacheEntry{service_url, jwt_md, expiration, false});
+  cache_index_[service_url] = cache_.begin();
+}
+
+namespace {
+
+struct jwt_refresh_args {
+  grpc_core::RefCountedPtr<grpc_call_credentials> creds;
+  std::string service_url;
+  grpc_closure closure;
+};
+
+}  // namespace
+
+void grpc_service_account_jwt_access_credentials::refresh_jwt(
+    void* arg, grpc_error* /*error*/) {
+  jwt_refresh_args* args = static_cast<jwt_refresh_args*>(arg);
+  auto* creds = static_cast<grpc_service_account_jwt_access_credentials*>(
+      args->creds.get());
+  gpr_timespec expiration;
+  grpc_mdelem jwt_md = creds->sign_jwt(args->service_url.c_str(), &expiration);
+  gpr_mu_lock(&creds->cache_mu_);
+  if (!GRPC_MDISNULL(jwt_md)) {
+    creds->cache_jwt_locked(args->service_url.c_str(), jwt_md, expiration);
+  } else {
+    // Calls keep using the cached jwt, and retry the refresh.
+    auto it = creds->cache_index_.find(args->service_url);
+    if (it != creds->cache_index_.end()) it->second->refreshing = false;
+  }
+  gpr_mu_unlock(&creds->cache_mu_);
+  delete args;
+}
+
 bool grpc_service_account_jwt_access_credentials::get_request_metadata(
     grpc_polling_entity* /*pollent*/, grpc_auth_metadata_context context,
     grpc_credentials_mdelem_array* md_array,
     grpc_closure* /*on_request_metadata*/, grpc_error** error) {
   gpr_timespec refresh_threshold = gpr_time_from_seconds(
       GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS, GPR_TIMESPAN);
+  // Past this point before expiry, the jwt is re-signed off the call path
+  // while calls keep using it.
+  gpr_timespec background_refresh_threshold = gpr_time_from_millis(
+      GPR_MIN(GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_SECS * GPR_MS_PER_SEC,
+              gpr_time_to_millis(jwt_lifetime_) / 2),
+      GPR_TIMESPAN);
 
   /* See if we can return a cached jwt. */
   grpc_mdelem jwt_md = GRPC_MDNULL;
+  bool start_refresh = false;
   {
     gpr_mu_lock(&cache_mu_);
-    if (cached_.service_url != nullptr &&
-        strcmp(cached_.service_url, context.service_url) == 0 &&
-        !GRPC_MDISNULL(cached_.jwt_md) &&
-        (gpr_time_cmp(
-             gpr_time_sub(cached_.jwt_expiration, gpr_now(GPR_CLOCK_REALTIME)),
-             refresh_threshold) > 0)) {
-      jwt_md = GRPC_MDELEM_REF(cached_.jwt_md);
+    auto it = cache_index_.find(context.service_url);
+    if (it != cache_index_.end()) {
+      CacheEntry& entry = *it->second;
+      gpr_timespec remaining =
+          gpr_time_sub(entry.jwt_expiration, gpr_now(GPR_CLOCK_REALTIME));
+      if (gpr_time_cmp(remaining, refresh_threshold) > 0) {
+        jwt_md = GRPC_MDELEM_REF(entry.jwt_md);
+        cache_.splice(cache_.begin(), cache_, it->second);
+        if (!entry.refreshing &&
+            gpr_time_cmp(remaining, background_refresh_threshold) <= 0) {
+          entry.refreshing = true;
+          start_refresh = true;
+        }
+      }
     }
     gpr_mu_unlock(&cache_mu_);
   }
 
+  if (start_refresh) {
+    jwt_refresh_args* args = new jwt_refresh_args();
+    args->creds = Ref();
+    args->service_url = context.service_url;
+    grpc_core::Executor::Run(
+        GRPC_CLOSURE_INIT(&args->closure, refresh_jwt, args, nullptr),
+        GRPC_ERROR_NONE);
+  }
+
   if (GRPC_MDISNULL(jwt_md)) {
-    char* jwt = nullptr;
     /* Generate a new jwt. */
-    gpr_mu_lock(&cache_mu_);
-    reset_cache();
-    jwt = grpc_jwt_encode_and_sign(&key_, context.service_url, jwt_lifetime_,
-                                   nullptr);
-    if (jwt != nullptr) {
-      char* md_value;
-      gpr_asprintf(&md_value, "Bearer %s", jwt);
-      gpr_free(jwt);
-      cached_.jwt_expiration =
-          gpr_time_add(gpr_now(GPR_CLOCK_REALTIME), jwt_lifetime_);
-      cached_.service_url = gpr_strdup(context.service_url);
-      cached_.jwt_md = grpc_mdelem_from_slices(
-          grpc_slice_from_static_string(GRPC_AUTHORIZATION_METADATA_KEY),
-          grpc_slice_from_copied_string(md_value));
-      gpr_free(md_value);
-      jwt_md = GRPC_MDELEM_REF(cached_.jwt_md);
+    gpr_timespec expiration;
+    jwt_md = sign_jwt(context.service_url, &expiration);
+    if (!GRPC_MDISNULL(jwt_md)) {
+      gpr_mu_lock(&cache_mu_);
+      cache_jwt_locked(context.service_url, GRPC_MDELEM_REF(jwt_md),
+                       expiration);
+      gpr_mu_unlock(&cache_mu_);
     }
-    gpr_mu_unlock(&cache_mu_);
   }
 
   if (!GRPC_MDISNULL(jwt_md)) {
@@ -121,7 +193,6 @@ grpc_service_account_jwt_access_credentials::
   }
   jwt_lifetime_ = token_lifetime;
   gpr_mu_init(&cache_mu_);
-  reset_cache();
 }
 
 grpc_core::RefCountedPtr<grpc_call_credentials>
@@ -21,9 +21,16 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <list>
+#include <map>
+#include <string>
+
 #include "src/core/lib/security/credentials/credentials.h"
 #include "src/core/lib/security/credentials/jwt/json_token.h"
 
+// Maximum number of audiences whose signed jwts are cached.
+#define GRPC_JWT_CACHE_MAX_ENTRIES 64
+
 class grpc_service_account_jwt_access_credentials
     : public grpc_call_credentials {
  public:
@@ -44,16 +51,28 @@ class grpc_service_account_jwt_access_credentials
   const grpc_auth_json_key& key() const { return key_; }
 
  private:
-  void reset_cache();
+  struct CacheEntry {
+    std::string service_url;
+    grpc_mdelem jwt_md;
+    gpr_timespec jwt_expiration;
+    // Whether the jwt is being re-signed in the background.
+    bool refreshing;
+  };
+  using CacheList = std::list<CacheEntry>;
 
-  // Have a simple cache for now with just 1 entry. We could have a map based on
-  // the service_url for a more sophisticated one.
+  // Signs a jwt for service_url. Returns GRPC_MDNULL on failure.
+  grpc_mdelem sign_jwt(const char* service_url, gpr_timespec* expiration);
+  // Adds or replaces the cached jwt of service_url, evicting the least
+  // recently used one if the cache is full. Takes ownership of jwt_md.
+  void cache_jwt_locked(const char* service_url, grpc_mdelem jwt_md,
+                        gpr_timespec expiration);
+  static void refresh_jwt(void* arg, grpc_error* error);
+
+  // Signed jwts by service url, most recently used first, up to
+  // GRPC_JWT_CACHE_MAX_ENTRIES of them.
   gpr_mu cache_mu_;
-  struct {
-    grpc_mdelem jwt_md = GRPC_MDNULL;
-    char* service_url = nullptr;
-    gpr_timespec jwt_expiration;
-  } cached_;
+  CacheList cache_;
+  std::map<std::string, CacheList::iterator> cache_index_;
 
   grpc_auth_json_key key_;
   gpr_timespec jwt_lifetime_;
@@ -21,6 +21,7 @@
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/security/credentials/oauth2/oauth2_credentials.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <grpc/grpc_security.h>
@@ -30,6 +31,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -236,13 +238,41 @@ void grpc_oauth2_token_fetcher_credentials::on_http_response(
           : GRPC_CREDENTIALS_ERROR;
   // Update cache and grab list of pending requests.
   gpr_mu_lock(&mu_);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  GRPC_STATS_INC_OAUTH2_TOKEN_FETCH_US(
+      gpr_timespec_to_micros(gpr_time_sub(now, token_fetch_start_)));
   token_fetch_pending_ = false;
-  access_token_md_ = GRPC_MDELEM_REF(access_token_md);
-  token_expiration_ =
-      status == GRPC_CREDENTIALS_OK
-          ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
-                         gpr_time_from_millis(token_lifetime, GPR_TIMESPAN))
-          : gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  if (status == GRPC_CREDENTIALS_OK) {
+    GRPC_MDELEM_UNREF(access_token_md_);
+    access_token_md_ = GRPC_MDELEM_REF(access_token_md);
+    token_expiration_ = gpr_time_add(
+        now, gpr_time_from_millis(token_lifetime, GPR_TIMESPAN));
+    // Jitter the refresh so that many processes which fetched their tokens
+    // at the same time do not all refresh them at the same time too.
+    int64_t refresh_ahead_ms =
+        (GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_SECS +
+         rand() % (GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_JITTER_SECS + 1)) *
+        GPR_MS_PER_SEC;
+    refresh_ahead_ms = GPR_MIN(refresh_ahead_ms, token_lifetime / 2);
+    token_refresh_time_ = gpr_time_sub(
+        token_expiration_,
+        gpr_time_from_millis(refresh_ahead_ms, GPR_TIMESPAN));
+  } else if (!GRPC_MDISNULL(access_token_md_) &&
+             gpr_time_cmp(token_expiration_, now) > 0) {
+    // The cached token has not expired yet: keep serving it, and retry the
+    // refresh a little later.
+    GRPC_MDELEM_UNREF(access_token_md);
+    access_token_md = GRPC_MDELEM_REF(access_token_md_);
+    status = GRPC_CREDENTIALS_OK;
+    token_refresh_time_ =
+        gpr_time_add(now, gpr_time_from_seconds(
+                              GRPC_SECURE_TOKEN_BACKGROUND_REFRESH_RETRY_SECS,
+                              GPR_TIMESPAN));
+  } else {
+    GRPC_MDELEM_UNREF(access_token_md_);
+    access_token_md_ = GRPC_MDNULL;
+    token_expiration_ = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  }
   grpc_oauth2_pending_get_request_metadata* pending_request = pending_requests_;
   pending_requests_ = nullptr;
   gpr_mu_unlock(&mu_);
@@ -274,19 +304,31 @@ bool grpc_oauth2_token_fetcher_credentials::get_request_metadata(
     grpc_credentials_mdelem_array* md_array, grpc_closure* on_request_metadata,
     grpc_error** /*error*/) {
   // Check if we can use the cached token.
-  grpc_millis refresh_threshold =
-      GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS * GPR_MS_PER_SEC;
   grpc_mdelem cached_access_token_md = GRPC_MDNULL;
+  bool start_fetch = false;
   gpr_mu_lock(&mu_);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
   if (!GRPC_MDISNULL(access_token_md_) &&
       gpr_time_cmp(
-          gpr_time_sub(token_expiration_, gpr_now(GPR_CLOCK_MONOTONIC)),
+          gpr_time_sub(token_expiration_, now),
           gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
                                 GPR_TIMESPAN)) > 0) {
     cached_access_token_md = GRPC_MDELEM_REF(access_token_md_);
   }
   if (!GRPC_MDISNULL(cached_access_token_md)) {
+    // Refresh the token ahead of its expiry, so that calls do not have to
+    // wait for the fetch once it gets close.
+    if (!token_fetch_pending_ &&
+        gpr_time_cmp(now, token_refresh_time_) >= 0) {
+      token_fetch_pending_ = true;
+      token_fetch_start_ = now;
+      start_fetch = true;
+    }
     gpr_mu_unlock(&mu_);
+    if (start_fetch) {
+      GRPC_STATS_INC_OAUTH2_TOKEN_BACKGROUND_REFRESHES();
+      this->start_fetch();
+    }
     grpc_credentials_mdelem_array_add(md_array, cached_access_token_md);
     GRPC_MDELEM_UNREF(cached_access_token_md);
     return true;
@@ -303,22 +345,27 @@ bool grpc_oauth2_token_fetcher_credentials::get_request_metadata(
       pollent, grpc_polling_entity_pollset_set(&pollent_));
   pending_request->next = pending_requests_;
   pending_requests_ = pending_request;
-  bool start_fetch = false;
   if (!token_fetch_pending_) {
     token_fetch_pending_ = true;
+    token_fetch_start_ = now;
     start_fetch = true;
   }
   gpr_mu_unlock(&mu_);
-  if (start_fetch) {
-    Ref().release();
-    fetch_oauth2(grpc_credentials_metadata_request_create(this->Ref()),
-                 &httpcli_context_, &pollent_,
-                 on_oauth2_token_fetcher_http_response,
-                 grpc_core::ExecCtx::Get()->Now() + refresh_threshold);
-  }
+  GRPC_STATS_INC_OAUTH2_CALLS_QUEUED_FOR_TOKEN();
+  if (start_fetch) this->start_fetch();
   return false;
 }
 
+void grpc_oauth2_token_fetcher_credentials::start_fetch() {
+  grpc_millis refresh_threshold =
+      GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS * GPR_MS_PER_SEC;
+  Ref().release();
+  fetch_oauth2(grpc_credentials_metadata_request_create(this->Ref()),
+               &httpcli_context_, &pollent_,
+               on_oauth2_token_fetcher_http_response,
+               grpc_core::ExecCtx::Get()->Now() + refresh_threshold);
+}
+
 void grpc_oauth2_token_fetcher_credentials::cancel_get_request_metadata(
     grpc_credentials_mdelem_array* md_array, grpc_error* error) {
   gpr_mu_lock(&mu_);
@@ -349,6 +396,8 @@ void grpc_oauth2_token_fetcher_credentials::cancel_get_request_metadata(
 grpc_oauth2_token_fetcher_credentials::grpc_oauth2_token_fetcher_credentials()
     : grpc_call_credentials(GRPC_CALL_CREDENTIALS_TYPE_OAUTH2),
       token_expiration_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
+      token_refresh_time_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
+      token_fetch_start_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
       pollent_(grpc_polling_entity_create_from_pollset_set(
           grpc_pollset_set_create())) {
   gpr_mu_init(&mu_);
@@ -92,10 +92,17 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
                             grpc_millis deadline) = 0;
 
  private:
+  // Starts a token fetch. token_fetch_pending_ must have been set.
+  void start_fetch();
+
   gpr_mu mu_;
   grpc_mdelem access_token_md_ = GRPC_MDNULL;
   gpr_timespec token_expiration_;
+  // Past this time, a call that still gets the cached token starts a
+  // background refresh.
+  gpr_timespec token_refresh_time_;
   bool token_fetch_pending_ = false;
+  gpr_timespec token_fetch_start_;
   grpc_oauth2_pending_get_request_metadata* pending_requests_ = nullptr;
   grpc_httpcli_context httpcli_context_;
   grpc_polling_entity pollent_;
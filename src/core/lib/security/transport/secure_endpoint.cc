@@ -97,6 +97,8 @@ struct secure_endpoint {
   grpc_slice read_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
   grpc_slice write_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
   grpc_slice_buffer output_buffer;
+  /* If set, the kernel protects the bytes written to wrapped_ep. */
+  bool kernel_tls_tx = false;
 
   gpr_refcount ref;
 };
@@ -301,6 +303,11 @@ static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
     }
   }
 
+  if (ep->kernel_tls_tx) {
+    grpc_endpoint_write(ep->wrapped_ep, slices, cb, arg);
+    return;
+  }
+
   if (ep->zero_copy_protector != nullptr) {
     // Use zero-copy grpc protector to protect.
     result = tsi_zero_copy_grpc_protector_protect(ep->zero_copy_protector,
@@ -444,3 +451,15 @@ grpc_endpoint* grpc_secure_endpoint_create(
                           leftover_slices, leftover_nslices);
   return &ep->base;
 }
+
+grpc_endpoint* grpc_secure_endpoint_create_with_kernel_tls_tx(
+    struct tsi_frame_protector* protector,
+    struct tsi_zero_copy_grpc_protector* zero_copy_protector,
+    grpc_endpoint* transport, grpc_slice* leftover_slices,
+    size_t leftover_nslices) {
+  secure_endpoint* ep =
+      new secure_endpoint(&vtable, protector, zero_copy_protector, transport,
+                          leftover_slices, leftover_nslices);
+  ep->kernel_tls_tx = true;
+  return &ep->base;
+}
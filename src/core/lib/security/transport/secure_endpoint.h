@@ -38,4 +38,14 @@ grpc_endpoint* grpc_secure_endpoint_create(
     grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
     size_t leftover_nslices);
 
+/* Same as grpc_secure_endpoint_create, for a to_wrap whose outgoing bytes are
+ * already protected by the kernel (see
+ * tsi_handshaker_result_enable_kernel_tls_tx): writes go to to_wrap as they
+ * are, and the protectors only unprotect the incoming bytes. */
+grpc_endpoint* grpc_secure_endpoint_create_with_kernel_tls_tx(
+    struct tsi_frame_protector* protector,
+    struct tsi_zero_copy_grpc_protector* zero_copy_protector,
+    grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
+    size_t leftover_nslices);
+
 #endif /* GRPC_CORE_LIB_SECURITY_TRANSPORT_SECURE_ENDPOINT_H */
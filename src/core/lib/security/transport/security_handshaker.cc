@@ -31,7 +31,9 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/handshaker.h"
 #include "src/core/lib/channel/handshaker_registry.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
@@ -75,6 +77,9 @@ class SecurityHandshaker : public Handshaker {
   static void OnHandshakeNextDoneGrpcWrapper(
       tsi_result result, void* user_data, const unsigned char* bytes_to_send,
       size_t bytes_to_send_size, tsi_handshaker_result* handshaker_result);
+  static void OnHandshakeStepOffloadedFn(void* arg, grpc_error* error);
+  void RunHandshakeStep(grpc_closure* closure, grpc_iomgr_cb_func step,
+                        grpc_error* error);
   static void OnPeerCheckedFn(void* arg, grpc_error* error);
   void OnPeerCheckedInner(grpc_error* error);
   size_t MoveReadBufferIntoHandshakeBuffer();
@@ -104,8 +109,16 @@ class SecurityHandshaker : public Handshaker {
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  bool kernel_tls_tx_ = false;
+  bool offload_ = false;
+  // The step run on the handshaker executor when offload_ is set.
+  grpc_closure offloaded_step_;
+  grpc_iomgr_cb_func offloaded_step_fn_ = nullptr;
 };
 
+// Handshake steps currently queued or running on the handshaker executor.
+gpr_atm g_offloaded_handshake_steps = 0;
+
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
                                        grpc_security_connector* connector,
                                        const grpc_channel_args* args)
@@ -120,6 +133,10 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
     max_frame_size_ = grpc_channel_arg_get_integer(
         arg, {0, 0, std::numeric_limits<int>::max()});
   }
+  kernel_tls_tx_ = grpc_channel_arg_get_bool(
+      grpc_channel_args_find(args, GRPC_ARG_TSI_KERNEL_TLS_TX), false);
+  offload_ = grpc_channel_arg_get_bool(
+      grpc_channel_args_find(args, GRPC_ARG_HANDSHAKER_OFFLOAD), false);
   gpr_mu_init(&mu_);
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
@@ -207,6 +224,15 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error* error) {
     HandshakeFailedLocked(error);
     return;
   }
+  // Hand the protection of outgoing bytes to the kernel, if asked to and
+  // supported. This must happen before the protectors take over the TLS state.
+  bool kernel_tls_tx = false;
+  if (kernel_tls_tx_) {
+    const int fd = grpc_endpoint_get_fd(args_->endpoint);
+    kernel_tls_tx =
+        fd >= 0 && tsi_handshaker_result_enable_kernel_tls_tx(
+                       handshaker_result_, fd) == TSI_OK;
+  }
   // Create zero-copy frame protector, if implemented.
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_result result = tsi_handshaker_result_create_zero_copy_grpc_protector(
@@ -240,15 +266,18 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error* error) {
   result = tsi_handshaker_result_get_unused_bytes(
       handshaker_result_, &unused_bytes, &unused_bytes_size);
   // Create secure endpoint.
+  auto* create_endpoint = kernel_tls_tx
+                              ? grpc_secure_endpoint_create_with_kernel_tls_tx
+                              : grpc_secure_endpoint_create;
   if (unused_bytes_size > 0) {
     grpc_slice slice =
         grpc_slice_from_copied_buffer((char*)unused_bytes, unused_bytes_size);
-    args_->endpoint = grpc_secure_endpoint_create(
-        protector, zero_copy_protector, args_->endpoint, &slice, 1);
+    args_->endpoint = create_endpoint(protector, zero_copy_protector,
+                                      args_->endpoint, &slice, 1);
     grpc_slice_unref_internal(slice);
   } else {
-    args_->endpoint = grpc_secure_endpoint_create(
-        protector, zero_copy_protector, args_->endpoint, nullptr, 0);
+    args_->endpoint = create_endpoint(protector, zero_copy_protector,
+                                      args_->endpoint, nullptr, 0);
   }
   tsi_handshaker_result_destroy(handshaker_result_);
   handshaker_result_ = nullptr;
@@ -380,12 +409,44 @@ grpc_error* SecurityHandshaker::DoHandshakerNextLocked(
 void SecurityHandshaker::OnHandshakeDataReceivedFromPeerFnScheduler(
     void* arg, grpc_error* error) {
   SecurityHandshaker* h = static_cast<SecurityHandshaker*>(arg);
-  grpc_core::ExecCtx::Run(
-      DEBUG_LOCATION,
-      GRPC_CLOSURE_INIT(&h->on_handshake_data_received_from_peer_,
-                        &SecurityHandshaker::OnHandshakeDataReceivedFromPeerFn,
-                        h, grpc_schedule_on_exec_ctx),
-      GRPC_ERROR_REF(error));
+  h->RunHandshakeStep(&h->on_handshake_data_received_from_peer_,
+                      &SecurityHandshaker::OnHandshakeDataReceivedFromPeerFn,
+                      GRPC_ERROR_REF(error));
+}
+
+// Runs step on the calling thread's ExecCtx, or on the handshaker executor if
+// handshakes are offloaded. Only the steps that may call into the TSI
+// handshaker go through here.
+void SecurityHandshaker::RunHandshakeStep(grpc_closure* closure,
+                                          grpc_iomgr_cb_func step,
+                                          grpc_error* error) {
+  if (!offload_) {
+    ExecCtx::Run(DEBUG_LOCATION,
+                 GRPC_CLOSURE_INIT(closure, step, this,
+                                   grpc_schedule_on_exec_ctx),
+                 error);
+    return;
+  }
+  GRPC_STATS_INC_HANDSHAKER_OFFLOADED_STEPS();
+  gpr_atm in_flight =
+      gpr_atm_no_barrier_fetch_add(&g_offloaded_handshake_steps, 1);
+  if (static_cast<size_t>(in_flight) >=
+      Executor::MaxThreads(ExecutorType::HANDSHAKER)) {
+    GRPC_STATS_INC_HANDSHAKER_QUEUED_STEPS();
+  }
+  offloaded_step_fn_ = step;
+  Executor::Run(
+      GRPC_CLOSURE_INIT(&offloaded_step_,
+                        &SecurityHandshaker::OnHandshakeStepOffloadedFn, this,
+                        nullptr),
+      error, ExecutorType::HANDSHAKER);
+}
+
+void SecurityHandshaker::OnHandshakeStepOffloadedFn(void* arg,
+                                                    grpc_error* error) {
+  SecurityHandshaker* h = static_cast<SecurityHandshaker*>(arg);
+  h->offloaded_step_fn_(h, error);
+  gpr_atm_no_barrier_fetch_add(&g_offloaded_handshake_steps, -1);
 }
 
 void SecurityHandshaker::OnHandshakeDataReceivedFromPeerFn(void* arg,
@@ -472,6 +533,14 @@ void SecurityHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
   MutexLock lock(&mu_);
   args_ = args;
   on_handshake_done_ = on_handshake_done;
+  if (offload_) {
+    // Process the bytes received so far on the handshaker executor.
+    RunHandshakeStep(&on_handshake_data_received_from_peer_,
+                     &SecurityHandshaker::OnHandshakeDataReceivedFromPeerFn,
+                     GRPC_ERROR_NONE);
+    ref.release();  // Avoid unref
+    return;
+  }
   size_t bytes_received_size = MoveReadBufferIntoHandshakeBuffer();
   grpc_error* error =
       DoHandshakerNextLocked(handshake_buffer_, bytes_received_size);
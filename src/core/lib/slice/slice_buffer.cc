@@ -30,33 +30,37 @@
 #include "src/core/lib/slice/slice_internal.h"
 
 /* grow a buffer; requires GRPC_SLICE_BUFFER_INLINE_ELEMENTS > 1 */
-#define GROW(x) (3 * (x) / 2)
+#define GROW(x) (2 * (x))
+
+/* Moves the slices into a new array of new_capacity elements. Only the live
+ * slices are copied: the ones taken from the front are not carried over. */
+static void grow_to(grpc_slice_buffer* sb, const size_t new_capacity) {
+  grpc_slice* new_slices =
+      static_cast<grpc_slice*>(gpr_malloc(new_capacity * sizeof(grpc_slice)));
+  memcpy(new_slices, sb->slices, sb->count * sizeof(grpc_slice));
+  if (sb->base_slices != sb->inlined) {
+    gpr_free(sb->base_slices);
+  }
+  sb->base_slices = sb->slices = new_slices;
+  sb->capacity = new_capacity;
+}
 
 /* Typically, we do not actually need to embiggen (by calling
- * memmove/malloc/realloc) - only if we were up against the full capacity of the
+ * memmove/malloc) - only if we were up against the full capacity of the
  * slice buffer. If do_embiggen is inlined, the compiler clobbers multiple
  * registers pointlessly in the common case. */
 static void GPR_ATTRIBUTE_NOINLINE do_embiggen(grpc_slice_buffer* sb,
-                                               const size_t slice_count,
                                                const size_t slice_offset) {
-  if (slice_offset != 0) {
-    /* Make room by moving elements if there's still space unused */
+  if (slice_offset >= sb->count) {
+    /* At least half of the array is free in front of the slices: make room by
+       moving them back, which frees as much room as growing would. Compacting
+       only then keeps buffers used as queues (take_first, then add) from
+       moving every element for each slice added. */
     memmove(sb->base_slices, sb->slices, sb->count * sizeof(grpc_slice));
     sb->slices = sb->base_slices;
   } else {
     /* Allocate more memory if no more space is available */
-    const size_t new_capacity = GROW(sb->capacity);
-    sb->capacity = new_capacity;
-    if (sb->base_slices == sb->inlined) {
-      sb->base_slices = static_cast<grpc_slice*>(
-          gpr_malloc(new_capacity * sizeof(grpc_slice)));
-      memcpy(sb->base_slices, sb->inlined, slice_count * sizeof(grpc_slice));
-    } else {
-      sb->base_slices = static_cast<grpc_slice*>(
-          gpr_realloc(sb->base_slices, new_capacity * sizeof(grpc_slice)));
-    }
-
-    sb->slices = sb->base_slices + slice_offset;
+    grow_to(sb, GROW(sb->capacity));
   }
 }
 
@@ -70,8 +74,19 @@ static void maybe_embiggen(grpc_slice_buffer* sb) {
   size_t slice_offset = static_cast<size_t>(sb->slices - sb->base_slices);
   size_t slice_count = sb->count + slice_offset;
   if (GPR_UNLIKELY(slice_count == sb->capacity)) {
-    do_embiggen(sb, slice_count, slice_offset);
+    do_embiggen(sb, slice_offset);
+  }
+}
+
+void grpc_slice_buffer_reserve(grpc_slice_buffer* sb, size_t n) {
+  const size_t slice_offset = static_cast<size_t>(sb->slices - sb->base_slices);
+  if (slice_offset + sb->count + n <= sb->capacity) return;
+  if (sb->count + n <= sb->capacity) {
+    memmove(sb->base_slices, sb->slices, sb->count * sizeof(grpc_slice));
+    sb->slices = sb->base_slices;
+    return;
   }
+  grow_to(sb, GPR_MAX(GROW(sb->capacity), sb->count + n));
 }
 
 void grpc_slice_buffer_init(grpc_slice_buffer* sb) {
@@ -88,6 +103,14 @@ void grpc_slice_buffer_destroy_internal(grpc_slice_buffer* sb) {
   }
 }
 
+size_t grpc_slice_buffer_shrink_internal(grpc_slice_buffer* sb) {
+  if (sb->count != 0 || sb->base_slices == sb->inlined) return 0;
+  const size_t freed = sb->capacity * sizeof(grpc_slice);
+  gpr_free(sb->base_slices);
+  grpc_slice_buffer_init(sb);
+  return freed;
+}
+
 void grpc_slice_buffer_destroy(grpc_slice_buffer* sb) {
   if (grpc_core::ExecCtx::Get() == nullptr) {
     grpc_core::ExecCtx exec_ctx;
@@ -172,6 +195,7 @@ void grpc_slice_buffer_add(grpc_slice_buffer* sb, grpc_slice s) {
 
 void grpc_slice_buffer_addn(grpc_slice_buffer* sb, grpc_slice* s, size_t n) {
   size_t i;
+  grpc_slice_buffer_reserve(sb, n);
   for (i = 0; i < n; i++) {
     grpc_slice_buffer_add(sb, s[i]);
   }
@@ -184,6 +208,12 @@ void grpc_slice_buffer_pop(grpc_slice_buffer* sb) {
   }
 }
 
+void grpc_slice_buffer_publish(grpc_slice_buffer* sb) {
+  for (size_t i = 0; i < sb->count; i++) {
+    grpc_slice_publish(sb->slices[i]);
+  }
+}
+
 void grpc_slice_buffer_reset_and_unref_internal(grpc_slice_buffer* sb) {
   size_t i;
   for (i = 0; i < sb->count; i++) {
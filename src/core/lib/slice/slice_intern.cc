@@ -28,6 +28,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/murmur_hash.h"
+#include "src/core/lib/gprpp/reader_epochs.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/iomgr_internal.h" /* for iomgr_abort_on_leaks() */
 #include "src/core/lib/profiling/timers.h"
@@ -43,15 +44,87 @@
 
 using grpc_core::InternedSliceRefcount;
 
+typedef struct slice_buckets {
+  size_t capacity;
+  grpc_core::Atomic<InternedSliceRefcount*>* strs;
+  /** Next in the shard's list of retired bucket arrays */
+  struct slice_buckets* next_retired;
+} slice_buckets;
+
+/** Memory that lookups without the shard lock may still be reading */
+typedef struct slice_retired {
+  InternedSliceRefcount* strs;
+  slice_buckets* buckets;
+} slice_retired;
+
 typedef struct slice_shard {
   gpr_mu mu;
-  InternedSliceRefcount** strs;
+  /** The slice_buckets in use. Only replaced under mu, but read without it */
+  gpr_atm buckets;
   size_t count;
-  size_t capacity;
+  /** Lookups of slices that are already interned, which take no lock */
+  grpc_core::ReaderEpochs readers;
+  /** Slices and bucket arrays unlinked since the last epoch flip */
+  slice_retired retired;
+  /** Slices and bucket arrays unlinked before the last epoch flip */
+  slice_retired waiting;
 } slice_shard;
 
 static slice_shard g_shards[SHARD_COUNT];
 
+static slice_buckets* alloc_buckets(size_t capacity) {
+  slice_buckets* buckets = static_cast<slice_buckets*>(
+      gpr_zalloc(sizeof(slice_buckets) +
+                 sizeof(grpc_core::Atomic<InternedSliceRefcount*>) * capacity));
+  buckets->capacity = capacity;
+  buckets->strs =
+      reinterpret_cast<grpc_core::Atomic<InternedSliceRefcount*>*>(buckets + 1);
+  return buckets;
+}
+
+static slice_buckets* shard_buckets(slice_shard* shard) {
+  return reinterpret_cast<slice_buckets*>(gpr_atm_acq_load(&shard->buckets));
+}
+
+static bool retired_empty(const slice_retired* retired) {
+  return retired->strs == nullptr && retired->buckets == nullptr;
+}
+
+static void free_retired(slice_retired* retired) {
+  InternedSliceRefcount* s = retired->strs;
+  while (s != nullptr) {
+    InternedSliceRefcount* next =
+        s->bucket_next.Load(grpc_core::MemoryOrder::RELAXED);
+    s->~InternedSliceRefcount();
+    gpr_free(s);
+    s = next;
+  }
+  retired->strs = nullptr;
+  slice_buckets* buckets = retired->buckets;
+  while (buckets != nullptr) {
+    slice_buckets* next = buckets->next_retired;
+    gpr_free(buckets);
+    buckets = next;
+  }
+  retired->buckets = nullptr;
+}
+
+/* Frees what was unlinked before the last epoch flip once the lookups that
+   could still see it are done, and flips the epoch for what was unlinked
+   since. */
+static void maybe_free_retired(slice_shard* shard) {
+  if (!retired_empty(&shard->waiting)) {
+    if (!shard->readers.PreviousEpochDone()) return;
+    free_retired(&shard->waiting);
+  }
+  if (!retired_empty(&shard->retired)) {
+    shard->waiting = shard->retired;
+    shard->retired.strs = nullptr;
+    shard->retired.buckets = nullptr;
+    shard->readers.Flip();
+  }
+}
+
 typedef struct {
   uint32_t hash;
   uint32_t idx;
@@ -68,17 +141,27 @@ namespace grpc_core {
 uint32_t g_hash_seed;
 static bool g_forced_hash_seed = false;
 
-InternedSliceRefcount::~InternedSliceRefcount() {
-  slice_shard* shard = &g_shards[SHARD_IDX(this->hash)];
+void InternedSliceRefcount::Destroy(void* arg) {
+  auto* rc = static_cast<InternedSliceRefcount*>(arg);
+  slice_shard* shard = &g_shards[SHARD_IDX(rc->hash)];
   MutexLock lock(&shard->mu);
-  InternedSliceRefcount** prev_next;
+  slice_buckets* buckets = shard_buckets(shard);
+  Atomic<InternedSliceRefcount*>* prev_next;
   InternedSliceRefcount* cur;
-  for (prev_next = &shard->strs[TABLE_IDX(this->hash, shard->capacity)],
-      cur = *prev_next;
-       cur != this; prev_next = &cur->bucket_next, cur = cur->bucket_next)
+  for (prev_next = &buckets->strs[TABLE_IDX(rc->hash, buckets->capacity)],
+      cur = prev_next->Load(MemoryOrder::RELAXED);
+       cur != rc; prev_next = &cur->bucket_next,
+      cur = cur->bucket_next.Load(MemoryOrder::RELAXED))
     ;
-  *prev_next = cur->bucket_next;
+  prev_next->Store(cur->bucket_next.Load(MemoryOrder::RELAXED),
+                   MemoryOrder::RELEASE);
   shard->count--;
+  /* A lookup that does not hold the shard lock may still be looking at rc, so
+     it cannot be freed yet. Walking on from rc into the retired list is
+     harmless: nothing on it can gain a ref again. */
+  rc->bucket_next.Store(shard->retired.strs, MemoryOrder::RELEASE);
+  shard->retired.strs = rc;
+  maybe_free_retired(shard);
 }
 
 }  // namespace grpc_core
@@ -86,25 +169,31 @@ InternedSliceRefcount::~InternedSliceRefcount() {
 static void grow_shard(slice_shard* shard) {
   GPR_TIMER_SCOPE("grow_strtab", 0);
 
-  size_t capacity = shard->capacity * 2;
+  slice_buckets* old_buckets = shard_buckets(shard);
+  size_t capacity = old_buckets->capacity * 2;
   size_t i;
-  InternedSliceRefcount** strtab;
+  slice_buckets* buckets;
   InternedSliceRefcount *s, *next;
 
-  strtab = static_cast<InternedSliceRefcount**>(
-      gpr_zalloc(sizeof(InternedSliceRefcount*) * capacity));
+  buckets = alloc_buckets(capacity);
 
-  for (i = 0; i < shard->capacity; i++) {
-    for (s = shard->strs[i]; s; s = next) {
+  /* Lookups still walking the old buckets may be led astray into the new
+     chains and miss, in which case they retry under the lock. */
+  for (i = 0; i < old_buckets->capacity; i++) {
+    for (s = old_buckets->strs[i].Load(grpc_core::MemoryOrder::RELAXED); s;
+         s = next) {
       size_t idx = TABLE_IDX(s->hash, capacity);
-      next = s->bucket_next;
-      s->bucket_next = strtab[idx];
-      strtab[idx] = s;
+      next = s->bucket_next.Load(grpc_core::MemoryOrder::RELAXED);
+      s->bucket_next.Store(
+          buckets->strs[idx].Load(grpc_core::MemoryOrder::RELAXED),
+          grpc_core::MemoryOrder::RELEASE);
+      buckets->strs[idx].Store(s, grpc_core::MemoryOrder::RELAXED);
     }
   }
-  gpr_free(shard->strs);
-  shard->strs = strtab;
-  shard->capacity = capacity;
+  gpr_atm_rel_store(&shard->buckets, reinterpret_cast<gpr_atm>(buckets));
+  old_buckets->next_retired = shard->retired.buckets;
+  shard->retired.buckets = old_buckets;
+  maybe_free_retired(shard);
 }
 
 grpc_core::InternedSlice::InternedSlice(InternedSliceRefcount* s) {
@@ -203,23 +292,26 @@ static size_t GetLength(const grpc_slice& slice) {
 // Returns: a newly interned slice.
 template <typename SliceArgs>
 static InternedSliceRefcount* InternNewStringLocked(slice_shard* shard,
-                                                    size_t shard_idx,
+                                                    slice_buckets* buckets,
                                                     uint32_t hash,
                                                     const SliceArgs& args) {
   /* string data goes after the internal_string header */
   size_t len = GetLength(args);
   const void* buffer = GetBuffer(args);
+  const size_t idx = TABLE_IDX(hash, buckets->capacity);
   InternedSliceRefcount* s =
       static_cast<InternedSliceRefcount*>(gpr_malloc(sizeof(*s) + len));
-  new (s) grpc_core::InternedSliceRefcount(len, hash, shard->strs[shard_idx]);
+  new (s) grpc_core::InternedSliceRefcount(
+      len, hash, buckets->strs[idx].Load(grpc_core::MemoryOrder::RELAXED));
   // TODO(arjunroy): Investigate why hpack tried to intern the nullptr string.
   // https://github.com/grpc/grpc/pull/20110#issuecomment-526729282
   if (len > 0) {
     memcpy(reinterpret_cast<char*>(s + 1), buffer, len);
   }
-  shard->strs[shard_idx] = s;
+  /* publish s, fully initialized, to lookups that do not take the lock */
+  buckets->strs[idx].Store(s, grpc_core::MemoryOrder::RELEASE);
   shard->count++;
-  if (shard->count > shard->capacity * 2) {
+  if (shard->count > buckets->capacity * 2) {
     grow_shard(shard);
   }
   return s;
@@ -227,18 +319,20 @@ static InternedSliceRefcount* InternNewStringLocked(slice_shard* shard,
 
 // Attempt to see if the provided slice or string matches an existing interned
 // slice. SliceArgs... is either a const grpc_slice& or a string and length. In
-// either case, hash is the pre-computed hash value.  We must already hold the
-// shard lock. Helper for FindOrCreateInternedSlice().
+// either case, hash is the pre-computed hash value. This does not need the
+// shard lock, but without it must run inside a read counted by the shard's
+// readers. Helper for FindOrCreateInternedSlice().
 //
 // Returns: a pre-existing matching static slice, or null.
 template <typename SliceArgs>
-static InternedSliceRefcount* MatchInternedSliceLocked(uint32_t hash,
-                                                       size_t idx,
-                                                       const SliceArgs& args) {
+static InternedSliceRefcount* MatchInternedSlice(slice_buckets* buckets,
+                                                 uint32_t hash,
+                                                 const SliceArgs& args) {
   InternedSliceRefcount* s;
-  slice_shard* shard = &g_shards[SHARD_IDX(hash)];
   /* search for an existing string */
-  for (s = shard->strs[idx]; s; s = s->bucket_next) {
+  for (s = buckets->strs[TABLE_IDX(hash, buckets->capacity)].Load(
+           grpc_core::MemoryOrder::ACQUIRE);
+       s; s = s->bucket_next.Load(grpc_core::MemoryOrder::ACQUIRE)) {
     if (s->hash == hash && grpc_core::InternedSlice(s) == args) {
       if (s->refcnt.RefIfNonZero()) {
         return s;
@@ -253,18 +347,25 @@ static InternedSliceRefcount* MatchInternedSliceLocked(uint32_t hash,
 // either the existing matching interned slice or the newly created one.
 // SliceArgs is either a const grpc_slice& or const pair<const char*, size_t>&.
 // In either case, hash is the pre-computed hash value. We do not hold the
-// shard lock here, but do take it.
+// shard lock here, and only take it if the slice is not interned yet.
 //
 // Returns: an interned slice, either pre-existing/matched or newly created.
 template <typename SliceArgs>
 static InternedSliceRefcount* FindOrCreateInternedSlice(uint32_t hash,
                                                         const SliceArgs& args) {
   slice_shard* shard = &g_shards[SHARD_IDX(hash)];
+  grpc_core::ReaderEpochs::Read read = shard->readers.BeginRead();
+  InternedSliceRefcount* s =
+      MatchInternedSlice(shard_buckets(shard), hash, args);
+  shard->readers.EndRead(read);
+  if (s != nullptr) {
+    return s;
+  }
   gpr_mu_lock(&shard->mu);
-  const size_t idx = TABLE_IDX(hash, shard->capacity);
-  InternedSliceRefcount* s = MatchInternedSliceLocked(hash, idx, args);
+  slice_buckets* buckets = shard_buckets(shard);
+  s = MatchInternedSlice(buckets, hash, args);
   if (s == nullptr) {
-    s = InternNewStringLocked(shard, idx, hash, args);
+    s = InternNewStringLocked(shard, buckets, hash, args);
   }
   gpr_mu_unlock(&shard->mu);
   return s;
@@ -318,9 +419,13 @@ void grpc_slice_intern_init(void) {
     slice_shard* shard = &g_shards[i];
     gpr_mu_init(&shard->mu);
     shard->count = 0;
-    shard->capacity = INITIAL_SHARD_CAPACITY;
-    shard->strs = static_cast<InternedSliceRefcount**>(
-        gpr_zalloc(sizeof(*shard->strs) * shard->capacity));
+    gpr_atm_no_barrier_store(
+        &shard->buckets,
+        reinterpret_cast<gpr_atm>(alloc_buckets(INITIAL_SHARD_CAPACITY)));
+    shard->retired.strs = nullptr;
+    shard->retired.buckets = nullptr;
+    shard->waiting.strs = nullptr;
+    shard->waiting.buckets = nullptr;
   }
   for (size_t i = 0; i < GPR_ARRAY_SIZE(static_metadata_hash); i++) {
     static_metadata_hash[i].hash = 0;
@@ -355,12 +460,17 @@ void grpc_slice_intern_shutdown(void) {
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     slice_shard* shard = &g_shards[i];
     gpr_mu_destroy(&shard->mu);
+    free_retired(&shard->waiting);
+    free_retired(&shard->retired);
+    slice_buckets* buckets = shard_buckets(shard);
     /* TODO(ctiller): GPR_ASSERT(shard->count == 0); */
     if (shard->count != 0) {
       gpr_log(GPR_DEBUG, "WARNING: %" PRIuPTR " metadata strings were leaked",
               shard->count);
-      for (size_t j = 0; j < shard->capacity; j++) {
-        for (InternedSliceRefcount* s = shard->strs[j]; s; s = s->bucket_next) {
+      for (size_t j = 0; j < buckets->capacity; j++) {
+        for (InternedSliceRefcount* s =
+                 buckets->strs[j].Load(grpc_core::MemoryOrder::RELAXED);
+             s; s = s->bucket_next.Load(grpc_core::MemoryOrder::RELAXED)) {
           char* text = grpc_dump_slice(grpc_core::InternedSlice(s),
                                        GPR_DUMP_HEX | GPR_DUMP_ASCII);
           gpr_log(GPR_DEBUG, "LEAKED: %s", text);
@@ -371,6 +481,6 @@ void grpc_slice_intern_shutdown(void) {
         abort();
       }
     }
-    gpr_free(shard->strs);
+    gpr_free(buckets);
   }
 }
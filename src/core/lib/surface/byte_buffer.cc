@@ -40,6 +40,7 @@ grpc_byte_buffer* grpc_raw_compressed_byte_buffer_create(
   bb->type = GRPC_BB_RAW;
   bb->data.raw.compression = compression;
   grpc_slice_buffer_init(&bb->data.raw.slice_buffer);
+  grpc_slice_buffer_reserve(&bb->data.raw.slice_buffer, nslices);
   for (i = 0; i < nslices; i++) {
     grpc_slice_ref_internal(slices[i]);
     grpc_slice_buffer_add(&bb->data.raw.slice_buffer, slices[i]);
@@ -31,8 +31,10 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/channel/call_timeline.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/compression/algorithm_metadata.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/gpr/string.h"
@@ -136,6 +138,7 @@ struct grpc_call {
       : arena(arena),
         cq(args.cq),
         channel(args.channel),
+        registered_call_handle(args.registered_call_handle),
         is_client(args.server_transport_data == nullptr),
         stream_op_payload(context) {
     for (int i = 0; i < 2; i++) {
@@ -155,6 +158,7 @@ struct grpc_call {
   grpc_completion_queue* cq;
   grpc_polling_entity pollent;
   grpc_channel* channel;
+  void* registered_call_handle;
   gpr_cycle_counter start_time = gpr_get_cycle_counter();
   /* parent_call* */ gpr_atm parent_call_atm = 0;
   child_call* child = nullptr;
@@ -172,6 +176,8 @@ struct grpc_call {
   bool received_initial_metadata = false;
   bool receiving_message = false;
   bool requested_final_op = false;
+  /** whether channelz counts this call's outcome */
+  bool channelz_sampled = false;
   gpr_atm any_ops_sent_atm = 0;
   gpr_atm received_final_op_atm = 0;
 
@@ -220,6 +226,10 @@ struct grpc_call {
   grpc_core::OrphanablePtr<grpc_core::ByteStream> receiving_stream;
   grpc_byte_buffer** receiving_buffer = nullptr;
   grpc_slice receiving_slice = grpc_empty_slice();
+  /* Inflates a compressed message as its slices are received */
+  grpc_msg_decompressor* receiving_decompressor = nullptr;
+  /* Bytes of the message pulled from receiving_stream so far */
+  size_t receiving_length = 0;
   grpc_closure receiving_slice_ready;
   grpc_closure receiving_stream_ready;
   grpc_closure receiving_initial_metadata_ready;
@@ -333,19 +343,27 @@ grpc_error* grpc_call_create(const grpc_call_create_args* args,
   grpc_error* error = GRPC_ERROR_NONE;
   grpc_channel_stack* channel_stack =
       grpc_channel_get_channel_stack(args->channel);
-  size_t initial_size = grpc_channel_get_call_size_estimate(args->channel);
+  size_t initial_size = grpc_channel_get_call_size_estimate(
+      args->channel, args->registered_call_handle);
   GRPC_STATS_INC_CALL_INITIAL_SIZE(initial_size);
+  if (args->registered_call_handle != nullptr) {
+    GRPC_STATS_INC_REGISTERED_CALL_INITIAL_SIZE(initial_size);
+  }
   size_t call_and_stack_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_call)) +
       channel_stack->call_stack_size;
   size_t call_alloc_size =
       call_and_stack_size + (args->parent ? sizeof(child_call) : 0);
 
+  grpc_core::ArenaPool* arena_pool = args->channel->arena_pool;
   std::pair<grpc_core::Arena*, void*> arena_with_call =
-      grpc_core::Arena::CreateWithAlloc(initial_size, call_alloc_size);
+      arena_pool != nullptr
+          ? arena_pool->CreateWithAlloc(initial_size, call_alloc_size)
+          : grpc_core::Arena::CreateWithAlloc(initial_size, call_alloc_size);
   arena = arena_with_call.first;
   call = new (arena_with_call.second) grpc_call(arena, *args);
   *out_call = call;
+  grpc_core::CallTimeline::MaybeStart(arena, call->context, call->is_client);
   grpc_slice path = grpc_empty_slice();
   if (call->is_client) {
     call->final_op.client.status_details = nullptr;
@@ -467,13 +485,13 @@ grpc_error* grpc_call_create(const grpc_call_create_args* args,
     grpc_core::channelz::ChannelNode* channelz_channel =
         grpc_channel_get_channelz_node(call->channel);
     if (channelz_channel != nullptr) {
-      channelz_channel->RecordCallStarted();
+      call->channelz_sampled = channelz_channel->RecordCallStarted();
     }
   } else {
     grpc_core::channelz::ServerNode* channelz_server =
         grpc_server_get_channelz_node(call->final_op.server.server);
     if (channelz_server != nullptr) {
-      channelz_server->RecordCallStarted();
+      call->channelz_sampled = channelz_server->RecordCallStarted();
     }
   }
 
@@ -514,9 +532,14 @@ void grpc_call_internal_unref(grpc_call* c REF_ARG) {
 static void release_call(void* call, grpc_error* /*error*/) {
   grpc_call* c = static_cast<grpc_call*>(call);
   grpc_channel* channel = c->channel;
+  void* registered_call_handle = c->registered_call_handle;
   grpc_core::Arena* arena = c->arena;
   c->~grpc_call();
-  grpc_channel_update_call_size_estimate(channel, arena->Destroy());
+  size_t arena_size = channel->arena_pool != nullptr
+                          ? channel->arena_pool->Destroy(arena)
+                          : arena->Destroy();
+  grpc_channel_update_call_size_estimate(channel, registered_call_handle,
+                                         arena_size);
   GRPC_CHANNEL_INTERNAL_UNREF(channel, "call");
 }
 
@@ -530,6 +553,9 @@ static void destroy_call(void* call, grpc_error* /*error*/) {
         &c->metadata_batch[1 /* is_receiving */][i /* is_initial */]);
   }
   c->receiving_stream.reset();
+  if (c->receiving_decompressor != nullptr) {
+    grpc_msg_decompressor_destroy(c->receiving_decompressor);
+  }
   parent_call* pc = get_parent_call(c);
   if (pc != nullptr) {
     pc->~parent_call();
@@ -728,6 +754,12 @@ static void cancel_with_status(grpc_call* c, grpc_status_code status,
   cancel_with_error(c, error_from_status(status, description));
 }
 
+void grpc_call_cancel_with_status_internal(grpc_call* call,
+                                           grpc_status_code status,
+                                           const char* description) {
+  cancel_with_status(call, status, description);
+}
+
 static void set_final_status(grpc_call* call, grpc_error* error) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_error_trace)) {
     gpr_log(GPR_DEBUG, "set_final_status %s", call->is_client ? "CLI" : "SVR");
@@ -743,7 +775,7 @@ static void set_final_status(grpc_call* call, grpc_error* error) {
     gpr_atm_rel_store(&call->status_error, reinterpret_cast<gpr_atm>(error));
     grpc_core::channelz::ChannelNode* channelz_channel =
         grpc_channel_get_channelz_node(call->channel);
-    if (channelz_channel != nullptr) {
+    if (channelz_channel != nullptr && call->channelz_sampled) {
       if (*call->final_op.client.status != GRPC_STATUS_OK) {
         channelz_channel->RecordCallFailed();
       } else {
@@ -757,7 +789,7 @@ static void set_final_status(grpc_call* call, grpc_error* error) {
             GRPC_ERROR_NONE;
     grpc_core::channelz::ServerNode* channelz_server =
         grpc_server_get_channelz_node(call->final_op.server.server);
-    if (channelz_server != nullptr) {
+    if (channelz_server != nullptr && call->channelz_sampled) {
       if (*call->final_op.server.cancelled) {
         channelz_server->RecordCallFailed();
       } else {
@@ -1221,6 +1253,10 @@ static void post_batch_completion(batch_control* bctl) {
   }
   reset_batch_errors(bctl);
 
+  if (bctl->op.recv_trailing_metadata) {
+    grpc_core::CallTimeline::Mark(
+        call->context, grpc_core::CallTimeline::kCompletionDelivered);
+  }
   if (bctl->completion_data.notify_tag.is_closure) {
     /* unrefs error */
     bctl->call = nullptr;
@@ -1242,13 +1278,79 @@ static void finish_batch_step(batch_control* bctl) {
   }
 }
 
+static void fail_receiving_message(batch_control* bctl) {
+  grpc_call* call = bctl->call;
+  call->receiving_stream.reset();
+  if (call->receiving_decompressor != nullptr) {
+    grpc_msg_decompressor_destroy(call->receiving_decompressor);
+    call->receiving_decompressor = nullptr;
+  }
+  grpc_byte_buffer_destroy(*call->receiving_buffer);
+  *call->receiving_buffer = nullptr;
+  call->receiving_message = 0;
+  finish_batch_step(bctl);
+}
+
+/* The size limit that message_size_filter set for the messages the call
+   receives, once they are decompressed. */
+static size_t max_recv_message_size(grpc_call* call) {
+  uintptr_t limit = reinterpret_cast<uintptr_t>(
+      call->context[GRPC_CONTEXT_MAX_RECV_MESSAGE_SIZE].value);
+  return limit == 0 ? SIZE_MAX : static_cast<size_t>(limit - 1);
+}
+
+static void GPR_ATTRIBUTE_NOINLINE
+handle_error_decompressing_message(batch_control* bctl) {
+  grpc_call* call = bctl->call;
+  if (call->receiving_decompressor != nullptr &&
+      grpc_msg_decompressor_over_limit(call->receiving_decompressor)) {
+    char* message_string;
+    gpr_asprintf(&message_string,
+                 "Received message larger than max (more than %" PRIuPTR
+                 " bytes once decompressed)",
+                 max_recv_message_size(call));
+    cancel_with_status(call, GRPC_STATUS_RESOURCE_EXHAUSTED, message_string);
+    gpr_free(message_string);
+  } else {
+    cancel_with_status(call, GRPC_STATUS_INTERNAL,
+                       "Unexpected error decompressing data");
+  }
+  fail_receiving_message(bctl);
+}
+
+/* Takes ownership of slice. Returns false if it could not be decompressed. */
+static bool add_receiving_slice(grpc_call* call, grpc_slice slice) {
+  grpc_slice_buffer* sb = &(*call->receiving_buffer)->data.raw.slice_buffer;
+  call->receiving_length += GRPC_SLICE_LENGTH(slice);
+  if (call->receiving_decompressor == nullptr) {
+    grpc_slice_buffer_add(sb, slice);
+    return true;
+  }
+  bool ok = grpc_msg_decompressor_add(call->receiving_decompressor, slice, sb);
+  grpc_slice_unref_internal(slice);
+  return ok;
+}
+
 static void continue_receiving_slices(batch_control* bctl) {
   grpc_error* error;
   grpc_call* call = bctl->call;
   for (;;) {
-    size_t remaining = call->receiving_stream->length() -
-                       (*call->receiving_buffer)->data.raw.slice_buffer.length;
+    size_t remaining =
+        call->receiving_stream->length() - call->receiving_length;
     if (remaining == 0) {
+      if (call->receiving_decompressor != nullptr) {
+        bool ok = grpc_msg_decompressor_finish(
+            call->receiving_decompressor,
+            &(*call->receiving_buffer)->data.raw.slice_buffer);
+        grpc_msg_decompressor_destroy(call->receiving_decompressor);
+        call->receiving_decompressor = nullptr;
+        if (GPR_UNLIKELY(!ok)) {
+          handle_error_decompressing_message(bctl);
+          return;
+        }
+      }
+      grpc_core::CallTimeline::Mark(
+          call->context, grpc_core::CallTimeline::kFirstMessageReceived);
       call->receiving_message = 0;
       call->receiving_stream.reset();
       finish_batch_step(bctl);
@@ -1257,14 +1359,12 @@ static void continue_receiving_slices(batch_control* bctl) {
     if (call->receiving_stream->Next(remaining, &call->receiving_slice_ready)) {
       error = call->receiving_stream->Pull(&call->receiving_slice);
       if (error == GRPC_ERROR_NONE) {
-        grpc_slice_buffer_add(&(*call->receiving_buffer)->data.raw.slice_buffer,
-                              call->receiving_slice);
+        if (GPR_UNLIKELY(!add_receiving_slice(call, call->receiving_slice))) {
+          handle_error_decompressing_message(bctl);
+          return;
+        }
       } else {
-        call->receiving_stream.reset();
-        grpc_byte_buffer_destroy(*call->receiving_buffer);
-        *call->receiving_buffer = nullptr;
-        call->receiving_message = 0;
-        finish_batch_step(bctl);
+        fail_receiving_message(bctl);
         GRPC_ERROR_UNREF(error);
         return;
       }
@@ -1283,9 +1383,11 @@ static void receiving_slice_ready(void* bctlp, grpc_error* error) {
     grpc_slice slice;
     error = call->receiving_stream->Pull(&slice);
     if (error == GRPC_ERROR_NONE) {
-      grpc_slice_buffer_add(&(*call->receiving_buffer)->data.raw.slice_buffer,
-                            slice);
-      continue_receiving_slices(bctl);
+      if (GPR_LIKELY(add_receiving_slice(call, slice))) {
+        continue_receiving_slices(bctl);
+      } else {
+        handle_error_decompressing_message(bctl);
+      }
     } else {
       /* Error returned by ByteStream::Pull() needs to be released manually */
       release_error = true;
@@ -1296,11 +1398,7 @@ static void receiving_slice_ready(void* bctlp, grpc_error* error) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_operation_failures)) {
       GRPC_LOG_IF_ERROR("receiving_slice_ready", GRPC_ERROR_REF(error));
     }
-    call->receiving_stream.reset();
-    grpc_byte_buffer_destroy(*call->receiving_buffer);
-    *call->receiving_buffer = nullptr;
-    call->receiving_message = 0;
-    finish_batch_step(bctl);
+    fail_receiving_message(bctl);
     if (release_error) {
       GRPC_ERROR_UNREF(error);
     }
@@ -1315,19 +1413,24 @@ static void process_data_after_md(batch_control* bctl) {
     finish_batch_step(bctl);
   } else {
     call->test_only_last_message_flags = call->receiving_stream->flags();
-    if ((call->receiving_stream->flags() & GRPC_WRITE_INTERNAL_COMPRESS) &&
-        (call->incoming_message_compression_algorithm >
-         GRPC_MESSAGE_COMPRESS_NONE)) {
-      grpc_compression_algorithm algo;
-      GPR_ASSERT(
-          grpc_compression_algorithm_from_message_stream_compression_algorithm(
-              &algo, call->incoming_message_compression_algorithm,
-              (grpc_stream_compression_algorithm)0));
-      *call->receiving_buffer =
-          grpc_raw_compressed_byte_buffer_create(nullptr, 0, algo);
-    } else {
-      *call->receiving_buffer = grpc_raw_byte_buffer_create(nullptr, 0);
+    *call->receiving_buffer = grpc_raw_byte_buffer_create(nullptr, 0);
+    /* Compressed messages are inflated as they arrive, so the application
+       gets the message uncompressed and never holds both forms in full.
+       Channels that pass messages through leave them compressed instead. */
+    if (call->receiving_stream->flags() & GRPC_WRITE_INTERNAL_COMPRESS) {
+      if (grpc_channel_per_message_decompression(call->channel)) {
+        call->receiving_decompressor = grpc_msg_decompressor_create(
+            call->incoming_message_compression_algorithm,
+            grpc_channel_compression_dictionaries(call->channel),
+            call->receiving_stream->length(), max_recv_message_size(call));
+      } else {
+        grpc_compression_algorithm_from_message_stream_compression_algorithm(
+            &(*call->receiving_buffer)->data.raw.compression,
+            call->incoming_message_compression_algorithm,
+            GRPC_STREAM_COMPRESS_NONE);
+      }
     }
+    call->receiving_length = 0;
     GRPC_CLOSURE_INIT(&call->receiving_slice_ready, receiving_slice_ready, bctl,
                       grpc_schedule_on_exec_ctx);
     continue_receiving_slices(bctl);
@@ -1467,6 +1570,8 @@ static void receiving_initial_metadata_ready(void* bctlp, grpc_error* error) {
   GRPC_CALL_COMBINER_STOP(&call->call_combiner, "recv_initial_metadata_ready");
 
   if (error == GRPC_ERROR_NONE) {
+    grpc_core::CallTimeline::Mark(
+        call->context, grpc_core::CallTimeline::kInitialMetadataReceived);
     grpc_metadata_batch* md =
         &call->metadata_batch[1 /* is_receiving */][0 /* is_trailing */];
     recv_initial_filter(call, md);
@@ -1548,6 +1653,327 @@ static void free_no_op_completion(void* /*p*/, grpc_cq_completion* completion) {
   gpr_free(completion);
 }
 
+/* The add_*_op functions below turn one already validated op into its part of
+   the transport op of \a bctl, and record on \a call that it was started. */
+
+static grpc_call_error add_send_initial_metadata_op(grpc_call* call,
+                                                    batch_control* bctl,
+                                                    const grpc_op* op) {
+  grpc_transport_stream_op_batch* stream_op = &bctl->op;
+  grpc_transport_stream_op_batch_payload* stream_op_payload =
+      &call->stream_op_payload;
+  // TODO(juanlishen): If the user has already specified a compression
+  // algorithm by setting the initial metadata with key of
+  // GRPC_COMPRESSION_REQUEST_ALGORITHM_MD_KEY, we shouldn't override that
+  // with the compression algorithm mapped from compression level.
+  /* process compression level */
+  grpc_metadata& compression_md = call->compression_md;
+  compression_md.key = grpc_empty_slice();
+  compression_md.value = grpc_empty_slice();
+  compression_md.flags = 0;
+  size_t additional_metadata_count = 0;
+  grpc_compression_level effective_compression_level = GRPC_COMPRESS_LEVEL_NONE;
+  bool level_set = false;
+  if (op->data.send_initial_metadata.maybe_compression_level.is_set) {
+    effective_compression_level =
+        op->data.send_initial_metadata.maybe_compression_level.level;
+    level_set = true;
+  } else {
+    const grpc_compression_options copts =
+        grpc_channel_compression_options(call->channel);
+    if (copts.default_level.is_set) {
+      level_set = true;
+      effective_compression_level = copts.default_level.level;
+    }
+  }
+  // Currently, only server side supports compression level setting.
+  if (level_set && !call->is_client) {
+    const grpc_compression_algorithm calgo =
+        compression_algorithm_for_level_locked(call,
+                                               effective_compression_level);
+    // The following metadata will be checked and removed by the message
+    // compression filter. It will be used as the call's compression
+    // algorithm.
+    compression_md.key = GRPC_MDSTR_GRPC_INTERNAL_ENCODING_REQUEST;
+    compression_md.value = grpc_compression_algorithm_slice(calgo);
+    additional_metadata_count++;
+  }
+  if (op->data.send_initial_metadata.count + additional_metadata_count >
+      INT_MAX) {
+    return GRPC_CALL_ERROR_INVALID_METADATA;
+  }
+  stream_op->send_initial_metadata = true;
+  call->sent_initial_metadata = true;
+  if (!prepare_application_metadata(
+          call, static_cast<int>(op->data.send_initial_metadata.count),
+          op->data.send_initial_metadata.metadata, 0, call->is_client,
+          &compression_md, static_cast<int>(additional_metadata_count))) {
+    return GRPC_CALL_ERROR_INVALID_METADATA;
+  }
+  /* TODO(ctiller): just make these the same variable? */
+  if (call->is_client) {
+    call->metadata_batch[0][0].deadline = call->send_deadline;
+  }
+  stream_op_payload->send_initial_metadata.send_initial_metadata =
+      &call->metadata_batch[0 /* is_receiving */][0 /* is_trailing */];
+  stream_op_payload->send_initial_metadata.send_initial_metadata_flags =
+      op->flags;
+  if (call->is_client) {
+    stream_op_payload->send_initial_metadata.peer_string = &call->peer_string;
+  }
+  return GRPC_CALL_OK;
+}
+
+static void add_send_message_op(grpc_call* call, batch_control* bctl,
+                                const grpc_op* op) {
+  uint32_t flags = op->flags;
+  /* If the outgoing buffer is already compressed, mark it as so in the
+     flags. These will be picked up by the compression filter and further
+     (wasteful) attempts at compression skipped. */
+  if (op->data.send_message.send_message->data.raw.compression >
+      GRPC_COMPRESS_NONE) {
+    flags |= GRPC_WRITE_INTERNAL_COMPRESS;
+  }
+  bctl->op.send_message = true;
+  call->sending_message = true;
+  call->sending_stream.Init(
+      &op->data.send_message.send_message->data.raw.slice_buffer, flags);
+  call->stream_op_payload.send_message.send_message.reset(
+      call->sending_stream.get());
+}
+
+static void add_send_close_from_client_op(grpc_call* call,
+                                          batch_control* bctl) {
+  bctl->op.send_trailing_metadata = true;
+  call->sent_final_op = true;
+  call->stream_op_payload.send_trailing_metadata.send_trailing_metadata =
+      &call->metadata_batch[0 /* is_receiving */][1 /* is_trailing */];
+}
+
+static grpc_call_error add_send_status_from_server_op(grpc_call* call,
+                                                      batch_control* bctl,
+                                                      const grpc_op* op) {
+  if (op->data.send_status_from_server.trailing_metadata_count > INT_MAX) {
+    return GRPC_CALL_ERROR_INVALID_METADATA;
+  }
+  bctl->op.send_trailing_metadata = true;
+  call->sent_final_op = true;
+  GPR_ASSERT(call->send_extra_metadata_count == 0);
+  call->send_extra_metadata_count = 1;
+  call->send_extra_metadata[0].md =
+      grpc_get_reffed_status_elem(op->data.send_status_from_server.status);
+  grpc_error* status_error =
+      op->data.send_status_from_server.status == GRPC_STATUS_OK
+          ? GRPC_ERROR_NONE
+          : grpc_error_set_int(
+                GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server returned error"),
+                GRPC_ERROR_INT_GRPC_STATUS,
+                static_cast<intptr_t>(op->data.send_status_from_server.status));
+  if (op->data.send_status_from_server.status_details != nullptr) {
+    call->send_extra_metadata[1].md = grpc_mdelem_from_slices(
+        GRPC_MDSTR_GRPC_MESSAGE,
+        grpc_slice_ref_internal(
+            *op->data.send_status_from_server.status_details));
+    call->send_extra_metadata_count++;
+    if (status_error != GRPC_ERROR_NONE) {
+      char* msg = grpc_slice_to_c_string(
+          GRPC_MDVALUE(call->send_extra_metadata[1].md));
+      status_error =
+          grpc_error_set_str(status_error, GRPC_ERROR_STR_GRPC_MESSAGE,
+                             grpc_slice_from_copied_string(msg));
+      gpr_free(msg);
+    }
+  }
+
+  gpr_atm_rel_store(&call->status_error,
+                    reinterpret_cast<gpr_atm>(status_error));
+  if (!prepare_application_metadata(
+          call,
+          static_cast<int>(
+              op->data.send_status_from_server.trailing_metadata_count),
+          op->data.send_status_from_server.trailing_metadata, 1, 1, nullptr,
+          0)) {
+    for (int n = 0; n < call->send_extra_metadata_count; n++) {
+      GRPC_MDELEM_UNREF(call->send_extra_metadata[n].md);
+    }
+    call->send_extra_metadata_count = 0;
+    return GRPC_CALL_ERROR_INVALID_METADATA;
+  }
+  call->stream_op_payload.send_trailing_metadata.send_trailing_metadata =
+      &call->metadata_batch[0 /* is_receiving */][1 /* is_trailing */];
+  return GRPC_CALL_OK;
+}
+
+static void add_recv_initial_metadata_op(grpc_call* call, batch_control* bctl,
+                                         const grpc_op* op) {
+  grpc_transport_stream_op_batch_payload* stream_op_payload =
+      &call->stream_op_payload;
+  call->received_initial_metadata = true;
+  call->buffered_metadata[0] =
+      op->data.recv_initial_metadata.recv_initial_metadata;
+  GRPC_CLOSURE_INIT(&call->receiving_initial_metadata_ready,
+                    receiving_initial_metadata_ready, bctl,
+                    grpc_schedule_on_exec_ctx);
+  bctl->op.recv_initial_metadata = true;
+  stream_op_payload->recv_initial_metadata.recv_initial_metadata =
+      &call->metadata_batch[1 /* is_receiving */][0 /* is_trailing */];
+  stream_op_payload->recv_initial_metadata.recv_initial_metadata_ready =
+      &call->receiving_initial_metadata_ready;
+  if (!call->is_client) {
+    stream_op_payload->recv_initial_metadata.peer_string = &call->peer_string;
+  }
+}
+
+static void add_recv_message_op(grpc_call* call, batch_control* bctl,
+                                const grpc_op* op) {
+  call->receiving_message = true;
+  bctl->op.recv_message = true;
+  call->receiving_buffer = op->data.recv_message.recv_message;
+  call->stream_op_payload.recv_message.recv_message = &call->receiving_stream;
+  GRPC_CLOSURE_INIT(&call->receiving_stream_ready,
+                    receiving_stream_ready_in_call_combiner, bctl,
+                    grpc_schedule_on_exec_ctx);
+  call->stream_op_payload.recv_message.recv_message_ready =
+      &call->receiving_stream_ready;
+}
+
+/* Shared by GRPC_OP_RECV_STATUS_ON_CLIENT and GRPC_OP_RECV_CLOSE_ON_SERVER */
+static void add_recv_trailing_metadata_op(grpc_call* call,
+                                          batch_control* bctl) {
+  grpc_transport_stream_op_batch_payload* stream_op_payload =
+      &call->stream_op_payload;
+  call->requested_final_op = true;
+  bctl->op.recv_trailing_metadata = true;
+  stream_op_payload->recv_trailing_metadata.recv_trailing_metadata =
+      &call->metadata_batch[1 /* is_receiving */][1 /* is_trailing */];
+  stream_op_payload->recv_trailing_metadata.collect_stats =
+      &call->final_info.stats.transport_stream_stats;
+  GRPC_CLOSURE_INIT(&call->receiving_trailing_metadata_ready,
+                    receiving_trailing_metadata_ready, bctl,
+                    grpc_schedule_on_exec_ctx);
+  stream_op_payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+      &call->receiving_trailing_metadata_ready;
+}
+
+static void add_recv_status_on_client_op(grpc_call* call, batch_control* bctl,
+                                         const grpc_op* op) {
+  call->buffered_metadata[1] = op->data.recv_status_on_client.trailing_metadata;
+  call->final_op.client.status = op->data.recv_status_on_client.status;
+  call->final_op.client.status_details =
+      op->data.recv_status_on_client.status_details;
+  call->final_op.client.error_string =
+      op->data.recv_status_on_client.error_string;
+  add_recv_trailing_metadata_op(call, bctl);
+}
+
+static void add_recv_close_on_server_op(grpc_call* call, batch_control* bctl,
+                                        const grpc_op* op) {
+  call->final_op.server.cancelled = op->data.recv_close_on_server.cancelled;
+  add_recv_trailing_metadata_op(call, bctl);
+}
+
+#define UNARY_OP_BIT(op) (1u << (op))
+/* The batch a client starts for a unary call */
+#define CLIENT_UNARY_BATCH_OPS                                                 \
+  (UNARY_OP_BIT(GRPC_OP_SEND_INITIAL_METADATA) |                               \
+   UNARY_OP_BIT(GRPC_OP_SEND_MESSAGE) |                                        \
+   UNARY_OP_BIT(GRPC_OP_SEND_CLOSE_FROM_CLIENT) |                              \
+   UNARY_OP_BIT(GRPC_OP_RECV_INITIAL_METADATA) |                               \
+   UNARY_OP_BIT(GRPC_OP_RECV_MESSAGE) |                                        \
+   UNARY_OP_BIT(GRPC_OP_RECV_STATUS_ON_CLIENT))
+/* The batch a server starts to answer a unary call, which may or may not
+   also ask for the close */
+#define SERVER_UNARY_BATCH_OPS                                                 \
+  (UNARY_OP_BIT(GRPC_OP_SEND_INITIAL_METADATA) |                               \
+   UNARY_OP_BIT(GRPC_OP_SEND_MESSAGE) |                                        \
+   UNARY_OP_BIT(GRPC_OP_SEND_STATUS_FROM_SERVER))
+#define SERVER_UNARY_BATCH_OPS_WITH_CLOSE \
+  (SERVER_UNARY_BATCH_OPS | UNARY_OP_BIT(GRPC_OP_RECV_CLOSE_ON_SERVER))
+
+/* Checks, in a single pass over \a ops, whether they are a valid unary batch
+   (see CLIENT_UNARY_BATCH_OPS and SERVER_UNARY_BATCH_OPS) started on a call
+   that has not started any of them yet. If so, fills in \a by_type with each
+   op, indexed by type. Anything else, including invalid batches, is left to
+   the generic path, which reports the precise error. */
+static bool match_unary_batch(grpc_call* call, const grpc_op* ops, size_t nops,
+                              const grpc_op** by_type, uint32_t* mask) {
+  if (nops > 6 || nops < 3) return false;
+  uint32_t seen = 0;
+  for (size_t i = 0; i < nops; i++) {
+    const grpc_op* op = &ops[i];
+    if (op->reserved != nullptr || op->op > GRPC_OP_RECV_CLOSE_ON_SERVER) {
+      return false;
+    }
+    const uint32_t bit = UNARY_OP_BIT(op->op);
+    if ((seen & bit) != 0) return false;
+    seen |= bit;
+    switch (op->op) {
+      case GRPC_OP_SEND_INITIAL_METADATA:
+        if (!are_initial_metadata_flags_valid(op->flags, call->is_client)) {
+          return false;
+        }
+        break;
+      case GRPC_OP_SEND_MESSAGE:
+        if (!are_write_flags_valid(op->flags) ||
+            op->data.send_message.send_message == nullptr) {
+          return false;
+        }
+        break;
+      default:
+        if (op->flags != 0) return false;
+        break;
+    }
+    by_type[op->op] = op;
+  }
+  if (call->is_client) {
+    if (seen != CLIENT_UNARY_BATCH_OPS) return false;
+  } else if (seen != SERVER_UNARY_BATCH_OPS &&
+             seen != SERVER_UNARY_BATCH_OPS_WITH_CLOSE) {
+    return false;
+  }
+  if (call->sent_initial_metadata || call->sending_message ||
+      call->sent_final_op || call->received_initial_metadata ||
+      call->receiving_message || call->requested_final_op) {
+    return false;
+  }
+  *mask = seen;
+  return true;
+}
+
+/* Turns a batch matched by match_unary_batch into a transport op. All
+   validation other than of the metadata itself was done by the match, so this
+   only has to set up each op. Sets \a num_recv_ops to the number of receive
+   ops added. */
+static grpc_call_error add_unary_batch_ops(grpc_call* call,
+                                           batch_control* bctl,
+                                           const grpc_op* const* by_type,
+                                           uint32_t mask, int* num_recv_ops) {
+  grpc_call_error error = add_send_initial_metadata_op(
+      call, bctl, by_type[GRPC_OP_SEND_INITIAL_METADATA]);
+  if (error != GRPC_CALL_OK) return error;
+  add_send_message_op(call, bctl, by_type[GRPC_OP_SEND_MESSAGE]);
+  if (call->is_client) {
+    add_send_close_from_client_op(call, bctl);
+    add_recv_initial_metadata_op(call, bctl,
+                                 by_type[GRPC_OP_RECV_INITIAL_METADATA]);
+    add_recv_message_op(call, bctl, by_type[GRPC_OP_RECV_MESSAGE]);
+    add_recv_status_on_client_op(call, bctl,
+                                 by_type[GRPC_OP_RECV_STATUS_ON_CLIENT]);
+    *num_recv_ops = 3;
+    return GRPC_CALL_OK;
+  }
+  error = add_send_status_from_server_op(
+      call, bctl, by_type[GRPC_OP_SEND_STATUS_FROM_SERVER]);
+  if (error != GRPC_CALL_OK) return error;
+  *num_recv_ops = 0;
+  if (mask & UNARY_OP_BIT(GRPC_OP_RECV_CLOSE_ON_SERVER)) {
+    add_recv_close_on_server_op(call, bctl,
+                                by_type[GRPC_OP_RECV_CLOSE_ON_SERVER]);
+    *num_recv_ops = 1;
+  }
+  return GRPC_CALL_OK;
+}
+
 static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
                                         size_t nops, void* notify_tag,
                                         int is_notify_tag_closure) {
@@ -1560,7 +1986,8 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
   int num_recv_ops = 0;
   grpc_call_error error = GRPC_CALL_OK;
   grpc_transport_stream_op_batch* stream_op;
-  grpc_transport_stream_op_batch_payload* stream_op_payload;
+  const grpc_op* unary_ops[GRPC_OP_RECV_CLOSE_ON_SERVER + 1];
+  uint32_t unary_mask;
 
   GRPC_CALL_LOG_BATCH(GPR_INFO, ops, nops);
 
@@ -1588,7 +2015,14 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
       static_cast<uint8_t>(is_notify_tag_closure != 0);
 
   stream_op = &bctl->op;
-  stream_op_payload = &call->stream_op_payload;
+
+  if (match_unary_batch(call, ops, nops, unary_ops, &unary_mask)) {
+    error =
+        add_unary_batch_ops(call, bctl, unary_ops, unary_mask, &num_recv_ops);
+    if (error != GRPC_CALL_OK) goto done_with_error;
+    has_send_ops = true;
+    goto start_batch;
+  }
 
   /* rewrite batch ops into a transport op */
   for (i = 0; i < nops; i++) {
@@ -1608,69 +2042,8 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        // TODO(juanlishen): If the user has already specified a compression
-        // algorithm by setting the initial metadata with key of
-        // GRPC_COMPRESSION_REQUEST_ALGORITHM_MD_KEY, we shouldn't override that
-        // with the compression algorithm mapped from compression level.
-        /* process compression level */
-        grpc_metadata& compression_md = call->compression_md;
-        compression_md.key = grpc_empty_slice();
-        compression_md.value = grpc_empty_slice();
-        compression_md.flags = 0;
-        size_t additional_metadata_count = 0;
-        grpc_compression_level effective_compression_level =
-            GRPC_COMPRESS_LEVEL_NONE;
-        bool level_set = false;
-        if (op->data.send_initial_metadata.maybe_compression_level.is_set) {
-          effective_compression_level =
-              op->data.send_initial_metadata.maybe_compression_level.level;
-          level_set = true;
-        } else {
-          const grpc_compression_options copts =
-              grpc_channel_compression_options(call->channel);
-          if (copts.default_level.is_set) {
-            level_set = true;
-            effective_compression_level = copts.default_level.level;
-          }
-        }
-        // Currently, only server side supports compression level setting.
-        if (level_set && !call->is_client) {
-          const grpc_compression_algorithm calgo =
-              compression_algorithm_for_level_locked(
-                  call, effective_compression_level);
-          // The following metadata will be checked and removed by the message
-          // compression filter. It will be used as the call's compression
-          // algorithm.
-          compression_md.key = GRPC_MDSTR_GRPC_INTERNAL_ENCODING_REQUEST;
-          compression_md.value = grpc_compression_algorithm_slice(calgo);
-          additional_metadata_count++;
-        }
-        if (op->data.send_initial_metadata.count + additional_metadata_count >
-            INT_MAX) {
-          error = GRPC_CALL_ERROR_INVALID_METADATA;
-          goto done_with_error;
-        }
-        stream_op->send_initial_metadata = true;
-        call->sent_initial_metadata = true;
-        if (!prepare_application_metadata(
-                call, static_cast<int>(op->data.send_initial_metadata.count),
-                op->data.send_initial_metadata.metadata, 0, call->is_client,
-                &compression_md, static_cast<int>(additional_metadata_count))) {
-          error = GRPC_CALL_ERROR_INVALID_METADATA;
-          goto done_with_error;
-        }
-        /* TODO(ctiller): just make these the same variable? */
-        if (call->is_client) {
-          call->metadata_batch[0][0].deadline = call->send_deadline;
-        }
-        stream_op_payload->send_initial_metadata.send_initial_metadata =
-            &call->metadata_batch[0 /* is_receiving */][0 /* is_trailing */];
-        stream_op_payload->send_initial_metadata.send_initial_metadata_flags =
-            op->flags;
-        if (call->is_client) {
-          stream_op_payload->send_initial_metadata.peer_string =
-              &call->peer_string;
-        }
+        error = add_send_initial_metadata_op(call, bctl, op);
+        if (error != GRPC_CALL_OK) goto done_with_error;
         has_send_ops = true;
         break;
       }
@@ -1687,20 +2060,7 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        uint32_t flags = op->flags;
-        /* If the outgoing buffer is already compressed, mark it as so in the
-           flags. These will be picked up by the compression filter and further
-           (wasteful) attempts at compression skipped. */
-        if (op->data.send_message.send_message->data.raw.compression >
-            GRPC_COMPRESS_NONE) {
-          flags |= GRPC_WRITE_INTERNAL_COMPRESS;
-        }
-        stream_op->send_message = true;
-        call->sending_message = true;
-        call->sending_stream.Init(
-            &op->data.send_message.send_message->data.raw.slice_buffer, flags);
-        stream_op_payload->send_message.send_message.reset(
-            call->sending_stream.get());
+        add_send_message_op(call, bctl, op);
         has_send_ops = true;
         break;
       }
@@ -1718,10 +2078,7 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        stream_op->send_trailing_metadata = true;
-        call->sent_final_op = true;
-        stream_op_payload->send_trailing_metadata.send_trailing_metadata =
-            &call->metadata_batch[0 /* is_receiving */][1 /* is_trailing */];
+        add_send_close_from_client_op(call, bctl);
         has_send_ops = true;
         break;
       }
@@ -1739,59 +2096,8 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        if (op->data.send_status_from_server.trailing_metadata_count >
-            INT_MAX) {
-          error = GRPC_CALL_ERROR_INVALID_METADATA;
-          goto done_with_error;
-        }
-        stream_op->send_trailing_metadata = true;
-        call->sent_final_op = true;
-        GPR_ASSERT(call->send_extra_metadata_count == 0);
-        call->send_extra_metadata_count = 1;
-        call->send_extra_metadata[0].md = grpc_get_reffed_status_elem(
-            op->data.send_status_from_server.status);
-        grpc_error* status_error =
-            op->data.send_status_from_server.status == GRPC_STATUS_OK
-                ? GRPC_ERROR_NONE
-                : grpc_error_set_int(
-                      GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-                          "Server returned error"),
-                      GRPC_ERROR_INT_GRPC_STATUS,
-                      static_cast<intptr_t>(
-                          op->data.send_status_from_server.status));
-        if (op->data.send_status_from_server.status_details != nullptr) {
-          call->send_extra_metadata[1].md = grpc_mdelem_from_slices(
-              GRPC_MDSTR_GRPC_MESSAGE,
-              grpc_slice_ref_internal(
-                  *op->data.send_status_from_server.status_details));
-          call->send_extra_metadata_count++;
-          if (status_error != GRPC_ERROR_NONE) {
-            char* msg = grpc_slice_to_c_string(
-                GRPC_MDVALUE(call->send_extra_metadata[1].md));
-            status_error =
-                grpc_error_set_str(status_error, GRPC_ERROR_STR_GRPC_MESSAGE,
-                                   grpc_slice_from_copied_string(msg));
-            gpr_free(msg);
-          }
-        }
-
-        gpr_atm_rel_store(&call->status_error,
-                          reinterpret_cast<gpr_atm>(status_error));
-        if (!prepare_application_metadata(
-                call,
-                static_cast<int>(
-                    op->data.send_status_from_server.trailing_metadata_count),
-                op->data.send_status_from_server.trailing_metadata, 1, 1,
-                nullptr, 0)) {
-          for (int n = 0; n < call->send_extra_metadata_count; n++) {
-            GRPC_MDELEM_UNREF(call->send_extra_metadata[n].md);
-          }
-          call->send_extra_metadata_count = 0;
-          error = GRPC_CALL_ERROR_INVALID_METADATA;
-          goto done_with_error;
-        }
-        stream_op_payload->send_trailing_metadata.send_trailing_metadata =
-            &call->metadata_batch[0 /* is_receiving */][1 /* is_trailing */];
+        error = add_send_status_from_server_op(call, bctl, op);
+        if (error != GRPC_CALL_OK) goto done_with_error;
         has_send_ops = true;
         break;
       }
@@ -1805,21 +2111,7 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        call->received_initial_metadata = true;
-        call->buffered_metadata[0] =
-            op->data.recv_initial_metadata.recv_initial_metadata;
-        GRPC_CLOSURE_INIT(&call->receiving_initial_metadata_ready,
-                          receiving_initial_metadata_ready, bctl,
-                          grpc_schedule_on_exec_ctx);
-        stream_op->recv_initial_metadata = true;
-        stream_op_payload->recv_initial_metadata.recv_initial_metadata =
-            &call->metadata_batch[1 /* is_receiving */][0 /* is_trailing */];
-        stream_op_payload->recv_initial_metadata.recv_initial_metadata_ready =
-            &call->receiving_initial_metadata_ready;
-        if (!call->is_client) {
-          stream_op_payload->recv_initial_metadata.peer_string =
-              &call->peer_string;
-        }
+        add_recv_initial_metadata_op(call, bctl, op);
         ++num_recv_ops;
         break;
       }
@@ -1833,15 +2125,7 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        call->receiving_message = true;
-        stream_op->recv_message = true;
-        call->receiving_buffer = op->data.recv_message.recv_message;
-        stream_op_payload->recv_message.recv_message = &call->receiving_stream;
-        GRPC_CLOSURE_INIT(&call->receiving_stream_ready,
-                          receiving_stream_ready_in_call_combiner, bctl,
-                          grpc_schedule_on_exec_ctx);
-        stream_op_payload->recv_message.recv_message_ready =
-            &call->receiving_stream_ready;
+        add_recv_message_op(call, bctl, op);
         ++num_recv_ops;
         break;
       }
@@ -1859,24 +2143,7 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        call->requested_final_op = true;
-        call->buffered_metadata[1] =
-            op->data.recv_status_on_client.trailing_metadata;
-        call->final_op.client.status = op->data.recv_status_on_client.status;
-        call->final_op.client.status_details =
-            op->data.recv_status_on_client.status_details;
-        call->final_op.client.error_string =
-            op->data.recv_status_on_client.error_string;
-        stream_op->recv_trailing_metadata = true;
-        stream_op_payload->recv_trailing_metadata.recv_trailing_metadata =
-            &call->metadata_batch[1 /* is_receiving */][1 /* is_trailing */];
-        stream_op_payload->recv_trailing_metadata.collect_stats =
-            &call->final_info.stats.transport_stream_stats;
-        GRPC_CLOSURE_INIT(&call->receiving_trailing_metadata_ready,
-                          receiving_trailing_metadata_ready, bctl,
-                          grpc_schedule_on_exec_ctx);
-        stream_op_payload->recv_trailing_metadata.recv_trailing_metadata_ready =
-            &call->receiving_trailing_metadata_ready;
+        add_recv_status_on_client_op(call, bctl, op);
         ++num_recv_ops;
         break;
       }
@@ -1894,25 +2161,14 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
-        call->requested_final_op = true;
-        call->final_op.server.cancelled =
-            op->data.recv_close_on_server.cancelled;
-        stream_op->recv_trailing_metadata = true;
-        stream_op_payload->recv_trailing_metadata.recv_trailing_metadata =
-            &call->metadata_batch[1 /* is_receiving */][1 /* is_trailing */];
-        stream_op_payload->recv_trailing_metadata.collect_stats =
-            &call->final_info.stats.transport_stream_stats;
-        GRPC_CLOSURE_INIT(&call->receiving_trailing_metadata_ready,
-                          receiving_trailing_metadata_ready, bctl,
-                          grpc_schedule_on_exec_ctx);
-        stream_op_payload->recv_trailing_metadata.recv_trailing_metadata_ready =
-            &call->receiving_trailing_metadata_ready;
+        add_recv_close_on_server_op(call, bctl, op);
         ++num_recv_ops;
         break;
       }
     }
   }
 
+start_batch:
   GRPC_CALL_INTERNAL_REF(call, "completion");
   if (!is_notify_tag_closure) {
     GPR_ASSERT(grpc_cq_begin_op(call->cq, notify_tag));
@@ -1925,6 +2181,10 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
     stream_op->on_complete = &bctl->finish_batch;
   }
 
+  /* The transport only records write timestamps for traced batches */
+  stream_op->is_traced =
+      call->context[GRPC_CONTEXT_WRITE_TIMESTAMPS].value != nullptr;
+
   gpr_atm_rel_store(&call->any_ops_sent_atm, 1);
   execute_batch(call, stream_op, &bctl->start_batch);
 
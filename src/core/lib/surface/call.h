@@ -49,6 +49,10 @@ typedef struct grpc_call_create_args {
   size_t add_initial_metadata_count;
 
   grpc_millis send_deadline;
+
+  /* handle of the registered method of a client call, if any: it keeps the
+     arena size estimate for its calls */
+  void* registered_call_handle;
 } grpc_call_create_args;
 
 /* Create a new call based on \a args.
@@ -86,6 +90,12 @@ grpc_call_error grpc_call_start_batch_and_execute(grpc_call* call,
  * exec_ctx. */
 void grpc_call_cancel_internal(grpc_call* call);
 
+/* gRPC core internal version of grpc_call_cancel_with_status that does not
+ * create exec_ctx. */
+void grpc_call_cancel_with_status_internal(grpc_call* call,
+                                           grpc_status_code status,
+                                           const char* description);
+
 /* Given the top call_element, get the call object. */
 grpc_call* grpc_call_from_top_element(grpc_call_element* surface_element);
 
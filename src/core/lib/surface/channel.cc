@@ -34,6 +34,7 @@
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/channel/channelz_registry.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
@@ -57,11 +58,70 @@
 typedef struct registered_call {
   grpc_mdelem path;
   grpc_mdelem authority;
+  /* arena size estimate of this method's calls (0 until one finished) */
+  gpr_atm call_size_estimate;
   struct registered_call* next;
 } registered_call;
 
+/* Reserves the memory a channel's call arena pool may cache from the channel's
+   resource quota, and empties the pool and hands the reservation back when
+   the quota runs short. The pool then stops caching. */
+struct arena_pool_reclaimer {
+  grpc_core::ArenaPool* pool;
+  /* the channel's own resource user may be shared, and would only take one
+     benign reclaimer */
+  grpc_resource_user* resource_user;
+  size_t reserved_bytes;
+  grpc_closure closure;
+  /* one for the channel, one while the reclaimer is posted */
+  gpr_refcount refs;
+};
+
 static void destroy_channel(void* arg, grpc_error* error);
 
+static void arena_pool_reclaimer_unref(arena_pool_reclaimer* r) {
+  if (!gpr_unref(&r->refs)) return;
+  delete r->pool;
+  if (r->reserved_bytes > 0) {
+    grpc_resource_user_free(r->resource_user, r->reserved_bytes);
+  }
+  grpc_resource_user_unref(r->resource_user);
+  gpr_free(r);
+}
+
+static void reclaim_arena_pool(void* arg, grpc_error* error) {
+  arena_pool_reclaimer* r = static_cast<arena_pool_reclaimer*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    GRPC_STATS_INC_COUNTER_BY(
+        GRPC_STATS_COUNTER_MEMORY_RECLAIMED_ARENA_POOL_BYTES,
+        r->pool->Release());
+    grpc_resource_user_free(r->resource_user, r->reserved_bytes);
+    r->reserved_bytes = 0;
+    grpc_resource_user_finish_reclamation(r->resource_user);
+  }
+  arena_pool_reclaimer_unref(r);
+}
+
+static arena_pool_reclaimer* create_arena_pool_reclaimer(
+    grpc_resource_user* channel_resource_user, size_t arena_pool_size) {
+  grpc_resource_user* resource_user = grpc_resource_user_create(
+      grpc_resource_user_quota(channel_resource_user), "call_arena_pool");
+  if (!grpc_resource_user_safe_alloc(resource_user, arena_pool_size)) {
+    grpc_resource_user_unref(resource_user);
+    return nullptr;
+  }
+  arena_pool_reclaimer* r =
+      static_cast<arena_pool_reclaimer*>(gpr_malloc(sizeof(*r)));
+  r->pool = new grpc_core::ArenaPool(arena_pool_size);
+  r->resource_user = resource_user;
+  r->reserved_bytes = arena_pool_size;
+  gpr_ref_init(&r->refs, 2);
+  GRPC_CLOSURE_INIT(&r->closure, reclaim_arena_pool, r,
+                    grpc_schedule_on_exec_ctx);
+  grpc_resource_user_post_reclaimer(resource_user, false, &r->closure);
+  return r;
+}
+
 grpc_channel* grpc_channel_create_with_builder(
     grpc_channel_stack_builder* builder,
     grpc_channel_stack_type channel_stack_type) {
@@ -99,6 +159,8 @@ grpc_channel* grpc_channel_create_with_builder(
           grpc_call_get_initial_size_estimate());
 
   grpc_compression_options_init(&channel->compression_options);
+  channel->per_message_decompression = true;
+  int arena_pool_size = 0;
   for (size_t i = 0; i < args->num_args; i++) {
     if (0 ==
         strcmp(args->args[i].key, GRPC_COMPRESSION_CHANNEL_DEFAULT_LEVEL)) {
@@ -121,6 +183,25 @@ grpc_channel* grpc_channel_create_with_builder(
       channel->compression_options.enabled_algorithms_bitset =
           static_cast<uint32_t>(args->args[i].value.integer) |
           0x1; /* always support no compression */
+    } else if (0 == strcmp(args->args[i].key,
+                           GRPC_COMPRESSION_CHANNEL_DEFLATE_DICTIONARIES)) {
+      if (args->args[i].type == GRPC_ARG_POINTER) {
+        GPR_ASSERT(args->args[i].value.pointer.p != nullptr);
+        channel->compression_dictionaries = grpc_compression_dictionaries_ref(
+            static_cast<grpc_compression_dictionaries*>(
+                args->args[i].value.pointer.p));
+      } else {
+        gpr_log(GPR_DEBUG, GRPC_COMPRESSION_CHANNEL_DEFLATE_DICTIONARIES
+                " should be a pointer");
+      }
+    } else if (0 ==
+               strcmp(args->args[i].key,
+                      GRPC_COMPRESSION_CHANNEL_PER_MESSAGE_DECOMPRESSION)) {
+      channel->per_message_decompression =
+          grpc_channel_arg_get_bool(&args->args[i], true);
+    } else if (0 == strcmp(args->args[i].key, GRPC_ARG_CALL_ARENA_POOL_SIZE)) {
+      arena_pool_size = grpc_channel_arg_get_integer(&args->args[i],
+                                                     {0, 0, INT_MAX});
     } else if (0 == strcmp(args->args[i].key, GRPC_ARG_CHANNELZ_CHANNEL_NODE)) {
       if (args->args[i].type == GRPC_ARG_POINTER) {
         GPR_ASSERT(args->args[i].value.pointer.p != nullptr);
@@ -133,6 +214,17 @@ grpc_channel* grpc_channel_create_with_builder(
       }
     }
   }
+  if (arena_pool_size > 0) {
+    if (resource_user == nullptr) {
+      channel->arena_pool = new grpc_core::ArenaPool(arena_pool_size);
+    } else {
+      channel->arena_pool_reclaimer =
+          create_arena_pool_reclaimer(resource_user, arena_pool_size);
+      if (channel->arena_pool_reclaimer != nullptr) {
+        channel->arena_pool = channel->arena_pool_reclaimer->pool;
+      }
+    }
+  }
 
   grpc_channel_args_destroy(args);
   return channel;
@@ -199,6 +291,9 @@ void CreateChannelzNode(grpc_channel_stack_builder* builder) {
       grpc_channel_args_find(args,
                              GRPC_ARG_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE),
       {GRPC_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE_DEFAULT, 0, INT_MAX});
+  const uint32_t call_sampling_period = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_CHANNELZ_CALL_SAMPLING_PERIOD),
+      {GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT, 1, INT_MAX});
   const intptr_t channelz_parent_uuid =
       grpc_core::channelz::GetParentUuidFromArgs(*args);
   // Create the channelz node.
@@ -206,7 +301,7 @@ void CreateChannelzNode(grpc_channel_stack_builder* builder) {
   grpc_core::RefCountedPtr<grpc_core::channelz::ChannelNode> channelz_node =
       grpc_core::MakeRefCounted<grpc_core::channelz::ChannelNode>(
           target != nullptr ? target : "", channel_tracer_max_memory,
-          channelz_parent_uuid);
+          channelz_parent_uuid, call_sampling_period);
   channelz_node->AddTraceEvent(
       grpc_core::channelz::ChannelTrace::Severity::Info,
       grpc_slice_from_static_string("Channel created"));
@@ -294,28 +389,31 @@ grpc_channel* grpc_channel_create(const char* target,
   return channel;
 }
 
-size_t grpc_channel_get_call_size_estimate(grpc_channel* channel) {
+size_t grpc_channel_get_call_size_estimate(grpc_channel* channel,
+                                           void* registered_call_handle) {
 #define ROUND_UP_SIZE 256
+  gpr_atm estimate = gpr_atm_no_barrier_load(&channel->call_size_estimate);
+  if (registered_call_handle != nullptr) {
+    gpr_atm method_estimate = gpr_atm_no_barrier_load(
+        &static_cast<registered_call*>(registered_call_handle)
+             ->call_size_estimate);
+    if (method_estimate != 0) estimate = method_estimate;
+  }
   /* We round up our current estimate to the NEXT value of ROUND_UP_SIZE.
      This ensures:
       1. a consistent size allocation when our estimate is drifting slowly
          (which is common) - which tends to help most allocators reuse memory
       2. a small amount of allowed growth over the estimate without hitting
          the arena size doubling case, reducing overall memory usage */
-  return (static_cast<size_t>(
-              gpr_atm_no_barrier_load(&channel->call_size_estimate)) +
-          2 * ROUND_UP_SIZE) &
+  return (static_cast<size_t>(estimate) + 2 * ROUND_UP_SIZE) &
          ~static_cast<size_t>(ROUND_UP_SIZE - 1);
 }
 
-void grpc_channel_update_call_size_estimate(grpc_channel* channel,
-                                            size_t size) {
-  size_t cur = static_cast<size_t>(
-      gpr_atm_no_barrier_load(&channel->call_size_estimate));
+static void update_call_size_estimate(gpr_atm* estimate, size_t size) {
+  size_t cur = static_cast<size_t>(gpr_atm_no_barrier_load(estimate));
   if (cur < size) {
     /* size grew: update estimate */
-    gpr_atm_no_barrier_cas(&channel->call_size_estimate,
-                           static_cast<gpr_atm>(cur),
+    gpr_atm_no_barrier_cas(estimate, static_cast<gpr_atm>(cur),
                            static_cast<gpr_atm>(size));
     /* if we lose: never mind, something else will likely update soon enough */
   } else if (cur == size) {
@@ -323,12 +421,26 @@ void grpc_channel_update_call_size_estimate(grpc_channel* channel,
   } else if (cur > 0) {
     /* size shrank: decrease estimate */
     gpr_atm_no_barrier_cas(
-        &channel->call_size_estimate, static_cast<gpr_atm>(cur),
+        estimate, static_cast<gpr_atm>(cur),
         static_cast<gpr_atm>(GPR_MIN(cur - 1, (255 * cur + size) / 256)));
     /* if we lose: never mind, something else will likely update soon enough */
   }
 }
 
+void grpc_channel_update_call_size_estimate(grpc_channel* channel,
+                                            void* registered_call_handle,
+                                            size_t size) {
+  /* the channel wide estimate covers all calls: it's what calls of methods
+     without an estimate of their own start with */
+  update_call_size_estimate(&channel->call_size_estimate, size);
+  if (registered_call_handle != nullptr) {
+    update_call_size_estimate(
+        &static_cast<registered_call*>(registered_call_handle)
+             ->call_size_estimate,
+        size);
+  }
+}
+
 char* grpc_channel_get_target(grpc_channel* channel) {
   GRPC_API_TRACE("grpc_channel_get_target(channel=%p)", 1, (channel));
   return gpr_strdup(channel->target);
@@ -357,7 +469,7 @@ static grpc_call* grpc_channel_create_call_internal(
     grpc_channel* channel, grpc_call* parent_call, uint32_t propagation_mask,
     grpc_completion_queue* cq, grpc_pollset_set* pollset_set_alternative,
     grpc_mdelem path_mdelem, grpc_mdelem authority_mdelem,
-    grpc_millis deadline) {
+    grpc_millis deadline, void* registered_call_handle) {
   grpc_mdelem send_metadata[2];
   size_t num_metadata = 0;
 
@@ -380,6 +492,7 @@ static grpc_call* grpc_channel_create_call_internal(
   args.add_initial_metadata = send_metadata;
   args.add_initial_metadata_count = num_metadata;
   args.send_deadline = deadline;
+  args.registered_call_handle = registered_call_handle;
 
   grpc_call* call;
   GRPC_LOG_IF_ERROR("call_create", grpc_call_create(&args, &call));
@@ -399,7 +512,7 @@ grpc_call* grpc_channel_create_call(grpc_channel* channel,
       grpc_mdelem_create(GRPC_MDSTR_PATH, method, nullptr),
       host != nullptr ? grpc_mdelem_create(GRPC_MDSTR_AUTHORITY, *host, nullptr)
                       : GRPC_MDNULL,
-      grpc_timespec_to_millis_round_up(deadline));
+      grpc_timespec_to_millis_round_up(deadline), nullptr);
 
   return call;
 }
@@ -414,7 +527,7 @@ grpc_call* grpc_channel_create_pollset_set_call(
       grpc_mdelem_create(GRPC_MDSTR_PATH, method, nullptr),
       host != nullptr ? grpc_mdelem_create(GRPC_MDSTR_AUTHORITY, *host, nullptr)
                       : GRPC_MDNULL,
-      deadline);
+      deadline, nullptr);
 }
 
 void* grpc_channel_register_call(grpc_channel* channel, const char* method,
@@ -433,6 +546,7 @@ void* grpc_channel_register_call(grpc_channel* channel, const char* method,
       host ? grpc_mdelem_from_slices(GRPC_MDSTR_AUTHORITY,
                                      grpc_core::ExternallyManagedSlice(host))
            : GRPC_MDNULL;
+  rc->call_size_estimate = 0;
   gpr_mu_lock(&channel->registered_call_mu);
   rc->next = channel->registered_calls;
   channel->registered_calls = rc;
@@ -462,7 +576,7 @@ grpc_call* grpc_channel_create_registered_call(
   grpc_call* call = grpc_channel_create_call_internal(
       channel, parent_call, propagation_mask, completion_queue, nullptr,
       GRPC_MDELEM_REF(rc->path), GRPC_MDELEM_REF(rc->authority),
-      grpc_timespec_to_millis_round_up(deadline));
+      grpc_timespec_to_millis_round_up(deadline), rc);
 
   return call;
 }
@@ -493,10 +607,20 @@ static void destroy_channel(void* arg, grpc_error* /*error*/) {
     GRPC_MDELEM_UNREF(rc->authority);
     gpr_free(rc);
   }
+  if (channel->arena_pool_reclaimer != nullptr) {
+    /* cancels the reclaimer if it is still posted */
+    grpc_resource_user_shutdown(channel->arena_pool_reclaimer->resource_user);
+    arena_pool_reclaimer_unref(channel->arena_pool_reclaimer);
+  } else {
+    delete channel->arena_pool;
+  }
   if (channel->resource_user != nullptr) {
     grpc_resource_user_free(channel->resource_user,
                             GRPC_RESOURCE_QUOTA_CHANNEL_SIZE);
   }
+  if (channel->compression_dictionaries != nullptr) {
+    grpc_compression_dictionaries_unref(channel->compression_dictionaries);
+  }
   gpr_mu_destroy(&channel->registered_call_mu);
   gpr_free(channel->target);
   gpr_free(channel);
@@ -24,6 +24,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 grpc_channel* grpc_channel_create(const char* target,
@@ -59,16 +60,31 @@ grpc_channel_stack* grpc_channel_get_channel_stack(grpc_channel* channel);
 grpc_core::channelz::ChannelNode* grpc_channel_get_channelz_node(
     grpc_channel* channel);
 
-size_t grpc_channel_get_call_size_estimate(grpc_channel* channel);
-void grpc_channel_update_call_size_estimate(grpc_channel* channel, size_t size);
+/** Initial arena size for a call on \a channel. Calls created with a
+    registered call handle get an estimate of their own method, once one of
+    them has finished; \a registered_call_handle may be null. */
+size_t grpc_channel_get_call_size_estimate(grpc_channel* channel,
+                                           void* registered_call_handle);
+/** Feed the final arena \a size of a finished call back to the estimates */
+void grpc_channel_update_call_size_estimate(grpc_channel* channel,
+                                            void* registered_call_handle,
+                                            size_t size);
 
 struct registered_call;
 struct grpc_channel {
   int is_client;
   grpc_compression_options compression_options;
+  /* deflate dictionaries that received messages may be compressed with */
+  grpc_compression_dictionaries* compression_dictionaries;
+  /* false if received messages are left compressed */
+  bool per_message_decompression;
 
   gpr_atm call_size_estimate;
   grpc_resource_user* resource_user;
+  /* keeps the arenas of finished calls for new ones (if enabled) */
+  grpc_core::ArenaPool* arena_pool;
+  /* empties arena_pool under memory pressure, if there is a resource_user */
+  struct arena_pool_reclaimer* arena_pool_reclaimer;
 
   gpr_mu registered_call_mu;
   registered_call* registered_calls;
@@ -84,6 +100,16 @@ inline grpc_compression_options grpc_channel_compression_options(
   return channel->compression_options;
 }
 
+inline const grpc_compression_dictionaries*
+grpc_channel_compression_dictionaries(const grpc_channel* channel) {
+  return channel->compression_dictionaries;
+}
+
+inline bool grpc_channel_per_message_decompression(
+    const grpc_channel* channel) {
+  return channel->per_message_decompression;
+}
+
 inline grpc_channel_stack* grpc_channel_get_channel_stack(
     grpc_channel* channel) {
   return CHANNEL_STACK_FROM_CHANNEL(channel);
@@ -25,6 +25,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
@@ -33,6 +34,7 @@
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/pollset.h"
@@ -56,6 +58,11 @@ namespace {
 GPR_TLS_DECL(g_cached_event);
 GPR_TLS_DECL(g_cached_cq);
 
+// The sharded event queue this thread last called next on, and the shard of
+// it that the thread prefers. See CqShardedEventQueue.
+GPR_TLS_DECL(g_home_queue);
+GPR_TLS_DECL(g_home_shard);
+
 typedef struct {
   grpc_pollset_worker** worker;
   void* tag;
@@ -195,7 +202,8 @@ struct cq_vtable {
   grpc_cq_completion_type cq_completion_type;
   size_t data_size;
   void (*init)(void* data,
-               grpc_experimental_completion_queue_functor* shutdown_callback);
+               grpc_experimental_completion_queue_functor* shutdown_callback,
+               int num_shards);
   void (*shutdown)(grpc_completion_queue* cq);
   void (*destroy)(void* data);
   bool (*begin_op)(grpc_completion_queue* cq, void* tag);
@@ -227,6 +235,10 @@ class CqEventQueue {
 
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
+  /* Pops up to \a max completions into \a out while holding the consumer lock
+   * once. Returns the number popped, which may be zero even if the queue is
+   * not empty. */
+  size_t PopBatch(grpc_cq_completion** out, size_t max);
 
  private:
   /* Spinlock to serialize consumers i.e pop() operations */
@@ -240,11 +252,47 @@ class CqEventQueue {
   grpc_core::Atomic<intptr_t> num_queue_items_{0};
 };
 
+/* The event queue of a GRPC_CQ_NEXT completion queue, split into one or more
+ * CqEventQueue shards. A thread that calls next on the queue gets a home shard.
+ * It pops from that shard first and steals from the others when it is empty,
+ * and completions it queues itself (e.g. from the closures run while it
+ * polls) go to it too. Completions queued from any other thread go to the
+ * shard of the current cpu. With one shard this is just a CqEventQueue. */
+class CqShardedEventQueue {
+ public:
+  explicit CqShardedEventQueue(size_t num_shards);
+  ~CqShardedEventQueue() { delete[] shards_; }
+
+  /* Sum of the shards' num_items(), so equally only eventually consistent */
+  intptr_t num_items() const;
+
+  bool Push(grpc_cq_completion* c);
+  grpc_cq_completion* Pop();
+  size_t PopBatch(grpc_cq_completion** out, size_t max);
+
+ private:
+  /* Keeps shards on separate cache lines, as each has its own consumers */
+  struct Shard {
+    CqEventQueue queue;
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  /* The calling thread's home shard, assigned on its first call */
+  size_t HomeShard();
+
+  size_t num_shards_;
+  Shard* shards_;
+  /* Round-robin counter handing out home shards */
+  grpc_core::Atomic<size_t> next_home_shard_{0};
+};
+
 struct cq_next_data {
+  explicit cq_next_data(int num_shards)
+      : queue(static_cast<size_t>(GPR_MAX(num_shards, 1))) {}
   ~cq_next_data() { GPR_ASSERT(queue.num_items() == 0); }
 
   /** Completed events for completion-queues of type GRPC_CQ_NEXT */
-  CqEventQueue queue;
+  CqShardedEventQueue queue;
 
   /** Counter of how many things have ever been queued on this completion queue
       useful for avoiding locks to check the queue */
@@ -376,13 +424,17 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
 static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
                            gpr_timespec deadline, void* reserved);
 
-// Note that cq_init_next and cq_init_pluck do not use the shutdown_callback
+// Note that cq_init_next and cq_init_pluck do not use the shutdown_callback,
+// and only cq_init_next uses num_shards
 static void cq_init_next(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    int num_shards);
 static void cq_init_pluck(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    int num_shards);
 static void cq_init_callback(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    int num_shards);
 static void cq_destroy_next(void* data);
 static void cq_destroy_pluck(void* data);
 static void cq_destroy_callback(void* data);
@@ -425,6 +477,8 @@ static void on_pollset_shutdown_done(void* cq, grpc_error* error);
 void grpc_cq_global_init() {
   gpr_tls_init(&g_cached_event);
   gpr_tls_init(&g_cached_cq);
+  gpr_tls_init(&g_home_queue);
+  gpr_tls_init(&g_home_shard);
 }
 
 void grpc_completion_queue_thread_local_cache_init(grpc_completion_queue* cq) {
@@ -491,17 +545,106 @@ grpc_cq_completion* CqEventQueue::Pop() {
   return c;
 }
 
+size_t CqEventQueue::PopBatch(grpc_cq_completion** out, size_t max) {
+  size_t n = 0;
+
+  if (gpr_spinlock_trylock(&queue_lock_)) {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
+
+    bool is_empty = false;
+    while (n < max) {
+      grpc_cq_completion* c = reinterpret_cast<grpc_cq_completion*>(
+          queue_.PopAndCheckEnd(&is_empty));
+      if (c == nullptr) break;
+      out[n++] = c;
+    }
+    gpr_spinlock_unlock(&queue_lock_);
+
+    if (n < max && !is_empty) {
+      GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
+    }
+  } else {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
+  }
+
+  if (n > 0) {
+    num_queue_items_.FetchSub(static_cast<intptr_t>(n),
+                              grpc_core::MemoryOrder::RELAXED);
+  }
+
+  return n;
+}
+
+CqShardedEventQueue::CqShardedEventQueue(size_t num_shards)
+    : num_shards_(num_shards), shards_(new Shard[num_shards]) {}
+
+intptr_t CqShardedEventQueue::num_items() const {
+  intptr_t n = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    n += shards_[i].queue.num_items();
+  }
+  return n;
+}
+
+size_t CqShardedEventQueue::HomeShard() {
+  if (reinterpret_cast<CqShardedEventQueue*>(gpr_tls_get(&g_home_queue)) !=
+      this) {
+    gpr_tls_set(&g_home_queue, reinterpret_cast<intptr_t>(this));
+    gpr_tls_set(&g_home_shard,
+                static_cast<intptr_t>(next_home_shard_.FetchAdd(
+                    1, grpc_core::MemoryOrder::RELAXED)));
+  }
+  return static_cast<size_t>(gpr_tls_get(&g_home_shard)) % num_shards_;
+}
+
+bool CqShardedEventQueue::Push(grpc_cq_completion* c) {
+  if (num_shards_ == 1) return shards_[0].queue.Push(c);
+  size_t shard;
+  if (reinterpret_cast<CqShardedEventQueue*>(gpr_tls_get(&g_home_queue)) ==
+      this) {
+    shard = static_cast<size_t>(gpr_tls_get(&g_home_shard)) % num_shards_;
+  } else {
+    shard = gpr_cpu_current_cpu() % num_shards_;
+  }
+  return shards_[shard].queue.Push(c);
+}
+
+grpc_cq_completion* CqShardedEventQueue::Pop() {
+  if (num_shards_ == 1) return shards_[0].queue.Pop();
+  size_t home = HomeShard();
+  for (size_t i = 0; i < num_shards_; i++) {
+    grpc_cq_completion* c = shards_[(home + i) % num_shards_].queue.Pop();
+    if (c != nullptr) {
+      if (i != 0) {
+        GRPC_STATS_INC_CQ_EV_QUEUE_STEALS();
+      }
+      return c;
+    }
+  }
+  return nullptr;
+}
+
+size_t CqShardedEventQueue::PopBatch(grpc_cq_completion** out, size_t max) {
+  if (num_shards_ == 1) return shards_[0].queue.PopBatch(out, max);
+  /* Only the home shard is drained here: the batch is extra work that is
+     already local, and stealing more than one event at a time would undo the
+     balancing the other shards' threads are doing. */
+  return shards_[HomeShard()].queue.PopBatch(out, max);
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_experimental_completion_queue_functor* shutdown_callback) {
+    grpc_experimental_completion_queue_functor* shutdown_callback,
+    int num_shards) {
   GPR_TIMER_SCOPE("grpc_completion_queue_create_internal", 0);
 
   grpc_completion_queue* cq;
 
   GRPC_API_TRACE(
       "grpc_completion_queue_create_internal(completion_type=%d, "
-      "polling_type=%d)",
-      2, (completion_type, polling_type));
+      "polling_type=%d, num_shards=%d)",
+      3, (completion_type, polling_type, num_shards));
+  GPR_ASSERT(num_shards <= 1 || completion_type == GRPC_CQ_NEXT);
 
   const cq_vtable* vtable = &g_cq_vtable[completion_type];
   const cq_poller_vtable* poller_vtable =
@@ -521,7 +664,7 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
   new (&cq->owning_refs) grpc_core::RefCount(2);
 
   poller_vtable->init(POLLSET_FROM_CQ(cq), &cq->mu);
-  vtable->init(DATA_FROM_CQ(cq), shutdown_callback);
+  vtable->init(DATA_FROM_CQ(cq), shutdown_callback, num_shards);
 
   GRPC_CLOSURE_INIT(&cq->pollset_shutdown_done, on_pollset_shutdown_done, cq,
                     grpc_schedule_on_exec_ctx);
@@ -530,8 +673,9 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
 
 static void cq_init_next(
     void* data,
-    grpc_experimental_completion_queue_functor* /*shutdown_callback*/) {
-  new (data) cq_next_data();
+    grpc_experimental_completion_queue_functor* /*shutdown_callback*/,
+    int num_shards) {
+  new (data) cq_next_data(num_shards);
 }
 
 static void cq_destroy_next(void* data) {
@@ -541,7 +685,8 @@ static void cq_destroy_next(void* data) {
 
 static void cq_init_pluck(
     void* data,
-    grpc_experimental_completion_queue_functor* /*shutdown_callback*/) {
+    grpc_experimental_completion_queue_functor* /*shutdown_callback*/,
+    int /*num_shards*/) {
   new (data) cq_pluck_data();
 }
 
@@ -551,7 +696,8 @@ static void cq_destroy_pluck(void* data) {
 }
 
 static void cq_init_callback(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback) {
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    int /*num_shards*/) {
   new (data) cq_callback_data(shutdown_callback);
 }
 
@@ -666,6 +812,14 @@ bool grpc_cq_begin_op(grpc_completion_queue* cq, void* tag) {
   return cq->vtable->begin_op(cq, tag);
 }
 
+/* Records how long \a c waited in its queue to be taken by the application.
+   Must be called before the completion's done function. */
+static void record_delivery_delay(grpc_cq_completion* c) {
+  (void)c; /* when stats are compiled out */
+  GRPC_STATS_INC_CQ_DELIVERY_DELAY_US(gpr_timespec_to_micros(
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), c->queued_at)));
+}
+
 /* Queue a GRPC_OP_COMPLETED operation to a completion queue (with a
  * completion
  * type of GRPC_CQ_NEXT) */
@@ -695,6 +849,7 @@ static void cq_end_op_for_next(
   storage->done = done;
   storage->done_arg = done_arg;
   storage->next = static_cast<uintptr_t>(is_success);
+  storage->queued_at = gpr_get_cycle_counter();
 
   cq_check_tag(cq, tag, true); /* Used in debug builds only */
 
@@ -776,6 +931,7 @@ static void cq_end_op_for_pluck(
   storage->done_arg = done_arg;
   storage->next =
       ((uintptr_t)&cqd->completed_head) | (static_cast<uintptr_t>(is_success));
+  storage->queued_at = gpr_get_cycle_counter();
 
   gpr_mu_lock(cq->mu);
   cq_check_tag(cq, tag, false); /* Used in debug builds only */
@@ -856,6 +1012,7 @@ static void cq_end_op_for_callback(
   auto* functor = static_cast<grpc_experimental_completion_queue_functor*>(tag);
   if (internal || functor->inlineable ||
       grpc_iomgr_is_any_background_poller_thread()) {
+    GRPC_STATS_INC_CQ_CALLBACK_INLINE_RUNS();
     grpc_core::ApplicationCallbackExecCtx::Enqueue(functor,
                                                    (error == GRPC_ERROR_NONE));
     GRPC_ERROR_UNREF(error);
@@ -864,6 +1021,7 @@ static void cq_end_op_for_callback(
 
   // Schedule the callback on a closure if not internal or triggered
   // from a background poller thread.
+  GRPC_STATS_INC_CQ_CALLBACK_EXECUTOR_HOPS();
   grpc_core::Executor::Run(
       GRPC_CLOSURE_CREATE(functor_callback, functor, nullptr), error);
 }
@@ -943,24 +1101,18 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
-static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
-                          void* reserved) {
+/* Fills \a events[0] with the first completion (or the timeout or shutdown)
+   seen before \a deadline and, when that is a completion, takes up to
+   \a max_events - 1 more that are already queued without waiting for them.
+   Returns the number of events filled in. */
+static size_t cq_next_events(grpc_completion_queue* cq, grpc_event* events,
+                             size_t max_events, gpr_timespec deadline) {
   GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
 
-  grpc_event ret;
+  grpc_event& ret = events[0];
+  size_t num_events = 1;
   cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
 
-  GRPC_API_TRACE(
-      "grpc_completion_queue_next("
-      "cq=%p, "
-      "deadline=gpr_timespec { tv_sec: %" PRId64
-      ", tv_nsec: %d, clock_type: %d }, "
-      "reserved=%p)",
-      5,
-      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
-       reserved));
-  GPR_ASSERT(!reserved);
-
   dump_pending_tags(cq);
 
   GRPC_CQ_INTERNAL_REF(cq, "next");
@@ -977,23 +1129,34 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
   for (;;) {
     grpc_millis iteration_deadline = deadline_millis;
 
-    if (is_finished_arg.stolen_completion != nullptr) {
-      grpc_cq_completion* c = is_finished_arg.stolen_completion;
-      is_finished_arg.stolen_completion = nullptr;
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
-      break;
+    grpc_cq_completion* c = is_finished_arg.stolen_completion;
+    is_finished_arg.stolen_completion = nullptr;
+    if (c == nullptr) {
+      c = cqd->queue.Pop();
     }
 
-    grpc_cq_completion* c = cqd->queue.Pop();
-
     if (c != nullptr) {
       ret.type = GRPC_OP_COMPLETE;
       ret.success = c->next & 1u;
       ret.tag = c->tag;
+      record_delivery_delay(c);
       c->done(c->done_arg, c);
+      if (max_events > 1) {
+        grpc_cq_completion* more[16];
+        while (num_events < max_events) {
+          size_t n = cqd->queue.PopBatch(
+              more, GPR_MIN(max_events - num_events, GPR_ARRAY_SIZE(more)));
+          if (n == 0) break;
+          for (size_t i = 0; i < n; i++) {
+            grpc_event* ev = &events[num_events++];
+            ev->type = GRPC_OP_COMPLETE;
+            ev->success = more[i]->next & 1u;
+            ev->tag = more[i]->tag;
+            record_delivery_delay(more[i]);
+            more[i]->done(more[i]->done_arg, more[i]);
+          }
+        }
+      }
       break;
     } else {
       /* If c == NULL it means either the queue is empty OR in an transient
@@ -1059,11 +1222,31 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  for (size_t i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
+  return num_events;
+}
+
+static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
+                          void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  grpc_event ret;
+  cq_next_events(cq, &ret, 1, deadline);
   return ret;
 }
 
@@ -1114,6 +1297,26 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+int grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                     grpc_event* events, int max_events,
+                                     gpr_timespec deadline, void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, events=%p, max_events=%d, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(max_events > 0);
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_NEXT);
+
+  return static_cast<int>(
+      cq_next_events(cq, events, static_cast<size_t>(max_events), deadline));
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
@@ -1227,6 +1430,7 @@ static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
       ret.type = GRPC_OP_COMPLETE;
       ret.success = c->next & 1u;
       ret.tag = c->tag;
+      record_delivery_delay(c);
       c->done(c->done_arg, c);
       break;
     }
@@ -1244,6 +1448,7 @@ static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
         ret.type = GRPC_OP_COMPLETE;
         ret.success = c->next & 1u;
         ret.tag = c->tag;
+        record_delivery_delay(c);
         c->done(c->done_arg, c);
         goto done;
       }
@@ -26,6 +26,7 @@
 #include <grpc/grpc.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/pollset.h"
 
@@ -48,6 +49,8 @@ typedef struct grpc_cq_completion {
   void* done_arg;
   /** next pointer; low bit is used to indicate success or not */
   uintptr_t next;
+  /** when the completion was queued */
+  gpr_cycle_counter queued_at;
 } grpc_cq_completion;
 
 #ifndef NDEBUG
@@ -92,6 +95,7 @@ int grpc_get_cq_poll_num(grpc_completion_queue* cc);
 
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_experimental_completion_queue_functor* shutdown_callback);
+    grpc_experimental_completion_queue_functor* shutdown_callback,
+    int num_shards = 1);
 
 #endif /* GRPC_CORE_LIB_SURFACE_COMPLETION_QUEUE_H */
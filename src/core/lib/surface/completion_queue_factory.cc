@@ -31,7 +31,8 @@ static grpc_completion_queue* default_create(
     const grpc_completion_queue_factory* /*factory*/,
     const grpc_completion_queue_attributes* attr) {
   return grpc_completion_queue_create_internal(
-      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb);
+      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb,
+      attr->version >= 3 ? attr->cq_num_shards : 1);
 }
 
 static grpc_completion_queue_factory_vtable default_vtable = {default_create};
@@ -60,14 +61,14 @@ const grpc_completion_queue_factory* grpc_completion_queue_factory_lookup(
 grpc_completion_queue* grpc_completion_queue_create_for_next(void* reserved) {
   GPR_ASSERT(!reserved);
   grpc_completion_queue_attributes attr = {1, GRPC_CQ_NEXT,
-                                           GRPC_CQ_DEFAULT_POLLING, nullptr};
+                                           GRPC_CQ_DEFAULT_POLLING, nullptr, 1};
   return g_default_cq_factory.vtable->create(&g_default_cq_factory, &attr);
 }
 
 grpc_completion_queue* grpc_completion_queue_create_for_pluck(void* reserved) {
   GPR_ASSERT(!reserved);
   grpc_completion_queue_attributes attr = {1, GRPC_CQ_PLUCK,
-                                           GRPC_CQ_DEFAULT_POLLING, nullptr};
+                                           GRPC_CQ_DEFAULT_POLLING, nullptr, 1};
   return g_default_cq_factory.vtable->create(&g_default_cq_factory, &attr);
 }
 
@@ -76,7 +77,7 @@ grpc_completion_queue* grpc_completion_queue_create_for_callback(
     void* reserved) {
   GPR_ASSERT(!reserved);
   grpc_completion_queue_attributes attr = {
-      2, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING, shutdown_callback};
+      2, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING, shutdown_callback, 1};
   return g_default_cq_factory.vtable->create(&g_default_cq_factory, &attr);
 }
 
@@ -30,10 +30,12 @@
 #include "src/core/lib/channel/channelz_registry.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/channel/handshaker_registry.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/http/httpcli.h"
 #include "src/core/lib/http/parser.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/combiner.h"
@@ -144,6 +146,7 @@ void grpc_init(void) {
     grpc_core::ApplicationCallbackExecCtx::GlobalInit();
     grpc_core::ExecCtx::GlobalInit();
     grpc_iomgr_init();
+    grpc_httpcli_init();
     gpr_timers_global_init();
     grpc_core::HandshakerRegistry::Init();
     grpc_security_init();
@@ -178,6 +181,7 @@ void grpc_shutdown_internal_locked(void) {
           g_all_of_the_plugins[i].destroy();
         }
       }
+      grpc_httpcli_shutdown();
     }
     grpc_iomgr_shutdown();
     gpr_timers_global_destroy();
@@ -185,6 +189,7 @@ void grpc_shutdown_internal_locked(void) {
     grpc_mdctx_global_shutdown();
     grpc_core::HandshakerRegistry::Shutdown();
     grpc_slice_intern_shutdown();
+    grpc_msg_compress_shutdown();
     grpc_core::channelz::ChannelzRegistry::Shutdown();
     grpc_stats_shutdown();
     grpc_core::Fork::GlobalShutdown();
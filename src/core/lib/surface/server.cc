@@ -28,7 +28,9 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
@@ -95,12 +97,33 @@ struct requested_call {
   } data;
 };
 
-struct channel_registered_method {
+struct method_table_entry {
   registered_method* server_registered_method;
   uint32_t flags;
   bool has_host;
   grpc_core::ExternallyManagedSlice method;
   grpc_core::ExternallyManagedSlice host;
+  uint32_t hash;
+};
+
+struct method_table_slot {
+  uint32_t hash;
+  /* the entries whose method hashes to hash, those with a host first: usually
+     just one */
+  uint32_t first_entry;
+  uint32_t num_entries;
+};
+
+/* The server's registered methods, keyed by the hash of their path alone.
+   Built by grpc_server_start() as a minimal perfect hash (hash and displace):
+   the path hash picks a displacement, and the two pick the only slot that can
+   hold the path, so that a lookup takes a single probe. */
+struct method_table {
+  method_table_entry* entries;
+  method_table_slot* slots;
+  uint32_t num_slots;
+  uint32_t* displacements;
+  uint32_t num_buckets;
 };
 
 struct channel_data {
@@ -110,9 +133,6 @@ struct channel_data {
   /* linked list of all channels on a server */
   channel_data* next;
   channel_data* prev;
-  channel_registered_method* registered_methods;
-  uint32_t registered_method_slots;
-  uint32_t registered_method_max_probes;
   grpc_closure finish_destroy_channel_closure;
   intptr_t channelz_socket_uuid;
 };
@@ -193,14 +213,26 @@ struct call_data {
   grpc_closure publish;
 
   call_data* pending_next = nullptr;
+  /* when the call was added to the pending list */
+  grpc_millis queued_at = 0;
   grpc_core::CallCombiner* call_combiner;
 };
 
 struct request_matcher {
   grpc_server* server;
+  /* Guards the pending list, and makes sure a call is only added to it while
+     all of requests_per_cq are empty. Each matcher has its own, so matching
+     calls to different methods does not contend. */
+  gpr_mu mu;
   call_data* pending_head;
   call_data* pending_tail;
   LockedMultiProducerSingleConsumerQueue* requests_per_cq;
+  /* Load shedding state, guarded by mu: the smallest queueing delay seen in
+     the interval ending at shed_interval_end, and whether the previous
+     interval's minimum was above the target. */
+  grpc_millis shed_min_delay;
+  grpc_millis shed_interval_end;
+  bool shed_overloaded;
 };
 
 struct registered_method {
@@ -230,15 +262,14 @@ struct grpc_server {
   size_t pollset_count;
   bool started;
 
-  /* The two following mutexes control access to server-state
-     mu_global controls access to non-call-related state (e.g., channel state)
-     mu_call controls access to call-related state (e.g., the call lists)
+  /* mu_global controls access to non-call-related state (e.g., channel
+     state). Call-related state (the lists of pending calls) is guarded by the
+     mu of the request_matcher it belongs to.
 
      If they are ever required to be nested, you must lock mu_global
-     before mu_call. This is currently used in shutdown processing
-     (grpc_server_shutdown_and_notify and maybe_finish_shutdown) */
+     before a request_matcher's mu. This is currently used in shutdown
+     processing (grpc_server_shutdown_and_notify and maybe_finish_shutdown) */
   gpr_mu mu_global; /* mutex for server and channel state */
-  gpr_mu mu_call;   /* mutex for call-specific state */
 
   /* startup synchronization: flag is protected by mu_global, signals whether
      we are doing the listener start routine or not */
@@ -246,6 +277,8 @@ struct grpc_server {
   gpr_cv starting_cv;
 
   registered_method* registered_methods;
+  /** lookup table for registered_methods, built when the server starts */
+  method_table registered_method_table;
   /** one request matcher for unregistered methods */
   request_matcher unregistered_request_matcher;
 
@@ -264,6 +297,10 @@ struct grpc_server {
   gpr_timespec last_shutdown_message_time;
 
   grpc_core::RefCountedPtr<grpc_core::channelz::ServerNode> channelz_server;
+
+  /* load shedding configuration; a target of 0 disables it */
+  grpc_millis shed_target_delay;
+  grpc_millis shed_interval;
 };
 
 #define SERVER_FROM_CALL_ELEM(elem) \
@@ -273,7 +310,7 @@ static void publish_new_rpc(void* calld, grpc_error* error);
 static void fail_call(grpc_server* server, size_t cq_idx, requested_call* rc,
                       grpc_error* error);
 /* Before calling maybe_finish_shutdown, we must hold mu_global and not
-   hold mu_call */
+   hold any request_matcher's mu */
 static void maybe_finish_shutdown(grpc_server* server);
 
 /*
@@ -351,7 +388,11 @@ static void channel_broadcaster_shutdown(channel_broadcaster* cb,
 
 static void request_matcher_init(request_matcher* rm, grpc_server* server) {
   rm->server = server;
+  gpr_mu_init(&rm->mu);
   rm->pending_head = rm->pending_tail = nullptr;
+  rm->shed_min_delay = 0;
+  rm->shed_interval_end = 0;
+  rm->shed_overloaded = false;
   rm->requests_per_cq = static_cast<LockedMultiProducerSingleConsumerQueue*>(
       gpr_malloc(sizeof(*rm->requests_per_cq) * server->cq_count));
   for (size_t i = 0; i < server->cq_count; i++) {
@@ -365,6 +406,14 @@ static void request_matcher_destroy(request_matcher* rm) {
     rm->requests_per_cq[i].~LockedMultiProducerSingleConsumerQueue();
   }
   gpr_free(rm->requests_per_cq);
+  gpr_mu_destroy(&rm->mu);
+}
+
+static void request_matcher_lock(request_matcher* rm) {
+  if (!gpr_mu_trylock(&rm->mu)) {
+    GRPC_STATS_INC_SERVER_REQUEST_MATCHER_LOCK_CONTENTIONS();
+    gpr_mu_lock(&rm->mu);
+  }
 }
 
 static void kill_zombie(void* elem, grpc_error* /*error*/) {
@@ -372,6 +421,46 @@ static void kill_zombie(void* elem, grpc_error* /*error*/) {
       grpc_call_from_top_element(static_cast<grpc_call_element*>(elem)));
 }
 
+static void shed_call(void* elem, grpc_error* /*error*/) {
+  grpc_call* call =
+      grpc_call_from_top_element(static_cast<grpc_call_element*>(elem));
+  grpc_call_cancel_with_status_internal(call, GRPC_STATUS_RESOURCE_EXHAUSTED,
+                                        "Server overloaded");
+  grpc_call_unref(call);
+}
+
+/* CoDel-style overload detection. Queueing delay is only a sign of overload
+   if it persists: the server counts as overloaded for an interval if no call
+   dequeued during the previous one waited less than the target. While
+   overloaded, calls that waited over twice the target are shed, so that the
+   rest are served before their deadlines instead of every call timing out.
+   Must be called with rm->mu held. */
+static bool request_matcher_should_shed_locked(request_matcher* rm,
+                                               call_data* calld) {
+  grpc_server* server = rm->server;
+  if (server->shed_target_delay == 0) return false;
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_millis delay = now - calld->queued_at;
+  if (now >= rm->shed_interval_end) {
+    /* If nothing was dequeued for a whole interval, the queue drained. */
+    bool overloaded = rm->shed_min_delay > server->shed_target_delay &&
+                      now < rm->shed_interval_end + server->shed_interval;
+    if (overloaded != rm->shed_overloaded &&
+        server->channelz_server != nullptr) {
+      server->channelz_server->AddTraceEvent(
+          grpc_core::channelz::ChannelTrace::Severity::Warning,
+          grpc_slice_from_static_string(overloaded ? "Load shedding started"
+                                                   : "Load shedding stopped"));
+    }
+    rm->shed_overloaded = overloaded;
+    rm->shed_min_delay = delay;
+    rm->shed_interval_end = now + server->shed_interval;
+  } else if (delay < rm->shed_min_delay) {
+    rm->shed_min_delay = delay;
+  }
+  return rm->shed_overloaded && delay > 2 * server->shed_target_delay;
+}
+
 static void request_matcher_zombify_all_pending_calls(request_matcher* rm) {
   while (rm->pending_head) {
     call_data* calld = rm->pending_head;
@@ -399,6 +488,132 @@ static void request_matcher_kill_requests(grpc_server* server,
   GRPC_ERROR_UNREF(error);
 }
 
+/*
+ * method table
+ */
+
+static uint32_t method_table_slot_index(uint32_t hash, uint32_t displacement,
+                                        uint32_t num_slots) {
+  /* murmur3's finalizer, so that each displacement scatters a bucket's hashes
+     independently */
+  uint32_t h = hash + displacement * 0x9e3779b9u;
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h % num_slots;
+}
+
+static const method_table_slot* method_table_find(const method_table* table,
+                                                  uint32_t hash) {
+  const uint32_t displacement =
+      table->displacements[hash % table->num_buckets];
+  const method_table_slot* slot = &table->slots[method_table_slot_index(
+      hash, displacement, table->num_slots)];
+  return slot->num_entries > 0 && slot->hash == hash ? slot : nullptr;
+}
+
+/* Gives each bucket of keys a displacement that sends its keys to slots no
+   other key uses, largest buckets first. Returns false if some bucket found
+   none. */
+static bool method_table_place(method_table* table,
+                               const std::vector<method_table_slot>& keys) {
+  std::vector<std::vector<uint32_t>> buckets(table->num_buckets);
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    buckets[keys[i].hash % table->num_buckets].push_back(i);
+  }
+  std::vector<uint32_t> order(table->num_buckets);
+  for (uint32_t i = 0; i < table->num_buckets; i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+  std::vector<bool> used(table->num_slots, false);
+  std::vector<uint32_t> chosen;
+  const uint32_t max_displacement = 64 * table->num_slots + 64;
+  for (uint32_t b : order) {
+    if (buckets[b].empty()) break;
+    uint32_t d;
+    for (d = 0; d < max_displacement; d++) {
+      chosen.clear();
+      for (uint32_t key : buckets[b]) {
+        const uint32_t slot =
+            method_table_slot_index(keys[key].hash, d, table->num_slots);
+        if (used[slot] ||
+            std::find(chosen.begin(), chosen.end(), slot) != chosen.end()) {
+          break;
+        }
+        chosen.push_back(slot);
+      }
+      if (chosen.size() == buckets[b].size()) break;
+    }
+    if (d == max_displacement) return false;
+    table->displacements[b] = d;
+    for (size_t i = 0; i < chosen.size(); i++) {
+      used[chosen[i]] = true;
+      table->slots[chosen[i]] = keys[buckets[b][i]];
+    }
+  }
+  return true;
+}
+
+static void method_table_init(method_table* table, registered_method* methods) {
+  size_t num_entries = 0;
+  for (registered_method* rm = methods; rm; rm = rm->next) {
+    num_entries++;
+  }
+  if (num_entries == 0) return;
+  GPR_ASSERT(num_entries <= UINT32_MAX);
+  table->entries = static_cast<method_table_entry*>(
+      gpr_zalloc(sizeof(method_table_entry) * num_entries));
+  method_table_entry* entry = table->entries;
+  for (registered_method* rm = methods; rm; rm = rm->next, entry++) {
+    entry->server_registered_method = rm;
+    entry->flags = rm->flags;
+    entry->has_host = rm->host != nullptr;
+    if (entry->has_host) {
+      entry->host = grpc_core::ExternallyManagedSlice(rm->host);
+    }
+    entry->method = grpc_core::ExternallyManagedSlice(rm->method);
+    entry->hash = entry->method.Hash();
+  }
+  std::stable_sort(
+      table->entries, table->entries + num_entries,
+      [](const method_table_entry& a, const method_table_entry& b) {
+        if (a.hash != b.hash) return a.hash < b.hash;
+        return a.has_host && !b.has_host;
+      });
+  /* one key per distinct hash: methods registered for several hosts, and
+     the rare paths whose hashes collide, share a slot */
+  std::vector<method_table_slot> keys;
+  for (uint32_t i = 0; i < num_entries; i++) {
+    if (keys.empty() || keys.back().hash != table->entries[i].hash) {
+      keys.push_back({table->entries[i].hash, i, 0});
+    }
+    keys.back().num_entries++;
+  }
+  const uint32_t num_keys = static_cast<uint32_t>(keys.size());
+  table->num_buckets = (num_keys + 1) / 2;
+  table->displacements =
+      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * table->num_buckets));
+  /* a table with exactly one slot per key is usually found quickly; should
+     it not be, give up on minimality a little at a time */
+  table->num_slots = num_keys;
+  for (;;) {
+    table->slots = static_cast<method_table_slot*>(
+        gpr_zalloc(sizeof(method_table_slot) * table->num_slots));
+    if (method_table_place(table, keys)) break;
+    gpr_free(table->slots);
+    table->num_slots += table->num_slots / 8 + 1;
+  }
+}
+
+static void method_table_destroy(method_table* table) {
+  gpr_free(table->entries);
+  gpr_free(table->slots);
+  gpr_free(table->displacements);
+}
+
 /*
  * server proper
  */
@@ -411,8 +626,8 @@ static void server_delete(grpc_server* server) {
   server->channelz_server.reset();
   grpc_channel_args_destroy(server->channel_args);
   gpr_mu_destroy(&server->mu_global);
-  gpr_mu_destroy(&server->mu_call);
   gpr_cv_destroy(&server->starting_cv);
+  method_table_destroy(&server->registered_method_table);
   while ((rm = server->registered_methods) != nullptr) {
     server->registered_methods = rm->next;
     if (server->started) {
@@ -549,10 +764,10 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
 
   /* no cq to take the request found: queue it on the slow list */
   GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED();
-  gpr_mu_lock(&server->mu_call);
+  request_matcher_lock(rm);
 
   // We need to ensure that all the queues are empty.  We do this under
-  // the server mu_call lock to ensure that if something is added to
+  // the matcher's lock to ensure that if something is added to
   // an empty request queue, it will block until the call is actually
   // added to the pending list.
   for (size_t i = 0; i < server->cq_count; i++) {
@@ -562,7 +777,7 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
     if (rc == nullptr) {
       continue;
     } else {
-      gpr_mu_unlock(&server->mu_call);
+      gpr_mu_unlock(&rm->mu);
       GRPC_STATS_INC_SERVER_CQS_CHECKED(i + server->cq_count);
       gpr_atm_no_barrier_store(&calld->state, ACTIVATED);
       publish_call(server, calld, cq_idx, rc);
@@ -571,6 +786,9 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
   }
 
   gpr_atm_no_barrier_store(&calld->state, PENDING);
+  if (server->shed_target_delay != 0) {
+    calld->queued_at = grpc_core::ExecCtx::Get()->Now();
+  }
   if (rm->pending_head == nullptr) {
     rm->pending_tail = rm->pending_head = calld;
   } else {
@@ -578,7 +796,7 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
     rm->pending_tail = calld;
   }
   calld->pending_next = nullptr;
-  gpr_mu_unlock(&server->mu_call);
+  gpr_mu_unlock(&rm->mu);
 }
 
 static void finish_start_new_rpc(
@@ -619,39 +837,17 @@ static void start_new_rpc(grpc_call_element* elem) {
   channel_data* chand = static_cast<channel_data*>(elem->channel_data);
   call_data* calld = static_cast<call_data*>(elem->call_data);
   grpc_server* server = chand->server;
-  uint32_t i;
-  uint32_t hash;
-  channel_registered_method* rm;
-
-  if (chand->registered_methods && calld->path_set && calld->host_set) {
-    /* TODO(ctiller): unify these two searches */
-    /* check for an exact match with host */
-    hash = GRPC_MDSTR_KV_HASH(grpc_slice_hash_internal(calld->host),
-                              grpc_slice_hash_internal(calld->path));
-    for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
-      if (rm->server_registered_method == nullptr) break;
-      if (!rm->has_host) continue;
-      if (rm->host != calld->host) continue;
-      if (rm->method != calld->path) continue;
-      if ((rm->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
-          0 == (calld->recv_initial_metadata_flags &
-                GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
-        continue;
-      }
-      finish_start_new_rpc(server, elem, &rm->server_registered_method->matcher,
-                           rm->server_registered_method->payload_handling);
-      return;
-    }
-    /* check for a wildcard method definition (no host set) */
-    hash = GRPC_MDSTR_KV_HASH(0, grpc_slice_hash_internal(calld->path));
-    for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
-      if (rm->server_registered_method == nullptr) break;
-      if (rm->has_host) continue;
+  const method_table* table = &server->registered_method_table;
+
+  if (table->num_slots > 0 && calld->path_set && calld->host_set) {
+    const method_table_slot* slot =
+        method_table_find(table, grpc_slice_hash_internal(calld->path));
+    /* an exact match with host comes before a wildcard method definition (no
+       host set) */
+    for (uint32_t i = 0; slot != nullptr && i < slot->num_entries; i++) {
+      const method_table_entry* rm = &table->entries[slot->first_entry + i];
       if (rm->method != calld->path) continue;
+      if (rm->has_host && rm->host != calld->host) continue;
       if ((rm->flags & GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST) &&
           0 == (calld->recv_initial_metadata_flags &
                 GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST)) {
@@ -690,17 +886,23 @@ static int num_channels(grpc_server* server) {
   return n;
 }
 
-static void kill_pending_work_locked(grpc_server* server, grpc_error* error) {
+static void request_matcher_kill_pending_work(grpc_server* server,
+                                              request_matcher* rm,
+                                              grpc_error* error) {
+  request_matcher_lock(rm);
+  request_matcher_kill_requests(server, rm, error);
+  request_matcher_zombify_all_pending_calls(rm);
+  gpr_mu_unlock(&rm->mu);
+}
+
+static void kill_pending_work(grpc_server* server, grpc_error* error) {
   if (server->started) {
-    request_matcher_kill_requests(server, &server->unregistered_request_matcher,
-                                  GRPC_ERROR_REF(error));
-    request_matcher_zombify_all_pending_calls(
-        &server->unregistered_request_matcher);
+    request_matcher_kill_pending_work(
+        server, &server->unregistered_request_matcher, GRPC_ERROR_REF(error));
     for (registered_method* rm = server->registered_methods; rm;
          rm = rm->next) {
-      request_matcher_kill_requests(server, &rm->matcher,
-                                    GRPC_ERROR_REF(error));
-      request_matcher_zombify_all_pending_calls(&rm->matcher);
+      request_matcher_kill_pending_work(server, &rm->matcher,
+                                        GRPC_ERROR_REF(error));
     }
   }
   GRPC_ERROR_UNREF(error);
@@ -712,10 +914,8 @@ static void maybe_finish_shutdown(grpc_server* server) {
     return;
   }
 
-  gpr_mu_lock(&server->mu_call);
-  kill_pending_work_locked(
-      server, GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
-  gpr_mu_unlock(&server->mu_call);
+  kill_pending_work(server,
+                    GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
 
   if (server->root_channel_data.next != &server->root_channel_data ||
       server->listeners_destroyed < num_listeners(server)) {
@@ -871,6 +1071,7 @@ static void accept_stream(void* cd, grpc_transport* /*transport*/,
   args.add_initial_metadata = nullptr;
   args.add_initial_metadata_count = 0;
   args.send_deadline = GRPC_MILLIS_INF_FUTURE;
+  args.registered_call_handle = nullptr;
   grpc_call* call;
   grpc_error* error = grpc_call_create(&args, &call);
   grpc_call_element* elem =
@@ -917,28 +1118,11 @@ static grpc_error* server_init_channel_elem(grpc_channel_element* elem,
   chand->server = nullptr;
   chand->channel = nullptr;
   chand->next = chand->prev = chand;
-  chand->registered_methods = nullptr;
   return GRPC_ERROR_NONE;
 }
 
 static void server_destroy_channel_elem(grpc_channel_element* elem) {
-  size_t i;
   channel_data* chand = static_cast<channel_data*>(elem->channel_data);
-  if (chand->registered_methods) {
-    for (i = 0; i < chand->registered_method_slots; i++) {
-      grpc_slice_unref_internal(chand->registered_methods[i].method);
-      GPR_DEBUG_ASSERT(chand->registered_methods[i].method.refcount ==
-                           &grpc_core::kNoopRefcount ||
-                       chand->registered_methods[i].method.refcount == nullptr);
-      if (chand->registered_methods[i].has_host) {
-        grpc_slice_unref_internal(chand->registered_methods[i].host);
-        GPR_DEBUG_ASSERT(chand->registered_methods[i].host.refcount ==
-                             &grpc_core::kNoopRefcount ||
-                         chand->registered_methods[i].host.refcount == nullptr);
-      }
-    }
-    gpr_free(chand->registered_methods);
-  }
   if (chand->server) {
     if (chand->server->channelz_server != nullptr &&
         chand->channelz_socket_uuid != 0) {
@@ -1013,7 +1197,6 @@ grpc_server* grpc_server_create(const grpc_channel_args* args, void* reserved) {
       static_cast<grpc_server*>(gpr_zalloc(sizeof(grpc_server)));
 
   gpr_mu_init(&server->mu_global);
-  gpr_mu_init(&server->mu_call);
   gpr_cv_init(&server->starting_cv);
 
   /* decremented by grpc_server_destroy */
@@ -1022,6 +1205,13 @@ grpc_server* grpc_server_create(const grpc_channel_args* args, void* reserved) {
       &server->root_channel_data;
 
   server->channel_args = grpc_channel_args_copy(args);
+  server->shed_target_delay = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args,
+                             GRPC_ARG_SERVER_LOAD_SHEDDING_TARGET_DELAY_MS),
+      {0, 0, INT_MAX});
+  server->shed_interval = grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_SERVER_LOAD_SHEDDING_INTERVAL_MS),
+      {100, 1, INT_MAX});
 
   const grpc_arg* arg = grpc_channel_args_find(args, GRPC_ARG_ENABLE_CHANNELZ);
   if (grpc_channel_arg_get_bool(arg, GRPC_ENABLE_CHANNELZ_DEFAULT)) {
@@ -1030,9 +1220,12 @@ grpc_server* grpc_server_create(const grpc_channel_args* args, void* reserved) {
     size_t channel_tracer_max_memory = grpc_channel_arg_get_integer(
         arg,
         {GRPC_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE_DEFAULT, 0, INT_MAX});
+    arg = grpc_channel_args_find(args, GRPC_ARG_CHANNELZ_CALL_SAMPLING_PERIOD);
+    uint32_t call_sampling_period = grpc_channel_arg_get_integer(
+        arg, {GRPC_CHANNELZ_CALL_SAMPLING_PERIOD_DEFAULT, 1, INT_MAX});
     server->channelz_server =
         grpc_core::MakeRefCounted<grpc_core::channelz::ServerNode>(
-            server, channel_tracer_max_memory);
+            server, channel_tracer_max_memory, call_sampling_period);
     server->channelz_server->AddTraceEvent(
         grpc_core::channelz::ChannelTrace::Severity::Info,
         grpc_slice_from_static_string("Server created"));
@@ -1071,6 +1264,14 @@ void* grpc_server_register_method(
             "grpc_server_register_method method string cannot be NULL");
     return nullptr;
   }
+  if (server->started) {
+    /* the method table is built once, by grpc_server_start() */
+    gpr_log(GPR_ERROR,
+            "grpc_server_register_method called after grpc_server_start for "
+            "%s@%s",
+            method, host ? host : "*");
+    return nullptr;
+  }
   for (m = server->registered_methods; m; m = m->next) {
     if (streq(m->method, method) && streq(m->host, host)) {
       gpr_log(GPR_ERROR, "duplicate registration for %s@%s", method,
@@ -1113,6 +1314,8 @@ void grpc_server_start(grpc_server* server) {
   for (registered_method* rm = server->registered_methods; rm; rm = rm->next) {
     request_matcher_init(&rm->matcher, server);
   }
+  method_table_init(&server->registered_method_table,
+                    server->registered_methods);
 
   gpr_mu_lock(&server->mu_global);
   server->starting = true;
@@ -1165,16 +1368,8 @@ void grpc_server_setup_transport(
     const grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode>&
         socket_node,
     grpc_resource_user* resource_user) {
-  size_t num_registered_methods;
-  size_t alloc;
-  registered_method* rm;
-  channel_registered_method* crm;
   grpc_channel* channel;
   channel_data* chand;
-  uint32_t hash;
-  size_t slots;
-  uint32_t probes;
-  uint32_t max_probes = 0;
   grpc_transport_op* op = nullptr;
 
   channel = grpc_channel_create(nullptr, args, GRPC_SERVER_CHANNEL, transport,
@@ -1202,44 +1397,6 @@ void grpc_server_setup_transport(
   }
   chand->cq_idx = cq_idx;
 
-  num_registered_methods = 0;
-  for (rm = s->registered_methods; rm; rm = rm->next) {
-    num_registered_methods++;
-  }
-  /* build a lookup table phrased in terms of mdstr's in this channels context
-     to quickly find registered methods */
-  if (num_registered_methods > 0) {
-    slots = 2 * num_registered_methods;
-    alloc = sizeof(channel_registered_method) * slots;
-    chand->registered_methods =
-        static_cast<channel_registered_method*>(gpr_zalloc(alloc));
-    for (rm = s->registered_methods; rm; rm = rm->next) {
-      grpc_core::ExternallyManagedSlice host;
-      grpc_core::ExternallyManagedSlice method(rm->method);
-      const bool has_host = rm->host != nullptr;
-      if (has_host) {
-        host = grpc_core::ExternallyManagedSlice(rm->host);
-      }
-      hash = GRPC_MDSTR_KV_HASH(has_host ? host.Hash() : 0, method.Hash());
-      for (probes = 0; chand->registered_methods[(hash + probes) % slots]
-                           .server_registered_method != nullptr;
-           probes++)
-        ;
-      if (probes > max_probes) max_probes = probes;
-      crm = &chand->registered_methods[(hash + probes) % slots];
-      crm->server_registered_method = rm;
-      crm->flags = rm->flags;
-      crm->has_host = has_host;
-      if (has_host) {
-        crm->host = host;
-      }
-      crm->method = method;
-    }
-    GPR_ASSERT(slots <= UINT32_MAX);
-    chand->registered_method_slots = static_cast<uint32_t>(slots);
-    chand->registered_method_max_probes = max_probes;
-  }
-
   gpr_mu_lock(&s->mu_global);
   chand->next = &s->root_channel_data;
   chand->prev = chand->next->prev;
@@ -1274,7 +1431,7 @@ static void listener_destroy_done(void* s, grpc_error* /*error*/) {
 /*
   - Kills all pending requests-for-incoming-RPC-calls (i.e the requests made via
     grpc_server_request_call and grpc_server_request_registered call will now be
-    cancelled). See 'kill_pending_work_locked()'
+    cancelled). See 'kill_pending_work()'
 
   - Shuts down the listeners (i.e the server will no longer listen on the port
     for new incoming channels).
@@ -1332,10 +1489,8 @@ void grpc_server_shutdown_and_notify(grpc_server* server,
   gpr_atm_rel_store(&server->shutdown_flag, 1);
 
   /* collect all unregistered then registered calls */
-  gpr_mu_lock(&server->mu_call);
-  kill_pending_work_locked(
-      server, GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
-  gpr_mu_unlock(&server->mu_call);
+  kill_pending_work(server,
+                    GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server Shutdown"));
 
   maybe_finish_shutdown(server);
   gpr_mu_unlock(&server->mu_global);
@@ -1440,12 +1595,27 @@ static grpc_call_error queue_call_request(grpc_server* server, size_t cq_idx,
   if (rm->requests_per_cq[cq_idx].Push(rc->mpscq_node.get())) {
     /* this was the first queued request: we need to lock and start
        matching calls */
-    gpr_mu_lock(&server->mu_call);
+    request_matcher_lock(rm);
     while ((calld = rm->pending_head) != nullptr) {
+      if (request_matcher_should_shed_locked(rm, calld)) {
+        rm->pending_head = calld->pending_next;
+        grpc_iomgr_cb_func cb = kill_zombie;
+        if (gpr_atm_full_cas(&calld->state, PENDING, ZOMBIED)) {
+          GRPC_STATS_INC_SERVER_CALLS_SHED();
+          cb = shed_call;
+        }
+        GRPC_CLOSURE_INIT(
+            &calld->kill_zombie_closure, cb,
+            grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
+            grpc_schedule_on_exec_ctx);
+        grpc_core::ExecCtx::Run(DEBUG_LOCATION, &calld->kill_zombie_closure,
+                                GRPC_ERROR_NONE);
+        continue;
+      }
       rc = reinterpret_cast<requested_call*>(rm->requests_per_cq[cq_idx].Pop());
       if (rc == nullptr) break;
       rm->pending_head = calld->pending_next;
-      gpr_mu_unlock(&server->mu_call);
+      gpr_mu_unlock(&rm->mu);
       if (!gpr_atm_full_cas(&calld->state, PENDING, ACTIVATED)) {
         // Zombied Call
         GRPC_CLOSURE_INIT(
@@ -1457,9 +1627,9 @@ static grpc_call_error queue_call_request(grpc_server* server, size_t cq_idx,
       } else {
         publish_call(server, calld, cq_idx, rc);
       }
-      gpr_mu_lock(&server->mu_call);
+      request_matcher_lock(rm);
     }
-    gpr_mu_unlock(&server->mu_call);
+    gpr_mu_unlock(&rm->mu);
   }
   return GRPC_CALL_OK;
 }
@@ -36,9 +36,38 @@ BdpEstimator::BdpEstimator(const char* name)
       ping_start_time_(gpr_time_0(GPR_CLOCK_MONOTONIC)),
       inter_ping_delay_(100.0),  // start at 100ms
       stable_estimate_count_(0),
-      bw_est_(0),
+      rtt_sample_(0),
+      bw_sample_(0),
       name_(name) {}
 
+double BdpEstimator::EstimateBandwidth() const {
+  double max_bandwidth = 0;
+  for (double sample : bandwidth_samples_) {
+    max_bandwidth = GPR_MAX(max_bandwidth, sample);
+  }
+  return max_bandwidth;
+}
+
+void BdpEstimator::AddSample(double bandwidth, double rtt, grpc_millis now) {
+  bandwidth_samples_[next_bandwidth_sample_] = bandwidth;
+  next_bandwidth_sample_ = (next_bandwidth_sample_ + 1) % kBandwidthSamples;
+  // an old minimum may predate a route change: let newer samples replace it
+  if (rtt > 0 && (min_rtt_ == 0 || rtt <= min_rtt_ ||
+                  now - min_rtt_time_ > kMinRttExpiry)) {
+    min_rtt_ = rtt;
+    min_rtt_time_ = now;
+  }
+  if (!filled_pipe_) {
+    const double max_bandwidth = EstimateBandwidth();
+    if (max_bandwidth >= full_bandwidth_ * 1.25) {
+      full_bandwidth_ = max_bandwidth;
+      full_bandwidth_count_ = 0;
+    } else if (++full_bandwidth_count_ >= 3) {
+      filled_pipe_ = true;
+    }
+  }
+}
+
 grpc_millis BdpEstimator::CompletePing() {
   gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
   gpr_timespec dt_ts = gpr_time_sub(now, ping_start_time_);
@@ -46,17 +75,25 @@ grpc_millis BdpEstimator::CompletePing() {
               1e-9 * static_cast<double>(dt_ts.tv_nsec);
   double bw = dt > 0 ? (static_cast<double>(accumulator_) / dt) : 0;
   int start_inter_ping_delay = inter_ping_delay_;
+  // compare against the recent samples only: a single burst must not keep
+  // the estimate from growing for good
+  const double bw_est = EstimateBandwidth();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
     gpr_log(GPR_INFO,
             "bdp[%s]:complete acc=%" PRId64 " est=%" PRId64
             " dt=%lf bw=%lfMbs bw_est=%lfMbs",
             name_, accumulator_, estimate_, dt, bw / 125000.0,
-            bw_est_ / 125000.0);
+            bw_est / 125000.0);
   }
   GPR_ASSERT(ping_state_ == PingState::STARTED);
-  if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
-    estimate_ = GPR_MAX(accumulator_, estimate_ * 2);
-    bw_est_ = bw;
+  rtt_sample_ = dt;
+  bw_sample_ = bw;
+  if (dt > 0) AddSample(bw, dt, grpc_core::ExecCtx::Get()->Now());
+  if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est) {
+    // rather than doubling for several pings, go straight to the modelled
+    // BDP when that is further
+    estimate_ = GPR_MAX(GPR_MAX(accumulator_, estimate_ * 2),
+                        static_cast<int64_t>(ModelBdp()));
     if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
       gpr_log(GPR_INFO, "bdp[%s]: estimate increased to %" PRId64, name_,
               estimate_);
@@ -41,7 +41,25 @@ class BdpEstimator {
   ~BdpEstimator() {}
 
   int64_t EstimateBdp() const { return estimate_; }
-  double EstimateBandwidth() const { return bw_est_; }
+  // The windowed max of the last few bandwidth samples (bytes per second), so
+  // that a burst is forgotten after a while
+  double EstimateBandwidth() const;
+
+  // Models the path to the peer the way BBR does: the bottleneck bandwidth is
+  // EstimateBandwidth(), and the propagation delay the minimum ping round trip
+  // time (in seconds) seen over the last ten seconds. Both are 0 before the
+  // first sample.
+  double MinRtt() const { return min_rtt_; }
+  // Bytes in flight needed to fill the path
+  double ModelBdp() const { return EstimateBandwidth() * min_rtt_; }
+  // Did the bandwidth stop growing by at least a quarter per ping, for three
+  // pings in a row? (BBR's startup exit condition)
+  bool FilledPipe() const { return filled_pipe_; }
+
+  // The round trip time (in seconds) and the bytes per second received
+  // during the most recently completed ping, 0 before the first one
+  double LastRttSample() const { return rtt_sample_; }
+  double LastBandwidthSample() const { return bw_sample_; }
 
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
@@ -78,6 +96,11 @@ class BdpEstimator {
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
+  static constexpr size_t kBandwidthSamples = 10;
+  static constexpr grpc_millis kMinRttExpiry = 10000;
+
+  void AddSample(double bandwidth, double rtt, grpc_millis now);
+
   PingState ping_state_;
   int64_t accumulator_;
   int64_t estimate_;
@@ -85,7 +108,15 @@ class BdpEstimator {
   gpr_timespec ping_start_time_;
   int inter_ping_delay_;
   int stable_estimate_count_;
-  double bw_est_;
+  double rtt_sample_;
+  double bw_sample_;
+  double bandwidth_samples_[kBandwidthSamples] = {};
+  size_t next_bandwidth_sample_ = 0;
+  double min_rtt_ = 0;
+  grpc_millis min_rtt_time_ = 0;
+  bool filled_pipe_ = false;
+  double full_bandwidth_ = 0;
+  int full_bandwidth_count_ = 0;
   const char* name_;
 };
 
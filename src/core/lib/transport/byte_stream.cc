@@ -92,6 +92,24 @@ void ByteStreamCache::Destroy() {
   }
 }
 
+bool ByteStreamCache::CacheAll() {
+  if (underlying_stream_ == nullptr) return true;
+  while (cache_buffer_.length < length_) {
+    if (!underlying_stream_->Next(length_ - cache_buffer_.length, nullptr)) {
+      return false;
+    }
+    grpc_slice slice;
+    grpc_error* error = underlying_stream_->Pull(&slice);
+    if (error != GRPC_ERROR_NONE) {
+      GRPC_ERROR_UNREF(error);
+      return false;
+    }
+    grpc_slice_buffer_add_indexed(&cache_buffer_, slice);
+  }
+  underlying_stream_.reset();
+  return true;
+}
+
 //
 // ByteStreamCache::CachingByteStream
 //
@@ -130,9 +148,13 @@ grpc_error* ByteStreamCache::CachingByteStream::Pull(grpc_slice* slice) {
   GPR_ASSERT(cache_->underlying_stream_ != nullptr);
   grpc_error* error = cache_->underlying_stream_->Pull(slice);
   if (error == GRPC_ERROR_NONE) {
-    grpc_slice_buffer_add(&cache_->cache_buffer_,
-                          grpc_slice_ref_internal(*slice));
-    ++cursor_;
+    if (cache_->caching_) {
+      // Indexed, so that small slices are not merged: the cache holds a ref
+      // to each slice pulled, and cursor_ counts them.
+      grpc_slice_buffer_add_indexed(&cache_->cache_buffer_,
+                                    grpc_slice_ref_internal(*slice));
+      ++cursor_;
+    }
     offset_ += GRPC_SLICE_LENGTH(*slice);
     // Orphan the underlying stream if it's been drained.
     if (offset_ == cache_->underlying_stream_->length()) {
@@ -146,12 +146,23 @@ class ByteStreamCache {
   // Must not be destroyed while still in use by a CachingByteStream.
   void Destroy();
 
+  // Slices pulled from the underlying stream from now on are passed through
+  // without being kept, for when the stream will not be replayed again.
+  void StopCaching() { caching_ = false; }
+
+  // Pulls the rest of the underlying stream into the cache, so that
+  // CachingByteStreams read only from the cache and may be used at the same
+  // time.  Returns false if the underlying stream could not be read
+  // synchronously.
+  bool CacheAll();
+
   grpc_slice_buffer* cache_buffer() { return &cache_buffer_; }
 
  private:
   OrphanablePtr<ByteStream> underlying_stream_;
   uint32_t length_;
   uint32_t flags_;
+  bool caching_ = true;
   grpc_slice_buffer cache_buffer_;
 };
 
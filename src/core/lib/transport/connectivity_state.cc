@@ -22,6 +22,9 @@
 
 #include <string.h>
 
+#include <map>
+#include <vector>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
@@ -53,43 +56,117 @@ const char* ConnectivityStateName(grpc_connectivity_state state) {
 // AsyncConnectivityStateWatcherInterface
 //
 
-// A fire-and-forget class to asynchronously deliver a connectivity
-// state notification to a watcher.
+// A fire-and-forget class to asynchronously deliver connectivity state
+// notifications to one or more watchers sharing a combiner.
 class AsyncConnectivityStateWatcherInterface::Notifier {
  public:
-  Notifier(RefCountedPtr<AsyncConnectivityStateWatcherInterface> watcher,
-           grpc_connectivity_state state, Combiner* combiner)
-      : watcher_(std::move(watcher)), state_(state) {
-    if (combiner != nullptr) {
-      combiner->Run(
-          GRPC_CLOSURE_INIT(&closure_, SendNotification, this, nullptr),
+  explicit Notifier(Combiner* combiner) : combiner_(combiner) {}
+
+  void AddWatcher(
+      RefCountedPtr<AsyncConnectivityStateWatcherInterface> watcher) {
+    watchers_.push_back(std::move(watcher));
+  }
+
+  // Deletes the notifier once the notifications have been delivered.
+  void Start() {
+    if (combiner_ != nullptr) {
+      combiner_->Run(
+          GRPC_CLOSURE_INIT(&closure_, SendNotifications, this, nullptr),
           GRPC_ERROR_NONE);
     } else {
-      GRPC_CLOSURE_INIT(&closure_, SendNotification, this,
+      GRPC_CLOSURE_INIT(&closure_, SendNotifications, this,
                         grpc_schedule_on_exec_ctx);
       ExecCtx::Run(DEBUG_LOCATION, &closure_, GRPC_ERROR_NONE);
     }
   }
 
  private:
-  static void SendNotification(void* arg, grpc_error* /*ignored*/) {
+  static void SendNotifications(void* arg, grpc_error* /*ignored*/) {
     Notifier* self = static_cast<Notifier*>(arg);
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
-      gpr_log(GPR_INFO, "watcher %p: delivering async notification for %s",
-              self->watcher_.get(), ConnectivityStateName(self->state_));
+    for (const auto& watcher : self->watchers_) {
+      watcher->DeliverPendingState();
     }
-    self->watcher_->OnConnectivityStateChange(self->state_);
     delete self;
   }
 
-  RefCountedPtr<AsyncConnectivityStateWatcherInterface> watcher_;
-  const grpc_connectivity_state state_;
+  Combiner* combiner_;
+  std::vector<RefCountedPtr<AsyncConnectivityStateWatcherInterface>>
+      watchers_;
   grpc_closure closure_;
 };
 
+// Collects the async watchers to notify of one state change, and schedules
+// one notifier per combiner for them when destroyed.
+class ConnectivityStateNotificationBatch {
+ public:
+  ~ConnectivityStateNotificationBatch() {
+    for (const auto& p : notifiers_) p.second->Start();
+  }
+
+  void AddWatcher(AsyncConnectivityStateWatcherInterface* watcher) {
+    AsyncConnectivityStateWatcherInterface::Notifier*& notifier =
+        notifiers_[watcher->combiner_];
+    if (notifier == nullptr) {
+      notifier = new AsyncConnectivityStateWatcherInterface::Notifier(
+          watcher->combiner_);
+    }
+    notifier->AddWatcher(watcher->Ref());
+  }
+
+ private:
+  std::map<Combiner*, AsyncConnectivityStateWatcherInterface::Notifier*>
+      notifiers_;
+};
+
 void AsyncConnectivityStateWatcherInterface::Notify(
     grpc_connectivity_state state) {
-  new Notifier(Ref(), state, combiner_);  // Deletes itself when done.
+  QueueNotification(-1, state, nullptr);
+}
+
+void AsyncConnectivityStateWatcherInterface::NotifyStateChange(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state,
+    ConnectivityStateNotificationBatch* batch) {
+  QueueNotification(old_state, new_state, batch);
+}
+
+void AsyncConnectivityStateWatcherInterface::QueueNotification(
+    int old_state, grpc_connectivity_state new_state,
+    ConnectivityStateNotificationBatch* batch) {
+  if (pending_state_.Exchange(new_state, MemoryOrder::ACQ_REL) != -1) {
+    // The pending notification will deliver the new state.
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
+      gpr_log(GPR_INFO, "watcher %p: coalescing notification for %s", this,
+              ConnectivityStateName(new_state));
+    }
+    return;
+  }
+  delivered_state_ = old_state;
+  if (batch != nullptr) {
+    batch->AddWatcher(this);
+  } else {
+    Notifier* notifier = new Notifier(combiner_);
+    notifier->AddWatcher(Ref());
+    notifier->Start();
+  }
+}
+
+void AsyncConnectivityStateWatcherInterface::DeliverPendingState() {
+  const int delivered_state = delivered_state_;
+  const int state = pending_state_.Exchange(-1, MemoryOrder::ACQ_REL);
+  if (state == delivered_state) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
+      gpr_log(GPR_INFO, "watcher %p: state is back to %s, not notifying",
+              this, ConnectivityStateName(
+                        static_cast<grpc_connectivity_state>(state)));
+    }
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
+    gpr_log(GPR_INFO, "watcher %p: delivering async notification for %s",
+            this,
+            ConnectivityStateName(static_cast<grpc_connectivity_state>(state)));
+  }
+  OnConnectivityStateChange(static_cast<grpc_connectivity_state>(state));
 }
 
 //
@@ -99,6 +176,7 @@ void AsyncConnectivityStateWatcherInterface::Notify(
 ConnectivityStateTracker::~ConnectivityStateTracker() {
   grpc_connectivity_state current_state = state_.Load(MemoryOrder::RELAXED);
   if (current_state == GRPC_CHANNEL_SHUTDOWN) return;
+  ConnectivityStateNotificationBatch batch;
   for (const auto& p : watchers_) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
       gpr_log(GPR_INFO,
@@ -106,7 +184,8 @@ ConnectivityStateTracker::~ConnectivityStateTracker() {
               name_, this, p.first, ConnectivityStateName(current_state),
               ConnectivityStateName(GRPC_CHANNEL_SHUTDOWN));
     }
-    p.second->Notify(GRPC_CHANNEL_SHUTDOWN);
+    p.second->NotifyStateChange(current_state, GRPC_CHANNEL_SHUTDOWN,
+                                &batch);
   }
 }
 
@@ -125,7 +204,7 @@ void ConnectivityStateTracker::AddWatcher(
               name_, this, watcher.get(), ConnectivityStateName(initial_state),
               ConnectivityStateName(current_state));
     }
-    watcher->Notify(current_state);
+    watcher->NotifyStateChange(initial_state, current_state, nullptr);
   }
   // If we're in state SHUTDOWN, don't add the watcher, so that it will
   // be orphaned immediately.
@@ -153,14 +232,18 @@ void ConnectivityStateTracker::SetState(grpc_connectivity_state state,
             ConnectivityStateName(state), reason);
   }
   state_.Store(state, MemoryOrder::RELAXED);
-  for (const auto& p : watchers_) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
-      gpr_log(GPR_INFO,
-              "ConnectivityStateTracker %s[%p]: notifying watcher %p: %s -> %s",
-              name_, this, p.first, ConnectivityStateName(current_state),
-              ConnectivityStateName(state));
+  {
+    ConnectivityStateNotificationBatch batch;
+    for (const auto& p : watchers_) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_connectivity_state_trace)) {
+        gpr_log(
+            GPR_INFO,
+            "ConnectivityStateTracker %s[%p]: notifying watcher %p: %s -> %s",
+            name_, this, p.first, ConnectivityStateName(current_state),
+            ConnectivityStateName(state));
+      }
+      p.second->NotifyStateChange(current_state, state, &batch);
     }
-    p.second->Notify(state);
   }
   // If the new state is SHUTDOWN, orphan all of the watchers.  This
   // avoids the need for the callers to explicitly cancel them.
@@ -37,6 +37,8 @@ extern TraceFlag grpc_connectivity_state_trace;
 // Enum to string conversion.
 const char* ConnectivityStateName(grpc_connectivity_state state);
 
+class ConnectivityStateNotificationBatch;
+
 // Interface for watching connectivity state.
 // Subclasses must implement the Notify() method.
 //
@@ -51,18 +53,37 @@ class ConnectivityStateWatcherInterface
   virtual void Notify(grpc_connectivity_state new_state) = 0;
 
   void Orphan() override { Unref(); }
+
+ private:
+  friend class ConnectivityStateTracker;
+
+  // Called by ConnectivityStateTracker instead of Notify(), with the state
+  // the watcher was last told about as \a old_state.  Watchers that notify
+  // asynchronously add themselves to \a batch, if set, so that all of the
+  // watchers sharing a combiner are notified in a single closure.
+  virtual void NotifyStateChange(
+      grpc_connectivity_state /*old_state*/, grpc_connectivity_state new_state,
+      ConnectivityStateNotificationBatch* /*batch*/) {
+    Notify(new_state);
+  }
 };
 
 // An alternative watcher interface that performs notifications via an
 // asynchronous callback scheduled on the ExecCtx.
 // Subclasses must implement the OnConnectivityStateChange() method.
+//
+// Notifications are coalesced: if the state changes again before a
+// pending notification has been delivered, only the latest state is
+// delivered, and nothing is delivered if the state has returned to the one
+// the watcher was last told about.
 class AsyncConnectivityStateWatcherInterface
     : public ConnectivityStateWatcherInterface {
  public:
   virtual ~AsyncConnectivityStateWatcherInterface() = default;
 
   // Schedules a closure on the ExecCtx to invoke
-  // OnConnectivityStateChange() asynchronously.
+  // OnConnectivityStateChange() asynchronously, unless one is already
+  // pending.
   void Notify(grpc_connectivity_state new_state) override final;
 
  protected:
@@ -77,7 +98,29 @@ class AsyncConnectivityStateWatcherInterface
   virtual void OnConnectivityStateChange(grpc_connectivity_state new_state) = 0;
 
  private:
+  friend class ConnectivityStateNotificationBatch;
+
+  void NotifyStateChange(grpc_connectivity_state old_state,
+                         grpc_connectivity_state new_state,
+                         ConnectivityStateNotificationBatch* batch) override;
+
+  // Records \a new_state as the state to deliver, and schedules a
+  // notification if none is pending.  \a old_state is the state the
+  // watcher was last told about, or -1 if unknown.
+  void QueueNotification(int old_state, grpc_connectivity_state new_state,
+                         ConnectivityStateNotificationBatch* batch);
+
+  // Delivers the pending state, if any.  Runs in the notification closure.
+  void DeliverPendingState();
+
   Combiner* combiner_;
+  // The latest state not yet delivered, or -1 if no notification is
+  // pending.  Whoever swaps it away from -1 schedules the notification.
+  Atomic<int> pending_state_{-1};
+  // The state the watcher had been told about when the pending
+  // notification was scheduled, or -1 if unknown.  Written before the
+  // notification is scheduled and read before pending_state_ is cleared.
+  int delivered_state_ = -1;
 };
 
 // Tracks connectivity state.  Maintains a list of watchers that are
@@ -35,6 +35,7 @@
 
 #include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/reader_epochs.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -64,7 +65,7 @@ grpc_core::DebugOnlyTraceFlag grpc_trace_metadata(false, "metadata");
 void grpc_mdelem_trace_ref(void* md, const grpc_slice& key,
                            const grpc_slice& value, intptr_t refcnt,
                            const char* file, int line) {
-  if (grpc_trace_metadata.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_metadata)) {
     char* key_str = grpc_slice_to_c_string(key);
     char* value_str = grpc_slice_to_c_string(value);
     gpr_log(file, line, GPR_LOG_SEVERITY_DEBUG,
@@ -78,7 +79,7 @@ void grpc_mdelem_trace_ref(void* md, const grpc_slice& key,
 void grpc_mdelem_trace_unref(void* md, const grpc_slice& key,
                              const grpc_slice& value, intptr_t refcnt,
                              const char* file, int line) {
-  if (grpc_trace_metadata.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_metadata)) {
     char* key_str = grpc_slice_to_c_string(key);
     char* value_str = grpc_slice_to_c_string(value);
     gpr_log(file, line, GPR_LOG_SEVERITY_DEBUG,
@@ -155,7 +156,7 @@ AllocatedMetadata::~AllocatedMetadata() {
 
 #ifndef NDEBUG
 void grpc_core::RefcountedMdBase::TraceAtStart(const char* tag) {
-  if (grpc_trace_metadata.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_metadata)) {
     char* key_str = grpc_slice_to_c_string(key());
     char* value_str = grpc_slice_to_c_string(value());
     gpr_log(GPR_DEBUG, "mdelem   %s:%p:%" PRIdPTR ": '%s' = '%s'", tag, this,
@@ -198,16 +199,20 @@ InternedMetadata::~InternedMetadata() {
 }
 
 size_t InternedMetadata::CleanupLinkedMetadata(
-    InternedMetadata::BucketLink* head) {
+    InternedMetadata::BucketLink* head, InternedMetadata** retired) {
   size_t num_freed = 0;
   InternedMetadata::BucketLink* prev_next = head;
   InternedMetadata *md, *next;
 
-  for (md = head->next; md; md = next) {
-    next = md->link_.next;
+  for (md = head->next.Load(grpc_core::MemoryOrder::RELAXED); md; md = next) {
+    next = md->bucket_next();
     if (md->AllRefsDropped()) {
-      prev_next->next = next;
-      delete md;
+      prev_next->next.Store(next, grpc_core::MemoryOrder::RELEASE);
+      /* A lookup that does not hold the shard lock may still be looking at
+         md, so it cannot be deleted yet. Walking on from md into the retired
+         list is harmless: nothing on it can gain a ref again. */
+      md->set_bucket_next(*retired);
+      *retired = md;
       num_freed++;
     } else {
       prev_next = &md->link_;
@@ -216,20 +221,70 @@ size_t InternedMetadata::CleanupLinkedMetadata(
   return num_freed;
 }
 
+bool InternedMetadata::RefIfNonZero() {
+  if (!IncrementRefIfNonZero()) return false;
+#ifndef NDEBUG
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_metadata)) {
+    char* key_str = grpc_slice_to_c_string(key());
+    char* value_str = grpc_slice_to_c_string(value());
+    intptr_t value = RefValue();
+    gpr_log(__FILE__, __LINE__, GPR_LOG_SEVERITY_DEBUG,
+            "mdelem   REF:%p:%" PRIdPTR "->%" PRIdPTR ": '%s' = '%s'", this,
+            value - 1, value, key_str, value_str);
+    gpr_free(key_str);
+    gpr_free(value_str);
+  }
+#endif
+  return true;
+}
+
+typedef struct mdtab_buckets {
+  size_t capacity;
+  InternedMetadata::BucketLink* elems;
+  /** Next in the shard's list of retired bucket arrays */
+  struct mdtab_buckets* next_retired;
+} mdtab_buckets;
+
+/** Memory that lookups without the shard lock may still be reading */
+typedef struct mdtab_retired {
+  InternedMetadata* elems;
+  mdtab_buckets* buckets;
+} mdtab_retired;
+
 typedef struct mdtab_shard {
   gpr_mu mu;
-  InternedMetadata::BucketLink* elems;
+  /** The mdtab_buckets in use. Only replaced under mu, but read without it */
+  gpr_atm buckets;
   size_t count;
-  size_t capacity;
   /** Estimate of the number of unreferenced mdelems in the hash table.
       This will eventually converge to the exact number, but it's instantaneous
       accuracy is not guaranteed */
   gpr_atm free_estimate;
+  /** Lookups of elements already in the table, which take no lock */
+  grpc_core::ReaderEpochs readers;
+  /** Elements and bucket arrays unlinked since the last epoch flip */
+  mdtab_retired retired;
+  /** Elements and bucket arrays unlinked before the last epoch flip */
+  mdtab_retired waiting;
 } mdtab_shard;
 
 static mdtab_shard g_shards[SHARD_COUNT];
 
 static void gc_mdtab(mdtab_shard* shard);
+static void free_retired(mdtab_retired* retired);
+
+static mdtab_buckets* alloc_buckets(size_t capacity) {
+  mdtab_buckets* buckets = static_cast<mdtab_buckets*>(gpr_zalloc(
+      sizeof(mdtab_buckets) + sizeof(InternedMetadata::BucketLink) * capacity));
+  buckets->capacity = capacity;
+  buckets->elems =
+      reinterpret_cast<InternedMetadata::BucketLink*>(buckets + 1);
+  return buckets;
+}
+
+static mdtab_buckets* shard_buckets(mdtab_shard* shard) {
+  return reinterpret_cast<mdtab_buckets*>(gpr_atm_acq_load(&shard->buckets));
+}
 
 void grpc_mdctx_global_init(void) {
   /* initialize shards */
@@ -238,9 +293,13 @@ void grpc_mdctx_global_init(void) {
     gpr_mu_init(&shard->mu);
     shard->count = 0;
     gpr_atm_no_barrier_store(&shard->free_estimate, 0);
-    shard->capacity = INITIAL_SHARD_CAPACITY;
-    shard->elems = static_cast<InternedMetadata::BucketLink*>(
-        gpr_zalloc(sizeof(*shard->elems) * shard->capacity));
+    gpr_atm_no_barrier_store(
+        &shard->buckets,
+        reinterpret_cast<gpr_atm>(alloc_buckets(INITIAL_SHARD_CAPACITY)));
+    shard->retired.elems = nullptr;
+    shard->retired.buckets = nullptr;
+    shard->waiting.elems = nullptr;
+    shard->waiting.buckets = nullptr;
   }
 }
 
@@ -249,6 +308,8 @@ void grpc_mdctx_global_shutdown() {
     mdtab_shard* shard = &g_shards[i];
     gpr_mu_destroy(&shard->mu);
     gc_mdtab(shard);
+    free_retired(&shard->waiting);
+    free_retired(&shard->retired);
     if (shard->count != 0) {
       gpr_log(GPR_DEBUG, "WARNING: %" PRIuPTR " metadata elements were leaked",
               shard->count);
@@ -262,7 +323,7 @@ void grpc_mdctx_global_shutdown() {
 #ifndef GRPC_ASAN_ENABLED
     GPR_DEBUG_ASSERT(shard->count == 0);
 #endif
-    gpr_free(shard->elems);
+    gpr_free(shard_buckets(shard));
   }
 }
 
@@ -277,7 +338,7 @@ static int is_mdelem_static(grpc_mdelem e) {
 
 void InternedMetadata::RefWithShardLocked(mdtab_shard* shard) {
 #ifndef NDEBUG
-  if (grpc_trace_metadata.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_metadata)) {
     char* key_str = grpc_slice_to_c_string(key());
     char* value_str = grpc_slice_to_c_string(value());
     intptr_t value = RefValue();
@@ -293,11 +354,50 @@ void InternedMetadata::RefWithShardLocked(mdtab_shard* shard) {
   }
 }
 
+static bool retired_empty(const mdtab_retired* retired) {
+  return retired->elems == nullptr && retired->buckets == nullptr;
+}
+
+static void free_retired(mdtab_retired* retired) {
+  InternedMetadata* md = retired->elems;
+  while (md != nullptr) {
+    InternedMetadata* next = md->bucket_next();
+    delete md;
+    md = next;
+  }
+  retired->elems = nullptr;
+  mdtab_buckets* buckets = retired->buckets;
+  while (buckets != nullptr) {
+    mdtab_buckets* next = buckets->next_retired;
+    gpr_free(buckets);
+    buckets = next;
+  }
+  retired->buckets = nullptr;
+}
+
+/* Frees what was unlinked before the last epoch flip once the lookups that
+   could still see it are done, and flips the epoch for what was unlinked
+   since. */
+static void maybe_free_retired(mdtab_shard* shard) {
+  if (!retired_empty(&shard->waiting)) {
+    if (!shard->readers.PreviousEpochDone()) return;
+    free_retired(&shard->waiting);
+  }
+  if (!retired_empty(&shard->retired)) {
+    shard->waiting = shard->retired;
+    shard->retired.elems = nullptr;
+    shard->retired.buckets = nullptr;
+    shard->readers.Flip();
+  }
+}
+
 static void gc_mdtab(mdtab_shard* shard) {
   GPR_TIMER_SCOPE("gc_mdtab", 0);
   size_t num_freed = 0;
-  for (size_t i = 0; i < shard->capacity; ++i) {
-    intptr_t freed = InternedMetadata::CleanupLinkedMetadata(&shard->elems[i]);
+  mdtab_buckets* buckets = shard_buckets(shard);
+  for (size_t i = 0; i < buckets->capacity; ++i) {
+    intptr_t freed = InternedMetadata::CleanupLinkedMetadata(
+        &buckets->elems[i], &shard->retired.elems);
     num_freed += freed;
     shard->count -= freed;
   }
@@ -308,37 +408,67 @@ static void gc_mdtab(mdtab_shard* shard) {
 static void grow_mdtab(mdtab_shard* shard) {
   GPR_TIMER_SCOPE("grow_mdtab", 0);
 
-  size_t capacity = shard->capacity * 2;
+  mdtab_buckets* old_buckets = shard_buckets(shard);
+  size_t capacity = old_buckets->capacity * 2;
   size_t i;
-  InternedMetadata::BucketLink* mdtab;
+  mdtab_buckets* buckets;
   InternedMetadata *md, *next;
   uint32_t hash;
 
-  mdtab = static_cast<InternedMetadata::BucketLink*>(
-      gpr_zalloc(sizeof(InternedMetadata::BucketLink) * capacity));
+  buckets = alloc_buckets(capacity);
 
-  for (i = 0; i < shard->capacity; i++) {
-    for (md = shard->elems[i].next; md; md = next) {
+  /* Lookups still walking the old buckets may be led astray into the new
+     chains and miss, in which case they retry under the lock. */
+  for (i = 0; i < old_buckets->capacity; i++) {
+    for (md = old_buckets->elems[i].next.Load(grpc_core::MemoryOrder::RELAXED);
+         md; md = next) {
       size_t idx;
       hash = md->hash();
       next = md->bucket_next();
       idx = TABLE_IDX(hash, capacity);
-      md->set_bucket_next(mdtab[idx].next);
-      mdtab[idx].next = md;
+      md->set_bucket_next(
+          buckets->elems[idx].next.Load(grpc_core::MemoryOrder::RELAXED));
+      buckets->elems[idx].next.Store(md, grpc_core::MemoryOrder::RELAXED);
     }
   }
-  gpr_free(shard->elems);
-  shard->elems = mdtab;
-  shard->capacity = capacity;
+  gpr_atm_rel_store(&shard->buckets, reinterpret_cast<gpr_atm>(buckets));
+  old_buckets->next_retired = shard->retired.buckets;
+  shard->retired.buckets = old_buckets;
 }
 
 static void rehash_mdtab(mdtab_shard* shard) {
   if (gpr_atm_no_barrier_load(&shard->free_estimate) >
-      static_cast<gpr_atm>(shard->capacity / 4)) {
+      static_cast<gpr_atm>(shard_buckets(shard)->capacity / 4)) {
     gc_mdtab(shard);
   } else {
     grow_mdtab(shard);
   }
+  maybe_free_retired(shard);
+}
+
+/* Looks for an interned element for \a key and \a value without taking the
+   shard lock, and returns it with a new ref. Returns nullptr if there is none,
+   or if it could not be safely reffed without the lock. */
+static InternedMetadata* find_interned(mdtab_shard* shard,
+                                       const grpc_slice& key,
+                                       const grpc_slice& value, uint32_t hash) {
+  grpc_core::ReaderEpochs::Read read = shard->readers.BeginRead();
+  mdtab_buckets* buckets = shard_buckets(shard);
+  InternedMetadata* found = nullptr;
+  for (InternedMetadata* md =
+           buckets->elems[TABLE_IDX(hash, buckets->capacity)].next.Load(
+               grpc_core::MemoryOrder::ACQUIRE);
+       md != nullptr; md = md->bucket_next()) {
+    if (grpc_slice_static_interned_equal(key, md->key()) &&
+        grpc_slice_static_interned_equal(value, md->value())) {
+      /* If all refs were dropped, md may be about to be retired, and only
+         the shard lock can bring it back. */
+      if (md->RefIfNonZero()) found = md;
+      break;
+    }
+  }
+  shard->readers.EndRead(read);
+  return found;
 }
 
 template <bool key_definitely_static, bool value_definitely_static = false>
@@ -436,15 +566,25 @@ static grpc_mdelem md_create_must_intern(const grpc_slice& key,
   // comparison of the refcounts.
   InternedMetadata* md;
   mdtab_shard* shard = &g_shards[SHARD_IDX(hash)];
+  mdtab_buckets* buckets;
   size_t idx;
 
   GPR_TIMER_SCOPE("grpc_mdelem_from_metadata_strings", 0);
 
+  md = find_interned(shard, key, value, hash);
+  if (md != nullptr) {
+    return GRPC_MAKE_MDELEM(md, GRPC_MDELEM_STORAGE_INTERNED);
+  }
+
   gpr_mu_lock(&shard->mu);
+  /* memory is only retired on this path, so it is freed on it too */
+  maybe_free_retired(shard);
 
-  idx = TABLE_IDX(hash, shard->capacity);
+  buckets = shard_buckets(shard);
+  idx = TABLE_IDX(hash, buckets->capacity);
   /* search for an existing pair */
-  for (md = shard->elems[idx].next; md; md = md->bucket_next()) {
+  for (md = buckets->elems[idx].next.Load(grpc_core::MemoryOrder::RELAXED); md;
+       md = md->bucket_next()) {
     if (grpc_slice_static_interned_equal(key, md->key()) &&
         grpc_slice_static_interned_equal(value, md->value())) {
       md->RefWithShardLocked(shard);
@@ -454,15 +594,18 @@ static grpc_mdelem md_create_must_intern(const grpc_slice& key,
   }
 
   /* not found: create a new pair */
+  InternedMetadata* head =
+      buckets->elems[idx].next.Load(grpc_core::MemoryOrder::RELAXED);
   md = key_definitely_static
            ? new InternedMetadata(
-                 key, value, hash, shard->elems[idx].next,
+                 key, value, hash, head,
                  static_cast<const InternedMetadata::NoRefKey*>(nullptr))
-           : new InternedMetadata(key, value, hash, shard->elems[idx].next);
-  shard->elems[idx].next = md;
+           : new InternedMetadata(key, value, hash, head);
+  /* publish md, fully constructed, to lookups that do not take the lock */
+  buckets->elems[idx].next.Store(md, grpc_core::MemoryOrder::RELEASE);
   shard->count++;
 
-  if (shard->count > shard->capacity * 2) {
+  if (shard->count > buckets->capacity * 2) {
     rehash_mdtab(shard);
   }
 
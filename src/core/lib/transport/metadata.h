@@ -269,6 +269,7 @@ class RefcountedMdBase {
   intptr_t RefValue() { return refcnt_.Load(MemoryOrder::RELAXED); }
   bool AllRefsDropped() { return refcnt_.Load(MemoryOrder::ACQUIRE) == 0; }
   bool FirstRef() { return refcnt_.FetchAdd(1, MemoryOrder::RELAXED) == 0; }
+  bool IncrementRefIfNonZero() { return refcnt_.IncrementIfNonzero(); }
 
  private:
   /* must be byte compatible with grpc_mdelem_data */
@@ -285,7 +286,8 @@ class InternedMetadata : public RefcountedMdBase {
   struct BucketLink {
     explicit BucketLink(InternedMetadata* md) : next(md) {}
 
-    InternedMetadata* next = nullptr;
+    // Atomic since lookups walk bucket chains without the shard lock.
+    Atomic<InternedMetadata*> next;
   };
   InternedMetadata(const grpc_slice& key, const grpc_slice& value,
                    uint32_t hash, InternedMetadata* next);
@@ -294,11 +296,20 @@ class InternedMetadata : public RefcountedMdBase {
 
   ~InternedMetadata();
   void RefWithShardLocked(mdtab_shard* shard);
+  // Takes a ref without the shard lock, unless all refs were already dropped.
+  bool RefIfNonZero();
   UserData* user_data() { return &user_data_; }
-  InternedMetadata* bucket_next() { return link_.next; }
-  void set_bucket_next(InternedMetadata* md) { link_.next = md; }
+  InternedMetadata* bucket_next() {
+    return link_.next.Load(MemoryOrder::ACQUIRE);
+  }
+  void set_bucket_next(InternedMetadata* md) {
+    link_.next.Store(md, MemoryOrder::RELEASE);
+  }
 
-  static size_t CleanupLinkedMetadata(BucketLink* head);
+  // Unlinks the elements of the chain at \a head that have no refs left, and
+  // prepends them to \a retired rather than deleting them.
+  static size_t CleanupLinkedMetadata(BucketLink* head,
+                                      InternedMetadata** retired);
 
  private:
   UserData user_data_;
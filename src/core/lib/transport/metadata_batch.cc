@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/profiling/timers.h"
@@ -79,9 +80,47 @@ void grpc_metadata_batch_assert_ok(grpc_metadata_batch* batch) {
 }
 #endif /* NDEBUG */
 
+static gpr_atm g_next_group_id;
+
+void grpc_mdelem_group_init(grpc_mdelem_group* group) {
+  // Ids start at 1, so that 0 can stand for no group.
+  group->id = static_cast<uint64_t>(
+      gpr_atm_no_barrier_fetch_add(&g_next_group_id, 1) + 1);
+  group->count = 0;
+}
+
+void grpc_mdelem_group_add(grpc_mdelem_group* group, grpc_mdelem elem,
+                           grpc_metadata_batch_callouts_index idx) {
+  GPR_ASSERT(group->count < grpc_mdelem_group::kMaxElems);
+  GPR_DEBUG_ASSERT(GRPC_BATCH_INDEX_OF(GRPC_MDKEY(elem)) == idx);
+  group->elems[group->count] = elem;
+  group->idx[group->count] = idx;
+  group->count++;
+}
+
+void grpc_mdelem_group_destroy(grpc_mdelem_group* group) {
+  for (size_t i = 0; i < group->count; i++) {
+    GRPC_MDELEM_UNREF(group->elems[i]);
+  }
+  group->count = 0;
+}
+
+struct grpc_linked_mdelem_block {
+  grpc_linked_mdelem storage;
+  grpc_linked_mdelem_block* next;
+};
+
 void grpc_metadata_batch_init(grpc_metadata_batch* batch) {
-  memset(batch, 0, sizeof(*batch));
+  // The inline storage is only ever read after being handed out, so leave it
+  // alone rather than touching all of its cache lines here.
+  memset(&batch->list, 0, sizeof(batch->list));
+  memset(&batch->idx, 0, sizeof(batch->idx));
   batch->deadline = GRPC_MILLIS_INF_FUTURE;
+  batch->group = nullptr;
+  batch->group_head = nullptr;
+  batch->checked_grpc_post = false;
+  batch->inline_used = 0;
+  batch->overflow = nullptr;
 }
 
 void grpc_metadata_batch_destroy(grpc_metadata_batch* batch) {
@@ -89,6 +128,23 @@ void grpc_metadata_batch_destroy(grpc_metadata_batch* batch) {
   for (l = batch->list.head; l; l = l->next) {
     GRPC_MDELEM_UNREF(l->md);
   }
+  grpc_linked_mdelem_block* block = batch->overflow;
+  while (block != nullptr) {
+    grpc_linked_mdelem_block* next = block->next;
+    gpr_free(block);
+    block = next;
+  }
+}
+
+static grpc_linked_mdelem* alloc_storage(grpc_metadata_batch* batch) {
+  if (GPR_LIKELY(batch->inline_used < grpc_metadata_batch::kInlineElems)) {
+    return &batch->inline_storage[batch->inline_used++];
+  }
+  grpc_linked_mdelem_block* block = static_cast<grpc_linked_mdelem_block*>(
+      gpr_malloc(sizeof(grpc_linked_mdelem_block)));
+  block->next = batch->overflow;
+  batch->overflow = block;
+  return &block->storage;
 }
 
 grpc_error* grpc_attach_md_to_error(grpc_error* src, grpc_mdelem md) {
@@ -205,6 +261,13 @@ grpc_error* grpc_metadata_batch_add_tail(grpc_metadata_batch* batch,
   return grpc_metadata_batch_link_tail(batch, storage);
 }
 
+grpc_error* grpc_metadata_batch_add_head(
+    grpc_metadata_batch* batch, grpc_mdelem elem_to_add,
+    grpc_metadata_batch_callouts_index idx) {
+  return grpc_metadata_batch_add_head(batch, alloc_storage(batch), elem_to_add,
+                                      idx);
+}
+
 static void link_tail(grpc_mdelem_list* list, grpc_linked_mdelem* storage) {
   assert_valid_list(list);
   GPR_DEBUG_ASSERT(!GRPC_MDISNULL(storage->md));
@@ -221,6 +284,13 @@ static void link_tail(grpc_mdelem_list* list, grpc_linked_mdelem* storage) {
   assert_valid_list(list);
 }
 
+grpc_error* grpc_metadata_batch_add_tail(
+    grpc_metadata_batch* batch, grpc_mdelem elem_to_add,
+    grpc_metadata_batch_callouts_index idx) {
+  return grpc_metadata_batch_add_tail(batch, alloc_storage(batch), elem_to_add,
+                                      idx);
+}
+
 grpc_error* grpc_metadata_batch_link_tail(grpc_metadata_batch* batch,
                                           grpc_linked_mdelem* storage) {
   assert_valid_callouts(batch);
@@ -249,6 +319,25 @@ grpc_error* grpc_metadata_batch_link_tail(
   return GRPC_ERROR_NONE;
 }
 
+grpc_error* grpc_metadata_batch_link_tail_group(
+    grpc_metadata_batch* batch, grpc_linked_mdelem* storage,
+    const grpc_mdelem_group* group) {
+  for (size_t i = 0; i < group->count; i++) {
+    storage[i].md = GRPC_MDELEM_REF(group->elems[i]);
+    grpc_error* err =
+        grpc_metadata_batch_link_tail(batch, &storage[i], group->idx[i]);
+    if (GPR_UNLIKELY(err != GRPC_ERROR_NONE)) {
+      GRPC_MDELEM_UNREF(storage[i].md);
+      return err;
+    }
+  }
+  if (batch->group == nullptr && group->count > 0) {
+    batch->group = group;
+    batch->group_head = storage;
+  }
+  return GRPC_ERROR_NONE;
+}
+
 static void unlink_storage(grpc_mdelem_list* list,
                            grpc_linked_mdelem* storage) {
   assert_valid_list(list);
@@ -371,6 +460,7 @@ void grpc_metadata_batch_copy(grpc_metadata_batch* src,
                               grpc_linked_mdelem* storage) {
   grpc_metadata_batch_init(dst);
   dst->deadline = src->deadline;
+  dst->checked_grpc_post = src->checked_grpc_post;
   size_t i = 0;
   for (grpc_linked_mdelem* elem = src->list.head; elem != nullptr;
        elem = elem->next) {
@@ -385,8 +475,47 @@ void grpc_metadata_batch_copy(grpc_metadata_batch* src,
   }
 }
 
+// Returns where \a l lives in \a dst, given that \a dst is a copy of \a src.
+static grpc_linked_mdelem* rebase(grpc_linked_mdelem* l,
+                                  grpc_metadata_batch* src,
+                                  grpc_metadata_batch* dst) {
+  if (l >= src->inline_storage &&
+      l < src->inline_storage + grpc_metadata_batch::kInlineElems) {
+    return dst->inline_storage + (l - src->inline_storage);
+  }
+  return l;
+}
+
 void grpc_metadata_batch_move(grpc_metadata_batch* src,
                               grpc_metadata_batch* dst) {
-  *dst = *src;
+  dst->list = src->list;
+  dst->idx = src->idx;
+  dst->deadline = src->deadline;
+  dst->group = src->group;
+  dst->group_head = src->group_head;
+  dst->checked_grpc_post = src->checked_grpc_post;
+  dst->inline_used = src->inline_used;
+  dst->overflow = src->overflow;
+  if (src->inline_used > 0) {
+    // Elements in the inline storage move with it, so every pointer to one of
+    // them has to be fixed up.
+    for (size_t i = 0; i < src->inline_used; i++) {
+      dst->inline_storage[i] = src->inline_storage[i];
+    }
+    dst->list.head = rebase(dst->list.head, src, dst);
+    dst->list.tail = rebase(dst->list.tail, src, dst);
+    if (dst->group_head != nullptr) {
+      dst->group_head = rebase(dst->group_head, src, dst);
+    }
+    for (grpc_linked_mdelem* l = dst->list.head; l != nullptr; l = l->next) {
+      l->next = rebase(l->next, src, dst);
+      l->prev = rebase(l->prev, src, dst);
+    }
+    for (size_t i = 0; i < GRPC_BATCH_CALLOUTS_COUNT; i++) {
+      if (dst->idx.array[i] != nullptr) {
+        dst->idx.array[i] = rebase(dst->idx.array[i], src, dst);
+      }
+    }
+  }
   grpc_metadata_batch_init(src);
 }
@@ -46,7 +46,33 @@ typedef struct grpc_mdelem_list {
   grpc_linked_mdelem* tail;
 } grpc_mdelem_list;
 
+/** Elements that a filter links, in this order, into every batch it sends,
+    such as the request headers that are the same for every call on a
+    channel. A transport may encode the elements of a group as a unit. */
+typedef struct grpc_mdelem_group {
+  static constexpr size_t kMaxElems = 4;
+
+  /** Unique to the group for the lifetime of the process */
+  uint64_t id;
+  size_t count;
+  grpc_mdelem elems[kMaxElems];
+  grpc_metadata_batch_callouts_index idx[kMaxElems];
+} grpc_mdelem_group;
+
+void grpc_mdelem_group_init(grpc_mdelem_group* group);
+/** Adds \a elem, which must be a callout, as the last element of \a group.
+    Takes ownership of \a elem */
+void grpc_mdelem_group_add(grpc_mdelem_group* group, grpc_mdelem elem,
+                           grpc_metadata_batch_callouts_index idx);
+void grpc_mdelem_group_destroy(grpc_mdelem_group* group);
+
+/** Storage handed out by the batch once its inline storage is used up */
+typedef struct grpc_linked_mdelem_block grpc_linked_mdelem_block;
+
 typedef struct grpc_metadata_batch {
+  /** Number of elements of storage owned by the batch itself */
+  static constexpr size_t kInlineElems = 8;
+
   /** Metadata elements in this batch */
   grpc_mdelem_list list;
   grpc_metadata_batch_callouts idx;
@@ -54,6 +80,22 @@ typedef struct grpc_metadata_batch {
       or GRPC_MILLIS_INF_FUTURE if this batch does not need to send a
       grpc-timeout */
   grpc_millis deadline;
+  /** The group linked by grpc_metadata_batch_link_tail_group() and the
+      storage of its first element, or null. Later changes to the batch may
+      separate the elements again, so this is only a hint. */
+  const grpc_mdelem_group* group;
+  grpc_linked_mdelem* group_head;
+  /** Set by a transport that found, while decoding the batch, that it holds
+      the request headers of a plain gRPC POST: :method POST, :scheme http
+      or https, te trailers and content-type application/grpc. Anything that
+      changes those headers before the server http filter must clear it. */
+  bool checked_grpc_post;
+  /** Storage for elements added without caller supplied storage. Slots are
+      handed out in order and only reclaimed when the batch is cleared, so
+      elements added this way sit next to each other and to the batch. */
+  size_t inline_used;
+  grpc_linked_mdelem_block* overflow;
+  grpc_linked_mdelem inline_storage[kInlineElems];
 } grpc_metadata_batch;
 
 void grpc_metadata_batch_init(grpc_metadata_batch* batch);
@@ -102,6 +144,14 @@ grpc_error* grpc_metadata_batch_link_tail(
     grpc_metadata_batch* batch, grpc_linked_mdelem* storage,
     grpc_metadata_batch_callouts_index idx) GRPC_MUST_USE_RESULT;
 
+/** Add the elements of \a group to the end of \a batch, in order, using
+    \a storage (an array of at least group->count elements) as backing
+    storage. \a storage is owned by the caller and must survive for the
+    lifetime of batch, and \a group must outlive the batch. */
+grpc_error* grpc_metadata_batch_link_tail_group(
+    grpc_metadata_batch* batch, grpc_linked_mdelem* storage,
+    const grpc_mdelem_group* group) GRPC_MUST_USE_RESULT;
+
 /** Add \a elem_to_add as the first element in \a batch, using
     \a storage as backing storage for the linked list element.
     \a storage is owned by the caller and must survive for the
@@ -128,6 +178,12 @@ inline grpc_error* GRPC_MUST_USE_RESULT grpc_metadata_batch_add_head(
   return grpc_metadata_batch_add_head(batch, storage, idx);
 }
 
+/** Add \a elem_to_add as the first element in \a batch, using storage owned
+    by \a batch itself. Takes ownership of \a elem_to_add */
+grpc_error* grpc_metadata_batch_add_head(
+    grpc_metadata_batch* batch, grpc_mdelem elem_to_add,
+    grpc_metadata_batch_callouts_index idx) GRPC_MUST_USE_RESULT;
+
 /** Add \a elem_to_add as the last element in \a batch, using
     \a storage as backing storage for the linked list element.
     \a storage is owned by the caller and must survive for the
@@ -152,6 +208,12 @@ inline grpc_error* GRPC_MUST_USE_RESULT grpc_metadata_batch_add_tail(
   return grpc_metadata_batch_add_tail(batch, storage, idx);
 }
 
+/** Add \a elem_to_add as the last element in \a batch, using storage owned
+    by \a batch itself. Takes ownership of \a elem_to_add */
+grpc_error* grpc_metadata_batch_add_tail(
+    grpc_metadata_batch* batch, grpc_mdelem elem_to_add,
+    grpc_metadata_batch_callouts_index idx) GRPC_MUST_USE_RESULT;
+
 grpc_error* grpc_attach_md_to_error(grpc_error* src, grpc_mdelem md);
 
 typedef struct {
@@ -1224,6 +1224,57 @@ grpc_mdelem grpc_static_mdelem_for_static_strings(intptr_t a, intptr_t b) {
              : GRPC_MDNULL;
 }
 
+static const uint8_t static_str_idxs[] = {
+    255, 255, 255, 255, 255, 255, 36,  255, 255, 255, 255, 78,  255, 255, 72,
+    255, 255, 255, 255, 255, 255, 255, 81,  255, 97,  255, 255, 255, 44,  255,
+    255, 255, 255, 8,   47,  255, 18,  255, 255, 255, 255, 28,  255, 255, 4,
+    255, 63,  55,  5,   255, 255, 255, 255, 95,  255, 255, 255, 103, 255, 255,
+    255, 255, 255, 255, 255, 24,  255, 82,  255, 255, 255, 255, 255, 255, 255,
+    255, 255, 104, 255, 255, 76,  255, 255, 46,  255, 59,  255, 255, 84,  255,
+    255, 255, 255, 13,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    39,  255, 37,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 90,  255,
+    255, 255, 21,  66,  255, 255, 255, 255, 7,   255, 255, 99,  255, 255, 255,
+    255, 42,  255, 1,   255, 255, 255, 52,  255, 255, 255, 16,  14,  86,  255,
+    255, 255, 98,  0,   255, 255, 25,  255, 255, 255, 255, 79,  255, 255, 93,
+    255, 255, 19,  255, 255, 49,  255, 255, 35,  255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 38,  255, 255, 57,  255, 255, 9,
+    255, 255, 255, 255, 255, 255, 255, 255, 2,   255, 255, 255, 255, 255, 255,
+    255, 100, 255, 96,  255, 255, 71,  255, 11,  50,  255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 62,  255, 255, 15,  255, 255, 255,
+    255, 255, 255, 255, 74,  61,  255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 17,  255, 255, 33,  255, 255, 12,  255, 255,
+    255, 56,  255, 255, 22,  255, 255, 255, 255, 255, 255, 255, 101, 255, 255,
+    255, 255, 255, 26,  255, 255, 255, 255, 255, 255, 48,  255, 94,  255, 255,
+    255, 255, 255, 255, 255, 107, 255, 255, 83,  67,  255, 255, 255, 255, 255,
+    53,  255, 255, 255, 255, 255, 255, 255, 255, 255, 69,  255, 255, 3,   255,
+    255, 255, 255, 41,  255, 75,  255, 31,  105, 10,  255, 255, 106, 255, 87,
+    255, 255, 255, 255, 89,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 65,  255, 60,  255, 255, 255, 255, 255, 255, 255, 255, 20,  58,  85,
+    70,  255, 30,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 51,  64,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 43,
+    102, 255, 255, 255, 34,  255, 255, 255, 255, 255, 73,  255, 255, 255, 255,
+    27,  255, 255, 255, 255, 255, 255, 255, 255, 255, 91,  255, 255, 255, 255,
+    255, 255, 255, 32,  255, 255, 255, 255, 255, 255, 45,  255, 255, 255, 40,
+    255, 255, 255, 255, 255, 255, 255, 255, 23,  88,  255, 255, 255, 255, 255,
+    255, 54,  255, 255, 92,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 68,  255, 255, 255, 255, 255, 255, 255, 6,   255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 77,  255, 255, 255, 80,
+    255, 255};
+
+intptr_t grpc_static_slice_index_for_bytes(const char* bytes, size_t length) {
+  if (length == 0) return 29;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(bytes);
+  uint32_t k = static_cast<uint32_t>(p[0]) |
+               static_cast<uint32_t>(p[length / 3]) << 8 |
+               static_cast<uint32_t>(p[length - 1]) << 16 |
+               static_cast<uint32_t>(length & 0xff) << 24;
+  uint8_t idx = static_str_idxs[(k * 0xd987e0a9u) >> 23];
+  return idx != 255 && grpc_static_slice_table()[idx] ==
+                           std::pair<const char*, size_t>(bytes, length)
+             ? idx
+             : -1;
+}
+
 const uint8_t grpc_static_accept_encoding_metadata[8] = {0,  75, 76, 77,
                                                          78, 79, 80, 81};
 
@@ -513,6 +513,7 @@ extern uintptr_t grpc_static_mdelem_user_data[GRPC_STATIC_MDELEM_COUNT];
   (grpc_static_mdelem_manifested()[84])
 
 grpc_mdelem grpc_static_mdelem_for_static_strings(intptr_t a, intptr_t b);
+intptr_t grpc_static_slice_index_for_bytes(const char* bytes, size_t length);
 typedef enum {
   GRPC_BATCH_PATH,
   GRPC_BATCH_METHOD,
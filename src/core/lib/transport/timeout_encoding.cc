@@ -23,6 +23,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <grpc/support/log.h>
+
 #include "src/core/lib/gpr/string.h"
 
 static int64_t round_up(int64_t x, int64_t divisor) {
@@ -41,6 +43,15 @@ static int64_t round_up_to_three_sig_figs(int64_t x) {
   return round_up(x, 10000000);
 }
 
+/* round a positive integer down to \a digits significant figures */
+static int64_t round_down_to_sig_figs(int64_t x, int digits) {
+  int64_t limit = 1;
+  for (int i = 0; i < digits; ++i) limit *= 10;
+  int64_t divisor = 1;
+  while (x >= limit * divisor) divisor *= 10;
+  return x - x % divisor;
+}
+
 /* encode our minimum viable timeout value */
 static void enc_tiny(char* buffer) { memcpy(buffer, "1n", 3); }
 
@@ -91,6 +102,16 @@ void grpc_http2_encode_timeout(grpc_millis timeout, char* buffer) {
   }
 }
 
+grpc_millis grpc_http2_round_timeout_down(grpc_millis timeout, int digits) {
+  GPR_ASSERT(digits >= 1 && digits <= 3);
+  if (timeout <= 0) return timeout;
+  if (timeout < 1000 * GPR_MS_PER_SEC) {
+    return round_down_to_sig_figs(timeout, digits);
+  }
+  return round_down_to_sig_figs(timeout / GPR_MS_PER_SEC, digits) *
+         GPR_MS_PER_SEC;
+}
+
 static int is_all_whitespace(const char* p, const char* end) {
   while (p != end && *p == ' ') p++;
   return p == end;
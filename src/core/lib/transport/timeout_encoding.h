@@ -35,4 +35,10 @@
 void grpc_http2_encode_timeout(grpc_millis timeout, char* buffer);
 int grpc_http2_decode_timeout(const grpc_slice& text, grpc_millis* timeout);
 
+/* Rounds \a timeout down to \a digits (1 to 3) significant figures, in
+   milliseconds below 1000 seconds and in seconds above. The result encodes
+   without further rounding, so nearby timeouts share an encoding, and the
+   peer's deadline never passes after ours. */
+grpc_millis grpc_http2_round_timeout_down(grpc_millis timeout, int digits);
+
 #endif /* GRPC_CORE_LIB_TRANSPORT_TIMEOUT_ENCODING_H */
@@ -25,7 +25,9 @@
 
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/polling_entity.h"
@@ -81,7 +83,7 @@ void grpc_stream_ref_init(grpc_stream_refcount* refcount, int initial_refs,
 #ifndef NDEBUG
 inline void grpc_stream_ref(grpc_stream_refcount* refcount,
                             const char* reason) {
-  if (grpc_trace_stream_refcount.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_stream_refcount)) {
     gpr_log(GPR_DEBUG, "%s %p:%p REF %s", refcount->object_type, refcount,
             refcount->destroy.cb_arg, reason);
   }
@@ -98,7 +100,7 @@ void grpc_stream_destroy(grpc_stream_refcount* refcount);
 #ifndef NDEBUG
 inline void grpc_stream_unref(grpc_stream_refcount* refcount,
                               const char* reason) {
-  if (grpc_trace_stream_refcount.enabled()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_stream_refcount)) {
     gpr_log(GPR_DEBUG, "%s %p:%p UNREF %s", refcount->object_type, refcount,
             refcount->destroy.cb_arg, reason);
   }
@@ -320,6 +322,29 @@ struct grpc_transport_stream_op_batch_payload {
   grpc_call_context_element* context;
 };
 
+namespace grpc_core {
+
+// How many more streams a client transport can start before new ones have to
+// wait for the peer to allow more concurrent streams. The transport publishes
+// it from its own thread; anyone holding a ref may read it at any time.
+class StreamHeadroom : public RefCounted<StreamHeadroom> {
+ public:
+  // Negative if streams are already waiting.
+  int64_t headroom() const { return headroom_.Load(MemoryOrder::RELAXED); }
+  // Would a new stream have to wait?
+  bool saturated() const { return headroom() <= 0; }
+
+  void set_headroom(int64_t headroom) {
+    headroom_.Store(headroom, MemoryOrder::RELAXED);
+  }
+
+ private:
+  // Unlimited until the transport says otherwise.
+  Atomic<int64_t> headroom_{INT64_MAX};
+};
+
+}  // namespace grpc_core
+
 /** Transport op: a set of operations to perform on a transport as a whole */
 typedef struct grpc_transport_op {
   /** Called when processing of this op is done. */
@@ -330,6 +355,8 @@ typedef struct grpc_transport_op {
   grpc_connectivity_state start_connectivity_watch_state = GRPC_CHANNEL_IDLE;
   grpc_core::ConnectivityStateWatcherInterface* stop_connectivity_watch =
       nullptr;
+  /** have the transport keep this up to date for as long as it lives */
+  grpc_core::RefCountedPtr<grpc_core::StreamHeadroom> watch_stream_headroom;
   /** should the transport be disconnected
    * Error contract: the transport that gets this op must cause
    *                 disconnect_with_error to be unref'ed after processing it */
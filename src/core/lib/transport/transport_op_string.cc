@@ -144,6 +144,14 @@ char* grpc_transport_op_string(grpc_transport_op* op) {
     gpr_strvec_add(&b, tmp);
   }
 
+  if (op->watch_stream_headroom != nullptr) {
+    if (!first) gpr_strvec_add(&b, gpr_strdup(" "));
+    first = false;
+    gpr_asprintf(&tmp, "WATCH_STREAM_HEADROOM:%p",
+                 op->watch_stream_headroom.get());
+    gpr_strvec_add(&b, tmp);
+  }
+
   if (op->stop_connectivity_watch != nullptr) {
     if (!first) gpr_strvec_add(&b, gpr_strdup(" "));
     first = false;
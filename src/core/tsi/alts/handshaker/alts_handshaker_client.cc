@@ -26,6 +26,8 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/call.h"
@@ -38,6 +40,11 @@
 
 const int kHandshakerClientOpNum = 4;
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_alts_max_concurrent_handshakes, 40,
+    "Maximum number of client, and separately of server, ALTS handshakes in "
+    "flight with the handshaker service. Further handshakes are queued.");
+
 struct alts_handshaker_client {
   const alts_handshaker_client_vtable* vtable;
 };
@@ -351,11 +358,13 @@ class HandshakeQueue {
       if (outstanding_handshakes_ == max_outstanding_handshakes_) {
         // Max number already running, add to queue.
         queued_handshakes_.push_back(client);
+        GRPC_STATS_INC_ALTS_HANDSHAKES_QUEUED();
         return;
       }
       // Start the handshake immediately.
       ++outstanding_handshakes_;
     }
+    GRPC_STATS_INC_ALTS_HANDSHAKES_STARTED();
     continue_make_grpc_call(client, true /* is_start */);
   }
 
@@ -372,6 +381,7 @@ class HandshakeQueue {
       client = queued_handshakes_.front();
       queued_handshakes_.pop_front();
     }
+    GRPC_STATS_INC_ALTS_HANDSHAKES_STARTED();
     continue_make_grpc_call(client, true /* is_start */);
   }
 
@@ -395,7 +405,8 @@ HandshakeQueue* g_client_handshake_queue;
 HandshakeQueue* g_server_handshake_queue;
 
 void DoHandshakeQueuesInit(void) {
-  const size_t per_queue_max_outstanding_handshakes = 40;
+  const size_t per_queue_max_outstanding_handshakes = static_cast<size_t>(
+      GPR_MAX(1, GPR_GLOBAL_CONFIG_GET(grpc_alts_max_concurrent_handshakes)));
   g_client_handshake_queue =
       new HandshakeQueue(per_queue_max_outstanding_handshakes);
   g_server_handshake_queue =
@@ -22,8 +22,21 @@
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
 
+/* The channel to the handshaker service carries every handshake of the
+ * process. Spread them over a few connections, so that a burst of reconnects
+ * is not serialized behind one connection's stream limit, and keep the
+ * connections probed so that a dead one fails its handshakes quickly instead
+ * of letting them run into their deadlines.  */
+constexpr int kHandshakerServiceMaxConnections = 4;
+constexpr int kHandshakerServiceCallsPerConnection = 20;
+constexpr int kHandshakerServiceKeepaliveTimeMs = 5 * 60 * 1000;
+constexpr int kHandshakerServiceKeepaliveTimeoutMs = 20 * 1000;
+
 static alts_shared_resource_dedicated g_alts_resource_dedicated;
 
 alts_shared_resource_dedicated* grpc_alts_get_shared_resource_dedicated(void) {
@@ -55,8 +68,22 @@ void grpc_alts_shared_resource_dedicated_start(
     const char* handshaker_service_url) {
   gpr_mu_lock(&g_alts_resource_dedicated.mu);
   if (g_alts_resource_dedicated.cq == nullptr) {
-    g_alts_resource_dedicated.channel =
-        grpc_insecure_channel_create(handshaker_service_url, nullptr, nullptr);
+    grpc_arg args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS),
+            kHandshakerServiceMaxConnections),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_SUBCHANNEL_CALLS_PER_CONNECTION),
+            kHandshakerServiceCallsPerConnection),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_TIME_MS),
+            kHandshakerServiceKeepaliveTimeMs),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_TIMEOUT_MS),
+            kHandshakerServiceKeepaliveTimeoutMs)};
+    grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+    g_alts_resource_dedicated.channel = grpc_insecure_channel_create(
+        handshaker_service_url, &channel_args, nullptr);
     g_alts_resource_dedicated.cq =
         grpc_completion_queue_create_for_next(nullptr);
     g_alts_resource_dedicated.thread =
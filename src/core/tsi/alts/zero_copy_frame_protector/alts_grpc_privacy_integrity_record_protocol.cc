@@ -69,6 +69,58 @@ static tsi_result alts_grpc_privacy_integrity_protect(
   return TSI_OK;
 }
 
+static tsi_result alts_grpc_privacy_integrity_protect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* unprotected_slices,
+    size_t max_frame_data_size, grpc_slice_buffer* protected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_frame_data_size == 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid arguments to alts_grpc_record_protocol protect frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* Seals all the frames back to back into one newly allocated buffer, so the
+   * whole write costs a single allocation and a single slice. Empty input is
+   * still sealed as one empty frame, like protect does.  */
+  size_t frame_overhead = rp->header_length + rp->tag_length;
+  size_t frame_count =
+      (unprotected_slices->length + max_frame_data_size - 1) /
+      max_frame_data_size;
+  if (frame_count == 0) frame_count = 1;
+  grpc_slice protected_slice = GRPC_SLICE_MALLOC(
+      unprotected_slices->length + frame_count * frame_overhead);
+  uint8_t* protected_ptr = GRPC_SLICE_START_PTR(protected_slice);
+  grpc_slice_buffer frame_sb;
+  grpc_slice_buffer_init(&frame_sb);
+  do {
+    size_t frame_data_size =
+        GPR_MIN(unprotected_slices->length, max_frame_data_size);
+    grpc_slice_buffer_move_first(unprotected_slices, frame_data_size,
+                                 &frame_sb);
+    iovec_t protected_iovec = {protected_ptr,
+                               frame_data_size + frame_overhead};
+    /* Calls alts_iovec_record_protocol protect.  */
+    char* error_details = nullptr;
+    alts_grpc_record_protocol_convert_slice_buffer_to_iovec(rp, &frame_sb);
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_protect(
+            rp->iovec_rp, rp->iovec_buf, frame_sb.count, protected_iovec,
+            &error_details);
+    grpc_slice_buffer_reset_and_unref_internal(&frame_sb);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to protect, %s", error_details);
+      gpr_free(error_details);
+      grpc_slice_buffer_destroy_internal(&frame_sb);
+      grpc_slice_unref_internal(protected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    protected_ptr += protected_iovec.iov_len;
+  } while (unprotected_slices->length > 0);
+  grpc_slice_buffer_destroy_internal(&frame_sb);
+  grpc_slice_buffer_add(protected_slices, protected_slice);
+  return TSI_OK;
+}
+
 static tsi_result alts_grpc_privacy_integrity_unprotect(
     alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
@@ -118,7 +170,8 @@ static tsi_result alts_grpc_privacy_integrity_unprotect(
 static const alts_grpc_record_protocol_vtable
     alts_grpc_privacy_integrity_record_protocol_vtable = {
         alts_grpc_privacy_integrity_protect,
-        alts_grpc_privacy_integrity_unprotect, nullptr};
+        alts_grpc_privacy_integrity_unprotect,
+        alts_grpc_privacy_integrity_protect_frames, nullptr};
 
 tsi_result alts_grpc_privacy_integrity_record_protocol_create(
     gsec_aead_crypter* crypter, size_t overflow_size, bool is_client,
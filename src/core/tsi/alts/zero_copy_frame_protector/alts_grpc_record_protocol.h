@@ -50,6 +50,26 @@ tsi_result alts_grpc_record_protocol_protect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
     grpc_slice_buffer* protected_slices);
 
+/**
+ * This method protects unprotected data as a sequence of frames, each carrying
+ * at most max_frame_data_size bytes of it, and appends the protected frames to
+ * protected_slices. Implementations may seal all the frames into a single
+ * buffer in one pass, which saves an allocation and a slice per frame. The
+ * input unprotected data slice buffer will be cleared, although the actual
+ * unprotected data bytes are not modified.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - unprotected_slices: the unprotected data to be protected.
+ * - max_frame_data_size: maximum size of unprotected data in a frame.
+ * - protected_slices: slice buffer where the protected frames are appended.
+ *
+ * This method returns TSI_OK in case of success or a specific error code in
+ * case of failure.
+ */
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_frame_data_size, grpc_slice_buffer* protected_slices);
+
 /**
  * This methods performs unprotect operation on a full frame of protected data
  * and appends unprotected data to unprotected_slices. It is the caller's
@@ -134,6 +134,37 @@ tsi_result alts_grpc_record_protocol_protect(
   return self->vtable->protect(self, unprotected_slices, protected_slices);
 }
 
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_frame_data_size, grpc_slice_buffer* protected_slices) {
+  if (grpc_core::ExecCtx::Get() == nullptr || self == nullptr ||
+      self->vtable == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_frame_data_size == 0) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->protect_frames != nullptr) {
+    return self->vtable->protect_frames(self, unprotected_slices,
+                                        max_frame_data_size, protected_slices);
+  }
+  if (self->vtable->protect == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  grpc_slice_buffer frame_sb;
+  grpc_slice_buffer_init(&frame_sb);
+  tsi_result result = TSI_OK;
+  while (unprotected_slices->length > max_frame_data_size) {
+    grpc_slice_buffer_move_first(unprotected_slices, max_frame_data_size,
+                                 &frame_sb);
+    result = self->vtable->protect(self, &frame_sb, protected_slices);
+    if (result != TSI_OK) break;
+  }
+  if (result == TSI_OK) {
+    result = self->vtable->protect(self, unprotected_slices, protected_slices);
+  }
+  grpc_slice_buffer_destroy_internal(&frame_sb);
+  return result;
+}
+
 tsi_result alts_grpc_record_protocol_unprotect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
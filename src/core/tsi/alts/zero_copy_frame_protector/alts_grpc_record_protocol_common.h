@@ -38,6 +38,11 @@ typedef struct {
   tsi_result (*unprotect)(alts_grpc_record_protocol* self,
                           grpc_slice_buffer* protected_slices,
                           grpc_slice_buffer* unprotected_slices);
+  /* Optional. If null, frames are protected one at a time.  */
+  tsi_result (*protect_frames)(alts_grpc_record_protocol* self,
+                               grpc_slice_buffer* unprotected_slices,
+                               size_t max_frame_data_size,
+                               grpc_slice_buffer* protected_slices);
   void (*destruct)(alts_grpc_record_protocol* self);
 } alts_grpc_record_protocol_vtable;
 
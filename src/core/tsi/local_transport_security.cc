@@ -140,7 +140,8 @@ static const tsi_handshaker_result_vtable result_vtable = {
     handshaker_result_create_zero_copy_grpc_protector,
     nullptr, /* handshaker_result_create_frame_protector */
     nullptr, /* handshaker_result_get_unused_bytes */
-    handshaker_result_destroy};
+    handshaker_result_destroy,
+    nullptr /* handshaker_result_enable_kernel_tls_tx */};
 
 static tsi_result create_handshaker_result(bool is_client,
                                            tsi_handshaker_result** self) {
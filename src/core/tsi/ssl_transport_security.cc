@@ -25,6 +25,10 @@
 #include <limits.h>
 #include <string.h>
 
+#include <deque>
+#include <map>
+#include <string>
+
 /* TODO(jboeuf): refactor inet_ntop into a portability header. */
 /* Note: for whomever reads this and tries to refactor this, this
    can't be in grpc, it has to be in gpr. */
@@ -45,15 +49,19 @@ extern "C" {
 #include <openssl/bio.h>
 #include <openssl/crypto.h> /* For OPENSSL_free */
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
 }
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -61,6 +69,10 @@ extern "C" {
 #define TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND 1024
 #define TSI_SSL_HANDSHAKER_OUTGOING_BUFFER_INITIAL_SIZE 1024
 
+/* Bounds on the peer certificates whose verification is cached. */
+#define TSI_SSL_VERIFIED_CERT_CACHE_MAX_ENTRIES 1024
+#define TSI_SSL_VERIFIED_CERT_CACHE_TTL_SECS 3600
+
 /* Putting a macro like this and littering the source file with #if is really
    bad practice.
    TODO(jboeuf): refactor all the #if / #endif in a separate module. */
@@ -68,9 +80,29 @@ extern "C" {
 #define TSI_OPENSSL_ALPN_SUPPORT 1
 #endif
 
+/* Kernel TLS needs the record keys, which only BoringSSL exports. */
+#if defined(GPR_LINUX) && defined(OPENSSL_IS_BORINGSSL) && \
+    defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#define TSI_KERNEL_TLS_SUPPORT 1
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+#endif
+
 /* TODO(jboeuf): I have not found a way to get this number dynamically from the
    SSL structure. This is what we would ultimately want though... */
 #define TSI_SSL_MAX_PROTECTION_OVERHEAD 100
+/* Records of the zero-copy protector are sealed in place when the first slice
+   holds at least this many bytes of the record. Shorter runs of slices are
+   gathered into one record instead, which costs a copy but fewer records. */
+#define TSI_SSL_MIN_IN_PLACE_RECORD_SIZE 1024
 
 /* --- Structure definitions. ---*/
 
@@ -101,6 +133,8 @@ struct tsi_ssl_server_handshaker_factory {
   size_t ssl_context_count;
   unsigned char* alpn_protocol_list;
   size_t alpn_protocol_list_length;
+  /* Identifies the client root certificates in the verified cert cache. */
+  unsigned char client_roots_digest[SHA256_DIGEST_LENGTH];
 };
 
 typedef struct {
@@ -130,6 +164,19 @@ typedef struct {
   size_t buffer_offset;
 } tsi_ssl_frame_protector;
 
+typedef struct {
+  tsi_zero_copy_grpc_protector base;
+  SSL* ssl;
+  BIO* network_io;
+  size_t max_protected_frame_size;
+  /* Largest number of unprotected bytes sealed in one record. */
+  size_t max_unprotected_frame_size;
+  /* Gathers the records that span several slices. */
+  unsigned char* buffer;
+  /* Unprotected bytes are read in here, and handed out as sub-slices. */
+  grpc_slice read_staging_buffer;
+} tsi_ssl_zero_copy_grpc_protector;
+
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
@@ -778,6 +825,98 @@ static int NullVerifyCallback(int /*preverify_ok*/, X509_STORE_CTX* /*ctx*/) {
   return 1;
 }
 
+/* --- Verified peer certificate cache. ---*/
+
+/* Peer certificates whose chain verified successfully, keyed by the digests
+   of the trusted roots and of the certificate, so that the handshakes of
+   reconnecting peers skip the chain verification. Reloading the roots
+   changes their digest: the entries of the old roots are not hit anymore,
+   and age out. */
+typedef struct {
+  gpr_mu mu;
+  std::map<std::string, gpr_timespec> expirations;
+  /* Keys in insertion order, hence in expiration order. */
+  std::deque<std::string> keys;
+  gpr_atm hits;
+} tsi_ssl_verified_cert_cache;
+
+static gpr_once g_verified_cert_cache_once = GPR_ONCE_INIT;
+static tsi_ssl_verified_cert_cache* g_verified_cert_cache = nullptr;
+
+static void init_verified_cert_cache(void) {
+  g_verified_cert_cache = new tsi_ssl_verified_cert_cache();
+  gpr_mu_init(&g_verified_cert_cache->mu);
+  gpr_atm_no_barrier_store(&g_verified_cert_cache->hits, 0);
+}
+
+static bool verified_cert_cache_lookup(const std::string& key) {
+  tsi_ssl_verified_cert_cache* cache = g_verified_cert_cache;
+  gpr_mu_lock(&cache->mu);
+  auto it = cache->expirations.find(key);
+  bool found = it != cache->expirations.end() &&
+               gpr_time_cmp(it->second, gpr_now(GPR_CLOCK_MONOTONIC)) > 0;
+  gpr_mu_unlock(&cache->mu);
+  if (found) gpr_atm_no_barrier_fetch_add(&cache->hits, 1);
+  return found;
+}
+
+static void verified_cert_cache_add(const std::string& key) {
+  tsi_ssl_verified_cert_cache* cache = g_verified_cert_cache;
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec expiration = gpr_time_add(
+      now, gpr_time_from_seconds(TSI_SSL_VERIFIED_CERT_CACHE_TTL_SECS,
+                                 GPR_TIMESPAN));
+  gpr_mu_lock(&cache->mu);
+  if (cache->expirations.emplace(key, expiration).second) {
+    cache->keys.push_back(key);
+    while (!cache->keys.empty()) {
+      auto it = cache->expirations.find(cache->keys.front());
+      if (gpr_time_cmp(it->second, now) > 0 &&
+          cache->expirations.size() <=
+              TSI_SSL_VERIFIED_CERT_CACHE_MAX_ENTRIES) {
+        break;
+      }
+      cache->expirations.erase(it);
+      cache->keys.pop_front();
+    }
+  }
+  gpr_mu_unlock(&cache->mu);
+}
+
+static X509* store_ctx_get0_cert(X509_STORE_CTX* store_ctx) {
+#if OPENSSL_VERSION_NUMBER < 0x10100000
+  return store_ctx->cert;
+#else
+  return X509_STORE_CTX_get0_cert(store_ctx);
+#endif
+}
+
+// Replaces the chain verification of the servers that verify their clients:
+// skips it for the client certificates that were verified before against the
+// same roots, as long as they have not expired.
+static int CachingCertVerifyCallback(X509_STORE_CTX* store_ctx, void* arg) {
+  tsi_ssl_server_handshaker_factory* factory =
+      static_cast<tsi_ssl_server_handshaker_factory*>(arg);
+  X509* cert = store_ctx_get0_cert(store_ctx);
+  unsigned char cert_digest[EVP_MAX_MD_SIZE];
+  unsigned int cert_digest_length = 0;
+  if (cert == nullptr ||
+      !X509_digest(cert, EVP_sha256(), cert_digest, &cert_digest_length)) {
+    return X509_verify_cert(store_ctx);
+  }
+  std::string key(reinterpret_cast<const char*>(factory->client_roots_digest),
+                  sizeof(factory->client_roots_digest));
+  key.append(reinterpret_cast<const char*>(cert_digest), cert_digest_length);
+  if (X509_cmp_current_time(X509_get_notAfter(cert)) > 0 &&
+      verified_cert_cache_lookup(key)) {
+    X509_STORE_CTX_set_error(store_ctx, X509_V_OK);
+    return 1;
+  }
+  int result = X509_verify_cert(store_ctx);
+  if (result == 1) verified_cert_cache_add(key);
+  return result;
+}
+
 /* --- tsi_ssl_root_certs_store methods implementation. ---*/
 
 tsi_ssl_root_certs_store* tsi_ssl_root_certs_store_create(
@@ -983,6 +1122,144 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+/* Moves the records written by SSL to network_io into protected_slices. */
+static tsi_result ssl_zero_copy_grpc_protector_flush(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* protected_slices) {
+  int pending = static_cast<int>(BIO_pending(impl->network_io));
+  if (pending <= 0) return TSI_OK;
+  grpc_slice frame = GRPC_SLICE_MALLOC(static_cast<size_t>(pending));
+  int read_from_ssl =
+      BIO_read(impl->network_io, GRPC_SLICE_START_PTR(frame), pending);
+  if (read_from_ssl != pending) {
+    gpr_log(GPR_ERROR, "Could not read from BIO after SSL_write.");
+    grpc_slice_unref_internal(frame);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(protected_slices, frame);
+  return TSI_OK;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  while (unprotected_slices->length > 0) {
+    grpc_slice first = unprotected_slices->slices[0];
+    size_t first_size = GRPC_SLICE_LENGTH(first);
+    size_t record_size =
+        GPR_MIN(unprotected_slices->length, impl->max_unprotected_frame_size);
+    if (first_size >= GPR_MIN(record_size, TSI_SSL_MIN_IN_PLACE_RECORD_SIZE)) {
+      /* Seal the record straight from the slice. */
+      record_size = GPR_MIN(record_size, first_size);
+      result =
+          do_ssl_write(impl->ssl, GRPC_SLICE_START_PTR(first), record_size);
+      if (record_size == first_size) {
+        grpc_slice_buffer_remove_first(unprotected_slices);
+      } else {
+        grpc_slice_buffer_sub_first(unprotected_slices, record_size,
+                                    first_size);
+      }
+    } else {
+      /* Gather the run of short slices, up to the next long one. */
+      size_t gathered = 0;
+      for (size_t i = 0; i < unprotected_slices->count; i++) {
+        size_t slice_size = GRPC_SLICE_LENGTH(unprotected_slices->slices[i]);
+        if (i > 0 && slice_size >= TSI_SSL_MIN_IN_PLACE_RECORD_SIZE) break;
+        gathered += slice_size;
+        if (gathered >= record_size) break;
+      }
+      record_size = GPR_MIN(record_size, gathered);
+      grpc_slice_buffer_move_first_into_buffer(unprotected_slices,
+                                               record_size, impl->buffer);
+      result = do_ssl_write(impl->ssl, impl->buffer, record_size);
+    }
+    if (result != TSI_OK) break;
+    result = ssl_zero_copy_grpc_protector_flush(impl, protected_slices);
+    if (result != TSI_OK) break;
+  }
+  return result;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  for (;;) {
+    /* Feed SSL as many protected bytes as its BIO takes... */
+    size_t written_into_ssl = 0;
+    while (protected_slices->count > 0) {
+      grpc_slice first = protected_slices->slices[0];
+      size_t first_size = GRPC_SLICE_LENGTH(first);
+      GPR_ASSERT(first_size <= INT_MAX);
+      int written = BIO_write(impl->network_io, GRPC_SLICE_START_PTR(first),
+                              static_cast<int>(first_size));
+      if (written <= 0) break;
+      written_into_ssl += static_cast<size_t>(written);
+      if (static_cast<size_t>(written) == first_size) {
+        grpc_slice_buffer_remove_first(protected_slices);
+      } else {
+        grpc_slice_buffer_sub_first(protected_slices,
+                                    static_cast<size_t>(written), first_size);
+      }
+    }
+    /* ... and take out all it can unprotect. */
+    size_t read_from_ssl = 0;
+    for (;;) {
+      grpc_slice* staging = &impl->read_staging_buffer;
+      size_t unprotected_size = GRPC_SLICE_LENGTH(*staging);
+      tsi_result result = do_ssl_read(
+          impl->ssl, GRPC_SLICE_START_PTR(*staging), &unprotected_size);
+      if (result != TSI_OK) return result;
+      if (unprotected_size == 0) break;
+      read_from_ssl += unprotected_size;
+      grpc_slice_buffer_add(unprotected_slices,
+                            grpc_slice_split_head(staging, unprotected_size));
+      if (GRPC_SLICE_LENGTH(*staging) == 0) {
+        grpc_slice_unref_internal(*staging);
+        *staging = GRPC_SLICE_MALLOC(impl->max_unprotected_frame_size);
+      }
+    }
+    if (protected_slices->count == 0) return TSI_OK;
+    if (written_into_ssl == 0 && read_from_ssl == 0) {
+      gpr_log(GPR_ERROR, "SSL accepts no more protected bytes.");
+      return TSI_INTERNAL_ERROR;
+    }
+  }
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_free(impl->buffer);
+  grpc_slice_unref_internal(impl->read_staging_buffer);
+  SSL_free(impl->ssl);
+  BIO_free(impl->network_io);
+  gpr_free(self);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t& max_frame_size) {
+  max_frame_size =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self)
+          ->max_protected_frame_size;
+  return TSI_OK;
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+        ssl_zero_copy_grpc_protector_max_frame_size,
+};
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1077,11 +1354,58 @@ static tsi_result ssl_handshaker_result_extract_peer(
   return result;
 }
 
+/* Clamps the requested max protected frame size, if any, to the supported
+   range and returns the size to use. */
+static size_t ssl_max_protected_frame_size(
+    size_t* max_output_protected_frame_size) {
+  if (max_output_protected_frame_size == nullptr) {
+    return TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  }
+  if (*max_output_protected_frame_size >
+      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  } else if (*max_output_protected_frame_size <
+             TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
+  }
+  return *max_output_protected_frame_size;
+}
+
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  protector_impl->max_protected_frame_size =
+      ssl_max_protected_frame_size(max_output_protected_frame_size);
+  protector_impl->max_unprotected_frame_size =
+      protector_impl->max_protected_frame_size -
+      TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  protector_impl->buffer = static_cast<unsigned char*>(
+      gpr_malloc(protector_impl->max_unprotected_frame_size));
+  protector_impl->read_staging_buffer =
+      GRPC_SLICE_MALLOC(protector_impl->max_unprotected_frame_size);
+  /* Transfer ownership of ssl and network_io to the protector. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  protector_impl->network_io = impl->network_io;
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
+  return TSI_OK;
+}
+
 static tsi_result ssl_handshaker_result_create_frame_protector(
     const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
     tsi_frame_protector** protector) {
   size_t actual_max_output_protected_frame_size =
-      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+      ssl_max_protected_frame_size(max_output_protected_frame_size);
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(
           const_cast<tsi_handshaker_result*>(self));
@@ -1089,18 +1413,6 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
       static_cast<tsi_ssl_frame_protector*>(
           gpr_zalloc(sizeof(*protector_impl)));
 
-  if (max_output_protected_frame_size != nullptr) {
-    if (*max_output_protected_frame_size >
-        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-    } else if (*max_output_protected_frame_size <
-               TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
-    }
-    actual_max_output_protected_frame_size = *max_output_protected_frame_size;
-  }
   protector_impl->buffer_size =
       actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
   protector_impl->buffer =
@@ -1132,6 +1444,77 @@ static tsi_result ssl_handshaker_result_get_unused_bytes(
   return TSI_OK;
 }
 
+#if TSI_KERNEL_TLS_SUPPORT
+/* Installs the write key of a TLS 1.2 AES-GCM connection into the kernel. */
+template <typename CryptoInfo>
+static tsi_result ssl_install_kernel_tls_tx(SSL* ssl, int fd,
+                                            uint16_t cipher_type) {
+  CryptoInfo crypto_info;
+  memset(&crypto_info, 0, sizeof(crypto_info));
+  const size_t key_size = sizeof(crypto_info.key);
+  const size_t salt_size = sizeof(crypto_info.salt);
+  /* For AEAD ciphers, the key block is the client key, the server key, the
+     client implicit IV and the server implicit IV. */
+  uint8_t key_block[2 * (sizeof(crypto_info.key) + sizeof(crypto_info.salt))];
+  if (SSL_get_key_block_len(ssl) != sizeof(key_block) ||
+      !SSL_generate_key_block(ssl, key_block, sizeof(key_block))) {
+    return TSI_UNIMPLEMENTED;
+  }
+  const bool is_server = SSL_is_server(ssl);
+  memcpy(crypto_info.key, key_block + (is_server ? key_size : 0), key_size);
+  memcpy(crypto_info.salt,
+         key_block + 2 * key_size + (is_server ? salt_size : 0), salt_size);
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  uint64_t seq = SSL_get_write_sequence(ssl);
+  for (size_t i = sizeof(crypto_info.rec_seq); i > 0; i--) {
+    crypto_info.rec_seq[i - 1] = static_cast<unsigned char>(seq & 0xff);
+    seq >>= 8;
+  }
+  /* Like BoringSSL, use the record sequence number as the explicit nonce. */
+  memcpy(crypto_info.iv, crypto_info.rec_seq, sizeof(crypto_info.iv));
+  crypto_info.info.version = TLS_1_2_VERSION;
+  crypto_info.info.cipher_type = cipher_type;
+  static const char kTlsUlp[] = "tls";
+  tsi_result result = TSI_OK;
+  if (setsockopt(fd, SOL_TCP, TCP_ULP, kTlsUlp, sizeof(kTlsUlp)) != 0 ||
+      setsockopt(fd, SOL_TLS, TLS_TX, &crypto_info, sizeof(crypto_info)) !=
+          0) {
+    /* A socket with the TLS ULP but no keys passes its data through. */
+    result = TSI_UNIMPLEMENTED;
+  }
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  return result;
+}
+#endif /* TSI_KERNEL_TLS_SUPPORT */
+
+static tsi_result ssl_handshaker_result_enable_kernel_tls_tx(
+    const tsi_handshaker_result* self, int fd) {
+#if TSI_KERNEL_TLS_SUPPORT
+  const tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<const tsi_ssl_handshaker_result*>(self);
+  SSL* ssl = impl->ssl;
+  if (ssl == nullptr || SSL_version(ssl) != TLS1_2_VERSION) {
+    return TSI_UNIMPLEMENTED;
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) return TSI_UNIMPLEMENTED;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      return ssl_install_kernel_tls_tx<tls12_crypto_info_aes_gcm_128>(
+          ssl, fd, TLS_CIPHER_AES_GCM_128);
+    case NID_aes_256_gcm:
+      return ssl_install_kernel_tls_tx<tls12_crypto_info_aes_gcm_256>(
+          ssl, fd, TLS_CIPHER_AES_GCM_256);
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+#else
+  (void)self;
+  (void)fd;
+  return TSI_UNIMPLEMENTED;
+#endif /* TSI_KERNEL_TLS_SUPPORT */
+}
+
 static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(self);
@@ -1143,10 +1526,11 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
 
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
-    nullptr, /* create_zero_copy_grpc_protector */
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
+    ssl_handshaker_result_enable_kernel_tls_tx,
 };
 
 static tsi_result ssl_handshaker_result_create(
@@ -1782,6 +2166,7 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
   size_t i = 0;
 
   gpr_once_init(&g_init_openssl_once, init_openssl);
+  gpr_once_init(&g_verified_cert_cache_once, init_verified_cert_cache);
 
   if (factory == nullptr) return TSI_INVALID_ARGUMENT;
   *factory = nullptr;
@@ -1805,6 +2190,10 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
     return TSI_OUT_OF_RESOURCES;
   }
   impl->ssl_context_count = options->num_key_cert_pairs;
+  if (options->pem_client_root_certs != nullptr) {
+    SHA256(reinterpret_cast<const uint8_t*>(options->pem_client_root_certs),
+           strlen(options->pem_client_root_certs), impl->client_roots_digest);
+  }
 
   if (options->num_alpn_protocols > 0) {
     result = build_alpn_protocol_name_list(
@@ -1877,6 +2266,8 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
           break;
         case TSI_REQUEST_CLIENT_CERTIFICATE_AND_VERIFY:
           SSL_CTX_set_verify(impl->ssl_contexts[i], SSL_VERIFY_PEER, nullptr);
+          SSL_CTX_set_cert_verify_callback(impl->ssl_contexts[i],
+                                           CachingCertVerifyCallback, impl);
           break;
         case TSI_REQUEST_AND_REQUIRE_CLIENT_CERTIFICATE_BUT_DONT_VERIFY:
           SSL_CTX_set_verify(impl->ssl_contexts[i],
@@ -1887,6 +2278,8 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
           SSL_CTX_set_verify(impl->ssl_contexts[i],
                              SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
                              nullptr);
+          SSL_CTX_set_cert_verify_callback(impl->ssl_contexts[i],
+                                           CachingCertVerifyCallback, impl);
           break;
       }
       /* TODO(jboeuf): Add revocation verification. */
@@ -1972,3 +2365,9 @@ const tsi_ssl_handshaker_factory_vtable* tsi_ssl_handshaker_factory_swap_vtable(
   factory->vtable = new_vtable;
   return orig_vtable;
 }
+
+size_t tsi_ssl_verified_cert_cache_hits_for_testing() {
+  gpr_once_init(&g_verified_cert_cache_once, init_verified_cert_cache);
+  return static_cast<size_t>(
+      gpr_atm_no_barrier_load(&g_verified_cert_cache->hits));
+}
@@ -336,4 +336,8 @@ const tsi_ssl_handshaker_factory_vtable* tsi_ssl_handshaker_factory_swap_vtable(
 tsi_result tsi_ssl_extract_x509_subject_names_from_pem_cert(
     const char* pem_cert, tsi_peer* peer);
 
+/* Returns how many client certificate chain verifications were skipped
+   because the certificate had been verified before. */
+size_t tsi_ssl_verified_cert_cache_hits_for_testing();
+
 #endif /* GRPC_CORE_TSI_SSL_TRANSPORT_SECURITY_H */
@@ -104,6 +104,8 @@ typedef struct {
                                  const unsigned char** bytes,
                                  size_t* bytes_size);
   void (*destroy)(tsi_handshaker_result* self);
+  tsi_result (*enable_kernel_tls_tx)(const tsi_handshaker_result* self,
+                                     int fd);
 } tsi_handshaker_result_vtable;
 
 struct tsi_handshaker_result {
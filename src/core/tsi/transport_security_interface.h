@@ -232,6 +232,17 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result* self, const unsigned char** bytes,
     size_t* byte_size);
 
+/* This method hands the protection of outgoing frames to the kernel for the
+   socket fd the handshake ran on, if the implementation, the negotiated
+   protocol and the kernel support it. It must be called after all handshake
+   bytes were written to fd and before any frame protector is created. On
+   TSI_OK, the bytes written to fd are protected by the kernel and must no
+   longer go through a frame protector; frame protectors created afterwards
+   are still needed to unprotect the incoming bytes. Returns TSI_UNIMPLEMENTED
+   when kernel protection is not available, in which case nothing changed. */
+tsi_result tsi_handshaker_result_enable_kernel_tls_tx(
+    const tsi_handshaker_result* self, int fd);
+
 /* This method releases the tsi_handshaker_handshaker object. After this method
    is called, no other method can be called on the object.  */
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self);
@@ -149,7 +149,9 @@ void ChannelResetConnectionBackoff(Channel* channel) {
                                    interceptor_creators_, interceptor_pos);
   context->set_call(c_call, shared_from_this());
 
-  return ::grpc::internal::Call(c_call, this, cq, info);
+  ::grpc::internal::Call call(c_call, this, cq, info);
+  call.set_message_passthrough(message_passthrough_);
+  return call;
 }
 
 ::grpc::internal::Call Channel::CreateCall(
@@ -246,7 +248,7 @@ class ShutdownCallback : public grpc_experimental_completion_queue_functor {
     auto* shutdown_callback = new ShutdownCallback;
     callback_cq_ = new ::grpc::CompletionQueue(grpc_completion_queue_attributes{
         GRPC_CQ_CURRENT_VERSION, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING,
-        shutdown_callback});
+        shutdown_callback, 1});
 
     // Transfer ownership of the new cq to its own shutdown callback
     shutdown_callback->TakeCQ(callback_cq_);
@@ -31,6 +31,8 @@
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/time.h>
 
+#include "src/cpp/common/write_timestamps.h"
+
 namespace grpc_impl {
 
 class Channel;
@@ -61,7 +63,9 @@ ClientContext::ClientContext()
       census_context_(nullptr),
       propagate_from_call_(nullptr),
       compression_algorithm_(GRPC_COMPRESS_NONE),
-      initial_metadata_corked_(false) {
+      initial_metadata_corked_(false),
+      write_timestamps_enabled_(false),
+      write_weight_(0) {
   g_client_callbacks->DefaultConstructor(this);
 }
 
@@ -72,6 +76,39 @@ ClientContext::~ClientContext() {
   g_client_callbacks->Destructor(this);
 }
 
+void ClientContext::Reset() {
+  GPR_ASSERT(propagate_from_call_ == nullptr);
+  if (call_) {
+    grpc_call_unref(call_);
+    call_ = nullptr;
+  }
+  g_client_callbacks->Destructor(this);
+  initial_metadata_received_ = false;
+  wait_for_ready_ = false;
+  wait_for_ready_explicitly_set_ = false;
+  idempotent_ = false;
+  cacheable_ = false;
+  channel_.reset();
+  call_canceled_ = false;
+  deadline_ = gpr_inf_future(GPR_CLOCK_REALTIME);
+  authority_.clear();
+  creds_.reset();
+  auth_context_.reset();
+  census_context_ = nullptr;
+  send_initial_metadata_.clear();
+  recv_initial_metadata_.Reset();
+  trailing_metadata_.Reset();
+  propagation_options_ = PropagationOptions();
+  compression_algorithm_ = GRPC_COMPRESS_NONE;
+  initial_metadata_corked_ = false;
+  write_timestamps_enabled_ = false;
+  write_weight_ = 0;
+  debug_error_string_.clear();
+  rpc_info_.~ClientRpcInfo();
+  new (&rpc_info_) grpc::experimental::ClientRpcInfo();
+  g_client_callbacks->DefaultConstructor(this);
+}
+
 void ClientContext::set_credentials(
     const std::shared_ptr<grpc_impl::CallCredentials>& creds) {
   creds_ = creds;
@@ -120,6 +157,12 @@ void ClientContext::set_call(
   GPR_ASSERT(call_ == nullptr);
   call_ = call;
   channel_ = channel;
+  if (write_timestamps_enabled_) {
+    grpc::internal::EnableCallWriteTimestamps(call_);
+  }
+  if (write_weight_ != 0) {
+    grpc::internal::SetCallWriteWeight(call_, write_weight_);
+  }
   if (creds_ && !creds_->ApplyToCall(call_)) {
     // TODO(yashykt): should interceptors also see this status?
     SendCancelToInterceptors();
@@ -172,6 +215,13 @@ grpc::string ClientContext::peer() const {
   return peer;
 }
 
+bool ClientContext::GetWriteTimestamps(
+    grpc::experimental::WriteTimestamps* timestamps) {
+  grpc::internal::MutexLock lock(&mu_);
+  if (call_ == nullptr) return false;
+  return grpc::internal::GetCallWriteTimestamps(call_, timestamps);
+}
+
 void ClientContext::SetGlobalCallbacks(GlobalCallbacks* client_callbacks) {
   GPR_ASSERT(g_client_callbacks == g_default_client_callbacks);
   GPR_ASSERT(client_callbacks != nullptr);
@@ -16,16 +16,115 @@
  *
  */
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
+#include <grpc/support/log.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/create_channel.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <grpcpp/impl/codegen/sync.h>
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/security/credentials.h>
 #include <grpcpp/support/channel_arguments.h>
 
 #include "src/cpp/client/create_channel_internal.h"
 
+namespace grpc {
+namespace experimental {
+
+// Spreads the calls made on it over a fixed set of channels.
+class ChannelPool final : public ::grpc::ChannelInterface {
+ public:
+  explicit ChannelPool(
+      std::vector<std::shared_ptr<::grpc::ChannelInterface>> channels)
+      : channels_(std::move(channels)) {}
+
+  grpc_connectivity_state GetState(bool try_to_connect) override {
+    for (size_t i = 1; try_to_connect && i < channels_.size(); i++) {
+      channels_[i]->GetState(true);
+    }
+    return channels_[0]->GetState(try_to_connect);
+  }
+
+ private:
+  // The tag of a method registered on the pool: the tags the method got on
+  // each channel, by channel index.
+  typedef std::vector<void*> RegisteredMethod;
+
+  grpc::internal::Call CreateCall(const grpc::internal::RpcMethod& method,
+                                  ::grpc_impl::ClientContext* context,
+                                  ::grpc_impl::CompletionQueue* cq) override {
+    const size_t i = PickChannel();
+    return channels_[i]->CreateCall(MethodOnChannel(method, i), context, cq);
+  }
+
+  grpc::internal::Call CreateCallInternal(
+      const grpc::internal::RpcMethod& method,
+      ::grpc_impl::ClientContext* context, ::grpc_impl::CompletionQueue* cq,
+      size_t interceptor_pos) override {
+    const size_t i = PickChannel();
+    return channels_[i]->CreateCallInternal(MethodOnChannel(method, i),
+                                            context, cq, interceptor_pos);
+  }
+
+  // Filling the ops of a call does not depend on its channel.
+  void PerformOpsOnCall(grpc::internal::CallOpSetInterface* ops,
+                        grpc::internal::Call* call) override {
+    channels_[0]->PerformOpsOnCall(ops, call);
+  }
+
+  void* RegisterMethod(const char* method) override {
+    std::unique_ptr<RegisteredMethod> tags(new RegisteredMethod);
+    for (const auto& channel : channels_) {
+      tags->push_back(channel->RegisterMethod(method));
+    }
+    grpc::internal::MutexLock lock(&mu_);
+    registered_methods_.push_back(std::move(tags));
+    return registered_methods_.back().get();
+  }
+
+  void NotifyOnStateChangeImpl(grpc_connectivity_state last_observed,
+                               gpr_timespec deadline,
+                               ::grpc_impl::CompletionQueue* cq,
+                               void* tag) override {
+    channels_[0]->NotifyOnStateChangeImpl(last_observed, deadline, cq, tag);
+  }
+
+  bool WaitForStateChangeImpl(grpc_connectivity_state last_observed,
+                              gpr_timespec deadline) override {
+    return channels_[0]->WaitForStateChangeImpl(last_observed, deadline);
+  }
+
+  ::grpc_impl::CompletionQueue* CallbackCQ() override {
+    return channels_[0]->CallbackCQ();
+  }
+
+  size_t PickChannel() {
+    return next_channel_.fetch_add(1, std::memory_order_relaxed) %
+           channels_.size();
+  }
+
+  // Returns \a method with the tag it was registered with on channel \a i.
+  static grpc::internal::RpcMethod MethodOnChannel(
+      const grpc::internal::RpcMethod& method, size_t i) {
+    void* tag = nullptr;
+    if (method.channel_tag() != nullptr) {
+      tag = (*static_cast<RegisteredMethod*>(method.channel_tag()))[i];
+    }
+    return grpc::internal::RpcMethod(method.name(), method.method_type(), tag);
+  }
+
+  const std::vector<std::shared_ptr<::grpc::ChannelInterface>> channels_;
+  std::atomic<size_t> next_channel_{0};
+  grpc::internal::Mutex mu_;
+  std::vector<std::unique_ptr<RegisteredMethod>> registered_methods_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
 namespace grpc_impl {
 std::shared_ptr<grpc::Channel> CreateChannelImpl(
     const grpc::string& target,
@@ -80,6 +179,22 @@ std::shared_ptr<grpc::Channel> CreateCustomChannelWithInterceptors(
                          "Invalid credentials."),
                      std::move(interceptor_creators));
 }
+
+std::shared_ptr<grpc::ChannelInterface> CreateCustomChannelPool(
+    const grpc::string& target,
+    const std::shared_ptr<grpc::ChannelCredentials>& creds,
+    const grpc::ChannelArguments& args, size_t pool_size) {
+  GPR_ASSERT(pool_size >= 1);
+  // Without a subchannel pool of their own, channels to the same target
+  // would share their subchannels and hence their connections.
+  grpc::ChannelArguments pool_args(args);
+  pool_args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  std::vector<std::shared_ptr<grpc::ChannelInterface>> channels;
+  for (size_t i = 0; i < pool_size; i++) {
+    channels.push_back(CreateCustomChannelImpl(target, creds, pool_args));
+  }
+  return std::make_shared<grpc::experimental::ChannelPool>(std::move(channels));
+}
 }  // namespace experimental
 
 }  // namespace grpc_impl
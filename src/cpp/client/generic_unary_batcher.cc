@@ -0,0 +1,190 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpcpp/generic/generic_unary_batcher.h>
+
+#include <vector>
+
+#include <grpcpp/alarm.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/support/client_callback.h>
+
+namespace grpc {
+namespace experimental {
+
+namespace {
+
+struct PendingCall {
+  ByteBuffer request;
+  ByteBuffer* response;
+  std::function<void(Status)> on_done;
+};
+
+}  // namespace
+
+// One bidi-streaming call carrying a batch of requests. Deletes itself once
+// the call is done.
+class GenericUnaryBatcher::Batch final
+    : public grpc_impl::experimental::ClientBidiReactor<ByteBuffer,
+                                                        ByteBuffer> {
+ public:
+  explicit Batch(std::vector<PendingCall> calls) : calls_(std::move(calls)) {}
+
+  void Start(GenericStub* stub, const grpc::string& method,
+             const Options& options) {
+    if (options.configure_context != nullptr) {
+      options.configure_context(&context_);
+    }
+    stub->experimental().PrepareBidiStreamingCall(&context_, method, this);
+    StartRead(&response_);
+    WriteNext();
+    StartCall();
+  }
+
+  void OnWriteDone(bool ok) override {
+    // If a write fails, the call is failing: OnDone() reports it.
+    if (ok && ++written_ < calls_.size()) WriteNext();
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) return;
+    PendingCall& call = calls_[read_];
+    call.response->Swap(&response_);
+    response_.Clear();
+    call.on_done(Status::OK);
+    if (++read_ < calls_.size()) StartRead(&response_);
+  }
+
+  void OnDone(const Status& s) override {
+    const Status status =
+        s.ok() ? Status(StatusCode::INTERNAL,
+                        "batch call ended without a response")
+               : s;
+    for (size_t i = read_; i < calls_.size(); i++) {
+      calls_[i].on_done(status);
+    }
+    delete this;
+  }
+
+ private:
+  void WriteNext() {
+    ByteBuffer* request = &calls_[written_].request;
+    if (written_ + 1 == calls_.size()) {
+      StartWriteLast(request, WriteOptions());
+    } else {
+      // Let the transport send the requests of the batch together.
+      StartWrite(request, WriteOptions().set_buffer_hint());
+    }
+  }
+
+  ClientContext context_;
+  std::vector<PendingCall> calls_;
+  size_t written_ = 0;
+  size_t read_ = 0;
+  ByteBuffer response_;
+};
+
+struct GenericUnaryBatcher::State {
+  State(std::shared_ptr<ChannelInterface> channel, const grpc::string& method,
+        const Options& options)
+      : stub(std::move(channel)), method(method), options(options) {}
+
+  // Requires holding mu.
+  std::vector<PendingCall> TakeBatchLocked() {
+    std::vector<PendingCall> batch;
+    batch.swap(pending);
+    ++window;
+    return batch;
+  }
+
+  // Sends the current batch once the delay is over, unless it was sent
+  // already. Requires holding mu.
+  void StartTimerLocked(const std::shared_ptr<State>& self) {
+    std::weak_ptr<State> weak_self = self;
+    const uint64_t batch_window = window;
+    // Cancels the timer of the previous batch, if it is still pending.
+    alarm.reset(new Alarm);
+    alarm->experimental().Set(
+        std::chrono::system_clock::now() + options.max_delay,
+        [weak_self, batch_window](bool ok) {
+          if (!ok) return;
+          std::shared_ptr<State> self = weak_self.lock();
+          if (self == nullptr) return;
+          std::vector<PendingCall> batch;
+          {
+            grpc::internal::MutexLock lock(&self->mu);
+            if (self->window == batch_window) batch = self->TakeBatchLocked();
+          }
+          self->Send(std::move(batch));
+        });
+  }
+
+  void Send(std::vector<PendingCall> batch) {
+    if (batch.empty()) return;
+    (new Batch(std::move(batch)))->Start(&stub, method, options);
+  }
+
+  GenericStub stub;
+  const grpc::string method;
+  const Options options;
+
+  grpc::internal::Mutex mu;
+  std::vector<PendingCall> pending;
+  // Incremented whenever the pending calls are taken as a batch
+  uint64_t window = 0;
+  std::unique_ptr<Alarm> alarm;
+};
+
+GenericUnaryBatcher::GenericUnaryBatcher(
+    std::shared_ptr<ChannelInterface> channel, const grpc::string& method)
+    : GenericUnaryBatcher(std::move(channel), method, Options()) {}
+
+GenericUnaryBatcher::GenericUnaryBatcher(
+    std::shared_ptr<ChannelInterface> channel, const grpc::string& method,
+    const Options& options)
+    : state_(std::make_shared<State>(std::move(channel), method, options)) {}
+
+GenericUnaryBatcher::~GenericUnaryBatcher() { Flush(); }
+
+void GenericUnaryBatcher::Call(const ByteBuffer& request, ByteBuffer* response,
+                               std::function<void(Status)> on_done) {
+  std::vector<PendingCall> batch;
+  {
+    grpc::internal::MutexLock lock(&state_->mu);
+    state_->pending.push_back({request, response, std::move(on_done)});
+    if (state_->pending.size() >= state_->options.max_batch_size) {
+      batch = state_->TakeBatchLocked();
+    } else if (state_->pending.size() == 1) {
+      state_->StartTimerLocked(state_);
+    }
+  }
+  state_->Send(std::move(batch));
+}
+
+void GenericUnaryBatcher::Flush() {
+  std::vector<PendingCall> batch;
+  {
+    grpc::internal::MutexLock lock(&state_->mu);
+    batch = state_->TakeBatchLocked();
+  }
+  state_->Send(std::move(batch));
+}
+
+}  // namespace experimental
+}  // namespace grpc
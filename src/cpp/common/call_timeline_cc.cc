@@ -0,0 +1,57 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpcpp/support/call_timeline.h>
+
+#include "src/core/lib/channel/call_timeline.h"
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc {
+namespace experimental {
+
+void SetCallTimelineSampling(uint32_t one_in) {
+  grpc_core::CallTimeline::SetSampling(one_in);
+}
+
+void CollectCallTimelines(uint64_t* cursor,
+                          std::vector<CallTimeline>* timelines) {
+  typedef grpc_core::CallTimeline Core;
+  grpc_core::CallTimelineRecord records[64];
+  size_t count;
+  do {
+    count = grpc_core::CollectCallTimelines(cursor, records,
+                                            GPR_ARRAY_SIZE(records));
+    for (size_t i = 0; i < count; i++) {
+      const int64_t* stage_ns = records[i].stage_ns;
+      CallTimeline timeline;
+      timeline.is_client = records[i].is_client;
+      timeline.created = stage_ns[Core::kCreated];
+      timeline.pick_complete = stage_ns[Core::kPickComplete];
+      timeline.stream_started = stage_ns[Core::kStreamStarted];
+      timeline.first_byte_written = stage_ns[Core::kFirstByteWritten];
+      timeline.initial_metadata_received =
+          stage_ns[Core::kInitialMetadataReceived];
+      timeline.first_message_received = stage_ns[Core::kFirstMessageReceived];
+      timeline.completion_delivered = stage_ns[Core::kCompletionDelivered];
+      timelines->push_back(timeline);
+    }
+  } while (count == GPR_ARRAY_SIZE(records));
+}
+
+}  // namespace experimental
+}  // namespace grpc
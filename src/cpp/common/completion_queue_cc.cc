@@ -24,6 +24,8 @@
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/support/time.h>
 
+#include "src/core/lib/gpr/useful.h"
+
 namespace grpc_impl {
 
 static ::grpc::internal::GrpcLibraryInitializer g_gli_initializer;
@@ -64,6 +66,40 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+CompletionQueue::NextStatus CompletionQueue::AsyncNextBatchInternal(
+    void** tags, bool* oks, int max_events, int* num_events,
+    gpr_timespec deadline) {
+  constexpr int kMaxEvents = 32;
+  grpc_event events[kMaxEvents];
+  *num_events = 0;
+  for (;;) {
+    int n = grpc_completion_queue_next_batch(
+        cq_, events, GPR_MIN(max_events, kMaxEvents), deadline, nullptr);
+    switch (events[0].type) {
+      case GRPC_QUEUE_TIMEOUT:
+        return TIMEOUT;
+      case GRPC_QUEUE_SHUTDOWN:
+        return SHUTDOWN;
+      case GRPC_OP_COMPLETE:
+        for (int i = 0; i < n; i++) {
+          auto core_cq_tag =
+              static_cast<::grpc::internal::CompletionQueueTag*>(events[i].tag);
+          void** tag = &tags[*num_events];
+          bool* ok = &oks[*num_events];
+          *ok = events[i].success != 0;
+          *tag = core_cq_tag;
+          if (core_cq_tag->FinalizeResult(tag, ok)) {
+            ++*num_events;
+          }
+        }
+        if (*num_events > 0) {
+          return GOT_EVENT;
+        }
+        break;
+    }
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
@@ -0,0 +1,52 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpcpp/support/event_trace.h>
+
+#include <stdio.h>
+
+#include "src/core/lib/profiling/timers.h"
+
+namespace grpc {
+namespace experimental {
+
+#ifdef GRPC_TIMER_TRACE
+
+void StartEventTrace() { grpc_core::TimerTrace::Start(); }
+
+void StopEventTrace() { grpc_core::TimerTrace::Stop(); }
+
+bool WriteEventTrace(const grpc::string& filename) {
+  FILE* out = fopen(filename.c_str(), "w");
+  if (out == nullptr) return false;
+  bool ok = grpc_core::TimerTrace::Write(out);
+  return fclose(out) == 0 && ok;
+}
+
+#else  // !GRPC_TIMER_TRACE
+
+void StartEventTrace() {}
+
+void StopEventTrace() {}
+
+bool WriteEventTrace(const grpc::string& /*filename*/) { return false; }
+
+#endif  // GRPC_TIMER_TRACE
+
+}  // namespace experimental
+}  // namespace grpc
@@ -0,0 +1,71 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_COMMON_WRITE_TIMESTAMPS_H
+#define GRPC_INTERNAL_CPP_COMMON_WRITE_TIMESTAMPS_H
+
+#include <grpc/grpc.h>
+#include <grpcpp/impl/codegen/write_timestamps.h>
+
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+#include "src/core/lib/surface/call.h"
+
+namespace grpc {
+namespace internal {
+
+// Makes the transport collect the timestamps of the writes of \a call from
+// its next batch on.
+inline void EnableCallWriteTimestamps(grpc_call* call) {
+  if (grpc_call_context_get(call, GRPC_CONTEXT_WRITE_TIMESTAMPS) != nullptr) {
+    return;
+  }
+  grpc_call_context_set(call, GRPC_CONTEXT_WRITE_TIMESTAMPS,
+                        new grpc_core::CallWriteTimestamps(),
+                        grpc_core::CallWriteTimestamps::Destroy);
+}
+
+// Makes the transport give \a weight shares of its writes to \a call.
+inline void SetCallWriteWeight(grpc_call* call, uint32_t weight) {
+  grpc_call_context_set(
+      call, GRPC_CONTEXT_WRITE_WEIGHT,
+      reinterpret_cast<void*>(static_cast<uintptr_t>(weight)), nullptr);
+}
+
+// Returns false if the timestamps of \a call are not being collected.
+inline bool GetCallWriteTimestamps(
+    grpc_call* call, ::grpc::experimental::WriteTimestamps* timestamps) {
+  auto* write_timestamps = static_cast<grpc_core::CallWriteTimestamps*>(
+      grpc_call_context_get(call, GRPC_CONTEXT_WRITE_TIMESTAMPS));
+  if (write_timestamps == nullptr) return false;
+  grpc_core::Timestamps last;
+  timestamps->num_writes = write_timestamps->Get(&last);
+  if (timestamps->num_writes > 0) {
+    timestamps->byte_offset = last.byte_offset;
+    timestamps->sendmsg_time = last.sendmsg_time.time;
+    timestamps->scheduled_time = last.scheduled_time.time;
+    timestamps->sent_time = last.sent_time.time;
+    timestamps->acked_time = last.acked_time.time;
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_COMMON_WRITE_TIMESTAMPS_H
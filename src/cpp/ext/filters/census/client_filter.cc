@@ -34,13 +34,18 @@ constexpr uint32_t CensusClientCallData::kMaxTagsLen;
 
 namespace {
 
+// Removes the server stats from \a b, and decodes them if \a elapsed_time is
+// not null.
 void FilterTrailingMetadata(grpc_metadata_batch* b, uint64_t* elapsed_time) {
   if (b->idx.named.grpc_server_stats_bin != nullptr) {
-    ServerStatsDeserialize(
-        reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(
-            GRPC_MDVALUE(b->idx.named.grpc_server_stats_bin->md))),
-        GRPC_SLICE_LENGTH(GRPC_MDVALUE(b->idx.named.grpc_server_stats_bin->md)),
-        elapsed_time);
+    if (elapsed_time != nullptr) {
+      ServerStatsDeserialize(
+          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(
+              GRPC_MDVALUE(b->idx.named.grpc_server_stats_bin->md))),
+          GRPC_SLICE_LENGTH(
+              GRPC_MDVALUE(b->idx.named.grpc_server_stats_bin->md)),
+          elapsed_time);
+    }
     grpc_metadata_batch_remove(b, b->idx.named.grpc_server_stats_bin);
   }
 }
@@ -55,8 +60,9 @@ void CensusClientCallData::OnDoneRecvTrailingMetadataCb(void* user_data,
   GPR_ASSERT(calld != nullptr);
   if (error == GRPC_ERROR_NONE) {
     GPR_ASSERT(calld->recv_trailing_metadata_ != nullptr);
-    FilterTrailingMetadata(calld->recv_trailing_metadata_,
-                           &calld->elapsed_time_);
+    FilterTrailingMetadata(
+        calld->recv_trailing_metadata_,
+        calld->record_stats_ ? &calld->elapsed_time_ : nullptr);
   }
   grpc_core::Closure::Run(DEBUG_LOCATION,
                           calld->initial_on_done_recv_trailing_metadata_,
@@ -101,7 +107,8 @@ void CensusClientCallData::StartTransportStreamOpBatch(
     }
     grpc_slice tags = grpc_empty_slice();
     // TODO: Add in tagging serialization.
-    size_t encoded_tags_len = StatsContextSerialize(kMaxTagsLen, &tags);
+    size_t encoded_tags_len =
+        record_stats_ ? StatsContextSerialize(kMaxTagsLen, &tags) : 0;
     if (encoded_tags_len > 0) {
       GRPC_LOG_IF_ERROR(
           "census grpc_filter",
@@ -115,7 +122,7 @@ void CensusClientCallData::StartTransportStreamOpBatch(
   if (op->send_message() != nullptr) {
     ++sent_message_count_;
   }
-  if (op->recv_message() != nullptr) {
+  if (op->recv_message() != nullptr && record_stats_) {
     recv_message_ = op->op()->payload->recv_message.recv_message;
     initial_on_done_recv_message_ =
         op->op()->payload->recv_message.recv_message_ready;
@@ -135,7 +142,8 @@ void CensusClientCallData::StartTransportStreamOpBatch(
 grpc_error* CensusClientCallData::Init(grpc_call_element* elem,
                                        const grpc_call_element_args* args) {
   path_ = grpc_slice_ref_internal(args->path);
-  start_time_ = absl::Now();
+  record_stats_ = ShouldRecordClientStats();
+  if (record_stats_) start_time_ = absl::Now();
   method_ = GetMethod(&path_);
   qualified_method_ = absl::StrCat("Sent.", method_);
   GRPC_CLOSURE_INIT(&on_done_recv_message_, OnDoneRecvMessageCb, elem,
@@ -149,19 +157,22 @@ grpc_error* CensusClientCallData::Init(grpc_call_element* elem,
 void CensusClientCallData::Destroy(grpc_call_element* elem,
                                    const grpc_call_final_info* final_info,
                                    grpc_closure* then_call_closure) {
-  const uint64_t request_size = GetOutgoingDataSize(final_info);
-  const uint64_t response_size = GetIncomingDataSize(final_info);
-  double latency_ms = absl::ToDoubleMilliseconds(absl::Now() - start_time_);
-  ::opencensus::stats::Record(
-      {{RpcClientSentBytesPerRpc(), static_cast<double>(request_size)},
-       {RpcClientReceivedBytesPerRpc(), static_cast<double>(response_size)},
-       {RpcClientRoundtripLatency(), latency_ms},
-       {RpcClientServerLatency(),
-        ToDoubleMilliseconds(absl::Nanoseconds(elapsed_time_))},
-       {RpcClientSentMessagesPerRpc(), sent_message_count_},
-       {RpcClientReceivedMessagesPerRpc(), recv_message_count_}},
-      {{ClientMethodTagKey(), method_},
-       {ClientStatusTagKey(), StatusCodeToString(final_info->final_status)}});
+  if (record_stats_) {
+    const uint64_t request_size = GetOutgoingDataSize(final_info);
+    const uint64_t response_size = GetIncomingDataSize(final_info);
+    double latency_ms = absl::ToDoubleMilliseconds(absl::Now() - start_time_);
+    ::opencensus::stats::Record(
+        {{RpcClientSentBytesPerRpc(), static_cast<double>(request_size)},
+         {RpcClientReceivedBytesPerRpc(), static_cast<double>(response_size)},
+         {RpcClientRoundtripLatency(), latency_ms},
+         {RpcClientServerLatency(),
+          ToDoubleMilliseconds(absl::Nanoseconds(elapsed_time_))},
+         {RpcClientSentMessagesPerRpc(), sent_message_count_},
+         {RpcClientReceivedMessagesPerRpc(), recv_message_count_}},
+        {{ClientMethodTagKey(), method_},
+         {ClientStatusTagKey(),
+          StatusCodeToString(final_info->final_status)}});
+  }
   grpc_slice_unref_internal(path_);
   context_.EndSpan();
 }
@@ -46,7 +46,8 @@ class CensusClientCallData : public CallData {
         elapsed_time_(0),
         recv_message_(nullptr),
         recv_message_count_(0),
-        sent_message_count_(0) {
+        sent_message_count_(0),
+        record_stats_(false) {
     memset(&stats_bin_, 0, sizeof(grpc_linked_mdelem));
     memset(&tracing_bin_, 0, sizeof(grpc_linked_mdelem));
     memset(&path_, 0, sizeof(grpc_slice));
@@ -94,6 +95,9 @@ class CensusClientCallData : public CallData {
   // Number of messages in this RPC.
   uint64_t recv_message_count_;
   uint64_t sent_message_count_;
+  // Whether this RPC was sampled for stats. Other RPCs skip the measurements
+  // but are still traced.
+  bool record_stats_;
   // Buffer needed for grpc_slice to reference when adding trace context
   // metatdata to outgoing message.
   char tracing_buf_[kMaxTraceContextLen];
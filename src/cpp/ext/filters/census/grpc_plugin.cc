@@ -20,6 +20,8 @@
 
 #include "src/cpp/ext/filters/census/grpc_plugin.h"
 
+#include <atomic>
+
 #include <grpcpp/server_context.h>
 
 #include "opencensus/tags/tag_key.h"
@@ -31,6 +33,24 @@
 
 namespace grpc {
 
+namespace {
+
+std::atomic<uint32_t> g_stats_sample_one_in{1};
+std::atomic<uint32_t> g_client_rpcs{0};
+std::atomic<uint32_t> g_server_rpcs{0};
+
+bool ShouldRecordStats(std::atomic<uint32_t>* rpcs) {
+  uint32_t one_in = g_stats_sample_one_in.load(std::memory_order_relaxed);
+  if (one_in <= 1) return one_in == 1;
+  return rpcs->fetch_add(1, std::memory_order_relaxed) % one_in == 0;
+}
+
+}  // namespace
+
+bool ShouldRecordClientStats() { return ShouldRecordStats(&g_client_rpcs); }
+
+bool ShouldRecordServerStats() { return ShouldRecordStats(&g_server_rpcs); }
+
 // These measure definitions should be kept in sync across opencensus
 // implementations--see
 // https://github.com/census-instrumentation/opencensus-java/blob/master/contrib/grpc_metrics/src/main/java/io/opencensus/contrib/grpc/metrics/RpcMeasureConstants.java.
@@ -127,6 +147,10 @@ void RegisterOpenCensusPlugin() {
   grpc::RpcServerReceivedMessagesPerRpc();
 }
 
+void SetOpenCensusStatsSampling(uint32_t one_in) {
+  grpc::g_stats_sample_one_in.store(one_in, std::memory_order_relaxed);
+}
+
 ::opencensus::trace::Span GetSpanFromServerContext(
     grpc::ServerContext* context) {
   return reinterpret_cast<const grpc::CensusContext*>(context->census_context())
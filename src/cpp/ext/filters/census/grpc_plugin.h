@@ -38,6 +38,11 @@ namespace grpc {
 ::opencensus::tags::TagKey ServerMethodTagKey();
 ::opencensus::tags::TagKey ServerStatusTagKey();
 
+// Whether to record the stats of a new client or server RPC, as set by
+// SetOpenCensusStatsSampling().
+bool ShouldRecordClientStats();
+bool ShouldRecordServerStats();
+
 // Names of measures used by the plugin--users can create views on these
 // measures but should not record data for them.
 extern const absl::string_view kRpcClientSentMessagesPerRpcMeasureName;
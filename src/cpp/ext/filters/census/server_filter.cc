@@ -39,7 +39,6 @@ namespace {
 struct ServerMetadataElements {
   grpc_slice path;
   grpc_slice tracing_slice;
-  grpc_slice census_proto;
 };
 
 void FilterInitialMetadata(grpc_metadata_batch* b,
@@ -52,9 +51,9 @@ void FilterInitialMetadata(grpc_metadata_batch* b,
         grpc_slice_ref_internal(GRPC_MDVALUE(b->idx.named.grpc_trace_bin->md));
     grpc_metadata_batch_remove(b, GRPC_BATCH_GRPC_TRACE_BIN);
   }
+  // The tags only matter to the stats, which do not propagate them yet (see
+  // StatsContextSerialize()): drop them without a copy.
   if (b->idx.named.grpc_tags_bin != nullptr) {
-    sml->census_proto =
-        grpc_slice_ref_internal(GRPC_MDVALUE(b->idx.named.grpc_tags_bin->md));
     grpc_metadata_batch_remove(b, GRPC_BATCH_GRPC_TAGS_BIN);
   }
 }
@@ -90,7 +89,6 @@ void CensusServerCallData::OnDoneRecvInitialMetadataCb(void* user_data,
     ServerMetadataElements sml;
     sml.path = grpc_empty_slice();
     sml.tracing_slice = grpc_empty_slice();
-    sml.census_proto = grpc_empty_slice();
     FilterInitialMetadata(initial_metadata, &sml);
     calld->path_ = grpc_slice_ref_internal(sml.path);
     calld->method_ = GetMethod(&calld->path_);
@@ -103,21 +101,12 @@ void CensusServerCallData::OnDoneRecvInitialMetadataCb(void* user_data,
     size_t tracing_str_len = GRPC_SLICE_IS_EMPTY(sml.tracing_slice)
                                  ? 0
                                  : GRPC_SLICE_LENGTH(sml.tracing_slice);
-    const char* census_str = GRPC_SLICE_IS_EMPTY(sml.census_proto)
-                                 ? ""
-                                 : reinterpret_cast<const char*>(
-                                       GRPC_SLICE_START_PTR(sml.census_proto));
-    size_t census_str_len = GRPC_SLICE_IS_EMPTY(sml.census_proto)
-                                ? 0
-                                : GRPC_SLICE_LENGTH(sml.census_proto);
 
     GenerateServerContext(absl::string_view(tracing_str, tracing_str_len),
-                          absl::string_view(census_str, census_str_len),
-                          /*primary_role*/ "", calld->qualified_method_,
-                          &calld->context_);
+                          /*stats*/ "", /*primary_role*/ "",
+                          calld->qualified_method_, &calld->context_);
 
     grpc_slice_unref_internal(sml.tracing_slice);
-    grpc_slice_unref_internal(sml.census_proto);
     grpc_slice_unref_internal(sml.path);
     grpc_census_call_set_context(
         calld->gc_, reinterpret_cast<census_context*>(&calld->context_));
@@ -138,14 +127,15 @@ void CensusServerCallData::StartTransportStreamOpBatch(
   if (op->send_message() != nullptr) {
     ++sent_message_count_;
   }
-  if (op->recv_message() != nullptr) {
+  if (op->recv_message() != nullptr && record_stats_) {
     recv_message_ = op->op()->payload->recv_message.recv_message;
     initial_on_done_recv_message_ =
         op->op()->payload->recv_message.recv_message_ready;
     op->op()->payload->recv_message.recv_message_ready = &on_done_recv_message_;
   }
   // We need to record the time when the trailing metadata was sent to mark the
-  // completeness of the request.
+  // completeness of the request. The client may sample the RPC even if we do
+  // not, so this is sent regardless.
   if (op->send_trailing_metadata() != nullptr) {
     elapsed_time_ = absl::Now() - start_time_;
     size_t len = ServerStatsSerialize(absl::ToInt64Nanoseconds(elapsed_time_),
@@ -168,6 +158,7 @@ void CensusServerCallData::StartTransportStreamOpBatch(
 grpc_error* CensusServerCallData::Init(grpc_call_element* elem,
                                        const grpc_call_element_args* args) {
   start_time_ = absl::Now();
+  record_stats_ = ShouldRecordServerStats();
   gc_ =
       grpc_call_from_top_element(grpc_call_stack_element(args->call_stack, 0));
   GRPC_CLOSURE_INIT(&on_done_recv_initial_metadata_,
@@ -182,18 +173,21 @@ grpc_error* CensusServerCallData::Init(grpc_call_element* elem,
 void CensusServerCallData::Destroy(grpc_call_element* elem,
                                    const grpc_call_final_info* final_info,
                                    grpc_closure* then_call_closure) {
-  const uint64_t request_size = GetOutgoingDataSize(final_info);
-  const uint64_t response_size = GetIncomingDataSize(final_info);
-  double elapsed_time_ms = absl::ToDoubleMilliseconds(elapsed_time_);
   grpc_auth_context_release(auth_context_);
-  ::opencensus::stats::Record(
-      {{RpcServerSentBytesPerRpc(), static_cast<double>(response_size)},
-       {RpcServerReceivedBytesPerRpc(), static_cast<double>(request_size)},
-       {RpcServerServerLatency(), elapsed_time_ms},
-       {RpcServerSentMessagesPerRpc(), sent_message_count_},
-       {RpcServerReceivedMessagesPerRpc(), recv_message_count_}},
-      {{ServerMethodTagKey(), method_},
-       {ServerStatusTagKey(), StatusCodeToString(final_info->final_status)}});
+  if (record_stats_) {
+    const uint64_t request_size = GetOutgoingDataSize(final_info);
+    const uint64_t response_size = GetIncomingDataSize(final_info);
+    double elapsed_time_ms = absl::ToDoubleMilliseconds(elapsed_time_);
+    ::opencensus::stats::Record(
+        {{RpcServerSentBytesPerRpc(), static_cast<double>(response_size)},
+         {RpcServerReceivedBytesPerRpc(), static_cast<double>(request_size)},
+         {RpcServerServerLatency(), elapsed_time_ms},
+         {RpcServerSentMessagesPerRpc(), sent_message_count_},
+         {RpcServerReceivedMessagesPerRpc(), recv_message_count_}},
+        {{ServerMethodTagKey(), method_},
+         {ServerStatusTagKey(),
+          StatusCodeToString(final_info->final_status)}});
+  }
   grpc_slice_unref_internal(path_);
   context_.EndSpan();
 }
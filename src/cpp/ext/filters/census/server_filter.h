@@ -47,7 +47,8 @@ class CensusServerCallData : public CallData {
         initial_on_done_recv_message_(nullptr),
         recv_message_(nullptr),
         recv_message_count_(0),
-        sent_message_count_(0) {
+        sent_message_count_(0),
+        record_stats_(false) {
     memset(&census_bin_, 0, sizeof(grpc_linked_mdelem));
     memset(&path_, 0, sizeof(grpc_slice));
     memset(&on_done_recv_initial_metadata_, 0, sizeof(grpc_closure));
@@ -91,6 +92,9 @@ class CensusServerCallData : public CallData {
   grpc_core::OrphanablePtr<grpc_core::ByteStream>* recv_message_;
   uint64_t recv_message_count_;
   uint64_t sent_message_count_;
+  // Whether this RPC was sampled for stats. Other RPCs skip the measurements
+  // but are still traced.
+  bool record_stats_;
   // Buffer needed for grpc_slice to reference it when adding metatdata to
   // response.
   char stats_buf_[kMaxServerStatsLen];
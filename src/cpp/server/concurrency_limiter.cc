@@ -0,0 +1,99 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/server/concurrency_limiter.h"
+
+#include <math.h>
+
+namespace grpc {
+namespace internal {
+
+namespace {
+
+// How much slower than the long-term latency recent calls may be before the
+// limit shrinks.
+constexpr double kTolerance = 1.5;
+// Weight of each window in the long-term latency.
+constexpr double kLongLatencyWeight = 0.05;
+// Weight of each computed limit in the limit actually used.
+constexpr double kSmoothing = 0.2;
+
+}  // namespace
+
+constexpr int ConcurrencyLimiter::kWindowSize;
+
+ConcurrencyLimiter::ConcurrencyLimiter(const char* method, int initial_limit,
+                                       int max_limit)
+    : method_(method),
+      max_limit_(max_limit),
+      limit_(initial_limit),
+      estimated_limit_(initial_limit) {}
+
+bool ConcurrencyLimiter::TryAcquire() {
+  int in_flight = in_flight_.load(std::memory_order_relaxed);
+  do {
+    if (in_flight >= limit_.load(std::memory_order_relaxed)) {
+      rejected_calls_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!in_flight_.compare_exchange_weak(in_flight, in_flight + 1,
+                                             std::memory_order_relaxed));
+  return true;
+}
+
+void ConcurrencyLimiter::OnCallDone(int64_t latency_us) {
+  const int in_flight = in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  grpc_core::MutexLock lock(&mu_);
+  window_latency_sum_us_ += latency_us;
+  if (in_flight > window_max_in_flight_) window_max_in_flight_ = in_flight;
+  if (++window_count_ < kWindowSize) return;
+  double short_latency_us =
+      static_cast<double>(window_latency_sum_us_) / window_count_;
+  if (short_latency_us < 1) short_latency_us = 1;
+  if (long_latency_us_ == 0) {
+    long_latency_us_ = short_latency_us;
+  } else {
+    long_latency_us_ = long_latency_us_ * (1 - kLongLatencyWeight) +
+                       short_latency_us * kLongLatencyWeight;
+    // After a slow period the long-term latency stays high for a while,
+    // which would let the limit grow unchecked. Pull it down faster.
+    if (long_latency_us_ > 2 * short_latency_us) long_latency_us_ *= 0.95;
+  }
+  double gradient = kTolerance * long_latency_us_ / short_latency_us;
+  if (gradient < 0.5) gradient = 0.5;
+  if (gradient > 1) gradient = 1;
+  // Leave room for a queue of sqrt(limit) calls, so that the limit can grow
+  // while latency is stable.
+  double new_limit = estimated_limit_ * gradient + sqrt(estimated_limit_);
+  // Only grow the limit if it was actually being used.
+  if (window_max_in_flight_ < estimated_limit_ / 2 &&
+      new_limit > estimated_limit_) {
+    new_limit = estimated_limit_;
+  }
+  estimated_limit_ =
+      estimated_limit_ * (1 - kSmoothing) + new_limit * kSmoothing;
+  if (estimated_limit_ < 1) estimated_limit_ = 1;
+  if (estimated_limit_ > max_limit_) estimated_limit_ = max_limit_;
+  limit_.store(static_cast<int>(estimated_limit_), std::memory_order_relaxed);
+  window_latency_sum_us_ = 0;
+  window_count_ = 0;
+  window_max_in_flight_ = 0;
+}
+
+}  // namespace internal
+}  // namespace grpc
@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_SERVER_CONCURRENCY_LIMITER_H
+#define GRPC_INTERNAL_CPP_SERVER_CONCURRENCY_LIMITER_H
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc {
+namespace internal {
+
+// Limits how many calls of one method are handled at once, adapting the
+// limit to the latency of the calls (a gradient limiter). While recent calls
+// are about as fast as calls have been in the long run, the limit grows;
+// when they slow down, which means work is queueing up behind the method,
+// it shrinks proportionally.
+class ConcurrencyLimiter {
+ public:
+  // Number of calls whose latencies are averaged before each update.
+  static constexpr int kWindowSize = 10;
+
+  ConcurrencyLimiter(const char* method, int initial_limit, int max_limit);
+
+  // Returns whether a call may start. If so, OnCallDone() must be called
+  // when it is done.
+  bool TryAcquire();
+  void OnCallDone(int64_t latency_us);
+
+  const char* method() const { return method_; }
+  int limit() const { return limit_.load(std::memory_order_relaxed); }
+  int in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+  uint64_t rejected_calls() const {
+    return rejected_calls_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const char* const method_;
+  const int max_limit_;
+  std::atomic<int> limit_;
+  std::atomic<int> in_flight_{0};
+  std::atomic<uint64_t> rejected_calls_{0};
+
+  grpc_core::Mutex mu_;
+  double estimated_limit_;
+  // Exponential moving average of the window latencies.
+  double long_latency_us_ = 0;
+  int64_t window_latency_sum_us_ = 0;
+  int window_count_ = 0;
+  int window_max_in_flight_ = 0;
+};
+
+}  // namespace internal
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_SERVER_CONCURRENCY_LIMITER_H
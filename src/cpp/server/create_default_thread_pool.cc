@@ -18,16 +18,26 @@
 
 #include <grpc/support/cpu.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/cpp/server/dynamic_thread_pool.h"
+#include "src/cpp/server/work_stealing_thread_pool.h"
 
 #ifndef GRPC_CUSTOM_DEFAULT_THREAD_POOL
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_cpp_work_stealing_thread_pool, false,
+    "If set, the default C++ thread pool is a fixed size work-stealing pool "
+    "instead of a dynamically sized one.");
+
 namespace grpc {
 namespace {
 
 ThreadPoolInterface* CreateDefaultThreadPoolImpl() {
   int cores = gpr_cpu_num_cores();
   if (!cores) cores = 4;
+  if (GPR_GLOBAL_CONFIG_GET(grpc_cpp_work_stealing_thread_pool)) {
+    return new WorkStealingThreadPool(cores);
+  }
   return new DynamicThreadPool(cores);
 }
 
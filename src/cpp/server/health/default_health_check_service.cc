@@ -35,7 +35,9 @@ namespace grpc {
 //
 
 DefaultHealthCheckService::DefaultHealthCheckService() {
+  grpc_core::MutexLock lock(&mu_);
   services_map_[""].SetServingStatus(SERVING);
+  UpdateStatusSnapshotLocked();
 }
 
 void DefaultHealthCheckService::SetServingStatus(
@@ -46,6 +48,7 @@ void DefaultHealthCheckService::SetServingStatus(
     serving = false;
   }
   services_map_[service_name].SetServingStatus(serving ? SERVING : NOT_SERVING);
+  UpdateStatusSnapshotLocked();
 }
 
 void DefaultHealthCheckService::SetServingStatus(bool serving) {
@@ -58,6 +61,7 @@ void DefaultHealthCheckService::SetServingStatus(bool serving) {
     ServiceData& service_data = p.second;
     service_data.SetServingStatus(status);
   }
+  UpdateStatusSnapshotLocked();
 }
 
 void DefaultHealthCheckService::Shutdown() {
@@ -70,18 +74,34 @@ void DefaultHealthCheckService::Shutdown() {
     ServiceData& service_data = p.second;
     service_data.SetServingStatus(NOT_SERVING);
   }
+  UpdateStatusSnapshotLocked();
 }
 
 DefaultHealthCheckService::ServingStatus
 DefaultHealthCheckService::GetServingStatus(
     const grpc::string& service_name) const {
-  grpc_core::MutexLock lock(&mu_);
-  auto it = services_map_.find(service_name);
-  if (it == services_map_.end()) {
+  std::shared_ptr<const std::map<grpc::string, ServingStatus>> snapshot =
+      std::atomic_load(&status_snapshot_);
+  auto it = snapshot->find(service_name);
+  if (it == snapshot->end()) {
     return NOT_FOUND;
   }
-  const ServiceData& service_data = it->second;
-  return service_data.GetServingStatus();
+  return it->second;
+}
+
+void DefaultHealthCheckService::UpdateStatusSnapshotLocked() {
+  std::shared_ptr<std::map<grpc::string, ServingStatus>> snapshot =
+      std::make_shared<std::map<grpc::string, ServingStatus>>();
+  for (const auto& p : services_map_) {
+    const ServingStatus status = p.second.GetServingStatus();
+    if (status != NOT_FOUND) {
+      snapshot->emplace_hint(snapshot->end(), p.first, status);
+    }
+  }
+  std::atomic_store(
+      &status_snapshot_,
+      std::shared_ptr<const std::map<grpc::string, ServingStatus>>(
+          std::move(snapshot)));
 }
 
 void DefaultHealthCheckService::RegisterCallHandler(
@@ -150,6 +170,9 @@ DefaultHealthCheckService::HealthCheckServiceImpl::HealthCheckServiceImpl(
     DefaultHealthCheckService* database,
     std::unique_ptr<ServerCompletionQueue> cq)
     : database_(database), cq_(std::move(cq)) {
+  for (ServingStatus status : {NOT_FOUND, SERVING, NOT_SERVING}) {
+    serialized_responses_[status] = SerializeResponse(status);
+  }
   // Add Check() method.
   AddMethod(new internal::RpcServiceMethod(
       kHealthCheckMethodName, internal::RpcMethod::NORMAL_RPC, nullptr));
@@ -233,8 +256,8 @@ bool DefaultHealthCheckService::HealthCheckServiceImpl::DecodeRequest(
   return true;
 }
 
-bool DefaultHealthCheckService::HealthCheckServiceImpl::EncodeResponse(
-    ServingStatus status, ByteBuffer* response) {
+Slice DefaultHealthCheckService::HealthCheckServiceImpl::SerializeResponse(
+    ServingStatus status) {
   upb::Arena arena;
   grpc_health_v1_HealthCheckResponse* response_struct =
       grpc_health_v1_HealthCheckResponse_new(arena.ptr());
@@ -248,11 +271,18 @@ bool DefaultHealthCheckService::HealthCheckServiceImpl::EncodeResponse(
   char* buf = grpc_health_v1_HealthCheckResponse_serialize(
       response_struct, arena.ptr(), &buf_length);
   if (buf == nullptr) {
+    return Slice();
+  }
+  return Slice(buf, buf_length);
+}
+
+bool DefaultHealthCheckService::HealthCheckServiceImpl::EncodeResponse(
+    ServingStatus status, ByteBuffer* response) const {
+  const Slice& serialized_response = serialized_responses_[status];
+  if (serialized_response.size() == 0) {
     return false;
   }
-  grpc_slice response_slice = grpc_slice_from_copied_buffer(buf, buf_length);
-  Slice encoded_response(response_slice, Slice::STEAL_REF);
-  ByteBuffer response_buffer(&encoded_response, 1);
+  ByteBuffer response_buffer(&serialized_response, 1);
   response->Swap(&response_buffer);
   return true;
 }
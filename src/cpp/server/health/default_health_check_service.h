@@ -20,6 +20,8 @@
 #define GRPC_INTERNAL_CPP_SERVER_DEFAULT_HEALTH_CHECK_SERVICE_H
 
 #include <atomic>
+#include <map>
+#include <memory>
 #include <set>
 
 #include <grpc/support/log.h>
@@ -214,7 +216,11 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
     // Returns true on success.
     static bool DecodeRequest(const ByteBuffer& request,
                               grpc::string* service_name);
-    static bool EncodeResponse(ServingStatus status, ByteBuffer* response);
+    // Returns an empty slice on failure.
+    static Slice SerializeResponse(ServingStatus status);
+    // Returns true on success. Responses are serialized only once, in the
+    // constructor, so this just references the serialized response.
+    bool EncodeResponse(ServingStatus status, ByteBuffer* response) const;
 
     // Needed to appease Windows compilers, which don't seem to allow
     // nested classes to access protected members in the parent's
@@ -224,6 +230,8 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
 
     DefaultHealthCheckService* database_;
     std::unique_ptr<ServerCompletionQueue> cq_;
+    // The serialized response for each ServingStatus.
+    Slice serialized_responses_[3];
 
     // To synchronize the operations related to shutdown state of cq_, so that
     // we don't enqueue new tags into cq_ after it is already shut down.
@@ -240,6 +248,7 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
 
   void Shutdown() override;
 
+  // Doesn't take mu_: reads the latest snapshot of the serving statuses.
   ServingStatus GetServingStatus(const grpc::string& service_name) const;
 
   HealthCheckServiceImpl* GetHealthCheckService(
@@ -274,9 +283,18 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
       const grpc::string& service_name,
       const std::shared_ptr<HealthCheckServiceImpl::CallHandler>& handler);
 
+  // Publishes the serving statuses in services_map_ as a new snapshot.
+  // Requires holding mu_.
+  void UpdateStatusSnapshotLocked();
+
   mutable grpc_core::Mutex mu_;
   bool shutdown_ = false;                             // Guarded by mu_.
   std::map<grpc::string, ServiceData> services_map_;  // Guarded by mu_.
+  // The serving status of every known service, replaced as a whole (with
+  // std::atomic_store) whenever a status changes, so that health checks can
+  // read it without taking mu_.
+  std::shared_ptr<const std::map<grpc::string, ServingStatus>>
+      status_snapshot_;
   std::unique_ptr<HealthCheckServiceImpl> impl_;
 };
 
@@ -138,43 +138,88 @@ LoadRecordValue::LoadRecordValue(grpc::string metric_name, uint64_t num_calls,
                         CallMetricValue(num_calls, total_metric_value));
 }
 
+constexpr size_t PerBalancerStore::kNumShards;
+
 void PerBalancerStore::MergeRow(const LoadRecordKey& key,
                                 const LoadRecordValue& value) {
-  // During suspension, the load data received will be dropped.
-  if (!suspended_) {
-    load_record_map_[key].MergeFrom(value);
-    gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data merged (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
-  } else {
-    gpr_log(GPR_DEBUG,
-            "[PerBalancerStore %p] Load data dropped (Key: %s, Value: %s).",
-            this, key.ToString().c_str(), value.ToString().c_str());
+  const bool log = gpr_should_log(GPR_LOG_SEVERITY_DEBUG);
+  {
+    Shard& shard = ShardFor(key);
+    grpc_core::MutexLock lock(&shard.mu);
+    // During suspension, the load data received will be dropped. Suspend()
+    // sets the flag before clearing the shards, so checking it under the
+    // shard lock never leaves rows behind in a suspended store.
+    if (!suspended_.load(std::memory_order_relaxed)) {
+      shard.load_record_map[key].MergeFrom(value);
+      if (log) {
+        gpr_log(GPR_DEBUG,
+                "[PerBalancerStore %p] Load data merged (Key: %s, Value: %s).",
+                this, key.ToString().c_str(), value.ToString().c_str());
+      }
+    } else if (log) {
+      gpr_log(GPR_DEBUG,
+              "[PerBalancerStore %p] Load data dropped (Key: %s, Value: %s).",
+              this, key.ToString().c_str(), value.ToString().c_str());
+    }
   }
   // We always keep track of num_calls_in_progress_, so that when this
   // store is resumed, we still have a correct value of
   // num_calls_in_progress_.
-  GPR_ASSERT(static_cast<int64_t>(num_calls_in_progress_) +
-                 value.GetNumCallsInProgressDelta() >=
-             0);
-  num_calls_in_progress_ += value.GetNumCallsInProgressDelta();
+  int64_t delta = value.GetNumCallsInProgressDelta();
+  uint64_t prev = num_calls_in_progress_.fetch_add(
+      static_cast<uint64_t>(delta), std::memory_order_relaxed);
+  GPR_ASSERT(static_cast<int64_t>(prev) + delta >= 0);
 }
 
 void PerBalancerStore::Suspend() {
-  suspended_ = true;
-  load_record_map_.clear();
+  suspended_.store(true, std::memory_order_relaxed);
+  for (Shard& shard : shards_) {
+    grpc_core::MutexLock lock(&shard.mu);
+    shard.load_record_map.clear();
+  }
   gpr_log(GPR_DEBUG, "[PerBalancerStore %p] Suspended.", this);
 }
 
 void PerBalancerStore::Resume() {
-  suspended_ = false;
+  suspended_.store(false, std::memory_order_relaxed);
   gpr_log(GPR_DEBUG, "[PerBalancerStore %p] Resumed.", this);
 }
 
 uint64_t PerBalancerStore::GetNumCallsInProgressForReport() {
-  GPR_ASSERT(!suspended_);
-  last_reported_num_calls_in_progress_ = num_calls_in_progress_;
-  return num_calls_in_progress_;
+  GPR_ASSERT(!IsSuspended());
+  last_reported_num_calls_in_progress_ =
+      num_calls_in_progress_.load(std::memory_order_relaxed);
+  return last_reported_num_calls_in_progress_;
+}
+
+PerBalancerStore::LoadRecordMap PerBalancerStore::TakeLoadRecordMap() {
+  LoadRecordMap load_record_map;
+  for (Shard& shard : shards_) {
+    LoadRecordMap taken;
+    {
+      grpc_core::MutexLock lock(&shard.mu);
+      taken.swap(shard.load_record_map);
+    }
+    // The shards hold disjoint keys.
+    if (load_record_map.empty()) {
+      load_record_map = std::move(taken);
+    } else {
+      for (auto& p : taken) {
+        load_record_map.emplace(p.first, std::move(p.second));
+      }
+    }
+  }
+  return load_record_map;
+}
+
+PerBalancerStore::LoadRecordMap PerBalancerStore::load_record_map() const {
+  LoadRecordMap load_record_map;
+  for (Shard& shard : shards_) {
+    grpc_core::MutexLock lock(&shard.mu);
+    load_record_map.insert(shard.load_record_map.begin(),
+                           shard.load_record_map.end());
+  }
+  return load_record_map;
 }
 
 void PerHostStore::ReportStreamCreated(const grpc::string& lb_id,
@@ -275,6 +320,12 @@ void PerHostStore::SetUpForNewLbId(const grpc::string& lb_id,
 
 PerBalancerStore* LoadDataStore::FindPerBalancerStore(
     const string& hostname, const string& lb_id) const {
+  grpc_core::MutexLock lock(&mu_);
+  return FindPerBalancerStoreLocked(hostname, lb_id);
+}
+
+PerBalancerStore* LoadDataStore::FindPerBalancerStoreLocked(
+    const string& hostname, const string& lb_id) const {
   auto it = per_host_stores_.find(hostname);
   if (it != per_host_stores_.end()) {
     const PerHostStore& per_host_store = it->second;
@@ -287,35 +338,52 @@ PerBalancerStore* LoadDataStore::FindPerBalancerStore(
 void LoadDataStore::MergeRow(const grpc::string& hostname,
                              const LoadRecordKey& key,
                              const LoadRecordValue& value) {
-  PerBalancerStore* per_balancer_store =
-      FindPerBalancerStore(hostname, key.lb_id());
-  if (per_balancer_store != nullptr) {
-    per_balancer_store->MergeRow(key, value);
-    return;
+  PerBalancerStore* per_balancer_store;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    per_balancer_store = FindPerBalancerStoreLocked(hostname, key.lb_id());
+    if (per_balancer_store == nullptr) {
+      TrackUnknownBalancerIdLocked(key.lb_id(),
+                                   value.GetNumCallsInProgressDelta());
+      return;
+    }
   }
+  // Stores are never removed, so the row can be merged outside of mu_.
+  per_balancer_store->MergeRow(key, value);
+}
+
+void LoadDataStore::TrackUnknownBalancerIdLocked(const grpc::string& lb_id,
+                                                 int64_t in_progress_delta) {
   // Unknown LB ID. Track it until its number of in-progress calls drops to
   // zero.
-  int64_t in_progress_delta = value.GetNumCallsInProgressDelta();
   if (in_progress_delta != 0) {
-    auto it_tracker = unknown_balancer_id_trackers_.find(key.lb_id());
+    auto it_tracker = unknown_balancer_id_trackers_.find(lb_id);
     if (it_tracker == unknown_balancer_id_trackers_.end()) {
       gpr_log(
           GPR_DEBUG,
           "[LoadDataStore %p] Start tracking unknown balancer (lb_id_: %s).",
-          this, key.lb_id().c_str());
+          this, lb_id.c_str());
       unknown_balancer_id_trackers_.insert(
-          {key.lb_id(), static_cast<uint64_t>(in_progress_delta)});
+          {lb_id, static_cast<uint64_t>(in_progress_delta)});
     } else if ((it_tracker->second += in_progress_delta) == 0) {
       unknown_balancer_id_trackers_.erase(it_tracker);
       gpr_log(GPR_DEBUG,
               "[LoadDataStore %p] Stop tracking unknown balancer (lb_id_: %s).",
-              this, key.lb_id().c_str());
+              this, lb_id.c_str());
     }
   }
 }
 
+bool LoadDataStore::IsTrackedUnknownBalancerId(
+    const grpc::string& lb_id) const {
+  grpc_core::MutexLock lock(&mu_);
+  return unknown_balancer_id_trackers_.find(lb_id) !=
+         unknown_balancer_id_trackers_.end();
+}
+
 const std::set<PerBalancerStore*>* LoadDataStore::GetAssignedStores(
     const grpc::string& hostname, const grpc::string& lb_id) {
+  grpc_core::MutexLock lock(&mu_);
   auto it = per_host_stores_.find(hostname);
   if (it == per_host_stores_.end()) return nullptr;
   return it->second.GetAssignedStores(lb_id);
@@ -324,11 +392,13 @@ const std::set<PerBalancerStore*>* LoadDataStore::GetAssignedStores(
 void LoadDataStore::ReportStreamCreated(const grpc::string& hostname,
                                         const grpc::string& lb_id,
                                         const grpc::string& load_key) {
+  grpc_core::MutexLock lock(&mu_);
   per_host_stores_[hostname].ReportStreamCreated(lb_id, load_key);
 }
 
 void LoadDataStore::ReportStreamClosed(const grpc::string& hostname,
                                        const grpc::string& lb_id) {
+  grpc_core::MutexLock lock(&mu_);
   auto it_per_host_store = per_host_stores_.find(hostname);
   GPR_ASSERT(it_per_host_store != per_host_stores_.end());
   it_per_host_store->second.ReportStreamClosed(lb_id);
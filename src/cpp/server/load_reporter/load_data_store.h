@@ -21,6 +21,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -28,6 +29,7 @@
 #include <grpc/support/log.h>
 #include <grpcpp/impl/codegen/config.h>
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/cpp/server/load_reporter/constants.h"
 
 namespace grpc {
@@ -191,7 +193,8 @@ class LoadRecordValue {
   std::unordered_map<grpc::string, CallMetricValue> call_metrics_;
 };
 
-// Stores the data associated with a particular LB ID.
+// Stores the data associated with a particular LB ID. Thread-safe: rows are
+// merged while the stores are being reported and re-assigned.
 class PerBalancerStore {
  public:
   using LoadRecordMap =
@@ -209,10 +212,13 @@ class PerBalancerStore {
   // Resume this store from suspension.
   void Resume();
   // Is this store suspended or not?
-  bool IsSuspended() const { return suspended_; }
+  bool IsSuspended() const {
+    return suspended_.load(std::memory_order_relaxed);
+  }
 
   bool IsNumCallsInProgressChangedSinceLastReport() const {
-    return num_calls_in_progress_ != last_reported_num_calls_in_progress_;
+    return num_calls_in_progress_.load(std::memory_order_relaxed) !=
+           last_reported_num_calls_in_progress_;
   }
 
   uint64_t GetNumCallsInProgressForReport();
@@ -222,21 +228,37 @@ class PerBalancerStore {
            "]";
   }
 
-  void ClearLoadRecordMap() { load_record_map_.clear(); }
+  // Returns the load records merged since the last call and clears them.
+  LoadRecordMap TakeLoadRecordMap();
 
   // Getters.
   const grpc::string& lb_id() const { return lb_id_; }
   const grpc::string& load_key() const { return load_key_; }
-  const LoadRecordMap& load_record_map() const { return load_record_map_; }
+  // Returns a copy of the load records.
+  LoadRecordMap load_record_map() const;
 
  private:
+  // The load records are spread over shards by the hash of their keys, so
+  // that merging rows only contends with merges of the same shard.
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    grpc_core::Mutex mu;
+    LoadRecordMap load_record_map;
+  };
+
+  Shard& ShardFor(const LoadRecordKey& key) {
+    return shards_[LoadRecordKey::Hasher()(key) % kNumShards];
+  }
+
   grpc::string lb_id_;
   // TODO(juanlishen): Use bytestring protobuf type?
   grpc::string load_key_;
-  LoadRecordMap load_record_map_;
-  uint64_t num_calls_in_progress_ = 0;
+  mutable Shard shards_[kNumShards];
+  std::atomic<uint64_t> num_calls_in_progress_{0};
+  // Only accessed by the reporting stream of the assigned balancer.
   uint64_t last_reported_num_calls_in_progress_ = 0;
-  bool suspended_ = false;
+  std::atomic<bool> suspended_{false};
 };
 
 // Stores the data associated with a particular host.
@@ -290,7 +312,10 @@ class PerHostStore {
       assigned_stores_;
 };
 
-// Thread-unsafe two-level bookkeeper of all the load data.
+// Thread-safe two-level bookkeeper of all the load data. The host and
+// balancer bookkeeping is guarded by one mutex, which MergeRow() only holds to
+// find the PerBalancerStore; the row itself is merged under the store's
+// shard lock.
 // Note: We never remove any store objects from this class, as per the
 // current spec. That's because premature removal of the store objects
 // may lead to loss of critical information, e.g., mapping from lb_id to
@@ -306,7 +331,9 @@ class LoadDataStore {
                                          const grpc::string& lb_id) const;
 
   // Returns null if hostname or lb_id is not found. The returned pointer points
-  // to the underlying data structure, which is not owned by the caller.
+  // to the underlying data structure, which is not owned by the caller. The
+  // set is changed by ReportStreamCreated() and ReportStreamClosed(), which
+  // callers must not run concurrently with reading it.
   const std::set<PerBalancerStore*>* GetAssignedStores(const string& hostname,
                                                        const string& lb_id);
 
@@ -318,10 +345,7 @@ class LoadDataStore {
 
   // Is the given lb_id a tracked unknown LB ID (i.e., the LB ID was associated
   // with some received load data but unknown to this load data store)?
-  bool IsTrackedUnknownBalancerId(const grpc::string& lb_id) const {
-    return unknown_balancer_id_trackers_.find(lb_id) !=
-           unknown_balancer_id_trackers_.end();
-  }
+  bool IsTrackedUnknownBalancerId(const grpc::string& lb_id) const;
 
   // Wrapper around PerHostStore::ReportStreamCreated.
   void ReportStreamCreated(const grpc::string& hostname,
@@ -333,6 +357,13 @@ class LoadDataStore {
                           const grpc::string& lb_id);
 
  private:
+  PerBalancerStore* FindPerBalancerStoreLocked(const grpc::string& hostname,
+                                               const grpc::string& lb_id) const;
+  void TrackUnknownBalancerIdLocked(const grpc::string& lb_id,
+                                    int64_t in_progress_delta);
+
+  mutable grpc_core::Mutex mu_;
+
   // Buffered data that was fetched from Census but hasn't been sent to
   // balancer. We need to keep this data ourselves because Census will
   // delete the data once it's returned.
@@ -291,6 +291,8 @@ LoadReporter::GenerateLoadBalancingFeedback() {
 ::google::protobuf::RepeatedPtrField<::grpc::lb::v1::Load>
 LoadReporter::GenerateLoads(const grpc::string& hostname,
                             const grpc::string& lb_id) {
+  // Sampling doesn't take store_mu_, so it keeps merging rows while the loads
+  // are being built; only stream creation and closure wait for this.
   grpc_core::MutexLock lock(&store_mu_);
   auto assigned_stores = load_data_store_.GetAssignedStores(hostname, lb_id);
   GPR_ASSERT(assigned_stores != nullptr);
@@ -298,8 +300,10 @@ LoadReporter::GenerateLoads(const grpc::string& hostname,
   ::google::protobuf::RepeatedPtrField<::grpc::lb::v1::Load> loads;
   for (PerBalancerStore* per_balancer_store : *assigned_stores) {
     GPR_ASSERT(!per_balancer_store->IsSuspended());
-    if (!per_balancer_store->load_record_map().empty()) {
-      for (const auto& p : per_balancer_store->load_record_map()) {
+    PerBalancerStore::LoadRecordMap load_record_map =
+        per_balancer_store->TakeLoadRecordMap();
+    if (!load_record_map.empty()) {
+      for (const auto& p : load_record_map) {
         const auto& key = p.first;
         const auto& value = p.second;
         auto load = loads.Add();
@@ -334,7 +338,6 @@ LoadReporter::GenerateLoads(const grpc::string& hostname,
           AttachOrphanLoadId(load, *per_balancer_store);
         }
       }
-      per_balancer_store->ClearLoadRecordMap();
     }
     if (per_balancer_store->IsNumCallsInProgressChangedSinceLastReport()) {
       auto load = loads.Add();
@@ -407,10 +410,7 @@ void LoadReporter::ProcessViewDataCallStart(
       const grpc::string& user_id = tag_values[2];
       LoadRecordKey key(client_ip_and_token, user_id);
       LoadRecordValue value = LoadRecordValue(start_count);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      load_data_store_.MergeRow(host, key, value);
     }
   }
 }
@@ -459,10 +459,7 @@ void LoadReporter::ProcessViewDataCallEnd(
       }
       LoadRecordValue value = LoadRecordValue(
           0, ok_count, error_count, bytes_sent, bytes_received, latency_ms);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      load_data_store_.MergeRow(host, key, value);
     }
   }
   AppendNewFeedbackRecord(total_end_count, total_error_count);
@@ -486,10 +483,7 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
               sizeof(kViewOtherCallMetricValue) - 1, tag_values);
       LoadRecordValue value = LoadRecordValue(
           metric_name, static_cast<uint64_t>(num_calls), total_metric_value);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      load_data_store_.MergeRow(host, key, value);
     }
   }
 }
@@ -216,8 +216,8 @@ class LoadReporter {
   const std::chrono::seconds feedback_sample_window_seconds_;
   grpc_core::Mutex feedback_mu_;
   std::deque<LoadBalancingFeedbackRecord> feedback_records_;
-  // TODO(juanlishen): Lock in finer grain. Locking the whole store may be
-  // too expensive.
+  // Serializes the report stream events with GenerateLoads(), which reads the
+  // balancer assignment of load_data_store_. Merging rows doesn't take it.
   grpc_core::Mutex store_mu_;
   LoadDataStore load_data_store_;
   std::unique_ptr<CensusViewProvider> census_view_provider_;
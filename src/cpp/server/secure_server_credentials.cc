@@ -16,6 +16,7 @@
  *
  */
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <memory>
@@ -28,6 +29,68 @@
 
 namespace grpc {
 
+namespace {
+
+// Bounds the memory held by the verdict cache.
+constexpr size_t kMaxCachedVerdicts = 1024;
+
+}  // namespace
+
+// Forwards to the call's auth context, recording the changes the processor
+// makes to it so that cache hits can replay them.
+class AuthMetadataProcessorAyncWrapper::RecordingAuthContext final
+    : public AuthContext {
+ public:
+  RecordingAuthContext(grpc_auth_context* ctx, Verdict* verdict)
+      : ctx_(ctx), verdict_(verdict) {}
+
+  bool IsPeerAuthenticated() const override {
+    return ctx_.IsPeerAuthenticated();
+  }
+  std::vector<grpc::string_ref> GetPeerIdentity() const override {
+    return ctx_.GetPeerIdentity();
+  }
+  grpc::string GetPeerIdentityPropertyName() const override {
+    return ctx_.GetPeerIdentityPropertyName();
+  }
+  std::vector<grpc::string_ref> FindPropertyValues(
+      const grpc::string& name) const override {
+    return ctx_.FindPropertyValues(name);
+  }
+  AuthPropertyIterator begin() const override { return ctx_.begin(); }
+  AuthPropertyIterator end() const override { return ctx_.end(); }
+
+  void AddProperty(const grpc::string& key,
+                   const grpc::string_ref& value) override {
+    ctx_.AddProperty(key, value);
+    verdict_->properties.emplace_back(
+        key, grpc::string(value.data(), value.length()));
+  }
+  bool SetPeerIdentityPropertyName(const grpc::string& name) override {
+    if (!ctx_.SetPeerIdentityPropertyName(name)) return false;
+    verdict_->peer_identity_property_name = name;
+    return true;
+  }
+
+ private:
+  SecureAuthContext ctx_;
+  Verdict* verdict_;
+};
+
+AuthMetadataProcessorAyncWrapper::AuthMetadataProcessorAyncWrapper(
+    const std::shared_ptr<AuthMetadataProcessor>& processor)
+    : processor_(processor) {
+  if (processor == nullptr) return;
+  if (processor->IsBlocking()) {
+    thread_pool_.reset(CreateDefaultThreadPool());
+    max_batch_size_ = std::max<size_t>(processor->MaxBatchSize(), 1);
+  }
+  cache_ttl_ = processor->VerdictCacheTtl();
+  if (cache_ttl_.count() > 0) {
+    cache_md_key_ = processor->VerdictCacheMetadataKey();
+  }
+}
+
 void AuthMetadataProcessorAyncWrapper::Destroy(void* wrapper) {
   auto* w = static_cast<AuthMetadataProcessorAyncWrapper*>(wrapper);
   delete w;
@@ -42,34 +105,161 @@ void AuthMetadataProcessorAyncWrapper::Process(
     cb(user_data, nullptr, 0, nullptr, 0, GRPC_STATUS_OK, nullptr);
     return;
   }
-  if (w->processor_->IsBlocking()) {
-    w->thread_pool_->Add([w, context, md, num_md, cb, user_data] {
-      w->AuthMetadataProcessorAyncWrapper::InvokeProcessor(context, md, num_md,
-                                                           cb, user_data);
+  grpc::string cache_key;
+  if (w->cache_ttl_.count() > 0) {
+    cache_key = w->VerdictCacheKey(md, num_md);
+    Verdict verdict;
+    if (!cache_key.empty() && w->LookupVerdict(cache_key, &verdict)) {
+      Finish(verdict, context, /*replay=*/true, cb, user_data);
+      return;
+    }
+  }
+  PendingCall call = {context, md, num_md, cb, user_data,
+                      std::move(cache_key)};
+  if (!w->processor_->IsBlocking()) {
+    // invoke directly.
+    std::vector<PendingCall> calls(1, std::move(call));
+    w->InvokeProcessor(&calls);
+  } else if (w->max_batch_size_ == 1) {
+    w->thread_pool_->Add([w, call] {
+      std::vector<PendingCall> calls(1, call);
+      w->InvokeProcessor(&calls);
     });
   } else {
-    // invoke directly.
-    w->InvokeProcessor(context, md, num_md, cb, user_data);
+    // Calls queue up while the thread pool is busy, and are then taken
+    // together by the next batch.
+    grpc::internal::MutexLock lock(&w->mu_);
+    w->queued_calls_.push_back(std::move(call));
+    if (!w->batch_scheduled_) {
+      w->batch_scheduled_ = true;
+      w->thread_pool_->Add([w] { w->ProcessQueuedCalls(); });
+    }
+  }
+}
+
+void AuthMetadataProcessorAyncWrapper::ProcessQueuedCalls() {
+  std::vector<PendingCall> calls;
+  {
+    grpc::internal::MutexLock lock(&mu_);
+    while (!queued_calls_.empty() && calls.size() < max_batch_size_) {
+      calls.push_back(std::move(queued_calls_.front()));
+      queued_calls_.pop_front();
+    }
+    // Let another thread take the calls that did not fit in this batch, or
+    // those that arrive from now on.
+    batch_scheduled_ = !queued_calls_.empty();
+    if (batch_scheduled_) {
+      thread_pool_->Add([this] { ProcessQueuedCalls(); });
+    }
   }
+  InvokeProcessor(&calls);
 }
 
 void AuthMetadataProcessorAyncWrapper::InvokeProcessor(
-    grpc_auth_context* ctx, const grpc_metadata* md, size_t num_md,
-    grpc_process_auth_metadata_done_cb cb, void* user_data) {
-  AuthMetadataProcessor::InputMetadata metadata;
+    std::vector<PendingCall>* calls) {
+  struct Job {
+    explicit Job(const PendingCall& call) : context(call.context, &verdict) {
+      for (size_t i = 0; i < call.num_md; i++) {
+        metadata.insert(std::make_pair(StringRefFromSlice(&call.md[i].key),
+                                       StringRefFromSlice(&call.md[i].value)));
+      }
+    }
+    AuthMetadataProcessor::InputMetadata metadata;
+    Verdict verdict;
+    RecordingAuthContext context;
+  };
+  std::vector<std::unique_ptr<Job>> jobs;
+  jobs.reserve(calls->size());
+  for (const PendingCall& call : *calls) {
+    jobs.emplace_back(new Job(call));
+  }
+
+  if (max_batch_size_ == 1) {
+    Job* job = jobs[0].get();
+    job->verdict.status = processor_->Process(job->metadata, &job->context,
+                                              &job->verdict.consumed_md,
+                                              &job->verdict.response_md);
+  } else {
+    std::vector<AuthMetadataProcessor::BatchEntry> batch;
+    batch.reserve(jobs.size());
+    for (const auto& job : jobs) {
+      batch.push_back({&job->metadata, &job->context, &job->verdict.consumed_md,
+                       &job->verdict.response_md, Status::OK});
+    }
+    processor_->ProcessBatch(&batch);
+    for (size_t i = 0; i < jobs.size(); i++) {
+      jobs[i]->verdict.status = std::move(batch[i].status);
+    }
+  }
+
+  for (size_t i = 0; i < calls->size(); i++) {
+    const PendingCall& call = (*calls)[i];
+    const Verdict& verdict = jobs[i]->verdict;
+    if (!call.cache_key.empty()) CacheVerdict(call.cache_key, verdict);
+    Finish(verdict, call.context, /*replay=*/false, call.cb, call.user_data);
+  }
+}
+
+grpc::string AuthMetadataProcessorAyncWrapper::VerdictCacheKey(
+    const grpc_metadata* md, size_t num_md) const {
   for (size_t i = 0; i < num_md; i++) {
-    metadata.insert(std::make_pair(StringRefFromSlice(&md[i].key),
-                                   StringRefFromSlice(&md[i].value)));
+    if (StringRefFromSlice(&md[i].key) == cache_md_key_) {
+      return StringFromCopiedSlice(md[i].value);
+    }
   }
-  SecureAuthContext context(ctx);
-  AuthMetadataProcessor::OutputMetadata consumed_metadata;
-  AuthMetadataProcessor::OutputMetadata response_metadata;
+  return "";
+}
 
-  Status status = processor_->Process(metadata, &context, &consumed_metadata,
-                                      &response_metadata);
+bool AuthMetadataProcessorAyncWrapper::LookupVerdict(const grpc::string& key,
+                                                     Verdict* verdict) {
+  grpc::internal::MutexLock lock(&mu_);
+  auto it = cache_.find(key);
+  if (it == cache_.end() ||
+      it->second.expiration <= std::chrono::steady_clock::now()) {
+    return false;
+  }
+  *verdict = it->second;
+  return true;
+}
+
+void AuthMetadataProcessorAyncWrapper::CacheVerdict(const grpc::string& key,
+                                                    Verdict verdict) {
+  const auto now = std::chrono::steady_clock::now();
+  verdict.expiration = now + cache_ttl_;
+  grpc::internal::MutexLock lock(&mu_);
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    it->second = std::move(verdict);
+    return;
+  }
+  cache_.emplace(key, std::move(verdict));
+  cache_order_.push_back(key);
+  // All verdicts live for the same time, so the oldest expire first.
+  while (!cache_order_.empty()) {
+    it = cache_.find(cache_order_.front());
+    if (it->second.expiration > now && cache_.size() <= kMaxCachedVerdicts) {
+      break;
+    }
+    cache_.erase(it);
+    cache_order_.pop_front();
+  }
+}
 
+void AuthMetadataProcessorAyncWrapper::Finish(
+    const Verdict& verdict, grpc_auth_context* context, bool replay,
+    grpc_process_auth_metadata_done_cb cb, void* user_data) {
+  if (replay) {
+    SecureAuthContext auth_context(context);
+    for (const auto& property : verdict.properties) {
+      auth_context.AddProperty(property.first, property.second);
+    }
+    if (!verdict.peer_identity_property_name.empty()) {
+      auth_context.SetPeerIdentityPropertyName(
+          verdict.peer_identity_property_name);
+    }
+  }
   std::vector<grpc_metadata> consumed_md;
-  for (const auto& consumed : consumed_metadata) {
+  for (const auto& consumed : verdict.consumed_md) {
     grpc_metadata md_entry;
     md_entry.key = SliceReferencingString(consumed.first);
     md_entry.value = SliceReferencingString(consumed.second);
@@ -77,7 +267,7 @@ void AuthMetadataProcessorAyncWrapper::InvokeProcessor(
     consumed_md.push_back(md_entry);
   }
   std::vector<grpc_metadata> response_md;
-  for (const auto& response : response_metadata) {
+  for (const auto& response : verdict.response_md) {
     grpc_metadata md_entry;
     md_entry.key = SliceReferencingString(response.first);
     md_entry.value = SliceReferencingString(response.second);
@@ -87,8 +277,9 @@ void AuthMetadataProcessorAyncWrapper::InvokeProcessor(
   auto consumed_md_data = consumed_md.empty() ? nullptr : &consumed_md[0];
   auto response_md_data = response_md.empty() ? nullptr : &response_md[0];
   cb(user_data, consumed_md_data, consumed_md.size(), response_md_data,
-     response_md.size(), static_cast<grpc_status_code>(status.error_code()),
-     status.error_message().c_str());
+     response_md.size(),
+     static_cast<grpc_status_code>(verdict.status.error_code()),
+     verdict.status.error_message().c_str());
 }
 
 }  // namespace grpc
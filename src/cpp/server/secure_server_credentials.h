@@ -19,8 +19,13 @@
 #ifndef GRPC_INTERNAL_CPP_SERVER_SECURE_SERVER_CREDENTIALS_H
 #define GRPC_INTERNAL_CPP_SERVER_SECURE_SERVER_CREDENTIALS_H
 
+#include <chrono>
+#include <deque>
+#include <map>
 #include <memory>
+#include <vector>
 
+#include <grpcpp/impl/codegen/sync.h>
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/security/tls_credentials_options.h>
 
@@ -46,19 +51,57 @@ class AuthMetadataProcessorAyncWrapper final {
                       grpc_process_auth_metadata_done_cb cb, void* user_data);
 
   AuthMetadataProcessorAyncWrapper(
-      const std::shared_ptr<AuthMetadataProcessor>& processor)
-      : processor_(processor) {
-    if (processor && processor->IsBlocking()) {
-      thread_pool_.reset(CreateDefaultThreadPool());
-    }
-  }
+      const std::shared_ptr<AuthMetadataProcessor>& processor);
 
  private:
-  void InvokeProcessor(grpc_auth_context* context, const grpc_metadata* md,
-                       size_t num_md, grpc_process_auth_metadata_done_cb cb,
-                       void* user_data);
-  std::unique_ptr<ThreadPoolInterface> thread_pool_;
+  class RecordingAuthContext;
+
+  struct PendingCall {
+    grpc_auth_context* context;
+    const grpc_metadata* md;
+    size_t num_md;
+    grpc_process_auth_metadata_done_cb cb;
+    void* user_data;
+    // Value of the verdict cache metadata, empty if not caching.
+    grpc::string cache_key;
+  };
+
+  // What the processor did for a call, replayed on cache hits.
+  struct Verdict {
+    Status status;
+    AuthMetadataProcessor::OutputMetadata consumed_md;
+    AuthMetadataProcessor::OutputMetadata response_md;
+    std::vector<std::pair<grpc::string, grpc::string>> properties;
+    grpc::string peer_identity_property_name;
+    std::chrono::steady_clock::time_point expiration;
+  };
+
+  // Runs the processor on \a calls, as one batch if batching.
+  void InvokeProcessor(std::vector<PendingCall>* calls);
+  // Invokes the processor on the queued calls, a batch at a time.
+  void ProcessQueuedCalls();
+  grpc::string VerdictCacheKey(const grpc_metadata* md, size_t num_md) const;
+  bool LookupVerdict(const grpc::string& key, Verdict* verdict);
+  void CacheVerdict(const grpc::string& key, Verdict verdict);
+  static void Finish(const Verdict& verdict, grpc_auth_context* context,
+                     bool replay, grpc_process_auth_metadata_done_cb cb,
+                     void* user_data);
+
   std::shared_ptr<AuthMetadataProcessor> processor_;
+  size_t max_batch_size_ = 1;
+  std::chrono::milliseconds cache_ttl_{0};
+  grpc::string cache_md_key_;
+
+  grpc::internal::Mutex mu_;
+  // Calls waiting for a batch, when batching.
+  std::deque<PendingCall> queued_calls_;
+  // Whether a thread pool task will take the next batch of queued_calls_.
+  bool batch_scheduled_ = false;
+  std::map<grpc::string, Verdict> cache_;
+  // Keys of cache_ in insertion order, hence expiration order.
+  std::deque<grpc::string> cache_order_;
+  // Last, so that its tasks are done before the above are destroyed.
+  std::unique_ptr<ThreadPoolInterface> thread_pool_;
 };
 
 }  // namespace grpc
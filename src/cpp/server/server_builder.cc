@@ -127,6 +127,17 @@ ServerBuilder::experimental_type::AddExternalConnectionAcceptor(
   return builder_->acceptors_.back()->GetAcceptor();
 }
 
+std::unique_ptr<ServerCompletionQueue>
+ServerBuilder::experimental_type::AddShardedCompletionQueue(
+    int num_shards, bool is_frequently_polled) {
+  ServerCompletionQueue* cq = new ServerCompletionQueue(
+      GRPC_CQ_NEXT,
+      is_frequently_polled ? GRPC_CQ_DEFAULT_POLLING : GRPC_CQ_NON_LISTENING,
+      nullptr, num_shards);
+  builder_->cqs_.push_back(cq);
+  return std::unique_ptr<ServerCompletionQueue>(cq);
+}
+
 ServerBuilder& ServerBuilder::SetOption(
     std::unique_ptr<grpc::ServerBuilderOption> option) {
   options_.push_back(std::move(option));
@@ -148,6 +159,12 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case TARGET_QUEUE_DELAY_USEC:
+      sync_server_settings_.target_queue_delay_usec = val;
+      break;
+    case PIN_CQ_THREADS:
+      sync_server_settings_.pin_cq_threads = val != 0;
+      break;
   }
   return *this;
 }
@@ -306,10 +323,11 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
     // This is a Sync server
     gpr_log(GPR_INFO,
             "Synchronous server. Num CQs: %d, Min pollers: %d, Max Pollers: "
-            "%d, CQ timeout (msec): %d",
+            "%d, CQ timeout (msec): %d, Target queue delay (usec): %d",
             sync_server_settings_.num_cqs, sync_server_settings_.min_pollers,
             sync_server_settings_.max_pollers,
-            sync_server_settings_.cq_timeout_msec);
+            sync_server_settings_.cq_timeout_msec,
+            sync_server_settings_.target_queue_delay_usec);
   }
 
   if (has_callback_methods) {
@@ -319,8 +337,14 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
   std::unique_ptr<grpc::Server> server(new grpc::Server(
       max_receive_message_size_, &args, sync_server_cqs,
       sync_server_settings_.min_pollers, sync_server_settings_.max_pollers,
-      sync_server_settings_.cq_timeout_msec, std::move(acceptors_),
+      sync_server_settings_.cq_timeout_msec,
+      sync_server_settings_.target_queue_delay_usec, std::move(acceptors_),
       resource_quota_, std::move(interceptor_creators_)));
+  server->callback_reactions_inline_ = callback_reactions_inline_;
+  server->pin_sync_cq_threads_ = sync_server_settings_.pin_cq_threads;
+  server->concurrency_limit_initial_ = concurrency_limit_initial_;
+  server->concurrency_limit_max_ = concurrency_limit_max_;
+  server->method_priorities_ = method_priorities_;
 
   grpc_impl::ServerInitializer* initializer = server->initializer();
 
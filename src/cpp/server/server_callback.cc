@@ -25,7 +25,7 @@ namespace grpc_impl {
 namespace internal {
 
 void ServerCallbackCall::CallOnCancel(ServerReactor* reactor) {
-  if (reactor->InternalInlineable()) {
+  if (inline_reactions_ || reactor->InternalInlineable()) {
     reactor->OnCancel();
   } else {
     Ref();
@@ -25,6 +25,7 @@
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpcpp/alarm.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/generic/async_generic_service.h>
 #include <grpcpp/impl/codegen/async_unary_call.h>
@@ -42,11 +43,13 @@
 #include <grpcpp/support/time.h>
 
 #include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/completion_queue.h"
 #include "src/cpp/client/create_channel_internal.h"
+#include "src/cpp/server/concurrency_limiter.h"
 #include "src/cpp/server/external_connection_acceptor_impl.h"
 #include "src/cpp/server/health/default_health_check_service.h"
 #include "src/cpp/thread_manager/thread_manager.h"
@@ -339,9 +342,12 @@ class Server::UnimplementedAsyncResponse final
 
 class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
  public:
-  SyncRequest(grpc::internal::RpcServiceMethod* method, void* method_tag)
+  SyncRequest(grpc::internal::RpcServiceMethod* method, void* method_tag,
+              grpc::internal::ConcurrencyLimiter* limiter, int priority)
       : method_(method),
         method_tag_(method_tag),
+        limiter_(limiter),
+        priority_(priority),
         in_flight_(false),
         has_request_payload_(method->method_type() ==
                                  grpc::internal::RpcMethod::NORMAL_RPC ||
@@ -361,6 +367,8 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
 
   void SetupRequest() { cq_ = grpc_completion_queue_create_for_pluck(nullptr); }
 
+  int priority() const { return priority_; }
+
   void TeardownRequest() {
     grpc_completion_queue_destroy(cq_);
     cq_ = nullptr;
@@ -428,6 +436,7 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
                                                 : nullptr),
           request_(nullptr),
           method_(mrd->method_),
+          limiter_(mrd->limiter_),
           call_(
               mrd->call_, server, &cq_, server->max_receive_message_size(),
               ctx_.set_server_rpc_info(method_->name(), method_->method_type(),
@@ -451,6 +460,10 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
     void Run(const std::shared_ptr<GlobalCallbacks>& global_callbacks,
              bool resources) {
       global_callbacks_ = global_callbacks;
+      if (resources && limiter_ != nullptr) {
+        resources = limiter_->TryAcquire();
+        if (resources) start_time_ = gpr_now(GPR_CLOCK_MONOTONIC);
+      }
       resources_ = resources;
 
       interceptor_methods_.SetCall(&call_);
@@ -465,8 +478,12 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
         // Set interception point for RECV MESSAGE
         auto* handler = resources_ ? method_->handler()
                                    : server_->resource_exhausted_handler_.get();
+        // Hand responses back as objects only to a client that did the same
+        call_.set_message_passthrough(
+            grpc::internal::MessagePassthrough::IsPassedThrough(
+                request_payload_));
         request_ = handler->Deserialize(call_.call(), request_payload_,
-                                        &request_status_, nullptr);
+                                        &request_status_, &handler_data_);
 
         request_payload_ = nullptr;
         interceptor_methods_.AddInterceptionHookPoint(
@@ -490,9 +507,14 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
         auto* handler = resources_ ? method_->handler()
                                    : server_->resource_exhausted_handler_.get();
         handler->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
-            &call_, &ctx_, request_, request_status_, nullptr, nullptr));
+            &call_, &ctx_, request_, request_status_, handler_data_, nullptr));
         request_ = nullptr;
+        handler_data_ = nullptr;
         global_callbacks_->PostSynchronousRequest(&ctx_);
+        if (resources_ && limiter_ != nullptr) {
+          limiter_->OnCallDone(static_cast<int64_t>(gpr_timespec_to_micros(
+              gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time_))));
+        }
 
         cq_.Shutdown();
 
@@ -512,18 +534,23 @@ class Server::SyncRequest final : public grpc::internal::CompletionQueueTag {
     const bool has_request_payload_;
     grpc_byte_buffer* request_payload_;
     void* request_;
+    void* handler_data_ = nullptr;
     grpc::Status request_status_;
     grpc::internal::RpcServiceMethod* const method_;
+    grpc::internal::ConcurrencyLimiter* const limiter_;
     grpc::internal::Call call_;
     Server* server_;
     std::shared_ptr<GlobalCallbacks> global_callbacks_;
     bool resources_;
+    gpr_timespec start_time_;
     grpc::internal::InterceptorBatchMethodsImpl interceptor_methods_;
   };
 
  private:
   grpc::internal::RpcServiceMethod* const method_;
   void* const method_tag_;
+  grpc::internal::ConcurrencyLimiter* const limiter_;
+  const int priority_;
   bool in_flight_;
   const bool has_request_payload_;
   grpc_call* call_;
@@ -679,6 +706,7 @@ class Server::CallbackRequest final : public Server::CallbackRequestBase {
       // Bind the call, deadline, and metadata from what we got
       req_->ctx_.set_call(req_->call_);
       req_->ctx_.cq_ = req_->cq_;
+      req_->ctx_.inline_reactions_ = req_->server_->callback_reactions_inline_;
       req_->ctx_.BindDeadlineAndMetadata(req_->deadline_,
                                          &req_->request_metadata_);
       req_->request_metadata_.count = 0;
@@ -707,6 +735,9 @@ class Server::CallbackRequest final : public Server::CallbackRequestBase {
 
       if (req_->has_request_payload_) {
         // Set interception point for RECV MESSAGE
+        call_->set_message_passthrough(
+            grpc::internal::MessagePassthrough::IsPassedThrough(
+                req_->request_payload_));
         req_->request_ = req_->method_->handler()->Deserialize(
             req_->call_, req_->request_payload_, &req_->request_status_,
             &req_->handler_data_);
@@ -837,12 +868,17 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
   SyncRequestThreadManager(Server* server, grpc::CompletionQueue* server_cq,
                            std::shared_ptr<GlobalCallbacks> global_callbacks,
                            grpc_resource_quota* rq, int min_pollers,
-                           int max_pollers, int cq_timeout_msec)
-      : ThreadManager("SyncServer", rq, min_pollers, max_pollers),
+                           int max_pollers, int cq_timeout_msec,
+                           int target_queue_delay_usec)
+      : ThreadManager("SyncServer", rq, min_pollers, max_pollers,
+                      target_queue_delay_usec),
         server_(server),
         server_cq_(server_cq),
         cq_timeout_msec_(cq_timeout_msec),
-        global_callbacks_(std::move(global_callbacks)) {}
+        global_callbacks_(std::move(global_callbacks)),
+        prioritized_(false),
+        cq_shutdown_(false),
+        wakeup_pending_(false) {}
 
   WorkStatus PollForWork(void** tag, bool* ok) override {
     *tag = nullptr;
@@ -851,6 +887,9 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
     gpr_timespec deadline =
         gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
                      gpr_time_from_millis(cq_timeout_msec_, GPR_TIMESPAN));
+    if (prioritized_) {
+      return PollForPrioritizedWork(tag, ok, deadline);
+    }
 
     switch (server_cq_->AsyncNext(tag, ok, deadline)) {
       case grpc::CompletionQueue::TIMEOUT:
@@ -892,8 +931,12 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
     // object
   }
 
-  void AddSyncMethod(grpc::internal::RpcServiceMethod* method, void* tag) {
-    sync_requests_.emplace_back(new SyncRequest(method, tag));
+  void AddSyncMethod(grpc::internal::RpcServiceMethod* method, void* tag,
+                     grpc::internal::ConcurrencyLimiter* limiter,
+                     int priority) {
+    sync_requests_.emplace_back(
+        new SyncRequest(method, tag, limiter, priority));
+    if (priority != 0) prioritized_ = true;
   }
 
   void AddUnknownSyncMethod() {
@@ -902,12 +945,15 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
           "unknown", grpc::internal::RpcMethod::BIDI_STREAMING,
           new grpc::internal::UnknownMethodHandler));
       sync_requests_.emplace_back(
-          new SyncRequest(unknown_method_.get(), nullptr));
+          new SyncRequest(unknown_method_.get(), nullptr, nullptr, 0));
     }
   }
 
   void Shutdown() override {
     ThreadManager::Shutdown();
+    // No more wakeups can be posted once the CQ is shut down.
+    grpc::internal::MutexLock lock(&backlog_mu_);
+    cq_shutdown_ = true;
     server_cq_->Shutdown();
   }
 
@@ -916,7 +962,12 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
     // Drain any pending items from the queue
     void* tag;
     bool ok;
+    for (const ReadyRequest& ready : backlog_) {
+      if (ready.ok) ready.request->PostShutdownCleanup();
+    }
+    backlog_.clear();
     while (server_cq_->Next(&tag, &ok)) {
+      if (tag == &wakeup_alarm_) continue;
       if (ok) {
         // If a request was pulled off the queue, it means that the thread
         // handling the request added it to the completion queue after shutdown
@@ -943,20 +994,103 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
   }
 
  private:
+  // A completed request that no thread has taken yet.
+  struct ReadyRequest {
+    SyncRequest* request;
+    bool ok;
+    int priority;
+    // Times a newer request was taken before this one
+    int passed_over;
+  };
+
+  // A request passed over this many times is taken next, whatever its
+  // priority.
+  static constexpr int kMaxPassedOver = 4;
+
+  // When some methods have a priority, requests are not handled in the order
+  // they complete. Polling threads move all the requests that have completed
+  // on server_cq_ to backlog_, and take the best one from there.
+  WorkStatus PollForPrioritizedWork(void** tag, bool* ok,
+                                    gpr_timespec deadline) {
+    const gpr_timespec no_wait = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+    {
+      grpc::internal::MutexLock lock(&backlog_mu_);
+      if (!backlog_.empty()) deadline = no_wait;
+    }
+    bool shutdown = false;
+    for (;;) {
+      void* event_tag;
+      bool event_ok;
+      grpc::CompletionQueue::NextStatus status =
+          server_cq_->AsyncNext(&event_tag, &event_ok, deadline);
+      if (status != grpc::CompletionQueue::GOT_EVENT) {
+        shutdown = status == grpc::CompletionQueue::SHUTDOWN;
+        break;
+      }
+      deadline = no_wait;
+      grpc::internal::MutexLock lock(&backlog_mu_);
+      if (event_tag == &wakeup_alarm_) {
+        wakeup_pending_ = false;
+        continue;
+      }
+      SyncRequest* request = static_cast<SyncRequest*>(event_tag);
+      backlog_.push_back({request, event_ok, request->priority(), 0});
+    }
+    grpc::internal::MutexLock lock(&backlog_mu_);
+    if (backlog_.empty()) {
+      return shutdown ? SHUTDOWN : TIMEOUT;
+    }
+    // The oldest request of the highest priority, unless an older request has
+    // waited long enough.
+    size_t next = 0;
+    for (size_t i = 0; i < backlog_.size(); i++) {
+      if (backlog_[i].passed_over >= kMaxPassedOver) {
+        next = i;
+        break;
+      }
+      if (backlog_[i].priority > backlog_[next].priority) next = i;
+    }
+    for (size_t i = 0; i < next; i++) {
+      backlog_[i].passed_over++;
+    }
+    *tag = backlog_[next].request;
+    *ok = backlog_[next].ok;
+    backlog_.erase(backlog_.begin() + next);
+    // Threads blocked on server_cq_ don't see the backlog: wake one up to
+    // take the rest.
+    if (!backlog_.empty() && !wakeup_pending_ && !cq_shutdown_) {
+      wakeup_pending_ = true;
+      wakeup_alarm_.Set(server_cq_, no_wait, &wakeup_alarm_);
+    }
+    return WORK_FOUND;
+  }
+
   Server* server_;
   grpc::CompletionQueue* server_cq_;
   int cq_timeout_msec_;
   std::vector<std::unique_ptr<SyncRequest>> sync_requests_;
   std::unique_ptr<grpc::internal::RpcServiceMethod> unknown_method_;
   std::shared_ptr<Server::GlobalCallbacks> global_callbacks_;
+  // Whether any method has a non-zero priority
+  bool prioritized_;
+
+  grpc::internal::Mutex backlog_mu_;
+  std::vector<ReadyRequest> backlog_;
+  bool cq_shutdown_;
+  // Whether wakeup_alarm_ is set and has not been polled yet
+  bool wakeup_pending_;
+  grpc::Alarm wakeup_alarm_;
 };
 
+constexpr int Server::SyncRequestThreadManager::kMaxPassedOver;
+
 static grpc::internal::GrpcLibraryInitializer g_gli_initializer;
 Server::Server(
     int max_receive_message_size, grpc::ChannelArguments* args,
     std::shared_ptr<std::vector<std::unique_ptr<grpc::ServerCompletionQueue>>>
         sync_server_cqs,
     int min_pollers, int max_pollers, int sync_cq_timeout_msec,
+    int sync_target_queue_delay_usec,
     std::vector<std::shared_ptr<grpc::internal::ExternalConnectionAcceptorImpl>>
         acceptors,
     grpc_resource_quota* server_rq,
@@ -990,7 +1124,7 @@ Server::Server(
     for (const auto& it : *sync_server_cqs_) {
       sync_req_mgrs_.emplace_back(new SyncRequestThreadManager(
           this, it.get(), global_callbacks_, server_rq, min_pollers,
-          max_pollers, sync_cq_timeout_msec));
+          max_pollers, sync_cq_timeout_msec, sync_target_queue_delay_usec));
     }
 
     if (default_rq_created) {
@@ -1060,11 +1194,9 @@ grpc_server* Server::c_server() { return server_; }
 
 std::shared_ptr<grpc::Channel> Server::InProcessChannel(
     const grpc::ChannelArguments& args) {
-  grpc_channel_args channel_args = args.c_channel_args();
-  return grpc::CreateChannelInternal(
-      "inproc", grpc_inproc_channel_create(server_, &channel_args, nullptr),
-      std::vector<std::unique_ptr<
-          grpc::experimental::ClientInterceptorFactoryInterface>>());
+  return InProcessChannelInternal(
+      args, std::vector<std::unique_ptr<
+                grpc::experimental::ClientInterceptorFactoryInterface>>());
 }
 
 std::shared_ptr<grpc::Channel>
@@ -1073,11 +1205,32 @@ Server::experimental_type::InProcessChannelWithInterceptors(
     std::vector<
         std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
         interceptor_creators) {
+  return server_->InProcessChannelInternal(args,
+                                          std::move(interceptor_creators));
+}
+
+std::vector<Server::experimental_type::MethodConcurrencyLimit>
+Server::experimental_type::GetMethodConcurrencyLimits() {
+  std::vector<MethodConcurrencyLimit> limits;
+  for (const auto& limiter : server_->concurrency_limiters_) {
+    limits.push_back({limiter->method(), limiter->limit(), limiter->in_flight(),
+                      limiter->rejected_calls()});
+  }
+  return limits;
+}
+
+std::shared_ptr<grpc::Channel> Server::InProcessChannelInternal(
+    const grpc::ChannelArguments& args,
+    std::vector<
+        std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
+        interceptor_creators) {
   grpc_channel_args channel_args = args.c_channel_args();
-  return grpc::CreateChannelInternal(
-      "inproc",
-      grpc_inproc_channel_create(server_->server_, &channel_args, nullptr),
+  std::shared_ptr<grpc::Channel> channel = grpc::CreateChannelInternal(
+      "inproc", grpc_inproc_channel_create(server_, &channel_args, nullptr),
       std::move(interceptor_creators));
+  channel->message_passthrough_ = grpc_channel_args_find_bool(
+      &channel_args, GRPC_ARG_INPROC_MESSAGE_PASSTHROUGH, false);
+  return channel;
 }
 
 static grpc_server_register_method_payload_handling PayloadHandlingForMethod(
@@ -1121,8 +1274,23 @@ bool Server::RegisterService(const grpc::string* host, grpc::Service* service) {
       method->set_server_tag(method_registration_tag);
     } else if (method->api_type() ==
                grpc::internal::RpcServiceMethod::ApiType::SYNC) {
+      auto priority_it = method_priorities_.find(method->name());
+      const int priority =
+          priority_it == method_priorities_.end() ? 0 : priority_it->second;
+      grpc::internal::ConcurrencyLimiter* limiter = nullptr;
+      if (concurrency_limit_max_ > 0) {
+        int initial_limit = concurrency_limit_initial_;
+        if (initial_limit < 1) initial_limit = 1;
+        if (initial_limit > concurrency_limit_max_) {
+          initial_limit = concurrency_limit_max_;
+        }
+        limiter = new grpc::internal::ConcurrencyLimiter(
+            method->name(), initial_limit, concurrency_limit_max_);
+        concurrency_limiters_.emplace_back(limiter);
+      }
       for (const auto& value : sync_req_mgrs_) {
-        value->AddSyncMethod(method.get(), method_registration_tag);
+        value->AddSyncMethod(method.get(), method_registration_tag, limiter,
+                             priority);
       }
     } else {
       // a callback method. Register at least some callback requests
@@ -1253,8 +1421,14 @@ void Server::Start(grpc::ServerCompletionQueue** cqs, size_t num_cqs) {
         new grpc::internal::ResourceExhaustedHandler);
   }
 
-  for (const auto& value : sync_req_mgrs_) {
-    value->Start();
+  for (size_t i = 0; i < sync_req_mgrs_.size(); i++) {
+    // Each manager's threads are the only ones polling its CQ, so pinning
+    // them also keeps the CQ's pollset on the same CPUs.
+    if (pin_sync_cq_threads_) {
+      sync_req_mgrs_[i]->SetCpuGroup(static_cast<int>(i),
+                                     static_cast<int>(sync_req_mgrs_.size()));
+    }
+    sync_req_mgrs_[i]->Start();
   }
 
   for (auto* cbreq : callback_reqs_to_start_) {
@@ -1397,7 +1571,7 @@ grpc::CompletionQueue* Server::CallbackCQ() {
     auto* shutdown_callback = new grpc::ShutdownCallback;
     callback_cq_ = new grpc::CompletionQueue(grpc_completion_queue_attributes{
         GRPC_CQ_CURRENT_VERSION, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING,
-        shutdown_callback});
+        shutdown_callback, 1});
 
     // Transfer ownership of the new cq to its own shutdown callback
     shutdown_callback->TakeCQ(callback_cq_);
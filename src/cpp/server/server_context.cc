@@ -34,6 +34,7 @@
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/surface/call.h"
+#include "src/cpp/common/write_timestamps.h"
 
 namespace grpc_impl {
 namespace experimental {
@@ -371,6 +372,22 @@ const struct census_context* ServerContextBase::census_context() const {
   return grpc_census_call_get_context(call_);
 }
 
+void ServerContextBase::EnableWriteTimestamps() {
+  if (call_ == nullptr) return;
+  grpc::internal::EnableCallWriteTimestamps(call_);
+}
+
+bool ServerContextBase::GetWriteTimestamps(
+    grpc::experimental::WriteTimestamps* timestamps) {
+  if (call_ == nullptr) return false;
+  return grpc::internal::GetCallWriteTimestamps(call_, timestamps);
+}
+
+void ServerContextBase::set_write_weight(uint32_t weight) {
+  if (call_ == nullptr) return;
+  grpc::internal::SetCallWriteWeight(call_, weight);
+}
+
 void ServerContextBase::SetLoadReportingCosts(
     const std::vector<grpc::string>& cost_data) {
   if (call_ == nullptr) return;
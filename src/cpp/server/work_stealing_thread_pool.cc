@@ -0,0 +1,181 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/server/work_stealing_thread_pool.h"
+
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc {
+namespace {
+
+GPR_TLS_DECL(g_current_worker);
+gpr_once g_tls_once = GPR_ONCE_INIT;
+
+void InitTls() { gpr_tls_init(&g_current_worker); }
+
+}  // namespace
+
+WorkStealingThreadPool::Worker::Worker(WorkStealingThreadPool* pool,
+                                       size_t index)
+    : pool(pool),
+      index(index),
+      // Any non-zero seed will do for xorshift
+      rand_state(static_cast<uint32_t>(index) * 2654435761u + 1) {}
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_threads) {
+  gpr_once_init(&g_tls_once, InitTls);
+  const size_t n = num_threads > 0 ? num_threads : 1;
+  for (size_t i = 0; i < n; i++) {
+    workers_.emplace_back(new Worker(this, i));
+  }
+  for (auto& worker : workers_) {
+    Worker* w = worker.get();
+    w->thd = grpc_core::Thread(
+        "grpcpp_ws_pool",
+        [](void* arg) {
+          Worker* w = static_cast<Worker*>(arg);
+          w->pool->ThreadFunc(w);
+        },
+        w);
+    w->thd.Start();
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  shutdown_.store(true, std::memory_order_seq_cst);
+  for (auto& worker : workers_) {
+    grpc_core::MutexLock lock(&worker->mu);
+    worker->cv.Signal();
+  }
+  for (auto& worker : workers_) {
+    worker->thd.Join();
+  }
+}
+
+void WorkStealingThreadPool::Add(const std::function<void()>& callback) {
+  Worker* worker = reinterpret_cast<Worker*>(gpr_tls_get(&g_current_worker));
+  if (worker == nullptr || worker->pool != this) {
+    worker = workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) %
+                      workers_.size()]
+                 .get();
+  }
+  {
+    grpc_core::MutexLock lock(&worker->mu);
+    worker->callbacks.push_back(callback);
+  }
+  // Pairs with Sleep(): either the sleeping worker sees the new callback, or
+  // we see it sleeping and wake it up.
+  num_pending_.fetch_add(1, std::memory_order_seq_cst);
+  if (num_sleeping_.load(std::memory_order_seq_cst) > 0) {
+    WakeOne(worker->index);
+  }
+}
+
+void WorkStealingThreadPool::WakeOne(size_t start) {
+  for (size_t i = 0; i < workers_.size(); i++) {
+    Worker* worker = workers_[(start + i) % workers_.size()].get();
+    grpc_core::MutexLock lock(&worker->mu);
+    if (worker->sleeping) {
+      // Claim the wakeup so that concurrent callers pick another worker
+      worker->sleeping = false;
+      num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+      worker->cv.Signal();
+      return;
+    }
+  }
+}
+
+bool WorkStealingThreadPool::Next(Worker* worker,
+                                  std::function<void()>* callback) {
+  bool found = false;
+  {
+    grpc_core::MutexLock lock(&worker->mu);
+    if (!worker->callbacks.empty()) {
+      *callback = std::move(worker->callbacks.back());
+      worker->callbacks.pop_back();
+      found = true;
+    }
+  }
+  if (!found) found = Steal(worker, callback);
+  if (found) num_pending_.fetch_sub(1, std::memory_order_relaxed);
+  return found;
+}
+
+bool WorkStealingThreadPool::Steal(Worker* thief,
+                                   std::function<void()>* callback) {
+  if (workers_.size() == 1 ||
+      num_pending_.load(std::memory_order_relaxed) <= 0) {
+    return false;
+  }
+  // xorshift32
+  uint32_t x = thief->rand_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  thief->rand_state = x;
+  const size_t start = x % workers_.size();
+  for (size_t i = 0; i < workers_.size(); i++) {
+    Worker* victim = workers_[(start + i) % workers_.size()].get();
+    if (victim == thief) continue;
+    grpc_core::MutexLock lock(&victim->mu);
+    if (!victim->callbacks.empty()) {
+      *callback = std::move(victim->callbacks.front());
+      victim->callbacks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::Sleep(Worker* worker) {
+  grpc_core::MutexLock lock(&worker->mu);
+  worker->sleeping = true;
+  num_sleeping_.fetch_add(1, std::memory_order_seq_cst);
+  while (worker->sleeping &&
+         num_pending_.load(std::memory_order_seq_cst) <= 0 &&
+         !shutdown_.load(std::memory_order_seq_cst)) {
+    worker->cv.Wait(&worker->mu);
+  }
+  if (worker->sleeping) {
+    // Nobody claimed the wakeup: we saw the work (or the shutdown) ourselves
+    worker->sleeping = false;
+    num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  // Drain the callbacks before considering shutdown to ensure all work gets
+  // completed.
+  return num_pending_.load(std::memory_order_relaxed) > 0 ||
+         !shutdown_.load(std::memory_order_relaxed);
+}
+
+void WorkStealingThreadPool::ThreadFunc(Worker* worker) {
+  gpr_tls_set(&g_current_worker, reinterpret_cast<intptr_t>(worker));
+  std::function<void()> callback;
+  do {
+    while (Next(worker, &callback)) {
+      callback();
+      callback = nullptr;
+    }
+  } while (Sleep(worker));
+  gpr_tls_set(&g_current_worker, reinterpret_cast<intptr_t>(nullptr));
+}
+
+}  // namespace grpc
@@ -0,0 +1,86 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_POOL_H
+#define GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_POOL_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <grpcpp/support/config.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/cpp/server/thread_pool_interface.h"
+
+namespace grpc {
+
+// A fixed set of threads, each with its own deque of callbacks and its own
+// mutex. Add() called from one of the threads pushes to that thread's deque;
+// other callers spread callbacks over the threads round-robin. A thread runs
+// the newest callback of its own deque first and otherwise steals the oldest
+// one of another deque. Idle threads sleep on their own condition variable,
+// so neither adding work nor waking a thread takes a pool-wide lock.
+//
+// Unlike DynamicThreadPool, the number of threads never grows: callbacks that
+// block for long hold up a thread for everything queued behind them.
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+ public:
+  explicit WorkStealingThreadPool(int num_threads);
+  // Runs all the callbacks that were added before returning.
+  ~WorkStealingThreadPool();
+
+  void Add(const std::function<void()>& callback) override;
+
+ private:
+  struct Worker {
+    Worker(WorkStealingThreadPool* pool, size_t index);
+
+    WorkStealingThreadPool* const pool;
+    const size_t index;
+    uint32_t rand_state;  // Used to pick steal victims
+    grpc_core::Mutex mu;
+    grpc_core::CondVar cv;
+    std::deque<std::function<void()>> callbacks;
+    // Set, under mu, while the worker waits on cv and nobody has woken it
+    bool sleeping = false;
+    grpc_core::Thread thd;
+  };
+
+  void ThreadFunc(Worker* worker);
+  bool Next(Worker* worker, std::function<void()>* callback);
+  bool Steal(Worker* thief, std::function<void()>* callback);
+  // Parks \a worker until there may be work. Returns false on shutdown.
+  bool Sleep(Worker* worker);
+  // Wakes up one sleeping worker, if there is one.
+  void WakeOne(size_t start);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> next_worker_{0};
+  // Number of callbacks in all the deques. It is only updated after the deque
+  // itself, so it can briefly go negative.
+  std::atomic<intptr_t> num_pending_{0};
+  std::atomic<size_t> num_sleeping_{0};
+  std::atomic<bool> shutdown_{false};
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_POOL_H
@@ -20,7 +20,18 @@
 
 #include <climits>
 
+#include <grpc/support/port_platform.h>
+
+#ifdef GPR_LINUX
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#endif
+
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
@@ -40,8 +51,18 @@ ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
 }
 
 void ThreadManager::WorkerThread::Run() {
-  thd_mgr_->MainWorkLoop();
-  thd_mgr_->MarkAsCompleted(this);
+#ifdef GPR_LINUX
+  if (!thd_mgr_->cpus_.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : thd_mgr_->cpus_) CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+      gpr_log(GPR_ERROR, "sched_setaffinity: %s", strerror(errno));
+    }
+  }
+#endif
+  bool retired = thd_mgr_->MainWorkLoop();
+  thd_mgr_->MarkAsCompleted(this, retired);
 }
 
 ThreadManager::WorkerThread::~WorkerThread() {
@@ -51,13 +72,19 @@ ThreadManager::WorkerThread::~WorkerThread() {
 
 ThreadManager::ThreadManager(const char* name,
                              grpc_resource_quota* resource_quota,
-                             int min_pollers, int max_pollers)
+                             int min_pollers, int max_pollers,
+                             int target_queue_delay_usec)
     : shutdown_(false),
       num_pollers_(0),
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
       num_threads_(0),
-      max_active_threads_sofar_(0) {
+      max_active_threads_sofar_(0),
+      target_queue_delay_usec_(target_queue_delay_usec),
+      thread_target_(min_pollers),
+      num_retiring_(0),
+      queue_delay_usec_(0),
+      no_pollers_since_(gpr_inf_past(GPR_CLOCK_MONOTONIC)) {
   resource_user_ = grpc_resource_user_create(resource_quota, name);
 }
 
@@ -72,6 +99,33 @@ ThreadManager::~ThreadManager() {
   CleanupCompletedThreads();
 }
 
+void ThreadManager::SetCpuGroup(int group, int num_groups) {
+  cpus_.clear();
+#ifdef GPR_LINUX
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    gpr_log(GPR_ERROR, "Not pinning threads: sched_getaffinity: %s",
+            strerror(errno));
+    return;
+  }
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+  }
+  const int count = static_cast<int>(cpus.size());
+  if (count == 0 || num_groups < 1) return;
+  if (count < num_groups) {
+    cpus_.push_back(cpus[group % count]);
+  } else {
+    cpus_.assign(cpus.begin() + group * count / num_groups,
+                 cpus.begin() + (group + 1) * count / num_groups);
+  }
+#else
+  (void)group;
+  (void)num_groups;
+#endif
+}
+
 void ThreadManager::Wait() {
   grpc_core::MutexLock lock(&mu_);
   while (num_threads_ != 0) {
@@ -94,7 +148,7 @@ int ThreadManager::GetMaxActiveThreadsSoFar() {
   return max_active_threads_sofar_;
 }
 
-void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
+void ThreadManager::MarkAsCompleted(WorkerThread* thd, bool retired) {
   {
     grpc_core::MutexLock list_lock(&list_mu_);
     completed_threads_.push_back(thd);
@@ -103,6 +157,7 @@ void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
   {
     grpc_core::MutexLock lock(&mu_);
     num_threads_--;
+    if (retired) num_retiring_--;
     if (num_threads_ == 0) {
       shutdown_cv_.Signal();
     }
@@ -123,6 +178,27 @@ void ThreadManager::CleanupCompletedThreads() {
   for (auto thd : completed_threads) delete thd;
 }
 
+void ThreadManager::RecordQueueDelay(int64_t delay_usec) {
+  // ThreadManager threads do not otherwise have an ExecCtx, which the stats
+  // need
+  grpc_core::ExecCtx exec_ctx;
+  queue_delay_usec_ += (delay_usec - queue_delay_usec_) / 8;
+  if (delay_usec > target_queue_delay_usec_) {
+    GRPC_STATS_INC_SYNC_SERVER_QUEUE_DELAY_OVER_TARGET();
+  }
+  if (queue_delay_usec_ > target_queue_delay_usec_ &&
+      thread_target_ <= num_threads_) {
+    // Grow geometrically so that a burst does not have to wait for the
+    // threads to be added one stall at a time
+    thread_target_ = num_threads_ + GPR_MAX(1, num_threads_ / 4);
+    GRPC_STATS_INC_SYNC_SERVER_THREAD_TARGET_RAISED();
+    gpr_log(GPR_DEBUG,
+            "ThreadManager: queueing delay %" PRId64
+            "us over target, thread target raised to %d",
+            queue_delay_usec_, thread_target_);
+  }
+}
+
 void ThreadManager::Initialize() {
   if (!grpc_resource_user_allocate_threads(resource_user_, min_pollers_)) {
     gpr_log(GPR_ERROR,
@@ -146,7 +222,11 @@ void ThreadManager::Initialize() {
   }
 }
 
-void ThreadManager::MainWorkLoop() {
+bool ThreadManager::MainWorkLoop() {
+  bool retired = false;
+  // Length of the stall that this thread ended by going back to polling, for
+  // adaptive sizing
+  int64_t stall_usec = 0;
   while (true) {
     void* tag;
     bool ok;
@@ -155,12 +235,25 @@ void ThreadManager::MainWorkLoop() {
     grpc_core::ReleasableMutexLock lock(&mu_);
     // Reduce the number of pollers by 1 and check what happened with the poll
     num_pollers_--;
+    if (adaptive() && num_pollers_ == 0) {
+      no_pollers_since_ = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
     bool done = false;
     switch (work_status) {
       case TIMEOUT:
         // If we timed out and we have more pollers than we need (or we are
         // shutdown), finish this thread
         if (shutdown_ || num_pollers_ > max_pollers_) done = true;
+        stall_usec = 0;
+        // A poller that sat idle for the whole timeout suggests there are
+        // more threads than the load needs
+        if (adaptive() && queue_delay_usec_ < target_queue_delay_usec_ / 2 &&
+            thread_target_ > min_pollers_) {
+          thread_target_ =
+              GPR_MAX(min_pollers_, GPR_MIN(thread_target_, num_threads_) - 1);
+          grpc_core::ExecCtx exec_ctx;
+          GRPC_STATS_INC_SYNC_SERVER_THREAD_TARGET_LOWERED();
+        }
         break;
       case SHUTDOWN:
         // If the thread manager is shutdown, finish this thread
@@ -170,7 +263,14 @@ void ThreadManager::MainWorkLoop() {
         // If we got work and there are now insufficient pollers and there is
         // quota available to create a new thread, start a new poller thread
         bool resource_exhausted = false;
-        if (!shutdown_ && num_pollers_ < min_pollers_) {
+        if (adaptive()) {
+          RecordQueueDelay(stall_usec);
+          stall_usec = 0;
+        }
+        // With adaptive sizing, once there are thread_target_ threads the
+        // work waits for one of them to be done instead.
+        if (!shutdown_ && num_pollers_ < min_pollers_ &&
+            (!adaptive() || num_threads_ - num_retiring_ < thread_target_)) {
           if (grpc_resource_user_allocate_threads(resource_user_, 1)) {
             // We can allocate a new poller thread
             num_pollers_++;
@@ -245,11 +345,20 @@ void ThreadManager::MainWorkLoop() {
     // pollset mutex) that makes DoWork() take longer to finish thereby causing
     // new poller threads to be created even faster. This results in a thread
     // avalanche.
-    if (num_pollers_ < max_pollers_) {
-      num_pollers_++;
-    } else {
-      break;
+    if (num_pollers_ >= max_pollers_) break;
+    if (adaptive()) {
+      // Let threads above the target go, as long as another one is polling
+      if (num_threads_ - num_retiring_ > thread_target_ && num_pollers_ > 0) {
+        num_retiring_++;
+        retired = true;
+        break;
+      }
+      if (num_pollers_ == 0) {
+        stall_usec = static_cast<int64_t>(gpr_timespec_to_micros(gpr_time_sub(
+            gpr_now(GPR_CLOCK_MONOTONIC), no_pollers_since_)));
+      }
     }
+    num_pollers_++;
   };
 
   // This thread is exiting. Do some cleanup work i.e delete already completed
@@ -258,6 +367,7 @@ void ThreadManager::MainWorkLoop() {
 
   // If we are here, either ThreadManager is shutting down or it already has
   // enough threads.
+  return retired;
 }
 
 }  // namespace grpc
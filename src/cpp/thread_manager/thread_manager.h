@@ -21,6 +21,7 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 
 #include <grpcpp/support/config.h>
 
@@ -32,13 +33,22 @@ namespace grpc {
 
 class ThreadManager {
  public:
+  // If target_queue_delay_usec is positive, the number of threads adapts to
+  // how long work waits to be picked up: see RecordQueueDelay().
   explicit ThreadManager(const char* name, grpc_resource_quota* resource_quota,
-                         int min_pollers, int max_pollers);
+                         int min_pollers, int max_pollers,
+                         int target_queue_delay_usec = 0);
   virtual ~ThreadManager();
 
   // Initializes and Starts the Rpc Manager threads
   void Initialize();
 
+  // Pins every thread of this ThreadManager to group 'group' of the CPUs this
+  // process may run on, split into 'num_groups' contiguous groups (groups
+  // share CPUs if there are fewer CPUs than groups). Must be called before
+  // Initialize(). Has no effect on platforms without thread affinity.
+  void SetCpuGroup(int group, int num_groups);
+
   // The return type of PollForWork() function
   enum WorkStatus { WORK_FOUND, SHUTDOWN, TIMEOUT };
 
@@ -135,14 +145,26 @@ class ThreadManager {
     bool created_;
   };
 
-  // The main function in ThreadManager
-  void MainWorkLoop();
+  // The main function in ThreadManager. Returns true if the thread is exiting
+  // because there are more threads than thread_target_.
+  bool MainWorkLoop();
 
-  void MarkAsCompleted(WorkerThread* thd);
+  void MarkAsCompleted(WorkerThread* thd, bool retired);
   void CleanupCompletedThreads();
 
-  // Protects shutdown_, num_pollers_, num_threads_ and
-  // max_active_threads_sofar_
+  bool adaptive() const { return target_queue_delay_usec_ > 0; }
+  // Adaptive sizing. Work waits in the queue whenever no thread is polling
+  // it, so when a thread goes back to polling after such a stall and finds
+  // work, the length of the stall is taken as that work's queueing delay (and
+  // the delay is zero for work found without a stall). thread_target_ is
+  // raised when the moving average of the delay exceeds the target, and
+  // lowered when a poller times out while the average is well below it.
+  // New threads are only created below thread_target_, and threads above it
+  // exit instead of polling again. Requires mu_.
+  void RecordQueueDelay(int64_t delay_usec);
+
+  // Protects shutdown_, num_pollers_, num_threads_,
+  // max_active_threads_sofar_ and the adaptive sizing state
   grpc_core::Mutex mu_;
 
   bool shutdown_;
@@ -172,6 +194,19 @@ class ThreadManager {
   // ever set so far
   int max_active_threads_sofar_;
 
+  // Adaptive sizing state: see RecordQueueDelay()
+  const int64_t target_queue_delay_usec_;
+  int thread_target_;
+  // Threads that are exiting because of thread_target_, but are still counted
+  // in num_threads_
+  int num_retiring_;
+  int64_t queue_delay_usec_;
+  gpr_timespec no_pollers_since_;
+
+  // The CPUs the threads are pinned to, or empty if they are not pinned. Set
+  // before any thread starts.
+  std::vector<int> cpus_;
+
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
 };
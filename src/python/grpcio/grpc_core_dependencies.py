@@ -36,6 +36,10 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+    'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
+    'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/xds.cc',
     'src/core/ext/filters/client_channel/lb_policy_registry.cc',
@@ -74,6 +78,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/xds/xds_client_stats.cc',
     'src/core/ext/filters/client_idle/client_idle_filter.cc',
     'src/core/ext/filters/deadline/deadline_filter.cc',
+    'src/core/ext/filters/deadline/deadline_wheel.cc',
     'src/core/ext/filters/http/client/http_client_filter.cc',
     'src/core/ext/filters/http/client_authority_filter.cc',
     'src/core/ext/filters/http/http_filters_plugin.cc',
@@ -111,6 +116,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/http2_settings.cc',
     'src/core/ext/transport/chttp2/transport/huffsyms.cc',
     'src/core/ext/transport/chttp2/transport/incoming_metadata.cc',
+    'src/core/ext/transport/chttp2/transport/keepalive_scheduler.cc',
     'src/core/ext/transport/chttp2/transport/parsing.cc',
     'src/core/ext/transport/chttp2/transport/stream_lists.cc',
     'src/core/ext/transport/chttp2/transport/stream_map.cc',
@@ -118,6 +124,11 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/writing.cc',
     'src/core/ext/transport/inproc/inproc_plugin.cc',
     'src/core/ext/transport/inproc/inproc_transport.cc',
+    'src/core/ext/transport/shm/shm_endpoint.cc',
+    'src/core/ext/transport/shm/shm_handshaker.cc',
+    'src/core/ext/transport/shm/shm_plugin.cc',
+    'src/core/ext/transport/shm/shm_resolver.cc',
+    'src/core/ext/transport/shm/shm_ring.cc',
     'src/core/ext/upb-generated/envoy/api/v2/auth/cert.upb.c',
     'src/core/ext/upb-generated/envoy/api/v2/cds.upb.c',
     'src/core/ext/upb-generated/envoy/api/v2/cluster/circuit_breaker.upb.c',
@@ -159,6 +170,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/upb-generated/validate/validate.upb.c',
     'src/core/lib/avl/avl.cc',
     'src/core/lib/backoff/backoff.cc',
+    'src/core/lib/channel/call_timeline.cc',
     'src/core/lib/channel/channel_args.cc',
     'src/core/lib/channel/channel_stack.cc',
     'src/core/lib/channel/channel_stack_builder.cc',
@@ -190,6 +202,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gpr/env_windows.cc',
     'src/core/lib/gpr/log.cc',
     'src/core/lib/gpr/log_android.cc',
+    'src/core/lib/gpr/log_async.cc',
     'src/core/lib/gpr/log_linux.cc',
     'src/core/lib/gpr/log_posix.cc',
     'src/core/lib/gpr/log_windows.cc',
@@ -241,6 +254,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/executor.cc',
     'src/core/lib/iomgr/executor/mpmcqueue.cc',
     'src/core/lib/iomgr/executor/threadpool.cc',
+    'src/core/lib/iomgr/executor/work_stealing.cc',
     'src/core/lib/iomgr/fork_posix.cc',
     'src/core/lib/iomgr/fork_windows.cc',
     'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -305,6 +319,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/timer_heap.cc',
     'src/core/lib/iomgr/timer_manager.cc',
     'src/core/lib/iomgr/timer_uv.cc',
+    'src/core/lib/iomgr/timer_wheel.cc',
     'src/core/lib/iomgr/udp_server.cc',
     'src/core/lib/iomgr/unix_sockets_posix.cc',
     'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -317,6 +332,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/json/json_string.cc',
     'src/core/lib/json/json_writer.cc',
     'src/core/lib/profiling/basic_timers.cc',
+    'src/core/lib/profiling/ring_timers.cc',
     'src/core/lib/profiling/stap_timers.cc',
     'src/core/lib/security/context/security_context.cc',
     'src/core/lib/security/credentials/alts/alts_credentials.cc',
@@ -68,6 +68,15 @@ extern grpc_compression_options_disable_algorithm_type grpc_compression_options_
 typedef int(*grpc_compression_options_is_algorithm_enabled_type)(const grpc_compression_options* opts, grpc_compression_algorithm algorithm);
 extern grpc_compression_options_is_algorithm_enabled_type grpc_compression_options_is_algorithm_enabled_import;
 #define grpc_compression_options_is_algorithm_enabled grpc_compression_options_is_algorithm_enabled_import
+typedef grpc_compression_dictionaries*(*grpc_compression_dictionaries_create_type)(const grpc_slice* dictionaries, size_t count);
+extern grpc_compression_dictionaries_create_type grpc_compression_dictionaries_create_import;
+#define grpc_compression_dictionaries_create grpc_compression_dictionaries_create_import
+typedef void(*grpc_compression_dictionaries_unref_type)(grpc_compression_dictionaries* dictionaries);
+extern grpc_compression_dictionaries_unref_type grpc_compression_dictionaries_unref_import;
+#define grpc_compression_dictionaries_unref grpc_compression_dictionaries_unref_import
+typedef const grpc_arg_pointer_vtable*(*grpc_compression_dictionaries_arg_vtable_type)(void);
+extern grpc_compression_dictionaries_arg_vtable_type grpc_compression_dictionaries_arg_vtable_import;
+#define grpc_compression_dictionaries_arg_vtable grpc_compression_dictionaries_arg_vtable_import
 typedef void(*grpc_metadata_array_init_type)(grpc_metadata_array* array);
 extern grpc_metadata_array_init_type grpc_metadata_array_init_import;
 #define grpc_metadata_array_init grpc_metadata_array_init_import
@@ -119,6 +128,9 @@ extern grpc_completion_queue_create_type grpc_completion_queue_create_import;
 typedef grpc_event(*grpc_completion_queue_next_type)(grpc_completion_queue* cq, gpr_timespec deadline, void* reserved);
 extern grpc_completion_queue_next_type grpc_completion_queue_next_import;
 #define grpc_completion_queue_next grpc_completion_queue_next_import
+typedef int(*grpc_completion_queue_next_batch_type)(grpc_completion_queue* cq, grpc_event* events, int max_events, gpr_timespec deadline, void* reserved);
+extern grpc_completion_queue_next_batch_type grpc_completion_queue_next_batch_import;
+#define grpc_completion_queue_next_batch grpc_completion_queue_next_batch_import
 typedef grpc_event(*grpc_completion_queue_pluck_type)(grpc_completion_queue* cq, void* tag, gpr_timespec deadline, void* reserved);
 extern grpc_completion_queue_pluck_type grpc_completion_queue_pluck_import;
 #define grpc_completion_queue_pluck grpc_completion_queue_pluck_import
@@ -0,0 +1,165 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/channel/call_timeline.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/support/time.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Stands in for a call: its arena and context.
+class FakeCall {
+ public:
+  FakeCall() : arena_(Arena::Create(1024)) {}
+
+  ~FakeCall() {
+    for (size_t i = 0; i < GRPC_CONTEXT_COUNT; i++) {
+      if (context_[i].destroy != nullptr) {
+        context_[i].destroy(context_[i].value);
+      }
+    }
+    arena_->Destroy();
+  }
+
+  bool Start(bool is_client) {
+    return CallTimeline::MaybeStart(arena_, context_, is_client);
+  }
+
+  grpc_call_context_element* context() { return context_; }
+
+ private:
+  Arena* arena_;
+  grpc_call_context_element context_[GRPC_CONTEXT_COUNT];
+};
+
+// Returns a cursor past all the records published so far.
+uint64_t CursorAtEnd() {
+  uint64_t cursor = 0;
+  CallTimelineRecord records[64];
+  while (CollectCallTimelines(&cursor, records, 64) == 64) {
+  }
+  return cursor;
+}
+
+class CallTimelineTest : public ::testing::Test {
+ protected:
+  void TearDown() override { CallTimeline::SetSampling(0); }
+};
+
+TEST_F(CallTimelineTest, OffByDefault) {
+  FakeCall call;
+  EXPECT_FALSE(call.Start(true));
+  EXPECT_EQ(call.context()[GRPC_CONTEXT_CALL_TIMELINE].value, nullptr);
+  EXPECT_EQ(call.context()[GRPC_CONTEXT_WRITE_TIMESTAMPS].value, nullptr);
+  CallTimeline::Mark(call.context(), CallTimeline::kPickComplete);
+}
+
+TEST_F(CallTimelineTest, RecordsStages) {
+  CallTimeline::SetSampling(1);
+  uint64_t cursor = CursorAtEnd();
+  {
+    FakeCall call;
+    ASSERT_TRUE(call.Start(true));
+    // Sampled calls trace their writes.
+    EXPECT_NE(call.context()[GRPC_CONTEXT_WRITE_TIMESTAMPS].value, nullptr);
+    CallTimeline::Mark(call.context(), CallTimeline::kPickComplete);
+    CallTimeline::Mark(call.context(), CallTimeline::kStreamStarted);
+    CallTimeline::Mark(call.context(), CallTimeline::kCompletionDelivered);
+  }
+  CallTimelineRecord records[4];
+  ASSERT_EQ(CollectCallTimelines(&cursor, records, 4), 1u);
+  const int64_t* stage_ns = records[0].stage_ns;
+  EXPECT_TRUE(records[0].is_client);
+  EXPECT_GT(stage_ns[CallTimeline::kCreated], 0);
+  EXPECT_GE(stage_ns[CallTimeline::kPickComplete],
+            stage_ns[CallTimeline::kCreated]);
+  EXPECT_GE(stage_ns[CallTimeline::kStreamStarted],
+            stage_ns[CallTimeline::kPickComplete]);
+  EXPECT_EQ(stage_ns[CallTimeline::kFirstByteWritten], 0);
+  EXPECT_EQ(stage_ns[CallTimeline::kInitialMetadataReceived], 0);
+  EXPECT_EQ(stage_ns[CallTimeline::kFirstMessageReceived], 0);
+  EXPECT_GE(stage_ns[CallTimeline::kCompletionDelivered],
+            stage_ns[CallTimeline::kStreamStarted]);
+  EXPECT_EQ(CollectCallTimelines(&cursor, records, 4), 0u);
+}
+
+TEST_F(CallTimelineTest, FirstMarkWins) {
+  CallTimeline::SetSampling(1);
+  uint64_t cursor = CursorAtEnd();
+  int64_t between;
+  {
+    FakeCall call;
+    ASSERT_TRUE(call.Start(false));
+    CallTimeline::Mark(call.context(), CallTimeline::kFirstMessageReceived);
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(2));
+    gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+    between = static_cast<int64_t>(now.tv_sec) * GPR_NS_PER_SEC + now.tv_nsec;
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(2));
+    CallTimeline::Mark(call.context(), CallTimeline::kFirstMessageReceived);
+  }
+  CallTimelineRecord record;
+  ASSERT_EQ(CollectCallTimelines(&cursor, &record, 1), 1u);
+  EXPECT_FALSE(record.is_client);
+  EXPECT_GT(record.stage_ns[CallTimeline::kFirstMessageReceived], 0);
+  EXPECT_LT(record.stage_ns[CallTimeline::kFirstMessageReceived], between);
+}
+
+TEST_F(CallTimelineTest, SamplesOneInN) {
+  CallTimeline::SetSampling(4);
+  int sampled = 0;
+  for (int i = 0; i < 64; i++) {
+    FakeCall call;
+    if (call.Start(true)) sampled++;
+  }
+  EXPECT_EQ(sampled, 16);
+}
+
+TEST_F(CallTimelineTest, KeepsTheMostRecentRecords) {
+  CallTimeline::SetSampling(1);
+  uint64_t cursor = CursorAtEnd();
+  const size_t kCalls = 3000;
+  for (size_t i = 0; i < kCalls; i++) {
+    FakeCall call;
+    ASSERT_TRUE(call.Start(true));
+  }
+  std::vector<CallTimelineRecord> records(kCalls);
+  size_t count = CollectCallTimelines(&cursor, records.data(), kCalls);
+  EXPECT_EQ(count, 1024u);
+  EXPECT_EQ(cursor, records[count - 1].index + 1);
+  for (size_t i = 1; i < count; i++) {
+    EXPECT_EQ(records[i].index, records[i - 1].index + 1);
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,6 +19,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <set>
+#include <thread>
+
 #include <grpc/grpc.h>
 #include <gtest/gtest.h>
 
@@ -141,6 +144,33 @@ TEST_F(ChannelzRegistryTest, TestUnregistration) {
   }
 }
 
+TEST_F(ChannelzRegistryTest, ConcurrentRegistration) {
+  const int kNumThreads = 8;
+  const int kNodesPerThread = 100;
+  std::vector<std::vector<RefCountedPtr<BaseNode>>> nodes(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&nodes, t]() {
+      for (int i = 0; i < kNodesPerThread; ++i) {
+        nodes[t].push_back(CreateTestNode());
+        // Churn: a node per iteration goes away again right away.
+        CreateTestNode();
+      }
+    });
+  }
+  for (auto& thd : threads) thd.join();
+  std::set<intptr_t> uuids;
+  for (int t = 0; t < kNumThreads; ++t) {
+    for (int i = 0; i < kNodesPerThread; ++i) {
+      EXPECT_TRUE(uuids.insert(nodes[t][i]->uuid()).second)
+          << "Uuids must be unique";
+      RefCountedPtr<BaseNode> retrieved =
+          ChannelzRegistry::Get(nodes[t][i]->uuid());
+      EXPECT_EQ(nodes[t][i], retrieved);
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
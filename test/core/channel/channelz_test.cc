@@ -51,8 +51,22 @@ class CallCountingHelperPeer {
   grpc_millis last_call_started_millis() const {
     CallCountingHelper::CounterData data;
     node_->CollectData(&data);
-    gpr_timespec ts = gpr_cycle_counter_to_time(data.last_call_started_cycle);
-    return grpc_timespec_to_millis_round_up(ts);
+    return data.last_call_started_millis;
+  }
+  int64_t calls_started() const {
+    CallCountingHelper::CounterData data;
+    node_->CollectData(&data);
+    return data.calls_started;
+  }
+  int64_t calls_failed() const {
+    CallCountingHelper::CounterData data;
+    node_->CollectData(&data);
+    return data.calls_failed;
+  }
+  int64_t calls_succeeded() const {
+    CallCountingHelper::CounterData data;
+    node_->CollectData(&data);
+    return data.calls_succeeded;
   }
 
  private:
@@ -314,6 +328,29 @@ TEST_P(ChannelzChannelTest, LastCallStartedMillis) {
   EXPECT_NE(millis1, millis4);
 }
 
+TEST(ChannelzCallCountingTest, SampledCounts) {
+  grpc_core::ExecCtx exec_ctx;
+  CallCountingHelper counter(4);
+  int sampled = 0;
+  for (int i = 0; i < 8; i++) {
+    if (counter.RecordCallStarted()) {
+      sampled++;
+      if (sampled == 1) {
+        counter.RecordCallFailed();
+      } else {
+        counter.RecordCallSucceeded();
+      }
+    }
+  }
+  // The counts of the sampled calls are scaled back up.
+  EXPECT_EQ(sampled, 2);
+  CallCountingHelperPeer peer(&counter);
+  EXPECT_EQ(peer.calls_started(), 8);
+  EXPECT_EQ(peer.calls_failed(), 4);
+  EXPECT_EQ(peer.calls_succeeded(), 4);
+  EXPECT_NE(peer.last_call_started_millis(), 0);
+}
+
 class ChannelzRegistryBasedTest : public ::testing::TestWithParam<size_t> {
  protected:
   // ensure we always have a fresh registry for tests.
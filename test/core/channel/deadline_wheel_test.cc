@@ -0,0 +1,157 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/deadline/deadline_wheel.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "test/core/util/test_config.h"
+
+#define LOG_TEST(x) gpr_log(GPR_INFO, "%s", x)
+
+typedef struct {
+  grpc_core::DeadlineWheel::Entry entry;
+  grpc_timer timer;
+  gpr_event done;
+  grpc_error* error;
+  grpc_closure on_deadline;
+} deadline_state;
+
+static void on_deadline(void* arg, grpc_error* error) {
+  deadline_state* state = static_cast<deadline_state*>(arg);
+  state->error = GRPC_ERROR_REF(error);
+  gpr_event_set(&state->done, (void*)1);
+}
+
+static void start(deadline_state* state, grpc_millis timeout) {
+  grpc_core::ExecCtx exec_ctx;
+  gpr_event_init(&state->done);
+  state->error = GRPC_ERROR_NONE;
+  GRPC_CLOSURE_INIT(&state->on_deadline, on_deadline, state,
+                    grpc_schedule_on_exec_ctx);
+  grpc_core::DeadlineWheel::Start(&state->entry, &state->timer,
+                                  grpc_core::ExecCtx::Get()->Now() + timeout,
+                                  0, &state->on_deadline);
+}
+
+static void cancel(deadline_state* state) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::DeadlineWheel::Cancel(&state->entry);
+}
+
+static bool wait_done(deadline_state* state, int timeout_ms) {
+  return gpr_event_wait(&state->done,
+                        grpc_timeout_milliseconds_to_deadline(timeout_ms)) !=
+         nullptr;
+}
+
+static int64_t millis_since(gpr_timespec start) {
+  return gpr_time_to_millis(
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start));
+}
+
+/* deadlines too close to park get a timer right away */
+static void test_near_deadline(void) {
+  deadline_state state;
+
+  LOG_TEST("test_near_deadline");
+
+  gpr_timespec start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  start(&state, 100);
+  GPR_ASSERT(wait_done(&state, 5000));
+  GPR_ASSERT(state.error == GRPC_ERROR_NONE);
+  GPR_ASSERT(millis_since(start_time) >= 90);
+}
+
+/* a parked deadline still fires at its deadline, not at its bucket's */
+static void test_far_deadline(void) {
+  deadline_state state;
+
+  LOG_TEST("test_far_deadline");
+
+  gpr_timespec start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  start(&state, 2500);
+  GPR_ASSERT(wait_done(&state, 10000));
+  GPR_ASSERT(state.error == GRPC_ERROR_NONE);
+  int64_t elapsed = millis_since(start_time);
+  GPR_ASSERT(elapsed >= 2490);
+  GPR_ASSERT(elapsed < 3500);
+}
+
+/* cancelling a parked deadline runs its closure right away with an error, and
+   leaves other parked deadlines alone */
+static void test_cancel_parked(void) {
+  deadline_state state1;
+  deadline_state state2;
+
+  LOG_TEST("test_cancel_parked");
+
+  start(&state1, 2500);
+  start(&state2, 2500);
+  cancel(&state1);
+  GPR_ASSERT(wait_done(&state1, 100));
+  GPR_ASSERT(state1.error == GRPC_ERROR_CANCELLED);
+  GPR_ASSERT(!wait_done(&state2, 1000));
+  GPR_ASSERT(wait_done(&state2, 10000));
+  GPR_ASSERT(state2.error == GRPC_ERROR_NONE);
+  /* cancelling a deadline that already fired is a no-op */
+  cancel(&state2);
+}
+
+/* once its bucket has fired, a deadline can still be cancelled */
+static void test_cancel_after_bucket(void) {
+  deadline_state state;
+
+  LOG_TEST("test_cancel_after_bucket");
+
+  start(&state, 3000);
+  GPR_ASSERT(!wait_done(&state, 2400));
+  cancel(&state);
+  GPR_ASSERT(wait_done(&state, 100));
+  GPR_ASSERT(state.error == GRPC_ERROR_CANCELLED);
+}
+
+/* an entry may be started again after it was cancelled */
+static void test_restart(void) {
+  deadline_state state;
+
+  LOG_TEST("test_restart");
+
+  start(&state, 2500);
+  cancel(&state);
+  GPR_ASSERT(wait_done(&state, 100));
+  GPR_ASSERT(state.error == GRPC_ERROR_CANCELLED);
+  start(&state, 200);
+  GPR_ASSERT(wait_done(&state, 5000));
+  GPR_ASSERT(state.error == GRPC_ERROR_NONE);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  test_near_deadline();
+  test_far_deadline();
+  test_cancel_parked();
+  test_cancel_after_bucket();
+  test_restart();
+  grpc_shutdown();
+  return 0;
+}
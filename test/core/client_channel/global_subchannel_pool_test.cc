@@ -0,0 +1,169 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Subchannels in these tests never connect.
+class NoOpConnector : public SubchannelConnector {
+ public:
+  void Connect(const Args& /*args*/, Result* /*result*/,
+               grpc_closure* /*notify*/) override {}
+
+  void Shutdown(grpc_error* error) override { GRPC_ERROR_UNREF(error); }
+};
+
+// Channel args for a subchannel to a distinct address per index, in the
+// global pool.
+class SubchannelArgs {
+ public:
+  explicit SubchannelArgs(int index)
+      : address_("ipv4:127.0.0.1:" + std::to_string(10000 + index)) {
+    grpc_arg args[] = {
+        grpc_channel_arg_string_create(
+            const_cast<char*>(GRPC_ARG_SUBCHANNEL_ADDRESS),
+            const_cast<char*>(address_.c_str())),
+        SubchannelPoolInterface::CreateChannelArg(
+            GlobalSubchannelPool::instance().get()),
+    };
+    args_ = grpc_channel_args_copy_and_add(nullptr, args, GPR_ARRAY_SIZE(args));
+  }
+  ~SubchannelArgs() { grpc_channel_args_destroy(args_); }
+
+  const grpc_channel_args* args() const { return args_; }
+  const std::string& address() const { return address_; }
+
+ private:
+  std::string address_;
+  grpc_channel_args* args_;
+};
+
+class GlobalSubchannelPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override { grpc_init(); }
+  void TearDown() override { grpc_shutdown_blocking(); }
+};
+
+TEST_F(GlobalSubchannelPoolTest, RegisterFindUnregister) {
+  ExecCtx exec_ctx;
+  SubchannelArgs args(0);
+  SubchannelKey key(args.args());
+  RefCountedPtr<GlobalSubchannelPool> pool = GlobalSubchannelPool::instance();
+  EXPECT_EQ(nullptr, pool->FindSubchannel(&key));
+  Subchannel* c = Subchannel::Create(MakeOrphanable<NoOpConnector>(),
+                                     args.args());
+  ASSERT_NE(nullptr, c);
+  Subchannel* found = pool->FindSubchannel(&key);
+  EXPECT_EQ(c, found);
+  GRPC_SUBCHANNEL_UNREF(found, "test");
+  // Creating a subchannel with the same args reuses the registered one.
+  Subchannel* reused = Subchannel::Create(MakeOrphanable<NoOpConnector>(),
+                                          args.args());
+  EXPECT_EQ(c, reused);
+  GRPC_SUBCHANNEL_UNREF(reused, "test");
+  // Dropping the last strong ref unregisters it.
+  GRPC_SUBCHANNEL_UNREF(c, "test");
+  EXPECT_EQ(nullptr, pool->FindSubchannel(&key));
+}
+
+// Threads create, find and drop subchannels for overlapping sets of
+// addresses, so that lookups without the shard locks race with
+// registrations, unregistrations and the shards growing. Every subchannel
+// found must be a live one for the address looked up; freeing an entry or a
+// bucket array a lookup may still be reading would fail here under a
+// sanitizer.
+TEST_F(GlobalSubchannelPoolTest, ConcurrentRegisterUnregisterFind) {
+  // Enough live subchannels that every shard grows more than once.
+  const int kAddresses = 1024;
+  const int kThreads = 8;
+  const int kHeldPerThread = 96;
+  const int kIterations = 5000;
+  std::vector<std::unique_ptr<SubchannelArgs>> args;
+  std::vector<std::unique_ptr<SubchannelKey>> keys;
+  for (int i = 0; i < kAddresses; i++) {
+    args.emplace_back(new SubchannelArgs(i));
+    keys.emplace_back(new SubchannelKey(args.back()->args()));
+  }
+  RefCountedPtr<GlobalSubchannelPool> pool = GlobalSubchannelPool::instance();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      ExecCtx exec_ctx;
+      // A ring of the subchannels this thread keeps alive for a while.
+      std::vector<Subchannel*> held(kHeldPerThread, nullptr);
+      uint32_t x = t + 1;
+      for (int i = 0; i < kIterations; i++) {
+        x = x * 1103515245 + 12345;
+        const int index = (x >> 8) % kAddresses;
+        Subchannel*& slot = held[i % kHeldPerThread];
+        if (slot != nullptr) {
+          GRPC_SUBCHANNEL_UNREF(slot, "test");
+          slot = nullptr;
+        }
+        if (i % 2 == 0) {
+          slot = Subchannel::Create(MakeOrphanable<NoOpConnector>(),
+                                    args[index]->args());
+          ASSERT_NE(nullptr, slot);
+        } else {
+          slot = pool->FindSubchannel(keys[index].get());
+        }
+        if (slot != nullptr) {
+          EXPECT_STREQ(args[index]->address().c_str(),
+                       slot->GetTargetAddress());
+        }
+        exec_ctx.Flush();
+      }
+      for (Subchannel* c : held) {
+        if (c != nullptr) GRPC_SUBCHANNEL_UNREF(c, "test");
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ExecCtx exec_ctx;
+  for (int i = 0; i < kAddresses; i++) {
+    EXPECT_EQ(nullptr, pool->FindSubchannel(keys[i].get()));
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
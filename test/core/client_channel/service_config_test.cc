@@ -207,6 +207,39 @@ TEST_F(ServiceConfigTest, ValidMethodConfig) {
   EXPECT_TRUE(error == GRPC_ERROR_NONE);
 }
 
+TEST_F(ServiceConfigTest, SameJsonSharesConfig) {
+  const char* test_json =
+      "{\"methodConfig\": [{\"name\":[{\"service\":\"TestServ\"}]}]}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg1 = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  auto svc_cfg2 = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  EXPECT_EQ(svc_cfg1.get(), svc_cfg2.get());
+  auto svc_cfg3 = ServiceConfig::Create("{}", &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  EXPECT_NE(svc_cfg1.get(), svc_cfg3.get());
+  // Once no config of that json is left, it is parsed again.
+  svc_cfg1.reset();
+  svc_cfg2.reset();
+  auto svc_cfg4 = ServiceConfig::Create(test_json, &error);
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  EXPECT_STREQ(svc_cfg4->service_config_json(), test_json);
+}
+
+TEST_F(ServiceConfigTest, ErroredConfigNotShared) {
+  const char* test_json = "{\"methodConfig\": [{\"blah\":1}]}";
+  grpc_error* error1 = GRPC_ERROR_NONE;
+  auto svc_cfg1 = ServiceConfig::Create(test_json, &error1);
+  ASSERT_TRUE(error1 != GRPC_ERROR_NONE);
+  grpc_error* error2 = GRPC_ERROR_NONE;
+  auto svc_cfg2 = ServiceConfig::Create(test_json, &error2);
+  ASSERT_TRUE(error2 != GRPC_ERROR_NONE);
+  EXPECT_NE(svc_cfg1.get(), svc_cfg2.get());
+  GRPC_ERROR_UNREF(error1);
+  GRPC_ERROR_UNREF(error2);
+}
+
 TEST_F(ServiceConfigTest, Parser1BasicTest1) {
   const char* test_json = "{\"global_param\":5}";
   grpc_error* error = GRPC_ERROR_NONE;
@@ -876,6 +909,98 @@ TEST_F(ClientChannelParserTest, InvalidRetryPolicyRetryableStatusCodes) {
   VerifyRegexMatch(error, e);
 }
 
+TEST_F(ClientChannelParserTest, ValidHedgingPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\",\n"
+      "      \"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ]\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error == GRPC_ERROR_NONE);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  EXPECT_TRUE(vector_ptr != nullptr);
+  const auto* parsed_config =
+      static_cast<grpc_core::internal::ClientChannelMethodParsedConfig*>(
+          ((*vector_ptr)[0]).get());
+  EXPECT_TRUE(parsed_config->retry_policy() != nullptr);
+  EXPECT_TRUE(parsed_config->retry_policy()->hedging);
+  EXPECT_EQ(parsed_config->retry_policy()->max_attempts, 3);
+  EXPECT_EQ(parsed_config->retry_policy()->hedging_delay, 500);
+  EXPECT_TRUE(parsed_config->retry_policy()->retryable_status_codes.Contains(
+      GRPC_STATUS_UNAVAILABLE));
+}
+
+TEST_F(ClientChannelParserTest, InvalidHedgingPolicyMaxAttempts) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 1,\n"
+      "      \"hedgingDelay\": \"0.5s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(std::string(
+      "(Service config parsing "
+      "error)(.*)(referenced_errors)(.*)(Method "
+      "Params)(.*)(referenced_errors)(.*)(methodConfig)(.*)(referenced_errors)("
+      ".*)(Client channel "
+      "parser)(.*)(referenced_errors)(.*)(hedgingPolicy)(.*)(referenced_errors)"
+      "(.*)(field:maxAttempts error:should be at least 2)"));
+  VerifyRegexMatch(error, e);
+}
+
+TEST_F(ClientChannelParserTest, InvalidRetryPolicyAndHedgingPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"retryPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"initialBackoff\": \"1s\",\n"
+      "      \"maxBackoff\": \"120s\",\n"
+      "      \"backoffMultiplier\": 1.6,\n"
+      "      \"retryableStatusCodes\": [ \"ABORTED\" ]\n"
+      "    },\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error* error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(test_json, &error);
+  gpr_log(GPR_ERROR, "%s", grpc_error_string(error));
+  ASSERT_TRUE(error != GRPC_ERROR_NONE);
+  std::regex e(std::string(
+      "(Service config parsing "
+      "error)(.*)(referenced_errors)(.*)(Method "
+      "Params)(.*)(referenced_errors)(.*)(methodConfig)(.*)(referenced_errors)("
+      ".*)(Client channel "
+      "parser)(.*)(referenced_errors)(.*)(field:hedgingPolicy error:Cannot be "
+      "combined with retryPolicy)"));
+  VerifyRegexMatch(error, e);
+}
+
 TEST_F(ClientChannelParserTest, ValidHealthCheck) {
   const char* test_json =
       "{\n"
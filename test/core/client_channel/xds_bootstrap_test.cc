@@ -46,6 +46,7 @@ TEST(XdsBootstrapTest, Basic) {
       "        \"ignore\": 0"
       "      }"
       "    ],"
+      "    \"incremental_xds\": true,"
       "    \"ignore\": 0"
       "  },"
       "  \"node\": {"
@@ -79,6 +80,7 @@ TEST(XdsBootstrapTest, Basic) {
   ASSERT_EQ(bootstrap.channel_creds().size(), 1);
   EXPECT_STREQ(bootstrap.channel_creds()[0].type, "fake");
   EXPECT_EQ(bootstrap.channel_creds()[0].config, nullptr);
+  EXPECT_TRUE(bootstrap.incremental_xds());
   ASSERT_NE(bootstrap.node(), nullptr);
   EXPECT_STREQ(bootstrap.node()->id, "foo");
   EXPECT_STREQ(bootstrap.node()->cluster, "bar");
@@ -162,6 +164,7 @@ TEST(XdsBootstrapTest, ValidWithoutChannelCredsAndNode) {
   EXPECT_EQ(error, GRPC_ERROR_NONE);
   EXPECT_STREQ(bootstrap.server_uri(), "fake:///lb");
   EXPECT_EQ(bootstrap.channel_creds().size(), 0);
+  EXPECT_FALSE(bootstrap.incremental_xds());
   EXPECT_EQ(bootstrap.node(), nullptr);
 }
 
@@ -220,7 +223,9 @@ TEST(XdsBootstrapTest, BadXdsServerContents) {
       "    \"server_uri\":1,"
       "    \"server_uri\":\"foo\","
       "    \"channel_creds\":1,"
-      "    \"channel_creds\":{}"
+      "    \"channel_creds\":{},"
+      "    \"incremental_xds\":1,"
+      "    \"incremental_xds\":false"
       "  }"
       "}");
   grpc_error* error = GRPC_ERROR_NONE;
@@ -233,7 +238,9 @@ TEST(XdsBootstrapTest, BadXdsServerContents) {
                   "duplicate \"server_uri\" field(.*)"
                   "\"channel_creds\" field is not an array(.*)"
                   "\"channel_creds\" field is not an array(.*)"
-                  "duplicate \"channel_creds\" field(.*)"));
+                  "duplicate \"channel_creds\" field(.*)"
+                  "\"incremental_xds\" field is not a boolean(.*)"
+                  "duplicate \"incremental_xds\" field"));
   VerifyRegexMatch(error, e);
 }
 
@@ -166,6 +166,221 @@ static void test_tiny_data_compress(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+static void test_zlib_levels(void) {
+  grpc_slice_buffer input;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_add(&input, create_test_value(ONE_MB_A));
+  grpc_slice expected = grpc_slice_merge(input.slices, input.count);
+
+  grpc_core::ExecCtx exec_ctx;
+  const grpc_message_compression_algorithm algorithms[] = {
+      GRPC_MESSAGE_COMPRESS_DEFLATE, GRPC_MESSAGE_COMPRESS_GZIP};
+  for (auto algorithm : algorithms) {
+    /* level 42 is invalid, and falls back to the default */
+    for (int level = -1; level <= 10; level++) {
+      const int zlib_level = level == 10 ? 42 : level;
+      /* twice, so that the second round reuses the streams of the first */
+      for (int round = 0; round < 2; round++) {
+        grpc_slice_buffer compressed;
+        grpc_slice_buffer output;
+        grpc_slice_buffer_init(&compressed);
+        grpc_slice_buffer_init(&output);
+        const int did_compress = grpc_msg_compress_with_level(
+            algorithm, zlib_level, &input, &compressed);
+        if (zlib_level == 0) {
+          /* stored blocks never get smaller than the input */
+          GPR_ASSERT(!did_compress);
+        } else {
+          GPR_ASSERT(did_compress);
+          GPR_ASSERT(grpc_msg_decompress(algorithm, &compressed, &output));
+          grpc_slice final = grpc_slice_merge(output.slices, output.count);
+          GPR_ASSERT(grpc_slice_eq(expected, final));
+          grpc_slice_unref(final);
+        }
+        grpc_slice_buffer_destroy(&compressed);
+        grpc_slice_buffer_destroy(&output);
+      }
+    }
+  }
+
+  grpc_slice_unref(expected);
+  grpc_slice_buffer_destroy(&input);
+}
+
+static void test_incremental_decompression(void) {
+  grpc_slice_buffer input;
+  grpc_slice_buffer compressed;
+  grpc_slice_buffer split;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_add(&input, create_test_value(ONE_MB_A));
+  grpc_slice expected = grpc_slice_merge(input.slices, input.count);
+
+  grpc_core::ExecCtx exec_ctx;
+  GPR_ASSERT(grpc_msg_decompressor_create(GRPC_MESSAGE_COMPRESS_NONE, nullptr,
+                                          0, SIZE_MAX) == nullptr);
+  const grpc_message_compression_algorithm algorithms[] = {
+      GRPC_MESSAGE_COMPRESS_DEFLATE, GRPC_MESSAGE_COMPRESS_GZIP};
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(algorithms); i++) {
+    grpc_slice_buffer_init(&compressed);
+    grpc_slice_buffer_init(&split);
+    GPR_ASSERT(grpc_msg_compress(algorithms[i], &input, &compressed));
+    grpc_split_slice_buffer(GRPC_SLICE_SPLIT_ONE_BYTE, &compressed, &split);
+
+    /* fed a byte at a time, as a transport may hand the message over */
+    grpc_slice_buffer_init(&output);
+    grpc_msg_decompressor* decompressor = grpc_msg_decompressor_create(
+        algorithms[i], nullptr, compressed.length, SIZE_MAX);
+    for (size_t j = 0; j < split.count; j++) {
+      GPR_ASSERT(
+          grpc_msg_decompressor_add(decompressor, split.slices[j], &output));
+    }
+    GPR_ASSERT(grpc_msg_decompressor_finish(decompressor, &output));
+    grpc_msg_decompressor_destroy(decompressor);
+    grpc_slice got = grpc_slice_merge(output.slices, output.count);
+    GPR_ASSERT(grpc_slice_eq(expected, got));
+    grpc_slice_unref(got);
+    grpc_slice_buffer_destroy(&output);
+
+    /* a message cut short is an error */
+    grpc_slice_buffer_init(&output);
+    decompressor = grpc_msg_decompressor_create(algorithms[i], nullptr,
+                                                compressed.length, SIZE_MAX);
+    for (size_t j = 0; j + 1 < split.count; j++) {
+      GPR_ASSERT(
+          grpc_msg_decompressor_add(decompressor, split.slices[j], &output));
+    }
+    GPR_ASSERT(!grpc_msg_decompressor_finish(decompressor, &output));
+    grpc_msg_decompressor_destroy(decompressor);
+    grpc_slice_buffer_destroy(&output);
+
+    /* so is data past its end */
+    grpc_slice_buffer_init(&output);
+    decompressor = grpc_msg_decompressor_create(algorithms[i], nullptr,
+                                                compressed.length, SIZE_MAX);
+    for (size_t j = 0; j < compressed.count; j++) {
+      GPR_ASSERT(grpc_msg_decompressor_add(decompressor, compressed.slices[j],
+                                           &output));
+    }
+    GPR_ASSERT(!grpc_msg_decompressor_add(decompressor, split.slices[0],
+                                          &output));
+    grpc_msg_decompressor_destroy(decompressor);
+    grpc_slice_buffer_destroy(&output);
+
+    /* a message may inflate up to the limit, but not past it */
+    grpc_slice_buffer_init(&output);
+    decompressor = grpc_msg_decompressor_create(
+        algorithms[i], nullptr, compressed.length, input.length);
+    for (size_t j = 0; j < compressed.count; j++) {
+      GPR_ASSERT(grpc_msg_decompressor_add(decompressor, compressed.slices[j],
+                                           &output));
+    }
+    GPR_ASSERT(grpc_msg_decompressor_finish(decompressor, &output));
+    GPR_ASSERT(output.length == input.length);
+    grpc_msg_decompressor_destroy(decompressor);
+    grpc_slice_buffer_destroy(&output);
+    grpc_slice_buffer_init(&output);
+    decompressor = grpc_msg_decompressor_create(
+        algorithms[i], nullptr, compressed.length, input.length - 1);
+    bool ok = true;
+    for (size_t j = 0; ok && j < compressed.count; j++) {
+      ok = grpc_msg_decompressor_add(decompressor, compressed.slices[j],
+                                     &output);
+    }
+    GPR_ASSERT(!ok);
+    GPR_ASSERT(grpc_msg_decompressor_over_limit(decompressor));
+    GPR_ASSERT(output.length < input.length);
+    grpc_msg_decompressor_destroy(decompressor);
+    grpc_slice_buffer_destroy(&output);
+
+    grpc_slice_buffer_destroy(&compressed);
+    grpc_slice_buffer_destroy(&split);
+  }
+
+  grpc_slice_unref(expected);
+  grpc_slice_buffer_destroy(&input);
+}
+
+static bool decompress_with_dictionaries(
+    grpc_slice_buffer* compressed,
+    const grpc_compression_dictionaries* dictionaries,
+    grpc_slice_buffer* output) {
+  grpc_msg_decompressor* decompressor =
+      grpc_msg_decompressor_create(GRPC_MESSAGE_COMPRESS_DEFLATE, dictionaries,
+                                   compressed->length, SIZE_MAX);
+  bool ok = true;
+  for (size_t i = 0; ok && i < compressed->count; i++) {
+    ok = grpc_msg_decompressor_add(decompressor, compressed->slices[i], output);
+  }
+  ok = ok && grpc_msg_decompressor_finish(decompressor, output);
+  grpc_msg_decompressor_destroy(decompressor);
+  return ok;
+}
+
+static void test_dictionary_compression(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice dictionary_slices[] = {
+      grpc_slice_from_static_string("unrelated"),
+      grpc_slice_from_static_string(
+          "{\"host\":\"frontend\",\"metric\":\"latency_ms\",\"value\":"),
+      grpc_slice_from_static_string("unrelated")};
+  grpc_compression_dictionaries* dictionaries =
+      grpc_compression_dictionaries_create(
+          dictionary_slices, GPR_ARRAY_SIZE(dictionary_slices));
+  /* the duplicate is dropped */
+  GPR_ASSERT(grpc_compression_dictionaries_count(dictionaries) == 2);
+  const grpc_slice* dictionary =
+      grpc_compression_dictionaries_get(dictionaries, 1);
+  GPR_ASSERT(grpc_compression_dictionaries_find(
+                 dictionaries,
+                 grpc_compression_dictionaries_id(dictionaries, 1)) ==
+             dictionary);
+
+  grpc_slice_buffer input;
+  grpc_slice_buffer plain;
+  grpc_slice_buffer compressed;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&plain);
+  grpc_slice_buffer_init(&compressed);
+  grpc_slice_buffer_add(
+      &input, grpc_slice_from_static_string(
+                  "{\"host\":\"frontend\",\"metric\":\"latency_ms\","
+                  "\"value\":42}"));
+  grpc_slice expected = grpc_slice_merge(input.slices, input.count);
+
+  /* too small to compress on its own, but not with the dictionary */
+  GPR_ASSERT(!grpc_msg_compress(GRPC_MESSAGE_COMPRESS_DEFLATE, &input, &plain));
+  GPR_ASSERT(grpc_msg_compress_with_dictionary(
+      GRPC_MESSAGE_COMPRESS_DEFLATE, GRPC_MSG_COMPRESS_DEFAULT_ZLIB_LEVEL,
+      dictionary, &input, &compressed));
+  GPR_ASSERT(compressed.length < input.length / 2);
+
+  grpc_slice_buffer_init(&output);
+  GPR_ASSERT(decompress_with_dictionaries(&compressed, dictionaries, &output));
+  grpc_slice got = grpc_slice_merge(output.slices, output.count);
+  GPR_ASSERT(grpc_slice_eq(expected, got));
+  grpc_slice_unref(got);
+  grpc_slice_buffer_destroy(&output);
+
+  /* the receiver must have the dictionary */
+  grpc_slice_buffer_init(&output);
+  GPR_ASSERT(!decompress_with_dictionaries(&compressed, nullptr, &output));
+  grpc_slice_buffer_destroy(&output);
+  grpc_compression_dictionaries* others =
+      grpc_compression_dictionaries_create(dictionary_slices, 1);
+  grpc_slice_buffer_init(&output);
+  GPR_ASSERT(!decompress_with_dictionaries(&compressed, others, &output));
+  grpc_slice_buffer_destroy(&output);
+
+  grpc_slice_unref(expected);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&plain);
+  grpc_slice_buffer_destroy(&compressed);
+  grpc_compression_dictionaries_unref(others);
+  grpc_compression_dictionaries_unref(dictionaries);
+}
+
 static void test_bad_decompression_data_crc(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer corrupted;
@@ -314,6 +529,9 @@ int main(int argc, char** argv) {
   }
 
   test_tiny_data_compress();
+  test_zlib_levels();
+  test_incremental_decompression();
+  test_dictionary_compression();
   test_bad_decompression_data_crc();
   test_bad_decompression_data_stream();
   test_bad_decompression_data_trailing_garbage();
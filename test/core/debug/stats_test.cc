@@ -18,6 +18,7 @@
 
 #include "src/core/lib/debug/stats.h"
 
+#include <algorithm>
 #include <mutex>
 #include <thread>
 
@@ -65,6 +66,31 @@ TEST(StatsTest, IncSpecificCounter) {
   EXPECT_EQ(snapshot->delta().counters[GRPC_STATS_COUNTER_SYSCALL_POLL], 1);
 }
 
+TEST(StatsTest, LogLinearBucketsAreNarrow) {
+  const int kHistogram = GRPC_STATS_HISTOGRAM_PICK_LATENCY_US;
+  const int* bounds = grpc_stats_histo_bucket_boundaries[kHistogram];
+  for (int value : {0, 1, 15, 16, 17, 1000, 123456, 16777215}) {
+    int bucket = grpc_stats_histo_find_bucket_log_linear(value, 4);
+    EXPECT_LE(bounds[bucket], value);
+    EXPECT_GT(bounds[bucket + 1], value);
+    // Each bucket is at most 1/16th of its lower bound wide.
+    EXPECT_LE(bounds[bucket + 1] - bounds[bucket],
+              std::max(1, bounds[bucket] / 16));
+  }
+}
+
+TEST(StatsTest, LogLinearPercentile) {
+  std::unique_ptr<Snapshot> snapshot(new Snapshot);
+  grpc_core::ExecCtx exec_ctx;
+  for (int i = 1; i <= 1000; i++) {
+    GRPC_STATS_INC_PICK_LATENCY_US(i * 100);
+  }
+  grpc_stats_data delta = snapshot->delta();
+  double p99 = grpc_stats_histo_percentile(
+      &delta, GRPC_STATS_HISTOGRAM_PICK_LATENCY_US, 99);
+  EXPECT_NEAR(p99, 99000, 99000 / 16.0);
+}
+
 static int FindExpectedBucket(int i, int j) {
   if (j < 0) {
     return 0;
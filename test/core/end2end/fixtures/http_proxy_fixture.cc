@@ -294,6 +294,10 @@ static void on_client_read_done_locked(void* arg, grpc_error* error) {
   // the current write is finished.
   //
   // Otherwise, move the read data into the write buffer and write it.
+  //
+  // Either way the slices are now shared with the server endpoint, which may
+  // release them while the client endpoint reads, so they must be published.
+  grpc_slice_buffer_publish(&conn->client_read_buffer);
   if (conn->server_is_writing) {
     grpc_slice_buffer_move_into(&conn->client_read_buffer,
                                 &conn->server_deferred_write_buffer);
@@ -336,6 +340,10 @@ static void on_server_read_done_locked(void* arg, grpc_error* error) {
   // the current write is finished.
   //
   // Otherwise, move the read data into the write buffer and write it.
+  //
+  // Either way the slices are now shared with the client endpoint, which may
+  // release them while the server endpoint reads, so they must be published.
+  grpc_slice_buffer_publish(&conn->server_read_buffer);
   if (conn->client_is_writing) {
     grpc_slice_buffer_move_into(&conn->server_read_buffer,
                                 &conn->client_deferred_write_buffer);
@@ -182,6 +182,8 @@ END2END_TESTS = {
         default_test_options._replace(cpu_cost=LOWCPU,
                                       needs_client_channel=True,
                                       proxyable=False),
+    'retry_hedging': default_test_options._replace(
+        cpu_cost=LOWCPU, needs_client_channel=True, proxyable=False),
     'retry_non_retriable_status': default_test_options._replace(
         cpu_cost=LOWCPU, needs_client_channel=True, proxyable=False),
     'retry_non_retriable_status_before_recv_trailing_metadata_started':
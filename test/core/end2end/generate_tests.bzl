@@ -274,6 +274,10 @@ END2END_TESTS = {
         needs_client_channel = True,
         proxyable = False,
     ),
+    "retry_hedging": _test_options(
+        needs_client_channel = True,
+        proxyable = False,
+    ),
     "retry_non_retriable_status": _test_options(
         needs_client_channel = True,
         proxyable = False,
@@ -33,11 +33,23 @@
 #include "src/core/lib/compression/compression_args.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/call_test_only.h"
+#include "src/core/lib/transport/byte_stream.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "test/core/end2end/cq_verifier.h"
 
 static void* tag(intptr_t t) { return (void*)t; }
 
+/* Returns how the last message received on call was compressed on the wire.
+   The message itself is handed to the application decompressed. */
+static grpc_compression_algorithm received_message_compression(
+    grpc_call* call) {
+  if ((grpc_call_test_only_get_message_flags(call) &
+       GRPC_WRITE_INTERNAL_COMPRESS) == 0) {
+    return GRPC_COMPRESS_NONE;
+  }
+  return grpc_call_test_only_get_compression_algorithm(call);
+}
+
 static grpc_end2end_test_fixture begin_test(grpc_end2end_test_config config,
                                             const char* test_name,
                                             grpc_channel_args* client_args,
@@ -273,7 +285,8 @@ static void request_with_payload_template(
     grpc_compression_algorithm expected_algorithm_from_server,
     grpc_metadata* client_init_metadata, bool set_server_level,
     grpc_compression_level server_compression_level,
-    bool send_message_before_initial_metadata) {
+    bool send_message_before_initial_metadata,
+    int client_min_message_size) {
   grpc_call* c;
   grpc_call* s;
   grpc_slice request_payload_slice;
@@ -310,6 +323,16 @@ static void request_with_payload_template(
 
   client_args = grpc_channel_args_set_channel_default_compression_algorithm(
       nullptr, default_client_channel_compression_algorithm);
+  if (client_min_message_size > 0) {
+    grpc_arg min_message_size_arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_COMPRESSION_CHANNEL_MIN_MESSAGE_SIZE),
+        client_min_message_size);
+    grpc_channel_args* new_client_args =
+        grpc_channel_args_copy_and_add(client_args, &min_message_size_arg, 1);
+    grpc_core::ExecCtx exec_ctx;
+    grpc_channel_args_destroy(client_args);
+    client_args = new_client_args;
+  }
   server_args = grpc_channel_args_set_channel_default_compression_algorithm(
       nullptr, default_server_channel_compression_algorithm);
 
@@ -442,6 +465,8 @@ static void request_with_payload_template(
     GPR_ASSERT(request_payload_recv->type == GRPC_BB_RAW);
     GPR_ASSERT(byte_buffer_eq_string(request_payload_recv, request_str));
     GPR_ASSERT(request_payload_recv->data.raw.compression ==
+               GRPC_COMPRESS_NONE);
+    GPR_ASSERT(received_message_compression(s) ==
                expected_algorithm_from_client);
 
     memset(ops, 0, sizeof(ops));
@@ -472,13 +497,14 @@ static void request_with_payload_template(
 
     GPR_ASSERT(response_payload_recv->type == GRPC_BB_RAW);
     GPR_ASSERT(byte_buffer_eq_string(response_payload_recv, response_str));
+    GPR_ASSERT(response_payload_recv->data.raw.compression ==
+               GRPC_COMPRESS_NONE);
     if (server_compression_level > GRPC_COMPRESS_LEVEL_NONE) {
       const grpc_compression_algorithm algo_for_server_level =
           grpc_call_compression_for_level(s, server_compression_level);
-      GPR_ASSERT(response_payload_recv->data.raw.compression ==
-                 algo_for_server_level);
+      GPR_ASSERT(received_message_compression(c) == algo_for_server_level);
     } else {
-      GPR_ASSERT(response_payload_recv->data.raw.compression ==
+      GPR_ASSERT(received_message_compression(c) ==
                  expected_algorithm_from_server);
     }
 
@@ -553,7 +579,7 @@ static void test_invoke_request_with_exceptionally_uncompressed_payload(
       config, "test_invoke_request_with_exceptionally_uncompressed_payload",
       GRPC_WRITE_NO_COMPRESS, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_GZIP, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, 0);
 }
 
 static void test_invoke_request_with_uncompressed_payload(
@@ -562,7 +588,7 @@ static void test_invoke_request_with_uncompressed_payload(
       config, "test_invoke_request_with_uncompressed_payload", 0,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_NONE, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, 0);
 }
 
 static void test_invoke_request_with_compressed_payload(
@@ -571,7 +597,16 @@ static void test_invoke_request_with_compressed_payload(
       config, "test_invoke_request_with_compressed_payload", 0,
       GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_GZIP, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, 0);
+}
+
+static void test_invoke_request_with_payload_under_min_message_size(
+    grpc_end2end_test_config config) {
+  request_with_payload_template(
+      config, "test_invoke_request_with_payload_under_min_message_size", 0,
+      GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_NONE,
+      GRPC_COMPRESS_GZIP, nullptr, false,
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, 2048);
 }
 
 static void test_invoke_request_with_send_message_before_initial_metadata(
@@ -580,7 +615,7 @@ static void test_invoke_request_with_send_message_before_initial_metadata(
       config, "test_invoke_request_with_compressed_payload", 0,
       GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_GZIP, nullptr, false,
-      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, true);
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, true, 0);
 }
 
 static void test_invoke_request_with_server_level(
@@ -588,7 +623,7 @@ static void test_invoke_request_with_server_level(
   request_with_payload_template(
       config, "test_invoke_request_with_server_level", 0, GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE /* ignored */,
-      nullptr, true, GRPC_COMPRESS_LEVEL_HIGH, false);
+      nullptr, true, GRPC_COMPRESS_LEVEL_HIGH, false, 0);
 }
 
 static void test_invoke_request_with_compressed_payload_md_override(
@@ -612,21 +647,21 @@ static void test_invoke_request_with_compressed_payload_md_override(
       config, "test_invoke_request_with_compressed_payload_md_override_1", 0,
       GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_NONE, &gzip_compression_override, false,
-      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false);
+      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false, 0);
 
   /* Channel default DEFLATE, call override to GZIP */
   request_with_payload_template(
       config, "test_invoke_request_with_compressed_payload_md_override_2", 0,
       GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_NONE, &gzip_compression_override, false,
-      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false);
+      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false, 0);
 
   /* Channel default DEFLATE, call override to NONE (aka IDENTITY) */
   request_with_payload_template(
       config, "test_invoke_request_with_compressed_payload_md_override_3", 0,
       GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_NONE, GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_NONE, &identity_compression_override, false,
-      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false);
+      /*ignored*/ GRPC_COMPRESS_LEVEL_NONE, false, 0);
 }
 
 static void test_invoke_request_with_disabled_algorithm(
@@ -641,6 +676,7 @@ void compressed_payload(grpc_end2end_test_config config) {
   test_invoke_request_with_exceptionally_uncompressed_payload(config);
   test_invoke_request_with_uncompressed_payload(config);
   test_invoke_request_with_compressed_payload(config);
+  test_invoke_request_with_payload_under_min_message_size(config);
   test_invoke_request_with_send_message_before_initial_metadata(config);
   test_invoke_request_with_server_level(config);
   test_invoke_request_with_compressed_payload_md_override(config);
@@ -823,10 +823,222 @@ static void test_max_concurrent_streams_with_timeout_on_second(
   config.tear_down_data(&f);
 }
 
+/* Starts a call whose send ops complete with tag(base + 1) once the stream is
+   opened, and whose recv ops complete with tag(base + 2). */
+static grpc_call* start_client_call(grpc_end2end_test_fixture f,
+                                    const char* method, int base,
+                                    grpc_metadata_array* initial_metadata_recv,
+                                    grpc_metadata_array* trailing_metadata_recv,
+                                    grpc_status_code* status,
+                                    grpc_slice* details) {
+  grpc_op ops[6];
+  grpc_op* op;
+  grpc_call* c = grpc_channel_create_call(
+      f.client, nullptr, GRPC_PROPAGATE_DEFAULTS, f.cq,
+      grpc_slice_from_static_string(method), nullptr, n_seconds_from_now(1000),
+      nullptr);
+  GPR_ASSERT(c);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(
+                                 c, ops, static_cast<size_t>(op - ops),
+                                 tag(base + 1), nullptr));
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata = trailing_metadata_recv;
+  op->data.recv_status_on_client.status = status;
+  op->data.recv_status_on_client.status_details = details;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_RECV_INITIAL_METADATA;
+  op->data.recv_initial_metadata.recv_initial_metadata = initial_metadata_recv;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(
+                                 c, ops, static_cast<size_t>(op - ops),
+                                 tag(base + 2), nullptr));
+  return c;
+}
+
+/* Sends the status of a server call, completing with tag(t). */
+static void finish_server_call(grpc_call* s, int t, int* was_cancelled) {
+  grpc_op ops[6];
+  grpc_op* op;
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = was_cancelled;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.trailing_metadata_count = 0;
+  op->data.send_status_from_server.status = GRPC_STATUS_UNIMPLEMENTED;
+  op->data.send_status_from_server.status_details = &status_details;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(
+                                 s, ops, static_cast<size_t>(op - ops), tag(t),
+                                 nullptr));
+}
+
+/* With the server accepting one stream per connection, a subchannel allowed
+   to open a second connection must serve a third call while the first one
+   is still open, even though the second call is queued behind it. */
+static void test_max_concurrent_streams_with_extra_connections(
+    grpc_end2end_test_config config) {
+  grpc_end2end_test_fixture f;
+  grpc_arg server_arg;
+  grpc_channel_args server_args;
+  grpc_arg client_arg[2];
+  grpc_channel_args client_args;
+  grpc_call* c[3];
+  grpc_call* s[3];
+  cq_verifier* cqv;
+  grpc_call_details call_details[3];
+  grpc_metadata_array request_metadata_recv[3];
+  grpc_metadata_array initial_metadata_recv[3];
+  grpc_metadata_array trailing_metadata_recv[3];
+  grpc_status_code status[3];
+  grpc_slice details[3];
+  int was_cancelled[3];
+  int i;
+
+  server_arg.key = const_cast<char*>(GRPC_ARG_MAX_CONCURRENT_STREAMS);
+  server_arg.type = GRPC_ARG_INTEGER;
+  server_arg.value.integer = 1;
+
+  server_args.num_args = 1;
+  server_args.args = &server_arg;
+
+  client_arg[0].key = const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS);
+  client_arg[0].type = GRPC_ARG_INTEGER;
+  client_arg[0].value.integer = 2;
+  client_arg[1].key =
+      const_cast<char*>(GRPC_ARG_SUBCHANNEL_CALLS_PER_CONNECTION);
+  client_arg[1].type = GRPC_ARG_INTEGER;
+  client_arg[1].value.integer = 1;
+
+  client_args.num_args = 2;
+  client_args.args = client_arg;
+
+  f = begin_test(config, "test_max_concurrent_streams_with_extra_connections",
+                 &client_args, &server_args);
+  cqv = cq_verifier_create(f.cq);
+
+  for (i = 0; i < 3; i++) {
+    grpc_metadata_array_init(&request_metadata_recv[i]);
+    grpc_metadata_array_init(&initial_metadata_recv[i]);
+    grpc_metadata_array_init(&trailing_metadata_recv[i]);
+    grpc_call_details_init(&call_details[i]);
+  }
+
+  /* perform a ping-pong to ensure that settings have had a chance to round
+     trip */
+  simple_request_body(config, f);
+
+  c[0] = start_client_call(f, "/alpha", 300, &initial_metadata_recv[0],
+                           &trailing_metadata_recv[0], &status[0],
+                           &details[0]);
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_server_request_call(f.server, &s[0], &call_details[0],
+                                      &request_metadata_recv[0], f.cq, f.cq,
+                                      tag(101)));
+  CQ_EXPECT_COMPLETION(cqv, tag(101), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(301), 1);
+  cq_verify(cqv);
+
+  /* the first connection is full: this call waits for /alpha, and asks the
+     subchannel for another connection */
+  c[1] = start_client_call(f, "/beta", 400, &initial_metadata_recv[1],
+                           &trailing_metadata_recv[1], &status[1],
+                           &details[1]);
+  cq_verify_empty_timeout(cqv, 1);
+
+  /* this call goes to the new connection */
+  c[2] = start_client_call(f, "/gamma", 500, &initial_metadata_recv[2],
+                           &trailing_metadata_recv[2], &status[2],
+                           &details[2]);
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_server_request_call(f.server, &s[2], &call_details[2],
+                                      &request_metadata_recv[2], f.cq, f.cq,
+                                      tag(103)));
+  CQ_EXPECT_COMPLETION(cqv, tag(103), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(501), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(call_details[2].method, "/gamma"));
+
+  /* finishing /alpha lets /beta start */
+  finish_server_call(s[0], 201, &was_cancelled[0]);
+  CQ_EXPECT_COMPLETION(cqv, tag(201), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(302), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(401), 1);
+  cq_verify(cqv);
+
+  finish_server_call(s[2], 203, &was_cancelled[2]);
+  CQ_EXPECT_COMPLETION(cqv, tag(203), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(502), 1);
+  cq_verify(cqv);
+
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_server_request_call(f.server, &s[1], &call_details[1],
+                                      &request_metadata_recv[1], f.cq, f.cq,
+                                      tag(102)));
+  CQ_EXPECT_COMPLETION(cqv, tag(102), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(0 == grpc_slice_str_cmp(call_details[1].method, "/beta"));
+  finish_server_call(s[1], 202, &was_cancelled[1]);
+  CQ_EXPECT_COMPLETION(cqv, tag(202), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(402), 1);
+  cq_verify(cqv);
+
+  cq_verifier_destroy(cqv);
+
+  for (i = 0; i < 3; i++) {
+    GPR_ASSERT(status[i] == GRPC_STATUS_UNIMPLEMENTED);
+    grpc_call_unref(c[i]);
+    grpc_call_unref(s[i]);
+    grpc_slice_unref(details[i]);
+    grpc_metadata_array_destroy(&request_metadata_recv[i]);
+    grpc_metadata_array_destroy(&initial_metadata_recv[i]);
+    grpc_metadata_array_destroy(&trailing_metadata_recv[i]);
+    grpc_call_details_destroy(&call_details[i]);
+  }
+
+  end_test(&f);
+  config.tear_down_data(&f);
+}
+
 void max_concurrent_streams(grpc_end2end_test_config config) {
   test_max_concurrent_streams_with_timeout_on_first(config);
   test_max_concurrent_streams_with_timeout_on_second(config);
   test_max_concurrent_streams(config);
+  if ((config.feature_mask & FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL) &&
+      !(config.feature_mask & FEATURE_MASK_SUPPORTS_REQUEST_PROXYING)) {
+    test_max_concurrent_streams_with_extra_connections(config);
+  }
 }
 
 void max_concurrent_streams_pre_init(void) {}
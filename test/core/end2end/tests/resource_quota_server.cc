@@ -26,6 +26,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
 #include "test/core/end2end/cq_verifier.h"
 
 static void* tag(intptr_t t) { return (void*)t; }
@@ -116,12 +118,15 @@ void resource_quota_server(grpc_end2end_test_config config) {
 #define SERVER_RECV_BASE_TAG 0x3000
 #define SERVER_END_BASE_TAG 0x4000
 
-  grpc_arg arg;
-  arg.key = const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA);
-  arg.type = GRPC_ARG_POINTER;
-  arg.value.pointer.p = resource_quota;
-  arg.value.pointer.vtable = grpc_resource_quota_arg_vtable();
-  grpc_channel_args args = {1, &arg};
+  grpc_arg arg[2];
+  arg[0].key = const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA);
+  arg[0].type = GRPC_ARG_POINTER;
+  arg[0].value.pointer.p = resource_quota;
+  arg[0].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  /* exercise giving back the hpack table before going away */
+  arg[1] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER_PRESSURE), 0);
+  grpc_channel_args args = {GPR_ARRAY_SIZE(arg), arg};
 
   grpc_end2end_test_fixture f =
       begin_test(config, "resource_quota_server", nullptr, &args);
@@ -33,11 +33,23 @@
 #include "src/core/lib/compression/compression_args.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/call_test_only.h"
+#include "src/core/lib/transport/byte_stream.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "test/core/end2end/cq_verifier.h"
 
 static void* tag(intptr_t t) { return (void*)t; }
 
+/* Returns how the last message received on call was compressed on the wire.
+   The message itself is handed to the application decompressed. */
+static grpc_compression_algorithm received_message_compression(
+    grpc_call* call) {
+  if ((grpc_call_test_only_get_message_flags(call) &
+       GRPC_WRITE_INTERNAL_COMPRESS) == 0) {
+    return GRPC_COMPRESS_NONE;
+  }
+  return grpc_call_test_only_get_compression_algorithm(call);
+}
+
 static grpc_end2end_test_fixture begin_test(grpc_end2end_test_config config,
                                             const char* test_name,
                                             grpc_channel_args* client_args,
@@ -267,6 +279,8 @@ static void request_with_payload_template(
     GPR_ASSERT(request_payload_recv->type == GRPC_BB_RAW);
     GPR_ASSERT(byte_buffer_eq_string(request_payload_recv, request_str));
     GPR_ASSERT(request_payload_recv->data.raw.compression ==
+               GRPC_COMPRESS_NONE);
+    GPR_ASSERT(received_message_compression(s) ==
                expected_algorithm_from_client);
 
     memset(ops, 0, sizeof(ops));
@@ -285,13 +299,14 @@ static void request_with_payload_template(
 
     GPR_ASSERT(response_payload_recv->type == GRPC_BB_RAW);
     GPR_ASSERT(byte_buffer_eq_string(response_payload_recv, response_str));
+    GPR_ASSERT(response_payload_recv->data.raw.compression ==
+               GRPC_COMPRESS_NONE);
     if (server_compression_level > GRPC_COMPRESS_LEVEL_NONE) {
       const grpc_compression_algorithm algo_for_server_level =
           grpc_call_compression_for_level(s, server_compression_level);
-      GPR_ASSERT(response_payload_recv->data.raw.compression ==
-                 algo_for_server_level);
+      GPR_ASSERT(received_message_compression(c) == algo_for_server_level);
     } else {
-      GPR_ASSERT(response_payload_recv->data.raw.compression ==
+      GPR_ASSERT(received_message_compression(c) ==
                  expected_algorithm_from_server);
     }
 
@@ -35,6 +35,55 @@ using grpc_core::Arena;
 
 static void test_noop(void) { Arena::Create(1)->Destroy(); }
 
+static void test_aligned(void) {
+  gpr_log(GPR_DEBUG, "test_aligned");
+
+  Arena* a = Arena::Create(1024);
+  char* c = static_cast<char*>(a->Alloc(1, 1));
+  char* i = static_cast<char*>(a->Alloc(sizeof(int), alignof(int)));
+  char* d = static_cast<char*>(a->Alloc(8, 8));
+  char* p = static_cast<char*>(a->Alloc(1));
+  GPR_ASSERT(((intptr_t)i & (alignof(int) - 1)) == 0);
+  GPR_ASSERT(((intptr_t)d & 7) == 0);
+  GPR_ASSERT(((intptr_t)p & 0xf) == 0);
+  // small objects are packed, rather than each taking 16 bytes
+  GPR_ASSERT(i - c == alignof(int));
+  GPR_ASSERT(d - c == 8);
+  GPR_ASSERT(p - c == 16);
+  char* n = reinterpret_cast<char*>(a->New<char>('x'));
+  GPR_ASSERT(n == p + 1 && *n == 'x');
+  a->Destroy();
+}
+
+static void test_pool(void) {
+  gpr_log(GPR_DEBUG, "test_pool");
+
+  grpc_core::ArenaPool pool(1024 * 1024);
+  Arena* a = pool.CreateWithAlloc(100, 16).first;
+  memset(a->Alloc(900), 1, 900);
+  pool.Destroy(a);
+  // The storage just cached should back the next arena of the same size.
+  auto b = pool.CreateWithAlloc(100, 16);
+  memset(b.first->Alloc(900), 1, 900);
+  pool.Destroy(b.first);
+  // Arenas too large to cache still work.
+  Arena* c = pool.CreateWithAlloc(1024 * 1024, 16).first;
+  memset(c->Alloc(1024 * 1024), 1, 1024 * 1024);
+  pool.Destroy(c);
+  // Nor does a full pool stop arenas from being destroyed.
+  grpc_core::ArenaPool tiny(0);
+  Arena* d = tiny.CreateWithAlloc(1, 16).first;
+  memset(d->Alloc(4096), 1, 4096);
+  tiny.Destroy(d);
+  // Released storage is freed, and no more is cached.
+  Arena* e = pool.CreateWithAlloc(100, 16).first;
+  pool.Destroy(e);
+  GPR_ASSERT(pool.Release() > 0);
+  Arena* f = pool.CreateWithAlloc(100, 16).first;
+  pool.Destroy(f);
+  GPR_ASSERT(pool.Release() == 0);
+}
+
 static void test(const char* name, size_t init_size, const size_t* allocs,
                  size_t nallocs) {
   gpr_strvec v;
@@ -128,6 +177,8 @@ int main(int argc, char* argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  test_aligned();
+  test_pool();
 
   return 0;
 }
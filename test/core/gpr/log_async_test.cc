@@ -0,0 +1,261 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Test of the per-thread rings that GRPC_LOG_ASYNC queues log lines on. The
+   writer thread's output goes to stderr, which is redirected to a pipe. */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gpr/log_async.h"
+
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+#include "test/core/util/test_config.h"
+
+#if defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "src/core/lib/gprpp/thd.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_log_async);
+
+/* Mirrors log_async.cc. */
+#define RING_SIZE (64 * 1024)
+#define MAX_RINGS 64
+/* Bytes in a ring for a line with prefix "p" and no padding: the length, the
+   prefix, a space, the message and a newline. */
+#define RECORD_OVERHEAD (4 + 3)
+
+static int g_read_fd;
+static int g_write_fd;
+/* Everything read back from stderr so far. */
+static std::string g_output;
+
+static bool print(const std::string& message) {
+  return gpr_log_async_print(GPR_LOG_SEVERITY_INFO, 0, "p",
+                             message.c_str());
+}
+
+/* A message with \a tag in front, padded so that its record takes \a size
+   bytes of a ring. */
+static std::string message_of_size(const std::string& tag, size_t size) {
+  GPR_ASSERT(size >= RECORD_OVERHEAD + tag.size());
+  return tag + std::string(size - RECORD_OVERHEAD - tag.size(),
+                           static_cast<char>('a' + size % 26));
+}
+
+static std::string line_of(const std::string& message) {
+  return "p " + message + "\n";
+}
+
+/* Appends what can be read from stderr right now to g_output. */
+static void read_available() {
+  char buf[4096];
+  for (;;) {
+    ssize_t n = read(g_read_fd, buf, sizeof(buf));
+    if (n <= 0) {
+      GPR_ASSERT(n < 0 && errno == EAGAIN);
+      return;
+    }
+    g_output.append(buf, static_cast<size_t>(n));
+  }
+}
+
+/* Reads stderr until \a needle shows up in it. */
+static void read_until(const std::string& needle) {
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  for (;;) {
+    read_available();
+    if (g_output.find(needle) != std::string::npos) return;
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+}
+
+/* Fills the pipe behind stderr, so that the writer thread blocks on its next
+   write until the test reads again. */
+static void fill_pipe() {
+  int flags = fcntl(g_write_fd, F_GETFL);
+  GPR_ASSERT(fcntl(g_write_fd, F_SETFL, flags | O_NONBLOCK) == 0);
+  /* Small writes that do not fit fail rather than being split, so finish
+     with single bytes. */
+  const std::string filler(4096, '.');
+  for (size_t size = filler.size(); size > 0;) {
+    if (write(g_write_fd, filler.data(), size) < 0) {
+      GPR_ASSERT(errno == EAGAIN);
+      size = size == 1 ? 0 : 1;
+    }
+  }
+  GPR_ASSERT(fcntl(g_write_fd, F_SETFL, flags) == 0);
+}
+
+/* Lines whose records are not a divisor of RING_SIZE, and vary in size, end
+   up split at every offset around the end of the ring, length prefix
+   included. */
+static void test_wrap_around() {
+  gpr_log(GPR_INFO, "test_wrap_around");
+  size_t total = 0;
+  int line = 0;
+  while (total < 3 * RING_SIZE) {
+    /* Stay under half a ring between reads, so that nothing is dropped. */
+    std::string message;
+    for (size_t batch = 0; batch < RING_SIZE / 4;) {
+      size_t size = 64 + (line * 37) % 2000;
+      message = message_of_size("wrap " + std::to_string(line) + ":", size);
+      GPR_ASSERT(print(message));
+      batch += size;
+      total += size;
+      ++line;
+    }
+    read_until(line_of(message));
+  }
+  /* Every line came out once, whole, and in order. */
+  size_t pos = 0;
+  for (int i = 0; i < line; ++i) {
+    size_t size = 64 + (i * 37) % 2000;
+    std::string expected =
+        line_of(message_of_size("wrap " + std::to_string(i) + ":", size));
+    size_t found = g_output.find(expected, pos);
+    GPR_ASSERT(found != std::string::npos);
+    pos = found + expected.size();
+  }
+  GPR_ASSERT(g_output.find("dropped") == std::string::npos);
+}
+
+/* Lines that do not fit in a full ring are counted, and the count is written
+   once the writer catches up. */
+static void test_dropped_lines() {
+  gpr_log(GPR_INFO, "test_dropped_lines");
+  /* Start from an empty ring. */
+  read_until("test_dropped_lines\n");
+  fill_pipe();
+  GPR_ASSERT(print("stalled"));
+  /* Let the writer take the line, and block writing it. */
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(200));
+  /* Records of 1024 bytes fill the ring exactly. */
+  const int kFit = RING_SIZE / 1024;
+  const int kDropped = 10;
+  for (int i = 0; i < kFit + kDropped; ++i) {
+    GPR_ASSERT(
+        print(message_of_size("drop " + std::to_string(i) + ":", 1024)));
+  }
+  read_until("gpr_log: dropped " + std::to_string(kDropped) + " lines\n");
+  for (int i = 0; i < kFit; ++i) {
+    GPR_ASSERT(g_output.find(line_of(message_of_size(
+                   "drop " + std::to_string(i) + ":", 1024))) !=
+               std::string::npos);
+  }
+  for (int i = kFit; i < kFit + kDropped; ++i) {
+    GPR_ASSERT(g_output.find("drop " + std::to_string(i) + ":") ==
+               std::string::npos);
+  }
+}
+
+struct thread_arg {
+  int round;
+  int index;
+  bool queued;
+  /* Counts the threads of the round that have logged. */
+  gpr_atm* logged;
+  gpr_event* done;
+};
+
+static std::string thread_message(int round, int index) {
+  return "thread " + std::to_string(round) + " " + std::to_string(index) + ":";
+}
+
+static void thread_body(void* arg) {
+  thread_arg* a = static_cast<thread_arg*>(arg);
+  a->queued = print(thread_message(a->round, a->index));
+  gpr_atm_full_fetch_add(a->logged, 1);
+  /* Keeps the ring until every thread of the round has logged. */
+  gpr_event_wait(a->done, gpr_inf_future(GPR_CLOCK_REALTIME));
+}
+
+/* A thread that exits gives its ring back, for the threads that log next.
+   Threads beyond the rings available are left to log themselves. */
+static void test_ring_handoff() {
+  gpr_log(GPR_INFO, "test_ring_handoff");
+  const int kThreads = MAX_RINGS + 8;
+  for (int round = 0; round < 2; ++round) {
+    gpr_atm logged = 0;
+    gpr_event done;
+    gpr_event_init(&done);
+    grpc_core::Thread threads[kThreads];
+    thread_arg args[kThreads];
+    for (int i = 0; i < kThreads; ++i) {
+      args[i] = {round, i, false, &logged, &done};
+      threads[i] =
+          grpc_core::Thread("grpc_log_async_test", thread_body, &args[i]);
+      threads[i].Start();
+    }
+    while (gpr_atm_acq_load(&logged) < kThreads) {
+      read_available();
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+    }
+    gpr_event_set(&done, reinterpret_cast<void*>(1));
+    int queued = 0;
+    for (int i = 0; i < kThreads; ++i) {
+      threads[i].Join();
+      if (args[i].queued) {
+        ++queued;
+        read_until(line_of(thread_message(round, i)));
+      }
+    }
+    /* The main thread holds one ring. */
+    GPR_ASSERT(queued == MAX_RINGS - 1);
+  }
+}
+
+int main(int argc, char** argv) {
+  GPR_GLOBAL_CONFIG_SET(grpc_log_async, true);
+  grpc::testing::TestEnvironment env(argc, argv);
+  gpr_set_log_verbosity(GPR_LOG_SEVERITY_INFO);
+  int fds[2];
+  GPR_ASSERT(pipe(fds) == 0);
+  g_read_fd = fds[0];
+  g_write_fd = fds[1];
+  GPR_ASSERT(fcntl(g_read_fd, F_SETFL, O_NONBLOCK) == 0);
+  int saved_stderr = dup(STDERR_FILENO);
+  GPR_ASSERT(dup2(g_write_fd, STDERR_FILENO) == STDERR_FILENO);
+  test_wrap_around();
+  test_dropped_lines();
+  test_ring_handoff();
+  dup2(saved_stderr, STDERR_FILENO);
+  return 0;
+}
+
+#else /* !(defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG)) */
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  return 0;
+}
+
+#endif /* defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG) */
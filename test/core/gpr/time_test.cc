@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "src/core/lib/gpr/time_precise.h"
 #include "test/core/util/test_config.h"
 
 static void to_fp(void* arg, const char* buf, size_t len) {
@@ -253,6 +254,28 @@ static void test_cmp_extreme(void) {
   GPR_ASSERT(gpr_time_cmp(t1, t2) == 0);
 }
 
+/* With the cycle clock on where the machine allows it, the monotonic clock
+   still never goes backwards, and keeps pace with the realtime clock across
+   the updates of the cycle clock. */
+static void test_cycle_clock(void) {
+  GPR_GLOBAL_CONFIG_SET(grpc_cycle_clock, true);
+  gpr_time_init();
+  gpr_timespec mono_start = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec real_start = gpr_now(GPR_CLOCK_REALTIME);
+  gpr_timespec last = mono_start;
+  gpr_timespec mono;
+  do {
+    mono = gpr_now(GPR_CLOCK_MONOTONIC);
+    GPR_ASSERT(gpr_time_cmp(mono, last) >= 0);
+    last = mono;
+  } while (gpr_time_cmp(gpr_time_sub(mono, mono_start),
+                        gpr_time_from_millis(2500, GPR_TIMESPAN)) < 0);
+  gpr_timespec real = gpr_now(GPR_CLOCK_REALTIME);
+  GPR_ASSERT(gpr_time_similar(gpr_time_sub(mono, mono_start),
+                              gpr_time_sub(real, real_start),
+                              gpr_time_from_millis(50, GPR_TIMESPAN)));
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
 
@@ -263,5 +286,6 @@ int main(int argc, char* argv[]) {
   test_similar();
   test_convert_extreme();
   test_cmp_extreme();
+  test_cycle_clock();
   return 0;
 }
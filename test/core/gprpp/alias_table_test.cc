@@ -0,0 +1,127 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/gprpp/alias_table.h"
+
+#include <stdlib.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+// Resolves every entry for every key, and checks that each index is
+// resolved to exactly as often as its share of the total weight implies.
+void CheckResolutions(const std::vector<uint32_t>& weights) {
+  InlinedVector<uint32_t, 1> table_weights;
+  uint64_t total_weight = 0;
+  for (uint32_t weight : weights) {
+    table_weights.push_back(weight);
+    total_weight += weight;
+  }
+  AliasTable table(table_weights);
+  ASSERT_EQ(weights.size(), table.size());
+  ASSERT_EQ(total_weight, table.total_weight());
+  std::vector<uint64_t> resolutions(weights.size(), 0);
+  for (size_t entry = 0; entry < table.size(); ++entry) {
+    for (uint64_t key = 0; key < total_weight; ++key) {
+      const size_t index = table.Resolve(entry, key);
+      ASSERT_LT(index, weights.size());
+      ++resolutions[index];
+    }
+  }
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_EQ(static_cast<uint64_t>(weights[i]) * weights.size(),
+              resolutions[i])
+        << "index " << i;
+  }
+}
+
+TEST(AliasTable, SingleWeight) {
+  CheckResolutions({1});
+  CheckResolutions({7});
+}
+
+TEST(AliasTable, EqualWeights) {
+  CheckResolutions({1, 1});
+  CheckResolutions({3, 3, 3, 3, 3});
+}
+
+TEST(AliasTable, UnequalWeights) {
+  CheckResolutions({2, 8});
+  CheckResolutions({1, 2, 3, 4});
+  CheckResolutions({100, 1, 1});
+  CheckResolutions({1, 1, 1, 97});
+}
+
+// An entry that is filled from an overfull one can leave that one
+// underfull, and then be its alias in turn.
+TEST(AliasTable, AliasOfAnAlias) {
+  CheckResolutions({6, 5, 1, 0});
+  CheckResolutions({1, 10, 1, 10, 1, 1});
+}
+
+TEST(AliasTable, ZeroWeightsAreNeverResolvedTo) {
+  CheckResolutions({0, 5});
+  CheckResolutions({5, 0, 5, 0});
+  CheckResolutions({0, 0, 1});
+}
+
+TEST(AliasTable, RandomWeights) {
+  srand(42);
+  for (int i = 0; i < 100; ++i) {
+    std::vector<uint32_t> weights(1 + rand() % 50);
+    for (uint32_t& weight : weights) {
+      weight = rand() % 100;
+    }
+    weights[rand() % weights.size()] += 1;
+    CheckResolutions(weights);
+  }
+}
+
+TEST(AliasTable, PicksInProportionToWeights) {
+  const std::vector<uint32_t> kWeights = {1, 2, 3, 4};
+  const int kPicks = 100000;
+  InlinedVector<uint32_t, 1> weights;
+  for (uint32_t weight : kWeights) weights.push_back(weight);
+  AliasTable table(weights);
+  std::vector<int> picks(kWeights.size(), 0);
+  for (int i = 0; i < kPicks; ++i) {
+    ++picks[table.Pick()];
+  }
+  for (size_t i = 0; i < kWeights.size(); ++i) {
+    const double expected = kPicks * kWeights[i] / 10.0;
+    EXPECT_GT(picks[i], expected * 0.9) << "index " << i;
+    EXPECT_LT(picks[i], expected * 1.1) << "index " << i;
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/gprpp/reader_epochs.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "test/core/util/test_config.h"
+
+using grpc_core::ReaderEpochs;
+
+#define LIVE_MAGIC 0x11111111
+#define FREED_MAGIC 0xdeadbeef
+#define WRITER_ITERATIONS 20000
+
+typedef struct object {
+  uint32_t magic;
+  size_t version;
+} object;
+
+static void test_single_thread(void) {
+  gpr_log(GPR_DEBUG, "test_single_thread");
+  ReaderEpochs epochs;
+  memset(&epochs, 0, sizeof(epochs));
+  GPR_ASSERT(epochs.PreviousEpochDone());
+  ReaderEpochs::Read read = epochs.BeginRead();
+  /* The read is counted in the current epoch... */
+  GPR_ASSERT(epochs.PreviousEpochDone());
+  epochs.Flip();
+  /* ...which is the previous one after a flip. */
+  GPR_ASSERT(!epochs.PreviousEpochDone());
+  ReaderEpochs::Read late_read = epochs.BeginRead();
+  epochs.EndRead(read);
+  GPR_ASSERT(epochs.PreviousEpochDone());
+  epochs.Flip();
+  GPR_ASSERT(!epochs.PreviousEpochDone());
+  epochs.EndRead(late_read);
+  GPR_ASSERT(epochs.PreviousEpochDone());
+}
+
+typedef struct {
+  ReaderEpochs* epochs;
+  gpr_atm* current;
+  gpr_atm* stop;
+  gpr_event* start;
+  size_t reads;
+} reader_args;
+
+/* Dereferences the current object, a few times per read, until stopped. */
+static void reader_thread(void* arg) {
+  reader_args* a = static_cast<reader_args*>(arg);
+  gpr_event_wait(a->start, gpr_inf_future(GPR_CLOCK_REALTIME));
+  size_t last_version = 0;
+  while (!gpr_atm_acq_load(a->stop)) {
+    ReaderEpochs::Read read = a->epochs->BeginRead();
+    object* o = reinterpret_cast<object*>(gpr_atm_acq_load(a->current));
+    for (int i = 0; i < 16; i++) {
+      GPR_ASSERT(o->magic == LIVE_MAGIC);
+    }
+    GPR_ASSERT(o->version >= last_version);
+    last_version = o->version;
+    a->epochs->EndRead(read);
+    a->reads++;
+  }
+}
+
+/* A writer replaces the object readers see, and frees the old one as soon as
+   the epochs allow it, while readers keep dereferencing it. Freed objects are
+   poisoned first, so that a read that was not waited for fails even without
+   a sanitizer. */
+static void test_mt(void) {
+  gpr_log(GPR_DEBUG, "test_mt");
+  ReaderEpochs epochs;
+  memset(&epochs, 0, sizeof(epochs));
+  gpr_atm current = reinterpret_cast<gpr_atm>(new object{LIVE_MAGIC, 0});
+  gpr_atm stop = 0;
+  gpr_event start;
+  gpr_event_init(&start);
+  grpc_core::Thread thds[8];
+  reader_args ra[GPR_ARRAY_SIZE(thds)];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    ra[i].epochs = &epochs;
+    ra[i].current = &current;
+    ra[i].stop = &stop;
+    ra[i].start = &start;
+    ra[i].reads = 0;
+    thds[i] = grpc_core::Thread("grpc_reader_epochs_test", reader_thread,
+                                &ra[i]);
+    thds[i].Start();
+  }
+  gpr_event_set(&start, (void*)1);
+  size_t spins = 0;
+  for (size_t version = 1; version <= WRITER_ITERATIONS; version++) {
+    object* old = reinterpret_cast<object*>(gpr_atm_no_barrier_load(&current));
+    object* replacement = new object{LIVE_MAGIC, version};
+    gpr_atm_rel_store(&current, reinterpret_cast<gpr_atm>(replacement));
+    epochs.Flip();
+    while (!epochs.PreviousEpochDone()) {
+      spins++;
+    }
+    old->magic = FREED_MAGIC;
+    delete old;
+  }
+  gpr_atm_rel_store(&stop, 1);
+  size_t reads = 0;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    thds[i].Join();
+    reads += ra[i].reads;
+  }
+  gpr_log(GPR_DEBUG, "reads: %" PRIuPTR " spins: %" PRIuPTR, reads, spins);
+  delete reinterpret_cast<object*>(gpr_atm_no_barrier_load(&current));
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  test_single_thread();
+  test_mt();
+  return 0;
+}
@@ -53,5 +53,12 @@ int main(int /*argc*/, char* /*argv*/ []) {
   // and sanity checks the server_ssl_test.
   const char* fake_alpn_list[] = {"foo"};
   GPR_ASSERT(!server_ssl_test(fake_alpn_list, 1, "foo"));
+  // Handshake succeeds when the server runs it on the handshaker executor.
+  grpc_arg offload_arg;
+  offload_arg.type = GRPC_ARG_INTEGER;
+  offload_arg.key = const_cast<char*>(GRPC_ARG_HANDSHAKER_OFFLOAD);
+  offload_arg.value.integer = 1;
+  grpc_channel_args offload_args = {1, &offload_arg};
+  GPR_ASSERT(server_ssl_test(full_alpn_list, 2, "grpc-exp", &offload_args));
   return 0;
 }
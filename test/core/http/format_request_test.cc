@@ -39,7 +39,7 @@ static void test_format_get_request(void) {
   GPR_ASSERT(0 == grpc_slice_str_cmp(slice,
                                      "GET /index.html HTTP/1.0\r\n"
                                      "Host: example.com\r\n"
-                                     "Connection: close\r\n"
+                                     "Connection: keep-alive\r\n"
                                      "User-Agent: " GRPC_HTTPCLI_USER_AGENT
                                      "\r\n"
                                      "x-yz: abc\r\n"
@@ -66,7 +66,7 @@ static void test_format_post_request(void) {
   GPR_ASSERT(0 == grpc_slice_str_cmp(slice,
                                      "POST /index.html HTTP/1.0\r\n"
                                      "Host: example.com\r\n"
-                                     "Connection: close\r\n"
+                                     "Connection: keep-alive\r\n"
                                      "User-Agent: " GRPC_HTTPCLI_USER_AGENT
                                      "\r\n"
                                      "x-yz: abc\r\n"
@@ -94,7 +94,7 @@ static void test_format_post_request_no_body(void) {
   GPR_ASSERT(0 == grpc_slice_str_cmp(slice,
                                      "POST /index.html HTTP/1.0\r\n"
                                      "Host: example.com\r\n"
-                                     "Connection: close\r\n"
+                                     "Connection: keep-alive\r\n"
                                      "User-Agent: " GRPC_HTTPCLI_USER_AGENT
                                      "\r\n"
                                      "x-yz: abc\r\n"
@@ -126,7 +126,7 @@ static void test_format_post_request_content_type_override(void) {
                       slice,
                       "POST /index.html HTTP/1.0\r\n"
                       "Host: example.com\r\n"
-                      "Connection: close\r\n"
+                      "Connection: keep-alive\r\n"
                       "User-Agent: " GRPC_HTTPCLI_USER_AGENT "\r\n"
                       "x-yz: abc\r\n"
                       "Content-Type: application/x-www-form-urlencoded\r\n"
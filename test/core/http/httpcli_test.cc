@@ -26,6 +26,7 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "test/core/util/port.h"
 #include "test/core/util/subprocess.h"
@@ -53,7 +54,7 @@ static void on_finish(void* arg, grpc_error* error) {
   GPR_ASSERT(response->body_length == strlen(expect));
   GPR_ASSERT(0 == memcmp(expect, response->body, response->body_length));
   gpr_mu_lock(g_mu);
-  g_done = 1;
+  g_done++;
   GPR_ASSERT(GRPC_LOG_IF_ERROR(
       "pollset_kick",
       grpc_pollset_kick(grpc_polling_entity_pollset(&g_pops), nullptr)));
@@ -138,6 +139,52 @@ static void test_post(int port) {
   grpc_http_response_destroy(&response);
 }
 
+/* Identical GETs made together both get the response. */
+static void test_get_coalesced(int port) {
+  grpc_httpcli_request req;
+  char* host;
+  grpc_core::ExecCtx exec_ctx;
+
+  g_done = 0;
+  gpr_log(GPR_INFO, "test_get_coalesced");
+
+  gpr_asprintf(&host, "localhost:%d", port);
+  gpr_log(GPR_INFO, "requesting from %s", host);
+
+  memset(&req, 0, sizeof(req));
+  req.host = host;
+  req.http.path = const_cast<char*>("/get");
+  req.handshaker = &grpc_httpcli_plaintext;
+
+  grpc_http_response responses[2];
+  grpc_resource_quota* resource_quota =
+      grpc_resource_quota_create("test_get_coalesced");
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(responses); i++) {
+    responses[i] = {};
+    grpc_httpcli_get(&g_context, &g_pops, resource_quota, &req,
+                     n_seconds_time(15),
+                     GRPC_CLOSURE_CREATE(on_finish, &responses[i],
+                                         grpc_schedule_on_exec_ctx),
+                     &responses[i]);
+  }
+  grpc_resource_quota_unref_internal(resource_quota);
+  gpr_mu_lock(g_mu);
+  while (g_done < 2) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(grpc_polling_entity_pollset(&g_pops),
+                                          &worker, n_seconds_time(1))));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  gpr_free(host);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(responses); i++) {
+    grpc_http_response_destroy(&responses[i]);
+  }
+}
+
 static void destroy_pops(void* p, grpc_error* /*error*/) {
   grpc_pollset_destroy(
       grpc_polling_entity_pollset(static_cast<grpc_polling_entity*>(p)));
@@ -202,6 +249,7 @@ int main(int argc, char** argv) {
 
     test_get(port);
     test_post(port);
+    test_get_coalesced(port);
 
     grpc_httpcli_context_destroy(&g_context);
     GRPC_CLOSURE_INIT(&destroyed, destroy_pops, &g_pops,
@@ -18,6 +18,8 @@
 
 #include "src/core/lib/iomgr/combiner.h"
 
+#include <string.h>
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -136,6 +138,32 @@ static void test_execute_finally(void) {
   GRPC_COMBINER_UNREF(lock, "test_execute_finally");
 }
 
+static void test_profiling(void) {
+  gpr_log(GPR_DEBUG, "test_profiling");
+
+  GPR_GLOBAL_CONFIG_SET(grpc_combiner_profiling, true);
+  grpc_combiner_global_init();
+  grpc_core::Combiner* lock = grpc_combiner_create("test");
+  GPR_ASSERT(lock->profile != nullptr);
+  GPR_ASSERT(strcmp(lock->profile->name(), "test") == 0);
+  grpc_core::ExecCtx exec_ctx;
+  gpr_event_init(&got_in_finally);
+  lock->Run(GRPC_CLOSURE_CREATE(add_finally, lock, nullptr), GRPC_ERROR_NONE);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(gpr_event_wait(&got_in_finally,
+                            grpc_timeout_seconds_to_deadline(5)) != nullptr);
+  // The closure and the one it added to the final list.
+  grpc_core::UniquePtr<char> summary = lock->profile->Summary();
+  gpr_log(GPR_DEBUG, "summary: %s", summary.get());
+  GPR_ASSERT(strncmp(summary.get(), "closures=2 ", 11) == 0);
+  GRPC_COMBINER_UNREF(lock, "test_profiling");
+  GPR_GLOBAL_CONFIG_SET(grpc_combiner_profiling, false);
+  grpc_combiner_global_init();
+  lock = grpc_combiner_create("test");
+  GPR_ASSERT(lock->profile == nullptr);
+  GRPC_COMBINER_UNREF(lock, "test_profiling");
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -143,6 +171,7 @@ int main(int argc, char** argv) {
   test_execute_one();
   test_execute_finally();
   test_execute_many();
+  test_profiling();
   grpc_shutdown();
 
   return 0;
@@ -214,6 +214,47 @@ static void test_overflow() {
   ;
 }
 
+static void test_status_only() {
+  static grpc_error_status_only status_only =
+      GRPC_ERROR_STATUS_ONLY_INIT("Test", GRPC_STATUS_UNAVAILABLE);
+  grpc_error* error = grpc_error_from_status_only(&status_only);
+  GPR_ASSERT(grpc_error_is_special(error));
+  GPR_ASSERT(grpc_error_is_status_only(error));
+  GPR_ASSERT(!grpc_error_is_status_only(GRPC_ERROR_OOM));
+  GPR_ASSERT(GRPC_ERROR_REF(error) == error);
+  GRPC_ERROR_UNREF(error);
+
+  intptr_t i;
+  GPR_ASSERT(grpc_error_get_int(error, GRPC_ERROR_INT_GRPC_STATUS, &i));
+  GPR_ASSERT(i == GRPC_STATUS_UNAVAILABLE);
+  GPR_ASSERT(!grpc_error_get_int(error, GRPC_ERROR_INT_HTTP2_ERROR, &i));
+  grpc_slice str;
+  GPR_ASSERT(grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &str));
+  GPR_ASSERT(grpc_slice_str_cmp(str, "Test") == 0);
+  GPR_ASSERT(!grpc_error_get_str(error, GRPC_ERROR_STR_GRPC_MESSAGE, &str));
+
+  const char* s = grpc_error_string(error);
+  GPR_ASSERT(strcmp(s, "{\"description\":\"Test\",\"grpc_status\":14}") ==
+             0);
+  GPR_ASSERT(grpc_error_string(error) == s);
+
+  // Adding to a status-only error upgrades it, leaving the original alone.
+  grpc_error* full = grpc_error_set_int(error, GRPC_ERROR_INT_ERRNO, 42);
+  GPR_ASSERT(!grpc_error_is_special(full));
+  GPR_ASSERT(grpc_error_get_int(full, GRPC_ERROR_INT_GRPC_STATUS, &i));
+  GPR_ASSERT(i == GRPC_STATUS_UNAVAILABLE);
+  GPR_ASSERT(grpc_error_get_int(full, GRPC_ERROR_INT_ERRNO, &i));
+  GPR_ASSERT(i == 42);
+  GPR_ASSERT(grpc_error_get_str(full, GRPC_ERROR_STR_DESCRIPTION, &str));
+  GPR_ASSERT(grpc_slice_str_cmp(str, "Test") == 0);
+  GPR_ASSERT(!grpc_error_get_int(error, GRPC_ERROR_INT_ERRNO, &i));
+
+  // And it may be referenced by a full error.
+  full = grpc_error_add_child(full, error);
+  GPR_ASSERT(strstr(grpc_error_string(full), s) != nullptr);
+  GRPC_ERROR_UNREF(full);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -226,6 +267,7 @@ int main(int argc, char** argv) {
   test_create_referencing();
   test_create_referencing_many();
   test_overflow();
+  test_status_only();
   grpc_shutdown();
 
   return 0;
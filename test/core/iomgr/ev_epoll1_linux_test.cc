@@ -0,0 +1,171 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/iomgr/port.h"
+
+/* This test only relevant on linux systems where epoll() is available */
+#ifdef GRPC_LINUX_EPOLL
+#include "src/core/lib/iomgr/ev_epoll1_linux.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <string.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "test/core/util/test_config.h"
+
+/* Longer than any of the tests should take, so that workers only return
+   early if they are kicked. */
+#define WORK_DEADLINE_MS 20000
+#define NUM_WORKERS 4
+
+typedef struct {
+  gpr_mu* mu;
+  grpc_pollset* pollset;
+  grpc_millis deadline_ms;
+  /* Guarded by mu */
+  bool done;
+  int returned;
+} workers_state;
+
+static void pollset_destroy(void* ps, grpc_error* /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(ps));
+  gpr_free(ps);
+}
+
+static void workers_state_init(workers_state* s, grpc_millis deadline_ms) {
+  s->pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  grpc_pollset_init(s->pollset, &s->mu);
+  s->deadline_ms = deadline_ms;
+  s->done = false;
+  s->returned = 0;
+}
+
+static void workers_state_destroy(workers_state* s) {
+  grpc_closure ps_destroy_closure;
+  GRPC_CLOSURE_INIT(&ps_destroy_closure, pollset_destroy, s->pollset,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(s->mu);
+  grpc_pollset_shutdown(s->pollset, &ps_destroy_closure);
+  gpr_mu_unlock(s->mu);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+/* Works on the pollset until done is set: one of the workers polls, the
+   others wait in line for a kick. */
+static void worker_thread(void* arg) {
+  workers_state* s = static_cast<workers_state*>(arg);
+  grpc_core::ExecCtx exec_ctx;
+  gpr_mu_lock(s->mu);
+  do {
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(s->pollset, nullptr,
+                          grpc_core::ExecCtx::Get()->Now() + s->deadline_ms)));
+  } while (!s->done);
+  s->returned++;
+  gpr_mu_unlock(s->mu);
+}
+
+static void start_workers(workers_state* s, grpc_core::Thread* thds) {
+  for (size_t i = 0; i < NUM_WORKERS; i++) {
+    thds[i] = grpc_core::Thread("grpc_ev_epoll1_linux_test", worker_thread, s);
+    thds[i].Start();
+  }
+}
+
+/* Every worker, the waiting ones included, returns once it is kicked. */
+static void test_kick_waiting_workers() {
+  gpr_log(GPR_DEBUG, "test_kick_waiting_workers");
+  grpc_core::ExecCtx exec_ctx;
+  workers_state s;
+  workers_state_init(&s, WORK_DEADLINE_MS);
+  grpc_core::Thread thds[NUM_WORKERS];
+  start_workers(&s, thds);
+  /* Let the workers line up */
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  gpr_mu_lock(s.mu);
+  s.done = true;
+  while (s.returned < NUM_WORKERS) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR("pollset_kick",
+                                 grpc_pollset_kick(s.pollset, nullptr)));
+    gpr_mu_unlock(s.mu);
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+    gpr_mu_lock(s.mu);
+  }
+  gpr_mu_unlock(s.mu);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    thds[i].Join();
+  }
+  workers_state_destroy(&s);
+}
+
+/* Waiting workers that are not kicked return at their deadline. */
+static void test_waiting_workers_deadline() {
+  gpr_log(GPR_DEBUG, "test_waiting_workers_deadline");
+  grpc_core::ExecCtx exec_ctx;
+  workers_state s;
+  workers_state_init(&s, 100);
+  s.done = true;
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_core::Thread thds[NUM_WORKERS];
+  start_workers(&s, thds);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    thds[i].Join();
+  }
+  gpr_timespec elapsed = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start);
+  GPR_ASSERT(gpr_time_cmp(elapsed, gpr_time_from_seconds(10, GPR_TIMESPAN)) <
+             0);
+  GPR_ASSERT(s.returned == NUM_WORKERS);
+  workers_state_destroy(&s);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  /* Once as by default, and once with waiting workers spinning for longer
+     than it takes to kick them. */
+  const int32_t spin_us[] = {0, 100000};
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(spin_us); i++) {
+    GPR_GLOBAL_CONFIG_SET(grpc_epoll1_worker_spin_us, spin_us[i]);
+    grpc_init();
+    {
+      grpc_core::ExecCtx exec_ctx;
+      const char* poll_strategy = grpc_get_poll_strategy_name();
+      if (poll_strategy != nullptr && strcmp(poll_strategy, "epoll1") == 0) {
+        gpr_log(GPR_INFO, "worker spin: %d us", spin_us[i]);
+        test_kick_waiting_workers();
+        test_waiting_workers_deadline();
+      } else {
+        gpr_log(GPR_INFO,
+                "Skipping the test. The test is only relevant for 'epoll1' "
+                "strategy. and the current strategy is: '%s'",
+                poll_strategy);
+      }
+    }
+    grpc_shutdown_blocking();
+  }
+  return 0;
+}
+#else /* GRPC_LINUX_EPOLL */
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+#endif
@@ -25,6 +25,7 @@
 #include <string.h>
 #include <sys/eventfd.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "test/core/util/test_config.h"
 
 static void pollset_destroy(void* ps, grpc_error* /*error*/) {
@@ -90,15 +91,78 @@ static void test_pollable_owner_fd() {
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static void on_readable(void* arg, grpc_error* /*error*/) {
+  *static_cast<bool*>(arg) = true;
+}
+
+// Events of an fd are handled on the NUMA node of the pollset it was added to
+// by a thread polling that pollset.
+static void test_numa_affinity() {
+  grpc_core::ExecCtx exec_ctx;
+  GPR_ASSERT(grpc_epollex_numa_node_count() > 0);
+
+  int ev_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (ev_fd < 0) {
+    gpr_log(GPR_ERROR, "Error in creating event fd for the test");
+    return;
+  }
+  grpc_fd* fd = grpc_fd_create(ev_fd, "epollex-test-numa-fd", false);
+  gpr_mu* mu;
+  grpc_pollset* ps =
+      static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  grpc_pollset_init(ps, &mu);
+  grpc_pollset_add_fd(ps, fd);
+
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+  bool readable = false;
+  grpc_closure on_readable_closure;
+  GRPC_CLOSURE_INIT(&on_readable_closure, on_readable, &readable,
+                    grpc_schedule_on_exec_ctx);
+  grpc_fd_notify_on_read(fd, &on_readable_closure);
+  GPR_ASSERT(eventfd_write(ev_fd, 1) == 0);
+  grpc_millis deadline = grpc_core::ExecCtx::Get()->Now() + 5000;
+  gpr_mu_lock(mu);
+  while (!readable && grpc_core::ExecCtx::Get()->Now() < deadline) {
+    GPR_ASSERT(GRPC_LOG_IF_ERROR("pollset_work",
+                                 grpc_pollset_work(ps, nullptr, deadline)));
+    gpr_mu_unlock(mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(mu);
+  }
+  gpr_mu_unlock(mu);
+  GPR_ASSERT(readable);
+
+  // Polling ps pinned this thread to the node of ps.
+  GPR_ASSERT(grpc_pollset_is_local(ps));
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  GPR_ASSERT(after.counters[GRPC_STATS_COUNTER_POLLSET_NUMA_LOCAL_WAKEUPS] >
+             before.counters[GRPC_STATS_COUNTER_POLLSET_NUMA_LOCAL_WAKEUPS]);
+  GPR_ASSERT(after.counters[GRPC_STATS_COUNTER_POLLSET_NUMA_REMOTE_WAKEUPS] ==
+             before.counters[GRPC_STATS_COUNTER_POLLSET_NUMA_REMOTE_WAKEUPS]);
+
+  grpc_fd_orphan(fd, nullptr, nullptr, "test numa fd orphan");
+  grpc_closure ps_destroy_closure;
+  GRPC_CLOSURE_INIT(&ps_destroy_closure, pollset_destroy, ps,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(mu);
+  grpc_pollset_shutdown(ps, &ps_destroy_closure);
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 int main(int argc, char** argv) {
   const char* poll_strategy = nullptr;
   grpc::testing::TestEnvironment env(argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_epollex_numa_affinity, true);
   grpc_init();
   {
     grpc_core::ExecCtx exec_ctx;
     poll_strategy = grpc_get_poll_strategy_name();
     if (poll_strategy != nullptr && strcmp(poll_strategy, "epollex") == 0) {
       test_pollable_owner_fd();
+      test_numa_affinity();
     } else {
       gpr_log(GPR_INFO,
               "Skipping the test. The test is only relevant for 'epollex' "
@@ -0,0 +1,136 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "test/core/util/test_config.h"
+
+using grpc_core::ExecCtx;
+
+namespace {
+
+// Records the order in which closures ran.
+struct Trace {
+  int order[256];
+  int count = 0;
+};
+
+struct Step {
+  grpc_closure closure;
+  Trace* trace;
+  int id;
+  // If set, scheduled on the latency lane when this step runs.
+  Step* then = nullptr;
+  // Number of times this step reschedules itself on the latency lane.
+  int repeats = 0;
+};
+
+void record(void* arg, grpc_error* /*error*/) {
+  Step* step = static_cast<Step*>(arg);
+  GPR_ASSERT(step->trace->count < 256);
+  step->trace->order[step->trace->count++] = step->id;
+  if (step->then != nullptr) {
+    ExecCtx::Run(DEBUG_LOCATION, &step->then->closure, GRPC_ERROR_NONE,
+                 ExecCtx::ClosureLane::kLatency);
+  }
+  if (step->repeats > 0) {
+    --step->repeats;
+    ExecCtx::Run(DEBUG_LOCATION, &step->closure, GRPC_ERROR_NONE,
+                 ExecCtx::ClosureLane::kLatency);
+  }
+}
+
+void init_step(Step* step, Trace* trace, int id) {
+  GRPC_CLOSURE_INIT(&step->closure, record, step, grpc_schedule_on_exec_ctx);
+  step->trace = trace;
+  step->id = id;
+}
+
+}  // namespace
+
+static void test_latency_runs_first(void) {
+  gpr_log(GPR_DEBUG, "test_latency_runs_first");
+  Trace trace;
+  Step steps[4];
+  for (int i = 0; i < 4; i++) init_step(&steps[i], &trace, i);
+  grpc_core::ExecCtx exec_ctx;
+  ExecCtx::Run(DEBUG_LOCATION, &steps[0].closure, GRPC_ERROR_NONE);
+  ExecCtx::Run(DEBUG_LOCATION, &steps[1].closure, GRPC_ERROR_NONE);
+  ExecCtx::Run(DEBUG_LOCATION, &steps[2].closure, GRPC_ERROR_NONE,
+               ExecCtx::ClosureLane::kLatency);
+  ExecCtx::Run(DEBUG_LOCATION, &steps[3].closure, GRPC_ERROR_NONE,
+               ExecCtx::ClosureLane::kLatency);
+  ExecCtx::Get()->Flush();
+  GPR_ASSERT(trace.count == 4);
+  GPR_ASSERT(trace.order[0] == 2);
+  GPR_ASSERT(trace.order[1] == 3);
+  GPR_ASSERT(trace.order[2] == 0);
+  GPR_ASSERT(trace.order[3] == 1);
+}
+
+static void test_latency_preempts_bulk_batch(void) {
+  gpr_log(GPR_DEBUG, "test_latency_preempts_bulk_batch");
+  Trace trace;
+  Step steps[4];
+  for (int i = 0; i < 4; i++) init_step(&steps[i], &trace, i);
+  // Bulk step 0 schedules latency step 3, which must run before bulk steps 1
+  // and 2 even though they were queued first.
+  steps[0].then = &steps[3];
+  grpc_core::ExecCtx exec_ctx;
+  for (int i = 0; i < 3; i++) {
+    ExecCtx::Run(DEBUG_LOCATION, &steps[i].closure, GRPC_ERROR_NONE);
+  }
+  ExecCtx::Get()->Flush();
+  GPR_ASSERT(trace.count == 4);
+  GPR_ASSERT(trace.order[0] == 0);
+  GPR_ASSERT(trace.order[1] == 3);
+  GPR_ASSERT(trace.order[2] == 1);
+  GPR_ASSERT(trace.order[3] == 2);
+}
+
+static void test_bulk_is_not_starved(void) {
+  gpr_log(GPR_DEBUG, "test_bulk_is_not_starved");
+  Trace trace;
+  Step latency;
+  Step bulk;
+  init_step(&latency, &trace, 0);
+  init_step(&bulk, &trace, 1);
+  latency.repeats = 3 * ExecCtx::kMaxLatencyBurst;
+  grpc_core::ExecCtx exec_ctx;
+  ExecCtx::Run(DEBUG_LOCATION, &bulk.closure, GRPC_ERROR_NONE);
+  ExecCtx::Run(DEBUG_LOCATION, &latency.closure, GRPC_ERROR_NONE,
+               ExecCtx::ClosureLane::kLatency);
+  ExecCtx::Get()->Flush();
+  GPR_ASSERT(trace.count == 3 * ExecCtx::kMaxLatencyBurst + 2);
+  for (int i = 0; i < trace.count; i++) {
+    GPR_ASSERT(trace.order[i] == (i == ExecCtx::kMaxLatencyBurst ? 1 : 0));
+  }
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  test_latency_runs_first();
+  test_latency_preempts_bulk_batch();
+  test_bulk_is_not_starved();
+  grpc_shutdown();
+  return 0;
+}
@@ -147,6 +147,28 @@ static void test_unix_socket(void) {
   args_finish(&args);
 }
 
+// Lookups of the same name made while one is in progress share it, and each
+// gets its own copy of the addresses.
+static void test_concurrent_lookups_of_same_name(void) {
+  grpc_core::ExecCtx exec_ctx;
+  args_struct args1;
+  args_init(&args1);
+  args_struct args2;
+  args_init(&args2);
+  poll_pollset_until_request_done(&args1);
+  poll_pollset_until_request_done(&args2);
+  grpc_resolve_address(
+      "localhost:1", nullptr, args1.pollset_set,
+      GRPC_CLOSURE_CREATE(must_succeed, &args1, grpc_schedule_on_exec_ctx),
+      &args1.addrs);
+  grpc_resolve_address(
+      "localhost:1", nullptr, args2.pollset_set,
+      GRPC_CLOSURE_CREATE(must_succeed, &args2, grpc_schedule_on_exec_ctx),
+      &args2.addrs);
+  args_finish(&args1);
+  args_finish(&args2);
+}
+
 static void test_unix_socket_path_name_too_long(void) {
   grpc_core::ExecCtx exec_ctx;
   args_struct args;
@@ -253,6 +275,7 @@ int main(int argc, char** argv) {
     if (gpr_stricmp(resolver.get(), "native") == 0) {
       test_unix_socket();
       test_unix_socket_path_name_too_long();
+      test_concurrent_lookups_of_same_name();
     }
   }
   gpr_cmdline_destroy(cl);
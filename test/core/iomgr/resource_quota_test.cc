@@ -18,9 +18,12 @@
 
 #include "src/core/lib/iomgr/resource_quota.h"
 
+#include <string.h>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
@@ -715,6 +718,49 @@ static void test_one_slice(void) {
   grpc_resource_quota_unref(q);
 }
 
+static void test_confined_slices(void) {
+  gpr_log(GPR_INFO, "** test_confined_slices **");
+
+  grpc_resource_quota* q = grpc_resource_quota_create("test_confined_slices");
+  grpc_resource_quota_resize(q, 1024);
+
+  grpc_resource_user* usr = grpc_resource_user_create(q, "usr");
+
+  grpc_resource_user_slice_allocator alloc;
+  int num_allocs = 0;
+  grpc_resource_user_slice_allocator_init(&alloc, usr, inc_int_cb, &num_allocs);
+  alloc.confined = true;
+
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+
+  {
+    const int start_allocs = num_allocs;
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc_slices(&alloc, 512, 2, &buffer));
+    grpc_core::ExecCtx::Get()->Flush();
+    assert_counter_becomes(&num_allocs, start_allocs + 1);
+  }
+
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(buffer.count == 2);
+    GPR_ASSERT(buffer.slices[0].refcount->confined());
+    GPR_ASSERT(buffer.slices[1].refcount->confined());
+    grpc_slice sub = grpc_slice_sub(buffer.slices[0], 0, 256);
+    GPR_ASSERT(sub.refcount->confined());
+    grpc_slice_publish(sub);
+    GPR_ASSERT(!buffer.slices[0].refcount->confined());
+    GPR_ASSERT(buffer.slices[1].refcount->confined());
+    grpc_slice_buffer_publish(&buffer);
+    GPR_ASSERT(!buffer.slices[1].refcount->confined());
+    grpc_slice_buffer_destroy_internal(&buffer);
+    grpc_slice_unref_internal(sub);
+  }
+  destroy_user(usr);
+  grpc_resource_quota_unref(q);
+}
+
 static void test_one_slice_deleted_late(void) {
   gpr_log(GPR_INFO, "** test_one_slice_deleted_late **");
 
@@ -751,6 +797,147 @@ static void test_one_slice_deleted_late(void) {
   }
 }
 
+static void test_recycled_slices(void) {
+  gpr_log(GPR_INFO, "** test_recycled_slices **");
+
+  grpc_resource_quota* q = grpc_resource_quota_create("test_recycled_slices");
+  grpc_resource_quota_resize(q, 64 * 1024);
+
+  grpc_resource_user* usr = grpc_resource_user_create(q, "usr");
+
+  grpc_resource_user_slice_allocator alloc;
+  int num_allocs = 0;
+  grpc_resource_user_slice_allocator_init(&alloc, usr, inc_int_cb, &num_allocs);
+
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+
+  // Cycle through sizes on both sides of the cached size classes, so the
+  // quota only balances if reused buffers are charged like fresh ones.
+  const size_t sizes[] = {1, 256, 257, 1000, 4096, 8192, 16384 + 1, 65536};
+  for (int round = 0; round < 10; round++) {
+    for (size_t size : sizes) {
+      const size_t count = GPR_MAX(1, 32 * 1024 / size);
+      {
+        const int start_allocs = num_allocs;
+        grpc_core::ExecCtx exec_ctx;
+        if (!grpc_resource_user_alloc_slices(&alloc, size, count, &buffer)) {
+          grpc_core::ExecCtx::Get()->Flush();
+          assert_counter_becomes(&num_allocs, start_allocs + 1);
+        }
+      }
+      GPR_ASSERT(buffer.count == count);
+      GPR_ASSERT(buffer.length == size * count);
+      for (size_t i = 0; i < buffer.count; i++) {
+        memset(GRPC_SLICE_START_PTR(buffer.slices[i]), round, size);
+      }
+      {
+        grpc_core::ExecCtx exec_ctx;
+        grpc_slice_buffer_reset_and_unref_internal(&buffer);
+      }
+    }
+  }
+
+  // A freed block is handed out again for the next slice of its size class.
+  // The free lists are per cpu, so retry in case this thread moved to another
+  // cpu between the free and the allocation.
+  bool reused = false;
+  for (int attempt = 0; attempt < 100 && !reused; attempt++) {
+    uint8_t* freed = nullptr;
+    for (int i = 0; i < 2; i++) {
+      {
+        const int start_allocs = num_allocs;
+        grpc_core::ExecCtx exec_ctx;
+        if (!grpc_resource_user_alloc_slices(&alloc, 1000, 1, &buffer)) {
+          grpc_core::ExecCtx::Get()->Flush();
+          assert_counter_becomes(&num_allocs, start_allocs + 1);
+        }
+      }
+      uint8_t* data = GRPC_SLICE_START_PTR(buffer.slices[0]);
+      if (i == 0) {
+        freed = data;
+      } else {
+        reused = data == freed;
+      }
+      {
+        grpc_core::ExecCtx exec_ctx;
+        grpc_slice_buffer_reset_and_unref_internal(&buffer);
+      }
+      GPR_ASSERT(grpc_resource_user_slice_cache_size_for_testing() >= 1024);
+    }
+  }
+  GPR_ASSERT(reused);
+
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer_destroy_internal(&buffer);
+  }
+  destroy_user(usr);
+  grpc_resource_quota_unref(q);
+}
+
+static void test_slices_charged_for_capacity(void) {
+  gpr_log(GPR_INFO, "** test_slices_charged_for_capacity **");
+
+  grpc_resource_quota* q =
+      grpc_resource_quota_create("test_slices_charged_for_capacity");
+  grpc_resource_quota_resize(q, 1024);
+
+  grpc_resource_user* usr = grpc_resource_user_create(q, "usr");
+
+  grpc_resource_user_slice_allocator alloc;
+  int num_allocs = 0;
+  grpc_resource_user_slice_allocator_init(&alloc, usr, inc_int_cb, &num_allocs);
+
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  grpc_slice_buffer pending;
+  grpc_slice_buffer_init(&pending);
+
+  // Leave a freed block in the cache.
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc_slices(&alloc, 256, 1, &buffer));
+    grpc_core::ExecCtx::Get()->Flush();
+    assert_counter_becomes(&num_allocs, 1);
+    grpc_slice_buffer_reset_and_unref_internal(&buffer);
+  }
+  GPR_ASSERT(grpc_resource_user_slice_cache_size_for_testing() > 0);
+
+  // 600 bytes take a 1024 byte block, which uses up the whole quota.
+  {
+    grpc_core::ExecCtx exec_ctx;
+    if (!grpc_resource_user_alloc_slices(&alloc, 600, 1, &buffer)) {
+      grpc_core::ExecCtx::Get()->Flush();
+    }
+    assert_counter_becomes(&num_allocs, 2);
+  }
+  GPR_ASSERT(buffer.length == 600);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc_slices(&alloc, 1, 1, &pending));
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  GPR_ASSERT(num_allocs == 2);
+  // Running short of memory empties the cache.
+  GPR_ASSERT(grpc_resource_user_slice_cache_size_for_testing() == 0);
+
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer_reset_and_unref_internal(&buffer);
+  }
+  assert_counter_becomes(&num_allocs, 3);
+  GPR_ASSERT(pending.length == 1);
+
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer_destroy_internal(&buffer);
+    grpc_slice_buffer_destroy_internal(&pending);
+  }
+  destroy_user(usr);
+  grpc_resource_quota_unref(q);
+}
+
 static void test_resize_to_zero(void) {
   gpr_log(GPR_INFO, "** test_resize_to_zero **");
   grpc_resource_quota* q = grpc_resource_quota_create("test_resize_to_zero");
@@ -891,6 +1078,74 @@ static void test_thread_maxquota_change() {
   grpc_resource_quota_unref(rq);
 }
 
+static void test_sharded_alloc_is_inline(void) {
+  gpr_log(GPR_INFO, "** test_sharded_alloc_is_inline **");
+  GPR_GLOBAL_CONFIG_SET(grpc_resource_quota_per_cpu_shards, true);
+  grpc_resource_quota* q =
+      grpc_resource_quota_create("test_sharded_alloc_is_inline");
+  GPR_GLOBAL_CONFIG_SET(grpc_resource_quota_per_cpu_shards, false);
+  grpc_resource_quota_resize(q, 1024 * 1024);
+  grpc_resource_user* usr1 = grpc_resource_user_create(q, "usr1");
+  grpc_resource_user* usr2 = grpc_resource_user_create(q, "usr2");
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(grpc_resource_user_alloc(usr1, 1024, nullptr));
+    grpc_resource_user_free(usr1, 1024);
+    GPR_ASSERT(grpc_resource_user_alloc(usr2, 1024, nullptr));
+    grpc_resource_user_free(usr2, 1024);
+  }
+  grpc_resource_quota_unref(q);
+  destroy_user(usr1);
+  destroy_user(usr2);
+}
+
+static void test_sharded_alloc_blocked_by_size(void) {
+  gpr_log(GPR_INFO, "** test_sharded_alloc_blocked_by_size **");
+  GPR_GLOBAL_CONFIG_SET(grpc_resource_quota_per_cpu_shards, true);
+  grpc_resource_quota* q =
+      grpc_resource_quota_create("test_sharded_alloc_blocked_by_size");
+  GPR_GLOBAL_CONFIG_SET(grpc_resource_quota_per_cpu_shards, false);
+  grpc_resource_quota_resize(q, 2048);
+  grpc_resource_user* usr1 = grpc_resource_user_create(q, "usr1");
+  grpc_resource_user* usr2 = grpc_resource_user_create(q, "usr2");
+  {
+    // Leaves some of the quota cached in the shard of this cpu
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(grpc_resource_user_alloc(usr1, 1024, nullptr));
+    grpc_resource_user_free(usr1, 1024);
+  }
+  {
+    // Needs all of the quota, including what the shard holds
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc(usr2, 2048, set_event(&ev)));
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               nullptr);
+  }
+  {
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc(usr1, 1024, set_event(&ev)));
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_milliseconds_to_deadline(
+                                       100)) == nullptr);
+    grpc_resource_user_free(usr2, 2048);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               nullptr);
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_resource_user_free(usr1, 1024);
+  }
+  grpc_resource_quota_unref(q);
+  destroy_user(usr1);
+  destroy_user(usr2);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -916,8 +1171,13 @@ int main(int argc, char** argv) {
   test_reclaimers_can_be_posted_repeatedly();
   test_one_slice();
   test_one_slice_deleted_late();
+  test_confined_slices();
+  test_recycled_slices();
+  test_slices_charged_for_capacity();
   test_resize_to_zero();
   test_negative_rq_free_pool();
+  test_sharded_alloc_is_inline();
+  test_sharded_alloc_blocked_by_size();
   gpr_mu_destroy(&g_mu);
   gpr_cv_destroy(&g_cv);
 
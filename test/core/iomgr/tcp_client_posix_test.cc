@@ -34,6 +34,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
@@ -136,6 +137,63 @@ void test_succeeds(void) {
   gpr_mu_unlock(g_mu);
 }
 
+/* With fast open the SYN waits for the first write, and without it the
+   listen backlog completes the handshake: either way the connect finishes
+   before the server accepts. */
+void test_fast_open(void) {
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr.addr);
+  int svr_fd;
+  int connections_complete_before;
+  grpc_closure done;
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_DEBUG, "test_fast_open");
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+
+  /* create a dummy server */
+  svr_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(svr_fd >= 0);
+  GPR_ASSERT(
+      0 == bind(svr_fd, (struct sockaddr*)addr, (socklen_t)resolved_addr.len));
+  GPR_ASSERT(0 == listen(svr_fd, 1));
+
+  gpr_mu_lock(g_mu);
+  connections_complete_before = g_connections_complete;
+  gpr_mu_unlock(g_mu);
+
+  /* connect to it */
+  GPR_ASSERT(getsockname(svr_fd, (struct sockaddr*)addr,
+                         (socklen_t*)&resolved_addr.len) == 0);
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_TCP_FAST_OPEN), 1);
+  grpc_channel_args args = {1, &arg};
+  GRPC_CLOSURE_INIT(&done, must_succeed, nullptr, grpc_schedule_on_exec_ctx);
+  grpc_tcp_client_connect(&done, &g_connecting, g_pollset_set, &args,
+                          &resolved_addr, GRPC_MILLIS_INF_FUTURE);
+
+  gpr_mu_lock(g_mu);
+
+  while (g_connections_complete == connections_complete_before) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(g_pollset, &worker,
+                          grpc_timespec_to_millis_round_up(
+                              grpc_timeout_seconds_to_deadline(5)))));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+
+  gpr_mu_unlock(g_mu);
+  close(svr_fd);
+}
+
 void test_fails(void) {
   grpc_resolved_address resolved_addr;
   struct sockaddr_in* addr =
@@ -203,6 +261,7 @@ int main(int argc, char** argv) {
 
     test_succeeds();
     gpr_log(GPR_ERROR, "End of first test");
+    test_fast_open();
     test_fails();
     grpc_pollset_set_destroy(g_pollset_set);
     GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
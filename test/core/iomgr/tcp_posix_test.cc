@@ -35,6 +35,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
@@ -198,7 +199,7 @@ static void read_cb(void* user_data, grpc_error* error) {
 }
 
 /* Write to a socket, then read from it using the grpc_tcp API. */
-static void read_test(size_t num_bytes, size_t slice_size) {
+static void read_test(size_t num_bytes, size_t slice_size, int busy_poll_us) {
   int sv[2];
   grpc_endpoint* ep;
   struct read_socket_state state;
@@ -207,16 +208,23 @@ static void read_test(size_t num_bytes, size_t slice_size) {
       grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  gpr_log(GPR_INFO, "Read test of size %" PRIuPTR ", slice size %" PRIuPTR,
-          num_bytes, slice_size);
+  gpr_log(GPR_INFO,
+          "Read test of size %" PRIuPTR ", slice size %" PRIuPTR
+          ", busy poll %dus",
+          num_bytes, slice_size, busy_poll_us);
 
   create_sockets(sv);
 
-  grpc_arg a[1];
+  grpc_arg a[2];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER,
   a[0].value.integer = static_cast<int>(slice_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_BUSY_POLL_US);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = busy_poll_us;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  grpc_stats_data stats_before;
+  grpc_stats_collect(&stats_before);
   ep =
       grpc_tcp_create(grpc_fd_create(sv[1], "read_test", false), &args, "test");
   grpc_endpoint_add_to_pollset(ep, g_pollset);
@@ -244,6 +252,20 @@ static void read_test(size_t num_bytes, size_t slice_size) {
   GPR_ASSERT(state.read_bytes == state.target_read_bytes);
   gpr_mu_unlock(g_mu);
 
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  /* The epoll1 engine busy polls while the endpoint is open */
+  if (busy_poll_us > 0 &&
+      strcmp(grpc_get_poll_strategy_name(), "epoll1") == 0) {
+    grpc_stats_data stats_after;
+    grpc_stats_collect(&stats_after);
+    GPR_ASSERT(
+        stats_after.counters[GRPC_STATS_COUNTER_BUSY_POLL_SPIN_HITS] +
+            stats_after.counters[GRPC_STATS_COUNTER_BUSY_POLL_SPIN_MISSES] >
+        stats_before.counters[GRPC_STATS_COUNTER_BUSY_POLL_SPIN_HITS] +
+            stats_before.counters[GRPC_STATS_COUNTER_BUSY_POLL_SPIN_MISSES]);
+  }
+#endif
+
   grpc_slice_buffer_destroy_internal(&state.incoming);
   grpc_endpoint_destroy(ep);
 }
@@ -472,6 +494,145 @@ static void write_test(size_t num_bytes, size_t slice_size,
   gpr_free(slices);
 }
 
+/* Write to a TCP socket with MSG_ZEROCOPY enabled, then drain it directly.
+   The write is expected to behave exactly like a copied write; when the kernel
+   or polling engine does not support zerocopy the endpoint falls back to
+   copying. */
+static void zerocopy_write_test(size_t num_bytes, size_t slice_size) {
+  int sv[2];
+  grpc_endpoint* ep;
+  struct write_socket_state state;
+  size_t num_blocks;
+  grpc_slice* slices;
+  uint8_t current_data = 0;
+  grpc_slice_buffer outgoing;
+  grpc_closure write_done_closure;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO,
+          "Start zerocopy write test with %" PRIuPTR
+          " bytes, slice size %" PRIuPTR,
+          num_bytes, slice_size);
+
+  create_inet_sockets(sv);
+
+  grpc_arg a[3];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = static_cast<int>(slice_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = 1;
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = 0;
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "zerocopy_write_test",
+                                      grpc_event_engine_can_track_errors()),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+  state.ep = ep;
+  state.write_done = 0;
+
+  slices = allocate_blocks(num_bytes, slice_size, &num_blocks, &current_data);
+
+  grpc_slice_buffer_init(&outgoing);
+  grpc_slice_buffer_addn(&outgoing, slices, num_blocks);
+  GRPC_CLOSURE_INIT(&write_done_closure, write_done, &state,
+                    grpc_schedule_on_exec_ctx);
+
+  grpc_endpoint_write(ep, &outgoing, &write_done_closure, nullptr);
+  /* The fd may already be writable when the endpoint first waits for it, in
+     which case the retry is scheduled on this exec_ctx and must run before we
+     block in drain_socket_blocking(). */
+  exec_ctx.Flush();
+  drain_socket_blocking(sv[0], num_bytes, num_bytes);
+  exec_ctx.Flush();
+  gpr_mu_lock(g_mu);
+  while (!state.write_done) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    exec_ctx.Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+
+  grpc_slice_buffer_destroy_internal(&outgoing);
+  grpc_endpoint_destroy(ep);
+  gpr_free(slices);
+}
+
+/* Write slices of mixed sizes, so that runs of small slices are interleaved
+   with large ones, then drain the socket directly. */
+static void coalesce_write_test(size_t num_bytes, int coalesce_threshold) {
+  static const size_t kSliceSizes[] = {9, 1, 100, 255, 256, 4096, 17, 65536};
+  int sv[2];
+  grpc_endpoint* ep;
+  struct write_socket_state state;
+  uint8_t current_data = 0;
+  grpc_slice_buffer outgoing;
+  grpc_closure write_done_closure;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO,
+          "Start coalesce write test with %" PRIuPTR " bytes, threshold %d",
+          num_bytes, coalesce_threshold);
+
+  create_sockets(sv);
+
+  grpc_arg a[1];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_TX_COALESCE_BYTES_THRESHOLD);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = coalesce_threshold;
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "coalesce_write_test", false),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+  state.ep = ep;
+  state.write_done = 0;
+
+  grpc_slice_buffer_init(&outgoing);
+  size_t num_bytes_left = num_bytes;
+  for (size_t i = 0; num_bytes_left > 0; ++i) {
+    size_t slice_size = GPR_MIN(kSliceSizes[i % GPR_ARRAY_SIZE(kSliceSizes)],
+                                num_bytes_left);
+    grpc_slice slice = grpc_slice_malloc(slice_size);
+    uint8_t* buf = GRPC_SLICE_START_PTR(slice);
+    for (size_t j = 0; j < slice_size; ++j) {
+      buf[j] = current_data++;
+    }
+    grpc_slice_buffer_add(&outgoing, slice);
+    num_bytes_left -= slice_size;
+  }
+  GRPC_CLOSURE_INIT(&write_done_closure, write_done, &state,
+                    grpc_schedule_on_exec_ctx);
+
+  grpc_endpoint_write(ep, &outgoing, &write_done_closure, nullptr);
+  drain_socket_blocking(sv[0], num_bytes, num_bytes);
+  exec_ctx.Flush();
+  gpr_mu_lock(g_mu);
+  while (!state.write_done) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    exec_ctx.Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+
+  grpc_slice_buffer_destroy_internal(&outgoing);
+  grpc_endpoint_destroy(ep);
+}
+
 void on_fd_released(void* arg, grpc_error* /*errors*/) {
   int* done = static_cast<int*>(arg);
   *done = 1;
@@ -560,10 +721,11 @@ static void release_fd_test(size_t num_bytes, size_t slice_size) {
 void run_tests(void) {
   size_t i = 0;
 
-  read_test(100, 8192);
-  read_test(10000, 8192);
-  read_test(10000, 137);
-  read_test(10000, 1);
+  read_test(100, 8192, 0);
+  read_test(10000, 8192, 0);
+  read_test(10000, 137, 0);
+  read_test(10000, 1, 0);
+  read_test(10000, 8192, 50);
   large_read_test(8192);
   large_read_test(1);
 
@@ -584,6 +746,16 @@ void run_tests(void) {
     write_test(40320, i, true);
   }
 
+  zerocopy_write_test(100, 8192);
+  zerocopy_write_test(100000, 8192);
+  zerocopy_write_test(100000, 137);
+  zerocopy_write_test(4 * 1024 * 1024, 65536);
+
+  coalesce_write_test(100, 256);
+  coalesce_write_test(1000000, 256);
+  coalesce_write_test(1000000, 16384);
+  coalesce_write_test(1000000, 0);
+
   release_fd_test(100, 8192);
 }
 
@@ -42,6 +42,7 @@
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 
@@ -221,6 +222,38 @@ static void test_no_op_with_port_and_start(void) {
   grpc_tcp_server_unref(s);
 }
 
+/* Several SO_REUSEPORT listeners per port, but no pollsets to spread them
+   over. */
+static void test_no_op_with_port_and_start_reuseport_listeners(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr.addr);
+  grpc_arg chan_args[1];
+  chan_args[0].type = GRPC_ARG_INTEGER;
+  chan_args[0].key = const_cast<char*>(GRPC_ARG_REUSEPORT_LISTENERS_PER_PORT);
+  chan_args[0].value.integer = 3;
+  const grpc_channel_args channel_args = {1, chan_args};
+  grpc_tcp_server* s;
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_create(nullptr, &channel_args, &s));
+  LOG_TEST("test_no_op_with_port_and_start_reuseport_listeners");
+  int port = -1;
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+  GPR_ASSERT(grpc_tcp_server_add_port(s, &resolved_addr, &port) ==
+                 GRPC_ERROR_NONE &&
+             port > 0);
+
+  grpc_tcp_server_start(s, nullptr, 0, on_connect, nullptr);
+  GPR_ASSERT(grpc_tcp_server_port_fd_count(s, 0) ==
+             (grpc_is_socket_reuse_port_supported() ? 3u : 1u));
+
+  grpc_tcp_server_unref(s);
+}
+
 static grpc_error* tcp_connect(const test_addr* remote,
                                on_connect_result* result) {
   grpc_millis deadline =
@@ -422,6 +455,132 @@ static void test_connect(size_t num_connects,
   GPR_ASSERT(weak_ref.server == nullptr);
 }
 
+/* Tests a tcp server with several SO_REUSEPORT listeners on a single port. The
+   kernel picks the listener of each connection, so only check that every
+   connection was accepted by one of them. */
+static void test_connect_reuseport_listeners(size_t num_connects) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr.addr);
+  grpc_arg chan_args[1];
+  chan_args[0].type = GRPC_ARG_INTEGER;
+  chan_args[0].key = const_cast<char*>(GRPC_ARG_REUSEPORT_LISTENERS_PER_PORT);
+  chan_args[0].value.integer = 3;
+  const grpc_channel_args channel_args = {1, chan_args};
+  grpc_tcp_server* s;
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_create(nullptr, &channel_args, &s));
+  LOG_TEST("test_connect_reuseport_listeners");
+  gpr_log(GPR_INFO, "clients=%lu", static_cast<unsigned long>(num_connects));
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int port = -1;
+  GPR_ASSERT(grpc_tcp_server_add_port(s, &resolved_addr, &port) ==
+                 GRPC_ERROR_NONE &&
+             port > 0);
+  GPR_ASSERT(grpc_tcp_server_port_fd_count(s, 0) == 1);
+
+  grpc_tcp_server_start(s, &g_pollset, 1, on_connect, nullptr);
+
+  const unsigned num_fds = grpc_tcp_server_port_fd_count(s, 0);
+  GPR_ASSERT(num_fds == (grpc_is_socket_reuse_port_supported() ? 3 : 1));
+  test_addr dst;
+  dst.addr = resolved_addr;
+  grpc_sockaddr_set_port(&dst.addr, port);
+  test_addr_init_str(&dst);
+  for (size_t connect_num = 0; connect_num < num_connects; ++connect_num) {
+    on_connect_result result;
+    on_connect_result_init(&result);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR("tcp_connect", tcp_connect(&dst, &result)));
+    GPR_ASSERT(result.server == s);
+    GPR_ASSERT(result.port_index == 0);
+    GPR_ASSERT(result.fd_index < num_fds);
+    GPR_ASSERT(result.server_fd >= 0);
+  }
+
+  grpc_tcp_server_unref(s);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+/* Like on_connect, without keeping a result: many connections come in
+   between checks. */
+static void on_connect_count(void* /*arg*/, grpc_endpoint* tcp,
+                             grpc_pollset* /*pollset*/,
+                             grpc_tcp_server_acceptor* acceptor) {
+  grpc_endpoint_shutdown(tcp,
+                         GRPC_ERROR_CREATE_FROM_STATIC_STRING("Connected"));
+  grpc_endpoint_destroy(tcp);
+  gpr_free(acceptor);
+
+  gpr_mu_lock(g_mu);
+  g_nconnects++;
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+/* Tests that a backlog of more connections than a listener accepts per wakeup
+   is still accepted in full. */
+static void test_connect_burst(size_t num_connects) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr.addr);
+  grpc_tcp_server* s;
+  GPR_ASSERT(GRPC_ERROR_NONE == grpc_tcp_server_create(nullptr, nullptr, &s));
+  LOG_TEST("test_connect_burst");
+  gpr_log(GPR_INFO, "clients=%lu", static_cast<unsigned long>(num_connects));
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int port = -1;
+  GPR_ASSERT(grpc_tcp_server_add_port(s, &resolved_addr, &port) ==
+                 GRPC_ERROR_NONE &&
+             port > 0);
+  grpc_sockaddr_set_port(&resolved_addr, port);
+
+  /* Queue up every connection before the server starts accepting. */
+  int* clifds = static_cast<int*>(gpr_malloc(sizeof(int) * num_connects));
+  for (size_t i = 0; i < num_connects; ++i) {
+    clifds[i] = socket(AF_INET, SOCK_STREAM, 0);
+    GPR_ASSERT(clifds[i] >= 0);
+    GPR_ASSERT(connect(clifds[i], (struct sockaddr*)addr,
+                       (socklen_t)resolved_addr.len) == 0);
+  }
+  gpr_mu_lock(g_mu);
+  const int nconnects_before = g_nconnects;
+  gpr_mu_unlock(g_mu);
+  grpc_tcp_server_start(s, &g_pollset, 1, on_connect_count, nullptr);
+
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(10));
+  gpr_mu_lock(g_mu);
+  while (g_nconnects - nconnects_before < static_cast<int>(num_connects) &&
+         deadline > grpc_core::ExecCtx::Get()->Now()) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(g_nconnects - nconnects_before == static_cast<int>(num_connects));
+  gpr_mu_unlock(g_mu);
+
+  for (size_t i = 0; i < num_connects; ++i) {
+    close(clifds[i]);
+  }
+  gpr_free(clifds);
+  grpc_tcp_server_unref(s);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 static void destroy_pollset(void* p, grpc_error* /*error*/) {
   grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
 }
@@ -454,6 +613,7 @@ int main(int argc, char** argv) {
     test_no_op_with_start();
     test_no_op_with_port();
     test_no_op_with_port_and_start();
+    test_no_op_with_port_and_start_reuseport_listeners();
 
     if (getifaddrs(&ifa) != 0 || ifa == nullptr) {
       gpr_log(GPR_ERROR, "getifaddrs: %s", strerror(errno));
@@ -486,6 +646,8 @@ int main(int argc, char** argv) {
     /* Connect to same addresses as listeners. */
     test_connect(1, nullptr, nullptr, false);
     test_connect(10, nullptr, nullptr, false);
+    test_connect_reuseport_listeners(10);
+    test_connect_burst(50);
 
     /* Set dst_addrs->addrs[i].len=0 for dst_addrs that are unreachable with a
        "::" listener. */
@@ -29,6 +29,7 @@
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "test/core/util/test_config.h"
 #include "test/core/util/tracer_util.h"
 
@@ -37,6 +38,9 @@
 extern grpc_core::TraceFlag grpc_timer_trace;
 extern grpc_core::TraceFlag grpc_timer_check_trace;
 
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
 static int cb_called[MAX_CB][2];
 static const int64_t kMillisIn25Days = 2160000000;
 static const int64_t kHoursIn25Days = 600;
@@ -153,6 +157,129 @@ void destruction_test(void) {
   GPR_ASSERT(1 == cb_called[2][0]);
 }
 
+/* Timers must fire exactly at their deadline no matter how far out they were
+   set, which for the timing wheel means after being cascaded down through
+   several levels. */
+void far_deadline_test(void) {
+  const grpc_millis deadlines[] = {1,    63,     64,     65,     4095,
+                                   4096, 262143, 262145, 300000, 20000000};
+  const size_t num_timers = GPR_ARRAY_SIZE(deadlines);
+  grpc_timer timers[GPR_ARRAY_SIZE(deadlines) + 1];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "far_deadline_test");
+
+  grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  for (size_t i = 0; i < num_timers; i++) {
+    grpc_timer_init(
+        &timers[i], start + deadlines[i],
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+  /* One more timer, cancelled while it sits on a higher level of the wheel */
+  grpc_timer_init(&timers[num_timers], start + 262144,
+                  GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)num_timers,
+                                      grpc_schedule_on_exec_ctx));
+
+  for (size_t i = 0; i < num_timers; i++) {
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(start + deadlines[i] - 1);
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(cb_called[i][1] == 0);
+    if (i == 5) {
+      grpc_timer_cancel(&timers[num_timers]);
+      grpc_core::ExecCtx::Get()->Flush();
+      GPR_ASSERT(cb_called[num_timers][0] == 1);
+    }
+
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(start + deadlines[i]);
+    GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+    grpc_core::ExecCtx::Get()->Flush();
+    for (size_t j = 0; j < num_timers; j++) {
+      GPR_ASSERT(cb_called[j][1] == (j <= i));
+      GPR_ASSERT(cb_called[j][0] == 0);
+    }
+  }
+  GPR_ASSERT(cb_called[num_timers][1] == 0);
+
+  grpc_timer_list_shutdown();
+}
+
+/* Timers initialized with slack that round to the same deadline fire
+   together, never before their own deadline, and can still be cancelled one
+   at a time. */
+void coalesced_timer_test(void) {
+  grpc_timer timers[8];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "coalesced_timer_test");
+
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  grpc_millis base = (start / 64 + 2) * 64;
+  /* Timers 0-4 all round up to base */
+  for (int i = 0; i < 5; i++) {
+    grpc_timer_init_with_slack(
+        &timers[i], base - 10 + i, 64,
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+  /* Timers 5 and 6 round up to base + 64 */
+  for (int i = 5; i < 7; i++) {
+    grpc_timer_init_with_slack(
+        &timers[i], base + 1, 64,
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+  /* No slack: behaves like grpc_timer_init */
+  grpc_timer_init_with_slack(
+      &timers[7], base - 10, 0,
+      GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)7, grpc_schedule_on_exec_ctx));
+
+  grpc_timer_cancel(&timers[1]);
+  grpc_timer_cancel(&timers[5]);
+  grpc_timer_cancel(&timers[6]);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(1 == cb_called[1][0]);
+  GPR_ASSERT(1 == cb_called[5][0]);
+  GPR_ASSERT(1 == cb_called[6][0]);
+
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(base - 10);
+  grpc_timer_check(nullptr);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(1 == cb_called[7][1]);
+  GPR_ASSERT(0 == cb_called[0][1]);
+
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(base - 1);
+  grpc_timer_check(nullptr);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (int i = 0; i < 5; i++) {
+    GPR_ASSERT(0 == cb_called[i][1]);
+  }
+
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(base);
+  GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (int i = 0; i < 5; i++) {
+    GPR_ASSERT(cb_called[i][1] == (i == 1 ? 0 : 1));
+    GPR_ASSERT(cb_called[i][0] == (i == 1 ? 1 : 0));
+  }
+
+  /* Cancelling after the group fired does nothing */
+  grpc_timer_cancel(&timers[0]);
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(base + 64);
+  grpc_timer_check(nullptr);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(0 == cb_called[0][0]);
+  GPR_ASSERT(0 == cb_called[5][1]);
+  GPR_ASSERT(0 == cb_called[6][1]);
+
+  grpc_timer_list_shutdown();
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 /* Cleans up a list with pending timers that simulate long-running-services.
    This test does the following:
     1) Simulates grpc server start time to 25 days in the past (completed in
@@ -219,41 +346,49 @@ void long_running_service_cleanup_test(void) {
 }
 
 int main(int argc, char** argv) {
-  /* Tests with default g_start_time */
-  {
-    grpc::testing::TestEnvironment env(argc, argv);
-    grpc_core::ExecCtx::GlobalInit();
-    grpc_core::ExecCtx exec_ctx;
-    grpc_determine_iomgr_platform();
-    grpc_iomgr_platform_init();
-    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
-    add_test();
-    destruction_test();
-    grpc_iomgr_platform_shutdown();
-  }
-  grpc_core::ExecCtx::GlobalShutdown();
-
-  /* Begin long running service tests */
-  {
-    grpc::testing::TestEnvironment env(argc, argv);
-    /* Set g_start_time back 25 days. */
-    /* We set g_start_time here in case there are any initialization
-        dependencies that use g_start_time. */
-    gpr_timespec new_start =
-        gpr_time_sub(gpr_now(gpr_clock_type::GPR_CLOCK_MONOTONIC),
-                     gpr_time_from_hours(kHoursIn25Days,
-                                         gpr_clock_type::GPR_CLOCK_MONOTONIC));
-    grpc_core::ExecCtx::TestOnlyGlobalInit(new_start);
-    grpc_core::ExecCtx exec_ctx;
-    grpc_determine_iomgr_platform();
-    grpc_iomgr_platform_init();
-    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
-    long_running_service_cleanup_test();
-    add_test();
-    destruction_test();
-    grpc_iomgr_platform_shutdown();
+  grpc_timer_vtable* impls[] = {&grpc_generic_timer_vtable,
+                                &grpc_wheel_timer_vtable};
+  for (grpc_timer_vtable* impl : impls) {
+    /* Tests with default g_start_time */
+    {
+      grpc::testing::TestEnvironment env(argc, argv);
+      grpc_core::ExecCtx::GlobalInit();
+      grpc_core::ExecCtx exec_ctx;
+      grpc_determine_iomgr_platform();
+      grpc_iomgr_platform_init();
+      grpc_set_timer_impl(impl);
+      gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+      add_test();
+      destruction_test();
+      far_deadline_test();
+      coalesced_timer_test();
+      grpc_iomgr_platform_shutdown();
+    }
+    grpc_core::ExecCtx::GlobalShutdown();
+
+    /* Begin long running service tests */
+    {
+      grpc::testing::TestEnvironment env(argc, argv);
+      /* Set g_start_time back 25 days. */
+      /* We set g_start_time here in case there are any initialization
+          dependencies that use g_start_time. */
+      gpr_timespec new_start = gpr_time_sub(
+          gpr_now(gpr_clock_type::GPR_CLOCK_MONOTONIC),
+          gpr_time_from_hours(kHoursIn25Days,
+                              gpr_clock_type::GPR_CLOCK_MONOTONIC));
+      grpc_core::ExecCtx::TestOnlyGlobalInit(new_start);
+      grpc_core::ExecCtx exec_ctx;
+      grpc_determine_iomgr_platform();
+      grpc_iomgr_platform_init();
+      grpc_set_timer_impl(impl);
+      gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+      long_running_service_cleanup_test();
+      add_test();
+      destruction_test();
+      grpc_iomgr_platform_shutdown();
+    }
+    grpc_core::ExecCtx::GlobalShutdown();
   }
-  grpc_core::ExecCtx::GlobalShutdown();
 
   return 0;
 }
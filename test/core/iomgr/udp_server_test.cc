@@ -124,6 +124,53 @@ class TestGrpcUdpHandlerFactory : public GrpcUdpHandlerFactory {
 
 TestGrpcUdpHandlerFactory handler_factory;
 
+static int g_number_of_batches = 0;
+static int g_number_of_datagrams = 0;
+
+/* Echoes every datagram back to its sender. */
+class TestGrpcUdpBatchHandler : public GrpcUdpBatchHandler {
+ public:
+  TestGrpcUdpBatchHandler(grpc_fd* emfd, void* user_data)
+      : GrpcUdpBatchHandler(emfd, user_data) {}
+  ~TestGrpcUdpBatchHandler() override {}
+
+  void OnDatagrams(const GrpcUdpDatagram* datagrams, size_t count) override {
+    gpr_mu_lock(g_mu);
+    g_number_of_batches++;
+    g_number_of_datagrams += static_cast<int>(count);
+    for (size_t i = 0; i < count; i++) {
+      g_number_of_bytes_read += static_cast<int>(datagrams[i].length);
+    }
+    GPR_ASSERT(SendDatagrams(datagrams, count) == static_cast<int>(count));
+    gpr_log(GPR_DEBUG, "received %zu datagrams on handler %p", count, this);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR("pollset_kick",
+                                 grpc_pollset_kick(g_pollset, nullptr)));
+    gpr_mu_unlock(g_mu);
+  }
+
+  void OnCanWrite(void* /*user_data*/,
+                  grpc_closure* /*notify_on_write_closure*/) override {}
+
+  void OnFdAboutToOrphan(grpc_closure* orphan_fd_closure,
+                         void* /*user_data*/) override {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, orphan_fd_closure, GRPC_ERROR_NONE);
+    g_number_of_orphan_calls++;
+  }
+};
+
+class TestGrpcUdpBatchHandlerFactory : public GrpcUdpHandlerFactory {
+ public:
+  GrpcUdpHandler* CreateUdpHandler(grpc_fd* emfd, void* user_data) override {
+    return new TestGrpcUdpBatchHandler(emfd, user_data);
+  }
+
+  void DestroyUdpHandler(GrpcUdpHandler* handler) override {
+    delete reinterpret_cast<TestGrpcUdpBatchHandler*>(handler);
+  }
+};
+
+TestGrpcUdpBatchHandlerFactory batch_handler_factory;
+
 struct test_socket_factory {
   grpc_socket_factory base;
   int number_of_socket_calls;
@@ -359,6 +406,81 @@ static void test_receive(int number_of_clients) {
   shutdown_and_destroy_pollset();
 }
 
+static void test_receive_batched(int number_of_datagrams) {
+  grpc_pollset_init(g_pollset, &g_mu);
+  grpc_core::ExecCtx exec_ctx;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_storage* addr =
+      reinterpret_cast<struct sockaddr_storage*>(resolved_addr.addr);
+  grpc_udp_server* s = grpc_udp_server_create(nullptr);
+  grpc_pollset* pollsets[1];
+  LOG_TEST("test_receive_batched");
+  gpr_log(GPR_INFO, "datagrams=%d", number_of_datagrams);
+
+  g_number_of_bytes_read = 0;
+  g_number_of_orphan_calls = 0;
+  g_number_of_batches = 0;
+  g_number_of_datagrams = 0;
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
+  addr->ss_family = AF_INET;
+  /* A single listener, so that all datagrams land on the same socket, with a
+     receive buffer large enough to hold all of them. */
+  GPR_ASSERT(grpc_udp_server_add_port(s, &resolved_addr, 1 << 20, 1 << 20,
+                                      &batch_handler_factory, 1) > 0);
+
+  int svrfd = grpc_udp_server_get_fd(s, 0);
+  GPR_ASSERT(svrfd >= 0);
+  GPR_ASSERT(getsockname(svrfd, (struct sockaddr*)addr,
+                         (socklen_t*)&resolved_addr.len) == 0);
+
+  int clifd = socket(addr->ss_family, SOCK_DGRAM, 0);
+  GPR_ASSERT(clifd >= 0);
+  GPR_ASSERT(connect(clifd, (struct sockaddr*)addr,
+                     (socklen_t)resolved_addr.len) == 0);
+  /* Queue all datagrams before the server starts reading them. */
+  for (int i = 0; i < number_of_datagrams; i++) {
+    GPR_ASSERT(5 == write(clifd, "hello", 5));
+  }
+
+  pollsets[0] = g_pollset;
+  grpc_udp_server_start(s, pollsets, 1, nullptr);
+
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(10));
+  gpr_mu_lock(g_mu);
+  while (g_number_of_datagrams < number_of_datagrams &&
+         deadline > grpc_core::ExecCtx::Get()->Now()) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(g_number_of_datagrams == number_of_datagrams);
+  GPR_ASSERT(g_number_of_bytes_read == 5 * number_of_datagrams);
+  /* Every read should have returned several datagrams. */
+  GPR_ASSERT(g_number_of_batches <
+             number_of_datagrams /
+                 static_cast<int>(GrpcUdpBatchHandler::kDefaultBatchSize) +
+                 2);
+  gpr_mu_unlock(g_mu);
+
+  /* Every datagram was echoed back with SendDatagrams(). */
+  char buf[16];
+  for (int i = 0; i < number_of_datagrams; i++) {
+    GPR_ASSERT(5 == recv(clifd, buf, sizeof(buf), 0));
+    GPR_ASSERT(memcmp(buf, "hello", 5) == 0);
+  }
+  close(clifd);
+
+  grpc_udp_server_destroy(s, nullptr);
+  GPR_ASSERT(g_number_of_orphan_calls == 1);
+  shutdown_and_destroy_pollset();
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -376,6 +498,7 @@ int main(int argc, char** argv) {
     test_no_op_with_port_and_start();
     test_receive(1);
     test_receive(10);
+    test_receive_batched(64);
 
     gpr_free(g_pollset);
   }
@@ -0,0 +1,147 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/profiling/timers.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/lib/gpr/tmpfile.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+
+#ifdef GRPC_TIMER_TRACE
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+void TimedWork(int iterations) {
+  for (int i = 0; i < iterations; i++) {
+    GPR_TIMER_SCOPE("timer_trace_test.outer", 0);
+    {
+      GPR_TIMER_SCOPE("timer_trace_test.inner", 0);
+      GPR_TIMER_MARK("timer_trace_test.mark", 0);
+    }
+  }
+}
+
+const char* GetString(grpc_json* object, const char* key) {
+  for (grpc_json* child = object->child; child != nullptr;
+       child = child->next) {
+    if (strcmp(child->key, key) == 0) return child->value;
+  }
+  return nullptr;
+}
+
+// Writes the trace out and counts its events by name and phase, eg.
+// "timer_trace_test.inner/B". Also checks that each thread's begins and
+// ends pair up.
+std::map<std::string, int> WriteAndCountEvents() {
+  char* filename;
+  FILE* out = gpr_tmpfile("timer_trace_test", &filename);
+  EXPECT_NE(out, nullptr);
+  EXPECT_TRUE(TimerTrace::Write(out));
+  long size = ftell(out);
+  std::string contents(size, '\0');
+  rewind(out);
+  EXPECT_EQ(fread(&contents[0], 1, size, out), static_cast<size_t>(size));
+  fclose(out);
+  remove(filename);
+  gpr_free(filename);
+  grpc_json* json = grpc_json_parse_string(&contents[0]);
+  EXPECT_NE(json, nullptr);
+  std::map<std::string, int> counts;
+  std::map<std::string, int> depth_by_thread;
+  if (json == nullptr) return counts;
+  grpc_json* events = json->child;
+  while (events != nullptr && strcmp(events->key, "traceEvents") != 0) {
+    events = events->next;
+  }
+  EXPECT_NE(events, nullptr);
+  for (grpc_json* event = events == nullptr ? nullptr : events->child;
+       event != nullptr; event = event->next) {
+    std::string phase = GetString(event, "ph");
+    counts[std::string(GetString(event, "name")) + "/" + phase]++;
+    int& depth = depth_by_thread[GetString(event, "tid")];
+    if (phase == "B") depth++;
+    if (phase == "E") {
+      EXPECT_GE(--depth, 0);
+    }
+  }
+  grpc_json_destroy(json);
+  return counts;
+}
+
+TEST(TimerTraceTest, RecordsOnlyWhileStarted) {
+  TimedWork(1);
+  TimerTrace::Start();
+  TimedWork(3);
+  TimerTrace::Stop();
+  TimedWork(1);
+  std::map<std::string, int> counts = WriteAndCountEvents();
+  EXPECT_EQ(counts["timer_trace_test.outer/B"], 3);
+  EXPECT_EQ(counts["timer_trace_test.outer/E"], 3);
+  EXPECT_EQ(counts["timer_trace_test.inner/B"], 3);
+  EXPECT_EQ(counts["timer_trace_test.inner/E"], 3);
+  EXPECT_EQ(counts["timer_trace_test.mark/i"], 3);
+}
+
+TEST(TimerTraceTest, KeepsTheLastEventsOfEachThread) {
+  TimerTrace::Start();
+  Thread threads[2];
+  for (Thread& thread : threads) {
+    // More events than a ring holds.
+    thread = Thread(
+        "timer_trace_test", [](void*) { TimedWork(10000); }, nullptr);
+    thread.Start();
+  }
+  for (Thread& thread : threads) thread.Join();
+  TimerTrace::Stop();
+  std::map<std::string, int> counts = WriteAndCountEvents();
+  // The oldest events were overwritten, and ends that lost their begins
+  // dropped.
+  EXPECT_GT(counts["timer_trace_test.mark/i"], 0);
+  EXPECT_LT(counts["timer_trace_test.mark/i"], 20000);
+  EXPECT_LE(counts["timer_trace_test.outer/E"],
+            counts["timer_trace_test.outer/B"]);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+#endif  // GRPC_TIMER_TRACE
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -30,6 +30,7 @@
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/fake_transport_security.h"
+#include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
 
 static gpr_mu* g_mu;
@@ -202,6 +203,60 @@ static void test_leftover(grpc_endpoint_test_config config, size_t slice_size) {
   clean_up();
 }
 
+// With kernel TLS, the kernel protects the outgoing bytes: the secure endpoint
+// must hand them to the wrapped endpoint as they are.
+static void test_kernel_tls_tx_writes_through(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_endpoint_pair tcp =
+      grpc_iomgr_create_endpoint_pair("kernel_tls", nullptr);
+  grpc_endpoint_add_to_pollset(tcp.client, g_pollset);
+  grpc_endpoint_add_to_pollset(tcp.server, g_pollset);
+  grpc_endpoint* client_ep = grpc_secure_endpoint_create_with_kernel_tls_tx(
+      tsi_create_fake_frame_protector(nullptr), nullptr, tcp.client, nullptr,
+      0);
+  gpr_log(GPR_INFO, "Start test kernel tls tx");
+
+  grpc_slice s = grpc_slice_from_copied_string("hello kernel tls");
+  grpc_slice_buffer outgoing;
+  grpc_slice_buffer_init(&outgoing);
+  grpc_slice_buffer_add(&outgoing, grpc_slice_ref_internal(s));
+  grpc_slice_buffer incoming;
+  grpc_slice_buffer_init(&incoming);
+  int n = 0;
+  grpc_closure write_done;
+  grpc_closure read_done;
+  GRPC_CLOSURE_INIT(&write_done, inc_call_ctr, &n, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&read_done, inc_call_ctr, &n, grpc_schedule_on_exec_ctx);
+  grpc_endpoint_write(client_ep, &outgoing, &write_done, nullptr);
+  grpc_endpoint_read(tcp.server, &incoming, &read_done, /*urgent=*/false);
+
+  gpr_mu_lock(g_mu);
+  while (n < 2) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(g_pollset, &worker,
+                          grpc_core::ExecCtx::Get()->Now() + 1000)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  grpc_slice received = grpc_slice_merge(incoming.slices, incoming.count);
+  GPR_ASSERT(grpc_slice_eq(s, received));
+  grpc_slice_unref_internal(received);
+
+  grpc_endpoint_shutdown(
+      client_ep, GRPC_ERROR_CREATE_FROM_STATIC_STRING("test_kernel_tls end"));
+  grpc_endpoint_shutdown(
+      tcp.server, GRPC_ERROR_CREATE_FROM_STATIC_STRING("test_kernel_tls end"));
+  grpc_endpoint_destroy(client_ep);
+  grpc_endpoint_destroy(tcp.server);
+  grpc_slice_unref_internal(s);
+  grpc_slice_buffer_destroy_internal(&outgoing);
+  grpc_slice_buffer_destroy_internal(&incoming);
+}
+
 static void destroy_pollset(void* p, grpc_error* /*error*/) {
   grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
 }
@@ -219,6 +274,7 @@ int main(int argc, char** argv) {
     grpc_endpoint_tests(configs[1], g_pollset, g_mu);
     test_leftover(configs[2], 1);
     test_leftover(configs[3], 1);
+    test_kernel_tls_tx_writes_through();
     GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
                       grpc_schedule_on_exec_ctx);
     grpc_pollset_shutdown(g_pollset, &destroyed);
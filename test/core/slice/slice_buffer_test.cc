@@ -147,6 +147,56 @@ void test_slice_buffer_first() {
   GPR_ASSERT(buf.length == 0);
 }
 
+void test_slice_buffer_reserve() {
+  grpc_slice_buffer buf;
+  grpc_slice_buffer_init(&buf);
+
+  grpc_slice_buffer_reserve(&buf, 100);
+  GPR_ASSERT(buf.capacity >= 100);
+  grpc_slice* const slices = buf.base_slices;
+  for (int i = 0; i < 100; i++) {
+    grpc_slice_buffer_add(&buf, grpc_slice_malloc(100));
+  }
+  GPR_ASSERT(buf.count == 100);
+  GPR_ASSERT(buf.base_slices == slices);
+
+  // Used as a queue, the buffer grows at most once, then compacts rather than
+  // growing without bound.
+  const size_t capacity = buf.capacity;
+  for (int i = 0; i < 1000; i++) {
+    grpc_slice_unref(grpc_slice_buffer_take_first(&buf));
+    grpc_slice_buffer_add(&buf, grpc_slice_malloc(100));
+  }
+  GPR_ASSERT(buf.count == 100);
+  GPR_ASSERT(buf.length == 100 * 100);
+  GPR_ASSERT(buf.capacity <= 2 * capacity);
+
+  // Reserving keeps the slices that are left, in order.
+  grpc_slice_buffer_reset_and_unref(&buf);
+  for (int i = 0; i < 20; i++) {
+    grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_static_string("a"));
+    grpc_slice_buffer_add_indexed(&buf, grpc_slice_from_static_string("bb"));
+  }
+  for (int i = 0; i < 10; i++) {
+    grpc_slice_unref(grpc_slice_buffer_take_first(&buf));
+  }
+  grpc_slice_buffer_reserve(&buf, 4 * capacity);
+  GPR_ASSERT(buf.capacity >= buf.count + 4 * capacity);
+  GPR_ASSERT(buf.count == 30);
+  for (size_t i = 0; i < buf.count; i++) {
+    GPR_ASSERT(GRPC_SLICE_LENGTH(buf.slices[i]) == 1 + i % 2);
+  }
+
+  // Only an empty buffer gives its slice array back.
+  GPR_ASSERT(grpc_slice_buffer_shrink_internal(&buf) == 0);
+  grpc_slice_buffer_reset_and_unref(&buf);
+  GPR_ASSERT(grpc_slice_buffer_shrink_internal(&buf) > 0);
+  GPR_ASSERT(buf.base_slices == buf.inlined);
+  GPR_ASSERT(grpc_slice_buffer_shrink_internal(&buf) == 0);
+  grpc_slice_buffer_add(&buf, grpc_slice_from_static_string("a"));
+  grpc_slice_buffer_destroy(&buf);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -154,6 +204,7 @@ int main(int argc, char** argv) {
   test_slice_buffer_add();
   test_slice_buffer_move_first();
   test_slice_buffer_first();
+  test_slice_buffer_reserve();
 
   grpc_shutdown();
   return 0;
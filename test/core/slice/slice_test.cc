@@ -27,7 +27,10 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/static_metadata.h"
 #include "test/core/util/test_config.h"
@@ -263,6 +266,75 @@ static void test_slice_interning(void) {
   grpc_shutdown();
 }
 
+#define CONCURRENT_INTERNING_THREADS 8
+#define CONCURRENT_INTERNING_ITERATIONS 10000
+
+static void concurrent_interning_thread(void* arg) {
+  const grpc_slice* pinned = static_cast<const grpc_slice*>(arg);
+  char buffer[GPR_LTOA_MIN_BUFSIZE];
+  for (long i = 0; i < CONCURRENT_INTERNING_ITERATIONS; i++) {
+    /* churn through slices that are dropped right away, so that the table is
+       grown and slices are freed under the lookups of the pinned slice */
+    gpr_ltoa(i, buffer);
+    grpc_slice_unref(grpc_slice_intern(grpc_slice_from_static_string(buffer)));
+    grpc_slice interned = grpc_slice_intern(
+        grpc_slice_from_static_string("hello123456789123456789"));
+    GPR_ASSERT(GRPC_SLICE_START_PTR(interned) == GRPC_SLICE_START_PTR(*pinned));
+    grpc_slice_unref(interned);
+  }
+}
+
+static void test_slice_interning_concurrently(void) {
+  LOG_TEST_NAME("test_slice_interning_concurrently");
+
+  grpc_init();
+  grpc_slice pinned = grpc_slice_intern(
+      grpc_slice_from_static_string("hello123456789123456789"));
+  grpc_core::Thread threads[CONCURRENT_INTERNING_THREADS];
+  for (auto& th : threads) {
+    th = grpc_core::Thread("grpc_concurrent_interning",
+                           concurrent_interning_thread, &pinned);
+    th.Start();
+  }
+  for (auto& th : threads) {
+    th.Join();
+  }
+  grpc_slice_unref(pinned);
+  grpc_shutdown();
+}
+
+static const char* const kUnpinnedStrings[] = {
+    "unpinned-0-123456789123456789", "unpinned-1-123456789123456789",
+    "unpinned-2-123456789123456789", "unpinned-3-123456789123456789"};
+
+static void concurrent_intern_unref_thread(void* /*arg*/) {
+  for (long i = 0; i < CONCURRENT_INTERNING_ITERATIONS; i++) {
+    /* nothing else holds these slices, so their last ref is dropped all the
+       time, and they are unlinked and freed under the lookups of the other
+       threads */
+    const char* s = kUnpinnedStrings[i % GPR_ARRAY_SIZE(kUnpinnedStrings)];
+    grpc_slice interned = grpc_slice_intern(grpc_slice_from_static_string(s));
+    GPR_ASSERT(grpc_slice_str_cmp(interned, s) == 0);
+    grpc_slice_unref(interned);
+  }
+}
+
+static void test_slice_intern_unref_concurrently(void) {
+  LOG_TEST_NAME("test_slice_intern_unref_concurrently");
+
+  grpc_init();
+  grpc_core::Thread threads[CONCURRENT_INTERNING_THREADS];
+  for (auto& th : threads) {
+    th = grpc_core::Thread("grpc_concurrent_intern_unref",
+                           concurrent_intern_unref_thread, nullptr);
+    th.Start();
+  }
+  for (auto& th : threads) {
+    th.Join();
+  }
+  grpc_shutdown();
+}
+
 static void test_static_slice_interning(void) {
   LOG_TEST_NAME("test_static_slice_interning");
 
@@ -292,6 +364,22 @@ static void test_static_slice_copy_interning(void) {
   grpc_shutdown();
 }
 
+static void test_static_slice_index_for_bytes(void) {
+  LOG_TEST_NAME("test_static_slice_index_for_bytes");
+
+  for (size_t i = 0; i < GRPC_STATIC_MDSTR_COUNT; i++) {
+    const grpc_slice& s = grpc_static_slice_table()[i];
+    GPR_ASSERT(grpc_static_slice_index_for_bytes(
+                   reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(s)),
+                   GRPC_SLICE_LENGTH(s)) == static_cast<intptr_t>(i));
+  }
+  // Same length and sampled bytes as "grpc-timeout", or a prefix of a static
+  // string
+  GPR_ASSERT(grpc_static_slice_index_for_bytes("grpc-tineout", 12) == -1);
+  GPR_ASSERT(grpc_static_slice_index_for_bytes("grpc-timeou", 11) == -1);
+  GPR_ASSERT(grpc_static_slice_index_for_bytes("x-custom-header", 15) == -1);
+}
+
 static void test_moved_string_slice(void) {
   LOG_TEST_NAME("test_moved_string_slice");
 
@@ -345,8 +433,11 @@ int main(int argc, char** argv) {
   }
   test_slice_from_copied_string_works();
   test_slice_interning();
+  test_slice_interning_concurrently();
+  test_slice_intern_unref_concurrently();
   test_static_slice_interning();
   test_static_slice_copy_interning();
+  test_static_slice_index_for_bytes();
   test_moved_string_slice();
   grpc_shutdown();
   return 0;
@@ -165,6 +165,125 @@ static void test_cq_end_op(void) {
   }
 }
 
+static void test_next_batch(void) {
+  grpc_event events[4];
+  grpc_completion_queue* cc;
+  grpc_cq_completion completions[6];
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+  void* tags[GPR_ARRAY_SIZE(completions)];
+  int n;
+
+  LOG_TEST("test_next_batch");
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+    tags[i] = create_test_tag();
+  }
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    grpc_core::ExecCtx exec_ctx;
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    n = grpc_completion_queue_next_batch(
+        cc, events, GPR_ARRAY_SIZE(events),
+        grpc_timeout_milliseconds_to_deadline(10), nullptr);
+    GPR_ASSERT(n == 1);
+    GPR_ASSERT(events[0].type == GRPC_QUEUE_TIMEOUT);
+
+    for (size_t j = 0; j < GPR_ARRAY_SIZE(tags); j++) {
+      GPR_ASSERT(grpc_cq_begin_op(cc, tags[j]));
+      grpc_cq_end_op(cc, tags[j], GRPC_ERROR_NONE, do_nothing_end_completion,
+                     nullptr, &completions[j]);
+    }
+
+    /* The first call fills the whole array, the second takes what is left. */
+    size_t next_tag = 0;
+    n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                         gpr_inf_past(GPR_CLOCK_REALTIME),
+                                         nullptr);
+    GPR_ASSERT(n == static_cast<int>(GPR_ARRAY_SIZE(events)));
+    for (int j = 0; j < n; j++) {
+      GPR_ASSERT(events[j].type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(events[j].success);
+      GPR_ASSERT(events[j].tag == tags[next_tag++]);
+    }
+    n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                         gpr_inf_past(GPR_CLOCK_REALTIME),
+                                         nullptr);
+    GPR_ASSERT(n == static_cast<int>(GPR_ARRAY_SIZE(tags) -
+                                    GPR_ARRAY_SIZE(events)));
+    for (int j = 0; j < n; j++) {
+      GPR_ASSERT(events[j].type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(events[j].tag == tags[next_tag++]);
+    }
+
+    grpc_completion_queue_shutdown(cc);
+    n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                         gpr_inf_future(GPR_CLOCK_REALTIME),
+                                         nullptr);
+    GPR_ASSERT(n == 1);
+    GPR_ASSERT(events[0].type == GRPC_QUEUE_SHUTDOWN);
+    grpc_completion_queue_destroy(cc);
+  }
+}
+
+static void test_sharded_next(void) {
+  grpc_event ev;
+  grpc_completion_queue* cc;
+  grpc_cq_completion completions[16];
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+  void* tags[GPR_ARRAY_SIZE(completions)];
+  bool seen[GPR_ARRAY_SIZE(completions)];
+
+  LOG_TEST("test_sharded_next");
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+    tags[i] = create_test_tag();
+  }
+
+  attr.version = 3;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  attr.cq_shutdown_cb = nullptr;
+  attr.cq_num_shards = 4;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    grpc_core::ExecCtx exec_ctx;
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    /* Whichever shards the events land in, a single consumer gets them all */
+    for (size_t j = 0; j < GPR_ARRAY_SIZE(tags); j++) {
+      GPR_ASSERT(grpc_cq_begin_op(cc, tags[j]));
+      grpc_cq_end_op(cc, tags[j], GRPC_ERROR_NONE, do_nothing_end_completion,
+                     nullptr, &completions[j]);
+      seen[j] = false;
+    }
+    for (size_t j = 0; j < GPR_ARRAY_SIZE(tags); j++) {
+      ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
+                                      nullptr);
+      GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(ev.success);
+      size_t k = 0;
+      while (k < GPR_ARRAY_SIZE(tags) && tags[k] != ev.tag) k++;
+      GPR_ASSERT(k < GPR_ARRAY_SIZE(tags));
+      GPR_ASSERT(!seen[k]);
+      seen[k] = true;
+    }
+    ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
+                                    nullptr);
+    GPR_ASSERT(ev.type == GRPC_QUEUE_TIMEOUT);
+
+    shutdown_and_destroy(cc);
+  }
+}
+
 static void test_cq_tls_cache_full(void) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -495,6 +614,8 @@ int main(int argc, char** argv) {
   test_shutdown_then_next_polling();
   test_shutdown_then_next_with_timeout();
   test_cq_end_op();
+  test_next_batch();
+  test_sharded_next();
   test_pluck();
   test_pluck_after_shutdown();
   test_cq_tls_cache_full();
@@ -75,6 +75,9 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_compression_options_enable_algorithm);
   printf("%lx", (unsigned long) grpc_compression_options_disable_algorithm);
   printf("%lx", (unsigned long) grpc_compression_options_is_algorithm_enabled);
+  printf("%lx", (unsigned long) grpc_compression_dictionaries_create);
+  printf("%lx", (unsigned long) grpc_compression_dictionaries_unref);
+  printf("%lx", (unsigned long) grpc_compression_dictionaries_arg_vtable);
   printf("%lx", (unsigned long) grpc_metadata_array_init);
   printf("%lx", (unsigned long) grpc_metadata_array_destroy);
   printf("%lx", (unsigned long) grpc_call_details_init);
@@ -92,6 +95,7 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_completion_queue_create_for_callback);
   printf("%lx", (unsigned long) grpc_completion_queue_create);
   printf("%lx", (unsigned long) grpc_completion_queue_next);
+  printf("%lx", (unsigned long) grpc_completion_queue_next_batch);
   printf("%lx", (unsigned long) grpc_completion_queue_pluck);
   printf("%lx", (unsigned long) grpc_completion_queue_shutdown);
   printf("%lx", (unsigned long) grpc_completion_queue_destroy);
@@ -22,8 +22,16 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/iomgr/resolve_address.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/security/credentials/fake/fake_credentials.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
@@ -55,6 +63,239 @@ void test_register_method_fail(void) {
   grpc_server_destroy(server);
 }
 
+void test_register_method_after_start(void) {
+  grpc_server* server = grpc_server_create(nullptr, nullptr);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_server_register_completion_queue(server, cq, nullptr);
+  GPR_ASSERT(grpc_server_register_method(server, "m", "h",
+                                         GRPC_SRM_PAYLOAD_NONE, 0) != nullptr);
+  grpc_server_start(server);
+  GPR_ASSERT(grpc_server_register_method(server, "m2", "h",
+                                         GRPC_SRM_PAYLOAD_NONE, 0) == nullptr);
+  GPR_ASSERT(grpc_server_register_method(server, "m2", nullptr,
+                                         GRPC_SRM_PAYLOAD_NONE, 0) == nullptr);
+  grpc_server_shutdown_and_notify(server, cq, nullptr);
+  grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
+  grpc_server_destroy(server);
+  grpc_completion_queue_destroy(cq);
+}
+
+#define UNREGISTERED (-1)
+
+/* A started server with registered methods, and an in-process channel to
+   it. The server always has a call requested for each registered method, and
+   one for unregistered methods, tagged with the method's index or
+   UNREGISTERED. */
+typedef struct {
+  grpc_server* server;
+  grpc_channel* channel;
+  grpc_completion_queue* cq;
+  std::vector<void*> methods;
+  grpc_call* server_call;
+  grpc_call_details details;
+  gpr_timespec deadline;
+  grpc_metadata_array request_metadata;
+} method_fixture;
+
+static void* method_tag(int index) {
+  return reinterpret_cast<void*>(static_cast<intptr_t>(index) + 1000);
+}
+
+static void request_method_call(method_fixture* f, int index) {
+  grpc_call_error error;
+  if (index == UNREGISTERED) {
+    error = grpc_server_request_call(f->server, &f->server_call, &f->details,
+                                     &f->request_metadata, f->cq, f->cq,
+                                     method_tag(index));
+  } else {
+    error = grpc_server_request_registered_call(
+        f->server, f->methods[index], &f->server_call, &f->deadline,
+        &f->request_metadata, nullptr, f->cq, f->cq, method_tag(index));
+  }
+  GPR_ASSERT(error == GRPC_CALL_OK);
+}
+
+/* \a methods holds a method and a host (nullptr for any host) per method to
+   register. */
+static void method_fixture_init(method_fixture* f,
+                                const std::vector<const char*>& methods) {
+  f->server = grpc_server_create(nullptr, nullptr);
+  f->cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_server_register_completion_queue(f->server, f->cq, nullptr);
+  for (size_t i = 0; i < methods.size(); i += 2) {
+    f->methods.push_back(grpc_server_register_method(
+        f->server, methods[i], methods[i + 1], GRPC_SRM_PAYLOAD_NONE, 0));
+    GPR_ASSERT(f->methods.back() != nullptr);
+  }
+  grpc_server_start(f->server);
+  f->channel = grpc_inproc_channel_create(f->server, nullptr, nullptr);
+  grpc_call_details_init(&f->details);
+  grpc_metadata_array_init(&f->request_metadata);
+  for (int i = 0; i < static_cast<int>(f->methods.size()); i++) {
+    request_method_call(f, i);
+  }
+  request_method_call(f, UNREGISTERED);
+}
+
+static void method_fixture_destroy(method_fixture* f) {
+  grpc_channel_destroy(f->channel);
+  grpc_server_shutdown_and_notify(f->server, f->cq, nullptr);
+  grpc_server_cancel_all_calls(f->server);
+  /* the requested calls fail, then the shutdown completes */
+  for (;;) {
+    grpc_event ev = grpc_completion_queue_next(
+        f->cq, grpc_timeout_seconds_to_deadline(5), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    if (ev.tag == nullptr) break;
+  }
+  grpc_server_destroy(f->server);
+  grpc_completion_queue_shutdown(f->cq);
+  while (grpc_completion_queue_next(f->cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(f->cq);
+  grpc_call_details_destroy(&f->details);
+  grpc_metadata_array_destroy(&f->request_metadata);
+}
+
+/* Calls \a method at \a host and returns the index of the registered method
+   the server matched it with, or UNREGISTERED. */
+static int matched_method(method_fixture* f, const char* method,
+                          const char* host) {
+  grpc_slice method_slice = grpc_slice_from_static_string(method);
+  grpc_slice host_slice = grpc_slice_from_static_string(host);
+  grpc_call* c = grpc_channel_create_call(
+      f->channel, nullptr, GRPC_PROPAGATE_DEFAULTS, f->cq, method_slice,
+      &host_slice, grpc_timeout_seconds_to_deadline(5), nullptr);
+  grpc_metadata_array trailing_metadata;
+  grpc_metadata_array_init(&trailing_metadata);
+  grpc_status_code status;
+  grpc_slice details;
+  grpc_op ops[3];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  ops[2].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[2].data.recv_status_on_client.trailing_metadata = &trailing_metadata;
+  ops[2].data.recv_status_on_client.status = &status;
+  ops[2].data.recv_status_on_client.status_details = &details;
+  void* client_tag = reinterpret_cast<void*>(1);
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(c, ops, GPR_ARRAY_SIZE(ops), client_tag,
+                                   nullptr));
+  int matched = 0;
+  bool found = false;
+  bool client_done = false;
+  while (!found || !client_done) {
+    grpc_event ev = grpc_completion_queue_next(
+        f->cq, grpc_timeout_seconds_to_deadline(5), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    GPR_ASSERT(ev.success);
+    if (ev.tag == client_tag) {
+      client_done = true;
+      continue;
+    }
+    GPR_ASSERT(!found);
+    found = true;
+    matched = static_cast<int>(reinterpret_cast<intptr_t>(ev.tag) - 1000);
+    grpc_call_cancel_with_status(f->server_call, GRPC_STATUS_UNIMPLEMENTED,
+                                 "matched", nullptr);
+    grpc_call_unref(f->server_call);
+    f->server_call = nullptr;
+    if (matched == UNREGISTERED) {
+      GPR_ASSERT(grpc_slice_str_cmp(f->details.method, method) == 0);
+      GPR_ASSERT(grpc_slice_str_cmp(f->details.host, host) == 0);
+      grpc_call_details_destroy(&f->details);
+      grpc_call_details_init(&f->details);
+    }
+    grpc_metadata_array_destroy(&f->request_metadata);
+    grpc_metadata_array_init(&f->request_metadata);
+    request_method_call(f, matched);
+  }
+  GPR_ASSERT(status == GRPC_STATUS_UNIMPLEMENTED);
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&trailing_metadata);
+  grpc_call_unref(c);
+  return matched;
+}
+
+/* A method registered for the call's host wins over the same method
+   registered for any host, whichever was registered first. */
+void test_registered_method_host_precedence(void) {
+  method_fixture f;
+  method_fixture_init(&f, {"/a", nullptr, "/a", "h1", "/b", "h1", "/c",
+                           nullptr, "/a", "h2"});
+  GPR_ASSERT(matched_method(&f, "/a", "h1") == 1);
+  GPR_ASSERT(matched_method(&f, "/a", "h2") == 4);
+  GPR_ASSERT(matched_method(&f, "/a", "h3") == 0);
+  GPR_ASSERT(matched_method(&f, "/b", "h1") == 2);
+  GPR_ASSERT(matched_method(&f, "/b", "h2") == UNREGISTERED);
+  GPR_ASSERT(matched_method(&f, "/c", "h1") == 3);
+  GPR_ASSERT(matched_method(&f, "/d", "h1") == UNREGISTERED);
+  method_fixture_destroy(&f);
+}
+
+/* Finds two paths whose hashes collide. */
+static void colliding_paths(std::string* a, std::string* b) {
+  std::unordered_map<uint32_t, std::string> seen;
+  for (int i = 0;; i++) {
+    std::string path = "/collide/" + std::to_string(i);
+    grpc_slice slice = grpc_slice_from_static_buffer(path.data(), path.size());
+    auto it = seen.emplace(grpc_slice_hash_internal(slice), path);
+    if (!it.second) {
+      *a = it.first->second;
+      *b = path;
+      return;
+    }
+  }
+}
+
+/* Paths whose hashes collide share a slot of the method table, and are
+   still told apart, including from an unregistered path with the same
+   hash. */
+void test_registered_method_hash_collision(void) {
+  std::string a, b;
+  colliding_paths(&a, &b);
+  {
+    method_fixture f;
+    method_fixture_init(&f, {a.c_str(), "h", b.c_str(), nullptr});
+    GPR_ASSERT(matched_method(&f, a.c_str(), "h") == 0);
+    GPR_ASSERT(matched_method(&f, a.c_str(), "h2") == UNREGISTERED);
+    GPR_ASSERT(matched_method(&f, b.c_str(), "h") == 1);
+    GPR_ASSERT(matched_method(&f, b.c_str(), "h2") == 1);
+    method_fixture_destroy(&f);
+  }
+  {
+    method_fixture f;
+    method_fixture_init(&f, {a.c_str(), nullptr});
+    GPR_ASSERT(matched_method(&f, a.c_str(), "h") == 0);
+    GPR_ASSERT(matched_method(&f, b.c_str(), "h") == UNREGISTERED);
+    method_fixture_destroy(&f);
+  }
+}
+
+/* Enough methods that some buckets need a displacement other than zero. */
+void test_many_registered_methods(void) {
+  const int kMethods = 1000;
+  std::vector<std::string> paths;
+  for (int i = 0; i < kMethods; i++) {
+    paths.push_back("/many/" + std::to_string(i));
+  }
+  std::vector<const char*> methods;
+  for (int i = 0; i < kMethods; i++) {
+    methods.push_back(paths[i].c_str());
+    methods.push_back(nullptr);
+  }
+  method_fixture f;
+  method_fixture_init(&f, methods);
+  for (int i = 0; i < kMethods; i++) {
+    GPR_ASSERT(matched_method(&f, paths[i].c_str(), "h") == i);
+  }
+  GPR_ASSERT(matched_method(&f, "/many/none", "h") == UNREGISTERED);
+  method_fixture_destroy(&f);
+}
+
 void test_request_call_on_no_server_cq(void) {
   grpc_completion_queue* cc = grpc_completion_queue_create_for_next(nullptr);
   grpc_server* server = grpc_server_create(nullptr, nullptr);
@@ -151,6 +392,10 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_register_method_fail();
+  test_register_method_after_start();
+  test_registered_method_host_precedence();
+  test_registered_method_hash_collision();
+  test_many_registered_methods();
   test_request_call_on_no_server_cq();
 #ifndef GRPC_UV
   test_bind_server_twice();
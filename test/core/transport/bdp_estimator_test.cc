@@ -83,6 +83,43 @@ TEST(BdpEstimatorTest, GetEstimate1Sample) {
   est.EstimateBdp();
 }
 
+TEST(BdpEstimatorTest, LastSamples) {
+  BdpEstimator est("test");
+  EXPECT_EQ(est.LastRttSample(), 0);
+  EXPECT_EQ(est.LastBandwidthSample(), 0);
+  grpc_core::ExecCtx exec_ctx;
+  est.SchedulePing();
+  est.StartPing();
+  est.AddIncomingBytes(3000);
+  inc_time();
+  est.CompletePing();
+  EXPECT_EQ(est.LastRttSample(), 30);
+  EXPECT_EQ(est.LastBandwidthSample(), 100);
+}
+
+TEST(BdpEstimatorTest, BandwidthIsWindowedMax) {
+  BdpEstimator est("test");
+  grpc_core::ExecCtx exec_ctx;
+  auto ping = [&est](int64_t bytes) {
+    est.SchedulePing();
+    est.StartPing();
+    est.AddIncomingBytes(bytes);
+    inc_time();
+    est.CompletePing();
+  };
+  ping(30000);
+  EXPECT_EQ(est.EstimateBandwidth(), 1000);
+  // a burst is remembered for ten pings, then forgotten
+  for (int i = 0; i < 9; i++) {
+    ping(3000);
+    EXPECT_EQ(est.EstimateBandwidth(), 1000);
+  }
+  ping(3000);
+  EXPECT_EQ(est.EstimateBandwidth(), 100);
+  EXPECT_EQ(est.MinRtt(), 30);
+  EXPECT_EQ(est.ModelBdp(), 3000);
+}
+
 TEST(BdpEstimatorTest, GetEstimate2Samples) {
   BdpEstimator est("test");
   AddSample(&est, 100);
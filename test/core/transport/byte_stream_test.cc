@@ -242,6 +242,47 @@ TEST(CachingByteStream, SharedCache) {
   cache.Destroy();
 }
 
+TEST(CachingByteStream, StopCaching) {
+  grpc_core::ExecCtx exec_ctx;
+  // Create and populate slice buffer byte stream.
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  grpc_slice input[] = {
+      grpc_slice_from_static_string("foo"),
+      grpc_slice_from_static_string("bar"),
+  };
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(input); ++i) {
+    grpc_slice_buffer_add(&buffer, input[i]);
+  }
+  SliceBufferByteStream underlying_stream(&buffer, 0);
+  grpc_slice_buffer_destroy_internal(&buffer);
+  // Create cache and caching stream.
+  ByteStreamCache cache((OrphanablePtr<ByteStream>(&underlying_stream)));
+  ByteStreamCache::CachingByteStream stream(&cache);
+  grpc_closure closure;
+  GRPC_CLOSURE_INIT(&closure, NotCalledClosure, nullptr,
+                    grpc_schedule_on_exec_ctx);
+  // Read the first slice, which is cached.
+  EXPECT_TRUE(stream.Next(~(size_t)0, &closure));
+  grpc_slice output;
+  grpc_error* error = stream.Pull(&output);
+  EXPECT_TRUE(error == GRPC_ERROR_NONE);
+  EXPECT_TRUE(grpc_slice_eq(input[0], output));
+  grpc_slice_unref_internal(output);
+  EXPECT_EQ(cache.cache_buffer()->count, 1u);
+  // Read the second slice, which is not.
+  cache.StopCaching();
+  EXPECT_TRUE(stream.Next(~(size_t)0, &closure));
+  error = stream.Pull(&output);
+  EXPECT_TRUE(error == GRPC_ERROR_NONE);
+  EXPECT_TRUE(grpc_slice_eq(input[1], output));
+  grpc_slice_unref_internal(output);
+  EXPECT_EQ(cache.cache_buffer()->count, 1u);
+  // Clean up.
+  stream.Orphan();
+  cache.Destroy();
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -60,6 +60,16 @@ static grpc_slice HUFF(const char* s) {
   return out;
 }
 
+static grpc_slice HUFF_IF_SHORTER(const char* s) {
+  grpc_slice ss = grpc_slice_from_copied_string(s);
+  grpc_slice out;
+  if (!grpc_chttp2_huffman_compress_if_shorter(ss, &out)) {
+    out = grpc_slice_ref(ss);
+  }
+  grpc_slice_unref(ss);
+  return out;
+}
+
 #define EXPECT_SLICE_EQ(expected, slice)                                    \
   expect_slice_eq(                                                          \
       grpc_slice_from_copied_buffer(expected, sizeof(expected) - 1), slice, \
@@ -133,6 +143,19 @@ int main(int /*argc*/, char** /*argv*/) {
   EXPECT_SLICE_EQ(
       "\x9d\x29\xad\x17\x18\x63\xc7\x8f\x0b\x97\xc8\xe9\xae\x82\xae\x43\xd3",
       HUFF("https://www.example.com"));
+  /* codes too long to share a 32 bit accumulator */
+  EXPECT_SLICE_EQ("\xff\xff\xb1\xff\xff\xfc\x3f\xff\xff\xf3",
+                  HUFF("\x01\xfe\x7f"));
+  EXPECT_SLICE_EQ("\xff\xff\xff\xfb\xff\xff\xfc\xff", HUFF("\x16\x17"));
+
+  /* Huffman encoding only when it is shorter */
+  EXPECT_SLICE_EQ("\xf1\xe3\xc2\xe5\xf2\x3a\x6b\xa0\xab\x90\xf4\xff",
+                  HUFF_IF_SHORTER("www.example.com"));
+  EXPECT_SLICE_EQ("\xa8\xeb\x10\x64\x9c\xbf", HUFF_IF_SHORTER("no-cache"));
+  EXPECT_SLICE_EQ("", HUFF_IF_SHORTER(""));
+  EXPECT_SLICE_EQ("a", HUFF_IF_SHORTER("a"));
+  EXPECT_SLICE_EQ("aa", HUFF_IF_SHORTER("aa"));
+  EXPECT_SLICE_EQ("A{}", HUFF_IF_SHORTER("A{}"));
 
   /* Various test vectors for combined encoding */
   EXPECT_COMBINED_EQUIV("");
@@ -159,6 +159,68 @@ TEST_F(ContextListTest, NonEmptyListEmptyTimestamp) {
   exec_ctx.Flush();
 }
 
+/** Tests that the elements of streams with a CallWriteTimestamps record the
+ * timestamps there instead of calling the global callback, and that writes
+ * cut short by an error are not recorded.
+ */
+TEST_F(ContextListTest, PerCallWriteTimestamps) {
+  grpc_core::ContextList* list = nullptr;
+  const int kNumElems = 2;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_stream_refcount ref;
+  GRPC_STREAM_REF_INIT(&ref, 1, nullptr, nullptr, "dummy ref");
+  grpc_resource_quota* resource_quota =
+      grpc_resource_quota_create("context_list_test");
+  grpc_endpoint* mock_endpoint =
+      grpc_mock_endpoint_create(discard_write, resource_quota);
+  grpc_transport* t =
+      grpc_create_chttp2_transport(nullptr, mock_endpoint, true);
+  std::vector<grpc_chttp2_stream*> s;
+  s.reserve(kNumElems);
+  std::vector<RefCountedPtr<CallWriteTimestamps>> write_timestamps;
+  gpr_atm verifier_called[kNumElems];
+  for (auto i = 0; i < kNumElems; i++) {
+    s.push_back(static_cast<grpc_chttp2_stream*>(
+        gpr_malloc(grpc_transport_stream_size(t))));
+    grpc_transport_init_stream(reinterpret_cast<grpc_transport*>(t),
+                               reinterpret_cast<grpc_stream*>(s[i]), &ref,
+                               nullptr, nullptr);
+    s[i]->context = &verifier_called[i];
+    s[i]->byte_counter = kByteOffset + i;
+    write_timestamps.push_back(MakeRefCounted<CallWriteTimestamps>());
+    s[i]->write_timestamps = write_timestamps[i];
+    gpr_atm_rel_store(&verifier_called[i], static_cast<gpr_atm>(0));
+    grpc_core::ContextList::Append(&list, s[i]);
+  }
+  grpc_core::Timestamps ts;
+  ts.sendmsg_time.time = gpr_time_from_seconds(1, GPR_CLOCK_REALTIME);
+  ts.acked_time.time = gpr_time_from_seconds(2, GPR_CLOCK_REALTIME);
+  grpc_core::ContextList::Execute(list, &ts, GRPC_ERROR_NONE);
+  list = nullptr;
+  for (auto i = 0; i < kNumElems; i++) {
+    grpc_core::ContextList::Append(&list, s[i]);
+  }
+  grpc_error* error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("shutdown");
+  grpc_core::ContextList::Execute(list, &ts, error);
+  GRPC_ERROR_UNREF(error);
+  for (auto i = 0; i < kNumElems; i++) {
+    EXPECT_EQ(gpr_atm_acq_load(&verifier_called[i]), static_cast<gpr_atm>(0));
+    grpc_core::Timestamps last;
+    EXPECT_EQ(write_timestamps[i]->Get(&last), 1u);
+    EXPECT_EQ(last.byte_offset, kByteOffset + i);
+    EXPECT_EQ(gpr_time_cmp(last.sendmsg_time.time, ts.sendmsg_time.time), 0);
+    EXPECT_EQ(gpr_time_cmp(last.acked_time.time, ts.acked_time.time), 0);
+    grpc_transport_destroy_stream(reinterpret_cast<grpc_transport*>(t),
+                                  reinterpret_cast<grpc_stream*>(s[i]),
+                                  nullptr);
+    exec_ctx.Flush();
+    gpr_free(s[i]);
+  }
+  grpc_transport_destroy(t);
+  grpc_resource_quota_unref(resource_quota);
+  exec_ctx.Flush();
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
@@ -26,6 +26,7 @@
 #include <grpc/support/string_util.h>
 
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -47,6 +48,7 @@ typedef struct {
   bool eof;
   bool use_true_binary_metadata;
   bool only_intern_key;
+  bool intern_nothing;
 } verify_params;
 
 /* verify that the output generated by encoding the stream matches the
@@ -72,12 +74,15 @@ static void verify(const verify_params params, const char* expected,
       e[i - 1].next = &e[i];
       e[i].prev = &e[i - 1];
     }
+    grpc_slice key_slice = grpc_slice_from_static_string(key);
     grpc_slice value_slice = grpc_slice_from_static_string(value);
-    if (!params.only_intern_key) {
-      value_slice = grpc_slice_intern(value_slice);
+    if (!params.intern_nothing) {
+      key_slice = grpc_slice_intern(key_slice);
+      if (!params.only_intern_key) {
+        value_slice = grpc_slice_intern(value_slice);
+      }
     }
-    e[i].md = grpc_mdelem_from_slices(
-        grpc_slice_intern(grpc_slice_from_static_string(key)), value_slice);
+    e[i].md = grpc_mdelem_from_slices(key_slice, value_slice);
   }
   e[0].prev = nullptr;
   e[nheaders - 1].next = nullptr;
@@ -244,12 +249,226 @@ static void test_interned_key_indexed() {
   verify_params params = {false, false, true};
   verify(params, "000009 0104 deadbeef 40 0161 0162 0f2f 0163", 2, "a", "b",
          "a", "c");
+  /* seen twice: both elems get interned and added to the table */
+  verify(params, "000006 0104 deadbeef 7e 0162 7e 0163", 2, "a", "b", "a",
+         "c");
   for (i = 0; i < 10; i++) {
-    verify(params, "000008 0104 deadbeef 0f2f 0162 0f2f 0163", 2, "a", "b", "a",
-           "c");
+    verify(params, "000002 0104 deadbeef bf be", 2, "a", "b", "a", "c");
   }
 }
 
+static void test_nothing_interned_indexed() {
+  int i;
+  verify_params params = {false, false, false, true};
+  verify(params, "00000a 0104 deadbeef 00 0178 0179 00 0178 017a", 2, "x",
+         "y", "x", "z");
+  /* seen twice: the key isn't in the table yet */
+  verify(params, "000008 0104 deadbeef 40 0178 0179 7e 017a", 2, "x", "y",
+         "x", "z");
+  for (i = 0; i < 10; i++) {
+    verify(params, "000002 0104 deadbeef bf be", 2, "x", "y", "x", "z");
+  }
+}
+
+static void test_never_indexed() {
+  int i;
+  verify_params params = {false, false, false};
+  for (i = 0; i < 3; i++) {
+    verify(params,
+           "000014 0104 deadbeef 10 0d 617574686f72697a6174696f6e 84 41496153",
+           1, "authorization", "secret");
+  }
+}
+
+static void test_huffman_values() {
+  verify_params params = {false, false, false};
+  /* shorter once huffman compressed */
+  verify(params,
+         "000010 0104 deadbeef 40 0161 8c f1e3c2e5f23a6ba0ab90f4ff", 1, "a",
+         "www.example.com");
+  /* no shorter once huffman compressed */
+  verify(params, "000007 0104 deadbeef 40 0162 03 417b7d", 1, "b", "A{}");
+}
+
+static void test_preencoded_static_elems() {
+  verify_params params = {false, false, false};
+  int i;
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data stats_before;
+  grpc_stats_collect(&stats_before);
+#endif
+  verify(params, "00000f 0104 deadbeef 40 0b 677270632d737461747573 01 30", 1,
+         "grpc-status", "0");
+  for (i = 0; i < 3; i++) {
+    verify(params, "000001 0104 deadbeef be", 1, "grpc-status", "0");
+  }
+  /* adding to the table moves the index of grpc-status: 0 */
+  verify(params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  for (i = 0; i < 2; i++) {
+    verify(params, "000001 0104 deadbeef bf", 1, "grpc-status", "0");
+  }
+  verify(params,
+         "00001b 0104 deadbeef 88 40 0c 636f6e74656e742d74797065 8b "
+         "1d75d0620d263d4c4d6564",
+         2, ":status", "200", "content-type", "application/grpc");
+  verify(params, "000002 0104 deadbeef 88 be", 2, ":status", "200",
+         "content-type", "application/grpc");
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data stats_after;
+  grpc_stats_collect(&stats_after);
+  /* a block is only copied once it has been sent fully indexed against the
+     same decoder table */
+  const int counter = GRPC_STATS_COUNTER_HPACK_SEND_PREENCODED;
+  GPR_ASSERT(stats_after.counters[counter] - stats_before.counters[counter] ==
+             3);
+#endif
+}
+
+/* Encodes \a extra (unless null) followed by the elems of \a group, linked as
+   a group or one by one. */
+static grpc_slice encode_group(grpc_chttp2_hpack_compressor* c,
+                               const grpc_mdelem_group* group, bool as_group,
+                               grpc_mdelem extra) {
+  grpc_metadata_batch b;
+  grpc_linked_mdelem extra_storage;
+  grpc_linked_mdelem storage[grpc_mdelem_group::kMaxElems];
+  grpc_metadata_batch_init(&b);
+  if (!GRPC_MDISNULL(extra)) {
+    GPR_ASSERT(grpc_metadata_batch_add_tail(&b, &extra_storage,
+                                            GRPC_MDELEM_REF(extra)) ==
+               GRPC_ERROR_NONE);
+  }
+  if (as_group) {
+    GPR_ASSERT(grpc_metadata_batch_link_tail_group(&b, storage, group) ==
+               GRPC_ERROR_NONE);
+  } else {
+    for (size_t i = 0; i < group->count; i++) {
+      storage[i].md = GRPC_MDELEM_REF(group->elems[i]);
+      GPR_ASSERT(grpc_metadata_batch_link_tail(&b, &storage[i],
+                                               group->idx[i]) ==
+                 GRPC_ERROR_NONE);
+    }
+  }
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_encode_header_options hopt = {0xdeadbeef, false, false, 16384, &stats};
+  grpc_chttp2_encode_header(c, nullptr, 0, &b, &hopt, &output);
+  grpc_slice merged = grpc_slice_merge(output.slices, output.count);
+  grpc_slice_buffer_destroy_internal(&output);
+  grpc_metadata_batch_destroy(&b);
+  return merged;
+}
+
+/* a group encodes to the same bytes as its elems one by one, and its
+   encoding is reused once all of them are indexed */
+static void test_mdelem_group() {
+  grpc_mdelem_group group;
+  grpc_mdelem_group_init(&group);
+  grpc_mdelem_group_add(&group, GRPC_MDELEM_TE_TRAILERS, GRPC_BATCH_TE);
+  grpc_mdelem_group_add(
+      &group,
+      grpc_mdelem_from_slices(GRPC_MDSTR_USER_AGENT,
+                              grpc_slice_intern(grpc_slice_from_static_string(
+                                  "grpc-c/test (linux; chttp2)"))),
+      GRPC_BATCH_USER_AGENT);
+  grpc_mdelem extra = grpc_mdelem_from_slices(
+      grpc_slice_intern(grpc_slice_from_static_string("x-extra")),
+      grpc_slice_intern(grpc_slice_from_static_string("1")));
+  grpc_chttp2_hpack_compressor plain;
+  grpc_chttp2_hpack_compressor_init(&plain);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data stats_before;
+  grpc_stats_collect(&stats_before);
+#endif
+  for (int i = 0; i < 8; i++) {
+    /* new table entries part way through move every dynamic index */
+    grpc_mdelem first = i == 4 ? extra : GRPC_MDNULL;
+    grpc_slice got = encode_group(&g_compressor, &group, true, first);
+    grpc_slice expect = encode_group(&plain, &group, false, first);
+    if (!grpc_slice_eq(got, expect)) {
+      char* expect_str =
+          grpc_dump_slice(expect, GPR_DUMP_HEX | GPR_DUMP_ASCII);
+      char* got_str = grpc_dump_slice(got, GPR_DUMP_HEX | GPR_DUMP_ASCII);
+      gpr_log(GPR_ERROR, "mismatched group output in round %d", i);
+      gpr_log(GPR_ERROR, "EXPECT: %s", expect_str);
+      gpr_log(GPR_ERROR, "GOT:    %s", got_str);
+      gpr_free(expect_str);
+      gpr_free(got_str);
+      g_failure = 1;
+    }
+    grpc_slice_unref_internal(got);
+    grpc_slice_unref_internal(expect);
+  }
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data stats_after;
+  grpc_stats_collect(&stats_after);
+  const int counter = GRPC_STATS_COUNTER_HPACK_SEND_PREENCODED;
+  GPR_ASSERT(stats_after.counters[counter] > stats_before.counters[counter]);
+#endif
+  grpc_chttp2_hpack_compressor_destroy(&plain);
+  GRPC_MDELEM_UNREF(extra);
+  grpc_mdelem_group_destroy(&group);
+}
+
+/* Encodes a header block of interned elems from \a n key/value pairs. */
+static grpc_slice encode_pairs(const char* const* pairs, size_t n) {
+  grpc_metadata_batch b;
+  grpc_linked_mdelem storage[4];
+  GPR_ASSERT(n <= GPR_ARRAY_SIZE(storage));
+  grpc_metadata_batch_init(&b);
+  for (size_t i = 0; i < n; i++) {
+    grpc_mdelem elem = grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string(pairs[2 * i])),
+        grpc_slice_intern(grpc_slice_from_copied_string(pairs[2 * i + 1])));
+    GPR_ASSERT(grpc_metadata_batch_add_tail(&b, &storage[i], elem) ==
+               GRPC_ERROR_NONE);
+  }
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_encode_header_options hopt = {0xdeadbeef, false, false, 16384, &stats};
+  grpc_chttp2_encode_header(&g_compressor, nullptr, 0, &b, &hopt, &output);
+  grpc_slice merged = grpc_slice_merge(output.slices, output.count);
+  grpc_slice_buffer_destroy_internal(&output);
+  grpc_metadata_batch_destroy(&b);
+  return merged;
+}
+
+/* A header whose value changes on every request, next to one that never
+   changes: once the sketch has seen a few of the values, it keeps them out
+   of the table, so that they don't keep evicting the popular header. */
+static void test_high_cardinality_values() {
+  const int kWarmup = 256;
+  const int kRequests = 4096;
+  int values_added = 0;
+  int popular_misses = 0;
+  for (int i = 0; i < kWarmup + kRequests; i++) {
+    char value[16];
+    snprintf(value, sizeof(value), "%d", i);
+    const char* pairs[] = {"x-popular", "yes", "x-request-id", value};
+    grpc_slice got = encode_pairs(pairs, 2);
+    const uint8_t* bytes = GRPC_SLICE_START_PTR(got);
+    GPR_ASSERT(GRPC_SLICE_LENGTH(got) > 10);
+    if (i >= kWarmup) {
+      /* the popular header comes first, right after the frame header: it is
+         a single byte when indexed */
+      if ((bytes[9] & 0x80) == 0) {
+        popular_misses++;
+      } else if ((bytes[10] & 0xc0) == 0x40) {
+        values_added++;
+      }
+    }
+    grpc_slice_unref_internal(got);
+  }
+  gpr_log(GPR_INFO, "values added: %d, popular header misses: %d",
+          values_added, popular_misses);
+  GPR_ASSERT(values_added <= kRequests / 64);
+  GPR_ASSERT(popular_misses <= 4);
+}
+
 static void run_test(void (*test)(), const char* name) {
   gpr_log(GPR_INFO, "RUN TEST: %s", name);
   grpc_core::ExecCtx exec_ctx;
@@ -267,6 +486,12 @@ int main(int argc, char** argv) {
   TEST(test_decode_table_overflow);
   TEST(test_encode_header_size);
   TEST(test_interned_key_indexed);
+  TEST(test_nothing_interned_indexed);
+  TEST(test_never_indexed);
+  TEST(test_huffman_values);
+  TEST(test_preencoded_static_elems);
+  TEST(test_mdelem_group);
+  TEST(test_high_cardinality_values);
   grpc_shutdown();
   for (i = 0; i < num_to_delete; i++) {
     gpr_free(to_delete[i]);
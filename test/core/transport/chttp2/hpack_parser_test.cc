@@ -25,6 +25,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/parse_hexstring.h"
 #include "test/core/util/slice_splitter.h"
@@ -212,11 +213,111 @@ static void test_vectors(grpc_slice_split_mode mode) {
   grpc_chttp2_hpack_parser_destroy(&parser);
 }
 
+static grpc_error* on_huffman_hdr(void* ud, grpc_mdelem md) {
+  grpc_slice* expected = static_cast<grpc_slice*>(ud);
+  GPR_ASSERT(grpc_slice_str_cmp(GRPC_MDKEY(md), "x-test") == 0);
+  GPR_ASSERT(grpc_slice_eq(GRPC_MDVALUE(md), *expected));
+  GRPC_MDELEM_UNREF(md);
+  *expected = grpc_empty_slice();
+  return GRPC_ERROR_NONE;
+}
+
+/* parses a literal header whose value is the huffman encoding of \a value */
+static void test_huffman_value(grpc_slice_split_mode mode, grpc_slice value) {
+  grpc_chttp2_hpack_parser parser;
+  grpc_core::ExecCtx exec_ctx;
+  size_t nbits = 0;
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(value); i++) {
+    nbits += grpc_chttp2_huffsyms[GRPC_SLICE_START_PTR(value)[i]].length;
+  }
+  size_t length = (nbits + 7) / 8;
+  uint8_t* buf = static_cast<uint8_t*>(gpr_malloc(length + 13));
+  uint8_t* out = buf;
+  memcpy(out, "\x00\x06x-test", 8);
+  out += 8;
+  /* huffman encoded string length, 7 bit prefix */
+  if (length < 127) {
+    *out++ = static_cast<uint8_t>(0x80 | length);
+  } else {
+    *out++ = 0xff;
+    size_t rest = length - 127;
+    while (rest >= 128) {
+      *out++ = static_cast<uint8_t>(0x80 | (rest & 0x7f));
+      rest >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(rest);
+  }
+  uint64_t bits = 0;
+  size_t count = 0;
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(value); i++) {
+    const grpc_chttp2_huffsym& sym =
+        grpc_chttp2_huffsyms[GRPC_SLICE_START_PTR(value)[i]];
+    bits = bits << sym.length | sym.bits;
+    count += sym.length;
+    while (count >= 8) {
+      count -= 8;
+      *out++ = static_cast<uint8_t>(bits >> count);
+    }
+  }
+  if (count > 0) {
+    /* pad with the start of EOS */
+    *out++ = static_cast<uint8_t>(bits << (8 - count) | (0xff >> count));
+  }
+  grpc_slice input =
+      grpc_slice_from_copied_buffer(reinterpret_cast<char*>(buf), out - buf);
+  gpr_free(buf);
+
+  grpc_slice expected = value;
+  grpc_chttp2_hpack_parser_init(&parser);
+  parser.on_header = on_huffman_hdr;
+  parser.on_header_user_data = &expected;
+  grpc_slice* slices;
+  size_t nslices;
+  grpc_split_slices(mode, &input, 1, &slices, &nslices);
+  grpc_slice_unref(input);
+  for (size_t i = 0; i < nslices; i++) {
+    GPR_ASSERT(grpc_chttp2_hpack_parser_parse(&parser, slices[i]) ==
+               GRPC_ERROR_NONE);
+    grpc_slice_unref(slices[i]);
+  }
+  gpr_free(slices);
+  /* the header was seen */
+  GPR_ASSERT(GRPC_SLICE_LENGTH(expected) == 0);
+  grpc_chttp2_hpack_parser_destroy(&parser);
+}
+
+static void test_huffman_values(grpc_slice_split_mode mode) {
+  /* every symbol, including the ones with the longest codes */
+  grpc_slice value = GRPC_SLICE_MALLOC(4 * 256);
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(value); i++) {
+    GRPC_SLICE_START_PTR(value)[i] = static_cast<uint8_t>(i * 7);
+  }
+  test_huffman_value(mode, value);
+  grpc_slice_unref(value);
+  /* a long token made of the (short) symbols of base64 */
+  static const char alphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  value = GRPC_SLICE_MALLOC(1000);
+  for (size_t i = 0; i < GRPC_SLICE_LENGTH(value); i++) {
+    GRPC_SLICE_START_PTR(value)[i] = alphabet[(i * 13) % 64];
+  }
+  test_huffman_value(mode, value);
+  grpc_slice_unref(value);
+  /* strings short enough to end in the middle of the first lookup */
+  for (size_t i = 0; i < 8; i++) {
+    value = grpc_slice_from_copied_buffer("a\xfe\x10z<y0e", i);
+    test_huffman_value(mode, value);
+    grpc_slice_unref(value);
+  }
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_vectors(GRPC_SLICE_SPLIT_MERGE_ALL);
   test_vectors(GRPC_SLICE_SPLIT_ONE_BYTE);
+  test_huffman_values(GRPC_SLICE_SPLIT_MERGE_ALL);
+  test_huffman_values(GRPC_SLICE_SPLIT_ONE_BYTE);
   grpc_shutdown();
   return 0;
 }
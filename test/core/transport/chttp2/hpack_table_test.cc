@@ -147,6 +147,53 @@ static void test_many_additions(void) {
   grpc_chttp2_hptbl_destroy(&tbl);
 }
 
+static void test_lazy_allocation(void) {
+  grpc_chttp2_hptbl tbl;
+  uint32_t i;
+  char* key;
+  char* value;
+
+  LOG_TEST("test_lazy_allocation");
+
+  grpc_core::ExecCtx exec_ctx;
+
+  /* nothing is allocated until the first insertion */
+  GPR_ASSERT(tbl.ents == nullptr);
+  GPR_ASSERT(tbl.cap_entries == 0);
+  GPR_ASSERT(GRPC_MDISNULL(
+      grpc_chttp2_hptbl_lookup(&tbl, 1 + GRPC_CHTTP2_LAST_STATIC_ENTRY)));
+
+  for (i = 0; i < tbl.max_entries; i++) {
+    grpc_mdelem elem;
+    gpr_asprintf(&key, "K%d", i);
+    gpr_asprintf(&value, "V%d", i);
+    elem = grpc_mdelem_from_slices(grpc_slice_from_copied_string(key),
+                                   grpc_slice_from_copied_string(value));
+    GPR_ASSERT(grpc_chttp2_hptbl_add(&tbl, elem) == GRPC_ERROR_NONE);
+    GRPC_MDELEM_UNREF(elem);
+    gpr_free(key);
+    gpr_free(value);
+    if (i == 0) {
+      GPR_ASSERT(tbl.cap_entries == grpc_chttp2_hptbl::kMinCapacity);
+    }
+    GPR_ASSERT(tbl.cap_entries <= tbl.max_entries);
+    GPR_ASSERT(tbl.num_ents <= tbl.cap_entries);
+  }
+  gpr_asprintf(&key, "K%d", i - 1);
+  gpr_asprintf(&value, "V%d", i - 1);
+  assert_index(&tbl, 1 + GRPC_CHTTP2_LAST_STATIC_ENTRY, key, value);
+  gpr_free(key);
+  gpr_free(value);
+
+  /* shrinking the table gives the memory back */
+  GPR_ASSERT(grpc_chttp2_hptbl_set_current_table_size(&tbl, 0) ==
+             GRPC_ERROR_NONE);
+  GPR_ASSERT(tbl.num_ents == 0);
+  GPR_ASSERT(tbl.cap_entries == grpc_chttp2_hptbl::kMinCapacity);
+
+  grpc_chttp2_hptbl_destroy(&tbl);
+}
+
 static grpc_chttp2_hptbl_find_result find_simple(grpc_chttp2_hptbl* tbl,
                                                  const char* key,
                                                  const char* value) {
@@ -268,6 +315,7 @@ int main(int argc, char** argv) {
   grpc_init();
   test_static_lookup();
   test_many_additions();
+  test_lazy_allocation();
   test_find();
   grpc_shutdown();
   return 0;
@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/ext/transport/chttp2/transport/keepalive_scheduler.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "test/core/util/test_config.h"
+
+#define LOG_TEST(x) gpr_log(GPR_INFO, "%s", x)
+
+typedef struct {
+  gpr_event done;
+  grpc_error* error;
+  grpc_closure on_due;
+} due_state;
+
+static void on_due(void* arg, grpc_error* error) {
+  due_state* state = static_cast<due_state*>(arg);
+  state->error = GRPC_ERROR_REF(error);
+  gpr_event_set(&state->done, (void*)1);
+}
+
+static void due_state_init(due_state* state) {
+  gpr_event_init(&state->done);
+  state->error = GRPC_ERROR_NONE;
+  GRPC_CLOSURE_INIT(&state->on_due, on_due, state, grpc_schedule_on_exec_ctx);
+}
+
+static bool wait_due(due_state* state, int timeout_ms) {
+  return gpr_event_wait(&state->done,
+                        grpc_timeout_milliseconds_to_deadline(timeout_ms)) !=
+         nullptr;
+}
+
+static void schedule(grpc_core::KeepaliveScheduler::Timer* timer,
+                     grpc_millis interval, grpc_millis slack,
+                     due_state* state) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::KeepaliveScheduler::Schedule(timer, interval, slack,
+                                          &state->on_due);
+}
+
+/* an idle timer runs its closure once the interval has elapsed */
+static void test_fires_when_idle(void) {
+  grpc_core::KeepaliveScheduler::Timer timer;
+  due_state state;
+
+  LOG_TEST("test_fires_when_idle");
+
+  due_state_init(&state);
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  schedule(&timer, 100, 0, &state);
+  GPR_ASSERT(wait_due(&state, 5000));
+  GPR_ASSERT(state.error == GRPC_ERROR_NONE);
+  GPR_ASSERT(gpr_time_to_millis(gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC),
+                                             start)) >= 90);
+}
+
+/* activity keeps the closure from running, until it stops */
+static void test_activity_postpones(void) {
+  grpc_core::KeepaliveScheduler::Timer timer;
+  due_state state;
+
+  LOG_TEST("test_activity_postpones");
+
+  due_state_init(&state);
+  schedule(&timer, 300, 0, &state);
+  for (int i = 0; i < 12; i++) {
+    {
+      grpc_core::ExecCtx exec_ctx;
+      timer.RecordActivity();
+    }
+    GPR_ASSERT(!wait_due(&state, 50));
+  }
+  gpr_timespec last_activity = gpr_now(GPR_CLOCK_MONOTONIC);
+  GPR_ASSERT(wait_due(&state, 5000));
+  GPR_ASSERT(state.error == GRPC_ERROR_NONE);
+  GPR_ASSERT(gpr_time_to_millis(gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC),
+                                             last_activity)) >= 200);
+}
+
+/* cancelling runs the closure right away with an error, and leaves the other
+   timers of the same bucket alone */
+static void test_cancel(void) {
+  grpc_core::KeepaliveScheduler::Timer timer1;
+  grpc_core::KeepaliveScheduler::Timer timer2;
+  due_state state1;
+  due_state state2;
+
+  LOG_TEST("test_cancel");
+
+  due_state_init(&state1);
+  due_state_init(&state2);
+  schedule(&timer1, 500, 100, &state1);
+  schedule(&timer2, 500, 100, &state2);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::KeepaliveScheduler::Cancel(&timer1);
+  }
+  GPR_ASSERT(wait_due(&state1, 100));
+  GPR_ASSERT(state1.error == GRPC_ERROR_CANCELLED);
+  GPR_ASSERT(!wait_due(&state2, 200));
+  GPR_ASSERT(wait_due(&state2, 5000));
+  GPR_ASSERT(state2.error == GRPC_ERROR_NONE);
+  {
+    /* cancelling a timer that already ran is a no-op */
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::KeepaliveScheduler::Cancel(&timer2);
+  }
+}
+
+/* the last timer of a bucket may be cancelled, and the bucket reused */
+static void test_cancel_last_and_reschedule(void) {
+  grpc_core::KeepaliveScheduler::Timer timer;
+  due_state state;
+
+  LOG_TEST("test_cancel_last_and_reschedule");
+
+  due_state_init(&state);
+  schedule(&timer, 200, 1000, &state);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::KeepaliveScheduler::Cancel(&timer);
+  }
+  GPR_ASSERT(wait_due(&state, 100));
+  GPR_ASSERT(state.error == GRPC_ERROR_CANCELLED);
+  due_state_init(&state);
+  schedule(&timer, 200, 1000, &state);
+  GPR_ASSERT(wait_due(&state, 5000));
+  GPR_ASSERT(state.error == GRPC_ERROR_NONE);
+}
+
+/* a peer's floor only ever goes up, and is kept per peer */
+static void test_peer_interval_floor(void) {
+  LOG_TEST("test_peer_interval_floor");
+
+  GPR_ASSERT(grpc_core::KeepaliveScheduler::PeerIntervalFloor("peer_a") == 0);
+  grpc_core::KeepaliveScheduler::RaisePeerIntervalFloor("peer_a", 2000);
+  GPR_ASSERT(grpc_core::KeepaliveScheduler::PeerIntervalFloor("peer_a") ==
+             2000);
+  grpc_core::KeepaliveScheduler::RaisePeerIntervalFloor("peer_a", 1000);
+  GPR_ASSERT(grpc_core::KeepaliveScheduler::PeerIntervalFloor("peer_a") ==
+             2000);
+  grpc_core::KeepaliveScheduler::RaisePeerIntervalFloor("peer_a", 4000);
+  GPR_ASSERT(grpc_core::KeepaliveScheduler::PeerIntervalFloor("peer_a") ==
+             4000);
+  GPR_ASSERT(grpc_core::KeepaliveScheduler::PeerIntervalFloor("peer_b") == 0);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  test_fires_when_idle();
+  test_activity_postpones();
+  test_cancel();
+  test_cancel_last_and_reschedule();
+  test_peer_interval_floor();
+  grpc_shutdown();
+  return 0;
+}
@@ -69,14 +69,14 @@ static void test_basic_add_find(uint32_t n) {
 
 /* verify that for_each gets the right values during test_delete_evens_XXX */
 static void verify_for_each(void* user_data, uint32_t stream_id, void* ptr) {
-  uint32_t* for_each_check = static_cast<uint32_t*>(user_data);
-  GPR_ASSERT(ptr);
-  GPR_ASSERT(*for_each_check == stream_id);
-  *for_each_check += 2;
+  uint32_t* for_each_count = static_cast<uint32_t*>(user_data);
+  GPR_ASSERT((void*)(uintptr_t)stream_id == ptr);
+  GPR_ASSERT(stream_id & 1);
+  (*for_each_count)++;
 }
 
 static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
-  uint32_t for_each_check = 1;
+  uint32_t for_each_count = 0;
   uint32_t i;
   size_t got;
 
@@ -91,12 +91,9 @@ static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
     }
   }
 
-  grpc_chttp2_stream_map_for_each(map, verify_for_each, &for_each_check);
-  if (n & 1) {
-    GPR_ASSERT(for_each_check == n + 2);
-  } else {
-    GPR_ASSERT(for_each_check == n + 1);
-  }
+  grpc_chttp2_stream_map_for_each(map, verify_for_each, &for_each_count);
+  GPR_ASSERT(for_each_count == (n + 1) / 2);
+  GPR_ASSERT(for_each_count == grpc_chttp2_stream_map_size(map));
 }
 
 /* add a bunch of keys, delete the even ones, and make sure the map is
@@ -142,26 +139,113 @@ static void test_delete_evens_incremental(uint32_t n) {
 }
 
 /* add a bunch of keys, delete old ones after some time, ensure the
-   backing array does not grow */
+   backing array does not grow once it fits the live keys */
 static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map map;
   uint32_t i;
   uint32_t del;
+  size_t capacity;
 
   LOG_TEST("test_periodic_compaction");
   gpr_log(GPR_INFO, "n = %d", n);
 
   grpc_chttp2_stream_map_init(&map, 16);
   GPR_ASSERT(map.capacity == 16);
+  capacity = map.capacity;
   for (i = 1; i <= n; i++) {
     grpc_chttp2_stream_map_add(&map, i, (void*)static_cast<uintptr_t>(i));
+    if (i == 9) {
+      capacity = map.capacity;
+    }
     if (i > 8) {
       del = i - 8;
       GPR_ASSERT((void*)(uintptr_t)del ==
                  grpc_chttp2_stream_map_delete(&map, del));
     }
   }
-  GPR_ASSERT(map.capacity == 16);
+  GPR_ASSERT(map.capacity == capacity);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+static void delete_for_each(void* user_data, uint32_t stream_id, void* ptr) {
+  grpc_chttp2_stream_map* map = static_cast<grpc_chttp2_stream_map*>(user_data);
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(map, stream_id));
+}
+
+/* delete every key from a for_each callback, as closing a transport does */
+static void test_delete_during_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_delete_during_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, (void*)static_cast<uintptr_t>(i));
+  }
+  grpc_chttp2_stream_map_for_each(&map, delete_for_each, &map);
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  GPR_ASSERT(nullptr == grpc_chttp2_stream_map_rand(&map));
+  for (i = 1; i <= n; i++) {
+    GPR_ASSERT(nullptr == grpc_chttp2_stream_map_find(&map, i));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+/* delete keys and add them back */
+static void test_readd(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_readd");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, (void*)static_cast<uintptr_t>(i));
+  }
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_delete(&map, i);
+    grpc_chttp2_stream_map_add(&map, i, (void*)static_cast<uintptr_t>(i + 1));
+  }
+  GPR_ASSERT(n == grpc_chttp2_stream_map_size(&map));
+  for (i = 1; i <= n; i++) {
+    GPR_ASSERT((void*)(uintptr_t)(i + 1) ==
+               grpc_chttp2_stream_map_find(&map, i));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+/* shrink an emptied map, and check that it grows back */
+static void test_shrink(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_shrink");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, (void*)static_cast<uintptr_t>(i));
+  }
+  const size_t grown = map.capacity;
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_shrink(&map, 8));
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_delete(&map, i);
+  }
+  const size_t freed = grpc_chttp2_stream_map_shrink(&map, 8);
+  GPR_ASSERT(map.capacity == 8);
+  GPR_ASSERT(freed == (grown - map.capacity) *
+                          (sizeof(uint32_t) + sizeof(void*)));
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_shrink(&map, 8));
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, (void*)static_cast<uintptr_t>(i));
+  }
+  GPR_ASSERT(n == grpc_chttp2_stream_map_size(&map));
+  for (i = 1; i <= n; i++) {
+    GPR_ASSERT((void*)(uintptr_t)i == grpc_chttp2_stream_map_find(&map, i));
+  }
   grpc_chttp2_stream_map_destroy(&map);
 }
 
@@ -180,6 +264,9 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_delete_during_for_each(n);
+    test_readd(n);
+    test_shrink(n);
 
     tmp = n;
     n += prev;
@@ -61,6 +61,21 @@ class Watcher : public ConnectivityStateWatcherInterface {
   bool* destroyed_;
 };
 
+class AsyncWatcher : public AsyncConnectivityStateWatcherInterface {
+ public:
+  AsyncWatcher(int* count, grpc_connectivity_state* output)
+      : count_(count), output_(output) {}
+
+ private:
+  void OnConnectivityStateChange(grpc_connectivity_state new_state) override {
+    ++*count_;
+    *output_ = new_state;
+  }
+
+  int* count_;
+  grpc_connectivity_state* output_;
+};
+
 TEST(StateTracker, SetAndGetState) {
   ConnectivityStateTracker tracker("xxx", GRPC_CHANNEL_CONNECTING);
   EXPECT_EQ(tracker.state(), GRPC_CHANNEL_CONNECTING);
@@ -180,6 +195,45 @@ TEST(StateTracker, DoNotNotifyShutdownAtDestructionIfAlreadyInShutdown) {
   EXPECT_EQ(state, GRPC_CHANNEL_SHUTDOWN);
 }
 
+TEST(StateTracker, AsyncWatcherGetsOnlyLatestState) {
+  int count = 0;
+  grpc_connectivity_state state = GRPC_CHANNEL_IDLE;
+  ConnectivityStateTracker tracker("xxx", GRPC_CHANNEL_CONNECTING);
+  {
+    ExecCtx exec_ctx;
+    tracker.AddWatcher(GRPC_CHANNEL_CONNECTING,
+                       MakeOrphanable<AsyncWatcher>(&count, &state));
+    tracker.SetState(GRPC_CHANNEL_READY, "whee");
+    tracker.SetState(GRPC_CHANNEL_TRANSIENT_FAILURE, "whee");
+    EXPECT_EQ(count, 0);
+  }
+  // The two changes were coalesced into one notification.
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(state, GRPC_CHANNEL_TRANSIENT_FAILURE);
+}
+
+TEST(StateTracker, AsyncWatcherNotNotifiedOfFlapBack) {
+  int count = 0;
+  grpc_connectivity_state state = GRPC_CHANNEL_IDLE;
+  ConnectivityStateTracker tracker("xxx", GRPC_CHANNEL_READY);
+  {
+    ExecCtx exec_ctx;
+    tracker.AddWatcher(GRPC_CHANNEL_READY,
+                       MakeOrphanable<AsyncWatcher>(&count, &state));
+    tracker.SetState(GRPC_CHANNEL_TRANSIENT_FAILURE, "whee");
+    tracker.SetState(GRPC_CHANNEL_READY, "whee");
+  }
+  // The watcher never saw the state change away from READY.
+  EXPECT_EQ(count, 0);
+  EXPECT_EQ(state, GRPC_CHANNEL_IDLE);
+  {
+    ExecCtx exec_ctx;
+    tracker.SetState(GRPC_CHANNEL_SHUTDOWN, "whee");
+  }
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(state, GRPC_CHANNEL_SHUTDOWN);
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -29,6 +29,7 @@
 #include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_table.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/static_metadata.h"
@@ -146,6 +147,90 @@ static void test_create_many_persistant_metadata(void) {
   gpr_free(created);
 }
 
+#define CONCURRENT_THREADS 8
+
+static void concurrent_interning_thread(void* arg) {
+  const grpc_mdelem* pinned = static_cast<const grpc_mdelem*>(arg);
+  char buffer[GPR_LTOA_MIN_BUFSIZE];
+  grpc_core::ExecCtx exec_ctx;
+  for (long i = 0; i < MANY; i++) {
+    /* churn through elements that are dropped right away, so that the table
+       is collected and grown under the lookups of the pinned element */
+    gpr_ltoa(i, buffer);
+    GRPC_MDELEM_UNREF(grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string("c")),
+        grpc_slice_intern(grpc_slice_from_static_string(buffer))));
+    grpc_mdelem md = grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string("p")),
+        grpc_slice_intern(grpc_slice_from_static_string("v")));
+    GPR_ASSERT(md.payload == pinned->payload);
+    GRPC_MDELEM_UNREF(md);
+  }
+}
+
+static void test_concurrent_interning(void) {
+  gpr_log(GPR_INFO, "test_concurrent_interning");
+
+  grpc_init();
+  grpc_mdelem pinned;
+  {
+    grpc_core::ExecCtx exec_ctx;
+    pinned = grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string("p")),
+        grpc_slice_intern(grpc_slice_from_static_string("v")));
+  }
+  grpc_core::Thread threads[CONCURRENT_THREADS];
+  for (auto& th : threads) {
+    th = grpc_core::Thread("grpc_concurrent_interning",
+                           concurrent_interning_thread, &pinned);
+    th.Start();
+  }
+  for (auto& th : threads) {
+    th.Join();
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_MDELEM_UNREF(pinned);
+  }
+  grpc_shutdown();
+}
+
+static void concurrent_intern_unref_thread(void* /*arg*/) {
+  char buffer[GPR_LTOA_MIN_BUFSIZE];
+  grpc_core::ExecCtx exec_ctx;
+  for (long i = 0; i < MANY; i++) {
+    /* nothing else holds the "u" elements, so they are collected, and their
+       memory reclaimed, while the other threads look them up */
+    gpr_ltoa(i % 4, buffer);
+    grpc_mdelem md = grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string("u")),
+        grpc_slice_intern(grpc_slice_from_static_string(buffer)));
+    GPR_ASSERT(grpc_slice_str_cmp(GRPC_MDKEY(md), "u") == 0);
+    GPR_ASSERT(grpc_slice_str_cmp(GRPC_MDVALUE(md), buffer) == 0);
+    GRPC_MDELEM_UNREF(md);
+    gpr_ltoa(i, buffer);
+    GRPC_MDELEM_UNREF(grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string("c")),
+        grpc_slice_intern(grpc_slice_from_static_string(buffer))));
+  }
+}
+
+static void test_concurrent_intern_unref(void) {
+  gpr_log(GPR_INFO, "test_concurrent_intern_unref");
+
+  grpc_init();
+  grpc_core::Thread threads[CONCURRENT_THREADS];
+  for (auto& th : threads) {
+    th = grpc_core::Thread("grpc_concurrent_intern_unref",
+                           concurrent_intern_unref_thread, nullptr);
+    th.Start();
+  }
+  for (auto& th : threads) {
+    th.Join();
+  }
+  grpc_shutdown();
+}
+
 static void test_spin_creating_the_same_thing(bool intern_keys,
                                               bool intern_values) {
   gpr_log(GPR_INFO,
@@ -406,6 +491,8 @@ int main(int argc, char** argv) {
     }
   }
   test_create_many_persistant_metadata();
+  test_concurrent_interning();
+  test_concurrent_intern_unref();
   test_things_stick_around();
   test_user_data_works();
   test_user_data_works_for_allocated_md();
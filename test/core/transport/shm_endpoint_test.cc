@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "test/core/util/test_config.h"
+
+#ifdef GRPC_SHM_TRANSPORT
+
+#include <unistd.h>
+
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "test/core/iomgr/endpoint_tests.h"
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+static void clean_up(void) {}
+
+static grpc_endpoint_test_fixture create_fixture_shm_endpoint_pair(
+    size_t /*slice_size*/) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_endpoint_pair p = grpc_iomgr_create_endpoint_pair("test", nullptr);
+  // Small rings, so that most writes wrap around and wait for space.
+  grpc_shm_fds client_fds;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_shm_fds_create",
+                               grpc_shm_fds_create(16384, &client_fds)));
+  int client_array[GRPC_SHM_NUM_FDS];
+  int server_array[GRPC_SHM_NUM_FDS];
+  grpc_shm_fds_to_array(&client_fds, client_array);
+  for (size_t i = 0; i < GRPC_SHM_NUM_FDS; i++) {
+    server_array[i] = dup(client_array[i]);
+    GPR_ASSERT(server_array[i] >= 0);
+  }
+  grpc_shm_fds server_fds;
+  grpc_shm_fds_from_array(server_array, client_fds.ring_size, &server_fds);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("grpc_shm_fds_validate",
+                               grpc_shm_fds_validate(&server_fds)));
+
+  grpc_endpoint_test_fixture f;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "grpc_shm_endpoint_create",
+      grpc_shm_endpoint_create(&client_fds, 0, p.client, &f.client_ep)));
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "grpc_shm_endpoint_create",
+      grpc_shm_endpoint_create(&server_fds, 1, p.server, &f.server_ep)));
+  grpc_endpoint_add_to_pollset(f.client_ep, g_pollset);
+  grpc_endpoint_add_to_pollset(f.server_ep, g_pollset);
+  return f;
+}
+
+static grpc_endpoint_test_config configs[] = {
+    {"shm/socketpair", create_fixture_shm_endpoint_pair, clean_up},
+};
+
+static void destroy_pollset(void* p, grpc_error* /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+int main(int argc, char** argv) {
+  grpc_closure destroyed;
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(g_pollset, &g_mu);
+    grpc_endpoint_tests(configs[0], g_pollset, g_mu);
+    GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(g_pollset, &destroyed);
+  }
+  grpc_shutdown();
+  gpr_free(g_pollset);
+
+  return 0;
+}
+
+#else /* GRPC_SHM_TRANSPORT */
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  return 0;
+}
+
+#endif /* GRPC_SHM_TRANSPORT */
@@ -67,6 +67,39 @@ void test_encoding(void) {
   assert_encodes_as(100000000000, "99999999S");
 }
 
+static void assert_rounds_down_as(grpc_millis ts, int digits,
+                                  const char* s) {
+  char buffer[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
+  grpc_millis rounded = grpc_http2_round_timeout_down(ts, digits);
+  grpc_http2_encode_timeout(rounded, buffer);
+  gpr_log(GPR_INFO, "check '%s' == '%s'", buffer, s);
+  GPR_ASSERT(0 == strcmp(buffer, s));
+  GPR_ASSERT(rounded <= ts);
+  /* the rounded timeout is sent as is, unless it is out of range */
+  grpc_millis decoded;
+  GPR_ASSERT(grpc_http2_decode_timeout(grpc_slice_from_static_string(buffer),
+                                       &decoded));
+  GPR_ASSERT(rounded <= 0 || rounded >= 99999999000 || decoded == rounded);
+}
+
+void test_rounding_down(void) {
+  LOG_TEST("test_rounding_down");
+  assert_rounds_down_as(-1, 2, "1n");
+  assert_rounds_down_as(1, 1, "1m");
+  assert_rounds_down_as(19, 1, "10m");
+  assert_rounds_down_as(19, 2, "19m");
+  assert_rounds_down_as(999, 2, "990m");
+  assert_rounds_down_as(1999, 1, "1S");
+  assert_rounds_down_as(1999, 2, "1900m");
+  assert_rounds_down_as(1999, 3, "1990m");
+  assert_rounds_down_as(59999, 2, "59S");
+  assert_rounds_down_as(60999, 2, "1M");
+  assert_rounds_down_as(999999, 3, "999S");
+  assert_rounds_down_as(1000999, 2, "1000S");
+  assert_rounds_down_as(3601 * GPR_MS_PER_SEC, 2, "1H");
+  assert_rounds_down_as(100000000000, 3, "99999999S");
+}
+
 static void assert_decodes_as(const char* buffer, grpc_millis expected) {
   grpc_millis got;
   uint32_t hash = gpr_murmur_hash3(buffer, strlen(buffer), 0);
@@ -161,6 +194,7 @@ void test_decoding_fails(void) {
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   test_encoding();
+  test_rounding_down();
   test_decoding();
   test_decoding_fails();
   return 0;
@@ -315,6 +315,42 @@ static void empty_seal_unseal(alts_grpc_record_protocol* sender,
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static void multi_frame_seal_unseal(alts_grpc_record_protocol* sender,
+                                    alts_grpc_record_protocol* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_grpc_record_protocol_test_var* var =
+        alts_grpc_record_protocol_test_var_create();
+    /* Seals the data as frames of at most a third of it, then unseals them one
+     * by one.  */
+    size_t data_length = var->original_sb.length;
+    size_t max_frame_data_size = data_length / 3 + 1;
+    size_t frame_overhead = var->header_length + var->tag_length;
+    tsi_result status = alts_grpc_record_protocol_protect_frames(
+        sender, &var->original_sb, max_frame_data_size, &var->protected_sb);
+    GPR_ASSERT(status == TSI_OK);
+    GPR_ASSERT(var->original_sb.length == 0);
+    grpc_slice_buffer frame_sb;
+    grpc_slice_buffer_init(&frame_sb);
+    size_t remaining = data_length;
+    while (remaining > 0) {
+      size_t frame_data_size = GPR_MIN(remaining, max_frame_data_size);
+      grpc_slice_buffer_move_first(&var->protected_sb,
+                                   frame_data_size + frame_overhead, &frame_sb);
+      status = alts_grpc_record_protocol_unprotect(receiver, &frame_sb,
+                                                   &var->unprotected_sb);
+      GPR_ASSERT(status == TSI_OK);
+      remaining -= frame_data_size;
+    }
+    GPR_ASSERT(var->protected_sb.length == 0);
+    GPR_ASSERT(
+        are_slice_buffers_equal(&var->unprotected_sb, &var->duplicate_sb));
+    grpc_slice_buffer_destroy_internal(&frame_sb);
+    alts_grpc_record_protocol_test_var_destroy(var);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 static void unsync_seal_unseal(alts_grpc_record_protocol* sender,
                                alts_grpc_record_protocol* receiver) {
   grpc_core::ExecCtx exec_ctx;
@@ -404,6 +440,12 @@ static void alts_grpc_record_protocol_empty_seal_unseal_tests(
   empty_seal_unseal(fixture->server_protect, fixture->client_unprotect);
 }
 
+static void alts_grpc_record_protocol_multi_frame_seal_unseal_tests(
+    alts_grpc_record_protocol_test_fixture* fixture) {
+  multi_frame_seal_unseal(fixture->client_protect, fixture->server_unprotect);
+  multi_frame_seal_unseal(fixture->server_protect, fixture->client_unprotect);
+}
+
 static void alts_grpc_record_protocol_unsync_seal_unseal_tests(
     alts_grpc_record_protocol_test_fixture* fixture) {
   unsync_seal_unseal(fixture->client_protect, fixture->server_unprotect);
@@ -442,6 +484,10 @@ static void alts_grpc_record_protocol_tests(
   auto* fixture_5 = fixture_create();
   alts_grpc_record_protocol_input_check_tests(fixture_5);
   alts_grpc_record_protocol_test_fixture_destroy(fixture_5);
+
+  auto* fixture_6 = fixture_create();
+  alts_grpc_record_protocol_multi_frame_seal_unseal_tests(fixture_6);
+  alts_grpc_record_protocol_test_fixture_destroy(fixture_6);
 }
 
 int main(int /*argc*/, char** /*argv*/) {
@@ -24,6 +24,7 @@
 #include "src/core/lib/security/security_connector/security_connector.h"
 #include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/tsi/transport_security_interface.h"
 #include "test/core/tsi/transport_security_test_lib.h"
 #include "test/core/util/test_config.h"
@@ -560,6 +561,32 @@ void ssl_tsi_test_do_handshake_with_bad_client_cert() {
   tsi_test_fixture_destroy(fixture);
 }
 
+void ssl_tsi_test_do_handshake_verified_cert_cache() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_verified_cert_cache");
+  auto do_handshake = [](bool use_bad_client_cert) {
+    tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+    ssl_tsi_test_fixture* ssl_fixture =
+        reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+    ssl_fixture->key_cert_lib->use_bad_client_cert = use_bad_client_cert;
+    ssl_fixture->force_client_auth = true;
+    tsi_test_do_handshake(fixture);
+    tsi_test_fixture_destroy(fixture);
+  };
+  // Unless an earlier test did, the first handshake verifies the client
+  // certificate. The next ones find it in the cache.
+  do_handshake(false);
+  size_t hits = tsi_ssl_verified_cert_cache_hits_for_testing();
+  do_handshake(false);
+  GPR_ASSERT(tsi_ssl_verified_cert_cache_hits_for_testing() == hits + 1);
+  do_handshake(false);
+  GPR_ASSERT(tsi_ssl_verified_cert_cache_hits_for_testing() == hits + 2);
+  // Failed verifications are not cached.
+  hits = tsi_ssl_verified_cert_cache_hits_for_testing();
+  do_handshake(true);
+  do_handshake(true);
+  GPR_ASSERT(tsi_ssl_verified_cert_cache_hits_for_testing() == hits);
+}
+
 void ssl_tsi_test_do_handshake_alpn_client_no_server() {
   gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_alpn_client_no_server");
   tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
@@ -653,6 +680,90 @@ void ssl_tsi_test_do_round_trip_odd_buffer_size() {
   }
 }
 
+static tsi_zero_copy_grpc_protector* ssl_tsi_test_create_zero_copy_protector(
+    tsi_handshaker_result* result) {
+  tsi_zero_copy_grpc_protector* protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 result, nullptr, &protector) == TSI_OK);
+  const unsigned char* unused_bytes = nullptr;
+  size_t unused_bytes_size = 0;
+  GPR_ASSERT(tsi_handshaker_result_get_unused_bytes(
+                 result, &unused_bytes, &unused_bytes_size) == TSI_OK);
+  if (unused_bytes_size > 0) {
+    grpc_slice_buffer protected_slices;
+    grpc_slice_buffer unprotected_slices;
+    grpc_slice_buffer_init(&protected_slices);
+    grpc_slice_buffer_init(&unprotected_slices);
+    grpc_slice_buffer_add(&protected_slices,
+                          grpc_slice_from_copied_buffer(
+                              reinterpret_cast<const char*>(unused_bytes),
+                              unused_bytes_size));
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   protector, &protected_slices, &unprotected_slices) ==
+               TSI_OK);
+    GPR_ASSERT(unprotected_slices.length == 0);
+    grpc_slice_buffer_destroy(&protected_slices);
+    grpc_slice_buffer_destroy(&unprotected_slices);
+  }
+  return protector;
+}
+
+static void ssl_tsi_test_zero_copy_send_message(
+    tsi_zero_copy_grpc_protector* sender,
+    tsi_zero_copy_grpc_protector* receiver) {
+  // Mix slices sealed in place with short ones that are gathered.
+  const size_t slice_sizes[] = {9, 20000, 5, 3000, 1, 1024, 17};
+  grpc_slice_buffer message;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer received;
+  grpc_slice_buffer_init(&message);
+  grpc_slice_buffer_init(&protected_slices);
+  grpc_slice_buffer_init(&received);
+  uint8_t next = 0;
+  for (size_t size : slice_sizes) {
+    grpc_slice slice = grpc_slice_malloc(size);
+    for (size_t i = 0; i < size; i++) {
+      GRPC_SLICE_START_PTR(slice)[i] = next++;
+    }
+    grpc_slice_buffer_add(&message, slice);
+  }
+  grpc_slice expected = grpc_slice_malloc(message.length);
+  for (size_t i = 0; i < message.length; i++) {
+    GRPC_SLICE_START_PTR(expected)[i] = static_cast<uint8_t>(i);
+  }
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(sender, &message,
+                                                  &protected_slices) == TSI_OK);
+  GPR_ASSERT(message.length == 0);
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                 receiver, &protected_slices, &received) == TSI_OK);
+  GPR_ASSERT(protected_slices.length == 0);
+  GPR_ASSERT(received.length == GRPC_SLICE_LENGTH(expected));
+  grpc_slice actual = grpc_slice_malloc(received.length);
+  grpc_slice_buffer_move_first_into_buffer(&received, received.length,
+                                           GRPC_SLICE_START_PTR(actual));
+  GPR_ASSERT(grpc_slice_eq(actual, expected));
+  grpc_slice_unref(actual);
+  grpc_slice_unref(expected);
+  grpc_slice_buffer_destroy(&message);
+  grpc_slice_buffer_destroy(&protected_slices);
+  grpc_slice_buffer_destroy(&received);
+}
+
+void ssl_tsi_test_do_round_trip_zero_copy() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_round_trip_zero_copy");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  tsi_test_do_handshake(fixture);
+  tsi_zero_copy_grpc_protector* client_protector =
+      ssl_tsi_test_create_zero_copy_protector(fixture->client_result);
+  tsi_zero_copy_grpc_protector* server_protector =
+      ssl_tsi_test_create_zero_copy_protector(fixture->server_result);
+  ssl_tsi_test_zero_copy_send_message(client_protector, server_protector);
+  ssl_tsi_test_zero_copy_send_message(server_protector, client_protector);
+  tsi_zero_copy_grpc_protector_destroy(client_protector);
+  tsi_zero_copy_grpc_protector_destroy(server_protector);
+  tsi_test_fixture_destroy(fixture);
+}
+
 void ssl_tsi_test_do_handshake_session_cache() {
   gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_session_cache");
   tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
@@ -868,6 +979,7 @@ int main(int argc, char** argv) {
   ssl_tsi_test_do_handshake_with_server_name_indication_wild_star_domain();
   ssl_tsi_test_do_handshake_with_bad_server_cert();
   ssl_tsi_test_do_handshake_with_bad_client_cert();
+  ssl_tsi_test_do_handshake_verified_cert_cache();
 #ifdef OPENSSL_IS_BORINGSSL
   // BoringSSL and OpenSSL have different behaviors on mismatched ALPN.
   ssl_tsi_test_do_handshake_alpn_client_no_server();
@@ -878,6 +990,7 @@ int main(int argc, char** argv) {
   ssl_tsi_test_do_handshake_session_cache();
   ssl_tsi_test_do_round_trip_for_all_configs();
   ssl_tsi_test_do_round_trip_odd_buffer_size();
+  ssl_tsi_test_do_round_trip_zero_copy();
   ssl_tsi_test_handshaker_factory_internals();
   ssl_tsi_test_duplicate_root_certificates();
   ssl_tsi_test_extract_x509_subject_names();
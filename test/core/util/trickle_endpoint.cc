@@ -18,7 +18,7 @@
 
 #include "src/core/lib/iomgr/sockaddr.h"
 
-#include "test/core/util/passthru_endpoint.h"
+#include "test/core/util/trickle_endpoint.h"
 
 #include <inttypes.h>
 #include <string.h>
@@ -32,14 +32,28 @@
 
 #define WRITE_BUFFER_SIZE (2 * 1024 * 1024)
 
+/* bytes that went through the rate limit at the same time, in flight until
+   arrival */
+typedef struct in_flight_bytes {
+  gpr_timespec arrival;
+  size_t length;
+  struct in_flight_bytes* next;
+} in_flight_bytes;
+
 typedef struct {
   grpc_endpoint base;
   double bytes_per_second;
+  gpr_timespec latency;
   grpc_endpoint* wrapped;
   gpr_timespec last_write;
 
   gpr_mu mu;
   grpc_slice_buffer write_buffer;
+  /* bytes that went through the rate limit but did not arrive yet, described
+     oldest first by in_flight_head */
+  grpc_slice_buffer in_flight_buffer;
+  in_flight_bytes* in_flight_head;
+  in_flight_bytes* in_flight_tail;
   grpc_slice_buffer writing_buffer;
   grpc_error* error;
   bool writing;
@@ -112,6 +126,12 @@ static void te_destroy(grpc_endpoint* ep) {
   grpc_endpoint_destroy(te->wrapped);
   gpr_mu_destroy(&te->mu);
   grpc_slice_buffer_destroy_internal(&te->write_buffer);
+  grpc_slice_buffer_destroy_internal(&te->in_flight_buffer);
+  while (te->in_flight_head != nullptr) {
+    in_flight_bytes* next = te->in_flight_head->next;
+    gpr_free(te->in_flight_head);
+    te->in_flight_head = next;
+  }
   grpc_slice_buffer_destroy_internal(&te->writing_buffer);
   GRPC_ERROR_UNREF(te->error);
   gpr_free(te);
@@ -156,14 +176,23 @@ static const grpc_endpoint_vtable vtable = {te_read,
 
 grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
                                             double bytes_per_second) {
+  return grpc_trickle_endpoint_create_with_latency(wrap, bytes_per_second, 0);
+}
+
+grpc_endpoint* grpc_trickle_endpoint_create_with_latency(
+    grpc_endpoint* wrap, double bytes_per_second, int latency_ms) {
   trickle_endpoint* te =
       static_cast<trickle_endpoint*>(gpr_malloc(sizeof(*te)));
   te->base.vtable = &vtable;
   te->wrapped = wrap;
   te->bytes_per_second = bytes_per_second;
+  te->latency = gpr_time_from_millis(latency_ms, GPR_TIMESPAN);
   te->write_cb = nullptr;
   gpr_mu_init(&te->mu);
   grpc_slice_buffer_init(&te->write_buffer);
+  grpc_slice_buffer_init(&te->in_flight_buffer);
+  te->in_flight_head = nullptr;
+  te->in_flight_tail = nullptr;
   grpc_slice_buffer_init(&te->writing_buffer);
   te->error = GRPC_ERROR_NONE;
   te->writing = false;
@@ -183,16 +212,45 @@ size_t grpc_trickle_endpoint_trickle(grpc_endpoint* ep) {
     size_t bytes = static_cast<size_t>(te->bytes_per_second * elapsed);
     // gpr_log(GPR_DEBUG, "%lf elapsed --> %" PRIdPTR " bytes", elapsed, bytes);
     if (bytes > 0) {
-      grpc_slice_buffer_move_first(&te->write_buffer,
-                                   GPR_MIN(bytes, te->write_buffer.length),
+      bytes = GPR_MIN(bytes, te->write_buffer.length);
+      grpc_slice_buffer_move_first(&te->write_buffer, bytes,
+                                   &te->in_flight_buffer);
+      in_flight_bytes* in_flight =
+          static_cast<in_flight_bytes*>(gpr_malloc(sizeof(*in_flight)));
+      in_flight->arrival = gpr_time_add(now, te->latency);
+      in_flight->length = bytes;
+      in_flight->next = nullptr;
+      if (te->in_flight_tail != nullptr) {
+        te->in_flight_tail->next = in_flight;
+      } else {
+        te->in_flight_head = in_flight;
+      }
+      te->in_flight_tail = in_flight;
+      te->last_write = now;
+      maybe_call_write_cb_locked(te);
+    }
+  }
+  if (!te->writing && te->in_flight_head != nullptr) {
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    size_t bytes = 0;
+    while (te->in_flight_head != nullptr &&
+           gpr_time_cmp(te->in_flight_head->arrival, now) <= 0) {
+      in_flight_bytes* arrived = te->in_flight_head;
+      bytes += arrived->length;
+      te->in_flight_head = arrived->next;
+      gpr_free(arrived);
+    }
+    if (te->in_flight_head == nullptr) {
+      te->in_flight_tail = nullptr;
+    }
+    if (bytes > 0) {
+      grpc_slice_buffer_move_first(&te->in_flight_buffer, bytes,
                                    &te->writing_buffer);
       te->writing = true;
-      te->last_write = now;
       grpc_endpoint_write(
           te->wrapped, &te->writing_buffer,
           GRPC_CLOSURE_CREATE(te_finish_write, te, grpc_schedule_on_exec_ctx),
           nullptr);
-      maybe_call_write_cb_locked(te);
     }
   }
   size_t backlog = te->write_buffer.length;
@@ -24,6 +24,12 @@
 grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
                                             double bytes_per_second);
 
+/* Like grpc_trickle_endpoint_create, but bytes also take \a latency_ms to
+   reach the other end once they went through, to model a path with a high
+   bandwidth-delay product. */
+grpc_endpoint* grpc_trickle_endpoint_create_with_latency(
+    grpc_endpoint* wrap, double bytes_per_second, int latency_ms);
+
 /* Allow up to \a bytes through the endpoint. Returns the new backlog. */
 size_t grpc_trickle_endpoint_trickle(grpc_endpoint* endpoint);
 
@@ -35,9 +35,14 @@ DEFINE_string(
     generated_file_path, "",
     "path to the directory containing generated files compiler_test.grpc.pb.h "
     "and compiler_test_mock.grpc.pb.h");
+DEFINE_bool(check_arena_file, false,
+            "whether the directory also holds compiler_test_arena.grpc.pb.h, "
+            "generated with the arena=true option");
 
 const char kGoldenFilePath[] = "test/cpp/codegen/compiler_test_golden";
 const char kMockGoldenFilePath[] = "test/cpp/codegen/compiler_test_mock_golden";
+const char kArenaGoldenFilePath[] =
+    "test/cpp/codegen/compiler_test_arena_golden";
 
 void run_test(const std::basic_string<char>& generated_file,
               const std::basic_string<char>& golden_file) {
@@ -67,6 +72,13 @@ TEST(GoldenMockFileTest, TestGeneratedMockFile) {
            kMockGoldenFilePath);
 }
 
+TEST(GoldenArenaFileTest, TestGeneratedArenaFile) {
+  // The Makefile build does not generate it.
+  if (!FLAGS_check_arena_file) GTEST_SKIP();
+  run_test(FLAGS_generated_file_path + "compiler_test_arena.grpc.pb.h",
+           kArenaGoldenFilePath);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   grpc::testing::InitTest(&argc, &argv, true);
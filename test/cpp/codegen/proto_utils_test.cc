@@ -182,6 +182,65 @@ TEST_F(WriterTest, LargeBlockLargeBackup) {
   BufferWriterTest(4096, 8192, 4095);
 }
 
+grpc::string Flatten(const std::vector<Slice>& slices) {
+  grpc::string out;
+  for (const Slice& slice : slices) {
+    out.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+  }
+  return out;
+}
+
+class SplitterTest : public WriterTest {};
+
+TEST_F(SplitterTest, FieldWithinOneSlice) {
+  // 1: varint 150, 2: a value long enough not to be inlined, 3: fixed32.
+  const grpc::string kValue = "0123456789abcdefghijklmnopqrstuv";
+  const grpc::string head = grpc::string("\x08\x96\x01\x12\x20") + kValue;
+  const char kTail[] = "\x1d\x01\x02\x03\x04";
+  Slice slices[] = {Slice(head), Slice(kTail, sizeof(kTail) - 1)};
+  ByteBuffer bb(slices, 2);
+  ProtoFieldSplitter splitter(&bb);
+  ASSERT_TRUE(splitter.status().ok());
+  std::vector<Slice> rest;
+  Slice field;
+  ASSERT_TRUE(splitter.Split(2, &rest, &field));
+  EXPECT_EQ(kValue, grpc::string(reinterpret_cast<const char*>(field.begin()),
+                                 field.size()));
+  // The value references the received slice rather than a copy.
+  EXPECT_EQ(slices[0].begin() + 5, field.begin());
+  EXPECT_EQ(grpc::string("\x08\x96\x01\x1d\x01\x02\x03\x04", 8),
+            Flatten(rest));
+}
+
+TEST_F(SplitterTest, FieldAcrossSlicesLastOneWins) {
+  // 2: "ab", 1: varint 1, 2: "hello" split over three slices.
+  const char kFirst[] = "\x12\x02\x61\x62\x08\x01\x12";
+  const char kSecond[] = "\x05he";
+  const char kThird[] = "llo";
+  Slice slices[] = {Slice(kFirst, sizeof(kFirst) - 1),
+                    Slice(kSecond, sizeof(kSecond) - 1),
+                    Slice(kThird, sizeof(kThird) - 1)};
+  ByteBuffer bb(slices, 3);
+  ProtoFieldSplitter splitter(&bb);
+  ASSERT_TRUE(splitter.status().ok());
+  std::vector<Slice> rest;
+  Slice field;
+  ASSERT_TRUE(splitter.Split(2, &rest, &field));
+  EXPECT_EQ("hello", grpc::string(reinterpret_cast<const char*>(field.begin()),
+                                  field.size()));
+  EXPECT_EQ(grpc::string("\x08\x01"), Flatten(rest));
+}
+
+TEST_F(SplitterTest, RejectsTruncatedPayload) {
+  const char kPayload[] = "\x12\x05hel";
+  Slice slice(kPayload, sizeof(kPayload) - 1);
+  ByteBuffer bb(&slice, 1);
+  ProtoFieldSplitter splitter(&bb);
+  std::vector<Slice> rest;
+  Slice field;
+  EXPECT_FALSE(splitter.Split(2, &rest, &field));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace grpc
@@ -16,4 +16,5 @@
 set -eux
 
 GENERATED_PB_H_DIR="${TEST_SRCDIR}/com_github_grpc_grpc/test/cpp/codegen/"
-test/cpp/codegen/golden_file_test --generated_file_path="$GENERATED_PB_H_DIR"
+test/cpp/codegen/golden_file_test --generated_file_path="$GENERATED_PB_H_DIR" \
+  --check_arena_file
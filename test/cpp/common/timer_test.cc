@@ -16,13 +16,18 @@
  *
  */
 
+#include <string.h>
+
 #include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <gtest/gtest.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/iomgr/timer_manager.h"
 #include "test/core/util/test_config.h"
@@ -223,6 +228,79 @@ TEST_F(TimerTest, DISABLED_CancelNextTimer) {
   gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
 }
 
+#ifdef GRPC_POSIX_SOCKET_EV
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_timers_on_pollers);
+
+class TimerOnPollerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    GPR_GLOBAL_CONFIG_SET(grpc_timers_on_pollers, true);
+    grpc_init();
+    // Only the epoll based polling engines run timers
+    const char* poll_strategy = grpc_get_poll_strategy_name();
+    if (grpc_test_slowdown_factor() != 1 || poll_strategy == nullptr ||
+        (strcmp(poll_strategy, "epoll1") != 0 &&
+         strcmp(poll_strategy, "epollex") != 0)) {
+      do_not_test_ = true;
+    }
+  }
+
+  void TearDown() override {
+    grpc_shutdown_blocking();
+    GPR_GLOBAL_CONFIG_SET(grpc_timers_on_pollers, false);
+  }
+
+  bool do_not_test_{false};
+};
+
+TEST_F(TimerOnPollerTest, PollerWakesUpForTimer) {
+  MAYBE_SKIP_TEST;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_pollset* pollset =
+      static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+  gpr_mu* mu;
+  grpc_pollset_init(pollset, &mu);
+  grpc_timer timer;
+  gpr_atm timer_fired = 0;
+  grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  grpc_timer_init(&timer, start + 100,
+                  GRPC_CLOSURE_CREATE(
+                      [](void* arg, grpc_error*) {
+                        gpr_atm_no_barrier_fetch_add(
+                            static_cast<gpr_atm*>(arg), 1);
+                      },
+                      &timer_fired, grpc_schedule_on_exec_ctx));
+
+  // Nothing else kicks the pollset, so only the timer can end the poll early
+  gpr_mu_lock(mu);
+  GRPC_LOG_IF_ERROR("pollset_work",
+                    grpc_pollset_work(pollset, nullptr, start + 5000));
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  EXPECT_LT(grpc_core::ExecCtx::Get()->Now() - start, 2500);
+
+  // Whichever thread got to the timer first ran it
+  while (gpr_atm_no_barrier_load(&timer_fired) == 0) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  EXPECT_EQ(1, gpr_atm_no_barrier_load(&timer_fired));
+
+  grpc_closure destroyed;
+  gpr_mu_lock(mu);
+  grpc_pollset_shutdown(
+      pollset, GRPC_CLOSURE_INIT(
+                   &destroyed,
+                   [](void* pollset, grpc_error*) {
+                     grpc_pollset_destroy(static_cast<grpc_pollset*>(pollset));
+                   },
+                   pollset, grpc_schedule_on_exec_ctx));
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(pollset);
+}
+#endif
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
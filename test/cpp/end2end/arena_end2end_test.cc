@@ -0,0 +1,141 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "src/proto/grpc/testing/arena_test.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// ArenaTestService is generated with arena=true, so both kinds of handlers
+// should get a request and a response that live on the same arena.
+Status CheckArenaAndEcho(const EchoRequest* request, EchoResponse* response) {
+  if (request->GetArena() == nullptr) {
+    return Status(StatusCode::INTERNAL, "request is not on an arena");
+  }
+  if (response->GetArena() != request->GetArena()) {
+    return Status(StatusCode::INTERNAL, "response is not on the arena");
+  }
+  response->set_message(request->message());
+  // Submessages are created on the arena of their parent.
+  response->mutable_param()->set_host("localhost");
+  if (response->param().GetArena() != request->GetArena()) {
+    return Status(StatusCode::INTERNAL, "submessage is not on the arena");
+  }
+  return Status::OK;
+}
+
+class SyncArenaService : public ArenaTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    return CheckArenaAndEcho(request, response);
+  }
+};
+
+class CallbackArenaService
+    : public ArenaTestService::ExperimentalCallbackService {
+ public:
+  experimental::ServerUnaryReactor* Echo(
+      experimental::CallbackServerContext* context, const EchoRequest* request,
+      EchoResponse* response) override {
+    experimental::ServerUnaryReactor* reactor = context->DefaultReactor();
+    reactor->Finish(CheckArenaAndEcho(request, response));
+    return reactor;
+  }
+};
+
+class ArenaEnd2endTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    if (server_ != nullptr) {
+      server_->Shutdown();
+      grpc_recycle_unused_port(port_);
+    }
+  }
+
+  void StartServer(Service* service) {
+    port_ = grpc_pick_unused_port_or_die();
+    std::ostringstream server_address;
+    server_address << "localhost:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(service);
+    server_ = builder.BuildAndStart();
+    stub_ = ArenaTestService::NewStub(
+        CreateChannel(server_address.str(), InsecureChannelCredentials()));
+  }
+
+  // Sends more calls than one arena is needed for, so that later calls get
+  // arenas back from the pool.
+  void SendRpcs() {
+    for (int i = 0; i < 10; ++i) {
+      ClientContext context;
+      EchoRequest request;
+      request.set_message("Hello " + std::to_string(i));
+      EchoResponse response;
+      Status status = stub_->Echo(&context, request, &response);
+      EXPECT_TRUE(status.ok()) << status.error_message();
+      EXPECT_EQ(request.message(), response.message());
+      EXPECT_EQ("localhost", response.param().host());
+    }
+  }
+
+  int port_;
+  SyncArenaService sync_service_;
+  CallbackArenaService callback_service_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<ArenaTestService::Stub> stub_;
+};
+
+TEST_F(ArenaEnd2endTest, SyncHandler) {
+  StartServer(&sync_service_);
+  SendRpcs();
+}
+
+TEST_F(ArenaEnd2endTest, CallbackHandler) {
+  StartServer(&callback_service_);
+  SendRpcs();
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -26,6 +26,7 @@
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/generic/generic_unary_batcher.h>
 #include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
@@ -526,6 +527,41 @@ TEST_P(ClientCallbackEnd2endTest, SequentialGenericRpcsAsBidiWithReactorReuse) {
   SendGenericEchoAsBidi(10, 10);
 }
 
+TEST_P(ClientCallbackEnd2endTest, GenericUnaryBatcher) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  const int kNumRpcs = 10;
+  grpc::experimental::GenericUnaryBatcher::Options options;
+  options.max_batch_size = 4;
+  grpc::experimental::GenericUnaryBatcher batcher(
+      channel_, "/grpc.testing.EchoTestService/BidiStream", options);
+  std::mutex mu;
+  std::condition_variable cv;
+  int done = 0;
+  std::vector<ByteBuffer> recv_bufs(kNumRpcs);
+  for (int i = 0; i < kNumRpcs; i++) {
+    EchoRequest request;
+    request.set_message("Hello batch " + std::to_string(i));
+    auto send_buf = SerializeToByteBuffer(&request);
+    batcher.Call(*send_buf, &recv_bufs[i], [&mu, &cv, &done](Status s) {
+      EXPECT_TRUE(s.ok()) << s.error_message();
+      std::lock_guard<std::mutex> l(mu);
+      done++;
+      cv.notify_one();
+    });
+  }
+  batcher.Flush();
+  std::unique_lock<std::mutex> l(mu);
+  while (done < kNumRpcs) {
+    cv.wait(l);
+  }
+  for (int i = 0; i < kNumRpcs; i++) {
+    EchoResponse response;
+    EXPECT_TRUE(ParseFromByteBuffer(&recv_bufs[i], &response));
+    EXPECT_EQ("Hello batch " + std::to_string(i), response.message());
+  }
+}
+
 #if GRPC_ALLOW_EXCEPTIONS
 TEST_P(ClientCallbackEnd2endTest, ExceptingRpc) {
   MAYBE_SKIP_TEST;
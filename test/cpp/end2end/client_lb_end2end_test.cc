@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -58,6 +59,7 @@
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 #include "test/core/util/test_lb_policies.h"
+#include "test/core/util/test_tcp_server.h"
 #include "test/cpp/end2end/test_service_impl.h"
 
 #include <gmock/gmock.h>
@@ -93,6 +95,44 @@ void tcp_client_connect_with_delay(grpc_closure* closure, grpc_endpoint** ep,
 
 grpc_tcp_client_vtable delayed_connect = {tcp_client_connect_with_delay};
 
+// A TCP listener that accepts connections but never answers on them, like
+// an address that black-holes traffic: connection attempts to it neither
+// succeed nor fail until they time out.
+class StalledServer {
+ public:
+  StalledServer() : port_(grpc_pick_unused_port_or_die()) {
+    test_tcp_server_init(&server_, OnConnect, this);
+    test_tcp_server_start(&server_, port_);
+  }
+
+  ~StalledServer() {
+    {
+      grpc_core::ExecCtx exec_ctx;
+      for (grpc_endpoint* endpoint : endpoints_) {
+        grpc_endpoint_destroy(endpoint);
+      }
+    }
+    test_tcp_server_destroy(&server_);
+  }
+
+  int port() const { return port_; }
+
+ private:
+  static void OnConnect(void* arg, grpc_endpoint* endpoint,
+                        grpc_pollset* /*accepting_pollset*/,
+                        grpc_tcp_server_acceptor* acceptor) {
+    gpr_free(acceptor);
+    StalledServer* self = static_cast<StalledServer*>(arg);
+    grpc::internal::MutexLock lock(&self->mu_);
+    self->endpoints_.push_back(endpoint);
+  }
+
+  const int port_;
+  test_tcp_server server_;
+  grpc::internal::Mutex mu_;
+  std::vector<grpc_endpoint*> endpoints_;
+};
+
 // Subclass of TestServiceImpl that increments a request counter for
 // every call to the Echo RPC.
 class MyTestServiceImpl : public TestServiceImpl {
@@ -100,12 +140,17 @@ class MyTestServiceImpl : public TestServiceImpl {
   Status Echo(ServerContext* context, const EchoRequest* request,
               EchoResponse* response) override {
     const udpa::data::orca::v1::OrcaLoadReport* load_report = nullptr;
+    int delay_ms = 0;
     {
       grpc::internal::MutexLock lock(&mu_);
       ++request_count_;
       load_report = load_report_;
+      delay_ms = delay_ms_;
     }
     AddClient(context->peer());
+    if (delay_ms > 0) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(delay_ms));
+    }
     if (load_report != nullptr) {
       // TODO(roth): Once we provide a more standard server-side API for
       // populating this data, use that API here.
@@ -135,6 +180,11 @@ class MyTestServiceImpl : public TestServiceImpl {
     load_report_ = load_report;
   }
 
+  void set_delay_ms(int delay_ms) {
+    grpc::internal::MutexLock lock(&mu_);
+    delay_ms_ = delay_ms;
+  }
+
  private:
   void AddClient(const grpc::string& client) {
     grpc::internal::MutexLock lock(&clients_mu_);
@@ -144,6 +194,7 @@ class MyTestServiceImpl : public TestServiceImpl {
   grpc::internal::Mutex mu_;
   int request_count_ = 0;
   const udpa::data::orca::v1::OrcaLoadReport* load_report_ = nullptr;
+  int delay_ms_ = 0;
   grpc::internal::Mutex clients_mu_;
   std::set<grpc::string> clients_;
 };
@@ -552,6 +603,21 @@ TEST_F(ClientLbEnd2endTest, PickFirstSelectsReadyAtStartup) {
   EXPECT_TRUE(WaitForChannelReady(channel2.get(), 1 /* timeout_seconds */));
 }
 
+TEST_F(ClientLbEnd2endTest, PickFirstDoesNotWaitForStalledAddress) {
+  // The first address never completes the handshake, so connecting to it
+  // would take the whole connect timeout.
+  StalledServer stalled_server;
+  StartServers(1);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      {stalled_server.port(), servers_[0]->port_});
+  // The second address is tried after a short delay, and wins.
+  CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+  EXPECT_EQ(1, servers_[0]->service_.request_count());
+}
+
 TEST_F(ClientLbEnd2endTest, PickFirstBackOffInitialReconnect) {
   ChannelArguments args;
   constexpr int kInitialBackOffMs = 100;
@@ -686,6 +752,75 @@ TEST_F(ClientLbEnd2endTest,
   EXPECT_LT(waited_ms, kWaitMs);
 }
 
+TEST_F(ClientLbEnd2endTest, SharedReconnectBackoffRound) {
+  grpc_core::ExecCtx exec_ctx;
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  const char* kKey = "grpc.subchannel_address=ipv4:127.0.0.1:1";
+  const char* kOtherKey = "grpc.subchannel_address=ipv4:127.0.0.1:2";
+  // No round has started: subchannels retry on their own backoff.
+  EXPECT_EQ(now,
+            grpc_core::GlobalSubchannelPool::SharedNextAttemptTime(kKey, now));
+  // The first failure sets the retry time of the round.
+  grpc_core::GlobalSubchannelPool::RecordConnectFailure(kKey, now + 1000);
+  EXPECT_EQ(now + 1000,
+            grpc_core::GlobalSubchannelPool::SharedNextAttemptTime(kKey, now));
+  EXPECT_EQ(now + 2000, grpc_core::GlobalSubchannelPool::SharedNextAttemptTime(
+                            kKey, now + 2000));
+  // Later failures keep it.
+  grpc_core::GlobalSubchannelPool::RecordConnectFailure(kKey, now + 3000);
+  EXPECT_EQ(now + 1000,
+            grpc_core::GlobalSubchannelPool::SharedNextAttemptTime(kKey, now));
+  // Other keys are not affected.
+  EXPECT_EQ(now, grpc_core::GlobalSubchannelPool::SharedNextAttemptTime(
+                     kOtherKey, now));
+  // A success ends the round.
+  grpc_core::GlobalSubchannelPool::RecordConnectSuccess(kKey);
+  EXPECT_EQ(now,
+            grpc_core::GlobalSubchannelPool::SharedNextAttemptTime(kKey, now));
+}
+
+TEST_F(ClientLbEnd2endTest, SharedReconnectBackoffResetOnInit) {
+  {
+    grpc_core::ExecCtx exec_ctx;
+    const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+    grpc_core::GlobalSubchannelPool::RecordConnectFailure("key", now + 60000);
+  }
+  grpc_shutdown_blocking();
+  grpc_init();
+  grpc_core::ExecCtx exec_ctx;
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  EXPECT_EQ(now,
+            grpc_core::GlobalSubchannelPool::SharedNextAttemptTime("key", now));
+}
+
+TEST_F(ClientLbEnd2endTest, ConnectAttemptRateLimit) {
+  constexpr int kAttemptsPerSecond = 10;
+  // The rate is read when grpc is initialized.
+  GPR_GLOBAL_CONFIG_SET(grpc_client_connect_attempts_per_second,
+                        kAttemptsPerSecond);
+  grpc_shutdown_blocking();
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+    // A burst of a second's worth of attempts starts right away.
+    for (int i = 0; i < kAttemptsPerSecond; ++i) {
+      EXPECT_EQ(now, grpc_core::GlobalSubchannelPool::ReserveConnectAttempt());
+    }
+    // Later ones are spaced out at the rate.
+    EXPECT_EQ(now + 100,
+              grpc_core::GlobalSubchannelPool::ReserveConnectAttempt());
+    EXPECT_EQ(now + 200,
+              grpc_core::GlobalSubchannelPool::ReserveConnectAttempt());
+  }
+  GPR_GLOBAL_CONFIG_SET(grpc_client_connect_attempts_per_second, 0);
+  grpc_shutdown_blocking();
+  grpc_init();
+  grpc_core::ExecCtx exec_ctx;
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  EXPECT_EQ(now, grpc_core::GlobalSubchannelPool::ReserveConnectAttempt());
+}
+
 TEST_F(ClientLbEnd2endTest, PickFirstUpdates) {
   // Start servers and send one RPC per server.
   const int kNumServers = 3;
@@ -1222,6 +1357,94 @@ TEST_F(ClientLbEnd2endTest, RoundRobinManyUpdates) {
   EXPECT_EQ("round_robin", channel->GetLoadBalancingPolicyName());
 }
 
+TEST_F(ClientLbEnd2endTest, RoundRobinPicksDuringUpdates) {
+  // Picks read the data plane state without taking the data plane lock, so
+  // keep them running while both the picker and the service config change.
+  const int kNumServers = 3;
+  const int kNumThreads = 4;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  std::vector<int> ports = GetServersPorts();
+  response_generator.SetNextResolution(ports);
+  CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+  std::atomic<bool> done{false};
+  std::atomic<int> num_failures{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([this, &stub, &done, &num_failures]() {
+      while (!done.load()) {
+        Status status;
+        if (!SendRpc(stub, nullptr, 5000, &status, true /* wait_for_ready */)) {
+          gpr_log(GPR_ERROR, "RPC failed: %s", status.error_message().c_str());
+          ++num_failures;
+        }
+      }
+    });
+  }
+  std::mt19937 rng(std::random_device{}());
+  for (size_t i = 0; i < 200; ++i) {
+    // Each update replaces the picker; every other one also changes the
+    // service config.
+    std::vector<int> update_ports = ports;
+    std::shuffle(update_ports.begin(), update_ports.end(), rng);
+    update_ports.resize(1 + i % kNumServers);
+    response_generator.SetNextResolution(
+        update_ports,
+        i % 2 == 0
+            ? "{\"retryThrottling\": {\"maxTokens\": 10, \"tokenRatio\": 0.1}}"
+            : nullptr);
+  }
+  done.store(true);
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(0, num_failures.load());
+  // The channel still works after the updates.
+  response_generator.SetNextResolution(ports);
+  CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+}
+
+TEST_F(ClientLbEnd2endTest, RoundRobinPicksDuringBackendRestarts) {
+  // Here the updates come from the LB policy: each restart makes round_robin
+  // publish new pickers, and the connected subchannels of the lost
+  // connections are cleared once the picks using the old pickers are done.
+  const int kNumServers = 3;
+  const int kNumThreads = 4;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+  std::atomic<bool> done{false};
+  std::atomic<int> num_failures{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([this, &stub, &done, &num_failures]() {
+      while (!done.load()) {
+        Status status;
+        SendRpc(stub, nullptr, 5000, &status, true /* wait_for_ready */);
+        // RPCs on a backend that is being shut down may fail.
+        if (!status.ok() && status.error_code() != StatusCode::UNAVAILABLE) {
+          gpr_log(GPR_ERROR, "RPC failed: %s", status.error_message().c_str());
+          ++num_failures;
+        }
+      }
+    });
+  }
+  for (size_t i = 0; i < 3 * kNumServers; ++i) {
+    // Restart one backend at a time, so that the others can take the picks.
+    servers_[i % kNumServers]->Shutdown();
+    StartServer(i % kNumServers);
+    WaitForServer(stub, i % kNumServers, DEBUG_LOCATION,
+                  true /* ignore_failure */);
+  }
+  done.store(true);
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(0, num_failures.load());
+  CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+}
+
 TEST_F(ClientLbEnd2endTest, RoundRobinConcurrentUpdates) {
   // TODO(dgq): replicate the way internal testing exercises the concurrent
   // update provisions of RR.
@@ -1380,6 +1603,172 @@ TEST_F(ClientLbEnd2endTest, RoundRobinSingleReconnect) {
   WaitForServer(stub, 0, DEBUG_LOCATION);
 }
 
+TEST_F(ClientLbEnd2endTest, WeightedRoundRobin) {
+  const int kNumServers = 2;
+  const int kNumRpcs = 100;
+  StartServers(kNumServers);
+  // Both servers serve the same load, but the first one needs nine times
+  // as much CPU to do it.
+  udpa::data::orca::v1::OrcaLoadReport busy_load_report;
+  busy_load_report.set_cpu_utilization(0.9);
+  busy_load_report.set_rps(100);
+  udpa::data::orca::v1::OrcaLoadReport idle_load_report;
+  idle_load_report.set_cpu_utilization(0.1);
+  idle_load_report.set_rps(100);
+  servers_[0]->service_.set_load_report(&busy_load_report);
+  servers_[1]->service_.set_load_report(&idle_load_report);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("weighted_round_robin", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  // Until the servers have reported their load, picks are unweighted.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  // Once the weights are applied, most requests go to the idle server.
+  const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  bool weighted = false;
+  while (!weighted &&
+         gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+    ResetCounters();
+    for (int i = 0; i < kNumRpcs; ++i) {
+      CheckRpcSendOk(stub, DEBUG_LOCATION);
+    }
+    weighted = servers_[1]->service_.request_count() >
+               5 * servers_[0]->service_.request_count();
+  }
+  EXPECT_TRUE(weighted);
+  // Both servers still get requests.
+  EXPECT_GT(servers_[0]->service_.request_count(), 0);
+  // Check LB policy name for the channel.
+  EXPECT_EQ("weighted_round_robin", channel->GetLoadBalancingPolicyName());
+  servers_[0]->service_.set_load_report(nullptr);
+  servers_[1]->service_.set_load_report(nullptr);
+}
+
+TEST_F(ClientLbEnd2endTest, LeastRequest) {
+  const int kNumServers = 2;
+  const int kNumRpcs = 10;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("least_request", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  ResetCounters();
+  // Keep one call in flight on one of the servers.
+  std::thread slow_rpc([this, &stub]() {
+    EchoRequest request;
+    request.set_message(kRequestMessage_);
+    request.mutable_param()->set_server_sleep_us(2 * 1000 * 1000);
+    EchoResponse response;
+    ClientContext context;
+    context.set_deadline(grpc_timeout_milliseconds_to_deadline(5000));
+    EXPECT_TRUE(stub->Echo(&context, request, &response).ok());
+  });
+  size_t busy_server;
+  while (true) {
+    if (servers_[0]->service_.request_count() > 0) {
+      busy_server = 0;
+      break;
+    }
+    if (servers_[1]->service_.request_count() > 0) {
+      busy_server = 1;
+      break;
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  }
+  // With only two servers, every pick compares both of them, so the other
+  // server gets all the calls while the slow one is in flight.
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_EQ(1, servers_[busy_server]->service_.request_count());
+  EXPECT_EQ(kNumRpcs, servers_[1 - busy_server]->service_.request_count());
+  slow_rpc.join();
+  // Check LB policy name for the channel.
+  EXPECT_EQ("least_request", channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(ClientLbEnd2endTest, RingHash) {
+  const int kNumServers = 3;
+  const int kNumRpcs = 10;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\":[{\"ring_hash\":{\"hashHeader\":\"x-key\"}}]}");
+  // Calls without a key are spread over all servers.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  // Calls with the same key go to the same server.
+  auto send_rpc_with_key = [this, &stub](const char* key) {
+    EchoRequest request;
+    request.set_message(kRequestMessage_);
+    EchoResponse response;
+    ClientContext context;
+    context.AddMetadata("x-key", key);
+    EXPECT_TRUE(stub->Echo(&context, request, &response).ok());
+  };
+  for (const char* key : {"foo", "bar"}) {
+    ResetCounters();
+    for (int i = 0; i < kNumRpcs; ++i) {
+      send_rpc_with_key(key);
+    }
+    int num_servers_used = 0;
+    for (const auto& server : servers_) {
+      const int request_count = server->service_.request_count();
+      if (request_count > 0) {
+        EXPECT_EQ(kNumRpcs, request_count);
+        ++num_servers_used;
+      }
+    }
+    EXPECT_EQ(1, num_servers_used);
+  }
+  // Check LB policy name for the channel.
+  EXPECT_EQ("ring_hash", channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(ClientLbEnd2endTest, OutlierDetection) {
+  const int kNumServers = 2;
+  const int kNumRpcs = 10;
+  const int kMaxRounds = 50;
+  StartServers(kNumServers);
+  // Server 0 is much slower than server 1.
+  servers_[0]->service_.set_delay_ms(50);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\":[{\"outlier_detection_experimental\":{"
+      "\"childPolicy\":[{\"round_robin\":{}}],"
+      "\"interval\":\"1s\",\"minimumHosts\":2,\"requestVolume\":3,"
+      "\"maxEjectionPercent\":50,\"latencyPercentile\":50,"
+      "\"latencyThresholdFactor\":2}}]}");
+  WaitForServer(stub, 0, DEBUG_LOCATION);
+  WaitForServer(stub, 1, DEBUG_LOCATION);
+  // Eventually, server 0 is ejected and all calls go to server 1.
+  int round = 0;
+  for (; round < kMaxRounds; ++round) {
+    ResetCounters();
+    for (int i = 0; i < kNumRpcs; ++i) {
+      CheckRpcSendOk(stub, DEBUG_LOCATION);
+    }
+    if (servers_[0]->service_.request_count() == 0) break;
+  }
+  EXPECT_LT(round, kMaxRounds);
+  EXPECT_EQ(kNumRpcs, servers_[1]->service_.request_count());
+  // Check LB policy name for the channel.
+  EXPECT_EQ("outlier_detection_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
 // If health checking is required by client but health checking service
 // is not running on the server, the channel should be treated as healthy.
 TEST_F(ClientLbEnd2endTest,
@@ -0,0 +1,182 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpcpp/support/coroutine.h>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+// The adapters only exist when the compiler supports coroutines, so this
+// test only has cases when built as C++20.
+#ifdef GRPC_HAS_COROUTINES
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+using experimental::AwaitCallback;
+using experimental::AwaitTag;
+using experimental::DetachedCoroutine;
+using experimental::ResumeCoroutines;
+
+// Answers one call on the async server, after starting the coroutine that
+// takes the next one.
+DetachedCoroutine ServeEcho(EchoTestService::AsyncService* service,
+                            ServerCompletionQueue* cq) {
+  ServerContext context;
+  EchoRequest request;
+  ServerAsyncResponseWriter<EchoResponse> responder(&context);
+  const bool ok = co_await AwaitTag([&](void* tag) {
+    service->RequestEcho(&context, &request, &responder, cq, cq, tag);
+  });
+  // The server is shutting down.
+  if (!ok) co_return;
+  ServeEcho(service, cq);
+  EchoResponse response;
+  response.set_message(request.message());
+  co_await AwaitTag(
+      [&](void* tag) { responder.Finish(response, Status::OK, tag); });
+}
+
+// Sends two calls with the callback API, one after the other, and sets
+// \a done to the concatenation of their responses.
+DetachedCoroutine EchoTwice(EchoTestService::Stub* stub,
+                            std::promise<std::string>* done) {
+  std::string messages;
+  for (const char* message : {"Hello", "World"}) {
+    ClientContext context;
+    EchoRequest request;
+    request.set_message(message);
+    EchoResponse response;
+    const Status status =
+        co_await AwaitCallback([&](std::function<void(Status)> on_done) {
+          stub->experimental_async()->Echo(&context, &request, &response,
+                                           std::move(on_done));
+        });
+    if (!status.ok()) {
+      done->set_value(status.error_message());
+      co_return;
+    }
+    messages += response.message();
+  }
+  done->set_value(messages);
+}
+
+// Sends a call with the completion queue API and stores its response in
+// \a result. The last of the \a pending calls shuts \a cq down.
+DetachedCoroutine EchoOnQueue(EchoTestService::Stub* stub,
+                              CompletionQueue* cq, std::string message,
+                              std::string* result, int* pending) {
+  ClientContext context;
+  EchoRequest request;
+  request.set_message(message);
+  EchoResponse response;
+  Status status;
+  auto reader = stub->PrepareAsyncEcho(&context, request, cq);
+  reader->StartCall();
+  const bool ok = co_await AwaitTag(
+      [&](void* tag) { reader->Finish(&response, &status, tag); });
+  *result = ok && status.ok() ? response.message() : status.error_message();
+  // Coroutines waiting on cq are only resumed by the thread that drives it,
+  // so the count needs no lock.
+  if (--*pending == 0) cq->Shutdown();
+}
+
+class CoroutineEnd2endTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    port_ = grpc_pick_unused_port_or_die();
+    std::ostringstream server_address;
+    server_address << "localhost:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    cq_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    ServeEcho(&service_, cq_.get());
+    server_thread_ = std::thread([this]() { ResumeCoroutines(cq_.get()); });
+    stub_ = EchoTestService::NewStub(
+        CreateChannel(server_address.str(), InsecureChannelCredentials()));
+  }
+
+  void TearDown() override {
+    server_->Shutdown();
+    cq_->Shutdown();
+    server_thread_.join();
+    grpc_recycle_unused_port(port_);
+  }
+
+  int port_;
+  EchoTestService::AsyncService service_;
+  std::unique_ptr<ServerCompletionQueue> cq_;
+  std::unique_ptr<Server> server_;
+  std::thread server_thread_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(CoroutineEnd2endTest, AwaitCallback) {
+  std::promise<std::string> done;
+  EchoTwice(stub_.get(), &done);
+  EXPECT_EQ("HelloWorld", done.get_future().get());
+}
+
+TEST_F(CoroutineEnd2endTest, AwaitTag) {
+  CompletionQueue cq;
+  std::string hello;
+  std::string world;
+  int pending = 2;
+  EchoOnQueue(stub_.get(), &cq, "Hello", &hello, &pending);
+  EchoOnQueue(stub_.get(), &cq, "World", &world, &pending);
+  // Returns once the last call has shut the queue down.
+  ResumeCoroutines(&cq);
+  EXPECT_EQ(0, pending);
+  EXPECT_EQ("Hello", hello);
+  EXPECT_EQ("World", world);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+#endif  // GRPC_HAS_COROUTINES
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -32,6 +32,7 @@
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 
@@ -193,6 +194,61 @@ class TestAuthMetadataProcessor : public AuthMetadataProcessor {
 const char TestAuthMetadataProcessor::kGoodGuy[] = "Dr Jekyll";
 const char TestAuthMetadataProcessor::kIdentityPropName[] = "novel identity";
 
+// Caches its verdicts, keyed by the plugin metadata.
+class CachingAuthMetadataProcessor : public TestAuthMetadataProcessor {
+ public:
+  CachingAuthMetadataProcessor() : TestAuthMetadataProcessor(true) {}
+
+  std::chrono::milliseconds VerdictCacheTtl() const override {
+    return std::chrono::minutes(1);
+  }
+  grpc::string VerdictCacheMetadataKey() const override {
+    return TestMetadataCredentialsPlugin::kGoodMetadataKey;
+  }
+
+  Status Process(const InputMetadata& auth_metadata, AuthContext* context,
+                 OutputMetadata* consumed_auth_metadata,
+                 OutputMetadata* response_metadata) override {
+    ++process_count_;
+    return TestAuthMetadataProcessor::Process(
+        auth_metadata, context, consumed_auth_metadata, response_metadata);
+  }
+
+  int process_count() const { return process_count_; }
+
+ private:
+  std::atomic<int> process_count_{0};
+};
+
+// Processes the calls in batches, recording their sizes.
+class BatchingAuthMetadataProcessor : public TestAuthMetadataProcessor {
+ public:
+  static const size_t kMaxBatchSize = 4;
+
+  BatchingAuthMetadataProcessor() : TestAuthMetadataProcessor(true) {}
+
+  size_t MaxBatchSize() const override { return kMaxBatchSize; }
+
+  void ProcessBatch(std::vector<BatchEntry>* batch) override {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      batch_sizes_.push_back(batch->size());
+    }
+    TestAuthMetadataProcessor::ProcessBatch(batch);
+  }
+
+  std::vector<size_t> batch_sizes() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return batch_sizes_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::vector<size_t> batch_sizes_;
+};
+
+const size_t BatchingAuthMetadataProcessor::kMaxBatchSize;
+
 class Proxy : public ::grpc::testing::EchoTestService::Service {
  public:
   Proxy(const std::shared_ptr<Channel>& channel)
@@ -812,6 +868,65 @@ TEST_P(End2endTest, MultipleRpcs) {
   }
 }
 
+TEST_P(End2endTest, ReusedClientContext) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("Hello hello hello hello");
+  request.mutable_param()->set_echo_metadata(true);
+  ClientContext context;
+  for (int i = 0; i < 3; i++) {
+    const grpc::string value = "value" + grpc::to_string(i);
+    context.AddMetadata("key", value);
+    context.set_deadline(std::chrono::system_clock::now() +
+                         std::chrono::seconds(10));
+    Status s = stub_->Echo(&context, request, &response);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(response.message(), request.message());
+    // Only the metadata of this rpc is echoed back.
+    const auto& trailing_metadata = context.GetServerTrailingMetadata();
+    EXPECT_EQ(1u, trailing_metadata.count("key"));
+    auto iter = trailing_metadata.find("key");
+    ASSERT_TRUE(iter != trailing_metadata.end());
+    EXPECT_EQ(value, grpc::string(iter->second.begin(), iter->second.end()));
+    context.Reset();
+    EXPECT_EQ(gpr_inf_future(GPR_CLOCK_REALTIME).tv_sec,
+              context.raw_deadline().tv_sec);
+  }
+}
+
+TEST_P(End2endTest, ChannelPool) {
+  MAYBE_SKIP_TEST;
+  // The pool creates channels to a target, not in-process ones.
+  if (GetParam().inproc) {
+    return;
+  }
+  ResetStub();
+  ChannelArguments args;
+  auto channel_creds = GetCredentialsProvider()->GetChannelCredentials(
+      GetParam().credentials_type, &args);
+  auto pool = experimental::CreateCustomChannelPool(server_address_.str(),
+                                                    channel_creds, args, 3);
+  auto stub = grpc::testing::EchoTestService::NewStub(pool);
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message("Hello");
+  for (int i = 0; i < 6; i++) {
+    ClientContext context;
+    Status s = stub->Echo(&context, request, &response);
+    EXPECT_TRUE(s.ok());
+    EXPECT_EQ(response.message(), request.message());
+  }
+  ClientContext context;
+  auto stream = stub->BidiStream(&context);
+  EXPECT_TRUE(stream->Write(request));
+  EXPECT_TRUE(stream->Read(&response));
+  EXPECT_EQ(response.message(), request.message());
+  EXPECT_TRUE(stream->WritesDone());
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
 TEST_P(End2endTest, EmptyBinaryMetadata) {
   MAYBE_SKIP_TEST;
   ResetStub();
@@ -936,6 +1051,41 @@ TEST_P(End2endTest, RequestStreamTwoRequestsWithCoalescingApi) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_P(End2endTest, RequestStreamWriteMany) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoRequest requests[3];
+  EchoResponse response;
+  ClientContext context;
+
+  auto stream = stub_->RequestStream(&context, &response);
+  for (auto& request : requests) request.set_message("hello");
+  EXPECT_TRUE(stream->WriteMany(requests, 3, WriteOptions()));
+  stream->WritesDone();
+  Status s = stream->Finish();
+  EXPECT_EQ(response.message(), "hellohellohello");
+  EXPECT_TRUE(s.ok());
+}
+
+TEST_P(End2endTest, RequestStreamCorked) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoRequest request;
+  EchoResponse response;
+  ClientContext context;
+
+  auto stream = stub_->RequestStream(&context, &response);
+  request.set_message("hello");
+  stream->Cork();
+  EXPECT_TRUE(stream->Write(request));
+  EXPECT_TRUE(stream->Write(request));
+  EXPECT_TRUE(stream->Uncork(request));
+  stream->WritesDone();
+  Status s = stream->Finish();
+  EXPECT_EQ(response.message(), "hellohellohello");
+  EXPECT_TRUE(s.ok());
+}
+
 TEST_P(End2endTest, ResponseStream) {
   MAYBE_SKIP_TEST;
   ResetStub();
@@ -1743,6 +1893,74 @@ TEST_P(SecureEnd2endTest, BlockingAuthMetadataPluginAndProcessorFailure) {
   EXPECT_EQ(s.error_code(), StatusCode::UNAUTHENTICATED);
 }
 
+TEST_P(SecureEnd2endTest, AuthMetadataProcessorVerdictCache) {
+  MAYBE_SKIP_TEST;
+  auto* processor = new CachingAuthMetadataProcessor();
+  StartServer(std::shared_ptr<AuthMetadataProcessor>(processor));
+  ResetStub();
+  for (int i = 0; i < 2; i++) {
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext context;
+    context.set_credentials(processor->GetCompatibleClientCreds());
+    request.set_message("Hello");
+    request.mutable_param()->set_echo_metadata(true);
+    if (i == 0) {
+      // The processor adds the identity to the connection's auth context,
+      // so later calls on it see it more than once.
+      request.mutable_param()->set_expected_client_identity(
+          TestAuthMetadataProcessor::kGoodGuy);
+    }
+    Status s = stub_->Echo(&context, request, &response);
+    EXPECT_TRUE(s.ok());
+    // The cached verdict consumes the metadata too.
+    EXPECT_FALSE(MetadataContains(
+        context.GetServerTrailingMetadata(), GRPC_AUTHORIZATION_METADATA_KEY,
+        grpc::string("Bearer ") + TestAuthMetadataProcessor::kGoodGuy));
+  }
+  EXPECT_EQ(processor->process_count(), 1);
+  // Failures are cached as well.
+  for (int i = 0; i < 2; i++) {
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext context;
+    context.set_credentials(processor->GetIncompatibleClientCreds());
+    request.set_message("Hello");
+    Status s = stub_->Echo(&context, request, &response);
+    EXPECT_EQ(s.error_code(), StatusCode::UNAUTHENTICATED);
+  }
+  EXPECT_EQ(processor->process_count(), 2);
+}
+
+TEST_P(SecureEnd2endTest, BatchingAuthMetadataProcessor) {
+  MAYBE_SKIP_TEST;
+  auto* processor = new BatchingAuthMetadataProcessor();
+  StartServer(std::shared_ptr<AuthMetadataProcessor>(processor));
+  ResetStub();
+  const int kNumCalls = 20;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumCalls; i++) {
+    threads.emplace_back([this, processor] {
+      EchoRequest request;
+      EchoResponse response;
+      ClientContext context;
+      context.set_credentials(processor->GetCompatibleClientCreds());
+      request.set_message("Hello");
+      Status s = stub_->Echo(&context, request, &response);
+      EXPECT_TRUE(s.ok());
+      EXPECT_EQ(request.message(), response.message());
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  size_t num_processed = 0;
+  for (size_t size : processor->batch_sizes()) {
+    EXPECT_GE(size, 1u);
+    EXPECT_LE(size, BatchingAuthMetadataProcessor::kMaxBatchSize);
+    num_processed += size;
+  }
+  EXPECT_EQ(num_processed, static_cast<size_t>(kNumCalls));
+}
+
 TEST_P(SecureEnd2endTest, SetPerCallCredentials) {
   MAYBE_SKIP_TEST;
   ResetStub();
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpc/support/time.h>
@@ -59,7 +60,8 @@ void verify_ok(CompletionQueue* cq, int i, bool expect_ok) {
 
 class GenericEnd2endTest : public ::testing::Test {
  protected:
-  GenericEnd2endTest() : server_host_("localhost") {}
+  GenericEnd2endTest()
+      : server_host_("localhost"), server_decompresses_messages_(true) {}
 
   void SetUp() override {
     shut_down_ = false;
@@ -69,6 +71,10 @@ class GenericEnd2endTest : public ::testing::Test {
     ServerBuilder builder;
     builder.AddListeningPort(server_address_.str(),
                              InsecureServerCredentials());
+    if (!server_decompresses_messages_) {
+      builder.AddChannelArgument(
+          GRPC_COMPRESSION_CHANNEL_PER_MESSAGE_DECOMPRESSION, 0);
+    }
     builder.RegisterAsyncGenericService(&generic_service_);
     // Include a second call to RegisterAsyncGenericService to make sure that
     // we get an error in the log, since it is not allowed to have 2 async
@@ -247,6 +253,7 @@ class GenericEnd2endTest : public ::testing::Test {
   AsyncGenericService generic_service_;
   const grpc::string server_host_;
   std::ostringstream server_address_;
+  bool server_decompresses_messages_;
   bool shutting_down_;
   bool shut_down_;
   std::mutex shutting_down_mu_;
@@ -418,6 +425,123 @@ TEST_F(GenericEnd2endTest, ShortDeadline) {
   driver.join();
 }
 
+// By default, the server gets a message compressed on the wire as the
+// uncompressed bytes, in a buffer that reports no compression.
+TEST_F(GenericEnd2endTest, ReceivesCompressedMessageUncompressed) {
+  ResetStub();
+  const grpc::string kMethodName("/grpc.cpp.test.util.EchoTestService/Echo");
+  EchoRequest send_request;
+  Status recv_status;
+
+  ClientContext cli_ctx;
+  cli_ctx.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  GenericServerContext srv_ctx;
+  GenericServerAsyncReaderWriter stream(&srv_ctx);
+
+  send_request.set_message(grpc::string(4096, 'a'));
+  std::unique_ptr<GenericClientAsyncReaderWriter> call =
+      generic_stub_->PrepareCall(&cli_ctx, kMethodName, &cli_cq_);
+  call->StartCall(tag(1));
+  client_ok(1);
+  std::unique_ptr<ByteBuffer> send_buffer =
+      SerializeToByteBuffer(&send_request);
+  call->Write(*send_buffer, tag(2));
+  send_buffer.reset();
+  client_ok(2);
+  call->WritesDone(tag(3));
+  client_ok(3);
+
+  generic_service_.RequestCall(&srv_ctx, &stream, srv_cq_.get(),
+                               srv_cq_.get(), tag(4));
+  server_ok(4);
+
+  ByteBuffer recv_buffer;
+  stream.Read(&recv_buffer, tag(5));
+  server_ok(5);
+  EXPECT_EQ(GRPC_COMPRESS_NONE, recv_buffer.compression_algorithm());
+  // The buffer holds the message bytes themselves.
+  const grpc::string serialized = send_request.SerializeAsString();
+  EXPECT_EQ(serialized.size(), recv_buffer.Length());
+  std::vector<Slice> slices;
+  EXPECT_TRUE(recv_buffer.Dump(&slices).ok());
+  grpc::string received;
+  for (const Slice& slice : slices) {
+    received.append(reinterpret_cast<const char*>(slice.begin()),
+                    slice.size());
+  }
+  EXPECT_EQ(serialized, received);
+
+  stream.Finish(Status::OK, tag(6));
+  server_ok(6);
+  call->Finish(&recv_status, tag(7));
+  client_ok(7);
+  EXPECT_TRUE(recv_status.ok());
+}
+
+class GenericPassthroughEnd2endTest : public GenericEnd2endTest {
+ protected:
+  GenericPassthroughEnd2endTest() { server_decompresses_messages_ = false; }
+};
+
+// The server gets the request still compressed and echoes it back as it is.
+TEST_F(GenericPassthroughEnd2endTest, ForwardsCompressedMessage) {
+  ResetStub();
+  const grpc::string kMethodName("/grpc.cpp.test.util.EchoTestService/Echo");
+  EchoRequest send_request;
+  EchoRequest recv_request;
+  EchoResponse recv_response;
+  Status recv_status;
+
+  ClientContext cli_ctx;
+  cli_ctx.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  GenericServerContext srv_ctx;
+  GenericServerAsyncReaderWriter stream(&srv_ctx);
+
+  send_request.set_message(grpc::string(4096, 'a'));
+  std::unique_ptr<GenericClientAsyncReaderWriter> call =
+      generic_stub_->PrepareCall(&cli_ctx, kMethodName, &cli_cq_);
+  call->StartCall(tag(1));
+  client_ok(1);
+  std::unique_ptr<ByteBuffer> send_buffer =
+      SerializeToByteBuffer(&send_request);
+  const size_t uncompressed_length = send_buffer->Length();
+  call->Write(*send_buffer, tag(2));
+  send_buffer.reset();
+  client_ok(2);
+  call->WritesDone(tag(3));
+  client_ok(3);
+
+  generic_service_.RequestCall(&srv_ctx, &stream, srv_cq_.get(),
+                               srv_cq_.get(), tag(4));
+  server_ok(4);
+
+  ByteBuffer recv_buffer;
+  stream.Read(&recv_buffer, tag(5));
+  server_ok(5);
+  EXPECT_EQ(GRPC_COMPRESS_GZIP, recv_buffer.compression_algorithm());
+  EXPECT_LT(recv_buffer.Length(), uncompressed_length);
+  // Reading the buffer still decompresses it.
+  EXPECT_TRUE(ParseFromByteBuffer(&recv_buffer, &recv_request));
+  EXPECT_EQ(send_request.message(), recv_request.message());
+
+  srv_ctx.set_compression_algorithm(recv_buffer.compression_algorithm());
+  stream.Write(recv_buffer, tag(6));
+  server_ok(6);
+  stream.Finish(Status::OK, tag(7));
+  server_ok(7);
+
+  ByteBuffer cli_recv_buffer;
+  call->Read(&cli_recv_buffer, tag(8));
+  client_ok(8);
+  EXPECT_EQ(GRPC_COMPRESS_NONE, cli_recv_buffer.compression_algorithm());
+  EXPECT_TRUE(ParseFromByteBuffer(&cli_recv_buffer, &recv_response));
+  EXPECT_EQ(send_request.message(), recv_response.message());
+
+  call->Finish(&recv_status, tag(9));
+  client_ok(9);
+  EXPECT_TRUE(recv_status.ok());
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
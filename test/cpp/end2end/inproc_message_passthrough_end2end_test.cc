@@ -0,0 +1,218 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/codegen/call_op_set.h>
+#include <grpcpp/impl/codegen/client_unary_call.h>
+#include <grpcpp/impl/codegen/message_passthrough.h>
+#include <grpcpp/impl/codegen/method_handler.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <grpcpp/impl/codegen/rpc_service_method.h>
+#include <grpcpp/impl/codegen/serialization_traits.h>
+#include <grpcpp/impl/codegen/service_type.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// A message whose only serialized field is text. handed_over is set by the
+// sender and not serialized, so the receiver only sees it set if it got the
+// sender's object.
+struct TextMessage {
+  grpc::string text;
+  bool handed_over = false;
+};
+
+// Number of TextMessages serialized so far
+std::atomic<int> g_serialized{0};
+
+}  // namespace
+}  // namespace testing
+
+template <>
+class SerializationTraits<testing::TextMessage, void> {
+ public:
+  static Status Serialize(const testing::TextMessage& msg, ByteBuffer* bb,
+                          bool* own_buffer) {
+    testing::g_serialized.fetch_add(1);
+    *own_buffer = true;
+    Slice slice(msg.text);
+    ByteBuffer tmp(&slice, 1);
+    bb->Swap(&tmp);
+    return Status::OK;
+  }
+  static Status Deserialize(ByteBuffer* bb, testing::TextMessage* msg) {
+    std::vector<Slice> slices;
+    Status status = bb->Dump(&slices);
+    bb->Clear();
+    if (!status.ok()) return status;
+    msg->text.clear();
+    msg->handed_over = false;
+    for (const Slice& slice : slices) {
+      msg->text.append(reinterpret_cast<const char*>(slice.begin()),
+                       slice.size());
+    }
+    return Status::OK;
+  }
+};
+
+namespace experimental {
+template <>
+struct InprocMessagePassthrough<testing::TextMessage> : public std::true_type {
+};
+}  // namespace experimental
+
+namespace testing {
+namespace {
+
+const char kEchoMethod[] = "/grpc.testing.TextService/Echo";
+// Client metadata asking the server to compress its response
+const char kCompressResponseKey[] = "compress-response";
+
+class TextService : public Service {
+ public:
+  TextService() {
+    AddMethod(new internal::RpcServiceMethod(
+        kEchoMethod, internal::RpcMethod::NORMAL_RPC,
+        new internal::RpcMethodHandler<TextService, TextMessage, TextMessage>(
+            [](TextService* service, ServerContext* context,
+               const TextMessage* request, TextMessage* response) {
+              return service->Echo(context, request, response);
+            },
+            this)));
+  }
+
+  Status Echo(ServerContext* context, const TextMessage* request,
+              TextMessage* response) {
+    request_handed_over_ = request->handed_over;
+    if (context->client_metadata().count(kCompressResponseKey) > 0) {
+      context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    }
+    response->text = request->text;
+    response->handed_over = true;
+    return Status::OK;
+  }
+
+  bool request_handed_over() const { return request_handed_over_; }
+
+ private:
+  bool request_handed_over_ = false;
+};
+
+// Runs every test over an in-process channel with and without
+// GRPC_ARG_INPROC_MESSAGE_PASSTHROUGH.
+class InprocMessagePassthroughEnd2endTest
+    : public ::testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    ServerBuilder builder;
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    if (GetParam()) args.SetInt(GRPC_ARG_INPROC_MESSAGE_PASSTHROUGH, 1);
+    channel_ = server_->InProcessChannel(args);
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  // Echoes \a text and checks that it comes back unchanged, and that it was
+  // serialized both ways unless the channel hands messages over.
+  void Echo(const grpc::string& text, bool compress_request,
+            bool compress_response) {
+    ClientContext context;
+    if (compress_request) {
+      context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    }
+    if (compress_response) context.AddMetadata(kCompressResponseKey, "1");
+    TextMessage request;
+    request.text = text;
+    request.handed_over = true;
+    TextMessage response;
+    const int serialized = g_serialized.load();
+    Status status = internal::BlockingUnaryCall(
+        channel_.get(),
+        internal::RpcMethod(kEchoMethod, internal::RpcMethod::NORMAL_RPC),
+        &context, request, &response);
+    ASSERT_TRUE(status.ok()) << status.error_message();
+    EXPECT_EQ(text, response.text);
+    EXPECT_EQ(GetParam(), service_.request_handed_over());
+    EXPECT_EQ(GetParam(), response.handed_over);
+    EXPECT_EQ(GetParam() ? 0 : 2, g_serialized.load() - serialized);
+  }
+
+  TextService service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+};
+
+TEST_P(InprocMessagePassthroughEnd2endTest, SmallMessages) {
+  for (int i = 0; i < 10; i++) {
+    Echo("hello " + std::to_string(i), false, false);
+  }
+  Echo("", false, false);
+}
+
+// Messages the size of a handed over message's bytes, which are still
+// parsed normally when they were serialized.
+TEST_P(InprocMessagePassthroughEnd2endTest, HeaderSizedMessages) {
+  for (size_t size = 16; size <= 64; size += 8) {
+    Echo(grpc::string(size, 'h'), false, false);
+  }
+}
+
+TEST_P(InprocMessagePassthroughEnd2endTest, LargeMessages) {
+  Echo(grpc::string(1024 * 1024, 'a'), false, false);
+  Echo(grpc::string(3 * 1024 * 1024 + 7, 'b'), false, false);
+}
+
+// Handed over messages skip compression, which would replace their bytes,
+// while serialized ones are still compressed.
+TEST_P(InprocMessagePassthroughEnd2endTest, CompressedMessages) {
+  Echo("compressed request", true, false);
+  Echo("compressed response", false, true);
+  Echo(grpc::string(1024 * 1024, 'c'), true, true);
+}
+
+INSTANTIATE_TEST_SUITE_P(InprocMessagePassthroughEnd2endTest,
+                         InprocMessagePassthroughEnd2endTest,
+                         ::testing::Bool());
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
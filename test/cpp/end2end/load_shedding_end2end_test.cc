@@ -0,0 +1,194 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Calls that wait this long for the server to request them count as
+// queueing delay over the target.
+constexpr int kTargetDelayMs = 200;
+constexpr int kIntervalMs = 1000;
+
+gpr_timespec MillisAfter(gpr_timespec t, int ms) {
+  return gpr_time_add(t, gpr_time_from_millis(ms, GPR_TIMESPAN));
+}
+
+// The server is async, so calls wait in its pending queue until the test
+// requests them: the test plays a slow server.
+class LoadSheddingEnd2endTest : public ::testing::Test {
+ protected:
+  struct ServerCall {
+    ServerCall() : responder(&context) {}
+
+    ServerContext context;
+    EchoRequest request;
+    ServerAsyncResponseWriter<EchoResponse> responder;
+  };
+
+  void SetUp() override {
+    port_ = grpc_pick_unused_port_or_die();
+    std::ostringstream server_address;
+    server_address << "localhost:" << port_;
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address.str(),
+                             InsecureServerCredentials());
+    builder.RegisterService(&service_);
+    builder.experimental().SetLoadShedding(kTargetDelayMs, kIntervalMs);
+    cq_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    stub_ = EchoTestService::NewStub(
+        CreateChannel(server_address.str(), InsecureChannelCredentials()));
+  }
+
+  void TearDown() override {
+    server_->Shutdown();
+    cq_->Shutdown();
+    void* ignored_tag;
+    bool ignored_ok;
+    while (cq_->Next(&ignored_tag, &ignored_ok))
+      ;
+    grpc_recycle_unused_port(port_);
+  }
+
+  // Sends a unary call from a new thread, which stores its status.
+  std::thread StartCall(Status* status) {
+    return std::thread([this, status]() {
+      ClientContext context;
+      context.set_deadline(grpc_timeout_seconds_to_deadline(30));
+      EchoRequest request;
+      request.set_message("Hello");
+      EchoResponse response;
+      *status = stub_->Echo(&context, request, &response);
+    });
+  }
+
+  // Asks for the next call. Pending calls are dequeued, or shed, right away.
+  void RequestCall(ServerCall* call) {
+    service_.RequestEcho(&call->context, &call->request, &call->responder,
+                         cq_.get(), cq_.get(), call);
+  }
+
+  // Waits for a requested call to arrive, and answers it.
+  void AnswerCall(ServerCall* call) {
+    void* got_tag;
+    bool ok;
+    ASSERT_TRUE(cq_->Next(&got_tag, &ok));
+    EXPECT_EQ(call, got_tag);
+    EXPECT_TRUE(ok);
+    EchoResponse response;
+    response.set_message(call->request.message());
+    call->responder.Finish(response, Status::OK, call);
+    ASSERT_TRUE(cq_->Next(&got_tag, &ok));
+    EXPECT_EQ(call, got_tag);
+  }
+
+  int port_;
+  EchoTestService::AsyncService service_;
+  std::unique_ptr<ServerCompletionQueue> cq_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(LoadSheddingEnd2endTest, ShedsOnlyWhileDelayStaysAboveTarget) {
+  // Calls queue up for longer than the target.
+  constexpr int kNumCalls = 5;
+  std::vector<Status> statuses(kNumCalls);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumCalls; ++i) {
+    threads.push_back(StartCall(&statuses[i]));
+  }
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(kTargetDelayMs * 3));
+  // The first call dequeued starts an interval, and is served.
+  ServerCall first;
+  const gpr_timespec first_interval = gpr_now(GPR_CLOCK_MONOTONIC);
+  RequestCall(&first);
+  AnswerCall(&first);
+  // Once no call dequeued in the interval waited less than the target, the
+  // calls that waited over twice as long are shed.
+  gpr_sleep_until(MillisAfter(first_interval, kIntervalMs * 13 / 10));
+  ServerCall second;
+  const gpr_timespec shedding_interval = gpr_now(GPR_CLOCK_MONOTONIC);
+  RequestCall(&second);
+  for (std::thread& thread : threads) thread.join();
+  int num_ok = 0;
+  int num_shed = 0;
+  for (const Status& status : statuses) {
+    if (status.ok()) {
+      ++num_ok;
+    } else {
+      EXPECT_EQ(StatusCode::RESOURCE_EXHAUSTED, status.error_code());
+      ++num_shed;
+    }
+  }
+  EXPECT_EQ(1, num_ok);
+  EXPECT_EQ(kNumCalls - 1, num_shed);
+  // The request that found nothing left to dequeue takes the next call.
+  Status status;
+  std::thread thread = StartCall(&status);
+  AnswerCall(&second);
+  thread.join();
+  EXPECT_TRUE(status.ok());
+  // A call that waits less than the target brings the delay back down...
+  ServerCall third;
+  thread = StartCall(&status);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(kTargetDelayMs / 2));
+  RequestCall(&third);
+  AnswerCall(&third);
+  thread.join();
+  EXPECT_TRUE(status.ok());
+  // ...so once that interval is over, even calls that waited over twice the
+  // target are served.
+  ServerCall fourth;
+  thread = StartCall(&status);
+  gpr_sleep_until(MillisAfter(shedding_interval, kIntervalMs * 13 / 10));
+  RequestCall(&fourth);
+  AnswerCall(&fourth);
+  thread.join();
+  EXPECT_TRUE(status.ok());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
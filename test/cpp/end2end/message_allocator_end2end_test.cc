@@ -37,6 +37,7 @@
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/client_callback.h>
 #include <grpcpp/support/message_allocator.h>
+#include <grpcpp/support/proto_arena_allocator.h>
 
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
@@ -374,6 +375,21 @@ TEST_P(ArenaAllocatorTest, SimpleRpc) {
   EXPECT_EQ(kRpcCount, allocator->allocation_count);
 }
 
+class ProtoArenaAllocatorTest : public MessageAllocatorEnd2endTestBase {};
+
+TEST_P(ProtoArenaAllocatorTest, SimpleRpc) {
+  MAYBE_SKIP_TEST;
+  const int kRpcCount = 10;
+  // Fewer pooled arenas than RPCs, so that some are also freed.
+  std::unique_ptr<
+      experimental::ProtoArenaMessageAllocator<EchoRequest, EchoResponse>>
+      allocator(new experimental::ProtoArenaMessageAllocator<EchoRequest,
+                                                              EchoResponse>(2));
+  CreateServer(allocator.get());
+  ResetStub();
+  SendRpcs(kRpcCount);
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
   std::vector<TestScenario> scenarios;
   std::vector<grpc::string> credentials_types{
@@ -409,6 +425,8 @@ INSTANTIATE_TEST_SUITE_P(SimpleAllocatorTest, SimpleAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
 INSTANTIATE_TEST_SUITE_P(ArenaAllocatorTest, ArenaAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
+INSTANTIATE_TEST_SUITE_P(ProtoArenaAllocatorTest, ProtoArenaAllocatorTest,
+                         ::testing::ValuesIn(CreateTestScenarios(true)));
 
 }  // namespace
 }  // namespace testing
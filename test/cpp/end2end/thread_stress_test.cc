@@ -175,6 +175,25 @@ class CommonStressTestSyncServerLowThreadCount : public BaseClass {
   TestServiceImpl service_;
 };
 
+template <class BaseClass>
+class CommonStressTestSyncServerPrioritized : public BaseClass {
+ public:
+  void SetUp() override {
+    ServerBuilder builder;
+    this->SetUpStart(&builder, &service_);
+    builder.experimental().SetMethodPriority(
+        "/grpc.testing.EchoTestService/Echo", 1);
+    this->SetUpEnd(&builder);
+  }
+  void TearDown() override {
+    this->TearDownStart();
+    this->TearDownEnd();
+  }
+
+ private:
+  TestServiceImpl service_;
+};
+
 template <class BaseClass>
 class CommonStressTestAsyncServer : public BaseClass {
  public:
@@ -304,6 +323,8 @@ typedef ::testing::Types<
     CommonStressTestSyncServer<CommonStressTestInproc<TestServiceImpl, false>>,
     CommonStressTestSyncServerLowThreadCount<
         CommonStressTestInproc<TestServiceImpl, true>>,
+    CommonStressTestSyncServerPrioritized<
+        CommonStressTestInsecure<TestServiceImpl>>,
     CommonStressTestAsyncServer<
         CommonStressTestInsecure<grpc::testing::EchoTestService::AsyncService>>,
     CommonStressTestAsyncServer<CommonStressTestInproc<
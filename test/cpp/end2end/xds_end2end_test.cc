@@ -84,6 +84,8 @@ namespace {
 using std::chrono::system_clock;
 
 using ::envoy::api::v2::ClusterLoadAssignment;
+using ::envoy::api::v2::DeltaDiscoveryRequest;
+using ::envoy::api::v2::DeltaDiscoveryResponse;
 using ::envoy::api::v2::DiscoveryRequest;
 using ::envoy::api::v2::DiscoveryResponse;
 using ::envoy::api::v2::FractionalPercent;
@@ -127,6 +129,23 @@ constexpr char kBootstrapFile[] =
     "  }\n"
     "}\n";
 
+constexpr char kBootstrapFileIncremental[] =
+    "{\n"
+    "  \"xds_server\": {\n"
+    "    \"server_uri\": \"fake:///lb\",\n"
+    "    \"channel_creds\": [\n"
+    "      {\n"
+    "        \"type\": \"fake\"\n"
+    "      }\n"
+    "    ],\n"
+    "    \"incremental_xds\": true\n"
+    "  },\n"
+    "  \"node\": {\n"
+    "    \"id\": \"xds_end2end_test\",\n"
+    "    \"cluster\": \"test\"\n"
+    "  }\n"
+    "}\n";
+
 constexpr char kBootstrapFileBad[] =
     "{\n"
     "  \"xds_server\": {\n"
@@ -143,6 +162,7 @@ constexpr char kBootstrapFileBad[] =
 
 char* g_bootstrap_file;
 char* g_bootstrap_file_bad;
+char* g_bootstrap_file_incremental;
 
 void WriteBootstrapFiles() {
   char* bootstrap_file;
@@ -154,6 +174,10 @@ void WriteBootstrapFiles() {
   fputs(kBootstrapFileBad, out);
   fclose(out);
   g_bootstrap_file_bad = bootstrap_file;
+  out = gpr_tmpfile("xds_bootstrap_incremental", &bootstrap_file);
+  fputs(kBootstrapFileIncremental, out);
+  fclose(out);
+  g_bootstrap_file_incremental = bootstrap_file;
 }
 
 // Helper class to minimize the number of unique ports we use for this test.
@@ -366,6 +390,9 @@ class AdsServiceImpl : public AdsService {
 
   using Stream = ServerReaderWriter<DiscoveryResponse, DiscoveryRequest>;
   using ResponseDelayPair = std::pair<DiscoveryResponse, int>;
+  using DeltaStream =
+      ServerReaderWriter<DeltaDiscoveryResponse, DeltaDiscoveryRequest>;
+  using DeltaResponseDelayPair = std::pair<DeltaDiscoveryResponse, int>;
 
   Status StreamAggregatedResources(ServerContext* context,
                                    Stream* stream) override {
@@ -402,15 +429,86 @@ class AdsServiceImpl : public AdsService {
     return Status::OK;
   }
 
+  Status DeltaAggregatedResources(ServerContext* context,
+                                  DeltaStream* stream) override {
+    gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources starts", this);
+    [&]() {
+      {
+        grpc_core::MutexLock lock(&ads_mu_);
+        if (ads_done_) return;
+      }
+      // Read request.
+      DeltaDiscoveryRequest request;
+      if (!stream->Read(&request)) return;
+      IncreaseRequestCount();
+      gpr_log(GPR_INFO, "ADS[%p]: received initial message '%s'", this,
+              request.DebugString().c_str());
+      AddDeltaRequest(request);
+      // The client ACKs or NACKs every response, so keep reading while the
+      // responses are sent.
+      std::thread reader([this, stream]() {
+        DeltaDiscoveryRequest ack;
+        while (stream->Read(&ack)) {
+          gpr_log(GPR_INFO, "ADS[%p]: received ACK '%s'", this,
+                  ack.DebugString().c_str());
+          AddDeltaRequest(ack);
+        }
+      });
+      // Send responses, each with its own nonce.
+      std::vector<DeltaResponseDelayPair> responses_and_delays;
+      {
+        grpc_core::MutexLock lock(&ads_mu_);
+        responses_and_delays = delta_responses_and_delays_;
+      }
+      for (size_t i = 0; i < responses_and_delays.size(); ++i) {
+        DeltaDiscoveryResponse response = responses_and_delays[i].first;
+        response.set_nonce(std::to_string(i + 1));
+        SendResponse(stream, response, responses_and_delays[i].second);
+      }
+      // Wait until notified done.
+      {
+        grpc_core::MutexLock lock(&ads_mu_);
+        ads_cond_.WaitUntil(&ads_mu_, [this] { return ads_done_; });
+      }
+      // Cancel the call to unblock the reader.
+      context->TryCancel();
+      reader.join();
+    }();
+    gpr_log(GPR_INFO, "ADS[%p]: DeltaAggregatedResources done", this);
+    return Status::OK;
+  }
+
   void add_response(const DiscoveryResponse& response, int send_after_ms) {
     grpc_core::MutexLock lock(&ads_mu_);
     responses_and_delays_.push_back(std::make_pair(response, send_after_ms));
   }
 
+  void add_delta_response(const DeltaDiscoveryResponse& response,
+                          int send_after_ms) {
+    grpc_core::MutexLock lock(&ads_mu_);
+    delta_responses_and_delays_.push_back(
+        std::make_pair(response, send_after_ms));
+  }
+
+  // The requests received on the current incremental stream: the initial
+  // request followed by an ACK or NACK per response.
+  std::vector<DeltaDiscoveryRequest> delta_requests() {
+    grpc_core::MutexLock lock(&ads_mu_);
+    return delta_requests_;
+  }
+
+  void WaitForDeltaRequests(size_t count) {
+    grpc_core::MutexLock lock(&ads_mu_);
+    delta_requests_cond_.WaitUntil(
+        &ads_mu_, [this, count] { return delta_requests_.size() >= count; });
+  }
+
   void Start() {
     grpc_core::MutexLock lock(&ads_mu_);
     ads_done_ = false;
     responses_and_delays_.clear();
+    delta_responses_and_delays_.clear();
+    delta_requests_.clear();
   }
 
   void Shutdown() {
@@ -418,11 +516,40 @@ class AdsServiceImpl : public AdsService {
       grpc_core::MutexLock lock(&ads_mu_);
       NotifyDoneWithAdsCallLocked();
       responses_and_delays_.clear();
+      delta_responses_and_delays_.clear();
     }
     gpr_log(GPR_INFO, "ADS[%p]: shut down", this);
   }
 
   static DiscoveryResponse BuildResponse(const ResponseArgs& args) {
+    DiscoveryResponse response;
+    response.set_type_url(kEdsTypeUrl);
+    response.add_resources()->PackFrom(BuildAssignment(args));
+    return response;
+  }
+
+  // Builds an incremental response that adds or changes the resource \a name.
+  static DeltaDiscoveryResponse BuildDeltaResponse(
+      const grpc::string& name, const grpc::string& version,
+      const ResponseArgs& args) {
+    DeltaDiscoveryResponse response;
+    response.set_type_url(kEdsTypeUrl);
+    auto* resource = response.add_resources();
+    resource->set_name(name);
+    resource->set_version(version);
+    resource->mutable_resource()->PackFrom(BuildAssignment(args));
+    return response;
+  }
+
+  // Builds an incremental response that removes the resource \a name.
+  static DeltaDiscoveryResponse BuildDeltaRemoval(const grpc::string& name) {
+    DeltaDiscoveryResponse response;
+    response.set_type_url(kEdsTypeUrl);
+    response.add_removed_resources(name);
+    return response;
+  }
+
+  static ClusterLoadAssignment BuildAssignment(const ResponseArgs& args) {
     ClusterLoadAssignment assignment;
     assignment.set_cluster_name("service name");
     for (const auto& locality : args.locality_list) {
@@ -459,10 +586,7 @@ class AdsServiceImpl : public AdsService {
         drop_percentage->set_denominator(args.drop_denominator);
       }
     }
-    DiscoveryResponse response;
-    response.set_type_url(kEdsTypeUrl);
-    response.add_resources()->PackFrom(assignment);
-    return response;
+    return assignment;
   }
 
   void NotifyDoneWithAdsCall() {
@@ -478,7 +602,8 @@ class AdsServiceImpl : public AdsService {
   }
 
  private:
-  void SendResponse(Stream* stream, const DiscoveryResponse& response,
+  template <typename StreamType, typename ResponseType>
+  void SendResponse(StreamType* stream, const ResponseType& response,
                     int delay_ms) {
     gpr_log(GPR_INFO, "ADS[%p]: sleeping for %d ms...", this, delay_ms);
     if (delay_ms > 0) {
@@ -490,11 +615,20 @@ class AdsServiceImpl : public AdsService {
     stream->Write(response);
   }
 
+  void AddDeltaRequest(const DeltaDiscoveryRequest& request) {
+    grpc_core::MutexLock lock(&ads_mu_);
+    delta_requests_.push_back(request);
+    delta_requests_cond_.Broadcast();
+  }
+
   grpc_core::CondVar ads_cond_;
+  grpc_core::CondVar delta_requests_cond_;
   // Protect the members below.
   grpc_core::Mutex ads_mu_;
   bool ads_done_ = false;
   std::vector<ResponseDelayPair> responses_and_delays_;
+  std::vector<DeltaResponseDelayPair> delta_responses_and_delays_;
+  std::vector<DeltaDiscoveryRequest> delta_requests_;
 };
 
 class LrsServiceImpl : public LrsService {
@@ -867,6 +1001,12 @@ class XdsEnd2endTest : public ::testing::TestWithParam<TestType> {
     balancers_[i]->ads_service()->add_response(response, delay_ms);
   }
 
+  void ScheduleDeltaResponseForBalancer(size_t i,
+                                        const DeltaDiscoveryResponse& response,
+                                        int delay_ms) {
+    balancers_[i]->ads_service()->add_delta_response(response, delay_ms);
+  }
+
   Status SendRpc(EchoResponse* response = nullptr, int timeout_ms = 1000,
                  bool wait_for_ready = false) {
     const bool local_response = (response == nullptr);
@@ -1294,6 +1434,64 @@ TEST_P(LocalityMapTest, WeightedRoundRobin) {
   EXPECT_EQ(1U, balancers_[0]->ads_service()->response_count());
 }
 
+// Tests that when an update lists the same localities with new weights, the
+// localities are matched by name to the existing ones, and picked according
+// to the new weights.
+TEST_P(LocalityMapTest, UpdateWeightsOfSameLocalities) {
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  const size_t kNumRpcs = 5000;
+  const std::vector<int> kLocalityWeights0 = {1, 2, 7};
+  const std::vector<int> kLocalityWeights1 = {7, 2, 1};
+  const int kTotalLocalityWeight = 10;
+  AdsServiceImpl::ResponseArgs args({
+      {"locality0", GetBackendPorts(0, 1), kLocalityWeights0[0]},
+      {"locality1", GetBackendPorts(1, 2), kLocalityWeights0[1]},
+      {"locality2", GetBackendPorts(2, 3), kLocalityWeights0[2]},
+  });
+  ScheduleResponseForBalancer(0, AdsServiceImpl::BuildResponse(args), 0);
+  args = AdsServiceImpl::ResponseArgs({
+      {"locality0", GetBackendPorts(0, 1), kLocalityWeights1[0]},
+      {"locality1", GetBackendPorts(1, 2), kLocalityWeights1[1]},
+      {"locality2", GetBackendPorts(2, 3), kLocalityWeights1[2]},
+  });
+  ScheduleResponseForBalancer(0, AdsServiceImpl::BuildResponse(args), 5000);
+  const double kErrorTolerance = 0.2;
+  auto check_picked_rates = [&](const std::vector<int>& weights) {
+    for (size_t i = 0; i < weights.size(); ++i) {
+      const double weight_rate =
+          static_cast<double>(weights[i]) / kTotalLocalityWeight;
+      const double picked_rate =
+          static_cast<double>(
+              backends_[i]->backend_service()->request_count()) /
+          kNumRpcs;
+      EXPECT_THAT(picked_rate,
+                  ::testing::AllOf(
+                      ::testing::Ge(weight_rate * (1 - kErrorTolerance)),
+                      ::testing::Le(weight_rate * (1 + kErrorTolerance))));
+    }
+  };
+  WaitForAllBackends(0, 3);
+  CheckRpcSendOk(kNumRpcs);
+  check_picked_rates(kLocalityWeights0);
+  // Wait until the update has been processed, as signaled by the ADS service
+  // having sent it and locality0 becoming the most picked one.
+  while (balancers_[0]->ads_service()->response_count() < 2) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
+  }
+  ResetBackendCounters();
+  while (backends_[0]->backend_service()->request_count() <
+         backends_[2]->backend_service()->request_count() + 100) {
+    CheckRpcSendOk();
+  }
+  ResetBackendCounters();
+  CheckRpcSendOk(kNumRpcs);
+  check_picked_rates(kLocalityWeights1);
+  // The ADS service got a single request, and sent two responses.
+  EXPECT_EQ(1U, balancers_[0]->ads_service()->request_count());
+  EXPECT_EQ(2U, balancers_[0]->ads_service()->response_count());
+}
+
 // Tests that the locality map can work properly even when it contains a large
 // number of localities.
 TEST_P(LocalityMapTest, StressTest) {
@@ -2249,6 +2447,208 @@ TEST_P(BalancerUpdateTest, DeadUpdate) {
 // TODO(juanlishen): Add TEST_P(UpdatesWithClientLoadReportingTest,
 // ReresolveDeadBalancer)
 
+class IncrementalXdsTest : public BasicTest {
+ public:
+  void SetUp() override {
+    BasicTest::SetUp();
+    gpr_setenv("GRPC_XDS_BOOTSTRAP", g_bootstrap_file_incremental);
+    ResetStub();
+  }
+};
+
+// Tests that the client subscribes to its resource over a Delta ADS stream,
+// applies every new version and ACKs each response.
+TEST_P(IncrementalXdsTest, Update) {
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  const size_t kNumRpcs = 100;
+  AdsServiceImpl::ResponseArgs args({
+      {"locality0", GetBackendPorts(0, 2)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "1", args),
+      0);
+  args = AdsServiceImpl::ResponseArgs({
+      {"locality0", GetBackendPorts(2, 4)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "2", args),
+      2000);
+  WaitForAllBackends(0, 2);
+  // Wait for the second version to be applied.
+  WaitForAllBackends(2, 4);
+  CheckRpcSendOk(kNumRpcs);
+  EXPECT_EQ(0U, backends_[0]->backend_service()->request_count());
+  EXPECT_EQ(0U, backends_[1]->backend_service()->request_count());
+  // The initial request subscribes to the resource, and each response is
+  // ACKed with its nonce.
+  balancers_[0]->ads_service()->WaitForDeltaRequests(3);
+  const auto requests = balancers_[0]->ads_service()->delta_requests();
+  ASSERT_EQ(3U, requests.size());
+  EXPECT_EQ(kEdsTypeUrl, requests[0].type_url());
+  ASSERT_EQ(1, requests[0].resource_names_subscribe_size());
+  EXPECT_EQ(kApplicationTargetName_, requests[0].resource_names_subscribe(0));
+  EXPECT_EQ(0U, requests[0].initial_resource_versions().size());
+  EXPECT_EQ("", requests[0].response_nonce());
+  EXPECT_EQ("1", requests[1].response_nonce());
+  EXPECT_FALSE(requests[1].has_error_detail());
+  EXPECT_EQ("2", requests[2].response_nonce());
+  EXPECT_FALSE(requests[2].has_error_detail());
+  // The ADS service got a single request, and sent two responses.
+  EXPECT_EQ(1U, balancers_[0]->ads_service()->request_count());
+  EXPECT_EQ(2U, balancers_[0]->ads_service()->response_count());
+}
+
+// Tests that a response resending the version the client already has is
+// ACKed but not applied.
+TEST_P(IncrementalXdsTest, SameVersionIsIgnored) {
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  const size_t kNumRpcs = 100;
+  AdsServiceImpl::ResponseArgs args({
+      {"locality0", GetBackendPorts(0, 2)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "1", args),
+      0);
+  // Same version, different contents.
+  args = AdsServiceImpl::ResponseArgs({
+      {"locality0", GetBackendPorts(2, 4)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "1", args),
+      1000);
+  WaitForAllBackends(0, 2);
+  // Wait for the resend to be ACKed.
+  balancers_[0]->ads_service()->WaitForDeltaRequests(3);
+  const auto requests = balancers_[0]->ads_service()->delta_requests();
+  EXPECT_EQ("2", requests[2].response_nonce());
+  EXPECT_FALSE(requests[2].has_error_detail());
+  CheckRpcSendOk(kNumRpcs);
+  EXPECT_EQ(0U, backends_[2]->backend_service()->request_count());
+  EXPECT_EQ(0U, backends_[3]->backend_service()->request_count());
+  EXPECT_EQ(2U, balancers_[0]->ads_service()->response_count());
+}
+
+// Tests that once the server removes the resource, the client applies the
+// same version again when it is added back.
+TEST_P(IncrementalXdsTest, RemovedResourceCanBeAddedBack) {
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  AdsServiceImpl::ResponseArgs args({
+      {"locality0", GetBackendPorts(0, 2)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "1", args),
+      0);
+  ScheduleDeltaResponseForBalancer(
+      0, AdsServiceImpl::BuildDeltaRemoval(kApplicationTargetName_), 1000);
+  args = AdsServiceImpl::ResponseArgs({
+      {"locality0", GetBackendPorts(2, 4)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "1", args),
+      1000);
+  WaitForAllBackends(0, 2);
+  // Wait for the resource to be added back.
+  WaitForAllBackends(2, 4);
+  // The removal was ACKed like any other response.
+  balancers_[0]->ads_service()->WaitForDeltaRequests(4);
+  const auto requests = balancers_[0]->ads_service()->delta_requests();
+  EXPECT_EQ("2", requests[2].response_nonce());
+  EXPECT_FALSE(requests[2].has_error_detail());
+  EXPECT_EQ(3U, balancers_[0]->ads_service()->response_count());
+}
+
+// Tests that an invalid response is NACKed with the error, and that the
+// client keeps using the last valid version until the next one.
+TEST_P(IncrementalXdsTest, InvalidResponseIsNacked) {
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  const size_t kNumRpcs = 100;
+  AdsServiceImpl::ResponseArgs args({
+      {"locality0", GetBackendPorts(0, 2)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "1", args),
+      0);
+  // No localities and no drops.
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "2",
+                                         AdsServiceImpl::ResponseArgs()),
+      1000);
+  // A valid response with the version that was rejected.
+  args = AdsServiceImpl::ResponseArgs({
+      {"locality0", GetBackendPorts(2, 4)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "2", args),
+      3000);
+  WaitForAllBackends(0, 2);
+  balancers_[0]->ads_service()->WaitForDeltaRequests(3);
+  auto requests = balancers_[0]->ads_service()->delta_requests();
+  EXPECT_EQ("2", requests[2].response_nonce());
+  ASSERT_TRUE(requests[2].has_error_detail());
+  EXPECT_NE("", requests[2].error_detail().message());
+  // The rejected version is not used.
+  CheckRpcSendOk(kNumRpcs);
+  EXPECT_EQ(0U, backends_[2]->backend_service()->request_count());
+  EXPECT_EQ(0U, backends_[3]->backend_service()->request_count());
+  // The rejected version is not remembered either, so a valid response with
+  // the same version is applied.
+  WaitForAllBackends(2, 4);
+  balancers_[0]->ads_service()->WaitForDeltaRequests(4);
+  requests = balancers_[0]->ads_service()->delta_requests();
+  EXPECT_EQ("3", requests[3].response_nonce());
+  EXPECT_FALSE(requests[3].has_error_detail());
+}
+
+// Tests that on a new stream, the client tells the server which version it
+// already has.
+TEST_P(IncrementalXdsTest, ReconnectSendsInitialResourceVersions) {
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  AdsServiceImpl::ResponseArgs args({
+      {"locality0", GetBackendPorts(0, 2)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "1", args),
+      0);
+  WaitForAllBackends(0, 2);
+  balancers_[0]->ads_service()->WaitForDeltaRequests(2);
+  // Restart the balancer, so that the client opens a new stream.
+  balancers_[0]->Shutdown();
+  balancers_[0]->Start(server_host_);
+  args = AdsServiceImpl::ResponseArgs({
+      {"locality0", GetBackendPorts(2, 4)},
+  });
+  ScheduleDeltaResponseForBalancer(
+      0,
+      AdsServiceImpl::BuildDeltaResponse(kApplicationTargetName_, "2", args),
+      0);
+  WaitForAllBackends(2, 4);
+  balancers_[0]->ads_service()->WaitForDeltaRequests(2);
+  const auto requests = balancers_[0]->ads_service()->delta_requests();
+  ASSERT_EQ(1U, requests[0].initial_resource_versions().size());
+  EXPECT_EQ("1", requests[0].initial_resource_versions().at(
+                     kApplicationTargetName_));
+  ASSERT_EQ(1, requests[0].resource_names_subscribe_size());
+  EXPECT_EQ(kApplicationTargetName_, requests[0].resource_names_subscribe(0));
+  // Nonces start over on the new stream.
+  EXPECT_EQ("1", requests[1].response_nonce());
+  EXPECT_FALSE(requests[1].has_error_detail());
+}
+
 class ClientLoadReportingTest : public XdsEnd2endTest {
  public:
   ClientLoadReportingTest() : XdsEnd2endTest(4, 1, 3) {}
@@ -2474,6 +2874,12 @@ INSTANTIATE_TEST_SUITE_P(XdsTest, BalancerUpdateTest,
                                            TestType(true, true)),
                          &TestTypeName);
 
+INSTANTIATE_TEST_SUITE_P(XdsTest, IncrementalXdsTest,
+                         ::testing::Values(TestType(false, true),
+                                           TestType(false, false),
+                                           TestType(true, true)),
+                         &TestTypeName);
+
 // Load reporting tests are not run with load reporting disabled.
 INSTANTIATE_TEST_SUITE_P(XdsTest, ClientLoadReportingTest,
                          ::testing::Values(TestType(false, true),
@@ -310,6 +310,41 @@ TEST_F(StatsPluginEnd2EndTest, CompletedRpcs) {
   }
 }
 
+TEST_F(StatsPluginEnd2EndTest, SampledStats) {
+  View client_completed_rpcs_view(ClientCompletedRpcsCumulative());
+  View server_completed_rpcs_view(ServerCompletedRpcsCumulative());
+
+  EchoRequest request;
+  request.set_message("foo");
+  EchoResponse response;
+  // Clients and servers each record one RPC in two.
+  SetOpenCensusStatsSampling(2);
+  const int count = 4;
+  for (int i = 0; i < count; ++i) {
+    ::grpc::ClientContext context;
+    ::grpc::Status status = stub_->Echo(&context, request, &response);
+    ASSERT_TRUE(status.ok());
+    EXPECT_EQ("foo", response.message());
+  }
+  // No RPC is recorded.
+  SetOpenCensusStatsSampling(0);
+  {
+    ::grpc::ClientContext context;
+    ::grpc::Status status = stub_->Echo(&context, request, &response);
+    ASSERT_TRUE(status.ok());
+  }
+  SetOpenCensusStatsSampling(1);
+  absl::SleepFor(absl::Milliseconds(500));
+  TestUtils::Flush();
+
+  EXPECT_THAT(client_completed_rpcs_view.GetData().int_data(),
+              ::testing::UnorderedElementsAre(::testing::Pair(
+                  ::testing::ElementsAre(client_method_name_, "OK"), 2)));
+  EXPECT_THAT(server_completed_rpcs_view.GetData().int_data(),
+              ::testing::UnorderedElementsAre(::testing::Pair(
+                  ::testing::ElementsAre(server_method_name_, "OK"), 2)));
+}
+
 TEST_F(StatsPluginEnd2EndTest, RequestReceivedMessagesPerRpc) {
   // TODO: Use streaming RPCs.
   View client_received_messages_per_rpc_view(
@@ -32,6 +32,14 @@ static void BM_Arena_NoOp(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_NoOp)->Range(1, 1024 * 1024);
 
+static void BM_ArenaPool_NoOp(benchmark::State& state) {
+  grpc_core::ArenaPool pool(1024 * 1024);
+  for (auto _ : state) {
+    pool.Destroy(pool.CreateWithAlloc(state.range(0), 1).first);
+  }
+}
+BENCHMARK(BM_ArenaPool_NoOp)->Range(1, 1024 * 1024);
+
 static void BM_Arena_ManyAlloc(benchmark::State& state) {
   Arena* a = Arena::Create(state.range(0));
   const size_t realloc_after =
@@ -59,6 +67,18 @@ static void BM_Arena_Batch(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+static void BM_ArenaPool_Batch(benchmark::State& state) {
+  grpc_core::ArenaPool pool(1024 * 1024);
+  for (auto _ : state) {
+    Arena* a = pool.CreateWithAlloc(state.range(0), 1).first;
+    for (int i = 0; i < state.range(1); i++) {
+      a->Alloc(state.range(2));
+    }
+    pool.Destroy(a);
+  }
+}
+BENCHMARK(BM_ArenaPool_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -35,6 +35,7 @@
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/iomgr/call_combiner.h"
@@ -92,6 +93,21 @@ class InsecureChannel : public BaseChannelFixture {
             grpc_insecure_channel_create("localhost:1234", nullptr, nullptr)) {}
 };
 
+class InsecureChannelWithArenaPool : public BaseChannelFixture {
+ public:
+  InsecureChannelWithArenaPool()
+      : BaseChannelFixture(grpc_insecure_channel_create("localhost:1234",
+                                                        Args(), nullptr)) {}
+
+ private:
+  static const grpc_channel_args* Args() {
+    static grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_CALL_ARENA_POOL_SIZE), 1024 * 1024);
+    static const grpc_channel_args args = {1, &arg};
+    return &args;
+  }
+};
+
 class LameChannel : public BaseChannelFixture {
  public:
   LameChannel()
@@ -117,6 +133,7 @@ static void BM_CallCreateDestroy(benchmark::State& state) {
 }
 
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, InsecureChannel);
+BENCHMARK_TEMPLATE(BM_CallCreateDestroy, InsecureChannelWithArenaPool);
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, LameChannel);
 
 ////////////////////////////////////////////////////////////////////////////////
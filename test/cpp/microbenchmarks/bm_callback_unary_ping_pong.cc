@@ -16,9 +16,27 @@
  *
  */
 
+#include <cstdlib>
+#include <new>
+
 #include "test/cpp/microbenchmarks/callback_unary_ping_pong.h"
 #include "test/cpp/util/test_config.h"
 
+namespace grpc {
+namespace testing {
+std::atomic<size_t> g_cpp_heap_allocs{0};
+}  // namespace testing
+}  // namespace grpc
+
+void* operator new(std::size_t size) {
+  grpc::testing::g_cpp_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) std::abort();
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
 namespace grpc {
 namespace testing {
 
@@ -25,6 +25,8 @@
 #include <memory>
 #include <sstream>
 
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
@@ -235,6 +237,25 @@ class SingleNonInternedElem {
   }
 };
 
+// A non binary value of kLength characters, like the bearer tokens of
+// authorization headers
+template <int kLength>
+class SingleNonInternedLongElem {
+ public:
+  static constexpr bool kEnableTrueBinary = false;
+  static std::vector<grpc_mdelem> GetElems() {
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string value = "Bearer ";
+    for (int i = 0; i < kLength; i++) {
+      value.push_back(alphabet[(i * 37 + i / 64) % 64]);
+    }
+    return {grpc_mdelem_from_slices(
+        grpc_slice_from_static_string("authorization"),
+        grpc_slice_from_copied_buffer(value.data(), value.size()))};
+  }
+};
+
 template <int kLength, bool kTrueBinary>
 class SingleNonInternedBinaryElem {
  public:
@@ -407,6 +428,12 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    SingleNonInternedBinaryElem<100, true>)
     ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonInternedLongElem<32>)
+    ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonInternedLongElem<256>)
+    ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonInternedLongElem<1024>)
+    ->Args({0, 16384});
 // test with a tiny frame size, to highlight continuation costs
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonInternedElem)
     ->Args({0, 1});
@@ -426,6 +453,64 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 
 }  // namespace hpack_encoder_fixtures
 
+////////////////////////////////////////////////////////////////////////////////
+// Binary (-bin) metadata values
+//
+
+static grpc_slice MakeBinaryValue(size_t length) {
+  grpc_slice value = GRPC_SLICE_MALLOC(length);
+  uint8_t* p = GRPC_SLICE_START_PTR(value);
+  for (size_t i = 0; i < length; i++) {
+    p[i] = static_cast<uint8_t>(i * 131 + 7);
+  }
+  return value;
+}
+
+static void BM_Base64Encode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice value = MakeBinaryValue(state.range(0));
+  for (auto _ : state) {
+    grpc_slice_unref_internal(grpc_chttp2_base64_encode(value));
+  }
+  grpc_slice_unref_internal(value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Encode)->RangeMultiplier(4)->Range(64, 8192);
+
+static void BM_Base64EncodeAndHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice value = MakeBinaryValue(state.range(0));
+  for (auto _ : state) {
+    grpc_slice_unref_internal(
+        grpc_chttp2_base64_encode_and_huffman_compress(value));
+  }
+  grpc_slice_unref_internal(value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64EncodeAndHuffmanCompress)
+    ->RangeMultiplier(4)
+    ->Range(64, 8192);
+
+static void BM_Base64Decode(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice value = MakeBinaryValue(state.range(0));
+  grpc_slice encoded = grpc_chttp2_base64_encode(value);
+  for (auto _ : state) {
+    grpc_slice_unref_internal(
+        grpc_chttp2_base64_decode_with_length(encoded, state.range(0)));
+  }
+  grpc_slice_unref_internal(encoded);
+  grpc_slice_unref_internal(value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Base64Decode)->RangeMultiplier(4)->Range(64, 8192);
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK parser
 //
@@ -649,6 +734,41 @@ class NonIndexedBinaryElem<100, false> {
   }
 };
 
+// A non indexed header with a huffman encoded value of kLength characters,
+// like the bearer tokens of authorization headers
+template <int kLength>
+class NonIndexedHuffmanElem {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string value = "Bearer ";
+    for (int i = 0; i < kLength; i++) {
+      value.push_back(alphabet[(i * 37 + i / 64) % 64]);
+    }
+    grpc_slice huffman = grpc_chttp2_huffman_compress(
+        grpc_slice_from_static_buffer(value.data(), value.size()));
+    std::vector<uint8_t> v = {0x00, 0x0d, 'a', 'u', 't', 'h', 'o', 'r',
+                              'i',  'z',  'a', 't', 'i', 'o', 'n'};
+    // value length with a 7 bit prefix, and huffman flag
+    size_t length = GRPC_SLICE_LENGTH(huffman);
+    if (length < 0x7f) {
+      v.push_back(static_cast<uint8_t>(0x80 | length));
+    } else {
+      v.push_back(0xff);
+      for (length -= 0x7f; length >= 0x80; length >>= 7) {
+        v.push_back(static_cast<uint8_t>(0x80 | (length & 0x7f)));
+      }
+      v.push_back(static_cast<uint8_t>(length));
+    }
+    v.insert(v.end(), GRPC_SLICE_START_PTR(huffman),
+             GRPC_SLICE_END_PTR(huffman));
+    grpc_slice_unref(huffman);
+    return {MakeSlice(v)};
+  }
+};
+
 class RepresentativeClientInitialMetadata {
  public:
   static std::vector<grpc_slice> GetInitSlices() {
@@ -912,6 +1032,12 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<31, true>,
                    UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<100, true>,
                    UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<32>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<256>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<1024>,
+                   UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeClientInitialMetadata, UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
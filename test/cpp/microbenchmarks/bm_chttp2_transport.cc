@@ -27,8 +27,10 @@
 #include <memory>
 #include <queue>
 #include <sstream>
+#include <vector>
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/resource_quota.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -676,6 +678,84 @@ static void BM_TransportStreamRecv(benchmark::State& state) {
 }
 BENCHMARK(BM_TransportStreamRecv)->Range(0, 128 * 1024 * 1024);
 
+// Parses a read of state.range(0) small frames back to back. They're of an
+// unknown type so that the cost is in the deframing rather than in the
+// frame parsers.
+static void BM_TransportParseSmallFrames(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  Fixture f(grpc::ChannelArguments(), true);
+  grpc_chttp2_transport* t = f.chttp2_transport();
+  t->is_first_frame = false;
+  const size_t num_frames = static_cast<size_t>(state.range(0));
+  const size_t frame_size = GRPC_CHTTP2_FRAME_HEADER_SIZE + 8;
+  grpc_slice read = GRPC_SLICE_MALLOC(num_frames * frame_size);
+  uint8_t* p = GRPC_SLICE_START_PTR(read);
+  for (size_t i = 0; i < num_frames; i++) {
+    const uint8_t frame[] = {0, 0, 8, 0xff, 0, 0, 0, 0, 0};
+    memcpy(p, frame, sizeof(frame));
+    memset(p + sizeof(frame), 0, frame_size - sizeof(frame));
+    p += frame_size;
+  }
+  while (state.KeepRunning()) {
+    GPR_ASSERT(grpc_chttp2_perform_read(t, read) == GRPC_ERROR_NONE);
+  }
+  state.SetBytesProcessed(state.iterations() * GRPC_SLICE_LENGTH(read));
+  grpc_slice_unref(read);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TransportParseSmallFrames)->Range(1, 1024);
+
+// Lookups among state.range(0) live streams, interleaved with as many closed
+// ones
+static void BM_StreamMapFind(benchmark::State& state) {
+  TrackCounters track_counters;
+  const uint32_t num_streams = static_cast<uint32_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  std::vector<uint32_t> ids;
+  uint32_t id = 1;
+  for (uint32_t i = 0; i < 2 * num_streams; i++, id += 2) {
+    grpc_chttp2_stream_map_add(&map, id, &map);
+    // Every other stream completed
+    if (i % 2 == 1) {
+      grpc_chttp2_stream_map_delete(&map, id - 2);
+      ids.push_back(id);
+    }
+  }
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    GPR_ASSERT(grpc_chttp2_stream_map_find(&map, ids[i]) != nullptr);
+    if (++i == ids.size()) i = 0;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapFind)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Opens a stream and closes the oldest one, keeping state.range(0) streams
+// alive
+static void BM_StreamMapAddDelete(benchmark::State& state) {
+  TrackCounters track_counters;
+  const uint32_t num_streams = static_cast<uint32_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  uint32_t next_id = 1;
+  for (uint32_t i = 0; i < num_streams; i++, next_id += 2) {
+    grpc_chttp2_stream_map_add(&map, next_id, &map);
+  }
+  uint32_t oldest_id = 1;
+  while (state.KeepRunning()) {
+    grpc_chttp2_stream_map_add(&map, next_id, &map);
+    next_id += 2;
+    grpc_chttp2_stream_map_delete(&map, oldest_id);
+    oldest_id += 2;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapAddDelete)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,382 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the client channel's pick path, with many threads sharing one
+   channel */
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/client_channel_factory.h"
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/resolver/fake/fake_resolver.h"
+#include "src/core/ext/filters/client_channel/server_address.h"
+#include "src/core/ext/filters/client_channel/service_config.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/surface/channel.h"
+#include "src/core/lib/transport/transport_impl.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// The method the calls are made to, which the service config has a method
+// config for.
+static const char* kMethod = "/grpc.testing.EchoTestService/Echo";
+
+// How many addresses the resolver returns.
+static const int kNumBackends = 8;
+
+namespace phony_transport {
+
+// A transport that is connected as soon as it is created and that never
+// sends anything, so that a call on it costs little more than its pick.
+// Receives fail; sends succeed.
+struct PhonyTransport {
+  grpc_transport base;  // Must be first.
+  grpc_core::OrphanablePtr<grpc_core::ConnectivityStateWatcherInterface>
+      watcher;
+};
+
+int InitStream(grpc_transport* /*self*/, grpc_stream* /*stream*/,
+               grpc_stream_refcount* /*refcount*/, const void* /*server_data*/,
+               grpc_core::Arena* /*arena*/) {
+  return 0;
+}
+
+void SetPollset(grpc_transport* /*self*/, grpc_stream* /*stream*/,
+                grpc_pollset* /*pollset*/) {}
+
+void SetPollsetSet(grpc_transport* /*self*/, grpc_stream* /*stream*/,
+                   grpc_pollset_set* /*pollset_set*/) {}
+
+void PerformStreamOp(grpc_transport* /*self*/, grpc_stream* /*stream*/,
+                     grpc_transport_stream_op_batch* op) {
+  grpc_transport_stream_op_batch_payload* payload = op->payload;
+  grpc_error* error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("phony transport");
+  if (op->cancel_stream) {
+    GRPC_ERROR_UNREF(payload->cancel_stream.cancel_error);
+  }
+  if (op->send_message) {
+    payload->send_message.send_message.reset();
+  }
+  if (op->recv_initial_metadata) {
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION,
+        payload->recv_initial_metadata.recv_initial_metadata_ready,
+        GRPC_ERROR_REF(error));
+  }
+  if (op->recv_message) {
+    payload->recv_message.recv_message->reset();
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION,
+                            payload->recv_message.recv_message_ready,
+                            GRPC_ERROR_REF(error));
+  }
+  if (op->recv_trailing_metadata) {
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION,
+        payload->recv_trailing_metadata.recv_trailing_metadata_ready,
+        GRPC_ERROR_REF(error));
+  }
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, op->on_complete, GRPC_ERROR_NONE);
+  GRPC_ERROR_UNREF(error);
+}
+
+void PerformOp(grpc_transport* self, grpc_transport_op* op) {
+  PhonyTransport* t = reinterpret_cast<PhonyTransport*>(self);
+  // The connection never changes state, so the watcher is only kept until
+  // it is stopped or the transport is destroyed.
+  if (op->start_connectivity_watch != nullptr) {
+    t->watcher = std::move(op->start_connectivity_watch);
+  }
+  if (op->stop_connectivity_watch != nullptr &&
+      op->stop_connectivity_watch == t->watcher.get()) {
+    t->watcher.reset();
+  }
+  GRPC_ERROR_UNREF(op->disconnect_with_error);
+  GRPC_ERROR_UNREF(op->goaway_error);
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, op->on_consumed, GRPC_ERROR_NONE);
+}
+
+void DestroyStream(grpc_transport* /*self*/, grpc_stream* /*stream*/,
+                   grpc_closure* then_schedule_closure) {
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, then_schedule_closure,
+                          GRPC_ERROR_NONE);
+}
+
+void Destroy(grpc_transport* self) {
+  delete reinterpret_cast<PhonyTransport*>(self);
+}
+
+grpc_endpoint* GetEndpoint(grpc_transport* /*self*/) { return nullptr; }
+
+// Not named like an HTTP transport, so that the subchannel's stack is only
+// the connected channel filter.
+const grpc_transport_vtable phony_transport_vtable = {
+    0,          "phony",       InitStream,
+    SetPollset, SetPollsetSet, PerformStreamOp,
+    PerformOp,  DestroyStream, Destroy,
+    GetEndpoint};
+
+grpc_transport* Create() {
+  PhonyTransport* t = new PhonyTransport();
+  t->base.vtable = &phony_transport_vtable;
+  return &t->base;
+}
+
+}  // namespace phony_transport
+
+// Connects subchannels to phony transports right away.
+class PhonyConnector : public grpc_core::SubchannelConnector {
+ public:
+  void Connect(const Args& args, Result* result,
+               grpc_closure* notify) override {
+    result->transport = phony_transport::Create();
+    result->channel_args = grpc_channel_args_copy(args.channel_args);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, notify, GRPC_ERROR_NONE);
+  }
+
+  void Shutdown(grpc_error* error) override { GRPC_ERROR_UNREF(error); }
+};
+
+class PhonyClientChannelFactory : public grpc_core::ClientChannelFactory {
+ public:
+  grpc_core::Subchannel* CreateSubchannel(
+      const grpc_channel_args* args) override {
+    return grpc_core::Subchannel::Create(
+        grpc_core::MakeOrphanable<PhonyConnector>(), args);
+  }
+};
+
+// A client channel with a fake resolver, whose subchannels connect to phony
+// transports.
+class PickChannel {
+ public:
+  // Resolves to kNumBackends addresses balanced by lb_policy, and waits for
+  // the channel to be READY. If lb_policy is null, the channel never
+  // resolves, and stays CONNECTING with every pick queued.
+  explicit PickChannel(const char* lb_policy)
+      : response_generator_(
+            grpc_core::MakeRefCounted<
+                grpc_core::FakeResolverResponseGenerator>()) {
+    {
+      grpc_core::ExecCtx exec_ctx;
+      grpc_arg args[] = {
+          grpc_channel_arg_string_create(
+              const_cast<char*>(GRPC_ARG_SERVER_URI),
+              const_cast<char*>("fake:///pick")),
+          grpc_core::ClientChannelFactory::CreateChannelArg(&factory_),
+          grpc_core::FakeResolverResponseGenerator::MakeChannelArg(
+              response_generator_.get()),
+          grpc_channel_arg_integer_create(
+              const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1),
+      };
+      grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+      channel_ = grpc_channel_create("fake:///pick", &channel_args,
+                                     GRPC_CLIENT_CHANNEL, nullptr);
+      if (lb_policy != nullptr) {
+        response_generator_->SetResponse(BuildResult(lb_policy));
+      }
+    }
+    WaitForState(lb_policy != nullptr ? GRPC_CHANNEL_READY
+                                      : GRPC_CHANNEL_CONNECTING);
+  }
+
+  ~PickChannel() { grpc_channel_destroy(channel_); }
+
+  grpc_channel* channel() const { return channel_; }
+
+ private:
+  static grpc_core::Resolver::Result BuildResult(const char* lb_policy) {
+    grpc_core::Resolver::Result result;
+    for (int i = 0; i < kNumBackends; i++) {
+      grpc_resolved_address address;
+      grpc_string_to_sockaddr(&address, const_cast<char*>("127.0.0.1"),
+                              1000 + i);
+      result.addresses.emplace_back(address, nullptr);
+    }
+    char* json;
+    gpr_asprintf(&json,
+                 "{\"loadBalancingConfig\":[{\"%s\":{}}],"
+                 "\"methodConfig\":[{\"name\":[{"
+                 "\"service\":\"grpc.testing.EchoTestService\","
+                 "\"method\":\"Echo\"}],\"waitForReady\":true}]}",
+                 lb_policy);
+    result.service_config = grpc_core::ServiceConfig::Create(
+        json, &result.service_config_error);
+    GPR_ASSERT(result.service_config != nullptr);
+    gpr_free(json);
+    return result;
+  }
+
+  void WaitForState(grpc_connectivity_state target) {
+    grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+    grpc_connectivity_state state;
+    while ((state = grpc_channel_check_connectivity_state(channel_, 1)) !=
+           target) {
+      grpc_channel_watch_connectivity_state(
+          channel_, state, grpc_timeout_seconds_to_deadline(10), cq, nullptr);
+      GPR_ASSERT(grpc_completion_queue_next(
+                     cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr)
+                     .success);
+    }
+    grpc_completion_queue_shutdown(cq);
+    while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq);
+  }
+
+  PhonyClientChannelFactory factory_;
+  grpc_core::RefCountedPtr<grpc_core::FakeResolverResponseGenerator>
+      response_generator_;
+  grpc_channel* channel_;
+};
+
+// What the picks of all the threads cost, per pick. Only kept by thread 0,
+// which starts it before the threads start picking and finishes it after
+// they all stop.
+class PickCounters {
+ public:
+  PickCounters() { grpc_stats_collect(&stats_begin_); }
+
+  void Finish(benchmark::State& state) {
+    const double picks = static_cast<double>(state.iterations()) *
+                         static_cast<double>(state.threads);
+    (void)picks;
+#ifdef GRPC_COLLECT_STATS
+    grpc_stats_data stats_end;
+    grpc_stats_collect(&stats_end);
+    grpc_stats_data stats;
+    grpc_stats_diff(&stats_end, &stats_begin_, &stats);
+    state.counters["pick_p50_us"] = grpc_stats_histo_percentile(
+        &stats, GRPC_STATS_HISTOGRAM_PICK_LATENCY_US, 50.0);
+    state.counters["pick_p99_us"] = grpc_stats_histo_percentile(
+        &stats, GRPC_STATS_HISTOGRAM_PICK_LATENCY_US, 99.0);
+#endif
+#ifdef GPR_LOW_LEVEL_COUNTERS
+    state.counters["locks_per_pick"] =
+        static_cast<double>(gpr_atm_no_barrier_load(&gpr_mu_locks) -
+                            mu_locks_at_start_) /
+        picks;
+    state.counters["allocs_per_pick"] =
+        static_cast<double>(
+            grpc_memory_counters_snapshot().total_allocs_absolute -
+            allocs_at_start_) /
+        picks;
+#endif
+  }
+
+ private:
+  grpc_stats_data stats_begin_;
+#ifdef GPR_LOW_LEVEL_COUNTERS
+  const gpr_atm mu_locks_at_start_ = gpr_atm_no_barrier_load(&gpr_mu_locks);
+  const size_t allocs_at_start_ =
+      grpc_memory_counters_snapshot().total_allocs_absolute;
+#endif
+};
+
+// Every thread starts calls on the shared channel, one at a time, and
+// waits for their send_initial_metadata batch, which needs the pick. The
+// call is created and destroyed in the loop too, and its batch reaches the
+// phony transport once picked. If lb_policy is null, the pick is queued and
+// the call is cancelled, which takes it back out of the queue.
+static void RunPicks(benchmark::State& state, const char* lb_policy) {
+  static PickChannel* channel = nullptr;
+  static PickCounters* counters = nullptr;
+  if (state.thread_index == 0) {
+    channel = new PickChannel(lb_policy);
+    counters = new PickCounters();
+  }
+  const bool queued = lb_policy == nullptr;
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_slice method = grpc_slice_from_static_string(kMethod);
+  grpc_op op;
+  memset(&op, 0, sizeof(op));
+  op.op = GRPC_OP_SEND_INITIAL_METADATA;
+  void* tag = reinterpret_cast<void*>(1);
+  for (auto _ : state) {
+    grpc_call* call = grpc_channel_create_call(
+        channel->channel(), nullptr, GRPC_PROPAGATE_DEFAULTS, cq, method,
+        nullptr, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call, &op, 1, tag,
+                                                     nullptr));
+    if (queued) grpc_call_cancel(call, nullptr);
+    grpc_event ev = grpc_completion_queue_next(
+        cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    GPR_ASSERT(ev.success == !queued);
+    grpc_call_unref(call);
+  }
+  state.SetItemsProcessed(state.iterations());
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+  if (state.thread_index == 0) {
+    counters->Finish(state);
+    delete counters;
+    delete channel;
+  }
+}
+
+static void BM_PickFirstPick(benchmark::State& state) {
+  RunPicks(state, "pick_first");
+}
+BENCHMARK(BM_PickFirstPick)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_RoundRobinPick(benchmark::State& state) {
+  RunPicks(state, "round_robin");
+}
+BENCHMARK(BM_RoundRobinPick)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_QueuedPick(benchmark::State& state) {
+  RunPicks(state, nullptr);
+}
+BENCHMARK(BM_QueuedPick)->ThreadRange(1, 64)->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -23,6 +23,7 @@
 #include <sstream>
 
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -346,6 +347,23 @@ static void BM_ClosureSched4OnTwoCombiners(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureSched4OnTwoCombiners);
 
+// An uncontended call combiner, as seen by most steps of a unary call.
+static void BM_ClosureSchedOnCallCombiner(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::CallCombiner call_combiner;
+  grpc_closure c;
+  GRPC_CLOSURE_INIT(&c, DoNothing, nullptr, grpc_schedule_on_exec_ctx);
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    GRPC_CALL_COMBINER_START(&call_combiner, &c, GRPC_ERROR_NONE, "bm");
+    grpc_core::ExecCtx::Get()->Flush();
+    GRPC_CALL_COMBINER_STOP(&call_combiner, "bm");
+  }
+
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ClosureSchedOnCallCombiner);
+
 // Helper that continuously reschedules the same closure against something until
 // the benchmark is complete
 class Rescheduler {
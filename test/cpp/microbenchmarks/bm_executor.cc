@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the executor under skewed load */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+class BlockingCounter {
+ public:
+  BlockingCounter(int count) : count_(count) {}
+  void DecrementCount() {
+    std::lock_guard<std::mutex> l(mu_);
+    count_--;
+    if (count_ == 0) cv_.notify_all();
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> l(mu_);
+    while (count_ > 0) {
+      cv_.wait(l);
+    }
+  }
+
+ private:
+  int count_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+};
+
+struct Work {
+  grpc_closure closure;
+  int spins;
+  BlockingCounter* counter;
+};
+
+static void DoWork(void* arg, grpc_error* /*error*/) {
+  Work* work = static_cast<Work*>(arg);
+  volatile int val = 0;
+  for (int i = 0; i < work->spins; i++) {
+    val = val + 1;
+  }
+  work->counter->DecrementCount();
+}
+
+// All the closures are enqueued by the benchmark thread, and every 16th one
+// does 100 times as much work as the others. The first argument selects the
+// work stealing executor, the second is the number of closures per batch.
+static void BM_ExecutorSkewedLoad(benchmark::State& state) {
+  const bool work_stealing = state.range(0) != 0;
+  const int batch_size = state.range(1);
+  const int kShortSpins = 1000;
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::Executor executor("bm_executor", work_stealing);
+  executor.Init();
+  std::vector<Work> work(batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    GRPC_CLOSURE_INIT(&work[i].closure, DoWork, &work[i],
+                      grpc_schedule_on_exec_ctx);
+    work[i].spins = i % 16 == 0 ? 100 * kShortSpins : kShortSpins;
+  }
+  while (state.KeepRunningBatch(batch_size)) {
+    BlockingCounter counter(batch_size);
+    for (auto& w : work) {
+      w.counter = &counter;
+      executor.Enqueue(&w.closure, GRPC_ERROR_NONE, true /* is_short */);
+    }
+    counter.Wait();
+  }
+  executor.Shutdown();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ExecutorSkewedLoad)
+    ->Args({0, 16})
+    ->Args({1, 16})
+    ->Args({0, 256})
+    ->Args({1, 256})
+    ->Args({0, 4096})
+    ->Args({1, 4096})
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char* argv[]) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
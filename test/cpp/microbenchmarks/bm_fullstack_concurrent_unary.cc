@@ -0,0 +1,200 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark many small concurrent unary calls sharing one connection */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "src/core/lib/profiling/timers.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+// Copies runs of slices shorter than 256 bytes into a single iovec
+class TxCoalesceConfiguration : public FixtureConfiguration {
+ public:
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetInt(GRPC_ARG_TCP_TX_COALESCE_BYTES_THRESHOLD, 256);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_TCP_TX_COALESCE_BYTES_THRESHOLD, 256);
+  }
+};
+
+class TxCoalesceTCP : public TCP {
+ public:
+  TxCoalesceTCP(Service* service) : TCP(service, TxCoalesceConfiguration()) {}
+};
+
+// Holds small writes on busy connections back for up to a millisecond
+class WriteCoalesceConfiguration : public FixtureConfiguration {
+ public:
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetInt(GRPC_ARG_HTTP2_WRITE_COALESCE_DELAY_MS, 1);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WRITE_COALESCE_DELAY_MS, 1);
+  }
+};
+
+class WriteCoalesceTCP : public TCP {
+ public:
+  WriteCoalesceTCP(Service* service)
+      : TCP(service, WriteCoalesceConfiguration()) {}
+};
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+enum TagKind { kServerRequested = 0, kServerFinished, kClientFinished };
+
+static void* tag(size_t slot, TagKind kind) {
+  return reinterpret_cast<void*>(static_cast<intptr_t>(slot << 2 | kind));
+}
+
+// Starts state.range(0) unary calls with state.range(1) byte messages at
+// once, and waits for all of them before starting the next round.
+template <class Fixture>
+static void BM_ConcurrentUnary(benchmark::State& state) {
+  const size_t num_calls = state.range(0);
+  EchoTestService::AsyncService service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  EchoRequest send_request;
+  EchoResponse send_response;
+  if (state.range(1) > 0) {
+    send_request.set_message(std::string(state.range(1), 'a'));
+    send_response.set_message(std::string(state.range(1), 'a'));
+  }
+  struct ServerEnv {
+    ServerContext ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer;
+    ServerEnv() : response_writer(&ctx) {}
+  };
+  struct ClientEnv {
+    ClientContext ctx;
+    EchoResponse recv_response;
+    Status recv_status;
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader;
+  };
+  std::vector<std::unique_ptr<ServerEnv>> server_env(num_calls);
+  for (size_t i = 0; i < num_calls; i++) {
+    server_env[i].reset(new ServerEnv);
+    service.RequestEcho(&server_env[i]->ctx, &server_env[i]->recv_request,
+                        &server_env[i]->response_writer, fixture->cq(),
+                        fixture->cq(), tag(i, kServerRequested));
+  }
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  std::vector<std::unique_ptr<ClientEnv>> client_env(num_calls);
+  while (state.KeepRunningBatch(num_calls)) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    for (size_t i = 0; i < num_calls; i++) {
+      client_env[i].reset(new ClientEnv);
+      client_env[i]->response_reader =
+          stub->AsyncEcho(&client_env[i]->ctx, send_request, fixture->cq());
+      client_env[i]->response_reader->Finish(&client_env[i]->recv_response,
+                                             &client_env[i]->recv_status,
+                                             tag(i, kClientFinished));
+    }
+    size_t pending = 2 * num_calls;
+    while (pending > 0) {
+      void* t;
+      bool ok;
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      GPR_ASSERT(ok);
+      const intptr_t n = reinterpret_cast<intptr_t>(t);
+      const size_t slot = n >> 2;
+      switch (n & 3) {
+        case kServerRequested:
+          server_env[slot]->response_writer.Finish(send_response, Status::OK,
+                                                   tag(slot, kServerFinished));
+          break;
+        case kServerFinished:
+          // Any request slot may pick up the next round's calls
+          server_env[slot].reset(new ServerEnv);
+          service.RequestEcho(&server_env[slot]->ctx,
+                              &server_env[slot]->recv_request,
+                              &server_env[slot]->response_writer,
+                              fixture->cq(), fixture->cq(),
+                              tag(slot, kServerRequested));
+          pending--;
+          break;
+        case kClientFinished:
+          GPR_ASSERT(client_env[slot]->recv_status.ok());
+          pending--;
+          break;
+      }
+    }
+  }
+  fixture->Finish(state);
+  fixture.reset();
+  client_env.clear();
+  server_env.clear();
+  state.SetBytesProcessed(2 * state.range(1) * state.iterations());
+}
+
+static void SweepArgs(benchmark::internal::Benchmark* b) {
+  for (int calls = 1; calls <= 256; calls *= 4) {
+    for (int size : {0, 10, 100}) {
+      b->Args({calls, size});
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_ConcurrentUnary, TCP)->Apply(SweepArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentUnary, TxCoalesceTCP)
+    ->Apply(SweepArgs)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentUnary, WriteCoalesceTCP)
+    ->Apply(SweepArgs)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
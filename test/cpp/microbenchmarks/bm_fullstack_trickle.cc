@@ -21,12 +21,15 @@
 #include <benchmark/benchmark.h>
 #include <gflags/gflags.h>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/lib/iomgr/timer_manager.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/histogram.h"
 #include "test/core/util/trickle_endpoint.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
 #include "test/cpp/microbenchmarks/fullstack_fixtures.h"
@@ -76,18 +79,37 @@ static void write_csv(std::ostream* out, A0&& a0, Arg&&... arg) {
   write_csv(out, std::forward<Arg>(arg)...);
 }
 
+// Sizes flow control windows from the BBR style bandwidth and RTT model
+class BbrAutotuningConfiguration : public FixtureConfiguration {
+ public:
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetInt(GRPC_ARG_HTTP2_BBR_AUTOTUNING, 1);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_HTTP2_BBR_AUTOTUNING, 1);
+  }
+};
+
 class TrickledCHTTP2 : public EndpointPairFixture {
  public:
   TrickledCHTTP2(Service* service, bool streaming, size_t req_size,
                  size_t resp_size, size_t kilobits_per_second,
-                 grpc_passthru_endpoint_stats* stats)
-      : EndpointPairFixture(service, MakeEndpoints(kilobits_per_second, stats),
-                            FixtureConfiguration()),
+                 grpc_passthru_endpoint_stats* stats, int rtt_ms = 0,
+                 bool bbr_autotuning = false)
+      : EndpointPairFixture(
+            service, MakeEndpoints(kilobits_per_second, rtt_ms, stats),
+            Configuration(bbr_autotuning)),
         stats_(stats) {
     if (FLAGS_log) {
       std::ostringstream fn;
       fn << "trickle." << (streaming ? "streaming" : "unary") << "." << req_size
-         << "." << resp_size << "." << kilobits_per_second << ".csv";
+         << "." << resp_size << "." << kilobits_per_second;
+      if (rtt_ms != 0) fn << "." << rtt_ms << "ms";
+      if (bbr_autotuning) fn << ".bbr";
+      fn << ".csv";
       log_.reset(new std::ofstream(fn.str().c_str()));
       write_csv(log_.get(), "t", "iteration", "client_backlog",
                 "server_backlog", "client_t_stall", "client_s_stall",
@@ -125,6 +147,9 @@ class TrickledCHTTP2 : public EndpointPairFixture {
             (double)state.iterations())
         << " svr_stream_stalls/iter:"
         << ((double)server_stats_.streams_stalled_due_to_stream_flow_control /
+            (double)state.iterations())
+        << " simulated_us/iter:"
+        << ((double)(gpr_atm_no_barrier_load(&g_now_us) - measure_start_us_) /
             (double)state.iterations());
   }
 
@@ -136,11 +161,13 @@ class TrickledCHTTP2 : public EndpointPairFixture {
         reinterpret_cast<grpc_chttp2_transport*>(server_transport_);
     grpc_chttp2_stream* client_stream =
         client->stream_map.count == 1
-            ? static_cast<grpc_chttp2_stream*>(client->stream_map.values[0])
+            ? static_cast<grpc_chttp2_stream*>(
+                  grpc_chttp2_stream_map_rand(&client->stream_map))
             : nullptr;
     grpc_chttp2_stream* server_stream =
         server->stream_map.count == 1
-            ? static_cast<grpc_chttp2_stream*>(server->stream_map.values[0])
+            ? static_cast<grpc_chttp2_stream*>(
+                  grpc_chttp2_stream_map_rand(&server->stream_map))
             : nullptr;
     write_csv(
         log_.get(),
@@ -193,6 +220,9 @@ class TrickledCHTTP2 : public EndpointPairFixture {
         grpc_trickle_endpoint_trickle(endpoint_pair_.server);
 
     if (update_stats) {
+      if (measure_start_us_ < 0) {
+        measure_start_us_ = gpr_atm_no_barrier_load(&g_now_us);
+      }
       UpdateStats((grpc_chttp2_transport*)client_transport_, &client_stats_,
                   client_backlog);
       UpdateStats((grpc_chttp2_transport*)server_transport_, &server_stats_,
@@ -210,15 +240,26 @@ class TrickledCHTTP2 : public EndpointPairFixture {
   Stats server_stats_;
   std::unique_ptr<std::ofstream> log_;
   gpr_timespec start_ = gpr_now(GPR_CLOCK_MONOTONIC);
+  // Simulated time of the first step after warmup
+  gpr_atm measure_start_us_ = -1;
+
+  static const FixtureConfiguration& Configuration(bool bbr_autotuning) {
+    static FixtureConfiguration default_configuration;
+    static BbrAutotuningConfiguration bbr_autotuning_configuration;
+    if (bbr_autotuning) return bbr_autotuning_configuration;
+    return default_configuration;
+  }
 
-  static grpc_endpoint_pair MakeEndpoints(size_t kilobits,
+  static grpc_endpoint_pair MakeEndpoints(size_t kilobits, int rtt_ms,
                                           grpc_passthru_endpoint_stats* stats) {
     grpc_endpoint_pair p;
     grpc_passthru_endpoint_create(&p.client, &p.server,
                                   LibraryInitializer::get().rq(), stats);
     double bytes_per_second = 125.0 * kilobits;
-    p.client = grpc_trickle_endpoint_create(p.client, bytes_per_second);
-    p.server = grpc_trickle_endpoint_create(p.server, bytes_per_second);
+    p.client = grpc_trickle_endpoint_create_with_latency(
+        p.client, bytes_per_second, rtt_ms / 2);
+    p.server = grpc_trickle_endpoint_create_with_latency(
+        p.server, bytes_per_second, rtt_ms / 2);
     return p;
   }
 
@@ -253,12 +294,13 @@ static void TrickleCQNext(TrickledCHTTP2* fixture, void** t, bool* ok,
   }
 }
 
-static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
+static void PumpStreamServerToClient(benchmark::State& state, int rtt_ms,
+                                     bool bbr_autotuning) {
   EchoTestService::AsyncService service;
   std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
       &service, true, state.range(0) /* req_size */,
       state.range(0) /* resp_size */, state.range(1) /* bw in kbit/s */,
-      grpc_passthru_endpoint_stats_create()));
+      grpc_passthru_endpoint_stats_create(), rtt_ms, bbr_autotuning));
   {
     EchoResponse send_response;
     EchoResponse recv_response;
@@ -335,6 +377,10 @@ static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
   state.SetBytesProcessed(state.range(0) * state.iterations());
 }
 
+static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
+  PumpStreamServerToClient(state, 0, false);
+}
+
 static void StreamingTrickleArgs(benchmark::internal::Benchmark* b) {
   for (int i = 1; i <= 128 * 1024 * 1024; i *= 8) {
     for (int j = 64; j <= 128 * 1024 * 1024; j *= 8) {
@@ -347,6 +393,25 @@ static void StreamingTrickleArgs(benchmark::internal::Benchmark* b) {
 }
 BENCHMARK(BM_PumpStreamServerToClient_Trickle)->Apply(StreamingTrickleArgs);
 
+// Cross region links: compare how fast the flow control windows of the PID
+// (0) and BBR style (1) autotuning let one stream fill a high
+// bandwidth-delay product path
+static void BM_PumpStreamServerToClient_HighBdpTrickle(
+    benchmark::State& state) {
+  PumpStreamServerToClient(state, state.range(2) /* rtt in ms */,
+                           state.range(3) != 0 /* bbr autotuning */);
+}
+
+static void HighBdpTrickleArgs(benchmark::internal::Benchmark* b) {
+  for (int bw : {1000 * 1000, 10 * 1000 * 1000}) {
+    for (int bbr = 0; bbr <= 1; bbr++) {
+      b->Args({1024 * 1024, bw, 80, bbr});
+    }
+  }
+}
+BENCHMARK(BM_PumpStreamServerToClient_HighBdpTrickle)
+    ->Apply(HighBdpTrickleArgs);
+
 static void BM_PumpUnbalancedUnary_Trickle(benchmark::State& state) {
   EchoTestService::AsyncService service;
   std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
@@ -450,6 +515,244 @@ static void UnaryTrickleArgs(benchmark::internal::Benchmark* b) {
   }
 }
 BENCHMARK(BM_PumpUnbalancedUnary_Trickle)->Apply(UnaryTrickleArgs);
+
+// Many streams competing for one connection's window: bulk bidi streams keep
+// pumping server to client while, one per iteration, a small unary call is
+// made behind them. Reports how evenly the bulk streams shared the link
+// (Jain's index over bytes received, 1 when perfectly even, and the smallest
+// share relative to the mean) and the small call latency in simulated time.
+struct FairnessBulkStream {
+  ServerContext svr_ctx;
+  ServerAsyncReaderWriter<EchoResponse, EchoRequest> response_rw{&svr_ctx};
+  ClientContext cli_ctx;
+  std::unique_ptr<ClientAsyncReaderWriter<EchoRequest, EchoResponse>>
+      request_rw;
+  EchoResponse send_response;
+  EchoResponse recv_response;
+  Status status;
+  bool writing = false;
+  int64_t bytes_received = 0;
+};
+
+enum FairnessTag {
+  kFairnessServerStarted,
+  kFairnessClientStarted,
+  kFairnessServerWrote,
+  kFairnessClientRead,
+  kFairnessServerFinished,
+  kFairnessClientFinished,
+  kFairnessSmallRequested,
+  kFairnessSmallServerFinished,
+  kFairnessSmallClientFinished,
+  kFairnessNumTags
+};
+
+static void* fairness_tag(FairnessTag kind, size_t stream) {
+  return tag(static_cast<intptr_t>(stream * kFairnessNumTags + kind));
+}
+
+static void BM_PumpConcurrentStreams_Trickle(benchmark::State& state) {
+  const size_t num_bulk = state.range(0);
+  EchoTestService::AsyncService service;
+  std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
+      &service, true, state.range(2) /* req_size */,
+      state.range(1) /* resp_size */, state.range(3) /* bw in kbit/s */,
+      grpc_passthru_endpoint_stats_create()));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  // Odd numbered streams write a sixteenth of what even ones do, so that
+  // streams with different message sizes compete too.
+  std::vector<std::unique_ptr<FairnessBulkStream>> bulk;
+  for (size_t i = 0; i < num_bulk; i++) {
+    bulk.emplace_back(new FairnessBulkStream);
+    FairnessBulkStream* s = bulk.back().get();
+    s->send_response.set_message(
+        std::string(i % 2 == 0 ? state.range(1) : state.range(1) / 16, 'a'));
+    service.RequestBidiStream(&s->svr_ctx, &s->response_rw, fixture->cq(),
+                              fixture->cq(),
+                              fairness_tag(kFairnessServerStarted, i));
+    s->request_rw =
+        stub->AsyncBidiStream(&s->cli_ctx, fixture->cq(),
+                              fairness_tag(kFairnessClientStarted, i));
+  }
+  void* t;
+  bool ok;
+  for (size_t need = 2 * num_bulk; need > 0; need--) {
+    TrickleCQNext(fixture.get(), &t, &ok, -1);
+    GPR_ASSERT(ok);
+  }
+  for (size_t i = 0; i < num_bulk; i++) {
+    FairnessBulkStream* s = bulk[i].get();
+    s->response_rw.Write(s->send_response,
+                         fairness_tag(kFairnessServerWrote, i));
+    s->writing = true;
+    s->request_rw->Read(&s->recv_response,
+                        fairness_tag(kFairnessClientRead, i));
+  }
+  bool measuring = false;
+  bool draining = false;
+  // Keeps the bulk streams going; returns false for the small call's events.
+  auto handle_bulk = [&](void* bulk_tag, bool bulk_ok) {
+    intptr_t n = reinterpret_cast<intptr_t>(bulk_tag);
+    FairnessTag kind = static_cast<FairnessTag>(n % kFairnessNumTags);
+    if (kind >= kFairnessSmallRequested) return false;
+    FairnessBulkStream* s = bulk[n / kFairnessNumTags].get();
+    if (kind == kFairnessServerWrote) {
+      GPR_ASSERT(bulk_ok);
+      s->writing = false;
+      if (!draining) {
+        s->response_rw.Write(s->send_response, bulk_tag);
+        s->writing = true;
+      }
+    } else if (kind == kFairnessClientRead && bulk_ok) {
+      if (measuring) s->bytes_received += s->recv_response.message().size();
+      s->request_rw->Read(&s->recv_response, bulk_tag);
+    }
+    return true;
+  };
+
+  EchoRequest send_request;
+  EchoResponse send_response;
+  EchoResponse recv_response;
+  if (state.range(2) > 0) {
+    send_request.set_message(std::string(state.range(2), 'a'));
+    send_response.set_message(std::string(state.range(2), 'a'));
+  }
+  Status recv_status;
+  struct ServerEnv {
+    ServerContext ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer;
+    ServerEnv() : response_writer(&ctx) {}
+  };
+  std::unique_ptr<ServerEnv> senv(new ServerEnv);
+  void* small_requested = fairness_tag(kFairnessSmallRequested, 0);
+  void* small_server_finished = fairness_tag(kFairnessSmallServerFinished, 0);
+  void* small_client_finished = fairness_tag(kFairnessSmallClientFinished, 0);
+  service.RequestEcho(&senv->ctx, &senv->recv_request, &senv->response_writer,
+                      fixture->cq(), fixture->cq(), small_requested);
+  grpc_histogram* small_latencies_us = grpc_histogram_create(0.01, 60e6);
+  auto inner_loop = [&](bool in_warmup) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    int64_t iteration = in_warmup ? -1 : state.iterations();
+    recv_response.Clear();
+    ClientContext cli_ctx;
+    gpr_atm start_us = gpr_atm_no_barrier_load(&g_now_us);
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        stub->AsyncEcho(&cli_ctx, send_request, fixture->cq()));
+    response_reader->Finish(&recv_response, &recv_status,
+                            small_client_finished);
+    bool server_done = false;
+    bool client_done = false;
+    while (!server_done || !client_done) {
+      TrickleCQNext(fixture.get(), &t, &ok, iteration);
+      if (handle_bulk(t, ok)) continue;
+      GPR_ASSERT(ok);
+      if (t == small_requested) {
+        senv->response_writer.Finish(send_response, Status::OK,
+                                     small_server_finished);
+      } else if (t == small_server_finished) {
+        server_done = true;
+      } else {
+        GPR_ASSERT(t == small_client_finished);
+        client_done = true;
+        if (!in_warmup) {
+          grpc_histogram_add(
+              small_latencies_us,
+              static_cast<double>(gpr_atm_no_barrier_load(&g_now_us) -
+                                  start_us));
+        }
+      }
+    }
+    GPR_ASSERT(recv_status.ok());
+    senv.reset(new ServerEnv);
+    service.RequestEcho(&senv->ctx, &senv->recv_request,
+                        &senv->response_writer, fixture->cq(), fixture->cq(),
+                        small_requested);
+  };
+  gpr_timespec warmup_start = gpr_now(GPR_CLOCK_MONOTONIC);
+  for (int i = 0; i < FLAGS_warmup_iterations; i++) {
+    inner_loop(true);
+    if (gpr_time_cmp(gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), warmup_start),
+                     gpr_time_from_seconds(FLAGS_warmup_max_time_seconds,
+                                           GPR_TIMESPAN)) > 0) {
+      break;
+    }
+  }
+  measuring = true;
+  while (state.KeepRunning()) {
+    inner_loop(false);
+  }
+  measuring = false;
+
+  // Let the writes in flight land, then finish every bulk stream.
+  draining = true;
+  auto writes_pending = [&]() {
+    for (auto& s : bulk) {
+      if (s->writing) return true;
+    }
+    return false;
+  };
+  while (writes_pending()) {
+    TrickleCQNext(fixture.get(), &t, &ok, -1);
+    GPR_ASSERT(handle_bulk(t, ok));
+  }
+  for (size_t i = 0; i < num_bulk; i++) {
+    FairnessBulkStream* s = bulk[i].get();
+    s->response_rw.Finish(Status::OK,
+                          fairness_tag(kFairnessServerFinished, i));
+    s->request_rw->Finish(&s->status,
+                          fairness_tag(kFairnessClientFinished, i));
+  }
+  for (size_t need = 2 * num_bulk; need > 0;) {
+    TrickleCQNext(fixture.get(), &t, &ok, -1);
+    GPR_ASSERT(handle_bulk(t, ok));
+    intptr_t kind = reinterpret_cast<intptr_t>(t) % kFairnessNumTags;
+    if (kind == kFairnessServerFinished || kind == kFairnessClientFinished) {
+      need--;
+    }
+  }
+
+  double sum = 0;
+  double sum_squares = 0;
+  double min_bytes = -1;
+  for (auto& s : bulk) {
+    double bytes = static_cast<double>(s->bytes_received);
+    sum += bytes;
+    sum_squares += bytes * bytes;
+    if (min_bytes < 0 || bytes < min_bytes) min_bytes = bytes;
+  }
+  if (sum_squares > 0) {
+    state.counters["fairness"] =
+        sum * sum / (static_cast<double>(num_bulk) * sum_squares);
+    state.counters["min_share"] =
+        min_bytes * static_cast<double>(num_bulk) / sum;
+  }
+  state.counters["small_p50_us"] =
+      grpc_histogram_percentile(small_latencies_us, 50);
+  state.counters["small_p99_us"] =
+      grpc_histogram_percentile(small_latencies_us, 99);
+  grpc_histogram_destroy(small_latencies_us);
+  fixture->Finish(state);
+  // Also cancels the small call still requested on the server.
+  fixture.reset();
+  senv.reset();
+  bulk.clear();
+  state.SetBytesProcessed(static_cast<int64_t>(sum));
+}
+
+static void ConcurrentStreamsTrickleArgs(benchmark::internal::Benchmark* b) {
+  for (int streams : {2, 8, 32}) {
+    for (int bulk_size : {16 * 1024, 1024 * 1024}) {
+      for (int bw : {10 * 1000, 100 * 1000}) {
+        b->Args({streams, bulk_size, 1, bw});
+        b->Args({streams, bulk_size, 1024, bw});
+      }
+    }
+  }
+}
+BENCHMARK(BM_PumpConcurrentStreams_Trickle)
+    ->Apply(ConcurrentStreamsTrickleArgs);
 }  // namespace testing
 }  // namespace grpc
 
@@ -466,6 +769,11 @@ int main(int argc, char** argv) {
   ::benchmark::Initialize(&argc, argv);
   ::grpc::testing::InitTest(&argc, &argv, false);
   grpc_timer_manager_set_threading(false);
+  // Start the fake clock where the real one is, or it would stay behind the
+  // time the ExecCtx clock starts at and timers would never fire
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  ::grpc::testing::g_now_us =
+      now.tv_sec * GPR_US_PER_SEC + now.tv_nsec / GPR_NS_PER_US;
   gpr_now_impl = ::grpc::testing::fake_now;
   benchmark::RunTheBenchmarksNamespaced();
 }
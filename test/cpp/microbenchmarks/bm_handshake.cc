@@ -0,0 +1,337 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark connection establishment: TCP connect, security handshake and
+   HTTP/2 setup, until the channel is READY */
+
+#include <stdint.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+extern "C" {
+#include <openssl/bio.h>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+}
+
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/security/credentials/fake/fake_credentials.h"
+#include "test/core/util/histogram.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/util/test_config.h"
+
+enum class Security { kInsecure, kFake, kLocal, kSslRsa, kSslEcdsa };
+
+// Name the server certificates are issued for.
+static const char* kServerName = "foo.test.google.fr";
+
+static std::string BioToString(BIO* bio) {
+  char* data = nullptr;
+  long length = BIO_get_mem_data(bio, &data);
+  return std::string(data, static_cast<size_t>(length));
+}
+
+// Generates a self-signed server certificate and its key, in PEM. The client
+// trusts the certificate itself, so that RSA and ECDSA are compared on equal
+// chains.
+static void GenerateKeyCertPair(bool ecdsa, std::string* key_pem,
+                                std::string* cert_pem) {
+  EVP_PKEY* key = EVP_PKEY_new();
+  if (ecdsa) {
+    EC_KEY* ec_key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+    EC_KEY_set_asn1_flag(ec_key, OPENSSL_EC_NAMED_CURVE);
+    GPR_ASSERT(EC_KEY_generate_key(ec_key));
+    GPR_ASSERT(EVP_PKEY_assign_EC_KEY(key, ec_key));
+  } else {
+    RSA* rsa = RSA_new();
+    BIGNUM* exponent = BN_new();
+    BN_set_word(exponent, RSA_F4);
+    GPR_ASSERT(RSA_generate_key_ex(rsa, 2048, exponent, nullptr));
+    BN_free(exponent);
+    GPR_ASSERT(EVP_PKEY_assign_RSA(key, rsa));
+  }
+  X509* cert = X509_new();
+  X509_set_version(cert, 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+  X509_gmtime_adj(X509_get_notBefore(cert), 0);
+  X509_gmtime_adj(X509_get_notAfter(cert), 24 * 3600);
+  X509_set_pubkey(cert, key);
+  X509_NAME* name = X509_get_subject_name(cert);
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                             reinterpret_cast<const unsigned char*>(
+                                 kServerName),
+                             -1, -1, 0);
+  X509_set_issuer_name(cert, name);
+  GPR_ASSERT(X509_sign(cert, key, EVP_sha256()));
+
+  BIO* bio = BIO_new(BIO_s_mem());
+  GPR_ASSERT(PEM_write_bio_PrivateKey(bio, key, nullptr, nullptr, 0, nullptr,
+                                      nullptr));
+  *key_pem = BioToString(bio);
+  BIO_free(bio);
+  bio = BIO_new(BIO_s_mem());
+  GPR_ASSERT(PEM_write_bio_X509(bio, cert));
+  *cert_pem = BioToString(bio);
+  BIO_free(bio);
+  X509_free(cert);
+  EVP_PKEY_free(key);
+}
+
+// A server that accepts connections and handshakes with the given security,
+// polled by its own thread.
+class HandshakeServer {
+ public:
+  explicit HandshakeServer(Security security) : security_(security) {
+    grpc_core::UniquePtr<char> address;
+    grpc_core::JoinHostPort(&address, "localhost",
+                            grpc_pick_unused_port_or_die());
+    address_ = address.get();
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_credentials* creds = nullptr;
+    switch (security) {
+      case Security::kInsecure:
+        break;
+      case Security::kFake:
+        creds = grpc_fake_transport_security_server_credentials_create();
+        break;
+      case Security::kLocal:
+        creds = grpc_local_server_credentials_create(LOCAL_TCP);
+        break;
+      case Security::kSslRsa:
+      case Security::kSslEcdsa: {
+        std::string key;
+        GenerateKeyCertPair(security == Security::kSslEcdsa, &key, &cert_);
+        grpc_ssl_pem_key_cert_pair pair = {key.c_str(), cert_.c_str()};
+        creds = grpc_ssl_server_credentials_create(nullptr, &pair, 1, 0,
+                                                   nullptr);
+        break;
+      }
+    }
+    if (creds == nullptr) {
+      GPR_ASSERT(
+          grpc_server_add_insecure_http2_port(server_, address_.c_str()));
+    } else {
+      GPR_ASSERT(grpc_server_add_secure_http2_port(server_, address_.c_str(),
+                                                   creds));
+      grpc_server_credentials_release(creds);
+    }
+    grpc_server_start(server_);
+    poller_ = std::thread([this] {
+      while (grpc_completion_queue_next(
+                 cq_, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr)
+                 .type != GRPC_QUEUE_SHUTDOWN) {
+      }
+    });
+  }
+
+  ~HandshakeServer() {
+    grpc_server_shutdown_and_notify(server_, cq_, nullptr);
+    grpc_server_cancel_all_calls(server_);
+    grpc_completion_queue_shutdown(cq_);
+    poller_.join();
+    grpc_server_destroy(server_);
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  // Creates a channel with a connection of its own to the server. The
+  // channel resumes the SSL sessions stored in session_cache, if not null.
+  grpc_channel* CreateChannel(grpc_ssl_session_cache* session_cache) {
+    std::vector<grpc_arg> args;
+    args.push_back(grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1));
+    grpc_channel_credentials* creds = nullptr;
+    switch (security_) {
+      case Security::kInsecure:
+        break;
+      case Security::kFake:
+        creds = grpc_fake_transport_security_credentials_create();
+        break;
+      case Security::kLocal:
+        creds = grpc_local_credentials_create(LOCAL_TCP);
+        break;
+      case Security::kSslRsa:
+      case Security::kSslEcdsa:
+        creds = grpc_ssl_credentials_create(cert_.c_str(), nullptr, nullptr,
+                                            nullptr);
+        args.push_back(grpc_channel_arg_string_create(
+            const_cast<char*>(GRPC_SSL_TARGET_NAME_OVERRIDE_ARG),
+            const_cast<char*>(kServerName)));
+        if (session_cache != nullptr) {
+          args.push_back(
+              grpc_ssl_session_cache_create_channel_arg(session_cache));
+        }
+        break;
+    }
+    grpc_channel_args channel_args = {args.size(), args.data()};
+    grpc_channel* channel;
+    if (creds == nullptr) {
+      channel = grpc_insecure_channel_create(address_.c_str(), &channel_args,
+                                             nullptr);
+    } else {
+      channel = grpc_secure_channel_create(creds, address_.c_str(),
+                                           &channel_args, nullptr);
+      grpc_channel_credentials_release(creds);
+    }
+    return channel;
+  }
+
+ private:
+  const Security security_;
+  std::string address_;
+  // The self-signed SSL server certificate, trusted by the clients.
+  std::string cert_;
+  grpc_completion_queue* cq_;
+  grpc_server* server_;
+  std::thread poller_;
+};
+
+static void WatchConnectivityState(grpc_channel* channel,
+                                   grpc_connectivity_state last_state,
+                                   grpc_completion_queue* cq, size_t index) {
+  grpc_channel_watch_connectivity_state(
+      channel, last_state, grpc_timeout_seconds_to_deadline(30), cq,
+      reinterpret_cast<void*>(static_cast<intptr_t>(index)));
+}
+
+// Connects the idle channels concurrently, and waits for all of them to be
+// READY. Adds the time each took to latencies_us, if not null.
+static void ConnectChannels(const std::vector<grpc_channel*>& channels,
+                            grpc_completion_queue* cq,
+                            grpc_histogram* latencies_us) {
+  std::vector<gpr_timespec> start_times(channels.size());
+  for (size_t i = 0; i < channels.size(); i++) {
+    start_times[i] = gpr_now(GPR_CLOCK_MONOTONIC);
+    GPR_ASSERT(grpc_channel_check_connectivity_state(channels[i], 1) ==
+               GRPC_CHANNEL_IDLE);
+    WatchConnectivityState(channels[i], GRPC_CHANNEL_IDLE, cq, i);
+  }
+  size_t connecting = channels.size();
+  while (connecting > 0) {
+    grpc_event ev = grpc_completion_queue_next(
+        cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    // The watch timed out: the channel never connected.
+    GPR_ASSERT(ev.success);
+    size_t i = static_cast<size_t>(reinterpret_cast<intptr_t>(ev.tag));
+    grpc_connectivity_state channel_state =
+        grpc_channel_check_connectivity_state(channels[i], 0);
+    if (channel_state != GRPC_CHANNEL_READY) {
+      WatchConnectivityState(channels[i], channel_state, cq, i);
+      continue;
+    }
+    if (latencies_us != nullptr) {
+      grpc_histogram_add(latencies_us,
+                         gpr_timespec_to_micros(gpr_time_sub(
+                             gpr_now(GPR_CLOCK_MONOTONIC), start_times[i])));
+    }
+    connecting--;
+  }
+}
+
+// Each iteration connects state.range(0) new channels concurrently, and waits
+// for all of them to be READY. Reports the handshakes per second, and the
+// percentiles of the time it took each channel to get READY.
+template <Security kSecurity, bool kResumeSessions>
+static void BM_Handshake(benchmark::State& state) {
+  const size_t concurrency = static_cast<size_t>(state.range(0));
+  HandshakeServer server(kSecurity);
+  grpc_ssl_session_cache* session_cache =
+      kResumeSessions ? grpc_ssl_session_cache_create_lru(1) : nullptr;
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_histogram* latencies_us = grpc_histogram_create(0.01, 60e6);
+  std::vector<grpc_channel*> channels(concurrency);
+  if (kResumeSessions) {
+    // Store the session that the benchmarked handshakes resume.
+    std::vector<grpc_channel*> first(1, server.CreateChannel(session_cache));
+    ConnectChannels(first, cq, nullptr);
+    grpc_channel_destroy(first[0]);
+  }
+  for (auto _ : state) {
+    for (size_t i = 0; i < concurrency; i++) {
+      channels[i] = server.CreateChannel(session_cache);
+    }
+    ConnectChannels(channels, cq, latencies_us);
+    for (grpc_channel* channel : channels) {
+      grpc_channel_destroy(channel);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * concurrency);
+  state.counters["p50_us"] = grpc_histogram_percentile(latencies_us, 50);
+  state.counters["p90_us"] = grpc_histogram_percentile(latencies_us, 90);
+  state.counters["p99_us"] = grpc_histogram_percentile(latencies_us, 99);
+  grpc_histogram_destroy(latencies_us);
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+  if (session_cache != nullptr) grpc_ssl_session_cache_destroy(session_cache);
+}
+
+static void ConcurrencyArgs(benchmark::internal::Benchmark* b) {
+  for (int concurrency : {1, 8, 64}) {
+    b->Arg(concurrency);
+  }
+  b->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_Handshake, Security::kInsecure, false)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_Handshake, Security::kFake, false)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_Handshake, Security::kLocal, false)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_Handshake, Security::kSslRsa, false)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_Handshake, Security::kSslEcdsa, false)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_Handshake, Security::kSslRsa, true)
+    ->Apply(ConcurrencyArgs);
+BENCHMARK_TEMPLATE(BM_Handshake, Security::kSslEcdsa, true)
+    ->Apply(ConcurrencyArgs);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc_init();
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
@@ -0,0 +1,63 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark bringing up the library from scratch, as a short-lived process
+   does before its first call */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+
+#include "test/cpp/util/test_config.h"
+
+// Unlike the other benchmarks, this one does not keep the library initialized
+// with a LibraryInitializer: every iteration has to start from a shut down
+// library, so counters that need it initialized are not tracked either.
+
+static void BM_InitShutdown(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc_init();
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_InitShutdown);
+
+// Includes creating a channel, which does not connect yet. The address needs
+// no resolver thread.
+static void BM_InitCreateChannel(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc_init();
+    grpc_channel* channel =
+        grpc_insecure_channel_create("ipv4:127.0.0.1:1", nullptr, nullptr);
+    grpc_channel_destroy(channel);
+    grpc_shutdown_blocking();
+  }
+}
+BENCHMARK(BM_InitCreateChannel);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark parsing json documents, and service configs in particular */
+
+#include <string.h>
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/ext/filters/client_channel/service_config.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json.h"
+
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// A service config with a method config for each of 'methods' services.
+static std::string MakeServiceConfig(int methods) {
+  std::string config =
+      "{\"loadBalancingPolicy\":\"round_robin\",\"methodConfig\":[";
+  for (int i = 0; i < methods; i++) {
+    char* method_config;
+    gpr_asprintf(&method_config,
+                 "%s{\"name\":[{\"service\":\"grpc.testing.Service%d\","
+                 "\"method\":\"Method\"}],\"waitForReady\":true,"
+                 "\"timeout\":\"%d.5s\",\"maxRequestMessageBytes\":%d,"
+                 "\"maxResponseMessageBytes\":%d}",
+                 i == 0 ? "" : ",", i, i + 1, 1024 * (i + 1), 2048 * (i + 1));
+    config += method_config;
+    gpr_free(method_config);
+  }
+  config += "]}";
+  return config;
+}
+
+static void BM_JsonParse(benchmark::State& state) {
+  TrackCounters track_counters;
+  std::string config = MakeServiceConfig(state.range(0));
+  // The parser unescapes strings in place.
+  char* input = static_cast<char*>(gpr_malloc(config.size()));
+  for (auto _ : state) {
+    memcpy(input, config.data(), config.size());
+    grpc_json* json = grpc_json_parse_string_with_len(input, config.size());
+    GPR_ASSERT(json != nullptr);
+    grpc_json_destroy(json);
+  }
+  gpr_free(input);
+  state.SetBytesProcessed(state.iterations() * config.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_JsonParse)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_ServiceConfigCreate(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  std::string config = MakeServiceConfig(state.range(0));
+  for (auto _ : state) {
+    grpc_error* error = GRPC_ERROR_NONE;
+    grpc_core::RefCountedPtr<grpc_core::ServiceConfig> service_config =
+        grpc_core::ServiceConfig::Create(config.c_str(), &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    GPR_ASSERT(service_config != nullptr);
+  }
+  state.SetBytesProcessed(state.iterations() * config.size());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ServiceConfigCreate)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
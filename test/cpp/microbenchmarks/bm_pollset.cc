@@ -26,6 +26,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 
@@ -157,6 +158,46 @@ static void BM_PollAddFd(benchmark::State& state) {
 }
 BENCHMARK(BM_PollAddFd);
 
+// Adds and removes a pollset in a pollset_set that already holds
+// state.range(0) others, as channels coming and going do.
+static void BM_PollsetSetChurn(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_pollsets = static_cast<size_t>(state.range(0)) + 1;
+  size_t ps_sz = grpc_pollset_size();
+  grpc_core::ExecCtx exec_ctx;
+  grpc_pollset_set* pss = grpc_pollset_set_create();
+  std::vector<grpc_pollset*> pollsets;
+  std::vector<gpr_mu*> mus(num_pollsets);
+  for (size_t i = 0; i < num_pollsets; i++) {
+    grpc_pollset* ps = static_cast<grpc_pollset*>(gpr_zalloc(ps_sz));
+    grpc_pollset_init(ps, &mus[i]);
+    pollsets.push_back(ps);
+  }
+  for (size_t i = 1; i < num_pollsets; i++) {
+    grpc_pollset_set_add_pollset(pss, pollsets[i]);
+  }
+  for (auto _ : state) {
+    grpc_pollset_set_add_pollset(pss, pollsets[0]);
+    grpc_pollset_set_del_pollset(pss, pollsets[0]);
+  }
+  for (size_t i = 1; i < num_pollsets; i++) {
+    grpc_pollset_set_del_pollset(pss, pollsets[i]);
+  }
+  grpc_pollset_set_destroy(pss);
+  for (size_t i = 0; i < num_pollsets; i++) {
+    grpc_closure shutdown_ps_closure;
+    GRPC_CLOSURE_INIT(&shutdown_ps_closure, shutdown_ps, pollsets[i],
+                      grpc_schedule_on_exec_ctx);
+    gpr_mu_lock(mus[i]);
+    grpc_pollset_shutdown(pollsets[i], &shutdown_ps_closure);
+    gpr_mu_unlock(mus[i]);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_free(pollsets[i]);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_PollsetSetChurn)->RangeMultiplier(16)->Range(1, 4096);
+
 class Closure : public grpc_closure {
  public:
   virtual ~Closure() {}
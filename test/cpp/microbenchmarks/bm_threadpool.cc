@@ -310,6 +310,50 @@ static void BM_SpikyLoad(benchmark::State& state) {
 }
 BENCHMARK(BM_SpikyLoad)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
 
+struct InfLenQueue {
+  static grpc_core::MPMCQueueInterface* Create() {
+    return new grpc_core::InfLenFIFOQueue();
+  }
+};
+
+struct BoundedQueue {
+  static grpc_core::MPMCQueueInterface* Create() {
+    return new grpc_core::BoundedFIFOQueue(1024);
+  }
+};
+
+struct BoundedSpinningQueue {
+  static grpc_core::MPMCQueueInterface* Create() {
+    return new grpc_core::BoundedFIFOQueue(1024, 100 /* spin_count */);
+  }
+};
+
+// Measures how the closure queue itself scales with the number of threads.
+// Every thread puts an element and then gets one, so each thread is both a
+// producer and a consumer and nobody blocks for long.
+template <class Queue>
+static void BM_MPMCQueuePutGet(benchmark::State& state) {
+  static grpc_core::MPMCQueueInterface* queue = nullptr;
+  // Setup for each run of test.
+  if (state.thread_index == 0) {
+    queue = Queue::Create();
+  }
+  int elem;
+  while (state.KeepRunning()) {
+    queue->Put(&elem);
+    benchmark::DoNotOptimize(queue->Get());
+  }
+  // Teardown at the end of each test run.
+  if (state.thread_index == 0) {
+    delete queue;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_MPMCQueuePutGet, InfLenQueue)->ThreadRange(1, 64);
+BENCHMARK_TEMPLATE(BM_MPMCQueuePutGet, BoundedQueue)->ThreadRange(1, 64);
+BENCHMARK_TEMPLATE(BM_MPMCQueuePutGet, BoundedSpinningQueue)
+    ->ThreadRange(1, 64);
+
 }  // namespace testing
 }  // namespace grpc
 
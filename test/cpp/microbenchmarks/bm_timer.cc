@@ -28,6 +28,10 @@
 #include "test/cpp/util/test_config.h"
 
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_manager.h"
+
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
 
 namespace grpc {
 namespace testing {
@@ -99,6 +103,76 @@ BENCHMARK(BM_TimerBatch)
     ->Args({/*check=*/true, /*reverse=*/true})
     ->ThreadRange(1, 128);
 
+// Swaps in the timer implementation selected by a benchmark argument for the
+// lifetime of the object. The timer threads are stopped meanwhile, since they
+// would otherwise be checking the timer list while it is replaced.
+class ScopedTimerImpl {
+ public:
+  explicit ScopedTimerImpl(benchmark::State& state, int impl)
+      : impl_(impl ? &grpc_wheel_timer_vtable : &grpc_generic_timer_vtable) {
+    state.SetLabel(impl ? "wheel" : "heap");
+    grpc_timer_manager_set_threading(false);
+    grpc_timer_list_shutdown();
+    grpc_set_timer_impl(impl_);
+    grpc_timer_list_init();
+  }
+  ~ScopedTimerImpl() {
+    grpc_timer_list_shutdown();
+    grpc_set_default_timer_impl();
+    grpc_timer_list_init();
+    grpc_timer_manager_set_threading(true);
+  }
+
+ private:
+  grpc_timer_vtable* impl_;
+};
+
+// Cost of adding and cancelling a timer while many others are pending, as
+// with the deadline, keepalive and BDP timers of a large number of calls.
+static void BM_InitCancelWithPendingTimers(benchmark::State& state) {
+  constexpr int kTimerCount = 1024;
+  const int pending_count = state.range(1);
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  ScopedTimerImpl impl(state, state.range(0));
+  const grpc_millis now = exec_ctx.Now();
+  auto deadline = [now](int i) {
+    // Spread over the next hour, starting a second out
+    return now + 1000 + (static_cast<grpc_millis>(i) * 7919) % 3600000;
+  };
+  std::vector<TimerClosure> pending(pending_count);
+  for (int i = 0; i < pending_count; i++) {
+    GRPC_CLOSURE_INIT(&pending[i].closure,
+                      [](void* /*args*/, grpc_error* /*err*/) {}, nullptr,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&pending[i].timer, deadline(i), &pending[i].closure);
+  }
+  std::vector<TimerClosure> timer_closures(kTimerCount);
+  int i = 0;
+  for (auto _ : state) {
+    TimerClosure* timer_closure = &timer_closures[i % kTimerCount];
+    GRPC_CLOSURE_INIT(&timer_closure->closure,
+                      [](void* /*args*/, grpc_error* /*err*/) {}, nullptr,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&timer_closure->timer, deadline(i++),
+                    &timer_closure->closure);
+    grpc_timer_cancel(&timer_closure->timer);
+    exec_ctx.Flush();
+  }
+  for (TimerClosure& timer_closure : pending) {
+    grpc_timer_cancel(&timer_closure.timer);
+  }
+  exec_ctx.Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_InitCancelWithPendingTimers)
+    ->Args({/*wheel=*/0, /*pending=*/10000})
+    ->Args({/*wheel=*/1, /*pending=*/10000})
+    ->Args({/*wheel=*/0, /*pending=*/100000})
+    ->Args({/*wheel=*/1, /*pending=*/100000})
+    ->Args({/*wheel=*/0, /*pending=*/1000000})
+    ->Args({/*wheel=*/1, /*pending=*/1000000});
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark parsing of EDS responses with many endpoints */
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/xds/xds_api.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+#include "envoy/api/v2/core/address.upb.h"
+#include "envoy/api/v2/core/base.upb.h"
+#include "envoy/api/v2/discovery.upb.h"
+#include "envoy/api/v2/eds.upb.h"
+#include "envoy/api/v2/endpoint/endpoint.upb.h"
+#include "google/protobuf/any.upb.h"
+#include "google/protobuf/wrappers.upb.h"
+#include "upb/upb.h"
+
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+constexpr char kEdsTypeUrl[] =
+    "type.googleapis.com/envoy.api.v2.ClusterLoadAssignment";
+
+// Spreads 'endpoints' endpoints evenly over 10 localities.
+static grpc_slice MakeEdsResponse(int endpoints) {
+  constexpr int kLocalities = 10;
+  upb::Arena arena;
+  envoy_api_v2_ClusterLoadAssignment* cluster_load_assignment =
+      envoy_api_v2_ClusterLoadAssignment_new(arena.ptr());
+  envoy_api_v2_ClusterLoadAssignment_set_cluster_name(
+      cluster_load_assignment, upb_strview_makez("service"));
+  // The messages point into these strings, so they must not be reallocated.
+  std::vector<std::string> strings;
+  strings.reserve(endpoints + kLocalities);
+  for (int l = 0; l < kLocalities; ++l) {
+    envoy_api_v2_endpoint_LocalityLbEndpoints* locality_lb_endpoints =
+        envoy_api_v2_ClusterLoadAssignment_add_endpoints(
+            cluster_load_assignment, arena.ptr());
+    envoy_api_v2_core_Locality* locality =
+        envoy_api_v2_endpoint_LocalityLbEndpoints_mutable_locality(
+            locality_lb_endpoints, arena.ptr());
+    envoy_api_v2_core_Locality_set_region(locality,
+                                          upb_strview_makez("region"));
+    envoy_api_v2_core_Locality_set_zone(locality, upb_strview_makez("zone"));
+    strings.push_back("subzone" + std::to_string(l));
+    envoy_api_v2_core_Locality_set_sub_zone(
+        locality, upb_strview_makez(strings.back().c_str()));
+    google_protobuf_UInt32Value_set_value(
+        envoy_api_v2_endpoint_LocalityLbEndpoints_mutable_load_balancing_weight(
+            locality_lb_endpoints, arena.ptr()),
+        1);
+    for (int i = l; i < endpoints; i += kLocalities) {
+      char address[32];
+      snprintf(address, sizeof(address), "10.%d.%d.%d", (i >> 16) & 0xff,
+               (i >> 8) & 0xff, i & 0xff);
+      strings.push_back(address);
+      envoy_api_v2_endpoint_LbEndpoint* lb_endpoint =
+          envoy_api_v2_endpoint_LocalityLbEndpoints_add_lb_endpoints(
+              locality_lb_endpoints, arena.ptr());
+      envoy_api_v2_core_SocketAddress* socket_address =
+          envoy_api_v2_core_Address_mutable_socket_address(
+              envoy_api_v2_endpoint_Endpoint_mutable_address(
+                  envoy_api_v2_endpoint_LbEndpoint_mutable_endpoint(
+                      lb_endpoint, arena.ptr()),
+                  arena.ptr()),
+              arena.ptr());
+      envoy_api_v2_core_SocketAddress_set_address(
+          socket_address, upb_strview_makez(strings.back().c_str()));
+      envoy_api_v2_core_SocketAddress_set_port_value(socket_address, 443);
+    }
+  }
+  size_t length;
+  char* encoded_cluster_load_assignment =
+      envoy_api_v2_ClusterLoadAssignment_serialize(cluster_load_assignment,
+                                                   arena.ptr(), &length);
+  envoy_api_v2_DiscoveryResponse* response =
+      envoy_api_v2_DiscoveryResponse_new(arena.ptr());
+  envoy_api_v2_DiscoveryResponse_set_type_url(response,
+                                              upb_strview_makez(kEdsTypeUrl));
+  google_protobuf_Any* resource =
+      envoy_api_v2_DiscoveryResponse_add_resources(response, arena.ptr());
+  google_protobuf_Any_set_type_url(resource, upb_strview_makez(kEdsTypeUrl));
+  google_protobuf_Any_set_value(
+      resource, upb_strview_make(encoded_cluster_load_assignment, length));
+  char* encoded_response =
+      envoy_api_v2_DiscoveryResponse_serialize(response, arena.ptr(), &length);
+  return grpc_slice_from_copied_buffer(encoded_response, length);
+}
+
+static void BM_EdsResponseParse(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice response = MakeEdsResponse(state.range(0));
+  for (auto _ : state) {
+    grpc_core::EdsUpdate update;
+    grpc_error* error =
+        grpc_core::XdsEdsResponseDecodeAndParse(response, &update);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    GPR_ASSERT(!update.priority_list_update.empty());
+  }
+  state.SetBytesProcessed(state.iterations() * GRPC_SLICE_LENGTH(response));
+  grpc_slice_unref_internal(response);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_EdsResponseParse)->Arg(1000)->Arg(10000)->Arg(50000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -22,6 +22,7 @@
 #define TEST_CPP_MICROBENCHMARKS_CALLBACK_UNARY_PING_PONG_H
 
 #include <benchmark/benchmark.h>
+#include <atomic>
 #include <sstream>
 #include "src/core/lib/profiling/timers.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
@@ -36,25 +37,37 @@ namespace testing {
  * BENCHMARKING KERNELS
  */
 
-void SendCallbackUnaryPingPong(benchmark::State* state, ClientContext* cli_ctx,
-                               EchoRequest* request, EchoResponse* response,
-                               EchoTestService::Stub* stub_, bool* done,
-                               std::mutex* mu, std::condition_variable* cv) {
-  int response_msgs_size = state->range(1);
-  cli_ctx->AddMetadata(kServerMessageSize, grpc::to_string(response_msgs_size));
-  stub_->experimental_async()->Echo(
-      cli_ctx, request, response,
-      [state, cli_ctx, request, response, stub_, done, mu, cv](Status s) {
+// Counts the heap allocations made through operator new, by any thread.
+extern std::atomic<size_t> g_cpp_heap_allocs;
+
+// Everything the ping pong loop needs, so that the completion callback only
+// captures one pointer and fits in std::function's inline storage.
+struct CallbackUnaryPingPongArgs {
+  benchmark::State* state;
+  ClientContext* cli_ctx;
+  EchoRequest* request;
+  EchoResponse* response;
+  EchoTestService::Stub* stub;
+  bool* done;
+  std::mutex* mu;
+  std::condition_variable* cv;
+};
+
+void SendCallbackUnaryPingPong(CallbackUnaryPingPongArgs* args) {
+  int response_msgs_size = args->state->range(1);
+  args->cli_ctx->AddMetadata(kServerMessageSize,
+                             grpc::to_string(response_msgs_size));
+  args->stub->experimental_async()->Echo(
+      args->cli_ctx, args->request, args->response, [args](Status s) {
         GPR_ASSERT(s.ok());
-        if (state->KeepRunning()) {
-          cli_ctx->~ClientContext();
-          new (cli_ctx) ClientContext();
-          SendCallbackUnaryPingPong(state, cli_ctx, request, response, stub_,
-                                    done, mu, cv);
+        if (args->state->KeepRunning()) {
+          args->cli_ctx->~ClientContext();
+          new (args->cli_ctx) ClientContext();
+          SendCallbackUnaryPingPong(args);
         } else {
-          std::lock_guard<std::mutex> l(*mu);
-          *done = true;
-          cv->notify_one();
+          std::lock_guard<std::mutex> l(*args->mu);
+          *args->done = true;
+          args->cv->notify_one();
         }
       });
 };
@@ -80,15 +93,22 @@ static void BM_CallbackUnaryPingPong(benchmark::State& state) {
   std::mutex mu;
   std::condition_variable cv;
   bool done = false;
+  CallbackUnaryPingPongArgs args = {&state, &cli_ctx, &request, &response,
+                                    stub_.get(), &done, &mu, &cv};
+  const size_t allocs_at_start = g_cpp_heap_allocs.load();
   if (state.KeepRunning()) {
     GPR_TIMER_SCOPE("BenchmarkCycle", 0);
-    SendCallbackUnaryPingPong(&state, &cli_ctx, &request, &response,
-                              stub_.get(), &done, &mu, &cv);
+    SendCallbackUnaryPingPong(&args);
   }
   std::unique_lock<std::mutex> l(mu);
   while (!done) {
     cv.wait(l);
   }
+  std::ostringstream allocs;
+  allocs << "cpp_allocs/iter:"
+         << static_cast<double>(g_cpp_heap_allocs.load() - allocs_at_start) /
+                static_cast<double>(state.iterations());
+  fixture->AddLabel(allocs.str());
   fixture->Finish(state);
   fixture.reset();
   state.SetBytesProcessed(request_msgs_size * state.iterations() +
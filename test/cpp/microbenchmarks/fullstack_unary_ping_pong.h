@@ -22,7 +22,11 @@
 #define TEST_CPP_MICROBENCHMARKS_FULLSTACK_UNARY_PING_PONG_H
 
 #include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include "src/core/lib/profiling/timers.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
@@ -109,6 +113,89 @@ static void BM_UnaryPingPong(benchmark::State& state) {
   state.SetBytesProcessed(state.range(0) * state.iterations() +
                           state.range(1) * state.iterations());
 }
+
+// Runs blocking unary calls from every benchmark thread over one shared
+// channel, to show how the transport scales with concurrent calls. The server
+// answers on as many threads as there are callers.
+template <class Fixture>
+static void BM_UnaryPingPongSharedChannel(benchmark::State& state) {
+  struct ServerEnv {
+    ServerContext ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer;
+    bool finishing = false;
+    ServerEnv() : response_writer(&ctx) {}
+  };
+  static EchoTestService::AsyncService* service;
+  static Fixture* fixture;
+  static EchoTestService::Stub* stub;
+  static std::vector<ServerEnv*>* server_env;
+  static std::vector<std::thread>* server_threads;
+  static std::atomic<bool> done;
+  if (state.thread_index == 0) {
+    done.store(false);
+    service = new EchoTestService::AsyncService;
+    fixture = new Fixture(service);
+    stub = EchoTestService::NewStub(fixture->channel()).release();
+    server_env = new std::vector<ServerEnv*>;
+    // Keep a couple of calls requested per caller
+    for (int i = 0; i < 2 * state.threads; i++) {
+      server_env->push_back(new ServerEnv);
+      service->RequestEcho(&server_env->back()->ctx,
+                           &server_env->back()->recv_request,
+                           &server_env->back()->response_writer,
+                           fixture->cq(), fixture->cq(), server_env->back());
+    }
+    server_threads = new std::vector<std::thread>;
+    for (int i = 0; i < state.threads; i++) {
+      server_threads->emplace_back([]() {
+        EchoResponse send_response;
+        void* t;
+        bool ok;
+        // The fixture drains the completion queue once these threads are
+        // done with it
+        while (!done.load()) {
+          if (fixture->cq()->AsyncNext(&t, &ok,
+                                       std::chrono::system_clock::now() +
+                                           std::chrono::milliseconds(10)) !=
+                  CompletionQueue::GOT_EVENT ||
+              !ok) {
+            continue;
+          }
+          ServerEnv* senv = static_cast<ServerEnv*>(t);
+          if (!senv->finishing) {
+            senv->finishing = true;
+            senv->response_writer.Finish(send_response, Status::OK, senv);
+          } else {
+            senv->~ServerEnv();
+            new (senv) ServerEnv();
+            service->RequestEcho(&senv->ctx, &senv->recv_request,
+                                 &senv->response_writer, fixture->cq(),
+                                 fixture->cq(), senv);
+          }
+        }
+      });
+    }
+  }
+  EchoRequest send_request;
+  for (auto _ : state) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    ClientContext cli_ctx;
+    EchoResponse recv_response;
+    GPR_ASSERT(stub->Echo(&cli_ctx, send_request, &recv_response).ok());
+  }
+  if (state.thread_index == 0) {
+    fixture->Finish(state);
+    done.store(true);
+    for (auto& th : *server_threads) th.join();
+    delete server_threads;
+    delete stub;
+    delete fixture;
+    for (ServerEnv* senv : *server_env) delete senv;
+    delete server_env;
+    delete service;
+  }
+}
 }  // namespace testing
 }  // namespace grpc
 
@@ -176,6 +176,42 @@ void TestCancelActiveDNSQuery(ArgsStruct* args) {
   ArgsFinish(args);
 }
 
+void TestCancelDNSQueryWaitingOnAnother(ArgsStruct* leader_args,
+                                        ArgsStruct* follower_args) {
+  int fake_dns_port = grpc_pick_unused_port_or_die();
+  grpc::testing::FakeNonResponsiveDNSServer fake_dns_server(fake_dns_port);
+  char* client_target;
+  GPR_ASSERT(gpr_asprintf(
+      &client_target,
+      "dns://[::1]:%d/dont-care-since-wont-be-resolved.test.com:1234",
+      fake_dns_port));
+  // create two resolvers for the same name, the second of which waits on
+  // the DNS query of the first
+  grpc_core::OrphanablePtr<grpc_core::Resolver> leader =
+      grpc_core::ResolverRegistry::CreateResolver(
+          client_target, nullptr, leader_args->pollset_set, leader_args->lock,
+          std::unique_ptr<grpc_core::Resolver::ResultHandler>(
+              new AssertFailureResultHandler(leader_args)));
+  grpc_core::OrphanablePtr<grpc_core::Resolver> follower =
+      grpc_core::ResolverRegistry::CreateResolver(
+          client_target, nullptr, follower_args->pollset_set,
+          follower_args->lock,
+          std::unique_ptr<grpc_core::Resolver::ResultHandler>(
+              new AssertFailureResultHandler(follower_args)));
+  gpr_free(client_target);
+  leader->StartLocked();
+  follower->StartLocked();
+  // The waiting resolver shuts down without the query being cancelled.
+  follower.reset();
+  grpc_core::ExecCtx::Get()->Flush();
+  PollPollsetUntilRequestDone(follower_args);
+  leader.reset();
+  grpc_core::ExecCtx::Get()->Flush();
+  PollPollsetUntilRequestDone(leader_args);
+  ArgsFinish(follower_args);
+  ArgsFinish(leader_args);
+}
+
 class CancelDuringAresQuery : public ::testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -208,6 +244,15 @@ TEST_F(CancelDuringAresQuery, TestCancelActiveDNSQuery) {
   TestCancelActiveDNSQuery(&args);
 }
 
+TEST_F(CancelDuringAresQuery, TestCancelDNSQueryWaitingOnAnother) {
+  grpc_core::ExecCtx exec_ctx;
+  ArgsStruct leader_args;
+  ArgsInit(&leader_args);
+  ArgsStruct follower_args;
+  ArgsInit(&follower_args);
+  TestCancelDNSQueryWaitingOnAnother(&leader_args, &follower_args);
+}
+
 #ifdef GPR_WINDOWS
 
 void MaybePollArbitraryPollsetTwice() {
@@ -21,6 +21,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <mutex>
 #include <unordered_map>
@@ -38,6 +39,7 @@
 
 #include "src/core/lib/gpr/env.h"
 #include "src/cpp/util/core_stats.h"
+#include "test/cpp/qps/cpu_affinity.h"
 #include "test/cpp/qps/histogram.h"
 #include "test/cpp/qps/interarrival.h"
 #include "test/cpp/qps/qps_worker.h"
@@ -108,13 +110,22 @@ class ClientRequestCreator<ByteBuffer> {
 
 class HistogramEntry final {
  public:
-  HistogramEntry() : value_used_(false), status_used_(false) {}
+  HistogramEntry()
+      : value_used_(false),
+        uncorrected_value_used_(false),
+        status_used_(false) {}
   bool value_used() const { return value_used_; }
   double value() const { return value_; }
   void set_value(double v) {
     value_used_ = true;
     value_ = v;
   }
+  bool uncorrected_value_used() const { return uncorrected_value_used_; }
+  double uncorrected_value() const { return uncorrected_value_; }
+  void set_uncorrected_value(double v) {
+    uncorrected_value_used_ = true;
+    uncorrected_value_ = v;
+  }
   bool status_used() const { return status_used_; }
   int status() const { return status_; }
   void set_status(int status) {
@@ -125,10 +136,52 @@ class HistogramEntry final {
  private:
   bool value_used_;
   double value_;
+  bool uncorrected_value_used_;
+  double uncorrected_value_;
   bool status_used_;
   int status_;
 };
 
+// Times a request for the latency histogram. An open-loop request is timed
+// from when it was scheduled to be sent: when the client falls behind its
+// schedule, the time the request waited to be sent is part of the latency the
+// offered load sees. Timing from the actual send time instead hides that
+// delay ("coordinated omission"); it is still recorded as the uncorrected
+// latency.
+class RequestTimer final {
+ public:
+  // Call with the time (GPR_CLOCK_MONOTONIC) an open-loop request is
+  // scheduled for. Returns \a issue_time.
+  gpr_timespec Schedule(gpr_timespec issue_time) {
+    scheduled_ = true;
+    issue_time_ = issue_time;
+    return issue_time;
+  }
+
+  // Call when the request is sent.
+  void Start() {
+    start_ = UsageTimer::Now();
+    if (scheduled_) {
+      gpr_timespec lag =
+          gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), issue_time_);
+      schedule_lag_ = std::max(0.0, lag.tv_sec + 1e-9 * lag.tv_nsec);
+    }
+  }
+
+  // Call when the response is received.
+  void Finish(HistogramEntry* entry) const {
+    const double latency = UsageTimer::Now() - start_;
+    entry->set_value((schedule_lag_ + latency) * 1e9);
+    if (scheduled_) entry->set_uncorrected_value(latency * 1e9);
+  }
+
+ private:
+  bool scheduled_ = false;
+  gpr_timespec issue_time_;
+  double start_ = 0;
+  double schedule_lag_ = 0;
+};
+
 typedef std::unordered_map<int, int64_t> StatusHistogram;
 
 inline void MergeStatusHistogram(const StatusHistogram& from,
@@ -152,6 +205,7 @@ class Client {
 
   ClientStats Mark(bool reset) {
     Histogram latencies;
+    Histogram uncorrected_latencies;
     StatusHistogram statuses;
     UsageTimer::Result timer_result;
 
@@ -161,15 +215,18 @@ class Client {
     int poll_count = cur_poll_count - last_reset_poll_count_;
     if (reset) {
       std::vector<Histogram> to_merge(threads_.size());
+      std::vector<Histogram> to_merge_uncorrected(threads_.size());
       std::vector<StatusHistogram> to_merge_status(threads_.size());
 
       for (size_t i = 0; i < threads_.size(); i++) {
-        threads_[i]->BeginSwap(&to_merge[i], &to_merge_status[i]);
+        threads_[i]->BeginSwap(&to_merge[i], &to_merge_uncorrected[i],
+                               &to_merge_status[i]);
       }
       std::unique_ptr<UsageTimer> timer(new UsageTimer);
       timer_.swap(timer);
       for (size_t i = 0; i < threads_.size(); i++) {
         latencies.Merge(to_merge[i]);
+        uncorrected_latencies.Merge(to_merge_uncorrected[i]);
         MergeStatusHistogram(to_merge_status[i], &statuses);
       }
       timer_result = timer->Mark();
@@ -177,7 +234,8 @@ class Client {
     } else {
       // merge snapshots of each thread histogram
       for (size_t i = 0; i < threads_.size(); i++) {
-        threads_[i]->MergeStatsInto(&latencies, &statuses);
+        threads_[i]->MergeStatsInto(&latencies, &uncorrected_latencies,
+                                    &statuses);
       }
       timer_result = timer_->Mark();
     }
@@ -200,6 +258,9 @@ class Client {
 
     ClientStats stats;
     latencies.FillProto(stats.mutable_latencies());
+    if (!closed_loop_) {
+      uncorrected_latencies.FillProto(stats.mutable_uncorrected_latencies());
+    }
     for (StatusHistogram::const_iterator it = statuses.begin();
          it != statuses.end(); ++it) {
       RequestResultCount* rrc = stats.add_request_results();
@@ -211,6 +272,7 @@ class Client {
     stats.set_time_user(timer_result.user);
     stats.set_cq_poll_count(poll_count);
     CoreStatsToProto(core_stats, stats.mutable_core_stats());
+    FillCoreCpuTimes(timer_result, core_list_, &stats);
     return stats;
   }
 
@@ -258,15 +320,18 @@ class Client {
 
     ~Thread() { impl_.join(); }
 
-    void BeginSwap(Histogram* n, StatusHistogram* s) {
+    void BeginSwap(Histogram* n, Histogram* uncorrected, StatusHistogram* s) {
       std::lock_guard<std::mutex> g(mu_);
       n->Swap(&histogram_);
+      uncorrected->Swap(&uncorrected_histogram_);
       s->swap(statuses_);
     }
 
-    void MergeStatsInto(Histogram* hist, StatusHistogram* s) {
+    void MergeStatsInto(Histogram* hist, Histogram* uncorrected,
+                        StatusHistogram* s) {
       std::unique_lock<std::mutex> g(mu_);
       hist->Merge(histogram_);
+      uncorrected->Merge(uncorrected_histogram_);
       MergeStatusHistogram(statuses_, s);
     }
 
@@ -292,6 +357,9 @@ class Client {
           }
         }
       }
+      if (entry->uncorrected_value_used()) {
+        uncorrected_histogram_.Add(entry->uncorrected_value());
+      }
       if (entry->status_used()) {
         statuses_[entry->status()]++;
       }
@@ -312,12 +380,17 @@ class Client {
         wait_loop++;
       }
 
+      if (idx_ < client_->thread_cores_.size()) {
+        PinThreadToCore(client_->thread_cores_[idx_]);
+      }
       client_->ThreadFunc(idx_, this);
       client_->CompleteThread();
     }
 
     std::mutex mu_;
     Histogram histogram_;
+    // Open-loop latencies timed from the actual send time
+    Histogram uncorrected_histogram_;
     StatusHistogram statuses_;
     Client* client_;
     const size_t idx_;
@@ -332,6 +405,10 @@ class Client {
  protected:
   bool closed_loop_;
   gpr_atm thread_pool_done_;
+  // The config's core_list
+  std::vector<int> core_list_;
+  // The core each thread is pinned to, if any
+  std::vector<int> thread_cores_;
   double median_latency_collection_interval_seconds_;  // In seconds
 
   void StartThreads(size_t num_threads) {
@@ -366,6 +443,10 @@ class Client {
         GPR_ASSERT(false);
     }
 
+    core_list_.assign(config.core_list().begin(), config.core_list().end());
+    // Threads that don't share completion queues
+    thread_cores_ = ThreadCores(config.core_list(), num_threads, num_threads);
+
     // Set closed_loop_ based on whether or not random_dist is set
     if (!random_dist) {
       closed_loop_ = true;
@@ -426,7 +507,9 @@ class ClientImpl : public Client {
   ClientImpl(const ClientConfig& config,
              std::function<std::unique_ptr<StubType>(std::shared_ptr<Channel>)>
                  create_stub)
-      : cores_(gpr_cpu_num_cores()), create_stub_(create_stub) {
+      : cores_(config.core_list_size() > 0 ? config.core_list_size()
+                                           : gpr_cpu_num_cores()),
+        create_stub_(create_stub) {
     for (int i = 0; i < config.client_channels(); i++) {
       channels_.emplace_back(
           config.server_targets(i % config.server_targets_size()), config,
@@ -89,7 +89,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   bool RunNextState(bool /*ok*/, HistogramEntry* entry) override {
     switch (next_state_) {
       case State::READY:
-        start_ = UsageTimer::Now();
+        timer_.Start();
         response_reader_ = prepare_req_(stub_, &context_, req_, cq_);
         response_reader_->StartCall();
         next_state_ = State::RESP_DONE;
@@ -98,7 +98,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
         return true;
       case State::RESP_DONE:
         if (status_.ok()) {
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          timer_.Finish(entry);
         }
         callback_(status_, &response_, entry);
         next_state_ = State::INVALID;
@@ -131,7 +131,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       CompletionQueue*)>
       prepare_req_;
   grpc::Status status_;
-  double start_;
+  RequestTimer timer_;
   std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>
       response_reader_;
 
@@ -141,7 +141,8 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
       alarm_.reset(new Alarm);
-      alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+      alarm_->Set(cq_, timer_.Schedule(next_issue_()),
+                  ClientRpcContext::tag(this));
     }
   }
 };
@@ -154,6 +155,7 @@ class AsyncClient : public ClientImpl<StubType, RequestType> {
   using Client::NextIssuer;
   using Client::SetupLoadTest;
   using Client::closed_loop_;
+  using Client::thread_cores_;
   using ClientImpl<StubType, RequestType>::cores_;
   using ClientImpl<StubType, RequestType>::channels_;
   using ClientImpl<StubType, RequestType>::request_;
@@ -173,6 +175,8 @@ class AsyncClient : public ClientImpl<StubType, RequestType> {
     for (int i = 0; i < num_cqs; i++) {
       cli_cqs_.emplace_back(new CompletionQueue);
     }
+    thread_cores_ =
+        ThreadCores(config.core_list(), num_async_threads_, num_cqs);
 
     for (int i = 0; i < num_async_threads_; i++) {
       cq_.emplace_back(i % cli_cqs_.size());
@@ -370,13 +374,14 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          alarm_->Set(cq_, timer_.Schedule(next_issue_()),
+                      ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          timer_.Start();
           next_state_ = State::WRITE_DONE;
           if (coalesce_ && messages_issued_ == messages_per_stream_ - 1) {
             stream_->WriteLast(req_, WriteOptions(),
@@ -394,7 +399,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
           return true;
           break;
         case State::READ_DONE:
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          timer_.Finish(entry);
           callback_(status_, &response_);
           if ((messages_per_stream_ != 0) &&
               (++messages_issued_ >= messages_per_stream_)) {
@@ -455,7 +460,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
           BenchmarkService::Stub*, grpc::ClientContext*, CompletionQueue*)>
       prepare_req_;
   grpc::Status status_;
-  double start_;
+  RequestTimer timer_;
   std::unique_ptr<grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>
       stream_;
 
@@ -555,14 +560,15 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
           break;  // loop around, don't return
         case State::WAIT:
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          alarm_->Set(cq_, timer_.Schedule(next_issue_()),
+                      ClientRpcContext::tag(this));
           next_state_ = State::READY_TO_WRITE;
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          timer_.Start();
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -570,7 +576,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
           if (!ok) {
             return false;
           }
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          timer_.Finish(entry);
           next_state_ = State::STREAM_IDLE;
           break;  // loop around
         default:
@@ -608,7 +614,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
       CompletionQueue*)>
       prepare_req_;
   grpc::Status status_;
-  double start_;
+  RequestTimer timer_;
   std::unique_ptr<grpc::ClientAsyncWriter<RequestType>> stream_;
 
   void StartInternal(CompletionQueue* cq) {
@@ -682,7 +688,7 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          timer_.Start();
           next_state_ = State::READ_DONE;
           stream_->Read(&response_, ClientRpcContext::tag(this));
           return true;
@@ -690,7 +696,7 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
           if (!ok) {
             return false;
           }
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          timer_.Finish(entry);
           callback_(status_, &response_);
           next_state_ = State::STREAM_IDLE;
           break;  // loop around
@@ -723,7 +729,7 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
       CompletionQueue*)>
       prepare_req_;
   grpc::Status status_;
-  double start_;
+  RequestTimer timer_;
   std::unique_ptr<grpc::ClientAsyncReader<ResponseType>> stream_;
 
   void StartInternal(CompletionQueue* cq) {
@@ -803,13 +809,14 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
           alarm_.reset(new Alarm);
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          alarm_->Set(cq_, timer_.Schedule(next_issue_()),
+                      ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          timer_.Start();
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -822,7 +829,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
           return true;
           break;
         case State::READ_DONE:
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          timer_.Finish(entry);
           callback_(status_, &response_);
           if ((messages_per_stream_ != 0) &&
               (++messages_issued_ >= messages_per_stream_)) {
@@ -878,7 +885,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
       CompletionQueue*)>
       prepare_req_;
   grpc::Status status_;
-  double start_;
+  RequestTimer timer_;
   std::unique_ptr<grpc::GenericClientAsyncReaderWriter> stream_;
 
   // Allow a limit on number of messages in a stream
@@ -0,0 +1,52 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "test/cpp/qps/cpu_affinity.h"
+
+#include <grpc/support/log.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#endif
+
+namespace grpc {
+namespace testing {
+
+bool PinThreadToCore(int core) {
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core, &cpus);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (err != 0) {
+    gpr_log(GPR_ERROR, "Could not pin thread to core %d: %s", core,
+            strerror(err));
+    return false;
+  }
+  return true;
+#else
+  gpr_log(GPR_INFO, "Thread pinning is only supported on Linux (core %d).",
+          core);
+  return false;
+#endif
+}
+
+}  // namespace testing
+}  // namespace grpc
@@ -0,0 +1,70 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef TEST_QPS_CPU_AFFINITY_H
+#define TEST_QPS_CPU_AFFINITY_H
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "test/cpp/qps/usage_timer.h"
+
+namespace grpc {
+namespace testing {
+
+// Returns the cores of a config's core_list that each of \a num_threads
+// threads should be pinned to, or an empty vector if \a core_list is empty.
+// Thread i polls completion queue i % num_cqs, so all the threads of a queue
+// share its core: with one thread per queue and a thread per listed core,
+// each core gets a queue of its own.
+template <class CoreList>
+std::vector<int> ThreadCores(const CoreList& core_list, size_t num_threads,
+                             size_t num_cqs) {
+  std::vector<int> cores;
+  if (core_list.empty()) return cores;
+  for (size_t i = 0; i < num_threads; i++) {
+    cores.push_back(core_list.Get((i % num_cqs) % core_list.size()));
+  }
+  return cores;
+}
+
+// Adds the cpu times in \a result of the cores in \a core_list to \a stats,
+// a ServerStats or ClientStats.
+template <class CoreList, class Stats>
+void FillCoreCpuTimes(const UsageTimer::Result& result,
+                      const CoreList& core_list, Stats* stats) {
+  for (int core : core_list) {
+    if (core < 0 || static_cast<size_t>(core) >= result.core_times.size()) {
+      continue;
+    }
+    auto* core_cpu_time = stats->add_core_cpu_times();
+    core_cpu_time->set_core(core);
+    core_cpu_time->set_total_cpu_time(result.core_times[core].total_cpu_time);
+    core_cpu_time->set_idle_cpu_time(result.core_times[core].idle_cpu_time);
+  }
+}
+
+// Pins the calling thread to \a core. Logs and returns false where that is
+// not supported or fails.
+bool PinThreadToCore(int core);
+
+}  // namespace testing
+}  // namespace grpc
+
+#endif  // TEST_QPS_CPU_AFFINITY_H
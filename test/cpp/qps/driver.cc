@@ -481,6 +481,8 @@ std::unique_ptr<ScenarioResult> RunScenario(
   // Finish a run
   std::unique_ptr<ScenarioResult> result(new ScenarioResult);
   Histogram merged_latencies;
+  Histogram merged_uncorrected_latencies;
+  bool has_uncorrected_latencies = false;
   std::unordered_map<int, int64_t> merged_statuses;
 
   gpr_log(GPR_INFO, "Finishing clients");
@@ -511,6 +513,10 @@ std::unique_ptr<ScenarioResult> RunScenario(
       gpr_log(GPR_INFO, "Received final status from client %zu", i);
       const auto& stats = client_status.stats();
       merged_latencies.MergeProto(stats.latencies());
+      if (stats.has_uncorrected_latencies()) {
+        merged_uncorrected_latencies.MergeProto(stats.uncorrected_latencies());
+        has_uncorrected_latencies = true;
+      }
       for (int i = 0; i < stats.request_results_size(); i++) {
         merged_statuses[stats.request_results(i).status_code()] +=
             stats.request_results(i).count();
@@ -537,6 +543,10 @@ std::unique_ptr<ScenarioResult> RunScenario(
   }
 
   merged_latencies.FillProto(result->mutable_latencies());
+  if (has_uncorrected_latencies) {
+    merged_uncorrected_latencies.FillProto(
+        result->mutable_uncorrected_latencies());
+  }
   for (std::unordered_map<int, int64_t>::iterator it = merged_statuses.begin();
        it != merged_statuses.end(); ++it) {
     RequestResultCount* rrc = result->add_request_results();
@@ -131,6 +131,16 @@ void GprLogReporter::ReportLatency(const ScenarioResult& result) {
           result.summary().latency_95() / 1000,
           result.summary().latency_99() / 1000,
           result.summary().latency_999() / 1000);
+  if (result.has_uncorrected_latencies()) {
+    Histogram histogram;
+    histogram.MergeProto(result.uncorrected_latencies());
+    gpr_log(GPR_INFO,
+            "Uncorrected latencies (50/90/95/99/99.9%%-ile): "
+            "%.1f/%.1f/%.1f/%.1f/%.1f us",
+            histogram.Percentile(50) / 1000, histogram.Percentile(90) / 1000,
+            histogram.Percentile(95) / 1000, histogram.Percentile(99) / 1000,
+            histogram.Percentile(99.9) / 1000);
+  }
 }
 
 void GprLogReporter::ReportTimes(const ScenarioResult& result) {
@@ -144,9 +154,27 @@ void GprLogReporter::ReportTimes(const ScenarioResult& result) {
           result.summary().client_user_time());
 }
 
+static void LogCoreCpuUsage(
+    const char* worker, size_t index,
+    const google::protobuf::RepeatedPtrField<CoreCpuTime>& core_cpu_times) {
+  for (const auto& core_cpu_time : core_cpu_times) {
+    if (core_cpu_time.total_cpu_time() == 0) continue;
+    gpr_log(GPR_INFO, "%s %" PRIuPTR " core %d CPU usage: %.2f%%", worker,
+            index, core_cpu_time.core(),
+            100.0 - 100.0 * core_cpu_time.idle_cpu_time() /
+                        core_cpu_time.total_cpu_time());
+  }
+}
+
 void GprLogReporter::ReportCpuUsage(const ScenarioResult& result) {
   gpr_log(GPR_INFO, "Server CPU usage: %.2f%%",
           result.summary().server_cpu_usage());
+  for (int i = 0; i < result.server_stats_size(); i++) {
+    LogCoreCpuUsage("Server", i, result.server_stats(i).core_cpu_times());
+  }
+  for (int i = 0; i < result.client_stats_size(); i++) {
+    LogCoreCpuUsage("Client", i, result.client_stats(i).core_cpu_times());
+  }
 }
 
 void GprLogReporter::ReportPollCount(const ScenarioResult& result) {
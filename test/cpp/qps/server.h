@@ -32,6 +32,7 @@
 #include "src/proto/grpc/testing/messages.pb.h"
 #include "test/core/end2end/data/ssl_test_data.h"
 #include "test/core/util/port.h"
+#include "test/cpp/qps/cpu_affinity.h"
 #include "test/cpp/qps/usage_timer.h"
 #include "test/cpp/util/test_credentials_provider.h"
 
@@ -41,8 +42,11 @@ namespace testing {
 class Server {
  public:
   explicit Server(const ServerConfig& config)
-      : timer_(new UsageTimer), last_reset_poll_count_(0) {
-    cores_ = gpr_cpu_num_cores();
+      : core_list_(config.core_list().begin(), config.core_list().end()),
+        timer_(new UsageTimer),
+        last_reset_poll_count_(0) {
+    cores_ = core_list_.empty() ? gpr_cpu_num_cores()
+                                : static_cast<int>(core_list_.size());
     if (config.port()) {  // positive for a fixed port, negative for inproc
       port_ = config.port();
     } else {  // zero for dynamic port
@@ -75,6 +79,7 @@ class Server {
     stats.set_idle_cpu_time(timer_result.idle_cpu_time);
     stats.set_cq_poll_count(poll_count);
     CoreStatsToProto(core_stats, stats.mutable_core_stats());
+    FillCoreCpuTimes(timer_result, core_list_, &stats);
     return stats;
   }
 
@@ -146,6 +151,7 @@ class Server {
  private:
   int port_;
   int cores_;
+  const std::vector<int> core_list_;
   std::unique_ptr<UsageTimer> timer_;
   int last_reset_poll_count_;
 };
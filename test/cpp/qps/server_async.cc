@@ -102,6 +102,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
     for (int i = 0; i < num_threads; i++) {
       cq_.emplace_back(i % srv_cqs_.size());
     }
+    thread_cores_ = ThreadCores(config.core_list(), num_threads, num_cqs);
 
     ApplyConfigToBuilder(config, builder.get());
 
@@ -199,6 +200,9 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
   }
 
   void ThreadFunc(int thread_idx) {
+    if (static_cast<size_t>(thread_idx) < thread_cores_.size()) {
+      PinThreadToCore(thread_cores_[thread_idx]);
+    }
     // Wait until work is available or we are shutting down
     bool ok;
     void* got_tag;
@@ -519,6 +523,8 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
   std::unique_ptr<grpc::Server> server_;
   std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> srv_cqs_;
   std::vector<int> cq_;
+  // The core each thread is pinned to, if any
+  std::vector<int> thread_cores_;
   ServiceType async_service_;
   std::vector<std::unique_ptr<ServerRpcContext>> contexts_;
 
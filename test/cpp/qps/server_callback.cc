@@ -97,6 +97,11 @@ class BenchmarkCallbackServiceImpl final
 class CallbackServer final : public grpc::testing::Server {
  public:
   explicit CallbackServer(const ServerConfig& config) : Server(config) {
+    if (config.core_list_size() > 0) {
+      gpr_log(GPR_INFO,
+              "Callback server threads are not pinned; core_list only "
+              "selects the cores to report");
+    }
     std::unique_ptr<ServerBuilder> builder = CreateQpsServerBuilder();
 
     auto port_num = port();
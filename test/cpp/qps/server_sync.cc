@@ -155,6 +155,11 @@ class BenchmarkServiceImpl final : public BenchmarkService::Service {
 class SynchronousServer final : public grpc::testing::Server {
  public:
   explicit SynchronousServer(const ServerConfig& config) : Server(config) {
+    if (config.core_list_size() > 0) {
+      gpr_log(GPR_INFO,
+              "Sync server threads are not pinned; core_list only selects the "
+              "cores to report");
+    }
     std::unique_ptr<ServerBuilder> builder = CreateQpsServerBuilder();
 
     auto port_num = port();
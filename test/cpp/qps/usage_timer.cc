@@ -76,6 +76,34 @@ static void get_cpu_usage(unsigned long long* total_cpu_time,
 #endif
 }
 
+static void get_core_times(std::vector<UsageTimer::CoreTime>* core_times) {
+#ifdef __linux__
+  std::ifstream proc_stat("/proc/stat");
+  std::string line;
+  // Skip the aggregate "cpu" line; the per-core "cpuN" lines follow it.
+  std::getline(proc_stat, line);
+  while (std::getline(proc_stat, line) && line.compare(0, 3, "cpu") == 0) {
+    std::stringstream line_s(line.substr(3));
+    size_t core;
+    line_s >> core;
+    if (core >= core_times->size()) core_times->resize(core + 1);
+    UsageTimer::CoreTime& core_time = (*core_times)[core];
+    core_time.total_cpu_time = 0;
+    core_time.idle_cpu_time = 0;
+    for (int i = 0; i < 10; ++i) {
+      unsigned long long cpu_time = 0;
+      line_s >> cpu_time;
+      core_time.total_cpu_time += cpu_time;
+      if (i == 3) {
+        core_time.idle_cpu_time = cpu_time;
+      }
+    }
+  }
+#else
+  (void)core_times;
+#endif
+}
+
 UsageTimer::Result UsageTimer::Sample() {
   Result r;
   r.wall = Now();
@@ -83,6 +111,7 @@ UsageTimer::Result UsageTimer::Sample() {
   r.total_cpu_time = 0;
   r.idle_cpu_time = 0;
   get_cpu_usage(&r.total_cpu_time, &r.idle_cpu_time);
+  get_core_times(&r.core_times);
   return r;
 }
 
@@ -94,6 +123,15 @@ UsageTimer::Result UsageTimer::Mark() const {
   r.system = s.system - start_.system;
   r.total_cpu_time = s.total_cpu_time - start_.total_cpu_time;
   r.idle_cpu_time = s.idle_cpu_time - start_.idle_cpu_time;
+  r.core_times.resize(s.core_times.size());
+  for (size_t i = 0; i < s.core_times.size(); ++i) {
+    r.core_times[i] = s.core_times[i];
+    // Cores brought online since the start count from zero.
+    if (i < start_.core_times.size()) {
+      r.core_times[i].total_cpu_time -= start_.core_times[i].total_cpu_time;
+      r.core_times[i].idle_cpu_time -= start_.core_times[i].idle_cpu_time;
+    }
+  }
 
   return r;
 }
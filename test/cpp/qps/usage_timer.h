@@ -19,16 +19,25 @@
 #ifndef TEST_QPS_USAGE_TIMER_H
 #define TEST_QPS_USAGE_TIMER_H
 
+#include <vector>
+
 class UsageTimer {
  public:
   UsageTimer();
 
+  struct CoreTime {
+    unsigned long long total_cpu_time;
+    unsigned long long idle_cpu_time;
+  };
+
   struct Result {
     double wall;
     double user;
     double system;
     unsigned long long total_cpu_time;
     unsigned long long idle_cpu_time;
+    // The cpu times of each core, indexed by core (data from proc/stat)
+    std::vector<CoreTime> core_times;
   };
 
   Result Mark() const;
@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/server/concurrency_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace internal {
+namespace {
+
+// Runs 'windows' windows of calls, with 'concurrency' calls in flight at a
+// time, each taking 'latency_us'.
+void RunCalls(ConcurrencyLimiter* limiter, int windows, int concurrency,
+              int64_t latency_us) {
+  for (int i = 0; i < windows * ConcurrencyLimiter::kWindowSize;
+       i += concurrency) {
+    int acquired = 0;
+    for (int j = 0; j < concurrency; ++j) {
+      if (limiter->TryAcquire()) ++acquired;
+    }
+    for (int j = 0; j < acquired; ++j) limiter->OnCallDone(latency_us);
+  }
+}
+
+TEST(ConcurrencyLimiterTest, RejectsCallsOverLimit) {
+  ConcurrencyLimiter limiter("/svc/Method", 2, 10);
+  EXPECT_TRUE(limiter.TryAcquire());
+  EXPECT_TRUE(limiter.TryAcquire());
+  EXPECT_FALSE(limiter.TryAcquire());
+  EXPECT_EQ(2, limiter.in_flight());
+  EXPECT_EQ(1u, limiter.rejected_calls());
+  limiter.OnCallDone(1000);
+  EXPECT_EQ(1, limiter.in_flight());
+  EXPECT_TRUE(limiter.TryAcquire());
+}
+
+TEST(ConcurrencyLimiterTest, GrowsWhileLatencyIsStable) {
+  ConcurrencyLimiter limiter("/svc/Method", 4, 100);
+  RunCalls(&limiter, 50, 4, 1000);
+  EXPECT_GT(limiter.limit(), 4);
+  EXPECT_LE(limiter.limit(), 100);
+}
+
+TEST(ConcurrencyLimiterTest, DoesNotGrowWhenUnused) {
+  ConcurrencyLimiter limiter("/svc/Method", 20, 100);
+  RunCalls(&limiter, 50, 1, 1000);
+  EXPECT_EQ(20, limiter.limit());
+}
+
+TEST(ConcurrencyLimiterTest, ShrinksWhenLatencyRises) {
+  ConcurrencyLimiter limiter("/svc/Method", 20, 100);
+  RunCalls(&limiter, 50, 20, 1000);
+  const int limit = limiter.limit();
+  RunCalls(&limiter, 10, 20, 10000);
+  EXPECT_LT(limiter.limit(), limit);
+  EXPECT_GE(limiter.limit(), 1);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
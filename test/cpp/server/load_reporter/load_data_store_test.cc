@@ -19,6 +19,7 @@
 #include <grpc/impl/codegen/port_platform.h>
 
 #include <set>
+#include <thread>
 #include <vector>
 
 #include <grpc/grpc.h>
@@ -470,6 +471,64 @@ TEST_F(PerBalancerStoreTest, DataAggregation) {
       v2.call_metrics().find(kMetric2)->second.total_metric_value());
 }
 
+TEST_F(PerBalancerStoreTest, TakeLoadRecordMap) {
+  PerBalancerStore per_balancer_store(kLbId1, kLoadKey1);
+  per_balancer_store.MergeRow(kKey1, LoadRecordValue(3, 1));
+  per_balancer_store.MergeRow(kKey2, LoadRecordValue(5, 2));
+  PerBalancerStore::LoadRecordMap taken =
+      per_balancer_store.TakeLoadRecordMap();
+  EXPECT_EQ(taken.size(), 2U);
+  EXPECT_EQ(taken.find(kKey1)->second.start_count(), 3U);
+  EXPECT_EQ(taken.find(kKey2)->second.ok_count(), 2U);
+  // The store is reset, but still counts the in-progress calls.
+  EXPECT_EQ(per_balancer_store.load_record_map().size(), 0U);
+  EXPECT_TRUE(per_balancer_store.TakeLoadRecordMap().empty());
+  EXPECT_EQ(per_balancer_store.GetNumCallsInProgressForReport(), 5U);
+}
+
+TEST_F(LoadDataStoreTest, ConcurrentMergeAndTake) {
+  const size_t kNumThreads = 4;
+  const size_t kNumKeys = 64;
+  const size_t kNumRounds = 100;
+  LoadDataStore load_data_store;
+  load_data_store.ReportStreamCreated(kHostname1, kLbId1, kLoadKey1);
+  PerBalancerStore* store =
+      load_data_store.FindPerBalancerStore(kHostname1, kLbId1);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t round = 0; round < kNumRounds; ++round) {
+        for (size_t i = 0; i < kNumKeys; ++i) {
+          LoadRecordKey key(kLbId1, kLbTag1, "user" + std::to_string(i),
+                            kClientIp1);
+          load_data_store.MergeRow(kHostname1, key, LoadRecordValue(1, 1));
+        }
+      }
+      // Unknown LB IDs are tracked concurrently, too.
+      LoadRecordKey unknown_key(FormatLbId(100 + t), kLbTag1, kUser1,
+                                kClientIp1);
+      load_data_store.MergeRow(kHostname1, unknown_key, LoadRecordValue(1));
+    });
+  }
+  // Report while the rows are being merged.
+  uint64_t total_start_count = 0;
+  for (size_t round = 0; round < kNumRounds; ++round) {
+    for (const auto& p : store->TakeLoadRecordMap()) {
+      total_start_count += p.second.start_count();
+    }
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (const auto& p : store->TakeLoadRecordMap()) {
+    total_start_count += p.second.start_count();
+  }
+  EXPECT_EQ(total_start_count, kNumThreads * kNumRounds * kNumKeys);
+  EXPECT_EQ(store->GetNumCallsInProgressForReport(), 0U);
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    EXPECT_TRUE(
+        load_data_store.IsTrackedUnknownBalancerId(FormatLbId(100 + t)));
+  }
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
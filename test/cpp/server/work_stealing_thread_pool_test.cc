@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/server/work_stealing_thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace {
+
+// Records the order in which callbacks run.
+class Recorder {
+ public:
+  void Record(int value) {
+    std::lock_guard<std::mutex> lock(mu_);
+    values_.push_back(value);
+    cv_.notify_all();
+  }
+
+  // Returns false if fewer than \a count values were recorded in time.
+  bool WaitFor(size_t count) {
+    std::unique_lock<std::mutex> lock(mu_);
+    return cv_.wait_for(lock, std::chrono::seconds(10),
+                        [this, count] { return values_.size() >= count; });
+  }
+
+  std::vector<int> values() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return values_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::vector<int> values_;
+};
+
+TEST(WorkStealingThreadPoolTest, RunsCallbacksAddedFromOutside) {
+  std::atomic<int> count{0};
+  Recorder recorder;
+  {
+    WorkStealingThreadPool pool(4);
+    for (int i = 0; i < 1000; i++) {
+      pool.Add([&count, &recorder, i] {
+        count.fetch_add(1);
+        recorder.Record(i);
+      });
+    }
+    EXPECT_TRUE(recorder.WaitFor(1000));
+  }
+  EXPECT_EQ(1000, count.load());
+}
+
+// A thread runs the callbacks it added itself newest first.
+TEST(WorkStealingThreadPoolTest, LocalCallbacksRunLastInFirstOut) {
+  Recorder recorder;
+  WorkStealingThreadPool pool(1);
+  pool.Add([&pool, &recorder] {
+    for (int i = 1; i <= 3; i++) {
+      pool.Add([&recorder, i] { recorder.Record(i); });
+    }
+  });
+  ASSERT_TRUE(recorder.WaitFor(3));
+  EXPECT_EQ(std::vector<int>({3, 2, 1}), recorder.values());
+}
+
+// Callbacks queued behind a busy thread are stolen by an idle one, oldest
+// first.
+TEST(WorkStealingThreadPoolTest, IdleThreadStealsFromBusyThread) {
+  const int kCallbacks = 100;
+  Recorder recorder;
+  WorkStealingThreadPool pool(2);
+  pool.Add([&pool, &recorder] {
+    for (int i = 0; i < kCallbacks; i++) {
+      pool.Add([&recorder, i] { recorder.Record(i); });
+    }
+    // This thread stays busy until the other one ran all of them.
+    EXPECT_TRUE(recorder.WaitFor(kCallbacks));
+  });
+  ASSERT_TRUE(recorder.WaitFor(kCallbacks));
+  std::vector<int> values = recorder.values();
+  for (int i = 0; i < kCallbacks; i++) {
+    EXPECT_EQ(i, values[i]);
+  }
+}
+
+// Destroying the pool runs everything that was added, including callbacks
+// added by callbacks that only run during shutdown.
+TEST(WorkStealingThreadPoolTest, ShutdownDrainsCallbacks) {
+  const int kCallbacks = 100;
+  std::atomic<int> count{0};
+  {
+    WorkStealingThreadPool pool(4);
+    for (int i = 0; i < kCallbacks; i++) {
+      pool.Add([&pool, &count] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        count.fetch_add(1);
+        pool.Add([&count] { count.fetch_add(1); });
+      });
+    }
+  }
+  EXPECT_EQ(2 * kCallbacks, count.load());
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
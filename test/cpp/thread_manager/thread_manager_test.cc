@@ -56,13 +56,17 @@ struct TestThreadManagerSettings {
 
   // How many should be instantiated
   int thread_manager_count;
+
+  // The target queueing delay for adaptive sizing (0 to disable it)
+  int target_queue_delay_usec;
 };
 
 class TestThreadManager final : public grpc::ThreadManager {
  public:
   TestThreadManager(const char* name, grpc_resource_quota* rq,
                     const TestThreadManagerSettings& settings)
-      : ThreadManager(name, rq, settings.min_pollers, settings.max_pollers),
+      : ThreadManager(name, rq, settings.min_pollers, settings.max_pollers,
+                      settings.target_queue_delay_usec),
         settings_(settings),
         num_do_work_(0),
         num_poll_for_work_(0),
@@ -150,10 +154,15 @@ class ThreadManagerTest
 TestThreadManagerSettings scenarios[] = {
     {2 /* min_pollers */, 10 /* max_pollers */, 10 /* poll_duration_ms */,
      1 /* work_duration_ms */, 50 /* max_poll_calls */,
-     INT_MAX /* thread_limit */, 1 /* thread_manager_count */},
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */,
+     0 /* target_queue_delay_usec */},
     {1 /* min_pollers */, 1 /* max_pollers */, 1 /* poll_duration_ms */,
      10 /* work_duration_ms */, 50 /* max_poll_calls */, 3 /* thread_limit */,
-     2 /* thread_manager_count */}};
+     2 /* thread_manager_count */, 0 /* target_queue_delay_usec */},
+    {1 /* min_pollers */, 10 /* max_pollers */, 1 /* poll_duration_ms */,
+     10 /* work_duration_ms */, 50 /* max_poll_calls */,
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */,
+     1000 /* target_queue_delay_usec */}};
 
 INSTANTIATE_TEST_SUITE_P(ThreadManagerTest, ThreadManagerTest,
                          ::testing::ValuesIn(scenarios));
@@ -17,9 +17,11 @@
  */
 
 #include <grpc++/support/byte_buffer.h>
+#include <grpcpp/impl/codegen/message_passthrough.h>
 #include <grpcpp/impl/grpc_library.h>
 
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include <grpc/grpc.h>
@@ -31,6 +33,72 @@ namespace grpc {
 
 static internal::GrpcLibraryInitializer g_gli_initializer;
 
+namespace internal {
+
+// Provide access to ByteBuffer internals.
+class GrpcByteBufferPeer {
+ public:
+  explicit GrpcByteBufferPeer(ByteBuffer* bb) : bb_(bb) {}
+  grpc_byte_buffer* c_buffer() { return bb_->c_buffer(); }
+
+ private:
+  ByteBuffer* bb_;
+};
+
+}  // namespace internal
+
+namespace {
+
+using internal::GrpcByteBufferPeer;
+using internal::MessagePassthrough;
+
+struct PassedMessage {
+  grpc::string text;
+};
+
+struct OtherPassedMessage {
+  grpc::string text;
+};
+
+template <class M>
+class TextSerializationTraits {
+ public:
+  static Status Serialize(const M& msg, ByteBuffer* bb, bool* own_buffer) {
+    *own_buffer = true;
+    Slice slice(msg.text);
+    ByteBuffer tmp(&slice, 1);
+    bb->Swap(&tmp);
+    return Status::OK;
+  }
+  static Status Deserialize(ByteBuffer* bb, M* msg) {
+    std::vector<Slice> slices;
+    (void)bb->Dump(&slices);
+    msg->text.clear();
+    for (const Slice& slice : slices) {
+      msg->text.append(reinterpret_cast<const char*>(slice.begin()),
+                       slice.size());
+    }
+    bb->Clear();
+    return Status::OK;
+  }
+};
+
+}  // namespace
+
+template <>
+class SerializationTraits<PassedMessage, void>
+    : public TextSerializationTraits<PassedMessage> {};
+template <>
+class SerializationTraits<OtherPassedMessage, void>
+    : public TextSerializationTraits<OtherPassedMessage> {};
+
+namespace experimental {
+template <>
+struct InprocMessagePassthrough<PassedMessage> : public std::true_type {};
+template <>
+struct InprocMessagePassthrough<OtherPassedMessage> : public std::true_type {};
+}  // namespace experimental
+
 namespace {
 
 const char* kContent1 = "hello xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
@@ -104,6 +172,52 @@ TEST_F(ByteBufferTest, Dump) {
   EXPECT_TRUE(SliceEqual(slices[1], world));
 }
 
+TEST_F(ByteBufferTest, ForEachSlice) {
+  std::vector<Slice> slices;
+  slices.emplace_back(kContent1);
+  slices.emplace_back(kContent2);
+  ByteBuffer buffer(&slices[0], 2);
+  grpc::string contents;
+  size_t count = 0;
+  EXPECT_TRUE(buffer
+                  .ForEachSlice([&contents, &count](const uint8_t* data,
+                                                    size_t length) {
+                    contents.append(reinterpret_cast<const char*>(data),
+                                    length);
+                    count++;
+                  })
+                  .ok());
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(grpc::string(kContent1) + kContent2, contents);
+  EXPECT_FALSE(ByteBuffer()
+                   .ForEachSlice([](const uint8_t* /*data*/,
+                                    size_t /*length*/) {})
+                   .ok());
+}
+
+void ReleaseExternal(void* released) { *static_cast<bool*>(released) = true; }
+
+TEST_F(ByteBufferTest, CreateFromExternalMemory) {
+  char data[] = "externally owned";
+  bool released = false;
+  {
+    ByteBuffer buffer(data, strlen(data), ReleaseExternal, &released);
+    EXPECT_EQ(strlen(data), buffer.Length());
+    ByteBuffer copy(buffer);
+    buffer.Clear();
+    EXPECT_FALSE(released);
+    const uint8_t* start = nullptr;
+    EXPECT_TRUE(copy.ForEachSlice([&start](const uint8_t* slice_data,
+                                           size_t /*length*/) {
+                      start = slice_data;
+                    })
+                    .ok());
+    // The bytes were not copied.
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(data), start);
+  }
+  EXPECT_TRUE(released);
+}
+
 TEST_F(ByteBufferTest, SerializationMakesCopy) {
   grpc_slice hello = grpc_slice_from_copied_string(kContent1);
   grpc_slice world = grpc_slice_from_copied_string(kContent2);
@@ -121,6 +235,66 @@ TEST_F(ByteBufferTest, SerializationMakesCopy) {
   EXPECT_TRUE(send_buffer.Valid());
 }
 
+TEST_F(ByteBufferTest, MessagePassthrough) {
+  PassedMessage sent;
+  sent.text = kContent1;
+  ByteBuffer buffer;
+  EXPECT_TRUE(MessagePassthrough::Serialize(sent, &buffer).ok());
+  EXPECT_TRUE(MessagePassthrough::IsPassedThrough(
+      GrpcByteBufferPeer(&buffer).c_buffer()));
+  PassedMessage received;
+  EXPECT_TRUE(MessagePassthrough::Deserialize(&buffer, &received).ok());
+  EXPECT_EQ(sent.text, received.text);
+  EXPECT_FALSE(buffer.Valid());
+}
+
+TEST_F(ByteBufferTest, MessagePassthroughChecksType) {
+  PassedMessage sent;
+  sent.text = kContent1;
+  ByteBuffer buffer;
+  EXPECT_TRUE(MessagePassthrough::Serialize(sent, &buffer).ok());
+  OtherPassedMessage received;
+  Status status = MessagePassthrough::Deserialize(&buffer, &received);
+  EXPECT_EQ(StatusCode::INTERNAL, status.error_code());
+  EXPECT_TRUE(received.text.empty());
+}
+
+TEST_F(ByteBufferTest, MessagePassthroughIgnoresCopiedBytes) {
+  PassedMessage sent;
+  sent.text = kContent1;
+  ByteBuffer buffer;
+  EXPECT_TRUE(MessagePassthrough::Serialize(sent, &buffer).ok());
+  // Bytes that look like a handed over message but live somewhere else, as
+  // they would if they came off the wire, are parsed like any other message.
+  std::vector<Slice> slices;
+  (void)buffer.Dump(&slices);
+  ASSERT_EQ(1u, slices.size());
+  grpc::string bytes(reinterpret_cast<const char*>(slices[0].begin()),
+                     slices[0].size());
+  Slice copy(bytes);
+  ByteBuffer copied(&copy, 1);
+  EXPECT_FALSE(MessagePassthrough::IsPassedThrough(
+      GrpcByteBufferPeer(&copied).c_buffer()));
+  PassedMessage received;
+  EXPECT_TRUE(MessagePassthrough::Deserialize(&copied, &received).ok());
+  EXPECT_EQ(bytes, received.text);
+}
+
+TEST_F(ByteBufferTest, MessagePassthroughParsesSerializedBytes) {
+  PassedMessage sent;
+  sent.text = kContent2;
+  ByteBuffer buffer;
+  bool own_buffer;
+  EXPECT_TRUE(SerializationTraits<PassedMessage>::Serialize(sent, &buffer,
+                                                            &own_buffer)
+                  .ok());
+  EXPECT_FALSE(MessagePassthrough::IsPassedThrough(
+      GrpcByteBufferPeer(&buffer).c_buffer()));
+  PassedMessage received;
+  EXPECT_TRUE(MessagePassthrough::Deserialize(&buffer, &received).ok());
+  EXPECT_EQ(sent.text, received.text);
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -116,198 +116,87 @@ static void generate_first_byte_lut(void) {
  * Huffman decoder table generation
  */
 
-#define MAXHUFFSTATES 1024
-
-/* represents a set of symbols as an array of booleans indicating inclusion */
-typedef struct { char included[GRPC_CHTTP2_NUM_HUFFSYMS]; } symset;
-/* represents a lookup table indexed by a nibble */
-typedef struct { unsigned values[16]; } nibblelut;
-
-#define NOT_SET (~(unsigned)0)
-
-/* returns a symset that includes all possible symbols */
-static symset symset_all(void) {
-  symset x;
-  memset(x.included, 1, sizeof(x.included));
-  return x;
-}
-
-/* returns a symset that includes no symbols */
-static symset symset_none(void) {
-  symset x;
-  memset(x.included, 0, sizeof(x.included));
-  return x;
-}
-
-/* returns an empty nibblelut */
-static nibblelut nibblelut_empty(void) {
-  nibblelut x;
-  int i;
-  for (i = 0; i < 16; i++) {
-    x.values[i] = NOT_SET;
-  }
-  return x;
-}
-
-/* counts symbols in a symset - only used for debug builds */
-#ifndef NDEBUG
-static int nsyms(symset s) {
-  int i;
-  int c = 0;
-  for (i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
-    c += s.included[i] != 0;
+#define LOOKUP_BITS 11
+#define MAX_CODE_LENGTH 30
+
+/* canonical decoding tables: the codes of length n are the values in
+   [first_code[n], first_code[n] + num_codes[n]), and belong to the symbols of
+   sorted_syms starting at first_sym[n] */
+static unsigned first_code[MAX_CODE_LENGTH + 1];
+static unsigned num_codes[MAX_CODE_LENGTH + 1];
+static unsigned first_sym[MAX_CODE_LENGTH + 1];
+static unsigned sorted_syms[GRPC_CHTTP2_NUM_HUFFSYMS];
+
+/* returns the symbol whose code starts the LOOKUP_BITS of bits, or -1 if no
+   code of at most max_length bits does */
+static int match(unsigned bits, unsigned max_length, unsigned *length) {
+  unsigned n;
+  for (n = 1; n <= max_length; n++) {
+    unsigned code = bits >> (LOOKUP_BITS - n);
+    if (code - first_code[n] < num_codes[n]) {
+      *length = n;
+      return (int)sorted_syms[first_sym[n] + code - first_code[n]];
+    }
   }
-  return c;
+  return -1;
 }
-#endif
-
-/* global table of discovered huffman decoding states */
-static struct {
-  /* the bit offset that this state starts at */
-  unsigned bitofs;
-  /* the set of symbols that this state started with */
-  symset syms;
 
-  /* lookup table for the next state */
-  nibblelut next;
-  /* lookup table for what to emit */
-  nibblelut emit;
-} huffstates[MAXHUFFSTATES];
-static unsigned nhuffstates = 0;
-
-/* given a number of decoded bits and a set of symbols that are live,
-   return the index into the decoder table for this state.
-   set isnew to 1 if this state was previously undiscovered */
-static unsigned state_index(unsigned bitofs, symset syms, unsigned *isnew) {
+static void dump_tbl(const char *type, const char *name, const unsigned *values,
+                     unsigned n) {
   unsigned i;
-  for (i = 0; i < nhuffstates; i++) {
-    if (huffstates[i].bitofs != bitofs) continue;
-    if (0 != memcmp(huffstates[i].syms.included, syms.included,
-                    GRPC_CHTTP2_NUM_HUFFSYMS))
-      continue;
-    *isnew = 0;
-    return i;
+  printf("static const %s %s[%d] = {", type, name, n);
+  for (i = 0; i < n; i++) {
+    printf("%d,", values[i]);
   }
-  GPR_ASSERT(nhuffstates != MAXHUFFSTATES);
- 
-  i = nhuffstates;
-  nhuffstates++;
-  
-  huffstates[i].bitofs = bitofs;
-  huffstates[i].syms = syms;
-  huffstates[i].next = nibblelut_empty();
-  huffstates[i].emit = nibblelut_empty();
-  *isnew = 1;
-  return i;
+  printf("};\n");
 }
 
-/* recursively build a decoding table
-
-   state   - the huffman state that we are trying to fill in
-   nibble  - the current nibble
-   nibbits - the number of bits in the nibble that have been filled in
-   bitofs  - the number of bits of symbol that have been decoded
-   emit    - the symbol to emit on this nibble (or -1 if no symbol has been
-             found)
-   syms    - the set of symbols that could be matched */
-static void build_dec_tbl(unsigned state, unsigned nibble, int nibbits,
-                          unsigned bitofs, unsigned emit, symset syms) {
+static void generate_huff_tables(void) {
+  unsigned n;
   unsigned i;
-  unsigned bit;
-
-  /* If we have four bits in the nibble we're looking at, then we can fill in
-     a slot in the lookup tables. */
-  if (nibbits == 4) {
-    unsigned isnew;
-    /* Find the state that we are in: this may be a new state, in which case
-       we recurse to fill it in, or we may have already seen this state, in
-       which case the recursion terminates */
-    unsigned st = state_index(bitofs, syms, &isnew);
-    GPR_ASSERT(huffstates[state].next.values[nibble] == NOT_SET);
-    huffstates[state].next.values[nibble] = st;
-    huffstates[state].emit.values[nibble] = emit;
-    if (isnew) {
-      build_dec_tbl(st, 0, 0, bitofs, NOT_SET, syms);
-    }
-    return;
-  }
+  unsigned nsorted = 0;
 
-  assert(nsyms(syms));
-
-  /* A bit can be 0 or 1 */
-  for (bit = 0; bit < 2; bit++) {
-    /* walk over active symbols and see if they have this bit set */
-    symset nextsyms = symset_none();
+  for (n = 1; n <= MAX_CODE_LENGTH; n++) {
+    first_sym[n] = nsorted;
     for (i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
-      if (!syms.included[i]) continue; /* disregard inactive symbols */
-      if (((grpc_chttp2_huffsyms[i].bits >>
-            (grpc_chttp2_huffsyms[i].length - bitofs - 1)) &
-           1) == bit) {
-        /* the bit is set, include it in the next recursive set */
-        if (grpc_chttp2_huffsyms[i].length == bitofs + 1) {
-          /* additionally, we've gotten to the end of a symbol - this is a
-             special recursion step: re-activate all the symbols, reset
-             bitofs to zero, and recurse */
-          build_dec_tbl(state, (nibble << 1) | bit, nibbits + 1, 0, i,
-                        symset_all());
-          /* skip the remainder of this loop */
-          goto next;
-        }
-        nextsyms.included[i] = 1;
-      }
+      if (grpc_chttp2_huffsyms[i].length != n) continue;
+      if (num_codes[n] == 0) first_code[n] = grpc_chttp2_huffsyms[i].bits;
+      /* the HPACK code is canonical: within a length, codes are consecutive
+         in symbol order */
+      GPR_ASSERT(grpc_chttp2_huffsyms[i].bits == first_code[n] + num_codes[n]);
+      num_codes[n]++;
+      sorted_syms[nsorted++] = i;
     }
-    /* recurse down for this bit */
-    build_dec_tbl(state, (nibble << 1) | bit, nibbits + 1, bitofs + 1, emit,
-                  nextsyms);
-  next:;
   }
-}
-
-static nibblelut ctbl[MAXHUFFSTATES];
-static int nctbl;
-
-static int ctbl_idx(nibblelut x) {
-  int i;
-  for (i = 0; i < nctbl; i++) {
-    if (0 == memcmp(&x, ctbl + i, sizeof(nibblelut))) return i;
-  }
-  ctbl[i] = x;
-  nctbl++;
-  return i;
-}
-
-static void dump_ctbl(const char *name) {
-  int i, j;
-  printf("static const gpr_int16 %s[%d*16] = {\n", name, nctbl);
-  for (i = 0; i < nctbl; i++) {
-    for (j = 0; j < 16; j++) {
-      printf("%d,", ctbl[i].values[j]);
+  GPR_ASSERT(nsorted == GRPC_CHTTP2_NUM_HUFFSYMS);
+  dump_tbl("uint32_t", "huff_first_code", first_code, MAX_CODE_LENGTH + 1);
+  dump_tbl("uint16_t", "huff_num_codes", num_codes, MAX_CODE_LENGTH + 1);
+  dump_tbl("uint16_t", "huff_first_sym", first_sym, MAX_CODE_LENGTH + 1);
+  dump_tbl("uint16_t", "huff_sorted_syms", sorted_syms,
+           GRPC_CHTTP2_NUM_HUFFSYMS);
+
+  /* each entry packs the first symbol, the second symbol, the number of
+     symbols and the number of bits they take, from the lowest byte up */
+  printf("static const uint32_t huff_lookup[%d] = {", 1 << LOOKUP_BITS);
+  for (i = 0; i < (1 << LOOKUP_BITS); i++) {
+    unsigned syms[2] = {0, 0};
+    unsigned nsyms = 0;
+    unsigned length = 0;
+    unsigned l;
+    int sym = match(i, LOOKUP_BITS, &l);
+    if (sym >= 0) {
+      syms[nsyms++] = (unsigned)sym;
+      length = l;
+      sym = match((i << length) & ((1 << LOOKUP_BITS) - 1),
+                  LOOKUP_BITS - length, &l);
+      if (sym >= 0) {
+        syms[nsyms++] = (unsigned)sym;
+        length += l;
+      }
     }
-    printf("\n");
-  }
-  printf("};\n");
-}
-
-static void generate_huff_tables(void) {
-  unsigned i;
-  build_dec_tbl(state_index(0, symset_all(), &i), 0, 0, 0, NOT_SET,
-                symset_all());
-
-  nctbl = 0;
-  printf("static const gpr_uint8 next_tbl[%d] = {", nhuffstates);
-  for (i = 0; i < nhuffstates; i++) {
-    printf("%d,", ctbl_idx(huffstates[i].next));
-  }
-  printf("};\n");
-  dump_ctbl("next_sub_tbl");
-
-  nctbl = 0;
-  printf("static const gpr_uint16 emit_tbl[%d] = {", nhuffstates);
-  for (i = 0; i < nhuffstates; i++) {
-    printf("%d,", ctbl_idx(huffstates[i].emit));
+    printf("0x%08x,", syms[0] | syms[1] << 8 | nsyms << 16 | length << 24);
   }
   printf("};\n");
-  dump_ctbl("emit_sub_tbl");
 }
 
 static void generate_base64_huff_encoder_table(void) {
@@ -678,6 +678,55 @@ print >> C, '  return h < GPR_ARRAY_SIZE(elem_keys) && elem_keys[h] == k && elem
 print >> C, '}'
 print >> C
 
+
+# Hashes the length and three of the bytes of a static string: enough to tell
+# all of them apart, and cheap enough for the hpack parser to try on every
+# literal it reads before falling back to interning.
+def static_str_key(s):
+    n = len(s)
+    return (ord(s[0]) | ord(s[n // 3]) << 8 | ord(s[n - 1]) << 16 |
+            (n & 0xff) << 24)
+
+
+STATIC_STR_HASH_BITS = 9
+assert len(all_strs) < 255
+for i in itertools.count(1):
+    static_str_mul = ((0x9E3779B1 * i) & 0xffffffff) | 1
+    static_str_idxs = [255] * (1 << STATIC_STR_HASH_BITS)
+    collision = False
+    for idx, s in enumerate(all_strs):
+        if not s:
+            continue
+        h = (((static_str_key(s) * static_str_mul) & 0xffffffff) >>
+             (32 - STATIC_STR_HASH_BITS))
+        if static_str_idxs[h] != 255:
+            collision = True
+            break
+        static_str_idxs[h] = idx
+    if not collision:
+        break
+print >> C, 'static const uint8_t static_str_idxs[] = {%s};' % ','.join(
+    '%d' % i for i in static_str_idxs)
+print >> C
+
+print >> H, ('intptr_t grpc_static_slice_index_for_bytes(const char* bytes, '
+             'size_t length);')
+print >> C, ('intptr_t grpc_static_slice_index_for_bytes(const char* bytes, '
+             'size_t length) {')
+print >> C, '  if (length == 0) return %d;' % (str_idx('') if '' in all_strs else
+                                               -1)
+print >> C, '  const uint8_t* p = reinterpret_cast<const uint8_t*>(bytes);'
+print >> C, ('  uint32_t k = static_cast<uint32_t>(p[0]) | '
+             'static_cast<uint32_t>(p[length / 3]) << 8 | '
+             'static_cast<uint32_t>(p[length - 1]) << 16 | '
+             'static_cast<uint32_t>(length & 0xff) << 24;')
+print >> C, '  uint8_t idx = static_str_idxs[(k * 0x%xu) >> %d];' % (
+    static_str_mul, 32 - STATIC_STR_HASH_BITS)
+print >> C, ('  return idx != 255 && grpc_static_slice_table()[idx] == '
+             'std::pair<const char*, size_t>(bytes, length) ? idx : -1;')
+print >> C, '}'
+print >> C
+
 print >> H, 'typedef enum {'
 for elem in METADATA_BATCH_CALLOUTS:
     print >> H, '  %s,' % mangle(elem, 'batch').upper()
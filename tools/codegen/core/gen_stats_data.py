@@ -44,9 +44,26 @@ def c_str(s, encoding='ascii'):
     return '"' + result + '"'
 
 
+# Bucket of a log_linear histogram: values below 2^precision get a bucket
+# each, then each power of two is split into 2^precision buckets. Matches
+# grpc_stats_histo_find_bucket_log_linear.
+def log_linear_bucket(value, precision):
+    if value < (1 << precision):
+        return value
+    shift = value.bit_length() - 1 - precision
+    return (shift << precision) + (value >> shift)
+
+
+def log_linear_lower_bound(bucket, precision):
+    sub_buckets = 1 << precision
+    if bucket < sub_buckets:
+        return bucket
+    return (sub_buckets + bucket % sub_buckets) << (bucket // sub_buckets - 1)
+
+
 types = (
     make_type('Counter', []),
-    make_type('Histogram', ['max', 'buckets']),
+    make_type('Histogram', ['max', 'buckets', 'scale', 'precision']),
 )
 
 inst_map = dict((t[0].__name__, t[1]) for t in types)
@@ -60,6 +77,13 @@ for attr in attrs:
         if t_name in attr:
             name = attr[t_name]
             del attr[t_name]
+            if t_name == 'histogram':
+                attr.setdefault('scale', 'exponential')
+                attr.setdefault('precision', 0)
+                if attr['scale'] == 'log_linear':
+                    assert 'buckets' not in attr, name
+                    attr['buckets'] = log_linear_bucket(
+                        attr['max'], attr['precision']) + 1
             lst.append(t(name=name, **attr))
             found = True
             break
@@ -133,7 +157,22 @@ def type_for_uint_table(table):
         return 'uint64_t'
 
 
+def gen_log_linear_bucket_code(histogram):
+    bounds = [
+        log_linear_lower_bound(i, histogram.precision)
+        for i in range(histogram.buckets + 1)
+    ]
+    bounds_idx = decl_static_table(bounds, 'int')
+    code = 'value = GPR_CLAMP(value, 0, %d);\n' % histogram.max
+    code += 'GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_%s, ' % histogram.name.upper(
+    )
+    code += 'grpc_stats_histo_find_bucket_log_linear(value, %d));\n' % histogram.precision
+    return (code, bounds_idx)
+
+
 def gen_bucket_code(histogram):
+    if histogram.scale == 'log_linear':
+        return gen_log_linear_bucket_code(histogram)
     bounds = [0, 1]
     done_trivial = False
     done_unmapped = False
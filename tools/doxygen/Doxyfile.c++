@@ -941,6 +941,7 @@ include/grpcpp/ext/health_check_service_server_builder_option.h \
 include/grpcpp/generic/async_generic_service.h \
 include/grpcpp/generic/generic_stub.h \
 include/grpcpp/generic/generic_stub_impl.h \
+include/grpcpp/generic/generic_unary_batcher.h \
 include/grpcpp/grpcpp.h \
 include/grpcpp/health_check_service_interface.h \
 include/grpcpp/health_check_service_interface_impl.h \
@@ -979,6 +980,7 @@ include/grpcpp/impl/codegen/intercepted_channel.h \
 include/grpcpp/impl/codegen/interceptor.h \
 include/grpcpp/impl/codegen/interceptor_common.h \
 include/grpcpp/impl/codegen/message_allocator.h \
+include/grpcpp/impl/codegen/message_passthrough.h \
 include/grpcpp/impl/codegen/metadata_map.h \
 include/grpcpp/impl/codegen/method_handler.h \
 include/grpcpp/impl/codegen/method_handler_impl.h \
@@ -1006,6 +1008,7 @@ include/grpcpp/impl/codegen/sync.h \
 include/grpcpp/impl/codegen/sync_stream.h \
 include/grpcpp/impl/codegen/sync_stream_impl.h \
 include/grpcpp/impl/codegen/time.h \
+include/grpcpp/impl/codegen/write_timestamps.h \
 include/grpcpp/impl/grpc_library.h \
 include/grpcpp/impl/method_handler_impl.h \
 include/grpcpp/impl/rpc_method.h \
@@ -1039,14 +1042,18 @@ include/grpcpp/support/async_stream_impl.h \
 include/grpcpp/support/async_unary_call.h \
 include/grpcpp/support/async_unary_call_impl.h \
 include/grpcpp/support/byte_buffer.h \
+include/grpcpp/support/call_timeline.h \
 include/grpcpp/support/channel_arguments.h \
 include/grpcpp/support/channel_arguments_impl.h \
 include/grpcpp/support/client_callback.h \
 include/grpcpp/support/client_callback_impl.h \
 include/grpcpp/support/client_interceptor.h \
 include/grpcpp/support/config.h \
+include/grpcpp/support/coroutine.h \
+include/grpcpp/support/event_trace.h \
 include/grpcpp/support/interceptor.h \
 include/grpcpp/support/message_allocator.h \
+include/grpcpp/support/proto_arena_allocator.h \
 include/grpcpp/support/proto_buffer_reader.h \
 include/grpcpp/support/proto_buffer_writer.h \
 include/grpcpp/support/server_callback.h \
@@ -102,8 +102,11 @@ def _flatten_result_inplace(scenario_result):
     scenario_result['scenario']['serverConfig'] = json.dumps(
         scenario_result['scenario']['serverConfig'])
     scenario_result['latencies'] = json.dumps(scenario_result['latencies'])
+    scenario_result['uncorrectedLatencies'] = json.dumps(
+        scenario_result.get('uncorrectedLatencies', {}))
     scenario_result['serverCpuStats'] = []
     for stats in scenario_result['serverStats']:
+        stats.pop('coreCpuTimes', None)
         scenario_result['serverCpuStats'].append(dict())
         scenario_result['serverCpuStats'][-1]['totalCpuTime'] = stats.pop(
             'totalCpuTime', None)
@@ -112,6 +115,8 @@ def _flatten_result_inplace(scenario_result):
     for stats in scenario_result['clientStats']:
         stats['latencies'] = json.dumps(stats['latencies'])
         stats.pop('requestResults', None)
+        stats.pop('uncorrectedLatencies', None)
+        stats.pop('coreCpuTimes', None)
     scenario_result['serverCores'] = json.dumps(scenario_result['serverCores'])
     scenario_result['clientSuccess'] = json.dumps(
         scenario_result['clientSuccess'])
@@ -38,6 +38,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_client_subchannels_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "client_subchannels_created")
+            stats[
+                "core_client_retry_buffered_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "client_retry_buffered_bytes")
+            stats[
+                "core_client_retry_buffer_overflow_commits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "client_retry_buffer_overflow_commits")
             stats[
                 "core_server_channels_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_channels_created")
@@ -67,6 +73,18 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_pollset_fd_cache_hits"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_fd_cache_hits")
+            stats[
+                "core_busy_poll_spin_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "busy_poll_spin_hits")
+            stats[
+                "core_busy_poll_spin_misses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "busy_poll_spin_misses")
+            stats[
+                "core_pollset_numa_local_wakeups"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_numa_local_wakeups")
+            stats[
+                "core_pollset_numa_remote_wakeups"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_numa_remote_wakeups")
             stats[
                 "core_histogram_slow_lookups"] = massage_qps_stats_helpers.counter(
                     core_stats, "histogram_slow_lookups")
@@ -80,6 +98,15 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats[
+                "core_tcp_zerocopy_sends"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_zerocopy_sends")
+            stats[
+                "core_tcp_zerocopy_fallbacks"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_zerocopy_fallbacks")
+            stats[
+                "core_tcp_write_coalesced_runs"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_write_coalesced_runs")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -102,6 +129,15 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_op_recv_trailing_metadata"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_op_recv_trailing_metadata")
+            stats[
+                "core_http2_send_data_frames"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_send_data_frames")
+            stats[
+                "core_http2_recv_data_frames"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_recv_data_frames")
+            stats[
+                "core_http2_recv_messages"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_recv_messages")
             stats[
                 "core_http2_settings_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_settings_writes")
@@ -119,6 +155,8 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
+            stats["core_http2_writes_held"] = massage_qps_stats_helpers.counter(
+                core_stats, "http2_writes_held")
             stats[
                 "core_http2_initiate_write_due_to_initial_write"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_initiate_write_due_to_initial_write")
@@ -228,6 +266,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_hpack_recv_binary_base64"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_recv_binary_base64")
+            stats[
+                "core_hpack_recv_static_string"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_recv_static_string")
+            stats[
+                "core_hpack_recv_interned_string"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_recv_interned_string")
             stats[
                 "core_hpack_send_indexed"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_send_indexed")
@@ -260,6 +304,15 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_hpack_send_binary_base64"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_send_binary_base64")
+            stats[
+                "core_hpack_send_dynidx_hit"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_dynidx_hit")
+            stats[
+                "core_hpack_send_dynidx_miss"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_dynidx_miss")
+            stats[
+                "core_hpack_send_preencoded"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_preencoded")
             stats[
                 "core_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(
                     core_stats, "combiner_locks_initiated")
@@ -302,12 +355,39 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_executor_push_retries"] = massage_qps_stats_helpers.counter(
                     core_stats, "executor_push_retries")
+            stats[
+                "core_executor_stolen_items"] = massage_qps_stats_helpers.counter(
+                    core_stats, "executor_stolen_items")
+            stats[
+                "core_handshaker_offloaded_steps"] = massage_qps_stats_helpers.counter(
+                    core_stats, "handshaker_offloaded_steps")
+            stats[
+                "core_handshaker_queued_steps"] = massage_qps_stats_helpers.counter(
+                    core_stats, "handshaker_queued_steps")
+            stats[
+                "core_alts_handshakes_started"] = massage_qps_stats_helpers.counter(
+                    core_stats, "alts_handshakes_started")
+            stats[
+                "core_alts_handshakes_queued"] = massage_qps_stats_helpers.counter(
+                    core_stats, "alts_handshakes_queued")
             stats[
                 "core_server_requested_calls"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_requested_calls")
             stats[
                 "core_server_slowpath_requests_queued"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_slowpath_requests_queued")
+            stats[
+                "core_server_request_matcher_lock_contentions"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_request_matcher_lock_contentions")
+            stats[
+                "core_sync_server_queue_delay_over_target"] = massage_qps_stats_helpers.counter(
+                    core_stats, "sync_server_queue_delay_over_target")
+            stats[
+                "core_sync_server_thread_target_raised"] = massage_qps_stats_helpers.counter(
+                    core_stats, "sync_server_thread_target_raised")
+            stats[
+                "core_sync_server_thread_target_lowered"] = massage_qps_stats_helpers.counter(
+                    core_stats, "sync_server_thread_target_lowered")
             stats[
                 "core_cq_ev_queue_trylock_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_trylock_failures")
@@ -317,6 +397,46 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_cq_ev_queue_transient_pop_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_transient_pop_failures")
+            stats["core_cq_ev_queue_steals"] = massage_qps_stats_helpers.counter(
+                core_stats, "cq_ev_queue_steals")
+            stats[
+                "core_compressed_messages"] = massage_qps_stats_helpers.counter(
+                    core_stats, "compressed_messages")
+            stats[
+                "core_compression_skipped_messages"] = massage_qps_stats_helpers.counter(
+                    core_stats, "compression_skipped_messages")
+            stats[
+                "core_health_check_streams_started"] = massage_qps_stats_helpers.counter(
+                    core_stats, "health_check_streams_started")
+            stats[
+                "core_health_check_streams_ended"] = massage_qps_stats_helpers.counter(
+                    core_stats, "health_check_streams_ended")
+            stats[
+                "core_native_dns_requests_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "native_dns_requests_coalesced")
+            stats[
+                "core_cq_callback_executor_hops"] = massage_qps_stats_helpers.counter(
+                    core_stats, "cq_callback_executor_hops")
+            stats[
+                "core_cq_callback_inline_runs"] = massage_qps_stats_helpers.counter(
+                    core_stats, "cq_callback_inline_runs")
+            stats["core_server_calls_shed"] = massage_qps_stats_helpers.counter(
+                core_stats, "server_calls_shed")
+            stats[
+                "core_oauth2_calls_queued_for_token"] = massage_qps_stats_helpers.counter(
+                    core_stats, "oauth2_calls_queued_for_token")
+            stats[
+                "core_oauth2_token_background_refreshes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "oauth2_token_background_refreshes")
+            stats[
+                "core_memory_reclaimed_buffer_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "memory_reclaimed_buffer_bytes")
+            stats[
+                "core_memory_reclaimed_hpack_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "memory_reclaimed_hpack_bytes")
+            stats[
+                "core_memory_reclaimed_arena_pool_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "memory_reclaimed_arena_pool_bytes")
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "call_initial_size")
             stats["core_call_initial_size"] = ",".join(
@@ -509,3 +629,153 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_cqs_checked_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "combiner_queue_wait_us")
+            stats["core_combiner_queue_wait_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_queue_wait_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_queue_wait_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_queue_wait_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_queue_wait_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "combiner_run_us")
+            stats["core_combiner_run_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_run_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_run_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_run_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_run_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "registered_call_initial_size")
+            stats["core_registered_call_initial_size"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_registered_call_initial_size_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_registered_call_initial_size_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_registered_call_initial_size_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_registered_call_initial_size_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "compression_bytes_saved")
+            stats["core_compression_bytes_saved"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_compression_bytes_saved_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_compression_bytes_saved_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_compression_bytes_saved_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_compression_bytes_saved_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "compression_run_us")
+            stats["core_compression_run_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_compression_run_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_compression_run_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_compression_run_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_compression_run_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "native_dns_resolve_us")
+            stats["core_native_dns_resolve_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_native_dns_resolve_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_native_dns_resolve_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_native_dns_resolve_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_native_dns_resolve_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "oauth2_token_fetch_us")
+            stats["core_oauth2_token_fetch_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_oauth2_token_fetch_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_oauth2_token_fetch_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_oauth2_token_fetch_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_oauth2_token_fetch_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "pick_latency_us")
+            stats["core_pick_latency_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_pick_latency_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_pick_latency_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_pick_latency_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_pick_latency_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "write_latency_us")
+            stats["core_write_latency_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_write_latency_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_write_latency_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_write_latency_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_write_latency_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "cq_delivery_delay_us")
+            stats["core_cq_delivery_delay_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_cq_delivery_delay_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_cq_delivery_delay_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_cq_delivery_delay_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_cq_delivery_delay_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
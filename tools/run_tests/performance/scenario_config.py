@@ -130,7 +130,9 @@ def _ping_pong_scenario(name,
                         messages_per_stream=None,
                         excluded_poll_engines=[],
                         minimal_stack=False,
-                        offered_load=None):
+                        offered_load=None,
+                        client_core_list=None,
+                        server_core_list=None):
     """Creates a basic ping pong scenario."""
     scenario = {
         'name': name,
@@ -211,6 +213,12 @@ def _ping_pong_scenario(name,
 
     if messages_per_stream:
         scenario['client_config']['messages_per_stream'] = messages_per_stream
+    # Pins the C++ worker threads polling each completion queue to these
+    # cores, in turn, and reports each core's CPU usage.
+    if client_core_list:
+        scenario['client_config']['core_list'] = client_core_list
+    if server_core_list:
+        scenario['server_config']['core_list'] = server_core_list
     if client_language:
         # the CLIENT_LANGUAGE field is recognized by run_performance_tests.py
         scenario['CLIENT_LANGUAGE'] = client_language
@@ -282,6 +290,24 @@ class CXXLanguage:
             server_threads_per_cq=1,
             categories=[SCALABLE])
 
+        # Open-loop scenarios report latencies measured from the scheduled
+        # send time along with the uncorrected ones. The first keeps up with
+        # its offered load, so both should agree; the second can't, so the
+        # corrected tail latencies include the time spent behind schedule.
+        for offered_load, label in [(1000, '1Kqps'), (1000000, '1Mqps')]:
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_unary_open_loop_%s_insecure' % label,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async',
+                outstanding=16,
+                channels=1,
+                num_clients=1,
+                offered_load=offered_load,
+                secure=False,
+                categories=[INPROC])
+
         for secure in [True, False]:
             secstr = 'secure' if secure else 'insecure'
             smoketest_categories = ([SMOKETEST] if secure else [])